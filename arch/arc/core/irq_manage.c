@@ -123,6 +123,40 @@ int arch_irq_is_enabled(unsigned int irq)
 	return z_arc_v2_irq_unit_int_enabled(irq);
 }
 
+#ifdef CONFIG_ARC_CONNECT
+/**
+ * @brief Route an IDU common interrupt to a set of cores
+ *
+ * The IDU is programmed in round robin mode by the SoC, so an interrupt
+ * routed to several cores is serviced by them in turn. The line is masked
+ * in the IDU while its destination changes. The core ID is the CPU index.
+ *
+ * @param irq IRQ line, IDU lines start at ARC_CONNECT_IDU_IRQ_START
+ * @param cpu_mask bit mask of the cores
+ * @return 0 on success, -EINVAL for a core level IRQ or an invalid mask
+ */
+int arch_irq_set_affinity(unsigned int irq, uint32_t cpu_mask)
+{
+	unsigned int idu_irq;
+	uint32_t mask;
+
+	if ((irq < ARC_CONNECT_IDU_IRQ_START) || (irq >= CONFIG_NUM_IRQS) ||
+	    (cpu_mask == 0U) ||
+	    ((cpu_mask & ~BIT_MASK(CONFIG_MP_NUM_CPUS)) != 0U)) {
+		return -EINVAL;
+	}
+
+	idu_irq = irq - ARC_CONNECT_IDU_IRQ_START;
+
+	mask = z_arc_connect_idu_read_mask(idu_irq);
+	z_arc_connect_idu_set_mask(idu_irq, 0x1);
+	z_arc_connect_idu_set_dest(idu_irq, cpu_mask);
+	z_arc_connect_idu_set_mask(idu_irq, mask);
+
+	return 0;
+}
+#endif /* CONFIG_ARC_CONNECT */
+
 /*
  * @internal
  *
@@ -681,6 +681,49 @@ static void reserved_exception(const z_arch_esf_t *esf, int fault)
 	       fault - 16);
 }
 
+#if defined(CONFIG_FPU_SHARING_LAZY)
+/**
+ * @brief Hand the FP registers over to the current thread
+ *
+ * Threads not owning the FP registers run with the FP co-processor
+ * disabled, so that their first FP instruction raises a NOCP UsageFault.
+ * The registers of the previous owner are saved in its thread: storing
+ * s16-s31 also makes the hardware preserve the caller-saved registers and
+ * FPSCR, still pending since the owner was switched out, into its exception
+ * stack frame. The faulting instruction is then executed again.
+ *
+ * @param exc_return EXC_RETURN value present in LR upon exception entry.
+ *
+ * @return true if the fault was such a trap and has been handled.
+ */
+static bool fp_lazy_trap(uint32_t exc_return)
+{
+	struct k_thread *owner = z_arm_fp_owner;
+
+	if (((SCB->CFSR & SCB_CFSR_NOCP_Msk) == 0) ||
+	    ((exc_return & EXC_RETURN_MODE_Msk) != EXC_RETURN_MODE_THREAD)) {
+		return false;
+	}
+
+	SCB->CFSR = SCB_CFSR_NOCP_Msk;
+	SCB->CPACR |= CPACR_CP10_PRIV_ACCESS | CPACR_CP11_PRIV_ACCESS;
+	__DSB();
+	__ISB();
+
+	if (owner != NULL) {
+		__asm__ volatile ("vstmia %0, {s16-s31}\n"
+				  :
+				  : "r" (&owner->arch.preempt_float)
+				  : "memory");
+	}
+
+	__set_FPSCR(0);
+	z_arm_fp_owner = _current;
+
+	return true;
+}
+#endif /* CONFIG_FPU_SHARING_LAZY */
+
 /* Handler function for ARM fault conditions. */
 static uint32_t fault_handle(z_arch_esf_t *esf, int fault, bool *recoverable)
 {
@@ -943,6 +986,13 @@ void z_arm_fault(uint32_t msp, uint32_t psp, uint32_t exc_return)
 	 */
 	z_arch_esf_t esf_copy;
 
+#if defined(CONFIG_FPU_SHARING_LAZY)
+	/* Handled before unlocking interrupts, the thread may hold a lock */
+	if ((fault == 6) && fp_lazy_trap(exc_return)) {
+		return;
+	}
+#endif /* CONFIG_FPU_SHARING_LAZY */
+
 	/* Force unlock interrupts */
 	arch_irq_unlock(0);
 
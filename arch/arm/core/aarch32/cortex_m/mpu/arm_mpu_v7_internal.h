@@ -20,6 +20,50 @@ static void mpu_init(void)
 	/* No specific configuration at init for ARMv7-M MPU. */
 }
 
+#if defined(CONFIG_ARM_MPU_SKIP_UNCHANGED_REGIONS)
+/* Maximum number of MPU regions whose programmed value is tracked. Regions
+ * beyond this are always written.
+ */
+#define MPU_SHADOW_REGIONS_NUM 16
+
+/* RBAR and RASR values last written to each MPU region. A region is only
+ * known to hold its shadow value once its bit in shadow_valid is set, so
+ * regions left over from before the MPU driver initialized are always
+ * written the first time.
+ */
+static uint32_t shadow_rbar[MPU_SHADOW_REGIONS_NUM];
+static uint32_t shadow_rasr[MPU_SHADOW_REGIONS_NUM];
+static uint32_t shadow_valid;
+
+/* Returns true if the region already holds the given value, otherwise
+ * records it as the region's new value.
+ */
+static bool region_shadow_update(const uint32_t index, uint32_t rbar,
+	uint32_t rasr)
+{
+	if (index >= MPU_SHADOW_REGIONS_NUM) {
+		return false;
+	}
+
+	if (((shadow_valid & BIT(index)) != 0U) &&
+		(shadow_rbar[index] == rbar) && (shadow_rasr[index] == rasr)) {
+		return true;
+	}
+
+	shadow_rbar[index] = rbar;
+	shadow_rasr[index] = rasr;
+	shadow_valid |= BIT(index);
+
+	return false;
+}
+#else
+static inline bool region_shadow_update(const uint32_t index, uint32_t rbar,
+	uint32_t rasr)
+{
+	return false;
+}
+#endif /* CONFIG_ARM_MPU_SKIP_UNCHANGED_REGIONS */
+
 /* This internal function performs MPU region initialization.
  *
  * Note:
@@ -28,16 +72,40 @@ static void mpu_init(void)
 static void region_init(const uint32_t index,
 	const struct arm_mpu_region *region_conf)
 {
+	uint32_t rbar = (region_conf->base & MPU_RBAR_ADDR_Msk)
+				| MPU_RBAR_VALID_Msk | index;
+	uint32_t rasr = region_conf->attr.rasr | MPU_RASR_ENABLE_Msk;
+
+	if (region_shadow_update(index, rbar, rasr)) {
+		return;
+	}
+
 	/* Select the region you want to access */
 	MPU->RNR = index;
 	/* Configure the region */
-	MPU->RBAR = (region_conf->base & MPU_RBAR_ADDR_Msk)
-				| MPU_RBAR_VALID_Msk | index;
-	MPU->RASR = region_conf->attr.rasr | MPU_RASR_ENABLE_Msk;
+	MPU->RBAR = rbar;
+	MPU->RASR = rasr;
 	LOG_DBG("[%d] 0x%08x 0x%08x",
 		index, region_conf->base, region_conf->attr.rasr);
 }
 
+/* This internal function disables an MPU region.
+ *
+ * Note:
+ *   The caller must provide a valid region index.
+ */
+static void region_disable(const uint32_t index)
+{
+	/* ARM_MPU_ClrRegion() leaves RBAR untouched, so only RASR is
+	 * meaningful for a disabled region
+	 */
+	if (region_shadow_update(index, 0U, 0U)) {
+		return;
+	}
+
+	ARM_MPU_ClrRegion(index);
+}
+
 /* @brief Partition sanity check
  *
  * This internal function performs run-time sanity check for
@@ -342,7 +410,7 @@ static int mpu_configure_dynamic_mpu_regions(const struct k_mem_partition
 
 		/* Disable the non-programmed MPU regions. */
 		for (int i = mpu_reg_index; i < get_num_regions(); i++) {
-			ARM_MPU_ClrRegion(i);
+			region_disable(i);
 		}
 	}
 
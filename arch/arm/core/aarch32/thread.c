@@ -355,6 +355,26 @@ int arch_float_disable(struct k_thread *thread)
 }
 #endif /* CONFIG_FPU && CONFIG_FPU_SHARING */
 
+#if defined(CONFIG_FPU_SHARING_LAZY)
+/* Thread whose FP context is held in the FP registers */
+struct k_thread *z_arm_fp_owner;
+
+void arch_float_lazy_abort(struct k_thread *thread)
+{
+	int key = arch_irq_lock();
+
+	if (z_arm_fp_owner == thread) {
+		z_arm_fp_owner = NULL;
+		/* Its FP caller-saved registers must never be preserved
+		 * into its stack frame.
+		 */
+		FPU->FPCCR &= ~FPU_FPCCR_LSPACT_Msk;
+	}
+
+	arch_irq_unlock(key);
+}
+#endif /* CONFIG_FPU_SHARING_LAZY */
+
 /* Internal function for Cortex-M initialization,
  * applicable to either case of running Zephyr
  * with or without multi-threading support.
@@ -370,6 +390,13 @@ static void z_arm_prepare_switch_to_main(void)
 #if defined(CONFIG_FPU_SHARING)
 	/* In Sharing mode clearing FPSCR may set the CONTROL.FPCA flag. */
 	__set_CONTROL(__get_CONTROL() & (~(CONTROL_FPCA_Msk)));
+#if defined(CONFIG_FPU_SHARING_LAZY)
+	/* No thread owns the FP registers yet, the first FP instruction of
+	 * a thread traps to hand them over.
+	 */
+	SCB->CPACR &= ~(CPACR_CP10_Msk | CPACR_CP11_Msk);
+	__DSB();
+#endif /* CONFIG_FPU_SHARING_LAZY */
 	__ISB();
 #endif /* CONFIG_FPU_SHARING */
 #endif /* CONFIG_FPU */
@@ -391,8 +418,8 @@ void arch_switch_to_main_thread(struct k_thread *main_thread, char *stack_ptr,
 	z_arm_prepare_switch_to_main();
 
 	_current = main_thread;
-#ifdef CONFIG_TRACING
-	sys_trace_thread_switched_in();
+#ifdef CONFIG_INSTRUMENT_THREAD_SWITCHING
+	z_thread_mark_switched_in();
 #endif
 
 	/* the ready queue cache already contains the main thread */
@@ -67,6 +67,10 @@ extern FUNC_NORETURN void z_arm_userspace_enter(k_thread_entry_t user_entry,
 
 extern void z_arm_fatal_error(unsigned int reason, const z_arch_esf_t *esf);
 
+#if defined(CONFIG_FPU_SHARING_LAZY)
+extern struct k_thread *z_arm_fp_owner;
+#endif /* CONFIG_FPU_SHARING_LAZY */
+
 #endif /* _ASMLANGUAGE */
 
 #ifdef __cplusplus
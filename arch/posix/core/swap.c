@@ -83,11 +83,11 @@ void arch_switch_to_main_thread(struct k_thread *main_thread, char *stack_ptr,
 			(posix_thread_status_t *)
 			_kernel.ready_q.cache->callee_saved.thread_status;
 
-	sys_trace_thread_switched_out();
+	z_thread_mark_switched_out();
 
 	_current = _kernel.ready_q.cache;
 
-	sys_trace_thread_switched_in();
+	z_thread_mark_switched_in();
 
 	posix_main_thread_start(ready_thread_ptr->thread_idx);
 } /* LCOV_EXCL_LINE */
@@ -27,6 +27,9 @@
 
 /* thread_arch_t member offsets */
 GEN_OFFSET_SYM(_thread_arch_t, swap_return_value);
+#ifdef CONFIG_FPU_SHARING_LAZY
+GEN_OFFSET_SYM(_thread_arch_t, fp_caller_saved);
+#endif
 
 /* struct coop member offsets */
 GEN_OFFSET_SYM(_callee_saved_t, sp);
@@ -59,6 +59,10 @@ void arch_new_thread(struct k_thread *thread, k_thread_stack_t *stack,
 		stack_init->mstatus |= MSTATUS_FS_INIT;
 	}
 	stack_init->fp_state = 0;
+#endif
+#ifdef CONFIG_FPU_SHARING_LAZY
+	/* Loaded into the FPU by the first FP instruction of the thread */
+	thread->callee_saved.fcsr = 0U;
 #endif
 	stack_init->mepc = (ulong_t)z_thread_entry_wrapper;
 
@@ -88,6 +92,12 @@ int arch_float_disable(struct k_thread *thread)
 	/* Disable all floating point capabilities for the thread */
 	thread->base.user_options &= ~K_FP_REGS;
 
+#ifdef CONFIG_FPU_SHARING_LAZY
+	if (z_riscv_fp_owner == thread) {
+		z_riscv_fp_owner = NULL;
+	}
+#endif
+
 	/* Clear the FS bits to disable the FPU. */
 	__asm__ volatile (
 		"mv t0, %0\n"
@@ -120,16 +130,38 @@ int arch_float_enable(struct k_thread *thread)
 	/* Enable all floating point capabilities for the thread. */
 	thread->base.user_options |= K_FP_REGS;
 
-	/* Set the FS bits to Initial to enable the FPU. */
+#ifndef CONFIG_FPU_SHARING_LAZY
+	/* Set the FS bits to Initial to enable the FPU. With lazy sharing
+	 * the first FP instruction of the thread does it instead.
+	 */
 	__asm__ volatile (
 		"mv t0, %0\n"
 		"csrrs x0, mstatus, t0\n"
 		:
 		: "r" (MSTATUS_FS_INIT)
 		);
+#endif
 
 	irq_unlock(key);
 
 	return 0;
 }
 #endif /* CONFIG_FPU && CONFIG_FPU_SHARING */
+
+#ifdef CONFIG_FPU_SHARING_LAZY
+/* Thread whose FP context is held in the FP registers */
+struct k_thread *z_riscv_fp_owner;
+
+void arch_float_lazy_abort(struct k_thread *thread)
+{
+	unsigned int key;
+
+	key = irq_lock();
+
+	if (z_riscv_fp_owner == thread) {
+		z_riscv_fp_owner = NULL;
+	}
+
+	irq_unlock(key);
+}
+#endif /* CONFIG_FPU_SHARING_LAZY */
@@ -32,6 +32,10 @@ arch_thread_return_value_set(struct k_thread *thread, unsigned int value)
 	thread->arch.swap_return_value = value;
 }
 
+#ifdef CONFIG_FPU_SHARING_LAZY
+extern struct k_thread *z_riscv_fp_owner;
+#endif
+
 FUNC_NORETURN void z_riscv_fatal_error(unsigned int reason,
 				       const z_arch_esf_t *esf);
 
@@ -59,6 +59,11 @@
 #define _thread_offset_to_swap_return_value \
 	(___thread_t_arch_OFFSET + ___thread_arch_t_swap_return_value_OFFSET)
 
+#ifdef CONFIG_FPU_SHARING_LAZY
+#define _thread_offset_to_fp_caller_saved \
+	(___thread_t_arch_OFFSET + ___thread_arch_t_fp_caller_saved_OFFSET)
+#endif
+
 #if defined(CONFIG_FPU) && defined(CONFIG_FPU_SHARING)
 
 #define _thread_offset_to_fcsr \
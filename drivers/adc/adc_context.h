@@ -179,6 +179,36 @@ static inline void adc_context_complete(struct adc_context *ctx, int status)
 	k_sem_give(&ctx->sync);
 }
 
+#ifdef CONFIG_ADC_CONTINUOUS
+static inline bool adc_context_is_continuous(struct adc_context *ctx)
+{
+	return ctx->sequence.options && ctx->options.block_callback;
+}
+
+/*
+ * This function should be called in the continuous mode each time a block
+ * (half of the sequence buffer) is filled. It returns false if the block
+ * callback asks to finish, then the driver stops the sampling and calls
+ * adc_context_complete().
+ */
+static inline bool adc_context_on_block_done(struct adc_context *ctx,
+					     struct device *dev,
+					     const void *block)
+{
+	enum adc_action action;
+
+	action = ctx->options.block_callback(dev, &ctx->sequence, block,
+					     ctx->sequence.buffer_size / 2U);
+
+	return action != ADC_ACTION_FINISH;
+}
+#else
+static inline bool adc_context_is_continuous(struct adc_context *ctx)
+{
+	return false;
+}
+#endif /* CONFIG_ADC_CONTINUOUS */
+
 static inline void adc_context_start_read(struct adc_context *ctx,
 					  const struct adc_sequence *sequence)
 {
@@ -190,7 +220,9 @@ static inline void adc_context_start_read(struct adc_context *ctx,
 		ctx->sequence.options = &ctx->options;
 		ctx->sampling_index = 0U;
 
-		if (ctx->options.interval_us != 0U) {
+		/* The hardware paces the continuous samplings */
+		if ((ctx->options.interval_us != 0U) &&
+		    !adc_context_is_continuous(ctx)) {
 			atomic_set(&ctx->sampling_requested, 0);
 			adc_context_enable_timer(ctx);
 			return;
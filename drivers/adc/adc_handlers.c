@@ -59,7 +59,9 @@ static inline int z_vrfy_adc_read(struct device *dev,
 					(struct adc_sequence *)user_sequence),
 				    "invalid ADC sequence"));
 	if (sequence.options != NULL) {
-		Z_OOPS(Z_SYSCALL_VERIFY_MSG(sequence.options->callback == NULL,
+		Z_OOPS(Z_SYSCALL_VERIFY_MSG(
+			    (sequence.options->callback == NULL) &&
+			    (sequence.options->block_callback == NULL),
 			    "ADC sequence callbacks forbidden from user mode"));
 	}
 
@@ -80,7 +82,9 @@ static inline int z_vrfy_adc_read_async(struct device *dev,
 					(struct adc_sequence *)user_sequence),
 				    "invalid ADC sequence"));
 	if (sequence.options != NULL) {
-		Z_OOPS(Z_SYSCALL_VERIFY_MSG(sequence.options->callback == NULL,
+		Z_OOPS(Z_SYSCALL_VERIFY_MSG(
+			    (sequence.options->callback == NULL) &&
+			    (sequence.options->block_callback == NULL),
 			    "ADC sequence callbacks forbidden from user mode"));
 	}
 	Z_OOPS(Z_SYSCALL_OBJ(async, K_OBJ_POLL_SIGNAL));
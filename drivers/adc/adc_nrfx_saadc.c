@@ -14,10 +14,20 @@ LOG_MODULE_REGISTER(adc_nrfx_saadc);
 
 #define DT_DRV_COMPAT nordic_nrf_saadc
 
+/* Range of the internal timer compare value, in 16 MHz clock cycles */
+#define SAMPLERATE_CC_MIN 80U
+#define SAMPLERATE_CC_MAX 2047U
+
 struct driver_data {
 	struct adc_context ctx;
 
 	uint8_t positive_inputs[SAADC_CH_NUM];
+
+#ifdef CONFIG_ADC_CONTINUOUS
+	/* Half of the buffer being filled in the continuous mode */
+	nrf_saadc_value_t *block;
+	uint16_t block_len;
+#endif
 };
 
 static struct driver_data m_data = {
@@ -253,6 +263,81 @@ static int check_buffer_size(const struct adc_sequence *sequence,
 	return 0;
 }
 
+#ifdef CONFIG_ADC_CONTINUOUS
+static nrf_saadc_value_t *other_block(nrf_saadc_value_t *block)
+{
+	nrf_saadc_value_t *buffer = m_data.ctx.sequence.buffer;
+
+	return (block == buffer) ? buffer + m_data.block_len : buffer;
+}
+
+/*
+ * Let the internal timer trigger the samplings and EasyDMA fill the two
+ * halves of the buffer in turn. The pointer to the next half is latched
+ * at STARTED, so that only the START task is needed at each END.
+ */
+static int prepare_continuous(const struct adc_sequence *sequence,
+			      uint8_t active_channels)
+{
+	uint32_t cc = sequence->options->interval_us * 16U;
+	size_t block_size = sequence->buffer_size / 2U;
+
+	/* The internal timer only works for a single channel */
+	if ((active_channels > 1) || (sequence->oversampling != 0U)) {
+		LOG_ERR("Continuous mode needs a single channel, "
+			"without oversampling");
+		return -ENOTSUP;
+	}
+
+	if ((cc < SAMPLERATE_CC_MIN) || (cc > SAMPLERATE_CC_MAX)) {
+		LOG_ERR("Sampling interval %u us is not valid",
+			sequence->options->interval_us);
+		return -EINVAL;
+	}
+
+	if ((block_size == 0U) ||
+	    ((block_size % sizeof(nrf_saadc_value_t)) != 0U) ||
+	    (block_size / sizeof(nrf_saadc_value_t)) > UINT16_MAX) {
+		LOG_ERR("Buffer size %u is not valid", sequence->buffer_size);
+		return -EINVAL;
+	}
+
+	m_data.block = sequence->buffer;
+	m_data.block_len = block_size / sizeof(nrf_saadc_value_t);
+
+	nrf_saadc_buffer_init(NRF_SAADC, m_data.block, m_data.block_len);
+	nrf_saadc_continuous_mode_enable(NRF_SAADC, cc);
+	nrf_saadc_event_clear(NRF_SAADC, NRF_SAADC_EVENT_STARTED);
+	nrf_saadc_int_enable(NRF_SAADC, NRF_SAADC_INT_STARTED);
+
+	return 0;
+}
+
+static void stop_continuous(void)
+{
+	nrf_saadc_int_disable(NRF_SAADC, NRF_SAADC_INT_STARTED);
+	nrf_saadc_continuous_mode_disable(NRF_SAADC);
+	nrf_saadc_task_trigger(NRF_SAADC, NRF_SAADC_TASK_STOP);
+	nrf_saadc_disable(NRF_SAADC);
+}
+
+static void continuous_block_done(struct device *dev)
+{
+	nrf_saadc_value_t *block = m_data.block;
+
+	/* Go on in the half latched at STARTED */
+	m_data.block = other_block(block);
+	nrf_saadc_task_trigger(NRF_SAADC, NRF_SAADC_TASK_START);
+
+	if (adc_context_on_block_done(&m_data.ctx, dev, block)) {
+		return;
+	}
+
+	stop_continuous();
+	adc_context_complete(&m_data.ctx, 0);
+}
+#endif /* CONFIG_ADC_CONTINUOUS */
+
 static int start_read(struct device *dev, const struct adc_sequence *sequence)
 {
 	int error;
@@ -321,6 +406,21 @@ static int start_read(struct device *dev, const struct adc_sequence *sequence)
 		return error;
 	}
 
+	if (sequence->options && sequence->options->block_callback) {
+#ifdef CONFIG_ADC_CONTINUOUS
+		error = prepare_continuous(sequence, active_channels);
+		if (error) {
+			return error;
+		}
+
+		adc_context_start_read(&m_data.ctx, sequence);
+
+		return adc_context_wait_for_completion(&m_data.ctx);
+#else
+		return -ENOTSUP;
+#endif /* CONFIG_ADC_CONTINUOUS */
+	}
+
 	error = check_buffer_size(sequence, active_channels);
 	if (error) {
 		return error;
@@ -372,10 +472,26 @@ static void saadc_irq_handler(void *param)
 	if (nrf_saadc_event_check(NRF_SAADC, NRF_SAADC_EVENT_END)) {
 		nrf_saadc_event_clear(NRF_SAADC, NRF_SAADC_EVENT_END);
 
+#ifdef CONFIG_ADC_CONTINUOUS
+		if (adc_context_is_continuous(&m_data.ctx)) {
+			continuous_block_done(dev);
+			return;
+		}
+#endif /* CONFIG_ADC_CONTINUOUS */
+
 		nrf_saadc_task_trigger(NRF_SAADC, NRF_SAADC_TASK_STOP);
 		nrf_saadc_disable(NRF_SAADC);
 
 		adc_context_on_sampling_done(&m_data.ctx, dev);
+#ifdef CONFIG_ADC_CONTINUOUS
+	} else if (adc_context_is_continuous(&m_data.ctx) &&
+		   nrf_saadc_event_check(NRF_SAADC,
+					 NRF_SAADC_EVENT_STARTED)) {
+		nrf_saadc_event_clear(NRF_SAADC, NRF_SAADC_EVENT_STARTED);
+
+		nrf_saadc_buffer_pointer_set(NRF_SAADC,
+					     other_block(m_data.block));
+#endif /* CONFIG_ADC_CONTINUOUS */
 	} else if (nrf_saadc_event_check(NRF_SAADC,
 					 NRF_SAADC_EVENT_CALIBRATEDONE)) {
 		nrf_saadc_event_clear(NRF_SAADC, NRF_SAADC_EVENT_CALIBRATEDONE);
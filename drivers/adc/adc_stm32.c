@@ -10,6 +10,7 @@
 #define DT_DRV_COMPAT st_stm32_adc
 
 #include <errno.h>
+#include <string.h>
 
 #include <drivers/adc.h>
 #include <device.h>
@@ -17,6 +18,11 @@
 #include <init.h>
 #include <soc.h>
 
+#ifdef CONFIG_ADC_STM32_DMA
+#include <dt-bindings/dma/stm32_dma.h>
+#include <drivers/dma.h>
+#endif
+
 #define ADC_CONTEXT_USES_KERNEL_TIMER
 #include "adc_context.h"
 
@@ -212,6 +218,15 @@ struct adc_stm32_data {
 #if defined(CONFIG_SOC_SERIES_STM32F0X) || defined(CONFIG_SOC_SERIES_STM32L0X)
 	int8_t acq_time_index;
 #endif
+#ifdef CONFIG_ADC_STM32_DMA
+	const char *dma_name;
+	struct device *dma_dev;
+	uint32_t dma_channel;
+	struct dma_config dma_cfg;
+	struct dma_block_config dma_blk;
+	/* Half of the buffer being filled in the continuous mode */
+	uint8_t dma_half;
+#endif
 };
 
 struct adc_stm32_cfg {
@@ -263,6 +278,151 @@ static void adc_stm32_start_conversion(struct device *dev)
 #endif
 }
 
+static void adc_stm32_enable_eoc_it(ADC_TypeDef *adc, bool enable)
+{
+#if defined(CONFIG_SOC_SERIES_STM32F0X) || \
+	defined(CONFIG_SOC_SERIES_STM32F3X) || \
+	defined(CONFIG_SOC_SERIES_STM32L0X) || \
+	defined(CONFIG_SOC_SERIES_STM32L4X) || \
+	defined(CONFIG_SOC_SERIES_STM32WBX) || \
+	defined(CONFIG_SOC_SERIES_STM32G4X) || \
+	defined(CONFIG_SOC_SERIES_STM32H7X)
+	if (enable) {
+		LL_ADC_EnableIT_EOC(adc);
+	} else {
+		LL_ADC_DisableIT_EOC(adc);
+	}
+#elif defined(CONFIG_SOC_SERIES_STM32F1X)
+	if (enable) {
+		LL_ADC_EnableIT_EOS(adc);
+	} else {
+		LL_ADC_DisableIT_EOS(adc);
+	}
+#else
+	if (enable) {
+		LL_ADC_EnableIT_EOCS(adc);
+	} else {
+		LL_ADC_DisableIT_EOCS(adc);
+	}
+#endif
+}
+
+#ifdef CONFIG_ADC_STM32_DMA
+static void adc_stm32_set_dma_transfer(ADC_TypeDef *adc, uint32_t transfer)
+{
+#if defined(CONFIG_SOC_SERIES_STM32H7X)
+	LL_ADC_REG_SetDataTransferMode(adc, transfer);
+#else
+	LL_ADC_REG_SetDMATransfer(adc, transfer);
+#endif
+}
+
+static void adc_stm32_stop_continuous(struct device *dev)
+{
+	const struct adc_stm32_cfg *config = dev->config;
+	struct adc_stm32_data *data = dev->data;
+	ADC_TypeDef *adc = (ADC_TypeDef *)config->base;
+
+	LL_ADC_REG_SetContinuousMode(adc, LL_ADC_REG_CONV_SINGLE);
+#if defined(CONFIG_SOC_SERIES_STM32F0X) || \
+	defined(CONFIG_SOC_SERIES_STM32F3X) || \
+	defined(CONFIG_SOC_SERIES_STM32L0X) || \
+	defined(CONFIG_SOC_SERIES_STM32L4X) || \
+	defined(CONFIG_SOC_SERIES_STM32WBX) || \
+	defined(CONFIG_SOC_SERIES_STM32G4X) || \
+	defined(CONFIG_SOC_SERIES_STM32H7X)
+	LL_ADC_REG_StopConversion(adc);
+#endif
+	adc_stm32_set_dma_transfer(adc, LL_ADC_REG_DMA_TRANSFER_NONE);
+	dma_stop(data->dma_dev, data->dma_channel);
+}
+
+/* Called at each half of the cyclic transfer, in the interrupt context. */
+static void adc_stm32_dma_callback(struct device *dma_dev, void *arg,
+				   uint32_t channel, int status)
+{
+	struct device *dev = arg;
+	struct adc_stm32_data *data = dev->data;
+	size_t block_len = data->ctx.sequence.buffer_size / 2U /
+			   sizeof(uint16_t);
+	uint16_t *block;
+
+	if (status < 0) {
+		LOG_ERR("DMA error %d", status);
+		adc_stm32_stop_continuous(dev);
+		adc_context_complete(&data->ctx, status);
+		return;
+	}
+
+	block = (uint16_t *)data->ctx.sequence.buffer +
+		data->dma_half * block_len;
+	data->dma_half ^= 1U;
+
+	if (!adc_context_on_block_done(&data->ctx, dev, block)) {
+		adc_stm32_stop_continuous(dev);
+		adc_context_complete(&data->ctx, 0);
+	}
+}
+
+/*
+ * Let the ADC convert back to back and a cyclic DMA transfer fill the two
+ * halves of the buffer, the DMA half and full transfer interrupts hand
+ * the blocks over.
+ */
+static int adc_stm32_prepare_continuous(struct device *dev,
+					const struct adc_sequence *sequence)
+{
+	const struct adc_stm32_cfg *config = dev->config;
+	struct adc_stm32_data *data = dev->data;
+	ADC_TypeDef *adc = (ADC_TypeDef *)config->base;
+	size_t block_size = sequence->buffer_size / 2U;
+	int err;
+
+	if (data->dma_dev == NULL) {
+		LOG_ERR("No DMA channel for continuous mode");
+		return -ENOTSUP;
+	}
+
+	/* No trigger timer is wired, the acquisition time sets the rate */
+	if (sequence->options->interval_us != 0U) {
+		LOG_ERR("Continuous mode only supports a zero interval");
+		return -ENOTSUP;
+	}
+
+	if ((block_size == 0U) ||
+	    ((block_size % (data->channel_count * sizeof(uint16_t))) != 0U)) {
+		LOG_ERR("Buffer size %u is not valid", sequence->buffer_size);
+		return -EINVAL;
+	}
+
+	memset(&data->dma_blk, 0, sizeof(data->dma_blk));
+	data->dma_blk.source_address = (uint32_t)&adc->DR;
+	data->dma_blk.source_addr_adj = DMA_ADDR_ADJ_NO_CHANGE;
+	data->dma_blk.dest_address = (uint32_t)sequence->buffer;
+	data->dma_blk.dest_addr_adj = DMA_ADDR_ADJ_INCREMENT;
+	data->dma_blk.block_size = sequence->buffer_size;
+	data->dma_cfg.head_block = &data->dma_blk;
+	data->dma_cfg.user_data = dev;
+	data->dma_half = 0U;
+
+	err = dma_config(data->dma_dev, data->dma_channel, &data->dma_cfg);
+	if (err) {
+		return err;
+	}
+
+	err = dma_start(data->dma_dev, data->dma_channel);
+	if (err) {
+		return err;
+	}
+
+	adc_stm32_enable_eoc_it(adc, false);
+	adc_stm32_set_dma_transfer(adc, LL_ADC_REG_DMA_TRANSFER_UNLIMITED);
+	LL_ADC_REG_SetContinuousMode(adc, LL_ADC_REG_CONV_CONTINUOUS);
+
+	return 0;
+}
+#endif /* CONFIG_ADC_STM32_DMA */
+
 static int start_read(struct device *dev, const struct adc_sequence *sequence)
 {
 	const struct adc_stm32_cfg *config = dev->config;
@@ -336,28 +496,33 @@ static int start_read(struct device *dev, const struct adc_sequence *sequence)
 #endif
 	data->channel_count = 1;
 
-	err = check_buffer_size(sequence, data->channel_count);
-	if (err) {
-		return err;
+	if (!(sequence->options && sequence->options->block_callback)) {
+		err = check_buffer_size(sequence, data->channel_count);
+		if (err) {
+			return err;
+		}
 	}
 
 #if !defined(CONFIG_SOC_SERIES_STM32F1X)
 	LL_ADC_SetResolution(adc, resolution);
 #endif
 
-#if defined(CONFIG_SOC_SERIES_STM32F0X) || \
-	defined(CONFIG_SOC_SERIES_STM32F3X) || \
-	defined(CONFIG_SOC_SERIES_STM32L0X) || \
-	defined(CONFIG_SOC_SERIES_STM32L4X) || \
-	defined(CONFIG_SOC_SERIES_STM32WBX) || \
-	defined(CONFIG_SOC_SERIES_STM32G4X) || \
-	defined(CONFIG_SOC_SERIES_STM32H7X)
-	LL_ADC_EnableIT_EOC(adc);
-#elif defined(CONFIG_SOC_SERIES_STM32F1X)
-	LL_ADC_EnableIT_EOS(adc);
+	if (sequence->options && sequence->options->block_callback) {
+#ifdef CONFIG_ADC_STM32_DMA
+		err = adc_stm32_prepare_continuous(dev, sequence);
+		if (err) {
+			return err;
+		}
+
+		adc_context_start_read(&data->ctx, sequence);
+
+		return adc_context_wait_for_completion(&data->ctx);
 #else
-	LL_ADC_EnableIT_EOCS(adc);
-#endif
+		return -ENOTSUP;
+#endif /* CONFIG_ADC_STM32_DMA */
+	}
+
+	adc_stm32_enable_eoc_it(adc, true);
 
 	adc_context_start_read(&data->ctx, sequence);
 
@@ -553,6 +718,15 @@ static int adc_stm32_init(struct device *dev)
 	LOG_DBG("Initializing....");
 
 	data->dev = dev;
+#ifdef CONFIG_ADC_STM32_DMA
+	if (data->dma_name != NULL) {
+		data->dma_dev = device_get_binding(data->dma_name);
+		if (!data->dma_dev) {
+			LOG_ERR("%s device not found", data->dma_name);
+			return -ENODEV;
+		}
+	}
+#endif
 #if defined(CONFIG_SOC_SERIES_STM32F0X) || defined(CONFIG_SOC_SERIES_STM32L0X)
 	/*
 	 * All conversion time for all channels on one ADC instance for F0 and
@@ -706,6 +880,33 @@ static const struct adc_driver_api api_stm32_driver_api = {
 #endif
 };
 
+#ifdef CONFIG_ADC_STM32_DMA
+#define ADC_DMA_CHANNEL_INIT(index)					\
+	.dma_name = DT_INST_DMAS_LABEL_BY_NAME(index, rx),		\
+	.dma_channel = DT_INST_DMAS_CELL_BY_NAME(index, rx, channel),	\
+	.dma_cfg = {							\
+		.dma_slot = DT_INST_DMAS_CELL_BY_NAME(index, rx, slot),	\
+		.channel_direction = PERIPHERAL_TO_MEMORY,		\
+		.source_data_size = 2,					\
+		.dest_data_size = 2,					\
+		.source_burst_length = 1,				\
+		.dest_burst_length = 1,					\
+		.channel_priority = STM32_DMA_CONFIG_PRIORITY(		\
+			DT_INST_DMAS_CELL_BY_NAME(index, rx,		\
+						  channel_config)),	\
+		.complete_callback_en = 1,				\
+		.cyclic = 1,						\
+		.dma_callback = adc_stm32_dma_callback,			\
+		.block_count = 1,					\
+	},
+
+#define ADC_DMA_CHANNEL(index)						\
+	COND_CODE_1(DT_INST_DMAS_HAS_NAME(index, rx),			\
+		    (ADC_DMA_CHANNEL_INIT(index)), ())
+#else
+#define ADC_DMA_CHANNEL(index)
+#endif /* CONFIG_ADC_STM32_DMA */
+
 #define STM32_ADC_INIT(index)						\
 									\
 static void adc_stm32_cfg_func_##index(void);				\
@@ -722,6 +923,7 @@ static struct adc_stm32_data adc_stm32_data_##index = {			\
 	ADC_CONTEXT_INIT_TIMER(adc_stm32_data_##index, ctx),		\
 	ADC_CONTEXT_INIT_LOCK(adc_stm32_data_##index, ctx),		\
 	ADC_CONTEXT_INIT_SYNC(adc_stm32_data_##index, ctx),		\
+	ADC_DMA_CHANNEL(index)						\
 };									\
 									\
 DEVICE_AND_API_INIT(adc_##index, DT_INST_LABEL(index),	\
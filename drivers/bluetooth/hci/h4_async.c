@@ -0,0 +1,580 @@
+/* h4_async.c - H:4 UART based Bluetooth driver using the UART async API */
+
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stddef.h>
+
+#include <zephyr.h>
+#include <arch/cpu.h>
+
+#include <init.h>
+#include <drivers/uart.h>
+#include <sys/util.h>
+#include <sys/byteorder.h>
+#include <sys/atomic.h>
+#include <string.h>
+
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/hci.h>
+#include <drivers/bluetooth/hci_driver.h>
+
+#define BT_DBG_ENABLED IS_ENABLED(CONFIG_BT_DEBUG_HCI_DRIVER)
+#define LOG_MODULE_NAME bt_driver
+#include "common/log.h"
+
+#include "../util.h"
+
+#define H4_NONE 0x00
+#define H4_CMD  0x01
+#define H4_ACL  0x02
+#define H4_SCO  0x03
+#define H4_EVT  0x04
+
+/* Reception is split into stages, each of which is a single DMA transfer
+ * of exactly known length. This lets the packet payload land directly in
+ * the net_buf it is handed to the host in. The gap between two transfers
+ * is covered by hardware flow control, which H:4 requires anyway.
+ */
+enum rx_state {
+	RX_TYPE,
+	RX_HDR,
+	RX_META,
+	RX_PAYLOAD,
+	RX_DISCARD,
+	RX_DEFERRED,
+};
+
+static K_KERNEL_STACK_DEFINE(rx_thread_stack, CONFIG_BT_RX_STACK_SIZE);
+static struct k_thread rx_thread_data;
+
+static struct {
+	struct net_buf *buf;
+	struct k_fifo   fifo;
+	struct k_poll_signal alloc;
+
+	enum rx_state   state;
+	uint16_t    remaining;
+	uint16_t    discard;
+	uint16_t    received;
+
+	bool     discardable;
+
+	uint8_t     hdr_len;
+
+	uint8_t     type;
+	union {
+		struct bt_hci_evt_hdr evt;
+		struct bt_hci_acl_hdr acl;
+		uint8_t hdr[4];
+	};
+
+	uint8_t     discard_buf[32];
+} rx = {
+	.fifo = Z_FIFO_INITIALIZER(rx.fifo),
+	.alloc = K_POLL_SIGNAL_INITIALIZER(rx.alloc),
+};
+
+static struct {
+	uint8_t type;
+	atomic_t busy;
+	struct net_buf *buf;
+	struct net_buf *frag;
+	struct k_fifo   fifo;
+} tx = {
+	.fifo = Z_FIFO_INITIALIZER(tx.fifo),
+};
+
+static struct device *h4_dev;
+
+static void rx_start(uint8_t *buf, size_t len)
+{
+	int err;
+
+	rx.received = 0U;
+
+	err = uart_rx_enable(h4_dev, buf, len, SYS_FOREVER_MS);
+	if (err) {
+		BT_ERR("Unable to enable RX (err %d)", err);
+	}
+}
+
+static void reset_rx(void)
+{
+	rx.state = RX_TYPE;
+	rx.type = H4_NONE;
+	rx.remaining = 0U;
+	rx.hdr_len = 0U;
+	rx.discardable = false;
+}
+
+static struct net_buf *get_rx(k_timeout_t timeout)
+{
+	BT_DBG("type 0x%02x, evt 0x%02x", rx.type, rx.evt.evt);
+
+	if (rx.type == H4_EVT) {
+		return bt_buf_get_evt(rx.evt.evt, rx.discardable, timeout);
+	}
+
+	return bt_buf_get_rx(BT_BUF_ACL_IN, timeout);
+}
+
+static void rx_discard(void)
+{
+	rx.state = RX_DISCARD;
+	rx_start(rx.discard_buf, MIN(rx.discard, sizeof(rx.discard_buf)));
+}
+
+static void rx_complete(void)
+{
+	struct net_buf *buf = rx.buf;
+	uint8_t evt_flags;
+
+	rx.buf = NULL;
+
+	BT_DBG("Payload (len %u): %s", buf->len, bt_hex(buf->data, buf->len));
+
+	if (rx.type == H4_EVT) {
+		evt_flags = bt_hci_evt_get_flags(rx.evt.evt);
+		bt_buf_set_type(buf, BT_BUF_EVT);
+	} else {
+		evt_flags = BT_HCI_EVT_FLAG_RECV;
+		bt_buf_set_type(buf, BT_BUF_ACL_IN);
+	}
+
+	if (evt_flags & BT_HCI_EVT_FLAG_RECV_PRIO) {
+		BT_DBG("Calling bt_recv_prio(%p)", buf);
+		bt_recv_prio(buf);
+	}
+
+	if (evt_flags & BT_HCI_EVT_FLAG_RECV) {
+		BT_DBG("Putting buf %p to rx fifo", buf);
+		net_buf_put(&rx.fifo, buf);
+	}
+}
+
+/* Set up the payload stage once rx.buf is available. Called both from the
+ * UART callback and, if allocation had to be deferred, from rx_thread.
+ */
+static void rx_payload(void)
+{
+	if (rx.hdr_len + rx.remaining > net_buf_tailroom(rx.buf)) {
+		BT_ERR("Not enough space in buffer");
+		net_buf_unref(rx.buf);
+		rx.buf = NULL;
+		rx.discard = rx.remaining;
+		reset_rx();
+		rx_discard();
+		return;
+	}
+
+	net_buf_add_mem(rx.buf, rx.hdr, rx.hdr_len);
+
+	if (!rx.remaining) {
+		rx_complete();
+		reset_rx();
+		rx_start(&rx.type, 1);
+		return;
+	}
+
+	rx.state = RX_PAYLOAD;
+	rx_start(net_buf_tail(rx.buf), rx.remaining);
+}
+
+static void rx_alloc(void)
+{
+	rx.buf = get_rx(K_NO_WAIT);
+	if (rx.buf) {
+		BT_DBG("Allocated rx.buf %p", rx.buf);
+		rx_payload();
+		return;
+	}
+
+	if (rx.discardable) {
+		BT_WARN("Discarding event 0x%02x", rx.evt.evt);
+		rx.discard = rx.remaining;
+		reset_rx();
+		if (rx.discard) {
+			rx_discard();
+		} else {
+			rx_start(&rx.type, 1);
+		}
+		return;
+	}
+
+	/* Leave RX disabled, flow control holds off the controller until
+	 * rx_thread has a buffer for us.
+	 */
+	BT_WARN("Failed to allocate, deferring to rx_thread");
+	rx.state = RX_DEFERRED;
+	k_poll_signal_raise(&rx.alloc, 0);
+}
+
+static void rx_type(void)
+{
+	switch (rx.type) {
+	case H4_EVT:
+		rx.hdr_len = sizeof(rx.evt);
+		break;
+	case H4_ACL:
+		rx.hdr_len = sizeof(rx.acl);
+		break;
+	default:
+		BT_ERR("Unknown H:4 type 0x%02x", rx.type);
+		reset_rx();
+		rx_start(&rx.type, 1);
+		return;
+	}
+
+	rx.state = RX_HDR;
+	rx_start(rx.hdr, rx.hdr_len);
+}
+
+static void rx_hdr(void)
+{
+	if (rx.type == H4_ACL) {
+		rx.remaining = sys_le16_to_cpu(rx.acl.len);
+		BT_DBG("Got ACL header. Payload %u bytes", rx.remaining);
+		rx_alloc();
+		return;
+	}
+
+	switch (rx.evt.evt) {
+	case BT_HCI_EVT_LE_META_EVENT:
+		/* The subevent code decides whether this is discardable */
+		if (rx.evt.len) {
+			rx.state = RX_META;
+			rx.hdr_len++;
+			rx_start(&rx.hdr[sizeof(rx.evt)], 1);
+			return;
+		}
+		break;
+#if defined(CONFIG_BT_BREDR)
+	case BT_HCI_EVT_INQUIRY_RESULT_WITH_RSSI:
+	case BT_HCI_EVT_EXTENDED_INQUIRY_RESULT:
+		rx.discardable = true;
+		break;
+#endif
+	}
+
+	rx.remaining = rx.evt.len;
+	BT_DBG("Got event header. Payload %u bytes", rx.remaining);
+	rx_alloc();
+}
+
+static void rx_meta(void)
+{
+	if (rx.hdr[sizeof(rx.evt)] == BT_HCI_EVT_LE_ADVERTISING_REPORT) {
+		BT_DBG("Marking adv report as discardable");
+		rx.discardable = true;
+	}
+
+	rx.remaining = rx.evt.len - 1;
+	BT_DBG("Got event header. Payload %u bytes", rx.evt.len);
+	rx_alloc();
+}
+
+/* The current transfer has ended, either with its buffer full or because
+ * reception was stopped. Move on to the next stage.
+ */
+static void rx_disabled(void)
+{
+	switch (rx.state) {
+	case RX_TYPE:
+		if (!rx.received) {
+			rx_start(&rx.type, 1);
+			return;
+		}
+
+		rx_type();
+		break;
+	case RX_HDR:
+		rx_hdr();
+		break;
+	case RX_META:
+		rx_meta();
+		break;
+	case RX_PAYLOAD:
+		net_buf_add(rx.buf, rx.received);
+		rx_complete();
+		reset_rx();
+		rx_start(&rx.type, 1);
+		break;
+	case RX_DISCARD:
+		rx.discard -= rx.received;
+		if (rx.discard) {
+			rx_discard();
+			return;
+		}
+
+		reset_rx();
+		rx_start(&rx.type, 1);
+		break;
+	case RX_DEFERRED:
+		break;
+	}
+}
+
+static void rx_stopped(enum uart_rx_stop_reason reason)
+{
+	BT_ERR("RX stopped (reason %u)", reason);
+
+	/* The stream is out of sync, drop whatever was in progress and
+	 * start over from the packet type.
+	 */
+	if (rx.buf) {
+		net_buf_unref(rx.buf);
+		rx.buf = NULL;
+	}
+
+	rx.received = 0U;
+	reset_rx();
+}
+
+static void tx_next(void);
+
+static void tx_done(void)
+{
+	if (tx.frag) {
+		tx.frag = tx.frag->frags;
+	} else {
+		/* The type byte went out on its own */
+		tx.frag = tx.buf;
+	}
+
+	if (tx.frag) {
+		tx_next();
+		return;
+	}
+
+	net_buf_unref(tx.buf);
+	tx.buf = NULL;
+	tx_next();
+}
+
+static void tx_start(const uint8_t *data, size_t len)
+{
+	int err;
+
+	err = uart_tx(h4_dev, data, len, SYS_FOREVER_MS);
+	if (err) {
+		BT_ERR("Unable to start TX (err %d)", err);
+		net_buf_unref(tx.buf);
+		tx.buf = NULL;
+		atomic_clear(&tx.busy);
+	}
+}
+
+/* Called with tx.busy set, either from h4_send or from the UART callback
+ * once the previous transfer is done.
+ */
+static void tx_next(void)
+{
+	if (tx.buf) {
+		tx_start(tx.frag->data, tx.frag->len);
+		return;
+	}
+
+	tx.buf = net_buf_get(&tx.fifo, K_NO_WAIT);
+	if (!tx.buf) {
+		atomic_clear(&tx.busy);
+
+		/* h4_send may have queued a buffer after our check but
+		 * before busy was cleared.
+		 */
+		if (!k_fifo_is_empty(&tx.fifo) &&
+		    atomic_cas(&tx.busy, 0, 1)) {
+			tx_next();
+		}
+
+		return;
+	}
+
+	switch (bt_buf_get_type(tx.buf)) {
+	case BT_BUF_ACL_OUT:
+		tx.type = H4_ACL;
+		break;
+	case BT_BUF_CMD:
+		tx.type = H4_CMD;
+		break;
+	default:
+		BT_ERR("Unknown buffer type");
+		net_buf_unref(tx.buf);
+		tx.buf = NULL;
+		tx_next();
+		return;
+	}
+
+	/* Fragments go out one transfer each, straight from the buffers.
+	 * The type byte normally goes in the headroom reserved for it.
+	 */
+	if (net_buf_headroom(tx.buf)) {
+		net_buf_push_u8(tx.buf, tx.type);
+		tx.frag = tx.buf;
+		tx_start(tx.frag->data, tx.frag->len);
+	} else {
+		tx.frag = NULL;
+		tx_start(&tx.type, 1);
+	}
+}
+
+static void bt_uart_cb(struct device *unused, struct uart_event *evt,
+		       void *user_data)
+{
+	ARG_UNUSED(unused);
+	ARG_UNUSED(user_data);
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+		tx_done();
+		break;
+	case UART_TX_ABORTED:
+		BT_ERR("TX aborted");
+		net_buf_unref(tx.buf);
+		tx.buf = NULL;
+		tx_next();
+		break;
+	case UART_RX_RDY:
+		rx.received += evt->data.rx.len;
+		break;
+	case UART_RX_STOPPED:
+		rx_stopped(evt->data.rx_stop.reason);
+		break;
+	case UART_RX_DISABLED:
+		rx_disabled();
+		break;
+	case UART_RX_BUF_REQUEST:
+	case UART_RX_BUF_RELEASED:
+	default:
+		break;
+	}
+}
+
+static void rx_thread(void *p1, void *p2, void *p3)
+{
+	struct k_poll_event events[] = {
+		K_POLL_EVENT_STATIC_INITIALIZER(K_POLL_TYPE_SIGNAL,
+						K_POLL_MODE_NOTIFY_ONLY,
+						&rx.alloc, 0),
+		K_POLL_EVENT_STATIC_INITIALIZER(K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+						K_POLL_MODE_NOTIFY_ONLY,
+						&rx.fifo, 0),
+	};
+	struct net_buf *buf;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	BT_DBG("started");
+
+	while (1) {
+		k_poll(events, ARRAY_SIZE(events), K_FOREVER);
+
+		/* The UART callback leaves RX disabled when it could not
+		 * get a buffer, and signals us to block for one.
+		 */
+		if (events[0].state == K_POLL_STATE_SIGNALED) {
+			k_poll_signal_reset(&rx.alloc);
+			rx.buf = get_rx(K_FOREVER);
+			BT_DBG("Got rx.buf %p", rx.buf);
+			rx_payload();
+		}
+
+		events[0].state = K_POLL_STATE_NOT_READY;
+		events[1].state = K_POLL_STATE_NOT_READY;
+
+		buf = net_buf_get(&rx.fifo, K_NO_WAIT);
+		while (buf) {
+			BT_DBG("Calling bt_recv(%p)", buf);
+			bt_recv(buf);
+
+			/* Give other threads a chance to run if the UART
+			 * is receiving data so fast that rx.fifo never
+			 * or very rarely goes empty.
+			 */
+			k_yield();
+
+			buf = net_buf_get(&rx.fifo, K_NO_WAIT);
+		}
+	}
+}
+
+static int h4_send(struct net_buf *buf)
+{
+	BT_DBG("buf %p type %u len %u", buf, bt_buf_get_type(buf), buf->len);
+
+	net_buf_put(&tx.fifo, buf);
+
+	if (atomic_cas(&tx.busy, 0, 1)) {
+		tx_next();
+	}
+
+	return 0;
+}
+
+/** Setup the HCI transport, which usually means to reset the Bluetooth IC
+  *
+  * @param dev The device structure for the bus connecting to the IC
+  *
+  * @return 0 on success, negative error value on failure
+  */
+int __weak bt_hci_transport_setup(struct device *dev)
+{
+	return 0;
+}
+
+static int h4_open(void)
+{
+	int ret;
+
+	BT_DBG("");
+
+	ret = bt_hci_transport_setup(h4_dev);
+	if (ret < 0) {
+		return -EIO;
+	}
+
+	ret = uart_callback_set(h4_dev, bt_uart_cb, NULL);
+	if (ret < 0) {
+		return ret;
+	}
+
+	k_thread_create(&rx_thread_data, rx_thread_stack,
+			K_KERNEL_STACK_SIZEOF(rx_thread_stack),
+			rx_thread, NULL, NULL, NULL,
+			K_PRIO_COOP(CONFIG_BT_RX_PRIO),
+			0, K_NO_WAIT);
+
+	reset_rx();
+	rx_start(&rx.type, 1);
+
+	return 0;
+}
+
+static const struct bt_hci_driver drv = {
+	.name		= "H:4",
+	.bus		= BT_HCI_DRIVER_BUS_UART,
+	.open		= h4_open,
+	.send		= h4_send,
+};
+
+static int bt_uart_init(struct device *unused)
+{
+	ARG_UNUSED(unused);
+
+	h4_dev = device_get_binding(CONFIG_BT_UART_ON_DEV_NAME);
+	if (!h4_dev) {
+		return -EINVAL;
+	}
+
+	bt_hci_driver_register(&drv);
+
+	return 0;
+}
+
+SYS_INIT(bt_uart_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE);
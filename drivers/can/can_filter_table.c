@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <sys/util.h>
+#include "can_filter_table.h"
+
+#define STD_ID_MASK BIT_MASK(11)
+#define EXT_ID_MASK BIT_MASK(29)
+
+static inline uint32_t filter_id(const struct zcan_filter *filter)
+{
+	return (filter->id_type == CAN_STANDARD_IDENTIFIER) ?
+		filter->std_id : filter->ext_id;
+}
+
+static inline uint32_t filter_mask(const struct zcan_filter *filter)
+{
+	return (filter->id_type == CAN_STANDARD_IDENTIFIER) ?
+		filter->std_id_mask : filter->ext_id_mask;
+}
+
+static inline bool filter_is_single(const struct zcan_filter *filter)
+{
+	return filter_mask(filter) ==
+		((filter->id_type == CAN_STANDARD_IDENTIFIER) ?
+		 STD_ID_MASK : EXT_ID_MASK);
+}
+
+static inline uint32_t id_hash(uint32_t id_type, uint32_t id)
+{
+	/* Multiplicative hashing, the top bits are the best mixed */
+	return ((id ^ (id_type << 29)) * 2654435761U) >>
+		(32 - CONFIG_CAN_FILTER_TABLE_HASH_BITS);
+}
+
+static int16_t *filter_list(struct can_filter_table *table,
+			    const struct zcan_filter *filter)
+{
+	if (filter_is_single(filter)) {
+		return &table->buckets[id_hash(filter->id_type,
+					       filter_id(filter))];
+	}
+
+	return &table->masked;
+}
+
+static bool filter_match(const struct zcan_filter *filter,
+			 const struct zcan_frame *frame)
+{
+	uint32_t id;
+
+	if (frame->id_type != filter->id_type) {
+		return false;
+	}
+
+	if ((frame->rtr ^ filter->rtr) & filter->rtr_mask) {
+		return false;
+	}
+
+	id = (frame->id_type == CAN_STANDARD_IDENTIFIER) ?
+		frame->std_id : frame->ext_id;
+
+	return ((id ^ filter_id(filter)) & filter_mask(filter)) == 0U;
+}
+
+void can_filter_table_init(struct can_filter_table *table,
+			   struct can_filter_entry *entries, uint16_t size)
+{
+	table->entries = entries;
+	table->size = size;
+	table->masked = -1;
+
+	for (int i = 0; i < ARRAY_SIZE(table->buckets); i++) {
+		table->buckets[i] = -1;
+	}
+
+	for (int i = 0; i < size; i++) {
+		entries[i].cb = NULL;
+		entries[i].next = -1;
+	}
+}
+
+int can_filter_table_add(struct can_filter_table *table,
+			 can_rx_callback_t cb, void *cb_arg,
+			 const struct zcan_filter *filter)
+{
+	struct can_filter_entry *entry;
+	int16_t *head;
+	int index;
+
+	for (index = 0; index < table->size; index++) {
+		if (table->entries[index].cb == NULL) {
+			break;
+		}
+	}
+
+	if (index == table->size) {
+		return CAN_NO_FREE_FILTER;
+	}
+
+	entry = &table->entries[index];
+	entry->filter = *filter;
+	entry->cb = cb;
+	entry->cb_arg = cb_arg;
+
+	head = filter_list(table, filter);
+	entry->next = *head;
+	*head = index;
+
+	return index;
+}
+
+void can_filter_table_remove(struct can_filter_table *table, int index)
+{
+	struct can_filter_entry *entry;
+	int16_t *link;
+
+	if (index < 0 || index >= table->size ||
+	    table->entries[index].cb == NULL) {
+		return;
+	}
+
+	entry = &table->entries[index];
+	link = filter_list(table, &entry->filter);
+	while (*link != index) {
+		link = &table->entries[*link].next;
+	}
+
+	*link = entry->next;
+	entry->next = -1;
+	entry->cb = NULL;
+}
+
+static int dispatch_list(const struct can_filter_table *table, int16_t index,
+			 const struct zcan_frame *frame)
+{
+	const struct can_filter_entry *entry;
+	struct zcan_frame tmp;
+	int count = 0;
+
+	for (; index >= 0; index = entry->next) {
+		entry = &table->entries[index];
+		if (!filter_match(&entry->filter, frame)) {
+			continue;
+		}
+
+		/* Make a temporary copy in case the user modifies the frame */
+		tmp = *frame;
+		entry->cb(&tmp, entry->cb_arg);
+		count++;
+	}
+
+	return count;
+}
+
+int can_filter_table_dispatch(const struct can_filter_table *table,
+			      const struct zcan_frame *frame)
+{
+	uint32_t id = (frame->id_type == CAN_STANDARD_IDENTIFIER) ?
+		frame->std_id : frame->ext_id;
+	int count;
+
+	count = dispatch_list(table,
+			      table->buckets[id_hash(frame->id_type, id)],
+			      frame);
+	count += dispatch_list(table, table->masked, frame);
+
+	return count;
+}
+
+/* Smallest filter accepting the frames of both, which have the same type */
+static struct zcan_filter filter_union(const struct zcan_filter *a,
+				       const struct zcan_filter *b)
+{
+	struct zcan_filter u = *a;
+	uint32_t mask;
+
+	mask = filter_mask(a) & filter_mask(b) &
+	       ~(filter_id(a) ^ filter_id(b));
+	u.rtr_mask = a->rtr_mask & b->rtr_mask & ~(a->rtr ^ b->rtr);
+	u.rtr &= u.rtr_mask;
+
+	if (u.id_type == CAN_STANDARD_IDENTIFIER) {
+		u.std_id_mask = mask;
+		u.std_id = filter_id(a) & mask;
+	} else {
+		u.ext_id_mask = mask;
+		u.ext_id = filter_id(a) & mask;
+	}
+
+	return u;
+}
+
+/* Number of identifier bits the union of a and b still compares */
+static int union_bits(const struct zcan_filter *a,
+		      const struct zcan_filter *b)
+{
+	if (a->id_type != b->id_type) {
+		return -1;
+	}
+
+	return popcount(filter_mask(a) & filter_mask(b) &
+			~(filter_id(a) ^ filter_id(b)));
+}
+
+/*
+ * Greedy merging: each attached filter is added to the output, and once
+ * it is full the two filters whose union accepts the fewest identifiers
+ * are merged, the new filter included.
+ */
+int can_filter_table_merge(const struct can_filter_table *table,
+			   struct zcan_filter *out, int max)
+{
+	const struct zcan_filter *filter;
+	int best_i, best_j, best, bits;
+	int n = 0;
+
+	for (int k = 0; k < table->size; k++) {
+		if (table->entries[k].cb == NULL) {
+			continue;
+		}
+
+		filter = &table->entries[k].filter;
+
+		/* Skip filters already covered */
+		for (int i = 0; i < n; i++) {
+			if (union_bits(&out[i], filter) ==
+			    popcount(filter_mask(&out[i])) &&
+			    (out[i].rtr_mask & ~filter->rtr_mask) == 0U &&
+			    ((out[i].rtr ^ filter->rtr) & out[i].rtr_mask) ==
+			    0U) {
+				filter = NULL;
+				break;
+			}
+		}
+
+		if (filter == NULL) {
+			continue;
+		}
+
+		if (n < max) {
+			out[n++] = *filter;
+			continue;
+		}
+
+		/* Index n stands for the new filter */
+		best = -1;
+		best_i = 0;
+		best_j = 0;
+		for (int i = 0; i < n; i++) {
+			for (int j = i + 1; j <= n; j++) {
+				bits = union_bits(&out[i],
+						  (j == n) ? filter : &out[j]);
+				if (bits > best) {
+					best = bits;
+					best_i = i;
+					best_j = j;
+				}
+			}
+		}
+
+		if (best < 0) {
+			return -ENOSPC;
+		}
+
+		out[best_i] = filter_union(&out[best_i],
+					   (best_j == n) ? filter :
+					   &out[best_j]);
+		if (best_j != n) {
+			out[best_j] = *filter;
+		}
+	}
+
+	return n;
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Table of the receive filters attached to a CAN controller.
+ *
+ * Filters matching a single identifier are hashed by identifier, so a
+ * received frame is only compared to the filters of its hash bucket and
+ * to the filters with masked identifier bits. can_filter_table_merge()
+ * computes a few mask filters accepting at least the frames of all the
+ * attached filters, for controllers with only a few hardware filters.
+ *
+ * The table is not locked, the driver serializes the calls.
+ */
+
+#ifndef ZEPHYR_DRIVERS_CAN_CAN_FILTER_TABLE_H_
+#define ZEPHYR_DRIVERS_CAN_CAN_FILTER_TABLE_H_
+
+#include <drivers/can.h>
+
+#define CAN_FILTER_TABLE_BUCKETS BIT(CONFIG_CAN_FILTER_TABLE_HASH_BITS)
+
+struct can_filter_entry {
+	struct zcan_filter filter;
+	can_rx_callback_t cb;
+	void *cb_arg;
+	/* Next entry of the bucket or of the masked list, -1 at the end */
+	int16_t next;
+};
+
+struct can_filter_table {
+	struct can_filter_entry *entries;
+	uint16_t size;
+	/* Heads of the single identifier buckets and of the masked list */
+	int16_t buckets[CAN_FILTER_TABLE_BUCKETS];
+	int16_t masked;
+};
+
+/* Initialize a table of size entries, all free. */
+void can_filter_table_init(struct can_filter_table *table,
+			   struct can_filter_entry *entries, uint16_t size);
+
+/* Add a filter, returns its index or CAN_NO_FREE_FILTER. */
+int can_filter_table_add(struct can_filter_table *table,
+			 can_rx_callback_t cb, void *cb_arg,
+			 const struct zcan_filter *filter);
+
+/* Remove the filter at index, as returned by can_filter_table_add(). */
+void can_filter_table_remove(struct can_filter_table *table, int index);
+
+/* Call the callbacks of the filters matching frame, returns their number. */
+int can_filter_table_dispatch(const struct can_filter_table *table,
+			      const struct zcan_frame *frame);
+
+/*
+ * Merge the attached filters into at most max filters, written to out.
+ * Returns the number of filters written, 0 if no filter is attached, or
+ * -ENOSPC if max is too small to hold both identifier types.
+ */
+int can_filter_table_merge(const struct can_filter_table *table,
+			   struct zcan_filter *out, int max);
+
+#endif /* ZEPHYR_DRIVERS_CAN_CAN_FILTER_TABLE_H_ */
@@ -271,6 +271,110 @@ const int mcp2515_set_mode(struct device *dev, uint8_t mcp2515_mode)
 	return 0;
 }
 
+#ifdef CONFIG_CAN_MCP2515_HW_FILTER
+/* Acceptance filter or mask registers, SIDH to EID0 */
+static void mcp2515_convert_id_to_regs(uint32_t id_type, uint32_t id,
+				       uint8_t *regs)
+{
+	if (id_type == CAN_STANDARD_IDENTIFIER) {
+		regs[0] = id >> 3;
+		regs[1] = (id & 0x07) << 5;
+		regs[2] = 0U;
+		regs[3] = 0U;
+	} else {
+		regs[0] = id >> 21;
+		regs[1] = (((id >> 18) & 0x07) << 5) | ((id >> 16) & 0x03);
+		regs[2] = id >> 8;
+		regs[3] = id;
+	}
+}
+
+/*
+ * Program the attached filters, merged into one filter per receive buffer.
+ * RXM0 with RXF0-1 select RXB0, RXM1 with RXF2-5 select RXB1. The device
+ * must be in configuration mode.
+ */
+static int mcp2515_set_hw_filters(struct device *dev)
+{
+	static const uint8_t rxf_addr[] = {
+		MCP2515_ADDR_RXF0SIDH, MCP2515_ADDR_RXF1SIDH,
+		MCP2515_ADDR_RXF2SIDH, MCP2515_ADDR_RXF3SIDH,
+		MCP2515_ADDR_RXF4SIDH, MCP2515_ADDR_RXF5SIDH,
+	};
+	struct mcp2515_data *dev_data = DEV_DATA(dev);
+	struct zcan_filter hw[MCP2515_RX_CNT];
+	const struct zcan_filter *filter;
+	uint8_t rxm = BIT(6) | BIT(5);
+	uint8_t regs[4];
+	int ret = 0;
+	int n;
+
+	n = can_filter_table_merge(&dev_data->filters, hw, ARRAY_SIZE(hw));
+	if (n > 0) {
+		if (n == 1) {
+			hw[1] = hw[0];
+		}
+
+		for (int i = 0; i < MCP2515_RX_CNT && !ret; i++) {
+			mcp2515_convert_id_to_regs(hw[i].id_type,
+				(hw[i].id_type == CAN_STANDARD_IDENTIFIER) ?
+				hw[i].std_id_mask : hw[i].ext_id_mask, regs);
+			ret = mcp2515_cmd_write_reg(dev,
+				i ? MCP2515_ADDR_RXM1SIDH :
+				MCP2515_ADDR_RXM0SIDH, regs, sizeof(regs));
+		}
+
+		for (int i = 0; i < ARRAY_SIZE(rxf_addr) && !ret; i++) {
+			filter = &hw[(i < 2) ? 0 : 1];
+			mcp2515_convert_id_to_regs(filter->id_type,
+				(filter->id_type == CAN_STANDARD_IDENTIFIER) ?
+				filter->std_id : filter->ext_id, regs);
+			if (filter->id_type == CAN_EXTENDED_IDENTIFIER) {
+				/* EXIDE */
+				regs[1] |= BIT(3);
+			}
+
+			ret = mcp2515_cmd_write_reg(dev, rxf_addr[i], regs,
+						    sizeof(regs));
+		}
+
+		/* Receive the frames matching the filters only */
+		rxm = ret ? rxm : 0U;
+	}
+
+	if (ret < 0) {
+		LOG_ERR("Failed to write the filters [%d]", ret);
+	}
+
+	mcp2515_cmd_bit_modify(dev, MCP2515_ADDR_RXB0CTRL, BIT(6) | BIT(5),
+			       rxm);
+	mcp2515_cmd_bit_modify(dev, MCP2515_ADDR_RXB1CTRL, BIT(6) | BIT(5),
+			       rxm);
+
+	return ret;
+}
+
+/* Update the filters of the controller, back to its current mode after. */
+static void mcp2515_update_hw_filters(struct device *dev)
+{
+	uint8_t canstat;
+	uint8_t mode;
+
+	if (mcp2515_cmd_read_reg(dev, MCP2515_ADDR_CANSTAT, &canstat, 1)) {
+		return;
+	}
+
+	mode = (canstat & MCP2515_CANSTAT_MODE_MASK) >>
+		MCP2515_CANSTAT_MODE_POS;
+
+	if (mcp2515_set_mode(dev, MCP2515_MODE_CONFIGURATION) == 0) {
+		(void)mcp2515_set_hw_filters(dev);
+	}
+
+	(void)mcp2515_set_mode(dev, mode);
+}
+#endif /* CONFIG_CAN_MCP2515_HW_FILTER */
+
 static int mcp2515_configure(struct device *dev, enum can_mode mode,
 			     uint32_t bitrate)
 {
@@ -370,6 +474,11 @@ static int mcp2515_configure(struct device *dev, enum can_mode mode,
 		LOG_ERR("Failed to write RXB1CTRL [%d]", ret);
 	}
 
+#ifdef CONFIG_CAN_MCP2515_HW_FILTER
+	/* The reset cleared the filters */
+	(void)mcp2515_set_hw_filters(dev);
+#endif
+
 done:
 	ret = mcp2515_set_mode(dev,
 			       mcp2515_convert_canmode_to_mcp2515mode(mode));
@@ -448,29 +557,19 @@ static int mcp2515_attach_isr(struct device *dev, can_rx_callback_t rx_cb,
 			      const struct zcan_filter *filter)
 {
 	struct mcp2515_data *dev_data = DEV_DATA(dev);
-	int filter_idx = 0;
+	int filter_idx;
 
 	__ASSERT(rx_cb != NULL, "response_ptr can not be null");
 
 	k_mutex_lock(&dev_data->mutex, K_FOREVER);
 
-	/* find free filter */
-	while ((BIT(filter_idx) & dev_data->filter_usage)
-	       && (filter_idx < CONFIG_CAN_MCP2515_MAX_FILTER)) {
-		filter_idx++;
-	}
-
-	/* setup filter */
-	if (filter_idx < CONFIG_CAN_MCP2515_MAX_FILTER) {
-		dev_data->filter_usage |= BIT(filter_idx);
-
-		dev_data->filter[filter_idx] = *filter;
-		dev_data->rx_cb[filter_idx] = rx_cb;
-		dev_data->cb_arg[filter_idx] = cb_arg;
-
-	} else {
-		filter_idx = CAN_NO_FREE_FILTER;
+	filter_idx = can_filter_table_add(&dev_data->filters, rx_cb, cb_arg,
+					  filter);
+#ifdef CONFIG_CAN_MCP2515_HW_FILTER
+	if (filter_idx != CAN_NO_FREE_FILTER) {
+		mcp2515_update_hw_filters(dev);
 	}
+#endif
 
 	k_mutex_unlock(&dev_data->mutex);
 
@@ -482,7 +581,10 @@ static void mcp2515_detach(struct device *dev, int filter_nr)
 	struct mcp2515_data *dev_data = DEV_DATA(dev);
 
 	k_mutex_lock(&dev_data->mutex, K_FOREVER);
-	dev_data->filter_usage &= ~BIT(filter_nr);
+	can_filter_table_remove(&dev_data->filters, filter_nr);
+#ifdef CONFIG_CAN_MCP2515_HW_FILTER
+	mcp2515_update_hw_filters(dev);
+#endif
 	k_mutex_unlock(&dev_data->mutex);
 }
 
@@ -494,56 +596,12 @@ static void mcp2515_register_state_change_isr(struct device *dev,
 	dev_data->state_change_isr = isr;
 }
 
-static uint8_t mcp2515_filter_match(struct zcan_frame *msg,
-				 struct zcan_filter *filter)
-{
-	if (msg->id_type != filter->id_type) {
-		return 0;
-	}
-
-	if ((msg->rtr ^ filter->rtr) & filter->rtr_mask) {
-		return 0;
-	}
-
-	if (msg->id_type == CAN_STANDARD_IDENTIFIER) {
-		if ((msg->std_id ^ filter->std_id) & filter->std_id_mask) {
-			return 0;
-		}
-	} else {
-		if ((msg->ext_id ^ filter->ext_id) & filter->ext_id_mask) {
-			return 0;
-		}
-	}
-
-	return 1;
-}
-
 static void mcp2515_rx_filter(struct device *dev, struct zcan_frame *msg)
 {
 	struct mcp2515_data *dev_data = DEV_DATA(dev);
-	uint8_t filter_idx = 0U;
-	can_rx_callback_t callback;
-	struct zcan_frame tmp_msg;
 
 	k_mutex_lock(&dev_data->mutex, K_FOREVER);
-
-	for (; filter_idx < CONFIG_CAN_MCP2515_MAX_FILTER; filter_idx++) {
-		if (!(BIT(filter_idx) & dev_data->filter_usage)) {
-			continue; /* filter slot empty */
-		}
-
-		if (!mcp2515_filter_match(msg,
-					  &dev_data->filter[filter_idx])) {
-			continue; /* filter did not match */
-		}
-
-		callback = dev_data->rx_cb[filter_idx];
-		/*Make a temporary copy in case the user modifies the message*/
-		tmp_msg = *msg;
-
-		callback(&tmp_msg, dev_data->cb_arg[filter_idx]);
-	}
-
+	(void)can_filter_table_dispatch(&dev_data->filters, msg);
 	k_mutex_unlock(&dev_data->mutex);
 }
 
@@ -818,8 +876,8 @@ static int mcp2515_init(struct device *dev)
 			NULL, NULL, K_PRIO_COOP(dev_cfg->int_thread_priority),
 			0, K_NO_WAIT);
 
-	(void)memset(dev_data->rx_cb, 0, sizeof(dev_data->rx_cb));
-	(void)memset(dev_data->filter, 0, sizeof(dev_data->filter));
+	can_filter_table_init(&dev_data->filters, dev_data->filter_entries,
+			      ARRAY_SIZE(dev_data->filter_entries));
 	dev_data->old_state = CAN_ERROR_ACTIVE;
 
 	ret = mcp2515_configure(dev, CAN_NORMAL_MODE, dev_cfg->bus_speed);
@@ -838,7 +896,6 @@ static struct mcp2515_data mcp2515_data_1 = {
 	.tx_cb[1].cb = NULL,
 	.tx_cb[2].cb = NULL,
 	.tx_busy_map = 0U,
-	.filter_usage = 0U,
 };
 
 static const struct mcp2515_config mcp2515_config_1 = {
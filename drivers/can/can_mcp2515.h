@@ -9,6 +9,7 @@
 #define _MCP2515_H_
 
 #include <drivers/can.h>
+#include "can_filter_table.h"
 
 #define MCP2515_RX_CNT                   2
 #define MCP2515_TX_CNT                   3
@@ -45,10 +46,8 @@ struct mcp2515_data {
 	uint8_t tx_busy_map;
 
 	/* filter data */
-	uint32_t filter_usage;
-	can_rx_callback_t rx_cb[CONFIG_CAN_MCP2515_MAX_FILTER];
-	void *cb_arg[CONFIG_CAN_MCP2515_MAX_FILTER];
-	struct zcan_filter filter[CONFIG_CAN_MCP2515_MAX_FILTER];
+	struct can_filter_table filters;
+	struct can_filter_entry filter_entries[CONFIG_CAN_MCP2515_MAX_FILTER];
 	can_state_change_isr_t state_change_isr;
 
 	/* general data */
@@ -107,6 +106,15 @@ struct mcp2515_config {
 #define MCP2515_ADDR_RXB0CTRL           0x60
 #define MCP2515_ADDR_RXB1CTRL           0x70
 
+#define MCP2515_ADDR_RXF0SIDH           0x00
+#define MCP2515_ADDR_RXF1SIDH           0x04
+#define MCP2515_ADDR_RXF2SIDH           0x08
+#define MCP2515_ADDR_RXF3SIDH           0x10
+#define MCP2515_ADDR_RXF4SIDH           0x14
+#define MCP2515_ADDR_RXF5SIDH           0x18
+#define MCP2515_ADDR_RXM0SIDH           0x20
+#define MCP2515_ADDR_RXM1SIDH           0x24
+
 #define MCP2515_ADDR_OFFSET_FRAME2FRAME	0x10
 #define MCP2515_ADDR_OFFSET_CTRL2FRAME	0x01
 
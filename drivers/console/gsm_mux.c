@@ -83,6 +83,9 @@ struct gsm_mux {
 	struct net_buf *buf;
 	int mru;
 
+	/* Keeps the frames of the different DLCIs from interleaving */
+	struct k_mutex tx_lock;
+
 	enum gsm_mux_state state;
 
 	/* Control DLCI is not included in this list so -1 here */
@@ -393,8 +396,11 @@ static int gsm_mux_send_data_msg(struct gsm_mux *mux, bool cmd,
 	}
 
 	/* Write the header and data in smaller chunks in order to avoid
-	 * allocating a big buffer.
+	 * allocating a big buffer. The whole frame is written under the
+	 * lock as PPP and AT traffic are sent concurrently.
 	 */
+	k_mutex_lock(&mux->tx_lock, K_FOREVER);
+
 	(void)gsm_mux_modem_send(mux, &hdr[0], pos);
 
 	if (size > 0) {
@@ -414,6 +420,8 @@ static int gsm_mux_send_data_msg(struct gsm_mux *mux, bool cmd,
 
 	ret = gsm_mux_modem_send(mux, &hdr[pos], 2);
 
+	k_mutex_unlock(&mux->tx_lock);
+
 	hexdump_packet("Sending", dlci->num, cmd, frame_type,
 		       buf, size);
 	return ret;
@@ -1233,10 +1241,43 @@ void gsm_mux_change_state(struct gsm_mux *mux, enum gsm_mux_state new_state)
 	mux->state = new_state;
 }
 
-static void gsm_mux_process_data(struct gsm_mux *mux, uint8_t recv_byte)
+/* Append received payload bytes to the frame, return the bytes consumed */
+static size_t gsm_mux_process_payload(struct gsm_mux *mux,
+				      const uint8_t *data, size_t len)
 {
 	size_t bytes_added;
 
+	len = MIN(len, mux->msg_len - mux->received);
+
+	if (mux->buf == NULL) {
+		mux->buf = net_buf_alloc(&gsm_mux_pool, BUF_ALLOC_TIMEOUT);
+		if (mux->buf == NULL) {
+			LOG_ERR("[%p] Can't allocate RX data! "
+				"Skipping data!", mux);
+			gsm_mux_change_state(mux, GSM_MUX_SOF);
+			return len;
+		}
+	}
+
+	bytes_added = net_buf_append_bytes(mux->buf, len, data,
+					   BUF_ALLOC_TIMEOUT,
+					   gsm_mux_alloc_buf,
+					   &gsm_mux_pool);
+	if (bytes_added != len) {
+		gsm_mux_change_state(mux, GSM_MUX_SOF);
+		return len;
+	}
+
+	mux->received += len;
+	if (mux->received == mux->msg_len) {
+		gsm_mux_change_state(mux, GSM_MUX_FCS);
+	}
+
+	return len;
+}
+
+static void gsm_mux_process_data(struct gsm_mux *mux, uint8_t recv_byte)
+{
 	switch (mux->state) {
 	case GSM_MUX_SOF:
 		/* This is the initial state where we look for SOF char */
@@ -1314,28 +1355,7 @@ static void gsm_mux_process_data(struct gsm_mux *mux, uint8_t recv_byte)
 		break;
 
 	case GSM_MUX_DATA:
-		if (mux->buf == NULL) {
-			mux->buf = net_buf_alloc(&gsm_mux_pool,
-						 BUF_ALLOC_TIMEOUT);
-			if (mux->buf == NULL) {
-				LOG_ERR("[%p] Can't allocate RX data! "
-					"Skipping data!", mux);
-				gsm_mux_change_state(mux, GSM_MUX_SOF);
-				break;
-			}
-		}
-
-		bytes_added = net_buf_append_bytes(mux->buf, 1,
-						   (void *)&recv_byte,
-						   BUF_ALLOC_TIMEOUT,
-						   gsm_mux_alloc_buf,
-						   &gsm_mux_pool);
-		if (bytes_added != 1) {
-			gsm_mux_change_state(mux, GSM_MUX_SOF);
-		} else if (++mux->received == mux->msg_len) {
-			gsm_mux_change_state(mux, GSM_MUX_FCS);
-		}
-
+		(void)gsm_mux_process_payload(mux, &recv_byte, 1);
 		break;
 
 	case GSM_MUX_FCS:
@@ -1382,6 +1402,12 @@ void gsm_mux_recv_buf(struct gsm_mux *mux, uint8_t *buf, int len)
 	LOG_DBG("Received %d bytes", len);
 
 	while (i < len) {
+		/* The payload is copied in one go, not byte by byte */
+		if (mux->state == GSM_MUX_DATA) {
+			i += gsm_mux_process_payload(mux, &buf[i], len - i);
+			continue;
+		}
+
 		gsm_mux_process_data(mux, buf[i++]);
 	}
 }
@@ -1473,6 +1499,7 @@ struct gsm_mux *gsm_mux_create(struct device *uart)
 		mux->state = GSM_MUX_SOF;
 		mux->buf = NULL;
 
+		k_mutex_init(&mux->tx_lock);
 		k_delayed_work_init(&mux->t2_timer, gsm_mux_t2_timeout);
 		sys_slist_init(&mux->pending_ctrls);
 
@@ -10,17 +10,52 @@
  */
 
 #include <assert.h>
+#include <errno.h>
 #include <string.h>
 #include <kernel.h>
 #include <drivers/uart.h>
 #include <mgmt/mcumgr/serial.h>
 #include <drivers/console/uart_mcumgr.h>
 
+#ifdef CONFIG_UART_MCUMGR_BINARY
+#include <sys/crc.h>
+#include <sys/byteorder.h>
+#include <net/buf.h>
+#include <mgmt/mcumgr/buf.h>
+#endif
+
 static struct device *uart_mcumgr_dev;
 
 /** Callback to execute when a valid fragment has been received. */
 static uart_mcumgr_recv_fn *uart_mgumgr_recv_cb;
 
+/** Contains buffers to hold incoming request fragments. */
+K_MEM_SLAB_DEFINE(uart_mcumgr_slab, sizeof(struct uart_mcumgr_rx_buf),
+		  CONFIG_UART_MCUMGR_RX_BUF_COUNT, 1);
+
+void uart_mcumgr_free_rx_buf(struct uart_mcumgr_rx_buf *rx_buf)
+{
+	void *block;
+
+	block = rx_buf;
+	k_mem_slab_free(&uart_mcumgr_slab, &block);
+}
+
+#ifndef CONFIG_UART_MCUMGR_ASYNC
+/**
+ * Reads a chunk of received data from the UART.
+ */
+static int uart_mcumgr_read_chunk(void *buf, int capacity)
+{
+	if (!uart_irq_rx_ready(uart_mcumgr_dev)) {
+		return 0;
+	}
+
+	return uart_fifo_read(uart_mcumgr_dev, buf, capacity);
+}
+#endif
+
+#ifndef CONFIG_UART_MCUMGR_BINARY
 /** Contains the fragment currently being received. */
 static struct uart_mcumgr_rx_buf *uart_mcumgr_cur_buf;
 
@@ -30,10 +65,6 @@ static struct uart_mcumgr_rx_buf *uart_mcumgr_cur_buf;
  */
 static bool uart_mcumgr_ignoring;
 
-/** Contains buffers to hold incoming request fragments. */
-K_MEM_SLAB_DEFINE(uart_mcumgr_slab, sizeof(struct uart_mcumgr_rx_buf),
-		  CONFIG_UART_MCUMGR_RX_BUF_COUNT, 1);
-
 static struct uart_mcumgr_rx_buf *uart_mcumgr_alloc_rx_buf(void)
 {
 	struct uart_mcumgr_rx_buf *rx_buf;
@@ -50,26 +81,6 @@ static struct uart_mcumgr_rx_buf *uart_mcumgr_alloc_rx_buf(void)
 	return rx_buf;
 }
 
-void uart_mcumgr_free_rx_buf(struct uart_mcumgr_rx_buf *rx_buf)
-{
-	void *block;
-
-	block = rx_buf;
-	k_mem_slab_free(&uart_mcumgr_slab, &block);
-}
-
-/**
- * Reads a chunk of received data from the UART.
- */
-static int uart_mcumgr_read_chunk(void *buf, int capacity)
-{
-	if (!uart_irq_rx_ready(uart_mcumgr_dev)) {
-		return 0;
-	}
-
-	return uart_fifo_read(uart_mcumgr_dev, buf, capacity);
-}
-
 /**
  * Processes a single incoming byte.
  */
@@ -111,16 +122,191 @@ static struct uart_mcumgr_rx_buf *uart_mcumgr_rx_byte(uint8_t byte)
 
 	return NULL;
 }
+#endif /* !CONFIG_UART_MCUMGR_BINARY */
+
+#ifdef CONFIG_UART_MCUMGR_BINARY
+enum {
+	UART_MCUMGR_BIN_SYNC_1,
+	UART_MCUMGR_BIN_SYNC_2,
+	UART_MCUMGR_BIN_LEN_1,
+	UART_MCUMGR_BIN_LEN_2,
+	UART_MCUMGR_BIN_DATA,
+};
+
+/** Callback to execute when a valid binary packet has been received. */
+static uart_mcumgr_recv_pkt_fn *uart_mcumgr_recv_pkt_cb;
+
+/** Contains the binary packet currently being received. */
+static struct net_buf *uart_mcumgr_bin_nb;
+
+/** Bytes of body and CRC still expected. */
+static uint16_t uart_mcumgr_bin_left;
+
+static uint8_t uart_mcumgr_bin_state;
+
+/**
+ * Starts receiving the body of a binary packet of the specified length.
+ */
+static void uart_mcumgr_bin_start(uint16_t len)
+{
+	uart_mcumgr_bin_state = UART_MCUMGR_BIN_SYNC_1;
+
+	uart_mcumgr_bin_nb = mcumgr_buf_alloc();
+	if (uart_mcumgr_bin_nb == NULL) {
+		/* Insufficient buffers; drop this packet. */
+		return;
+	}
+
+	if (len == 0U ||
+	    len + 2U > net_buf_tailroom(uart_mcumgr_bin_nb)) {
+		mcumgr_buf_free(uart_mcumgr_bin_nb);
+		uart_mcumgr_bin_nb = NULL;
+		return;
+	}
+
+	uart_mcumgr_bin_left = len + 2U;
+	uart_mcumgr_bin_state = UART_MCUMGR_BIN_DATA;
+}
 
+/**
+ * Processes received binary framed data, writing the body directly to the
+ * packet buffer.
+ */
+static void uart_mcumgr_rx_bin(const uint8_t *data, int len)
+{
+	struct net_buf *nb;
+	int n;
+
+	while (len > 0) {
+		switch (uart_mcumgr_bin_state) {
+		case UART_MCUMGR_BIN_SYNC_1:
+			if (*data == MCUMGR_SERIAL_HDR_BIN_1) {
+				uart_mcumgr_bin_state = UART_MCUMGR_BIN_SYNC_2;
+			}
+			break;
+
+		case UART_MCUMGR_BIN_SYNC_2:
+			if (*data == MCUMGR_SERIAL_HDR_BIN_2) {
+				uart_mcumgr_bin_state = UART_MCUMGR_BIN_LEN_1;
+			} else if (*data != MCUMGR_SERIAL_HDR_BIN_1) {
+				uart_mcumgr_bin_state = UART_MCUMGR_BIN_SYNC_1;
+			}
+			break;
+
+		case UART_MCUMGR_BIN_LEN_1:
+			uart_mcumgr_bin_left = *data << 8;
+			uart_mcumgr_bin_state = UART_MCUMGR_BIN_LEN_2;
+			break;
+
+		case UART_MCUMGR_BIN_LEN_2:
+			uart_mcumgr_bin_start(uart_mcumgr_bin_left | *data);
+			break;
+
+		case UART_MCUMGR_BIN_DATA:
+			nb = uart_mcumgr_bin_nb;
+			n = MIN(len, uart_mcumgr_bin_left);
+			net_buf_add_mem(nb, data, n);
+			data += n;
+			len -= n;
+
+			uart_mcumgr_bin_left -= n;
+			if (uart_mcumgr_bin_left > 0U) {
+				continue;
+			}
+
+			uart_mcumgr_bin_nb = NULL;
+			uart_mcumgr_bin_state = UART_MCUMGR_BIN_SYNC_1;
+
+			if (crc16(nb->data, nb->len, 0x1021, 0, true) != 0U) {
+				mcumgr_buf_free(nb);
+				continue;
+			}
+
+			/* Packet is complete; strip the CRC. */
+			nb->len -= 2U;
+			uart_mcumgr_recv_pkt_cb(nb);
+			continue;
+		}
+
+		data++;
+		len--;
+	}
+}
+#endif /* CONFIG_UART_MCUMGR_BINARY */
+
+/**
+ * Processes a chunk of received data.
+ */
+static void uart_mcumgr_rx_chunk(const uint8_t *data, int len)
+{
+#ifdef CONFIG_UART_MCUMGR_BINARY
+	uart_mcumgr_rx_bin(data, len);
+#else
+	struct uart_mcumgr_rx_buf *rx_buf;
+	int i;
+
+	for (i = 0; i < len; i++) {
+		rx_buf = uart_mcumgr_rx_byte(data[i]);
+		if (rx_buf != NULL) {
+			uart_mgumgr_recv_cb(rx_buf);
+		}
+	}
+#endif
+}
+
+#ifdef CONFIG_UART_MCUMGR_ASYNC
+/** Report received data once the line has been idle for this long. */
+#define UART_MCUMGR_ASYNC_RX_TIMEOUT_MS 1
+
+static uint8_t uart_mcumgr_async_bufs[2][CONFIG_UART_MCUMGR_ASYNC_BUF_SIZE];
+static uint8_t uart_mcumgr_async_next;
+
+static void uart_mcumgr_async_start(struct device *uart)
+{
+	uart_mcumgr_async_next = 1U;
+	uart_rx_enable(uart, uart_mcumgr_async_bufs[0],
+		       sizeof(uart_mcumgr_async_bufs[0]),
+		       UART_MCUMGR_ASYNC_RX_TIMEOUT_MS);
+}
+
+/**
+ * Asynchronous UART event handler; receives into two alternating buffers.
+ */
+static void uart_mcumgr_async_cb(struct device *uart, struct uart_event *evt,
+				 void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	switch (evt->type) {
+	case UART_RX_RDY:
+		uart_mcumgr_rx_chunk(evt->data.rx.buf + evt->data.rx.offset,
+				     evt->data.rx.len);
+		break;
+
+	case UART_RX_BUF_REQUEST:
+		uart_rx_buf_rsp(uart,
+				uart_mcumgr_async_bufs[uart_mcumgr_async_next],
+				sizeof(uart_mcumgr_async_bufs[0]));
+		uart_mcumgr_async_next ^= 1U;
+		break;
+
+	case UART_RX_DISABLED:
+		/* Reception stops on line errors; start over. */
+		uart_mcumgr_async_start(uart);
+		break;
+
+	default:
+		break;
+	}
+}
+#else
 /**
  * ISR that is called when UART bytes are received.
  */
 static void uart_mcumgr_isr(struct device *unused, void *user_data)
 {
-	struct uart_mcumgr_rx_buf *rx_buf;
 	uint8_t buf[32];
 	int chunk_len;
-	int i;
 
 	ARG_UNUSED(unused);
 	ARG_UNUSED(user_data);
@@ -133,14 +319,10 @@ static void uart_mcumgr_isr(struct device *unused, void *user_data)
 			continue;
 		}
 
-		for (i = 0; i < chunk_len; i++) {
-			rx_buf = uart_mcumgr_rx_byte(buf[i]);
-			if (rx_buf != NULL) {
-				uart_mgumgr_recv_cb(rx_buf);
-			}
-		}
+		uart_mcumgr_rx_chunk(buf, chunk_len);
 	}
 }
+#endif /* CONFIG_UART_MCUMGR_ASYNC */
 
 /**
  * Sends raw data over the UART.
@@ -157,11 +339,40 @@ static int uart_mcumgr_send_raw(const void *data, int len, void *arg)
 	return 0;
 }
 
+#ifdef CONFIG_UART_MCUMGR_BINARY
+int uart_mcumgr_send(const uint8_t *data, int len)
+{
+	uint8_t hdr[4];
+	uint8_t crc[2];
+
+	if (len < 0 || len > UINT16_MAX) {
+		return -EINVAL;
+	}
+
+	sys_put_be16(MCUMGR_SERIAL_HDR_BIN, hdr);
+	sys_put_be16(len, hdr + 2);
+	sys_put_be16(crc16(data, len, 0x1021, 0, true), crc);
+
+	uart_mcumgr_send_raw(hdr, sizeof(hdr), NULL);
+	uart_mcumgr_send_raw(data, len, NULL);
+	uart_mcumgr_send_raw(crc, sizeof(crc), NULL);
+
+	return 0;
+}
+#else
 int uart_mcumgr_send(const uint8_t *data, int len)
 {
 	return mcumgr_serial_tx_pkt(data, len, uart_mcumgr_send_raw, NULL);
 }
+#endif
 
+#ifdef CONFIG_UART_MCUMGR_ASYNC
+static void uart_mcumgr_setup(struct device *uart)
+{
+	uart_callback_set(uart, uart_mcumgr_async_cb, NULL);
+	uart_mcumgr_async_start(uart);
+}
+#else
 static void uart_mcumgr_setup(struct device *uart)
 {
 	uint8_t c;
@@ -178,6 +389,7 @@ static void uart_mcumgr_setup(struct device *uart)
 
 	uart_irq_rx_enable(uart);
 }
+#endif /* CONFIG_UART_MCUMGR_ASYNC */
 
 void uart_mcumgr_register(uart_mcumgr_recv_fn *cb)
 {
@@ -189,3 +401,16 @@ void uart_mcumgr_register(uart_mcumgr_recv_fn *cb)
 		uart_mcumgr_setup(uart_mcumgr_dev);
 	}
 }
+
+#ifdef CONFIG_UART_MCUMGR_BINARY
+void uart_mcumgr_register_pkt(uart_mcumgr_recv_pkt_fn *cb)
+{
+	uart_mcumgr_recv_pkt_cb = cb;
+
+	uart_mcumgr_dev = device_get_binding(CONFIG_UART_MCUMGR_ON_DEV_NAME);
+
+	if (uart_mcumgr_dev != NULL) {
+		uart_mcumgr_setup(uart_mcumgr_dev);
+	}
+}
+#endif
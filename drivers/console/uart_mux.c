@@ -433,6 +433,21 @@ static void uart_mux_poll_out(struct device *dev, unsigned char out_char)
 		return;
 	}
 
+	/* Characters written in a row are sent in a single frame by the TX
+	 * worker, instead of a frame each.
+	 */
+	while (!k_is_in_isr() && dev_data->status == UART_MUX_CONNECTED) {
+		if (ring_buf_put(dev_data->tx_ringbuf, &out_char, 1) == 1) {
+			k_work_submit_to_queue(&uart_mux_workq,
+					       &dev_data->tx_work);
+			return;
+		}
+
+		/* Wait for the TX worker to drain the ring buffer */
+		k_work_submit_to_queue(&uart_mux_workq, &dev_data->tx_work);
+		k_sleep(K_MSEC(1));
+	}
+
 	(void)gsm_dlci_send(dev_data->dlci, &out_char, 1);
 }
 
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <device.h>
+#include <drivers/crc.h>
+
+static struct device *crc_dev;
+
+static struct device *crc_hw_get(void)
+{
+	struct device *dev = crc_dev;
+
+	/* The unit's registers are not accessible from user mode */
+	if (_is_user_context()) {
+		return NULL;
+	}
+
+	if (unlikely(dev == NULL)) {
+		/* Only one chosen device exists, so this is safe even if
+		 * the whole operation isn't atomic.
+		 */
+		dev = device_get_binding(DT_LABEL(DT_CHOSEN(zephyr_crc)));
+		crc_dev = dev;
+	}
+
+	return dev;
+}
+
+int z_crc_hw_crc32_ieee_update(uint32_t crc, const uint8_t *data,
+			       size_t len, uint32_t *result)
+{
+	struct device *dev = crc_hw_get();
+
+	if (dev == NULL) {
+		return -ENODEV;
+	}
+
+	return crc_crc32_ieee_update(dev, crc, data, len, result);
+}
+
+int z_crc_hw_crc16_ccitt(uint16_t seed, const uint8_t *data, size_t len,
+			 uint16_t *result)
+{
+	struct device *dev = crc_hw_get();
+
+	if (dev == NULL) {
+		return -ENODEV;
+	}
+
+	return crc_crc16_ccitt(dev, seed, data, len, result);
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT st_stm32_crc
+
+#include <kernel.h>
+#include <device.h>
+#include <drivers/crc.h>
+#include <init.h>
+#include <sys/__assert.h>
+#include <soc.h>
+#include <drivers/clock_control.h>
+#include <drivers/clock_control/stm32_clock_control.h>
+
+/* Both supported CRCs are reflected: the input is bit-reversed per byte,
+ * the output over the polynomial width, and the initial value must be
+ * given in the unit's non-reflected domain.
+ */
+
+struct crc_stm32_dev_cfg {
+	CRC_TypeDef *crc;
+	struct stm32_pclken pclken;
+};
+
+struct crc_stm32_dev_data {
+	struct k_sem lock;
+};
+
+#define DEV_DATA(dev) \
+	((struct crc_stm32_dev_data *)(dev)->data)
+
+#define DEV_CFG(dev) \
+	((const struct crc_stm32_dev_cfg *)(dev)->config)
+
+static int crc_stm32_compute(struct device *dev, uint32_t poly_size,
+			     uint32_t poly, uint32_t init,
+			     const uint8_t *data, size_t len,
+			     uint32_t *result)
+{
+	CRC_TypeDef *crc = DEV_CFG(dev)->crc;
+
+	/* Never wait, the caller falls back to software instead */
+	if (k_sem_take(&DEV_DATA(dev)->lock, K_NO_WAIT) != 0) {
+		return -EBUSY;
+	}
+
+	LL_CRC_SetPolynomialSize(crc, poly_size);
+	LL_CRC_SetPolynomialCoef(crc, poly);
+	LL_CRC_SetInputDataReverseMode(crc, LL_CRC_INDATA_REVERSE_BYTE);
+	LL_CRC_SetOutputDataReverseMode(crc, LL_CRC_OUTDATA_REVERSE_BIT);
+	LL_CRC_SetInitialData(crc, init);
+	LL_CRC_ResetCRCCalculationUnit(crc);
+
+	for (; len > 0; len--) {
+		LL_CRC_FeedData8(crc, *data++);
+	}
+
+	*result = LL_CRC_ReadData32(crc);
+
+	k_sem_give(&DEV_DATA(dev)->lock);
+
+	return 0;
+}
+
+static int crc_stm32_crc32_ieee(struct device *dev, uint32_t crc,
+				const uint8_t *data, size_t len,
+				uint32_t *result)
+{
+	uint32_t out;
+	int ret;
+
+	ret = crc_stm32_compute(dev, LL_CRC_POLYLENGTH_32B, 0x04C11DB7,
+				__RBIT(~crc), data, len, &out);
+	if (ret == 0) {
+		*result = ~out;
+	}
+
+	return ret;
+}
+
+static int crc_stm32_crc16_ccitt(struct device *dev, uint16_t seed,
+				 const uint8_t *data, size_t len,
+				 uint16_t *result)
+{
+	uint32_t out;
+	int ret;
+
+	ret = crc_stm32_compute(dev, LL_CRC_POLYLENGTH_16B, 0x1021,
+				__RBIT(seed) >> 16, data, len, &out);
+	if (ret == 0) {
+		*result = (uint16_t)out;
+	}
+
+	return ret;
+}
+
+static int crc_stm32_init(struct device *dev)
+{
+	const struct crc_stm32_dev_cfg *cfg = DEV_CFG(dev);
+	struct device *clock;
+	int res;
+
+	k_sem_init(&DEV_DATA(dev)->lock, 1, 1);
+
+	clock = device_get_binding(STM32_CLOCK_CONTROL_NAME);
+	__ASSERT_NO_MSG(clock != NULL);
+
+	res = clock_control_on(clock,
+			       (clock_control_subsys_t *)&cfg->pclken);
+	__ASSERT_NO_MSG(res == 0);
+
+	return res;
+}
+
+static const struct crc_driver_api crc_stm32_api = {
+	.crc32_ieee = crc_stm32_crc32_ieee,
+	.crc16_ccitt = crc_stm32_crc16_ccitt,
+};
+
+static const struct crc_stm32_dev_cfg crc_stm32_config = {
+	.crc = (CRC_TypeDef *)DT_INST_REG_ADDR(0),
+	.pclken	= { .bus = DT_INST_CLOCKS_CELL(0, bus),
+		    .enr = DT_INST_CLOCKS_CELL(0, bits) },
+};
+
+static struct crc_stm32_dev_data crc_stm32_data;
+
+DEVICE_AND_API_INIT(crc_stm32, DT_INST_LABEL(0),
+		    crc_stm32_init,
+		    &crc_stm32_data, &crc_stm32_config,
+		    PRE_KERNEL_1, CONFIG_CRC_INIT_PRIORITY,
+		    &crc_stm32_api);
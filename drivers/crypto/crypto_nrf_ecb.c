@@ -11,6 +11,8 @@
 
 #define ECB_AES_KEY_SIZE   16
 #define ECB_AES_BLOCK_SIZE 16
+#define ECB_IRQ_PRIORITY   1
+#define ECB_QUEUE_SIZE     CONFIG_CRYPTO_ASYNC_QUEUE_SIZE
 
 LOG_MODULE_REGISTER(crypto_nrf_ecb, CONFIG_CRYPTO_LOG_LEVEL);
 
@@ -22,15 +24,97 @@ struct ecb_data {
 
 struct nrf_ecb_drv_state {
 	struct ecb_data data;
+	/* Asynchronous blocks, the first one is being encrypted */
+	struct cipher_pkt *queue[ECB_QUEUE_SIZE];
+	uint8_t head;
+	uint8_t len;
+	crypto_completion_cb cb;
 	bool in_use;
 };
 
 static struct nrf_ecb_drv_state drv_state;
 
-static int do_ecb_encrypt(struct cipher_ctx *ctx, struct cipher_pkt *pkt)
+static void ecb_start(struct cipher_pkt *pkt)
 {
-	ARG_UNUSED(ctx);
+	if (pkt->in_buf != drv_state.data.cleartext) {
+		memcpy(drv_state.data.cleartext, pkt->in_buf,
+		       ECB_AES_BLOCK_SIZE);
+	}
+
+	nrf_ecb_event_clear(NRF_ECB, NRF_ECB_EVENT_ENDECB);
+	nrf_ecb_event_clear(NRF_ECB, NRF_ECB_EVENT_ERRORECB);
+	nrf_ecb_task_trigger(NRF_ECB, NRF_ECB_TASK_STARTECB);
+}
+
+/*
+ * The next queued block is started from the interrupt ending the previous
+ * one, so a burst of blocks keeps the peripheral busy back to back.
+ */
+static void nrf_ecb_isr(void *arg)
+{
+	struct cipher_pkt *pkt;
+	int status = 0;
+
+	ARG_UNUSED(arg);
+
+	if (drv_state.len == 0U) {
+		nrf_ecb_event_clear(NRF_ECB, NRF_ECB_EVENT_ENDECB);
+		nrf_ecb_event_clear(NRF_ECB, NRF_ECB_EVENT_ERRORECB);
+		return;
+	}
+
+	pkt = drv_state.queue[drv_state.head];
+
+	if (nrf_ecb_event_check(NRF_ECB, NRF_ECB_EVENT_ERRORECB)) {
+		LOG_ERR("ECB operation error");
+		status = -EIO;
+	} else {
+		memcpy(pkt->out_buf, drv_state.data.ciphertext,
+		       ECB_AES_BLOCK_SIZE);
+		pkt->out_len = pkt->in_len;
+	}
+
+	drv_state.head = (drv_state.head + 1U) % ECB_QUEUE_SIZE;
+	drv_state.len--;
+	if (drv_state.len > 0U) {
+		ecb_start(drv_state.queue[drv_state.head]);
+	} else {
+		nrf_ecb_event_clear(NRF_ECB, NRF_ECB_EVENT_ENDECB);
+		nrf_ecb_event_clear(NRF_ECB, NRF_ECB_EVENT_ERRORECB);
+	}
+
+	drv_state.cb(pkt, status);
+}
+
+static int ecb_submit(struct cipher_pkt *pkt)
+{
+	unsigned int key;
+
+	if (drv_state.cb == NULL) {
+		LOG_ERR("No completion callback");
+		return -EINVAL;
+	}
 
+	key = irq_lock();
+
+	if (drv_state.len == ECB_QUEUE_SIZE) {
+		irq_unlock(key);
+		return -EBUSY;
+	}
+
+	drv_state.queue[(drv_state.head + drv_state.len) % ECB_QUEUE_SIZE] =
+		pkt;
+	if (drv_state.len++ == 0U) {
+		ecb_start(pkt);
+	}
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+static int do_ecb_encrypt(struct cipher_ctx *ctx, struct cipher_pkt *pkt)
+{
 	if (pkt->in_len != ECB_AES_BLOCK_SIZE) {
 		LOG_ERR("only 16-byte blocks are supported");
 		return -EINVAL;
@@ -40,14 +124,11 @@ static int do_ecb_encrypt(struct cipher_ctx *ctx, struct cipher_pkt *pkt)
 		return -EINVAL;
 	}
 
-	if (pkt->in_buf != drv_state.data.cleartext) {
-		memcpy(drv_state.data.cleartext, pkt->in_buf,
-		       ECB_AES_BLOCK_SIZE);
+	if (ctx->flags & CAP_ASYNC_OPS) {
+		return ecb_submit(pkt);
 	}
 
-	nrf_ecb_event_clear(NRF_ECB, NRF_ECB_EVENT_ENDECB);
-	nrf_ecb_event_clear(NRF_ECB, NRF_ECB_EVENT_ERRORECB);
-	nrf_ecb_task_trigger(NRF_ECB, NRF_ECB_TASK_STARTECB);
+	ecb_start(pkt);
 	while (!(nrf_ecb_event_check(NRF_ECB, NRF_ECB_EVENT_ENDECB) ||
 		 nrf_ecb_event_check(NRF_ECB, NRF_ECB_EVENT_ERRORECB))) {
 	}
@@ -69,6 +150,9 @@ static int nrf_ecb_driver_init(struct device *dev)
 
 	nrf_ecb_data_pointer_set(NRF_ECB, &drv_state.data);
 	drv_state.in_use = false;
+
+	IRQ_CONNECT(ECB_IRQn, ECB_IRQ_PRIORITY, nrf_ecb_isr, NULL, 0);
+
 	return 0;
 }
 
@@ -76,7 +160,17 @@ static int nrf_ecb_query_caps(struct device *dev)
 {
 	ARG_UNUSED(dev);
 
-	return (CAP_RAW_KEY | CAP_SEPARATE_IO_BUFS | CAP_SYNC_OPS);
+	return (CAP_RAW_KEY | CAP_SEPARATE_IO_BUFS | CAP_SYNC_OPS |
+		CAP_ASYNC_OPS);
+}
+
+static int nrf_ecb_callback_set(struct device *dev, crypto_completion_cb cb)
+{
+	ARG_UNUSED(dev);
+
+	drv_state.cb = cb;
+
+	return 0;
 }
 
 static int nrf_ecb_session_setup(struct device *dev, struct cipher_ctx *ctx,
@@ -86,12 +180,10 @@ static int nrf_ecb_session_setup(struct device *dev, struct cipher_ctx *ctx,
 	ARG_UNUSED(dev);
 
 	if ((algo != CRYPTO_CIPHER_ALGO_AES) ||
-	    !(ctx->flags & CAP_SYNC_OPS) ||
 	    (ctx->keylen != ECB_AES_KEY_SIZE) ||
 	    (op_type != CRYPTO_CIPHER_OP_ENCRYPT) ||
 	    (mode != CRYPTO_CIPHER_MODE_ECB)) {
-		LOG_ERR("This driver only supports 128-bit AES ECB encryption"
-			" in synchronous mode");
+		LOG_ERR("This driver only supports 128-bit AES ECB encryption");
 		return -EINVAL;
 	}
 
@@ -107,6 +199,15 @@ static int nrf_ecb_session_setup(struct device *dev, struct cipher_ctx *ctx,
 
 	drv_state.in_use = true;
 
+	if (ctx->flags & CAP_ASYNC_OPS) {
+		drv_state.head = 0U;
+		drv_state.len = 0U;
+		nrf_ecb_int_enable(NRF_ECB, NRF_ECB_INT_ENDECB_MASK |
+					    NRF_ECB_INT_ERRORECB_MASK);
+		NVIC_ClearPendingIRQ(ECB_IRQn);
+		irq_enable(ECB_IRQn);
+	}
+
 	ctx->ops.block_crypt_hndlr = do_ecb_encrypt;
 	ctx->ops.cipher_mode = mode;
 
@@ -121,7 +222,17 @@ static int nrf_ecb_session_setup(struct device *dev, struct cipher_ctx *ctx,
 static int nrf_ecb_session_free(struct device *dev, struct cipher_ctx *sessn)
 {
 	ARG_UNUSED(dev);
-	ARG_UNUSED(sessn);
+
+	if (sessn->flags & CAP_ASYNC_OPS) {
+		/* Let the queued blocks complete */
+		while (drv_state.len > 0U) {
+			k_yield();
+		}
+
+		irq_disable(ECB_IRQn);
+		nrf_ecb_int_disable(NRF_ECB, NRF_ECB_INT_ENDECB_MASK |
+					     NRF_ECB_INT_ERRORECB_MASK);
+	}
 
 	drv_state.in_use = false;
 
@@ -131,7 +242,7 @@ static int nrf_ecb_session_free(struct device *dev, struct cipher_ctx *sessn)
 static const struct crypto_driver_api crypto_enc_funcs = {
 	.begin_session = nrf_ecb_session_setup,
 	.free_session = nrf_ecb_session_free,
-	.crypto_async_callback_set = NULL,
+	.crypto_async_callback_set = nrf_ecb_callback_set,
 	.query_hw_caps = nrf_ecb_query_caps,
 };
 
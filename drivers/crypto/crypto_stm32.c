@@ -22,13 +22,15 @@
 LOG_MODULE_REGISTER(crypto_stm32);
 
 #define CRYP_SUPPORT (CAP_RAW_KEY | CAP_SEPARATE_IO_BUFS | CAP_SYNC_OPS | \
-		      CAP_NO_IV_PREFIX)
+		      CAP_ASYNC_OPS | CAP_NO_IV_PREFIX)
 #define BLOCK_LEN_BYTES 16
 #define BLOCK_LEN_WORDS (BLOCK_LEN_BYTES / sizeof(uint32_t))
 #define CRYPTO_MAX_SESSION CONFIG_CRYPTO_STM32_MAX_SESSION
 
 struct crypto_stm32_session crypto_stm32_sessions[CRYPTO_MAX_SESSION];
 
+DEVICE_DECLARE(crypto_stm32);
+
 static void copy_reverse_words(uint8_t *dst_buf, int dst_len,
 			       uint8_t *src_buf, int src_len)
 {
@@ -43,6 +45,147 @@ static void copy_reverse_words(uint8_t *dst_buf, int dst_len,
 	}
 }
 
+/* Start the first queued operation, the device is held */
+static void crypto_stm32_start(struct device *dev)
+{
+	struct crypto_stm32_data *data = CRYPTO_STM32_DATA(dev);
+	struct crypto_stm32_req *req;
+	struct crypto_stm32_session *session;
+	HAL_StatusTypeDef status;
+
+	while (data->len > 0U) {
+		req = &data->queue[data->head];
+		session = CRYPTO_STM32_SESSN(req->ctx);
+		session->config.pInitVect = req->vec;
+
+		status = HAL_CRYP_SetConfig(&data->hcryp, &session->config);
+		if (status == HAL_OK && req->encrypt) {
+			status = HAL_CRYP_Encrypt_IT(&data->hcryp,
+						     (uint32_t *)req->in_buf,
+						     req->in_len,
+						     (uint32_t *)req->out_buf);
+		} else if (status == HAL_OK) {
+			status = HAL_CRYP_Decrypt_IT(&data->hcryp,
+						     (uint32_t *)req->in_buf,
+						     req->in_len,
+						     (uint32_t *)req->out_buf);
+		}
+
+		if (status == HAL_OK) {
+			return;
+		}
+
+		LOG_ERR("Cannot start operation");
+		data->head = (data->head + 1U) % ARRAY_SIZE(data->queue);
+		data->len--;
+		data->cb(req->pkt, -EIO);
+	}
+
+	data->busy = false;
+	k_sem_give(&data->device_sem);
+}
+
+/* Release the device, to the queued asynchronous operations if any */
+static void crypto_stm32_release(struct device *dev)
+{
+	struct crypto_stm32_data *data = CRYPTO_STM32_DATA(dev);
+	unsigned int key;
+
+	key = irq_lock();
+
+	if (data->len > 0U && !data->busy) {
+		data->busy = true;
+		crypto_stm32_start(dev);
+	} else {
+		k_sem_give(&data->device_sem);
+	}
+
+	irq_unlock(key);
+}
+
+/*
+ * Queue an asynchronous operation. Queued operations are started from the
+ * completion interrupt of the previous one, back to back, while the
+ * device is held.
+ */
+static int crypto_stm32_enqueue(struct device *dev,
+				struct crypto_stm32_req *req)
+{
+	struct crypto_stm32_data *data = CRYPTO_STM32_DATA(dev);
+	unsigned int key;
+
+	if (data->cb == NULL) {
+		LOG_ERR("No completion callback");
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+
+	if (data->len == ARRAY_SIZE(data->queue)) {
+		irq_unlock(key);
+		return -EBUSY;
+	}
+
+	data->queue[(data->head + data->len) % ARRAY_SIZE(data->queue)] =
+		*req;
+	data->len++;
+
+	if (!data->busy && k_sem_take(&data->device_sem, K_NO_WAIT) == 0) {
+		data->busy = true;
+		crypto_stm32_start(dev);
+	}
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+static void crypto_stm32_complete(CRYP_HandleTypeDef *hcryp, int status)
+{
+	struct crypto_stm32_data *data =
+		CONTAINER_OF(hcryp, struct crypto_stm32_data, hcryp);
+	struct crypto_stm32_req *req = &data->queue[data->head];
+	struct cipher_pkt *pkt = req->pkt;
+
+	if (status == 0) {
+		pkt->out_len = req->out_len;
+	}
+
+	data->head = (data->head + 1U) % ARRAY_SIZE(data->queue);
+	data->len--;
+
+	/* Start the next operation before running the callback */
+	crypto_stm32_start(DEVICE_GET(crypto_stm32));
+
+	data->cb(pkt, status);
+}
+
+void HAL_CRYP_OutCpltCallback(CRYP_HandleTypeDef *hcryp)
+{
+	crypto_stm32_complete(hcryp, 0);
+}
+
+void HAL_CRYP_ErrorCallback(CRYP_HandleTypeDef *hcryp)
+{
+	LOG_ERR("Operation error");
+	crypto_stm32_complete(hcryp, -EIO);
+}
+
+static void crypto_stm32_isr(void *arg)
+{
+	struct device *dev = arg;
+
+	HAL_CRYP_IRQHandler(&CRYPTO_STM32_DATA(dev)->hcryp);
+}
+
+static int crypto_stm32_callback_set(struct device *dev,
+				     crypto_completion_cb cb)
+{
+	CRYPTO_STM32_DATA(dev)->cb = cb;
+
+	return 0;
+}
+
 static int do_encrypt(struct cipher_ctx *ctx, uint8_t *in_buf, int in_len,
 		      uint8_t *out_buf)
 {
@@ -56,7 +199,7 @@ static int do_encrypt(struct cipher_ctx *ctx, uint8_t *in_buf, int in_len,
 	status = HAL_CRYP_SetConfig(&data->hcryp, &session->config);
 	if (status != HAL_OK) {
 		LOG_ERR("Configuration error");
-		k_sem_give(&data->device_sem);
+		crypto_stm32_release(ctx->device);
 		return -EIO;
 	}
 
@@ -64,11 +207,11 @@ static int do_encrypt(struct cipher_ctx *ctx, uint8_t *in_buf, int in_len,
 				  (uint32_t *)out_buf, HAL_MAX_DELAY);
 	if (status != HAL_OK) {
 		LOG_ERR("Encryption error");
-		k_sem_give(&data->device_sem);
+		crypto_stm32_release(ctx->device);
 		return -EIO;
 	}
 
-	k_sem_give(&data->device_sem);
+	crypto_stm32_release(ctx->device);
 
 	return 0;
 }
@@ -86,7 +229,7 @@ static int do_decrypt(struct cipher_ctx *ctx, uint8_t *in_buf, int in_len,
 	status = HAL_CRYP_SetConfig(&data->hcryp, &session->config);
 	if (status != HAL_OK) {
 		LOG_ERR("Configuration error");
-		k_sem_give(&data->device_sem);
+		crypto_stm32_release(ctx->device);
 		return -EIO;
 	}
 
@@ -94,40 +237,53 @@ static int do_decrypt(struct cipher_ctx *ctx, uint8_t *in_buf, int in_len,
 				  (uint32_t *)out_buf, HAL_MAX_DELAY);
 	if (status != HAL_OK) {
 		LOG_ERR("Decryption error");
-		k_sem_give(&data->device_sem);
+		crypto_stm32_release(ctx->device);
 		return -EIO;
 	}
 
-	k_sem_give(&data->device_sem);
+	crypto_stm32_release(ctx->device);
 
 	return 0;
 }
 
-static int crypto_stm32_ecb_encrypt(struct cipher_ctx *ctx,
-				    struct cipher_pkt *pkt)
+/* Run an operation, or queue it for asynchronous sessions */
+static int crypto_stm32_submit(struct crypto_stm32_req *req)
 {
+	struct cipher_ctx *ctx = req->ctx;
+	struct crypto_stm32_session *session = CRYPTO_STM32_SESSN(ctx);
 	int ret;
 
-	/* For security reasons, ECB mode should not be used to encrypt
-	 * more than one block. Use CBC mode instead.
-	 */
-	if (pkt->in_len > 16) {
-		LOG_ERR("Cannot encrypt more than 1 block");
-		return -EINVAL;
+	if (ctx->flags & CAP_ASYNC_OPS) {
+		return crypto_stm32_enqueue(ctx->device, req);
+	}
+
+	session->config.pInitVect = req->vec;
+
+	if (req->encrypt) {
+		ret = do_encrypt(ctx, req->in_buf, req->in_len, req->out_buf);
+	} else {
+		ret = do_decrypt(ctx, req->in_buf, req->in_len, req->out_buf);
 	}
 
-	ret = do_encrypt(ctx, pkt->in_buf, pkt->in_len, pkt->out_buf);
 	if (ret == 0) {
-		pkt->out_len = 16;
+		req->pkt->out_len = req->out_len;
 	}
 
 	return ret;
 }
 
-static int crypto_stm32_ecb_decrypt(struct cipher_ctx *ctx,
-				    struct cipher_pkt *pkt)
+static int crypto_stm32_ecb_op(struct cipher_ctx *ctx,
+			       struct cipher_pkt *pkt, bool encrypt)
 {
-	int ret;
+	struct crypto_stm32_req req = {
+		.ctx = ctx,
+		.pkt = pkt,
+		.in_buf = pkt->in_buf,
+		.in_len = pkt->in_len,
+		.out_buf = pkt->out_buf,
+		.out_len = 16,
+		.encrypt = encrypt,
+	};
 
 	/* For security reasons, ECB mode should not be used to encrypt
 	 * more than one block. Use CBC mode instead.
@@ -137,104 +293,101 @@ static int crypto_stm32_ecb_decrypt(struct cipher_ctx *ctx,
 		return -EINVAL;
 	}
 
-	ret = do_decrypt(ctx, pkt->in_buf, pkt->in_len, pkt->out_buf);
-	if (ret == 0) {
-		pkt->out_len = 16;
-	}
+	return crypto_stm32_submit(&req);
+}
 
-	return ret;
+static int crypto_stm32_ecb_encrypt(struct cipher_ctx *ctx,
+				    struct cipher_pkt *pkt)
+{
+	return crypto_stm32_ecb_op(ctx, pkt, true);
+}
+
+static int crypto_stm32_ecb_decrypt(struct cipher_ctx *ctx,
+				    struct cipher_pkt *pkt)
+{
+	return crypto_stm32_ecb_op(ctx, pkt, false);
 }
 
 static int crypto_stm32_cbc_encrypt(struct cipher_ctx *ctx,
 				    struct cipher_pkt *pkt, uint8_t *iv)
 {
-	int ret;
-	uint32_t vec[BLOCK_LEN_WORDS];
-	int out_offset = 0;
-
-	struct crypto_stm32_session *session = CRYPTO_STM32_SESSN(ctx);
-
-	copy_reverse_words((uint8_t *)vec, sizeof(vec), iv, BLOCK_LEN_BYTES);
-	session->config.pInitVect = vec;
+	struct crypto_stm32_req req = {
+		.ctx = ctx,
+		.pkt = pkt,
+		.in_buf = pkt->in_buf,
+		.in_len = pkt->in_len,
+		.out_buf = pkt->out_buf,
+		.out_len = pkt->in_len,
+		.encrypt = true,
+	};
+
+	copy_reverse_words((uint8_t *)req.vec, sizeof(req.vec), iv,
+			   BLOCK_LEN_BYTES);
 
 	if ((ctx->flags & CAP_NO_IV_PREFIX) == 0U) {
 		/* Prefix IV to ciphertext unless CAP_NO_IV_PREFIX is set. */
 		memcpy(pkt->out_buf, iv, 16);
-		out_offset = 16;
-	}
-
-	ret = do_encrypt(ctx, pkt->in_buf, pkt->in_len,
-			 pkt->out_buf + out_offset);
-	if (ret == 0) {
-		pkt->out_len = pkt->in_len + out_offset;
+		req.out_buf += 16;
+		req.out_len += 16;
 	}
 
-	return ret;
+	return crypto_stm32_submit(&req);
 }
 
 static int crypto_stm32_cbc_decrypt(struct cipher_ctx *ctx,
 				    struct cipher_pkt *pkt, uint8_t *iv)
 {
-	int ret;
-	uint32_t vec[BLOCK_LEN_WORDS];
-	int in_offset = 0;
-
-	struct crypto_stm32_session *session = CRYPTO_STM32_SESSN(ctx);
-
-	copy_reverse_words((uint8_t *)vec, sizeof(vec), iv, BLOCK_LEN_BYTES);
-	session->config.pInitVect = vec;
+	struct crypto_stm32_req req = {
+		.ctx = ctx,
+		.pkt = pkt,
+		.in_buf = pkt->in_buf,
+		.in_len = pkt->in_len,
+		.out_buf = pkt->out_buf,
+		.out_len = pkt->in_len,
+		.encrypt = false,
+	};
+
+	copy_reverse_words((uint8_t *)req.vec, sizeof(req.vec), iv,
+			   BLOCK_LEN_BYTES);
 
 	if ((ctx->flags & CAP_NO_IV_PREFIX) == 0U) {
-		in_offset = 16;
+		req.in_buf += 16;
+		req.out_len -= 16;
 	}
 
-	ret = do_decrypt(ctx, pkt->in_buf + in_offset, pkt->in_len,
-			 pkt->out_buf);
-	if (ret == 0) {
-		pkt->out_len = pkt->in_len - in_offset;
-	}
+	return crypto_stm32_submit(&req);
+}
 
-	return ret;
+static int crypto_stm32_ctr_op(struct cipher_ctx *ctx,
+			       struct cipher_pkt *pkt, uint8_t *iv,
+			       bool encrypt)
+{
+	int ivlen = ctx->keylen - (ctx->mode_params.ctr_info.ctr_len >> 3);
+	struct crypto_stm32_req req = {
+		.ctx = ctx,
+		.pkt = pkt,
+		.in_buf = pkt->in_buf,
+		.in_len = pkt->in_len,
+		.out_buf = pkt->out_buf,
+		.out_len = pkt->in_len,
+		.encrypt = encrypt,
+	};
+
+	copy_reverse_words((uint8_t *)req.vec, sizeof(req.vec), iv, ivlen);
+
+	return crypto_stm32_submit(&req);
 }
 
 static int crypto_stm32_ctr_encrypt(struct cipher_ctx *ctx,
 				    struct cipher_pkt *pkt, uint8_t *iv)
 {
-	int ret;
-	uint32_t ctr[BLOCK_LEN_WORDS] = {0};
-	int ivlen = ctx->keylen - (ctx->mode_params.ctr_info.ctr_len >> 3);
-
-	struct crypto_stm32_session *session = CRYPTO_STM32_SESSN(ctx);
-
-	copy_reverse_words((uint8_t *)ctr, sizeof(ctr), iv, ivlen);
-	session->config.pInitVect = ctr;
-
-	ret = do_encrypt(ctx, pkt->in_buf, pkt->in_len, pkt->out_buf);
-	if (ret == 0) {
-		pkt->out_len = pkt->in_len;
-	}
-
-	return ret;
+	return crypto_stm32_ctr_op(ctx, pkt, iv, true);
 }
 
 static int crypto_stm32_ctr_decrypt(struct cipher_ctx *ctx,
 				    struct cipher_pkt *pkt, uint8_t *iv)
 {
-	int ret;
-	uint32_t ctr[BLOCK_LEN_WORDS] = {0};
-	int ivlen = ctx->keylen - (ctx->mode_params.ctr_info.ctr_len >> 3);
-
-	struct crypto_stm32_session *session = CRYPTO_STM32_SESSN(ctx);
-
-	copy_reverse_words((uint8_t *)ctr, sizeof(ctr), iv, ivlen);
-	session->config.pInitVect = ctr;
-
-	ret = do_decrypt(ctx, pkt->in_buf, pkt->in_len, pkt->out_buf);
-	if (ret == 0) {
-		pkt->out_len = pkt->in_len;
-	}
-
-	return ret;
+	return crypto_stm32_ctr_op(ctx, pkt, iv, false);
 }
 
 static int crypto_stm32_get_unused_session_index(struct device *dev)
@@ -390,6 +543,10 @@ static int crypto_stm32_session_free(struct device *dev,
 	struct crypto_stm32_data *data = CRYPTO_STM32_DATA(dev);
 	struct crypto_stm32_session *session = CRYPTO_STM32_SESSN(ctx);
 
+	/* Let the queued asynchronous operations complete */
+	k_sem_take(&data->device_sem, K_FOREVER);
+	k_sem_give(&data->device_sem);
+
 	session->in_use = false;
 
 	k_sem_take(&data->session_sem, K_FOREVER);
@@ -439,13 +596,17 @@ static int crypto_stm32_init(struct device *dev)
 		return -EIO;
 	}
 
+	IRQ_CONNECT(DT_INST_IRQN(0), DT_INST_IRQ(0, priority),
+		    crypto_stm32_isr, DEVICE_GET(crypto_stm32), 0);
+	irq_enable(DT_INST_IRQN(0));
+
 	return 0;
 }
 
 static struct crypto_driver_api crypto_enc_funcs = {
 	.begin_session = crypto_stm32_session_setup,
 	.free_session = crypto_stm32_session_free,
-	.crypto_async_callback_set = NULL,
+	.crypto_async_callback_set = crypto_stm32_callback_set,
 	.query_hw_caps = crypto_stm32_query_caps,
 };
 
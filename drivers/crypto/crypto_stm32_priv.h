@@ -15,10 +15,28 @@ struct crypto_stm32_config {
 	struct stm32_pclken pclken;
 };
 
+/* An operation, as run by the peripheral */
+struct crypto_stm32_req {
+	struct cipher_ctx *ctx;
+	struct cipher_pkt *pkt;
+	uint8_t *in_buf;
+	uint8_t *out_buf;
+	int in_len;
+	int out_len;
+	uint32_t vec[4];
+	bool encrypt;
+};
+
 struct crypto_stm32_data {
 	CRYP_HandleTypeDef hcryp;
 	struct k_sem device_sem;
 	struct k_sem session_sem;
+	/* Asynchronous operations, the first one is running when busy */
+	struct crypto_stm32_req queue[CONFIG_CRYPTO_ASYNC_QUEUE_SIZE];
+	uint8_t head;
+	uint8_t len;
+	bool busy;
+	crypto_completion_cb cb;
 };
 
 struct crypto_stm32_session {
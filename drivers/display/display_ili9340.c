@@ -29,6 +29,12 @@ struct ili9340_data {
 #if DT_INST_SPI_DEV_HAS_CS_GPIOS(0)
 	struct spi_cs_control cs_ctrl;
 #endif
+#ifdef CONFIG_DISPLAY_WRITE_ASYNC
+	/* Signal of the pending asynchronous write, if any */
+	struct k_poll_signal *async;
+	struct spi_buf async_buf;
+	struct spi_buf_set async_bufs;
+#endif
 };
 
 #define ILI9340_CMD_DATA_PIN_COMMAND 1
@@ -41,6 +47,23 @@ struct ili9340_data {
 #define ILI9340_RGB_SIZE 3U
 #endif
 
+/* Wait for the asynchronous write, the SPI bus and D/C pin are busy. */
+static void ili9340_async_wait(struct ili9340_data *data)
+{
+#ifdef CONFIG_DISPLAY_WRITE_ASYNC
+	struct k_poll_event evt;
+
+	if (data->async == NULL) {
+		return;
+	}
+
+	k_poll_event_init(&evt, K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY,
+			  data->async);
+	k_poll(&evt, 1, K_FOREVER);
+	data->async = NULL;
+#endif
+}
+
 static void ili9340_exit_sleep(struct ili9340_data *data)
 {
 	ili9340_transmit(data, ILI9340_CMD_EXIT_SLEEP, NULL, 0);
@@ -179,6 +202,50 @@ static int ili9340_write(const struct device *dev, const uint16_t x,
 	return 0;
 }
 
+#ifdef CONFIG_DISPLAY_WRITE_ASYNC
+static int ili9340_write_async(const struct device *dev, const uint16_t x,
+			       const uint16_t y,
+			       const struct display_buffer_descriptor *desc,
+			       const void *buf, struct k_poll_signal *signal)
+{
+	struct ili9340_data *data = (struct ili9340_data *)dev->data;
+	int err;
+
+	k_poll_signal_reset(signal);
+
+	if (desc->pitch > desc->width) {
+		/* Rows are not contiguous, write them one by one */
+		err = ili9340_write(dev, x, y, desc, buf);
+		k_poll_signal_raise(signal, err);
+		return err;
+	}
+
+	__ASSERT((desc->width * ILI9340_RGB_SIZE * desc->height)
+		 <= desc->buf_size, "Input buffer to small");
+
+	LOG_DBG("Writing %dx%d (w,h) @ %dx%d (x,y) async", desc->width,
+		desc->height, x, y);
+	ili9340_set_mem_area(data, x, y, desc->width, desc->height);
+	ili9340_transmit(data, ILI9340_CMD_MEM_WRITE, NULL, 0);
+
+	data->async_buf.buf = (void *)buf;
+	data->async_buf.len = desc->width * ILI9340_RGB_SIZE * desc->height;
+	data->async_bufs.buffers = &data->async_buf;
+	data->async_bufs.count = 1;
+
+	gpio_pin_set(data->command_data_gpio,
+		     DT_INST_GPIO_PIN(0, cmd_data_gpios),
+		     ILI9340_CMD_DATA_PIN_DATA);
+	err = spi_write_async(data->spi_dev, &data->spi_config,
+			      &data->async_bufs, signal);
+	if (err == 0) {
+		data->async = signal;
+	}
+
+	return err;
+}
+#endif
+
 static int ili9340_read(const struct device *dev, const uint16_t x,
 			const uint16_t y,
 			const struct display_buffer_descriptor *desc,
@@ -272,6 +339,8 @@ void ili9340_transmit(struct ili9340_data *data, uint8_t cmd, void *tx_data,
 	struct spi_buf tx_buf = { .buf = &cmd, .len = 1 };
 	struct spi_buf_set tx_bufs = { .buffers = &tx_buf, .count = 1 };
 
+	ili9340_async_wait(data);
+
 	gpio_pin_set(data->command_data_gpio,
 		     DT_INST_GPIO_PIN(0, cmd_data_gpios),
 		     ILI9340_CMD_DATA_PIN_COMMAND);
@@ -298,6 +367,9 @@ static const struct display_driver_api ili9340_api = {
 	.get_capabilities = ili9340_get_capabilities,
 	.set_pixel_format = ili9340_set_pixel_format,
 	.set_orientation = ili9340_set_orientation,
+#ifdef CONFIG_DISPLAY_WRITE_ASYNC
+	.write_async = ili9340_write_async,
+#endif
 };
 
 static struct ili9340_data ili9340_data;
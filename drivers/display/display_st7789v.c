@@ -55,6 +55,12 @@ struct st7789v_data {
 #ifdef CONFIG_DEVICE_POWER_MANAGEMENT
 	uint32_t pm_state;
 #endif
+#ifdef CONFIG_DISPLAY_WRITE_ASYNC
+	/* Signal of the pending asynchronous write, if any */
+	struct k_poll_signal *async;
+	struct spi_buf async_buf;
+	struct spi_buf_set async_bufs;
+#endif
 };
 
 #ifdef CONFIG_ST7789V_RGB565
@@ -75,12 +81,31 @@ static void st7789v_set_cmd(struct st7789v_data *data, int is_cmd)
 	gpio_pin_set(data->cmd_data_gpio, ST7789V_CMD_DATA_PIN, is_cmd);
 }
 
+/* Wait for the asynchronous write, the SPI bus and D/C pin are busy. */
+static void st7789v_async_wait(struct st7789v_data *data)
+{
+#ifdef CONFIG_DISPLAY_WRITE_ASYNC
+	struct k_poll_event evt;
+
+	if (data->async == NULL) {
+		return;
+	}
+
+	k_poll_event_init(&evt, K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY,
+			  data->async);
+	k_poll(&evt, 1, K_FOREVER);
+	data->async = NULL;
+#endif
+}
+
 static void st7789v_transmit(struct st7789v_data *data, uint8_t cmd,
 		uint8_t *tx_data, size_t tx_count)
 {
 	struct spi_buf tx_buf = { .buf = &cmd, .len = 1 };
 	struct spi_buf_set tx_bufs = { .buffers = &tx_buf, .count = 1 };
 
+	st7789v_async_wait(data);
+
 	st7789v_set_cmd(data, 1);
 	spi_write(data->spi_dev, &data->spi_config, &tx_bufs);
 
@@ -203,6 +228,50 @@ static int st7789v_write(const struct device *dev,
 	return 0;
 }
 
+#ifdef CONFIG_DISPLAY_WRITE_ASYNC
+static int st7789v_write_async(const struct device *dev,
+			       const uint16_t x,
+			       const uint16_t y,
+			       const struct display_buffer_descriptor *desc,
+			       const void *buf,
+			       struct k_poll_signal *signal)
+{
+	struct st7789v_data *data = (struct st7789v_data *)dev->data;
+	int err;
+
+	k_poll_signal_reset(signal);
+
+	if (desc->pitch > desc->width) {
+		/* Rows are not contiguous, write them one by one */
+		err = st7789v_write(dev, x, y, desc, buf);
+		k_poll_signal_raise(signal, err);
+		return err;
+	}
+
+	__ASSERT((desc->width * ST7789V_PIXEL_SIZE * desc->height) <=
+		 desc->buf_size, "Input buffer to small");
+
+	LOG_DBG("Writing %dx%d (w,h) @ %dx%d (x,y) async",
+			desc->width, desc->height, x, y);
+	st7789v_set_mem_area(data, x, y, desc->width, desc->height);
+	st7789v_transmit(data, ST7789V_CMD_RAMWR, NULL, 0);
+
+	data->async_buf.buf = (void *)buf;
+	data->async_buf.len = desc->width * ST7789V_PIXEL_SIZE * desc->height;
+	data->async_bufs.buffers = &data->async_buf;
+	data->async_bufs.count = 1;
+
+	st7789v_set_cmd(data, 0);
+	err = spi_write_async(data->spi_dev, &data->spi_config,
+			      &data->async_bufs, signal);
+	if (err == 0) {
+		data->async = signal;
+	}
+
+	return err;
+}
+#endif
+
 static void *st7789v_get_framebuffer(const struct device *dev)
 {
 	return NULL;
@@ -451,6 +520,9 @@ static const struct display_driver_api st7789v_api = {
 	.get_capabilities = st7789v_get_capabilities,
 	.set_pixel_format = st7789v_set_pixel_format,
 	.set_orientation = st7789v_set_orientation,
+#ifdef CONFIG_DISPLAY_WRITE_ASYNC
+	.write_async = st7789v_write_async,
+#endif
 };
 
 static struct st7789v_data st7789v_data = {
@@ -363,6 +363,10 @@ static void ssd16xx_get_capabilities(const struct device *dev,
 			    SCREEN_INFO_MONO_MSB_FIRST |
 			    SCREEN_INFO_EPD |
 			    SCREEN_INFO_DOUBLE_BUFFER;
+#if DT_INST_NODE_HAS_PROP(0, lut_default)
+	/* The default waveform only drives the pixels that change */
+	caps->screen_info |= SCREEN_INFO_PARTIAL_UPDATE;
+#endif
 }
 
 static int ssd16xx_set_orientation(const struct device *dev,
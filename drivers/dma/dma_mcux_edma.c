@@ -64,13 +64,13 @@ struct dma_mcux_edma_data {
 static void nxp_edma_callback(edma_handle_t *handle, void *param,
 			      bool transferDone, uint32_t tcds)
 {
-	int ret = 1;
+	int ret = DMA_STATUS_BLOCK;
 	struct call_back *data = (struct call_back *)param;
 	uint32_t channel = handle->channel;
 
 	if (transferDone) {
 		data->busy = false;
-		ret = 0;
+		ret = DMA_STATUS_COMPLETE;
 	}
 	LOG_DBG("transfer %d", tcds);
 	data->dma_callback(data->dev, data->user_data, channel, ret);
@@ -187,6 +187,31 @@ static void dma_mcux_edma_error_irq_handler(void *arg)
 #endif
 }
 
+/* Make the last TCD of the queue load the first one again. */
+static void dma_mcux_edma_link_cyclic(struct device *dev, uint32_t channel,
+				      struct dma_config *config)
+{
+	uint32_t count = MAX(config->block_count, 1U);
+	edma_tcd_t *first = &tcdpool[channel][0];
+	edma_tcd_t *last = &tcdpool[channel][count - 1U];
+	edma_tcd_t *regs = (edma_tcd_t *)(uint32_t)&DEV_BASE(dev)->TCD[channel];
+	uint32_t csr = DMA_CSR_ESG_MASK;
+
+	/* Half of a single block lets the client refill the other */
+	if ((count == 1U) && config->complete_callback_en) {
+		csr |= DMA_CSR_INTHALF_MASK;
+	}
+
+	last->DLAST_SGA = (uint32_t)first;
+	last->CSR = (last->CSR | csr) & ~DMA_CSR_DREQ_MASK;
+
+	/* A single TCD is already loaded in the channel registers */
+	if (count == 1U) {
+		regs->DLAST_SGA = (uint32_t)first;
+		regs->CSR = (regs->CSR | csr) & ~DMA_CSR_DREQ_MASK;
+	}
+}
+
 /* Configure a channel */
 static int dma_mcux_edma_configure(struct device *dev, uint32_t channel,
 				   struct dma_config *config)
@@ -284,7 +309,8 @@ static int dma_mcux_edma_configure(struct device *dev, uint32_t channel,
 				    config->linked_channel);
 	}
 
-	if (block_config->source_gather_en || block_config->dest_scatter_en) {
+	if (block_config->source_gather_en || block_config->dest_scatter_en ||
+	    (config->block_count > 1U) || config->cyclic) {
 		if (config->block_count > CONFIG_DMA_TCD_QUEUE_SIZE) {
 			LOG_ERR("please config DMA_TCD_QUEUE_SIZE as %d",
 				config->block_count);
@@ -304,6 +330,10 @@ static int dma_mcux_edma_configure(struct device *dev, uint32_t channel,
 			EDMA_SubmitTransfer(p_handle, &(data->transferConfig));
 			block_config = block_config->next_block;
 		}
+
+		if (config->cyclic) {
+			dma_mcux_edma_link_cyclic(dev, channel, config);
+		}
 	} else {
 		/* block_count shall be 1 */
 		status_t ret;
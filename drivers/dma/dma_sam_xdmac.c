@@ -26,10 +26,21 @@ LOG_MODULE_REGISTER(dma_sam_xdmac);
 #define XDMAC_INT_ERR (XDMAC_CIE_RBIE | XDMAC_CIE_WBIE | XDMAC_CIE_ROIE)
 #define DMA_CHANNELS_NO  XDMACCHID_NUMBER
 
+#if __DCACHE_PRESENT == 1
+#define DCACHE_CLEAN(addr, size) \
+	SCB_CleanDCache_by_Addr((uint32_t *)addr, size)
+#else
+#define DCACHE_CLEAN(addr, size) {; }
+#endif
+
 /* DMA channel configuration */
 struct sam_xdmac_channel_cfg {
 	void *user_data;
 	dma_callback_t callback;
+	/* Transfer runs through the linked list descriptors */
+	bool linked;
+	struct sam_xdmac_linked_list_desc_view1
+		desc[CONFIG_DMA_SAM_XDMAC_LL_SIZE] __aligned(32);
 };
 
 /* Device constant configuration parameters */
@@ -59,7 +70,8 @@ static void sam_xdmac_isr(void *arg)
 	Xdmac *const xdmac = dev_cfg->regs;
 	struct sam_xdmac_channel_cfg *channel_cfg;
 	uint32_t isr_status;
-	uint32_t err;
+	uint32_t cis;
+	int status;
 
 	/* Get global interrupt status */
 	isr_status = xdmac->XDMAC_GIS;
@@ -71,13 +83,22 @@ static void sam_xdmac_isr(void *arg)
 
 		channel_cfg = &dev_data->dma_channels[channel];
 
-		/* Get channel errors */
-		err = xdmac->XDMAC_CHID[channel].XDMAC_CIS & XDMAC_INT_ERR;
+		/* Get channel status, reading it clears it */
+		cis = xdmac->XDMAC_CHID[channel].XDMAC_CIS;
+
+		if (cis & XDMAC_INT_ERR) {
+			status = -EIO;
+		} else if (channel_cfg->linked && !(cis & XDMAC_CIS_LIS)) {
+			/* End of a block, the linked list goes on */
+			status = DMA_STATUS_BLOCK;
+		} else {
+			status = DMA_STATUS_COMPLETE;
+		}
 
 		/* Execute callback */
 		if (channel_cfg->callback) {
 			channel_cfg->callback(dev, channel_cfg->user_data,
-					      channel, err);
+					      channel, status);
 		}
 	}
 }
@@ -168,6 +189,8 @@ int sam_xdmac_transfer_configure(struct device *dev, uint32_t channel,
 
 		/* Set next descriptor address */
 		xdmac->XDMAC_CHID[channel].XDMAC_CNDA = param->nda;
+		/* View 1 descriptors hold a block of a single microblock */
+		xdmac->XDMAC_CHID[channel].XDMAC_CBC = param->blen;
 	}
 
 	/* Set next descriptor configuration */
@@ -176,6 +199,49 @@ int sam_xdmac_transfer_configure(struct device *dev, uint32_t channel,
 	return 0;
 }
 
+/* Describe each block with a view 1 descriptor, the last one links back
+ * to the first for a cyclic transfer.
+ */
+static int sam_xdmac_linked_list_build(struct device *dev, uint32_t channel,
+				       struct dma_config *cfg,
+				       uint32_t data_size)
+{
+	struct sam_xdmac_linked_list_desc_view1 *desc =
+		DEV_DATA(dev)->dma_channels[channel].desc;
+	struct dma_block_config *block = cfg->head_block;
+	uint32_t count = MAX(cfg->block_count, 1U);
+
+	for (uint32_t i = 0U; i < count; i++) {
+		if (block == NULL) {
+			LOG_ERR("Block %d of %d missing", i, count);
+			return -EINVAL;
+		}
+
+		desc[i].mbr_ubc = XDMA_UBC_NVIEW_NDV1
+			| XDMA_UBC_NSEN_UPDATED
+			| XDMA_UBC_NDEN_UPDATED
+			| (block->block_size >> data_size);
+		desc[i].mbr_sa = block->source_address;
+		desc[i].mbr_da = block->dest_address;
+
+		if (i + 1U < count) {
+			desc[i].mbr_nda = (uint32_t)&desc[i + 1U];
+			desc[i].mbr_ubc |= XDMA_UBC_NDE_FETCH_EN;
+		} else if (cfg->cyclic) {
+			desc[i].mbr_nda = (uint32_t)&desc[0];
+			desc[i].mbr_ubc |= XDMA_UBC_NDE_FETCH_EN;
+		} else {
+			desc[i].mbr_nda = 0U;
+		}
+
+		block = block->next_block;
+	}
+
+	DCACHE_CLEAN(desc, count * sizeof(*desc));
+
+	return 0;
+}
+
 static int sam_xdmac_config(struct device *dev, uint32_t channel,
 			    struct dma_config *cfg)
 {
@@ -199,9 +265,8 @@ static int sam_xdmac_config(struct device *dev, uint32_t channel,
 		return -EINVAL;
 	}
 
-	if (cfg->block_count != 1U) {
-		LOG_ERR("Only single block transfer is currently supported."
-			    " Please submit a patch.");
+	if (cfg->block_count > CONFIG_DMA_SAM_XDMAC_LL_SIZE) {
+		LOG_ERR("Set DMA_SAM_XDMAC_LL_SIZE to %d", cfg->block_count);
 		return -EINVAL;
 	}
 
@@ -259,11 +324,28 @@ static int sam_xdmac_config(struct device *dev, uint32_t channel,
 
 	dev_data->dma_channels[channel].callback = cfg->dma_callback;
 	dev_data->dma_channels[channel].user_data = cfg->user_data;
+	dev_data->dma_channels[channel].linked =
+		(cfg->block_count > 1U) || cfg->cyclic;
 
 	(void)memset(&transfer_cfg, 0, sizeof(transfer_cfg));
 	transfer_cfg.sa = cfg->head_block->source_address;
 	transfer_cfg.da = cfg->head_block->dest_address;
-	transfer_cfg.ublen = cfg->head_block->block_size >> data_size;
+
+	if (dev_data->dma_channels[channel].linked) {
+		ret = sam_xdmac_linked_list_build(dev, channel, cfg, data_size);
+		if (ret < 0) {
+			return ret;
+		}
+
+		transfer_cfg.nda =
+			(uint32_t)dev_data->dma_channels[channel].desc;
+		transfer_cfg.ndc = XDMAC_CNDC_NDE_DSCR_FETCH_EN
+			| XDMAC_CNDC_NDSUP_SRC_PARAMS_UPDATED
+			| XDMAC_CNDC_NDDUP_DST_PARAMS_UPDATED
+			| XDMAC_CNDC_NDVIEW_NDV1;
+	} else {
+		transfer_cfg.ublen = cfg->head_block->block_size >> data_size;
+	}
 
 	ret = sam_xdmac_transfer_configure(dev, channel, &transfer_cfg);
 
@@ -54,6 +54,81 @@ static void dma_stm32_clear_stream_irq(struct device *dev, uint32_t id)
 	stm32_dma_clear_stream_irq(dma, id);
 }
 
+static void dma_stm32_notify(struct device *dev,
+			     struct dma_stm32_stream *stream, uint32_t id,
+			     int status)
+{
+#ifdef CONFIG_DMAMUX_STM32
+	/* the callback function expects the dmamux channel nb */
+	stream->dma_callback(dev, stream->user_data,
+			     stream->mux_channel, status);
+#else
+	stream->dma_callback(dev, stream->user_data,
+			     id + STREAM_OFFSET, status);
+#endif /* CONFIG_DMAMUX_STM32 */
+}
+
+static int dma_stm32_load_block(DMA_TypeDef *dma, uint32_t id,
+				struct dma_stm32_stream *stream,
+				uint32_t src, uint32_t dst, size_t size)
+{
+	stm32_dma_disable_stream(dma, id);
+
+	switch (stream->direction) {
+	case MEMORY_TO_PERIPHERAL:
+		LL_DMA_SetMemoryAddress(dma, table_ll_stream[id], src);
+		LL_DMA_SetPeriphAddress(dma, table_ll_stream[id], dst);
+		break;
+	case MEMORY_TO_MEMORY:
+	case PERIPHERAL_TO_MEMORY:
+		LL_DMA_SetPeriphAddress(dma, table_ll_stream[id], src);
+		LL_DMA_SetMemoryAddress(dma, table_ll_stream[id], dst);
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	if (stream->source_periph) {
+		LL_DMA_SetDataLength(dma, table_ll_stream[id],
+				     size / stream->src_size);
+	} else {
+		LL_DMA_SetDataLength(dma, table_ll_stream[id],
+				     size / stream->dst_size);
+	}
+
+	return 0;
+}
+
+/* Start the block following the one just completed, if any. */
+static bool dma_stm32_next_block(struct device *dev, uint32_t id,
+				 struct dma_stm32_stream *stream)
+{
+	const struct dma_stm32_config *config = dev->config;
+	DMA_TypeDef *dma = (DMA_TypeDef *)(config->base);
+	struct dma_block_config *block;
+
+	if (stream->block_count <= 1U) {
+		return false;
+	}
+
+	if (++stream->block_index < stream->block_count) {
+		block = stream->block->next_block;
+	} else if (stream->cyclic) {
+		stream->block_index = 0U;
+		block = stream->head_block;
+	} else {
+		return false;
+	}
+
+	stream->block = block;
+	dma_stm32_clear_stream_irq(dev, id);
+	dma_stm32_load_block(dma, id, stream, block->source_address,
+			     block->dest_address, block->block_size);
+	stm32_dma_enable_stream(dma, id);
+
+	return true;
+}
+
 static void dma_stm32_irq_handler(void *arg)
 {
 	struct device *dev = arg;
@@ -67,6 +142,10 @@ static void dma_stm32_irq_handler(void *arg)
 		if (func_ll_is_active_tc[id](dma)) {
 			break;
 		}
+		if (func_ll_is_active_ht[id](dma) &&
+		    LL_DMA_IsEnabledIT_HT(dma, table_ll_stream[id])) {
+			break;
+		}
 		if (stm32_dma_is_irq_happened(dma, id)) {
 			break;
 		}
@@ -79,45 +158,42 @@ static void dma_stm32_irq_handler(void *arg)
 
 	stream = &data->streams[id];
 
-	if (!IS_ENABLED(CONFIG_DMAMUX_STM32)) {
-		stream->busy = false;
-	}
-
 	/* the dma stream id is in range from STREAM_OFFSET..<dma-requests> */
 	if (func_ll_is_active_tc[id](dma)) {
 		func_ll_clear_tc[id](dma);
+		/* a pending half transfer belongs to the block just done */
+		func_ll_clear_ht[id](dma);
+
+		if (dma_stm32_next_block(dev, id, stream) || stream->cyclic) {
+			if (stream->block_callback) {
+				dma_stm32_notify(dev, stream, id,
+						 DMA_STATUS_BLOCK);
+			}
+			return;
+		}
 
-#ifdef CONFIG_DMAMUX_STM32
 		stream->busy = false;
-		/* the callback function expects the dmamux channel nb */
-		stream->dma_callback(dev, stream->user_data,
-				     stream->mux_channel, 0);
-#else
-		stream->dma_callback(dev, stream->user_data,
-				     id + STREAM_OFFSET, 0);
-#endif /* CONFIG_DMAMUX_STM32 */
+		dma_stm32_notify(dev, stream, id, DMA_STATUS_COMPLETE);
+	} else if (func_ll_is_active_ht[id](dma) &&
+		   LL_DMA_IsEnabledIT_HT(dma, table_ll_stream[id])) {
+		func_ll_clear_ht[id](dma);
+		dma_stm32_notify(dev, stream, id, DMA_STATUS_BLOCK);
 	} else if (stm32_dma_is_unexpected_irq_happened(dma, id)) {
 		LOG_ERR("Unexpected irq happened.");
 
-#ifdef CONFIG_DMAMUX_STM32
-		stream->dma_callback(dev, stream->user_data,
-				     stream->mux_channel, -EIO);
-#else
-		stream->dma_callback(dev, stream->user_data,
-				     id + STREAM_OFFSET, -EIO);
-#endif /* CONFIG_DMAMUX_STM32 */
+		if (!IS_ENABLED(CONFIG_DMAMUX_STM32)) {
+			stream->busy = false;
+		}
+		dma_stm32_notify(dev, stream, id, -EIO);
 	} else {
 		LOG_ERR("Transfer Error.");
 		dma_stm32_dump_stream_irq(dev, id);
 		dma_stm32_clear_stream_irq(dev, id);
 
-#ifdef CONFIG_DMAMUX_STM32
-		stream->dma_callback(dev, stream->user_data,
-				     stream->mux_channel, -EIO);
-#else
-		stream->dma_callback(dev, stream->user_data,
-				     id + STREAM_OFFSET, -EIO);
-#endif /* CONFIG_DMAMUX_STM32 */
+		if (!IS_ENABLED(CONFIG_DMAMUX_STM32)) {
+			stream->busy = false;
+		}
+		dma_stm32_notify(dev, stream, id, -EIO);
 	}
 }
 
@@ -232,6 +308,32 @@ static int dma_stm32_get_periph_increment(enum dma_addr_adj increment,
 	return 0;
 }
 
+#if defined(CONFIG_DMA_STM32_V1)
+/*
+ * A cyclic transfer of two blocks which only differ by their memory address
+ * runs in the double buffer mode, without software chaining.
+ */
+static bool dma_stm32_is_double_buffer(struct dma_config *config,
+				       uint32_t block_count)
+{
+	struct dma_block_config *first = config->head_block;
+	struct dma_block_config *second = first->next_block;
+
+	if (!(config->cyclic || first->source_reload_en) ||
+	    (block_count != 2U) ||
+	    (config->channel_direction == MEMORY_TO_MEMORY) ||
+	    (first->block_size != second->block_size)) {
+		return false;
+	}
+
+	if (config->channel_direction == MEMORY_TO_PERIPHERAL) {
+		return first->dest_address == second->dest_address;
+	}
+
+	return first->source_address == second->source_address;
+}
+#endif /* CONFIG_DMA_STM32_V1 */
+
 #ifdef CONFIG_DMAMUX_STM32
 int dma_stm32_configure(struct device *dev, uint32_t id,
 			       struct dma_config *config)
@@ -246,6 +348,9 @@ static int dma_stm32_configure(struct device *dev, uint32_t id,
 					dev->config;
 	DMA_TypeDef *dma = (DMA_TypeDef *)dev_config->base;
 	LL_DMA_InitTypeDef DMA_InitStruct;
+	struct dma_block_config *block;
+	bool double_buffer = false;
+	uint32_t block_count;
 	uint32_t msize;
 	int ret;
 
@@ -265,10 +370,18 @@ static int dma_stm32_configure(struct device *dev, uint32_t id,
 	stm32_dma_disable_stream(dma, id);
 	dma_stm32_clear_stream_irq(dev, id);
 
-	if (config->head_block->block_size > DMA_STM32_MAX_DATA_ITEMS) {
-		LOG_ERR("Data size too big: %d\n",
-		       config->head_block->block_size);
-		return -EINVAL;
+	/* Some clients give a block_count above their number of blocks */
+	block = config->head_block;
+	for (block_count = 0U;
+	     (block != NULL) && (block_count < MAX(config->block_count, 1U));
+	     block_count++) {
+		if (block->block_size > DMA_STM32_MAX_DATA_ITEMS) {
+			LOG_ERR("Data size too big: %d\n",
+			       block->block_size);
+			return -EINVAL;
+		}
+
+		block = block->next_block;
 	}
 
 #ifdef CONFIG_DMA_STM32_V1
@@ -307,12 +420,23 @@ static int dma_stm32_configure(struct device *dev, uint32_t id,
 		return -EINVAL;
 	}
 
+#if defined(CONFIG_DMA_STM32_V1)
+	double_buffer = dma_stm32_is_double_buffer(config, block_count);
+#endif
+
 	stream->busy		= true;
 	stream->dma_callback	= config->dma_callback;
 	stream->direction	= config->channel_direction;
 	stream->user_data       = config->user_data;
 	stream->src_size	= config->source_data_size;
 	stream->dst_size	= config->dest_data_size;
+	stream->cyclic		= config->cyclic ||
+				  config->head_block->source_reload_en;
+	stream->block_callback	= config->complete_callback_en;
+	stream->head_block	= config->head_block;
+	stream->block		= config->head_block;
+	stream->block_count	= double_buffer ? 1U : block_count;
+	stream->block_index	= 0U;
 
 	/* check dest or source memory address, warn if 0 */
 	if ((config->head_block->source_address == 0)) {
@@ -377,7 +501,11 @@ static int dma_stm32_configure(struct device *dev, uint32_t id,
 		return ret;
 	}
 
-	if (config->head_block->source_reload_en) {
+	/*
+	 * Chained blocks are loaded by the irq handler, the circular mode
+	 * only repeats a single block.
+	 */
+	if (stream->cyclic && (stream->block_count <= 1U)) {
 		DMA_InitStruct.Mode = LL_DMA_MODE_CIRCULAR;
 	} else {
 		DMA_InitStruct.Mode = LL_DMA_MODE_NORMAL;
@@ -437,7 +565,26 @@ static int dma_stm32_configure(struct device *dev, uint32_t id,
 	LL_DMA_Init(dma, table_ll_stream[id], &DMA_InitStruct);
 
 	LL_DMA_EnableIT_TC(dma, table_ll_stream[id]);
-	/* Half-Transfer irq is not handled */
+
+	/* Half of a single cyclic block lets the client refill the other */
+	if (stream->cyclic && stream->block_callback &&
+	    (stream->block_count <= 1U) && !double_buffer) {
+		LL_DMA_EnableIT_HT(dma, table_ll_stream[id]);
+	} else {
+		LL_DMA_DisableIT_HT(dma, table_ll_stream[id]);
+	}
+
+#if defined(CONFIG_DMA_STM32_V1)
+	if (double_buffer) {
+		block = config->head_block->next_block;
+		LL_DMA_SetMemory1Address(dma, table_ll_stream[id],
+			stream->source_periph ? block->source_address :
+						block->dest_address);
+		LL_DMA_EnableDoubleBufferMode(dma, table_ll_stream[id]);
+	} else {
+		LL_DMA_DisableDoubleBufferMode(dma, table_ll_stream[id]);
+	}
+#endif
 
 #if defined(CONFIG_DMA_STM32_V1)
 	if (DMA_InitStruct.FIFOMode == LL_DMA_FIFOMODE_ENABLE) {
@@ -489,30 +636,10 @@ static int dma_stm32_reload(struct device *dev, uint32_t id,
 		return -EINVAL;
 	}
 
-	stm32_dma_disable_stream(dma, id);
-
-	switch (stream->direction) {
-	case MEMORY_TO_PERIPHERAL:
-		LL_DMA_SetMemoryAddress(dma, table_ll_stream[id], src);
-		LL_DMA_SetPeriphAddress(dma, table_ll_stream[id], dst);
-		break;
-	case MEMORY_TO_MEMORY:
-	case PERIPHERAL_TO_MEMORY:
-		LL_DMA_SetPeriphAddress(dma, table_ll_stream[id], src);
-		LL_DMA_SetMemoryAddress(dma, table_ll_stream[id], dst);
-		break;
-	default:
+	if (dma_stm32_load_block(dma, id, stream, src, dst, size)) {
 		return -EINVAL;
 	}
 
-	if (stream->source_periph) {
-		LL_DMA_SetDataLength(dma, table_ll_stream[id],
-				     size / stream->src_size);
-	} else {
-		LL_DMA_SetDataLength(dma, table_ll_stream[id],
-				     size / stream->dst_size);
-	}
-
 	stm32_dma_enable_stream(dma, id);
 
 	return 0;
@@ -565,6 +692,7 @@ static int dma_stm32_stop(struct device *dev, uint32_t id)
 #ifndef CONFIG_DMAMUX_STM32
 	LL_DMA_DisableIT_TC(dma, table_ll_stream[id]);
 #endif /* CONFIG_DMAMUX_STM32 */
+	LL_DMA_DisableIT_HT(dma, table_ll_stream[id]);
 
 #if defined(CONFIG_DMA_STM32_V1)
 	stm32_dma_disable_fifo_irq(dma, id);
@@ -17,8 +17,17 @@ struct dma_stm32_stream {
 #endif /* CONFIG_DMAMUX_STM32 */
 	bool source_periph;
 	bool busy;
+	/* restart from head_block after the last block */
+	bool cyclic;
+	/* report DMA_STATUS_BLOCK at the end of each block */
+	bool block_callback;
 	uint32_t src_size;
 	uint32_t dst_size;
+	/* blocks above one are chained by the irq handler */
+	uint32_t block_count;
+	uint32_t block_index;
+	struct dma_block_config *head_block;
+	struct dma_block_config *block; /* block being transferred */
 	void *user_data; /* holds the client data */
 	dma_callback_t dma_callback;
 };
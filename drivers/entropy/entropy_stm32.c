@@ -14,6 +14,7 @@
 #include <sys/__assert.h>
 #include <sys/util.h>
 #include <errno.h>
+#include <string.h>
 #include <soc.h>
 #include <sys/printk.h>
 #include <drivers/clock_control.h>
@@ -23,9 +24,20 @@ struct entropy_stm32_rng_dev_cfg {
 	struct stm32_pclken pclken;
 };
 
+#define POOL_WORDS CONFIG_ENTROPY_STM32_POOL_SIZE
+
 struct entropy_stm32_rng_dev_data {
 	RNG_TypeDef *rng;
 	struct device *clock;
+	/*
+	 * Random words read ahead by the refill work, taken by the callers
+	 * without waiting on the RNG.
+	 */
+	uint32_t pool[POOL_WORDS];
+	uint8_t head;
+	uint8_t len;
+	bool refill_ready;
+	struct k_work refill_work;
 };
 
 #define DEV_DATA(dev) \
@@ -63,7 +75,31 @@ static int entropy_stm32_got_error(RNG_TypeDef *rng)
 	return 0;
 }
 
-static int entropy_stm32_wait_ready(RNG_TypeDef *rng)
+/*
+ * Read a random word if one is ready. The check and the read are atomic
+ * so that concurrent readers never get the same word.
+ */
+static int entropy_stm32_read_word(RNG_TypeDef *rng, uint32_t *word)
+{
+	unsigned int key;
+	int ret = -EAGAIN;
+
+	key = irq_lock();
+
+	if (entropy_stm32_got_error(rng)) {
+		ret = -EIO;
+	} else if (LL_RNG_IsActiveFlag_DRDY(rng)) {
+		*word = LL_RNG_ReadRandData32(rng);
+		ret = 0;
+	}
+
+	irq_unlock(key);
+
+	return ret;
+}
+
+static int entropy_stm32_wait_word(RNG_TypeDef *rng, uint32_t *word,
+				   bool yield)
 {
 	/* Agording to the reference manual it takes 40 periods
 	 * of the RNG_CLK clock signal between two consecutive
@@ -77,59 +113,101 @@ static int entropy_stm32_wait_ready(RNG_TypeDef *rng)
 	 */
 
 	int timeout = 1000000;
+	int res;
 
 	__ASSERT_NO_MSG(rng != NULL);
 
-	while (!LL_RNG_IsActiveFlag_DRDY(rng)) {
-		if (entropy_stm32_got_error(rng)) {
-			return -EIO;
-		}
-
+	while ((res = entropy_stm32_read_word(rng, word)) == -EAGAIN) {
 		if (timeout-- == 0) {
 			return -ETIMEDOUT;
 		}
 
-		k_yield();
+		if (yield) {
+			k_yield();
+		}
 	}
 
-	if (entropy_stm32_got_error(rng)) {
-		return -EIO;
-	} else {
-		return 0;
+	return res;
+}
+
+/* Take whole words from the pool, return the number of bytes copied */
+static uint16_t entropy_stm32_pool_get(struct entropy_stm32_rng_dev_data *data,
+				       uint8_t *buf, uint16_t len)
+{
+	uint16_t copied = 0U;
+	unsigned int key;
+	uint32_t word;
+
+	while (copied < len) {
+		key = irq_lock();
+		if (data->len == 0U) {
+			irq_unlock(key);
+			break;
+		}
+
+		word = data->pool[data->head];
+		data->head = (data->head + 1U) % POOL_WORDS;
+		data->len--;
+		irq_unlock(key);
+
+		memcpy(buf + copied, &word, MIN(sizeof(word), len - copied));
+		copied += MIN(sizeof(word), len - copied);
 	}
+
+	return copied;
 }
 
-static int entropy_stm32_rng_get_entropy(struct device *dev, uint8_t *buffer,
-					 uint16_t length)
+static void entropy_stm32_refill(struct k_work *work)
 {
-	struct entropy_stm32_rng_dev_data *dev_data;
-	int n = sizeof(uint32_t);
-	int res;
+	struct entropy_stm32_rng_dev_data *data =
+		CONTAINER_OF(work, struct entropy_stm32_rng_dev_data,
+			     refill_work);
+	unsigned int key;
+	uint32_t word;
+
+	while (data->len < POOL_WORDS) {
+		if (entropy_stm32_got_error(data->rng)) {
+			entropy_stm32_rng_reset(data->rng);
+		}
 
-	__ASSERT_NO_MSG(dev != NULL);
-	__ASSERT_NO_MSG(buffer != NULL);
+		if (entropy_stm32_wait_word(data->rng, &word, true) < 0) {
+			return;
+		}
 
-	dev_data = DEV_DATA(dev);
+		key = irq_lock();
+		if (data->len < POOL_WORDS) {
+			data->pool[(data->head + data->len) % POOL_WORDS] =
+				word;
+			data->len++;
+		}
+		irq_unlock(key);
+	}
+}
 
-	__ASSERT_NO_MSG(dev_data != NULL);
+static int entropy_stm32_rng_fill(struct entropy_stm32_rng_dev_data *data,
+				  uint8_t *buffer, uint16_t length,
+				  bool yield)
+{
+	int n = sizeof(uint32_t);
+	int res;
 
 	/* if the RNG has errors reset it before use */
-	if (entropy_stm32_got_error(dev_data->rng)) {
-		entropy_stm32_rng_reset(dev_data->rng);
+	if (entropy_stm32_got_error(data->rng)) {
+		entropy_stm32_rng_reset(data->rng);
 	}
 
 	while (length > 0) {
 		uint32_t rndbits;
 		uint8_t *p_rndbits = (uint8_t *)&rndbits;
 
-		res = entropy_stm32_wait_ready(dev_data->rng);
-		if (res < 0)
+		res = entropy_stm32_wait_word(data->rng, &rndbits, yield);
+		if (res < 0) {
 			return res;
+		}
 
-		rndbits = LL_RNG_ReadRandData32(dev_data->rng);
-
-		if (length < sizeof(uint32_t))
+		if (length < sizeof(uint32_t)) {
 			n = length;
+		}
 
 		for (int i = 0; i < n; i++) {
 			*buffer++ = *p_rndbits++;
@@ -141,6 +219,54 @@ static int entropy_stm32_rng_get_entropy(struct device *dev, uint8_t *buffer,
 	return 0;
 }
 
+static int entropy_stm32_rng_get_entropy(struct device *dev, uint8_t *buffer,
+					 uint16_t length)
+{
+	struct entropy_stm32_rng_dev_data *dev_data;
+	uint16_t n;
+	int res;
+
+	__ASSERT_NO_MSG(dev != NULL);
+	__ASSERT_NO_MSG(buffer != NULL);
+
+	dev_data = DEV_DATA(dev);
+
+	__ASSERT_NO_MSG(dev_data != NULL);
+
+	n = entropy_stm32_pool_get(dev_data, buffer, length);
+
+	/* Wait on the RNG only for what the pool could not provide */
+	res = entropy_stm32_rng_fill(dev_data, buffer + n, length - n, true);
+
+	if (dev_data->refill_ready) {
+		k_work_submit(&dev_data->refill_work);
+	}
+
+	return res;
+}
+
+static int entropy_stm32_rng_get_entropy_isr(struct device *dev,
+					     uint8_t *buffer,
+					     uint16_t length,
+					     uint32_t flags)
+{
+	struct entropy_stm32_rng_dev_data *dev_data = DEV_DATA(dev);
+	uint16_t n;
+
+	n = entropy_stm32_pool_get(dev_data, buffer, length);
+
+	if ((flags & ENTROPY_BUSYWAIT) == 0U || n == length) {
+		return n;
+	}
+
+	if (entropy_stm32_rng_fill(dev_data, buffer + n, length - n,
+				   false) < 0) {
+		return -EIO;
+	}
+
+	return length;
+}
+
 static int entropy_stm32_rng_init(struct device *dev)
 {
 	struct entropy_stm32_rng_dev_data *dev_data;
@@ -205,11 +331,14 @@ static int entropy_stm32_rng_init(struct device *dev)
 
 	LL_RNG_Enable(dev_data->rng);
 
+	k_work_init(&dev_data->refill_work, entropy_stm32_refill);
+
 	return 0;
 }
 
 static const struct entropy_driver_api entropy_stm32_rng_api = {
-	.get_entropy = entropy_stm32_rng_get_entropy
+	.get_entropy = entropy_stm32_rng_get_entropy,
+	.get_entropy_isr = entropy_stm32_rng_get_entropy_isr
 };
 
 static const struct entropy_stm32_rng_dev_cfg entropy_stm32_rng_config = {
@@ -226,3 +355,17 @@ DEVICE_AND_API_INIT(entropy_stm32_rng, DT_INST_LABEL(0),
 		    &entropy_stm32_rng_data, &entropy_stm32_rng_config,
 		    PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_DEVICE,
 		    &entropy_stm32_rng_api);
+
+/* Fill the pool in the background once the system work queue runs */
+static int entropy_stm32_pool_start(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	entropy_stm32_rng_data.refill_ready = true;
+	k_work_submit(&entropy_stm32_rng_data.refill_work);
+
+	return 0;
+}
+
+SYS_INIT(entropy_stm32_pool_start, APPLICATION,
+	 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -18,6 +18,13 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #include <drivers/pcie/pcie.h>
 #include "eth_e1000_priv.h"
 
+/* RDLEN and TDLEN have to be a multiple of 128 bytes */
+#if (E1000_RX_DESC_COUNT % 8) || (E1000_TX_DESC_COUNT % 8)
+#error The number of RX and TX descriptors has to be a multiple of 8
+#endif
+
+#define E1000_TX_TIMEOUT_MS	100
+
 #if defined(CONFIG_ETH_E1000_VERBOSE_DEBUG)
 #define hexdump(_buf, _len, fmt, args...)				\
 ({									\
@@ -38,8 +45,10 @@ static const char *e1000_reg_to_string(enum e1000_reg_t r)
 	switch (r) {
 	_(CTRL);
 	_(ICR);
+	_(ITR);
 	_(ICS);
 	_(IMS);
+	_(IMC);
 	_(RCTL);
 	_(TCTL);
 	_(RDBAL);
@@ -89,55 +98,112 @@ static enum ethernet_hw_caps e1000_caps(struct device *dev)
 		ETHERNET_LINK_1000BASE_T;
 }
 
-static int e1000_tx(struct e1000_dev *dev, void *buf, size_t len)
+/* Release the TX descriptors, and the packets, the controller is done with */
+static void e1000_tx_reclaim(struct e1000_dev *dev)
 {
-	hexdump(buf, len, "%zu byte(s)", len);
+	volatile struct e1000_tx *desc;
 
-	dev->tx.addr = POINTER_TO_INT(buf);
-	dev->tx.len = len;
-	dev->tx.cmd = TDESC_EOP | TDESC_RS;
+	while (dev->tx_free < E1000_TX_DESC_COUNT - 1) {
+		desc = &dev->tx[dev->tx_tail];
+		if (!(desc->sta & TDESC_STA_DD)) {
+			break;
+		}
 
-	iow32(dev, TDT, 1);
+		if (dev->tx_pkt[dev->tx_tail]) {
+			net_pkt_unref(dev->tx_pkt[dev->tx_tail]);
+			dev->tx_pkt[dev->tx_tail] = NULL;
+		}
 
-	while (!(dev->tx.sta)) {
-		k_yield();
+		desc->sta = 0;
+		dev->tx_tail = (dev->tx_tail + 1) % E1000_TX_DESC_COUNT;
+		dev->tx_free++;
 	}
-
-	LOG_DBG("tx.sta: 0x%02hx", dev->tx.sta);
-
-	return (dev->tx.sta & TDESC_STA_DD) ? 0 : -EIO;
 }
 
 static int e1000_send(struct device *device, struct net_pkt *pkt)
 {
 	struct e1000_dev *dev = device->data;
-	size_t len = net_pkt_get_len(pkt);
+	volatile struct e1000_tx *desc = NULL;
+	struct net_buf *frag;
+	uint16_t count = 0;
+	int ret = 0;
+
+	for (frag = pkt->frags; frag; frag = frag->frags) {
+		if (frag->len) {
+			count++;
+		}
+	}
 
-	if (net_pkt_read(pkt, dev->txb, len)) {
+	/* One descriptor of the ring always stays unused */
+	if (count == 0 || count >= E1000_TX_DESC_COUNT) {
+		LOG_ERR("Cannot send %u fragment(s)", count);
 		return -EIO;
 	}
 
-	return e1000_tx(dev, dev->txb, len);
+	k_mutex_lock(&dev->tx_mutex, K_FOREVER);
+
+	e1000_tx_reclaim(dev);
+
+	while (dev->tx_free < count) {
+		ret = k_sem_take(&dev->tx_sem, K_MSEC(E1000_TX_TIMEOUT_MS));
+		e1000_tx_reclaim(dev);
+		if (ret < 0 && dev->tx_free < count) {
+			LOG_ERR("TX ring stalled");
+			ret = -EIO;
+			goto out;
+		}
+	}
+
+	/* The fragments are sent in place, one descriptor each */
+	for (frag = pkt->frags; frag; frag = frag->frags) {
+		if (!frag->len) {
+			continue;
+		}
+
+		hexdump(frag->data, frag->len, "%hu byte(s)", frag->len);
+
+		desc = &dev->tx[dev->tx_head];
+		desc->addr = POINTER_TO_INT(frag->data);
+		desc->len = frag->len;
+		desc->sta = 0;
+		desc->cmd = TDESC_IFCS | TDESC_RS;
+
+		dev->tx_head = (dev->tx_head + 1) % E1000_TX_DESC_COUNT;
+		dev->tx_free--;
+	}
+
+	desc->cmd |= TDESC_EOP;
+
+	/* Hold the packet until its last descriptor is written back */
+	dev->tx_pkt[(dev->tx_head + E1000_TX_DESC_COUNT - 1) %
+		    E1000_TX_DESC_COUNT] = net_pkt_ref(pkt);
+
+	iow32(dev, TDT, dev->tx_head);
+
+	ret = 0;
+out:
+	k_mutex_unlock(&dev->tx_mutex);
+
+	return ret;
 }
 
-static struct net_pkt *e1000_rx(struct e1000_dev *dev)
+static struct net_pkt *e1000_rx(struct e1000_dev *dev,
+				volatile struct e1000_rx *desc, void *buf)
 {
 	struct net_pkt *pkt = NULL;
-	void *buf;
 	ssize_t len;
 
-	LOG_DBG("rx.sta: 0x%02hx", dev->rx.sta);
+	LOG_DBG("rx.sta: 0x%02hx", desc->sta);
 
-	if (!(dev->rx.sta & RDESC_STA_DD)) {
-		LOG_ERR("RX descriptor not ready");
+	if (desc->err) {
+		LOG_ERR("RX descriptor error: 0x%02hx", desc->err);
 		goto out;
 	}
 
-	buf = INT_TO_POINTER((uint32_t)dev->rx.addr);
-	len = dev->rx.len - 4;
+	len = desc->len - 4;
 
 	if (len <= 0) {
-		LOG_ERR("Invalid RX descriptor length: %hu", dev->rx.len);
+		LOG_ERR("Invalid RX descriptor length: %hu", desc->len);
 		goto out;
 	}
 
@@ -160,18 +226,25 @@ out:
 	return pkt;
 }
 
-static void e1000_isr(struct device *device)
+/* Handle all the frames received since the last interrupt */
+static void e1000_rx_ring(struct e1000_dev *dev)
 {
-	struct e1000_dev *dev = device->data;
-	uint32_t icr = ior32(dev, ICR); /* Cleared upon read */
-	uint16_t vlan_tag = NET_VLAN_TAG_UNSPEC;
-
-	icr &= ~(ICR_TXDW | ICR_TXQE);
-
-	if (icr & ICR_RXO) {
-		struct net_pkt *pkt = e1000_rx(dev);
-
-		icr &= ~ICR_RXO;
+	volatile struct e1000_rx *desc;
+	struct net_pkt *pkt;
+	uint16_t vlan_tag;
+	int last = -1;
+
+	while (dev->rx[dev->rx_next].sta & RDESC_STA_DD) {
+		desc = &dev->rx[dev->rx_next];
+		vlan_tag = NET_VLAN_TAG_UNSPEC;
+
+		if (!(desc->sta & RDESC_STA_EOP)) {
+			/* Frames never span several 2048 byte buffers */
+			LOG_ERR("Dropping partial frame");
+			pkt = NULL;
+		} else {
+			pkt = e1000_rx(dev, desc, dev->rxb[dev->rx_next]);
+		}
 
 		if (pkt) {
 #if defined(CONFIG_NET_VLAN)
@@ -196,10 +269,43 @@ static void e1000_isr(struct device *device)
 			}
 #endif /* CONFIG_NET_VLAN */
 
-			net_recv_data(get_iface(dev, vlan_tag), pkt);
+			if (net_recv_data(get_iface(dev, vlan_tag), pkt) < 0) {
+				net_pkt_unref(pkt);
+			}
 		} else {
 			eth_stats_update_errors_rx(get_iface(dev, vlan_tag));
 		}
+
+		desc->sta = 0;
+		last = dev->rx_next;
+		dev->rx_next = (dev->rx_next + 1) % E1000_RX_DESC_COUNT;
+	}
+
+	/* Give the processed descriptors back to the controller at once */
+	if (last >= 0) {
+		iow32(dev, RDT, last);
+	}
+}
+
+static void e1000_isr(struct device *device)
+{
+	struct e1000_dev *dev = device->data;
+	uint32_t icr = ior32(dev, ICR); /* Cleared upon read */
+
+	if (icr & (ICR_TXDW | ICR_TXQE)) {
+		k_sem_give(&dev->tx_sem);
+	}
+
+	icr &= ~(ICR_TXDW | ICR_TXQE | ICR_LSC | ICR_RXDMT0);
+
+	if (icr & (ICR_RXO | ICR_RXT0)) {
+		if (icr & ICR_RXO) {
+			LOG_DBG("RX overrun");
+		}
+
+		e1000_rx_ring(dev);
+
+		icr &= ~(ICR_RXO | ICR_RXT0);
 	}
 
 	if (icr) {
@@ -225,6 +331,8 @@ int e1000_probe(struct device *device)
 		return -ENODEV;
 	}
 
+	dev->bdf = bdf;
+
 	phys_addr = pcie_get_mbar(bdf, 0);
 	pcie_set_cmd(bdf, PCIE_CONF_CMDSTAT_MEM |
 		     PCIE_CONF_CMDSTAT_MASTER, true);
@@ -233,30 +341,43 @@ int e1000_probe(struct device *device)
 	device_map(&dev->address, phys_addr, size,
 		   K_MEM_CACHE_NONE);
 
-	/* Setup TX descriptor */
+	k_mutex_init(&dev->tx_mutex);
+	k_sem_init(&dev->tx_sem, 0, 1);
+
+	/* Setup TX descriptor ring */
+
+	dev->tx_head = 0;
+	dev->tx_tail = 0;
+	dev->tx_free = E1000_TX_DESC_COUNT - 1;
 
 	iow32(dev, TDBAL, (uint32_t) &dev->tx);
 	iow32(dev, TDBAH, 0);
-	iow32(dev, TDLEN, 1*16);
+	iow32(dev, TDLEN, sizeof(dev->tx));
 
 	iow32(dev, TDH, 0);
 	iow32(dev, TDT, 0);
 
 	iow32(dev, TCTL, TCTL_EN);
 
-	/* Setup RX descriptor */
+	/* Setup RX descriptor ring */
+
+	for (int i = 0; i < E1000_RX_DESC_COUNT; i++) {
+		dev->rx[i].addr = POINTER_TO_INT(dev->rxb[i]);
+		dev->rx[i].sta = 0;
+	}
 
-	dev->rx.addr = POINTER_TO_INT(dev->rxb);
-	dev->rx.len = sizeof(dev->rxb);
+	dev->rx_next = 0;
 
 	iow32(dev, RDBAL, (uint32_t) &dev->rx);
 	iow32(dev, RDBAH, 0);
-	iow32(dev, RDLEN, 1*16);
+	iow32(dev, RDLEN, sizeof(dev->rx));
 
+	/* The controller owns the descriptors from RDH up to RDT - 1 */
 	iow32(dev, RDH, 0);
-	iow32(dev, RDT, 1);
+	iow32(dev, RDT, E1000_RX_DESC_COUNT - 1);
 
-	iow32(dev, IMS, IMS_RXO);
+	iow32(dev, ITR, E1000_ITR_INTERVAL);
+	iow32(dev, IMS, IMS_RXO | IMS_RXT0 | IMS_TXDW);
 
 	ral = ior32(dev, RAL);
 	rah = ior32(dev, RAH);
@@ -284,7 +405,10 @@ static void e1000_iface_init(struct net_if *iface)
 			e1000_isr, DEVICE_GET(eth_e1000),
 			DT_INST_IRQ(0, sense));
 
-		irq_enable(DT_INST_IRQN(0));
+		/* Uses MSI when CONFIG_PCIE_MSI is enabled and the
+		 * controller supports it.
+		 */
+		pcie_irq_enable(dev->bdf, DT_INST_IRQN(0));
 		iow32(dev, CTRL, CTRL_SLU); /* Set link up */
 		iow32(dev, RCTL, RCTL_EN | RCTL_MPE);
 	}
@@ -18,25 +18,41 @@ extern "C" {
 
 #define ICR_TXDW	     (1) /* Transmit Descriptor Written Back */
 #define ICR_TXQE	(1 << 1) /* Transmit Queue Empty */
+#define ICR_LSC		(1 << 2) /* Link Status Change */
+#define ICR_RXDMT0	(1 << 4) /* Rx Descriptor Minimum Threshold */
 #define ICR_RXO		(1 << 6) /* Receiver Overrun */
+#define ICR_RXT0	(1 << 7) /* Receiver Timer Interrupt */
 
+#define IMS_TXDW	     (1) /* Transmit Descriptor Written Back */
 #define IMS_RXO		(1 << 6) /* Receiver FIFO Overrun */
+#define IMS_RXT0	(1 << 7) /* Receiver Timer Interrupt */
 
 #define RCTL_MPE	(1 << 4) /* Multicast Promiscuous Enabled */
 
 #define TDESC_EOP	     (1) /* End Of Packet */
+#define TDESC_IFCS	(1 << 1) /* Insert FCS */
 #define TDESC_RS	(1 << 3) /* Report Status */
 
 #define RDESC_STA_DD	     (1) /* Descriptor Done */
+#define RDESC_STA_EOP	(1 << 1) /* End Of Packet */
 #define TDESC_STA_DD	     (1) /* Descriptor Done */
 
 #define ETH_ALEN 6	/* TODO: Add a global reusable definition in OS */
 
+#define E1000_RX_DESC_COUNT	CONFIG_ETH_E1000_RX_DESC_COUNT
+#define E1000_TX_DESC_COUNT	CONFIG_ETH_E1000_TX_DESC_COUNT
+#define E1000_RX_BUF_SIZE	2048 /* RCTL.BSIZE reset value */
+
+/* The ITR register counts in units of 256 ns */
+#define E1000_ITR_INTERVAL	(CONFIG_ETH_E1000_ITR_INTERVAL_US * 1000 / 256)
+
 enum e1000_reg_t {
 	CTRL	= 0x0000,	/* Device Control */
 	ICR	= 0x00C0,	/* Interrupt Cause Read */
+	ITR	= 0x00C4,	/* Interrupt Throttling Rate */
 	ICS	= 0x00C8,	/* Interrupt Cause Set */
 	IMS	= 0x00D0,	/* Interrupt Mask Set */
+	IMC	= 0x00D8,	/* Interrupt Mask Clear */
 	RCTL	= 0x0100,	/* Receive Control */
 	TCTL	= 0x0400,	/* Transmit Control */
 	RDBAL	= 0x2800,	/* Rx Descriptor Base Address Low */
@@ -75,17 +91,25 @@ struct e1000_rx {
 };
 
 struct e1000_dev {
-	volatile struct e1000_tx tx __aligned(16);
-	volatile struct e1000_rx rx __aligned(16);
+	volatile struct e1000_tx tx[E1000_TX_DESC_COUNT] __aligned(16);
+	volatile struct e1000_rx rx[E1000_RX_DESC_COUNT] __aligned(16);
 	mm_reg_t address;
+	pcie_bdf_t bdf;
 	/* If VLAN is enabled, there can be multiple VLAN interfaces related to
 	 * this physical device. In that case, this iface pointer value is not
 	 * really used for anything.
 	 */
 	struct net_if *iface;
 	uint8_t mac[ETH_ALEN];
-	uint8_t txb[NET_ETH_MTU];
-	uint8_t rxb[NET_ETH_MTU];
+	struct k_mutex tx_mutex;
+	struct k_sem tx_sem;
+	/* Packets sent in place, referenced by their last descriptor */
+	struct net_pkt *tx_pkt[E1000_TX_DESC_COUNT];
+	uint16_t tx_head;
+	uint16_t tx_tail;
+	uint16_t tx_free;
+	uint16_t rx_next;
+	uint8_t rxb[E1000_RX_DESC_COUNT][E1000_RX_BUF_SIZE];
 };
 
 static const char *e1000_reg_to_string(enum e1000_reg_t r)
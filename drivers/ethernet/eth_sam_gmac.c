@@ -32,6 +32,7 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #include <sys/util.h>
 #include <errno.h>
 #include <stdbool.h>
+#include <limits.h>
 #include <net/net_pkt.h>
 #include <net/net_if.h>
 #include <net/ethernet.h>
@@ -72,22 +73,45 @@ static inline void dcache_invalidate(uint32_t addr, uint32_t size)
 	SCB_InvalidateDCache_by_Addr((uint32_t *)start_addr, size_full);
 }
 
-static inline void dcache_clean(uint32_t addr, uint32_t size)
+/*
+ * Clean the data of all the fragments of a frame. Only the bytes the DMA
+ * will read are cleaned and the barriers are issued once per frame rather
+ * than once per fragment.
+ */
+static inline void dcache_clean_frags(struct net_buf *frag)
 {
+	uint32_t addr;
+	uint32_t end;
+
 	if (!dcache_enabled) {
 		return;
 	}
 
-	/* Make sure it is aligned to 32B */
-	uint32_t start_addr = addr & (uint32_t)~(GMAC_DCACHE_ALIGNMENT - 1);
-	uint32_t size_full = size + addr - start_addr;
+	__DSB();
+
+	for (; frag; frag = frag->frags) {
+		/* Make sure it is aligned to 32B */
+		addr = (uint32_t)frag->data &
+		       (uint32_t)~(GMAC_DCACHE_ALIGNMENT - 1);
+		end = (uint32_t)frag->data + frag->len;
+
+		for (; addr < end; addr += GMAC_DCACHE_ALIGNMENT) {
+			SCB->DCCMVAC = addr;
+		}
+	}
 
-	SCB_CleanDCache_by_Addr((uint32_t *)start_addr, size_full);
+	__DSB();
+	__ISB();
 }
 #else
 #define dcache_is_enabled()
 #define dcache_invalidate(addr, size)
-#define dcache_clean(addr, size)
+#define dcache_clean_frags(frag)
+#endif
+
+#if defined(CONFIG_ETH_SAM_GMAC_RX_POLL)
+K_KERNEL_STACK_DEFINE(rx_poll_stack, CONFIG_ETH_SAM_GMAC_RX_POLL_STACK_SIZE);
+static struct k_work_q rx_poll_workq;
 #endif
 
 #ifdef CONFIG_SOC_FAMILY_SAM0
@@ -1242,6 +1266,7 @@ static struct net_pkt *frame_get(struct gmac_queue *queue)
 	uint8_t *frag_data;
 	uint32_t frag_len;
 	uint32_t frame_len = 0U;
+	uint32_t status = 0U;
 	uint16_t tail;
 	uint8_t wrap;
 
@@ -1290,6 +1315,7 @@ static struct net_pkt *frame_get(struct gmac_queue *queue)
 			 "RX descriptor and buffer list desynchronized");
 		frame_is_complete = (bool)(rx_desc->w1 & GMAC_RXW1_EOF);
 		if (frame_is_complete) {
+			status = rx_desc->w1;
 			frag_len = (rx_desc->w1 & GMAC_RXW1_LEN) - frame_len;
 		} else {
 			frag_len = CONFIG_NET_BUF_DATA_SIZE;
@@ -1339,16 +1365,36 @@ static struct net_pkt *frame_get(struct gmac_queue *queue)
 	LOG_DBG("Frame complete: rx=%p, tail=%d", rx_frame, tail);
 	__ASSERT_NO_MSG(frame_is_complete);
 
+	/* Frames failing a checksum check are discarded by the GMAC, tell
+	 * the IP stack which checksums need no verification anymore.
+	 */
+	if (rx_frame) {
+		switch (status & GMAC_RXW1_CHKSUMSTATUS) {
+		case GMAC_RXW1_CHKSUM_IP:
+			net_pkt_set_chksum_state(rx_frame,
+						 NET_PKT_CHKSUM_IP_VERIFIED);
+			break;
+		case GMAC_RXW1_CHKSUM_IP_TCP:
+		case GMAC_RXW1_CHKSUM_IP_UDP:
+			net_pkt_set_chksum_state(rx_frame,
+						 NET_PKT_CHKSUM_VERIFIED);
+			break;
+		default:
+			break;
+		}
+	}
+
 	return rx_frame;
 }
 
-static void eth_rx(struct gmac_queue *queue)
+static int eth_rx(struct gmac_queue *queue, int budget)
 {
 	struct eth_sam_dev_data *dev_data =
 		CONTAINER_OF(queue, struct eth_sam_dev_data,
 			     queue_list[queue->que_idx]);
 	uint16_t vlan_tag = NET_VLAN_TAG_UNSPEC;
 	struct net_pkt *rx_frame;
+	int count = 0;
 #if defined(CONFIG_PTP_CLOCK_SAM_GMAC)
 	struct device *const dev = net_if_get_device(dev_data->iface);
 	const struct eth_sam_dev_cfg *const cfg = DEV_CFG(dev);
@@ -1357,10 +1403,16 @@ static void eth_rx(struct gmac_queue *queue)
 #endif
 
 	/* More than one frame could have been received by GMAC, get all
-	 * complete frames stored in the GMAC RX descriptor list.
+	 * complete frames stored in the GMAC RX descriptor list, up to
+	 * the given budget.
 	 */
-	rx_frame = frame_get(queue);
-	while (rx_frame) {
+	while (count < budget) {
+		rx_frame = frame_get(queue);
+		if (!rx_frame) {
+			break;
+		}
+
+		count++;
 		LOG_DBG("ETH rx");
 
 #if defined(CONFIG_NET_VLAN)
@@ -1408,10 +1460,81 @@ static void eth_rx(struct gmac_queue *queue)
 							     vlan_tag));
 			net_pkt_unref(rx_frame);
 		}
+	}
 
-		rx_frame = frame_get(queue);
+	return count;
+}
+
+#if defined(CONFIG_ETH_SAM_GMAC_RX_POLL)
+static void rx_irq_set(Gmac *gmac, struct gmac_queue *queue, bool enable)
+{
+	if (queue->que_idx == GMAC_QUE_0) {
+		if (enable) {
+			gmac->GMAC_IER = GMAC_INT_RX_BITS;
+		} else {
+			gmac->GMAC_IDR = GMAC_INT_RX_BITS;
+		}
+
+		return;
+	}
+
+#if GMAC_PRIORITY_QUEUE_NUM >= 1
+	if (enable) {
+		gmac->GMAC_IERPQ[queue->que_idx - 1] = GMAC_INTPQ_RX_BITS;
+	} else {
+		gmac->GMAC_IDRPQ[queue->que_idx - 1] = GMAC_INTPQ_RX_BITS;
+	}
+#endif
+}
+
+/*
+ * Called from the ISR: mask further RX interrupts of the queue and let the
+ * work queue pick up all the frames received in the meantime.
+ */
+static void rx_poll_schedule(Gmac *gmac, struct gmac_queue *queue,
+			     bool error)
+{
+	if (error) {
+		atomic_set(&queue->rx_error, 1);
+	}
+
+	rx_irq_set(gmac, queue, false);
+	k_work_submit_to_queue(&rx_poll_workq, &queue->rx_work);
+}
+
+static void rx_poll_work_handler(struct k_work *work)
+{
+	struct gmac_queue *queue =
+		CONTAINER_OF(work, struct gmac_queue, rx_work);
+	struct eth_sam_dev_data *dev_data =
+		CONTAINER_OF(queue, struct eth_sam_dev_data,
+			     queue_list[queue->que_idx]);
+	struct device *const dev = net_if_get_device(dev_data->iface);
+	Gmac *gmac = DEV_CFG(dev)->regs;
+	struct gmac_desc_list *rx_desc_list = &queue->rx_desc_list;
+
+	if (atomic_clear(&queue->rx_error)) {
+		rx_error_handler(gmac, queue);
+	}
+
+	if (eth_rx(queue, CONFIG_ETH_SAM_GMAC_RX_POLL_BUDGET) >=
+	    CONFIG_ETH_SAM_GMAC_RX_POLL_BUDGET) {
+		/* Budget exhausted, let other work run and come back */
+		k_work_submit_to_queue(&rx_poll_workq, work);
+		return;
+	}
+
+	rx_irq_set(gmac, queue, true);
+
+	/* A frame completed before the interrupt got unmasked would not
+	 * raise a new one, check for it.
+	 */
+	if (rx_desc_list->buf[rx_desc_list->tail].w0 & GMAC_RXW0_OWNERSHIP) {
+		rx_irq_set(gmac, queue, false);
+		k_work_submit_to_queue(&rx_poll_workq, work);
 	}
 }
+#endif /* CONFIG_ETH_SAM_GMAC_RX_POLL */
 
 #if !defined(CONFIG_ETH_SAM_GMAC_FORCE_QUEUE) && \
 	((GMAC_ACTIVE_QUEUE_NUM != NET_TC_TX_COUNT) || \
@@ -1443,7 +1566,7 @@ static int priority2queue(enum net_priority priority)
 }
 #endif
 
-static int eth_tx(struct device *dev, struct net_pkt *pkt)
+static int eth_tx_frame(struct device *dev, struct net_pkt *pkt, bool start)
 {
 	const struct eth_sam_dev_cfg *const cfg = DEV_CFG(dev);
 	struct eth_sam_dev_data *const dev_data = DEV_DATA(dev);
@@ -1494,6 +1617,9 @@ static int eth_tx(struct device *dev, struct net_pkt *pkt)
 
 	frag = pkt->frags;
 
+	/* Assure cache coherency before DMA read operation */
+	dcache_clean_frags(frag);
+
 	/* Keep reference to the descriptor */
 	tx_first_desc = &tx_desc_list->buf[tx_desc_list->head];
 
@@ -1501,11 +1627,17 @@ static int eth_tx(struct device *dev, struct net_pkt *pkt)
 		frag_data = frag->data;
 		frag_len = frag->len;
 
-		/* Assure cache coherency before DMA read operation */
-		dcache_clean((uint32_t)frag_data, frag->size);
-
 #if GMAC_MULTIPLE_TX_PACKETS == 1
-		k_sem_take(&queue->tx_desc_sem, K_FOREVER);
+		if (k_sem_take(&queue->tx_desc_sem, K_NO_WAIT) != 0) {
+			/* Frames of a batch might still wait for the start of
+			 * the transmission, start it so that their descriptors
+			 * get released.
+			 */
+			__DMB();  /* data memory barrier */
+			gmac->GMAC_NCR |= GMAC_NCR_TSTART;
+
+			k_sem_take(&queue->tx_desc_sem, K_FOREVER);
+		}
 
 		/* The following section becomes critical and requires IRQ lock
 		 * / unlock protection only due to the possibility of executing
@@ -1590,13 +1722,15 @@ static int eth_tx(struct device *dev, struct net_pkt *pkt)
 	irq_unlock(key);
 #endif
 
-	/* Guarantee that the first fragment got its bit removed before starting
-	 * sending packets to avoid packets getting stuck.
-	 */
-	__DMB();  /* data memory barrier */
+	if (start) {
+		/* Guarantee that the first fragment got its bit removed before
+		 * starting sending packets to avoid packets getting stuck.
+		 */
+		__DMB();  /* data memory barrier */
 
-	/* Start transmission */
-	gmac->GMAC_NCR |= GMAC_NCR_TSTART;
+		/* Start transmission */
+		gmac->GMAC_NCR |= GMAC_NCR_TSTART;
+	}
 
 #if GMAC_MULTIPLE_TX_PACKETS == 0
 	/* Wait until the packet is sent */
@@ -1624,6 +1758,36 @@ static int eth_tx(struct device *dev, struct net_pkt *pkt)
 	return 0;
 }
 
+static int eth_tx(struct device *dev, struct net_pkt *pkt)
+{
+	return eth_tx_frame(dev, pkt, true);
+}
+
+#if defined(CONFIG_NET_TX_BATCH) && GMAC_MULTIPLE_TX_PACKETS == 1
+static int eth_tx_batch(struct device *dev, struct net_pkt *pkts[],
+			size_t count)
+{
+	const struct eth_sam_dev_cfg *const cfg = DEV_CFG(dev);
+	Gmac *gmac = cfg->regs;
+	size_t i;
+
+	/* Queue all the frames and start the transmission only once */
+	for (i = 0; i < count; i++) {
+		if (eth_tx_frame(dev, pkts[i], false) < 0) {
+			break;
+		}
+	}
+
+	if (i > 0) {
+		__DMB();  /* data memory barrier */
+
+		gmac->GMAC_NCR |= GMAC_NCR_TSTART;
+	}
+
+	return i;
+}
+#endif
+
 static void queue0_isr(void *arg)
 {
 	struct device *const dev = (struct device *const)arg;
@@ -1646,13 +1810,21 @@ static void queue0_isr(void *arg)
 
 	/* RX packet */
 	if (isr & GMAC_INT_RX_ERR_BITS) {
+#if defined(CONFIG_ETH_SAM_GMAC_RX_POLL)
+		rx_poll_schedule(gmac, queue, true);
+#else
 		rx_error_handler(gmac, queue);
+#endif
 	} else if (isr & GMAC_ISR_RCOMP) {
 		tail_desc = &rx_desc_list->buf[rx_desc_list->tail];
 		LOG_DBG("rx.w1=0x%08x, tail=%d",
 			tail_desc->w1,
 			rx_desc_list->tail);
-		eth_rx(queue);
+#if defined(CONFIG_ETH_SAM_GMAC_RX_POLL)
+		rx_poll_schedule(gmac, queue, false);
+#else
+		eth_rx(queue, INT_MAX);
+#endif
 	}
 
 	/* TX packet */
@@ -1696,13 +1868,21 @@ static inline void priority_queue_isr(void *arg, unsigned int queue_idx)
 
 	/* RX packet */
 	if (isrpq & GMAC_INTPQ_RX_ERR_BITS) {
+#if defined(CONFIG_ETH_SAM_GMAC_RX_POLL)
+		rx_poll_schedule(gmac, queue, true);
+#else
 		rx_error_handler(gmac, queue);
+#endif
 	} else if (isrpq & GMAC_ISRPQ_RCOMP) {
 		tail_desc = &rx_desc_list->buf[rx_desc_list->tail];
 		LOG_DBG("rx.w1=0x%08x, tail=%d",
 			tail_desc->w1,
 			rx_desc_list->tail);
-		eth_rx(queue);
+#if defined(CONFIG_ETH_SAM_GMAC_RX_POLL)
+		rx_poll_schedule(gmac, queue, false);
+#else
+		eth_rx(queue, INT_MAX);
+#endif
 	}
 
 	/* TX packet */
@@ -1907,6 +2087,18 @@ static void eth0_iface_init(struct net_if *iface)
 			     sizeof(dev_data->mac_addr),
 			     NET_LINK_ETHERNET);
 
+#if defined(CONFIG_ETH_SAM_GMAC_RX_POLL)
+	k_work_q_start(&rx_poll_workq, rx_poll_stack,
+		       K_KERNEL_STACK_SIZEOF(rx_poll_stack),
+		       K_PRIO_COOP(CONFIG_ETH_SAM_GMAC_RX_POLL_PRIORITY));
+	k_thread_name_set(&rx_poll_workq.thread, "gmac_rx");
+
+	for (i = GMAC_QUE_0; i < GMAC_QUEUE_NUM; i++) {
+		k_work_init(&dev_data->queue_list[i].rx_work,
+			    rx_poll_work_handler);
+	}
+#endif
+
 	/* Initialize GMAC queues */
 	for (i = GMAC_QUE_0; i < GMAC_QUEUE_NUM; i++) {
 		result = queue_init(cfg->regs, &dev_data->queue_list[i]);
@@ -1986,6 +2178,10 @@ static enum ethernet_hw_caps eth_sam_gmac_get_capabilities(struct device *dev)
 		ETHERNET_PRIORITY_QUEUES |
 #if GMAC_ACTIVE_PRIORITY_QUEUE_NUM >= 1
 		ETHERNET_QAV |
+#endif
+#if GMAC_PRIORITY_QUEUE_NUM >= 1
+		/* See GMAC_DMA_QUEUE_FLAGS */
+		ETHERNET_HW_TX_CHKSUM_OFFLOAD |
 #endif
 		ETHERNET_LINK_100BASE_T;
 }
@@ -2033,6 +2229,81 @@ static int eth_sam_gmac_set_qav_param(struct device *dev,
 }
 #endif
 
+#if GMAC_ACTIVE_PRIORITY_QUEUE_NUM >= 1
+/*
+ * Program a screening register so that received frames matching the rule
+ * end up in the given priority queue. Type 1 registers match on DS/TC or
+ * UDP port, type 2 registers on VLAN priority.
+ */
+static int eth_sam_gmac_set_rx_steering(struct device *dev,
+					const struct ethernet_rx_steering *rule)
+{
+	const struct eth_sam_dev_cfg *const cfg = DEV_CFG(dev);
+	Gmac *gmac = cfg->regs;
+	uint32_t qnb;
+
+	if (rule->queue_id < 0 ||
+	    rule->queue_id > GMAC_ACTIVE_PRIORITY_QUEUE_NUM) {
+		return -EINVAL;
+	}
+
+	qnb = rule->queue_id;
+
+	switch (rule->type) {
+	case ETHERNET_RX_STEERING_TYPE_DS_TC:
+	case ETHERNET_RX_STEERING_TYPE_UDP_PORT:
+		if (rule->rule < 0 ||
+		    rule->rule >= ARRAY_SIZE(gmac->GMAC_ST1RPQ)) {
+			return -EINVAL;
+		}
+
+		if (!rule->set) {
+			gmac->GMAC_ST1RPQ[rule->rule] = 0U;
+		} else if (rule->type == ETHERNET_RX_STEERING_TYPE_DS_TC) {
+			if (rule->value > UINT8_MAX) {
+				return -EINVAL;
+			}
+
+			gmac->GMAC_ST1RPQ[rule->rule] =
+				GMAC_ST1RPQ_DSTCM(rule->value) |
+				GMAC_ST1RPQ_DSTCE | GMAC_ST1RPQ_QNB(qnb);
+		} else {
+			gmac->GMAC_ST1RPQ[rule->rule] =
+				GMAC_ST1RPQ_UDPM(rule->value) |
+				GMAC_ST1RPQ_UDPE | GMAC_ST1RPQ_QNB(qnb);
+		}
+
+		return 0;
+
+	case ETHERNET_RX_STEERING_TYPE_VLAN_PRIORITY:
+		if (rule->rule < 0 ||
+		    rule->rule >= ARRAY_SIZE(gmac->GMAC_ST2RPQ)) {
+			return -EINVAL;
+		}
+
+		if (!rule->set) {
+			gmac->GMAC_ST2RPQ[rule->rule] = 0U;
+			return 0;
+		}
+
+		if (rule->value > 7) {
+			return -EINVAL;
+		}
+
+		gmac->GMAC_ST2RPQ[rule->rule] =
+			GMAC_ST2RPQ_VLANP(rule->value) |
+			GMAC_ST2RPQ_VLANE | GMAC_ST2RPQ_QNB(qnb);
+
+		return 0;
+
+	default:
+		break;
+	}
+
+	return -ENOTSUP;
+}
+#endif
+
 static int eth_sam_gmac_set_config(struct device *dev,
 				   enum ethernet_config_type type,
 				   const struct ethernet_config *config)
@@ -2041,6 +2312,8 @@ static int eth_sam_gmac_set_config(struct device *dev,
 #if GMAC_ACTIVE_PRIORITY_QUEUE_NUM >= 1
 	case ETHERNET_CONFIG_TYPE_QAV_PARAM:
 		return eth_sam_gmac_set_qav_param(dev, type, config);
+	case ETHERNET_CONFIG_TYPE_RX_STEERING:
+		return eth_sam_gmac_set_rx_steering(dev, &config->rx_steering);
 #endif
 	default:
 		break;
@@ -2134,6 +2407,9 @@ static const struct ethernet_api eth_api = {
 	.set_config = eth_sam_gmac_set_config,
 	.get_config = eth_sam_gmac_get_config,
 	.send = eth_tx,
+#if defined(CONFIG_NET_TX_BATCH) && GMAC_MULTIPLE_TX_PACKETS == 1
+	.send_batch = eth_tx_batch,
+#endif
 
 #if defined(CONFIG_PTP_CLOCK_SAM_GMAC)
 	.get_ptp_clock = eth_sam_gmac_get_ptp_clock,
@@ -118,6 +118,14 @@ BUILD_ASSERT(ARRAY_SIZE(GMAC->GMAC_TBQBAPQ) + 1 == GMAC_QUEUE_NUM,
 #define GMAC_RXW1_TYPEIDMATCH         (0x3u << 22)
 /** Type ID register match found */
 #define GMAC_RXW1_TYPEIDFOUND         (0x1u << 24)
+/** Checksum status, replaces the type ID match with RX checksum offload */
+#define GMAC_RXW1_CHKSUMSTATUS        (0x3u << 22)
+/** IP header checksum checked */
+#define GMAC_RXW1_CHKSUM_IP           (0x1u << 22)
+/** IP header and TCP checksums checked */
+#define GMAC_RXW1_CHKSUM_IP_TCP       (0x2u << 22)
+/** IP header and UDP checksums checked */
+#define GMAC_RXW1_CHKSUM_IP_UDP       (0x3u << 22)
 /** Specific Address Register match */
 #define GMAC_RXW1_ADDRMATCH           (0x3u << 25)
 /** Specific Address Register match found */
@@ -160,6 +168,8 @@ BUILD_ASSERT(ARRAY_SIZE(GMAC->GMAC_TBQBAPQ) + 1 == GMAC_QUEUE_NUM,
 		(GMAC_IER_RXUBR | GMAC_IER_ROVR)
 #define GMAC_INT_TX_ERR_BITS \
 		(GMAC_IER_TUR | GMAC_IER_RLEX | GMAC_IER_TFC)
+#define GMAC_INT_RX_BITS \
+		(GMAC_IER_RCOMP | GMAC_INT_RX_ERR_BITS)
 #define GMAC_INT_EN_FLAGS \
 		(GMAC_IER_RCOMP | GMAC_INT_RX_ERR_BITS | \
 		 GMAC_IER_TCOMP | GMAC_INT_TX_ERR_BITS | GMAC_IER_HRESP)
@@ -168,6 +178,8 @@ BUILD_ASSERT(ARRAY_SIZE(GMAC->GMAC_TBQBAPQ) + 1 == GMAC_QUEUE_NUM,
 		(GMAC_IERPQ_RXUBR | GMAC_IERPQ_ROVR)
 #define GMAC_INTPQ_TX_ERR_BITS \
 		(GMAC_IERPQ_RLEX | GMAC_IERPQ_TFC)
+#define GMAC_INTPQ_RX_BITS \
+		(GMAC_IERPQ_RCOMP | GMAC_INTPQ_RX_ERR_BITS)
 #define GMAC_INTPQ_EN_FLAGS \
 		(GMAC_IERPQ_RCOMP | GMAC_INTPQ_RX_ERR_BITS | \
 		 GMAC_IERPQ_TCOMP | GMAC_INTPQ_TX_ERR_BITS | GMAC_IERPQ_HRESP)
@@ -255,6 +267,13 @@ struct gmac_queue {
 	/** Number of times transmit queue was flushed */
 	volatile uint32_t err_tx_flushed_count;
 
+#if defined(CONFIG_ETH_SAM_GMAC_RX_POLL)
+	/** Received frames are processed by this work item */
+	struct k_work rx_work;
+	/** RX error reported by the ISR, handled by the work item */
+	atomic_t rx_error;
+#endif
+
 	enum queue_idx que_idx;
 };
 
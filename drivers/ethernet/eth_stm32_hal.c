@@ -75,15 +75,95 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #define CACHE
 #endif
 
+#if defined(CONFIG_ETH_STM32_HAL_DMA_RING)
+static ETH_DMADescTypeDef dma_rx_desc_tab[ETH_RING_RX_DESC_NB]
+	CACHE ETH_DMA_MEM;
+static ETH_DMADescTypeDef dma_tx_desc_tab[ETH_RING_TX_DESC_NB]
+	CACHE ETH_DMA_MEM;
+#else
 static ETH_DMADescTypeDef dma_rx_desc_tab[ETH_RXBUFNB] CACHE ETH_DMA_MEM;
 static ETH_DMADescTypeDef dma_tx_desc_tab[ETH_TXBUFNB] CACHE ETH_DMA_MEM;
 static uint8_t dma_rx_buffer[ETH_RXBUFNB][ETH_RX_BUF_SIZE] CACHE ETH_DMA_MEM;
 static uint8_t dma_tx_buffer[ETH_TXBUFNB][ETH_TX_BUF_SIZE] CACHE ETH_DMA_MEM;
+#endif /* CONFIG_ETH_STM32_HAL_DMA_RING */
 
 #if defined(CONFIG_SOC_SERIES_STM32H7X)
 static ETH_TxPacketConfig tx_config CACHE;
 #endif
 
+#if defined(CONFIG_ETH_STM32_HAL_DMA_RING)
+
+/* No need to verify things for unit tests */
+#if !defined(CONFIG_NET_TEST)
+#if ETH_RING_RX_BUF_SIZE * ETH_RING_RX_DESC_NB < ETH_STM32_HAL_FRAME_SIZE_MAX
+#error CONFIG_NET_BUF_DATA_SIZE * CONFIG_ETH_STM32_HAL_DMA_RING_RX_DESC is \
+	not large enough to hold a full frame
+#endif
+
+#if ETH_RING_RX_BUF_SIZE > 0x1ffc
+#error CONFIG_NET_BUF_DATA_SIZE is larger than an RX descriptor buffer
+#endif
+
+#if CONFIG_NET_BUF_RX_COUNT <= ETH_RING_RX_DESC_NB
+#error Not enough RX buffers to allocate the RX descriptors
+#endif
+#endif /* !CONFIG_NET_TEST */
+
+#if CONFIG_ETH_STM32_HAL_RX_COALESCE_US > 0
+#define ETH_RX_DESC_DIC		ETH_DMARXDESC_DIC
+#else
+#define ETH_RX_DESC_DIC		0U
+#endif
+
+#if defined(CONFIG_ETH_STM32_HAL_HW_CHECKSUM)
+#define ETH_TX_DESC_CIC		ETH_DMATXDESC_CHECKSUMTCPUDPICMPFULL
+#else
+#define ETH_TX_DESC_CIC		0U
+#endif
+
+#define ETH_TX_RING_TIMEOUT_MS	20
+
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+#define ETH_DCACHE_ALIGNMENT	32U
+
+/* The DMA descriptors live in DTCM, only the network buffers are cached */
+static inline void dcache_clean(void *data, size_t size)
+{
+	uint32_t addr = (uint32_t)data & ~(ETH_DCACHE_ALIGNMENT - 1U);
+
+	if (SCB->CCR & SCB_CCR_DC_Msk) {
+		SCB_CleanDCache_by_Addr((uint32_t *)addr,
+					size + (uint32_t)data - addr);
+	}
+}
+
+static inline void dcache_flush(void *data, size_t size)
+{
+	uint32_t addr = (uint32_t)data & ~(ETH_DCACHE_ALIGNMENT - 1U);
+
+	if (SCB->CCR & SCB_CCR_DC_Msk) {
+		SCB_CleanInvalidateDCache_by_Addr((uint32_t *)addr,
+						  size + (uint32_t)data - addr);
+	}
+}
+
+static inline void dcache_invalidate(void *data, size_t size)
+{
+	uint32_t addr = (uint32_t)data & ~(ETH_DCACHE_ALIGNMENT - 1U);
+
+	if (SCB->CCR & SCB_CCR_DC_Msk) {
+		SCB_InvalidateDCache_by_Addr((uint32_t *)addr,
+					     size + (uint32_t)data - addr);
+	}
+}
+#else
+#define dcache_clean(data, size)
+#define dcache_flush(data, size)
+#define dcache_invalidate(data, size)
+#endif /* __DCACHE_PRESENT */
+
+#endif /* CONFIG_ETH_STM32_HAL_DMA_RING */
+
 #if defined(CONFIG_NET_L2_CANBUS_ETH_TRANSLATOR)
 #include <net/can.h>
 
@@ -163,6 +243,7 @@ static inline void disable_mcast_filter(ETH_HandleTypeDef *heth)
 #endif /* CONFIG_SOC_SERIES_STM32H7X) */
 }
 
+#if !defined(CONFIG_ETH_STM32_HAL_DMA_RING)
 static int eth_tx(struct device *dev, struct net_pkt *pkt)
 {
 	struct eth_stm32_hal_dev_data *dev_data = DEV_DATA(dev);
@@ -252,6 +333,204 @@ error:
 
 	return res;
 }
+#endif /* !CONFIG_ETH_STM32_HAL_DMA_RING */
+
+#if defined(CONFIG_ETH_STM32_HAL_DMA_RING)
+static int dma_ring_init(struct eth_stm32_hal_dev_data *dev_data)
+{
+	ETH_HandleTypeDef *heth = &dev_data->heth;
+	ETH_DMADescTypeDef *desc;
+	struct net_buf *buf;
+	int i;
+
+	for (i = 0; i < ETH_RING_TX_DESC_NB; i++) {
+		desc = &dma_tx_desc_tab[i];
+		desc->Status = ETH_DMATXDESC_TCH;
+		desc->ControlBufferSize = 0U;
+		desc->Buffer1Addr = 0U;
+		desc->Buffer2NextDescAddr = (uint32_t)
+			&dma_tx_desc_tab[(i + 1) % ETH_RING_TX_DESC_NB];
+		dev_data->tx_pkts[i] = NULL;
+	}
+
+	dev_data->tx_head = 0U;
+	dev_data->tx_tail = 0U;
+	dev_data->tx_free = ETH_RING_TX_DESC_NB;
+	dev_data->tx_since_ic = 0U;
+
+	for (i = 0; i < ETH_RING_RX_DESC_NB; i++) {
+		buf = net_pkt_get_reserve_rx_data(K_NO_WAIT);
+		if (buf == NULL) {
+			LOG_ERR("Failed to get RX buffer %d", i);
+			return -ENOBUFS;
+		}
+
+		dcache_flush(buf->data, ETH_RING_RX_BUF_SIZE);
+		dev_data->rx_bufs[i] = buf;
+
+		desc = &dma_rx_desc_tab[i];
+		desc->Buffer1Addr = (uint32_t)buf->data;
+		desc->ControlBufferSize = ETH_DMARXDESC_RCH | ETH_RX_DESC_DIC |
+					  ETH_RING_RX_BUF_SIZE;
+		desc->Buffer2NextDescAddr = (uint32_t)
+			&dma_rx_desc_tab[(i + 1) % ETH_RING_RX_DESC_NB];
+		desc->Status = ETH_DMARXDESC_OWN;
+	}
+
+	dev_data->rx_tail = 0U;
+
+	heth->Instance->DMATDLAR = (uint32_t)dma_tx_desc_tab;
+	heth->Instance->DMARDLAR = (uint32_t)dma_rx_desc_tab;
+
+	return 0;
+}
+
+static void dma_ring_irq_init(ETH_HandleTypeDef *heth)
+{
+#if CONFIG_ETH_STM32_HAL_RX_COALESCE_US > 0
+	/* The receive watchdog counts in units of 256 HCLK cycles */
+	uint32_t rswtc = SystemCoreClock / 1000000U *
+			 CONFIG_ETH_STM32_HAL_RX_COALESCE_US / 256U;
+
+	heth->Instance->DMARSWTR = MAX(MIN(rswtc, 0xffU), 1U);
+#endif
+
+	/* HAL_ETH_Init() only enables the RX interrupt */
+	__HAL_ETH_DMA_ENABLE_IT(heth, ETH_DMA_IT_T);
+}
+
+/* Release the TX descriptors, and the packets, the DMA is done with. */
+static void dma_ring_tx_reclaim(struct eth_stm32_hal_dev_data *dev_data)
+{
+	uint16_t tail = dev_data->tx_tail;
+
+	while (dev_data->tx_free < ETH_RING_TX_DESC_NB) {
+		if (dma_tx_desc_tab[tail].Status & ETH_DMATXDESC_OWN) {
+			break;
+		}
+
+		if (dev_data->tx_pkts[tail] != NULL) {
+			net_pkt_unref(dev_data->tx_pkts[tail]);
+			dev_data->tx_pkts[tail] = NULL;
+		}
+
+		tail = (tail + 1U) % ETH_RING_TX_DESC_NB;
+		dev_data->tx_free++;
+	}
+
+	dev_data->tx_tail = tail;
+}
+
+static int eth_tx_ring(struct device *dev, struct net_pkt *pkt)
+{
+	struct eth_stm32_hal_dev_data *dev_data = DEV_DATA(dev);
+	ETH_HandleTypeDef *heth;
+	ETH_DMADescTypeDef *desc;
+	struct net_buf *frag;
+	uint16_t first, last, idx;
+	uint16_t count = 0U;
+	uint32_t status;
+	int res;
+
+	__ASSERT_NO_MSG(pkt != NULL);
+	__ASSERT_NO_MSG(pkt->frags != NULL);
+	__ASSERT_NO_MSG(dev_data != NULL);
+
+	heth = &dev_data->heth;
+
+	for (frag = pkt->frags; frag; frag = frag->frags) {
+		if (frag->len) {
+			count++;
+		}
+	}
+
+	if (count == 0U || count > ETH_RING_TX_DESC_NB) {
+		LOG_ERR("PKT has %u fragments", count);
+		return -EIO;
+	}
+
+	k_mutex_lock(&dev_data->tx_mutex, K_FOREVER);
+
+	dma_ring_tx_reclaim(dev_data);
+
+	while (dev_data->tx_free < count) {
+		res = k_sem_take(&dev_data->tx_int_sem,
+				 K_MSEC(ETH_TX_RING_TIMEOUT_MS));
+		dma_ring_tx_reclaim(dev_data);
+		if (res < 0 && dev_data->tx_free < count) {
+			LOG_ERR("TX descriptors not released");
+			res = -EIO;
+			goto error;
+		}
+	}
+
+	first = dev_data->tx_head;
+	last = first;
+	idx = first;
+
+	for (frag = pkt->frags; frag; frag = frag->frags) {
+		if (!frag->len) {
+			continue;
+		}
+
+		dcache_clean(frag->data, frag->len);
+
+		desc = &dma_tx_desc_tab[idx];
+		desc->Buffer1Addr = (uint32_t)frag->data;
+		desc->ControlBufferSize = frag->len & ETH_DMATXDESC_TBS1;
+
+		/* The first descriptor is handed over once the whole frame
+		 * is set up.
+		 */
+		if (idx == first) {
+			status = ETH_DMATXDESC_TCH | ETH_DMATXDESC_FS |
+				 ETH_TX_DESC_CIC;
+		} else {
+			status = ETH_DMATXDESC_TCH | ETH_DMATXDESC_OWN;
+		}
+
+		if (--count == 0U) {
+			status |= ETH_DMATXDESC_LS;
+			last = idx;
+		}
+
+		desc->Status = status;
+
+		idx = (idx + 1U) % ETH_RING_TX_DESC_NB;
+		dev_data->tx_free--;
+	}
+
+	/* Keep an interrupt pending whenever the ring may fill up, a sender
+	 * waiting for free descriptors depends on it.
+	 */
+	if (++dev_data->tx_since_ic >= CONFIG_ETH_STM32_HAL_TX_COALESCE_FRAMES ||
+	    dev_data->tx_free < ETH_RING_TX_DESC_NB / 2) {
+		dma_tx_desc_tab[last].Status |= ETH_DMATXDESC_IC;
+		dev_data->tx_since_ic = 0U;
+	}
+
+	/* The buffers are sent in place, hold them until the DMA is done */
+	net_pkt_ref(pkt);
+	dev_data->tx_pkts[last] = pkt;
+	dev_data->tx_head = idx;
+
+	__DMB();
+	dma_tx_desc_tab[first].Status |= ETH_DMATXDESC_OWN;
+	__DSB();
+
+	/* Resume the DMA in case it suspended on an empty ring */
+	if ((heth->Instance->DMASR & ETH_DMASR_TBUS) != (uint32_t)RESET) {
+		heth->Instance->DMASR = ETH_DMASR_TBUS;
+	}
+	heth->Instance->DMATPDR = 0U;
+
+	res = 0;
+error:
+	k_mutex_unlock(&dev_data->tx_mutex);
+
+	return res;
+}
+#endif /* CONFIG_ETH_STM32_HAL_DMA_RING */
 
 static struct net_if *get_iface(struct eth_stm32_hal_dev_data *ctx,
 				uint16_t vlan_tag)
@@ -272,17 +551,169 @@ static struct net_if *get_iface(struct eth_stm32_hal_dev_data *ctx,
 #endif
 }
 
+#if defined(CONFIG_ETH_STM32_HAL_DMA_RING)
+#if defined(CONFIG_ETH_STM32_HAL_HW_CHECKSUM)
+static void dma_ring_rx_chksum(struct net_pkt *pkt, uint32_t status,
+			       uint32_t ext_status)
+{
+	/* Bit 0 flags the extended status as valid with the enhanced
+	 * descriptor format. Frames failing a checksum check are dropped by
+	 * the DMA.
+	 */
+	if (!(status & ETH_DMARXDESC_MAMPCE) ||
+	    (ext_status & (ETH_DMAPTPRXDESC_IPCB | ETH_DMAPTPRXDESC_IPHE |
+			   ETH_DMAPTPRXDESC_IPPE))) {
+		return;
+	}
+
+	switch (ext_status & ETH_DMAPTPRXDESC_IPPT) {
+	case ETH_DMAPTPRXDESC_IPPT_UDP:
+	case ETH_DMAPTPRXDESC_IPPT_TCP:
+		net_pkt_set_chksum_state(pkt, NET_PKT_CHKSUM_VERIFIED);
+		break;
+	default:
+		if (ext_status & ETH_DMAPTPRXDESC_IPV4PR) {
+			net_pkt_set_chksum_state(pkt,
+						 NET_PKT_CHKSUM_IP_VERIFIED);
+		}
+		break;
+	}
+}
+#else
+#define dma_ring_rx_chksum(pkt, status, ext_status)
+#endif /* CONFIG_ETH_STM32_HAL_HW_CHECKSUM */
+
+/*
+ * Take the next complete frame off the RX ring. The RX buffers holding the
+ * frame are linked into the packet as they are, and the descriptors get
+ * fresh buffers. When no fresh buffer is available the frame is dropped and
+ * the descriptors keep their buffers.
+ */
+static struct net_pkt *dma_ring_rx_frame(
+		struct eth_stm32_hal_dev_data *dev_data, struct net_if *iface)
+{
+	ETH_HandleTypeDef *heth = &dev_data->heth;
+	ETH_DMADescTypeDef *desc;
+	struct net_buf *buf;
+	struct net_buf *new_buf;
+	struct net_pkt *pkt;
+	uint32_t first_status;
+	uint32_t status;
+	uint32_t ext_status;
+	size_t frame_len;
+	size_t len;
+	uint16_t count;
+	uint16_t idx;
+
+	while (true) {
+		idx = dev_data->rx_tail;
+		first_status = dma_rx_desc_tab[idx].Status;
+
+		/* Wait until the DMA has released every segment */
+		for (count = 1U; ; count++) {
+			desc = &dma_rx_desc_tab[idx];
+			status = desc->Status;
+			if (status & ETH_DMARXDESC_OWN) {
+				return NULL;
+			}
+
+			if ((status & ETH_DMARXDESC_LS) ||
+			    count == ETH_RING_RX_DESC_NB) {
+				break;
+			}
+
+			idx = (idx + 1U) % ETH_RING_RX_DESC_NB;
+		}
+
+		ext_status = desc->ExtendedStatus;
+		frame_len = (status & ETH_DMARXDESC_FL) >>
+			    ETH_DMARXDESC_FRAMELENGTHSHIFT;
+
+		pkt = NULL;
+
+		if (!(first_status & ETH_DMARXDESC_FS) ||
+		    !(status & ETH_DMARXDESC_LS) ||
+		    (status & ETH_DMARXDESC_ES) || frame_len <= 4U) {
+			LOG_DBG("Dropping frame, status 0x%08x", status);
+		} else {
+			pkt = net_pkt_rx_alloc_on_iface(iface, K_NO_WAIT);
+			if (!pkt) {
+				LOG_ERR("Failed to obtain RX buffer");
+			}
+		}
+
+		/* The frame length includes the CRC */
+		frame_len -= MIN(frame_len, 4U);
+		idx = dev_data->rx_tail;
+
+		while (count--) {
+			desc = &dma_rx_desc_tab[idx];
+			buf = dev_data->rx_bufs[idx];
+			len = MIN(frame_len, ETH_RING_RX_BUF_SIZE);
+
+			if (pkt && len) {
+				new_buf = net_pkt_get_reserve_rx_data(K_NO_WAIT);
+				if (new_buf == NULL) {
+					LOG_ERR("Failed to refill RX ring");
+					net_pkt_unref(pkt);
+					pkt = NULL;
+				} else {
+					dcache_invalidate(buf->data, len);
+					net_buf_add(buf, len);
+					net_pkt_frag_add(pkt, buf);
+
+					dcache_flush(new_buf->data,
+						     ETH_RING_RX_BUF_SIZE);
+					dev_data->rx_bufs[idx] = new_buf;
+					desc->Buffer1Addr =
+						(uint32_t)new_buf->data;
+				}
+			}
+
+			frame_len -= len;
+
+			/* Give the descriptor back to the DMA */
+			__DMB();
+			desc->Status = ETH_DMARXDESC_OWN;
+
+			idx = (idx + 1U) % ETH_RING_RX_DESC_NB;
+		}
+
+		dev_data->rx_tail = idx;
+
+		/* When Rx Buffer unavailable flag is set: clear it
+		 * and resume reception.
+		 */
+		__DSB();
+		if ((heth->Instance->DMASR & ETH_DMASR_RBUS) !=
+		    (uint32_t)RESET) {
+			heth->Instance->DMASR = ETH_DMASR_RBUS;
+			heth->Instance->DMARPDR = 0U;
+		}
+
+		if (pkt) {
+			dma_ring_rx_chksum(pkt, status, ext_status);
+			return pkt;
+		}
+
+		eth_stats_update_errors_rx(iface);
+	}
+}
+#endif /* CONFIG_ETH_STM32_HAL_DMA_RING */
+
 static struct net_pkt *eth_rx(struct device *dev, uint16_t *vlan_tag)
 {
 	struct eth_stm32_hal_dev_data *dev_data;
+	struct net_pkt *pkt;
+#if !defined(CONFIG_ETH_STM32_HAL_DMA_RING)
 	ETH_HandleTypeDef *heth;
 #if !defined(CONFIG_SOC_SERIES_STM32H7X)
 	__IO ETH_DMADescTypeDef *dma_rx_desc;
 #endif /* !CONFIG_SOC_SERIES_STM32H7X */
-	struct net_pkt *pkt;
 	size_t total_len;
 	uint8_t *dma_buffer;
 	HAL_StatusTypeDef hal_ret = HAL_OK;
+#endif /* !CONFIG_ETH_STM32_HAL_DMA_RING */
 
 	__ASSERT_NO_MSG(dev != NULL);
 
@@ -290,6 +721,12 @@ static struct net_pkt *eth_rx(struct device *dev, uint16_t *vlan_tag)
 
 	__ASSERT_NO_MSG(dev_data != NULL);
 
+#if defined(CONFIG_ETH_STM32_HAL_DMA_RING)
+	pkt = dma_ring_rx_frame(dev_data, get_iface(dev_data, *vlan_tag));
+	if (!pkt) {
+		return NULL;
+	}
+#else
 	heth = &dev_data->heth;
 
 #if defined(CONFIG_SOC_SERIES_STM32H7X)
@@ -372,6 +809,7 @@ release_desc:
 		heth->Instance->DMARPDR = 0;
 	}
 #endif /* CONFIG_SOC_SERIES_STM32H7X */
+#endif /* CONFIG_ETH_STM32_HAL_DMA_RING */
 
 #if defined(CONFIG_NET_VLAN)
 	struct net_eth_hdr *hdr = NET_ETH_HDR(pkt);
@@ -441,6 +879,12 @@ static void rx_thread(void *arg1, void *unused1, void *unused2)
 				}
 			}
 		} else if (res == -EAGAIN) {
+#if defined(CONFIG_ETH_STM32_HAL_DMA_RING)
+			/* release the buffers of the last frames sent */
+			k_mutex_lock(&dev_data->tx_mutex, K_FOREVER);
+			dma_ring_tx_reclaim(dev_data);
+			k_mutex_unlock(&dev_data->tx_mutex);
+#endif
 			/* semaphore timeout period expired, check link status */
 			hal_ret = read_eth_phy_register(&dev_data->heth,
 				    PHY_ADDR, PHY_BSR, (uint32_t *) &status);
@@ -482,7 +926,22 @@ static void eth_isr(void *arg)
 
 	__ASSERT_NO_MSG(heth != NULL);
 
+#if defined(CONFIG_ETH_STM32_HAL_DMA_RING)
+	uint32_t status = heth->Instance->DMASR;
+
+	heth->Instance->DMASR = status & (ETH_DMASR_RS | ETH_DMASR_TS |
+					  ETH_DMASR_NIS);
+
+	if (status & ETH_DMASR_RS) {
+		k_sem_give(&dev_data->rx_int_sem);
+	}
+
+	if (status & ETH_DMASR_TS) {
+		k_sem_give(&dev_data->tx_int_sem);
+	}
+#else
 	HAL_ETH_IRQHandler(heth);
+#endif /* CONFIG_ETH_STM32_HAL_DMA_RING */
 }
 
 
@@ -583,6 +1042,9 @@ static int eth_initialize(struct device *dev)
 	/* Initialize semaphores */
 	k_mutex_init(&dev_data->tx_mutex);
 	k_sem_init(&dev_data->rx_int_sem, 0, UINT_MAX);
+#if defined(CONFIG_ETH_STM32_HAL_DMA_RING)
+	k_sem_init(&dev_data->tx_int_sem, 0, 1);
+#endif
 
 	/* Start interruption-poll thread */
 	k_thread_create(&dev_data->rx_thread, dev_data->rx_thread_stack,
@@ -605,11 +1067,20 @@ static int eth_initialize(struct device *dev)
 	}
 
 	hal_ret = HAL_ETH_Start_IT(heth);
+#else
+#if defined(CONFIG_ETH_STM32_HAL_DMA_RING)
+	ret = dma_ring_init(dev_data);
+	if (ret < 0) {
+		return ret;
+	}
+
+	dma_ring_irq_init(heth);
 #else
 	HAL_ETH_DMATxDescListInit(heth, dma_tx_desc_tab,
 		&dma_tx_buffer[0][0], ETH_TXBUFNB);
 	HAL_ETH_DMARxDescListInit(heth, dma_rx_desc_tab,
 		&dma_rx_buffer[0][0], ETH_RXBUFNB);
+#endif /* CONFIG_ETH_STM32_HAL_DMA_RING */
 
 	hal_ret = HAL_ETH_Start(heth);
 #endif /* CONFIG_SOC_SERIES_STM32H7X */
@@ -688,6 +1159,10 @@ static enum ethernet_hw_caps eth_stm32_hal_get_capabilities(struct device *dev)
 	return ETHERNET_LINK_10BASE_T | ETHERNET_LINK_100BASE_T
 #if defined(CONFIG_NET_VLAN)
 		| ETHERNET_HW_VLAN
+#endif
+#if defined(CONFIG_ETH_STM32_HAL_HW_CHECKSUM)
+		| ETHERNET_HW_TX_CHKSUM_OFFLOAD
+		| ETHERNET_HW_RX_CHKSUM_OFFLOAD
 #endif
 		;
 }
@@ -724,7 +1199,11 @@ static const struct ethernet_api eth_api = {
 
 	.get_capabilities = eth_stm32_hal_get_capabilities,
 	.set_config = eth_stm32_hal_set_config,
+#if defined(CONFIG_ETH_STM32_HAL_DMA_RING)
+	.send = eth_tx_ring,
+#else
 	.send = eth_tx,
+#endif
 };
 
 DEVICE_DECLARE(eth0_stm32_hal);
@@ -758,7 +1237,12 @@ static struct eth_stm32_hal_dev_data eth0_data = {
 			.AutoNegotiation = ETH_AUTONEGOTIATION_ENABLE,
 			.PhyAddress = PHY_ADDR,
 			.RxMode = ETH_RXINTERRUPT_MODE,
+#if defined(CONFIG_ETH_STM32_HAL_HW_CHECKSUM)
+			/* Full TX insertion is set up in the DMA descriptors */
+			.ChecksumMode = ETH_CHECKSUM_BY_HARDWARE,
+#else
 			.ChecksumMode = ETH_CHECKSUM_BY_SOFTWARE,
+#endif
 #endif /* !CONFIG_SOC_SERIES_STM32H7X */
 #if defined(CONFIG_ETH_STM32_HAL_MII)
 			.MediaInterface = ETH_MEDIA_INTERFACE_MII,
@@ -20,6 +20,13 @@
 #define ETH_RX_BUF_SIZE	ETH_MAX_PACKET_SIZE /* buffer size for receive */
 #define ETH_TX_BUF_SIZE	ETH_MAX_PACKET_SIZE /* buffer size for transmit */
 
+#if defined(CONFIG_ETH_STM32_HAL_DMA_RING)
+#define ETH_RING_RX_DESC_NB	CONFIG_ETH_STM32_HAL_DMA_RING_RX_DESC
+#define ETH_RING_TX_DESC_NB	CONFIG_ETH_STM32_HAL_DMA_RING_TX_DESC
+/* The DMA needs the RX buffer size to be a multiple of 4 */
+#define ETH_RING_RX_BUF_SIZE	(CONFIG_NET_BUF_DATA_SIZE & ~3)
+#endif /* CONFIG_ETH_STM32_HAL_DMA_RING */
+
 /* Device constant configuration parameters */
 struct eth_stm32_hal_dev_cfg {
 	void (*config_func)(void);
@@ -44,6 +51,18 @@ struct eth_stm32_hal_dev_data {
 		CONFIG_ETH_STM32_HAL_RX_THREAD_STACK_SIZE);
 	struct k_thread rx_thread;
 	bool link_up;
+#if defined(CONFIG_ETH_STM32_HAL_DMA_RING)
+	struct k_sem tx_int_sem;
+	/* RX buffers owned by the RX descriptors */
+	struct net_buf *rx_bufs[ETH_RING_RX_DESC_NB];
+	/* Packets referenced by the last TX descriptor of each frame */
+	struct net_pkt *tx_pkts[ETH_RING_TX_DESC_NB];
+	uint16_t rx_tail;
+	uint16_t tx_head;
+	uint16_t tx_tail;
+	uint16_t tx_free;
+	uint8_t tx_since_ic;
+#endif /* CONFIG_ETH_STM32_HAL_DMA_RING */
 };
 
 #define DEV_CFG(dev) \
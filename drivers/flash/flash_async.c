@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Asynchronous flash operations, run by a thread with the blocking driver
+ * API. Drivers that sleep while the device is busy, like spi_nor and
+ * nrf_qspi_nor, let the submitter run during long erases.
+ */
+
+#include <kernel.h>
+#include <drivers/flash.h>
+#include <errno.h>
+
+enum {
+	FLASH_ASYNC_READ,
+	FLASH_ASYNC_WRITE,
+	FLASH_ASYNC_ERASE,
+};
+
+static K_FIFO_DEFINE(flash_async_fifo);
+
+static int flash_async_submit(struct device *dev, uint8_t type, off_t offset,
+			      void *data, size_t len,
+			      struct flash_async_op *op,
+			      struct k_poll_signal *signal)
+{
+	if ((dev == NULL) || (op == NULL) || (signal == NULL)) {
+		return -EINVAL;
+	}
+
+	op->dev = dev;
+	op->type = type;
+	op->offset = offset;
+	op->data = data;
+	op->len = len;
+	op->signal = signal;
+
+	k_fifo_put(&flash_async_fifo, op);
+
+	return 0;
+}
+
+int flash_read_async(struct device *dev, off_t offset, void *data,
+		     size_t len, struct flash_async_op *op,
+		     struct k_poll_signal *signal)
+{
+	return flash_async_submit(dev, FLASH_ASYNC_READ, offset, data, len,
+				  op, signal);
+}
+
+int flash_write_async(struct device *dev, off_t offset, const void *data,
+		      size_t len, struct flash_async_op *op,
+		      struct k_poll_signal *signal)
+{
+	return flash_async_submit(dev, FLASH_ASYNC_WRITE, offset, (void *)data,
+				  len, op, signal);
+}
+
+int flash_erase_async(struct device *dev, off_t offset, size_t size,
+		      struct flash_async_op *op,
+		      struct k_poll_signal *signal)
+{
+	return flash_async_submit(dev, FLASH_ASYNC_ERASE, offset, NULL, size,
+				  op, signal);
+}
+
+static void flash_async_thread(void *p1, void *p2, void *p3)
+{
+	struct flash_async_op *op;
+	int rc;
+
+	for (;;) {
+		op = k_fifo_get(&flash_async_fifo, K_FOREVER);
+
+		switch (op->type) {
+		case FLASH_ASYNC_READ:
+			rc = flash_read(op->dev, op->offset, op->data, op->len);
+			break;
+		case FLASH_ASYNC_WRITE:
+			rc = flash_write(op->dev, op->offset, op->data,
+					 op->len);
+			break;
+		default:
+			rc = flash_erase(op->dev, op->offset, op->len);
+			break;
+		}
+
+		k_poll_signal_raise(op->signal, rc);
+	}
+}
+
+K_THREAD_DEFINE(flash_async, CONFIG_FLASH_ASYNC_STACK_SIZE,
+		flash_async_thread, NULL, NULL, NULL,
+		CONFIG_FLASH_ASYNC_THREAD_PRIO, 0, 0);
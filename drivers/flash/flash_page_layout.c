@@ -19,6 +19,25 @@ static int flash_get_page_info(struct device *dev, off_t offs,
 
 	api->page_layout(dev, &layout, &layout_size);
 
+	/* Most devices have pages of a single size */
+	if (layout_size == 1U) {
+		if (use_addr) {
+			num_in_group = offs / layout->pages_size;
+		} else {
+			num_in_group = offs;
+		}
+
+		if (num_in_group >= layout->pages_count) {
+			return -EINVAL;
+		}
+
+		info->size = layout->pages_size;
+		info->start_offset = num_in_group * layout->pages_size;
+		info->index = num_in_group;
+
+		return 0;
+	}
+
 	while (layout_size--) {
 		if (use_addr) {
 			end += layout->pages_count * layout->pages_size;
@@ -81,6 +100,54 @@ size_t z_impl_flash_get_page_count(struct device *dev)
 	return count;
 }
 
+void flash_page_foreach_in_range(struct device *dev, off_t offset,
+				 size_t size, flash_page_cb cb, void *data)
+{
+	const struct flash_driver_api *api = dev->api;
+	const struct flash_pages_layout *layout;
+	struct flash_pages_info page_info;
+	size_t block, num_blocks, page = 0, i;
+	off_t group_end;
+	off_t off = 0;
+	off_t end = offset + size;
+
+	api->page_layout(dev, &layout, &num_blocks);
+
+	for (block = 0; (block < num_blocks) && (off < end); block++) {
+		const struct flash_pages_layout *l = &layout[block];
+
+		group_end = off + l->pages_count * l->pages_size;
+
+		/* Skip the groups and pages before the range */
+		if (group_end <= offset) {
+			off = group_end;
+			page += l->pages_count;
+			continue;
+		}
+
+		i = 0;
+		if (off < offset) {
+			i = (offset - off) / l->pages_size;
+			off += i * l->pages_size;
+			page += i;
+		}
+
+		page_info.size = l->pages_size;
+
+		for (; (i < l->pages_count) && (off < end); i++) {
+			page_info.start_offset = off;
+			page_info.index = page;
+
+			if (!cb(&page_info, data)) {
+				return;
+			}
+
+			off += page_info.size;
+			page++;
+		}
+	}
+}
+
 void flash_page_foreach(struct device *dev, flash_page_cb cb, void *data)
 {
 	const struct flash_driver_api *api = dev->api;
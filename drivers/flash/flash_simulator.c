@@ -8,6 +8,7 @@
 
 #include <device.h>
 #include <drivers/flash.h>
+#include <drivers/flash/flash_simulator.h>
 #include <init.h>
 #include <kernel.h>
 #include <sys/util.h>
@@ -66,7 +67,7 @@
 /* increment a unit erase cycles counter */
 #define ERASE_CYCLES_INC(U)						     \
 	do {								     \
-		if (U < STATS_PAGE_COUNT_THRESHOLD) {			     \
+		if (U < FLASH_SIMULATOR_FLASH_PAGE_COUNT) {		     \
 			(*(&flash_sim_stats.erase_cycles_unit0 + (U)) += 1); \
 		}							     \
 	} while (0)
@@ -139,6 +140,56 @@ static uint8_t mock_flash[FLASH_SIMULATOR_FLASH_SIZE];
 
 static bool write_protection;
 
+/* operations take no time unless simulated */
+static struct flash_simulator_timing timing = {
+#ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+	.read_us = CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US,
+	.read_byte_ns = CONFIG_FLASH_SIMULATOR_READ_BYTE_TIME_NS,
+	.write_us = CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US,
+	.write_unit_us = CONFIG_FLASH_SIMULATOR_WRITE_UNIT_TIME_US,
+	.erase_us = CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US,
+	.erase_unit_us = CONFIG_FLASH_SIMULATOR_ERASE_UNIT_TIME_US,
+#endif
+};
+
+#ifdef CONFIG_FLASH_SIMULATOR_UNIT_STATS
+static struct flash_simulator_unit_stats
+	unit_stats[FLASH_SIMULATOR_PAGE_COUNT];
+
+/* account a write to the erase units it spans */
+static void unit_stats_write(off_t offset, size_t len)
+{
+	off_t end = offset + len;
+
+	offset -= FLASH_SIMULATOR_BASE_OFFSET;
+	end -= FLASH_SIMULATOR_BASE_OFFSET;
+
+	while (offset < end) {
+		uint32_t unit = offset / FLASH_SIMULATOR_ERASE_UNIT;
+		off_t unit_end = (unit + 1) * FLASH_SIMULATOR_ERASE_UNIT;
+		size_t n = MIN(end, unit_end) - offset;
+
+		unit_stats[unit].writes++;
+		unit_stats[unit].bytes_written += n;
+		offset += n;
+	}
+}
+#else
+static inline void unit_stats_write(off_t offset, size_t len)
+{
+}
+#endif /* CONFIG_FLASH_SIMULATOR_UNIT_STATS */
+
+/* wait for the simulated duration of an operation */
+static uint32_t sim_delay(uint32_t time_us)
+{
+	if (time_us != 0) {
+		k_busy_wait(time_us);
+	}
+
+	return time_us;
+}
+
 static const struct flash_driver_api flash_sim_api;
 
 static const struct flash_parameters flash_sim_parameters = {
@@ -192,11 +243,9 @@ static int flash_sim_read(struct device *dev, const off_t offset, void *data,
 	memcpy(data, FLASH(offset), len);
 	STATS_INCN(flash_sim_stats, bytes_read, len);
 
-#ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
-	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US);
 	STATS_INCN(flash_sim_stats, flash_read_time_us,
-		   CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US);
-#endif
+		   sim_delay(timing.read_us +
+			     ((uint64_t)len * timing.read_byte_ns) / 1000U));
 
 	return 0;
 }
@@ -265,13 +314,13 @@ static int flash_sim_write(struct device *dev, const off_t offset,
 	}
 
 	STATS_INCN(flash_sim_stats, bytes_written, len);
+	unit_stats_write(offset, len);
 
-#ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
 	/* wait before returning */
-	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US);
 	STATS_INCN(flash_sim_stats, flash_write_time_us,
-		   CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US);
-#endif
+		   sim_delay(timing.write_us +
+			     (len / FLASH_SIMULATOR_PROG_UNIT) *
+			     timing.write_unit_us));
 
 	return 0;
 }
@@ -321,15 +370,17 @@ static int flash_sim_erase(struct device *dev, const off_t offset,
 	/* erase as many units as necessary and increase their erase counter */
 	for (uint32_t i = 0; i < len / FLASH_SIMULATOR_ERASE_UNIT; i++) {
 		ERASE_CYCLES_INC(unit_start + i);
+#ifdef CONFIG_FLASH_SIMULATOR_UNIT_STATS
+		unit_stats[unit_start + i].erases++;
+#endif
 		unit_erase(unit_start + i);
 	}
 
-#ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
 	/* wait before returning */
-	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US);
 	STATS_INCN(flash_sim_stats, flash_erase_time_us,
-		   CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US);
-#endif
+		   sim_delay(timing.erase_us +
+			     (len / FLASH_SIMULATOR_ERASE_UNIT) *
+			     timing.erase_unit_us));
 
 	return 0;
 }
@@ -368,6 +419,52 @@ static const struct flash_driver_api flash_sim_api = {
 #endif
 };
 
+void flash_simulator_timing_get(struct device *dev,
+				struct flash_simulator_timing *t)
+{
+	ARG_UNUSED(dev);
+
+	*t = timing;
+}
+
+void flash_simulator_timing_set(struct device *dev,
+				const struct flash_simulator_timing *t)
+{
+	ARG_UNUSED(dev);
+
+	timing = *t;
+}
+
+size_t flash_simulator_unit_count(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return FLASH_SIMULATOR_PAGE_COUNT;
+}
+
+#ifdef CONFIG_FLASH_SIMULATOR_UNIT_STATS
+int flash_simulator_unit_stats_get(struct device *dev, size_t unit,
+				   struct flash_simulator_unit_stats *stats)
+{
+	ARG_UNUSED(dev);
+
+	if (unit >= FLASH_SIMULATOR_PAGE_COUNT) {
+		return -EINVAL;
+	}
+
+	*stats = unit_stats[unit];
+
+	return 0;
+}
+
+void flash_simulator_unit_stats_reset(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	memset(unit_stats, 0, sizeof(unit_stats));
+}
+#endif /* CONFIG_FLASH_SIMULATOR_UNIT_STATS */
+
 #ifdef CONFIG_ARCH_POSIX
 
 static int flash_mock_init(struct device *dev)
@@ -81,11 +81,16 @@ struct qspi_cmd {
  * @param sync The semaphore to ensure that transfer has finished
  * @param write_protection Indicates if write protection for flash
  *  device is enabled
+ * @param mem_busy Indicates if an erase or a write may still be in
+ *  progress in the flash, which can't be read through XIP meanwhile
  */
 struct qspi_nor_data {
 	struct k_sem sem;
 	struct k_sem sync;
 	bool write_protection;
+#if defined(CONFIG_NORDIC_QSPI_NOR_XIP)
+	bool mem_busy;
+#endif
 };
 
 static inline int qspi_get_mode(bool cpol, bool cpha)
@@ -273,6 +278,31 @@ static inline void qspi_complete(struct device *dev)
 	k_sem_give(&dev_data->sync);
 }
 
+/* The transfer of an erase or write is done before the flash is */
+static inline void qspi_set_mem_busy(struct device *dev)
+{
+#if defined(CONFIG_NORDIC_QSPI_NOR_XIP)
+	struct qspi_nor_data *dev_data = get_dev_data(dev);
+
+	dev_data->mem_busy = true;
+#endif
+}
+
+#if defined(CONFIG_NORDIC_QSPI_NOR_XIP)
+static void qspi_wait_mem_ready(struct device *dev)
+{
+	struct qspi_nor_data *dev_data = get_dev_data(dev);
+
+	while (dev_data->mem_busy) {
+		if (nrfx_qspi_mem_busy_check() != NRFX_ERROR_BUSY) {
+			dev_data->mem_busy = false;
+		} else {
+			k_sleep(K_MSEC(1));
+		}
+	}
+}
+#endif
+
 /**
  * @brief QSPI handler
  *
@@ -374,6 +404,7 @@ static int qspi_erase(struct device *dev, uint32_t addr, uint32_t size)
 		}
 	}
 
+	qspi_set_mem_busy(dev);
 	qspi_unlock(dev);
 
 	return rv;
@@ -607,7 +638,17 @@ static int qspi_nor_read(struct device *dev, off_t addr, void *dest,
 
 	qspi_lock(dev);
 
+#if defined(CONFIG_NORDIC_QSPI_NOR_XIP)
+	/* The CPU reads any size and alignment, unlike the DMA */
+	qspi_wait_mem_ready(dev);
+	memcpy(dest,
+	       (const void *)(CONFIG_NORDIC_QSPI_NOR_XIP_ADDRESS + addr),
+	       size);
+
+	nrfx_err_t res = NRFX_SUCCESS;
+#else
 	nrfx_err_t res = read_non_aligned(dev, addr, dest, size);
+#endif
 
 	qspi_unlock(dev);
 
@@ -722,6 +763,7 @@ static int qspi_nor_write(struct device *dev, off_t addr, const void *src,
 		qspi_wait_for_completion(dev, res);
 	}
 
+	qspi_set_mem_busy(dev);
 	qspi_unlock(dev);
 
 	return qspi_get_zephyr_ret_code(res);
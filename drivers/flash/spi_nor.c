@@ -44,6 +44,13 @@ LOG_MODULE_REGISTER(spi_nor, CONFIG_FLASH_LOG_LEVEL);
 
 #define SPI_NOR_MAX_ADDR_WIDTH 4
 
+/* Status polls done back to back before sleeping between polls, and
+ * bounds of the sleep duration.
+ */
+#define SPI_NOR_WAIT_SPIN_POLLS 32U
+#define SPI_NOR_WAIT_MIN_DELAY_US 100U
+#define SPI_NOR_WAIT_MAX_DELAY_US 10000U
+
 #ifndef NSEC_PER_MSEC
 #define NSEC_PER_MSEC (NSEC_PER_USEC * USEC_PER_MSEC)
 #endif
@@ -112,6 +119,10 @@ struct spi_nor_data {
 	 */
 	uint32_t ts_enter_dpd;
 #endif
+#ifdef CONFIG_SPI_NOR_ERASE_SUSPEND
+	/* Number of erases waiting with the device released */
+	uint8_t erasing;
+#endif
 
 	/* Minimal SFDP stores no dynamic configuration.  Runtime and
 	 * devicetree store page size and erase_types; runtime also
@@ -345,6 +356,51 @@ static int read_sfdp(const struct device *const dev,
 }
 #endif /* CONFIG_SPI_NOR_SFDP_RUNTIME */
 
+#ifdef CONFIG_SPI_NOR_FAST_READ
+/*
+ * @brief Read data with the Fast Read command
+ *
+ * Fast Read is followed by a wait state byte and runs at the maximum
+ * clock frequency of the device, while Read is limited to a lower one on
+ * many devices.
+ *
+ * @param dev Device struct
+ * @param addr The address to read from
+ * @param data The buffer to store the data
+ * @param length The size of the buffer
+ * @return 0 on success, negative errno code otherwise
+ */
+static int read_fast(const struct device *const dev,
+		     off_t addr, void *data, size_t length)
+{
+	struct spi_nor_data *const driver_data = dev->data;
+	uint8_t buf[] = {
+		SPI_NOR_CMD_READ_FAST,
+		addr >> 16,
+		addr >> 8,
+		addr,
+		0,		/* wait state */
+	};
+	struct spi_buf spi_buf[] = {
+		{
+			.buf = buf,
+			.len = sizeof(buf),
+		},
+		{
+			.buf = data,
+			.len = length,
+		}
+	};
+	const struct spi_buf_set buf_set = {
+		.buffers = spi_buf,
+		.count = ARRAY_SIZE(spi_buf),
+	};
+
+	return spi_transceive(driver_data->spi, &driver_data->spi_cfg,
+			      &buf_set, &buf_set);
+}
+#endif /* CONFIG_SPI_NOR_FAST_READ */
+
 static int enter_dpd(const struct device *const dev)
 {
 	int ret = 0;
@@ -437,14 +493,72 @@ static int spi_nor_wait_until_ready(struct device *dev)
 {
 	int ret;
 	uint8_t reg;
+	unsigned int polls = 0U;
+	uint32_t delay_us = SPI_NOR_WAIT_MIN_DELAY_US;
 
-	do {
+	/* Page programs complete after a few polls.  Erases take
+	 * milliseconds to seconds, sleep between polls with an
+	 * increasing delay instead of keeping the bus busy.
+	 */
+	while (true) {
 		ret = spi_nor_cmd_read(dev, SPI_NOR_CMD_RDSR, &reg, 1);
-	} while (!ret && (reg & SPI_NOR_WIP_BIT));
+		if ((ret != 0) || ((reg & SPI_NOR_WIP_BIT) == 0U)) {
+			break;
+		}
+
+		if ((polls < SPI_NOR_WAIT_SPIN_POLLS) || k_is_pre_kernel()
+		    || !IS_ENABLED(CONFIG_MULTITHREADING)) {
+			++polls;
+			continue;
+		}
+
+		k_sleep(K_USEC(delay_us));
+		delay_us = MIN(2U * delay_us, SPI_NOR_WAIT_MAX_DELAY_US);
+	}
 
 	return ret;
 }
 
+#ifdef CONFIG_SPI_NOR_ERASE_SUSPEND
+/**
+ * @brief Wait until an erase completes, releasing the device meanwhile
+ *
+ * Reads issued while the device is released suspend the erase.
+ *
+ * @param dev The device structure
+ * @return 0 on success, negative errno code otherwise
+ */
+static int spi_nor_wait_erase_done(struct device *dev)
+{
+	struct spi_nor_data *const driver_data = dev->data;
+	uint32_t delay_us = SPI_NOR_WAIT_MIN_DELAY_US;
+	uint8_t reg;
+	int ret;
+
+	if (k_is_pre_kernel() || !IS_ENABLED(CONFIG_MULTITHREADING)) {
+		return spi_nor_wait_until_ready(dev);
+	}
+
+	driver_data->erasing++;
+
+	while (true) {
+		ret = spi_nor_cmd_read(dev, SPI_NOR_CMD_RDSR, &reg, 1);
+		if ((ret != 0) || ((reg & SPI_NOR_WIP_BIT) == 0U)) {
+			break;
+		}
+
+		release_device(dev);
+		k_sleep(K_USEC(delay_us));
+		delay_us = MIN(2U * delay_us, SPI_NOR_WAIT_MAX_DELAY_US);
+		acquire_device(dev);
+	}
+
+	driver_data->erasing--;
+
+	return ret;
+}
+#endif /* CONFIG_SPI_NOR_ERASE_SUSPEND */
+
 static int spi_nor_read(struct device *dev, off_t addr, void *dest,
 			size_t size)
 {
@@ -458,9 +572,31 @@ static int spi_nor_read(struct device *dev, off_t addr, void *dest,
 
 	acquire_device(dev);
 
+#ifdef CONFIG_SPI_NOR_ERASE_SUSPEND
+	struct spi_nor_data *const driver_data = dev->data;
+	const bool suspend = (driver_data->erasing != 0U);
+
+	/* Suspending an erase takes tens of microseconds, completing it
+	 * up to seconds.  Data in the block being erased is undefined.
+	 */
+	if (suspend) {
+		spi_nor_cmd_write(dev, SPI_NOR_CMD_PES);
+	}
+#endif
+
 	spi_nor_wait_until_ready(dev);
 
+#ifdef CONFIG_SPI_NOR_FAST_READ
+	ret = read_fast(dev, addr, dest, size);
+#else
 	ret = spi_nor_cmd_addr_read(dev, SPI_NOR_CMD_READ, addr, dest, size);
+#endif
+
+#ifdef CONFIG_SPI_NOR_ERASE_SUSPEND
+	if (suspend) {
+		spi_nor_cmd_write(dev, SPI_NOR_CMD_PER);
+	}
+#endif
 
 	release_device(dev);
 	return ret;
@@ -480,6 +616,11 @@ static int spi_nor_write(struct device *dev, off_t addr, const void *src,
 
 	acquire_device(dev);
 
+	if (IS_ENABLED(CONFIG_SPI_NOR_ERASE_SUSPEND)) {
+		/* An erase may be in progress */
+		spi_nor_wait_until_ready(dev);
+	}
+
 	while (size > 0) {
 		size_t to_write = size;
 
@@ -535,13 +676,19 @@ static int spi_nor_erase(struct device *dev, off_t addr, size_t size)
 
 	acquire_device(dev);
 
+	if (IS_ENABLED(CONFIG_SPI_NOR_ERASE_SUSPEND)) {
+		/* Another erase may be in progress */
+		spi_nor_wait_until_ready(dev);
+	}
+
 	while ((size > 0) && (ret == 0)) {
 		spi_nor_cmd_write(dev, SPI_NOR_CMD_WREN);
 
 		if (size == flash_size) {
-			/* chip erase */
+			/* chip erase, which can't be suspended */
 			spi_nor_cmd_write(dev, SPI_NOR_CMD_CE);
 			size -= flash_size;
+			spi_nor_wait_until_ready(dev);
 		} else {
 			const struct jesd216_erase_type *erase_types =
 				dev_erase_types(dev);
@@ -551,9 +698,12 @@ static int spi_nor_erase(struct device *dev, off_t addr, size_t size)
 				const struct jesd216_erase_type *etp =
 					&erase_types[ei];
 
+				/* Largest erase that fits the rest of
+				 * the range.
+				 */
 				if ((etp->exp != 0)
 				    && SPI_NOR_IS_ALIGNED(addr, etp->exp)
-				    && SPI_NOR_IS_ALIGNED(size, etp->exp)
+				    && (size >= BIT(etp->exp))
 				    && ((bet == NULL)
 					|| (etp->exp > bet->exp))) {
 					bet = etp;
@@ -568,8 +718,12 @@ static int spi_nor_erase(struct device *dev, off_t addr, size_t size)
 					size, (long)addr);
 				ret = -EINVAL;
 			}
+#ifdef CONFIG_SPI_NOR_ERASE_SUSPEND
+			spi_nor_wait_erase_done(dev);
+#else
+			spi_nor_wait_until_ready(dev);
+#endif
 		}
-		spi_nor_wait_until_ready(dev);
 	}
 
 	release_device(dev);
@@ -29,6 +29,7 @@
 #include <device.h>
 #include <errno.h>
 #include <drivers/gpio.h>
+#include <drivers/gpio/gpio_bitbang.h>
 #include <drivers/i2c.h>
 
 #include <logging/log.h>
@@ -51,8 +52,8 @@ struct i2c_gpio_config {
 /* Driver instance data */
 struct i2c_gpio_context {
 	struct i2c_bitbang bitbang;	/* Bit-bang library data */
-	struct device *scl_gpio;	/* GPIO used for I2C SCL line */
-	struct device *sda_gpio;	/* GPIO used for I2C SDA line */
+	struct gpio_bitbang scl_gpio;	/* GPIO used for I2C SCL line */
+	struct gpio_bitbang sda_gpio;	/* GPIO used for I2C SDA line */
 	gpio_pin_t scl_pin;		/* Pin on gpio used for SCL line */
 	gpio_pin_t sda_pin;		/* Pin on gpio used for SDA line */
 };
@@ -61,23 +62,21 @@ static void i2c_gpio_set_scl(void *io_context, int state)
 {
 	struct i2c_gpio_context *context = io_context;
 
-	gpio_pin_set(context->scl_gpio, context->scl_pin, state);
+	gpio_bitbang_pin_set(&context->scl_gpio, context->scl_pin, state);
 }
 
 static void i2c_gpio_set_sda(void *io_context, int state)
 {
 	struct i2c_gpio_context *context = io_context;
 
-	gpio_pin_set(context->sda_gpio, context->sda_pin, state);
+	gpio_bitbang_pin_set(&context->sda_gpio, context->sda_pin, state);
 }
 
 static int i2c_gpio_get_sda(void *io_context)
 {
 	struct i2c_gpio_context *context = io_context;
-	int rc = gpio_pin_get(context->sda_gpio, context->sda_pin);
 
-	/* Default high as that would be a NACK */
-	return rc != 0;
+	return gpio_bitbang_pin_get(&context->sda_gpio, context->sda_pin);
 }
 
 static const struct i2c_bitbang_io io_fns = {
@@ -119,35 +118,41 @@ static int i2c_gpio_init(struct device *dev)
 {
 	struct i2c_gpio_context *context = dev->data;
 	const struct i2c_gpio_config *config = dev->config;
+	struct device *scl_gpio;
+	struct device *sda_gpio;
 	uint32_t bitrate_cfg;
 	int err;
 
-	context->scl_gpio = device_get_binding(config->scl_gpio_name);
-	if (!context->scl_gpio) {
+	scl_gpio = device_get_binding(config->scl_gpio_name);
+	if (!scl_gpio) {
 		LOG_ERR("failed to get SCL GPIO device");
 		return -EINVAL;
 	}
 
-	err = gpio_config(context->scl_gpio, config->scl_pin,
+	err = gpio_config(scl_gpio, config->scl_pin,
 			  config->scl_flags | GPIO_OUTPUT_HIGH);
 	if (err) {
 		LOG_ERR("failed to configure SCL GPIO pin (err %d)", err);
 		return err;
 	}
 
-	context->sda_gpio = device_get_binding(config->sda_gpio_name);
-	if (!context->sda_gpio) {
+	sda_gpio = device_get_binding(config->sda_gpio_name);
+	if (!sda_gpio) {
 		LOG_ERR("failed to get SCL GPIO device");
 		return -EINVAL;
 	}
 
-	err = gpio_config(context->sda_gpio, config->sda_pin,
+	err = gpio_config(sda_gpio, config->sda_pin,
 			  config->sda_flags | GPIO_OUTPUT_HIGH);
 	if (err) {
 		LOG_ERR("failed to configure SDA GPIO pin (err %d)", err);
 		return err;
 	}
 
+	/* After configuration, the active low flags are known */
+	gpio_bitbang_init(&context->scl_gpio, scl_gpio);
+	gpio_bitbang_init(&context->sda_gpio, sda_gpio);
+
 	context->sda_pin = config->sda_pin;
 	context->scl_pin = config->scl_pin;
 
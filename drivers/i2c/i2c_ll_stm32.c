@@ -53,23 +53,34 @@ int i2c_stm32_runtime_configure(struct device *dev, uint32_t config)
 	LL_I2C_Disable(i2c);
 	LL_I2C_SetMode(i2c, LL_I2C_MODE_I2C);
 	ret = stm32_i2c_configure_timing(dev, clock);
-	k_sem_give(&data->bus_mutex);
+	i2c_stm32_bus_unlock(dev);
 
 	return ret;
 }
 
+/* Release the bus, or hand it over to the next queued transfer. */
+void i2c_stm32_bus_unlock(struct device *dev)
+{
+	struct i2c_stm32_data *data = DEV_DATA(dev);
+
+#ifdef CONFIG_I2C_STM32_ASYNC
+	i2c_queue_unlock(dev, &data->queue, &data->bus_mutex,
+			 stm32_i2c_async_start);
+#else
+	k_sem_give(&data->bus_mutex);
+#endif
+}
+
 #define OPERATION(msg) (((struct i2c_msg *) msg)->flags & I2C_MSG_RW_MASK)
 
-static int i2c_stm32_transfer(struct device *dev, struct i2c_msg *msg,
-			      uint8_t num_msgs, uint16_t slave)
+/* Check for validity of all messages, to prevent having to abort
+ * in the middle of a transfer
+ */
+static int i2c_stm32_check_msgs(struct i2c_msg *msg, uint8_t num_msgs)
 {
-	struct i2c_stm32_data *data = DEV_DATA(dev);
 	struct i2c_msg *current, *next;
 	int ret = 0;
 
-	/* Check for validity of all messages, to prevent having to abort
-	 * in the middle of a transfer
-	 */
 	current = msg;
 
 	/*
@@ -107,6 +118,17 @@ static int i2c_stm32_transfer(struct device *dev, struct i2c_msg *msg,
 		current++;
 	}
 
+	return ret;
+}
+
+static int i2c_stm32_transfer(struct device *dev, struct i2c_msg *msg,
+			      uint8_t num_msgs, uint16_t slave)
+{
+	struct i2c_stm32_data *data = DEV_DATA(dev);
+	struct i2c_msg *current, *next;
+	int ret;
+
+	ret = i2c_stm32_check_msgs(msg, num_msgs);
 	if (ret) {
 		return ret;
 	}
@@ -161,9 +183,49 @@ static int i2c_stm32_transfer(struct device *dev, struct i2c_msg *msg,
 		num_msgs--;
 	}
 exit:
-	k_sem_give(&data->bus_mutex);
+	i2c_stm32_bus_unlock(dev);
+	return ret;
+}
+
+#ifdef CONFIG_I2C_STM32_ASYNC
+static int i2c_stm32_transfer_async(struct device *dev, struct i2c_msg *msg,
+				    uint8_t num_msgs, uint16_t slave,
+				    struct k_poll_signal *async)
+{
+	struct i2c_stm32_data *data = DEV_DATA(dev);
+	const struct i2c_queue_request req = {
+		.msgs = msg,
+		.num_msgs = num_msgs,
+		.addr = slave,
+		.signal = async,
+	};
+	int ret;
+
+	if (num_msgs == 0U) {
+		if (async) {
+			k_poll_signal_raise(async, 0);
+		}
+		return 0;
+	}
+
+	ret = i2c_stm32_check_msgs(msg, num_msgs);
+	if (ret) {
+		return ret;
+	}
+
+	ret = i2c_queue_lock_or_add(&data->queue, &data->bus_mutex, &req);
+	if (ret > 0) {
+		return 0;
+	}
+
+	ret = stm32_i2c_async_start(dev, &req);
+	if (ret) {
+		i2c_stm32_bus_unlock(dev);
+	}
+
 	return ret;
 }
+#endif /* CONFIG_I2C_STM32_ASYNC */
 
 static const struct i2c_driver_api api_funcs = {
 	.configure = i2c_stm32_runtime_configure,
@@ -172,6 +234,9 @@ static const struct i2c_driver_api api_funcs = {
 	.slave_register = i2c_stm32_slave_register,
 	.slave_unregister = i2c_stm32_slave_unregister,
 #endif
+#ifdef CONFIG_I2C_STM32_ASYNC
+	.transfer_async = i2c_stm32_transfer_async,
+#endif
 };
 
 static int i2c_stm32_init(struct device *dev)
@@ -9,6 +9,10 @@
 #ifndef ZEPHYR_DRIVERS_I2C_I2C_LL_STM32_H_
 #define ZEPHYR_DRIVERS_I2C_I2C_LL_STM32_H_
 
+#ifdef CONFIG_I2C_STM32_ASYNC
+#include "i2c_queue.h"
+#endif
+
 typedef void (*irq_config_func_t)(struct device *port);
 
 struct i2c_stm32_config {
@@ -42,6 +46,20 @@ struct i2c_stm32_data {
 		unsigned int len;
 		uint8_t *buf;
 	} current;
+#ifdef CONFIG_I2C_STM32_ASYNC
+	struct i2c_queue queue;
+	struct {
+		struct k_poll_signal *signal;
+		struct i2c_msg *msgs;
+		/* Part of msgs[idx] being transferred */
+		struct i2c_msg chunk;
+		uint32_t offset;
+		uint16_t slave;
+		uint8_t num_msgs;
+		uint8_t idx;
+		bool active;
+	} async;
+#endif
 #ifdef CONFIG_I2C_SLAVE
 	bool master_active;
 	struct i2c_slave_config *slave_cfg;
@@ -55,6 +73,11 @@ int32_t stm32_i2c_msg_read(struct device *dev, struct i2c_msg *msg, uint8_t *flg
 			 uint16_t sadr);
 int32_t stm32_i2c_configure_timing(struct device *dev, uint32_t clk);
 int i2c_stm32_runtime_configure(struct device *dev, uint32_t config);
+void i2c_stm32_bus_unlock(struct device *dev);
+#ifdef CONFIG_I2C_STM32_ASYNC
+int stm32_i2c_async_start(struct device *dev,
+			  const struct i2c_queue_request *req);
+#endif
 
 void stm32_i2c_event_isr(void *arg);
 void stm32_i2c_error_isr(void *arg);
@@ -89,6 +89,28 @@ static void stm32_i2c_enable_transfer_interrupts(struct device *dev)
 	LL_I2C_EnableIT_ERR(i2c);
 }
 
+#ifdef CONFIG_I2C_STM32_ASYNC
+static void stm32_i2c_async_continue(struct device *dev, bool stopped);
+#endif
+
+/* Hand the end of a message over to its waiter, or to the asynchronous
+ * transfer it belongs to. stopped is set once the bus is released.
+ */
+static void stm32_i2c_msg_end(struct device *dev, bool stopped)
+{
+	struct i2c_stm32_data *data = DEV_DATA(dev);
+
+#ifdef CONFIG_I2C_STM32_ASYNC
+	if (data->async.active) {
+		stm32_i2c_async_continue(dev, stopped);
+		return;
+	}
+#else
+	ARG_UNUSED(stopped);
+#endif
+	k_sem_give(&data->device_sync_sem);
+}
+
 static void stm32_i2c_master_mode_end(struct device *dev)
 {
 	const struct i2c_stm32_config *cfg = DEV_CFG(dev);
@@ -105,7 +127,7 @@ static void stm32_i2c_master_mode_end(struct device *dev)
 #else
 	LL_I2C_Disable(i2c);
 #endif
-	k_sem_give(&data->device_sync_sem);
+	stm32_i2c_msg_end(dev, true);
 }
 
 #if defined(CONFIG_I2C_SLAVE)
@@ -309,7 +331,7 @@ static void stm32_i2c_event(struct device *dev)
 			LL_I2C_GenerateStopCondition(i2c);
 		} else {
 			stm32_i2c_disable_transfer_interrupts(dev);
-			k_sem_give(&data->device_sync_sem);
+			stm32_i2c_msg_end(dev, false);
 		}
 	}
 
@@ -376,8 +398,9 @@ void stm32_i2c_error_isr(void *arg)
 }
 #endif
 
-int stm32_i2c_msg_write(struct device *dev, struct i2c_msg *msg,
-			uint8_t *next_msg_flags, uint16_t slave)
+static void stm32_i2c_msg_start(struct device *dev, struct i2c_msg *msg,
+				uint8_t *next_msg_flags, uint16_t slave,
+				uint32_t transfer)
 {
 	const struct i2c_stm32_config *cfg = DEV_CFG(dev);
 	struct i2c_stm32_data *data = DEV_DATA(dev);
@@ -385,38 +408,44 @@ int stm32_i2c_msg_write(struct device *dev, struct i2c_msg *msg,
 
 	data->current.len = msg->len;
 	data->current.buf = msg->buf;
-	data->current.is_write = 1U;
-	data->current.is_nack = 0U;
+	data->current.is_write = (transfer == LL_I2C_REQUEST_WRITE);
+	data->current.is_arlo = 0U;
 	data->current.is_err = 0U;
+	data->current.is_nack = 0U;
 	data->current.msg = msg;
 
-	msg_init(dev, msg, next_msg_flags, slave, LL_I2C_REQUEST_WRITE);
+	msg_init(dev, msg, next_msg_flags, slave, transfer);
 
 	stm32_i2c_enable_transfer_interrupts(dev);
-	LL_I2C_EnableIT_TX(i2c);
+	if (transfer == LL_I2C_REQUEST_WRITE) {
+		LL_I2C_EnableIT_TX(i2c);
+	} else {
+		LL_I2C_EnableIT_RX(i2c);
+	}
+}
 
-	k_sem_take(&data->device_sync_sem, K_FOREVER);
+static int stm32_i2c_msg_status(struct device *dev, const char *funcname)
+{
+	struct i2c_stm32_data *data = DEV_DATA(dev);
 
-	if (data->current.is_nack || data->current.is_err ||
-	    data->current.is_arlo) {
-		goto error;
+	if (!data->current.is_nack && !data->current.is_err &&
+	    !data->current.is_arlo) {
+		return 0;
 	}
 
-	return 0;
-error:
 	if (data->current.is_arlo) {
-		LOG_DBG("%s: ARLO %d", __func__,
+		LOG_DBG("%s: ARLO %d", funcname,
 				    data->current.is_arlo);
 		data->current.is_arlo = 0U;
 	}
 
 	if (data->current.is_nack) {
-		LOG_DBG("%s: NACK", __func__);
+		LOG_DBG("%s: NACK", funcname);
 		data->current.is_nack = 0U;
 	}
 
 	if (data->current.is_err) {
-		LOG_DBG("%s: ERR %d", __func__,
+		LOG_DBG("%s: ERR %d", funcname,
 				    data->current.is_err);
 		data->current.is_err = 0U;
 	}
@@ -424,54 +453,118 @@ error:
 	return -EIO;
 }
 
+int stm32_i2c_msg_write(struct device *dev, struct i2c_msg *msg,
+			uint8_t *next_msg_flags, uint16_t slave)
+{
+	struct i2c_stm32_data *data = DEV_DATA(dev);
+
+	stm32_i2c_msg_start(dev, msg, next_msg_flags, slave,
+			    LL_I2C_REQUEST_WRITE);
+
+	k_sem_take(&data->device_sync_sem, K_FOREVER);
+
+	return stm32_i2c_msg_status(dev, __func__);
+}
+
 int stm32_i2c_msg_read(struct device *dev, struct i2c_msg *msg,
 		       uint8_t *next_msg_flags, uint16_t slave)
 {
-	const struct i2c_stm32_config *cfg = DEV_CFG(dev);
 	struct i2c_stm32_data *data = DEV_DATA(dev);
-	I2C_TypeDef *i2c = cfg->i2c;
 
-	data->current.len = msg->len;
-	data->current.buf = msg->buf;
-	data->current.is_write = 0U;
-	data->current.is_arlo = 0U;
-	data->current.is_err = 0U;
-	data->current.is_nack = 0U;
-	data->current.msg = msg;
+	stm32_i2c_msg_start(dev, msg, next_msg_flags, slave,
+			    LL_I2C_REQUEST_READ);
 
-	msg_init(dev, msg, next_msg_flags, slave, LL_I2C_REQUEST_READ);
+	k_sem_take(&data->device_sync_sem, K_FOREVER);
 
-	stm32_i2c_enable_transfer_interrupts(dev);
-	LL_I2C_EnableIT_RX(i2c);
+	return stm32_i2c_msg_status(dev, __func__);
+}
 
-	k_sem_take(&data->device_sync_sem, K_FOREVER);
+#ifdef CONFIG_I2C_STM32_ASYNC
+/*
+ * Start the next part of the current message of an asynchronous transfer.
+ * The peripheral transfers at most 255 bytes at once, the rest of a longer
+ * message follows in reload mode as i2c_stm32_transfer() does it.
+ */
+static void stm32_i2c_async_chunk(struct device *dev)
+{
+	struct i2c_stm32_data *data = DEV_DATA(dev);
+	struct i2c_msg *msg = &data->async.msgs[data->async.idx];
+	struct i2c_msg *chunk = &data->async.chunk;
+	uint32_t left = msg->len - data->async.offset;
+	uint8_t *next_msg_flags = NULL;
+	uint8_t next_flags;
+	uint32_t transfer;
 
-	if (data->current.is_nack || data->current.is_err ||
-	    data->current.is_arlo) {
-		goto error;
+	chunk->buf = msg->buf + data->async.offset;
+	chunk->len = MIN(left, 255U);
+	chunk->flags = msg->flags;
+
+	if (chunk->len < left) {
+		chunk->flags &= ~I2C_MSG_STOP;
+		next_flags = msg->flags & ~I2C_MSG_RESTART;
+		next_msg_flags = &next_flags;
+	} else if (data->async.idx + 1U < data->async.num_msgs) {
+		next_msg_flags = &data->async.msgs[data->async.idx + 1U].flags;
 	}
 
-	return 0;
-error:
-	if (data->current.is_arlo) {
-		LOG_DBG("%s: ARLO %d", __func__,
-				    data->current.is_arlo);
-		data->current.is_arlo = 0U;
+	data->async.offset += chunk->len;
+
+	if ((chunk->flags & I2C_MSG_RW_MASK) == I2C_MSG_WRITE) {
+		transfer = LL_I2C_REQUEST_WRITE;
+	} else {
+		transfer = LL_I2C_REQUEST_READ;
 	}
 
-	if (data->current.is_nack) {
-		LOG_DBG("%s: NACK", __func__);
-		data->current.is_nack = 0U;
+	stm32_i2c_msg_start(dev, chunk, next_msg_flags, data->async.slave,
+			    transfer);
+}
+
+/* Called from the ISR at the end of each part of a message. */
+static void stm32_i2c_async_continue(struct device *dev, bool stopped)
+{
+	struct i2c_stm32_data *data = DEV_DATA(dev);
+	struct i2c_msg *msg = &data->async.msgs[data->async.idx];
+	int ret = stm32_i2c_msg_status(dev, __func__);
+
+	if ((ret == 0) && !stopped) {
+		if (data->async.offset >= msg->len) {
+			data->async.idx++;
+			data->async.offset = 0U;
+		}
+
+		if (data->async.idx < data->async.num_msgs) {
+			stm32_i2c_async_chunk(dev);
+			return;
+		}
 	}
 
-	if (data->current.is_err) {
-		LOG_DBG("%s: ERR %d", __func__,
-				    data->current.is_err);
-		data->current.is_err = 0U;
+	data->async.active = false;
+
+	if (data->async.signal) {
+		k_poll_signal_raise(data->async.signal, ret);
 	}
 
-	return -EIO;
+	i2c_stm32_bus_unlock(dev);
+}
+
+int stm32_i2c_async_start(struct device *dev,
+			  const struct i2c_queue_request *req)
+{
+	struct i2c_stm32_data *data = DEV_DATA(dev);
+
+	data->async.signal = req->signal;
+	data->async.msgs = req->msgs;
+	data->async.num_msgs = req->num_msgs;
+	data->async.slave = req->addr;
+	data->async.idx = 0U;
+	data->async.offset = 0U;
+	data->async.active = true;
+
+	stm32_i2c_async_chunk(dev);
+
+	return 0;
 }
+#endif /* CONFIG_I2C_STM32_ASYNC */
 
 #else /* !CONFIG_I2C_STM32_INTERRUPT */
 static inline int check_errors(struct device *dev, const char *funcname)
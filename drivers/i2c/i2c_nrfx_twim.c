@@ -10,6 +10,10 @@
 #include <nrfx_twim.h>
 #include <sys/util.h>
 
+#ifdef CONFIG_I2C_ASYNC
+#include "i2c_queue.h"
+#endif
+
 #include <logging/log.h>
 LOG_MODULE_REGISTER(i2c_nrfx_twim, CONFIG_I2C_LOG_LEVEL);
 
@@ -22,6 +26,15 @@ struct i2c_nrfx_twim_data {
 	uint32_t dev_config;
 	uint16_t concat_buf_size;
 	uint8_t *concat_buf;
+#ifdef CONFIG_I2C_ASYNC
+	struct i2c_queue queue;
+	struct k_poll_signal *signal;
+	struct i2c_msg *msgs;
+	nrfx_twim_xfer_desc_t xfer;
+	uint8_t num_msgs;
+	uint8_t msg_idx;
+	bool asynchronous;
+#endif
 #ifdef CONFIG_DEVICE_POWER_MANAGEMENT
 	uint32_t pm_state;
 #endif
@@ -43,28 +56,23 @@ const struct i2c_nrfx_twim_config *get_dev_config(struct device *dev)
 	return dev->config;
 }
 
-static int i2c_nrfx_twim_transfer(struct device *dev, struct i2c_msg *msgs,
-				  uint8_t num_msgs, uint16_t addr)
+/*
+ * Set up the transfer of msgs[*idx], concatenated with the following
+ * messages when possible. On return *idx is the index of the last message
+ * of the transfer. Returns the nrfx transfer flags or a negative errno code.
+ */
+static int twim_xfer_prepare(struct device *dev, struct i2c_msg *msgs,
+			     uint8_t num_msgs, size_t *idx,
+			     nrfx_twim_xfer_desc_t *xfer)
 {
-	int ret = 0;
 	uint32_t concat_len = 0;
 	uint8_t *concat_buf = get_dev_data(dev)->concat_buf;
 	uint16_t concat_buf_size = get_dev_data(dev)->concat_buf_size;
-	nrfx_twim_xfer_desc_t cur_xfer = {
-		.address = addr
-	};
-
-	k_sem_take(&(get_dev_data(dev)->transfer_sync), K_FOREVER);
-
-	/* Dummy take on completion_sync sem to be sure that it is empty */
-	k_sem_take(&(get_dev_data(dev)->completion_sync), K_NO_WAIT);
-
-	nrfx_twim_enable(&get_dev_config(dev)->twim);
+	size_t i;
 
-	for (size_t i = 0; i < num_msgs; i++) {
+	for (i = *idx; i < num_msgs; i++) {
 		if (I2C_MSG_ADDR_10_BITS & msgs[i].flags) {
-			ret = -ENOTSUP;
-			break;
+			return -ENOTSUP;
 		}
 
 		bool last_or_non_concatenable =
@@ -75,7 +83,7 @@ static int i2c_nrfx_twim_transfer(struct device *dev, struct i2c_msg *msgs,
 			     != (msgs[i].flags & I2C_MSG_READ)));
 
 		if ((concat_len != 0) || !last_or_non_concatenable) {
-			if (msgs[i].len > concat_buf_size) {
+			if (concat_len + msgs[i].len > concat_buf_size) {
 				LOG_ERR("Concatenation buffer is too small");
 				return -ENOSPC;
 			}
@@ -88,34 +96,111 @@ static int i2c_nrfx_twim_transfer(struct device *dev, struct i2c_msg *msgs,
 		}
 
 		if (last_or_non_concatenable) {
-			if (concat_len == 0) {
-				cur_xfer.p_primary_buf = msgs[i].buf;
-				cur_xfer.primary_length = msgs[i].len;
-			} else {
-				cur_xfer.p_primary_buf = concat_buf;
-				cur_xfer.primary_length = concat_len;
-			}
-			cur_xfer.type = (msgs[i].flags & I2C_MSG_READ) ?
-					 NRFX_TWIM_XFER_RX : NRFX_TWIM_XFER_TX;
-		} else {
-			continue;
+			break;
 		}
+	}
 
-		nrfx_err_t res = nrfx_twim_xfer(&get_dev_config(dev)->twim,
-						&cur_xfer,
-						(msgs[i].flags & I2C_MSG_STOP) ?
-						 0 : NRFX_TWIM_FLAG_TX_NO_STOP);
-		if (res != NRFX_SUCCESS) {
-			if (res == NRFX_ERROR_BUSY) {
-				ret = -EBUSY;
-				break;
-			} else {
-				ret = -EIO;
-				break;
-			}
+	if (concat_len == 0) {
+		xfer->p_primary_buf = msgs[i].buf;
+		xfer->primary_length = msgs[i].len;
+	} else {
+		xfer->p_primary_buf = concat_buf;
+		xfer->primary_length = concat_len;
+	}
+	xfer->type = (msgs[i].flags & I2C_MSG_READ) ?
+		     NRFX_TWIM_XFER_RX : NRFX_TWIM_XFER_TX;
+
+	*idx = i;
+
+	return (msgs[i].flags & I2C_MSG_STOP) ? 0 : NRFX_TWIM_FLAG_TX_NO_STOP;
+}
+
+/* If concatenated messages were I2C_MSG_READ type, then content of
+ * concatenation buffer has to be copied back into buffers provided by user.
+ * last is the last message of the transfer.
+ */
+static void twim_xfer_finish(struct device *dev, struct i2c_msg *last,
+			     const nrfx_twim_xfer_desc_t *xfer)
+{
+	uint8_t *concat_buf = get_dev_data(dev)->concat_buf;
+	uint32_t concat_len = xfer->primary_length;
+
+	if (!(last->flags & I2C_MSG_READ)
+	    || xfer->p_primary_buf != concat_buf) {
+		return;
+	}
+
+	while (concat_len > 0) {
+		concat_len -= last->len;
+		memcpy(last->buf, concat_buf + concat_len, last->len);
+		last--;
+	}
+}
+
+static int twim_xfer_start(struct device *dev, nrfx_twim_xfer_desc_t *xfer,
+			   uint32_t flags)
+{
+	nrfx_err_t res = nrfx_twim_xfer(&get_dev_config(dev)->twim, xfer,
+					flags);
+
+	if (res != NRFX_SUCCESS) {
+		return (res == NRFX_ERROR_BUSY) ? -EBUSY : -EIO;
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_I2C_ASYNC
+static int twim_async_start(struct device *dev,
+			    const struct i2c_queue_request *req);
+#endif
+
+static void twim_unlock(struct device *dev)
+{
+	struct i2c_nrfx_twim_data *dev_data = get_dev_data(dev);
+
+#ifdef CONFIG_I2C_ASYNC
+	i2c_queue_unlock(dev, &dev_data->queue, &dev_data->transfer_sync,
+			 twim_async_start);
+#else
+	k_sem_give(&dev_data->transfer_sync);
+#endif
+}
+
+static int i2c_nrfx_twim_transfer(struct device *dev, struct i2c_msg *msgs,
+				  uint8_t num_msgs, uint16_t addr)
+{
+	struct i2c_nrfx_twim_data *dev_data = get_dev_data(dev);
+	int ret = 0;
+	int flags;
+	nrfx_twim_xfer_desc_t cur_xfer = {
+		.address = addr
+	};
+
+	k_sem_take(&dev_data->transfer_sync, K_FOREVER);
+
+#ifdef CONFIG_I2C_ASYNC
+	dev_data->asynchronous = false;
+#endif
+
+	/* Dummy take on completion_sync sem to be sure that it is empty */
+	k_sem_take(&dev_data->completion_sync, K_NO_WAIT);
+
+	nrfx_twim_enable(&get_dev_config(dev)->twim);
+
+	for (size_t i = 0; i < num_msgs; i++) {
+		flags = twim_xfer_prepare(dev, msgs, num_msgs, &i, &cur_xfer);
+		if (flags < 0) {
+			ret = flags;
+			break;
 		}
 
-		ret = k_sem_take(&(get_dev_data(dev)->completion_sync),
+		ret = twim_xfer_start(dev, &cur_xfer, flags);
+		if (ret != 0) {
+			break;
+		}
+
+		ret = k_sem_take(&dev_data->completion_sync,
 				 I2C_TRANSFER_TIMEOUT_MSEC);
 		if (ret != 0) {
 			/* Whatever the frequency, completion_sync should have
@@ -133,39 +218,131 @@ static int i2c_nrfx_twim_transfer(struct device *dev, struct i2c_msg *msgs,
 			break;
 		}
 
-		res = get_dev_data(dev)->res;
-
-		if (res != NRFX_SUCCESS) {
-			LOG_ERR("Error %d occurred for message %d", res, i);
+		if (dev_data->res != NRFX_SUCCESS) {
+			LOG_ERR("Error %d occurred for message %d",
+				dev_data->res, i);
 			ret = -EIO;
 			break;
 		}
 
-		/* If concatenated messages were I2C_MSG_READ type, then
-		 * content of concatenation buffer has to be copied back into
-		 * buffers provided by user. */
-		if ((msgs[i].flags & I2C_MSG_READ)
-		    && cur_xfer.p_primary_buf == concat_buf) {
-			int j = i;
-
-			while (concat_len >= msgs[j].len) {
-				concat_len -= msgs[j].len;
-				memcpy(msgs[j].buf,
-				       concat_buf + concat_len,
-				       msgs[j].len);
-				j--;
+		twim_xfer_finish(dev, &msgs[i], &cur_xfer);
+	}
+
+	nrfx_twim_disable(&get_dev_config(dev)->twim);
+	twim_unlock(dev);
+
+	return ret;
+}
+
+#ifdef CONFIG_I2C_ASYNC
+/* Start the transfer of the current message of an asynchronous transfer. */
+static int twim_async_next(struct device *dev)
+{
+	struct i2c_nrfx_twim_data *dev_data = get_dev_data(dev);
+	size_t i = dev_data->msg_idx;
+	int flags;
+
+	flags = twim_xfer_prepare(dev, dev_data->msgs, dev_data->num_msgs,
+				  &i, &dev_data->xfer);
+	if (flags < 0) {
+		return flags;
+	}
+
+	dev_data->msg_idx = i;
+
+	return twim_xfer_start(dev, &dev_data->xfer, flags);
+}
+
+static int twim_async_start(struct device *dev,
+			    const struct i2c_queue_request *req)
+{
+	struct i2c_nrfx_twim_data *dev_data = get_dev_data(dev);
+	int ret;
+
+	dev_data->asynchronous = true;
+	dev_data->signal = req->signal;
+	dev_data->msgs = req->msgs;
+	dev_data->num_msgs = req->num_msgs;
+	dev_data->msg_idx = 0U;
+	dev_data->xfer.address = req->addr;
+
+	nrfx_twim_enable(&get_dev_config(dev)->twim);
+
+	ret = twim_async_next(dev);
+	if (ret != 0) {
+		nrfx_twim_disable(&get_dev_config(dev)->twim);
+	}
+
+	return ret;
+}
+
+/* Called from the event handler at the end of each nrfx transfer. */
+static void twim_async_done(struct device *dev)
+{
+	struct i2c_nrfx_twim_data *dev_data = get_dev_data(dev);
+	int ret = 0;
+
+	if (dev_data->res != NRFX_SUCCESS) {
+		LOG_ERR("Error %d occurred for message %d",
+			dev_data->res, dev_data->msg_idx);
+		ret = -EIO;
+	} else {
+		twim_xfer_finish(dev, &dev_data->msgs[dev_data->msg_idx],
+				 &dev_data->xfer);
+
+		dev_data->msg_idx++;
+		if (dev_data->msg_idx < dev_data->num_msgs) {
+			ret = twim_async_next(dev);
+			if (ret == 0) {
+				return;
 			}
+		}
+	}
+
+	nrfx_twim_disable(&get_dev_config(dev)->twim);
 
+	if (dev_data->signal) {
+		k_poll_signal_raise(dev_data->signal, ret);
+	}
+
+	twim_unlock(dev);
+}
+
+static int i2c_nrfx_twim_transfer_async(struct device *dev,
+					struct i2c_msg *msgs,
+					uint8_t num_msgs, uint16_t addr,
+					struct k_poll_signal *async)
+{
+	struct i2c_nrfx_twim_data *dev_data = get_dev_data(dev);
+	const struct i2c_queue_request req = {
+		.msgs = msgs,
+		.num_msgs = num_msgs,
+		.addr = addr,
+		.signal = async,
+	};
+	int ret;
+
+	if (num_msgs == 0U) {
+		if (async) {
+			k_poll_signal_raise(async, 0);
 		}
+		return 0;
+	}
 
-		concat_len = 0;
+	ret = i2c_queue_lock_or_add(&dev_data->queue,
+				    &dev_data->transfer_sync, &req);
+	if (ret > 0) {
+		return 0;
 	}
 
-	nrfx_twim_disable(&get_dev_config(dev)->twim);
-	k_sem_give(&(get_dev_data(dev)->transfer_sync));
+	ret = twim_async_start(dev, &req);
+	if (ret != 0) {
+		twim_unlock(dev);
+	}
 
 	return ret;
 }
+#endif /* CONFIG_I2C_ASYNC */
 
 static void event_handler(nrfx_twim_evt_t const *p_event, void *p_context)
 {
@@ -187,6 +364,13 @@ static void event_handler(nrfx_twim_evt_t const *p_event, void *p_context)
 		break;
 	}
 
+#ifdef CONFIG_I2C_ASYNC
+	if (dev_data->asynchronous) {
+		twim_async_done(dev);
+		return;
+	}
+#endif
+
 	k_sem_give(&dev_data->completion_sync);
 }
 
@@ -217,6 +401,9 @@ static int i2c_nrfx_twim_configure(struct device *dev, uint32_t dev_config)
 static const struct i2c_driver_api i2c_nrfx_twim_driver_api = {
 	.configure = i2c_nrfx_twim_configure,
 	.transfer  = i2c_nrfx_twim_transfer,
+#ifdef CONFIG_I2C_ASYNC
+	.transfer_async = i2c_nrfx_twim_transfer_async,
+#endif
 };
 
 static int init_twim(struct device *dev)
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Queue of the asynchronous transfers waiting for an I2C bus.
+ *
+ * The driver owns the bus while its lock semaphore is taken. An
+ * asynchronous transfer submitted while the bus is busy is queued, and
+ * i2c_queue_unlock() hands the bus over to the next queued transfer
+ * instead of releasing it, possibly from the interrupt completing the
+ * previous transfer.
+ */
+
+#ifndef ZEPHYR_DRIVERS_I2C_I2C_QUEUE_H_
+#define ZEPHYR_DRIVERS_I2C_I2C_QUEUE_H_
+
+#include <kernel.h>
+#include <drivers/i2c.h>
+
+struct i2c_queue_request {
+	struct i2c_msg *msgs;
+	uint8_t num_msgs;
+	uint16_t addr;
+	struct k_poll_signal *signal;
+};
+
+/*
+ * Start a transfer on the locked bus. Returns 0 once started, the driver
+ * then raises the signal and calls i2c_queue_unlock() at its end.
+ */
+typedef int (*i2c_queue_start_t)(struct device *dev,
+				 const struct i2c_queue_request *req);
+
+struct i2c_queue {
+	struct i2c_queue_request req[CONFIG_I2C_ASYNC_QUEUE_SIZE];
+	uint8_t head;
+	uint8_t len;
+};
+
+/*
+ * Lock the bus for an asynchronous transfer or, if it is busy, queue the
+ * transfer. Returns 0 if the caller got the lock and starts the transfer
+ * itself, 1 if the transfer is queued. Waits for the bus when the queue
+ * is full.
+ */
+static inline int i2c_queue_lock_or_add(struct i2c_queue *queue,
+					struct k_sem *lock,
+					const struct i2c_queue_request *req)
+{
+	unsigned int key;
+
+	key = irq_lock();
+
+	if (k_sem_take(lock, K_NO_WAIT) == 0) {
+		irq_unlock(key);
+		return 0;
+	}
+
+	if (queue->len < ARRAY_SIZE(queue->req)) {
+		queue->req[(queue->head + queue->len) %
+			   ARRAY_SIZE(queue->req)] = *req;
+		queue->len++;
+		irq_unlock(key);
+		return 1;
+	}
+
+	irq_unlock(key);
+
+	k_sem_take(lock, K_FOREVER);
+
+	return 0;
+}
+
+/* Hand the locked bus over to the next queued transfer, if any. */
+static inline void i2c_queue_unlock(struct device *dev,
+				    struct i2c_queue *queue,
+				    struct k_sem *lock,
+				    i2c_queue_start_t start)
+{
+	struct i2c_queue_request req;
+	unsigned int key;
+	int ret;
+
+	for (;;) {
+		key = irq_lock();
+		if (queue->len == 0U) {
+			break;
+		}
+
+		req = queue->req[queue->head];
+		queue->head = (queue->head + 1U) % ARRAY_SIZE(queue->req);
+		queue->len--;
+		irq_unlock(key);
+
+		ret = start(dev, &req);
+		if (ret == 0) {
+			return;
+		}
+
+		if (req.signal) {
+			k_poll_signal_raise(req.signal, ret);
+		}
+	}
+
+	/* Under the lock so that no transfer gets queued meanwhile */
+	k_sem_give(lock);
+	irq_unlock(key);
+}
+
+#endif /* ZEPHYR_DRIVERS_I2C_I2C_QUEUE_H_ */
@@ -91,6 +91,16 @@ static int queue_put(struct ring_buf *rb, void *mem_block, size_t size)
 	return 0;
 }
 
+static uint16_t queue_len(struct ring_buf *rb)
+{
+	return (rb->head + rb->len - rb->tail) % rb->len;
+}
+
+static bool is_pingpong(struct stream *stream)
+{
+	return (stream->cfg.options & I2S_OPT_PINGPONG) != 0U;
+}
+
 static int i2s_stm32_enable_clock(struct device *dev)
 {
 	const struct i2s_stm32_cfg *cfg = DEV_CFG(dev);
@@ -207,6 +217,12 @@ static int i2s_stm32_configure(struct device *dev, enum i2s_dir dir,
 		stream->master = false;
 	}
 
+	if ((i2s_cfg->options & I2S_OPT_PINGPONG) &&
+	    (dir == I2S_DIR_RX) && (CONFIG_I2S_STM32_RX_BLOCK_COUNT < 2)) {
+		LOG_ERR("ping pong mode needs at least 2 RX blocks");
+		return -EINVAL;
+	}
+
 	if (i2s_cfg->frame_clk_freq == 0U) {
 		stream->queue_drop(stream);
 		memset(&stream->cfg, 0, sizeof(struct i2s_config));
@@ -410,6 +426,13 @@ static int i2s_stm32_write(struct device *dev, void *mem_block, size_t size)
 		return -EIO;
 	}
 
+	/* A running ring is refilled in place */
+	if (is_pingpong(&dev_data->tx) &&
+	    dev_data->tx.state == I2S_STATE_RUNNING) {
+		LOG_DBG("invalid state");
+		return -EIO;
+	}
+
 	ret = k_sem_take(&dev_data->tx.sem,
 			 SYS_TIMEOUT_MS(dev_data->tx.cfg.timeout));
 	if (ret < 0) {
@@ -422,11 +445,99 @@ static int i2s_stm32_write(struct device *dev, void *mem_block, size_t size)
 	return 0;
 }
 
+static int i2s_stm32_ring_next(struct device *dev, enum i2s_dir dir,
+			       void **mem_block)
+{
+	struct i2s_stm32_data *const dev_data = DEV_DATA(dev);
+	struct stream *stream;
+	int ret;
+
+	if (dir == I2S_DIR_RX) {
+		stream = &dev_data->rx;
+	} else if (dir == I2S_DIR_TX) {
+		stream = &dev_data->tx;
+	} else {
+		LOG_ERR("Either RX or TX direction must be selected");
+		return -EINVAL;
+	}
+
+	if (!is_pingpong(stream)) {
+		return -EINVAL;
+	}
+
+	if (stream->state != I2S_STATE_RUNNING) {
+		LOG_DBG("invalid state");
+		return -EIO;
+	}
+
+	ret = k_sem_take(&stream->ring_sem,
+			 SYS_TIMEOUT_MS(stream->cfg.timeout));
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* The ring is released on errors */
+	if (stream->state != I2S_STATE_RUNNING) {
+		return -EIO;
+	}
+
+	*mem_block = stream->ring[stream->ring_app];
+	MODULO_INC(stream->ring_app, stream->ring_len);
+
+	return 0;
+}
+
+static int i2s_stm32_position_get(struct device *dev, enum i2s_dir dir,
+				  void **mem_block, size_t *offset)
+{
+	struct i2s_stm32_data *const dev_data = DEV_DATA(dev);
+	struct device *dev_dma;
+	struct dma_status stat;
+	struct stream *stream;
+	unsigned int key;
+	int ret;
+
+	if (dir == I2S_DIR_RX) {
+		stream = &dev_data->rx;
+		dev_dma = dev_data->dev_dma_rx;
+	} else if (dir == I2S_DIR_TX) {
+		stream = &dev_data->tx;
+		dev_dma = dev_data->dev_dma_tx;
+	} else {
+		LOG_ERR("Either RX or TX direction must be selected");
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+
+	if (stream->state != I2S_STATE_RUNNING &&
+	    stream->state != I2S_STATE_STOPPING) {
+		irq_unlock(key);
+		return -EIO;
+	}
+
+	ret = dma_get_status(dev_dma, stream->dma_channel, &stat);
+	if (ret == 0) {
+		*mem_block = is_pingpong(stream) ?
+			     stream->ring[stream->ring_dma] :
+			     stream->mem_block;
+		/* Both sides of the transfer use 16 bit data items */
+		*offset = stream->cfg.block_size -
+			  stat.pending_length * stream->dma_cfg.dest_data_size;
+	}
+
+	irq_unlock(key);
+
+	return ret;
+}
+
 static const struct i2s_driver_api i2s_stm32_driver_api = {
 	.configure = i2s_stm32_configure,
 	.read = i2s_stm32_read,
 	.write = i2s_stm32_write,
 	.trigger = i2s_stm32_trigger,
+	.ring_next = i2s_stm32_ring_next,
+	.position_get = i2s_stm32_position_get,
 };
 
 #define STM32_DMA_NUM_CHANNELS		8
@@ -486,6 +597,93 @@ static int start_dma(struct device *dev_dma, uint32_t channel,
 	return ret;
 }
 
+/*
+ * Chain the blocks of the ping pong ring into a cyclic DMA transfer, which
+ * reports the end of each block. A ring of two blocks runs in the double
+ * buffer mode of the DMA, longer ones are chained by its irq handler.
+ */
+static int start_dma_ring(struct device *dev_dma, struct stream *stream,
+			  void *periph, bool to_periph)
+{
+	struct dma_config dcfg = stream->dma_cfg;
+	struct dma_block_config *blk;
+	int ret;
+
+	for (int i = 0; i < stream->ring_len; i++) {
+		blk = &stream->ring_blk[i];
+		memset(blk, 0, sizeof(*blk));
+		blk->block_size = stream->cfg.block_size;
+		if (to_periph) {
+			blk->source_address = (uint32_t)stream->ring[i];
+			blk->dest_address = (uint32_t)periph;
+		} else {
+			blk->source_address = (uint32_t)periph;
+			blk->dest_address = (uint32_t)stream->ring[i];
+		}
+		if (stream->src_addr_increment) {
+			blk->source_addr_adj = DMA_ADDR_ADJ_INCREMENT;
+		} else {
+			blk->source_addr_adj = DMA_ADDR_ADJ_NO_CHANGE;
+		}
+		if (stream->dst_addr_increment) {
+			blk->dest_addr_adj = DMA_ADDR_ADJ_INCREMENT;
+		} else {
+			blk->dest_addr_adj = DMA_ADDR_ADJ_NO_CHANGE;
+		}
+		blk->fifo_mode_control = stream->fifo_threshold;
+		if (i + 1 < stream->ring_len) {
+			blk->next_block = &stream->ring_blk[i + 1];
+		}
+	}
+
+	dcfg.head_block = &stream->ring_blk[0];
+	dcfg.block_count = stream->ring_len;
+	dcfg.cyclic = 1;
+	dcfg.complete_callback_en = 1;
+
+	stream->ring_dma = 0U;
+	stream->ring_app = 0U;
+	k_sem_init(&stream->ring_sem, 0, stream->ring_len);
+
+	ret = dma_config(dev_dma, stream->dma_channel, &dcfg);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return dma_start(dev_dma, stream->dma_channel);
+}
+
+static void ring_free(struct stream *stream)
+{
+	for (int i = 0; i < stream->ring_len; i++) {
+		k_mem_slab_free(stream->cfg.mem_slab, &stream->ring[i]);
+	}
+
+	stream->ring_len = 0U;
+}
+
+/* Executed in the interrupt context at the end of each block of the ring */
+static void ring_block_done(struct stream *stream, struct device *dev,
+			    int status)
+{
+	/* The application fell a whole ring behind */
+	if (status < 0 ||
+	    k_sem_count_get(&stream->ring_sem) >= stream->ring_len) {
+		LOG_ERR("ring %s", status < 0 ? "DMA error" : "overflow");
+		stream->state = I2S_STATE_ERROR;
+		stream->stream_disable(stream, dev);
+		k_sem_give(&stream->ring_sem);
+		return;
+	}
+
+	/* Assure cache coherency after DMA write operation */
+	DCACHE_INVALIDATE(stream->ring[stream->ring_dma],
+			  stream->cfg.block_size);
+
+	MODULO_INC(stream->ring_dma, stream->ring_len);
+	k_sem_give(&stream->ring_sem);
+}
+
 static struct device *get_dev_from_rx_dma_channel(uint32_t dma_channel);
 static struct device *get_dev_from_tx_dma_channel(uint32_t dma_channel);
 static void rx_stream_disable(struct stream *stream, struct device *dev);
@@ -502,6 +700,11 @@ static void dma_rx_callback(struct device *dma_dev, void *arg,
 	void *mblk_tmp;
 	int ret;
 
+	if (is_pingpong(stream)) {
+		ring_block_done(stream, dev, status);
+		return;
+	}
+
 	if (status != 0) {
 		ret = -EIO;
 		stream->state = I2S_STATE_ERROR;
@@ -569,6 +772,11 @@ static void dma_tx_callback(struct device *dma_dev, void *arg,
 	size_t mem_block_size;
 	int ret;
 
+	if (is_pingpong(stream)) {
+		ring_block_done(stream, dev, status);
+		return;
+	}
+
 	if (status != 0) {
 		ret = -EIO;
 		stream->state = I2S_STATE_ERROR;
@@ -694,10 +902,24 @@ static int rx_stream_start(struct stream *stream, struct device *dev)
 	struct i2s_stm32_data *const dev_data = DEV_DATA(dev);
 	int ret;
 
-	ret = k_mem_slab_alloc(stream->cfg.mem_slab, &stream->mem_block,
-			       K_NO_WAIT);
-	if (ret < 0) {
-		return ret;
+	if (is_pingpong(stream)) {
+		for (stream->ring_len = 0U;
+		     stream->ring_len < CONFIG_I2S_STM32_RX_BLOCK_COUNT;
+		     stream->ring_len++) {
+			ret = k_mem_slab_alloc(stream->cfg.mem_slab,
+					       &stream->ring[stream->ring_len],
+					       K_NO_WAIT);
+			if (ret < 0) {
+				ring_free(stream);
+				return ret;
+			}
+		}
+	} else {
+		ret = k_mem_slab_alloc(stream->cfg.mem_slab,
+				       &stream->mem_block, K_NO_WAIT);
+		if (ret < 0) {
+			return ret;
+		}
 	}
 
 	if (stream->master) {
@@ -709,12 +931,19 @@ static int rx_stream_start(struct stream *stream, struct device *dev)
 	/* remember active RX DMA channel (used in callback) */
 	active_dma_rx_channel[stream->dma_channel] = dev;
 
-	ret = start_dma(dev_data->dev_dma_rx, stream->dma_channel,
-			&stream->dma_cfg,
-			(void *)LL_SPI_DMA_GetRegAddr(cfg->i2s),
-			stream->src_addr_increment, stream->mem_block,
-			stream->dst_addr_increment, stream->fifo_threshold,
-			stream->cfg.block_size);
+	if (is_pingpong(stream)) {
+		ret = start_dma_ring(dev_data->dev_dma_rx, stream,
+				     (void *)LL_SPI_DMA_GetRegAddr(cfg->i2s),
+				     false);
+	} else {
+		ret = start_dma(dev_data->dev_dma_rx, stream->dma_channel,
+				&stream->dma_cfg,
+				(void *)LL_SPI_DMA_GetRegAddr(cfg->i2s),
+				stream->src_addr_increment, stream->mem_block,
+				stream->dst_addr_increment,
+				stream->fifo_threshold,
+				stream->cfg.block_size);
+	}
 	if (ret < 0) {
 		LOG_ERR("Failed to start RX DMA transfer: %d", ret);
 		return ret;
@@ -735,15 +964,32 @@ static int tx_stream_start(struct stream *stream, struct device *dev)
 	size_t mem_block_size;
 	int ret;
 
-	ret = queue_get(&stream->mem_block_queue, &stream->mem_block,
-			&mem_block_size);
-	if (ret < 0) {
-		return ret;
-	}
-	k_sem_give(&stream->sem);
+	if (is_pingpong(stream)) {
+		/* The blocks written so far make up the ring */
+		if (queue_len(&stream->mem_block_queue) < 2) {
+			return -ENOMEM;
+		}
 
-	/* Assure cache coherency before DMA read operation */
-	DCACHE_CLEAN(stream->mem_block, mem_block_size);
+		stream->ring_len = 0U;
+		while (queue_get(&stream->mem_block_queue,
+				 &stream->ring[stream->ring_len],
+				 &mem_block_size) == 0) {
+			DCACHE_CLEAN(stream->ring[stream->ring_len],
+				     mem_block_size);
+			stream->ring_len++;
+			k_sem_give(&stream->sem);
+		}
+	} else {
+		ret = queue_get(&stream->mem_block_queue, &stream->mem_block,
+				&mem_block_size);
+		if (ret < 0) {
+			return ret;
+		}
+		k_sem_give(&stream->sem);
+
+		/* Assure cache coherency before DMA read operation */
+		DCACHE_CLEAN(stream->mem_block, mem_block_size);
+	}
 
 	if (stream->master) {
 		LL_I2S_SetTransferMode(cfg->i2s, LL_I2S_MODE_MASTER_TX);
@@ -754,12 +1000,19 @@ static int tx_stream_start(struct stream *stream, struct device *dev)
 	/* remember active TX DMA channel (used in callback) */
 	active_dma_tx_channel[stream->dma_channel] = dev;
 
-	ret = start_dma(dev_data->dev_dma_tx, stream->dma_channel,
-			&stream->dma_cfg,
-			stream->mem_block, stream->src_addr_increment,
-			(void *)LL_SPI_DMA_GetRegAddr(cfg->i2s),
-			stream->dst_addr_increment, stream->fifo_threshold,
-			stream->cfg.block_size);
+	if (is_pingpong(stream)) {
+		ret = start_dma_ring(dev_data->dev_dma_tx, stream,
+				     (void *)LL_SPI_DMA_GetRegAddr(cfg->i2s),
+				     true);
+	} else {
+		ret = start_dma(dev_data->dev_dma_tx, stream->dma_channel,
+				&stream->dma_cfg,
+				stream->mem_block, stream->src_addr_increment,
+				(void *)LL_SPI_DMA_GetRegAddr(cfg->i2s),
+				stream->dst_addr_increment,
+				stream->fifo_threshold,
+				stream->cfg.block_size);
+	}
 	if (ret < 0) {
 		LOG_ERR("Failed to start TX DMA transfer: %d", ret);
 		return ret;
@@ -787,6 +1040,7 @@ static void rx_stream_disable(struct stream *stream, struct device *dev)
 		k_mem_slab_free(stream->cfg.mem_slab, &stream->mem_block);
 		stream->mem_block = NULL;
 	}
+	ring_free(stream);
 
 	LL_I2S_Disable(cfg->i2s);
 
@@ -807,6 +1061,7 @@ static void tx_stream_disable(struct stream *stream, struct device *dev)
 		k_mem_slab_free(stream->cfg.mem_slab, &stream->mem_block);
 		stream->mem_block = NULL;
 	}
+	ring_free(stream);
 
 	LL_I2S_Disable(cfg->i2s);
 
@@ -67,6 +67,10 @@ struct ring_buf {
 	uint16_t tail;
 };
 
+/* Maximum number of memory blocks in a ping pong ring */
+#define RING_MAX_BLOCKS MAX(CONFIG_I2S_STM32_RX_BLOCK_COUNT, \
+			    CONFIG_I2S_STM32_TX_BLOCK_COUNT)
+
 /* Device constant configuration parameters */
 struct i2s_stm32_cfg {
 	SPI_TypeDef *i2s;
@@ -92,6 +96,14 @@ struct stream {
 	void *mem_block;
 	bool last_block;
 	bool master;
+	/* Ping pong ring, looped over by a cyclic DMA transfer */
+	void *ring[RING_MAX_BLOCKS];
+	struct dma_block_config ring_blk[RING_MAX_BLOCKS];
+	struct k_sem ring_sem;
+	uint8_t ring_len;
+	/* Block the DMA is in and next block handed to the application */
+	uint8_t ring_dma;
+	uint8_t ring_app;
 	int (*stream_start)(struct stream *, struct device *dev);
 	void (*stream_disable)(struct stream *, struct device *dev);
 	void (*queue_drop)(struct stream *);
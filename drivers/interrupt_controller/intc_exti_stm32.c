@@ -135,50 +135,43 @@ void stm32_exti_disable(int line)
 }
 
 /**
- * @brief check if interrupt is pending
+ * @brief get the pending interrupts
  *
- * @param line line number
+ * @param mask mask of the lines to check, among lines 0 to 31
+ *
+ * @return mask of the pending lines
  */
-static inline int stm32_exti_is_pending(int line)
+static inline uint32_t stm32_exti_get_pending(uint32_t mask)
 {
-	if (line < 32) {
 #if defined(CONFIG_SOC_SERIES_STM32MP1X) || \
 	defined(CONFIG_SOC_SERIES_STM32G0X) || \
 	defined(CONFIG_SOC_SERIES_STM32L5X)
-		return (LL_EXTI_IsActiveRisingFlag_0_31(1 << line) ||
-			LL_EXTI_IsActiveFallingFlag_0_31(1 << line));
+	return LL_EXTI_ReadRisingFlag_0_31(mask) |
+	       LL_EXTI_ReadFallingFlag_0_31(mask);
 #elif defined(CONFIG_SOC_SERIES_STM32H7X) && defined(CONFIG_CPU_CORTEX_M4)
-		return LL_C2_EXTI_IsActiveFlag_0_31(1 << line);
+	return LL_C2_EXTI_ReadFlag_0_31(mask);
 #else
-		return LL_EXTI_IsActiveFlag_0_31(1 << line);
+	return LL_EXTI_ReadFlag_0_31(mask);
 #endif
-	} else {
-		__ASSERT_NO_MSG(line);
-		return 0;
-	}
 }
 
 /**
- * @brief clear pending interrupt bit
+ * @brief clear pending interrupt bits
  *
- * @param line line number
+ * @param mask mask of the lines to clear, among lines 0 to 31
  */
-static inline void stm32_exti_clear_pending(int line)
+static inline void stm32_exti_clear_pending(uint32_t mask)
 {
-	if (line < 32) {
 #if defined(CONFIG_SOC_SERIES_STM32MP1X) || \
 	defined(CONFIG_SOC_SERIES_STM32G0X) || \
 	defined(CONFIG_SOC_SERIES_STM32L5X)
-		LL_EXTI_ClearRisingFlag_0_31(1 << line);
-		LL_EXTI_ClearFallingFlag_0_31(1 << line);
+	LL_EXTI_ClearRisingFlag_0_31(mask);
+	LL_EXTI_ClearFallingFlag_0_31(mask);
 #elif defined(CONFIG_SOC_SERIES_STM32H7X) && defined(CONFIG_CPU_CORTEX_M4)
-		LL_C2_EXTI_ClearFlag_0_31(1 << line);
+	LL_C2_EXTI_ClearFlag_0_31(mask);
 #else
-		LL_EXTI_ClearFlag_0_31(1 << line);
+	LL_EXTI_ClearFlag_0_31(mask);
 #endif
-	} else {
-		__ASSERT_NO_MSG(line);
-	}
 }
 
 void stm32_exti_trigger(int line, int trigger)
@@ -226,22 +219,23 @@ static void __stm32_exti_isr(int min, int max, void *arg)
 {
 	struct device *dev = arg;
 	struct stm32_exti_data *data = dev->data;
+	uint32_t pending;
 	int line;
 
-	/* see which bits are set */
-	for (line = min; line < max; line++) {
-		/* check if interrupt is pending */
-		if (stm32_exti_is_pending(line)) {
-			/* clear pending interrupt */
-			stm32_exti_clear_pending(line);
+	/* read and clear the pending lines of this IRQ at once */
+	pending = stm32_exti_get_pending(GENMASK(max - 1, min));
+	stm32_exti_clear_pending(pending);
 
-			/* run callback only if one is registered */
-			if (!data->cb[line].cb) {
-				continue;
-			}
+	while (pending != 0U) {
+		line = find_lsb_set(pending) - 1;
+		pending &= ~BIT(line);
 
-			data->cb[line].cb(line, data->cb[line].data);
+		/* run callback only if one is registered */
+		if (!data->cb[line].cb) {
+			continue;
 		}
+
+		data->cb[line].cb(line, data->cb[line].data);
 	}
 }
 
@@ -92,6 +92,12 @@ DEVICE_MMIO_TOPLEVEL_STATIC(ioapic_regs, DT_DRV_INST(0));
  */
 #define DEFAULT_RTE_DEST	(0xFF << 24)
 
+/*
+ * Logical destinations set by z_ioapic_irq_set_affinity(), 0 when the IRQ
+ * is delivered to all the local APICs.
+ */
+static uint8_t ioapic_rte_dest[CONFIG_IOAPIC_NUM_RTES];
+
 #ifdef CONFIG_DEVICE_POWER_MANAGEMENT
 #include <power/power.h>
 uint32_t ioapic_suspend_buf[SUSPEND_BITS_REQD / 32] = {0};
@@ -106,6 +112,15 @@ static uint32_t ioApicRedGetLo(unsigned int irq);
 static void IoApicRedUpdateLo(unsigned int irq, uint32_t value,
 					uint32_t mask);
 
+static inline uint32_t rte_dest(unsigned int irq)
+{
+	if (ioapic_rte_dest[irq] == 0U) {
+		return DEFAULT_RTE_DEST;
+	}
+
+	return (uint32_t)ioapic_rte_dest[irq] << 24;
+}
+
 /*
  * The functions irq_enable() and irq_disable() are implemented in the
  * interrupt controller driver due to the IRQ virtualization imposed by
@@ -282,7 +297,7 @@ int ioapic_resume_from_suspend(struct device *port)
 				IOAPIC_FIXED | IOAPIC_INT_MASK |
 				IOAPIC_LOGICAL | 0 ; /* dummy vector*/
 		}
-		ioApicRedSetHi(irq, DEFAULT_RTE_DEST);
+		ioApicRedSetHi(irq, rte_dest(irq));
 		ioApicRedSetLo(irq, rteValue);
 	}
 	ioapic_device_power_state = DEVICE_PM_ACTIVE_STATE;
@@ -336,10 +351,44 @@ void z_ioapic_irq_set(unsigned int irq, unsigned int vector, uint32_t flags)
 	/* the delivery mode is determined by the flags passed from drivers */
 	rteValue = IOAPIC_INT_MASK | IOAPIC_LOGICAL |
 		   (vector & IOAPIC_VEC_MASK) | flags;
-	ioApicRedSetHi(irq, DEFAULT_RTE_DEST);
+	ioApicRedSetHi(irq, rte_dest(irq));
 	ioApicRedSetLo(irq, rteValue);
 }
 
+/**
+ *
+ * @brief Route an IRQ to a set of CPUs
+ *
+ * The logical APIC ID of each CPU is a bit of the LDR in the xAPIC flat
+ * model, see intc_loapic.c, so the CPU mask is the logical destination.
+ * The destination is kept across suspend and z_ioapic_irq_set().
+ *
+ * @param irq Virtualized IRQ
+ * @param cpu_mask Bit mask of the CPUs receiving the IRQ
+ *
+ * @return 0 on success, -EINVAL if the mask is empty or has CPUs which do
+ * not exist, -ENOTSUP in x2APIC mode
+ */
+int z_ioapic_irq_set_affinity(unsigned int irq, uint32_t cpu_mask)
+{
+	uint32_t all = BIT_MASK(CONFIG_MP_NUM_CPUS);
+
+	if (IS_ENABLED(CONFIG_X2APIC)) {
+		/* LDR is in cluster model and can't be chosen */
+		return -ENOTSUP;
+	}
+
+	if ((irq >= CONFIG_IOAPIC_NUM_RTES) || (cpu_mask == 0U) ||
+	    ((cpu_mask & ~all) != 0U)) {
+		return -EINVAL;
+	}
+
+	ioapic_rte_dest[irq] = (cpu_mask == all) ? 0U : (uint8_t)cpu_mask;
+	ioApicRedSetHi(irq, rte_dest(irq));
+
+	return 0;
+}
+
 /**
  *
  * @brief Program interrupt vector for specified irq
@@ -100,3 +100,21 @@ void arch_irq_disable(unsigned int irq)
 		z_loapic_irq_disable(irq - LOAPIC_IRQ_BASE);
 	}
 }
+
+/**
+ *
+ * @brief Route an individual interrupt (IRQ) to a set of CPUs
+ *
+ * Only the IO APIC interrupts can be routed, the local APIC interrupts are
+ * delivered to the CPU owning the local APIC.
+ *
+ * @return 0 on success, negative errno otherwise
+ */
+int arch_irq_set_affinity(unsigned int irq, uint32_t cpu_mask)
+{
+	if (!IS_IOAPIC_IRQ(irq)) {
+		return -EINVAL;
+	}
+
+	return z_ioapic_irq_set_affinity(irq, cpu_mask);
+}
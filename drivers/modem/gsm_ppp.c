@@ -7,6 +7,7 @@
 #include <logging/log.h>
 LOG_MODULE_REGISTER(modem_gsm, CONFIG_MODEM_LOG_LEVEL);
 
+#include <stdlib.h>
 #include <kernel.h>
 #include <device.h>
 #include <sys/ring_buffer.h>
@@ -27,6 +28,7 @@ LOG_MODULE_REGISTER(modem_gsm, CONFIG_MODEM_LOG_LEVEL);
 #define GSM_RECV_MAX_BUF       30
 #define GSM_RECV_BUF_SIZE      128
 #define GSM_BUF_ALLOC_TIMEOUT  K_SECONDS(1)
+#define RSSI_POLLING_PERIOD    CONFIG_MODEM_GSM_RSSI_POLLING_PERIOD
 
 /* During the modem setup, we first create DLCI control channel and then
  * PPP and AT channels. Currently the modem does not create possible GNSS
@@ -44,12 +46,12 @@ static struct gsm_modem {
 	struct modem_context context;
 
 	struct modem_cmd_handler_data cmd_handler_data;
-	uint8_t cmd_read_buf[GSM_CMD_READ_BUF];
 	uint8_t cmd_match_buf[GSM_CMD_READ_BUF];
 	struct k_sem sem_response;
 
 	struct modem_iface_uart_data gsm_data;
 	struct k_delayed_work gsm_configure_work;
+	struct k_delayed_work rssi_work;
 	char gsm_isr_buf[PPP_MRU];
 	char gsm_rx_rb_buf[PPP_MRU * 3];
 
@@ -229,6 +231,18 @@ MODEM_CMD_DEFINE(on_cmd_atcmdinfo_iccid)
 #endif /* CONFIG_MODEM_SIM_NUMBERS */
 #endif /* CONFIG_MODEM_SHELL */
 
+/* Handler: +CSQ: <rssi>,<ber> */
+MODEM_CMD_DEFINE(on_cmd_csq)
+{
+	int rssi = (int)strtol(argv[0], NULL, 10);
+
+	/* 99 is "not known or not detectable" */
+	gsm.context.data_rssi = (rssi == 99) ? 0 : -113 + 2 * rssi;
+	LOG_DBG("RSSI: %d", gsm.context.data_rssi);
+
+	return 0;
+}
+
 static struct setup_cmd setup_cmds[] = {
 	/* no echo */
 	SETUP_CMD_NOHANDLE("ATE0"),
@@ -305,6 +319,28 @@ static void set_ppp_carrier_on(struct gsm_modem *gsm)
 	api->start(ppp_dev);
 }
 
+/*
+ * The AT channel runs next to the PPP channel, the signal quality is
+ * polled there without stopping the PPP link.
+ */
+static void rssi_poll(struct k_work *work)
+{
+	struct gsm_modem *gsm = CONTAINER_OF(work, struct gsm_modem,
+					     rssi_work);
+	struct modem_cmd cmd = MODEM_CMD("+CSQ: ", on_cmd_csq, 2U, ",");
+	int ret;
+
+	ret = modem_cmd_send(&gsm->context.iface, &gsm->context.cmd_handler,
+			     &cmd, 1, "AT+CSQ", &gsm->sem_response,
+			     GSM_CMD_AT_TIMEOUT);
+	if (ret < 0) {
+		LOG_DBG("AT+CSQ ret:%d", ret);
+	}
+
+	(void)k_delayed_work_submit(&gsm->rssi_work,
+				    K_SECONDS(RSSI_POLLING_PERIOD));
+}
+
 static void gsm_finalize_connection(struct gsm_modem *gsm)
 {
 	int ret;
@@ -388,6 +424,11 @@ static void gsm_finalize_connection(struct gsm_modem *gsm)
 			} else {
 				LOG_INF("AT channel %d connected to %s",
 					DLCI_AT, gsm->at_dev->name);
+
+				if (RSSI_POLLING_PERIOD) {
+					(void)k_delayed_work_submit(
+						&gsm->rssi_work, K_NO_WAIT);
+				}
 			}
 		}
 	}
@@ -618,8 +659,6 @@ static int gsm_init(struct device *device)
 
 	gsm->cmd_handler_data.cmds[CMD_RESP] = response_cmds;
 	gsm->cmd_handler_data.cmds_len[CMD_RESP] = ARRAY_SIZE(response_cmds);
-	gsm->cmd_handler_data.read_buf = &gsm->cmd_read_buf[0];
-	gsm->cmd_handler_data.read_buf_len = sizeof(gsm->cmd_read_buf);
 	gsm->cmd_handler_data.match_buf = &gsm->cmd_match_buf[0];
 	gsm->cmd_handler_data.match_buf_len = sizeof(gsm->cmd_match_buf);
 	gsm->cmd_handler_data.buf_pool = &gsm_recv_pool;
@@ -675,6 +714,7 @@ static int gsm_init(struct device *device)
 	k_thread_name_set(&gsm_rx_thread, "gsm_rx");
 
 	k_delayed_work_init(&gsm->gsm_configure_work, gsm_configure);
+	k_delayed_work_init(&gsm->rssi_work, rssi_poll);
 
 	(void)k_delayed_work_submit(&gsm->gsm_configure_work, K_NO_WAIT);
 
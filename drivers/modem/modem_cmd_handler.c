@@ -98,10 +98,96 @@ static bool starts_with(struct net_buf *buf, const char *str)
  * Cmd Handler Functions
  */
 
-static inline struct net_buf *read_rx_allocator(k_timeout_t timeout,
-						void *user_data)
+/*
+ * Read the modem iface data straight into the tail of the rx net_buf
+ * chain, instead of staging it in an intermediate buffer.
+ */
+static void read_rx_data(struct modem_cmd_handler_data *data,
+			 struct modem_iface *iface)
 {
-	return net_buf_alloc((struct net_buf_pool *)user_data, timeout);
+	struct net_buf *frag, *last = NULL;
+	size_t bytes_read;
+	bool alloc;
+	int ret;
+
+	if (data->rx_buf) {
+		last = net_buf_frag_last(data->rx_buf);
+	}
+
+	while (true) {
+		alloc = !last || !net_buf_tailroom(last);
+		if (alloc) {
+			frag = net_buf_alloc(data->buf_pool,
+					     data->alloc_timeout);
+			if (!frag) {
+				LOG_ERR("Can't allocate RX data! "
+					"Leaving data in the iface!");
+				break;
+			}
+		} else {
+			frag = last;
+		}
+
+		bytes_read = 0;
+		ret = iface->read(iface, net_buf_tail(frag),
+				  net_buf_tailroom(frag), &bytes_read);
+		if (ret < 0 || bytes_read == 0) {
+			/* modem context buffer is empty */
+			if (alloc) {
+				net_buf_unref(frag);
+			}
+
+			break;
+		}
+
+		net_buf_add(frag, bytes_read);
+		if (!alloc) {
+			continue;
+		}
+
+		if (last) {
+			net_buf_frag_insert(last, frag);
+		} else {
+			data->rx_buf = frag;
+		}
+
+		last = frag;
+	}
+}
+
+/*
+ * Length of the line prefix needed to parse the parameters of cmd: up to
+ * the delimiter ending its last parameter, or the whole line.
+ */
+static size_t params_len(struct modem_cmd_handler_data *data,
+			 struct modem_cmd *cmd, size_t line_len)
+{
+	struct net_buf *buf = data->rx_buf;
+	size_t pos = 0, off = 0;
+	uint16_t count = 0U;
+
+	if (cmd->arg_count == 0U) {
+		return MIN(cmd->cmd_len, line_len);
+	}
+
+	while (buf && pos < line_len) {
+		if (off >= buf->len) {
+			buf = buf->frags;
+			off = 0;
+			continue;
+		}
+
+		if (pos >= cmd->cmd_len && buf->data[off] != '\0' &&
+		    strchr(cmd->delim, buf->data[off]) &&
+		    ++count >= cmd->arg_count) {
+			return pos + 1;
+		}
+
+		pos++;
+		off++;
+	}
+
+	return line_len;
 }
 
 /* return scanned length for params */
@@ -168,9 +254,12 @@ static int parse_params(struct modem_cmd_handler_data *data,  size_t match_len,
 	return begin - cmd->cmd_len;
 }
 
-/* process a "matched" command */
+/*
+ * process a "matched" command: match_len bytes of the line are in
+ * match_buf, line_len is the length of the whole line
+ */
 static int process_cmd(struct modem_cmd *cmd, size_t match_len,
-			struct modem_cmd_handler_data *data)
+		       size_t line_len, struct modem_cmd_handler_data *data)
 {
 	int parsed_len = 0, ret = 0;
 	uint8_t *argv[CONFIG_MODEM_CMD_HANDLER_MAX_PARAM_COUNT];
@@ -194,7 +283,7 @@ static int process_cmd(struct modem_cmd *cmd, size_t match_len,
 
 	/* call handler */
 	if (cmd->func) {
-		ret = cmd->func(data, match_len - cmd->cmd_len - parsed_len,
+		ret = cmd->func(data, line_len - cmd->cmd_len - parsed_len,
 				argv, argc);
 		if (ret == -EAGAIN) {
 			/* wait for more data */
@@ -206,7 +295,7 @@ static int process_cmd(struct modem_cmd *cmd, size_t match_len,
 }
 
 /*
- * check 3 arrays of commands for a match in match_buf:
+ * check 3 arrays of commands for a match at the start of rx_buf:
  * - response handlers[0]
  * - unsolicited handlers[1]
  * - current assigned handlers[2]
@@ -222,9 +311,8 @@ static struct modem_cmd *find_cmd_match(struct modem_cmd_handler_data *data)
 
 		for (i = 0; i < data->cmds_len[j]; i++) {
 			/* match on "empty" cmd */
-			if (strlen(data->cmds[j][i].cmd) == 0 ||
-			    strncmp(data->match_buf, data->cmds[j][i].cmd,
-				    data->cmds[j][i].cmd_len) == 0) {
+			if (data->cmds[j][i].cmd[0] == '\0' ||
+			    starts_with(data->rx_buf, data->cmds[j][i].cmd)) {
 				return &data->cmds[j][i];
 			}
 		}
@@ -262,7 +350,7 @@ static void cmd_handler_process(struct modem_cmd_handler *cmd_handler,
 	struct modem_cmd_handler_data *data;
 	struct modem_cmd *cmd;
 	struct net_buf *frag = NULL;
-	size_t match_len, rx_len, bytes_read = 0;
+	size_t match_len, line_len;
 	int ret;
 	uint16_t offset, len;
 
@@ -274,35 +362,7 @@ static void cmd_handler_process(struct modem_cmd_handler *cmd_handler,
 	data = (struct modem_cmd_handler_data *)(cmd_handler->cmd_handler_data);
 
 	/* read all of the data from modem iface */
-	while (true) {
-		ret = iface->read(iface, data->read_buf,
-				  data->read_buf_len, &bytes_read);
-		if (ret < 0 || bytes_read == 0) {
-			/* modem context buffer is empty */
-			break;
-		}
-
-		/* make sure we have storage */
-		if (!data->rx_buf) {
-			data->rx_buf = net_buf_alloc(data->buf_pool,
-						     data->alloc_timeout);
-			if (!data->rx_buf) {
-				LOG_ERR("Can't allocate RX data! "
-					"Skipping data!");
-				break;
-			}
-		}
-
-		rx_len = net_buf_append_bytes(data->rx_buf, bytes_read,
-					      data->read_buf,
-					      data->alloc_timeout,
-					      read_rx_allocator,
-					      data->buf_pool);
-		if (rx_len < bytes_read) {
-			LOG_ERR("Data was lost! read %zu of %zu!",
-				rx_len, bytes_read);
-		}
-	}
+	read_rx_data(data, iface);
 
 	/* process all of the data in the net_buf */
 	while (data->rx_buf) {
@@ -335,29 +395,46 @@ static void cmd_handler_process(struct modem_cmd_handler *cmd_handler,
 			break;
 		}
 
-		/* load match_buf with content up to the next CR/LF */
+		/*
+		 * Lines are matched in place, only the command and its
+		 * parameters are copied to match_buf, not the data which
+		 * may follow them (e.g. socket payloads).
+		 */
 		/* NOTE: keep room in match_buf for ending NUL char */
-		match_len = net_buf_linearize(data->match_buf,
-					      data->match_buf_len - 1,
-					      data->rx_buf, 0, len);
+		line_len = MIN(len, data->match_buf_len - 1);
+
+		k_sem_take(&data->sem_parse_lock, K_FOREVER);
+
+		cmd = find_cmd_match(data);
+		if (IS_ENABLED(CONFIG_MODEM_CONTEXT_VERBOSE_DEBUG)) {
+			match_len = line_len;
+		} else if (cmd) {
+			match_len = params_len(data, cmd, len);
+		} else {
+			match_len = 0;
+		}
+
 		if ((data->match_buf_len - 1) < match_len) {
 			LOG_ERR("Match buffer size (%zu) is too small for "
-				"incoming command size: %u!  Truncating!",
+				"incoming command size: %zu!  Truncating!",
 				data->match_buf_len - 1, match_len);
 		}
 
+		match_len = net_buf_linearize(data->match_buf,
+					      data->match_buf_len - 1,
+					      data->rx_buf, 0, match_len);
+		data->match_buf[match_len] = '\0';
+
 #if defined(CONFIG_MODEM_CONTEXT_VERBOSE_DEBUG)
 		LOG_HEXDUMP_DBG(data->match_buf, match_len, "RECV");
 #endif
 
-		k_sem_take(&data->sem_parse_lock, K_FOREVER);
-
-		cmd = find_cmd_match(data);
 		if (cmd) {
 			LOG_DBG("match cmd [%s] (len:%u)",
-				log_strdup(cmd->cmd), match_len);
+				log_strdup(cmd->cmd), len);
 
-			if (process_cmd(cmd, match_len, data) == -EAGAIN) {
+			if (process_cmd(cmd, match_len, line_len,
+					data) == -EAGAIN) {
 				k_sem_give(&data->sem_parse_lock);
 				break;
 			}
@@ -567,7 +644,7 @@ int modem_cmd_handler_init(struct modem_cmd_handler *handler,
 		return -EINVAL;
 	}
 
-	if (!data->read_buf_len || !data->match_buf_len) {
+	if (!data->match_buf_len) {
 		return -EINVAL;
 	}
 
@@ -80,9 +80,10 @@ struct modem_cmd_handler_data {
 	struct modem_cmd *cmds[CMD_MAX];
 	size_t cmds_len[CMD_MAX];
 
-	char *read_buf;
-	size_t read_buf_len;
-
+	/*
+	 * Prefix of the matched line, holding the command and its
+	 * parameters, NUL terminated
+	 */
 	char *match_buf;
 	size_t match_buf_len;
 
@@ -38,6 +38,18 @@ LOG_MODULE_REGISTER(net_ppp, LOG_LEVEL);
 
 #define UART_BUF_LEN CONFIG_NET_PPP_UART_BUF_LEN
 
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+#define PPP_SEND_BUF_LEN CONFIG_NET_PPP_ASYNC_UART_TX_BUF_LEN
+#define PPP_SEND_BUF_COUNT 2
+#else
+#define PPP_SEND_BUF_LEN UART_BUF_LEN
+#define PPP_SEND_BUF_COUNT 1
+#endif
+
+/* RFC 1662 ch. 4.2, default async control character map */
+#define PPP_NEEDS_ESCAPE(byte) ((byte) < 0x20 || (byte) == 0x7d || \
+				(byte) == 0x7e)
+
 enum ppp_driver_state {
 	STATE_HDLC_FRAME_START,
 	STATE_HDLC_FRAME_ADDRESS,
@@ -62,8 +74,10 @@ struct ppp_driver_context {
 	/* ppp data is read into this buf */
 	uint8_t buf[UART_BUF_LEN];
 
-	/* ppp buf use when sending data */
-	uint8_t send_buf[UART_BUF_LEN];
+	/* ppp buf use when sending data. With the async UART API one buffer
+	 * is filled while the other one is being transmitted.
+	 */
+	uint8_t send_buf[PPP_SEND_BUF_COUNT][PPP_SEND_BUF_LEN];
 
 	uint8_t mac_addr[6];
 	struct net_linkaddr ll_addr;
@@ -75,6 +89,16 @@ struct ppp_driver_context {
 	struct ring_buf rx_ringbuf;
 	uint8_t rx_buf[CONFIG_NET_PPP_RINGBUF_SIZE];
 
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+	/* DMA buffers handed to the UART driver */
+	uint8_t async_rx_buf[2][CONFIG_NET_PPP_ASYNC_UART_RX_BUF_LEN];
+	uint8_t async_rx_next;
+
+	/* Given when the previous send buffer has been transmitted */
+	struct k_sem tx_sem;
+	uint8_t send_idx;
+#endif
+
 	/* ISR function callback worker */
 	struct k_work cb_work;
 	struct k_work_q cb_workq;
@@ -84,6 +108,9 @@ struct ppp_driver_context {
 #endif
 	enum ppp_driver_state state;
 
+	/* FCS of the frame being received, updated as data is saved */
+	uint16_t fcs;
+
 #if defined(CONFIG_PPP_CLIENT_CLIENTSERVER)
 	/* correctly received CLIENT bytes */
 	uint8_t client_index;
@@ -95,8 +122,10 @@ struct ppp_driver_context {
 
 static struct ppp_driver_context ppp_driver_context_data;
 
-static int ppp_save_byte(struct ppp_driver_context *ppp, uint8_t byte)
+static int ppp_save_bytes(struct ppp_driver_context *ppp,
+			  const uint8_t *data, size_t len)
 {
+	size_t count;
 	int ret;
 
 	if (!ppp->pkt) {
@@ -112,39 +141,49 @@ static int ppp_save_byte(struct ppp_driver_context *ppp, uint8_t byte)
 		net_pkt_cursor_init(ppp->pkt);
 
 		ppp->available = net_pkt_available_buffer(ppp->pkt);
+		ppp->fcs = 0xffff;
 	}
 
 	/* Extra debugging can be enabled separately if really
 	 * needed. Normally it would just print too much data.
 	 */
 	if (0) {
-		LOG_DBG("Saving byte %02x", byte);
+		LOG_HEXDUMP_DBG(data, len, "Saving bytes");
 	}
 
-	/* This is not very intuitive but we must allocate new buffer
-	 * before we write a byte to last available cursor position.
-	 */
-	if (ppp->available == 1) {
-		ret = net_pkt_alloc_buffer(ppp->pkt,
-					   CONFIG_NET_BUF_DATA_SIZE,
-					   AF_UNSPEC, K_NO_WAIT);
-		if (ret < 0) {
-			LOG_ERR("[%p] cannot allocate new data buffer", ppp);
-			goto out_of_mem;
+	if (IS_ENABLED(CONFIG_NET_PPP_VERIFY_FCS)) {
+		ppp->fcs = crc16_ccitt(ppp->fcs, data, len);
+	}
+
+	while (len > 0) {
+		/* This is not very intuitive but we must allocate new buffer
+		 * before we write a byte to last available cursor position.
+		 */
+		if (ppp->available <= 1) {
+			ret = net_pkt_alloc_buffer(ppp->pkt,
+						   CONFIG_NET_BUF_DATA_SIZE,
+						   AF_UNSPEC, K_NO_WAIT);
+			if (ret < 0) {
+				LOG_ERR("[%p] cannot allocate new data buffer",
+					ppp);
+				goto out_of_mem;
+			}
+
+			ppp->available = net_pkt_available_buffer(ppp->pkt);
 		}
 
-		ppp->available = net_pkt_available_buffer(ppp->pkt);
-	}
+		count = MIN(len, ppp->available - 1);
 
-	if (ppp->available) {
-		ret = net_pkt_write_u8(ppp->pkt, byte);
+		ret = net_pkt_write(ppp->pkt, data, count);
 		if (ret < 0) {
 			LOG_ERR("[%p] Cannot write to pkt %p (%d)",
 				ppp, ppp->pkt, ret);
 			goto out_of_mem;
 		}
 
-		ppp->available--;
+		ppp->available -= count;
+		data += count;
+		len -= count;
 	}
 
 	return 0;
@@ -155,6 +194,11 @@ out_of_mem:
 	return -ENOMEM;
 }
 
+static inline int ppp_save_byte(struct ppp_driver_context *ppp, uint8_t byte)
+{
+	return ppp_save_bytes(ppp, &byte, 1);
+}
+
 static const char *ppp_driver_state_str(enum ppp_driver_state state)
 {
 #if (CONFIG_NET_PPP_LOG_LEVEL >= LOG_LEVEL_DBG)
@@ -192,28 +236,60 @@ static void ppp_change_state(struct ppp_driver_context *ctx,
 	ctx->state = new_state;
 }
 
+static inline uint8_t *ppp_send_buf(struct ppp_driver_context *ppp)
+{
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+	return ppp->send_buf[ppp->send_idx];
+#else
+	return ppp->send_buf[0];
+#endif
+}
+
 static int ppp_send_flush(struct ppp_driver_context *ppp, int off)
 {
-	if (!IS_ENABLED(CONFIG_NET_TEST)) {
-		uint8_t *buf = ppp->send_buf;
+#if !defined(CONFIG_NET_PPP_ASYNC_UART)
+	uint8_t *buf = ppp_send_buf(ppp);
+#endif
 
-		while (off--) {
-			uart_poll_out(ppp->dev, *buf++);
-		}
+	if (IS_ENABLED(CONFIG_NET_TEST) || off == 0) {
+		return 0;
 	}
 
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+	/* Wait until the other buffer is out, then start sending this one
+	 * and continue filling the other one.
+	 */
+	k_sem_take(&ppp->tx_sem, K_FOREVER);
+
+	if (uart_tx(ppp->dev, ppp_send_buf(ppp), off, SYS_FOREVER_MS) < 0) {
+		LOG_ERR("[%p] cannot start UART TX", ppp);
+		k_sem_give(&ppp->tx_sem);
+	} else {
+		ppp->send_idx ^= 1;
+	}
+#else
+	while (off--) {
+		uart_poll_out(ppp->dev, *buf++);
+	}
+#endif
+
 	return 0;
 }
 
 static int ppp_send_bytes(struct ppp_driver_context *ppp,
 			  const uint8_t *data, int len, int off)
 {
-	int i;
+	int count;
 
-	for (i = 0; i < len; i++) {
-		ppp->send_buf[off++] = data[i];
+	while (len > 0) {
+		count = MIN(len, PPP_SEND_BUF_LEN - off);
 
-		if (off >= sizeof(ppp->send_buf)) {
+		memcpy(ppp_send_buf(ppp) + off, data, count);
+		off += count;
+		data += count;
+		len -= count;
+
+		if (off >= PPP_SEND_BUF_LEN) {
 			off = ppp_send_flush(ppp, off);
 		}
 	}
@@ -221,6 +297,34 @@ static int ppp_send_bytes(struct ppp_driver_context *ppp,
 	return off;
 }
 
+/* Copy data to the send buffer, escaping it in runs of plain bytes */
+static int ppp_send_escaped(struct ppp_driver_context *ppp,
+			    const uint8_t *data, int len, int off)
+{
+	uint8_t escaped[2];
+	int run;
+
+	while (len > 0) {
+		for (run = 0; run < len && !PPP_NEEDS_ESCAPE(data[run]);
+		     run++) {
+		}
+
+		if (run > 0) {
+			off = ppp_send_bytes(ppp, data, run, off);
+			data += run;
+			len -= run;
+			continue;
+		}
+
+		escaped[0] = 0x7d;
+		escaped[1] = *data++ ^ 0x20;
+		off = ppp_send_bytes(ppp, escaped, sizeof(escaped), off);
+		len--;
+	}
+
+	return off;
+}
+
 #if defined(CONFIG_PPP_CLIENT_CLIENTSERVER)
 
 #define CLIENT "CLIENT"
@@ -349,25 +453,9 @@ static int ppp_input_byte(struct ppp_driver_context *ppp, uint8_t byte)
 
 static bool ppp_check_fcs(struct ppp_driver_context *ppp)
 {
-	struct net_buf *buf;
-	uint16_t crc;
-
-	buf = ppp->pkt->buffer;
-	if (!buf) {
-		return false;
-	}
-
-	crc = crc16_ccitt(0xffff, buf->data, buf->len);
-
-	buf = buf->frags;
-
-	while (buf) {
-		crc = crc16_ccitt(crc, buf->data, buf->len);
-		buf = buf->frags;
-	}
-
-	if (crc != 0xf0b8) {
-		LOG_DBG("Invalid FCS (0x%x)", crc);
+	/* The FCS was accumulated while the frame was being saved */
+	if (ppp->fcs != 0xf0b8) {
+		LOG_DBG("Invalid FCS (0x%x)", ppp->fcs);
 #if defined(CONFIG_NET_STATISTICS_PPP)
 		ppp->stats.chkerr++;
 #endif
@@ -424,37 +512,65 @@ static void ppp_process_msg(struct ppp_driver_context *ppp)
 	ppp->pkt = NULL;
 }
 
-#if defined(CONFIG_NET_TEST)
-static uint8_t *ppp_recv_cb(uint8_t *buf, size_t *off)
+static void ppp_frame_end(struct ppp_driver_context *ppp)
 {
-	struct ppp_driver_context *ppp =
-		CONTAINER_OF(buf, struct ppp_driver_context, buf);
-	size_t i, len = *off;
+	if (!ppp->pkt) {
+		return;
+	}
 
-	for (i = 0; i < *off; i++) {
-		if (0) {
-			/* Extra debugging can be enabled separately if really
-			 * needed. Normally it would just print too much data.
-			 */
-			LOG_DBG("[%zd] %02x", i, buf[i]);
-		}
+	/* Ignore empty or too short frames */
+	if (net_pkt_get_len(ppp->pkt) > 3) {
+		ppp_process_msg(ppp);
+	} else {
+		net_pkt_unref(ppp->pkt);
+		ppp->pkt = NULL;
+	}
+}
 
-		if (ppp_input_byte(ppp, buf[i]) == 0) {
-			/* Ignore empty or too short frames */
-			if (ppp->pkt && net_pkt_get_len(ppp->pkt) > 3) {
-				ppp_process_msg(ppp);
-				break;
+/* Feed a block of received data to the HDLC deframer. Runs of bytes that
+ * need no unescaping are saved to the packet in one go, only the flag and
+ * escape bytes take the byte by byte path.
+ */
+static void ppp_input(struct ppp_driver_context *ppp,
+		      const uint8_t *data, size_t len)
+{
+	size_t run;
+
+	while (len > 0) {
+		if (ppp->state == STATE_HDLC_FRAME_DATA && !ppp->next_escaped) {
+			for (run = 0; run < len && data[run] != 0x7e &&
+				     data[run] != 0x7d; run++) {
+			}
+
+			if (run > 0) {
+				if (ppp_save_bytes(ppp, data, run) < 0) {
+					ppp_change_state(ppp,
+							 STATE_HDLC_FRAME_START);
+				}
+
+				data += run;
+				len -= run;
+				continue;
 			}
 		}
-	}
 
-	if (i == *off) {
-		*off = 0;
-	} else {
-		*off = len - i - 1;
+		if (ppp_input_byte(ppp, *data) == 0) {
+			ppp_frame_end(ppp);
+		}
 
-		memmove(&buf[0], &buf[i + 1], *off);
+		data++;
+		len--;
 	}
+}
+
+#if defined(CONFIG_NET_TEST)
+static uint8_t *ppp_recv_cb(uint8_t *buf, size_t *off)
+{
+	struct ppp_driver_context *ppp =
+		CONTAINER_OF(buf, struct ppp_driver_context, buf);
+
+	ppp_input(ppp, buf, *off);
+	*off = 0;
 
 	return buf;
 }
@@ -493,49 +609,6 @@ void ppp_driver_feed_data(uint8_t *data, int data_len)
 }
 #endif
 
-static bool calc_fcs(struct net_pkt *pkt, uint16_t *fcs, uint16_t protocol)
-{
-	struct net_buf *buf;
-	uint16_t crc;
-	uint16_t c;
-
-	buf = pkt->buffer;
-	if (!buf) {
-		return false;
-	}
-
-	/* HDLC Address and Control fields */
-	c = sys_cpu_to_be16(0xff << 8 | 0x03);
-
-	crc = crc16_ccitt(0xffff, (const uint8_t *)&c, sizeof(c));
-
-	if (protocol > 0) {
-		crc = crc16_ccitt(crc, (const uint8_t *)&protocol,
-				  sizeof(protocol));
-	}
-
-	while (buf) {
-		crc = crc16_ccitt(crc, buf->data, buf->len);
-		buf = buf->frags;
-	}
-
-	crc ^= 0xffff;
-	*fcs = crc;
-
-	return true;
-}
-
-static uint16_t ppp_escape_byte(uint8_t byte, int *offset)
-{
-	if (byte == 0x7e || byte == 0x7d || byte < 0x20) {
-		*offset = 0;
-		return (0x7d << 8) | (byte ^ 0x20);
-	}
-
-	*offset = 1;
-	return byte;
-}
-
 static int ppp_send(struct device *dev, struct net_pkt *pkt)
 {
 	struct ppp_driver_context *ppp = dev->data;
@@ -543,9 +616,10 @@ static int ppp_send(struct device *dev, struct net_pkt *pkt)
 	uint16_t protocol = 0;
 	int send_off = 0;
 	uint32_t sync_addr_ctrl;
-	uint16_t fcs, escaped;
+	uint16_t addr_ctrl;
+	uint16_t fcs;
+	uint8_t fcs_bytes[2];
 	uint8_t byte;
-	int i, offset;
 
 #if defined(CONFIG_NET_TEST)
 	return 0;
@@ -571,9 +645,10 @@ static int ppp_send(struct device *dev, struct net_pkt *pkt)
 		}
 	}
 
-	if (!calc_fcs(pkt, &fcs, protocol)) {
-		return -ENOMEM;
-	}
+	/* HDLC Address and Control fields are part of the FCS */
+	addr_ctrl = sys_cpu_to_be16(0xff << 8 | 0x03);
+	fcs = crc16_ccitt(0xffff, (const uint8_t *)&addr_ctrl,
+			  sizeof(addr_ctrl));
 
 	/* Sync, Address & Control fields */
 	sync_addr_ctrl = sys_cpu_to_be32(0x7e << 24 | 0xff << 16 |
@@ -582,15 +657,10 @@ static int ppp_send(struct device *dev, struct net_pkt *pkt)
 				  sizeof(sync_addr_ctrl), send_off);
 
 	if (protocol > 0) {
-		escaped = htons(ppp_escape_byte(protocol, &offset));
-		send_off = ppp_send_bytes(ppp, (uint8_t *)&escaped + offset,
-					  offset ? 1 : 2,
-					  send_off);
-
-		escaped = htons(ppp_escape_byte(protocol >> 8, &offset));
-		send_off = ppp_send_bytes(ppp, (uint8_t *)&escaped + offset,
-					  offset ? 1 : 2,
-					  send_off);
+		fcs = crc16_ccitt(fcs, (const uint8_t *)&protocol,
+				  sizeof(protocol));
+		send_off = ppp_send_escaped(ppp, (const uint8_t *)&protocol,
+					    sizeof(protocol), send_off);
 	}
 
 	/* Note that we do not print the first four bytes and FCS bytes at the
@@ -601,28 +671,20 @@ static int ppp_send(struct device *dev, struct net_pkt *pkt)
 		net_pkt_hexdump(pkt, "send ppp");
 	}
 
+	/* The FCS is calculated on the fragment while it is still hot in
+	 * the cache, right before it is escaped.
+	 */
 	while (buf) {
-		for (i = 0; i < buf->len; i++) {
-			/* Escape illegal bytes */
-			escaped = htons(ppp_escape_byte(buf->data[i], &offset));
-			send_off = ppp_send_bytes(ppp,
-						  (uint8_t *)&escaped + offset,
-						  offset ? 1 : 2,
-						  send_off);
-		}
-
+		fcs = crc16_ccitt(fcs, buf->data, buf->len);
+		send_off = ppp_send_escaped(ppp, buf->data, buf->len,
+					    send_off);
 		buf = buf->frags;
 	}
 
-	escaped = htons(ppp_escape_byte(fcs, &offset));
-	send_off = ppp_send_bytes(ppp, (uint8_t *)&escaped + offset,
-				  offset ? 1 : 2,
-				  send_off);
-
-	escaped = htons(ppp_escape_byte(fcs >> 8, &offset));
-	send_off = ppp_send_bytes(ppp, (uint8_t *)&escaped + offset,
-				  offset ? 1 : 2,
-				  send_off);
+	fcs ^= 0xffff;
+	sys_put_le16(fcs, fcs_bytes);
+	send_off = ppp_send_escaped(ppp, fcs_bytes, sizeof(fcs_bytes),
+				    send_off);
 
 	byte = 0x7e;
 	send_off = ppp_send_bytes(ppp, &byte, 1, send_off);
@@ -636,7 +698,7 @@ static int ppp_send(struct device *dev, struct net_pkt *pkt)
 static int ppp_consume_ringbuf(struct ppp_driver_context *ppp)
 {
 	uint8_t *data;
-	size_t len, tmp;
+	size_t len;
 	int ret;
 
 	len = ring_buf_get_claim(&ppp->rx_ringbuf, &data,
@@ -651,16 +713,7 @@ static int ppp_consume_ringbuf(struct ppp_driver_context *ppp)
 		LOG_HEXDUMP_DBG(data, len, ppp->dev->name);
 	}
 
-	tmp = len;
-
-	do {
-		if (ppp_input_byte(ppp, *data++) == 0) {
-			/* Ignore empty or too short frames */
-			if (ppp->pkt && net_pkt_get_len(ppp->pkt) > 3) {
-				ppp_process_msg(ppp);
-			}
-		}
-	} while (--tmp);
+	ppp_input(ppp, data, len);
 
 	ret = ring_buf_get_finish(&ppp->rx_ringbuf, len);
 	if (ret < 0) {
@@ -691,6 +744,9 @@ static int ppp_driver_init(struct device *dev)
 #if !defined(CONFIG_NET_TEST)
 	ring_buf_init(&ppp->rx_ringbuf, sizeof(ppp->rx_buf), ppp->rx_buf);
 	k_work_init(&ppp->cb_work, ppp_isr_cb_work);
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+	k_sem_init(&ppp->tx_sem, 1, 1);
+#endif
 
 	k_work_q_start(&ppp->cb_workq, ppp_workq,
 		       K_KERNEL_STACK_SIZEOF(ppp_workq),
@@ -775,6 +831,52 @@ static struct net_stats_ppp *ppp_get_stats(struct device *dev)
 #endif
 
 #if !defined(CONFIG_NET_TEST)
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+static void ppp_uart_callback(struct device *uart, struct uart_event *evt,
+			      void *user_data)
+{
+	struct ppp_driver_context *context = user_data;
+	int ret;
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+	case UART_TX_ABORTED:
+		k_sem_give(&context->tx_sem);
+		break;
+
+	case UART_RX_RDY:
+		ret = ring_buf_put(&context->rx_ringbuf,
+				   evt->data.rx.buf + evt->data.rx.offset,
+				   evt->data.rx.len);
+		if (ret < evt->data.rx.len) {
+			LOG_ERR("Rx buffer doesn't have enough space. "
+				"Bytes pending: %zu, written: %d",
+				evt->data.rx.len, ret);
+		}
+
+		k_work_submit_to_queue(&context->cb_workq, &context->cb_work);
+		break;
+
+	case UART_RX_BUF_REQUEST:
+		(void)uart_rx_buf_rsp(uart,
+			context->async_rx_buf[context->async_rx_next],
+			sizeof(context->async_rx_buf[0]));
+		context->async_rx_next ^= 1;
+		break;
+
+	case UART_RX_DISABLED:
+		/* Restart reception, e.g. after a line error */
+		context->async_rx_next = 1;
+		(void)uart_rx_enable(uart, context->async_rx_buf[0],
+				     sizeof(context->async_rx_buf[0]),
+				     CONFIG_NET_PPP_ASYNC_UART_RX_TIMEOUT);
+		break;
+
+	default:
+		break;
+	}
+}
+#else
 static void ppp_uart_flush(struct device *dev)
 {
 	uint8_t c;
@@ -807,6 +909,7 @@ static void ppp_uart_isr(struct device *uart, void *user_data)
 		k_work_submit_to_queue(&context->cb_workq, &context->cb_work);
 	}
 }
+#endif /* CONFIG_NET_PPP_ASYNC_UART */
 #endif /* !CONFIG_NET_TEST */
 
 static int ppp_start(struct device *dev)
@@ -855,12 +958,24 @@ static int ppp_start(struct device *dev)
 			return -ENODEV;
 		}
 
+#if defined(CONFIG_NET_PPP_ASYNC_UART)
+		uart_callback_set(context->dev, ppp_uart_callback, context);
+
+		context->async_rx_next = 1;
+		if (uart_rx_enable(context->dev, context->async_rx_buf[0],
+				   sizeof(context->async_rx_buf[0]),
+				   CONFIG_NET_PPP_ASYNC_UART_RX_TIMEOUT) < 0) {
+			LOG_ERR("Cannot enable async RX on %s", dev_name);
+			return -EIO;
+		}
+#else
 		uart_irq_rx_disable(context->dev);
 		uart_irq_tx_disable(context->dev);
 		ppp_uart_flush(context->dev);
 		uart_irq_callback_user_data_set(context->dev, ppp_uart_isr,
 						context);
 		uart_irq_rx_enable(context->dev);
+#endif
 	}
 #endif /* !CONFIG_NET_TEST */
 
@@ -36,8 +36,8 @@ static const uint32_t lis2dh_reg_val_to_scale[] = {
 #endif
 };
 
-static void lis2dh_convert(int16_t raw_val, uint32_t scale,
-			   struct sensor_value *val)
+void lis2dh_convert(int16_t raw_val, uint32_t scale,
+		    struct sensor_value *val)
 {
 	int32_t converted_val;
 
@@ -52,6 +52,25 @@ static void lis2dh_convert(int16_t raw_val, uint32_t scale,
 	val->val2 = converted_val % 1000000;
 }
 
+/* Time between two samples for the ODR set in ctrl1, 0 if powered down */
+uint32_t lis2dh_sample_period_ns(uint8_t ctrl1)
+{
+	/* 1620 is low power only, 1344 is 5376 in low power */
+	static const uint16_t odr_hz[] = {0, 1, 10, 25, 50, 100, 200, 400,
+					  1620, 1344};
+	uint8_t odr = (ctrl1 & LIS2DH_ODR_MASK) >> LIS2DH_ODR_SHIFT;
+
+	if ((odr == LIS2DH_ODR_9) && (ctrl1 & LIS2DH_LP_EN_BIT_MASK)) {
+		return NSEC_PER_SEC / 5376U;
+	}
+
+	if ((odr == 0U) || (odr >= ARRAY_SIZE(odr_hz))) {
+		return 0U;
+	}
+
+	return NSEC_PER_SEC / odr_hz[odr];
+}
+
 static int lis2dh_channel_get(struct device *dev,
 			      enum sensor_channel chan,
 			      struct sensor_value *val)
@@ -171,9 +190,13 @@ static int lis2dh_acc_odr_set(struct device *dev, uint16_t freq)
 		odr--;
 	}
 
-	return data->hw_tf->write_reg(dev, LIS2DH_REG_CTRL1,
-				      (value & ~LIS2DH_ODR_MASK) |
-				      LIS2DH_ODR_RATE(odr));
+	value = (value & ~LIS2DH_ODR_MASK) | LIS2DH_ODR_RATE(odr);
+
+#ifdef CONFIG_LIS2DH_FIFO
+	data->fifo_period_ns = lis2dh_sample_period_ns(value);
+#endif
+
+	return data->hw_tf->write_reg(dev, LIS2DH_REG_CTRL1, value);
 }
 #endif
 
@@ -264,6 +287,9 @@ static const struct sensor_driver_api lis2dh_driver_api = {
 #endif
 	.sample_fetch = lis2dh_sample_fetch,
 	.channel_get = lis2dh_channel_get,
+#ifdef CONFIG_LIS2DH_FIFO
+	.fifo_stream = lis2dh_fifo_stream,
+#endif
 };
 
 int lis2dh_init(struct device *dev)
@@ -102,6 +102,8 @@
 #define LIS2DH_REG_CTRL3		0x22
 #define LIS2DH_EN_DRDY1_INT1_SHIFT	4
 #define LIS2DH_EN_DRDY1_INT1		BIT(LIS2DH_EN_DRDY1_INT1_SHIFT)
+#define LIS2DH_EN_WTM_INT1		BIT(2)
+#define LIS2DH_EN_OVR_INT1		BIT(1)
 
 #define LIS2DH_REG_CTRL4		0x23
 #define LIS2DH_FS_SHIFT			4
@@ -127,6 +129,7 @@
 #endif
 
 #define LIS2DH_REG_CTRL5		0x24
+#define LIS2DH_FIFO_EN			BIT(6)
 #define LIS2DH_LIR_INT2_SHIFT		1
 #define LIS2DH_EN_LIR_INT2		BIT(LIS2DH_LIR_INT2_SHIFT)
 
@@ -155,6 +158,22 @@
 #define LIS2DH_REG_ACCEL_Y_MSB		0x2B
 #define LIS2DH_REG_ACCEL_Z_MSB		0x2D
 
+#define LIS2DH_REG_FIFO_CTRL		0x2e
+#define LIS2DH_FIFO_MODE_SHIFT		6
+#define LIS2DH_FIFO_MODE_BYPASS		(0 << LIS2DH_FIFO_MODE_SHIFT)
+#define LIS2DH_FIFO_MODE_STREAM		(2 << LIS2DH_FIFO_MODE_SHIFT)
+#define LIS2DH_FIFO_FTH_MASK		BIT_MASK(5)
+
+#define LIS2DH_REG_FIFO_SRC		0x2f
+#define LIS2DH_FIFO_SRC_WTM		BIT(7)
+#define LIS2DH_FIFO_SRC_OVRN		BIT(6)
+#define LIS2DH_FIFO_SRC_EMPTY		BIT(5)
+#define LIS2DH_FIFO_SRC_FSS_MASK	BIT_MASK(5)
+
+/* FIFO depth, in XYZ frames of 6 bytes */
+#define LIS2DH_FIFO_SIZE		32
+#define LIS2DH_FIFO_FRAME_SZ		6
+
 #define LIS2DH_REG_INT1_CFG		0x30
 #define LIS2DH_REG_INT2_CFG		0x34
 #define LIS2DH_AOI_CFG			BIT(7)
@@ -245,6 +264,12 @@ struct lis2dh_data {
 	atomic_t trig_flags;
 	enum sensor_channel chan_drdy;
 
+#ifdef CONFIG_LIS2DH_FIFO
+	struct sensor_fifo_config fifo;
+	uint32_t fifo_period_ns;
+	bool fifo_enabled;
+#endif
+
 #if defined(CONFIG_LIS2DH_TRIGGER_OWN_THREAD)
 	K_KERNEL_STACK_MEMBER(thread_stack, CONFIG_LIS2DH_THREAD_STACK_SIZE);
 	struct k_thread thread;
@@ -276,6 +301,15 @@ int lis2dh_acc_slope_config(struct device *dev, enum sensor_attribute attr,
 			    const struct sensor_value *val);
 #endif
 
+#ifdef CONFIG_LIS2DH_FIFO
+int lis2dh_fifo_stream(struct device *dev, enum sensor_channel chan,
+		       const struct sensor_fifo_config *config);
+#endif
+
+void lis2dh_convert(int16_t raw_val, uint32_t scale,
+		    struct sensor_value *val);
+uint32_t lis2dh_sample_period_ns(uint8_t ctrl1);
+
 int lis2dh_spi_init(struct device *dev);
 int lis2dh_i2c_init(struct device *dev);
 
@@ -7,11 +7,13 @@
 #define DT_DRV_COMPAT st_lis2dh
 
 #include <sys/util.h>
+#include <sys/byteorder.h>
 #include <kernel.h>
 #include <logging/log.h>
 
 #define START_TRIG_INT1			0
 #define START_TRIG_INT2			1
+#define START_FIFO			2
 #define TRIGGED_INT1			4
 #define TRIGGED_INT2			5
 
@@ -36,6 +38,13 @@ static int lis2dh_trigger_drdy_set(struct device *dev, enum sensor_channel chan,
 	struct lis2dh_data *lis2dh = dev->data;
 	int status;
 
+#ifdef CONFIG_LIS2DH_FIFO
+	/* INT1 signals the FIFO watermark while streaming */
+	if ((handler != NULL) && lis2dh->fifo_enabled) {
+		return -EBUSY;
+	}
+#endif
+
 	setup_int1(dev, false);
 
 	/* cancel potentially pending trigger */
@@ -105,6 +114,195 @@ static int lis2dh_start_trigger_int1(struct device *dev)
 					 LIS2DH_EN_DRDY1_INT1);
 }
 
+#ifdef CONFIG_LIS2DH_FIFO
+#define LIS2DH_FIFO_INT1 (LIS2DH_EN_WTM_INT1 | LIS2DH_EN_OVR_INT1)
+
+/* Size of a frame delivered in the given format */
+static uint16_t lis2dh_fifo_frame_size(enum sensor_fifo_format format)
+{
+	if (format == SENSOR_FIFO_CONVERTED) {
+		return 3 * sizeof(struct sensor_value);
+	}
+
+	return LIS2DH_FIFO_FRAME_SZ;
+}
+
+int lis2dh_fifo_stream(struct device *dev, enum sensor_channel chan,
+		       const struct sensor_fifo_config *config)
+{
+	struct lis2dh_data *lis2dh = dev->data;
+	int status;
+
+	if (chan != SENSOR_CHAN_ACCEL_XYZ) {
+		return -ENOTSUP;
+	}
+
+	if (config != NULL) {
+		if (lis2dh->handler_drdy != NULL) {
+			return -EBUSY;
+		}
+
+		/* the watermark is 5 bits wide */
+		if ((config->handler == NULL) || (config->watermark == 0U) ||
+		    (config->watermark > LIS2DH_FIFO_FTH_MASK) ||
+		    (config->buf_size < config->watermark *
+		     lis2dh_fifo_frame_size(config->format))) {
+			return -EINVAL;
+		}
+	}
+
+	setup_int1(dev, false);
+	lis2dh->fifo_enabled = false;
+
+	/* cancel potentially pending trigger */
+	atomic_clear_bit(&lis2dh->trig_flags, TRIGGED_INT1);
+	atomic_clear_bit(&lis2dh->trig_flags, START_FIFO);
+
+	status = lis2dh->hw_tf->update_reg(dev, LIS2DH_REG_CTRL3,
+					   LIS2DH_FIFO_INT1, 0);
+	if (status < 0) {
+		return status;
+	}
+
+	/* bypass mode empties the FIFO */
+	status = lis2dh->hw_tf->write_reg(dev, LIS2DH_REG_FIFO_CTRL,
+					  LIS2DH_FIFO_MODE_BYPASS);
+	if (status < 0) {
+		return status;
+	}
+
+	status = lis2dh->hw_tf->update_reg(dev, LIS2DH_REG_CTRL5,
+					   LIS2DH_FIFO_EN, 0);
+	if ((config == NULL) || (status < 0)) {
+		return status;
+	}
+
+	lis2dh->fifo = *config;
+	lis2dh->fifo_enabled = true;
+
+	/* serialize start of the FIFO in thread, as for the triggers */
+	atomic_set_bit(&lis2dh->trig_flags, START_FIFO);
+#if defined(CONFIG_LIS2DH_TRIGGER_OWN_THREAD)
+	k_sem_give(&lis2dh->gpio_sem);
+#elif defined(CONFIG_LIS2DH_TRIGGER_GLOBAL_THREAD)
+	k_work_submit(&lis2dh->work);
+#endif
+
+	return 0;
+}
+
+static int lis2dh_start_fifo(struct device *dev)
+{
+	struct lis2dh_data *lis2dh = dev->data;
+	uint8_t ctrl1;
+	int status;
+
+	status = lis2dh->hw_tf->read_reg(dev, LIS2DH_REG_CTRL1, &ctrl1);
+	if (unlikely(status < 0)) {
+		return status;
+	}
+
+	lis2dh->fifo_period_ns = lis2dh_sample_period_ns(ctrl1);
+
+	status = lis2dh->hw_tf->update_reg(dev, LIS2DH_REG_CTRL5,
+					   LIS2DH_FIFO_EN, LIS2DH_FIFO_EN);
+	if (unlikely(status < 0)) {
+		return status;
+	}
+
+	status = lis2dh->hw_tf->write_reg(dev, LIS2DH_REG_FIFO_CTRL,
+					  LIS2DH_FIFO_MODE_STREAM |
+					  lis2dh->fifo.watermark);
+	if (unlikely(status < 0)) {
+		return status;
+	}
+
+	setup_int1(dev, true);
+
+	return lis2dh->hw_tf->update_reg(dev, LIS2DH_REG_CTRL3,
+					 LIS2DH_FIFO_INT1, LIS2DH_FIFO_INT1);
+}
+
+/* Convert count raw frames at raw to the start of the user buffer. */
+static void lis2dh_fifo_convert(struct lis2dh_data *lis2dh,
+				const uint8_t *raw, uint16_t count)
+{
+	struct sensor_value *val = lis2dh->fifo.buf;
+	int16_t xyz[3];
+
+	/*
+	 * The raw frames are at the end of the buffer. Converting front to
+	 * back, a converted frame only overwrites raw frames already read.
+	 */
+	for (uint16_t i = 0; i < count; i++) {
+		for (int j = 0; j < 3; j++) {
+			xyz[j] = (int16_t)sys_get_le16(&raw[j * 2]);
+		}
+		raw += LIS2DH_FIFO_FRAME_SZ;
+
+		for (int j = 0; j < 3; j++) {
+			lis2dh_convert(xyz[j], lis2dh->scale, val++);
+		}
+	}
+}
+
+static void lis2dh_fifo_drain(struct device *dev)
+{
+	struct lis2dh_data *lis2dh = dev->data;
+	const struct sensor_fifo_config *cfg = &lis2dh->fifo;
+	struct sensor_fifo_frames frames = {
+		.buf = cfg->buf,
+		.frame_size = lis2dh_fifo_frame_size(cfg->format),
+		.period_ns = lis2dh->fifo_period_ns,
+	};
+	uint64_t timestamp_ns;
+	uint16_t left;
+	uint16_t max;
+	uint8_t *raw;
+	uint8_t src;
+	int status;
+
+	status = lis2dh->hw_tf->read_reg(dev, LIS2DH_REG_FIFO_SRC, &src);
+	if (status < 0) {
+		LOG_ERR("Could not read FIFO status: %d", status);
+		return;
+	}
+
+	/* the last frame is at most one period older than this */
+	timestamp_ns = k_ticks_to_ns_floor64(k_uptime_ticks());
+
+	frames.overrun = (src & LIS2DH_FIFO_SRC_OVRN) != 0U;
+	left = frames.overrun ? LIS2DH_FIFO_SIZE :
+				(src & LIS2DH_FIFO_SRC_FSS_MASK);
+	max = cfg->buf_size / frames.frame_size;
+
+	while (left > 0U) {
+		frames.count = MIN(left, max);
+		left -= frames.count;
+
+		/* the burst read wraps from OUT_Z_H back to OUT_X_L */
+		raw = (uint8_t *)cfg->buf + frames.count *
+		      (frames.frame_size - LIS2DH_FIFO_FRAME_SZ);
+		status = lis2dh->hw_tf->read_data(dev, LIS2DH_REG_ACCEL_X_LSB,
+						  raw, frames.count *
+						  LIS2DH_FIFO_FRAME_SZ);
+		if (status < 0) {
+			LOG_ERR("Could not read FIFO: %d", status);
+			return;
+		}
+
+		if (cfg->format == SENSOR_FIFO_CONVERTED) {
+			lis2dh_fifo_convert(lis2dh, raw, frames.count);
+		}
+
+		frames.timestamp_ns = timestamp_ns -
+				      (uint64_t)left * frames.period_ns;
+		cfg->handler(dev, &frames);
+		frames.overrun = false;
+	}
+}
+#endif /* CONFIG_LIS2DH_FIFO */
+
 #if DT_INST_PROP_HAS_IDX(0, irq_gpios, 1)
 #define LIS2DH_ANYM_CFG (LIS2DH_INT_CFG_ZHIE_ZUPE | LIS2DH_INT_CFG_YHIE_YUPE |\
 			 LIS2DH_INT_CFG_XHIE_XUPE)
@@ -288,6 +486,18 @@ static void lis2dh_thread_cb(void *arg)
 		return;
 	}
 
+#ifdef CONFIG_LIS2DH_FIFO
+	if (unlikely(atomic_test_and_clear_bit(&lis2dh->trig_flags,
+		     START_FIFO))) {
+		status = lis2dh_start_fifo(dev);
+
+		if (unlikely(status < 0)) {
+			LOG_ERR("lis2dh_start_fifo: %d", status);
+		}
+		return;
+	}
+#endif /* CONFIG_LIS2DH_FIFO */
+
 #if DT_INST_PROP_HAS_IDX(0, irq_gpios, 1)
 	if (unlikely(atomic_test_and_clear_bit(&lis2dh->trig_flags,
 		     START_TRIG_INT2))) {
@@ -307,6 +517,13 @@ static void lis2dh_thread_cb(void *arg)
 			.chan = lis2dh->chan_drdy,
 		};
 
+#ifdef CONFIG_LIS2DH_FIFO
+		if (lis2dh->fifo_enabled) {
+			lis2dh_fifo_drain(dev);
+			return;
+		}
+#endif
+
 		if (likely(lis2dh->handler_drdy != NULL)) {
 			lis2dh->handler_drdy(dev, &drdy_trigger);
 		}
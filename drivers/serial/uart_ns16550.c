@@ -98,6 +98,7 @@ BUILD_ASSERT(IS_ENABLED(CONFIG_PCIE), "NS16550(s) in DT need CONFIG_PCIE");
 #define IIR_LS    0x06 /* receiver line status interrupt */
 #define IIR_MASK  0x07 /* interrupt id bits mask  */
 #define IIR_ID    0x06 /* interrupt ID mask without NIP */
+#define IIR_TOUT  0x08 /* character timeout, along with IIR_RBRF */
 
 /* equates for FIFO control register */
 
@@ -153,6 +154,22 @@ BUILD_ASSERT(IS_ENABLED(CONFIG_PCIE), "NS16550(s) in DT need CONFIG_PCIE");
  */
 #define FCR_FIFO_64 0x20 /* Enable 64 bytes FIFO */
 
+#if defined(CONFIG_UART_NS16550_RX_FIFO_TRIGGER_1)
+#define FCR_FIFO_TRIGGER FCR_FIFO_1
+#elif defined(CONFIG_UART_NS16550_RX_FIFO_TRIGGER_4)
+#define FCR_FIFO_TRIGGER FCR_FIFO_4
+#elif defined(CONFIG_UART_NS16550_RX_FIFO_TRIGGER_14)
+#define FCR_FIFO_TRIGGER FCR_FIFO_14
+#else
+#define FCR_FIFO_TRIGGER FCR_FIFO_8
+#endif
+
+#ifdef CONFIG_UART_NS16750
+#define TX_FIFO_SIZE 64
+#else
+#define TX_FIFO_SIZE 16
+#endif
+
 /* constants for line control register */
 
 #define LCR_CS5 0x00   /* 5 bits data size */
@@ -292,6 +309,26 @@ struct uart_ns16550_dev_data_t {
 #ifdef UART_NS16550_DLF_ENABLED
 	uint8_t dlf;		/**< DLF value */
 #endif
+
+#ifdef CONFIG_UART_ASYNC_API
+	struct device *dev;
+	uart_callback_t async_cb;	/**< Async callback function pointer */
+	void *async_cb_data;	/**< Async callback function arg */
+
+	const uint8_t *tx_buf;
+	size_t tx_len;		/**< 0 if no transmission is ongoing */
+	size_t tx_pos;
+	struct k_delayed_work tx_timeout_work;
+
+	uint8_t *rx_buf;	/**< NULL if reception is disabled */
+	size_t rx_len;
+	size_t rx_pos;
+	size_t rx_offset;	/**< first byte not reported yet */
+	uint8_t *rx_next_buf;
+	size_t rx_next_len;
+	int32_t rx_timeout;
+	struct k_delayed_work rx_timeout_work;
+#endif
 };
 
 static const struct uart_driver_api uart_ns16550_driver_api;
@@ -454,11 +491,12 @@ static int uart_ns16550_configure(struct device *dev,
 
 	/*
 	 * Program FIFO: enabled, mode 0 (set for compatibility with quark),
-	 * generate the interrupt at 8th byte
+	 * generate the interrupt at the configured trigger level
 	 * Clear TX and RX FIFO
 	 */
 	OUTBYTE(FCR(dev),
-		FCR_FIFO | FCR_MODE0 | FCR_FIFO_8 | FCR_RCVRCLR | FCR_XMITCLR
+		FCR_FIFO | FCR_MODE0 | FCR_FIFO_TRIGGER | FCR_RCVRCLR |
+		FCR_XMITCLR
 #ifdef CONFIG_UART_NS16750
 		| FCR_FIFO_64
 #endif
@@ -488,6 +526,400 @@ static int uart_ns16550_config_get(struct device *dev, struct uart_config *cfg)
 	return 0;
 }
 
+#ifdef CONFIG_UART_ASYNC_API
+
+/*
+ * The asynchronous API is interrupt driven: the receiver interrupt is raised
+ * at the FIFO trigger level, or by the character timeout once the line is
+ * idle, and each interrupt moves a whole FIFO worth of data. The callbacks
+ * run with interrupts locked, as the state is shared with the ISR.
+ */
+
+static void ier_set(struct device *dev, uint8_t bits, bool enable)
+{
+	k_spinlock_key_t key = k_spin_lock(&DEV_DATA(dev)->lock);
+	uint8_t ier = INBYTE(IER(dev));
+
+	OUTBYTE(IER(dev), enable ? (ier | bits) : (ier & ~bits));
+
+	k_spin_unlock(&DEV_DATA(dev)->lock, key);
+}
+
+static void async_user_callback(struct uart_ns16550_dev_data_t *dev_data,
+				struct uart_event *evt)
+{
+	if (dev_data->async_cb) {
+		dev_data->async_cb(dev_data->dev, evt, dev_data->async_cb_data);
+	}
+}
+
+static void async_tx_end(struct uart_ns16550_dev_data_t *dev_data,
+			 enum uart_event_type type)
+{
+	struct uart_event evt = {
+		.type = type,
+		.data.tx = {
+			.buf = dev_data->tx_buf,
+			.len = dev_data->tx_pos,
+		},
+	};
+
+	(void)k_delayed_work_cancel(&dev_data->tx_timeout_work);
+
+	/* a new transfer may be started from the callback */
+	dev_data->tx_buf = NULL;
+	dev_data->tx_len = 0U;
+
+	async_user_callback(dev_data, &evt);
+}
+
+/* Report the bytes received since the last report. */
+static void async_rx_rdy(struct uart_ns16550_dev_data_t *dev_data)
+{
+	struct uart_event evt = {
+		.type = UART_RX_RDY,
+		.data.rx = {
+			.buf = dev_data->rx_buf,
+			.offset = dev_data->rx_offset,
+			.len = dev_data->rx_pos - dev_data->rx_offset,
+		},
+	};
+
+	if (evt.data.rx.len == 0U) {
+		return;
+	}
+
+	dev_data->rx_offset = dev_data->rx_pos;
+	async_user_callback(dev_data, &evt);
+}
+
+static void async_rx_buf_release(struct uart_ns16550_dev_data_t *dev_data,
+				 uint8_t *buf)
+{
+	struct uart_event evt = {
+		.type = UART_RX_BUF_RELEASED,
+		.data.rx_buf.buf = buf,
+	};
+
+	async_user_callback(dev_data, &evt);
+}
+
+static void async_rx_buf_request(struct uart_ns16550_dev_data_t *dev_data)
+{
+	struct uart_event evt = {
+		.type = UART_RX_BUF_REQUEST,
+	};
+
+	async_user_callback(dev_data, &evt);
+}
+
+static int uart_ns16550_callback_set(struct device *dev,
+				     uart_callback_t callback,
+				     void *user_data)
+{
+	struct uart_ns16550_dev_data_t * const dev_data = DEV_DATA(dev);
+	unsigned int key = irq_lock();
+
+	dev_data->async_cb = callback;
+	dev_data->async_cb_data = user_data;
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+static int uart_ns16550_tx(struct device *dev, const uint8_t *buf,
+			   size_t len, int32_t timeout)
+{
+	struct uart_ns16550_dev_data_t * const dev_data = DEV_DATA(dev);
+	unsigned int key;
+
+	if (len == 0U) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+
+	if (dev_data->tx_len != 0U) {
+		irq_unlock(key);
+		return -EBUSY;
+	}
+
+	dev_data->tx_buf = buf;
+	dev_data->tx_len = len;
+	dev_data->tx_pos = 0U;
+
+	if (timeout != SYS_FOREVER_MS) {
+		k_delayed_work_submit(&dev_data->tx_timeout_work,
+				      K_MSEC(timeout));
+	}
+
+	/* Raised right away, the transmitter FIFO being empty */
+	ier_set(dev, IER_TBE, true);
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+static int uart_ns16550_tx_abort(struct device *dev)
+{
+	struct uart_ns16550_dev_data_t * const dev_data = DEV_DATA(dev);
+	unsigned int key = irq_lock();
+
+	if (dev_data->tx_len == 0U) {
+		irq_unlock(key);
+		return -EFAULT;
+	}
+
+	ier_set(dev, IER_TBE, false);
+	async_tx_end(dev_data, UART_TX_ABORTED);
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+static void uart_ns16550_tx_timeout(struct k_work *work)
+{
+	struct uart_ns16550_dev_data_t *dev_data =
+		CONTAINER_OF(work, struct uart_ns16550_dev_data_t,
+			     tx_timeout_work);
+
+	(void)uart_ns16550_tx_abort(dev_data->dev);
+}
+
+static int uart_ns16550_rx_enable(struct device *dev, uint8_t *buf,
+				  size_t len, int32_t timeout)
+{
+	struct uart_ns16550_dev_data_t * const dev_data = DEV_DATA(dev);
+	unsigned int key;
+
+	if (len == 0U) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+
+	if (dev_data->rx_buf != NULL) {
+		irq_unlock(key);
+		return -EBUSY;
+	}
+
+	dev_data->rx_buf = buf;
+	dev_data->rx_len = len;
+	dev_data->rx_pos = 0U;
+	dev_data->rx_offset = 0U;
+	dev_data->rx_timeout = timeout;
+
+	ier_set(dev, IER_RXRDY | IER_LSR, true);
+
+	async_rx_buf_request(dev_data);
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+static int uart_ns16550_rx_buf_rsp(struct device *dev, uint8_t *buf,
+				   size_t len)
+{
+	struct uart_ns16550_dev_data_t * const dev_data = DEV_DATA(dev);
+	unsigned int key = irq_lock();
+	int ret = 0;
+
+	if (dev_data->rx_buf == NULL) {
+		ret = -EACCES;
+	} else if (dev_data->rx_next_buf != NULL) {
+		ret = -EBUSY;
+	} else {
+		dev_data->rx_next_buf = buf;
+		dev_data->rx_next_len = len;
+	}
+
+	irq_unlock(key);
+
+	return ret;
+}
+
+static int uart_ns16550_rx_disable(struct device *dev)
+{
+	struct uart_ns16550_dev_data_t * const dev_data = DEV_DATA(dev);
+	struct uart_event evt = {
+		.type = UART_RX_DISABLED,
+	};
+	unsigned int key = irq_lock();
+
+	if (dev_data->rx_buf == NULL) {
+		irq_unlock(key);
+		return -EFAULT;
+	}
+
+	ier_set(dev, IER_RXRDY | IER_LSR, false);
+	(void)k_delayed_work_cancel(&dev_data->rx_timeout_work);
+
+	async_rx_rdy(dev_data);
+	async_rx_buf_release(dev_data, dev_data->rx_buf);
+	if (dev_data->rx_next_buf != NULL) {
+		async_rx_buf_release(dev_data, dev_data->rx_next_buf);
+	}
+
+	dev_data->rx_buf = NULL;
+	dev_data->rx_next_buf = NULL;
+
+	async_user_callback(dev_data, &evt);
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+static void uart_ns16550_rx_timeout(struct k_work *work)
+{
+	struct uart_ns16550_dev_data_t *dev_data =
+		CONTAINER_OF(work, struct uart_ns16550_dev_data_t,
+			     rx_timeout_work);
+	unsigned int key = irq_lock();
+
+	if (dev_data->rx_buf != NULL) {
+		async_rx_rdy(dev_data);
+	}
+
+	irq_unlock(key);
+}
+
+static void async_rx_buf_full(struct device *dev)
+{
+	struct uart_ns16550_dev_data_t * const dev_data = DEV_DATA(dev);
+
+	(void)k_delayed_work_cancel(&dev_data->rx_timeout_work);
+	async_rx_rdy(dev_data);
+
+	if (dev_data->rx_next_buf == NULL) {
+		(void)uart_ns16550_rx_disable(dev);
+		return;
+	}
+
+	async_rx_buf_release(dev_data, dev_data->rx_buf);
+
+	dev_data->rx_buf = dev_data->rx_next_buf;
+	dev_data->rx_len = dev_data->rx_next_len;
+	dev_data->rx_pos = 0U;
+	dev_data->rx_offset = 0U;
+	dev_data->rx_next_buf = NULL;
+
+	async_rx_buf_request(dev_data);
+}
+
+static void async_rx_isr(struct device *dev, bool line_idle)
+{
+	struct uart_ns16550_dev_data_t * const dev_data = DEV_DATA(dev);
+
+	while ((dev_data->rx_buf != NULL) &&
+	       ((INBYTE(LSR(dev)) & LSR_RXRDY) != 0)) {
+		dev_data->rx_buf[dev_data->rx_pos++] = INBYTE(RDR(dev));
+
+		if (dev_data->rx_pos == dev_data->rx_len) {
+			async_rx_buf_full(dev);
+		}
+	}
+
+	if (!line_idle || (dev_data->rx_buf == NULL)) {
+		return;
+	}
+
+	if (dev_data->rx_timeout == 0) {
+		async_rx_rdy(dev_data);
+	} else if (dev_data->rx_timeout != SYS_FOREVER_MS) {
+		k_delayed_work_submit(&dev_data->rx_timeout_work,
+				      K_MSEC(dev_data->rx_timeout));
+	}
+}
+
+static void async_err_isr(struct device *dev)
+{
+	struct uart_ns16550_dev_data_t * const dev_data = DEV_DATA(dev);
+	int err = (INBYTE(LSR(dev)) & LSR_EOB_MASK) >> 1;
+	struct uart_event evt = {
+		.type = UART_RX_STOPPED,
+		.data.rx_stop = {
+			.reason = err,
+			.data = {
+				.buf = dev_data->rx_buf,
+				.offset = 0U,
+				.len = dev_data->rx_pos,
+			},
+		},
+	};
+
+	if ((err == 0) || (dev_data->rx_buf == NULL)) {
+		return;
+	}
+
+	async_rx_rdy(dev_data);
+	async_user_callback(dev_data, &evt);
+	(void)uart_ns16550_rx_disable(dev);
+}
+
+static void async_tx_isr(struct device *dev)
+{
+	struct uart_ns16550_dev_data_t * const dev_data = DEV_DATA(dev);
+	size_t n;
+
+	if (dev_data->tx_len == 0U) {
+		ier_set(dev, IER_TBE, false);
+		return;
+	}
+
+	if (dev_data->tx_pos == dev_data->tx_len) {
+		ier_set(dev, IER_TBE, false);
+		async_tx_end(dev_data, UART_TX_DONE);
+		return;
+	}
+
+	/* The FIFO is empty, fill it up at once */
+	n = MIN(TX_FIFO_SIZE, dev_data->tx_len - dev_data->tx_pos);
+	for (size_t i = 0; i < n; i++) {
+		OUTBYTE(THR(dev), dev_data->tx_buf[dev_data->tx_pos++]);
+	}
+}
+
+static void uart_ns16550_async_isr(struct device *dev)
+{
+	uint8_t iir;
+
+	while (((iir = INBYTE(IIR(dev))) & IIR_NIP) == 0) {
+		switch (iir & IIR_ID) {
+		case IIR_LS:
+			async_err_isr(dev);
+			break;
+		case IIR_RBRF:
+			async_rx_isr(dev, (iir & IIR_TOUT) != 0);
+			break;
+		case IIR_THRE:
+			async_tx_isr(dev);
+			break;
+		default:
+			/* modem status, cleared by reading it */
+			(void)INBYTE(MSR(dev));
+			break;
+		}
+	}
+}
+
+static void uart_ns16550_async_init(struct device *dev)
+{
+	struct uart_ns16550_dev_data_t * const dev_data = DEV_DATA(dev);
+
+	dev_data->dev = dev;
+	k_delayed_work_init(&dev_data->tx_timeout_work,
+			    uart_ns16550_tx_timeout);
+	k_delayed_work_init(&dev_data->rx_timeout_work,
+			    uart_ns16550_rx_timeout);
+}
+
+#endif /* CONFIG_UART_ASYNC_API */
+
 /**
  * @brief Initialize individual UART port
  *
@@ -506,7 +938,11 @@ static int uart_ns16550_init(struct device *dev)
 		return ret;
 	}
 
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#ifdef CONFIG_UART_ASYNC_API
+	uart_ns16550_async_init(dev);
+#endif
+
+#if defined(CONFIG_UART_INTERRUPT_DRIVEN) || defined(CONFIG_UART_ASYNC_API)
 	DEV_CFG(dev)->irq_config_func(dev);
 #endif
 
@@ -838,10 +1274,14 @@ static void uart_ns16550_irq_callback_set(struct device *dev,
 	k_spin_unlock(&dev_data->lock, key);
 }
 
+#endif /* CONFIG_UART_INTERRUPT_DRIVEN */
+
+#if defined(CONFIG_UART_INTERRUPT_DRIVEN) || defined(CONFIG_UART_ASYNC_API)
 /**
  * @brief Interrupt service routine.
  *
- * This simply calls the callback function, if one exists.
+ * This calls the interrupt-driven callback if one exists, and handles the
+ * asynchronous transfers otherwise.
  *
  * @param arg Argument to ISR.
  *
@@ -852,13 +1292,20 @@ static void uart_ns16550_isr(void *arg)
 	struct device *dev = arg;
 	struct uart_ns16550_dev_data_t * const dev_data = DEV_DATA(dev);
 
+	ARG_UNUSED(dev_data);
+
+#ifdef CONFIG_UART_INTERRUPT_DRIVEN
 	if (dev_data->cb) {
 		dev_data->cb(dev, dev_data->cb_data);
+		return;
 	}
+#endif
 
+#ifdef CONFIG_UART_ASYNC_API
+	uart_ns16550_async_isr(dev);
+#endif
 }
-
-#endif /* CONFIG_UART_INTERRUPT_DRIVEN */
+#endif
 
 #ifdef CONFIG_UART_NS16550_LINE_CTRL
 
@@ -964,6 +1411,15 @@ static const struct uart_driver_api uart_ns16550_driver_api = {
 
 #endif
 
+#ifdef CONFIG_UART_ASYNC_API
+	.callback_set = uart_ns16550_callback_set,
+	.tx = uart_ns16550_tx,
+	.tx_abort = uart_ns16550_tx_abort,
+	.rx_enable = uart_ns16550_rx_enable,
+	.rx_buf_rsp = uart_ns16550_rx_buf_rsp,
+	.rx_disable = uart_ns16550_rx_disable,
+#endif
+
 #ifdef CONFIG_UART_NS16550_LINE_CTRL
 	.line_ctrl_set = uart_ns16550_line_ctrl_set,
 #endif
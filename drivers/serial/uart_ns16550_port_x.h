@@ -9,7 +9,7 @@
 
 #if DT_NODE_HAS_STATUS(DT_DRV_INST(@NUM@), okay)
 
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#if defined(CONFIG_UART_INTERRUPT_DRIVEN) || defined(CONFIG_UART_ASYNC_API)
 static void irq_config_func_@NUM@(struct device *port);
 #endif
 
@@ -21,7 +21,7 @@ static const struct uart_ns16550_device_config uart_ns16550_dev_cfg_@NUM@ = {
 #endif
 	.sys_clk_freq = DT_INST_PROP(@NUM@, clock_frequency),
 
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#if defined(CONFIG_UART_INTERRUPT_DRIVEN) || defined(CONFIG_UART_ASYNC_API)
 	.irq_config_func = irq_config_func_@NUM@,
 #endif
 
@@ -65,7 +65,7 @@ DEVICE_AND_API_INIT(uart_ns16550_@NUM@, DT_INST_LABEL(@NUM@),
 #define INST_@NUM@_IRQ_FLAGS 0
 #endif
 
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#if defined(CONFIG_UART_INTERRUPT_DRIVEN) || defined(CONFIG_UART_ASYNC_API)
 static void irq_config_func_@NUM@(struct device *dev)
 {
 	ARG_UNUSED(dev);
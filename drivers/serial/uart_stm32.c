@@ -24,6 +24,11 @@
 
 #include <linker/sections.h>
 #include <drivers/clock_control/stm32_clock_control.h>
+#ifdef CONFIG_UART_ASYNC_API
+#include <string.h>
+#include <dt-bindings/dma/stm32_dma.h>
+#include <drivers/dma.h>
+#endif
 #include "uart_stm32.h"
 
 #include <logging/log.h>
@@ -609,17 +614,511 @@ static void uart_stm32_irq_callback_set(struct device *dev,
 	data->user_data = cb_data;
 }
 
+#endif /* CONFIG_UART_INTERRUPT_DRIVEN */
+
+#ifdef CONFIG_UART_ASYNC_API
+
+/* Address of the data register, for the DMA */
+#ifdef LL_USART_DMA_REG_DATA_TRANSMIT
+#define UART_DMA_TX_REG(uart)						\
+	LL_USART_DMA_GetRegAddr(uart, LL_USART_DMA_REG_DATA_TRANSMIT)
+#define UART_DMA_RX_REG(uart)						\
+	LL_USART_DMA_GetRegAddr(uart, LL_USART_DMA_REG_DATA_RECEIVE)
+#else
+#define UART_DMA_TX_REG(uart) LL_USART_DMA_GetRegAddr(uart)
+#define UART_DMA_RX_REG(uart) LL_USART_DMA_GetRegAddr(uart)
+#endif
+
+static inline void async_user_callback(struct uart_stm32_data *data,
+				       struct uart_event *event)
+{
+	if (data->async_cb) {
+		data->async_cb(data->dev, event, data->async_user_data);
+	}
+}
+
+static inline void async_evt_rx_rdy(struct uart_stm32_data *data)
+{
+	struct uart_event event = {
+		.type = UART_RX_RDY,
+		.data.rx.buf = data->dma_rx.buffer,
+		.data.rx.offset = data->dma_rx.offset,
+		.data.rx.len = data->dma_rx.counter - data->dma_rx.offset,
+	};
+
+	/* only report the data received since the last event */
+	data->dma_rx.offset = data->dma_rx.counter;
+
+	if (event.data.rx.len > 0) {
+		async_user_callback(data, &event);
+	}
+}
+
+static inline void async_evt_rx_buf_request(struct uart_stm32_data *data)
+{
+	struct uart_event event = {
+		.type = UART_RX_BUF_REQUEST,
+	};
+
+	async_user_callback(data, &event);
+}
+
+static inline void async_evt_rx_buf_release(struct uart_stm32_data *data,
+					    uint8_t *buf)
+{
+	struct uart_event event = {
+		.type = UART_RX_BUF_RELEASED,
+		.data.rx_buf.buf = buf,
+	};
+
+	async_user_callback(data, &event);
+}
+
+static inline void async_evt_tx(struct uart_stm32_data *data,
+				enum uart_event_type type)
+{
+	struct uart_event event = {
+		.type = type,
+		.data.tx.buf = data->dma_tx.buffer,
+		.data.tx.len = data->dma_tx.counter,
+	};
+
+	/* a new transfer may be started from the callback */
+	data->dma_tx.buffer_length = 0;
+	data->dma_tx.counter = 0;
+
+	async_user_callback(data, &event);
+}
+
+static inline void async_timer_start(struct k_delayed_work *work,
+				     int32_t timeout)
+{
+	if ((timeout != SYS_FOREVER_MS) && (timeout != 0)) {
+		k_delayed_work_submit(work, K_MSEC(timeout));
+	}
+}
+
+/* Report the data the DMA received since the last event. */
+static void uart_stm32_dma_rx_flush(struct device *dev)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	struct dma_status stat;
+
+	if (dma_get_status(data->dma_rx.dma_dev, data->dma_rx.dma_channel,
+			   &stat) == 0) {
+		data->dma_rx.counter = data->dma_rx.buffer_length -
+				       stat.pending_length;
+		async_evt_rx_rdy(data);
+	}
+}
+
+static int uart_stm32_async_rx_disable(struct device *dev)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	USART_TypeDef *UartInstance = UART_STRUCT(dev);
+	struct uart_event event = {
+		.type = UART_RX_DISABLED,
+	};
+	unsigned int key;
+
+	key = irq_lock();
+
+	if (!data->dma_rx.enabled) {
+		irq_unlock(key);
+		return -EFAULT;
+	}
+
+	LL_USART_DisableIT_IDLE(UartInstance);
+	LL_USART_DisableIT_ERROR(UartInstance);
+	LL_USART_DisableDMAReq_RX(UartInstance);
+	(void)k_delayed_work_cancel(&data->dma_rx.timeout_work);
+	dma_stop(data->dma_rx.dma_dev, data->dma_rx.dma_channel);
+
+	uart_stm32_dma_rx_flush(dev);
+	async_evt_rx_buf_release(data, data->dma_rx.buffer);
+	if (data->rx_next_buffer != NULL) {
+		async_evt_rx_buf_release(data, data->rx_next_buffer);
+	}
+
+	data->dma_rx.enabled = false;
+	data->dma_rx.buffer = NULL;
+	data->dma_rx.buffer_length = 0;
+	data->rx_next_buffer = NULL;
+	data->rx_next_buffer_len = 0;
+
+	async_user_callback(data, &event);
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+/* Called from the UART ISR when the line goes idle after some data. */
+static void uart_stm32_async_isr(struct device *dev)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	USART_TypeDef *UartInstance = UART_STRUCT(dev);
+	struct uart_event event = {
+		.type = UART_RX_STOPPED,
+	};
+	int err;
+
+	if (!data->dma_rx.enabled) {
+		return;
+	}
+
+	if (LL_USART_IsEnabledIT_IDLE(UartInstance) &&
+	    LL_USART_IsActiveFlag_IDLE(UartInstance)) {
+		LL_USART_ClearFlag_IDLE(UartInstance);
+
+		if (data->dma_rx.timeout == 0) {
+			uart_stm32_dma_rx_flush(dev);
+		} else {
+			async_timer_start(&data->dma_rx.timeout_work,
+					  data->dma_rx.timeout);
+		}
+	}
+
+	err = uart_stm32_err_check(dev);
+	if (err != 0) {
+		uart_stm32_dma_rx_flush(dev);
+
+		event.data.rx_stop.reason = err;
+		event.data.rx_stop.data.buf = data->dma_rx.buffer;
+		event.data.rx_stop.data.offset = 0;
+		event.data.rx_stop.data.len = data->dma_rx.counter;
+		async_user_callback(data, &event);
+
+		uart_stm32_async_rx_disable(dev);
+	}
+}
+
+static void uart_stm32_dma_rx_cb(struct device *dma_dev, void *user_data,
+				 uint32_t channel, int status)
+{
+	struct device *dev = user_data;
+	struct uart_stm32_data *data = DEV_DATA(dev);
+
+	if (status != 0) {
+		LOG_ERR("RX DMA error %d", status);
+		uart_stm32_async_rx_disable(dev);
+		return;
+	}
+
+	(void)k_delayed_work_cancel(&data->dma_rx.timeout_work);
+
+	/* the buffer is full */
+	data->dma_rx.counter = data->dma_rx.buffer_length;
+	async_evt_rx_rdy(data);
+
+	if (data->rx_next_buffer == NULL) {
+		uart_stm32_async_rx_disable(dev);
+		return;
+	}
+
+	async_evt_rx_buf_release(data, data->dma_rx.buffer);
+
+	data->dma_rx.buffer = data->rx_next_buffer;
+	data->dma_rx.buffer_length = data->rx_next_buffer_len;
+	data->dma_rx.offset = 0;
+	data->dma_rx.counter = 0;
+	data->rx_next_buffer = NULL;
+	data->rx_next_buffer_len = 0;
+
+	dma_reload(data->dma_rx.dma_dev, data->dma_rx.dma_channel,
+		   data->dma_rx.blk_cfg.source_address,
+		   (uint32_t)data->dma_rx.buffer,
+		   data->dma_rx.buffer_length);
+
+	async_evt_rx_buf_request(data);
+}
+
+static void uart_stm32_dma_tx_cb(struct device *dma_dev, void *user_data,
+				 uint32_t channel, int status)
+{
+	struct device *dev = user_data;
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	struct dma_status stat;
+	unsigned int key = irq_lock();
+
+	(void)k_delayed_work_cancel(&data->dma_tx.timeout_work);
+	LL_USART_DisableDMAReq_TX(UART_STRUCT(dev));
+
+	if (dma_get_status(data->dma_tx.dma_dev, data->dma_tx.dma_channel,
+			   &stat) == 0) {
+		data->dma_tx.counter = data->dma_tx.buffer_length -
+				       stat.pending_length;
+	}
+
+	async_evt_tx(data, (status == 0) ? UART_TX_DONE : UART_TX_ABORTED);
+
+	irq_unlock(key);
+}
+
+static int uart_stm32_async_callback_set(struct device *dev,
+					 uart_callback_t callback,
+					 void *user_data)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+
+	data->async_cb = callback;
+	data->async_user_data = user_data;
+
+	return 0;
+}
+
+static int uart_stm32_async_tx(struct device *dev, const uint8_t *tx_data,
+			       size_t buf_size, int32_t timeout)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	USART_TypeDef *UartInstance = UART_STRUCT(dev);
+	int ret;
+
+	if (data->dma_tx.dma_dev == NULL) {
+		return -ENODEV;
+	}
+
+	if (data->dma_tx.buffer_length != 0) {
+		return -EBUSY;
+	}
+
+	data->dma_tx.buffer = (uint8_t *)tx_data;
+	data->dma_tx.buffer_length = buf_size;
+	data->dma_tx.timeout = timeout;
+
+	LL_USART_ClearFlag_TC(UartInstance);
+
+	data->dma_tx.blk_cfg.source_address = (uint32_t)tx_data;
+	data->dma_tx.blk_cfg.block_size = buf_size;
+
+	ret = dma_config(data->dma_tx.dma_dev, data->dma_tx.dma_channel,
+			 &data->dma_tx.dma_cfg);
+	if (ret == 0) {
+		ret = dma_start(data->dma_tx.dma_dev,
+				data->dma_tx.dma_channel);
+	}
+	if (ret != 0) {
+		LOG_ERR("TX DMA start failed: %d", ret);
+		data->dma_tx.buffer_length = 0;
+		return ret;
+	}
+
+	async_timer_start(&data->dma_tx.timeout_work, timeout);
+
+	LL_USART_EnableDMAReq_TX(UartInstance);
+
+	return 0;
+}
+
+static int uart_stm32_async_tx_abort(struct device *dev)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	struct dma_status stat;
+	unsigned int key = irq_lock();
+
+	if (data->dma_tx.buffer_length == 0) {
+		irq_unlock(key);
+		return -EFAULT;
+	}
+
+	(void)k_delayed_work_cancel(&data->dma_tx.timeout_work);
+	LL_USART_DisableDMAReq_TX(UART_STRUCT(dev));
+	dma_stop(data->dma_tx.dma_dev, data->dma_tx.dma_channel);
+
+	if (dma_get_status(data->dma_tx.dma_dev, data->dma_tx.dma_channel,
+			   &stat) == 0) {
+		data->dma_tx.counter = data->dma_tx.buffer_length -
+				       stat.pending_length;
+	}
+
+	async_evt_tx(data, UART_TX_ABORTED);
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+static void uart_stm32_async_rx_timeout(struct k_work *work)
+{
+	struct uart_dma_stream *rx_stream =
+		CONTAINER_OF(work, struct uart_dma_stream, timeout_work);
+	struct uart_stm32_data *data =
+		CONTAINER_OF(rx_stream, struct uart_stm32_data, dma_rx);
+	unsigned int key = irq_lock();
+
+	if (data->dma_rx.enabled) {
+		uart_stm32_dma_rx_flush(data->dev);
+	}
+
+	irq_unlock(key);
+}
+
+static void uart_stm32_async_tx_timeout(struct k_work *work)
+{
+	struct uart_dma_stream *tx_stream =
+		CONTAINER_OF(work, struct uart_dma_stream, timeout_work);
+	struct uart_stm32_data *data =
+		CONTAINER_OF(tx_stream, struct uart_stm32_data, dma_tx);
+
+	(void)uart_stm32_async_tx_abort(data->dev);
+}
+
+static int uart_stm32_async_rx_enable(struct device *dev, uint8_t *rx_buf,
+				      size_t buf_size, int32_t timeout)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	USART_TypeDef *UartInstance = UART_STRUCT(dev);
+	int ret;
+
+	if (data->dma_rx.dma_dev == NULL) {
+		return -ENODEV;
+	}
+
+	if (data->dma_rx.enabled) {
+		return -EBUSY;
+	}
+
+	data->dma_rx.buffer = rx_buf;
+	data->dma_rx.buffer_length = buf_size;
+	data->dma_rx.offset = 0;
+	data->dma_rx.counter = 0;
+	data->dma_rx.timeout = timeout;
+
+	/* the DMA empties the data register instead */
+	LL_USART_DisableIT_RXNE(UartInstance);
+
+	data->dma_rx.blk_cfg.dest_address = (uint32_t)rx_buf;
+	data->dma_rx.blk_cfg.block_size = buf_size;
+
+	ret = dma_config(data->dma_rx.dma_dev, data->dma_rx.dma_channel,
+			 &data->dma_rx.dma_cfg);
+	if (ret == 0) {
+		ret = dma_start(data->dma_rx.dma_dev,
+				data->dma_rx.dma_channel);
+	}
+	if (ret != 0) {
+		LOG_ERR("RX DMA start failed: %d", ret);
+		return ret;
+	}
+
+	data->dma_rx.enabled = true;
+
+	LL_USART_EnableDMAReq_RX(UartInstance);
+
+	/* an idle line ends the reception of a chunk of data */
+	LL_USART_ClearFlag_IDLE(UartInstance);
+	LL_USART_EnableIT_IDLE(UartInstance);
+	LL_USART_EnableIT_ERROR(UartInstance);
+
+	async_evt_rx_buf_request(data);
+
+	return 0;
+}
+
+static int uart_stm32_async_rx_buf_rsp(struct device *dev, uint8_t *buf,
+				       size_t len)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	unsigned int key = irq_lock();
+	int err = 0;
+
+	if (!data->dma_rx.enabled) {
+		err = -EACCES;
+	} else if (data->rx_next_buffer != NULL) {
+		err = -EBUSY;
+	} else {
+		data->rx_next_buffer = buf;
+		data->rx_next_buffer_len = len;
+	}
+
+	irq_unlock(key);
+
+	return err;
+}
+
+static void uart_stm32_dma_stream_init(struct device *dev,
+				       struct uart_dma_stream *stream,
+				       uint32_t reg, bool rx)
+{
+	struct dma_block_config *blk_cfg = &stream->blk_cfg;
+
+	memset(blk_cfg, 0, sizeof(*blk_cfg));
+
+	if (rx) {
+		blk_cfg->source_address = reg;
+	} else {
+		blk_cfg->dest_address = reg;
+	}
+
+	blk_cfg->source_addr_adj = stream->src_addr_increment ?
+		DMA_ADDR_ADJ_INCREMENT : DMA_ADDR_ADJ_NO_CHANGE;
+	blk_cfg->dest_addr_adj = stream->dst_addr_increment ?
+		DMA_ADDR_ADJ_INCREMENT : DMA_ADDR_ADJ_NO_CHANGE;
+	blk_cfg->fifo_mode_control = stream->fifo_threshold;
+
+	stream->dma_cfg.head_block = blk_cfg;
+	stream->dma_cfg.user_data = dev;
+}
+
+static int uart_stm32_async_init(struct device *dev)
+{
+	struct uart_stm32_data *data = DEV_DATA(dev);
+	USART_TypeDef *UartInstance = UART_STRUCT(dev);
+
+	data->dev = dev;
+
+	if (data->dma_rx.dma_name != NULL) {
+		data->dma_rx.dma_dev =
+			device_get_binding(data->dma_rx.dma_name);
+		if (data->dma_rx.dma_dev == NULL) {
+			LOG_ERR("%s device not found", data->dma_rx.dma_name);
+			return -ENODEV;
+		}
+	}
+
+	if (data->dma_tx.dma_name != NULL) {
+		data->dma_tx.dma_dev =
+			device_get_binding(data->dma_tx.dma_name);
+		if (data->dma_tx.dma_dev == NULL) {
+			LOG_ERR("%s device not found", data->dma_tx.dma_name);
+			return -ENODEV;
+		}
+	}
+
+	k_delayed_work_init(&data->dma_rx.timeout_work,
+			    uart_stm32_async_rx_timeout);
+	k_delayed_work_init(&data->dma_tx.timeout_work,
+			    uart_stm32_async_tx_timeout);
+
+	uart_stm32_dma_stream_init(dev, &data->dma_rx,
+				   UART_DMA_RX_REG(UartInstance), true);
+	uart_stm32_dma_stream_init(dev, &data->dma_tx,
+				   UART_DMA_TX_REG(UartInstance), false);
+
+	return 0;
+}
+
+#endif /* CONFIG_UART_ASYNC_API */
+
+#if defined(CONFIG_UART_INTERRUPT_DRIVEN) || defined(CONFIG_UART_ASYNC_API)
 static void uart_stm32_isr(void *arg)
 {
 	struct device *dev = arg;
 	struct uart_stm32_data *data = DEV_DATA(dev);
 
+	ARG_UNUSED(data);
+
+#ifdef CONFIG_UART_ASYNC_API
+	uart_stm32_async_isr(dev);
+#endif
+
+#ifdef CONFIG_UART_INTERRUPT_DRIVEN
 	if (data->user_cb) {
 		data->user_cb(dev, data->user_data);
 	}
+#endif
 }
-
-#endif /* CONFIG_UART_INTERRUPT_DRIVEN */
+#endif /* CONFIG_UART_INTERRUPT_DRIVEN || CONFIG_UART_ASYNC_API */
 
 static const struct uart_driver_api uart_stm32_driver_api = {
 	.poll_in = uart_stm32_poll_in,
@@ -643,6 +1142,14 @@ static const struct uart_driver_api uart_stm32_driver_api = {
 	.irq_update = uart_stm32_irq_update,
 	.irq_callback_set = uart_stm32_irq_callback_set,
 #endif	/* CONFIG_UART_INTERRUPT_DRIVEN */
+#ifdef CONFIG_UART_ASYNC_API
+	.callback_set = uart_stm32_async_callback_set,
+	.tx = uart_stm32_async_tx,
+	.tx_abort = uart_stm32_async_tx_abort,
+	.rx_enable = uart_stm32_async_rx_enable,
+	.rx_disable = uart_stm32_async_rx_disable,
+	.rx_buf_rsp = uart_stm32_async_rx_buf_rsp,
+#endif	/* CONFIG_UART_ASYNC_API */
 };
 
 /**
@@ -724,14 +1231,59 @@ static int uart_stm32_init(struct device *dev)
 	}
 #endif /* !USART_ISR_REACK */
 
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#if defined(CONFIG_UART_INTERRUPT_DRIVEN) || defined(CONFIG_UART_ASYNC_API)
 	config->uconf.irq_config_func(dev);
 #endif
+
+#ifdef CONFIG_UART_ASYNC_API
+	return uart_stm32_async_init(dev);
+#else
 	return 0;
+#endif
 }
 
+#ifdef CONFIG_UART_ASYNC_API
+#define DMA_CHANNEL_CONFIG(id, dir)					\
+		DT_INST_DMAS_CELL_BY_NAME(id, dir, channel_config)
+#define DMA_FEATURES(id, dir)						\
+		DT_INST_DMAS_CELL_BY_NAME(id, dir, features)
+
+#define UART_DMA_CHANNEL_INIT(index, dir, dir_cap, src_dev, dest_dev)	\
+	.dma_name = DT_INST_DMAS_LABEL_BY_NAME(index, dir),		\
+	.dma_channel = DT_INST_DMAS_CELL_BY_NAME(index, dir, channel),	\
+	.dma_cfg = {							\
+		.dma_slot = DT_INST_DMAS_CELL_BY_NAME(index, dir, slot),\
+		.channel_direction = STM32_DMA_CONFIG_DIRECTION(	\
+					DMA_CHANNEL_CONFIG(index, dir)),\
+		.channel_priority = STM32_DMA_CONFIG_PRIORITY(		\
+					DMA_CHANNEL_CONFIG(index, dir)),\
+		.source_data_size = STM32_DMA_CONFIG_##src_dev##_DATA_SIZE(\
+					DMA_CHANNEL_CONFIG(index, dir)),\
+		.dest_data_size = STM32_DMA_CONFIG_##dest_dev##_DATA_SIZE(\
+					DMA_CHANNEL_CONFIG(index, dir)),\
+		.source_burst_length = 1, /* SINGLE transfer */		\
+		.dest_burst_length = 1,					\
+		.block_count = 1,					\
+		.dma_callback = uart_stm32_dma_##dir##_cb,		\
+	},								\
+	.src_addr_increment = STM32_DMA_CONFIG_##src_dev##_ADDR_INC(	\
+				DMA_CHANNEL_CONFIG(index, dir)),	\
+	.dst_addr_increment = STM32_DMA_CONFIG_##dest_dev##_ADDR_INC(	\
+				DMA_CHANNEL_CONFIG(index, dir)),	\
+	.fifo_threshold = STM32_DMA_FEATURES_FIFO_THRESHOLD(		\
+				DMA_FEATURES(index, dir)),
+
+#define UART_DMA_CHANNEL(index, dir, DIR, src, dest)			\
+.dma_##dir = {								\
+	COND_CODE_1(DT_INST_DMAS_HAS_NAME(index, dir),			\
+		    (UART_DMA_CHANNEL_INIT(index, dir, DIR, src, dest)),\
+		    (NULL))						\
+	},
+#else
+#define UART_DMA_CHANNEL(index, dir, DIR, src, dest)
+#endif
 
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#if defined(CONFIG_UART_INTERRUPT_DRIVEN) || defined(CONFIG_UART_ASYNC_API)
 #define STM32_UART_IRQ_HANDLER_DECL(index)				\
 	static void uart_stm32_irq_config_func_##index(struct device *dev)
 #define STM32_UART_IRQ_HANDLER_FUNC(index)				\
@@ -767,7 +1319,9 @@ static const struct uart_stm32_config uart_stm32_cfg_##index = {	\
 };									\
 									\
 static struct uart_stm32_data uart_stm32_data_##index = {		\
-	.baud_rate = DT_INST_PROP(index, current_speed)	\
+	.baud_rate = DT_INST_PROP(index, current_speed),		\
+	UART_DMA_CHANNEL(index, rx, RX, PERIPHERAL, MEMORY)		\
+	UART_DMA_CHANNEL(index, tx, TX, MEMORY, PERIPHERAL)		\
 };									\
 									\
 DEVICE_AND_API_INIT(uart_stm32_##index, DT_INST_LABEL(index),\
@@ -23,6 +23,30 @@ struct uart_stm32_config {
 	int  parity;
 };
 
+#ifdef CONFIG_UART_ASYNC_API
+/* DMA stream of one direction */
+struct uart_dma_stream {
+	const char *dma_name;
+	struct device *dma_dev;
+	uint32_t dma_channel;
+	struct dma_config dma_cfg;
+	struct dma_block_config blk_cfg;
+	bool src_addr_increment;
+	bool dst_addr_increment;
+	int fifo_threshold;
+	/* current buffer */
+	uint8_t *buffer;
+	size_t buffer_length;
+	/* bytes already reported */
+	size_t offset;
+	/* bytes transferred */
+	volatile size_t counter;
+	int32_t timeout;
+	struct k_delayed_work timeout_work;
+	bool enabled;
+};
+#endif
+
 /* driver data */
 struct uart_stm32_data {
 	/* Baud rate */
@@ -33,6 +57,15 @@ struct uart_stm32_data {
 	uart_irq_callback_user_data_t user_cb;
 	void *user_data;
 #endif
+#ifdef CONFIG_UART_ASYNC_API
+	struct device *dev;
+	uart_callback_t async_cb;
+	void *async_user_data;
+	struct uart_dma_stream dma_rx;
+	struct uart_dma_stream dma_tx;
+	uint8_t *rx_next_buffer;
+	size_t rx_next_buffer_len;
+#endif
 };
 
 #endif	/* ZEPHYR_DRIVERS_SERIAL_UART_STM32_H_ */
@@ -24,6 +24,24 @@ enum spi_ctx_runtime_op_mode {
 	SPI_CTX_RUNTIME_OP_MODE_SLAVE  = BIT(1),
 };
 
+#ifdef CONFIG_SPI_ASYNC_QUEUE
+/* Asynchronous transaction waiting for the bus */
+struct spi_context_request {
+	const struct spi_config *config;
+	const struct spi_buf_set *tx_bufs;
+	const struct spi_buf_set *rx_bufs;
+	struct k_poll_signal *signal;
+};
+
+/*
+ * Start a queued transaction on the locked context, possibly from the
+ * interrupt completing the previous one. Returns 0 once started, the
+ * completion then goes through spi_context_complete().
+ */
+typedef int (*spi_context_start_t)(struct device *dev,
+				   const struct spi_context_request *req);
+#endif /* CONFIG_SPI_ASYNC_QUEUE */
+
 struct spi_context {
 	const struct spi_config *config;
 
@@ -35,6 +53,13 @@ struct spi_context {
 	struct k_poll_signal *signal;
 	bool asynchronous;
 #endif /* CONFIG_SPI_ASYNC */
+#ifdef CONFIG_SPI_ASYNC_QUEUE
+	struct device *dev;
+	spi_context_start_t start;
+	struct spi_context_request queue[CONFIG_SPI_ASYNC_QUEUE_SIZE];
+	uint8_t queue_head;
+	uint8_t queue_len;
+#endif /* CONFIG_SPI_ASYNC_QUEUE */
 	const struct spi_buf *current_tx;
 	size_t tx_count;
 	const struct spi_buf *current_rx;
@@ -79,6 +104,97 @@ static inline void spi_context_lock(struct spi_context *ctx,
 #endif /* CONFIG_SPI_ASYNC */
 }
 
+/* Hand the locked context over to the next queued transaction, if any. */
+static inline void spi_context_unlock(struct spi_context *ctx)
+{
+#ifdef CONFIG_SPI_ASYNC_QUEUE
+	struct spi_context_request req;
+	unsigned int key;
+	int ret;
+
+	for (;;) {
+		key = irq_lock();
+		if (ctx->queue_len == 0U) {
+			break;
+		}
+
+		req = ctx->queue[ctx->queue_head];
+		ctx->queue_head = (ctx->queue_head + 1U) %
+				  ARRAY_SIZE(ctx->queue);
+		ctx->queue_len--;
+		irq_unlock(key);
+
+		ctx->asynchronous = true;
+		ctx->signal = req.signal;
+
+		ret = ctx->start(ctx->dev, &req);
+		if (ret == 0) {
+			return;
+		}
+
+		if (req.signal) {
+			k_poll_signal_raise(req.signal, ret);
+		}
+	}
+
+	/* Under the lock so that no request gets queued meanwhile */
+	k_sem_give(&ctx->lock);
+	irq_unlock(key);
+#else
+	k_sem_give(&ctx->lock);
+#endif /* CONFIG_SPI_ASYNC_QUEUE */
+}
+
+#ifdef CONFIG_SPI_ASYNC_QUEUE
+/*
+ * Lock the context for an asynchronous transaction or, if the bus is busy,
+ * queue it to be started by start() once the transactions ahead of it are
+ * done. Returns 0 if the caller got the lock and starts the transaction
+ * itself, 1 if the transaction is queued. Waits for the bus as
+ * spi_context_lock() does when the queue is full.
+ */
+static inline int spi_context_lock_or_queue(struct spi_context *ctx,
+					    struct device *dev,
+					    spi_context_start_t start,
+					    const struct spi_config *config,
+					    const struct spi_buf_set *tx_bufs,
+					    const struct spi_buf_set *rx_bufs,
+					    struct k_poll_signal *signal)
+{
+	struct spi_context_request *req;
+	unsigned int key;
+
+	key = irq_lock();
+
+	if (k_sem_take(&ctx->lock, K_NO_WAIT) == 0) {
+		irq_unlock(key);
+		ctx->asynchronous = true;
+		ctx->signal = signal;
+		return 0;
+	}
+
+	if (ctx->queue_len < ARRAY_SIZE(ctx->queue)) {
+		req = &ctx->queue[(ctx->queue_head + ctx->queue_len) %
+				  ARRAY_SIZE(ctx->queue)];
+		req->config = config;
+		req->tx_bufs = tx_bufs;
+		req->rx_bufs = rx_bufs;
+		req->signal = signal;
+		ctx->queue_len++;
+		ctx->dev = dev;
+		ctx->start = start;
+		irq_unlock(key);
+		return 1;
+	}
+
+	irq_unlock(key);
+
+	spi_context_lock(ctx, true, signal);
+
+	return 0;
+}
+#endif /* CONFIG_SPI_ASYNC_QUEUE */
+
 static inline void spi_context_release(struct spi_context *ctx, int status)
 {
 #ifdef CONFIG_SPI_SLAVE
@@ -89,10 +205,10 @@ static inline void spi_context_release(struct spi_context *ctx, int status)
 
 #ifdef CONFIG_SPI_ASYNC
 	if (!ctx->asynchronous || (status < 0)) {
-		k_sem_give(&ctx->lock);
+		spi_context_unlock(ctx);
 	}
 #else
-	k_sem_give(&ctx->lock);
+	spi_context_unlock(ctx);
 #endif /* CONFIG_SPI_ASYNC */
 }
 
@@ -138,7 +254,7 @@ static inline void spi_context_complete(struct spi_context *ctx, int status)
 		}
 
 		if (!(ctx->config->operation & SPI_LOCK_ON)) {
-			k_sem_give(&ctx->lock);
+			spi_context_unlock(ctx);
 		}
 	}
 #else
@@ -205,7 +321,7 @@ static inline void spi_context_unlock_unconditionally(struct spi_context *ctx)
 	_spi_context_cs_control(ctx, false, true);
 
 	if (!k_sem_count_get(&ctx->lock)) {
-		k_sem_give(&ctx->lock);
+		spi_context_unlock(ctx);
 	}
 }
 
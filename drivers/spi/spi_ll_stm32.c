@@ -55,18 +55,22 @@ LOG_MODULE_REGISTER(spi_ll_stm32);
 #ifdef CONFIG_SPI_STM32_DMA
 /* dummy value used for transferring NOP when tx buf is null */
 uint32_t nop_tx;
+/* dummy destination of the frames received without rx buf */
+static uint32_t dummy_rx;
+
+static void spi_stm32_dma_done(struct device *dev, int status);
 
 /* This function is executed in the interrupt context */
-static void dma_callback(struct device *dev, void *arg,
+static void dma_callback(struct device *dma_dev, void *arg,
 			 uint32_t channel, int status)
 {
-	/* arg directly holds the client data */
-	struct spi_stm32_data *data = arg;
+	/* arg directly holds the spi device */
+	struct device *dev = arg;
+	struct spi_stm32_data *data = DEV_DATA(dev);
 
-	if (status != 0) {
+	if (status < 0) {
 		LOG_ERR("DMA callback error with channel %d.", channel);
-		data->dma_tx.transfer_complete = true;
-		data->dma_rx.transfer_complete = true;
+		spi_stm32_dma_done(dev, status);
 		return;
 	}
 
@@ -79,10 +83,15 @@ static void dma_callback(struct device *dev, void *arg,
 		data->dma_rx.transfer_complete = true;
 	} else {
 		LOG_ERR("DMA callback channel %d is not valid.", channel);
-		data->dma_tx.transfer_complete = true;
-		data->dma_rx.transfer_complete = true;
+		spi_stm32_dma_done(dev, -EIO);
 		return;
 	}
+
+	/* the segment is over once its last frame is received */
+	if (data->dma_tx.transfer_complete &&
+	    data->dma_rx.transfer_complete) {
+		spi_stm32_dma_done(dev, 0);
+	}
 }
 
 static int spi_stm32_dma_tx_load(struct device *dev, const uint8_t *buf,
@@ -128,8 +137,8 @@ static int spi_stm32_dma_tx_load(struct device *dev, const uint8_t *buf,
 
 	/* direction is given by the DT */
 	stream->dma_cfg.head_block = &blk_cfg;
-	/* give the client data as arg, as the callback comes from the dma */
-	stream->dma_cfg.user_data = data;
+	/* give the spi device as arg, as the callback comes from the dma */
+	stream->dma_cfg.user_data = dev;
 	/* pass our client origin to the dma: data->dma_tx.dma_channel */
 	ret = dma_config(data->dev_dma_tx, data->dma_tx.channel,
 			&stream->dma_cfg);
@@ -160,17 +169,24 @@ static int spi_stm32_dma_rx_load(struct device *dev, uint8_t *buf, size_t len)
 	blk_cfg.block_size = len;
 
 	/* rx direction has periph as source and mem as dest. */
-	blk_cfg.dest_address = (buf != NULL) ? (uint32_t)buf : (uint32_t)NULL;
 	blk_cfg.source_address = (uint32_t)LL_SPI_DMA_GetRegAddr(cfg->spi);
 	if (data->dma_rx.src_addr_increment) {
 		blk_cfg.source_addr_adj = DMA_ADDR_ADJ_INCREMENT;
 	} else {
 		blk_cfg.source_addr_adj = DMA_ADDR_ADJ_NO_CHANGE;
 	}
-	if (data->dma_rx.dst_addr_increment) {
-		blk_cfg.dest_addr_adj = DMA_ADDR_ADJ_INCREMENT;
-	} else {
+
+	if (buf == NULL) {
+		/* if rx buff is null, then drops the received frames. */
+		blk_cfg.dest_address = (uint32_t)&dummy_rx;
 		blk_cfg.dest_addr_adj = DMA_ADDR_ADJ_NO_CHANGE;
+	} else {
+		blk_cfg.dest_address = (uint32_t)buf;
+		if (data->dma_rx.dst_addr_increment) {
+			blk_cfg.dest_addr_adj = DMA_ADDR_ADJ_INCREMENT;
+		} else {
+			blk_cfg.dest_addr_adj = DMA_ADDR_ADJ_NO_CHANGE;
+		}
 	}
 
 	/* give the fifo mode from the DT */
@@ -178,7 +194,7 @@ static int spi_stm32_dma_rx_load(struct device *dev, uint8_t *buf, size_t len)
 
 	/* direction is given by the DT */
 	stream->dma_cfg.head_block = &blk_cfg;
-	stream->dma_cfg.user_data = data;
+	stream->dma_cfg.user_data = dev;
 
 
 	/* pass our client origin to the dma: data->dma_rx.channel */
@@ -201,36 +217,21 @@ static int spi_dma_move_buffers(struct device *dev)
 	struct spi_stm32_data *data = DEV_DATA(dev);
 	int ret;
 
-	/* the length to transmit depends on the source data size (1,2 4) */
-	data->dma_segment_len = data->ctx.tx_len
-			/ data->dma_tx.dma_cfg.source_data_size;
+	/* segment up to the end of the current tx or rx buffer */
+	data->dma_segment_len = spi_context_longest_current_buf(&data->ctx);
 
-	/* Load receive first, so it can accept transmit data */
-	if (data->ctx.rx_len) {
-		ret = spi_stm32_dma_rx_load(dev, data->ctx.rx_buf,
-					    data->dma_segment_len);
-	} else {
-		ret = spi_stm32_dma_rx_load(dev, NULL, data->dma_segment_len);
-	}
+	data->dma_tx.transfer_complete = false;
+	data->dma_rx.transfer_complete = false;
 
+	/* Load receive first, so it can accept transmit data */
+	ret = spi_stm32_dma_rx_load(dev, data->ctx.rx_buf,
+				    data->dma_segment_len);
 	if (ret != 0) {
 		return ret;
 	}
 
-	if (data->ctx.tx_len) {
-		ret = spi_stm32_dma_tx_load(dev, data->ctx.tx_buf,
-					    data->dma_segment_len);
-	} else {
-		ret = spi_stm32_dma_tx_load(dev, NULL, data->dma_segment_len);
-	}
-
-	return ret;
-}
-
-static bool spi_stm32_dma_transfer_ongoing(struct spi_stm32_data *data)
-{
-	return ((data->dma_tx.transfer_complete != true)
-		&& (data->dma_rx.transfer_complete != true));
+	return spi_stm32_dma_tx_load(dev, data->ctx.tx_buf,
+				     data->dma_segment_len);
 }
 #endif /* CONFIG_SPI_STM32_DMA */
 
@@ -648,29 +649,45 @@ static int transceive(struct device *dev,
 }
 
 #ifdef CONFIG_SPI_STM32_DMA
-static int transceive_dma(struct device *dev,
-		      const struct spi_config *config,
-		      const struct spi_buf_set *tx_bufs,
-		      const struct spi_buf_set *rx_bufs,
-		      bool asynchronous, struct k_poll_signal *signal)
+/* Executed from the DMA callbacks at the end of each segment. */
+static void spi_stm32_dma_done(struct device *dev, int status)
 {
 	const struct spi_stm32_config *cfg = DEV_CFG(dev);
 	struct spi_stm32_data *data = DEV_DATA(dev);
-	SPI_TypeDef *spi = cfg->spi;
-	int ret;
 
-	if (!tx_bufs && !rx_bufs) {
-		return 0;
-	}
+	if (status == 0) {
+		spi_context_update_tx(&data->ctx, 1, data->dma_segment_len);
+		spi_context_update_rx(&data->ctx, 1, data->dma_segment_len);
 
-	if (asynchronous) {
-		return -ENOTSUP;
+		/* chain the next segment without leaving the interrupt */
+		if (spi_stm32_transfer_ongoing(data)) {
+			status = spi_dma_move_buffers(dev);
+			if (status == 0) {
+				return;
+			}
+		}
 	}
 
-	spi_context_lock(&data->ctx, asynchronous, signal);
+	dma_stop(data->dev_dma_tx, data->dma_tx.channel);
+	dma_stop(data->dev_dma_rx, data->dma_rx.channel);
 
-	data->dma_tx.transfer_complete = false;
-	data->dma_rx.transfer_complete = false;
+	spi_stm32_complete(data, cfg->spi, status);
+#ifndef CONFIG_SPI_STM32_INTERRUPT
+	/* otherwise already done by spi_stm32_complete() */
+	spi_context_complete(&data->ctx, status);
+#endif
+}
+
+/* Start a transaction on the locked context, the DMA completes it. */
+static int spi_stm32_dma_start(struct device *dev,
+			       const struct spi_config *config,
+			       const struct spi_buf_set *tx_bufs,
+			       const struct spi_buf_set *rx_bufs)
+{
+	const struct spi_stm32_config *cfg = DEV_CFG(dev);
+	struct spi_stm32_data *data = DEV_DATA(dev);
+	SPI_TypeDef *spi = cfg->spi;
+	int ret;
 
 	ret = spi_stm32_configure(dev, config);
 	if (ret) {
@@ -680,72 +697,63 @@ static int transceive_dma(struct device *dev,
 	/* Set buffers info */
 	spi_context_buffers_setup(&data->ctx, tx_bufs, rx_bufs, 1);
 
+	/* This is turned off in spi_stm32_complete(). */
+	spi_context_cs_control(&data->ctx, true);
+
 	ret = spi_dma_move_buffers(dev);
 	if (ret) {
+		dma_stop(data->dev_dma_rx, data->dma_rx.channel);
+		spi_context_cs_control(&data->ctx, false);
 		return ret;
 	}
 
 	LL_SPI_Enable(spi);
 
-	/* store spi peripheral address */
-	uint32_t periph_addr = data->dma_tx.dma_cfg.head_block->dest_address;
-
-	for (; ;) {
-		/* wait for SPI busy flag */
-		while (LL_SPI_IsActiveFlag_BSY(spi) == 1) {
-		}
+	return 0;
+}
 
-		/* once SPI is no more busy, wait for DMA transfer end */
-		while (spi_stm32_dma_transfer_ongoing(data) == 1) {
-		}
+#ifdef CONFIG_SPI_ASYNC_QUEUE
+static int spi_stm32_dma_start_queued(struct device *dev,
+				      const struct spi_context_request *req)
+{
+	return spi_stm32_dma_start(dev, req->config, req->tx_bufs,
+				   req->rx_bufs);
+}
+#endif /* CONFIG_SPI_ASYNC_QUEUE */
 
-		if ((data->ctx.tx_count <= 1) && (data->ctx.rx_count <= 1)) {
-			/* if it was the last count, then we are done */
-			break;
-		}
+static int transceive_dma(struct device *dev,
+		      const struct spi_config *config,
+		      const struct spi_buf_set *tx_bufs,
+		      const struct spi_buf_set *rx_bufs,
+		      bool asynchronous, struct k_poll_signal *signal)
+{
+	struct spi_stm32_data *data = DEV_DATA(dev);
+	int ret;
 
-		if (data->dma_tx.transfer_complete == true) {
-			LL_SPI_DisableDMAReq_TX(spi);
-			/*
-			 * Update the current Tx buffer, decreasing length of
-			 * data->ctx.tx_count,  by its own length
-			 */
-			spi_context_update_tx(&data->ctx, 1, data->ctx.tx_len);
-			/* keep the same dest (peripheral) */
-			data->dma_tx.transfer_complete = false;
-			/* and reload dma with a new source (memory) buffer */
-			dma_reload(data->dev_dma_tx,
-				data->dma_tx.channel,
-				(uint32_t)data->ctx.tx_buf,
-				periph_addr,
-				data->ctx.tx_len);
-		}
+	if (!tx_bufs && !rx_bufs) {
+		return 0;
+	}
 
-		if (data->dma_rx.transfer_complete == true) {
-			LL_SPI_DisableDMAReq_RX(spi);
-			/*
-			 * Update the current Rx buffer, decreasing length of
-			 * data->ctx.rx_count,  by its own length
-			 */
-			spi_context_update_rx(&data->ctx, 1, data->ctx.rx_len);
-			/* keep the same source (peripheral) */
-			data->dma_rx.transfer_complete = false;
-			/* and reload dma with a new dest (memory) buffer */
-			dma_reload(data->dev_dma_rx,
-				data->dma_rx.channel,
-				periph_addr,
-				(uint32_t)data->ctx.rx_buf,
-				data->ctx.rx_len);
+#ifdef CONFIG_SPI_ASYNC_QUEUE
+	if (asynchronous) {
+		if (spi_context_lock_or_queue(&data->ctx, dev,
+					      spi_stm32_dma_start_queued,
+					      config, tx_bufs, rx_bufs,
+					      signal)) {
+			/* started once the transactions ahead are done */
+			return 0;
 		}
-		LL_SPI_EnableDMAReq_RX(spi);
-		LL_SPI_EnableDMAReq_TX(spi);
+	} else {
+		spi_context_lock(&data->ctx, asynchronous, signal);
 	}
+#else
+	spi_context_lock(&data->ctx, asynchronous, signal);
+#endif /* CONFIG_SPI_ASYNC_QUEUE */
 
-	/* end of the transfer : all buffers sent/receceived */
-	LL_SPI_Disable(spi);
-
-	/* This is turned off in spi_stm32_complete(). */
-	spi_context_cs_control(&data->ctx, true);
+	ret = spi_stm32_dma_start(dev, config, tx_bufs, rx_bufs);
+	if (ret == 0) {
+		ret = spi_context_wait_for_completion(&data->ctx);
+	}
 
 	spi_context_release(&data->ctx, ret);
 
@@ -777,6 +785,15 @@ static int spi_stm32_transceive_async(struct device *dev,
 				      const struct spi_buf_set *rx_bufs,
 				      struct k_poll_signal *async)
 {
+#ifdef CONFIG_SPI_STM32_DMA
+	struct spi_stm32_data *data = DEV_DATA(dev);
+
+	if ((data->dma_tx.dma_name != NULL)
+	 && (data->dma_rx.dma_name != NULL)) {
+		return transceive_dma(dev, config, tx_bufs, rx_bufs,
+				      true, async);
+	}
+#endif /* CONFIG_SPI_STM32_DMA */
 	return transceive(dev, config, tx_bufs, rx_bufs, true, async);
 }
 #endif /* CONFIG_SPI_ASYNC */
@@ -871,7 +888,7 @@ static void spi_stm32_irq_config_func_##id(struct device *dev)		\
 		.channel_priority = STM32_DMA_CONFIG_PRIORITY(		\
 					DMA_CHANNEL_CONFIG(index, dir)),\
 		.dma_callback = dma_callback,				\
-		.block_count = 2,					\
+		.block_count = 1,					\
 	},								\
 	.src_addr_increment = STM32_DMA_CONFIG_##src_dev##_ADDR_INC(	\
 				DMA_CHANNEL_CONFIG(index, dir)),	\
@@ -204,21 +204,18 @@ static int spi_mcux_configure(struct device *dev,
 	return 0;
 }
 
-static int transceive(struct device *dev,
-		      const struct spi_config *spi_cfg,
-		      const struct spi_buf_set *tx_bufs,
-		      const struct spi_buf_set *rx_bufs,
-		      bool asynchronous,
-		      struct k_poll_signal *signal)
+/* Start a transaction on the locked context, the interrupt completes it. */
+static int spi_mcux_start(struct device *dev,
+			  const struct spi_config *spi_cfg,
+			  const struct spi_buf_set *tx_bufs,
+			  const struct spi_buf_set *rx_bufs)
 {
 	struct spi_mcux_data *data = dev->data;
 	int ret;
 
-	spi_context_lock(&data->ctx, asynchronous, signal);
-
 	ret = spi_mcux_configure(dev, spi_cfg);
 	if (ret) {
-		goto out;
+		return ret;
 	}
 
 	spi_context_buffers_setup(&data->ctx, tx_bufs, rx_bufs, 1);
@@ -227,11 +224,50 @@ static int transceive(struct device *dev,
 
 	ret = spi_mcux_transfer_next_packet(dev);
 	if (ret) {
-		goto out;
+		spi_context_cs_control(&data->ctx, false);
+	}
+
+	return ret;
+}
+
+#ifdef CONFIG_SPI_ASYNC_QUEUE
+static int spi_mcux_start_queued(struct device *dev,
+				 const struct spi_context_request *req)
+{
+	return spi_mcux_start(dev, req->config, req->tx_bufs, req->rx_bufs);
+}
+#endif /* CONFIG_SPI_ASYNC_QUEUE */
+
+static int transceive(struct device *dev,
+		      const struct spi_config *spi_cfg,
+		      const struct spi_buf_set *tx_bufs,
+		      const struct spi_buf_set *rx_bufs,
+		      bool asynchronous,
+		      struct k_poll_signal *signal)
+{
+	struct spi_mcux_data *data = dev->data;
+	int ret;
+
+#ifdef CONFIG_SPI_ASYNC_QUEUE
+	if (asynchronous) {
+		if (spi_context_lock_or_queue(&data->ctx, dev,
+					      spi_mcux_start_queued, spi_cfg,
+					      tx_bufs, rx_bufs, signal)) {
+			/* started once the transactions ahead are done */
+			return 0;
+		}
+	} else {
+		spi_context_lock(&data->ctx, asynchronous, signal);
+	}
+#else
+	spi_context_lock(&data->ctx, asynchronous, signal);
+#endif /* CONFIG_SPI_ASYNC_QUEUE */
+
+	ret = spi_mcux_start(dev, spi_cfg, tx_bufs, rx_bufs);
+	if (ret == 0) {
+		ret = spi_context_wait_for_completion(&data->ctx);
 	}
 
-	ret = spi_context_wait_for_completion(&data->ctx);
-out:
 	spi_context_release(&data->ctx, ret);
 
 	return ret;
@@ -15,28 +15,39 @@ K_MEM_POOL_DEFINE(video_buffer_pool,
 
 static struct video_buffer video_buf[CONFIG_VIDEO_BUFFER_POOL_NUM_MAX];
 static struct k_mem_block video_block[CONFIG_VIDEO_BUFFER_POOL_NUM_MAX];
+/* References on each video buffer, 0 if the slot is free */
+static uint8_t video_ref[CONFIG_VIDEO_BUFFER_POOL_NUM_MAX];
+static struct k_spinlock video_lock;
 
 struct video_buffer *video_buffer_alloc(size_t size)
 {
 	struct video_buffer *vbuf = NULL;
 	struct k_mem_block *block;
+	k_spinlock_key_t key;
 	int i;
 
 	/* find available video buffer */
+	key = k_spin_lock(&video_lock);
 	for (i = 0; i < ARRAY_SIZE(video_buf); i++) {
-		if (video_buf[i].buffer == NULL) {
+		if (video_ref[i] == 0U) {
+			video_ref[i] = 1U;
 			vbuf = &video_buf[i];
 			block = &video_block[i];
 			break;
 		}
 	}
+	k_spin_unlock(&video_lock, key);
 
 	if (vbuf == NULL) {
 		return NULL;
 	}
 
+	/* Whole cache lines, so that invalidation spares other buffers */
+	size = ROUND_UP(size, CONFIG_VIDEO_BUFFER_POOL_ALIGN);
+
 	/* Alloc buffer memory */
 	if (k_mem_pool_alloc(&video_buffer_pool, block, size, K_FOREVER)) {
+		video_ref[i] = 0U;
 		return NULL;
 	}
 
@@ -47,19 +58,90 @@ struct video_buffer *video_buffer_alloc(size_t size)
 	return vbuf;
 }
 
+void video_buffer_ref(struct video_buffer *vbuf)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&video_lock);
+	__ASSERT(video_ref[vbuf - video_buf] < UINT8_MAX, "Too many references");
+	video_ref[vbuf - video_buf]++;
+	k_spin_unlock(&video_lock, key);
+}
+
 void video_buffer_release(struct video_buffer *vbuf)
 {
-	struct k_mem_block *block = NULL;
-	int i;
+	int i = vbuf - video_buf;
+	k_spinlock_key_t key;
 
-	/* vbuf to block */
-	for (i = 0; i < ARRAY_SIZE(video_buf); i++) {
-		if (video_block[i].data == vbuf->buffer) {
-			block = &video_block[i];
-			break;
-		}
+	key = k_spin_lock(&video_lock);
+	if (video_ref[i] > 1U) {
+		video_ref[i]--;
+		k_spin_unlock(&video_lock, key);
+		return;
 	}
+	k_spin_unlock(&video_lock, key);
 
+	/* Last reference, the slot is freed once the memory is */
 	vbuf->buffer = NULL;
-	k_mem_pool_free(block);
+	k_mem_pool_free(&video_block[i]);
+	video_ref[i] = 0U;
+}
+
+#ifdef CONFIG_NET_BUF
+static struct video_buffer *video_buffer_from_data(uint8_t *data)
+{
+	for (int i = 0; i < ARRAY_SIZE(video_buf); i++) {
+		if (video_buf[i].buffer == data) {
+			return &video_buf[i];
+		}
+	}
+
+	return NULL;
+}
+
+static uint8_t *video_net_buf_data_alloc(struct net_buf *buf, size_t *size,
+					 k_timeout_t timeout)
+{
+	/* Data only comes from video buffers */
+	return NULL;
+}
+
+static uint8_t *video_net_buf_data_ref(struct net_buf *buf, uint8_t *data)
+{
+	video_buffer_ref(video_buffer_from_data(data));
+
+	return data;
+}
+
+static void video_net_buf_data_unref(struct net_buf *buf, uint8_t *data)
+{
+	video_buffer_release(video_buffer_from_data(data));
+}
+
+static const struct net_buf_data_cb video_net_buf_cb = {
+	.alloc = video_net_buf_data_alloc,
+	.ref   = video_net_buf_data_ref,
+	.unref = video_net_buf_data_unref,
+};
+
+const struct net_buf_data_alloc video_net_buf_alloc = {
+	.cb = &video_net_buf_cb,
+};
+
+struct net_buf *video_buffer_net_buf(struct net_buf_pool *pool,
+				     struct video_buffer *vbuf,
+				     k_timeout_t timeout)
+{
+	struct net_buf *buf;
+
+	buf = net_buf_alloc_len(pool, 0, timeout);
+	if (buf == NULL) {
+		return NULL;
+	}
+
+	video_buffer_ref(vbuf);
+	net_buf_simple_init_with_data(&buf->b, vbuf->buffer, vbuf->bytesused);
+
+	return buf;
 }
+#endif
@@ -7,6 +7,7 @@
 #define DT_DRV_COMPAT nxp_imx_csi
 
 #include <zephyr.h>
+#include <string.h>
 
 #include <fsl_csi.h>
 
@@ -29,6 +30,7 @@ struct video_mcux_csi_data {
 	struct k_fifo fifo_out;
 	uint32_t pixelformat;
 	struct k_poll_signal *signal;
+	struct video_stats stats;
 };
 
 static inline unsigned int video_pix_fmt_bpp(uint32_t pixelformat)
@@ -97,6 +99,11 @@ static void __frame_done_cb(CSI_Type *base, csi_handle_t *handle,
 
 	vbuf->timestamp = k_uptime_get_32();
 
+	if (data->stats.frames++ == 0U) {
+		data->stats.first_timestamp = vbuf->timestamp;
+	}
+	data->stats.last_timestamp = vbuf->timestamp;
+
 #ifdef CONFIG_HAS_MCUX_CACHE
 	DCACHE_InvalidateByRange(buffer_addr, vbuf->bytesused);
 #endif
@@ -104,6 +111,10 @@ static void __frame_done_cb(CSI_Type *base, csi_handle_t *handle,
 	k_fifo_put(&data->fifo_out, vbuf);
 
 done:
+	if (result == VIDEO_BUF_ERROR) {
+		data->stats.dropped++;
+	}
+
 	/* Trigger Event */
 	if (IS_ENABLED(CONFIG_POLL) && data->signal) {
 		k_poll_signal_raise(data->signal, result);
@@ -180,6 +191,8 @@ static int video_mcux_csi_stream_start(struct device *dev)
 	struct video_mcux_csi_data *data = dev->data;
 	status_t ret;
 
+	memset(&data->stats, 0, sizeof(data->stats));
+
 	ret = CSI_TransferStart(config->base, &data->csi_handle);
 	if (ret != kStatus_Success) {
 		return -EIO;
@@ -385,6 +398,24 @@ static int video_mcux_csi_set_signal(struct device *dev,
 }
 #endif
 
+static int video_mcux_csi_get_stats(struct device *dev,
+				    enum video_endpoint_id ep,
+				    struct video_stats *stats)
+{
+	struct video_mcux_csi_data *data = dev->data;
+	unsigned int key;
+
+	if (ep != VIDEO_EP_OUT) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+	*stats = data->stats;
+	irq_unlock(key);
+
+	return 0;
+}
+
 static const struct video_driver_api video_mcux_csi_driver_api = {
 	.set_format = video_mcux_csi_set_fmt,
 	.get_format = video_mcux_csi_get_fmt,
@@ -399,6 +430,7 @@ static const struct video_driver_api video_mcux_csi_driver_api = {
 #ifdef CONFIG_POLL
 	.set_signal = video_mcux_csi_set_signal,
 #endif
+	.get_stats = video_mcux_csi_get_stats,
 };
 
 #if 1 /* Unique Instance */
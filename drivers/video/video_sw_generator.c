@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <zephyr.h>
+#include <string.h>
 
 #include <drivers/video.h>
 
@@ -20,6 +21,7 @@ struct video_sw_generator_data {
 	bool ctrl_hflip;
 	bool ctrl_vflip;
 	struct k_poll_signal *signal;
+	struct video_stats stats;
 };
 
 static int video_sw_generator_set_fmt(struct device *dev,
@@ -56,6 +58,8 @@ static int video_sw_generator_stream_start(struct device *dev)
 {
 	struct video_sw_generator_data *data = dev->data;
 
+	memset(&data->stats, 0, sizeof(data->stats));
+
 	return k_delayed_work_submit(&data->buf_work, K_MSEC(33));
 }
 
@@ -105,6 +109,7 @@ static void __buffer_work(struct k_work *work)
 
 	vbuf = k_fifo_get(&data->fifo_in, K_NO_WAIT);
 	if (vbuf == NULL) {
+		data->stats.dropped++;
 		return;
 	}
 
@@ -114,6 +119,11 @@ static void __buffer_work(struct k_work *work)
 		break;
 	}
 
+	if (data->stats.frames++ == 0U) {
+		data->stats.first_timestamp = vbuf->timestamp;
+	}
+	data->stats.last_timestamp = vbuf->timestamp;
+
 	k_fifo_put(&data->fifo_out, vbuf);
 
 	if (IS_ENABLED(CONFIG_POLL) && data->signal) {
@@ -222,6 +232,24 @@ static int video_sw_generator_set_signal(struct device *dev,
 }
 #endif
 
+static int video_sw_generator_get_stats(struct device *dev,
+					enum video_endpoint_id ep,
+					struct video_stats *stats)
+{
+	struct video_sw_generator_data *data = dev->data;
+	unsigned int key;
+
+	if (ep != VIDEO_EP_OUT) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+	*stats = data->stats;
+	irq_unlock(key);
+
+	return 0;
+}
+
 static inline int video_sw_generator_set_ctrl(struct device *dev,
 					      unsigned int cid,
 					      void *value)
@@ -252,6 +280,7 @@ static const struct video_driver_api video_sw_generator_driver_api = {
 #ifdef CONFIG_POLL
 	.set_signal = video_sw_generator_set_signal,
 #endif
+	.get_stats = video_sw_generator_get_stats,
 };
 
 static struct video_sw_generator_data video_sw_generator_data_0 = {
@@ -14,6 +14,11 @@
 #define _SCS_ICSR_PENDSV (1 << 28)
 #define _SCS_ICSR_UNPENDSV (1 << 27)
 #define _SCS_ICSR_RETTOBASE (1 << 11)
+#define _SCS_CPACR (_SCS_BASE_ADDR + 0xd88)
+#define _SCS_CPACR_CP10_CP11_Msk (0xf << 20)
+#define _SCS_CPACR_CP10_CP11_PRIV (0x5 << 20)
+#define _SCS_FPCCR (_SCS_BASE_ADDR + 0xf34)
+#define _SCS_FPCCR_LSPACT (1 << 0)
 
 #endif
 
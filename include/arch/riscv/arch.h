@@ -43,9 +43,11 @@
 #ifdef CONFIG_CPU_HAS_FPU_DOUBLE_PRECISION
 #define RV_OP_LOADFPREG fld
 #define RV_OP_STOREFPREG fsd
+#define RV_FPREGSIZE 8
 #else
 #define RV_OP_LOADFPREG flw
 #define RV_OP_STOREFPREG fsw
+#define RV_FPREGSIZE 4
 #endif
 
 /* Common mstatus bits. All supported cores today have the same
@@ -70,6 +70,10 @@ typedef struct _callee_saved _callee_saved_t;
 
 struct _thread_arch {
 	uint32_t swap_return_value; /* Return value of z_swap() */
+#ifdef CONFIG_FPU_SHARING_LAZY
+	/* ft0-ft11 and fa0-fa7, saved when another thread takes the FPU */
+	RV_FP_TYPE fp_caller_saved[20];
+#endif
 };
 
 typedef struct _thread_arch _thread_arch_t;
@@ -38,12 +38,64 @@ struct bt_avdtp_seid_lsep {
 	struct bt_avdtp_seid_lsep *next;
 };
 
+/** @brief AVDTP Media Packet Header
+ *
+ *  Fields of the RTP header preceding the payload of each media packet.
+ */
+struct bt_avdtp_media_hdr {
+	/** Marker bit */
+	uint8_t marker:1;
+	/** RTP payload type */
+	uint8_t payload_type:7;
+	/** Sequence number */
+	uint16_t seq;
+	/** Timestamp, in units of the codec sampling clock */
+	uint32_t timestamp;
+	/** Synchronization source identifier */
+	uint32_t ssrc;
+};
+
+struct bt_avdtp_stream;
+
+/** @brief AVDTP Stream Transport Channel Callbacks */
+struct bt_avdtp_stream_ops {
+	/** @brief Transport channel connected.
+	 *
+	 *  @param stream The stream whose transport channel was connected.
+	 */
+	void (*connected)(struct bt_avdtp_stream *stream);
+
+	/** @brief Transport channel disconnected.
+	 *
+	 *  @param stream The stream whose transport channel was disconnected.
+	 */
+	void (*disconnected)(struct bt_avdtp_stream *stream);
+
+	/** @brief Media packet received.
+	 *
+	 *  The RTP header has already been removed from the buffer, which
+	 *  only contains the media payload. The buffer is the one the L2CAP
+	 *  SDU was received in; in order to queue it, e.g. into a jitter
+	 *  buffer, without copying the payload, take a reference with
+	 *  net_buf_ref() and release it once the payload has been consumed.
+	 *  Note that held buffers are not available for further reception.
+	 *
+	 *  @param stream The stream the packet was received on.
+	 *  @param hdr RTP header of the packet.
+	 *  @param buf Buffer containing the media payload.
+	 */
+	void (*recv)(struct bt_avdtp_stream *stream,
+		     const struct bt_avdtp_media_hdr *hdr,
+		     struct net_buf *buf);
+};
+
 /** @brief AVDTP Stream */
 struct bt_avdtp_stream {
 	struct bt_l2cap_br_chan chan; /* Transport Channel*/
 	struct bt_avdtp_seid_info lsep; /* Configured Local SEP */
 	struct bt_avdtp_seid_info rsep; /* Configured Remote SEP*/
 	uint8_t state; /* current state of the stream */
+	const struct bt_avdtp_stream_ops *ops; /* Transport callbacks */
 	struct bt_avdtp_stream *next;
 };
 
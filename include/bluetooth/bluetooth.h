@@ -1291,6 +1291,59 @@ int bt_le_scan_stop(void);
  */
 void bt_le_scan_cb_register(struct bt_le_scan_cb *cb);
 
+/** LE scan report filter parameters.
+ *
+ *  Each non-empty accept list is a condition which a report must satisfy by
+ *  matching at least one entry of the list. Reports must satisfy all the
+ *  conditions to be delivered.
+ */
+struct bt_le_scan_filter {
+	/** Minimum RSSI in dBm, weaker reports are dropped. 0 to disable. */
+	int8_t rssi_min;
+
+	/** Window in milliseconds during which reports with the same
+	 *  advertiser address, type and data as an already delivered report
+	 *  are dropped. 0 to disable.
+	 */
+	uint16_t dedup_window;
+
+	/** Accepted advertiser addresses. Identity addresses are used for
+	 *  advertisers that could be resolved.
+	 */
+	const bt_addr_le_t *addrs;
+
+	/** Number of entries in addrs. */
+	size_t addr_count;
+
+	/** Accepted 16-bit Service UUIDs. */
+	const uint16_t *uuid16s;
+
+	/** Number of entries in uuid16s. */
+	size_t uuid16_count;
+
+	/** Accepted Manufacturer Specific Data company identifiers. */
+	const uint16_t *company_ids;
+
+	/** Number of entries in company_ids. */
+	size_t company_id_count;
+};
+
+/** @brief Set the host side scan report filter.
+ *
+ *  Reports which do not pass the filter are dropped by the host before any
+ *  scan callback is called. Partial extended advertising reports are only
+ *  checked against the address list and the RSSI threshold.
+ *  Requires :option:`CONFIG_BT_SCAN_FILTER`.
+ *
+ *  @param filter Filter parameters, or NULL to deliver all reports. The
+ *                accept lists are not copied and must remain valid while the
+ *                filter is in use.
+ *
+ *  @return Zero on success or (negative) error code otherwise.
+ *  @return -EBUSY if scanning is ongoing.
+ */
+int bt_le_scan_filter_set(const struct bt_le_scan_filter *filter);
+
 /** @brief Add device (LE) to whitelist.
  *
  *  Add peer device LE address to the whitelist.
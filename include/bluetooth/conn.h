@@ -373,6 +373,33 @@ struct bt_conn_remote_info {
  */
 int bt_conn_get_info(const struct bt_conn *conn, struct bt_conn_info *info);
 
+/** Connection data counters */
+struct bt_conn_stats {
+	/** ACL data bytes sent to the controller, ACL headers excluded */
+	uint32_t tx_bytes;
+	/** ACL data packets sent to the controller */
+	uint32_t tx_packets;
+	/** ACL data packets the controller reported as completed */
+	uint32_t tx_completed;
+	/** ACL data bytes received, ACL headers excluded */
+	uint32_t rx_bytes;
+	/** ACL data packets received */
+	uint32_t rx_packets;
+};
+
+/** @brief Get connection data counters
+ *
+ *  The counters start at zero when the connection object is created.
+ *  Throughput is obtained by sampling them periodically.
+ *
+ *  @param conn Connection object.
+ *  @param stats Connection counters object.
+ *
+ *  @return Zero on success or (negative) error code on failure.
+ *  @retval -ENOTSUP :option:`CONFIG_BT_CONN_STATS` is disabled.
+ */
+int bt_conn_get_stats(const struct bt_conn *conn, struct bt_conn_stats *stats);
+
 /** @brief Get connection info for the remote device.
  *
  *  @param conn Connection object.
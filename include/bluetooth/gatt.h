@@ -868,6 +868,12 @@ struct bt_gatt_notify_params {
  *  parameters, when using this method the attribute given is used as the
  *  start range when looking up for possible matches.
  *
+ *  If @p conn is NULL the value is sent to every subscribed peer. With
+ *  :option:`CONFIG_BT_GATT_NOTIFY_MULTIPLE`, values for peers which enabled
+ *  the Multiple Handle Value Notification feature are batched into a
+ *  single ATT_MULTIPLE_HANDLE_VALUE_NTF per peer, also across calls made
+ *  before the System Workqueue runs.
+ *
  *  @param conn Connection object.
  *  @param params Notification parameters.
  *
@@ -877,6 +883,10 @@ int bt_gatt_notify_cb(struct bt_conn *conn,
 		      struct bt_gatt_notify_params *params);
 
 /** @brief Notify multiple attribute value change.
+ *
+ *  Values are batched into Multiple Handle Value Notifications for
+ *  peers supporting them, see @ref bt_gatt_notify_cb. If @p conn is NULL
+ *  the values are sent to every subscribed peer.
  *
  *  @param conn Connection object.
  *  @param num_params Number of notification parameters.
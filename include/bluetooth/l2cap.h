@@ -398,6 +398,11 @@ int bt_l2cap_chan_disconnect(struct bt_l2cap_chan *chan);
  *
  *  Send data from buffer to the channel. If credits are not available, buf will
  *  be queued and sent as and when credits are received from peer.
+ *  For LE connection oriented channels, data is sent without being copied
+ *  whenever a fragment of buf fits in a single segment and has at least
+ *  BT_L2CAP_CHAN_SEND_RESERVE bytes of headroom (plus 2 bytes for the SDU
+ *  length on the first fragment). Large SDUs can thus be given as a chain of
+ *  fragments of up to the channel's TX MPS each.
  *  Regarding to first input parameter, to get details see reference description
  *  to bt_l2cap_chan_connect() API above.
  *
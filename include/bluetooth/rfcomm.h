@@ -94,6 +94,9 @@ struct bt_rfcomm_dlc {
 	uint8_t                       state;
 	uint8_t                       rx_credit;
 
+	/* RX credits waiting to be returned along with outgoing data */
+	atomic_t                   rx_credit_pending;
+
 	/* Stack & kernel data for TX thread */
 	struct k_thread            tx_thread;
 	K_KERNEL_STACK_MEMBER(stack, 256);
@@ -214,6 +214,41 @@ int isotp_recv(struct isotp_recv_ctx *ctx, uint8_t *data, size_t len,
 int isotp_recv_net(struct isotp_recv_ctx *ctx, struct net_buf **buffer,
 		   k_timeout_t timeout);
 
+/**
+ * @brief Set the buffer messages are received in
+ *
+ * Multi-frame messages are then written straight to this buffer as their
+ * consecutive frames arrive, without net_buf allocation, and read with
+ * isotp_recv_sdu(). The block size may be zero whatever the message
+ * length, as no buffer has to be allocated during the reception.
+ * Messages larger than the buffer, or arriving while the buffer holds a
+ * message not yet released, are received in net-buffers and read with
+ * isotp_recv() or isotp_recv_net().
+ *
+ * @param ctx  Context that is already bound.
+ * @param buf  Buffer for the messages, valid until unbind, or NULL.
+ * @param len  Size of the buffer.
+ *
+ * @retval ISOTP_N_OK on success
+ * @retval ISOTP_N_ERROR if a message is being received in the buffer.
+ */
+int isotp_recv_sdu_buf(struct isotp_recv_ctx *ctx, uint8_t *buf, size_t len);
+
+/**
+ * @brief Wait for a message received in the buffer
+ *
+ * Releases the message returned by the previous call, the buffer then
+ * takes the next message, and waits until it is complete.
+ *
+ * @param ctx     Context with a buffer set by isotp_recv_sdu_buf().
+ * @param timeout Timeout for incoming data.
+ *
+ * @retval Length of the message, at the start of the buffer
+ * @retval ISOTP_RECV_TIMEOUT when "timeout" timed out
+ * @retval ISOTP_N_* on error
+ */
+int isotp_recv_sdu(struct isotp_recv_ctx *ctx, k_timeout_t timeout);
+
 /**
  * @brief Send data
  *
@@ -378,6 +413,11 @@ struct isotp_recv_ctx {
 	uint8_t bs;
 	uint8_t wft;
 	uint8_t sn_expected : 4;
+	uint8_t sdu_state;
+	uint8_t *sdu_buf;
+	size_t sdu_size;
+	size_t sdu_len;
+	struct k_sem sdu_sem;
 };
 
 /** @endcond */
@@ -711,6 +711,167 @@ int json_obj_encode(const struct json_obj_descr *descr, size_t descr_len,
 int json_arr_encode(const struct json_obj_descr *descr, const void *val,
 		    json_append_bytes_t append_bytes, void *data);
 
+/**
+ * @brief Event reported by the streaming JSON parser
+ *
+ * Strings are reported without their surrounding quotes and with escape
+ * sequences left untouched; neither @a key nor @a value is NUL-terminated.
+ * Both point into the parser's scratch buffer and are only valid for the
+ * duration of the callback.
+ */
+struct json_stream_event {
+	/** One of JSON_TOK_OBJECT_START, JSON_TOK_OBJECT_END,
+	 * JSON_TOK_LIST_START, JSON_TOK_LIST_END, JSON_TOK_STRING,
+	 * JSON_TOK_NUMBER, JSON_TOK_TRUE, JSON_TOK_FALSE or JSON_TOK_NULL
+	 */
+	enum json_tokens type;
+	/** Nesting level of the value, 0 for the top-level value */
+	uint8_t depth;
+	/** Key of the value if it is an object member, NULL otherwise */
+	const char *key;
+	/** Length of @a key */
+	size_t key_len;
+	/** Text of a string or number, NULL for other tokens */
+	const char *value;
+	/** Length of @a value */
+	size_t value_len;
+};
+
+/**
+ * @brief Function called by the streaming parser for each event
+ *
+ * @param event Event being reported
+ *
+ * @param user_data Pointer given to json_stream_init()
+ *
+ * @return 0 to continue parsing, a negative value to abort it. The value
+ * is then returned by json_stream_feed() or json_stream_finish().
+ */
+typedef int (*json_stream_cb_t)(const struct json_stream_event *event,
+				void *user_data);
+
+/**
+ * @brief Streaming JSON parser state
+ *
+ * All fields are private; use json_stream_init() to set up the parser.
+ */
+struct json_stream_parser {
+	json_stream_cb_t cb;
+	void *user_data;
+	char *buf;
+	size_t buf_size;
+	size_t key_len;
+	size_t value_len;
+	uint32_t objects;
+	uint8_t depth;
+	uint8_t state;
+	uint8_t lex;
+	uint8_t lex_aux;
+	bool in_key;
+	int error;
+};
+
+/**
+ * @brief Initializes a streaming JSON parser
+ *
+ * The streaming parser accepts a document in arbitrarily sized fragments
+ * and reports every value through @a cb as soon as it has been fully
+ * received, so documents never have to be linearized in memory and
+ * arbitrarily long arrays can be processed one element at a time.
+ * Containers may be nested up to 32 levels deep.
+ *
+ * @param parser Parser to initialize
+ *
+ * @param buf Scratch buffer holding the current key and scalar value
+ *
+ * @param buf_size Size of @a buf, which bounds the combined length of an
+ * object key and its (scalar) value
+ *
+ * @param cb Function called for each event
+ *
+ * @param user_data Pointer passed to @a cb
+ */
+void json_stream_init(struct json_stream_parser *parser, char *buf,
+		      size_t buf_size, json_stream_cb_t cb, void *user_data);
+
+/**
+ * @brief Feeds a fragment of a JSON document to a streaming parser
+ *
+ * @param parser Parser initialized with json_stream_init()
+ *
+ * @param data Fragment of the document; it is not modified and may be
+ * discarded once this function returns
+ *
+ * @param len Length of @a data
+ *
+ * @return 0 if the fragment has been consumed, -EINVAL on a syntax error,
+ * -ENOMEM if a token does not fit in the scratch buffer or nesting is too
+ * deep, or an error returned by the callback. Errors are sticky: once an
+ * error has been returned, every further call returns it as well.
+ */
+int json_stream_feed(struct json_stream_parser *parser, const char *data,
+		     size_t len);
+
+/**
+ * @brief Signals the end of the document to a streaming parser
+ *
+ * A top-level number is only reported at this point, since until then
+ * more digits could follow.
+ *
+ * @param parser Parser initialized with json_stream_init()
+ *
+ * @return 0 if a complete document has been parsed, -EINVAL if it is
+ * truncated, or the error previously returned by json_stream_feed().
+ */
+int json_stream_finish(struct json_stream_parser *parser);
+
+#if defined(CONFIG_NET_BUF) || defined(__DOXYGEN__)
+#include <net/buf.h>
+
+/**
+ * @brief Feeds every fragment of a net_buf chain to a streaming parser
+ *
+ * @param parser Parser initialized with json_stream_init()
+ *
+ * @param buf Head of the fragment chain
+ *
+ * @return See json_stream_feed().
+ */
+int json_stream_feed_net_buf(struct json_stream_parser *parser,
+			     const struct net_buf *buf);
+
+/**
+ * @brief Output context for json_append_bytes_to_net_buf()
+ */
+struct json_net_buf_appender {
+	/** Head of the fragment chain receiving the output */
+	struct net_buf *buf;
+	/** Pool to allocate additional fragments from, or NULL to fail
+	 * once @a buf is full
+	 */
+	struct net_buf_pool *pool;
+	/** Timeout used when allocating fragments */
+	k_timeout_t timeout;
+};
+
+/**
+ * @brief Append function writing into a net_buf chain
+ *
+ * Can be passed to json_obj_encode() or json_arr_encode() together with a
+ * struct json_net_buf_appender, so that the encoded document is written
+ * directly into network buffers, growing the chain as required.
+ *
+ * @param bytes Bytes to append
+ *
+ * @param len Number of bytes to append
+ *
+ * @param data Pointer to a struct json_net_buf_appender
+ *
+ * @return 0 on success, -ENOMEM if no fragment could be allocated.
+ */
+int json_append_bytes_to_net_buf(const char *bytes, size_t len, void *data);
+#endif /* CONFIG_NET_BUF */
+
 #ifdef __cplusplus
 }
 #endif
@@ -10,6 +10,10 @@
 #include <zephyr/types.h>
 #include <stdbool.h>
 
+#ifdef CONFIG_JWT_SIGN_RSA
+#include <mbedtls/pk.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -82,11 +86,62 @@ int jwt_add_payload(struct jwt_builder *builder,
 
 /**
  * @brief Sign the JWT token.
+ *
+ * The key is parsed for each call, see jwt_signer_init() to parse it
+ * once for many tokens.
  */
 int jwt_sign(struct jwt_builder *builder,
 	     const char *der_key,
 	     size_t der_key_len);
 
+/**
+ * @brief Reusable JWT signing context.
+ *
+ * Holds the signing key, parsed once by jwt_signer_init(), for the
+ * signature of any number of tokens with jwt_signer_sign().
+ */
+struct jwt_signer {
+#ifdef CONFIG_JWT_SIGN_RSA
+	/* Parsed RSA private key. */
+	mbedtls_pk_context pk;
+#endif
+#ifdef CONFIG_JWT_SIGN_ECDSA
+	/* Raw P-256 private key, referenced and not copied. */
+	const uint8_t *key;
+#endif
+};
+
+/**
+ * @brief Initialize a JWT signer.
+ *
+ * @param signer The signer to initialize.
+ * @param der_key The private key, DER encoded for RSA or the raw 32
+ * bytes key for ECDSA, which must then stay valid until
+ * jwt_signer_free().
+ * @param der_key_len The length of the key.
+ *
+ * @retval 0 Success
+ * @retval <0 Failure to parse the key
+ */
+int jwt_signer_init(struct jwt_signer *signer,
+		    const char *der_key,
+		    size_t der_key_len);
+
+/**
+ * @brief Release the resources of a JWT signer.
+ */
+void jwt_signer_free(struct jwt_signer *signer);
+
+/**
+ * @brief Sign the JWT token with a JWT signer.
+ *
+ * @retval 0 Success
+ * @retval -ENOMEM The token overflowed its buffer
+ * @retval <0 Other signature failure
+ */
+int jwt_signer_sign(struct jwt_signer *signer,
+		    struct jwt_builder *builder);
+
 
 static inline size_t jwt_payload_len(struct jwt_builder *builder)
 {
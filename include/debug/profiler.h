@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_DEBUG_PROFILER_H_
+#define ZEPHYR_INCLUDE_DEBUG_PROFILER_H_
+
+#include <kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup profiler Sampling profiler
+ *  @brief Module sampling the interrupted program counter
+ *
+ *  Samples are taken periodically from the system timer interrupt or from
+ *  a counter alarm interrupt, and stored in a buffer until it is full.
+ *  They can be printed with the "profiler dump" shell command and turned
+ *  into a flame graph with scripts/profiler/profiler_flamegraph.py.
+ *  @{
+ */
+
+/** @brief Profiler sample. */
+struct profiler_sample {
+	/** Interrupted program counter, 0 if unknown, e.g. when the sample
+	 * interrupted another interrupt or on unsupported architectures.
+	 */
+	uintptr_t pc;
+	/** Link register of the interrupted code, approximating its caller,
+	 * 0 if unknown or disabled.
+	 */
+	uintptr_t caller;
+	/** Interrupted thread. */
+	const struct k_thread *thread;
+};
+
+/** @brief Start sampling.
+ *
+ *  Samples are appended to the samples already taken, until the buffer is
+ *  full.
+ *
+ *  @param rate Sampling rate in Hz. With the system timer source, the
+ *		period is rounded to system ticks.
+ *
+ *  @retval 0 on success.
+ *  @retval -EINVAL if the rate is not supported.
+ *  @retval -EALREADY if already started.
+ *  @retval -ENODEV if the counter device is not available.
+ */
+int profiler_start(uint32_t rate);
+
+/** @brief Stop sampling. */
+void profiler_stop(void);
+
+/** @brief Discard the samples taken. Profiler must be stopped. */
+void profiler_reset(void);
+
+/** @brief Get the samples taken.
+ *
+ *  @param samples Set to the array of samples.
+ *
+ *  @return Number of samples.
+ */
+size_t profiler_samples_get(const struct profiler_sample **samples);
+
+/** @brief Get the number of samples dropped because the buffer was full.
+ *
+ *  @return Number of dropped samples.
+ */
+uint32_t profiler_dropped_get(void);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DEBUG_PROFILER_H_ */
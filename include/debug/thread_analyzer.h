@@ -29,6 +29,11 @@ struct thread_analyzer_info {
 	size_t stack_size;
 	/** Stack size in used */
 	size_t stack_used;
+
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	/** Share of the cycles run by all threads, in percent */
+	unsigned int utilization;
+#endif
 };
 
 /** @brief Thread analyzer stack size callback function
@@ -125,6 +125,45 @@ extern "C" {
  */
 #define DEVICE_DEFINE(dev_name, drv_name, init_fn, pm_control_fn,	\
 		      data_ptr, cfg_ptr, level, prio, api_ptr)		\
+	Z_DEVICE_OBJ_DEFINE(dev_name, drv_name, pm_control_fn,		\
+			    data_ptr, cfg_ptr, level, prio, api_ptr)	\
+	Z_INIT_ENTRY_DEFINE(_CONCAT(__device_, dev_name), init_fn,	\
+			    (&_CONCAT(__device_, dev_name)), level, prio)
+
+/**
+ * @def DEVICE_DEFINE_ASYNC
+ *
+ * @brief Like DEVICE_DEFINE(), but the init function may run in parallel
+ *
+ * @details With CONFIG_INIT_PARALLEL, the init function of a POST_KERNEL or
+ * later device runs on a boot worker thread, concurrently with the init
+ * entries that follow it in the same level.  Users of the device that are
+ * initialized in the same level must call device_init_wait() before using
+ * it.  See SYS_INIT_ASYNC().
+ */
+#define DEVICE_DEFINE_ASYNC(dev_name, drv_name, init_fn, pm_control_fn,	\
+			    data_ptr, cfg_ptr, level, prio, api_ptr)	\
+	Z_DEVICE_OBJ_DEFINE(dev_name, drv_name, pm_control_fn,		\
+			    data_ptr, cfg_ptr, level, prio, api_ptr)	\
+	Z_INIT_ENTRY_ASYNC_DEFINE(_CONCAT(__device_, dev_name), init_fn, \
+				  (&_CONCAT(__device_, dev_name)),	\
+				  level, prio)
+
+/**
+ * @def DEVICE_AND_API_INIT_ASYNC
+ *
+ * @brief Invoke DEVICE_DEFINE_ASYNC() with no power management support
+ * (@p pm_control_fn).
+ */
+#define DEVICE_AND_API_INIT_ASYNC(dev_name, drv_name, init_fn,		\
+				  data_ptr, cfg_ptr, level, prio, api_ptr) \
+	DEVICE_DEFINE_ASYNC(dev_name, drv_name, init_fn,		\
+			    device_pm_control_nop,			\
+			    data_ptr, cfg_ptr, level, prio, api_ptr)
+
+/* Device object part of DEVICE_DEFINE() */
+#define Z_DEVICE_OBJ_DEFINE(dev_name, drv_name, pm_control_fn,		\
+			    data_ptr, cfg_ptr, level, prio, api_ptr)	\
 	Z_DEVICE_DEFINE_PM(dev_name)					\
 	static Z_DECL_ALIGN(struct device)				\
 		DEVICE_NAME_GET(dev_name) __used			\
@@ -134,9 +173,7 @@ extern "C" {
 		.api = (api_ptr),					\
 		.data = (data_ptr),					\
 		Z_DEVICE_DEFINE_PM_INIT(dev_name, pm_control_fn)	\
-	};								\
-	Z_INIT_ENTRY_DEFINE(_CONCAT(__device_, dev_name), init_fn,	\
-			    (&_CONCAT(__device_, dev_name)), level, prio)
+	};
 
 /**
  * @def DEVICE_GET
@@ -250,6 +287,23 @@ static inline bool z_device_ready(const struct device *dev)
 	return dev->api != NULL;
 }
 
+/**
+ * @brief Wait for the initialization of a device to complete.
+ *
+ * Devices defined with DEVICE_DEFINE_ASYNC() may still be initializing
+ * when later init entries of the same level run.  An init function that
+ * depends on such a device calls this routine first.  For any other device,
+ * or once the device's init level has completed, it returns immediately.
+ *
+ * @param dev Device to wait for.
+ *
+ * @retval 0 The device is initialized and ready for use.
+ * @retval -ENODEV The device failed to initialize.
+ * @retval -EAGAIN The device is initialized in parallel and its init entry
+ *         has not been started yet.
+ */
+int device_init_wait(struct device *dev);
+
 /**
  * @}
  */
@@ -14,10 +14,33 @@
 extern "C" {
 #endif
 
+#ifdef CONFIG_IMG_DELTA
+/** State of the delta patch applier, see flash_img_delta_write(). */
+struct flash_img_delta {
+	const struct flash_area *src;
+	uint32_t src_off;
+	/* Bytes of the new image still to produce */
+	uint32_t left;
+	uint32_t diff_len;
+	uint32_t extra_len;
+	int32_t seek;
+	uint8_t hdr[12];
+	uint8_t hdr_len;
+	uint8_t state;
+};
+#endif
+
 struct flash_img_context {
 	uint8_t buf[CONFIG_IMG_BLOCK_BUF_SIZE];
+#ifdef CONFIG_IMG_WRITE_BACKGROUND
+	/* Filled while buf is programmed, and the other way around */
+	uint8_t buf2[CONFIG_IMG_BLOCK_BUF_SIZE];
+#endif
 	const struct flash_area *flash_area;
 	struct stream_flash_ctx stream;
+#ifdef CONFIG_IMG_DELTA
+	struct flash_img_delta delta;
+#endif
 };
 
 /**
@@ -68,6 +91,90 @@ size_t flash_img_bytes_written(struct flash_img_context *ctx);
 int flash_img_buffered_write(struct flash_img_context *ctx, const uint8_t *data,
 		    size_t len, bool flush);
 
+#ifdef CONFIG_IMG_ENABLE_IMAGE_CHECK
+/** Expected hash of an image, see flash_img_check(). */
+struct flash_img_check {
+	/** SHA-256 hash the image must match */
+	const uint8_t *match;
+	/** Length of the image in bytes */
+	size_t clen;
+};
+
+/**
+ * @brief Verify the SHA-256 hash of the image written.
+ *
+ * The hash is the one computed as the image was written, unless
+ * CONFIG_IMG_CHECK_READBACK is enabled, in which case the image is read
+ * back from the flash area. This is meant to be called after the final
+ * flash_img_buffered_write(), before requesting the upgrade with
+ * boot_request_upgrade().
+ *
+ * @param ctx     context the image was written with
+ * @param fic     expected hash and length of the image
+ * @param area_id flash area id of the partition holding the image
+ *
+ * @return  0 on success, -EINVAL if the hash or the length do not match,
+ * negative errno code on other failures
+ */
+int flash_img_check(struct flash_img_context *ctx,
+		    const struct flash_img_check *fic,
+		    uint8_t area_id);
+#endif
+
+#ifdef CONFIG_IMG_DELTA
+/**
+ * @brief Prepare a context to apply a delta patch.
+ *
+ * Must be called after flash_img_init() or flash_img_init_id().
+ *
+ * @param ctx         context
+ * @param src_area_id flash area id of the partition holding the image the
+ *                    patch was made against
+ *
+ * @return  0 on success, negative errno code on fail
+ */
+int flash_img_delta_init_id(struct flash_img_context *ctx,
+			    uint8_t src_area_id);
+
+/**
+ * @brief Prepare a context to apply a delta patch against the image in
+ * the primary slot.
+ *
+ * @param ctx context
+ *
+ * @return  0 on success, negative errno code on fail
+ */
+int flash_img_delta_init(struct flash_img_context *ctx);
+
+/**
+ * @brief Process a delta patch, writing the image it describes.
+ *
+ * The patch is a bsdiff-style patch with its streams interleaved, so that
+ * it can be applied as it is received with bounded RAM. All integers are
+ * little-endian:
+ *
+ * - a header made of the magic "ZDLT" and the 32-bit size of the new image,
+ * - records made of three 32-bit words: diff length, extra length and a
+ *   signed seek, followed by diff length bytes to add to the source bytes
+ *   and by extra length bytes to copy. The source offset advances by the
+ *   diff length, then by the seek.
+ *
+ * The patch ends once the new image is complete. The resulting image is
+ * written with flash_img_buffered_write().
+ *
+ * @param ctx context
+ * @param data patch data
+ * @param len Number of bytes of patch data
+ * @param flush when true, the patch must be complete and the image is
+ * flushed to flash
+ *
+ * @return  0 on success, -EINVAL on a malformed patch, negative errno code
+ * on other failures
+ */
+int flash_img_delta_write(struct flash_img_context *ctx, const uint8_t *data,
+			  size_t len, bool flush);
+#endif /* CONFIG_IMG_DELTA */
+
 #ifdef __cplusplus
 }
 #endif
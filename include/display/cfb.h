@@ -113,6 +113,10 @@ int cfb_framebuffer_invert(struct device *dev);
  * @brief Finalize framebuffer and write it to display RAM,
  * invert or reorder pixels if necessary.
  *
+ * Only the rows of tiles changed since the previous call are written, the
+ * whole framebuffer is written if the display keeps alternating RAM
+ * buffers without partial update support.
+ *
  * @param dev Pointer to device structure for driver instance
  *
  * @return 0 on success, negative value otherwise
@@ -229,6 +229,29 @@ typedef enum adc_action (*adc_sequence_callback)(
 				const struct adc_sequence *sequence,
 				uint16_t sampling_index);
 
+/**
+ * @brief Type definition of the callback function to be called in the
+ *        continuous mode each time a block of samples is filled.
+ *
+ * The sequence buffer is used as a double buffer, the driver fills one
+ * half while the other one is handed over to this callback. The callback is
+ * called in the interrupt context and must be done with the block before
+ * the driver wraps around to it.
+ *
+ * @param dev       Pointer to the device structure for the driver instance.
+ * @param sequence  Pointer to the sequence structure that triggered the
+ *                  sampling.
+ * @param block     Pointer to the filled block, within the sequence buffer.
+ * @param size      Size of the block in bytes, half of the buffer size.
+ *
+ * @returns ADC_ACTION_FINISH to stop the sampling, any other action to go
+ *          on. See @ref adc_action.
+ */
+typedef enum adc_action (*adc_block_callback)(
+				struct device *dev,
+				const struct adc_sequence *sequence,
+				const void *block, size_t size);
+
 /**
  * @brief Structure defining additional options for an ADC sampling sequence.
  */
@@ -255,6 +278,19 @@ struct adc_sequence_options {
 	 * is 1 + extra_samplings).
 	 */
 	uint16_t extra_samplings;
+
+	/**
+	 * Callback function to be called each time a block of samples is
+	 * filled. Setting it selects the continuous mode, in which the driver
+	 * keeps sampling into the buffer, through DMA, until the callback
+	 * returns ADC_ACTION_FINISH. The read request only completes then,
+	 * callback and extra_samplings are not used and interval_us is the
+	 * period of the samplings paced by the ADC hardware, 0 meaning as
+	 * fast as the conversions go.
+	 * Optional - set to NULL if it is not needed. Requires
+	 * CONFIG_ADC_CONTINUOUS and a driver supporting it.
+	 */
+	adc_block_callback block_callback;
 };
 
 /**
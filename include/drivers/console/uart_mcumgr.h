@@ -40,6 +40,30 @@ struct uart_mcumgr_rx_buf {
  */
 typedef void uart_mcumgr_recv_fn(struct uart_mcumgr_rx_buf *rx_buf);
 
+#ifdef CONFIG_UART_MCUMGR_BINARY
+struct net_buf;
+
+/** @typedef uart_mcumgr_recv_pkt_fn
+ * @brief Function that gets called when a binary framed mcumgr packet is
+ * received.
+ *
+ * This function gets called in the interrupt context.  Ownership of the
+ * specified buffer, allocated with mcumgr_buf_alloc(), is transferred to the
+ * callback when this function gets called.
+ *
+ * @param nb                    The received packet, without framing.
+ */
+typedef void uart_mcumgr_recv_pkt_fn(struct net_buf *nb);
+
+/**
+ * @brief Registers an mcumgr UART binary packet receive handler.
+ *
+ * @param cb                    The callback to execute when an mcumgr request
+ *                                  packet is received.
+ */
+void uart_mcumgr_register_pkt(uart_mcumgr_recv_pkt_fn *cb);
+#endif
+
 /**
  * @brief Sends an mcumgr packet over UART.
  *
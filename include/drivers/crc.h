@@ -0,0 +1,136 @@
+/**
+ * @file drivers/crc.h
+ *
+ * @brief Public APIs for CRC calculation unit drivers.
+ */
+
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_INCLUDE_DRIVERS_CRC_H_
+#define ZEPHYR_INCLUDE_DRIVERS_CRC_H_
+
+/**
+ * @brief CRC Interface
+ * @defgroup crc_interface CRC Interface
+ * @ingroup io_interfaces
+ * @{
+ */
+
+#include <errno.h>
+#include <zephyr/types.h>
+#include <device.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @typedef crc_crc32_ieee_t
+ * @brief Callback API to compute a CRC-32 (IEEE 802.3).
+ *
+ * See crc_crc32_ieee_update() for argument description
+ */
+typedef int (*crc_crc32_ieee_t)(struct device *dev, uint32_t crc,
+				const uint8_t *data, size_t len,
+				uint32_t *result);
+
+/**
+ * @typedef crc_crc16_ccitt_t
+ * @brief Callback API to compute a CRC-16/CCITT.
+ *
+ * See crc_crc16_ccitt() for argument description
+ */
+typedef int (*crc_crc16_ccitt_t)(struct device *dev, uint16_t seed,
+				 const uint8_t *data, size_t len,
+				 uint16_t *result);
+
+struct crc_driver_api {
+	crc_crc32_ieee_t crc32_ieee;
+	crc_crc16_ccitt_t crc16_ccitt;
+};
+
+/**
+ * @brief Computes a CRC-32 (IEEE 802.3) using a CRC calculation unit.
+ *
+ * Same semantics as crc32_ieee_update(). Drivers never block: if the
+ * unit is in use the call fails and the caller is expected to fall back
+ * to the software implementation. May be called from an ISR.
+ *
+ * @param dev Pointer to the CRC device.
+ * @param crc CRC returned by a previous call, or 0 to start a new one.
+ * @param data Input data.
+ * @param len Length of @a data, in bytes.
+ * @param result Where to store the resulting CRC.
+ * @retval 0 on success.
+ * @retval -EBUSY if the unit is in use.
+ * @retval -ENOTSUP if the unit does not support this CRC.
+ */
+static inline int crc_crc32_ieee_update(struct device *dev, uint32_t crc,
+					const uint8_t *data, size_t len,
+					uint32_t *result)
+{
+	const struct crc_driver_api *api =
+		(const struct crc_driver_api *)dev->api;
+
+	if (api->crc32_ieee == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->crc32_ieee(dev, crc, data, len, result);
+}
+
+/**
+ * @brief Computes a CRC-16/CCITT using a CRC calculation unit.
+ *
+ * Same semantics as crc16_ccitt(), see crc_crc32_ieee_update() for the
+ * locking rules.
+ *
+ * @param dev Pointer to the CRC device.
+ * @param seed Initial value of the CRC.
+ * @param data Input data.
+ * @param len Length of @a data, in bytes.
+ * @param result Where to store the resulting CRC.
+ * @retval 0 on success.
+ * @retval -EBUSY if the unit is in use.
+ * @retval -ENOTSUP if the unit does not support this CRC.
+ */
+static inline int crc_crc16_ccitt(struct device *dev, uint16_t seed,
+				  const uint8_t *data, size_t len,
+				  uint16_t *result)
+{
+	const struct crc_driver_api *api =
+		(const struct crc_driver_api *)dev->api;
+
+	if (api->crc16_ccitt == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->crc16_ccitt(dev, seed, data, len, result);
+}
+
+/**
+ * @cond INTERNAL_HIDDEN
+ *
+ * Used by the CRC library to offload computations to the zephyr,crc
+ * chosen device. They return a negative value whenever the computation
+ * must be done in software instead.
+ */
+int z_crc_hw_crc32_ieee_update(uint32_t crc, const uint8_t *data,
+			       size_t len, uint32_t *result);
+int z_crc_hw_crc16_ccitt(uint16_t seed, const uint8_t *data, size_t len,
+			 uint16_t *result);
+
+/** @endcond */
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_DRIVERS_CRC_H_ */
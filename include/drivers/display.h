@@ -20,6 +20,8 @@
  */
 
 #include <device.h>
+#include <errno.h>
+#include <kernel.h>
 #include <stddef.h>
 #include <zephyr/types.h>
 
@@ -63,6 +65,11 @@ enum display_screen_info {
 	 * Screen has two alternating ram buffers
 	 */
 	SCREEN_INFO_DOUBLE_BUFFER	= BIT(3),
+	/**
+	 * Screen updates the area written without a full refresh cycle,
+	 * writing only the changed regions is cheaper than a full frame.
+	 */
+	SCREEN_INFO_PARTIAL_UPDATE	= BIT(4),
 };
 
 /**
@@ -157,6 +164,16 @@ typedef int (*display_write_api)(const struct device *dev, const uint16_t x,
 				 const struct display_buffer_descriptor *desc,
 				 const void *buf);
 
+/**
+ * @typedef display_write_async_api
+ * @brief Callback API for writing data to the display asynchronously
+ * See display_write_async() for argument description
+ */
+typedef int (*display_write_async_api)(
+	const struct device *dev, const uint16_t x, const uint16_t y,
+	const struct display_buffer_descriptor *desc, const void *buf,
+	struct k_poll_signal *signal);
+
 /**
  * @typedef display_read_api
  * @brief Callback API for reading data from the display
@@ -232,6 +249,7 @@ struct display_driver_api {
 	display_get_capabilities_api get_capabilities;
 	display_set_pixel_format_api set_pixel_format;
 	display_set_orientation_api set_orientation;
+	display_write_async_api write_async;
 };
 
 /**
@@ -256,6 +274,45 @@ static inline int display_write(const struct device *dev, const uint16_t x,
 	return api->write(dev, x, y, desc, buf);
 }
 
+/**
+ * @brief Write data to display asynchronously
+ *
+ * Start the transfer of the buffer and return, so that the caller can
+ * render the next frame meanwhile. The signal is raised with the result of
+ * the transfer once the buffer may be reused. The driver waits for the
+ * transfer before its next access to the display, the caller must only
+ * wait for the signal and leave its reset to the next call of this
+ * function.
+ *
+ * Requires CONFIG_DISPLAY_WRITE_ASYNC.
+ *
+ * @param dev Pointer to device structure
+ * @param x x Coordinate of the upper left corner where to write the buffer
+ * @param y y Coordinate of the upper left corner where to write the buffer
+ * @param desc Pointer to a structure describing the buffer layout
+ * @param buf Pointer to buffer array
+ * @param signal Signal raised when the transfer is done
+ *
+ * @retval 0 if the transfer is started.
+ * @retval -ENOTSUP if the driver does not support asynchronous writes.
+ * @retval Negative errno code on other failure.
+ */
+static inline int
+display_write_async(const struct device *dev, const uint16_t x,
+		    const uint16_t y,
+		    const struct display_buffer_descriptor *desc,
+		    const void *buf, struct k_poll_signal *signal)
+{
+	struct display_driver_api *api =
+		(struct display_driver_api *)dev->api;
+
+	if (api->write_async == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->write_async(dev, x, y, desc, buf, signal);
+}
+
 /**
  * @brief Read data from display
  *
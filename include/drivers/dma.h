@@ -111,11 +111,21 @@ struct dma_block_config {
  * @param dev Pointer to the DMA device calling the callback.
  * @param user_data A pointer to some user data or NULL
  * @param channel The channel number
- * @param status 0 on success, a negative errno otherwise
+ * @param status DMA_STATUS_COMPLETE at the end of the transfer,
+ *               DMA_STATUS_BLOCK when a block or half of a cyclic block is
+ *               done, a negative errno otherwise
  */
 typedef void (*dma_callback_t)(struct device *dev, void *user_data,
 			       uint32_t channel, int status);
 
+/** The transfer is complete. */
+#define DMA_STATUS_COMPLETE 0
+/**
+ * A block of a chained or cyclic transfer is complete and the transfer goes
+ * on, only reported with complete_callback_en set.
+ */
+#define DMA_STATUS_BLOCK 1
+
 /**
  * @brief DMA configuration structure.
  *
@@ -142,7 +152,10 @@ typedef void (*dma_callback_t)(struct device *dev, void *user_data,
  *     linked_channel       [ 20 : 26 ] - after channel count exhaust will
  *                                        initiate a channel service request
  *                                        at this channel
- *     reserved             [ 27 : 31 ]
+ *     cyclic               [ 27 ]      - restart from head_block after the
+ *                                        last block, until stopped
+ *                                        0-disable, 1-enable
+ *     reserved             [ 28 : 31 ]
  *
  *     source_data_size    [ 0 : 15 ]   - width of source data (in bytes)
  *     dest_data_size      [ 16 : 31 ]  - width of dest data (in bytes)
@@ -150,7 +163,13 @@ typedef void (*dma_callback_t)(struct device *dev, void *user_data,
  *     dest_burst_length   [ 16 : 31 ]  - number of destination data units
  *
  *     block_count  is the number of blocks used for block chaining, this
- *     depends on availability of the DMA controller.
+ *     depends on availability of the DMA controller. The blocks are linked
+ *     through next_block starting at head_block.
+ *
+ *     With complete_callback_en the callback is also invoked with
+ *     DMA_STATUS_BLOCK at the end of each block and, for a cyclic transfer
+ *     of a single block, at half of it. This lets a client refill the
+ *     buffers of a continuous stream while the other half is transferred.
  *
  *     user_data  private data from DMA client.
  *
@@ -167,7 +186,8 @@ struct dma_config {
 	uint32_t  source_chaining_en :   1;
 	uint32_t  dest_chaining_en :     1;
 	uint32_t  linked_channel   :     7;
-	uint32_t  reserved :             5;
+	uint32_t  cyclic :               1;
+	uint32_t  reserved :             4;
 	uint32_t  source_data_size :    16;
 	uint32_t  dest_data_size :      16;
 	uint32_t  source_burst_length : 16;
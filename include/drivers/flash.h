@@ -295,6 +295,22 @@ typedef bool (*flash_page_cb)(const struct flash_pages_info *info, void *data);
  * @param data Private data for callback function
  */
 void flash_page_foreach(struct device *dev, flash_page_cb cb, void *data);
+
+/**
+ * @brief Iterate over the flash pages of a range on a device
+ *
+ * This routine is like flash_page_foreach(), but only invokes the callback
+ * for the pages overlapping the given range. The pages before the range
+ * are skipped without iterating over them.
+ *
+ * @param dev Device whose pages to iterate over
+ * @param offset Start offset of the range
+ * @param size Size of the range
+ * @param cb Callback to invoke for each flash page
+ * @param data Private data for callback function
+ */
+void flash_page_foreach_in_range(struct device *dev, off_t offset,
+				 size_t size, flash_page_cb cb, void *data);
 #endif /* CONFIG_FLASH_PAGE_LAYOUT */
 
 #if defined(CONFIG_FLASH_JESD216_API)
@@ -403,6 +419,93 @@ static inline const struct flash_parameters *z_impl_flash_get_parameters(const s
 	return api->get_parameters(dev);
 }
 
+#ifdef CONFIG_FLASH_ASYNC
+
+/**
+ * @brief Asynchronous flash operation
+ *
+ * Filled in by flash_read_async(), flash_write_async() and
+ * flash_erase_async(), must stay valid until the operation completes.
+ */
+struct flash_async_op {
+	/** Used by the flash async support */
+	void *fifo_reserved;
+	/** @cond INTERNAL_HIDDEN */
+	struct device *dev;
+	uint8_t type;
+	off_t offset;
+	void *data;
+	size_t len;
+	struct k_poll_signal *signal;
+	/** @endcond */
+};
+
+/**
+ *  @brief  Read data from flash asynchronously
+ *
+ *  Queues a flash_read() to the flash work thread.  On completion the
+ *  signal is raised with the result of flash_read().  Operations are run in
+ *  the order they were submitted in.
+ *
+ *  @param  dev             : flash dev
+ *  @param  offset          : Offset (byte aligned) to read
+ *  @param  data            : Buffer to store read data, must stay valid
+ *                            until completion
+ *  @param  len             : Number of bytes to read.
+ *  @param  op              : Operation object, must stay valid until
+ *                            completion
+ *  @param  signal          : Signal raised on completion
+ *
+ *  @return  0 on success, negative errno code on fail.
+ */
+int flash_read_async(struct device *dev, off_t offset, void *data,
+		     size_t len, struct flash_async_op *op,
+		     struct k_poll_signal *signal);
+
+/**
+ *  @brief  Write buffer into flash memory asynchronously
+ *
+ *  Queues a flash_write() to the flash work thread, see
+ *  flash_read_async().  Write protection must be disabled by the caller as
+ *  for flash_write().
+ *
+ *  @param  dev             : flash device
+ *  @param  offset          : starting offset for the write
+ *  @param  data            : data to write, must stay valid until
+ *                            completion
+ *  @param  len             : Number of bytes to write
+ *  @param  op              : Operation object, must stay valid until
+ *                            completion
+ *  @param  signal          : Signal raised on completion
+ *
+ *  @return  0 on success, negative errno code on fail.
+ */
+int flash_write_async(struct device *dev, off_t offset, const void *data,
+		      size_t len, struct flash_async_op *op,
+		      struct k_poll_signal *signal);
+
+/**
+ *  @brief  Erase part or all of a flash memory asynchronously
+ *
+ *  Queues a flash_erase() to the flash work thread, see
+ *  flash_read_async().  Write protection must be disabled by the caller as
+ *  for flash_erase().
+ *
+ *  @param  dev             : flash device
+ *  @param  offset          : erase area starting offset
+ *  @param  size            : size of area to be erased
+ *  @param  op              : Operation object, must stay valid until
+ *                            completion
+ *  @param  signal          : Signal raised on completion
+ *
+ *  @return  0 on success, negative errno code on fail.
+ */
+int flash_erase_async(struct device *dev, off_t offset, size_t size,
+		      struct flash_async_op *op,
+		      struct k_poll_signal *signal);
+
+#endif /* CONFIG_FLASH_ASYNC */
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Wear and timing interface of the flash simulator
+ */
+
+#ifndef ZEPHYR_INCLUDE_DRIVERS_FLASH_FLASH_SIMULATOR_H_
+#define ZEPHYR_INCLUDE_DRIVERS_FLASH_FLASH_SIMULATOR_H_
+
+#include <zephyr/types.h>
+#include <device.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Flash simulator wear and timing
+ * @defgroup flash_simulator_interface Flash simulator interface
+ * @ingroup flash_interface
+ * @{
+ */
+
+/**
+ * @brief Time taken by the simulated flash operations.
+ *
+ * Each operation busy-waits for its fixed time plus its time per amount of
+ * data. All zero means the operations take no simulated time.
+ */
+struct flash_simulator_timing {
+	/** Time of a read, in microseconds */
+	uint32_t read_us;
+	/** Additional time per byte read, in nanoseconds */
+	uint32_t read_byte_ns;
+	/** Time of a write, in microseconds */
+	uint32_t write_us;
+	/** Additional time per program unit written, in microseconds */
+	uint32_t write_unit_us;
+	/** Time of an erase, in microseconds */
+	uint32_t erase_us;
+	/** Additional time per erase unit erased, in microseconds */
+	uint32_t erase_unit_us;
+};
+
+/** @brief Use counters of an erase unit of the simulated flash. */
+struct flash_simulator_unit_stats {
+	/** Number of times the unit was erased */
+	uint32_t erases;
+	/** Number of writes which programmed the unit */
+	uint32_t writes;
+	/** Number of bytes programmed in the unit */
+	uint32_t bytes_written;
+};
+
+/**
+ * @brief Get the timing model of the simulated flash.
+ *
+ * With CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING it is set from the
+ * CONFIG_FLASH_SIMULATOR_*_TIME_* options at boot, it is all zero otherwise.
+ *
+ * @param dev Flash simulator device.
+ * @param timing Timing model output.
+ */
+void flash_simulator_timing_get(struct device *dev,
+				struct flash_simulator_timing *timing);
+
+/**
+ * @brief Set the timing model of the simulated flash.
+ *
+ * @param dev Flash simulator device.
+ * @param timing Timing model applied to the following operations.
+ */
+void flash_simulator_timing_set(struct device *dev,
+				const struct flash_simulator_timing *timing);
+
+/**
+ * @brief Get the number of erase units of the simulated flash.
+ *
+ * @param dev Flash simulator device.
+ *
+ * @return Number of erase units.
+ */
+size_t flash_simulator_unit_count(struct device *dev);
+
+/**
+ * @brief Get the use counters of an erase unit.
+ *
+ * Requires CONFIG_FLASH_SIMULATOR_UNIT_STATS.
+ *
+ * @param dev Flash simulator device.
+ * @param unit Index of the erase unit, from the start of the flash.
+ * @param stats Counters output.
+ *
+ * @return 0 on success, -EINVAL if unit is out of range.
+ */
+int flash_simulator_unit_stats_get(struct device *dev, size_t unit,
+				   struct flash_simulator_unit_stats *stats);
+
+/**
+ * @brief Clear the use counters of all erase units.
+ *
+ * Requires CONFIG_FLASH_SIMULATOR_UNIT_STATS.
+ *
+ * @param dev Flash simulator device.
+ */
+void flash_simulator_unit_stats_reset(struct device *dev);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DRIVERS_FLASH_FLASH_SIMULATOR_H_ */
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Fast GPIO access for bit-banged buses
+ *
+ * Drivers bit-banging a bus toggle the same few pins millions of times.
+ * These helpers resolve the port driver API and the active low pins once,
+ * then each access is a single call to the port driver, which typically
+ * is a single register write (e.g. BSRR on STM32, OUTSET/OUTCLR on nRF).
+ * They bypass the system call layer and are meant for kernel drivers.
+ */
+
+#ifndef ZEPHYR_INCLUDE_DRIVERS_GPIO_GPIO_BITBANG_H_
+#define ZEPHYR_INCLUDE_DRIVERS_GPIO_GPIO_BITBANG_H_
+
+#include <device.h>
+#include <drivers/gpio.h>
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Pins of a GPIO port driven by a bit-banged bus. */
+struct gpio_bitbang {
+	struct device *port;
+	const struct gpio_driver_api *api;
+	/* Pins configured as active low when the bus was initialized */
+	gpio_port_pins_t invert;
+};
+
+/**
+ * @brief Prepare the fast access to a GPIO port.
+ *
+ * The pins must be configured beforehand, the active low flags of the
+ * pins are captured here.
+ *
+ * @param bb Bit-bang port to initialize.
+ * @param port GPIO port device.
+ */
+static inline void gpio_bitbang_init(struct gpio_bitbang *bb,
+				     struct device *port)
+{
+	const struct gpio_driver_data *data =
+		(const struct gpio_driver_data *)port->data;
+
+	bb->port = port;
+	bb->api = (const struct gpio_driver_api *)port->api;
+	bb->invert = data->invert;
+}
+
+/**
+ * @brief Set the logical level of several pins at once.
+ *
+ * @param bb Bit-bang port.
+ * @param mask Pins to change.
+ * @param value Logical levels of the pins in mask.
+ */
+static inline void gpio_bitbang_set_masked(const struct gpio_bitbang *bb,
+					   gpio_port_pins_t mask,
+					   gpio_port_value_t value)
+{
+	bb->api->port_set_masked_raw(bb->port, mask, value ^ bb->invert);
+}
+
+/**
+ * @brief Set pins to their logical 1 (active) level.
+ *
+ * @param bb Bit-bang port.
+ * @param pins Pins to set.
+ */
+static inline void gpio_bitbang_set_bits(const struct gpio_bitbang *bb,
+					 gpio_port_pins_t pins)
+{
+	bb->api->port_set_clr_bits_raw(bb->port, pins & ~bb->invert,
+				       pins & bb->invert);
+}
+
+/**
+ * @brief Set pins to their logical 0 (inactive) level.
+ *
+ * @param bb Bit-bang port.
+ * @param pins Pins to clear.
+ */
+static inline void gpio_bitbang_clear_bits(const struct gpio_bitbang *bb,
+					   gpio_port_pins_t pins)
+{
+	bb->api->port_set_clr_bits_raw(bb->port, pins & bb->invert,
+				       pins & ~bb->invert);
+}
+
+/**
+ * @brief Set the logical level of a single pin.
+ *
+ * @param bb Bit-bang port.
+ * @param pin Pin number.
+ * @param value Logical level, 0 or not.
+ */
+static inline void gpio_bitbang_pin_set(const struct gpio_bitbang *bb,
+					gpio_pin_t pin, int value)
+{
+	if (value != 0) {
+		gpio_bitbang_set_bits(bb, BIT(pin));
+	} else {
+		gpio_bitbang_clear_bits(bb, BIT(pin));
+	}
+}
+
+/**
+ * @brief Get the logical level of the pins of the port.
+ *
+ * @param bb Bit-bang port.
+ *
+ * @return Logical levels of all the pins of the port.
+ */
+static inline gpio_port_value_t gpio_bitbang_get(const struct gpio_bitbang *bb)
+{
+	gpio_port_value_t value = 0U;
+
+	(void)bb->api->port_get_raw(bb->port, &value);
+
+	return value ^ bb->invert;
+}
+
+/**
+ * @brief Get the logical level of a single pin.
+ *
+ * @param bb Bit-bang port.
+ * @param pin Pin number.
+ *
+ * @return 1 if the pin is active, 0 otherwise.
+ */
+static inline int gpio_bitbang_pin_get(const struct gpio_bitbang *bb,
+				       gpio_pin_t pin)
+{
+	return (gpio_bitbang_get(bb) & BIT(pin)) != 0U;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DRIVERS_GPIO_GPIO_BITBANG_H_ */
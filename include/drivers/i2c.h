@@ -20,6 +20,7 @@
  */
 
 #include <zephyr/types.h>
+#include <kernel.h>
 #include <device.h>
 
 #ifdef __cplusplus
@@ -174,6 +175,11 @@ typedef int (*i2c_api_slave_register_t)(struct device *dev,
 typedef int (*i2c_api_slave_unregister_t)(struct device *dev,
 					  struct i2c_slave_config *cfg);
 typedef int (*i2c_api_recover_bus_t)(struct device *dev);
+typedef int (*i2c_api_full_io_async_t)(struct device *dev,
+				       struct i2c_msg *msgs,
+				       uint8_t num_msgs,
+				       uint16_t addr,
+				       struct k_poll_signal *async);
 
 __subsystem struct i2c_driver_api {
 	i2c_api_configure_t configure;
@@ -181,6 +187,9 @@ __subsystem struct i2c_driver_api {
 	i2c_api_slave_register_t slave_register;
 	i2c_api_slave_unregister_t slave_unregister;
 	i2c_api_recover_bus_t recover_bus;
+#ifdef CONFIG_I2C_ASYNC
+	i2c_api_full_io_async_t transfer_async;
+#endif /* CONFIG_I2C_ASYNC */
 };
 
 typedef int (*i2c_slave_api_register_t)(struct device *dev);
@@ -255,6 +264,57 @@ static inline int z_impl_i2c_transfer(struct device *dev,
 	return api->transfer(dev, msgs, num_msgs, addr);
 }
 
+/**
+ * @brief Perform data transfer to another I2C device, asynchronously.
+ *
+ * Same as i2c_transfer(), but returns once the transfer is started or,
+ * if the bus is busy, queued behind the transfers in progress. Queued
+ * transfers are started from the interrupt completing the previous one,
+ * so the transfers of several devices sharing a bus run back to back.
+ * Waits for the bus as i2c_transfer() does if the queue is full, see
+ * CONFIG_I2C_ASYNC_QUEUE_SIZE.
+ *
+ * The messages and their buffers must stay valid until the end of the
+ * transfer is signaled.
+ *
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param msgs Array of messages to transfer.
+ * @param num_msgs Number of messages to transfer.
+ * @param addr Address of the I2C target device.
+ * @param async A pointer to a valid and ready to be signaled
+ *        struct k_poll_signal, raised with the result of the transfer
+ *        (0 or a negative errno code). If NULL the end of the transfer
+ *        is not notified.
+ *
+ * @retval 0 If the transfer is started or queued.
+ * @retval -ENOTSUP If the driver does not support asynchronous transfers.
+ * @retval -EIO General input / output error.
+ */
+static inline int i2c_transfer_async(struct device *dev,
+				     struct i2c_msg *msgs, uint8_t num_msgs,
+				     uint16_t addr,
+				     struct k_poll_signal *async)
+{
+#ifdef CONFIG_I2C_ASYNC
+	const struct i2c_driver_api *api =
+		(const struct i2c_driver_api *)dev->api;
+
+	if (api->transfer_async == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->transfer_async(dev, msgs, num_msgs, addr, async);
+#else
+	ARG_UNUSED(dev);
+	ARG_UNUSED(msgs);
+	ARG_UNUSED(num_msgs);
+	ARG_UNUSED(addr);
+	ARG_UNUSED(async);
+
+	return -ENOTSUP;
+#endif /* CONFIG_I2C_ASYNC */
+}
+
 /**
  * @brief Recover the I2C bus
  *
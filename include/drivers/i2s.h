@@ -23,6 +23,7 @@
  * @{
  */
 
+#include <errno.h>
 #include <zephyr/types.h>
 #include <device.h>
 
@@ -196,6 +197,9 @@ typedef uint8_t i2s_opt_t;
  * is being populated while the other is being played (DMAed) and vice versa.
  * So, in this mode, 2 sets of buffers fixed in size are used. Static Arrays
  * are used to achieve this and hence they are never freed.
+ *
+ * Drivers implementing i2s_ring_next() loop over a ring of two or more
+ * memory blocks instead, which are filled or processed in place.
  */
 #define I2S_OPT_PINGPONG                    BIT(6)
 
@@ -321,6 +325,10 @@ __subsystem struct i2s_driver_api {
 	int (*write)(struct device *dev, void *mem_block, size_t size);
 	int (*trigger)(struct device *dev, enum i2s_dir dir,
 		       enum i2s_trigger_cmd cmd);
+	int (*ring_next)(struct device *dev, enum i2s_dir dir,
+			 void **mem_block);
+	int (*position_get)(struct device *dev, enum i2s_dir dir,
+			    void **mem_block, size_t *offset);
 };
 /**
  * @endcond
@@ -520,6 +528,75 @@ static inline int z_impl_i2s_trigger(struct device *dev, enum i2s_dir dir,
 	return api->trigger(dev, dir, cmd);
 }
 
+/**
+ * @brief Get the next memory block of the ping pong ring.
+ *
+ * In ping pong mode (I2S_OPT_PINGPONG) the memory blocks loop in a ring
+ * through a cyclic DMA transfer, without being queued and released. The
+ * TX ring is made of the blocks written with i2s_write() before the START
+ * trigger, the RX ring is allocated from the memory slab at START. All of
+ * them are released when the stream stops.
+ *
+ * This function waits for the DMA to be done with the next block of the
+ * ring, in ring order, and returns it: received data for RX, a block to
+ * refill in place for TX. The block stays owned by the driver and has to
+ * be processed before the DMA wraps around to it. Falling a whole ring
+ * behind is an RX overrun / TX underrun and moves the interface to the
+ * ERROR state. The wait can timeout as defined by i2s_configure().
+ *
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param dir Stream direction: RX or TX.
+ * @param mem_block Pointer to the next memory block of the ring.
+ *
+ * @retval 0 If successful.
+ * @retval -EIO The interface is not in RUNNING state.
+ * @retval -EINVAL The stream is not in ping pong mode.
+ * @retval -ENOTSUP The driver does not support a ping pong ring.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+static inline int i2s_ring_next(struct device *dev, enum i2s_dir dir,
+				void **mem_block)
+{
+	const struct i2s_driver_api *api =
+		(const struct i2s_driver_api *)dev->api;
+
+	if (api->ring_next == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->ring_next(dev, dir, mem_block);
+}
+
+/**
+ * @brief Get the current position of the DMA in the stream.
+ *
+ * The position is the memory block being transferred and the number of
+ * bytes of it already transferred, it lets latency sensitive applications
+ * track how far ahead of the DMA they fill or behind it they process.
+ *
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param dir Stream direction: RX or TX.
+ * @param mem_block Pointer to the memory block being transferred.
+ * @param offset Pointer to the variable storing the bytes transferred.
+ *
+ * @retval 0 If successful.
+ * @retval -EIO The interface is not in RUNNING or STOPPING state.
+ * @retval -ENOTSUP The driver does not report the position.
+ */
+static inline int i2s_position_get(struct device *dev, enum i2s_dir dir,
+				   void **mem_block, size_t *offset)
+{
+	const struct i2s_driver_api *api =
+		(const struct i2s_driver_api *)dev->api;
+
+	if (api->position_get == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->position_get(dev, dir, mem_block, offset);
+}
+
 /**
  * @}
  */
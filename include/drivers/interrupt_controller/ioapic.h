@@ -39,6 +39,7 @@ void z_ioapic_irq_enable(unsigned int irq);
 void z_ioapic_irq_disable(unsigned int irq);
 void z_ioapic_int_vec_set(unsigned int irq, unsigned int vector);
 void z_ioapic_irq_set(unsigned int irq, unsigned int vector, uint32_t flags);
+int z_ioapic_irq_set_affinity(unsigned int irq, uint32_t cpu_mask);
 #endif /* _ASMLANGUAGE */
 
 #ifdef __cplusplus
@@ -322,6 +322,64 @@ enum sensor_attribute {
 typedef void (*sensor_trigger_handler_t)(struct device *dev,
 					 struct sensor_trigger *trigger);
 
+/**
+ * @brief Formats of the frames streamed from a sensor FIFO.
+ */
+enum sensor_fifo_format {
+	/** Frames as stored by the sensor, the format is driver specific. */
+	SENSOR_FIFO_RAW,
+	/** One struct sensor_value per value of the channel per frame. */
+	SENSOR_FIFO_CONVERTED,
+};
+
+/**
+ * @brief Batch of frames drained from a sensor FIFO.
+ */
+struct sensor_fifo_frames {
+	/** Frames, in the buffer given to sensor_fifo_stream(). */
+	const void *buf;
+	/** Number of frames. */
+	uint16_t count;
+	/** Size of a frame, in bytes. */
+	uint16_t frame_size;
+	/** Time of the last frame, in nanoseconds since boot. */
+	uint64_t timestamp_ns;
+	/** Time between two frames, in nanoseconds. */
+	uint32_t period_ns;
+	/** Frames were lost before this batch as the FIFO overflowed. */
+	bool overrun;
+};
+
+/**
+ * @typedef sensor_fifo_handler_t
+ * @brief Callback API delivering the frames drained from a sensor FIFO
+ *
+ * The frame buffer is reused for the next batch once the callback returns.
+ *
+ * @param "struct device *dev" Pointer to the sensor device
+ * @param "const struct sensor_fifo_frames *frames" The frames
+ */
+typedef void (*sensor_fifo_handler_t)(struct device *dev,
+				      const struct sensor_fifo_frames *frames);
+
+/**
+ * @brief Sensor FIFO streaming configuration.
+ */
+struct sensor_fifo_config {
+	/** Frames buffered by the sensor before they are drained. */
+	uint16_t watermark;
+	/** Format of the frames delivered to the handler. */
+	enum sensor_fifo_format format;
+	/** Buffer the frames are drained to, holding at least watermark
+	 * frames.
+	 */
+	void *buf;
+	/** Size of buf, in bytes. */
+	size_t buf_size;
+	/** Function called with each batch of frames. */
+	sensor_fifo_handler_t handler;
+};
+
 /**
  * @typedef sensor_attr_set_t
  * @brief Callback API upon setting a sensor's attributes
@@ -370,6 +428,15 @@ typedef int (*sensor_sample_fetch_t)(struct device *dev,
 typedef int (*sensor_channel_get_t)(struct device *dev,
 				    enum sensor_channel chan,
 				    struct sensor_value *val);
+/**
+ * @typedef sensor_fifo_stream_t
+ * @brief Callback API for streaming a sensor FIFO
+ *
+ * See sensor_fifo_stream() for argument description
+ */
+typedef int (*sensor_fifo_stream_t)(struct device *dev,
+				    enum sensor_channel chan,
+				    const struct sensor_fifo_config *config);
 
 __subsystem struct sensor_driver_api {
 	sensor_attr_set_t attr_set;
@@ -377,6 +444,7 @@ __subsystem struct sensor_driver_api {
 	sensor_trigger_set_t trigger_set;
 	sensor_sample_fetch_t sample_fetch;
 	sensor_channel_get_t channel_get;
+	sensor_fifo_stream_t fifo_stream;
 };
 
 /**
@@ -566,6 +634,44 @@ static inline int z_impl_sensor_channel_get(struct device *dev,
 	return api->channel_get(dev, chan, val);
 }
 
+/**
+ * @brief Stream the samples of a channel through the sensor FIFO
+ *
+ * The FIFO watermark of the sensor is set to @a config->watermark frames.
+ * Each time it is reached, the driver drains the whole FIFO in one burst
+ * read and calls @a config->handler with the frames, converted if asked
+ * so. This replaces one sensor_sample_fetch() and sensor_channel_get() per
+ * sample, and their bus transaction, at high data rates.
+ *
+ * The handler is called from the thread of the driver, as the handlers of
+ * sensor_trigger_set() are. Streaming uses the interrupt line of the data
+ * ready trigger, which cannot be set meanwhile.
+ *
+ * This API is not permitted for user threads.
+ *
+ * @param dev Pointer to the sensor device
+ * @param chan The channel to stream, for example SENSOR_CHAN_ACCEL_XYZ
+ * @param config Streaming configuration, kept by the driver until the
+ * streaming stops, or NULL to stop streaming
+ *
+ * @return 0 if successful, -ENOTSUP if the sensor or the channel has no
+ * FIFO, -EINVAL if the watermark or the buffer do not fit the FIFO,
+ * negative errno code for other failures.
+ */
+static inline int sensor_fifo_stream(struct device *dev,
+				     enum sensor_channel chan,
+				     const struct sensor_fifo_config *config)
+{
+	const struct sensor_driver_api *api =
+		(const struct sensor_driver_api *)dev->api;
+
+	if (api->fifo_stream == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->fifo_stream(dev, chan, config);
+}
+
 /**
  * @brief The value of gravitational constant in micro m/s^2.
  */
@@ -27,6 +27,10 @@
 
 #include <drivers/video-controls.h>
 
+#ifdef CONFIG_NET_BUF
+#include <net/buf.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -110,6 +114,26 @@ struct video_buffer {
 	uint32_t timestamp;
 };
 
+/**
+ * @brief video stream statistics
+ *
+ * Counters of an endpoint since the stream was started.
+ *
+ * @param frames is the number of frames delivered to the outgoing queue.
+ * @param dropped is the number of frames lost, because no buffer was
+ *        queued or on capture error.
+ * @param first_timestamp is the timestamp of the first frame delivered,
+ *        in milliseconds.
+ * @param last_timestamp is the timestamp of the last frame delivered,
+ *        in milliseconds.
+ */
+struct video_stats {
+	uint32_t frames;
+	uint32_t dropped;
+	uint32_t first_timestamp;
+	uint32_t last_timestamp;
+};
+
 /**
  * @brief video_endpoint_id enum
  * Identify the video device endpoint.
@@ -226,6 +250,15 @@ typedef int (*video_api_set_signal_t)(struct device *dev,
 				      enum video_endpoint_id ep,
 				      struct k_poll_signal *signal);
 
+/**
+ * @typedef video_api_get_stats_t
+ * @brief Get the statistics of a video endpoint.
+ * See video_get_stats() for argument descriptions.
+ */
+typedef int (*video_api_get_stats_t)(struct device *dev,
+				     enum video_endpoint_id ep,
+				     struct video_stats *stats);
+
 struct video_driver_api {
 	/* mandatory callbacks */
 	video_api_set_format_t set_format;
@@ -240,6 +273,7 @@ struct video_driver_api {
 	video_api_set_ctrl_t set_ctrl;
 	video_api_set_ctrl_t get_ctrl;
 	video_api_set_signal_t set_signal;
+	video_api_get_stats_t get_stats;
 };
 
 /**
@@ -526,22 +560,123 @@ static inline int video_set_signal(struct device *dev,
 	return api->set_signal(dev, ep, signal);
 }
 
+/**
+ * @brief Get the statistics of a video endpoint.
+ *
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param ep Endpoint ID.
+ * @param stats Pointer to the statistics to fill.
+ *
+ * @retval 0 Is successful.
+ * @retval -EINVAL If parameters are invalid.
+ * @retval -ENOTSUP If statistics are not supported.
+ */
+static inline int video_get_stats(struct device *dev,
+				  enum video_endpoint_id ep,
+				  struct video_stats *stats)
+{
+	const struct video_driver_api *api =
+		(const struct video_driver_api *)dev->api;
+
+	if (api->get_stats == NULL) {
+		return -ENOTSUP;
+	}
+
+	return api->get_stats(dev, ep, stats);
+}
+
+/**
+ * @brief Frame rate of a video stream.
+ *
+ * @param stats Pointer to the statistics of the endpoint.
+ *
+ * @retval frame rate in frames per second, 0 if not enough frames were
+ *         delivered.
+ */
+static inline uint32_t video_stats_fps(const struct video_stats *stats)
+{
+	uint32_t elapsed = stats->last_timestamp - stats->first_timestamp;
+
+	if (stats->frames < 2 || elapsed == 0) {
+		return 0;
+	}
+
+	return (stats->frames - 1) * 1000U / elapsed;
+}
+
 /**
  * @brief Allocate video buffer.
  *
+ * The buffer data is aligned on CONFIG_VIDEO_BUFFER_POOL_ALIGN and its
+ * size rounded up to it, so that cache maintenance on the buffer does not
+ * affect other buffers. The buffer is returned with one reference.
+ *
  * @param size Size of the video buffer.
  *
  * @retval pointer to allocated video buffer
  */
 struct video_buffer *video_buffer_alloc(size_t size);
 
+/**
+ * @brief Take a reference on a video buffer.
+ *
+ * Share the buffer between several users, e.g. capture, processing and
+ * network send, without copying the frame. The buffer is freed once every
+ * reference is released.
+ *
+ * @param buf Pointer to the video buffer.
+ */
+void video_buffer_ref(struct video_buffer *buf);
+
 /**
  * @brief Release a video buffer.
  *
+ * Drop a reference on the buffer, the buffer is freed with the last one.
+ *
  * @param buf Pointer to the video buffer to release.
  */
 void video_buffer_release(struct video_buffer *buf);
 
+#if defined(CONFIG_NET_BUF) || defined(__DOXYGEN__)
+/** @cond INTERNAL_HIDDEN */
+extern const struct net_buf_data_alloc video_net_buf_alloc;
+/** @endcond */
+
+/**
+ * @brief Define a pool of network buffers referencing video buffers.
+ *
+ * The buffers of the pool carry no data of their own and are allocated
+ * with video_buffer_net_buf().
+ *
+ * @param _name Name of the pool variable.
+ * @param _count Number of buffers in the pool.
+ * @param _destroy Optional destroy callback when buffer is freed.
+ */
+#define VIDEO_NET_BUF_POOL_DEFINE(_name, _count, _destroy)                   \
+	static struct net_buf net_buf_##_name[_count] __noinit;               \
+	static struct net_buf_pool _name __net_buf_align                      \
+			__in_section(_net_buf_pool, static, _name) =          \
+		NET_BUF_POOL_INITIALIZER(_name, &video_net_buf_alloc,         \
+					 net_buf_##_name, _count, _destroy)
+
+/**
+ * @brief Wrap a video buffer in a network buffer.
+ *
+ * The network buffer references the bytes used in the video buffer
+ * without copying them and holds a reference on the video buffer until
+ * the network buffer and its clones are freed.
+ *
+ * @param pool Pool defined with VIDEO_NET_BUF_POOL_DEFINE().
+ * @param buf Pointer to the video buffer.
+ * @param timeout Time to wait for a free network buffer.
+ *
+ * @retval pointer to the network buffer, NULL if none is available.
+ */
+struct net_buf *video_buffer_net_buf(struct net_buf_pool *pool,
+				     struct video_buffer *buf,
+				     k_timeout_t timeout);
+#endif
+
 
 /* fourcc - four-character-code */
 #define video_fourcc(a, b, c, d)\
@@ -171,6 +171,34 @@ int fcb_append(struct fcb *fcb, uint16_t len, struct fcb_entry *loc);
  */
 int fcb_append_finish(struct fcb *fcb, struct fcb_entry *append_loc);
 
+/**
+ * Element appended by fcb_append_batch().
+ */
+struct fcb_batch_elem {
+	const void *data; /**< Element payload */
+	uint16_t len; /**< Length of the element payload */
+};
+
+/**
+ * Appends several complete entries to circular buffer in one flash write.
+ *
+ * The entries, with their length headers, CRCs and alignment padding, are
+ * encoded in @p buf and written in a single flash program operation to the
+ * same sector. Unlike fcb_append(), there is no need to write the payload
+ * and call fcb_append_finish() afterwards.
+ *
+ * @param[in] fcb FCB instance structure.
+ * @param[in] elems Entries to append, in order.
+ * @param[in] cnt Number of entries.
+ * @param[in] buf Buffer in which the entries are encoded.
+ * @param[in] buf_size Size of @p buf.
+ *
+ * @return 0 on success, -ENOMEM if @p buf is too small, -ENOSPC if the
+ *         entries don't fit in a sector, other negative value on failure.
+ */
+int fcb_append_batch(struct fcb *fcb, const struct fcb_batch_elem *elems,
+		     size_t cnt, uint8_t *buf, size_t buf_size);
+
 /**
  * FCB Walk callback function type.
  *
@@ -110,6 +110,17 @@ struct fs_statvfs {
 	unsigned long f_bfree;
 };
 
+/**
+ * @brief Buffer of a vectored read or write
+ *
+ * @param base Pointer to the buffer
+ * @param len Length of the buffer in bytes
+ */
+struct fs_iovec {
+	void *base;
+	size_t len;
+};
+
 /**
  * @brief File System interface structure
  *
@@ -131,6 +142,8 @@ struct fs_statvfs {
  * @param mkdir Creates a new directory using specified path
  * @param stat Checks the status of a file or directory specified by the path
  * @param statvfs Returns the total and available space in the filesystem volume
+ * @param readv Optional, reads into several buffers in a single operation
+ * @param writev Optional, writes from several buffers in a single operation
  */
 struct fs_file_system_t {
 	/* File operations */
@@ -159,6 +172,29 @@ struct fs_file_system_t {
 					struct fs_dirent *entry);
 	int (*statvfs)(struct fs_mount_t *mountp, const char *path,
 					struct fs_statvfs *stat);
+	/* Vectored file operations */
+	ssize_t (*readv)(struct fs_file_t *filp, const struct fs_iovec *iov,
+			 int iovcnt);
+	ssize_t (*writev)(struct fs_file_t *filp, const struct fs_iovec *iov,
+			  int iovcnt);
+};
+
+/**
+ * @brief Asynchronous file operation
+ *
+ * Filled in by fs_readv_async() and fs_writev_async(), the structure must
+ * stay valid until the operation completes.
+ */
+struct fs_async_op {
+	/** Used by the file system core */
+	void *fifo_reserved;
+	/** @cond INTERNAL_HIDDEN */
+	struct fs_file_t *zfp;
+	const struct fs_iovec *iov;
+	int iovcnt;
+	bool write;
+	struct k_poll_signal *signal;
+	/** @endcond */
 };
 
 #define FS_O_READ       0x01
@@ -288,6 +324,87 @@ ssize_t fs_read(struct fs_file_t *zfp, void *ptr, size_t size);
  */
 ssize_t fs_write(struct fs_file_t *zfp, const void *ptr, size_t size);
 
+/**
+ * @brief Vectored file read
+ *
+ * Reads into the buffers of iov in order, as a single read of their total
+ * length. File systems without native support perform one read per buffer.
+ *
+ * @param zfp Pointer to the file object
+ * @param iov Array of buffers
+ * @param iovcnt Number of buffers in iov
+ *
+ * @return Number of bytes read, less than the total length of the buffers
+ * if the end of the file was reached. Will return -ERRNO code on error.
+ */
+ssize_t fs_readv(struct fs_file_t *zfp, const struct fs_iovec *iov,
+		 int iovcnt);
+
+/**
+ * @brief Vectored file write
+ *
+ * Writes the buffers of iov in order, as a single write of their total
+ * length. File systems without native support perform one write per buffer.
+ *
+ * @param zfp Pointer to the file object
+ * @param iov Array of buffers
+ * @param iovcnt Number of buffers in iov
+ *
+ * @return Number of bytes written, less than the total length of the buffers
+ * if the disk got full. Will return -ERRNO code on error.
+ */
+ssize_t fs_writev(struct fs_file_t *zfp, const struct fs_iovec *iov,
+		  int iovcnt);
+
+/**
+ * @brief Asynchronous vectored file read
+ *
+ * Queues a fs_readv() to be run by the file system worker thread. On
+ * completion the signal is raised with the result of fs_readv() as its
+ * result. Operations are run in the order they were submitted in.
+ *
+ * The file, iov and buffers must stay valid and must not be used by the
+ * caller until the operation completes.
+ *
+ * @param op Operation object, must stay valid until completion
+ * @param zfp Pointer to the file object
+ * @param iov Array of buffers
+ * @param iovcnt Number of buffers in iov
+ * @param signal Signal raised on completion
+ *
+ * @retval 0 Operation queued
+ * @retval -EINVAL Invalid parameter
+ * @retval -EBADF The file is not open
+ */
+int fs_readv_async(struct fs_async_op *op, struct fs_file_t *zfp,
+		   const struct fs_iovec *iov, int iovcnt,
+		   struct k_poll_signal *signal);
+
+/**
+ * @brief Asynchronous vectored file write
+ *
+ * Queues a fs_writev() to be run by the file system worker thread, so that
+ * the caller can prepare the next data while the storage is programmed. On
+ * completion the signal is raised with the result of fs_writev() as its
+ * result. Operations are run in the order they were submitted in.
+ *
+ * The file, iov and buffers must stay valid and must not be used by the
+ * caller until the operation completes.
+ *
+ * @param op Operation object, must stay valid until completion
+ * @param zfp Pointer to the file object
+ * @param iov Array of buffers
+ * @param iovcnt Number of buffers in iov
+ * @param signal Signal raised on completion
+ *
+ * @retval 0 Operation queued
+ * @retval -EINVAL Invalid parameter
+ * @retval -EBADF The file is not open
+ */
+int fs_writev_async(struct fs_async_op *op, struct fs_file_t *zfp,
+		    const struct fs_iovec *iov, int iovcnt,
+		    struct k_poll_signal *signal);
+
 /**
  * @brief File seek
  *
@@ -37,8 +37,29 @@ struct fs_littlefs {
 	struct lfs lfs;
 	const struct flash_area *area;
 	struct k_mutex mutex;
+#ifdef CONFIG_FS_LITTLEFS_CACHE_POOL
+	/* Caches allocated at mount from the file cache pool */
+	struct k_mem_block cache_blocks[2];
+#endif
+#ifdef CONFIG_FS_LITTLEFS_MMAP_READ
+	/* Address of the flash area if memory-mapped, else NULL */
+	const uint8_t *mmap;
+#endif
 };
 
+/* Read and program cache declarations of FS_LITTLEFS_DECLARE_CUSTOM_CONFIG,
+ * the caches are allocated at mount with CONFIG_FS_LITTLEFS_CACHE_POOL.
+ */
+#ifdef CONFIG_FS_LITTLEFS_CACHE_POOL
+#define Z_FS_LITTLEFS_CACHES(name, cache_sz)
+#define Z_FS_LITTLEFS_CACHE(name, which) NULL
+#else
+#define Z_FS_LITTLEFS_CACHES(name, cache_sz)				\
+	static uint8_t __aligned(4) name ## _read_buffer[cache_sz];	\
+	static uint8_t __aligned(4) name ## _prog_buffer[cache_sz];
+#define Z_FS_LITTLEFS_CACHE(name, which) name ## _ ## which ## _buffer
+#endif
+
 /** @brief Define a littlefs configuration with customized size
  * characteristics.
  *
@@ -68,8 +89,7 @@ struct fs_littlefs {
  * @param lookahead_sz see :option:`CONFIG_FS_LITTLEFS_LOOKAHEAD_SIZE`
  */
 #define FS_LITTLEFS_DECLARE_CUSTOM_CONFIG(name, read_sz, prog_sz, cache_sz, lookahead_sz) \
-	static uint8_t __aligned(4) name ## _read_buffer[cache_sz];			  \
-	static uint8_t __aligned(4) name ## _prog_buffer[cache_sz];			  \
+	Z_FS_LITTLEFS_CACHES(name, cache_sz)						  \
 	static uint32_t name ## _lookahead_buffer[(lookahead_sz) / sizeof(uint32_t)];		  \
 	static struct fs_littlefs name = {						  \
 		.cfg = {								  \
@@ -77,8 +97,8 @@ struct fs_littlefs {
 			.prog_size = (prog_sz),						  \
 			.cache_size = (cache_sz),					  \
 			.lookahead_size = (lookahead_sz),				  \
-			.read_buffer = name ## _read_buffer,				  \
-			.prog_buffer = name ## _prog_buffer,				  \
+			.read_buffer = Z_FS_LITTLEFS_CACHE(name, read),			  \
+			.prog_buffer = Z_FS_LITTLEFS_CACHE(name, prog),			  \
 			.lookahead_buffer = name ## _lookahead_buffer,			  \
 		},									  \
 	}
@@ -99,6 +119,36 @@ struct fs_littlefs {
 					  CONFIG_FS_LITTLEFS_CACHE_SIZE, \
 					  CONFIG_FS_LITTLEFS_LOOKAHEAD_SIZE)
 
+/** @brief Define a littlefs configuration from devicetree.
+ *
+ * The sizes are taken from the properties of a ``zephyr,fstab,littlefs``
+ * node, those it does not have default to the Kconfig values.
+ *
+ * @param name the name for the structure.  The defined object has
+ * file scope.
+ * @param node_id the devicetree node identifier of the
+ * ``zephyr,fstab,littlefs`` node.
+ */
+#define FS_LITTLEFS_DECLARE_DT_CONFIG(name, node_id)			\
+	FS_LITTLEFS_DECLARE_CUSTOM_CONFIG(name,				\
+		DT_PROP_OR(node_id, read_size,				\
+			   CONFIG_FS_LITTLEFS_READ_SIZE),		\
+		DT_PROP_OR(node_id, prog_size,				\
+			   CONFIG_FS_LITTLEFS_PROG_SIZE),		\
+		DT_PROP_OR(node_id, cache_size,				\
+			   CONFIG_FS_LITTLEFS_CACHE_SIZE),		\
+		DT_PROP_OR(node_id, lookahead_size,			\
+			   CONFIG_FS_LITTLEFS_LOOKAHEAD_SIZE))
+
+/** @brief Flash area ID of the partition of a ``zephyr,fstab,littlefs``
+ * node, to be stored in the ``.storage_dev`` field of the mount point.
+ *
+ * @param node_id the devicetree node identifier of the
+ * ``zephyr,fstab,littlefs`` node.
+ */
+#define FS_LITTLEFS_DT_PARTITION_ID(node_id) \
+	DT_FIXED_PARTITION_ID(DT_PHANDLE(node_id, partition))
+
 #ifdef __cplusplus
 }
 #endif
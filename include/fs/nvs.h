@@ -43,6 +43,8 @@ extern "C" {
  * @param write_block_size Alignment size
  * @param nvs_lock Mutex
  * @param flash_device Flash Device
+ * @param lookup_cache Address of the most recent allocation table entry for
+ * each hash of the ID, when CONFIG_NVS_LOOKUP_CACHE is enabled
  */
 struct nvs_fs {
 	off_t offset;		/* filesystem offset in flash */
@@ -57,6 +59,9 @@ struct nvs_fs {
 	struct k_mutex nvs_lock;
 	struct device *flash_device;
 	const struct flash_parameters *flash_parameters;
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	uint32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
+#endif
 };
 
 /**
@@ -120,6 +125,22 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len);
  */
 int nvs_delete(struct nvs_fs *fs, uint16_t id);
 
+/**
+ * @brief nvs_gc_ahead
+ *
+ * Garbage collect the next sector now if an entry of len bytes would not
+ * fit in the current sector, so that writing it does not wait for garbage
+ * collection. This can be called when the system is idle, e.g. from a low
+ * priority thread. At most one sector is collected per call, and the space
+ * left in the current sector is lost.
+ *
+ * @param fs Pointer to file system
+ * @param len Data length of the entry to make room for
+ * @retval 0 Success
+ * @retval -ERRNO errno code if error
+ */
+int nvs_gc_ahead(struct nvs_fs *fs, size_t len);
+
 /**
  * @brief nvs_read
  *
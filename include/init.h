@@ -32,6 +32,17 @@ extern "C" {
 
 struct device;
 
+#ifdef CONFIG_INIT_PARALLEL
+/* Run time state of an init entry allowed to run in parallel */
+struct z_init_async {
+	struct k_work work;
+	const struct init_entry *entry;
+	/* Given once the init function has returned */
+	struct k_sem done;
+	atomic_t state;
+};
+#endif
+
 /**
  * @brief Static init entry structure for each device driver or services
  *
@@ -49,6 +60,12 @@ struct init_entry {
 	 * if the init entry is not used for a device driver but a services.
 	 */
 	struct device *dev;
+#ifdef CONFIG_INIT_PARALLEL
+	/** Parallel initialization state, NULL for entries that are run
+	 * in order.
+	 */
+	struct z_init_async *async;
+#endif
 };
 
 void z_sys_init_run_level(int32_t level);
@@ -90,6 +107,31 @@ void z_sys_init_run_level(int32_t level);
 		.dev = (device),					\
 	}
 
+/**
+ * @def Z_INIT_ENTRY_ASYNC_DEFINE
+ *
+ * @brief Create an init entry object that may run in parallel
+ *
+ * @details Like Z_INIT_ENTRY_DEFINE(), but with CONFIG_INIT_PARALLEL the
+ * init function of a POST_KERNEL or later entry is run on a boot worker
+ * thread, concurrently with the entries that follow it in the same level.
+ * Use SYS_INIT_ASYNC() or DEVICE_AND_API_INIT_ASYNC() instead.
+ */
+#ifdef CONFIG_INIT_PARALLEL
+#define Z_INIT_ENTRY_ASYNC_DEFINE(entry_name, init_fn, device, level, prio) \
+	static struct z_init_async _CONCAT(__init_async_, entry_name);	\
+	static const Z_DECL_ALIGN(struct init_entry)			\
+		_CONCAT(__init_, entry_name) __used			\
+	__attribute__((__section__(".init_" #level STRINGIFY(prio)))) = { \
+		.init = (init_fn),					\
+		.dev = (device),					\
+		.async = &_CONCAT(__init_async_, entry_name),		\
+	}
+#else
+#define Z_INIT_ENTRY_ASYNC_DEFINE(entry_name, init_fn, device, level, prio) \
+	Z_INIT_ENTRY_DEFINE(entry_name, init_fn, device, level, prio)
+#endif
+
 /**
  * @def SYS_INIT
  *
@@ -135,6 +177,30 @@ void z_sys_init_run_level(int32_t level);
 #define SYS_INIT(init_fn, level, prio)					\
 	Z_INIT_ENTRY_DEFINE(Z_SYS_NAME(init_fn), init_fn, NULL, level, prio)
 
+/**
+ * @def SYS_INIT_ASYNC
+ *
+ * @ingroup device_model
+ *
+ * @brief Run an initialization function at boot, possibly in parallel
+ *
+ * @details Like SYS_INIT(), but when CONFIG_INIT_PARALLEL is enabled and
+ * @p level is POST_KERNEL or later, the function is started at its place
+ * in the init order and runs on a boot worker thread while the following
+ * entries of the level are processed.  All such entries have completed
+ * before the next level starts.  Later entries of the same level that need
+ * the result must wait for it with device_init_wait() (for devices) or
+ * their own synchronization.  Without CONFIG_INIT_PARALLEL this is the
+ * same as SYS_INIT().
+ *
+ * @param init_fn Pointer to the boot function to run
+ * @param level The initialization level, see SYS_INIT().
+ * @param prio The initialization priority, see SYS_INIT().
+ */
+#define SYS_INIT_ASYNC(init_fn, level, prio)				\
+	Z_INIT_ENTRY_ASYNC_DEFINE(Z_SYS_NAME(init_fn), init_fn, NULL,	\
+				  level, prio)
+
 #ifdef __cplusplus
 }
 #endif
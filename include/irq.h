@@ -409,6 +409,27 @@ static inline unsigned int irq_parent_level_3(unsigned int irq)
  */
 #define irq_is_enabled(irq) arch_irq_is_enabled(irq)
 
+#if defined(CONFIG_ARCH_HAS_IRQ_AFFINITY) || defined(__DOXYGEN__)
+/**
+ * @brief Route an IRQ to a set of CPUs.
+ *
+ * This routine selects the CPUs which service interrupts from source
+ * @a irq, so that the interrupts of a device can be kept away from the
+ * CPUs running latency sensitive threads. When several CPUs are selected,
+ * the interrupt controller picks one of them for each interrupt.
+ *
+ * @param irq IRQ line.
+ * @param cpu_mask Bit mask of the CPUs, bit n standing for CPU n.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if the mask is empty, holds CPUs which do not exist, or
+ *	   the IRQ line can't be routed.
+ * @retval -ENOTSUP if the interrupt controller can't route the IRQ line in
+ *	   its current mode.
+ */
+#define irq_set_affinity(irq, cpu_mask) arch_irq_set_affinity(irq, cpu_mask)
+#endif
+
 /**
  * @}
  */
@@ -94,6 +94,7 @@ extern "C" {
 struct k_thread;
 struct k_mutex;
 struct k_sem;
+struct k_event;
 struct k_msgq;
 struct k_mbox;
 struct k_pipe;
@@ -405,6 +406,92 @@ static inline void k_object_free(void *obj)
 /* LCOV_EXCL_STOP */
 #endif /* CONFIG_DYNAMIC_OBJECTS */
 
+/**
+ * @brief Run the system calls queued in a batch
+ *
+ * User threads enter the kernel once for all @a count entries, which
+ * run in order with the usual validation of their arguments. A batched
+ * call failing validation oopses the thread just like the direct call.
+ * Entries queued by supervisor threads have already run.
+ *
+ * Use k_syscall_batch_submit() rather than calling this directly.
+ *
+ * @param entries Array of queued system calls
+ * @param count Number of entries
+ * @return 0
+ */
+__syscall int k_syscall_batch_run(struct k_syscall_batch_entry *entries,
+				  uint32_t count);
+
+#ifdef CONFIG_SYSCALL_BATCH
+/**
+ * @brief Initialize a system call batch
+ *
+ * For a user thread, @a batch and @a entries must be in memory the
+ * thread can write, for example its stack.
+ *
+ * @param batch Batch to initialize
+ * @param entries Storage for the queued calls
+ * @param size Number of entries in @a entries
+ */
+static inline void k_syscall_batch_init(struct k_syscall_batch *batch,
+					struct k_syscall_batch_entry *entries,
+					uint32_t size)
+{
+	batch->entries = entries;
+	batch->size = size;
+	batch->count = 0U;
+}
+
+/**
+ * @brief Queue a system call in a batch
+ *
+ * Any system call whose arguments fit in six registers can be queued:
+ * the build generates a z_batch_<name>() function for it. The call runs
+ * on k_syscall_batch_submit() in a user thread, and right away in a
+ * supervisor thread.
+ *
+ * @param batch Batch to queue the call in
+ * @param name System call name, for example k_sem_give
+ * @return Index of the entry, to get the return value with
+ *         k_syscall_batch_ret(), or -ENOMEM if the batch is full
+ */
+#define K_SYSCALL_BATCH(batch, name, ...) \
+	(((batch)->count == (batch)->size) ? -ENOMEM : \
+	 z_batch_##name(batch, ##__VA_ARGS__))
+
+/**
+ * @brief Run the queued calls of a batch and empty it
+ *
+ * @param batch Batch to submit
+ * @return 0
+ */
+static inline int k_syscall_batch_submit(struct k_syscall_batch *batch)
+{
+	int ret = 0;
+
+	if (batch->count != 0U) {
+		ret = k_syscall_batch_run(batch->entries, batch->count);
+	}
+	batch->count = 0U;
+
+	return ret;
+}
+
+/**
+ * @brief Get the return value of a submitted call
+ *
+ * @param batch Submitted batch
+ * @param index Index returned by K_SYSCALL_BATCH()
+ * @return The call's return value, cast to uintptr_t
+ */
+static inline uintptr_t k_syscall_batch_ret(const struct k_syscall_batch *batch,
+					    int index)
+{
+	return batch->entries[index].ret;
+}
+#endif /* CONFIG_SYSCALL_BATCH */
+
 /** @} */
 
 
@@ -546,6 +633,12 @@ struct _thread_stack_info {
 typedef struct _thread_stack_info _thread_stack_info_t;
 #endif /* CONFIG_THREAD_STACK_INFO */
 
+/** Thread (or ISR) runtime statistics */
+typedef struct k_thread_runtime_stats {
+	/** Hardware cycles spent running, as counted by k_cycle_get_32() */
+	uint64_t execution_cycles;
+} k_thread_runtime_stats_t;
+
 #if defined(CONFIG_USERSPACE)
 struct _mem_domain_info {
 	/** memory domain queue node */
@@ -554,6 +647,19 @@ struct _mem_domain_info {
 	struct k_mem_domain *mem_domain;
 };
 
+#if defined(CONFIG_USERSPACE_OBJ_CACHE)
+struct _thread_obj_cache {
+	/** object addresses of the cached lookups */
+	void *obj[CONFIG_USERSPACE_OBJ_CACHE_SIZE];
+	/** kernel object metadata found for each address */
+	struct z_object *ko[CONFIG_USERSPACE_OBJ_CACHE_SIZE];
+	/** generation of the object tables the entries were filled from */
+	atomic_val_t gen;
+	/** next entry to replace */
+	uint8_t next;
+};
+#endif /* CONFIG_USERSPACE_OBJ_CACHE */
+
 #endif /* CONFIG_USERSPACE */
 
 #ifdef CONFIG_THREAD_USERSPACE_LOCAL_DATA
@@ -622,9 +728,29 @@ struct k_thread {
 	k_thread_stack_t *stack_obj;
 	/** current syscall frame pointer */
 	void *syscall_frame;
+#if defined(CONFIG_USERSPACE_OBJ_CACHE)
+	/** recent kernel object lookups made by this thread's syscalls */
+	struct _thread_obj_cache obj_cache;
+#endif
 #endif /* CONFIG_USERSPACE */
 
 
+#if defined(CONFIG_THREAD_RUNTIME_STATS)
+	/** Runtime statistics */
+	struct k_thread_runtime_stats rt_stats;
+#endif
+
+#if defined(CONFIG_EVENTS)
+	/** Events waited for, then events which woke the thread up */
+	uint32_t events;
+
+	/** Options of the event wait */
+	uint32_t event_options;
+
+	/** Next thread woken up by the same k_event post */
+	struct k_thread *next_event_link;
+#endif
+
 #if defined(CONFIG_USE_SWITCH)
 	/* When using __switch() a few previously arch-specific items
 	 * become part of the core OS
@@ -709,6 +835,57 @@ extern void k_thread_foreach(k_thread_user_cb_t user_cb, void *user_data);
 extern void k_thread_foreach_unlocked(
 	k_thread_user_cb_t user_cb, void *user_data);
 
+/**
+ * @brief Get the runtime statistics of a thread.
+ *
+ * The cycles are accumulated on every context switch. The count of a
+ * thread running on another CPU only includes its previous time slices.
+ *
+ * @note CONFIG_THREAD_RUNTIME_STATS must be set for this function
+ * to be available.
+ *
+ * @param thread Thread.
+ * @param stats Filled with the statistics of the thread.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if an argument is NULL.
+ */
+int k_thread_runtime_stats_get(k_tid_t thread,
+			       k_thread_runtime_stats_t *stats);
+
+/**
+ * @brief Get the runtime statistics of all threads together.
+ *
+ * Includes the idle threads, so that the share of a thread in the total
+ * is its CPU load.
+ *
+ * @note CONFIG_THREAD_RUNTIME_STATS must be set for this function
+ * to be available.
+ *
+ * @param stats Filled with the sum of the statistics of all threads.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if stats is NULL.
+ */
+int k_thread_runtime_stats_all_get(k_thread_runtime_stats_t *stats);
+
+/**
+ * @brief Get the runtime statistics of an interrupt.
+ *
+ * The cycles of an interrupt include the ones of the interrupts which
+ * preempted it, and are not charged to the interrupted thread.
+ *
+ * @note CONFIG_THREAD_RUNTIME_STATS_ISR must be set for this function
+ * to be available.
+ *
+ * @param irq IRQ line, as an index in the software ISR table.
+ * @param stats Filled with the statistics of the interrupt.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if the IRQ is out of range or stats is NULL.
+ */
+int k_isr_runtime_stats_get(unsigned int irq, k_thread_runtime_stats_t *stats);
+
 /** @} */
 
 /**
@@ -2038,6 +2215,23 @@ static inline void *z_impl_k_timer_user_data_get(struct k_timer *timer)
 	return timer->user_data;
 }
 
+#ifdef CONFIG_TIMEOUT_SLACK
+/**
+ * @brief Allow a timer to expire late.
+ *
+ * The expirations of the timer may then be delayed by up to @a slack, to
+ * coalesce them with other timeouts and save wakeups. The period of a
+ * periodic timer runs from its actual expiration. The slack applies from
+ * the next start of the timer.
+ *
+ * @param timer     Address of timer.
+ * @param slack     Maximum delay of the expirations, K_NO_WAIT for none.
+ *
+ * @return N/A
+ */
+__syscall void k_timer_slack_set(struct k_timer *timer, k_timeout_t slack);
+#endif
+
 /** @} */
 
 /**
@@ -2203,6 +2397,14 @@ struct k_queue {
 	sys_sflist_t data_q;
 	struct k_spinlock lock;
 	_wait_q_t wait_q;
+#ifdef CONFIG_QUEUE_LOCKLESS
+	/* Items appended without the lock, newest first, not yet moved
+	 * to data_q.
+	 */
+	atomic_ptr_t pending;
+	/* Number of threads about to pend or pending in k_queue_get() */
+	atomic_t waiters;
+#endif
 
 	_POLL_EVENT;
 	_OBJECT_TRACING_NEXT_PTR(k_queue)
@@ -2222,6 +2424,10 @@ struct k_queue {
 
 extern void *z_queue_node_peek(sys_sfnode_t *node, bool needs_free);
 
+#ifdef CONFIG_QUEUE_LOCKLESS
+extern void z_queue_flush_pending(struct k_queue *queue);
+#endif
+
 /**
  * INTERNAL_HIDDEN @endcond
  */
@@ -2400,6 +2606,30 @@ extern int k_queue_merge_slist(struct k_queue *queue, sys_slist_t *list);
  */
 __syscall void *k_queue_get(struct k_queue *queue, k_timeout_t timeout);
 
+/**
+ * @brief Get all elements from a queue.
+ *
+ * This routine removes every data item present in @a queue and appends
+ * them, in queue order, to @a list in a single operation.  If the queue
+ * is empty it waits up to @a timeout for an item to arrive.  The first
+ * word of each data item is used to link it into @a list, so this can
+ * only be used on queues whose items are added without allocation, i.e.
+ * not with k_queue_alloc_append() or k_queue_alloc_prepend().
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param queue Address of the queue.
+ * @param list List the data items are appended to.
+ * @param timeout Non-negative waiting period to obtain a data item
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of data items appended to @a list, 0 if returned without
+ * waiting, or waiting period timed out.
+ */
+extern int k_queue_get_batch(struct k_queue *queue, sys_slist_t *list,
+			     k_timeout_t timeout);
+
 /**
  * @brief Remove an element from a queue.
  *
@@ -2416,6 +2646,9 @@ __syscall void *k_queue_get(struct k_queue *queue, k_timeout_t timeout);
  */
 static inline bool k_queue_remove(struct k_queue *queue, void *data)
 {
+#ifdef CONFIG_QUEUE_LOCKLESS
+	z_queue_flush_pending(queue);
+#endif
 	return sys_sflist_find_and_remove(&queue->data_q, (sys_sfnode_t *)data);
 }
 
@@ -2437,6 +2670,9 @@ static inline bool k_queue_unique_append(struct k_queue *queue, void *data)
 {
 	sys_sfnode_t *test;
 
+#ifdef CONFIG_QUEUE_LOCKLESS
+	z_queue_flush_pending(queue);
+#endif
 	SYS_SFLIST_FOR_EACH_NODE(&queue->data_q, test) {
 		if (test == (sys_sfnode_t *) data) {
 			return false;
@@ -2464,6 +2700,11 @@ __syscall int k_queue_is_empty(struct k_queue *queue);
 
 static inline int z_impl_k_queue_is_empty(struct k_queue *queue)
 {
+#ifdef CONFIG_QUEUE_LOCKLESS
+	if (atomic_ptr_get(&queue->pending) != NULL) {
+		return 0;
+	}
+#endif
 	return (int)sys_sflist_is_empty(&queue->data_q);
 }
 
@@ -2480,6 +2721,9 @@ __syscall void *k_queue_peek_head(struct k_queue *queue);
 
 static inline void *z_impl_k_queue_peek_head(struct k_queue *queue)
 {
+#ifdef CONFIG_QUEUE_LOCKLESS
+	z_queue_flush_pending(queue);
+#endif
 	return z_queue_node_peek(sys_sflist_peek_head(&queue->data_q), false);
 }
 
@@ -2496,6 +2740,9 @@ __syscall void *k_queue_peek_tail(struct k_queue *queue);
 
 static inline void *z_impl_k_queue_peek_tail(struct k_queue *queue)
 {
+#ifdef CONFIG_QUEUE_LOCKLESS
+	z_queue_flush_pending(queue);
+#endif
 	return z_queue_node_peek(sys_sflist_peek_tail(&queue->data_q), false);
 }
 
@@ -2735,6 +2982,26 @@ struct k_fifo {
 #define k_fifo_get(fifo, timeout) \
 	k_queue_get(&(fifo)->_queue, timeout)
 
+/**
+ * @brief Get all elements from a FIFO queue.
+ *
+ * This routine removes every data item present in @a fifo and appends
+ * them, oldest first, to @a list, waiting up to @a timeout if the FIFO is
+ * empty.  See k_queue_get_batch().
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param fifo Address of the FIFO queue.
+ * @param list Pointer to sys_slist_t object receiving the data items.
+ * @param timeout Waiting period to obtain a data item,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of data items appended to @a list, 0 if returned without
+ * waiting, or waiting period timed out.
+ */
+#define k_fifo_get_batch(fifo, list, timeout) \
+	k_queue_get_batch(&(fifo)->_queue, list, timeout)
+
 /**
  * @brief Query a FIFO queue to see if it has data available.
  *
@@ -3078,6 +3345,14 @@ struct k_work_q {
 	struct k_thread thread;
 };
 
+struct k_work_pool {
+	/* Shared queue, work_q.thread being the first worker */
+	struct k_work_q work_q;
+	/* Remaining num_threads - 1 workers */
+	struct k_thread *threads;
+	size_t num_threads;
+};
+
 enum {
 	K_WORK_STATE_PENDING,	/* Work item pending state */
 };
@@ -3276,6 +3551,25 @@ extern void k_work_q_start(struct k_work_q *work_q,
 			   k_thread_stack_t *stack,
 			   size_t stack_size, int prio);
 
+/**
+ * @brief Start a workqueue whose thread is pinned to a CPU.
+ *
+ * This works identically to k_work_q_start(), except that if
+ * CONFIG_SCHED_CPU_MASK is enabled the work processing thread only runs on
+ * CPU @a cpu modulo CONFIG_MP_NUM_CPUS.
+ *
+ * @param work_q Address of workqueue.
+ * @param stack Pointer to work queue thread's stack space.
+ * @param stack_size Size of the work queue thread's stack (in bytes).
+ * @param prio Priority of the work queue's thread.
+ * @param cpu CPU index.
+ *
+ * @return N/A
+ */
+extern void k_work_q_start_pinned(struct k_work_q *work_q,
+				  k_thread_stack_t *stack,
+				  size_t stack_size, int prio, int cpu);
+
 /**
  * @brief Start a workqueue in user mode
  *
@@ -3299,6 +3593,104 @@ extern void k_work_q_user_start(struct k_work_q *work_q,
 				k_thread_stack_t *stack,
 				size_t stack_size, int prio);
 
+/**
+ * @brief Start a workqueue serviced by a pool of threads.
+ *
+ * This routine starts a workqueue whose items are processed by
+ * @a num_threads worker threads which all take work from one shared queue,
+ * so that a slow work handler only occupies one worker and idle CPUs can
+ * pick up pending work.  The workqueue returned by k_work_pool_queue() is
+ * used with the regular k_work, k_delayed_work and k_work_poll APIs.
+ *
+ * Work items submitted to a pool may run concurrently with each other, and
+ * an item resubmitted by its own handler may start again on another worker
+ * before the first invocation returns.  Handlers must not rely on the
+ * serialization provided by single threaded workqueues.
+ *
+ * @param pool Address of the work pool.
+ * @param stacks First element of an array of @a num_threads stacks, as
+ *		defined by K_THREAD_STACK_ARRAY_DEFINE()
+ * @param stack_size Size of each stack, as passed to
+ *		K_THREAD_STACK_ARRAY_DEFINE().
+ * @param threads Array of @a num_threads - 1 thread objects for the
+ *		additional workers (may be NULL if @a num_threads is 1).
+ * @param num_threads Number of worker threads.
+ * @param prio Priority of the worker threads.
+ * @param pin If true and CONFIG_SCHED_CPU_MASK is enabled, pin worker @a i
+ *		to CPU @a i modulo CONFIG_MP_NUM_CPUS.
+ *
+ * @return N/A
+ */
+extern void k_work_pool_start(struct k_work_pool *pool,
+			      k_thread_stack_t *stacks, size_t stack_size,
+			      struct k_thread *threads, size_t num_threads,
+			      int prio, bool pin);
+
+/**
+ * @brief Get the workqueue of a work pool.
+ *
+ * @param pool Address of the work pool.
+ *
+ * @return Workqueue to pass to k_work_submit_to_queue() and friends.
+ */
+static inline struct k_work_q *k_work_pool_queue(struct k_work_pool *pool)
+{
+	return &pool->work_q;
+}
+
+/**
+ * @brief Submit a work item to a work pool.
+ *
+ * The item is run by the first idle worker of the pool, see
+ * k_work_submit_to_queue().
+ *
+ * @param pool Address of the work pool.
+ * @param work Address of work item.
+ *
+ * @return N/A
+ */
+static inline void k_work_pool_submit(struct k_work_pool *pool,
+				      struct k_work *work)
+{
+	k_work_submit_to_queue(k_work_pool_queue(pool), work);
+}
+
+/** @cond INTERNAL_HIDDEN */
+extern void z_work_q_main(void *work_q_ptr, void *p2, void *p3);
+
+#define Z_WORK_POOL_WORKER_DEFINE(i, name, stack_size, prio)		\
+	K_THREAD_DEFINE(_k_work_pool_##name##_##i, stack_size,		\
+			z_work_q_main, &name.work_q, NULL, NULL,	\
+			prio, 0, 0);
+/** @endcond */
+
+/**
+ * @brief Statically define and start a work pool.
+ *
+ * The worker threads are static threads, started at boot before main()
+ * runs, so no thread is created when work is handed to the pool. Each
+ * worker runs one work item at a time and then waits for the next one,
+ * its thread object and stack being reused for every item.
+ *
+ * The pool is used as if started with k_work_pool_start(), its worker
+ * threads are not pinned to CPUs.
+ *
+ * @param name Name of the work pool.
+ * @param n_threads Number of worker threads, an integer literal.
+ * @param stack_size Stack size of each worker thread.
+ * @param prio Priority of the worker threads.
+ */
+#define K_WORK_POOL_DEFINE(name, n_threads, stack_size, prio)		\
+	extern struct k_work_pool name;					\
+	UTIL_LISTIFY(n_threads, Z_WORK_POOL_WORKER_DEFINE, name,	\
+		     stack_size, prio)					\
+	struct k_work_pool name = {					\
+		.work_q = {						\
+			.queue = Z_QUEUE_INITIALIZER(name.work_q.queue), \
+		},							\
+		.num_threads = n_threads,				\
+	}
+
 /**
  * @brief Initialize a delayed work item.
  *
@@ -3313,6 +3705,23 @@ extern void k_work_q_user_start(struct k_work_q *work_q,
 extern void k_delayed_work_init(struct k_delayed_work *work,
 				k_work_handler_t handler);
 
+#ifdef CONFIG_TIMEOUT_SLACK
+/**
+ * @brief Allow a delayed work item to be submitted late.
+ *
+ * The countdown of the work item may then be extended by up to @a slack,
+ * to coalesce its expiry with other timeouts and save wakeups. The slack
+ * applies from the next submission of the work item.
+ *
+ * @param work Address of delayed work item.
+ * @param slack Maximum extension of the delay, K_NO_WAIT for none.
+ *
+ * @return N/A
+ */
+extern void k_delayed_work_slack_set(struct k_delayed_work *work,
+				     k_timeout_t slack);
+#endif
+
 /**
  * @brief Submit a delayed work item.
  *
@@ -3710,6 +4119,29 @@ __syscall int k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout);
  */
 __syscall int k_mutex_unlock(struct k_mutex *mutex);
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+/**
+ * @brief Outcomes of contended mutex locks
+ */
+struct k_mutex_spin_stats {
+	/** Locks obtained by spinning on a running owner */
+	uint32_t spin_acquired;
+	/** Locks that spun, then had to pend */
+	uint32_t spin_blocked;
+	/** Locks that pended without spinning */
+	uint32_t blocked;
+};
+
+/**
+ * @brief Get adaptive spinning statistics for all mutexes.
+ *
+ * @param stats Structure receiving the counters.
+ *
+ * @return N/A
+ */
+void k_mutex_spin_stats_get(struct k_mutex_spin_stats *stats);
+#endif
+
 /**
  * @}
  */
@@ -3853,6 +4285,152 @@ static inline unsigned int z_impl_k_sem_count_get(struct k_sem *sem)
 
 /** @} */
 
+#ifdef CONFIG_EVENTS
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+struct k_event {
+	_wait_q_t wait_q;
+	uint32_t events;
+	_POLL_EVENT;
+};
+
+#define Z_EVENT_INITIALIZER(obj) \
+	{ \
+	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	.events = 0, \
+	_POLL_EVENT_OBJ_INIT(obj) \
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @defgroup event_apis Event APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/** Wait for any of the requested events (default) */
+#define K_EVENT_WAIT_ANY 0U
+
+/** Wait for all the requested events */
+#define K_EVENT_WAIT_ALL BIT(0)
+
+/** Clear the events which satisfied the wait */
+#define K_EVENT_WAIT_CLEAR BIT(1)
+
+/**
+ * @brief Initialize an event object.
+ *
+ * This routine initializes an event object, with no events set, prior to
+ * its first use.
+ *
+ * @param event Address of the event object.
+ *
+ * @return N/A
+ */
+__syscall void k_event_init(struct k_event *event);
+
+/**
+ * @brief Post events.
+ *
+ * This routine sets @a events in the event object, in addition to the
+ * events already set, and wakes up all the threads whose wait is then
+ * satisfied.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param event Address of the event object.
+ * @param events Events to set.
+ *
+ * @return N/A
+ */
+__syscall void k_event_post(struct k_event *event, uint32_t events);
+
+/**
+ * @brief Set the events.
+ *
+ * This routine replaces the events of the event object by @a events and
+ * wakes up all the threads whose wait is then satisfied.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param event Address of the event object.
+ * @param events New events of the event object.
+ *
+ * @return N/A
+ */
+__syscall void k_event_set(struct k_event *event, uint32_t events);
+
+/**
+ * @brief Clear events.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param event Address of the event object.
+ * @param events Events to clear.
+ *
+ * @return N/A
+ */
+__syscall void k_event_clear(struct k_event *event, uint32_t events);
+
+/**
+ * @brief Wait for events.
+ *
+ * This routine waits for any of @a events to be set, or for all of them
+ * with K_EVENT_WAIT_ALL. With K_EVENT_WAIT_CLEAR, the events satisfying
+ * the wait are cleared before the routine returns. All the threads whose
+ * wait is satisfied by a post are woken up, before any of them clears
+ * events.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param event Address of the event object.
+ * @param events Events to wait for.
+ * @param options K_EVENT_WAIT_ANY or K_EVENT_WAIT_ALL, optionally ORed
+ *                with K_EVENT_WAIT_CLEAR.
+ * @param timeout Waiting period for the events,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Requested events which satisfied the wait, or 0 if the wait
+ *         timed out or @a events is 0.
+ */
+__syscall uint32_t k_event_wait(struct k_event *event, uint32_t events,
+				uint32_t options, k_timeout_t timeout);
+
+/**
+ * @brief Get the events currently set.
+ *
+ * @param event Address of the event object.
+ *
+ * @return Current events of the event object.
+ */
+__syscall uint32_t k_event_get(struct k_event *event);
+
+static inline uint32_t z_impl_k_event_get(struct k_event *event)
+{
+	return event->events;
+}
+
+/**
+ * @brief Statically define and initialize an event object.
+ *
+ * The event object can be accessed outside the module where it is defined
+ * using:
+ *
+ * @code extern struct k_event <name>; @endcode
+ *
+ * @param name Name of the event object.
+ */
+#define K_EVENT_DEFINE(name) \
+	struct k_event name = Z_EVENT_INITIALIZER(name)
+
+/** @} */
+#endif /* CONFIG_EVENTS */
+
 /**
  * @defgroup msgq_apis Message Queue APIs
  * @ingroup kernel_apis
@@ -3863,8 +4441,10 @@ static inline unsigned int z_impl_k_sem_count_get(struct k_sem *sem)
  * @brief Message Queue Structure
  */
 struct k_msgq {
-	/** Message queue wait queue */
+	/** Message queue wait queue, for readers */
 	_wait_q_t wait_q;
+	/** Wait queue for writers */
+	_wait_q_t put_wait_q;
 	/** Lock */
 	struct k_spinlock lock;
 	/** Message size */
@@ -3896,6 +4476,7 @@ struct k_msgq {
 #define Z_MSGQ_INITIALIZER(obj, q_buffer, q_msg_size, q_max_msgs) \
 	{ \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	.put_wait_q = Z_WAIT_Q_INIT(&obj.put_wait_q), \
 	.msg_size = q_msg_size, \
 	.max_msgs = q_max_msgs, \
 	.buffer_start = q_buffer, \
@@ -3912,6 +4493,8 @@ struct k_msgq {
 
 
 #define K_MSGQ_FLAG_ALLOC	BIT(0)
+#define K_MSGQ_FLAG_PUT_CLAIM	BIT(1)
+#define K_MSGQ_FLAG_GET_CLAIM	BIT(2)
 
 /**
  * @brief Message Queue Attributes
@@ -4011,7 +4594,8 @@ int k_msgq_cleanup(struct k_msgq *msgq);
 /**
  * @brief Send a message to a message queue.
  *
- * This routine sends a message to message queue @a q.
+ * This routine sends a message to message queue @a q.  While a put claim
+ * is outstanding, it returns -EBUSY right away, whatever @a timeout is.
  *
  * @note Can be called by ISRs.
  *
@@ -4024,6 +4608,7 @@ int k_msgq_cleanup(struct k_msgq *msgq);
  * @retval 0 Message sent.
  * @retval -ENOMSG Returned without waiting or queue purged.
  * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY A put claim is outstanding, returned without waiting.
  */
 __syscall int k_msgq_put(struct k_msgq *msgq, void *data, k_timeout_t timeout);
 
@@ -4031,7 +4616,8 @@ __syscall int k_msgq_put(struct k_msgq *msgq, void *data, k_timeout_t timeout);
  * @brief Receive a message from a message queue.
  *
  * This routine receives a message from message queue @a q in a "first in,
- * first out" manner.
+ * first out" manner.  While a get claim is outstanding, it returns -EBUSY
+ * right away, whatever @a timeout is.
  *
  * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
  *
@@ -4044,6 +4630,7 @@ __syscall int k_msgq_put(struct k_msgq *msgq, void *data, k_timeout_t timeout);
  * @retval 0 Message received.
  * @retval -ENOMSG Returned without waiting.
  * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY A get claim is outstanding, returned without waiting.
  */
 __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
 
@@ -4063,6 +4650,118 @@ __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
  */
 __syscall int k_msgq_peek(struct k_msgq *msgq, void *data);
 
+/**
+ * @brief Receive several messages from a message queue.
+ *
+ * This routine receives up to @a max_msgs messages from message queue
+ * @a msgq, in a "first in, first out" manner, into consecutive
+ * message-sized slots at @a data.  The queue is locked once for the
+ * whole batch.  If the queue is empty, the routine waits for a single
+ * message as k_msgq_get() does.  While a get claim is outstanding, it
+ * returns -EBUSY right away, whatever @a timeout is.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of area to hold @a max_msgs messages.
+ * @param max_msgs Maximum number of messages to receive.
+ * @param timeout Waiting period to receive the first message,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of messages received (at least 1) on success.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY A get claim is outstanding, returned without waiting.
+ */
+__syscall int k_msgq_get_batch(struct k_msgq *msgq, void *data,
+			       uint32_t max_msgs, k_timeout_t timeout);
+
+/**
+ * @brief Claim a free slot of a message queue for writing in place.
+ *
+ * This routine reserves the next free slot of message queue @a msgq and
+ * returns its address in @a data; the caller writes the message there
+ * and hands it to readers with k_msgq_put_commit().  Only one put claim
+ * can be outstanding at a time, and k_msgq_put() returns -EBUSY while
+ * it is.
+ *
+ * The slot is part of the queue's ring buffer, so this API is not
+ * available to user mode threads.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address receiving the slot address.
+ * @param timeout Waiting period for a slot to become free,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @retval 0 Slot claimed.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Another put claim is outstanding.
+ */
+int k_msgq_put_claim(struct k_msgq *msgq, void **data, k_timeout_t timeout);
+
+/**
+ * @brief Commit a message written in place.
+ *
+ * This routine queues the message in the slot obtained from
+ * k_msgq_put_claim().  If a reader is waiting, the message is copied to
+ * it directly.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param msgq Address of the message queue.
+ *
+ * @retval 0 Message sent.
+ * @retval -EINVAL No put claim is outstanding.
+ */
+int k_msgq_put_commit(struct k_msgq *msgq);
+
+/**
+ * @brief Claim the oldest message of a message queue for reading in place.
+ *
+ * This routine returns in @a data the address of the oldest message in
+ * message queue @a msgq without copying it.  The message stays in the
+ * queue until k_msgq_get_release() is called.  Only one get claim can
+ * be outstanding at a time, and k_msgq_get() returns -EBUSY while it
+ * is.  Purging the queue cancels the claim.
+ *
+ * The message is part of the queue's ring buffer, so this API is not
+ * available to user mode threads.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address receiving the message address.
+ * @param timeout Waiting period for a message to arrive,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @retval 0 Message claimed.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Another get claim is outstanding.
+ */
+int k_msgq_get_claim(struct k_msgq *msgq, void **data, k_timeout_t timeout);
+
+/**
+ * @brief Release a message read in place.
+ *
+ * This routine removes the message obtained from k_msgq_get_claim()
+ * from the queue, making its slot available to writers.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param msgq Address of the message queue.
+ *
+ * @retval 0 Message removed.
+ * @retval -EINVAL No get claim is outstanding.
+ */
+int k_msgq_get_release(struct k_msgq *msgq);
+
 /**
  * @brief Purge a message queue.
  *
@@ -4341,6 +5040,8 @@ struct k_pipe {
 	size_t         bytes_used;      /**< # bytes used in buffer */
 	size_t         read_index;      /**< Where in buffer to read from */
 	size_t         write_index;     /**< Where in buffer to write */
+	size_t         put_claim;       /**< # bytes claimed for writing */
+	size_t         get_claim;       /**< # bytes claimed for reading */
 	struct k_spinlock lock;		/**< Synchronization lock */
 
 	struct {
@@ -4365,6 +5066,8 @@ struct k_pipe {
 	.bytes_used = 0,                                            \
 	.read_index = 0,                                            \
 	.write_index = 0,                                           \
+	.put_claim = 0,                                             \
+	.get_claim = 0,                                             \
 	.lock = {},                                                 \
 	.wait_q = {                                                 \
 		.readers = Z_WAIT_Q_INIT(&obj.wait_q.readers),       \
@@ -4461,6 +5164,7 @@ __syscall int k_pipe_alloc_init(struct k_pipe *pipe, size_t size);
  * @retval -EIO Returned without waiting; zero data bytes were written.
  * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
  *                 minus one data bytes were written.
+ * @retval -EBUSY A put claim is outstanding; no data bytes were written.
  */
 __syscall int k_pipe_put(struct k_pipe *pipe, void *data,
 			 size_t bytes_to_write, size_t *bytes_written,
@@ -4484,6 +5188,7 @@ __syscall int k_pipe_put(struct k_pipe *pipe, void *data,
  * @retval -EIO Returned without waiting; zero data bytes were read.
  * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
  *                 minus one data bytes were read.
+ * @retval -EBUSY A get claim is outstanding; no data bytes were read.
  */
 __syscall int k_pipe_get(struct k_pipe *pipe, void *data,
 			 size_t bytes_to_read, size_t *bytes_read,
@@ -4506,6 +5211,94 @@ __syscall int k_pipe_get(struct k_pipe *pipe, void *data,
 extern void k_pipe_block_put(struct k_pipe *pipe, struct k_mem_block *block,
 			     size_t size, struct k_sem *sem);
 
+/**
+ * @brief Claim free space of a pipe's buffer for writing in place.
+ *
+ * This routine reserves up to @a size contiguous free bytes at the write
+ * position of @a pipe's ring buffer and returns their address in @a data.
+ * The caller fills them and hands them to readers with
+ * k_pipe_put_commit().  Fewer than @a size bytes are claimed when the
+ * free space wraps around the end of the buffer.  Only one put claim can
+ * be outstanding at a time, and k_pipe_put() returns -EBUSY while it is.
+ *
+ * The claimed bytes are part of the pipe's buffer, so this API is not
+ * available to user mode threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address receiving the address of the claimed bytes.
+ * @param size Maximum number of bytes to claim.
+ * @param timeout Waiting period for free space to become available,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of bytes claimed (at least 1) on success.
+ * @retval -EINVAL Zero bytes requested or the pipe has no buffer.
+ * @retval -EIO Returned without waiting; the buffer is full.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Another put claim is outstanding.
+ */
+int k_pipe_put_claim(struct k_pipe *pipe, uint8_t **data, size_t size,
+		     k_timeout_t timeout);
+
+/**
+ * @brief Commit bytes written in place to a pipe.
+ *
+ * This routine ends the put claim and makes the first @a size claimed
+ * bytes available to readers; the rest of the claim is given back.
+ * Readers waiting on the pipe are served from the buffer.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes written, at most the number claimed.
+ *
+ * @retval 0 Bytes committed.
+ * @retval -EINVAL No put claim is outstanding or @a size is too large.
+ */
+int k_pipe_put_commit(struct k_pipe *pipe, size_t size);
+
+/**
+ * @brief Claim data of a pipe's buffer for reading in place.
+ *
+ * This routine returns in @a data the address of up to @a size
+ * contiguous bytes at the read position of @a pipe's ring buffer,
+ * without copying them.  The bytes stay in the pipe until
+ * k_pipe_get_release() is called.  Only one get claim can be
+ * outstanding at a time, and k_pipe_get() returns -EBUSY while it is.
+ *
+ * Only buffered data can be claimed: data of writers waiting on the pipe
+ * is moved into the buffer as space is released.
+ *
+ * The claimed bytes are part of the pipe's buffer, so this API is not
+ * available to user mode threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address receiving the address of the claimed bytes.
+ * @param size Maximum number of bytes to claim.
+ * @param timeout Waiting period for data to become available,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of bytes claimed (at least 1) on success.
+ * @retval -EINVAL Zero bytes requested or the pipe has no buffer.
+ * @retval -EIO Returned without waiting; the buffer is empty.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Another get claim is outstanding.
+ */
+int k_pipe_get_claim(struct k_pipe *pipe, uint8_t **data, size_t size,
+		     k_timeout_t timeout);
+
+/**
+ * @brief Release bytes read in place from a pipe.
+ *
+ * This routine ends the get claim and frees the first @a size claimed
+ * bytes; the rest stay in the pipe to be read again.  Writers waiting on
+ * the pipe move their data into the freed space.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes consumed, at most the number claimed.
+ *
+ * @retval 0 Bytes released.
+ * @retval -EINVAL No get claim is outstanding or @a size is too large.
+ */
+int k_pipe_get_release(struct k_pipe *pipe, size_t size);
+
 /**
  * @brief Query the number of bytes that may be read from @a pipe.
  *
@@ -4532,6 +5325,14 @@ __syscall size_t k_pipe_write_avail(struct k_pipe *pipe);
  * @cond INTERNAL_HIDDEN
  */
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+struct k_mem_slab_cache {
+	struct k_spinlock lock;
+	char *free_list;
+	uint32_t count;
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	uint32_t num_blocks;
@@ -4539,6 +5340,12 @@ struct k_mem_slab {
 	char *buffer;
 	char *free_list;
 	uint32_t num_used;
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	/* Blocks counted in num_used but held by a CPU's magazine */
+	struct k_mem_slab_cache cache[CONFIG_MP_NUM_CPUS];
+	/* Set while threads may wait, freed blocks bypass the caches */
+	bool cache_bypass;
+#endif
 
 	_OBJECT_TRACING_NEXT_PTR(k_mem_slab)
 	_OBJECT_TRACING_LINKED_FLAG
@@ -4652,6 +5459,37 @@ extern int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem,
  */
 extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
 
+/**
+ * @brief Allocate several memory blocks from a memory slab.
+ *
+ * This routine allocates up to @a count blocks without waiting and
+ * stores their addresses in @a mem.  The slab is locked once for the
+ * whole batch.
+ *
+ * @param slab Address of the memory slab.
+ * @param mem Array receiving the block addresses.
+ * @param count Number of blocks requested.
+ *
+ * @return Number of blocks allocated, which may be less than @a count.
+ */
+extern uint32_t k_mem_slab_alloc_batch(struct k_mem_slab *slab, void **mem,
+				       uint32_t count);
+
+/**
+ * @brief Free several memory blocks to a memory slab.
+ *
+ * This routine releases @a count blocks whose addresses are stored in
+ * @a mem, locking the slab once for the whole batch.
+ *
+ * @param slab Address of the memory slab.
+ * @param mem Array of block addresses.
+ * @param count Number of blocks in @a mem.
+ *
+ * @return N/A
+ */
+extern void k_mem_slab_free_batch(struct k_mem_slab *slab, void **mem,
+				  uint32_t count);
+
 /**
  * @brief Get the number of used blocks in a memory slab.
  *
@@ -4664,7 +5502,17 @@ extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	uint32_t cached = 0U;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		cached += slab->cache[i].count;
+	}
+
+	return slab->num_used - cached;
+#else
 	return slab->num_used;
+#endif
 }
 
 /**
@@ -4679,7 +5527,7 @@ static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->num_blocks - slab->num_used;
+	return slab->num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /** @} */
@@ -4721,6 +5569,25 @@ void k_heap_init(struct k_heap *h, void *mem, size_t bytes);
  */
 void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout);
 
+/**
+ * @brief Resize memory allocated by k_heap_alloc()
+ *
+ * Resizes the block at @a ptr, in place if the adjacent memory allows
+ * it, otherwise by allocating a new block, copying the contents and
+ * freeing the old one.  A NULL @a ptr behaves like k_heap_alloc(), a
+ * zero @a bytes like k_heap_free().  If the new size cannot be
+ * obtained by the expiration of the timeout, NULL is returned and the
+ * original block is left untouched.
+ *
+ * @param h Heap which owns the block
+ * @param ptr A valid memory block, or NULL
+ * @param bytes New size of the block
+ * @param timeout How long to wait, or K_NO_WAIT
+ * @return A pointer to valid heap memory, or NULL
+ */
+void *k_heap_realloc(struct k_heap *h, void *ptr, size_t bytes,
+		     k_timeout_t timeout);
+
 /**
  * @brief Free memory allocated by k_heap_alloc()
  *
@@ -4911,6 +5778,9 @@ enum _poll_types_bits {
 	/* queue/FIFO/LIFO data availability */
 	_POLL_TYPE_DATA_AVAILABLE,
 
+	/* events set in a k_event */
+	_POLL_TYPE_EVENTS_POSTED,
+
 	_POLL_NUM_TYPES
 };
 
@@ -4933,6 +5803,9 @@ enum _poll_states_bits {
 	/* queue/FIFO/LIFO wait was cancelled */
 	_POLL_STATE_CANCELLED,
 
+	/* events are set in a k_event */
+	_POLL_STATE_EVENTS_POSTED,
+
 	_POLL_NUM_STATES
 };
 
@@ -4963,6 +5836,7 @@ enum _poll_states_bits {
 #define K_POLL_TYPE_SEM_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_SEM_AVAILABLE)
 #define K_POLL_TYPE_DATA_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_DATA_AVAILABLE)
 #define K_POLL_TYPE_FIFO_DATA_AVAILABLE K_POLL_TYPE_DATA_AVAILABLE
+#define K_POLL_TYPE_EVENTS_POSTED Z_POLL_TYPE_BIT(_POLL_TYPE_EVENTS_POSTED)
 
 /* public - polling modes */
 enum k_poll_modes {
@@ -4979,6 +5853,7 @@ enum k_poll_modes {
 #define K_POLL_STATE_DATA_AVAILABLE Z_POLL_STATE_BIT(_POLL_STATE_DATA_AVAILABLE)
 #define K_POLL_STATE_FIFO_DATA_AVAILABLE K_POLL_STATE_DATA_AVAILABLE
 #define K_POLL_STATE_CANCELLED Z_POLL_STATE_BIT(_POLL_STATE_CANCELLED)
+#define K_POLL_STATE_EVENTS_POSTED Z_POLL_STATE_BIT(_POLL_STATE_EVENTS_POSTED)
 
 /* public - poll signal object */
 struct k_poll_signal {
@@ -5034,6 +5909,7 @@ struct k_poll_event {
 		struct k_sem *sem;
 		struct k_fifo *fifo;
 		struct k_queue *queue;
+		struct k_event *event_obj;
 	};
 };
 
@@ -5187,6 +6063,89 @@ __syscall void k_poll_signal_check(struct k_poll_signal *signal,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *signal, int result);
 
+/**
+ * @brief Persistent set of poll events
+ *
+ * Events added to a poll set stay registered with their objects across
+ * calls to k_poll_set_wait(), which only touches the events that became
+ * ready.  This makes waiting on many objects O(ready) instead of O(events).
+ */
+struct k_poll_set {
+	/** PRIVATE - DO NOT TOUCH */
+	struct _poller poller;
+
+	/** PRIVATE - DO NOT TOUCH: events that triggered, not yet returned */
+	sys_dlist_t ready;
+
+	/** PRIVATE - DO NOT TOUCH: events returned by the last wait */
+	sys_dlist_t reported;
+
+	/** PRIVATE - DO NOT TOUCH */
+	_wait_q_t wait_q;
+};
+
+/**
+ * @brief Initialize a poll set.
+ *
+ * The calling thread becomes the owner of the set; its priority is used to
+ * order the set's registrations against other pollers of the same objects.
+ * Only one thread at a time may wait on a set.
+ *
+ * @param set Poll set to initialize.
+ *
+ * @return N/A
+ */
+extern void k_poll_set_init(struct k_poll_set *set);
+
+/**
+ * @brief Add a poll event to a poll set.
+ *
+ * The event must have been initialized with k_poll_event_init() and must
+ * not be in use by k_poll() or another set.  It stays registered with its
+ * object until removed with k_poll_set_remove().
+ *
+ * @param set Poll set.
+ * @param event Event to add.
+ *
+ * @return N/A
+ */
+extern void k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Remove a poll event from a poll set.
+ *
+ * @param set Poll set.
+ * @param event Event previously added with k_poll_set_add().
+ *
+ * @return N/A
+ */
+extern void k_poll_set_remove(struct k_poll_set *set,
+			      struct k_poll_event *event);
+
+/**
+ * @brief Wait for events of a poll set to become ready.
+ *
+ * Up to @a max_events ready events are stored in @a ready_events, with their
+ * state field set as by k_poll().  Reporting is level-triggered: events
+ * returned by one call are checked again by the next call on the same set
+ * and are reported again if their condition still holds, otherwise they
+ * are re-registered with their object.  Events not returned keep their
+ * registration untouched.
+ *
+ * @param set Poll set.
+ * @param ready_events Array receiving pointers to ready events.
+ * @param max_events Size of @a ready_events.
+ * @param timeout Waiting period for an event to be ready,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of events stored in @a ready_events (at least 1, unless
+ *	   the only ready events were removed concurrently).
+ * @retval -EAGAIN Waiting period timed out.
+ */
+extern int k_poll_set_wait(struct k_poll_set *set,
+			   struct k_poll_event **ready_events, int max_events,
+			   k_timeout_t timeout);
+
 /**
  * @internal
  */
@@ -128,6 +128,22 @@ struct _cpu {
 	/* True when _current is allowed to context switch */
 	uint8_t swap_ok;
 #endif
+
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	/* cycle count when rt_thread started being charged */
+	uint32_t rt_start;
+
+	/* thread charged for the cycles since rt_start */
+	struct k_thread *rt_thread;
+
+	/* cycles charged to all threads on this CPU */
+	uint64_t rt_total;
+
+#ifdef CONFIG_THREAD_RUNTIME_STATS_ISR
+	/* nesting level of timed ISRs, threads are not charged while > 0 */
+	uint32_t rt_isr_nested;
+#endif
+#endif
 };
 
 typedef struct _cpu _cpu_t;
@@ -222,19 +238,48 @@ struct _timeout {
 	sys_dnode_t node;
 	_timeout_func_t fn;
 #ifdef CONFIG_TIMEOUT_64BIT
-	/* Can't use k_ticks_t for header dependency reasons */
+	/* Can't use k_ticks_t for header dependency reasons.  Ticks
+	 * relative to the previous timeout in the queue, or absolute
+	 * expiry tick with CONFIG_TIMEOUT_WHEEL.
+	 */
 	uint64_t dticks;
 #else
 	uint32_t dticks;
 #endif
+#ifdef CONFIG_TIMEOUT_SLACK
+	/* Ticks the expiry may be delayed by to coalesce it with others */
+	uint32_t slack;
+#endif
 };
 
 /* kernel spinlock type */
 
+#ifdef CONFIG_SPINLOCK_STATS
+/* Contention counters of a spinlock, see k_spin_stats_get() */
+struct k_spinlock_stats {
+	/* Number of times the lock was taken */
+	uint32_t acquired;
+	/* Number of acquisitions that found the lock held */
+	uint32_t contended;
+	/* Number of spin loop iterations spent waiting */
+	uint32_t spins;
+};
+#endif
+
 struct k_spinlock {
 #ifdef CONFIG_SMP
+#ifdef CONFIG_SPINLOCK_TICKET
+	/* Next ticket to hand out, and ticket currently served */
+	atomic_t tail;
+	atomic_t owner;
+#else
 	atomic_t locked;
 #endif
+#endif
+
+#ifdef CONFIG_SPINLOCK_STATS
+	struct k_spinlock_stats stats;
+#endif
 
 #ifdef CONFIG_SPIN_VALIDATE
 	/* Stores the thread that holds the lock with the locking CPU
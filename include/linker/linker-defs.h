@@ -200,6 +200,17 @@ extern char __dtcm_start[];
 extern char __dtcm_end[];
 #endif
 
+#ifdef CONFIG_HOT_PATH_ITCM
+extern char __itcm_text_start[];
+extern char __itcm_text_end[];
+extern char __itcm_text_rom_start[];
+#endif
+
+#ifdef CONFIG_EXT_XIP_SECTIONS
+extern char __ext_xip_start[];
+extern char __ext_xip_end[];
+#endif
+
 /* Used by the Security Attribution Unit to configure the
  * Non-Secure Callable region.
  */
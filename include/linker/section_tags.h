@@ -32,6 +32,40 @@
 #define __imx_boot_dcd_section Z_GENERIC_SECTION(_IMX_BOOT_DCD_SECTION_NAME)
 #endif /* CONFIG_ARM */
 
+/*
+ * Kernel hot paths: functions placed in the ITCM, or copied to SRAM when
+ * executing in place, and data placed in the DTCM, with
+ * CONFIG_HOT_PATH_RELOCATION. Plain code and data otherwise.
+ */
+#if defined(CONFIG_HOT_PATH_RELOCATION)
+#define __hot_text	__attribute__((noinline, long_call)) \
+			__in_section_unique(_HOT_TEXT_SECTION_NAME)
+#else
+#define __hot_text
+#endif /* CONFIG_HOT_PATH_RELOCATION */
+
+#if defined(CONFIG_HOT_PATH_DTCM)
+#define __hot_data	__in_section_unique(dtcm_data)
+#define __hot_bss	__in_section_unique(dtcm_bss)
+#else
+#define __hot_data
+#define __hot_bss
+#endif /* CONFIG_HOT_PATH_DTCM */
+
+/*
+ * Cold code and constant data placed in an external flash executed in
+ * place with CONFIG_EXT_XIP_SECTIONS, to free internal flash. Plain code
+ * and rodata otherwise.
+ */
+#if defined(CONFIG_EXT_XIP_SECTIONS)
+#define __ext_xip_text	__attribute__((noinline, long_call)) \
+			__in_section_unique(ext_xip_text)
+#define __ext_xip_rodata __in_section_unique(ext_xip_rodata)
+#else
+#define __ext_xip_text
+#define __ext_xip_rodata
+#endif /* CONFIG_EXT_XIP_SECTIONS */
+
 #if defined(CONFIG_NOCACHE_MEMORY)
 #define __nocache __in_section_unique(_NOCACHE_SECTION_NAME)
 #else
@@ -46,6 +46,21 @@
 #define _DTCM_DATA_SECTION_NAME	.dtcm_data
 #define _DTCM_BSS_SECTION_NAME		.dtcm_bss
 #define _DTCM_NOINIT_SECTION_NAME	.dtcm_noinit
+
+#define _ITCM_TEXT_SECTION_NAME	.itcm_text
+#endif
+
+/* Cold code and data in external flash, see __ext_xip_text */
+#define _EXT_XIP_TEXT_SECTION_NAME	.ext_xip_text
+#define _EXT_XIP_RODATA_SECTION_NAME	.ext_xip_rodata
+
+/* Kernel hot paths, see __hot_text */
+#if defined(CONFIG_HOT_PATH_ITCM)
+#define _HOT_TEXT_SECTION_NAME itcm_text
+#elif defined(CONFIG_HOT_PATH_RELOCATION)
+#define _HOT_TEXT_SECTION_NAME ramfunc
+#else
+#define _HOT_TEXT_SECTION_NAME text
 #endif
 
 #define _IMX_BOOT_CONF_SECTION_NAME	.boot_hdr.conf
@@ -61,6 +76,7 @@
 #if defined(_ASMLANGUAGE)
 /* Various text section names */
 #define TEXT text
+#define HOT_TEXT _HOT_TEXT_SECTION_NAME
 #if defined(CONFIG_X86)
 #define TEXT_START text_start /* beginning of TEXT section */
 #else
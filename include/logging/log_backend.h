@@ -10,6 +10,7 @@
 #include <stdarg.h>
 #include <sys/__assert.h>
 #include <sys/util.h>
+#include <kernel.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -43,6 +44,26 @@ struct log_backend_api {
 	void (*init)(void);
 };
 
+/**
+ * @brief Logger backend processing thread.
+ *
+ * A backend with a processing thread gets messages through its own queue,
+ * so it does not delay other backends. Messages which do not fit in the
+ * queue are dropped for that backend only.
+ */
+struct log_backend_thread {
+	struct k_msgq *queue;
+	k_thread_stack_t *stack;
+	size_t stack_size;
+	struct k_thread *thread;
+	/* Non-NULL if the backend completes messages asynchronously, it
+	 * limits the number of messages passed to the backend and not
+	 * completed with log_backend_put_done().
+	 */
+	struct k_sem *pending;
+	int prio;
+};
+
 /**
  * @brief Logger backend control block.
  */
@@ -50,6 +71,10 @@ struct log_backend_control_block {
 	void *ctx;
 	uint8_t id;
 	bool active;
+#ifdef CONFIG_LOG_BACKEND_THREAD
+	bool thread_started;
+	atomic_t dropped;
+#endif
 };
 
 /**
@@ -60,6 +85,9 @@ struct log_backend {
 	struct log_backend_control_block *cb;
 	const char *name;
 	bool autostart;
+#ifdef CONFIG_LOG_BACKEND_THREAD
+	const struct log_backend_thread *thread;
+#endif
 };
 
 extern const struct log_backend __log_backends_start[];
@@ -87,6 +115,74 @@ extern const struct log_backend __log_backends_end[];
 		.autostart = _autostart					       \
 	}
 
+/**
+ * @brief Macro for creating a logger backend instance with its own
+ *	  processing thread.
+ *
+ * Messages are passed to the backend from a dedicated thread, through a
+ * queue of @p _queue_len messages. If @p _async is not zero, the backend
+ * API put function may return before the message is transmitted, and the
+ * backend calls @ref log_backend_put_done once it is. At most @p _async
+ * messages are then in progress in the backend, e.g. one being formatted
+ * while another one is transmitted by DMA. As for any backend, a message
+ * used after put returns must be held with log_msg_get(). In panic mode,
+ * messages must be processed synchronously.
+ *
+ * Requires CONFIG_LOG_BACKEND_THREAD, otherwise equivalent to
+ * @ref LOG_BACKEND_DEFINE.
+ *
+ * @param _name		Name of the backend instance.
+ * @param _api		Logger backend API.
+ * @param _autostart	If true backend is initialized and activated together
+ *			with the logger subsystem.
+ * @param _queue_len	Number of messages queued for the backend.
+ * @param _stack_size	Stack size of the backend thread.
+ * @param _prio		Priority of the backend thread.
+ * @param _async	Maximum number of messages in progress in the
+ *			backend, 0 if the backend processes messages
+ *			synchronously. Must be an integer literal.
+ */
+#ifdef CONFIG_LOG_BACKEND_THREAD
+#define LOG_BACKEND_THREAD_DEFINE(_name, _api, _autostart, _queue_len,	       \
+				  _stack_size, _prio, _async)		       \
+	K_MSGQ_DEFINE(UTIL_CAT(backend_queue_, _name),			       \
+		      sizeof(struct log_msg *), _queue_len, sizeof(void *));   \
+	K_KERNEL_STACK_DEFINE(UTIL_CAT(backend_stack_, _name), _stack_size);   \
+	static struct k_thread UTIL_CAT(backend_thread_, _name);	       \
+	COND_CODE_0(_async, (),						       \
+		(K_SEM_DEFINE(UTIL_CAT(backend_pending_, _name),	       \
+			      _async, _async);))			       \
+	static const struct log_backend_thread				       \
+		UTIL_CAT(backend_thread_cfg_, _name) =			       \
+	{								       \
+		.queue = &UTIL_CAT(backend_queue_, _name),		       \
+		.stack = UTIL_CAT(backend_stack_, _name),		       \
+		.stack_size = K_KERNEL_STACK_SIZEOF(			       \
+				UTIL_CAT(backend_stack_, _name)),	       \
+		.thread = &UTIL_CAT(backend_thread_, _name),		       \
+		.pending = COND_CODE_0(_async, (NULL),			       \
+				(&UTIL_CAT(backend_pending_, _name))),	       \
+		.prio = _prio,						       \
+	};								       \
+	static struct log_backend_control_block UTIL_CAT(backend_cb_, _name) = \
+	{								       \
+		.id = 0,						       \
+		.active = false,					       \
+	};								       \
+	static const Z_STRUCT_SECTION_ITERABLE(log_backend, _name) =	       \
+	{								       \
+		.api = &_api,						       \
+		.cb = &UTIL_CAT(backend_cb_, _name),			       \
+		.name = STRINGIFY(_name),				       \
+		.autostart = _autostart,				       \
+		.thread = &UTIL_CAT(backend_thread_cfg_, _name)		       \
+	}
+#else
+#define LOG_BACKEND_THREAD_DEFINE(_name, _api, _autostart, _queue_len,	       \
+				  _stack_size, _prio, _async)		       \
+	LOG_BACKEND_DEFINE(_name, _api, _autostart)
+#endif
+
 
 /**
  * @brief Put message with log entry to the backend.
@@ -102,6 +198,26 @@ static inline void log_backend_put(const struct log_backend *const backend,
 	backend->api->put(backend, msg);
 }
 
+/**
+ * @brief Notify that an asynchronous backend completed a message.
+ *
+ * Called by backends defined with @ref LOG_BACKEND_THREAD_DEFINE and a non
+ * zero @p _async parameter, once the transmission of a message passed to
+ * the put function is completed. May be called from an interrupt.
+ *
+ * @param[in] backend  Pointer to the backend instance.
+ */
+static inline void log_backend_put_done(const struct log_backend *const backend)
+{
+	__ASSERT_NO_MSG(backend != NULL);
+
+#ifdef CONFIG_LOG_BACKEND_THREAD
+	if ((backend->thread != NULL) && (backend->thread->pending != NULL)) {
+		k_sem_give(backend->thread->pending);
+	}
+#endif
+}
+
 /**
  * @brief Synchronously process log message.
  *
@@ -14,6 +14,7 @@
 #include <syscall.h>
 #include <sys/util.h>
 #include <sys/printk.h>
+#include <arch/common/ffs.h>
 
 #define LOG_LEVEL_NONE 0U
 #define LOG_LEVEL_ERR  1U
@@ -265,7 +266,7 @@ static inline char z_log_minimal_level_to_char(int level)
 			if (IS_ENABLED(CONFIG_LOG_MINIMAL)) {		       \
 				Z_LOG_TO_PRINTK(_level, __VA_ARGS__);	       \
 			} else if (is_user_context ||			       \
-				   (_level <= LOG_RUNTIME_FILTER(_filter))) {  \
+				   Z_LOG_RUNTIME_CHECK(_filter, _level)) {     \
 				struct log_msg_ids src_level = {	       \
 					.level = _level,		       \
 					.domain_id = CONFIG_LOG_DOMAIN_ID,     \
@@ -321,7 +322,7 @@ static inline char z_log_minimal_level_to_char(int level)
 							  (const char *)_data, \
 							  _length);	       \
 			} else if (is_user_context ||			       \
-				   (_level <= LOG_RUNTIME_FILTER(_filter))) {  \
+				   Z_LOG_RUNTIME_CHECK(_filter, _level)) {     \
 				struct log_msg_ids src_level = {	       \
 					.level = _level,		       \
 					.domain_id = CONFIG_LOG_DOMAIN_ID,     \
@@ -371,17 +372,30 @@ static inline char z_log_minimal_level_to_char(int level)
 /** @brief Filter slot size. */
 #define LOG_FILTER_SLOT_SIZE LOG_LEVEL_BITS
 
-/** @brief Number of slots in one word. */
-#define LOG_FILTERS_NUM_OF_SLOTS (32 / LOG_FILTER_SLOT_SIZE)
+/** @brief Number of bits of the aggregated filter.
+ *
+ * The aggregated filter is kept as a bitmap with one bit per log level, set
+ * if any backend accepts that level from the source. Checking a level is a
+ * single test of the filter word against a constant mask.
+ */
+#define LOG_FILTER_AGGR_BITS LOG_LEVEL_DBG
+
+/** @brief Aggregated filter mask. */
+#define LOG_FILTER_AGGR_MASK (BIT(LOG_FILTER_AGGR_BITS) - 1U)
+
+/** @brief Number of slots in one word, including the aggregated filter. */
+#define LOG_FILTERS_NUM_OF_SLOTS \
+	(1 + ((32 - LOG_FILTER_AGGR_BITS) / LOG_FILTER_SLOT_SIZE))
 
 /** @brief Slot mask. */
 #define LOG_FILTER_SLOT_MASK (BIT(LOG_FILTER_SLOT_SIZE) - 1U)
 
-/** @brief Bit offset of a slot.
+/** @brief Bit offset of a backend slot.
  *
- *  @param _id Slot ID.
+ *  @param _id Slot ID, starting from @ref LOG_FILTER_FIRST_BACKEND_SLOT_IDX.
  */
-#define LOG_FILTER_SLOT_SHIFT(_id) (LOG_FILTER_SLOT_SIZE * (_id))
+#define LOG_FILTER_SLOT_SHIFT(_id) \
+	(LOG_FILTER_SLOT_SIZE * ((_id) - 1U) + LOG_FILTER_AGGR_BITS)
 
 #define LOG_FILTER_SLOT_GET(_filters, _id) \
 	((*(_filters) >> LOG_FILTER_SLOT_SHIFT(_id)) & LOG_FILTER_SLOT_MASK)
@@ -396,16 +410,33 @@ static inline char z_log_minimal_level_to_char(int level)
 
 #define LOG_FILTER_AGGR_SLOT_IDX 0
 
+/** @brief Bit of the aggregated filter set if @p _level is accepted. */
+#define LOG_FILTER_AGGR_LEVEL_BIT(_level) (BIT(_level) >> 1)
+
 #define LOG_FILTER_AGGR_SLOT_GET(_filters) \
-	LOG_FILTER_SLOT_GET(_filters, LOG_FILTER_AGGR_SLOT_IDX)
+	find_msb_set(*(_filters) & LOG_FILTER_AGGR_MASK)
+
+#define LOG_FILTER_AGGR_SLOT_SET(_filters, _level)			\
+	do {								\
+		*(_filters) &= ~LOG_FILTER_AGGR_MASK;			\
+		*(_filters) |= (BIT(_level) - 1U) & LOG_FILTER_AGGR_MASK; \
+	} while (false)
+
+#define LOG_FILTER_AGGR_LEVEL_CHECK(_filters, _level) \
+	((*(_filters) & LOG_FILTER_AGGR_LEVEL_BIT(_level)) != 0U)
 
 #define LOG_FILTER_FIRST_BACKEND_SLOT_IDX 1
 
 #ifdef CONFIG_LOG_RUNTIME_FILTERING
 #define LOG_RUNTIME_FILTER(_filter) \
-	LOG_FILTER_SLOT_GET(&(_filter)->filters, LOG_FILTER_AGGR_SLOT_IDX)
+	LOG_FILTER_AGGR_SLOT_GET(&(_filter)->filters)
+
+#define Z_LOG_RUNTIME_CHECK(_filter, _level) \
+	LOG_FILTER_AGGR_LEVEL_CHECK(&(_filter)->filters, _level)
 #else
 #define LOG_RUNTIME_FILTER(_filter) LOG_LEVEL_DBG
+
+#define Z_LOG_RUNTIME_CHECK(_filter, _level) true
 #endif
 
 /** @brief Log level value used to indicate log entry that should not be
@@ -413,6 +444,16 @@ static inline char z_log_minimal_level_to_char(int level)
  */
 #define LOG_LEVEL_INTERNAL_RAW_STRING LOG_LEVEL_NONE
 
+/** @internal
+ * @brief Largest package held by a raw string log message.
+ *
+ * With CONFIG_LOG_PRINTK_PACKAGE raw strings are stored as packages built
+ * by printk_package(). This leaves room for the package header and one
+ * copied string of up to CONFIG_LOG_PRINTK_MAX_STRING_LENGTH characters.
+ */
+#define Z_LOG_PRINTK_PACKAGE_MAX_SIZE \
+	(CONFIG_LOG_PRINTK_MAX_STRING_LENGTH + 1 + 32)
+
 extern struct log_source_const_data __log_const_start[];
 extern struct log_source_const_data __log_const_end[];
 
@@ -655,6 +696,14 @@ uint32_t log_get_strdup_longest_string(void);
  */
 void log_dropped(void);
 
+/** @brief Indicate to the log core that one buffered log message has been
+ *	   dropped to make room for a new one.
+ *
+ * @note This function is intended to be used internally
+ *	 by the logging subsystem.
+ */
+void z_log_dropped_buffered(void);
+
 /** @brief Log a message from user mode context.
  *
  * @note This function is intended to be used internally
@@ -725,7 +774,7 @@ __syscall void z_log_hexdump_from_user(uint32_t src_level_val,
 					vprintk(_str, _valist);		       \
 				}					       \
 			} else if (is_user_context ||			       \
-				   (_level <= LOG_RUNTIME_FILTER(_filter))) {  \
+				   Z_LOG_RUNTIME_CHECK(_filter, _level)) {     \
 				struct log_msg_ids src_level = {	       \
 					.level = _level,		       \
 					.domain_id = CONFIG_LOG_DOMAIN_ID,     \
@@ -160,7 +160,7 @@ union log_msg_chunk {
 	struct log_msg_cont cont;
 };
 
-/** @brief Function for initialization of the log message pool. */
+/** @brief Function for initialization of the log message buffer. */
 void log_msg_pool_init(void);
 
 /** @brief Function for indicating that message is in use.
@@ -181,6 +181,31 @@ void log_msg_get(struct log_msg *msg);
  */
 void log_msg_put(struct log_msg *msg);
 
+/** @brief Function for making a message available for processing.
+ *
+ *  @note This function is intended to be used internally
+ *	  by the logging subsystem.
+ *
+ *  @param msg Message.
+ */
+void log_msg_commit(struct log_msg *msg);
+
+/** @brief Function for getting the oldest message for processing.
+ *
+ *  @note This function is intended to be used internally
+ *	  by the logging subsystem.
+ *
+ *  @return Message, to be released with @ref log_msg_put, or NULL if there
+ *	    is none ready.
+ */
+struct log_msg *log_msg_claim(void);
+
+/** @brief Function for checking if a message is ready for processing.
+ *
+ *  @return true if @ref log_msg_claim has a message to return.
+ */
+bool log_msg_pending(void);
+
 /** @brief Get domain ID of the message.
  *
  * @param msg Message
@@ -306,21 +331,35 @@ void log_msg_hexdump_data_get(struct log_msg *msg,
 			      size_t *length,
 			      size_t offset);
 
-union log_msg_chunk *log_msg_no_space_handle(void);
+/** @brief Allocate contiguous chunks from the buffer.
+ *
+ * Continuation chunks directly follow the head chunk in the buffer, and
+ * are freed along with it.
+ *
+ * @param n Number of chunks.
+ *
+ * @return Pointer to the first chunk or NULL if failed to allocate.
+ */
+union log_msg_chunk *log_msg_chunks_alloc(uint32_t n);
 
-/** @brief Allocate single chunk from the pool.
+/** @brief Allocate single chunk from the buffer.
  *
  * @return Pointer to the allocated chunk or NULL if failed to allocate.
  */
-union log_msg_chunk *log_msg_chunk_alloc(void);
+static inline union log_msg_chunk *log_msg_chunk_alloc(void)
+{
+	return log_msg_chunks_alloc(1U);
+}
 
-/** @brief Allocate chunk for standard log message.
+/** @brief Allocate chunks for standard log message.
  *
- *  @return Allocated chunk of NULL.
+ *  @param n Number of chunks.
+ *
+ *  @return Allocated chunks or NULL.
  */
-static inline struct log_msg *z_log_msg_std_alloc(void)
+static inline struct log_msg *z_log_msg_std_chunks_alloc(uint32_t n)
 {
-	struct  log_msg *msg = (struct  log_msg *)log_msg_chunk_alloc();
+	struct  log_msg *msg = (struct  log_msg *)log_msg_chunks_alloc(n);
 
 	if (msg != NULL) {
 		/* all fields reset to 0, reference counter to 1 */
@@ -339,6 +378,15 @@ static inline struct log_msg *z_log_msg_std_alloc(void)
 	return msg;
 }
 
+/** @brief Allocate chunk for standard log message.
+ *
+ *  @return Allocated chunk of NULL.
+ */
+static inline struct log_msg *z_log_msg_std_alloc(void)
+{
+	return z_log_msg_std_chunks_alloc(1U);
+}
+
 /** @brief Create standard log message with no arguments.
  *
  *  @details Function resets header and sets following fields:
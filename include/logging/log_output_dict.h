@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_INCLUDE_LOGGING_LOG_OUTPUT_DICT_H_
+#define ZEPHYR_INCLUDE_LOGGING_LOG_OUTPUT_DICT_H_
+
+#include <logging/log_output.h>
+#include <logging/log_msg.h>
+#include <stdarg.h>
+#include <toolchain.h>
+#include <sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Dictionary based log output
+ * @defgroup log_output_dict Dictionary based log output
+ * @ingroup log_output
+ * @{
+ *
+ * Messages are written as binary records in the target's byte order. Format
+ * strings, hexdump descriptions and constant string arguments are only
+ * referred to by their address, and are resolved on the host from the
+ * database generated from the ELF file by
+ * scripts/logging/dictionary/database_gen.py.
+ */
+
+/** @brief Record types. */
+enum log_dict_output_msg_type {
+	/** Standard message, arguments follow the header. */
+	LOG_DICT_OUTPUT_MSG_STD,
+	/** Hexdump or raw string, data follows the header. */
+	LOG_DICT_OUTPUT_MSG_HEXDUMP,
+	/** Dropped messages notification. */
+	LOG_DICT_OUTPUT_MSG_DROPPED,
+};
+
+/** @brief Header of standard and hexdump records.
+ *
+ * A standard record is followed by @p len arguments of sizeof(log_arg_t)
+ * bytes each, then @p nstr strings copied from RAM, each one made of the
+ * index of the argument it replaces on one byte and its characters
+ * including the terminating null character.
+ *
+ * A hexdump record is followed by @p len bytes of data.
+ */
+struct log_dict_output_normal_msg_hdr {
+	uint8_t type;       /**< LOG_DICT_OUTPUT_MSG_STD or _HEXDUMP. */
+	uint8_t ids;        /**< Level (bits 0-2) and domain ID (bits 3-7). */
+	uint16_t source;    /**< Source ID. */
+	uint32_t timestamp; /**< Timestamp, in timestamp counter ticks. */
+	uintptr_t fmt;      /**< Address of the format string or description. */
+	uint16_t len;       /**< Number of arguments or data length. */
+	uint8_t nstr;       /**< Number of strings following the arguments. */
+} __packed;
+
+/** @brief Dropped messages record. */
+struct log_dict_output_dropped_msg {
+	uint8_t type;       /**< LOG_DICT_OUTPUT_MSG_DROPPED. */
+	uint32_t count;     /**< Number of dropped messages. */
+} __packed;
+
+/** @brief Process log message in dictionary format.
+ *
+ * @param log_output Pointer to the log output instance.
+ * @param msg Log message.
+ * @param flags Optional flags.
+ */
+void log_output_msg_dict_process(const struct log_output *log_output,
+				 struct log_msg *msg, uint32_t flags);
+
+/** @brief Process dropped messages indication in dictionary format.
+ *
+ * @param log_output Pointer to the log output instance.
+ * @param cnt Number of dropped messages.
+ */
+void log_output_dropped_dict_process(const struct log_output *log_output,
+				     uint32_t cnt);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_LOGGING_LOG_OUTPUT_DICT_H_ */
@@ -54,6 +54,17 @@
  * | ------------- | ------------- |
  * | Polynomial    | 0x1021        |
  * | Initial Value | 0             |
+ *
+ * ## Binary framing
+ *
+ * With CONFIG_UART_MCUMGR_BINARY, the UART transport sends each packet in a
+ * single frame, without encoding:
+ *     offset 0:    0x06 0x16
+ *     offset 2:    {16-bit packet-length}
+ *     offset 4:    {body}
+ *     offset ?:    {crc16}
+ *
+ * The packet length does not include the CRC, which is computed as above.
  */
 
 #ifndef ZEPHYR_INCLUDE_MGMT_SERIAL_H_
@@ -67,12 +78,15 @@ extern "C" {
 
 #define MCUMGR_SERIAL_HDR_PKT       0x0609
 #define MCUMGR_SERIAL_HDR_FRAG      0x0414
+#define MCUMGR_SERIAL_HDR_BIN       0x0616
 #define MCUMGR_SERIAL_MAX_FRAME     128
 
 #define MCUMGR_SERIAL_HDR_PKT_1     (MCUMGR_SERIAL_HDR_PKT >> 8)
 #define MCUMGR_SERIAL_HDR_PKT_2     (MCUMGR_SERIAL_HDR_PKT & 0xff)
 #define MCUMGR_SERIAL_HDR_FRAG_1    (MCUMGR_SERIAL_HDR_FRAG >> 8)
 #define MCUMGR_SERIAL_HDR_FRAG_2    (MCUMGR_SERIAL_HDR_FRAG & 0xff)
+#define MCUMGR_SERIAL_HDR_BIN_1     (MCUMGR_SERIAL_HDR_BIN >> 8)
+#define MCUMGR_SERIAL_HDR_BIN_2     (MCUMGR_SERIAL_HDR_BIN & 0xff)
 
 /**
  * @brief Maintains state for an incoming mcumgr request packet.
@@ -1243,6 +1243,9 @@ struct net_buf *net_buf_ref(struct net_buf *buf);
  * @brief Clone buffer
  *
  * Duplicate given buffer including any data and headers currently stored.
+ * If the pool of the buffer supports data referencing, which is the case
+ * of the fixed, variable and heap pools, the clone shares the data of the
+ * original buffer instead of getting a copy of it.
  *
  * @param buf A valid pointer on a buffer
  * @param timeout Affects the action taken should the pool be empty.
@@ -1254,6 +1257,36 @@ struct net_buf *net_buf_ref(struct net_buf *buf);
  */
 struct net_buf *net_buf_clone(struct net_buf *buf, k_timeout_t timeout);
 
+/**
+ * @brief Create a slice of a buffer
+ *
+ * Allocate a buffer from the pool of the given buffer, referencing
+ * @a len bytes of its data starting @a offset bytes past its data pointer,
+ * without copying them. The data stays allocated as long as the slice
+ * exists, even if the original buffer is released in the meantime. For
+ * fixed pools this is achieved by holding a reference to the original
+ * buffer, which thus stays out of its pool until the slice is released.
+ *
+ * A slice is a regular buffer when it comes to reading it, chaining it
+ * as a fragment or walking it with a net_pkt cursor. The referenced data
+ * is shared however, so neither the slice nor the original buffer should
+ * be written to while both exist. A slice has no tailroom.
+ *
+ * @param buf A valid pointer on a buffer
+ * @param offset Offset of the slice from the data pointer of @a buf
+ * @param len Length of the slice, @a offset + @a len must not exceed the
+ *        length of @a buf
+ * @param timeout Affects the action taken should the pool be empty.
+ *        If K_NO_WAIT, then return immediately. If K_FOREVER, then
+ *        wait as long as necessary. Otherwise, wait until the specified
+ *        timeout.
+ *
+ * @return Slice buffer or NULL if out of buffers or if the pool of @a buf
+ *         does not support data referencing.
+ */
+struct net_buf *net_buf_slice(struct net_buf *buf, size_t offset, size_t len,
+			      k_timeout_t timeout);
+
 /**
  * @brief Get a pointer to the user data of a buffer.
  *
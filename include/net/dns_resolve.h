@@ -216,6 +216,13 @@ struct dns_resolve_context {
 		 * cannot be used to find correct pending query.
 		 */
 		uint16_t query_hash;
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+		/** Index of the pending query whose answer this query shares
+		 * or -1 if this query was sent to the servers itself.
+		 */
+		int8_t leader;
+#endif
 	} queries[CONFIG_DNS_NUM_CONCUR_QUERIES];
 
 	/** Is this context in use */
@@ -305,6 +312,11 @@ int dns_resolve_cancel_with_name(struct dns_resolve_context *ctx,
  * We might send the query to multiple servers (if there are more than one
  * server configured), but we only use the result of the first received
  * response.
+ * If CONFIG_DNS_RESOLVER_CACHE is enabled, an answer that is still valid
+ * in the cache is given to the callback before this function returns and
+ * the returned DNS id is 0. A query for a name and type that is already
+ * pending shares the answer of that query and gets the same DNS id, so
+ * cancelling it cancels both.
  *
  * @param ctx DNS context
  * @param query What the caller wants to resolve.
@@ -399,6 +411,49 @@ static inline int dns_cancel_addr_info(uint16_t dns_id)
 	return dns_resolve_cancel(dns_resolve_get_default(), dns_id);
 }
 
+/**
+ * @typedef dns_cache_cb_t
+ * @brief Callback used while iterating over the DNS answer cache.
+ *
+ * @param name Host name of the cached answer.
+ * @param type Query type of the cached answer.
+ * @param status DNS_EAI_ALLDONE for a positive answer, or the error
+ * status that is returned for a negative answer.
+ * @param addrs Cached addresses, NULL for a negative answer.
+ * @param count Number of cached addresses.
+ * @param ttl Remaining lifetime of the entry in seconds.
+ * @param user_data A valid pointer to user data or NULL
+ */
+typedef void (*dns_cache_cb_t)(const char *name, enum dns_query_type type,
+			       enum dns_resolve_status status,
+			       const struct sockaddr *addrs, int count,
+			       uint32_t ttl, void *user_data);
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+/**
+ * @brief Go through all the valid entries of the DNS answer cache.
+ *
+ * @param cb User-supplied callback function to call
+ * @param user_data User specified data
+ */
+void dns_cache_foreach(dns_cache_cb_t cb, void *user_data);
+
+/**
+ * @brief Remove all entries from the DNS answer cache.
+ */
+void dns_cache_flush(void);
+#else
+static inline void dns_cache_foreach(dns_cache_cb_t cb, void *user_data)
+{
+	ARG_UNUSED(cb);
+	ARG_UNUSED(user_data);
+}
+
+static inline void dns_cache_flush(void)
+{
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
 /**
  * @}
  */
@@ -126,6 +126,9 @@ enum ethernet_hw_caps {
 
 	/** VLAN Tag stripping */
 	ETHERNET_HW_VLAN_TAG_STRIP	= BIT(14),
+
+	/** TCP segmentation offload, see net_pkt_set_tso_mss() */
+	ETHERNET_HW_TX_TSO		= BIT(15),
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -139,6 +142,7 @@ enum ethernet_config_type {
 	ETHERNET_CONFIG_TYPE_PROMISC_MODE,
 	ETHERNET_CONFIG_TYPE_PRIORITY_QUEUES_NUM,
 	ETHERNET_CONFIG_TYPE_FILTER,
+	ETHERNET_CONFIG_TYPE_RX_STEERING,
 };
 
 enum ethernet_qav_param_type {
@@ -188,6 +192,31 @@ struct ethernet_filter {
 	bool set;
 };
 
+/** Received frame field used to steer the frame to a priority queue */
+enum ethernet_rx_steering_type {
+	/** IPv4 DS field / IPv6 traffic class */
+	ETHERNET_RX_STEERING_TYPE_DS_TC,
+	/** UDP destination port */
+	ETHERNET_RX_STEERING_TYPE_UDP_PORT,
+	/** VLAN priority (PCP) */
+	ETHERNET_RX_STEERING_TYPE_VLAN_PRIORITY,
+};
+
+struct ethernet_rx_steering {
+	/** Index of the hardware rule to program */
+	int rule;
+	/** Field to match on */
+	enum ethernet_rx_steering_type type;
+	/** Value of the field */
+	uint16_t value;
+	/** ID of the queue matching frames are stored in, 0 is the
+	 * regular queue.
+	 */
+	int queue_id;
+	/** Set (true) or unset (false) the rule */
+	bool set;
+};
+
 /** @cond INTERNAL_HIDDEN */
 struct ethernet_config {
 	union {
@@ -208,6 +237,8 @@ struct ethernet_config {
 		int priority_queues_num;
 
 		struct ethernet_filter filter;
+
+		struct ethernet_rx_steering rx_steering;
 	};
 };
 /** @endcond */
@@ -263,6 +294,16 @@ struct ethernet_api {
 
 	/** Send a network packet */
 	int (*send)(struct device *dev, struct net_pkt *pkt);
+
+#if defined(CONFIG_NET_TX_BATCH)
+	/** Queue several network packets for transmission and start the
+	 * transmission only once. Return the number of packets, from the
+	 * start of the array, that were queued, or a negative error code.
+	 * The remaining packets are passed to send() one by one.
+	 */
+	int (*send_batch)(struct device *dev, struct net_pkt *pkts[],
+			  size_t count);
+#endif /* CONFIG_NET_TX_BATCH */
 };
 
 /* Make sure that the network interface API is properly setup inside
@@ -44,6 +44,7 @@ enum net_request_ethernet_cmd {
 	NET_REQUEST_ETHERNET_CMD_SET_PROMISC_MODE,
 	NET_REQUEST_ETHERNET_CMD_GET_PRIORITY_QUEUES_NUM,
 	NET_REQUEST_ETHERNET_CMD_GET_QAV_PARAM,
+	NET_REQUEST_ETHERNET_CMD_SET_RX_STEERING,
 };
 
 #define NET_REQUEST_ETHERNET_SET_AUTO_NEGOTIATION			\
@@ -86,8 +87,14 @@ NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_ETHERNET_GET_PRIORITY_QUEUES_NUM);
 
 NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_ETHERNET_GET_QAV_PARAM);
 
+#define NET_REQUEST_ETHERNET_SET_RX_STEERING				\
+	(_NET_ETHERNET_BASE | NET_REQUEST_ETHERNET_CMD_SET_RX_STEERING)
+
+NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_ETHERNET_SET_RX_STEERING);
+
 struct net_eth_addr;
 struct ethernet_qav_param;
+struct ethernet_rx_steering;
 
 struct ethernet_req_params {
 	union {
@@ -106,6 +113,8 @@ struct ethernet_req_params {
 		struct ethernet_qav_param qav_param;
 
 		int priority_queues_num;
+
+		struct ethernet_rx_steering rx_steering;
 	};
 };
 
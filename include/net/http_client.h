@@ -109,6 +109,16 @@ struct http_response {
 	/** Where the body starts */
 	uint8_t *body_start;
 
+	/** Start of the body fragment passed to the response callback.
+	 * It points into recv_buf and is only valid during the callback.
+	 */
+	const uint8_t *body_frag_start;
+
+	/** Length of the body fragment passed to the response callback,
+	 * not counting any header or chunk framing around it.
+	 */
+	size_t body_frag_len;
+
 	/** Where the response is stored, this is to be
 	 * provided by the user.
 	 */
@@ -149,6 +159,11 @@ struct http_response {
 	uint8_t cl_present : 1;
 	uint8_t body_found : 1;
 	uint8_t message_complete : 1;
+
+	/** The server allows the connection to be used for another
+	 * request, set when the response is complete.
+	 */
+	uint8_t keep_alive : 1;
 };
 
 /** HTTP client internal data that the application should not touch
@@ -243,7 +258,9 @@ struct http_request {
 	const char *payload;
 
 	/** Payload length is used to calculate Content-Length. Set to 0
-	 * for chunked transfers.
+	 * for chunked transfers. In that case add the
+	 * "Transfer-Encoding: chunked" header to header_fields and send
+	 * the payload with http_client_send_chunk() from payload_cb.
 	 */
 	size_t payload_len;
 
@@ -285,6 +302,44 @@ struct http_request {
 int http_client_req(int sock, struct http_request *req,
 		    int32_t timeout, void *user_data);
 
+/**
+ * @brief Send one chunk of a chunked transfer encoded payload. This is meant
+ * to be called from the payload callback of the request.
+ *
+ * @param sock Socket id of the connection.
+ * @param data Chunk data.
+ * @param len Length of the chunk data. A zero length sends the last chunk
+ *        that ends the payload.
+ *
+ * @return <0 if error, >=0 amount of data sent to the server
+ */
+int http_client_send_chunk(int sock, const void *data, size_t len);
+
+#if defined(CONFIG_HTTP_CLIENT_CONN_POOL_SIZE) && \
+	(CONFIG_HTTP_CLIENT_CONN_POOL_SIZE > 0)
+/**
+ * @brief Get a connection to a HTTP server. An idle connection to the same
+ * address kept from a previous request is returned if the server did not
+ * close it, otherwise a new TCP connection is created.
+ *
+ * @param addr Address and port of the server.
+ * @param addrlen Length of the address.
+ *
+ * @return <0 if error, otherwise the socket id of the connection
+ */
+int http_client_conn_get(const struct sockaddr *addr, socklen_t addrlen);
+
+/**
+ * @brief Give back a connection obtained with http_client_conn_get(). The
+ * connection is kept for the next request if the response to req allowed
+ * it, otherwise it is closed.
+ *
+ * @param sock Socket id of the connection.
+ * @param req Last request done on the connection, or NULL to close it.
+ */
+void http_client_conn_put(int sock, const struct http_request *req);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -453,6 +453,13 @@ struct mqtt_internal {
 
 	/** Internal. Remaining payload length to read. */
 	uint32_t remaining_payload;
+
+#if CONFIG_MQTT_INFLIGHT_WINDOW > 0
+	/** Internal. Message ids of the QoS 1 and QoS 2 publications that
+	 *  the broker has not acknowledged yet, 0 for a free slot.
+	 */
+	uint16_t inflight[CONFIG_MQTT_INFLIGHT_WINDOW];
+#endif
 };
 
 /**
@@ -584,6 +591,12 @@ int mqtt_connect(struct mqtt_client *client);
 /**
  * @brief API to publish messages on topics.
  *
+ * Only the packet header is encoded in the client's TX buffer, the payload
+ * is passed to the transport as is. Several QoS 1 and QoS 2 messages can be
+ * in flight at the same time; if :option:`CONFIG_MQTT_INFLIGHT_WINDOW` is
+ * set, publishing fails with -EAGAIN while that many messages wait for their
+ * PUBACK or PUBCOMP.
+ *
  * @param[in] client Client instance for which the procedure is requested.
  *                   Shall not be NULL.
  * @param[in] param Parameters to be used for the publish message.
@@ -111,6 +111,21 @@ typedef void (*net_context_send_cb_t)(struct net_context *context,
 				      int status,
 				      void *user_data);
 
+/**
+ * @typedef net_context_fill_cb_t
+ * @brief Callback producing the data to send straight into a packet.
+ *
+ * @details Called from net_context_send_from() for each network buffer
+ * fragment of the packet, in the context of the caller.
+ *
+ * @param buf Where to write the data.
+ * @param len Exact amount of data to write.
+ * @param user_data The fill data given in net_context_send_from() call.
+ *
+ * @return 0 if ok, < 0 if error
+ */
+typedef int (*net_context_fill_cb_t)(void *buf, size_t len, void *user_data);
+
 /**
  * @typedef net_tcp_accept_cb_t
  * @brief Accept callback
@@ -304,6 +319,10 @@ __net_socket struct net_context {
 #if defined(CONFIG_NET_CONTEXT_TXTIME)
 		bool txtime;
 #endif
+#if defined(CONFIG_NET_CONTEXT_REUSEPORT)
+		/** Share the local address and port with other contexts */
+		bool reuseport;
+#endif
 #if defined(CONFIG_SOCKS)
 		struct {
 			struct sockaddr addr;
@@ -690,6 +709,24 @@ static inline bool net_context_is_proxy_enabled(struct net_context *context)
 }
 #endif
 
+/**
+ * @brief Check if the context shares its local address and port.
+ *
+ * @param context Network context.
+ *
+ * @return True if the NET_OPT_REUSEPORT option is set, False otherwise.
+ */
+static inline bool net_context_is_reuseport(struct net_context *context)
+{
+#if defined(CONFIG_NET_CONTEXT_REUSEPORT)
+	return context->options.reuseport;
+#else
+	ARG_UNUSED(context);
+
+	return false;
+#endif
+}
+
 /**
  * @brief Get network context.
  *
@@ -925,6 +962,33 @@ int net_context_send(struct net_context *context,
 		     k_timeout_t timeout,
 		     void *user_data);
 
+/**
+ * @brief Send data produced by a callback to a peer.
+ *
+ * @details Same as net_context_send(), but instead of being copied from
+ * a buffer, the data is written by the fill callback straight into the
+ * network buffers of the packet. This avoids an intermediate copy when
+ * the data comes e.g. from a file. The packet size is limited by the
+ * network buffers available, so less than len may be sent.
+ *
+ * @param context The network context to use.
+ * @param fill Callback writing the data into the packet.
+ * @param fill_data User data passed to the fill callback.
+ * @param len Length of the data to send.
+ * @param cb Caller-supplied callback function.
+ * @param timeout Currently this value is not used.
+ * @param user_data Caller-supplied user data.
+ *
+ * @return Amount of data sent if ok, < 0 if error
+ */
+int net_context_send_from(struct net_context *context,
+			  net_context_fill_cb_t fill,
+			  void *fill_data,
+			  size_t len,
+			  net_context_send_cb_t cb,
+			  k_timeout_t timeout,
+			  void *user_data);
+
 /**
  * @brief Send data to a peer specified by address.
  *
@@ -1049,6 +1113,7 @@ enum net_context_option {
 	NET_OPT_TIMESTAMP	= 2,
 	NET_OPT_TXTIME		= 3,
 	NET_OPT_SOCKS5		= 4,
+	NET_OPT_REUSEPORT	= 5,
 };
 
 /**
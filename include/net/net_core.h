@@ -63,18 +63,15 @@ extern "C" {
 #if defined(CONFIG_NET_PKT_TXTIME_STATS_DETAIL) || \
 	defined(CONFIG_NET_PKT_RXTIME_STATS_DETAIL)
 #if !defined(NET_PKT_DETAIL_STATS_COUNT)
-#if defined(CONFIG_NET_PKT_TXTIME_STATS_DETAIL)
-
+/* RX path records: TC queue, TC dequeue, L2, IP, connection demux,
+ * socket queue and application read. TX path uses three points.
+ */
 #if defined(CONFIG_NET_PKT_RXTIME_STATS_DETAIL)
-#define NET_PKT_DETAIL_STATS_COUNT 4
+#define NET_PKT_DETAIL_STATS_COUNT 7
 #else
 #define NET_PKT_DETAIL_STATS_COUNT 3
 #endif /* CONFIG_NET_PKT_RXTIME_STATS_DETAIL */
 
-#else
-#define NET_PKT_DETAIL_STATS_COUNT 4
-#endif /* CONFIG_NET_PKT_TXTIME_STATS_DETAIL */
-
 #endif /* !NET_PKT_DETAIL_STATS_COUNT */
 #endif /* CONFIG_NET_PKT_TXTIME_STATS_DETAIL ||
 	  CONFIG_NET_PKT_RXTIME_STATS_DETAIL */
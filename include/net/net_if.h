@@ -458,6 +458,11 @@ struct net_if {
 #if defined(CONFIG_NET_STATISTICS_PER_INTERFACE)
 	/** Network statistics related to this network interface */
 	struct net_stats stats;
+
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+	/** Per CPU counters, summed up into stats when they are read */
+	struct net_stats_cpu stats_cpu[CONFIG_MP_NUM_CPUS];
+#endif
 #endif /* CONFIG_NET_STATISTICS_PER_INTERFACE */
 
 	/** Network interface instance configuration */
@@ -1933,6 +1938,16 @@ bool net_if_need_calc_rx_checksum(struct net_if *iface);
  */
 bool net_if_need_calc_tx_checksum(struct net_if *iface);
 
+/**
+ * @brief Check if the network device can split large TCP packets into
+ * segments when sending them (TCP segmentation offload).
+ *
+ * @param iface Network interface
+ *
+ * @return True if TCP segmentation is offloaded, false otherwise.
+ */
+bool net_if_can_offload_tso(struct net_if *iface);
+
 /**
  * @brief Get interface according to index
  *
@@ -2038,6 +2053,11 @@ struct net_if_timestamp_cb {
 
 	/** Timestamp callback */
 	net_if_timestamp_callback_t cb;
+
+#if defined(CONFIG_NET_PKT_TIMESTAMP_DIRECT)
+	/** Called from the context of the driver delivering the timestamp */
+	bool direct;
+#endif
 };
 
 /**
@@ -2055,6 +2075,28 @@ void net_if_register_timestamp_cb(struct net_if_timestamp_cb *handle,
 				  struct net_if *iface,
 				  net_if_timestamp_callback_t cb);
 
+#if defined(CONFIG_NET_PKT_TIMESTAMP_DIRECT)
+/**
+ * @brief Register a timestamp callback called directly by the driver.
+ *
+ * @details The callback is called from the context where the driver
+ * delivers the TX timestamp, often its interrupt handler, instead of the
+ * TX timestamp thread. It must not block and it consumes the packet, no
+ * other callback is called for it.
+ *
+ * @param handle Caller specified handler for the callback.
+ * @param pkt Net packet for which the callback is registered. NULL for all
+ *	      packets.
+ * @param iface Net interface for which the callback is. NULL for all
+ *		interfaces.
+ * @param cb Callback to register.
+ */
+void net_if_register_timestamp_cb_direct(struct net_if_timestamp_cb *handle,
+					 struct net_pkt *pkt,
+					 struct net_if *iface,
+					 net_if_timestamp_callback_t cb);
+#endif /* CONFIG_NET_PKT_TIMESTAMP_DIRECT */
+
 /**
  * @brief Unregister a timestamp callback.
  *
@@ -64,6 +64,16 @@ struct net_l2 {
 	 */
 	int (*send)(struct net_if *iface, struct net_pkt *pkt);
 
+	/**
+	 * Optional function used by net core to push several packets to
+	 * the lower layer at once, so that the driver can queue all of
+	 * them before starting the transmission. The result for each packet
+	 * is stored in the status array and has the same meaning as the
+	 * return value of send().
+	 */
+	void (*send_batch)(struct net_if *iface, struct net_pkt *pkts[],
+			   int *status, size_t count);
+
 	/**
 	 * This function is used to enable/disable traffic over a network
 	 * interface. The function returns <0 if error and >=0 if no error.
@@ -125,15 +135,21 @@ NET_L2_DECLARE_PUBLIC(CANBUS_RAW_L2);
 NET_L2_DECLARE_PUBLIC(CANBUS_L2);
 #endif /* CONFIG_NET_L2_CANBUS */
 
-#define NET_L2_INIT(_name, _recv_fn, _send_fn, _enable_fn, _get_flags_fn) \
+#define NET_L2_INIT_BATCH(_name, _recv_fn, _send_fn, _send_batch_fn,	\
+			  _enable_fn, _get_flags_fn)			\
 	const Z_STRUCT_SECTION_ITERABLE(net_l2,				\
 					NET_L2_GET_NAME(_name)) = {	\
 		.recv = (_recv_fn),					\
 		.send = (_send_fn),					\
+		.send_batch = (_send_batch_fn),				\
 		.enable = (_enable_fn),					\
 		.get_flags = (_get_flags_fn),				\
 	}
 
+#define NET_L2_INIT(_name, _recv_fn, _send_fn, _enable_fn, _get_flags_fn) \
+	NET_L2_INIT_BATCH(_name, _recv_fn, _send_fn, NULL, _enable_fn,	\
+			  _get_flags_fn)
+
 #define NET_L2_GET_DATA(name, sfx) _net_l2_data_##name##sfx
 
 #define NET_L2_DATA_INIT(name, sfx, ctx_type)				\
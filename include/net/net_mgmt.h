@@ -143,9 +143,10 @@ struct net_mgmt_event_callback {
 #endif
 
 	/** A mask of network events on which the above handler should be
-	 * called in case those events come. Such mask can be modified
-	 * whenever necessary by the owner, and thus will affect the handler
-	 * being called or not.
+	 * called in case those events come. The command part of such mask
+	 * can be modified whenever necessary by the owner, and thus will
+	 * affect the handler being called or not. Layer and layer code
+	 * must stay the same while the callback is registered.
 	 */
 	union {
 		/** A mask of network events on which the above handler should
@@ -194,6 +195,28 @@ void net_mgmt_add_event_callback(struct net_mgmt_event_callback *cb);
 #define net_mgmt_add_event_callback(...)
 #endif
 
+/**
+ * @brief Add a user callback run in the context raising the event
+ *
+ * The handler is called directly from net_mgmt_event_notify() or
+ * net_mgmt_event_notify_with_info(), before the event is queued for the
+ * regular callbacks. It thus sees every event, even when the event queue
+ * overflows, but it must be short, must not block and must not add or
+ * delete callbacks. The info pointer given to it is the one provided by
+ * the notifier. Without CONFIG_NET_MGMT_EVENT_DIRECT, the callback is
+ * added as a regular one.
+ *
+ * Layer and layer code of the callback's event mask must not be changed
+ * while it is registered, contrary to its command part.
+ *
+ * @param cb A valid pointer on user's callback to add.
+ */
+#ifdef CONFIG_NET_MGMT_EVENT_DIRECT
+void net_mgmt_add_event_callback_direct(struct net_mgmt_event_callback *cb);
+#else
+#define net_mgmt_add_event_callback_direct(cb) net_mgmt_add_event_callback(cb)
+#endif
+
 /**
  * @brief Delete a user callback
  * @param cb A valid pointer on user's callback to delete.
@@ -28,6 +28,7 @@
 #include <net/net_context.h>
 #include <net/ethernet_vlan.h>
 #include <net/ptp_time.h>
+#include <tracing/tracing.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -45,6 +46,24 @@ struct canbus_net_isotp_tx_ctx;
 struct canbus_net_isotp_rx_ctx;
 
 
+/** Checksum state of a network packet */
+enum net_pkt_chksum {
+	/** Checksums are computed or verified in software */
+	NET_PKT_CHKSUM_NONE = 0,
+	/** Outgoing packet, the IPv4 header, UDP and TCP checksums are left
+	 * for the hardware to fill in.
+	 */
+	NET_PKT_CHKSUM_PENDING,
+	/** Incoming packet, the IPv4 header checksum was verified by the
+	 * hardware.
+	 */
+	NET_PKT_CHKSUM_IP_VERIFIED,
+	/** Incoming packet, the IPv4 header and the UDP or TCP checksums were
+	 * verified by the hardware.
+	 */
+	NET_PKT_CHKSUM_VERIFIED,
+};
+
 /* buffer cursor used in net_pkt */
 struct net_pkt_cursor {
 	/** Current net_buf pointer by the cursor */
@@ -183,6 +202,8 @@ struct net_pkt {
 		uint8_t ppp_msg           : 1; /* This is a PPP message */
 	};
 
+	uint8_t chksum_state      : 2; /* enum net_pkt_chksum */
+
 #if defined(CONFIG_NET_TCP)
 	uint8_t tcp_first_msg     : 1; /* Is this the first time this pkt is sent,
 				     * or is this a resend of a TCP segment.
@@ -211,6 +232,20 @@ struct net_pkt {
 	 */
 	uint8_t priority;
 
+#if defined(CONFIG_NET_TCP_TSO)
+	/* Segment size the hardware splits this TCP packet into, zero if
+	 * the packet is sent as is.
+	 */
+	uint16_t tso_mss;
+#endif
+
+#if defined(CONFIG_NET_RX_FLOW_STEERING)
+	/* Hash of the flow the packet belongs to, used to select the RX
+	 * queue. Zero if not known yet.
+	 */
+	uint32_t rx_hash;
+#endif
+
 #if defined(CONFIG_NET_VLAN)
 	/* VLAN TCI (Tag Control Information). This contains the Priority
 	 * Code Point (PCP), Drop Eligible Indicator (DEI) and VLAN
@@ -381,6 +416,52 @@ static inline void net_pkt_set_tcp_1st_msg(struct net_pkt *pkt, bool is_1st)
 #endif
 }
 
+static inline enum net_pkt_chksum net_pkt_chksum_state(struct net_pkt *pkt)
+{
+	return (enum net_pkt_chksum)pkt->chksum_state;
+}
+
+static inline void net_pkt_set_chksum_state(struct net_pkt *pkt,
+					    enum net_pkt_chksum state)
+{
+	pkt->chksum_state = state;
+}
+
+#if defined(CONFIG_NET_TCP_TSO)
+static inline uint16_t net_pkt_tso_mss(struct net_pkt *pkt)
+{
+	return pkt->tso_mss;
+}
+
+/**
+ * @brief Let the hardware segment an outgoing TCP packet
+ *
+ * Only used on interfaces having the ETHERNET_HW_TX_TSO capability. The
+ * driver splits the TCP payload into segments of at most mss bytes and
+ * updates the IP and TCP headers of each of them.
+ *
+ * @param pkt Network packet
+ * @param mss Segment size, zero to send the packet as is.
+ */
+static inline void net_pkt_set_tso_mss(struct net_pkt *pkt, uint16_t mss)
+{
+	pkt->tso_mss = mss;
+}
+#else
+static inline uint16_t net_pkt_tso_mss(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_tso_mss(struct net_pkt *pkt, uint16_t mss)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(mss);
+}
+#endif
+
 #if defined(CONFIG_NET_SOCKETS)
 static inline uint8_t net_pkt_eof(struct net_pkt *pkt)
 {
@@ -685,6 +766,35 @@ static inline void net_pkt_set_priority(struct net_pkt *pkt,
 	pkt->priority = priority;
 }
 
+#if defined(CONFIG_NET_RX_FLOW_STEERING)
+static inline uint32_t net_pkt_rx_hash(struct net_pkt *pkt)
+{
+	return pkt->rx_hash;
+}
+
+/* Drivers with a hardware flow hash (RSS) can set it on reception to save
+ * the stack from computing one. Any non-zero value that is identical for
+ * all packets of a flow is suitable.
+ */
+static inline void net_pkt_set_rx_hash(struct net_pkt *pkt, uint32_t hash)
+{
+	pkt->rx_hash = hash;
+}
+#else
+static inline uint32_t net_pkt_rx_hash(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_rx_hash(struct net_pkt *pkt, uint32_t hash)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(hash);
+}
+#endif
+
 #if defined(CONFIG_NET_VLAN)
 static inline uint16_t net_pkt_vlan_tag(struct net_pkt *pkt)
 {
@@ -850,7 +960,18 @@ static ALWAYS_INLINE void net_pkt_set_stats_tick(struct net_pkt *pkt,
 }
 
 #define net_pkt_set_tx_stats_tick(pkt, tick) net_pkt_set_stats_tick(pkt, tick)
-#define net_pkt_set_rx_stats_tick(pkt, tick) net_pkt_set_stats_tick(pkt, tick)
+
+#if defined(CONFIG_NET_PKT_RXTIME_STATS_DETAIL)
+static ALWAYS_INLINE void net_pkt_set_rx_stats_tick(struct net_pkt *pkt,
+						    uint32_t tick)
+{
+	sys_trace_void(SYS_TRACE_ID_NET_RX_STAGE + pkt->detail.count);
+
+	net_pkt_set_stats_tick(pkt, tick);
+}
+#else
+#define net_pkt_set_rx_stats_tick(pkt, tick)
+#endif /* CONFIG_NET_PKT_RXTIME_STATS_DETAIL */
 #else
 static inline uint32_t *net_pkt_stats_tick(struct net_pkt *pkt)
 {
@@ -1693,6 +1814,26 @@ int net_pkt_copy(struct net_pkt *pkt_dst,
 		 struct net_pkt *pkt_src,
 		 size_t length);
 
+/**
+ * @brief Copy data from a packet into another one and checksum it.
+ *
+ * @details Same as net_pkt_copy() but the 16-bit ones' complement sum of
+ *          the copied data, as used by the Internet checksum, is added to
+ *          sum on the way, so that the data does not need to be walked
+ *          again to compute it. The copied data is summed as if it started
+ *          at an even offset.
+ *
+ * @param pkt_dst Destination network packet.
+ * @param pkt_src Source network packet.
+ * @param length  Length of data to be copied.
+ * @param sum     Pointer to the running sum, in host byte order.
+ *
+ * @return 0 on success, negative errno code otherwise.
+ */
+int net_pkt_copy_chksum(struct net_pkt *pkt_dst,
+			struct net_pkt *pkt_src,
+			size_t length, uint16_t *sum);
+
 /**
  * @brief Clone pkt and its buffer.
  *
@@ -1792,6 +1933,24 @@ int net_pkt_read_be32(struct net_pkt *pkt, uint32_t *data);
  */
 int net_pkt_write(struct net_pkt *pkt, const void *data, size_t length);
 
+/**
+ * @brief Write data produced by a callback into a net_pkt
+ *
+ * @details Same as net_pkt_write(), but the callback writes the data
+ *          directly into the net_pkt buffer fragments, e.g. reading
+ *          them from a file, instead of them being copied from a
+ *          buffer. It is called once per fragment written to.
+ *
+ * @param pkt       The network packet where to write
+ * @param fill      Callback writing the data
+ * @param user_data User data passed to the callback
+ * @param length    Length of the data to be written
+ *
+ * @return 0 on success, negative errno code otherwise.
+ */
+int net_pkt_write_from(struct net_pkt *pkt, net_context_fill_cb_t fill,
+		       void *user_data, size_t length);
+
 /* Write uint8_t data into a net_pkt. */
 static inline int net_pkt_write_u8(struct net_pkt *pkt, uint8_t data)
 {
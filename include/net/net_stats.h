@@ -218,6 +218,19 @@ struct net_stats_rx_time {
 	net_stats_t count;
 };
 
+/** Number of buckets in a packet time histogram */
+#define NET_STATS_TIME_HIST_BUCKETS 16
+
+/**
+ * @brief Network packet time histogram
+ *
+ * Bucket 0 counts the times below 1 us, bucket n > 0 the times from
+ * 2^(n-1) us up to 2^n us. The last bucket also counts all longer times.
+ */
+struct net_stats_time_hist {
+	net_stats_t bucket[NET_STATS_TIME_HIST_BUCKETS];
+};
+
 /**
  * @brief Traffic class statistics
  */
@@ -327,15 +340,32 @@ struct net_stats {
 	/** Network packet TX time detail statistics */
 	struct net_stats_tx_time tx_time_detail[NET_PKT_DETAIL_STATS_COUNT];
 #endif
-#if defined(CONFIG_NET_PKT_RXTIME_STATS_DETAIL)
-	/** Network packet RX time detail statistics */
-	struct net_stats_tx_time rx_time_detail[NET_PKT_DETAIL_STATS_COUNT];
 #endif
+
+#if defined(CONFIG_NET_PKT_TXTIME_STATS_HISTOGRAM)
+	/** Network packet TX time histogram */
+	struct net_stats_time_hist tx_time_hist;
 #endif
 
 #if defined(CONFIG_NET_PKT_RXTIME_STATS)
 	/** Network packet RX time statistics */
 	struct net_stats_rx_time rx_time;
+
+#if defined(CONFIG_NET_PKT_RXTIME_STATS_DETAIL)
+	/** Network packet RX time detail statistics */
+	struct net_stats_rx_time rx_time_detail[NET_PKT_DETAIL_STATS_COUNT];
+#endif
+#endif
+
+#if defined(CONFIG_NET_PKT_RXTIME_STATS_HISTOGRAM)
+	/** Network packet RX time histogram */
+	struct net_stats_time_hist rx_time_hist;
+
+#if defined(CONFIG_NET_PKT_RXTIME_STATS_DETAIL)
+	/** Network packet RX time histogram of each detail stage */
+	struct net_stats_time_hist
+			rx_time_detail_hist[NET_PKT_DETAIL_STATS_COUNT];
+#endif
 #endif
 
 #if defined(CONFIG_NET_STATISTICS_POWER_MANAGEMENT)
@@ -343,6 +373,19 @@ struct net_stats {
 #endif
 };
 
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+/**
+ * @brief Statistics updated by a single CPU.
+ *
+ * Each copy starts on a cache line of its own so that CPUs updating
+ * their counters do not disturb each other.
+ */
+struct net_stats_cpu {
+	/** Counters updated by this CPU */
+	struct net_stats stats;
+} __aligned(64);
+#endif
+
 /**
  * @brief Ethernet error statistics
  */
@@ -26,7 +26,9 @@
 #include <net/net_ip.h>
 #include <net/dns_resolve.h>
 #include <net/socket_select.h>
+#include <net/socket_epoll.h>
 #include <stdlib.h>
+#include <sys/atomic.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -38,6 +40,14 @@ struct zsock_pollfd {
 	short revents;
 };
 
+/** Message of zsock_sendmmsg() and zsock_recvmmsg() */
+struct zsock_mmsghdr {
+	struct msghdr msg_hdr;  /* Message header */
+	unsigned int msg_len;   /* Number of bytes sent or received */
+};
+
+struct net_pkt;
+
 /* ZSOCK_POLL* values are compatible with Linux */
 /** zsock_poll: Poll for readability */
 #define ZSOCK_POLLIN 1
@@ -124,8 +134,18 @@ struct zsock_pollfd {
 /** Socket option to control TLS session caching. Accepted values:
  *  - 0 - Disabled.
  *  - 1 - Enabled.
+ *
+ *  When enabled, clients cache the session established with a peer, and
+ *  offer it for resumption on the next connection to the same peer address
+ *  and hostname. Servers issue session tickets (RFC 5077) so that clients
+ *  can resume their sessions. Disabled by default.
  */
 #define TLS_SESSION_CACHE 7
+/** Read-only socket option to read the statistics of the client session
+ *  cache, shared by all the sockets. It returns a
+ *  struct zsock_tls_session_cache_stats.
+ */
+#define TLS_SESSION_CACHE_STATS 8
 
 /** @} */
 
@@ -142,6 +162,16 @@ struct zsock_pollfd {
 #define TLS_SESSION_CACHE_DISABLED 0 /**< Disable TLS session caching. */
 #define TLS_SESSION_CACHE_ENABLED 1 /**< Enable TLS session caching. */
 
+/** Statistics of the TLS client session cache, see TLS_SESSION_CACHE_STATS */
+struct zsock_tls_session_cache_stats {
+	/** Number of client handshakes that looked for a cached session */
+	uint32_t lookups;
+	/** Number of client handshakes that offered a cached session */
+	uint32_t hits;
+	/** Number of sessions stored after a completed handshake */
+	uint32_t stores;
+};
+
 struct zsock_addrinfo {
 	struct zsock_addrinfo *ai_next;
 	int ai_flags;
@@ -227,6 +257,65 @@ __syscall int zsock_socket(int family, int type, int proto);
  */
 __syscall int zsock_socketpair(int family, int type, int proto, int *sv);
 
+#if defined(CONFIG_NET_SOCKETPAIR)
+/**
+ * @brief Claim space in the peer's receive buffer of a socketpair
+ *
+ * @details
+ * Reserve up to @a size contiguous bytes in the receive buffer of the
+ * other end of socketpair @a sock and return their address in @a data,
+ * so a producer can build its message in place instead of copying it
+ * with send(). The bytes are handed to the peer with
+ * zsock_socketpair_commit(). Regular writes to @a sock fail with EBUSY
+ * while a claim is outstanding, and the peer must not be closed before
+ * the claim is committed. This function is only available to kernel
+ * threads.
+ *
+ * @param sock Socketpair endpoint to write to.
+ * @param data Address receiving the address of the claimed bytes.
+ * @param size Maximum number of bytes to claim.
+ *
+ * @return Number of bytes claimed, or -1 with errno set (EAGAIN if the
+ *         peer's buffer is full).
+ */
+int zsock_socketpair_claim(int sock, uint8_t **data, size_t size);
+
+/**
+ * @brief Commit bytes written in place to a socketpair
+ *
+ * @details
+ * End the claim made with zsock_socketpair_claim() and make the first
+ * @a size bytes available to the peer. A reader blocked on the peer is
+ * woken only if its buffer was empty.
+ *
+ * @param sock Socketpair endpoint the claim was made on.
+ * @param size Number of bytes written, at most the number claimed.
+ *
+ * @return 0 on success, or -1 with errno set.
+ */
+int zsock_socketpair_commit(int sock, size_t size);
+
+/**
+ * @brief Send data received on a socketpair to another socket
+ *
+ * @details
+ * Send up to @a len bytes waiting on socketpair endpoint @a in to socket
+ * @a out with zsock_sendto(), directly from the socketpair's receive
+ * buffer. Like read(), only the first chunk may block. Reads of @a in
+ * fail with EBUSY while the transfer is in progress. This function is
+ * only available to kernel threads.
+ *
+ * @param in Socketpair endpoint to read from.
+ * @param out Socket to send to.
+ * @param len Maximum number of bytes to transfer.
+ * @param flags Flags passed to zsock_sendto().
+ *
+ * @return Number of bytes transferred, 0 at end of file, or -1 with errno
+ *         set.
+ */
+ssize_t zsock_socketpair_splice(int in, int out, size_t len, int flags);
+#endif /* CONFIG_NET_SOCKETPAIR */
+
 /**
  * @brief Close a network socket
  *
@@ -396,6 +485,99 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+/**
+ * @brief Send several messages on a socket
+ *
+ * @details
+ * @rst
+ * Send the messages of ``msgvec`` one after the other like
+ * :c:func:`zsock_sendmsg` does, but with a single system call. The number
+ * of bytes sent for each message is stored in its ``msg_len`` field. See
+ * the Linux ``sendmmsg(2)`` man page for normative description.
+ * This function is also exposed as ``sendmmsg()``
+ * if :option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @return Number of messages sent, or -1 with errno set if the first one
+ *         could not be sent.
+ */
+__syscall int zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+struct fs_file_t;
+
+/**
+ * @brief Send data from a file to a connected peer
+ *
+ * @details
+ * @rst
+ * Send up to ``count`` bytes of ``file``, an open file of the file system
+ * API, like the Linux ``sendfile(2)`` does. If ``offset`` is not NULL,
+ * the data is read from ``*offset``, which is updated past the data sent,
+ * and the file position is left unchanged. Otherwise the data is read from
+ * the file position, which is updated. For TCP and UDP sockets, the data
+ * is read directly into the network buffers. Other sockets, e.g. TLS
+ * ones, go through a small intermediate buffer.
+ * Available to supervisor threads only, if
+ * :option:`CONFIG_NET_SOCKETS_SENDFILE` is defined.
+ * @endrst
+ *
+ * @return Number of bytes sent, or -1 with errno set if none could be
+ *         sent.
+ */
+ssize_t zsock_sendfile(int sock, struct fs_file_t *file, off_t *offset,
+		       size_t count);
+
+/**
+ * @brief Receive several datagrams from a socket
+ *
+ * @details
+ * @rst
+ * Receive up to ``vlen`` datagrams with a single system call. Each one is
+ * scattered over the ``msg_iov`` buffers of its message, its length is
+ * stored in ``msg_len`` and its source address in ``msg_name`` if not NULL.
+ * ``ZSOCK_MSG_TRUNC`` is set in ``msg_flags`` if the datagram did not fit.
+ * Only the first datagram is waited for, the call returns as soon as no
+ * more datagrams are queued. See the Linux ``recvmmsg(2)`` man page for
+ * normative description, the timeout argument is not supported. Only
+ * datagram sockets are supported.
+ * This function is also exposed as ``recvmmsg()``
+ * if :option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @return Number of datagrams received, or -1 with errno set if none was.
+ */
+__syscall int zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+/**
+ * @brief Receive several datagrams from a socket without copying them
+ *
+ * @details
+ * @rst
+ * Zero-copy variant of :c:func:`zsock_recvmmsg`: instead of copying the
+ * payload, the network packets holding the datagrams are handed to the
+ * caller. The cursor of each packet is set to the start of the payload, so
+ * it can be read with :c:func:`net_pkt_read` or by walking the buffer
+ * chain, and :c:func:`net_pkt_remaining_data` gives its length. The caller
+ * owns these packets and must release them with :c:func:`net_pkt_unref`
+ * as soon as possible, as they hold RX buffers of the network stack.
+ * This function is only available to supervisor threads of the kernel and
+ * to native datagram sockets.
+ * @endrst
+ *
+ * @param sock Socket to receive from.
+ * @param pkts Array receiving the packets.
+ * @param count Size of the pkts array.
+ * @param flags Only ``ZSOCK_MSG_DONTWAIT`` is supported.
+ * @param src_addrs Optional array of count addresses receiving the source
+ *        address of each packet.
+ *
+ * @return Number of packets received, or -1 with errno set if none was.
+ */
+int zsock_recv_pkts(int sock, struct net_pkt *pkts[], unsigned int count,
+		    int flags, struct sockaddr_storage *src_addrs);
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
@@ -628,6 +810,7 @@ int zsock_getnameinfo(const struct sockaddr *addr, socklen_t addrlen,
 #if defined(CONFIG_NET_SOCKETS_POSIX_NAMES)
 
 #define pollfd zsock_pollfd
+#define mmsghdr zsock_mmsghdr
 
 static inline int socket(int family, int type, int proto)
 {
@@ -702,6 +885,18 @@ static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 	return zsock_recvfrom(sock, buf, max_len, flags, src_addr, addrlen);
 }
 
+static inline int sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
+static inline int recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
 static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
 	return zsock_poll(fds, nfds, timeout);
@@ -798,6 +993,10 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 /* Socket options for SOL_SOCKET level */
 /** sockopt: Enable server address reuse */
 #define SO_REUSEADDR 2
+/** sockopt: Share the address and port with other sockets, incoming
+ * connections and datagrams being spread among them
+ */
+#define SO_REUSEPORT 15
 /** sockopt: Async error (ignored, for compatibility) */
 #define SO_ERROR 4
 #define SO_RCVTIMEO 20
@@ -860,6 +1059,90 @@ struct ifreq {
 #define SO_DFU_OFFSET 7
 #define SO_DFU_ERROR 20
 
+/* Protocol level for packet sockets. */
+#define SOL_PACKET 263
+
+/* Socket options for SOL_PACKET level */
+/** sockopt: Receive the frames in a ring, struct zsock_tpacket_req */
+#define PACKET_RX_RING 5
+/** sockopt: Receive ring statistics, struct zsock_tpacket_stats */
+#define PACKET_STATISTICS 6
+
+/**
+ * @brief Receive ring of a packet socket, option PACKET_RX_RING.
+ *
+ * There is no mmap(), so the application provides the memory of the
+ * ring: tp_frame_nr frames of tp_frame_size bytes, each starting with a
+ * struct zsock_tpacket_hdr. The stack fills the frames in order and
+ * hands each of them over by setting TP_STATUS_USER in its status. The
+ * application hands a frame back by setting its status to
+ * TP_STATUS_KERNEL. A frame received while the next frame of the ring is
+ * still owned by the application is dropped.
+ *
+ * poll() reports POLLIN when the frame before the next one the stack
+ * fills is owned by the application. The ring is set before bind() and
+ * stays in place until the socket is closed.
+ */
+struct zsock_tpacket_req {
+	/** Ring memory, aligned on TPACKET_ALIGNMENT */
+	void *tp_ring;
+	/** Size of a frame, a multiple of TPACKET_ALIGNMENT */
+	uint32_t tp_frame_size;
+	/** Number of frames */
+	uint32_t tp_frame_nr;
+};
+
+/** @brief Header of a frame of a packet socket receive ring. */
+struct zsock_tpacket_hdr {
+	/** TP_STATUS_* flags, owner of the frame */
+	atomic_t tp_status;
+	/** Length of the received frame */
+	uint32_t tp_len;
+	/** Bytes of the frame stored in the ring, up to the frame size */
+	uint32_t tp_snaplen;
+	/** Offset of the frame data from the header */
+	uint16_t tp_mac;
+	/** Index of the receiving interface */
+	uint16_t tp_ifindex;
+	/** Reception time from the driver, zero if not timestamped */
+	uint32_t tp_sec;
+	uint32_t tp_nsec;
+};
+
+/** @brief Receive ring statistics, option PACKET_STATISTICS. */
+struct zsock_tpacket_stats {
+	/** Frames stored in the ring */
+	uint32_t tp_packets;
+	/** Frames dropped because the ring was full */
+	uint32_t tp_drops;
+};
+
+/** Frame owned by the stack */
+#define TP_STATUS_KERNEL 0
+/** Frame owned by the application */
+#define TP_STATUS_USER BIT(0)
+/** Frames were dropped before this one */
+#define TP_STATUS_LOSING BIT(2)
+
+#define TPACKET_ALIGNMENT 16
+#define TPACKET_ALIGN(x) ROUND_UP(x, TPACKET_ALIGNMENT)
+#define TPACKET_HDRLEN TPACKET_ALIGN(sizeof(struct zsock_tpacket_hdr))
+
+/**
+ * @brief Get a frame of a packet socket receive ring.
+ *
+ * @param req Ring, as set with PACKET_RX_RING.
+ * @param idx Frame index, below tp_frame_nr.
+ *
+ * @return Header of the frame.
+ */
+static inline struct zsock_tpacket_hdr *zsock_tpacket_frame(
+	const struct zsock_tpacket_req *req, uint32_t idx)
+{
+	return (struct zsock_tpacket_hdr *)((uint8_t *)req->tp_ring +
+					    idx * req->tp_frame_size);
+}
+
 /** @cond INTERNAL_HIDDEN */
 /**
  * @brief Registration information for a given BSD socket family.
@@ -151,6 +151,42 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 		       enum websocket_opcode opcode, bool mask, bool final,
 		       int32_t timeout);
 
+/**
+ * @brief Queue websocket msg to be sent with the following ones.
+ *
+ * @details The frame is built and masked into a per websocket buffer. The
+ * queued frames are sent in a single TCP write when the buffer gets full,
+ * by the next websocket_send_msg() call, or by websocket_flush().
+ * Requires CONFIG_WEBSOCKET_TX_COALESCE.
+ *
+ * @param ws_sock Websocket id returned by websocket_connect().
+ * @param payload Websocket data to send.
+ * @param payload_len Length of the data to be sent.
+ * @param opcode Operation code (text, binary, ping, pong, close)
+ * @param mask Mask the data, see RFC 6455 for details
+ * @param final Is this final message for this message send, see
+ *        websocket_send_msg().
+ * @param timeout How long to try to send the queued messages if the
+ *        buffer is full. The value is in milliseconds. Value
+ *        SYS_FOREVER_MS means to wait forever.
+ *
+ * @return <0 if error, >=0 amount of bytes queued or sent
+ */
+int websocket_queue_msg(int ws_sock, const uint8_t *payload,
+			size_t payload_len, enum websocket_opcode opcode,
+			bool mask, bool final, int32_t timeout);
+
+/**
+ * @brief Send the websocket msgs queued by websocket_queue_msg().
+ *
+ * @param ws_sock Websocket id returned by websocket_connect().
+ * @param timeout How long to try to send the messages. The value is in
+ *        milliseconds. Value SYS_FOREVER_MS means to wait forever.
+ *
+ * @return 0 if ok, <0 if error
+ */
+int websocket_flush(int ws_sock, int32_t timeout);
+
 /**
  * @brief Receive websocket msg from peer.
  *
@@ -41,6 +41,12 @@ int mq_timedreceive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
 int mq_timedsend(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
 		 unsigned int msg_prio, const struct timespec *abstime);
 
+/* Zephyr extensions, exchanging messages in place */
+int mq_send_claim(mqd_t mqdes, void **msg_ptr);
+int mq_send_commit(mqd_t mqdes);
+int mq_receive_claim(mqd_t mqdes, void **msg_ptr);
+int mq_receive_release(mqd_t mqdes);
+
 #ifdef __cplusplus
 }
 #endif
@@ -9,6 +9,7 @@
 
 #include <zephyr/types.h>
 #include <stdbool.h>
+#include <sys/slist.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -214,6 +215,63 @@ bool sys_pm_ctrl_is_state_enabled(enum power_states state);
 
 #endif /* CONFIG_SYS_PM_STATE_LOCK */
 
+#ifdef CONFIG_SYS_PM_POLICY_RESIDENCY_PREDICTIVE
+/**
+ * @brief Wakeup latency constraint
+ *
+ * While requested, the policy only selects power states whose exit latency
+ * is not more than the latency of the constraint.
+ */
+struct sys_pm_latency_req {
+	sys_snode_t node;
+	uint32_t latency_us;
+};
+
+/**
+ * @brief Request or update a wakeup latency constraint
+ *
+ * @param [in] req Constraint, owned by the caller until released.
+ * @param [in] latency_us Longest acceptable exit latency in microseconds.
+ */
+void sys_pm_latency_request(struct sys_pm_latency_req *req,
+			    uint32_t latency_us);
+
+/**
+ * @brief Release a wakeup latency constraint
+ *
+ * @param [in] req Constraint given to sys_pm_latency_request().
+ */
+void sys_pm_latency_release(struct sys_pm_latency_req *req);
+
+/**
+ * @brief Residency counters of a power state
+ */
+struct sys_pm_state_stats {
+	/** Number of times the state was entered */
+	uint32_t count;
+	/** Number of wakeups before the next kernel timeout */
+	uint32_t early_wakeups;
+	/** Wakeups before the minimum residency of the state */
+	uint32_t too_deep;
+	/** Stays long enough for the next deeper enabled state */
+	uint32_t too_shallow;
+	/** Total time spent in the state, in microseconds */
+	uint64_t residency_us;
+};
+
+/**
+ * @brief Get the residency counters of a power state
+ *
+ * @param [in] state Power state.
+ * @param [out] stats Counters of the state.
+ *
+ * @retval 0 on success, -EINVAL if the state is not a low power state.
+ */
+int sys_pm_state_stats_get(enum power_states state,
+			   struct sys_pm_state_stats *stats);
+
+#endif /* CONFIG_SYS_PM_POLICY_RESIDENCY_PREDICTIVE */
+
 /**
  * @}
  */
@@ -27,6 +27,62 @@ struct k_spinlock_key {
 	int key;
 };
 
+#ifdef CONFIG_SMP
+/* Internal: take and drop the SMP lock word, local interrupts are
+ * already masked by the caller.
+ */
+static ALWAYS_INLINE void z_spin_acquire(struct k_spinlock *l)
+{
+#ifdef CONFIG_SPINLOCK_STATS
+	uint32_t spins = 0U;
+#endif
+
+#ifdef CONFIG_SPINLOCK_TICKET
+	atomic_val_t ticket = atomic_inc(&l->tail);
+
+	while (atomic_get(&l->owner) != ticket) {
+#ifdef CONFIG_SPINLOCK_STATS
+		spins++;
+#endif
+	}
+#else
+	while (!atomic_cas(&l->locked, 0, 1)) {
+#ifdef CONFIG_SPINLOCK_STATS
+		spins++;
+#endif
+	}
+#endif
+
+#ifdef CONFIG_SPINLOCK_STATS
+	/* Lock is held, plain updates are safe */
+	l->stats.acquired++;
+	if (spins != 0U) {
+		l->stats.contended++;
+		l->stats.spins += spins;
+	}
+#endif
+}
+
+static ALWAYS_INLINE void z_spin_drop(struct k_spinlock *l)
+{
+#ifdef CONFIG_SPINLOCK_TICKET
+	/* Only the holder writes owner, but the increment doubles as
+	 * the release barrier handing the lock to the next ticket.
+	 */
+	atomic_inc(&l->owner);
+#else
+	/* Strictly we don't need atomic_clear() here (which is an
+	 * exchange operation that returns the old value).  We are always
+	 * setting a zero and (because we hold the lock) know the existing
+	 * state won't change due to a race.  But some architectures need
+	 * a memory barrier when used like this, and we don't have a
+	 * Zephyr framework for that.
+	 */
+	atomic_clear(&l->locked);
+#endif
+}
+#endif /* CONFIG_SMP */
+
 /**
  * @brief Kernel Spin Lock
  *
@@ -93,8 +149,7 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 #endif
 
 #ifdef CONFIG_SMP
-	while (!atomic_cas(&l->locked, 0, 1)) {
-	}
+	z_spin_acquire(l);
 #endif
 
 #ifdef CONFIG_SPIN_VALIDATE
@@ -133,14 +188,7 @@ static ALWAYS_INLINE void k_spin_unlock(struct k_spinlock *l,
 #endif
 
 #ifdef CONFIG_SMP
-	/* Strictly we don't need atomic_clear() here (which is an
-	 * exchange operation that returns the old value).  We are always
-	 * setting a zero and (because we hold the lock) know the existing
-	 * state won't change due to a race.  But some architectures need
-	 * a memory barrier when used like this, and we don't have a
-	 * Zephyr framework for that.
-	 */
-	atomic_clear(&l->locked);
+	z_spin_drop(l);
 #endif
 	arch_irq_unlock(key.key);
 }
@@ -155,9 +203,27 @@ static ALWAYS_INLINE void k_spin_release(struct k_spinlock *l)
 	__ASSERT(z_spin_unlock_valid(l), "Not my spinlock %p", l);
 #endif
 #ifdef CONFIG_SMP
-	atomic_clear(&l->locked);
+	z_spin_drop(l);
 #endif
 }
 
+#ifdef CONFIG_SPINLOCK_STATS
+/**
+ * @brief Get the contention counters of a spin lock
+ *
+ * Copies the counters maintained for the lock when
+ * CONFIG_SPINLOCK_STATS is set.  The copy is taken without holding
+ * the lock and may be slightly out of date on a busy lock.
+ *
+ * @param l A pointer to the spinlock
+ * @param stats Structure receiving the counters
+ */
+static inline void k_spin_stats_get(struct k_spinlock *l,
+				    struct k_spinlock_stats *stats)
+{
+	*stats = *(volatile struct k_spinlock_stats *)&l->stats;
+}
+#endif
+
 
 #endif /* ZEPHYR_INCLUDE_SPINLOCK_H_ */
@@ -27,7 +27,8 @@
  * However, all statistics in a given structure must be of the same size, and
  * they are all unsigned.
  *
- * - STATS_SECT_ENTRY(): default statistic entry, 32-bits.
+ * - STATS_SECT_ENTRY(): default statistic entry, 32-bits, or 64-bits if
+ *   CONFIG_STATS_64BIT is enabled.
  *
  * - STATS_SECT_ENTRY16(): 16-bits.  Smaller statistics if you need to fit into
  *   specific RAM or code size numbers.
@@ -46,6 +47,13 @@
  *     s<stat-idx>
  *
  * E.g., "s0", "s1", etc.
+ *
+ * With CONFIG_STATS_PER_CPU, a group registered with
+ * STATS_PER_CPU_INIT_AND_REG() gets one copy of its entries per CPU, declared
+ * with STATS_PER_CPU_DECL().  STATS_INC() and STATS_INCN() then update the
+ * copy of the current CPU, so CPUs do not race or share cache lines, and
+ * stats_walk() stores the sum of the copies in the group before reporting
+ * an entry.  Entries of such groups must only be read through stats_walk().
  */
 
 #ifndef ZEPHYR_INCLUDE_STATS_STATS_H_
@@ -53,6 +61,9 @@
 
 #include <stddef.h>
 #include <zephyr/types.h>
+#ifdef CONFIG_STATS_PER_CPU
+#include <kernel_structs.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -68,6 +79,12 @@ struct stats_hdr {
 	uint8_t s_size;
 	uint16_t s_cnt;
 	uint8_t s_pad1;
+#ifdef CONFIG_STATS_PER_CPU
+	/* Per-CPU copies of the group, NULL if not per-CPU */
+	void *s_cpu;
+	/* Size of each copy */
+	uint16_t s_cpu_stride;
+#endif
 #ifdef CONFIG_STATS_NAMES
 	const struct stats_name_map *s_map;
 	int s_map_cnt;
@@ -103,11 +120,18 @@ struct stats_hdr {
 		struct stats_hdr s_hdr;
 
 /**
- * @brief Declares a 32-bit stat entry inside a group struct.
+ * @brief Declares a default size stat entry inside a group struct.
+ *
+ * The entry is 64-bit if CONFIG_STATS_64BIT is enabled, 32-bit otherwise.
+ * Its size is STATS_SIZE_DEFAULT.
  *
  * @param var__                 The name to assign to the entry.
  */
+#ifdef CONFIG_STATS_64BIT
+#define STATS_SECT_ENTRY(var__) uint64_t var__;
+#else
 #define STATS_SECT_ENTRY(var__) uint32_t var__;
+#endif
 
 /**
  * @brief Declares a 16-bit stat entry inside a group struct.
@@ -140,8 +164,24 @@ struct stats_hdr {
  * @param var__                 The statistic entry to increase.
  * @param n__                   The amount to increase the statistic entry by.
  */
+#ifdef CONFIG_STATS_PER_CPU
+#define STATS_INCN(group__, var__, n__)					\
+	do {								\
+		__typeof__(group__) *cpu__ = (group__).s_hdr.s_cpu;	\
+									\
+		if (cpu__ == NULL) {					\
+			(group__).var__ += (n__);			\
+		} else {						\
+			unsigned int key__ = arch_irq_lock();		\
+									\
+			cpu__[_current_cpu->id].var__ += (n__);		\
+			arch_irq_unlock(key__);				\
+		}							\
+	} while (false)
+#else
 #define STATS_INCN(group__, var__, n__)	\
 	((group__).var__ += (n__))
+#endif
 
 /**
  * @brief Increments a statistic entry.
@@ -164,13 +204,33 @@ struct stats_hdr {
  * @param group__               The group containing the entry to clear.
  * @param var__                 The statistic entry to clear.
  */
+#ifdef CONFIG_STATS_PER_CPU
+#define STATS_CLEAR(group__, var__)					\
+	do {								\
+		__typeof__(group__) *cpu__ = (group__).s_hdr.s_cpu;	\
+									\
+		(group__).var__ = 0;					\
+		for (int i__ = 0; (cpu__ != NULL) &&			\
+				  (i__ < CONFIG_MP_NUM_CPUS); i__++) {	\
+			cpu__[i__].var__ = 0;				\
+		}							\
+	} while (false)
+#else
 #define STATS_CLEAR(group__, var__) \
 	((group__).var__ = 0)
+#endif
 
 #define STATS_SIZE_16 (sizeof(uint16_t))
 #define STATS_SIZE_32 (sizeof(uint32_t))
 #define STATS_SIZE_64 (sizeof(uint64_t))
 
+/** Size of the entries declared with STATS_SECT_ENTRY(). */
+#ifdef CONFIG_STATS_64BIT
+#define STATS_SIZE_DEFAULT STATS_SIZE_64
+#else
+#define STATS_SIZE_DEFAULT STATS_SIZE_32
+#endif
+
 #define STATS_SIZE_INIT_PARMS(group__, size__) \
 	(size__),			       \
 	((sizeof(group__)) - sizeof(struct stats_hdr)) / (size__)
@@ -197,6 +257,69 @@ struct stats_hdr {
 		STATS_NAME_INIT_PARMS(group__),				 \
 		(name__))
 
+#ifdef CONFIG_STATS_PER_CPU
+/**
+ * @brief Declares the per-CPU copies of a statistics group.
+ *
+ * @param sectname__            The stats group struct name.
+ * @param group__               The statistics group.
+ */
+#define STATS_PER_CPU_DECL(sectname__, group__)				\
+	static STATS_SECT_DECL(sectname__)				\
+		group__ ## _per_cpu[CONFIG_MP_NUM_CPUS]
+
+/**
+ * @brief Initializes and registers a per-CPU statistics group.
+ *
+ * The per-CPU copies must have been declared with STATS_PER_CPU_DECL().
+ *
+ * @param group__               The statistics group to initialize and
+ *                                  register.
+ * @param size__                The size of each entry in the statistics group,
+ *                                  in bytes.  Must be one of: 2 (16-bits), 4
+ *                                  (32-bits) or 8 (64-bits).
+ * @param name__                The name of the statistics group to register.
+ *                                  This name must be unique among all
+ *                                  statistics groups.
+ *
+ * @return                      0 on success; negative error code on failure.
+ */
+#define STATS_PER_CPU_INIT_AND_REG(group__, size__, name__)		 \
+	stats_per_cpu_init_and_reg(					 \
+		&(group__).s_hdr,					 \
+		&(group__ ## _per_cpu)[0].s_hdr,			 \
+		sizeof(group__),					 \
+		(size__),						 \
+		(sizeof(group__) - sizeof(struct stats_hdr)) / (size__), \
+		STATS_NAME_INIT_PARMS(group__),				 \
+		(name__))
+
+/**
+ * @brief Initializes and registers a per-CPU statistics group.
+ *
+ * Note: it is recommended to use the STATS_PER_CPU_INIT_AND_REG macro
+ * instead of this function.
+ *
+ * @param hdr                   The header of the statistics group.
+ * @param cpu_hdr               The header of the first of the
+ *                                  CONFIG_MP_NUM_CPUS copies of the group.
+ * @param stride                The size of the statistics group struct.
+ *
+ * See stats_init_and_reg() for the other parameters.
+ *
+ * @return                      0 on success; negative error code on failure.
+ */
+int stats_per_cpu_init_and_reg(struct stats_hdr *hdr,
+			       struct stats_hdr *cpu_hdr, size_t stride,
+			       uint8_t size, uint16_t cnt,
+			       const struct stats_name_map *map,
+			       uint16_t map_cnt, const char *name);
+#else
+#define STATS_PER_CPU_DECL(sectname__, group__)
+#define STATS_PER_CPU_INIT_AND_REG(group__, size__, name__)	\
+	STATS_INIT_AND_REG(group__, size__, name__)
+#endif /* CONFIG_STATS_PER_CPU */
+
 /**
  * @brief Initializes a statistics group.
  *
@@ -345,6 +468,8 @@ struct stats_hdr *stats_group_find(const char *name);
 #define STATS_SECT_ENTRY16(var__)
 #define STATS_SECT_ENTRY32(var__)
 #define STATS_SECT_ENTRY64(var__)
+#define STATS_PER_CPU_DECL(sectname__, group__)
+#define STATS_PER_CPU_INIT_AND_REG(group__, size__, name__) (0)
 #define STATS_RESET(var__)
 #define STATS_SIZE_INIT_PARMS(group__, size__)
 #define STATS_INCN(group__, var__, n__)
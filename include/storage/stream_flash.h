@@ -21,7 +21,12 @@
  */
 
 #include <stdbool.h>
+#include <kernel.h>
 #include <drivers/flash.h>
+#ifdef CONFIG_STREAM_FLASH_SHA256
+#include <tinycrypt/sha256.h>
+#include <tinycrypt/constants.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -62,6 +67,18 @@ struct stream_flash_ctx {
 #ifdef CONFIG_STREAM_FLASH_ERASE
 	off_t last_erased_page_start_offset; /* Last erased offset */
 #endif
+#ifdef CONFIG_STREAM_FLASH_DOUBLE_BUFFER
+	uint8_t *buf2; /* Other write buffer, NULL if not double buffered */
+	struct k_work work; /* Programs sync_buf */
+	struct k_sem idle; /* Available when no buffer is being programmed */
+	uint8_t *sync_buf; /* Buffer being programmed */
+	size_t sync_len; /* Number of bytes being programmed */
+	size_t sync_addr; /* Offset the buffer is programmed to */
+	int sync_rc; /* Result of the last program */
+#endif
+#ifdef CONFIG_STREAM_FLASH_SHA256
+	struct tc_sha256_state_struct sha256; /* Hash of the data written */
+#endif
 };
 
 /**
@@ -83,6 +100,25 @@ struct stream_flash_ctx {
 int stream_flash_init(struct stream_flash_ctx *ctx, struct device *fdev,
 		      uint8_t *buf, size_t buf_len, size_t offset, size_t size,
 		      stream_flash_callback_t cb);
+
+#ifdef CONFIG_STREAM_FLASH_DOUBLE_BUFFER
+/**
+ * @brief Program the flash in the background.
+ *
+ * Must be called right after stream_flash_init(). The write buffer and
+ * @a buf2 then take turns: a filled buffer is erased, programmed and
+ * verified by a work queue while the other one is filled, and the page of
+ * the next buffer is erased ahead. The callback is invoked from the work
+ * queue.
+ *
+ * @param ctx context
+ * @param buf2 Second write buffer, of the length given to stream_flash_init()
+ *
+ * @return non-negative on success, negative errno code on fail
+ */
+int stream_flash_double_buffer_set(struct stream_flash_ctx *ctx,
+				   uint8_t *buf2);
+#endif
 /**
  * @brief Read number of bytes written to the flash.
  *
@@ -108,12 +144,75 @@ size_t stream_flash_bytes_written(struct stream_flash_ctx *ctx);
  *        A flush write should be the last write operation in a sequence of
  *        write operations for given context (although this is not mandatory
  *        if the total data size is a multiple of the buffer size).
+ *        With double buffering, it also waits for the data to be programmed,
+ *        and an error programming a buffer may only be reported by a later
+ *        call.
  *
  * @return non-negative on success, negative errno code on fail
  */
 int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *data,
 				size_t len, bool flush);
 
+#ifdef CONFIG_STREAM_FLASH_SHA256
+/**
+ * @brief Get the SHA-256 hash of the data written so far.
+ *
+ * The hash covers the data passed to stream_flash_buffered_write(), without
+ * the padding of the last write, so that an image can be verified without
+ * reading it back. Writing can go on after this call.
+ *
+ * @param ctx context
+ * @param digest Buffer receiving the hash
+ *
+ * @return non-negative on success, negative errno code on fail
+ */
+int stream_flash_sha256_get(struct stream_flash_ctx *ctx,
+			    uint8_t digest[TC_SHA256_DIGEST_SIZE]);
+#endif
+
+#ifdef CONFIG_STREAM_FLASH_PROGRESS
+/**
+ * @brief Restore the write progress saved with stream_flash_progress_save().
+ *
+ * Must be called right after stream_flash_init(). Writing then continues
+ * after the bytes written when the progress was saved. Nothing is restored
+ * when no progress was saved.
+ *
+ * @param ctx context
+ * @param settings_key key the progress was saved under
+ *
+ * @return non-negative on success, negative errno code on fail
+ */
+int stream_flash_progress_load(struct stream_flash_ctx *ctx,
+			       const char *settings_key);
+
+/**
+ * @brief Save the number of bytes written in the settings.
+ *
+ * Data still in the write buffer is not accounted, so the caller should
+ * save the progress when stream_flash_bytes_written() matches the data it
+ * passed in, or be ready to pass the difference in again after a restore.
+ *
+ * @param ctx context
+ * @param settings_key key to save the progress under
+ *
+ * @return non-negative on success, negative errno code on fail
+ */
+int stream_flash_progress_save(struct stream_flash_ctx *ctx,
+			       const char *settings_key);
+
+/**
+ * @brief Delete the progress saved with stream_flash_progress_save().
+ *
+ * @param ctx context
+ * @param settings_key key the progress was saved under
+ *
+ * @return non-negative on success, negative errno code on fail
+ */
+int stream_flash_progress_clear(struct stream_flash_ctx *ctx,
+				const char *settings_key);
+#endif
+
 /**
  * @brief Erase the flash page to which a given offset belongs.
  *
@@ -268,6 +268,15 @@ void arch_irq_enable(unsigned int irq);
  */
 int arch_irq_is_enabled(unsigned int irq);
 
+#ifdef CONFIG_ARCH_HAS_IRQ_AFFINITY
+/**
+ * Route the specified interrupt line to a set of CPUs
+ *
+ * @see irq_set_affinity()
+ */
+int arch_irq_set_affinity(unsigned int irq, uint32_t cpu_mask);
+#endif
+
 /**
  * Arch-specific hook to install a dynamic interrupt.
  *
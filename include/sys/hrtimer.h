@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief High resolution timers
+ *
+ * Timers expiring with the resolution of a counter device, independently
+ * of the system tick rate. Their handlers run in the interrupt context
+ * of the counter alarm.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_HRTIMER_H_
+#define ZEPHYR_INCLUDE_SYS_HRTIMER_H_
+
+#include <zephyr/types.h>
+#include <sys/dlist.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct sys_hrtimer;
+
+/**
+ * @brief High resolution timer expiry handler
+ *
+ * Called from the counter interrupt. The handler may start or stop any
+ * high resolution timer, including its own.
+ *
+ * @param timer Expired timer.
+ */
+typedef void (*sys_hrtimer_handler_t)(struct sys_hrtimer *timer);
+
+/** @brief High resolution timer */
+struct sys_hrtimer {
+	sys_dnode_t node;
+	sys_hrtimer_handler_t handler;
+	void *user_data;
+	/* Expiry and period in counter ticks */
+	uint64_t expiry;
+	uint64_t period;
+};
+
+/**
+ * @brief Initialize a high resolution timer.
+ *
+ * @param timer Timer.
+ * @param handler Expiry handler, or NULL.
+ * @param user_data Data for the handler.
+ */
+void sys_hrtimer_init(struct sys_hrtimer *timer,
+		      sys_hrtimer_handler_t handler, void *user_data);
+
+/**
+ * @brief Start or restart a high resolution timer.
+ *
+ * @param timer Timer.
+ * @param delay_ns Time to the first expiry, in nanoseconds.
+ * @param period_ns Time between the following expiries, in nanoseconds,
+ *		    0 for a one shot timer.
+ *
+ * @retval 0 on success.
+ * @retval -ENODEV if no counter backs the timers.
+ */
+int sys_hrtimer_start(struct sys_hrtimer *timer, uint64_t delay_ns,
+		      uint64_t period_ns);
+
+/**
+ * @brief Stop a high resolution timer.
+ *
+ * @param timer Timer.
+ */
+void sys_hrtimer_stop(struct sys_hrtimer *timer);
+
+/**
+ * @brief Get the time left to the next expiry of a timer.
+ *
+ * @param timer Timer.
+ *
+ * @return Time in nanoseconds, 0 if the timer is stopped.
+ */
+uint64_t sys_hrtimer_remaining_ns(struct sys_hrtimer *timer);
+
+/**
+ * @brief Sleep with the resolution of the high resolution timers.
+ *
+ * @param ns Time to sleep, in nanoseconds.
+ *
+ * @retval 0 on success.
+ * @retval -ENODEV if no counter backs the timers.
+ */
+int sys_hrtimer_sleep_ns(uint64_t ns);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_HRTIMER_H_ */
@@ -0,0 +1,204 @@
+/* mpsc_pbuf.h: Multi producer, single consumer packet buffer */
+
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/** @file */
+
+#ifndef ZEPHYR_INCLUDE_SYS_MPSC_PBUF_H_
+#define ZEPHYR_INCLUDE_SYS_MPSC_PBUF_H_
+
+#include <zephyr/types.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <sys/atomic.h>
+#include <sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup mpsc_pbuf_apis Multi producer, single consumer packet buffer APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/** Drop the oldest packets to make room when the buffer is full. */
+#define MPSC_PBUF_MODE_OVERWRITE BIT(0)
+
+/** Space taken in the buffer by a packet of @a len bytes, in bytes. */
+#define MPSC_PBUF_PACKET_SIZE(len) \
+	(sizeof(uint32_t) * (1 + ceiling_fraction(len, sizeof(uint32_t))))
+
+struct mpsc_pbuf_buffer;
+
+/**
+ * @typedef mpsc_pbuf_drop_t
+ * @brief Callback for a committed packet dropped to make room.
+ *
+ * Called in the context of the allocating producer, possibly an ISR,
+ * before the space of the packet is reused.
+ *
+ * @param buffer Packet buffer.
+ * @param packet Dropped packet.
+ * @param len Length of the packet in bytes.
+ */
+typedef void (*mpsc_pbuf_drop_t)(struct mpsc_pbuf_buffer *buffer,
+				 void *packet, size_t len);
+
+/**
+ * @brief A multi producer, single consumer packet buffer.
+ *
+ * Packets of variable length are stored contiguously in a circular buffer
+ * of 32-bit words, each one preceded by a one word header. Producers,
+ * including ISRs, allocate and commit packets without taking any lock;
+ * the packets are then claimed in allocation order by a single consumer.
+ * Claimed packets may be freed in any order and from any context, their
+ * space is given back once all the older packets are freed as well.
+ */
+struct mpsc_pbuf_buffer {
+	uint32_t *buf;      /**< Memory region for stored packets */
+	uint32_t size;      /**< Size of buf in 32-bit words, a power of 2 */
+	uint32_t flags;     /**< MPSC_PBUF_MODE_* flags */
+	mpsc_pbuf_drop_t drop; /**< Called for dropped packets, or NULL */
+	atomic_t wr_idx;    /**< Free running index of the next allocation */
+	atomic_t claim_idx; /**< Free running index of the next claim */
+	atomic_t rd_idx;    /**< Free running index of the oldest packet */
+	atomic_t dropped;   /**< Number of packets dropped or not allocated */
+};
+
+/**
+ * @brief Statically define and initialize a packet buffer.
+ *
+ * @param name Name of the packet buffer.
+ * @param pow Packet buffer size exponent, the buffer holds 2^pow words.
+ * @param mode MPSC_PBUF_MODE_* flags.
+ * @param drop_cb Callback for dropped packets, or NULL.
+ */
+#define MPSC_PBUF_DEFINE(name, pow, mode, drop_cb) \
+	static uint32_t _mpsc_pbuf_data_##name[BIT(pow)]; \
+	struct mpsc_pbuf_buffer name = { \
+		.buf = _mpsc_pbuf_data_##name, \
+		.size = BIT(pow), \
+		.flags = (mode), \
+		.drop = (drop_cb), \
+	}
+
+/**
+ * @brief Initialize a packet buffer.
+ *
+ * @param buffer Packet buffer.
+ * @param data Memory region, zero initialized by this function.
+ * @param size Size of @a data in 32-bit words, must be a power of 2.
+ * @param mode MPSC_PBUF_MODE_* flags.
+ * @param drop Callback for dropped packets, or NULL.
+ */
+void mpsc_pbuf_init(struct mpsc_pbuf_buffer *buffer, uint32_t *data,
+		    uint32_t size, uint32_t mode, mpsc_pbuf_drop_t drop);
+
+/**
+ * @brief Allocate a packet.
+ *
+ * May be called from any context, concurrently with other producers and
+ * the consumer. The packet is not seen by the consumer until committed.
+ *
+ * When the buffer is full and MPSC_PBUF_MODE_OVERWRITE is set, the oldest
+ * committed packets are dropped to make room. Packets being claimed by the
+ * consumer or not yet committed are never dropped, the allocation fails
+ * instead.
+ *
+ * @param buffer Packet buffer.
+ * @param len Length of the packet in bytes.
+ *
+ * @return Pointer to the word aligned packet, or NULL if there is no room.
+ */
+void *mpsc_pbuf_alloc(struct mpsc_pbuf_buffer *buffer, size_t len);
+
+/**
+ * @brief Commit a packet, making it available to the consumer.
+ *
+ * @param buffer Packet buffer.
+ * @param packet Packet returned by mpsc_pbuf_alloc().
+ */
+void mpsc_pbuf_commit(struct mpsc_pbuf_buffer *buffer, void *packet);
+
+/**
+ * @brief Claim the oldest committed packet.
+ *
+ * Only called by the consumer. Packets are only handed out in allocation
+ * order, so an older packet still being written by its producer holds back
+ * the ones committed after it. Several packets may be claimed at a time.
+ *
+ * @param buffer Packet buffer.
+ * @param len Set to the length of the packet in bytes.
+ *
+ * @return Pointer to the packet, or NULL if there is none ready.
+ */
+void *mpsc_pbuf_claim(struct mpsc_pbuf_buffer *buffer, size_t *len);
+
+/**
+ * @brief Free a packet.
+ *
+ * May be called from any context, for a claimed packet or for one which
+ * was allocated but not committed, which is then never claimed.
+ *
+ * @param buffer Packet buffer.
+ * @param packet Packet returned by mpsc_pbuf_claim() or mpsc_pbuf_alloc().
+ */
+void mpsc_pbuf_free(struct mpsc_pbuf_buffer *buffer, const void *packet);
+
+/**
+ * @brief Check if a committed packet is ready to be claimed.
+ *
+ * @param buffer Packet buffer.
+ *
+ * @return true if mpsc_pbuf_claim() has a packet to hand out, or padding
+ *	   to skip.
+ */
+bool mpsc_pbuf_is_pending(struct mpsc_pbuf_buffer *buffer);
+
+/**
+ * @brief Get the space used in the buffer.
+ *
+ * Freed packets are included until their space is given back.
+ *
+ * @param buffer Packet buffer.
+ *
+ * @return Used space in bytes.
+ */
+static inline uint32_t mpsc_pbuf_used_get(struct mpsc_pbuf_buffer *buffer)
+{
+	return sizeof(uint32_t) * ((uint32_t)atomic_get(&buffer->wr_idx) -
+				   (uint32_t)atomic_get(&buffer->rd_idx));
+}
+
+/**
+ * @brief Get the number of packets dropped or not allocated.
+ *
+ * @param buffer Packet buffer.
+ * @param reset Reset the count after reading it.
+ *
+ * @return Number of packets lost since the last reset.
+ */
+static inline uint32_t mpsc_pbuf_dropped_get(struct mpsc_pbuf_buffer *buffer,
+					     bool reset)
+{
+	if (reset) {
+		return (uint32_t)atomic_set(&buffer->dropped, 0);
+	}
+
+	return (uint32_t)atomic_get(&buffer->dropped);
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_MPSC_PBUF_H_ */
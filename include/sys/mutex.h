@@ -11,24 +11,56 @@
  * sys_mutex behaves almost exactly like k_mutex, with the added advantage
  * that a sys_mutex instance can reside in user memory.
  *
- * Further enhancements will support locking/unlocking uncontended sys_mutexes
- * with simple atomic ops instead of syscalls, similar to Linux's
- * FUTEX_LOCK_PI and FUTEX_UNLOCK_PI
+ * With CONFIG_SYS_MUTEX_FAST_PATH, uncontended sys_mutexes are locked and
+ * unlocked with atomic ops on the mutex memory, similar to Linux's
+ * FUTEX_LOCK_PI and FUTEX_UNLOCK_PI. The kernel is only entered when a
+ * thread has to wait, it then hands the ownership over to the backing
+ * k_mutex so that priority inheritance applies as with a k_mutex.
  */
 
 #ifdef CONFIG_USERSPACE
 #include <sys/atomic.h>
 #include <zephyr/types.h>
 #include <sys_clock.h>
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+#include <errno.h>
+#include <kernel.h>
+#endif
 
 struct sys_mutex {
-	/* Currently unused, but will be used to store state for fast mutexes
-	 * that can be locked/unlocked with atomic ops if there is no
-	 * contention
+	/* With CONFIG_SYS_MUTEX_FAST_PATH, the owner thread ID, or 0 if the
+	 * mutex is unlocked, ORed with SYS_MUTEX_CONTENDED once the kernel
+	 * manages the ownership. Unused otherwise.
 	 */
 	atomic_t val;
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	/* Lock count, only changed by the owner */
+	uint32_t lock_count;
+#endif
 };
 
+/** @cond INTERNAL_HIDDEN */
+#define SYS_MUTEX_CONTENDED BIT(0)
+
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+#ifndef CONFIG_SMP
+/* ID of the running thread, set on every context switch and readable by
+ * threads that have z_libc_partition in their memory domain.
+ */
+extern atomic_val_t z_sys_mutex_self;
+#endif
+
+static inline atomic_val_t z_sys_mutex_current(void)
+{
+#ifdef CONFIG_SMP
+	return (atomic_val_t)k_current_get();
+#else
+	return *(volatile atomic_val_t *)&z_sys_mutex_self;
+#endif
+}
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
+/** @endcond */
+
 #define SYS_MUTEX_DEFINE(name) \
 	struct sys_mutex name
 
@@ -70,6 +102,12 @@ __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
  * A thread is permitted to lock a mutex it has already locked. The operation
  * completes immediately and the lock count is increased by 1.
  *
+ * With CONFIG_SYS_MUTEX_FAST_PATH, the mutex memory is accessed before
+ * the kernel validates it: an address the caller has no access to faults
+ * instead of returning -EACCES, and memory that is not a sys_mutex may be
+ * taken for an unlocked one instead of returning -EINVAL. Only a NULL
+ * @a mutex is always reported.
+ *
  * @param mutex Address of the mutex, which may reside in user memory
  * @param timeout Waiting period to lock the mutex,
  *                or one of the special values K_NO_WAIT and K_FOREVER.
@@ -77,13 +115,37 @@ __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
  * @retval 0 Mutex locked.
  * @retval -EBUSY Returned without waiting.
  * @retval -EAGAIN Waiting period timed out.
- * @retval -EACCESS Caller has no access to provided mutex address
+ * @retval -EACCES Caller has no access to provided mutex address
  * @retval -EINVAL Provided mutex not recognized by the kernel
  */
 static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 {
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	atomic_val_t self = z_sys_mutex_current();
+	int ret;
+
+	if (mutex != NULL) {
+		if (atomic_cas(&mutex->val, 0, self)) {
+			mutex->lock_count = 1U;
+			return 0;
+		}
+
+		if ((atomic_get(&mutex->val) & ~SYS_MUTEX_CONTENDED) == self) {
+			mutex->lock_count++;
+			return 0;
+		}
+	}
+
+	ret = z_sys_mutex_kernel_lock(mutex, timeout);
+	if (ret == 0) {
+		mutex->lock_count = 1U;
+	}
+
+	return ret;
+#else
 	/* For now, make the syscall unconditionally */
 	return z_sys_mutex_kernel_lock(mutex, timeout);
+#endif
 }
 
 /**
@@ -96,16 +158,43 @@ static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
  * the calling thread as many times as it was previously locked by that
  * thread.
  *
+ * With CONFIG_SYS_MUTEX_FAST_PATH, an address the caller has no access to
+ * faults instead of returning -EACCES, see sys_mutex_lock().
+ *
  * @param mutex Address of the mutex, which may reside in user memory
- * @retval -EACCESS Caller has no access to provided mutex address
+ * @retval 0 Mutex unlocked.
+ * @retval -EACCES Caller has no access to provided mutex address
  * @retval -EINVAL Provided mutex not recognized by the kernel or mutex wasn't
  *                 locked
  * @retval -EPERM Caller does not own the mutex
  */
 static inline int sys_mutex_unlock(struct sys_mutex *mutex)
 {
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	atomic_val_t self = z_sys_mutex_current();
+
+	if ((mutex != NULL) &&
+	    (atomic_get(&mutex->val) & ~SYS_MUTEX_CONTENDED) == self) {
+		if (mutex->lock_count > 1U) {
+			mutex->lock_count--;
+			return 0;
+		}
+
+		mutex->lock_count = 0U;
+
+		if (atomic_cas(&mutex->val, self, 0)) {
+			return 0;
+		}
+	}
+
+	/* Contended, the kernel hands the mutex over to a waiter, or not
+	 * owned, the kernel reports the error.
+	 */
+	return z_sys_mutex_kernel_unlock(mutex);
+#else
 	/* For now, make the syscall unconditionally */
 	return z_sys_mutex_kernel_unlock(mutex);
+#endif
 }
 
 #include <syscalls/mutex.h>
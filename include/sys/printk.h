@@ -68,6 +68,88 @@ extern __printf_like(3, 0) int vsnprintk(char *str, size_t size,
 extern __printf_like(3, 0) void z_vprintk(int (*out)(int f, void *c), void *ctx,
 					 const char *fmt, va_list ap);
 
+/**
+ * @brief Package a formatted message for rendering later.
+ *
+ * Captures the format string pointer and the raw argument values in a
+ * compact, self-describing package instead of formatting the message.
+ * Strings that do not live in read-only memory are copied into the
+ * package, so it stays valid after the caller's buffers go away. The
+ * format string itself must remain valid until the package is rendered.
+ *
+ * The package holds no pointers into itself and needs no particular
+ * alignment, so it may be copied freely, e.g. into a ring buffer.
+ *
+ * Only the conversions understood by printk() are supported.
+ *
+ * @param packaged Buffer for the package, or NULL to only compute the
+ *        size it would take.
+ * @param len Size of @a packaged in bytes.
+ * @param fmt Format string.
+ * @param ap Format arguments.
+ *
+ * @return Size of the package in bytes, -ENOSPC if it does not fit in
+ *         @a len bytes, or -EINVAL if more than 32 strings would have to
+ *         be copied.
+ */
+extern __printf_like(3, 0) int printk_vpackage(void *packaged, size_t len,
+					       const char *fmt, va_list ap);
+
+/**
+ * @brief Package a formatted message for rendering later.
+ *
+ * See printk_vpackage().
+ */
+extern __printf_like(3, 4) int printk_package(void *packaged, size_t len,
+					      const char *fmt, ...);
+
+/**
+ * @brief Get the size of a package built by printk_package().
+ *
+ * @param packaged Package.
+ *
+ * @return Size of the package in bytes.
+ */
+extern size_t printk_package_len(const void *packaged);
+
+/**
+ * @brief Format a package built by printk_package().
+ *
+ * @param out Character output function.
+ * @param ctx Context passed to @a out.
+ * @param packaged Package.
+ */
+extern void printk_package_render(int (*out)(int c, void *ctx), void *ctx,
+				  const void *packaged);
+
+/**
+ * @brief Format a package built by printk_package() into a string.
+ *
+ * Behaves like snprintk() given the package's format and arguments.
+ *
+ * @param str Output buffer.
+ * @param size Size of @a str in bytes.
+ * @param packaged Package.
+ *
+ * @return Length of the formatted string, not counting the terminator.
+ */
+extern int snprintk_package(char *str, size_t size, const void *packaged);
+
+/**
+ * @brief Flush deferred printk() output and stop deferring it.
+ *
+ * With CONFIG_PRINTK_DEFERRED, prints all queued messages from the calling
+ * context and makes later printk() calls output immediately. Called when
+ * the system encounters a fatal error.
+ */
+#ifdef CONFIG_PRINTK_DEFERRED
+extern void printk_deferred_panic(void);
+#else
+static inline void printk_deferred_panic(void)
+{
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
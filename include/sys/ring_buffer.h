@@ -21,6 +21,10 @@ extern "C" {
 
 #define SIZE32_OF(x) (sizeof((x))/sizeof(uint32_t))
 
+/* Modulo mask of a compile-time ring buffer size, 0 if not a power of 2 */
+#define Z_RING_BUF_MASK(size) \
+	((((size) & ((size) - 1)) == 0U) ? ((size) - 1) : 0U)
+
 /**
  * @brief A structure to represent a ring buffer
  */
@@ -124,7 +128,8 @@ struct ring_buf {
 	static uint8_t _ring_buffer_data_##name[size8]; \
 	struct ring_buf name = { \
 		.size = size8, \
-		.buf = { .buf8 = _ring_buffer_data_##name} \
+		.buf = { .buf8 = _ring_buffer_data_##name}, \
+		.mask = Z_RING_BUF_MASK(size8) \
 	}
 
 
@@ -156,6 +161,50 @@ static inline void ring_buf_init(struct ring_buf *buf, uint32_t size, void *data
 	}
 }
 
+/** @brief Read an index owned by the other side of a ring buffer.
+ *
+ * @note Function for internal use.
+ *
+ * The producer owns @a tail and the consumer owns @a head. Reading the
+ * other side's index with acquire semantics guarantees the data (or free
+ * space) it covers is visible before it is used.
+ *
+ * @param idx Address of the index.
+ *
+ * @return Index value.
+ */
+static inline uint32_t z_ring_buf_idx_get(const uint32_t *idx)
+{
+#ifdef CONFIG_SMP
+	return __atomic_load_n(idx, __ATOMIC_ACQUIRE);
+#else
+	uint32_t val = *(const volatile uint32_t *)idx;
+
+	compiler_barrier();
+	return val;
+#endif
+}
+
+/** @brief Publish an index to the other side of a ring buffer.
+ *
+ * @note Function for internal use.
+ *
+ * Stores @a val with release semantics, so the data written (or read)
+ * before is complete when the other side sees the new index.
+ *
+ * @param idx Address of the index.
+ * @param val New index value.
+ */
+static inline void z_ring_buf_idx_set(uint32_t *idx, uint32_t val)
+{
+#ifdef CONFIG_SMP
+	__atomic_store_n(idx, val, __ATOMIC_RELEASE);
+#else
+	compiler_barrier();
+	*(volatile uint32_t *)idx = val;
+#endif
+}
+
 /** @brief Determine free space based on ring buffer parameters.
  *
  * @note Function for internal use.
@@ -186,7 +235,8 @@ static inline uint32_t z_ring_buf_custom_space_get(uint32_t size, uint32_t head,
  */
 static inline int ring_buf_is_empty(struct ring_buf *buf)
 {
-	return (buf->head == buf->tail);
+	return (z_ring_buf_idx_get(&buf->head) ==
+		z_ring_buf_idx_get(&buf->tail));
 }
 
 /**
@@ -210,7 +260,9 @@ static inline void ring_buf_reset(struct ring_buf *buf)
  */
 static inline uint32_t ring_buf_space_get(struct ring_buf *buf)
 {
-	return z_ring_buf_custom_space_get(buf->size, buf->head, buf->tail);
+	return z_ring_buf_custom_space_get(buf->size,
+					   z_ring_buf_idx_get(&buf->head),
+					   z_ring_buf_idx_get(&buf->tail));
 }
 
 /**
@@ -287,7 +339,9 @@ int ring_buf_item_get(struct ring_buf *buf, uint16_t *type, uint8_t *value,
  * @warning
  * Use cases involving multiple writers to the ring buffer must prevent
  * concurrent write operations, either by preventing all writers from
- * being preempted or by using a mutex to govern writes to the ring buffer.
+ * being preempted or by using a mutex to govern writes to the ring buffer,
+ * or use @ref ring_buf_mp_put_claim. One writer and one reader need no
+ * locking.
  *
  * @warning
  * Ring buffer instance should not mix byte access and item access
@@ -355,7 +409,9 @@ uint32_t ring_buf_put(struct ring_buf *buf, const uint8_t *data, uint32_t size);
  * @warning
  * Use cases involving multiple reads of the ring buffer must prevent
  * concurrent read operations, either by preventing all readers from
- * being preempted or by using a mutex to govern reads to the ring buffer.
+ * being preempted or by using a mutex to govern reads to the ring buffer,
+ * or use @ref ring_buf_mc_get_claim. One writer and one reader need no
+ * locking.
  *
  * @warning
  * Ring buffer instance should not mix byte access and item access
@@ -413,6 +469,101 @@ int ring_buf_get_finish(struct ring_buf *buf, uint32_t size);
  */
 uint32_t ring_buf_get(struct ring_buf *buf, uint8_t *data, uint32_t size);
 
+/**
+ * @brief Allocate buffer for writing data, safe against other writers.
+ *
+ * This routine works like @ref ring_buf_put_claim but several writers can
+ * call it concurrently, from threads, ISRs or other CPUs, without a lock.
+ * Each claim must be completed with @ref ring_buf_mp_put_finish. Data
+ * becomes visible to the reader once every claim made before it is
+ * finished as well. The ring buffer must be smaller than 16 MiB.
+ *
+ * @warning
+ * Writers of a ring buffer instance must either all use the ring_buf_mp_
+ * calls or all use the single writer calls. The reader can use either
+ * @ref ring_buf_get_claim or @ref ring_buf_mc_get_claim.
+ *
+ * @warning
+ * Ring buffer instance should not mix byte access and item access
+ * (calls prefixed with ring_buf_item_).
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] data Pointer to the address. It is set to a location within
+ *		    ring buffer.
+ * @param[in]  size Requested allocation size (in bytes).
+ *
+ * @return Size of allocated buffer which can be smaller than requested if
+ *	   there is not enough free space or buffer wraps.
+ */
+uint32_t ring_buf_mp_put_claim(struct ring_buf *buf, uint8_t **data,
+			       uint32_t size);
+
+/**
+ * @brief Indicate that a buffer claimed for writing is filled.
+ *
+ * The whole claimed size is committed: other writers may have claimed
+ * the space behind it, so it cannot be handed back.
+ *
+ * @param buf Address of ring buffer.
+ */
+void ring_buf_mp_put_finish(struct ring_buf *buf);
+
+/**
+ * @brief Write (copy) data to a ring buffer, safe against other writers.
+ *
+ * @param buf Address of ring buffer.
+ * @param data Address of data.
+ * @param size Data size (in bytes).
+ *
+ * @retval Number of bytes written.
+ */
+uint32_t ring_buf_mp_put(struct ring_buf *buf, const uint8_t *data,
+			 uint32_t size);
+
+/**
+ * @brief Get address of valid data, safe against other readers.
+ *
+ * This routine works like @ref ring_buf_get_claim but several readers can
+ * call it concurrently without a lock. Each claim must be completed with
+ * @ref ring_buf_mc_get_finish. The space is given back to the writer
+ * once every claim made before it is finished as well. The ring buffer
+ * must be smaller than 16 MiB.
+ *
+ * @warning
+ * Readers of a ring buffer instance must either all use the ring_buf_mc_
+ * calls or all use the single reader calls.
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] data Pointer to the address. It is set to a location within
+ *		    ring buffer.
+ * @param[in]  size Requested size (in bytes).
+ *
+ * @return Number of valid bytes in the provided buffer which can be smaller
+ *	   than requested if there is not enough data or buffer wraps.
+ */
+uint32_t ring_buf_mc_get_claim(struct ring_buf *buf, uint8_t **data,
+			       uint32_t size);
+
+/**
+ * @brief Indicate that a buffer claimed for reading is processed.
+ *
+ * The whole claimed size is freed.
+ *
+ * @param buf Address of ring buffer.
+ */
+void ring_buf_mc_get_finish(struct ring_buf *buf);
+
+/**
+ * @brief Read data from a ring buffer, safe against other readers.
+ *
+ * @param buf  Address of ring buffer.
+ * @param data Address of the output buffer.
+ * @param size Data size (in bytes).
+ *
+ * @retval Number of bytes written to the output buffer.
+ */
+uint32_t ring_buf_mc_get(struct ring_buf *buf, uint8_t *data, uint32_t size);
+
 /**
  * @}
  */
@@ -87,6 +87,41 @@ typedef uintptr_t (*_k_syscall_handler_t)(uintptr_t arg1, uintptr_t arg2,
 					  uintptr_t arg5, uintptr_t arg6,
 					  void *ssf);
 
+/**
+ * @brief A system call queued in a batch
+ *
+ * Filled by the z_batch_<name>() functions generated for each system call,
+ * see k_syscall_batch_run().
+ */
+struct k_syscall_batch_entry {
+	/** Marshalled arguments, as passed to the handler function */
+	uintptr_t args[6];
+	/** System call ID, K_SYSCALL_LIMIT if already run */
+	uintptr_t id;
+	/** Handler return value, set when the call has run */
+	uintptr_t ret;
+};
+
+/**
+ * @brief A batch of system calls
+ *
+ * Lives in memory of the calling thread; see k_syscall_batch_init().
+ */
+struct k_syscall_batch {
+	struct k_syscall_batch_entry *entries;
+	uint32_t size;
+	uint32_t count;
+};
+
+#ifdef CONFIG_SYSCALL_BATCH
+/* Next free entry of @a batch; the caller checked it is not full */
+static inline struct k_syscall_batch_entry *
+z_syscall_batch_next(struct k_syscall_batch *batch)
+{
+	return &batch->entries[batch->count++];
+}
+#endif /* CONFIG_SYSCALL_BATCH */
+
 /* True if a syscall function must trap to the kernel, usually a
  * compile-time decision.
  */
@@ -18,6 +18,9 @@
 #define SYS_TRACE_ID_SEMA_GIVE               (5u + SYS_TRACE_ID_OFFSET)
 #define SYS_TRACE_ID_SEMA_TAKE               (6u + SYS_TRACE_ID_OFFSET)
 
+/* First of NET_PKT_DETAIL_STATS_COUNT IDs, one per network RX stage */
+#define SYS_TRACE_ID_NET_RX_STAGE            (7u + SYS_TRACE_ID_OFFSET)
+
 #ifdef CONFIG_SEGGER_SYSTEMVIEW
 #include "tracing_sysview.h"
 
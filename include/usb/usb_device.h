@@ -374,6 +374,10 @@ void usb_transfer_ep_callback(uint8_t ep, enum usb_dc_ep_cb_status_code);
  * and can be executed in IRQ context. The provided callback will be called
  * on transfer completion (or error) in thread context.
  *
+ * With CONFIG_USB_TRANSFER_QUEUE, a transfer started while the endpoint is
+ * busy is queued and started as soon as the previous one is over, without
+ * waiting for its completion callback. Otherwise -EBUSY is returned.
+ *
  * @param[in]  ep           Endpoint address corresponding to the one
  *                          listed in the device configuration table
  * @param[in]  data         Pointer to data buffer to write-to/read-from
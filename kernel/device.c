@@ -5,9 +5,11 @@
  */
 
 #include <string.h>
+#include <errno.h>
 #include <device.h>
 #include <sys/atomic.h>
 #include <syscall_handler.h>
+#include <kernel_internal.h>
 
 extern const struct init_entry __init_start[];
 extern const struct init_entry __init_PRE_KERNEL_1_start[];
@@ -29,6 +31,178 @@ extern uint32_t __device_busy_end[];
 #define DEVICE_BUSY_SIZE (__device_busy_end - __device_busy_start)
 #endif
 
+#ifdef CONFIG_DEVICE_NAME_HASH
+BUILD_ASSERT((CONFIG_DEVICE_NAME_HASH_SIZE &
+	      (CONFIG_DEVICE_NAME_HASH_SIZE - 1)) == 0,
+	     "CONFIG_DEVICE_NAME_HASH_SIZE must be a power of two");
+
+#define NAME_HASH_MASK (CONFIG_DEVICE_NAME_HASH_SIZE - 1)
+
+/* Open addressed index of the device table by name: each slot holds a
+ * device index plus one, zero marks an empty slot.  Written once
+ * before any init function runs, read-only afterwards.
+ */
+static uint16_t name_hash[CONFIG_DEVICE_NAME_HASH_SIZE];
+
+/* Set when some devices did not fit, lookup misses must then fall
+ * back to scanning the device table.
+ */
+static bool name_hash_partial;
+
+static uint32_t name_hash_calc(const char *name)
+{
+	/* 32 bit FNV-1a */
+	uint32_t hash = 2166136261U;
+
+	while (*name != '\0') {
+		hash = (hash ^ (uint8_t)*name++) * 16777619U;
+	}
+
+	return hash;
+}
+
+static void name_hash_init(void)
+{
+	size_t count = __device_end - __device_start;
+	size_t used = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		uint32_t slot;
+
+		/* Keep one slot free so that probing always ends */
+		if (used == NAME_HASH_MASK || i >= UINT16_MAX) {
+			name_hash_partial = true;
+			break;
+		}
+
+		slot = name_hash_calc(__device_start[i].name);
+		while (name_hash[slot & NAME_HASH_MASK] != 0U) {
+			slot++;
+		}
+		name_hash[slot & NAME_HASH_MASK] = i + 1;
+		used++;
+	}
+}
+
+/* Devices sharing a name are probed in device table order, so the
+ * first ready one is returned as with the linear scan.
+ */
+static struct device *name_hash_find(const char *name)
+{
+	uint32_t slot = name_hash_calc(name);
+	uint16_t idx;
+
+	while ((idx = name_hash[slot & NAME_HASH_MASK]) != 0U) {
+		struct device *dev = &__device_start[idx - 1];
+
+		if (z_device_ready(dev) &&
+		    ((dev->name == name) || (strcmp(name, dev->name) == 0))) {
+			return dev;
+		}
+		slot++;
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_DEVICE_NAME_HASH */
+
+#if CONFIG_BOOT_TIME_INIT_ENTRIES > 0
+struct z_init_timing z_init_timings[CONFIG_BOOT_TIME_INIT_ENTRIES];
+atomic_t z_init_timing_count;
+#endif
+
+static void init_entry_run(const struct init_entry *entry)
+{
+	struct device *dev = entry->dev;
+	int retval;
+#if CONFIG_BOOT_TIME_INIT_ENTRIES > 0
+	uint32_t start = k_cycle_get_32();
+	atomic_val_t idx;
+#endif
+
+	retval = entry->init(dev);
+	if (retval != 0) {
+		if (dev) {
+			/* Initialization failed. Clear the API struct
+			 * so that device_get_binding() will not succeed
+			 * for it.
+			 */
+			dev->api = NULL;
+		}
+	}
+
+#if CONFIG_BOOT_TIME_INIT_ENTRIES > 0
+	idx = atomic_inc(&z_init_timing_count);
+	if (idx < CONFIG_BOOT_TIME_INIT_ENTRIES) {
+		z_init_timings[idx].entry = entry;
+		z_init_timings[idx].cycles = k_cycle_get_32() - start;
+	}
+#endif
+}
+
+#ifdef CONFIG_INIT_PARALLEL
+enum {
+	INIT_ASYNC_IDLE,
+	INIT_ASYNC_STARTED,
+	INIT_ASYNC_DONE,
+};
+
+static struct k_work_pool init_pool;
+static struct k_thread init_pool_threads[MAX(CONFIG_INIT_PARALLEL_THREADS - 1,
+					     1)];
+static K_THREAD_STACK_ARRAY_DEFINE(init_pool_stacks,
+				   CONFIG_INIT_PARALLEL_THREADS,
+				   CONFIG_INIT_PARALLEL_STACK_SIZE);
+
+static void init_async_handler(struct k_work *work)
+{
+	struct z_init_async *async = CONTAINER_OF(work, struct z_init_async,
+						  work);
+
+	init_entry_run(async->entry);
+	atomic_set(&async->state, INIT_ASYNC_DONE);
+	k_sem_give(&async->done);
+}
+
+static void init_async_start(const struct init_entry *entry)
+{
+	struct z_init_async *async = entry->async;
+	static bool pool_started;
+
+	if (!pool_started) {
+		k_work_pool_start(&init_pool, init_pool_stacks[0],
+				  K_THREAD_STACK_SIZEOF(init_pool_stacks[0]),
+				  init_pool_threads,
+				  CONFIG_INIT_PARALLEL_THREADS,
+				  CONFIG_INIT_PARALLEL_PRIORITY, false);
+		pool_started = true;
+	}
+
+	async->entry = entry;
+	k_sem_init(&async->done, 0, 1);
+	k_work_init(&async->work, init_async_handler);
+	atomic_set(&async->state, INIT_ASYNC_STARTED);
+	k_work_submit_to_queue(k_work_pool_queue(&init_pool), &async->work);
+}
+
+static int init_async_wait(struct z_init_async *async)
+{
+	switch (atomic_get(&async->state)) {
+	case INIT_ASYNC_IDLE:
+		return -EAGAIN;
+	case INIT_ASYNC_STARTED:
+		/* Pass the token on to the other waiters, if any */
+		k_sem_take(&async->done, K_FOREVER);
+		k_sem_give(&async->done);
+		break;
+	default:
+		break;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_INIT_PARALLEL */
+
 /**
  * @brief Execute all the init entry initialization functions at a given level
  *
@@ -55,31 +229,72 @@ void z_sys_init_run_level(int32_t level)
 	};
 	const struct init_entry *entry;
 
+#ifdef CONFIG_DEVICE_NAME_HASH
+	if (level == _SYS_INIT_LEVEL_PRE_KERNEL_1) {
+		name_hash_init();
+	}
+#endif
+
 	for (entry = levels[level]; entry < levels[level+1]; entry++) {
 		struct device *dev = entry->dev;
-		int retval;
 
 		if (dev != NULL) {
 			z_object_init(dev);
 		}
 
-		retval = entry->init(dev);
-		if (retval != 0) {
-			if (dev) {
-				/* Initialization failed. Clear the API struct
-				 * so that device_get_binding() will not succeed
-				 * for it.
-				 */
-				dev->api = NULL;
+#ifdef CONFIG_INIT_PARALLEL
+		/* The pre-kernel levels have no threads to offload to */
+		if ((entry->async != NULL) &&
+		    (level >= _SYS_INIT_LEVEL_POST_KERNEL)) {
+			init_async_start(entry);
+			continue;
+		}
+#endif
+		init_entry_run(entry);
+	}
+
+#ifdef CONFIG_INIT_PARALLEL
+	/* Everything started in this level is done before the next one */
+	for (entry = levels[level]; entry < levels[level+1]; entry++) {
+		if (entry->async != NULL) {
+			(void)init_async_wait(entry->async);
+		}
+	}
+#endif
+}
+
+int device_init_wait(struct device *dev)
+{
+#ifdef CONFIG_INIT_PARALLEL
+	const struct init_entry *entry;
+
+	for (entry = __init_start; entry < __init_end; entry++) {
+		if ((entry->dev == dev) && (entry->async != NULL) &&
+		    (entry >= __init_POST_KERNEL_start)) {
+			int ret = init_async_wait(entry->async);
+
+			if (ret != 0) {
+				return ret;
 			}
+			break;
 		}
 	}
+#endif
+
+	return z_device_ready(dev) ? 0 : -ENODEV;
 }
 
 struct device *z_impl_device_get_binding(const char *name)
 {
 	struct device *dev;
 
+#ifdef CONFIG_DEVICE_NAME_HASH
+	dev = name_hash_find(name);
+	if ((dev != NULL) || !name_hash_partial) {
+		return dev;
+	}
+#endif
+
 	/* Split the search into two loops: in the common scenario, where
 	 * device names are stored in ROM (and are referenced by the user
 	 * with CONFIG_* macros), only cheap pointer comparisons will be
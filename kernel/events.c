@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Kernel event object.
+ *
+ * An event object holds 32 event flags. Threads wait directly on its wait
+ * queue, recording in their own thread structure the events they wait for,
+ * so that a post only wakes up the threads whose condition is satisfied.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <wait_q.h>
+#include <ksched.h>
+#include <syscall_handler.h>
+
+/* Single lock for all event objects, as for semaphores */
+static struct k_spinlock lock;
+
+void z_impl_k_event_init(struct k_event *event)
+{
+	event->events = 0U;
+	z_waitq_init(&event->wait_q);
+#ifdef CONFIG_POLL
+	sys_dlist_init(&event->poll_events);
+#endif
+
+	z_object_init(event);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline void z_vrfy_k_event_init(struct k_event *event)
+{
+	Z_OOPS(Z_SYSCALL_OBJ_INIT(event, K_OBJ_EVENT));
+	z_impl_k_event_init(event);
+}
+#include <syscalls/k_event_init_mrsh.c>
+#endif
+
+/* Events satisfying a wait, 0 if the wait is not satisfied */
+static uint32_t event_match(uint32_t current, uint32_t events,
+			    uint32_t options)
+{
+	uint32_t matched = current & events;
+
+	if (((options & K_EVENT_WAIT_ALL) != 0U) && (matched != events)) {
+		return 0U;
+	}
+
+	return matched;
+}
+
+static inline void handle_poll_events(struct k_event *event)
+{
+#ifdef CONFIG_POLL
+	/* Unlike a semaphore, events satisfy all the pollers */
+	while (!sys_dlist_is_empty(&event->poll_events)) {
+		z_handle_obj_poll_events(&event->poll_events,
+					 K_POLL_STATE_EVENTS_POSTED);
+	}
+#else
+	ARG_UNUSED(event);
+#endif
+}
+
+/* The events become (events & keep) | set */
+static void event_update(struct k_event *event, uint32_t set, uint32_t keep)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct k_thread *woken = NULL;
+	struct k_thread *thread;
+	uint32_t clear = 0U;
+	uint32_t matched;
+
+	event->events = (event->events & keep) | set;
+
+	/* Threads can't be unpended while walking the wait queue, link the
+	 * satisfied ones first. All of them see the same events, the
+	 * events they consume are cleared afterwards.
+	 */
+	_WAIT_Q_FOR_EACH(&event->wait_q, thread) {
+		matched = event_match(event->events, thread->events,
+				      thread->event_options);
+		if (matched == 0U) {
+			continue;
+		}
+
+		thread->events = matched;
+		thread->next_event_link = woken;
+		woken = thread;
+
+		if ((thread->event_options & K_EVENT_WAIT_CLEAR) != 0U) {
+			clear |= matched;
+		}
+	}
+
+	event->events &= ~clear;
+
+	while (woken != NULL) {
+		thread = woken;
+		woken = thread->next_event_link;
+
+		z_unpend_thread(thread);
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+	}
+
+	if (event->events != 0U) {
+		handle_poll_events(event);
+	}
+
+	z_reschedule(&lock, key);
+}
+
+void z_impl_k_event_post(struct k_event *event, uint32_t events)
+{
+	event_update(event, events, UINT32_MAX);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline void z_vrfy_k_event_post(struct k_event *event,
+				       uint32_t events)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(event, K_OBJ_EVENT));
+	z_impl_k_event_post(event, events);
+}
+#include <syscalls/k_event_post_mrsh.c>
+#endif
+
+void z_impl_k_event_set(struct k_event *event, uint32_t events)
+{
+	event_update(event, events, 0U);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline void z_vrfy_k_event_set(struct k_event *event, uint32_t events)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(event, K_OBJ_EVENT));
+	z_impl_k_event_set(event, events);
+}
+#include <syscalls/k_event_set_mrsh.c>
+#endif
+
+void z_impl_k_event_clear(struct k_event *event, uint32_t events)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	/* Clearing events never satisfies a wait */
+	event->events &= ~events;
+
+	k_spin_unlock(&lock, key);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline void z_vrfy_k_event_clear(struct k_event *event,
+					uint32_t events)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(event, K_OBJ_EVENT));
+	z_impl_k_event_clear(event, events);
+}
+#include <syscalls/k_event_clear_mrsh.c>
+#endif
+
+uint32_t z_impl_k_event_wait(struct k_event *event, uint32_t events,
+			     uint32_t options, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	uint32_t matched;
+
+	__ASSERT(((arch_is_in_isr() == false) ||
+		  K_TIMEOUT_EQ(timeout, K_NO_WAIT)), "");
+
+	if (events == 0U) {
+		return 0U;
+	}
+
+	key = k_spin_lock(&lock);
+
+	matched = event_match(event->events, events, options);
+	if (matched != 0U) {
+		if ((options & K_EVENT_WAIT_CLEAR) != 0U) {
+			event->events &= ~matched;
+		}
+		k_spin_unlock(&lock, key);
+		return matched;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		k_spin_unlock(&lock, key);
+		return 0U;
+	}
+
+	_current->events = events;
+	_current->event_options = options;
+
+	/* The poster stores the matching events in the thread */
+	if (z_pend_curr(&lock, key, &event->wait_q, timeout) != 0) {
+		return 0U;
+	}
+
+	return _current->events;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline uint32_t z_vrfy_k_event_wait(struct k_event *event,
+					   uint32_t events, uint32_t options,
+					   k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(event, K_OBJ_EVENT));
+	return z_impl_k_event_wait(event, events, options, timeout);
+}
+#include <syscalls/k_event_wait_mrsh.c>
+
+static inline uint32_t z_vrfy_k_event_get(struct k_event *event)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(event, K_OBJ_EVENT));
+	return z_impl_k_event_get(event);
+}
+#include <syscalls/k_event_get_mrsh.c>
+#endif
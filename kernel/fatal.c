@@ -99,6 +99,9 @@ void z_fatal_error(unsigned int reason, const z_arch_esf_t *esf)
 	unsigned int key = arch_irq_lock();
 	struct k_thread *thread = k_current_get();
 
+	/* Get any deferred printk() output out before reporting the error */
+	printk_deferred_panic();
+
 	/* sanitycheck looks for the "ZEPHYR FATAL ERROR" string, don't
 	 * change it without also updating sanitycheck
 	 */
@@ -182,6 +182,19 @@ void arch_switch_to_main_thread(struct k_thread *main_thread, char *stack_ptr,
 int arch_float_disable(struct k_thread *thread);
 #endif /* CONFIG_FPU && CONFIG_FPU_SHARING */
 
+#ifdef CONFIG_FPU_SHARING_LAZY
+/**
+ * @brief Forget the floating point context of an aborted thread
+ *
+ * With lazy floating point context switching, the floating point registers
+ * are only saved into a thread once another thread uses them. This makes
+ * sure they are never saved into the thread object of an aborted thread.
+ *
+ * @param thread Thread being aborted.
+ */
+void arch_float_lazy_abort(struct k_thread *thread);
+#endif /* CONFIG_FPU_SHARING_LAZY */
+
 /** @} */
 
 /**
@@ -76,6 +76,22 @@ extern void z_thread_monitor_exit(struct k_thread *thread);
 	} while (false)
 #endif /* CONFIG_THREAD_MONITOR */
 
+/* context switch notifications, called by the kernel and the architecture
+ * context switch code with interrupts locked
+ */
+#ifdef CONFIG_INSTRUMENT_THREAD_SWITCHING
+extern void z_thread_mark_switched_in(void);
+extern void z_thread_mark_switched_out(void);
+#else
+#define z_thread_mark_switched_in()
+#define z_thread_mark_switched_out()
+#endif /* CONFIG_INSTRUMENT_THREAD_SWITCHING */
+
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+/* charge the cycles since the last switch and start counting for _current */
+extern void z_thread_runtime_switched_in(void);
+#endif
+
 #ifdef CONFIG_USE_SWITCH
 /* This is a arch function traditionally, but when the switch-based
  * z_swap() is in use it's a simple inline provided by the kernel.
@@ -109,6 +125,20 @@ extern int z_stack_adjust_initialized;
 #ifdef CONFIG_BOOT_TIME_MEASUREMENT
 extern uint32_t z_timestamp_main; /* timestamp when main task starts */
 extern uint32_t z_timestamp_idle; /* timestamp when CPU goes idle */
+
+#if CONFIG_BOOT_TIME_INIT_ENTRIES > 0
+/* Duration of an init entry, recorded in order of completion */
+struct z_init_timing {
+	const struct init_entry *entry;
+	uint32_t cycles;
+};
+
+/* z_init_timing_count may exceed the array size if some entries were
+ * not recorded.
+ */
+extern struct z_init_timing z_init_timings[CONFIG_BOOT_TIME_INIT_ENTRIES];
+extern atomic_t z_init_timing_count;
+#endif
 #endif
 
 extern struct k_thread z_main_thread;
@@ -128,6 +158,13 @@ extern uint8_t *z_priv_stack_find(k_thread_stack_t *stack);
 bool z_stack_is_user_capable(k_thread_stack_t *stack);
 #endif /* CONFIG_USERSPACE */
 
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+/* Make an unlocked mutex locked once by owner, which did not lock it
+ * itself. Returns -EBUSY if the mutex is locked.
+ */
+int z_mutex_adopt(struct k_mutex *mutex, struct k_thread *owner);
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
+
 #ifdef __cplusplus
 }
 #endif
@@ -97,7 +97,7 @@ static ALWAYS_INLINE unsigned int do_swap(unsigned int key,
 #endif
 
 	if (new_thread != old_thread) {
-		sys_trace_thread_switched_out();
+		z_thread_mark_switched_out();
 #ifdef CONFIG_TIMESLICING
 		z_reset_time_slice();
 #endif
@@ -117,7 +117,7 @@ static ALWAYS_INLINE unsigned int do_swap(unsigned int key,
 		wait_for_switch(new_thread);
 		arch_switch(new_thread->switch_handle,
 			     &old_thread->switch_handle);
-		sys_trace_thread_switched_in();
+		z_thread_mark_switched_in();
 	}
 
 	if (is_spinlock) {
@@ -156,11 +156,11 @@ static inline int z_swap_irqlock(unsigned int key)
 	int ret;
 	z_check_stack_sentinel();
 #ifndef CONFIG_ARM
-	sys_trace_thread_switched_out();
+	z_thread_mark_switched_out();
 #endif
 	ret = arch_swap(key);
 #ifndef CONFIG_ARM
-	sys_trace_thread_switched_in();
+	z_thread_mark_switched_in();
 #endif
 	return ret;
 }
@@ -155,6 +155,10 @@ void z_data_copy(void)
 	(void)memcpy(&__dtcm_data_start, &__dtcm_data_rom_start,
 		 __dtcm_data_end - __dtcm_data_start);
 #endif
+#ifdef CONFIG_HOT_PATH_ITCM
+	(void)memcpy(&__itcm_text_start, &__itcm_text_rom_start,
+		 __itcm_text_end - __itcm_text_start);
+#endif
 #ifdef CONFIG_CODE_DATA_RELOCATION
 	extern void data_copy_xip_relocation(void);
 
@@ -191,6 +195,27 @@ void z_data_copy(void)
 
 bool z_sys_post_kernel;
 
+#ifdef CONFIG_HOT_PATH_RELOCATION_REPORT
+static void hot_path_report(void)
+{
+	/* The copy itself happens in z_data_copy(), before the system
+	 * timer is initialized, so only the sizes are reported.
+	 */
+#ifdef CONFIG_HOT_PATH_ITCM
+	size_t size = __itcm_text_end - __itcm_text_start;
+#else
+	size_t size = (uintptr_t)_ramfunc_ram_size;
+#endif
+
+	printk("*** Hot paths: %zu bytes of code copied at boot", size);
+#ifdef CONFIG_HOT_PATH_DTCM
+	printk(", %zu bytes of data in DTCM",
+	       (size_t)(__dtcm_end - __dtcm_start));
+#endif
+	printk(" ***\n");
+}
+#endif /* CONFIG_HOT_PATH_RELOCATION_REPORT */
+
 /**
  *
  * @brief Mainline for kernel's background thread
@@ -224,6 +249,10 @@ static void bg_thread_main(void *unused1, void *unused2, void *unused3)
 		k_busy_wait(CONFIG_BOOT_DELAY * USEC_PER_MSEC);
 	}
 
+#ifdef CONFIG_HOT_PATH_RELOCATION_REPORT
+	hot_path_report();
+#endif
+
 #if defined(CONFIG_BOOT_BANNER)
 #ifdef BUILD_VERSION
 	printk("*** Booting Zephyr OS build %s %s ***\n",
@@ -26,9 +26,30 @@ static int statics_init(struct device *unused)
 
 SYS_INIT(statics_init, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
 
+/* Time left to wait until the deadline computed by z_timeout_end_calc(),
+ * K_NO_WAIT once it has passed.  K_FOREVER has no deadline: its end
+ * is UINT64_MAX, which is negative as an int64_t.
+ */
+static k_timeout_t timeout_remaining(k_timeout_t timeout, int64_t end)
+{
+	int64_t now;
+
+	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		return K_FOREVER;
+	}
+
+	now = z_tick_get();
+	if ((end - now) <= 0) {
+		return K_NO_WAIT;
+	}
+
+	return K_TICKS(end - now);
+}
+
 void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout)
 {
-	int64_t now, end = z_timeout_end_calc(timeout);
+	int64_t end = z_timeout_end_calc(timeout);
+	k_timeout_t remaining;
 	void *ret = NULL;
 	k_spinlock_key_t key = k_spin_lock(&h->lock);
 
@@ -37,13 +58,12 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout)
 	while (ret == NULL) {
 		ret = sys_heap_alloc(&h->heap, bytes);
 
-		now = z_tick_get();
-		if ((ret != NULL) || ((end - now) <= 0)) {
+		remaining = timeout_remaining(timeout, end);
+		if ((ret != NULL) || K_TIMEOUT_EQ(remaining, K_NO_WAIT)) {
 			break;
 		}
 
-		(void) z_pend_curr(&h->lock, key, &h->wait_q,
-				   K_TICKS(end - now));
+		(void) z_pend_curr(&h->lock, key, &h->wait_q, remaining);
 		key = k_spin_lock(&h->lock);
 	}
 
@@ -51,6 +71,39 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout)
 	return ret;
 }
 
+void *k_heap_realloc(struct k_heap *h, void *ptr, size_t bytes,
+		     k_timeout_t timeout)
+{
+	int64_t end = z_timeout_end_calc(timeout);
+	k_timeout_t remaining;
+	void *ret = NULL;
+	k_spinlock_key_t key = k_spin_lock(&h->lock);
+
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	while (ret == NULL) {
+		ret = sys_heap_realloc(&h->heap, ptr, bytes);
+
+		remaining = timeout_remaining(timeout, end);
+		if ((ret != NULL) || (bytes == 0) ||
+		    K_TIMEOUT_EQ(remaining, K_NO_WAIT)) {
+			break;
+		}
+
+		(void) z_pend_curr(&h->lock, key, &h->wait_q, remaining);
+		key = k_spin_lock(&h->lock);
+	}
+
+	/* Resizing an existing block may have released memory */
+	if ((ptr != NULL) && ((ret != NULL) || (bytes == 0)) &&
+	    (z_unpend_all(&h->wait_q) != 0)) {
+		z_reschedule(&h->lock, key);
+	} else {
+		k_spin_unlock(&h->lock, key);
+	}
+	return ret;
+}
+
 void k_heap_free(struct k_heap *h, void *mem)
 {
 	k_spinlock_key_t key = k_spin_lock(&h->lock);
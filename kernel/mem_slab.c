@@ -14,6 +14,7 @@
 #include <ksched.h>
 #include <init.h>
 #include <sys/check.h>
+#include <string.h>
 
 static struct k_spinlock lock;
 
@@ -88,6 +89,9 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->block_size = block_size;
 	slab->buffer = buffer;
 	slab->num_used = 0U;
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	(void)memset(slab->cache, 0, sizeof(slab->cache));
+#endif
 	rc = create_free_list(slab);
 	if (rc < 0) {
 		goto out;
@@ -101,28 +105,272 @@ out:
 	return rc;
 }
 
-int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+#define CACHE_BATCH (CONFIG_MEM_SLAB_CPU_CACHE_SIZE / 2)
+
+/* Each cache has its own lock, which only its CPU takes except when
+ * another CPU runs dry and steals from it.  Lock order is the shared
+ * slab lock, then the cache lock: blocks move between a cache and the
+ * shared list as a chain, taken under one lock and handed over under
+ * the other.
+ *
+ * A thread about to wait sets cache_bypass under the shared lock, then
+ * steals from every cache before it pends, still under the shared lock.
+ * Blocks pushed to a cache before the steal are found by it, and a
+ * thread pushing afterwards sees cache_bypass under the cache lock and
+ * frees its blocks through the shared list instead, waking the waiter.
+ */
+static inline struct k_mem_slab_cache *cache_lock(struct k_mem_slab *slab,
+						  k_spinlock_key_t *key)
+{
+	unsigned int irq = arch_irq_lock();
+	struct k_mem_slab_cache *c = &slab->cache[_current_cpu->id];
+
+	/* The CPU can't change once interrupts are locked; have the
+	 * matching k_spin_unlock() restore the caller's interrupt state.
+	 */
+	*key = k_spin_lock(&c->lock);
+	key->key = irq;
+
+	return c;
+}
+
+static inline void *cache_pop(struct k_mem_slab_cache *c)
+{
+	char *block = c->free_list;
+
+	c->free_list = *(char **)block;
+	c->count--;
+
+	return block;
+}
+
+static inline void cache_push(struct k_mem_slab_cache *c, void *block)
+{
+	*(char **)block = c->free_list;
+	c->free_list = block;
+	c->count++;
+}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
+/* Give a block to the first waiter or put it on the shared list, with
+ * the shared lock held.  Returns true if a thread was readied.
+ */
+static bool shared_free(struct k_mem_slab *slab, void *block)
+{
+	struct k_thread *pending_thread;
+
+	pending_thread = z_unpend_first_thread(&slab->wait_q);
+	if (pending_thread != NULL) {
+		z_thread_return_value_set_with_data(pending_thread, 0, block);
+		z_ready_thread(pending_thread);
+		return true;
+	}
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	/* Nobody waits anymore, the caches can be used again */
+	slab->cache_bypass = false;
+#endif
+	*(char **)block = slab->free_list;
+	slab->free_list = block;
+	slab->num_used--;
+
+	return false;
+}
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+/* Free a chain of blocks through the shared list */
+static void shared_free_chain(struct k_mem_slab *slab, char *chain)
 {
 	k_spinlock_key_t key = k_spin_lock(&lock);
+	bool resched = false;
+	char *block;
+
+	while (chain != NULL) {
+		block = chain;
+		chain = *(char **)block;
+		resched |= shared_free(slab, block);
+	}
+
+	if (resched) {
+		z_reschedule(&lock, key);
+	} else {
+		k_spin_unlock(&lock, key);
+	}
+}
+
+/* Take up to CACHE_BATCH blocks off the shared list, with the shared lock
+ * held.  Blocks in a cache stay counted in num_used, see
+ * k_mem_slab_num_used_get().
+ */
+static char *shared_take_chain(struct k_mem_slab *slab)
+{
+	char *chain = NULL;
+	char *block;
+	int n;
+
+	for (n = 0; n < CACHE_BATCH && slab->free_list != NULL; n++) {
+		block = slab->free_list;
+		slab->free_list = *(char **)block;
+		*(char **)block = chain;
+		chain = block;
+		slab->num_used++;
+	}
+
+	return chain;
+}
+
+/* Put a chain taken off the shared list in the current CPU's cache */
+static void cache_put_chain(struct k_mem_slab *slab, char *chain)
+{
+	k_spinlock_key_t key;
+	struct k_mem_slab_cache *c = cache_lock(slab, &key);
+	char *block;
+
+	if (slab->cache_bypass) {
+		k_spin_unlock(&c->lock, key);
+		shared_free_chain(slab, chain);
+		return;
+	}
+
+	while (chain != NULL && c->count < CONFIG_MEM_SLAB_CPU_CACHE_SIZE) {
+		block = chain;
+		chain = *(char **)block;
+		cache_push(c, block);
+	}
+
+	k_spin_unlock(&c->lock, key);
+
+	if (chain != NULL) {
+		shared_free_chain(slab, chain);
+	}
+}
+
+static bool cache_alloc(struct k_mem_slab *slab, void **mem)
+{
+	k_spinlock_key_t key;
+	struct k_mem_slab_cache *c = cache_lock(slab, &key);
+	bool ret = false;
+
+	if (c->count != 0U) {
+		*mem = cache_pop(c);
+		ret = true;
+	}
+
+	k_spin_unlock(&c->lock, key);
+
+	return ret;
+}
+
+static bool cache_free(struct k_mem_slab *slab, void *block)
+{
+	k_spinlock_key_t key;
+	struct k_mem_slab_cache *c = cache_lock(slab, &key);
+	char *chain = NULL;
+	char *flushed;
+	int n;
+
+	/* Waiters can only be served from the shared path */
+	if (slab->cache_bypass) {
+		k_spin_unlock(&c->lock, key);
+		return false;
+	}
+
+	if (c->count == CONFIG_MEM_SLAB_CPU_CACHE_SIZE) {
+		for (n = 0; n < CACHE_BATCH; n++) {
+			flushed = cache_pop(c);
+			*(char **)flushed = chain;
+			chain = flushed;
+		}
+	}
+	cache_push(c, block);
+
+	k_spin_unlock(&c->lock, key);
+
+	if (chain != NULL) {
+		shared_free_chain(slab, chain);
+	}
+
+	return true;
+}
+
+/* Shared list is empty: take a block parked in any CPU's cache, with the
+ * shared lock held.
+ */
+static bool cache_steal(struct k_mem_slab *slab, void **mem)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct k_mem_slab_cache *c = &slab->cache[i];
+		k_spinlock_key_t key = k_spin_lock(&c->lock);
+
+		if (c->count != 0U) {
+			*mem = cache_pop(c);
+			k_spin_unlock(&c->lock, key);
+			return true;
+		}
+
+		k_spin_unlock(&c->lock, key);
+	}
+
+	return false;
+}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
+int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
 	int result;
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (cache_alloc(slab, mem)) {
+		return 0;
+	}
+#endif
+
+	key = k_spin_lock(&lock);
+
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
 		slab->free_list = *(char **)(slab->free_list);
 		slab->num_used++;
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+		/* and refill the cache while at it */
+		char *chain = shared_take_chain(slab);
+
+		k_spin_unlock(&lock, key);
+		if (chain != NULL) {
+			cache_put_chain(slab, chain);
+		}
+		return 0;
+#else
 		result = 0;
-	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
-		/* don't wait for a free block to become available */
-		*mem = NULL;
-		result = -ENOMEM;
+#endif
 	} else {
-		/* wait for a free block or timeout */
-		result = z_pend_curr(&lock, key, &slab->wait_q, timeout);
-		if (result == 0) {
-			*mem = _current->base.swap_data;
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+		/* Set before stealing, so frees past the steal wake us */
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			slab->cache_bypass = true;
+		}
+
+		if (cache_steal(slab, mem)) {
+			k_spin_unlock(&lock, key);
+			return 0;
+		}
+#endif
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			/* don't wait for a free block to become available */
+			*mem = NULL;
+			result = -ENOMEM;
+		} else {
+			/* wait for a free block or timeout */
+			result = z_pend_curr(&lock, key, &slab->wait_q,
+					     timeout);
+			if (result == 0) {
+				*mem = _current->base.swap_data;
+			}
+			return result;
 		}
-		return result;
 	}
 
 	k_spin_unlock(&lock, key);
@@ -132,17 +380,88 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 
 void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&lock);
-	struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
+	k_spinlock_key_t key;
 
-	if (pending_thread != NULL) {
-		z_thread_return_value_set_with_data(pending_thread, 0, *mem);
-		z_ready_thread(pending_thread);
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (cache_free(slab, *mem)) {
+		return;
+	}
+#endif
+
+	key = k_spin_lock(&lock);
+
+	if (shared_free(slab, *mem)) {
+		z_reschedule(&lock, key);
+	} else {
+		k_spin_unlock(&lock, key);
+	}
+}
+
+uint32_t k_mem_slab_alloc_batch(struct k_mem_slab *slab, void **mem,
+				uint32_t count)
+{
+	k_spinlock_key_t key;
+	uint32_t n = 0U;
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	struct k_mem_slab_cache *c = cache_lock(slab, &key);
+
+	while (n < count && c->count != 0U) {
+		mem[n++] = cache_pop(c);
+	}
+
+	k_spin_unlock(&c->lock, key);
+#endif
+
+	key = k_spin_lock(&lock);
+
+	while (n < count && slab->free_list != NULL) {
+		mem[n] = slab->free_list;
+		slab->free_list = *(char **)(slab->free_list);
+		slab->num_used++;
+		n++;
+	}
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	while (n < count && cache_steal(slab, &mem[n])) {
+		n++;
+	}
+#endif
+
+	k_spin_unlock(&lock, key);
+
+	return n;
+}
+
+void k_mem_slab_free_batch(struct k_mem_slab *slab, void **mem,
+			   uint32_t count)
+{
+	k_spinlock_key_t key;
+	bool resched = false;
+	uint32_t n = 0U;
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	struct k_mem_slab_cache *c = cache_lock(slab, &key);
+
+	/* Waiters can only be served from the shared path */
+	if (!slab->cache_bypass) {
+		while (n < count && c->count < CONFIG_MEM_SLAB_CPU_CACHE_SIZE) {
+			cache_push(c, mem[n++]);
+		}
+	}
+
+	k_spin_unlock(&c->lock, key);
+#endif
+
+	key = k_spin_lock(&lock);
+
+	for (; n < count; n++) {
+		resched |= shared_free(slab, mem[n]);
+	}
+
+	if (resched) {
 		z_reschedule(&lock, key);
 	} else {
-		**(char ***)mem = slab->free_list;
-		slab->free_list = *(char **)mem;
-		slab->num_used--;
 		k_spin_unlock(&lock, key);
 	}
 }
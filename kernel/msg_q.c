@@ -58,6 +58,7 @@ void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 	msgq->used_msgs = 0;
 	msgq->flags = 0;
 	z_waitq_init(&msgq->wait_q);
+	z_waitq_init(&msgq->put_wait_q);
 	msgq->lock = (struct k_spinlock) {};
 
 	SYS_TRACING_OBJ_INIT(k_msgq, msgq);
@@ -101,7 +102,8 @@ int z_vrfy_k_msgq_alloc_init(struct k_msgq *q, size_t msg_size,
 
 int k_msgq_cleanup(struct k_msgq *msgq)
 {
-	CHECKIF(z_waitq_head(&msgq->wait_q) != NULL) {
+	CHECKIF(z_waitq_head(&msgq->wait_q) != NULL ||
+		z_waitq_head(&msgq->put_wait_q) != NULL) {
 		return -EBUSY;
 	}
 
@@ -113,6 +115,73 @@ int k_msgq_cleanup(struct k_msgq *msgq)
 }
 
 
+static inline void msgq_advance(struct k_msgq *msgq, char **ptr)
+{
+	*ptr += msgq->msg_size;
+	if (*ptr == msgq->buffer_end) {
+		*ptr = msgq->buffer_start;
+	}
+}
+
+/* Hand the message at write_ptr to a waiting reader, if any.  Readers
+ * waiting in k_msgq_get_claim() have no buffer: the message is queued
+ * for them instead.  Must be called with the lock held.
+ */
+static bool msgq_give_reader(struct k_msgq *msgq)
+{
+	struct k_thread *pending_thread = z_unpend_first_thread(&msgq->wait_q);
+
+	if (pending_thread == NULL) {
+		return false;
+	}
+
+	if (pending_thread->base.swap_data != NULL) {
+		(void)memcpy(pending_thread->base.swap_data, msgq->write_ptr,
+			     msgq->msg_size);
+	} else {
+		msgq_advance(msgq, &msgq->write_ptr);
+		msgq->used_msgs++;
+	}
+	arch_thread_return_value_set(pending_thread, 0);
+	z_ready_thread(pending_thread);
+
+	return true;
+}
+
+/* Fill free slots from waiting writers.  Writers waiting in
+ * k_msgq_put_claim() are only woken up to retry their claim.  Must be
+ * called with the lock held, returns true if any thread was readied.
+ */
+static bool msgq_take_writers(struct k_msgq *msgq)
+{
+	struct k_thread *pending_thread;
+	bool readied = false;
+
+	while (msgq->used_msgs < msgq->max_msgs &&
+	       (msgq->flags & K_MSGQ_FLAG_PUT_CLAIM) == 0U) {
+		pending_thread = z_unpend_first_thread(&msgq->put_wait_q);
+		if (pending_thread == NULL) {
+			break;
+		}
+
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		readied = true;
+
+		if (pending_thread->base.swap_data == NULL) {
+			/* claim waiter, it retries once it runs */
+			continue;
+		}
+
+		(void)memcpy(msgq->write_ptr, pending_thread->base.swap_data,
+			     msgq->msg_size);
+		msgq_advance(msgq, &msgq->write_ptr);
+		msgq->used_msgs++;
+	}
+
+	return readied;
+}
+
 int z_impl_k_msgq_put(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 {
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
@@ -123,26 +192,29 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 
 	key = k_spin_lock(&msgq->lock);
 
-	if (msgq->used_msgs < msgq->max_msgs) {
+	if ((msgq->flags & K_MSGQ_FLAG_PUT_CLAIM) != 0U) {
+		/* the slot at write_ptr is being written in place */
+		result = -EBUSY;
+	} else if (msgq->used_msgs < msgq->max_msgs) {
 		/* message queue isn't full */
 		pending_thread = z_unpend_first_thread(&msgq->wait_q);
-		if (pending_thread != NULL) {
+		if (pending_thread != NULL &&
+		    pending_thread->base.swap_data != NULL) {
 			/* give message to waiting thread */
 			(void)memcpy(pending_thread->base.swap_data, data,
 			       msgq->msg_size);
+		} else {
+			/* put message in queue */
+			(void)memcpy(msgq->write_ptr, data, msgq->msg_size);
+			msgq_advance(msgq, &msgq->write_ptr);
+			msgq->used_msgs++;
+		}
+		if (pending_thread != NULL) {
 			/* wake up waiting thread */
 			arch_thread_return_value_set(pending_thread, 0);
 			z_ready_thread(pending_thread);
 			z_reschedule(&msgq->lock, key);
 			return 0;
-		} else {
-			/* put message in queue */
-			(void)memcpy(msgq->write_ptr, data, msgq->msg_size);
-			msgq->write_ptr += msgq->msg_size;
-			if (msgq->write_ptr == msgq->buffer_end) {
-				msgq->write_ptr = msgq->buffer_start;
-			}
-			msgq->used_msgs++;
 		}
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
@@ -151,7 +223,8 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 	} else {
 		/* wait for put message success, failure, or timeout */
 		_current->base.swap_data = data;
-		return z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		return z_pend_curr(&msgq->lock, key, &msgq->put_wait_q,
+				   timeout);
 	}
 
 	k_spin_unlock(&msgq->lock, key);
@@ -194,35 +267,21 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
 
 	k_spinlock_key_t key;
-	struct k_thread *pending_thread;
 	int result;
 
 	key = k_spin_lock(&msgq->lock);
 
-	if (msgq->used_msgs > 0) {
+	if ((msgq->flags & K_MSGQ_FLAG_GET_CLAIM) != 0U) {
+		/* the message at read_ptr is being read in place */
+		result = -EBUSY;
+	} else if (msgq->used_msgs > 0) {
 		/* take first available message from queue */
 		(void)memcpy(data, msgq->read_ptr, msgq->msg_size);
-		msgq->read_ptr += msgq->msg_size;
-		if (msgq->read_ptr == msgq->buffer_end) {
-			msgq->read_ptr = msgq->buffer_start;
-		}
+		msgq_advance(msgq, &msgq->read_ptr);
 		msgq->used_msgs--;
 
 		/* handle first thread waiting to write (if any) */
-		pending_thread = z_unpend_first_thread(&msgq->wait_q);
-		if (pending_thread != NULL) {
-			/* add thread's message to queue */
-			(void)memcpy(msgq->write_ptr, pending_thread->base.swap_data,
-			       msgq->msg_size);
-			msgq->write_ptr += msgq->msg_size;
-			if (msgq->write_ptr == msgq->buffer_end) {
-				msgq->write_ptr = msgq->buffer_start;
-			}
-			msgq->used_msgs++;
-
-			/* wake up waiting thread */
-			arch_thread_return_value_set(pending_thread, 0);
-			z_ready_thread(pending_thread);
+		if (msgq_take_writers(msgq)) {
 			z_reschedule(&msgq->lock, key);
 			return 0;
 		}
@@ -285,6 +344,215 @@ static inline int z_vrfy_k_msgq_peek(struct k_msgq *q, void *data)
 #include <syscalls/k_msgq_peek_mrsh.c>
 #endif
 
+int z_impl_k_msgq_get_batch(struct k_msgq *msgq, void *data,
+			    uint32_t max_msgs, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	k_spinlock_key_t key;
+	char *dst = data;
+	uint32_t count = 0U;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if ((msgq->flags & K_MSGQ_FLAG_GET_CLAIM) != 0U) {
+		result = -EBUSY;
+	} else if (msgq->used_msgs > 0) {
+		/* drain as much as fits, refilling from waiting writers */
+		while (count < max_msgs && msgq->used_msgs > 0) {
+			(void)memcpy(dst, msgq->read_ptr, msgq->msg_size);
+			dst += msgq->msg_size;
+			count++;
+			msgq_advance(msgq, &msgq->read_ptr);
+			msgq->used_msgs--;
+		}
+
+		if (msgq_take_writers(msgq)) {
+			z_reschedule(&msgq->lock, key);
+			return count;
+		}
+		result = count;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) || max_msgs == 0U) {
+		result = -ENOMSG;
+	} else {
+		/* wait for a single message, as k_msgq_get() */
+		_current->base.swap_data = data;
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		return (result == 0) ? 1 : result;
+	}
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_batch(struct k_msgq *q, void *data,
+					  uint32_t max_msgs,
+					  k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(q, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(data, max_msgs, q->msg_size));
+
+	return z_impl_k_msgq_get_batch(q, data, max_msgs, timeout);
+}
+#include <syscalls/k_msgq_get_batch_mrsh.c>
+#endif
+
+/* Wait on @a wait_q until @a ready holds for a claim.  The waiting thread
+ * has no message buffer, which tells put/get to only wake it up.  Must be
+ * called with the lock held; returns with it held on success.
+ */
+static int msgq_claim_wait(struct k_msgq *msgq, k_spinlock_key_t *key,
+			   _wait_q_t *wait_q,
+			   bool (*ready)(struct k_msgq *msgq),
+			   k_timeout_t timeout)
+{
+	int64_t now, end = z_timeout_end_calc(timeout);
+	int result;
+
+	while (!ready(msgq)) {
+		k_timeout_t remaining = timeout;
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -ENOMSG;
+		}
+		if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			now = z_tick_get();
+			if (end - now <= 0) {
+				return -EAGAIN;
+			}
+			remaining = K_TICKS(end - now);
+		}
+
+		_current->base.swap_data = NULL;
+		result = z_pend_curr(&msgq->lock, *key, wait_q, remaining);
+		*key = k_spin_lock(&msgq->lock);
+		if (result != 0) {
+			return result;
+		}
+	}
+
+	return 0;
+}
+
+static bool msgq_has_space(struct k_msgq *msgq)
+{
+	return msgq->used_msgs < msgq->max_msgs;
+}
+
+static bool msgq_has_msg(struct k_msgq *msgq)
+{
+	return msgq->used_msgs > 0;
+}
+
+int k_msgq_put_claim(struct k_msgq *msgq, void **data, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	k_spinlock_key_t key = k_spin_lock(&msgq->lock);
+	int result;
+
+	if ((msgq->flags & K_MSGQ_FLAG_PUT_CLAIM) != 0U) {
+		result = -EBUSY;
+	} else {
+		result = msgq_claim_wait(msgq, &key, &msgq->put_wait_q,
+					 msgq_has_space, timeout);
+		if (result == 0 &&
+		    (msgq->flags & K_MSGQ_FLAG_PUT_CLAIM) != 0U) {
+			/* another claimer got there while we waited */
+			result = -EBUSY;
+		} else if (result == 0) {
+			msgq->flags |= K_MSGQ_FLAG_PUT_CLAIM;
+			*data = msgq->write_ptr;
+		}
+	}
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+int k_msgq_put_commit(struct k_msgq *msgq)
+{
+	k_spinlock_key_t key = k_spin_lock(&msgq->lock);
+	bool resched;
+
+	if ((msgq->flags & K_MSGQ_FLAG_PUT_CLAIM) == 0U) {
+		k_spin_unlock(&msgq->lock, key);
+		return -EINVAL;
+	}
+
+	msgq->flags &= ~K_MSGQ_FLAG_PUT_CLAIM;
+
+	/* The queue had a free slot when it was claimed, so there are no
+	 * writers to take in.
+	 */
+	resched = msgq_give_reader(msgq);
+	if (!resched) {
+		msgq_advance(msgq, &msgq->write_ptr);
+		msgq->used_msgs++;
+	}
+
+	if (resched) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return 0;
+}
+
+int k_msgq_get_claim(struct k_msgq *msgq, void **data, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	k_spinlock_key_t key = k_spin_lock(&msgq->lock);
+	int result;
+
+	if ((msgq->flags & K_MSGQ_FLAG_GET_CLAIM) != 0U) {
+		result = -EBUSY;
+	} else {
+		result = msgq_claim_wait(msgq, &key, &msgq->wait_q,
+					 msgq_has_msg, timeout);
+		if (result == 0 &&
+		    (msgq->flags & K_MSGQ_FLAG_GET_CLAIM) != 0U) {
+			/* another claimer got there while we waited */
+			result = -EBUSY;
+		} else if (result == 0) {
+			msgq->flags |= K_MSGQ_FLAG_GET_CLAIM;
+			*data = msgq->read_ptr;
+		}
+	}
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+int k_msgq_get_release(struct k_msgq *msgq)
+{
+	k_spinlock_key_t key = k_spin_lock(&msgq->lock);
+
+	if ((msgq->flags & K_MSGQ_FLAG_GET_CLAIM) == 0U) {
+		k_spin_unlock(&msgq->lock, key);
+		return -EINVAL;
+	}
+
+	msgq->flags &= ~K_MSGQ_FLAG_GET_CLAIM;
+	msgq_advance(msgq, &msgq->read_ptr);
+	msgq->used_msgs--;
+
+	if (msgq_take_writers(msgq)) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return 0;
+}
+
 void z_impl_k_msgq_purge(struct k_msgq *msgq)
 {
 	k_spinlock_key_t key;
@@ -293,6 +561,13 @@ void z_impl_k_msgq_purge(struct k_msgq *msgq)
 	key = k_spin_lock(&msgq->lock);
 
 	/* wake up any threads that are waiting to write */
+	while ((pending_thread =
+		z_unpend_first_thread(&msgq->put_wait_q)) != NULL) {
+		arch_thread_return_value_set(pending_thread, -ENOMSG);
+		z_ready_thread(pending_thread);
+	}
+
+	/* and any that are waiting to read */
 	while ((pending_thread = z_unpend_first_thread(&msgq->wait_q)) != NULL) {
 		arch_thread_return_value_set(pending_thread, -ENOMSG);
 		z_ready_thread(pending_thread);
@@ -300,6 +575,7 @@ void z_impl_k_msgq_purge(struct k_msgq *msgq)
 
 	msgq->used_msgs = 0;
 	msgq->read_ptr = msgq->write_ptr;
+	msgq->flags &= ~K_MSGQ_FLAG_GET_CLAIM;
 
 	z_reschedule(&msgq->lock, key);
 }
@@ -93,6 +93,27 @@ static inline int z_vrfy_k_mutex_init(struct k_mutex *mutex)
 #include <syscalls/k_mutex_init_mrsh.c>
 #endif
 
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+/* A sys_mutex locked without syscall gets its k_mutex on contention */
+int z_mutex_adopt(struct k_mutex *mutex, struct k_thread *owner)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (mutex->lock_count != 0U) {
+		k_spin_unlock(&lock, key);
+		return -EBUSY;
+	}
+
+	mutex->owner = owner;
+	mutex->lock_count = 1U;
+	mutex->owner_orig_prio = owner->base.prio;
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
+
 static int32_t new_prio_for_inheritance(int32_t target, int32_t limit)
 {
 	int new_prio = z_is_prio_higher(target, limit) ? target : limit;
@@ -116,6 +137,82 @@ static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 	return false;
 }
 
+/* must be called with lock held */
+static inline void mutex_take(struct k_mutex *mutex)
+{
+	mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
+				_current->base.prio :
+				mutex->owner_orig_prio;
+
+	mutex->lock_count++;
+	mutex->owner = _current;
+
+	LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
+		_current, mutex, mutex->lock_count,
+		mutex->owner_orig_prio);
+}
+
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+static atomic_t spin_acquired, spin_blocked, blocked;
+
+/* Also polled without the lock while spinning, hence the volatile reads */
+static bool running_elsewhere(struct k_thread *thread)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct k_thread *current =
+			*(struct k_thread * volatile *)&_kernel.cpus[i].current;
+
+		if (i != _current_cpu->id && current == thread) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/* Busy-wait for a running owner to release the mutex.  Spinning only
+ * pays off if the owner is on another CPU and the release will not be
+ * a direct hand-off to an already pending waiter, so both are rechecked
+ * on every iteration.  Called and returns with lock held; returns true
+ * if the mutex is free.
+ */
+static bool mutex_spin(struct k_mutex *mutex, k_spinlock_key_t *key)
+{
+	uint32_t start = k_cycle_get_32();
+	uint32_t limit = k_us_to_cyc_ceil32(CONFIG_MUTEX_ADAPTIVE_SPIN_USEC);
+	struct k_thread *owner = mutex->owner;
+
+	if ((z_waitq_head(&mutex->wait_q) != NULL) ||
+	    !running_elsewhere(owner)) {
+		atomic_inc(&blocked);
+		return false;
+	}
+
+	k_spin_unlock(&lock, *key);
+	while ((*(volatile uint32_t *)&mutex->lock_count != 0U) &&
+	       (*(struct k_thread * volatile *)&mutex->owner == owner) &&
+	       running_elsewhere(owner) &&
+	       (z_waitq_head(&mutex->wait_q) == NULL) &&
+	       ((k_cycle_get_32() - start) < limit)) {
+	}
+	*key = k_spin_lock(&lock);
+
+	if (mutex->lock_count == 0U) {
+		atomic_inc(&spin_acquired);
+		return true;
+	}
+
+	atomic_inc(&spin_blocked);
+	return false;
+}
+
+void k_mutex_spin_stats_get(struct k_mutex_spin_stats *stats)
+{
+	stats->spin_acquired = atomic_get(&spin_acquired);
+	stats->spin_blocked = atomic_get(&spin_blocked);
+	stats->blocked = atomic_get(&blocked);
+}
+#endif /* CONFIG_MUTEX_ADAPTIVE_SPIN */
+
 int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 {
 	int new_prio;
@@ -128,17 +225,7 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 	key = k_spin_lock(&lock);
 
 	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
-
-		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
-					_current->base.prio :
-					mutex->owner_orig_prio;
-
-		mutex->lock_count++;
-		mutex->owner = _current;
-
-		LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
-			_current, mutex, mutex->lock_count,
-			mutex->owner_orig_prio);
+		mutex_take(mutex);
 
 		k_spin_unlock(&lock, key);
 		sys_trace_end_call(SYS_TRACE_ID_MUTEX_LOCK);
@@ -152,6 +239,17 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		return -EBUSY;
 	}
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+	if (mutex_spin(mutex, &key)) {
+		mutex_take(mutex);
+
+		k_spin_unlock(&lock, key);
+		sys_trace_end_call(SYS_TRACE_ID_MUTEX_LOCK);
+
+		return 0;
+	}
+#endif
+
 	new_prio = new_prio_for_inheritance(_current->base.prio,
 					    mutex->owner->base.prio);
 
@@ -133,6 +133,8 @@ void k_pipe_init(struct k_pipe *pipe, unsigned char *buffer, size_t size)
 	pipe->bytes_used = 0;
 	pipe->read_index = 0;
 	pipe->write_index = 0;
+	pipe->put_claim = 0;
+	pipe->get_claim = 0;
 	pipe->lock = (struct k_spinlock){};
 	z_waitq_init(&pipe->wait_q.writers);
 	z_waitq_init(&pipe->wait_q.readers);
@@ -446,6 +448,18 @@ int z_pipe_put_internal(struct k_pipe *pipe, struct k_pipe_async *async_desc,
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
+	/* The buffer's write position belongs to the claimer */
+	if (pipe->put_claim != 0) {
+		k_spin_unlock(&pipe->lock, key);
+		*bytes_written = 0;
+#if (CONFIG_NUM_PIPE_ASYNC_MSGS > 0)
+		if (async_desc != NULL) {
+			pipe_async_finish(async_desc);
+		}
+#endif
+		return -EBUSY;
+	}
+
 	/*
 	 * Create a list of "working readers" into which the data will be
 	 * directly copied.
@@ -602,6 +616,13 @@ int z_impl_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
+	/* The buffer's read position belongs to the claimer */
+	if (pipe->get_claim != 0) {
+		k_spin_unlock(&pipe->lock, key);
+		*bytes_read = 0;
+		return -EBUSY;
+	}
+
 	/*
 	 * Create a list of "working readers" into which the data will be
 	 * directly copied.
@@ -804,6 +825,261 @@ void k_pipe_block_put(struct k_pipe *pipe, struct k_mem_block *block,
 }
 #endif
 
+/**
+ * @brief Serve pended readers from the pipe's circular buffer
+ *
+ * Called with @a pipe's lock held after data was committed to the buffer;
+ * releases the lock.  Readers waiting for a get claim have nothing to
+ * transfer and are only woken up to retry.
+ */
+static void pipe_readers_fill(struct k_pipe *pipe, k_spinlock_key_t key)
+{
+	struct k_thread    *reader;
+	struct k_thread    *thread;
+	struct k_pipe_desc *desc;
+	sys_dlist_t    xfer_list;
+	size_t         bytes_copied;
+
+	(void)pipe_xfer_prepare(&xfer_list, &reader, &pipe->wait_q.readers,
+				0, pipe->bytes_used, 0, K_FOREVER);
+
+	if (sys_dlist_is_empty(&xfer_list) && reader == NULL) {
+		k_spin_unlock(&pipe->lock, key);
+		return;
+	}
+
+	z_sched_lock();
+	k_spin_unlock(&pipe->lock, key);
+
+	thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	while (thread != NULL) {
+		desc = (struct k_pipe_desc *)thread->base.swap_data;
+		bytes_copied = pipe_buffer_get(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		z_ready_thread(thread);
+
+		thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	}
+
+	if (reader != NULL) {
+		desc = (struct k_pipe_desc *)reader->base.swap_data;
+		bytes_copied = pipe_buffer_get(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+	}
+
+	k_sched_unlock();
+}
+
+/**
+ * @brief Move data of pended writers into the pipe's circular buffer
+ *
+ * Called with @a pipe's lock held after buffer space was released;
+ * releases the lock.  Writers waiting for a put claim have nothing to
+ * transfer and are only woken up to retry.
+ */
+static void pipe_writers_drain(struct k_pipe *pipe, k_spinlock_key_t key)
+{
+	struct k_thread    *writer;
+	struct k_thread    *thread;
+	struct k_pipe_desc *desc;
+	sys_dlist_t    xfer_list;
+	size_t         bytes_copied;
+
+	(void)pipe_xfer_prepare(&xfer_list, &writer, &pipe->wait_q.writers,
+				0, pipe->size - pipe->bytes_used, 0,
+				K_FOREVER);
+
+	if (sys_dlist_is_empty(&xfer_list) && writer == NULL) {
+		k_spin_unlock(&pipe->lock, key);
+		return;
+	}
+
+	z_sched_lock();
+	k_spin_unlock(&pipe->lock, key);
+
+	thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	while (thread != NULL) {
+		desc = (struct k_pipe_desc *)thread->base.swap_data;
+		bytes_copied = pipe_buffer_put(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		pipe_thread_ready(thread);
+
+		thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	}
+
+	if (writer != NULL) {
+		desc = (struct k_pipe_desc *)writer->base.swap_data;
+		bytes_copied = pipe_buffer_put(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+	}
+
+	k_sched_unlock();
+}
+
+/* Contiguous free bytes at the write position */
+static size_t pipe_put_run(struct k_pipe *pipe)
+{
+	return MIN(pipe->size - pipe->bytes_used,
+		   pipe->size - pipe->write_index);
+}
+
+/* Contiguous used bytes at the read position */
+static size_t pipe_get_run(struct k_pipe *pipe)
+{
+	return MIN(pipe->bytes_used, pipe->size - pipe->read_index);
+}
+
+/**
+ * @brief Wait until a claim can be made
+ *
+ * The waiting thread pends on @a wait_q with an empty descriptor, so
+ * pipe transfers only wake it up.  Must be called with the lock held;
+ * returns with it held.
+ *
+ * @return 0 if @a run bytes can be claimed, otherwise a negative errno
+ */
+static int pipe_claim_wait(struct k_pipe *pipe, k_spinlock_key_t *key,
+			   _wait_q_t *wait_q, const size_t *claim,
+			   size_t (*run)(struct k_pipe *pipe),
+			   k_timeout_t timeout)
+{
+	struct k_pipe_desc pipe_desc = { .buffer = NULL, .bytes_to_xfer = 0 };
+	int64_t now, end = z_timeout_end_calc(timeout);
+
+	while (true) {
+		k_timeout_t remaining = timeout;
+
+		/* Checked on every pass: another claimer may have won */
+		if (*claim != 0) {
+			return -EBUSY;
+		}
+		if (run(pipe) != 0) {
+			return 0;
+		}
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -EIO;
+		}
+		if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			now = z_tick_get();
+			if (end - now <= 0) {
+				return -EAGAIN;
+			}
+			remaining = K_TICKS(end - now);
+		}
+
+		/* Transfers ready waiters without a return value: recheck */
+		_current->base.swap_data = &pipe_desc;
+		(void)z_pend_curr(&pipe->lock, *key, wait_q, remaining);
+		*key = k_spin_lock(&pipe->lock);
+	}
+}
+
+int k_pipe_put_claim(struct k_pipe *pipe, uint8_t **data, size_t size,
+		     k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	CHECKIF(size == 0 || pipe->size == 0) {
+		return -EINVAL;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	int result;
+
+	result = pipe_claim_wait(pipe, &key, &pipe->wait_q.writers,
+				 &pipe->put_claim, pipe_put_run, timeout);
+	if (result == 0) {
+		pipe->put_claim = MIN(pipe_put_run(pipe), size);
+		*data = pipe->buffer + pipe->write_index;
+		result = (int)pipe->put_claim;
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return result;
+}
+
+int k_pipe_put_commit(struct k_pipe *pipe, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	if (pipe->put_claim == 0 || size > pipe->put_claim) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->put_claim = 0;
+	pipe->bytes_used += size;
+	pipe->write_index += size;
+	if (pipe->write_index == pipe->size) {
+		pipe->write_index = 0;
+	}
+
+	pipe_readers_fill(pipe, key);
+
+	return 0;
+}
+
+int k_pipe_get_claim(struct k_pipe *pipe, uint8_t **data, size_t size,
+		     k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	CHECKIF(size == 0 || pipe->size == 0) {
+		return -EINVAL;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	int result;
+
+	result = pipe_claim_wait(pipe, &key, &pipe->wait_q.readers,
+				 &pipe->get_claim, pipe_get_run, timeout);
+	if (result == 0) {
+		pipe->get_claim = MIN(pipe_get_run(pipe), size);
+		*data = pipe->buffer + pipe->read_index;
+		result = (int)pipe->get_claim;
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return result;
+}
+
+int k_pipe_get_release(struct k_pipe *pipe, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	if (pipe->get_claim == 0 || size > pipe->get_claim) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->get_claim = 0;
+	pipe->bytes_used -= size;
+	pipe->read_index += size;
+	if (pipe->read_index == pipe->size) {
+		pipe->read_index = 0;
+	}
+
+	pipe_writers_drain(pipe, key);
+
+	return 0;
+}
+
 size_t z_impl_k_pipe_read_avail(struct k_pipe *pipe)
 {
 	size_t res;
@@ -73,6 +73,14 @@ static inline bool is_condition_met(struct k_poll_event *event, uint32_t *state)
 			return true;
 		}
 		break;
+#ifdef CONFIG_EVENTS
+	case K_POLL_TYPE_EVENTS_POSTED:
+		if (event->event_obj->events != 0U) {
+			*state = K_POLL_STATE_EVENTS_POSTED;
+			return true;
+		}
+		break;
+#endif
 	case K_POLL_TYPE_IGNORE:
 		break;
 	default:
@@ -107,6 +115,8 @@ static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 	sys_dlist_append(events, &event->_node);
 }
 
+static int signal_poll_event(struct k_poll_event *event, uint32_t state);
+
 /* must be called with interrupts locked */
 static inline int register_event(struct k_poll_event *event,
 				 struct _poller *poller)
@@ -119,11 +129,30 @@ static inline int register_event(struct k_poll_event *event,
 	case K_POLL_TYPE_DATA_AVAILABLE:
 		__ASSERT(event->queue != NULL, "invalid queue\n");
 		add_event(&event->queue->poll_events, event, poller);
+#ifdef CONFIG_QUEUE_LOCKLESS
+		/* Lockless appends only signal registered pollers, recheck
+		 * for one that slipped in after the condition was checked.
+		 */
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+		if (atomic_ptr_get(&event->queue->pending) != NULL) {
+			sys_dlist_remove(&event->_node);
+			event->poller = poller;
+			(void)signal_poll_event(event,
+					K_POLL_STATE_FIFO_DATA_AVAILABLE);
+			return 0;
+		}
+#endif
 		break;
 	case K_POLL_TYPE_SIGNAL:
 		__ASSERT(event->signal != NULL, "invalid poll signal\n");
 		add_event(&event->signal->poll_events, event, poller);
 		break;
+#ifdef CONFIG_EVENTS
+	case K_POLL_TYPE_EVENTS_POSTED:
+		__ASSERT(event->event_obj != NULL, "invalid event object\n");
+		add_event(&event->event_obj->poll_events, event, poller);
+		break;
+#endif
 	case K_POLL_TYPE_IGNORE:
 		/* nothing to do */
 		break;
@@ -157,6 +186,12 @@ static inline void clear_event_registration(struct k_poll_event *event)
 		__ASSERT(event->signal != NULL, "invalid poll signal\n");
 		remove = true;
 		break;
+#ifdef CONFIG_EVENTS
+	case K_POLL_TYPE_EVENTS_POSTED:
+		__ASSERT(event->event_obj != NULL, "invalid event object\n");
+		remove = true;
+		break;
+#endif
 	case K_POLL_TYPE_IGNORE:
 		/* nothing to do */
 		break;
@@ -357,6 +392,11 @@ static inline int z_vrfy_k_poll(struct k_poll_event *events,
 		case K_POLL_TYPE_DATA_AVAILABLE:
 			Z_OOPS(Z_SYSCALL_OBJ(e->queue, K_OBJ_QUEUE));
 			break;
+#ifdef CONFIG_EVENTS
+		case K_POLL_TYPE_EVENTS_POSTED:
+			Z_OOPS(Z_SYSCALL_OBJ(e->event_obj, K_OBJ_EVENT));
+			break;
+#endif
 		default:
 			ret = -EINVAL;
 			goto out_free;
@@ -482,6 +522,145 @@ static inline void z_vrfy_k_poll_signal_reset(struct k_poll_signal *signal)
 
 #endif
 
+/* Called with interrupts locked when an event of a poll set triggers.
+ * The event has just been unlinked from its object, so its node is
+ * free to put it on the set's ready list.
+ */
+static int poll_set_cb(struct k_poll_event *event, uint32_t state)
+{
+	struct k_poll_set *set =
+		CONTAINER_OF(event->poller, struct k_poll_set, poller);
+	struct k_thread *thread;
+
+	ARG_UNUSED(state);
+
+	sys_dlist_append(&set->ready, &event->_node);
+
+	thread = z_unpend_first_thread(&set->wait_q);
+	if (thread != NULL) {
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+	}
+
+	return 0;
+}
+
+/* must be called with interrupts locked */
+static void poll_set_arm(struct k_poll_set *set, struct k_poll_event *event)
+{
+	uint32_t state;
+
+	if (is_condition_met(event, &state)) {
+		event->state |= state;
+		sys_dlist_append(&set->ready, &event->_node);
+	} else {
+		(void)register_event(event, &set->poller);
+	}
+}
+
+void k_poll_set_init(struct k_poll_set *set)
+{
+	set->poller.is_polling = true;
+	set->poller.thread = _current;
+	set->poller.cb = poll_set_cb;
+	sys_dlist_init(&set->ready);
+	sys_dlist_init(&set->reported);
+	z_waitq_init(&set->wait_q);
+}
+
+void k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	__ASSERT(!sys_dnode_is_linked(&event->_node), "event already in use");
+
+	event->state = K_POLL_STATE_NOT_READY;
+	poll_set_arm(set, event);
+
+	k_spin_unlock(&lock, key);
+}
+
+void k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	ARG_UNUSED(set);
+
+	/* Whether registered with its object or on one of the set's
+	 * lists, the event is linked through its node.
+	 */
+	if (sys_dnode_is_linked(&event->_node)) {
+		sys_dlist_remove(&event->_node);
+	}
+	event->poller = NULL;
+
+	k_spin_unlock(&lock, key);
+}
+
+/* must be called with interrupts locked */
+static int poll_set_collect(struct k_poll_set *set,
+			    struct k_poll_event **ready_events, int max_events)
+{
+	int count = 0;
+	sys_dnode_t *node;
+
+	while (count < max_events &&
+	       (node = sys_dlist_get(&set->ready)) != NULL) {
+		struct k_poll_event *event =
+			CONTAINER_OF(node, struct k_poll_event, _node);
+
+		sys_dlist_append(&set->reported, &event->_node);
+		ready_events[count++] = event;
+	}
+
+	return count;
+}
+
+int k_poll_set_wait(struct k_poll_set *set,
+		    struct k_poll_event **ready_events, int max_events,
+		    k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	sys_dnode_t *node;
+	int count;
+
+	__ASSERT(!arch_is_in_isr(), "");
+	__ASSERT(max_events > 0, "");
+
+	key = k_spin_lock(&lock);
+
+	/* Re-arm what the previous call handed out: only those events
+	 * need their condition checked again.
+	 */
+	while ((node = sys_dlist_get(&set->reported)) != NULL) {
+		struct k_poll_event *event =
+			CONTAINER_OF(node, struct k_poll_event, _node);
+
+		event->state = K_POLL_STATE_NOT_READY;
+		poll_set_arm(set, event);
+		k_spin_unlock(&lock, key);
+		key = k_spin_lock(&lock);
+	}
+
+	count = poll_set_collect(set, ready_events, max_events);
+	if (count > 0 || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		k_spin_unlock(&lock, key);
+		return count > 0 ? count : -EAGAIN;
+	}
+
+	int swap_rc = z_pend_curr(&lock, key, &set->wait_q, timeout);
+
+	if (swap_rc != 0) {
+		return swap_rc;
+	}
+
+	key = k_spin_lock(&lock);
+	count = poll_set_collect(set, ready_events, max_events);
+	k_spin_unlock(&lock, key);
+
+	return count;
+}
+
 static void triggered_work_handler(struct k_work *work)
 {
 	k_work_handler_t handler;
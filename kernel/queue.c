@@ -81,6 +81,10 @@ void z_impl_k_queue_init(struct k_queue *queue)
 	sys_sflist_init(&queue->data_q);
 	queue->lock = (struct k_spinlock) {};
 	z_waitq_init(&queue->wait_q);
+#ifdef CONFIG_QUEUE_LOCKLESS
+	queue->pending = NULL;
+	queue->waiters = ATOMIC_INIT(0);
+#endif
 #if defined(CONFIG_POLL)
 	sys_dlist_init(&queue->poll_events);
 #endif
@@ -111,6 +115,124 @@ static inline void handle_poll_events(struct k_queue *queue, uint32_t state)
 #endif
 }
 
+#ifdef CONFIG_QUEUE_LOCKLESS
+/*
+ * Lockless appends push items on queue->pending with a CAS as long as
+ * nobody waits for the queue.  Consumers and every locked operation first
+ * move the pending items to data_q under the lock, restoring FIFO order.
+ *
+ * A consumer about to pend (or a poller registering) announces itself,
+ * then rechecks pending; a producer pushes, then rechecks for waiters.
+ * The full fences order both sides, so at least one of them sees the
+ * other and the item is handed over under the lock.
+ */
+static inline bool queue_has_waiters(struct k_queue *queue)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	if (atomic_get(&queue->waiters) != 0) {
+		return true;
+	}
+#ifdef CONFIG_POLL
+	if (!sys_dlist_is_empty(&queue->poll_events)) {
+		return true;
+	}
+#endif
+	return false;
+}
+
+/* must be called with queue->lock held */
+static bool queue_drain_pending(struct k_queue *queue)
+{
+	sys_sfnode_t *node, *next, *head = NULL, *tail;
+
+	if (atomic_ptr_get(&queue->pending) == NULL) {
+		return false;
+	}
+
+	node = atomic_ptr_set(&queue->pending, NULL);
+	tail = node;
+	while (node != NULL) {
+		next = (sys_sfnode_t *)node->next_and_flags;
+		node->next_and_flags = (unative_t)head;
+		head = node;
+		node = next;
+	}
+
+	sys_sflist_append_list(&queue->data_q, head, tail);
+	return true;
+}
+
+/* Move pending items to data_q and hand them to waiting threads, returns
+ * true if a thread was woken.  Must be called with queue->lock held.
+ */
+static bool queue_flush(struct k_queue *queue)
+{
+	struct k_thread *thread;
+	bool woken = false;
+
+	if (!queue_drain_pending(queue)) {
+		return false;
+	}
+
+	while (!sys_sflist_is_empty(&queue->data_q)) {
+		thread = z_unpend_first_thread(&queue->wait_q);
+		if (thread == NULL) {
+			break;
+		}
+		prepare_thread_to_run(thread, z_queue_node_peek(
+			sys_sflist_get_not_empty(&queue->data_q), true));
+		woken = true;
+	}
+
+	if (!sys_sflist_is_empty(&queue->data_q)) {
+		handle_poll_events(queue, K_POLL_STATE_DATA_AVAILABLE);
+	}
+
+	return woken;
+}
+
+void z_queue_flush_pending(struct k_queue *queue)
+{
+	k_spinlock_key_t key;
+
+	if (atomic_ptr_get(&queue->pending) == NULL) {
+		return;
+	}
+
+	key = k_spin_lock(&queue->lock);
+	if (queue_flush(queue)) {
+		z_reschedule(&queue->lock, key);
+	} else {
+		k_spin_unlock(&queue->lock, key);
+	}
+}
+
+static bool queue_append_lockless(struct k_queue *queue, void *data)
+{
+	sys_sfnode_t *node = data;
+	void *head;
+
+	if (queue_has_waiters(queue)) {
+		return false;
+	}
+
+	do {
+		head = atomic_ptr_get(&queue->pending);
+		node->next_and_flags = (unative_t)head;
+	} while (!atomic_ptr_cas(&queue->pending, head, node));
+
+	/* A consumer may have started waiting before seeing the item */
+	if (queue_has_waiters(queue)) {
+		k_spinlock_key_t key = k_spin_lock(&queue->lock);
+
+		(void)queue_flush(queue);
+		z_reschedule(&queue->lock, key);
+	}
+
+	return true;
+}
+#endif /* CONFIG_QUEUE_LOCKLESS */
+
 void z_impl_k_queue_cancel_wait(struct k_queue *queue)
 {
 	k_spinlock_key_t key = k_spin_lock(&queue->lock);
@@ -136,11 +258,19 @@ static inline void z_vrfy_k_queue_cancel_wait(struct k_queue *queue)
 #endif
 
 static int32_t queue_insert(struct k_queue *queue, void *prev, void *data,
-			  bool alloc)
+			  bool alloc, bool is_append)
 {
 	k_spinlock_key_t key = k_spin_lock(&queue->lock);
 	struct k_thread *first_pending_thread;
 
+#ifdef CONFIG_QUEUE_LOCKLESS
+	(void)queue_flush(queue);
+#endif
+
+	if (is_append) {
+		prev = sys_sflist_peek_tail(&queue->data_q);
+	}
+
 	first_pending_thread = z_unpend_first_thread(&queue->wait_q);
 
 	if (first_pending_thread != NULL) {
@@ -173,24 +303,27 @@ static int32_t queue_insert(struct k_queue *queue, void *prev, void *data,
 
 void k_queue_insert(struct k_queue *queue, void *prev, void *data)
 {
-	(void)queue_insert(queue, prev, data, false);
+	(void)queue_insert(queue, prev, data, false, false);
 }
 
 void k_queue_append(struct k_queue *queue, void *data)
 {
-	(void)queue_insert(queue, sys_sflist_peek_tail(&queue->data_q),
-			   data, false);
+#ifdef CONFIG_QUEUE_LOCKLESS
+	if (queue_append_lockless(queue, data)) {
+		return;
+	}
+#endif
+	(void)queue_insert(queue, NULL, data, false, true);
 }
 
 void k_queue_prepend(struct k_queue *queue, void *data)
 {
-	(void)queue_insert(queue, NULL, data, false);
+	(void)queue_insert(queue, NULL, data, false, false);
 }
 
 int32_t z_impl_k_queue_alloc_append(struct k_queue *queue, void *data)
 {
-	return queue_insert(queue, sys_sflist_peek_tail(&queue->data_q), data,
-			    true);
+	return queue_insert(queue, NULL, data, true, true);
 }
 
 #ifdef CONFIG_USERSPACE
@@ -205,7 +338,7 @@ static inline int32_t z_vrfy_k_queue_alloc_append(struct k_queue *queue,
 
 int32_t z_impl_k_queue_alloc_prepend(struct k_queue *queue, void *data)
 {
-	return queue_insert(queue, NULL, data, true);
+	return queue_insert(queue, NULL, data, true, false);
 }
 
 #ifdef CONFIG_USERSPACE
@@ -228,6 +361,10 @@ int k_queue_append_list(struct k_queue *queue, void *head, void *tail)
 	k_spinlock_key_t key = k_spin_lock(&queue->lock);
 	struct k_thread *thread = NULL;
 
+#ifdef CONFIG_QUEUE_LOCKLESS
+	(void)queue_flush(queue);
+#endif
+
 	if (head != NULL) {
 		thread = z_unpend_first_thread(&queue->wait_q);
 	}
@@ -279,6 +416,10 @@ void *z_impl_k_queue_get(struct k_queue *queue, k_timeout_t timeout)
 	k_spinlock_key_t key = k_spin_lock(&queue->lock);
 	void *data;
 
+#ifdef CONFIG_QUEUE_LOCKLESS
+	(void)queue_drain_pending(queue);
+#endif
+
 	if (likely(!sys_sflist_is_empty(&queue->data_q))) {
 		sys_sfnode_t *node;
 
@@ -293,11 +434,86 @@ void *z_impl_k_queue_get(struct k_queue *queue, k_timeout_t timeout)
 		return NULL;
 	}
 
+#ifdef CONFIG_QUEUE_LOCKLESS
+	/* Stop lockless appends, then catch any that raced with us */
+	atomic_inc(&queue->waiters);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	if (queue_drain_pending(queue)) {
+		atomic_dec(&queue->waiters);
+		data = z_queue_node_peek(
+			sys_sflist_get_not_empty(&queue->data_q), true);
+		k_spin_unlock(&queue->lock, key);
+		return data;
+	}
+#endif
+
 	int ret = z_pend_curr(&queue->lock, key, &queue->wait_q, timeout);
 
+#ifdef CONFIG_QUEUE_LOCKLESS
+	atomic_dec(&queue->waiters);
+#endif
+
 	return (ret != 0) ? NULL : _current->base.swap_data;
 }
 
+int k_queue_get_batch(struct k_queue *queue, sys_slist_t *list,
+		      k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	sys_sfnode_t *head, *tail, *node;
+	void *first = NULL;
+	int count = 0;
+
+	key = k_spin_lock(&queue->lock);
+#ifdef CONFIG_QUEUE_LOCKLESS
+	(void)queue_drain_pending(queue);
+#endif
+
+	if (sys_sflist_is_empty(&queue->data_q)) {
+		k_spin_unlock(&queue->lock, key);
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return 0;
+		}
+
+		/* Wait for one item, then take whatever came with it */
+		first = z_impl_k_queue_get(queue, timeout);
+		if (first == NULL) {
+			return 0;
+		}
+
+		key = k_spin_lock(&queue->lock);
+#ifdef CONFIG_QUEUE_LOCKLESS
+		(void)queue_drain_pending(queue);
+#endif
+	}
+
+	head = sys_sflist_peek_head(&queue->data_q);
+	tail = sys_sflist_peek_tail(&queue->data_q);
+	sys_sflist_init(&queue->data_q);
+	k_spin_unlock(&queue->lock, key);
+
+	if (first != NULL) {
+		sys_slist_append(list, first);
+		count++;
+	}
+
+	/* Items added without allocation have no flags, so the detached
+	 * sflist is a valid slist.
+	 */
+	for (node = head; node != NULL;
+	     node = sys_sflist_peek_next_no_check(node)) {
+		__ASSERT(sys_sfnode_flags_get(node) == 0U,
+			 "allocated item in batch");
+		count++;
+	}
+
+	if (head != NULL) {
+		sys_slist_append_list(list, head, tail);
+	}
+
+	return count;
+}
+
 #ifdef CONFIG_USERSPACE
 static inline void *z_vrfy_k_queue_get(struct k_queue *queue,
 				       k_timeout_t timeout)
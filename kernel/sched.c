@@ -53,7 +53,7 @@ LOG_MODULE_DECLARE(os);
 #endif
 
 /* the only struct z_kernel instance */
-struct z_kernel _kernel;
+__hot_bss struct z_kernel _kernel;
 
 static struct k_spinlock sched_spinlock;
 
@@ -350,7 +350,7 @@ static void update_metairq_preempt(struct k_thread *thread)
 #endif
 }
 
-static void update_cache(int preempt_ok)
+static __hot_text void update_cache(int preempt_ok)
 {
 #ifndef CONFIG_SMP
 	struct k_thread *thread = next_up();
@@ -391,7 +391,7 @@ static void ready_thread(struct k_thread *thread)
 	}
 }
 
-void z_ready_thread(struct k_thread *thread)
+__hot_text void z_ready_thread(struct k_thread *thread)
 {
 	LOCKED(&sched_spinlock) {
 		ready_thread(thread);
@@ -485,6 +485,10 @@ void z_thread_single_abort(struct k_thread *thread)
 
 	(void)z_abort_thread_timeout(thread);
 
+#ifdef CONFIG_FPU_SHARING_LAZY
+	arch_float_lazy_abort(thread);
+#endif
+
 	if (IS_ENABLED(CONFIG_SMP)) {
 		z_sched_abort(thread);
 	}
@@ -670,7 +674,7 @@ int z_pend_curr_irqlock(uint32_t key, _wait_q_t *wait_q, k_timeout_t timeout)
 #endif
 }
 
-int z_pend_curr(struct k_spinlock *lock, k_spinlock_key_t key,
+__hot_text int z_pend_curr(struct k_spinlock *lock, k_spinlock_key_t key,
 	       _wait_q_t *wait_q, k_timeout_t timeout)
 {
 #if defined(CONFIG_TIMESLICING) && defined(CONFIG_SWAP_NONATOMIC)
@@ -680,7 +684,7 @@ int z_pend_curr(struct k_spinlock *lock, k_spinlock_key_t key,
 	return z_swap(lock, key);
 }
 
-struct k_thread *z_unpend_first_thread(_wait_q_t *wait_q)
+__hot_text struct k_thread *z_unpend_first_thread(_wait_q_t *wait_q)
 {
 	struct k_thread *thread = z_unpend1_no_timeout(wait_q);
 
@@ -766,7 +770,7 @@ static inline bool need_swap(void)
 #endif
 }
 
-void z_reschedule(struct k_spinlock *lock, k_spinlock_key_t key)
+__hot_text void z_reschedule(struct k_spinlock *lock, k_spinlock_key_t key)
 {
 	if (resched(key.key) && need_swap()) {
 		z_swap(lock, key);
@@ -831,6 +835,8 @@ static inline void set_current(struct k_thread *new_thread)
 #ifdef CONFIG_USE_SWITCH
 void *z_get_next_switch_handle(void *interrupted)
 {
+	struct k_thread *old_thread = _current;
+
 	_current->switch_handle = interrupted;
 
 	z_check_stack_sentinel();
@@ -861,6 +867,10 @@ void *z_get_next_switch_handle(void *interrupted)
 	set_current(z_get_next_ready_thread());
 #endif
 
+	if (_current != old_thread) {
+		z_thread_mark_switched_in();
+	}
+
 	wait_for_switch(_current);
 	return _current->switch_handle;
 }
@@ -883,7 +893,7 @@ ALWAYS_INLINE void z_priq_dumb_add(sys_dlist_t *pq, struct k_thread *thread)
 	sys_dlist_append(pq, &thread->base.qnode_dlist);
 }
 
-void z_priq_dumb_remove(sys_dlist_t *pq, struct k_thread *thread)
+__hot_text void z_priq_dumb_remove(sys_dlist_t *pq, struct k_thread *thread)
 {
 #if defined(CONFIG_SWAP_NONATOMIC) && defined(CONFIG_SCHED_DUMB)
 	if (pq == &_kernel.ready_q.runq && thread == _current &&
@@ -897,7 +907,7 @@ void z_priq_dumb_remove(sys_dlist_t *pq, struct k_thread *thread)
 	sys_dlist_remove(&thread->base.qnode_dlist);
 }
 
-struct k_thread *z_priq_dumb_best(sys_dlist_t *pq)
+__hot_text struct k_thread *z_priq_dumb_best(sys_dlist_t *pq)
 {
 	struct k_thread *thread = NULL;
 	sys_dnode_t *n = sys_dlist_peek_head(pq);
@@ -1135,7 +1145,7 @@ static inline void z_vrfy_k_thread_deadline_set(k_tid_t tid, int deadline)
 #endif
 #endif
 
-void z_impl_k_yield(void)
+__hot_text void z_impl_k_yield(void)
 {
 	__ASSERT(!arch_is_in_isr(), "");
 
@@ -104,7 +104,7 @@ static inline void handle_poll_events(struct k_sem *sem)
 #endif
 }
 
-void z_impl_k_sem_give(struct k_sem *sem)
+__hot_text void z_impl_k_sem_give(struct k_sem *sem)
 {
 	k_spinlock_key_t key = k_spin_lock(&lock);
 	struct k_thread *thread = z_unpend_first_thread(&sem->wait_q);
@@ -132,7 +132,7 @@ static inline void z_vrfy_k_sem_give(struct k_sem *sem)
 #include <syscalls/k_sem_give_mrsh.c>
 #endif
 
-int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
+__hot_text int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 {
 	int ret = 0;
 
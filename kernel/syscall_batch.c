@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <syscall_handler.h>
+#include <kernel_structs.h>
+
+int z_impl_k_syscall_batch_run(struct k_syscall_batch_entry *entries,
+			       uint32_t count)
+{
+	/* Supervisor threads run batched calls as they queue them */
+	ARG_UNUSED(entries);
+	ARG_UNUSED(count);
+
+	return 0;
+}
+
+static int z_vrfy_k_syscall_batch_run(struct k_syscall_batch_entry *entries,
+				      uint32_t count)
+{
+	/* Each handler takes over and then clears the syscall frame */
+	void *ssf = _current->syscall_frame;
+	struct k_syscall_batch_entry entry;
+	uintptr_t id;
+
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(entries, count, sizeof(*entries)));
+
+	for (uint32_t i = 0; i < count; i++) {
+		/* Work on a copy other user threads can't change under us */
+		entry = entries[i];
+		id = entry.id;
+
+		if (id == K_SYSCALL_LIMIT) {
+			continue;
+		}
+
+		/* Batches don't nest; the bad syscall handler oopses */
+		if (id >= K_SYSCALL_BAD || id == K_SYSCALL_K_SYSCALL_BATCH_RUN) {
+			entry.args[0] = id;
+			id = K_SYSCALL_BAD;
+		}
+
+		entries[i].ret = _k_syscall_table[id](entry.args[0],
+						      entry.args[1],
+						      entry.args[2],
+						      entry.args[3],
+						      entry.args[4],
+						      entry.args[5], ssf);
+	}
+
+	return 0;
+}
+#include <syscalls/k_syscall_batch_run_mrsh.c>
@@ -26,6 +26,7 @@
 #include <stdbool.h>
 #include <irq_offload.h>
 #include <sys/check.h>
+#include <sys/mutex.h>
 #include <random/rand32.h>
 
 #define LOG_LEVEL CONFIG_KERNEL_LOG_LEVEL
@@ -180,6 +181,24 @@ static inline void *z_vrfy_k_thread_custom_data_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_THREAD_CUSTOM_DATA */
 
+#ifdef CONFIG_INSTRUMENT_THREAD_SWITCHING
+void z_thread_mark_switched_in(void)
+{
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	z_thread_runtime_switched_in();
+#endif
+#if defined(CONFIG_SYS_MUTEX_FAST_PATH) && !defined(CONFIG_SMP)
+	z_sys_mutex_self = (atomic_val_t)_current;
+#endif
+	sys_trace_thread_switched_in();
+}
+
+void z_thread_mark_switched_out(void)
+{
+	sys_trace_thread_switched_out();
+}
+#endif /* CONFIG_INSTRUMENT_THREAD_SWITCHING */
+
 #if defined(CONFIG_THREAD_MONITOR)
 /*
  * Remove a thread from the kernel's list of active threads.
@@ -539,6 +558,9 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 	new_thread->stack_obj = stack;
 	new_thread->mem_domain_info.mem_domain = NULL;
 	new_thread->syscall_frame = NULL;
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+	(void)memset(&new_thread->obj_cache, 0, sizeof(new_thread->obj_cache));
+#endif
 
 	/* Any given thread has access to itself */
 	k_object_access_grant(new_thread, new_thread);
@@ -592,6 +614,9 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 #ifdef CONFIG_SCHED_CPU_MASK
 	new_thread->base.cpu_mask = -1;
 #endif
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	(void)memset(&new_thread->rt_stats, 0, sizeof(new_thread->rt_stats));
+#endif
 #ifdef CONFIG_ARCH_HAS_CUSTOM_SWAP_TO_MAIN
 	/* _current may be null if the dummy thread is not used */
 	if (!_current) {
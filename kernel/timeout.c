@@ -19,8 +19,6 @@
 
 static uint64_t curr_tick;
 
-static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
-
 static struct k_spinlock timeout_lock;
 
 #define MAX_WAIT (IS_ENABLED(CONFIG_SYSTEM_CLOCK_SLOPPY_IDLE) \
@@ -41,6 +39,185 @@ static inline int z_vrfy_z_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#ifdef CONFIG_TIMEOUT_WHEEL
+/* Hierarchical timing wheel.  Each of the WHEEL_LEVELS levels has
+ * WHEEL_SLOTS slots, and a slot at level L spans WHEEL_SLOTS^L ticks.
+ * Timeouts store their absolute expiry tick in dticks and are filed at
+ * the level of the most significant WHEEL_BITS group in which that
+ * expiry differs from curr_tick.  Level 0 slots thus only hold
+ * timeouts expiring at exactly that tick, and a slot at a higher level
+ * is cascaded down into the lower levels when curr_tick reaches its
+ * first tick.  Expiries too far out for the top level wait on an
+ * overflow list that is refiled each time the top level wraps.
+ *
+ * Slot lists are only valid while their bit is set in
+ * wheel_occupied[], so no initialization pass is needed.
+ */
+#define WHEEL_BITS 6
+#define WHEEL_SLOTS BIT(WHEEL_BITS)
+#define WHEEL_LEVELS CONFIG_TIMEOUT_WHEEL_LEVELS
+#define WHEEL_SPAN_BITS (WHEEL_LEVELS * WHEEL_BITS)
+
+BUILD_ASSERT(WHEEL_SLOTS == 64, "occupancy bitmaps are 64 bits wide");
+
+static sys_dlist_t wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+static uint64_t wheel_occupied[WHEEL_LEVELS];
+static sys_dlist_t wheel_overflow = SYS_DLIST_STATIC_INIT(&wheel_overflow);
+
+/* Cached earliest expiry, recomputed lazily after it is removed */
+static uint64_t wheel_next;
+static bool wheel_next_valid;
+
+static void wheel_insert(struct _timeout *to)
+{
+	uint64_t diff = to->dticks ^ curr_tick;
+	int level = diff == 0U ? 0 : (63 - __builtin_clzll(diff)) / WHEEL_BITS;
+	sys_dlist_t *list = &wheel_overflow;
+
+	if (level < WHEEL_LEVELS) {
+		int slot = (to->dticks >> (level * WHEEL_BITS)) &
+			   (WHEEL_SLOTS - 1);
+
+		list = &wheel[level][slot];
+		if ((wheel_occupied[level] & BIT64(slot)) == 0U) {
+			sys_dlist_init(list);
+			wheel_occupied[level] |= BIT64(slot);
+		}
+	}
+
+	sys_dlist_append(list, &to->node);
+
+	if (wheel_next_valid && to->dticks < wheel_next) {
+		wheel_next = to->dticks;
+	}
+}
+
+static void wheel_slot_release(sys_dlist_t *list)
+{
+	if (list != &wheel_overflow) {
+		int idx = list - &wheel[0][0];
+
+		wheel_occupied[idx / WHEEL_SLOTS] &= ~BIT64(idx % WHEEL_SLOTS);
+	}
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	/* The only node of a list has the list head as both neighbors */
+	sys_dlist_t *list = t->node.next;
+	bool last = t->node.next == t->node.prev;
+
+	sys_dlist_remove(&t->node);
+
+	if (last) {
+		wheel_slot_release(list);
+	}
+
+	if (wheel_next_valid && t->dticks == wheel_next) {
+		wheel_next_valid = false;
+	}
+}
+
+/* Finds the list holding the earliest expiries, and the tick at
+ * which it has to be processed.  Returns NULL if there is none.
+ */
+static sys_dlist_t *wheel_first(uint64_t *tick, int *level)
+{
+	for (int l = 0; l < WHEEL_LEVELS; l++) {
+		if (wheel_occupied[l] != 0U) {
+			int shift = l * WHEEL_BITS;
+			int slot = __builtin_ctzll(wheel_occupied[l]);
+
+			*tick = (curr_tick & ~(BIT64(shift + WHEEL_BITS) - 1)) |
+				((uint64_t)slot << shift);
+			*level = l;
+			return &wheel[l][slot];
+		}
+	}
+
+	if (!sys_dlist_is_empty(&wheel_overflow)) {
+		*tick = ((curr_tick >> WHEEL_SPAN_BITS) + 1) <<
+			WHEEL_SPAN_BITS;
+		*level = WHEEL_LEVELS;
+		return &wheel_overflow;
+	}
+
+	return NULL;
+}
+
+/* Earliest absolute expiry in the wheel, or UINT64_MAX if empty */
+static uint64_t wheel_next_expiry(void)
+{
+	uint64_t tick;
+	int level;
+	sys_dlist_t *list;
+	struct _timeout *t;
+
+	if (wheel_next_valid) {
+		return wheel_next;
+	}
+
+	list = wheel_first(&tick, &level);
+	wheel_next = UINT64_MAX;
+
+	if (list != NULL && level == 0) {
+		wheel_next = tick;
+	} else if (list != NULL) {
+		/* The earliest expiry is somewhere in this slot */
+		SYS_DLIST_FOR_EACH_CONTAINER(list, t, node) {
+			wheel_next = MIN(wheel_next, t->dticks);
+		}
+	}
+
+	wheel_next_valid = true;
+	return wheel_next;
+}
+
+/* Advances curr_tick towards target, cascading higher level slots as
+ * their time comes.  Returns the first timeout expiring at or before
+ * target (already removed from the wheel, with curr_tick set to its
+ * expiry), or NULL once nothing is left to do before target.
+ */
+static struct _timeout *wheel_advance(uint64_t target)
+{
+	uint64_t tick;
+	int level;
+	sys_dlist_t *list;
+
+	while ((list = wheel_first(&tick, &level)) != NULL &&
+	       tick <= target) {
+		sys_dlist_t pending;
+		sys_dnode_t *node;
+
+		curr_tick = tick;
+
+		if (level == 0) {
+			struct _timeout *t = CONTAINER_OF(sys_dlist_peek_head(list),
+							  struct _timeout, node);
+
+			remove_timeout(t);
+			return t;
+		}
+
+		/* Cascade: refile everything from this slot relative to
+		 * the new curr_tick, which always lands at a lower level
+		 * (or back on the overflow list).
+		 */
+		sys_dlist_init(&pending);
+		while ((node = sys_dlist_get(list)) != NULL) {
+			sys_dlist_append(&pending, node);
+		}
+		wheel_slot_release(list);
+		while ((node = sys_dlist_get(&pending)) != NULL) {
+			wheel_insert(CONTAINER_OF(node, struct _timeout, node));
+		}
+	}
+
+	return NULL;
+}
+#else
+static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -63,17 +240,64 @@ static void remove_timeout(struct _timeout *t)
 
 	sys_dlist_remove(&t->node);
 }
+#endif /* CONFIG_TIMEOUT_WHEEL */
 
 static int32_t elapsed(void)
 {
 	return announce_remaining == 0 ? z_clock_elapsed() : 0;
 }
 
+#ifdef CONFIG_TIMEOUT_SLACK
+/* Delays an expiry, in ticks after curr_tick, up to the next multiple of
+ * the largest power of two not above the slack of the timeout, so that
+ * timeouts with similar slacks expire together whatever their phase.
+ * Returns the slack left after this alignment.
+ */
+static uint32_t slack_align(struct _timeout *to, k_ticks_t *dt)
+{
+	uint64_t granule, expiry;
+	uint32_t delay;
+
+	if (to->slack == 0U) {
+		return 0U;
+	}
+
+	granule = BIT64(31 - __builtin_clz(to->slack));
+	expiry = (curr_tick + *dt + granule - 1U) & ~(granule - 1U);
+	delay = expiry - (curr_tick + *dt);
+
+	*dt += delay;
+
+	return to->slack - delay;
+}
+
+void z_timeout_slack_set(struct _timeout *to, k_timeout_t slack)
+{
+	__ASSERT(!K_TIMEOUT_EQ(slack, K_FOREVER), "");
+
+#ifdef CONFIG_LEGACY_TIMEOUT_API
+	to->slack = k_ms_to_ticks_ceil32(slack);
+#else
+	to->slack = (uint32_t)MAX(slack.ticks, 0);
+#endif
+}
+#else
+#define slack_align(to, dt) 0U
+#endif /* CONFIG_TIMEOUT_SLACK */
+
 static int32_t next_timeout(void)
 {
+#ifdef CONFIG_TIMEOUT_WHEEL
+	uint64_t expiry = wheel_next_expiry();
+	int32_t ticks_elapsed = elapsed();
+	int64_t dt = (int64_t)(expiry - curr_tick) - ticks_elapsed;
+	int32_t ret = expiry == UINT64_MAX ? MAX_WAIT :
+		      (int32_t)MIN(MAX(0, dt), INT_MAX);
+#else
 	struct _timeout *to = first();
 	int32_t ticks_elapsed = elapsed();
 	int32_t ret = to == NULL ? MAX_WAIT : MAX(0, to->dticks - ticks_elapsed);
+#endif
 
 #ifdef CONFIG_TIMESLICING
 	if (_current_cpu->slice_ticks && _current_cpu->slice_ticks < ret) {
@@ -105,15 +329,33 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	ticks = MAX(1, ticks);
 
 	LOCKED(&timeout_lock) {
+		k_ticks_t dt = ticks + elapsed();
+		uint32_t slack = slack_align(to, &dt);
+
+#ifdef CONFIG_TIMEOUT_WHEEL
+		ARG_UNUSED(slack);
+
+		to->dticks = curr_tick + dt;
+		wheel_insert(to);
+
+		if (to->dticks == wheel_next_expiry()) {
+			z_clock_set_timeout(next_timeout(), false);
+		}
+#else
 		struct _timeout *t;
 
-		to->dticks = ticks + elapsed();
+		to->dticks = dt;
 		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
+			if (t->dticks > to->dticks + slack) {
 				t->dticks -= to->dticks;
 				sys_dlist_insert(&t->node, &to->node);
 				break;
 			}
+			if (t->dticks > to->dticks) {
+				/* Within the slack, expire along with t */
+				to->dticks = t->dticks;
+				slack = 0U;
+			}
 			to->dticks -= t->dticks;
 		}
 
@@ -124,6 +366,7 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 		if (to == first()) {
 			z_clock_set_timeout(next_timeout(), false);
 		}
+#endif
 	}
 }
 
@@ -150,12 +393,16 @@ static k_ticks_t timeout_rem(struct _timeout *timeout)
 		return 0;
 	}
 
+#ifdef CONFIG_TIMEOUT_WHEEL
+	ticks = timeout->dticks - curr_tick;
+#else
 	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
 		ticks += t->dticks;
 		if (timeout == t) {
 			break;
 		}
 	}
+#endif
 
 	return ticks - elapsed();
 }
@@ -226,6 +473,20 @@ void z_clock_announce(int32_t ticks)
 
 	announce_remaining = ticks;
 
+#ifdef CONFIG_TIMEOUT_WHEEL
+	uint64_t target = curr_tick + ticks;
+	struct _timeout *t;
+
+	while ((t = wheel_advance(target)) != NULL) {
+		announce_remaining = target - curr_tick;
+
+		k_spin_unlock(&timeout_lock, key);
+		t->fn(t);
+		key = k_spin_lock(&timeout_lock);
+	}
+
+	curr_tick = target;
+#else
 	while (first() != NULL && first()->dticks <= announce_remaining) {
 		struct _timeout *t = first();
 		int dt = t->dticks;
@@ -245,6 +506,7 @@ void z_clock_announce(int32_t ticks)
 	}
 
 	curr_tick += announce_remaining;
+#endif
 	announce_remaining = 0;
 
 	z_clock_set_timeout(next_timeout(), false);
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Thread and ISR runtime accounting
+ *
+ * Each CPU charges the cycles elapsed since rt_start to rt_thread, on every
+ * context switch and whenever the statistics are read. With
+ * CONFIG_THREAD_RUNTIME_STATS_ISR, ISRs dispatched from the software ISR
+ * table stop the count of the interrupted thread and are timed per IRQ.
+ *
+ * Only the 32-bit cycle counter is read, so a thread running for longer than
+ * its period without being switched out or read is under-accounted.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <kernel_internal.h>
+#include <spinlock.h>
+#include <sw_isr_table.h>
+#include <errno.h>
+
+/* Serializes the readers. The writers run on their own CPU with
+ * interrupts locked.
+ */
+static struct k_spinlock usage_lock;
+
+#ifdef CONFIG_THREAD_RUNTIME_STATS_ISR
+static uint64_t isr_cycles[IRQ_TABLE_SIZE];
+#endif
+
+static void usage_update(struct _cpu *cpu, uint32_t now)
+{
+	uint32_t cycles = now - cpu->rt_start;
+
+#ifdef CONFIG_THREAD_RUNTIME_STATS_ISR
+	/* The outermost ISR restarts the count when it returns. */
+	if (cpu->rt_isr_nested != 0U) {
+		return;
+	}
+#endif
+
+	if (cpu->rt_thread != NULL) {
+		cpu->rt_thread->rt_stats.execution_cycles += cycles;
+		cpu->rt_total += cycles;
+	}
+
+	cpu->rt_start = now;
+}
+
+void z_thread_runtime_switched_in(void)
+{
+	struct _cpu *cpu = _current_cpu;
+
+	usage_update(cpu, k_cycle_get_32());
+	cpu->rt_thread = _current;
+}
+
+int k_thread_runtime_stats_get(k_tid_t thread,
+			       k_thread_runtime_stats_t *stats)
+{
+	k_spinlock_key_t key;
+
+	if ((thread == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&usage_lock);
+	usage_update(_current_cpu, k_cycle_get_32());
+	*stats = thread->rt_stats;
+	k_spin_unlock(&usage_lock, key);
+
+	return 0;
+}
+
+int k_thread_runtime_stats_all_get(k_thread_runtime_stats_t *stats)
+{
+	k_spinlock_key_t key;
+
+	if (stats == NULL) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&usage_lock);
+	usage_update(_current_cpu, k_cycle_get_32());
+
+	stats->execution_cycles = 0;
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		stats->execution_cycles += _kernel.cpus[i].rt_total;
+	}
+	k_spin_unlock(&usage_lock, key);
+
+	return 0;
+}
+
+#ifdef CONFIG_THREAD_RUNTIME_STATS_ISR
+/* Called by the interrupt wrapper in place of the ISR of the table entry. */
+void z_thread_runtime_isr_call(void *arg, void (*isr)(void *),
+			       const struct _isr_table_entry *entry)
+{
+	struct _cpu *cpu = _current_cpu;
+	unsigned int irq = entry - _sw_isr_table;
+	unsigned int key;
+	uint32_t start;
+	uint32_t now;
+
+	key = arch_irq_lock();
+	start = k_cycle_get_32();
+	usage_update(cpu, start);
+	cpu->rt_isr_nested++;
+	arch_irq_unlock(key);
+
+	isr(arg);
+
+	key = arch_irq_lock();
+	now = k_cycle_get_32();
+	isr_cycles[irq] += now - start;
+	if (--cpu->rt_isr_nested == 0U) {
+		cpu->rt_start = now;
+	}
+	arch_irq_unlock(key);
+}
+
+int k_isr_runtime_stats_get(unsigned int irq, k_thread_runtime_stats_t *stats)
+{
+	k_spinlock_key_t key;
+
+	if ((irq >= IRQ_TABLE_SIZE) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&usage_lock);
+	stats->execution_cycles = isr_cycles[irq];
+	k_spin_unlock(&usage_lock, key);
+
+	return 0;
+}
+#endif /* CONFIG_THREAD_RUNTIME_STATS_ISR */
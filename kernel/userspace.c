@@ -330,6 +330,56 @@ void *z_impl_k_object_alloc(enum k_objects otype)
 	return zo->name;
 }
 
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+/* Bumped whenever a dynamic object is freed. Each thread's lookup cache
+ * remembers the generation it was filled under and is flushed when that
+ * no longer matches. Permission bits and flags are always read from the
+ * live struct z_object, so revoking access needs no flush.
+ */
+static atomic_t obj_cache_gen;
+
+static inline void obj_cache_invalidate(void)
+{
+	(void)atomic_inc(&obj_cache_gen);
+}
+
+static struct z_object *obj_cache_find(struct _thread_obj_cache *cache,
+				       void *obj)
+{
+	atomic_val_t gen = atomic_get(&obj_cache_gen);
+
+	/* The generation must be sampled before any lookup whose result
+	 * ends up in the cache, so a free racing with that lookup leaves
+	 * a stale generation behind and forces another flush
+	 */
+	if (cache->gen != gen) {
+		(void)memset(cache->obj, 0, sizeof(cache->obj));
+		cache->gen = gen;
+		return NULL;
+	}
+
+	for (int i = 0; i < CONFIG_USERSPACE_OBJ_CACHE_SIZE; i++) {
+		if (cache->obj[i] == obj) {
+			return cache->ko[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void obj_cache_add(struct _thread_obj_cache *cache, void *obj,
+			  struct z_object *ko)
+{
+	cache->obj[cache->next] = obj;
+	cache->ko[cache->next] = ko;
+	cache->next = (cache->next + 1U) % CONFIG_USERSPACE_OBJ_CACHE_SIZE;
+}
+#else
+static inline void obj_cache_invalidate(void)
+{
+}
+#endif /* CONFIG_USERSPACE_OBJ_CACHE */
+
 void k_object_free(void *obj)
 {
 	struct dyn_obj *dyn_obj;
@@ -349,6 +399,7 @@ void k_object_free(void *obj)
 		if (dyn_obj->kobj.type == K_OBJ_THREAD) {
 			thread_idx_free(dyn_obj->kobj.data.thread_id);
 		}
+		obj_cache_invalidate();
 	}
 	k_spin_unlock(&objfree_lock, key);
 
@@ -361,6 +412,21 @@ struct z_object *z_object_find(void *obj)
 {
 	struct z_object *ret;
 
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+	/* Only system calls from user mode use the calling thread's
+	 * cache, which keeps it private to that thread
+	 */
+	struct _thread_obj_cache *cache = NULL;
+
+	if (z_is_in_user_syscall() && obj != NULL) {
+		cache = &_current->obj_cache;
+		ret = obj_cache_find(cache, obj);
+		if (ret != NULL) {
+			return ret;
+		}
+	}
+#endif
+
 	ret = z_object_gperf_find(obj);
 
 	if (ret == NULL) {
@@ -372,6 +438,12 @@ struct z_object *z_object_find(void *obj)
 		}
 	}
 
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+	if (cache != NULL && ret != NULL) {
+		obj_cache_add(cache, obj, ret);
+	}
+#endif
+
 	return ret;
 }
 
@@ -445,6 +517,7 @@ static void unref_check(struct z_object *ko, uintptr_t index)
 
 	rb_remove(&obj_rb_tree, &dyn_obj->node);
 	sys_dlist_remove(&dyn_obj->obj_list);
+	obj_cache_invalidate();
 	k_free(dyn_obj);
 out:
 #endif
@@ -507,6 +580,10 @@ void z_thread_perms_all_clear(struct k_thread *thread)
 	if (index != -1) {
 		z_object_wordlist_foreach(clear_perms_cb, (void *)index);
 	}
+
+#ifdef CONFIG_USERSPACE_OBJ_CACHE
+	(void)memset(&thread->obj_cache, 0, sizeof(thread->obj_cache));
+#endif
 }
 
 static int thread_perms_test(struct z_object *ko)
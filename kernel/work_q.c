@@ -24,8 +24,6 @@
 static struct k_spinlock lock;
 #endif
 
-extern void z_work_q_main(void *work_q_ptr, void *p2, void *p3);
-
 void k_work_q_start(struct k_work_q *work_q, k_thread_stack_t *stack,
 		    size_t stack_size, int prio)
 {
@@ -36,6 +34,66 @@ void k_work_q_start(struct k_work_q *work_q, k_thread_stack_t *stack,
 	k_thread_name_set(&work_q->thread, WORKQUEUE_THREAD_NAME);
 }
 
+static void work_pool_worker_start(struct k_thread *thread,
+				   k_thread_stack_t *stack, size_t stack_size,
+				   struct k_work_q *work_q, int prio,
+				   int cpu, bool pin)
+{
+	(void)k_thread_create(thread, stack, stack_size, z_work_q_main,
+			      work_q, NULL, NULL, prio, 0, K_FOREVER);
+	k_thread_name_set(thread, WORKQUEUE_THREAD_NAME);
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	if (pin) {
+		(void)k_thread_cpu_mask_clear(thread);
+		(void)k_thread_cpu_mask_enable(thread,
+					       cpu % CONFIG_MP_NUM_CPUS);
+	}
+#else
+	ARG_UNUSED(cpu);
+	ARG_UNUSED(pin);
+#endif
+
+	k_thread_start(thread);
+}
+
+void k_work_q_start_pinned(struct k_work_q *work_q, k_thread_stack_t *stack,
+			   size_t stack_size, int prio, int cpu)
+{
+	k_queue_init(&work_q->queue);
+	work_pool_worker_start(&work_q->thread, stack, stack_size, work_q,
+			       prio, cpu, true);
+}
+
+void k_work_pool_start(struct k_work_pool *pool,
+		       k_thread_stack_t *stacks, size_t stack_size,
+		       struct k_thread *threads, size_t num_threads,
+		       int prio, bool pin)
+{
+	size_t stride = K_THREAD_STACK_LEN(stack_size);
+
+	__ASSERT(num_threads > 0, "work pool needs at least one thread");
+	__ASSERT(num_threads == 1 || threads != NULL, "");
+
+	pool->threads = threads;
+	pool->num_threads = num_threads;
+	k_queue_init(&pool->work_q.queue);
+
+	/* All workers block on the same queue, so whichever one is idle
+	 * takes the next item.
+	 */
+	work_pool_worker_start(&pool->work_q.thread, stacks, stack_size,
+			       &pool->work_q, prio, 0, pin);
+
+	for (size_t i = 1; i < num_threads; i++) {
+		k_thread_stack_t *stack = (k_thread_stack_t *)
+			((uint8_t *)stacks + i * stride);
+
+		work_pool_worker_start(&threads[i - 1], stack, stack_size,
+				       &pool->work_q, prio, i, pin);
+	}
+}
+
 #ifdef CONFIG_SYS_CLOCK_EXISTS
 static void work_timeout(struct _timeout *t)
 {
@@ -53,6 +111,13 @@ void k_delayed_work_init(struct k_delayed_work *work, k_work_handler_t handler)
 	work->work_q = NULL;
 }
 
+#ifdef CONFIG_TIMEOUT_SLACK
+void k_delayed_work_slack_set(struct k_delayed_work *work, k_timeout_t slack)
+{
+	z_timeout_slack_set(&work->timeout, slack);
+}
+#endif
+
 static int work_cancel(struct k_delayed_work *work)
 {
 	CHECKIF(work->work_q == NULL) {
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <ksched.h>
+#include <wait_q.h>
+#include "wrapper.h"
+
+/*
+ * Event flags and thread flags wait directly on a kernel wait queue.
+ * Setting flags wakes all the waiters up, each of them then checks its
+ * own condition again, under the same IRQ lock as the flags update.
+ */
+
+void cv2_flags_init(struct cv2_flags *flags)
+{
+	z_waitq_init(&flags->wait_q);
+	flags->value = 0U;
+}
+
+uint32_t cv2_flags_set(struct cv2_flags *flags, uint32_t set)
+{
+	unsigned int key;
+	uint32_t value;
+
+	key = irq_lock();
+
+	flags->value |= set;
+	value = flags->value;
+
+	if (z_unpend_all(&flags->wait_q) != 0) {
+		z_reschedule_irqlock(key);
+	} else {
+		irq_unlock(key);
+	}
+
+	return value;
+}
+
+uint32_t cv2_flags_clear(struct cv2_flags *flags, uint32_t clear)
+{
+	unsigned int key;
+	uint32_t value;
+
+	key = irq_lock();
+	value = flags->value;
+	flags->value &= ~clear;
+	irq_unlock(key);
+
+	return value;
+}
+
+static inline bool cv2_flags_match(uint32_t value, uint32_t wait,
+				   uint32_t options)
+{
+	if ((options & osFlagsWaitAll) != 0U) {
+		return (value & wait) == wait;
+	}
+
+	return (value & wait) != 0U;
+}
+
+uint32_t cv2_flags_wait(struct cv2_flags *flags, uint32_t wait,
+			uint32_t options, uint32_t timeout)
+{
+	k_timeout_t left = K_FOREVER;
+	uint64_t end = 0U;
+	unsigned int key;
+	uint32_t value;
+	int64_t ticks;
+
+	if ((timeout != 0U) && (timeout != osWaitForever)) {
+		end = z_timeout_end_calc(K_TICKS(timeout));
+	}
+
+	key = irq_lock();
+
+	for (;;) {
+		value = flags->value;
+		if (cv2_flags_match(value, wait, options)) {
+			break;
+		}
+
+		if (timeout == 0U) {
+			irq_unlock(key);
+			return osFlagsErrorResource;
+		}
+
+		if (timeout != osWaitForever) {
+			ticks = (int64_t)end - z_tick_get();
+			if (ticks <= 0) {
+				irq_unlock(key);
+				return osFlagsErrorTimeout;
+			}
+			left = K_TICKS(ticks);
+		}
+
+		(void)z_pend_curr_irqlock(key, &flags->wait_q, left);
+		key = irq_lock();
+	}
+
+	if ((options & osFlagsNoClear) == 0U) {
+		flags->value &= ~wait;
+	}
+
+	irq_unlock(key);
+
+	return value;
+}
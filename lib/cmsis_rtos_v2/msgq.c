@@ -44,9 +44,9 @@ osMessageQueueId_t osMessageQueueNew(uint32_t msg_count, uint32_t msg_size,
 		attr = &init_msgq_attrs;
 	}
 
-	if (k_mem_slab_alloc(&cv2_msgq_slab, (void **)&msgq, K_MSEC(100)) == 0) {
-		(void)memset(msgq, 0, sizeof(struct cv2_msgq));
-	} else {
+	msgq = cv2_cb_alloc(&cv2_msgq_slab, attr->cb_mem, attr->cb_size,
+			    sizeof(struct cv2_msgq));
+	if (msgq == NULL) {
 		return NULL;
 	}
 
@@ -57,7 +57,7 @@ osMessageQueueId_t osMessageQueueNew(uint32_t msg_count, uint32_t msg_size,
 
 		msgq->pool = k_calloc(msg_count, msg_size);
 		if (msgq->pool == NULL) {
-			k_mem_slab_free(&cv2_msgq_slab, (void *) &msgq);
+			cv2_cb_free(&cv2_msgq_slab, msgq);
 			return NULL;
 		}
 		msgq->is_dynamic_allocation = TRUE;
@@ -274,7 +274,7 @@ osStatus_t osMessageQueueDelete(osMessageQueueId_t msgq_id)
 	if (msgq->is_dynamic_allocation) {
 		k_free(msgq->pool);
 	}
-	k_mem_slab_free(&cv2_msgq_slab, (void *)&msgq);
+	cv2_cb_free(&cv2_msgq_slab, msgq);
 
 	return osOK;
 }
@@ -39,9 +39,9 @@ osMutexId_t osMutexNew(const osMutexAttr_t *attr)
 	__ASSERT(!(attr->attr_bits & osMutexRobust),
 		 "Zephyr does not support osMutexRobust.\n");
 
-	if (k_mem_slab_alloc(&cv2_mutex_slab, (void **)&mutex, K_MSEC(100)) == 0) {
-		memset(mutex, 0, sizeof(struct cv2_mutex));
-	} else {
+	mutex = cv2_cb_alloc(&cv2_mutex_slab, attr->cb_mem, attr->cb_size,
+			     sizeof(struct cv2_mutex));
+	if (mutex == NULL) {
 		return NULL;
 	}
 
@@ -151,7 +151,7 @@ osStatus_t osMutexDelete(osMutexId_t mutex_id)
 	 * mutex_id is in an invalid mutex state) is not supported in Zephyr.
 	 */
 
-	k_mem_slab_free(&cv2_mutex_slab, (void *) &mutex);
+	cv2_cb_free(&cv2_mutex_slab, mutex);
 
 	return osOK;
 }
@@ -34,10 +34,9 @@ osSemaphoreId_t osSemaphoreNew(uint32_t max_count, uint32_t initial_count,
 		attr = &init_sema_attrs;
 	}
 
-	if (k_mem_slab_alloc(&cv2_semaphore_slab,
-			     (void **)&semaphore, K_MSEC(100)) == 0) {
-		(void)memset(semaphore, 0, sizeof(struct cv2_sem));
-	} else {
+	semaphore = cv2_cb_alloc(&cv2_semaphore_slab, attr->cb_mem,
+				 attr->cb_size, sizeof(struct cv2_sem));
+	if (semaphore == NULL) {
 		return NULL;
 	}
 
@@ -142,7 +141,7 @@ osStatus_t osSemaphoreDelete(osSemaphoreId_t semaphore_id)
 	 * supported in Zephyr.
 	 */
 
-	k_mem_slab_free(&cv2_semaphore_slab, (void *) &semaphore);
+	cv2_cb_free(&cv2_semaphore_slab, semaphore);
 
 	return osOK;
 }
@@ -175,10 +175,7 @@ osThreadId_t osThreadNew(osThreadFunc_t threadfunc, void *arg,
 		stack = attr->stack_mem;
 	}
 
-	k_poll_signal_init(&tid->poll_signal);
-	k_poll_event_init(&tid->poll_event, K_POLL_TYPE_SIGNAL,
-			  K_POLL_MODE_NOTIFY_ONLY, &tid->poll_signal);
-	tid->signal_results = 0U;
+	cv2_flags_init(&tid->flags);
 
 	/* TODO: Do this somewhere only once */
 	if (one_time == 0U) {
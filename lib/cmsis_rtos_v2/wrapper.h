@@ -8,17 +8,23 @@
 #define __WRAPPER_H__
 
 #include <kernel.h>
+#include <string.h>
+#include <wait_q.h>
 #include <cmsis_os2.h>
 
 #define TRUE    1
 #define FALSE   0
 
+/* Flags shared by the event flags and thread flags objects */
+struct cv2_flags {
+	_wait_q_t wait_q;
+	uint32_t value;
+};
+
 struct cv2_thread {
 	sys_dnode_t node;
 	struct k_thread z_thread;
-	struct k_poll_signal poll_signal;
-	struct k_poll_event poll_event;
-	uint32_t signal_results;
+	struct cv2_flags flags;
 	char name[16];
 	uint32_t attr_bits;
 	struct k_sem join_guard;
@@ -60,13 +66,52 @@ struct cv2_msgq {
 };
 
 struct cv2_event_flags {
-	struct k_poll_signal poll_signal;
-	struct k_poll_event poll_event;
-	uint32_t signal_results;
+	struct cv2_flags flags;
 	char name[16];
 };
 
 extern osThreadId_t get_cmsis_thread_id(k_tid_t tid);
 extern void *is_cmsis_rtos_v2_thread(void *thread_id);
 
+void cv2_flags_init(struct cv2_flags *flags);
+uint32_t cv2_flags_set(struct cv2_flags *flags, uint32_t set);
+uint32_t cv2_flags_clear(struct cv2_flags *flags, uint32_t clear);
+uint32_t cv2_flags_wait(struct cv2_flags *flags, uint32_t wait,
+			uint32_t options, uint32_t timeout);
+
+/*
+ * Get the memory of a control block, either the one provided by the
+ * application through the cb_mem attribute or a block of the slab.
+ */
+static inline void *cv2_cb_alloc(struct k_mem_slab *slab, void *cb_mem,
+				 uint32_t cb_size, size_t size)
+{
+	void *cb;
+
+	if (cb_mem != NULL) {
+		if ((cb_size < size) ||
+		    ((uintptr_t)cb_mem & (sizeof(void *) - 1)) != 0U) {
+			return NULL;
+		}
+		cb = cb_mem;
+	} else if (k_mem_slab_alloc(slab, &cb, K_MSEC(100)) != 0) {
+		return NULL;
+	}
+
+	(void)memset(cb, 0, size);
+
+	return cb;
+}
+
+/* Release a control block, if it was taken from the slab. */
+static inline void cv2_cb_free(struct k_mem_slab *slab, void *cb)
+{
+	char *start = slab->buffer;
+
+	if (((char *)cb >= start) &&
+	    ((char *)cb < start + slab->num_blocks * slab->block_size)) {
+		k_mem_slab_free(slab, &cb);
+	}
+}
+
 #endif
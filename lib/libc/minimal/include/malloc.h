@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_LIBC_MINIMAL_INCLUDE_MALLOC_H_
+#define ZEPHYR_LIB_LIBC_MINIMAL_INCLUDE_MALLOC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Occupancy and contention of the malloc arena */
+struct malloc_stats {
+	size_t arena_size;	/* bytes managed by the arena */
+	size_t allocated;	/* bytes held by the application */
+	size_t cached;		/* freed bytes kept in the CPU caches */
+	uint32_t cache_hits;	/* allocations served by a CPU cache */
+	uint32_t heap_allocs;	/* allocations served by the arena */
+	uint32_t contended;	/* arena accesses which had to wait */
+};
+
+/* Requires CONFIG_MINIMAL_LIBC_MALLOC_CACHE, -ENOTSUP otherwise */
+int malloc_stats_get(struct malloc_stats *stats);
+
+/* Print the statistics on the console */
+void malloc_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_LIB_LIBC_MINIMAL_INCLUDE_MALLOC_H_ */
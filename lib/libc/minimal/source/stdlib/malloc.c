@@ -5,11 +5,15 @@
  */
 
 #include <stdlib.h>
+#include <malloc.h>
 #include <zephyr.h>
 #include <init.h>
 #include <errno.h>
 #include <sys/math_extras.h>
 #include <sys/mempool.h>
+#include <sys/sys_heap.h>
+#include <sys/mutex.h>
+#include <sys/atomic.h>
 #include <string.h>
 #include <app_memory/app_memdomain.h>
 
@@ -27,6 +31,248 @@ K_APPMEM_PARTITION_DEFINE(z_malloc_partition);
 #define POOL_SECTION .data
 #endif /* CONFIG_USERSPACE */
 
+#ifdef CONFIG_MINIMAL_LIBC_MALLOC_SYS_HEAP
+static char __aligned(8) Z_GENERIC_SECTION(POOL_SECTION)
+	z_malloc_heap_mem[CONFIG_MINIMAL_LIBC_MALLOC_ARENA_SIZE];
+static Z_GENERIC_SECTION(POOL_SECTION) struct sys_heap z_malloc_heap;
+static Z_GENERIC_SECTION(POOL_SECTION) SYS_MUTEX_DEFINE(z_malloc_heap_mutex);
+
+#ifdef CONFIG_MINIMAL_LIBC_MALLOC_CACHE
+/*
+ * Blocks up to MALLOC_CACHE_MAX bytes are rounded up to a power of two
+ * size class. Freed blocks of each class are kept on a list of the CPU
+ * which freed them, and the next allocations of that CPU take them back
+ * without going through the arena and its mutex.
+ *
+ * Every block starts with a header holding its usable size.
+ */
+#define MALLOC_HDR_SIZE 8
+#define MALLOC_CACHE_MIN_SHIFT 4
+#define MALLOC_CACHE_CLASSES 5
+#define MALLOC_CACHE_MAX (1 << (MALLOC_CACHE_MIN_SHIFT + \
+				MALLOC_CACHE_CLASSES - 1))
+
+struct malloc_cache {
+	void *head[MALLOC_CACHE_CLASSES];
+	uint8_t count[MALLOC_CACHE_CLASSES];
+};
+
+static struct malloc_cache malloc_caches[CONFIG_MP_NUM_CPUS];
+static atomic_t malloc_allocated;
+static atomic_t malloc_cached;
+static atomic_t malloc_cache_hits;
+static atomic_t malloc_heap_allocs;
+static atomic_t malloc_contended;
+
+static int malloc_class(size_t size)
+{
+	int cls = 0;
+
+	while (size > (1U << (MALLOC_CACHE_MIN_SHIFT + cls))) {
+		cls++;
+	}
+
+	return cls;
+}
+
+/* With the local interrupts locked, the thread stays on this CPU */
+static struct malloc_cache *malloc_cache_lock(unsigned int *key)
+{
+	*key = arch_irq_lock();
+#ifdef CONFIG_SMP
+	return &malloc_caches[arch_curr_cpu()->id];
+#else
+	return &malloc_caches[0];
+#endif
+}
+
+static void malloc_heap_lock(void)
+{
+	if (sys_mutex_lock(&z_malloc_heap_mutex, K_NO_WAIT) != 0) {
+		atomic_inc(&malloc_contended);
+		(void) sys_mutex_lock(&z_malloc_heap_mutex, K_FOREVER);
+	}
+}
+
+void *malloc(size_t size)
+{
+	struct malloc_cache *cache;
+	unsigned int key;
+	size_t *hdr;
+	int cls;
+
+	if (size == 0) {
+		return NULL;
+	}
+
+	if (size <= MALLOC_CACHE_MAX) {
+		cls = malloc_class(size);
+		size = 1U << (MALLOC_CACHE_MIN_SHIFT + cls);
+
+		cache = malloc_cache_lock(&key);
+		hdr = cache->head[cls];
+		if (hdr != NULL) {
+			cache->head[cls] = *(void **)(hdr + 1);
+			cache->count[cls]--;
+			arch_irq_unlock(key);
+			atomic_inc(&malloc_cache_hits);
+			atomic_sub(&malloc_cached, size);
+			atomic_add(&malloc_allocated, size);
+			return (uint8_t *)hdr + MALLOC_HDR_SIZE;
+		}
+		arch_irq_unlock(key);
+	} else if (size > SIZE_MAX - MALLOC_HDR_SIZE) {
+		errno = ENOMEM;
+		return NULL;
+	}
+
+	malloc_heap_lock();
+	hdr = sys_heap_alloc(&z_malloc_heap, size + MALLOC_HDR_SIZE);
+	(void) sys_mutex_unlock(&z_malloc_heap_mutex);
+
+	if (hdr == NULL) {
+		errno = ENOMEM;
+		return NULL;
+	}
+
+	atomic_inc(&malloc_heap_allocs);
+	atomic_add(&malloc_allocated, size);
+	*hdr = size;
+
+	return (uint8_t *)hdr + MALLOC_HDR_SIZE;
+}
+
+void free(void *ptr)
+{
+	struct malloc_cache *cache;
+	unsigned int key;
+	size_t *hdr;
+	size_t size;
+	int cls;
+
+	if (ptr == NULL) {
+		return;
+	}
+
+	hdr = (size_t *)((uint8_t *)ptr - MALLOC_HDR_SIZE);
+	size = *hdr;
+
+	if (size <= MALLOC_CACHE_MAX) {
+		cls = malloc_class(size);
+
+		cache = malloc_cache_lock(&key);
+		if (cache->count[cls] < CONFIG_MINIMAL_LIBC_MALLOC_CACHE_DEPTH) {
+			*(void **)(hdr + 1) = cache->head[cls];
+			cache->head[cls] = hdr;
+			cache->count[cls]++;
+			arch_irq_unlock(key);
+			atomic_add(&malloc_cached, size);
+			atomic_sub(&malloc_allocated, size);
+			return;
+		}
+		arch_irq_unlock(key);
+	}
+
+	malloc_heap_lock();
+	sys_heap_free(&z_malloc_heap, hdr);
+	(void) sys_mutex_unlock(&z_malloc_heap_mutex);
+
+	atomic_sub(&malloc_allocated, size);
+}
+
+void *realloc(void *ptr, size_t requested_size)
+{
+	void *new_ptr;
+	size_t size;
+
+	if (ptr == NULL) {
+		return malloc(requested_size);
+	}
+
+	if (requested_size == 0) {
+		free(ptr);
+		return NULL;
+	}
+
+	size = *(size_t *)((uint8_t *)ptr - MALLOC_HDR_SIZE);
+	if (requested_size <= size) {
+		return ptr;
+	}
+
+	new_ptr = malloc(requested_size);
+	if (new_ptr == NULL) {
+		return NULL;
+	}
+
+	memcpy(new_ptr, ptr, size);
+	free(ptr);
+
+	return new_ptr;
+}
+
+int malloc_stats_get(struct malloc_stats *stats)
+{
+	stats->arena_size = CONFIG_MINIMAL_LIBC_MALLOC_ARENA_SIZE;
+	stats->allocated = atomic_get(&malloc_allocated);
+	stats->cached = atomic_get(&malloc_cached);
+	stats->cache_hits = atomic_get(&malloc_cache_hits);
+	stats->heap_allocs = atomic_get(&malloc_heap_allocs);
+	stats->contended = atomic_get(&malloc_contended);
+
+	return 0;
+}
+#else
+void *malloc(size_t size)
+{
+	void *ret;
+
+	(void) sys_mutex_lock(&z_malloc_heap_mutex, K_FOREVER);
+	ret = sys_heap_alloc(&z_malloc_heap, size);
+	(void) sys_mutex_unlock(&z_malloc_heap_mutex);
+
+	if (ret == NULL && size != 0) {
+		errno = ENOMEM;
+	}
+
+	return ret;
+}
+
+void *realloc(void *ptr, size_t requested_size)
+{
+	void *ret;
+
+	(void) sys_mutex_lock(&z_malloc_heap_mutex, K_FOREVER);
+	ret = sys_heap_realloc(&z_malloc_heap, ptr, requested_size);
+	(void) sys_mutex_unlock(&z_malloc_heap_mutex);
+
+	if (ret == NULL && requested_size != 0) {
+		errno = ENOMEM;
+	}
+
+	return ret;
+}
+
+void free(void *ptr)
+{
+	(void) sys_mutex_lock(&z_malloc_heap_mutex, K_FOREVER);
+	sys_heap_free(&z_malloc_heap, ptr);
+	(void) sys_mutex_unlock(&z_malloc_heap_mutex);
+}
+#endif /* CONFIG_MINIMAL_LIBC_MALLOC_CACHE */
+
+static int malloc_prepare(struct device *unused)
+{
+	ARG_UNUSED(unused);
+
+	sys_mutex_init(&z_malloc_heap_mutex);
+	sys_heap_init(&z_malloc_heap, z_malloc_heap_mem,
+		      CONFIG_MINIMAL_LIBC_MALLOC_ARENA_SIZE);
+
+	return 0;
+}
+
+SYS_INIT(malloc_prepare, APPLICATION, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#else /* !CONFIG_MINIMAL_LIBC_MALLOC_SYS_HEAP */
 SYS_MEM_POOL_DEFINE(z_malloc_mem_pool, NULL, 16,
 		    CONFIG_MINIMAL_LIBC_MALLOC_ARENA_SIZE, 1, 4, POOL_SECTION);
 
@@ -52,6 +298,7 @@ static int malloc_prepare(struct device *unused)
 }
 
 SYS_INIT(malloc_prepare, APPLICATION, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif /* CONFIG_MINIMAL_LIBC_MALLOC_SYS_HEAP */
 #else /* No malloc arena */
 void *malloc(size_t size)
 {
@@ -64,6 +311,8 @@ void *malloc(size_t size)
 }
 #endif
 
+#if !defined(CONFIG_MINIMAL_LIBC_MALLOC_SYS_HEAP) || \
+	(CONFIG_MINIMAL_LIBC_MALLOC_ARENA_SIZE == 0)
 void *realloc(void *ptr, size_t requested_size)
 {
 	void *new_ptr;
@@ -99,8 +348,34 @@ void free(void *ptr)
 {
 	sys_mem_pool_free(ptr);
 }
+#endif
 #endif /* CONFIG_MINIMAL_LIBC_MALLOC */
 
+#if !defined(CONFIG_MINIMAL_LIBC_MALLOC_CACHE) || \
+	(CONFIG_MINIMAL_LIBC_MALLOC_ARENA_SIZE == 0)
+int malloc_stats_get(struct malloc_stats *stats)
+{
+	ARG_UNUSED(stats);
+
+	return -ENOTSUP;
+}
+#endif
+
+void malloc_stats(void)
+{
+	struct malloc_stats stats;
+
+	if (malloc_stats_get(&stats) != 0) {
+		printk("malloc statistics not available\n");
+		return;
+	}
+
+	printk("arena %zu bytes, allocated %zu, cached %zu\n",
+	       stats.arena_size, stats.allocated, stats.cached);
+	printk("cache hits %u, arena allocations %u, contended %u\n",
+	       stats.cache_hits, stats.heap_allocs, stats.contended);
+}
+
 #ifdef CONFIG_MINIMAL_LIBC_CALLOC
 void *calloc(size_t nmemb, size_t size)
 {
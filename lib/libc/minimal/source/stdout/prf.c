@@ -36,19 +36,18 @@ static void _uc(char *buf)
 }
 
 /*
- * Writes the specified number into the buffer in the given base,
- * using the digit characters 0-9a-z (i.e. base>36 will start writing
- * odd bytes).
+ * Writes the specified number into the buffer in the base 2^shift,
+ * using the digit characters 0-9a-f.
  */
-static int _to_x(char *buf, unsigned VALTYPE n, unsigned int base)
+static int _to_x(char *buf, unsigned VALTYPE n, unsigned int shift)
 {
 	char *start = buf;
 	int len;
 
 	do {
-		unsigned int d = n % base;
+		unsigned int d = n & ((1U << shift) - 1);
 
-		n /= base;
+		n >>= shift;
 		*buf++ = '0' + d + (d > 9 ? ('a' - '0' - 10) : 0);
 	} while (n);
 
@@ -74,7 +73,7 @@ static int _to_hex(char *buf, unsigned VALTYPE value, bool alt_form, char prefix
 		*buf++ = 'x';
 	}
 
-	len = _to_x(buf, value, 16);
+	len = _to_x(buf, value, 4);
 	if (prefix == 'X') {
 		_uc(buf0);
 	}
@@ -94,30 +93,98 @@ static int _to_octal(char *buf, unsigned VALTYPE value, bool alt_form)
 			return 1;
 		}
 	}
-	return (buf - buf0) + _to_x(buf, value, 8);
+	return (buf - buf0) + _to_x(buf, value, 3);
+}
+
+static const char _digit_pairs[] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+/*
+ * Writes the decimal digits of a 32 bit value, two at a time, ending at
+ * "end". Divisions by the constant 100 compile to multiplications.
+ * At least "min" digits are written, returns the new start.
+ */
+static char *_u32_to_dec(char *end, uint32_t value, int min)
+{
+	while (value >= 100U || min > 2) {
+		uint32_t r = value % 100U;
+
+		value /= 100U;
+		end -= 2;
+		end[0] = _digit_pairs[2 * r];
+		end[1] = _digit_pairs[2 * r + 1];
+		min -= 2;
+	}
+
+	if (value >= 10U || min == 2) {
+		end -= 2;
+		end[0] = _digit_pairs[2 * value];
+		end[1] = _digit_pairs[2 * value + 1];
+	} else {
+		*--end = '0' + value;
+	}
+
+	return end;
 }
 
 static int _to_udec(char *buf, unsigned VALTYPE value)
 {
-	return _to_x(buf, value, 10);
+	char tmp[20];
+	char *end = tmp + sizeof(tmp);
+	char *p;
+	int len;
+
+	/*
+	 * Wider values are split in chunks of 8 digits, so only these
+	 * few divisions use the large 64 bit division routine.
+	 */
+#if defined(CONFIG_MINIMAL_LIBC_LL_PRINTF) || defined(CONFIG_64BIT)
+	while (value > UINT32_MAX) {
+		unsigned VALTYPE q = value / 100000000U;
+
+		end = _u32_to_dec(end, (uint32_t)(value - q * 100000000U), 8);
+		value = q;
+	}
+#endif
+
+	p = _u32_to_dec(end, (uint32_t)value, 1);
+	len = tmp + sizeof(tmp) - p;
+	memcpy(buf, p, len);
+	buf[len] = 0;
+
+	return len;
 }
 
 static int _to_dec(char *buf, VALTYPE value, bool fplus, bool fspace)
 {
 	char *start = buf;
+	unsigned VALTYPE magnitude = value;
 
 	if (value < 0) {
 		*buf++ = '-';
-		value = -value;
+		/* unsigned, so that the most negative value also works */
+		magnitude = -magnitude;
 	} else if (fplus) {
 		*buf++ = '+';
 	} else if (fspace) {
 		*buf++ = ' ';
 	}
 
-	return (buf + _to_udec(buf, value)) - start;
+	return (buf + _to_udec(buf, magnitude)) - start;
 }
 
+struct zero_padding { int predot, postdot, trail; };
+
+#ifdef CONFIG_MINIMAL_LIBC_FLOAT_PRINTF
 static	void _rlrshift(uint64_t *v)
 {
 	*v = (*v & 1) + (*v >> 1);
@@ -205,8 +272,6 @@ static	char _get_digit(uint64_t *fr, int *digit_count)
 #define	MAXFP1	0xFFFFFFFF	/* Largest # if first fp format */
 #define HIGHBIT64 (1ull<<63)
 
-struct zero_padding { int predot, postdot, trail; };
-
 static int _to_float(char *buf, uint64_t double_temp, char c,
 		     bool falt, bool fplus, bool fspace, int precision,
 		     struct zero_padding *zp)
@@ -421,6 +486,289 @@ static int _to_float(char *buf, uint64_t double_temp, char c,
 	return buf - start;
 }
 
+#ifdef CONFIG_MINIMAL_LIBC_SHORTEST_FLOAT_PRINTF
+/*
+ * Shortest round trip conversion, after the Grisu2 algorithm of Florian
+ * Loitsch, "Printing Floating-Point Numbers Quickly and Accurately with
+ * Integers". The digits always read back to the same double, and are
+ * the shortest such digits for nearly all values.
+ */
+
+struct diy_fp {
+	uint64_t f;
+	int e;
+};
+
+/* 10^(-348 + 8 * i), normalized to 64 bits, and its binary exponent */
+static const uint64_t cached_pow10_f[] = {
+	0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL,
+	0xcf42894a5dce35eaULL, 0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL,
+	0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL, 0xbe5691ef416bd60cULL,
+	0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+	0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL,
+	0xc21094364dfb5637ULL, 0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL,
+	0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL, 0xb23867fb2a35b28eULL,
+	0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+	0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL,
+	0xb5b5ada8aaff80b8ULL, 0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL,
+	0x964e858c91ba2655ULL, 0xdff9772470297ebdULL, 0xa6dfbd9fb8e5b88fULL,
+	0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+	0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL,
+	0xaa242499697392d3ULL, 0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL,
+	0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL, 0x9c40000000000000ULL,
+	0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+	0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL,
+	0x9f4f2726179a2245ULL, 0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL,
+	0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL, 0x924d692ca61be758ULL,
+	0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+	0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL,
+	0x952ab45cfa97a0b3ULL, 0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL,
+	0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL, 0x88fcf317f22241e2ULL,
+	0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+	0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL,
+	0x8bab8eefb6409c1aULL, 0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL,
+	0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL, 0x80444b5e7aa7cf85ULL,
+	0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+	0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL,
+};
+
+static const int16_t cached_pow10_e[] = {
+	-1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+	-954, -927, -901, -874, -847, -821, -794, -768, -741, -715,
+	-688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+	-422, -396, -369, -343, -316, -289, -263, -236, -210, -183,
+	-157, -130, -103, -77, -50, -24, 3, 30, 56, 83,
+	109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+	375, 402, 428, 455, 481, 508, 534, 561, 588, 614,
+	641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+	907, 933, 960, 986, 1013, 1039, 1066,
+};
+
+static const uint64_t pow10_64[] = {
+	1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+	10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+	100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+	100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+	100000000000000000ULL, 1000000000000000000ULL,
+	10000000000000000000ULL,
+};
+
+static struct diy_fp diy_fp_mul(struct diy_fp x, struct diy_fp y)
+{
+	uint64_t a = x.f >> 32, b = x.f & 0xffffffffU;
+	uint64_t c = y.f >> 32, d = y.f & 0xffffffffU;
+	uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+	uint64_t tmp = (bd >> 32) + (ad & 0xffffffffU) + (bc & 0xffffffffU);
+	struct diy_fp r;
+
+	/* round the dropped low half */
+	tmp += 1U << 31;
+	r.f = ac + (ad >> 32) + (bc >> 32) + (tmp >> 32);
+	r.e = x.e + y.e + 64;
+
+	return r;
+}
+
+static struct diy_fp diy_fp_normalize(struct diy_fp x)
+{
+	while ((x.f & HIGHBIT64) == 0) {
+		x.f <<= 1;
+		x.e--;
+	}
+
+	return x;
+}
+
+static void grisu_round(char *buf, int len, uint64_t delta, uint64_t rest,
+			uint64_t ten_kappa, uint64_t wp_w)
+{
+	while (rest < wp_w && delta - rest >= ten_kappa &&
+	       (rest + ten_kappa < wp_w ||
+		wp_w - rest > rest + ten_kappa - wp_w)) {
+		buf[len - 1]--;
+		rest += ten_kappa;
+	}
+}
+
+/*
+ * Writes the shortest digits of a finite, non-zero double, returns their
+ * count. The value is then digits * 10^(*k).
+ */
+static int _grisu2(char *buf, uint64_t double_temp, int *k)
+{
+	struct diy_fp v, w, mi, pl, c, one, wp_w;
+	uint64_t hidden = 1ULL << 52;
+	uint64_t p2, delta, rest;
+	uint32_t p1, d;
+	int i, kappa, len = 0;
+
+	v.f = double_temp & (hidden - 1);
+	v.e = (double_temp >> 52) & 0x7ff;
+	if (v.e != 0) {
+		v.f += hidden;
+		v.e -= 1075;
+	} else {
+		v.e = -1074;
+	}
+
+	/* boundaries halfway to the neighbour doubles */
+	pl.f = (v.f << 1) + 1;
+	pl.e = v.e - 1;
+	pl = diy_fp_normalize(pl);
+	if (v.f == hidden) {
+		mi.f = (v.f << 2) - 1;
+		mi.e = v.e - 2;
+	} else {
+		mi.f = (v.f << 1) - 1;
+		mi.e = v.e - 1;
+	}
+	mi.f <<= mi.e - pl.e;
+	mi.e = pl.e;
+
+	/* scale so that the binary exponent lands in [-59, -32] */
+	i = 0;
+	while (cached_pow10_e[i] + pl.e + 64 < -59) {
+		i++;
+	}
+	c.f = cached_pow10_f[i];
+	c.e = cached_pow10_e[i];
+	*k = 348 - 8 * i;
+
+	w = diy_fp_mul(diy_fp_normalize(v), c);
+	pl = diy_fp_mul(pl, c);
+	mi = diy_fp_mul(mi, c);
+	mi.f++;
+	pl.f--;
+	delta = pl.f - mi.f;
+
+	one.e = pl.e;
+	one.f = 1ULL << -one.e;
+	wp_w.f = pl.f - w.f;
+	p1 = pl.f >> -one.e;
+	p2 = pl.f & (one.f - 1);
+
+	kappa = 0;
+	while (kappa < 10 && p1 >= pow10_64[kappa]) {
+		kappa++;
+	}
+
+	while (kappa > 0) {
+		kappa--;
+		d = p1 / (uint32_t)pow10_64[kappa];
+		p1 %= (uint32_t)pow10_64[kappa];
+		if (d || len) {
+			buf[len++] = '0' + d;
+		}
+
+		rest = ((uint64_t)p1 << -one.e) + p2;
+		if (rest <= delta) {
+			*k += kappa;
+			grisu_round(buf, len, delta, rest,
+				    pow10_64[kappa] << -one.e, wp_w.f);
+			return len;
+		}
+	}
+
+	for (;;) {
+		p2 *= 10U;
+		delta *= 10U;
+		d = p2 >> -one.e;
+		if (d || len) {
+			buf[len++] = '0' + d;
+		}
+		p2 &= one.f - 1;
+		kappa--;
+		if (p2 < delta) {
+			*k += kappa;
+			grisu_round(buf, len, delta, p2, one.f,
+				    wp_w.f * (-kappa < (int)ARRAY_SIZE(pow10_64) ?
+					      pow10_64[-kappa] : 0));
+			return len;
+		}
+	}
+}
+
+/*
+ * Formats a double like %g with the shortest digits reading back to the
+ * same value instead of a fixed precision.
+ */
+static int _to_shortest(char *buf, uint64_t double_temp, char c,
+			bool fplus, bool fspace)
+{
+	char digits[18];
+	char *start = buf;
+	int len, k, exp10, i;
+
+	if (double_temp & HIGHBIT64) {
+		*buf++ = '-';
+	} else if (fplus) {
+		*buf++ = '+';
+	} else if (fspace) {
+		*buf++ = ' ';
+	}
+
+	if ((double_temp & ~HIGHBIT64) == 0) {
+		*buf++ = '0';
+		*buf = 0;
+		return buf - start;
+	}
+
+	len = _grisu2(digits, double_temp, &k);
+
+	/* position of the decimal point relative to the first digit */
+	exp10 = len + k;
+
+	if (exp10 > -4 && exp10 <= 17) {
+		if (exp10 <= 0) {
+			*buf++ = '0';
+			*buf++ = '.';
+			for (i = exp10; i < 0; i++) {
+				*buf++ = '0';
+			}
+			memcpy(buf, digits, len);
+			buf += len;
+		} else if (exp10 >= len) {
+			memcpy(buf, digits, len);
+			buf += len;
+			for (i = len; i < exp10; i++) {
+				*buf++ = '0';
+			}
+		} else {
+			memcpy(buf, digits, exp10);
+			buf += exp10;
+			*buf++ = '.';
+			memcpy(buf, digits + exp10, len - exp10);
+			buf += len - exp10;
+		}
+	} else {
+		*buf++ = digits[0];
+		if (len > 1) {
+			*buf++ = '.';
+			memcpy(buf, digits + 1, len - 1);
+			buf += len - 1;
+		}
+		*buf++ = c + 'e' - 'g';
+		exp10--;
+		if (exp10 < 0) {
+			*buf++ = '-';
+			exp10 = -exp10;
+		} else {
+			*buf++ = '+';
+		}
+		if (exp10 >= 100) {
+			*buf++ = (exp10 / 100) + '0';
+			exp10 %= 100;
+		}
+		*buf++ = (exp10 / 10) + '0';
+		*buf++ = (exp10 % 10) + '0';
+	}
+	*buf = 0;
+
+	return buf - start;
+}
+#endif /* CONFIG_MINIMAL_LIBC_SHORTEST_FLOAT_PRINTF */
+#endif /* CONFIG_MINIMAL_LIBC_FLOAT_PRINTF */
+
 static int _atoi(const char **sptr)
 {
 	const char *p = *sptr - 1;
@@ -584,6 +932,7 @@ int z_prf(int (*func)(), void *dest, const char *format, va_list vargs)
 			case 'F':
 			case 'g':
 			case 'G':
+#ifdef CONFIG_MINIMAL_LIBC_FLOAT_PRINTF
 			{
 				uint64_t double_val;
 
@@ -596,6 +945,13 @@ int z_prf(int (*func)(), void *dest, const char *format, va_list vargs)
 				u.d = va_arg(vargs, double);
 				double_val = u.i;
 
+#ifdef CONFIG_MINIMAL_LIBC_SHORTEST_FLOAT_PRINTF
+				if ((c == 'g' || c == 'G') && (precision < 0) &&
+				    (((double_val >> 52) & 0x7ff) != 0x7ff)) {
+					clen = _to_shortest(buf, double_val, c,
+							    fplus, fspace);
+				} else
+#endif
 				clen = _to_float(buf, double_val, c, falt,
 						 fplus, fspace, precision,
 						 &zero);
@@ -610,6 +966,14 @@ int z_prf(int (*func)(), void *dest, const char *format, va_list vargs)
 				precision = -1;
 				break;
 			}
+#else
+				/* floating point conversions not built in */
+				(void)va_arg(vargs, double);
+				PUTC('%');
+				PUTC(c);
+				count += 2;
+				continue;
+#endif
 
 			case 'n':
 				switch (i) {
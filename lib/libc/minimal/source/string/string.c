@@ -10,6 +10,32 @@
 #include <stdint.h>
 #include <sys/types.h>
 
+#ifdef CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING
+#define MEM_WORD_MASK (sizeof(mem_word_t) - 1)
+#define MEM_WORD_ONES ((mem_word_t)-1 / 0xff)
+
+/* Replicate a byte in all the bytes of a word */
+static inline mem_word_t mem_word_fill(unsigned char c)
+{
+	return MEM_WORD_ONES * c;
+}
+
+/* Check whether any byte of a word is zero */
+static inline int mem_word_has_zero(mem_word_t w)
+{
+#ifdef CONFIG_MINIMAL_LIBC_STRING_RISCV_ZBB
+	mem_word_t orc;
+
+	/* orc.b sets the zero bytes to 0x00 and the others to 0xff */
+	__asm__ (".insn i 0x13, 5, %0, %1, 0x287" : "=r" (orc) : "r" (w));
+
+	return orc != (mem_word_t)-1;
+#else
+	return ((w - MEM_WORD_ONES) & ~w & (MEM_WORD_ONES << 7)) != 0;
+#endif
+}
+#endif /* CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING */
+
 /**
  *
  * @brief Copy a string
@@ -106,6 +132,33 @@ char *strrchr(const char *s, int c)
 
 size_t strlen(const char *s)
 {
+#ifdef CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING
+	/*
+	 * Aligned word reads never cross a page or an MPU region boundary,
+	 * so reading past the terminator within the last word is harmless.
+	 */
+	const char *p = s;
+	const mem_word_t *w;
+
+	while (((uintptr_t)p & MEM_WORD_MASK) != 0) {
+		if (*p == '\0') {
+			return p - s;
+		}
+		p++;
+	}
+
+	w = (const mem_word_t *)p;
+	while (!mem_word_has_zero(*w)) {
+		w++;
+	}
+
+	p = (const char *)w;
+	while (*p != '\0') {
+		p++;
+	}
+
+	return p - s;
+#else
 	size_t n = 0;
 
 	while (*s != '\0') {
@@ -114,6 +167,7 @@ size_t strlen(const char *s)
 	}
 
 	return n;
+#endif
 }
 
 /**
@@ -144,6 +198,30 @@ size_t strnlen(const char *s, size_t maxlen)
 
 int strcmp(const char *s1, const char *s2)
 {
+#ifdef CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING
+	/* compare whole words while both strings have the same alignment */
+	if ((((uintptr_t)s1 ^ (uintptr_t)s2) & MEM_WORD_MASK) == 0) {
+		const mem_word_t *w1, *w2;
+
+		while (((uintptr_t)s1 & MEM_WORD_MASK) != 0) {
+			if ((*s1 != *s2) || (*s1 == '\0')) {
+				return *s1 - *s2;
+			}
+			s1++;
+			s2++;
+		}
+
+		w1 = (const mem_word_t *)s1;
+		w2 = (const mem_word_t *)s2;
+		while ((*w1 == *w2) && !mem_word_has_zero(*w1)) {
+			w1++;
+			w2++;
+		}
+
+		s1 = (const char *)w1;
+		s2 = (const char *)w2;
+	}
+#endif
 	while ((*s1 == *s2) && (*s1 != '\0')) {
 		s1++;
 		s2++;
@@ -297,6 +375,17 @@ void *memmove(void *d, const void *s, size_t n)
 
 void *memcpy(void *_MLIBC_RESTRICT d, const void *_MLIBC_RESTRICT s, size_t n)
 {
+#if defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING) && defined(CONFIG_X86)
+	void *dest = d;
+
+	/* fast string operations make this the best copy on any alignment */
+	__asm__ volatile ("rep movsb"
+			  : "+D" (d), "+S" (s), "+c" (n)
+			  :
+			  : "memory");
+
+	return dest;
+#else
 	/* attempt word-sized copying only if buffers have identical alignment */
 
 	unsigned char *d_byte = (unsigned char *)d;
@@ -320,6 +409,28 @@ void *memcpy(void *_MLIBC_RESTRICT d, const void *_MLIBC_RESTRICT s, size_t n)
 		mem_word_t *d_word = (mem_word_t *)d_byte;
 		const mem_word_t *s_word = (const mem_word_t *)s_byte;
 
+#if defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING) && \
+	defined(CONFIG_ARMV7_M_ARMV8_M_MAINLINE)
+		while (n >= 4 * sizeof(mem_word_t)) {
+			__asm__ volatile ("ldmia %0!, {r2-r5}\n\t"
+					  "stmia %1!, {r2-r5}"
+					  : "+r" (s_word), "+r" (d_word)
+					  :
+					  : "r2", "r3", "r4", "r5", "memory");
+			n -= 4 * sizeof(mem_word_t);
+		}
+#elif defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING)
+		while (n >= 4 * sizeof(mem_word_t)) {
+			d_word[0] = s_word[0];
+			d_word[1] = s_word[1];
+			d_word[2] = s_word[2];
+			d_word[3] = s_word[3];
+			d_word += 4;
+			s_word += 4;
+			n -= 4 * sizeof(mem_word_t);
+		}
+#endif
+
 		while (n >= sizeof(mem_word_t)) {
 			*(d_word++) = *(s_word++);
 			n -= sizeof(mem_word_t);
@@ -337,6 +448,7 @@ void *memcpy(void *_MLIBC_RESTRICT d, const void *_MLIBC_RESTRICT s, size_t n)
 	}
 
 	return d;
+#endif
 }
 
 /**
@@ -348,6 +460,16 @@ void *memcpy(void *_MLIBC_RESTRICT d, const void *_MLIBC_RESTRICT s, size_t n)
 
 void *memset(void *buf, int c, size_t n)
 {
+#if defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING) && defined(CONFIG_X86)
+	void *d = buf;
+
+	__asm__ volatile ("rep stosb"
+			  : "+D" (d), "+c" (n)
+			  : "a" (c)
+			  : "memory");
+
+	return buf;
+#else
 	/* do byte-sized initialization until word-aligned or finished */
 
 	unsigned char *d_byte = (unsigned char *)buf;
@@ -372,6 +494,17 @@ void *memset(void *buf, int c, size_t n)
 	c_word |= c_word << 32;
 #endif
 
+#ifdef CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING
+	while (n >= 4 * sizeof(mem_word_t)) {
+		d_word[0] = c_word;
+		d_word[1] = c_word;
+		d_word[2] = c_word;
+		d_word[3] = c_word;
+		d_word += 4;
+		n -= 4 * sizeof(mem_word_t);
+	}
+#endif
+
 	while (n >= sizeof(mem_word_t)) {
 		*(d_word++) = c_word;
 		n -= sizeof(mem_word_t);
@@ -387,6 +520,7 @@ void *memset(void *buf, int c, size_t n)
 	}
 
 	return buf;
+#endif
 }
 
 /**
@@ -398,6 +532,37 @@ void *memset(void *buf, int c, size_t n)
 
 void *memchr(const void *s, int c, size_t n)
 {
+#ifdef CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING
+	const unsigned char *p = s;
+	const mem_word_t *w;
+	mem_word_t c_word = mem_word_fill((unsigned char)c);
+
+	while ((n > 0) && (((uintptr_t)p & MEM_WORD_MASK) != 0)) {
+		if (*p == (unsigned char)c) {
+			return (void *)p;
+		}
+		p++;
+		n--;
+	}
+
+	/* skip the words without the byte */
+	w = (const mem_word_t *)p;
+	while ((n >= sizeof(mem_word_t)) && !mem_word_has_zero(*w ^ c_word)) {
+		w++;
+		n -= sizeof(mem_word_t);
+	}
+
+	p = (const unsigned char *)w;
+	while (n > 0) {
+		if (*p == (unsigned char)c) {
+			return (void *)p;
+		}
+		p++;
+		n--;
+	}
+
+	return NULL;
+#else
 	if (n != 0) {
 		const unsigned char *p = s;
 
@@ -410,4 +575,5 @@ void *memchr(const void *s, int c, size_t n)
 	}
 
 	return NULL;
+#endif
 }
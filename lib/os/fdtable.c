@@ -54,7 +54,22 @@ static struct fd_entry fdtable[CONFIG_POSIX_MAX_FDS] = {
 #endif
 };
 
-static K_MUTEX_DEFINE(fdtable_lock);
+/*
+ * Entries reserved or in use. An entry is reserved by z_reserve_fd()
+ * before z_finalize_fd() gives it a reference, so allocation has its own
+ * bitmap, claimed one word at a time with compare and swap.
+ */
+static ATOMIC_DEFINE(fd_busy, CONFIG_POSIX_MAX_FDS) = {
+#ifdef CONFIG_POSIX_API
+	/* STDIN, STDOUT and STDERR */
+	BIT(0) | BIT(1) | BIT(2),
+#endif
+};
+
+static void z_fd_release(int fd)
+{
+	atomic_clear_bit(fd_busy, fd);
+}
 
 static int z_fd_ref(int fd)
 {
@@ -63,7 +78,16 @@ static int z_fd_ref(int fd)
 
 static int z_fd_unref(int fd)
 {
-	int old_rc = atomic_dec(&fdtable[fd].refcount);
+	atomic_val_t old_rc;
+
+	do {
+		old_rc = atomic_get(&fdtable[fd].refcount);
+		if (old_rc == 0) {
+			/* Reserved but never finalized */
+			z_fd_release(fd);
+			return 0;
+		}
+	} while (!atomic_cas(&fdtable[fd].refcount, old_rc, old_rc - 1));
 
 	if (old_rc != 1) {
 		return old_rc - 1;
@@ -71,17 +95,32 @@ static int z_fd_unref(int fd)
 
 	fdtable[fd].obj = NULL;
 	fdtable[fd].vtable = NULL;
+	z_fd_release(fd);
 
 	return 0;
 }
 
 static int _find_fd_entry(void)
 {
-	int fd;
+	atomic_val_t busy;
+	int fd, i;
+
+	for (i = 0; i < ARRAY_SIZE(fd_busy); i++) {
+		busy = atomic_get(&fd_busy[i]);
+
+		while ((uint32_t)~busy != 0U) {
+			fd = i * ATOMIC_BITS + __builtin_ctz((uint32_t)~busy);
+			if (fd >= ARRAY_SIZE(fdtable)) {
+				break;
+			}
 
-	for (fd = 0; fd < ARRAY_SIZE(fdtable); fd++) {
-		if (!atomic_get(&fdtable[fd].refcount)) {
-			return fd;
+			if (atomic_cas(&fd_busy[i], busy,
+				       busy | ATOMIC_MASK(fd))) {
+				return fd;
+			}
+
+			/* Lost a race with another reservation */
+			busy = atomic_get(&fd_busy[i]);
 		}
 	}
 
@@ -142,17 +181,13 @@ int z_reserve_fd(void)
 {
 	int fd;
 
-	(void)k_mutex_lock(&fdtable_lock, K_FOREVER);
-
 	fd = _find_fd_entry();
 	if (fd >= 0) {
-		/* Mark entry as used, z_finalize_fd() will fill it in. */
+		/* Entry is reserved, z_finalize_fd() will fill it in. */
 		fdtable[fd].obj = NULL;
 		fdtable[fd].vtable = NULL;
 	}
 
-	k_mutex_unlock(&fdtable_lock);
-
 	return fd;
 }
 
@@ -89,6 +89,22 @@ bool sys_heap_validate(struct sys_heap *heap)
 		return false;  /* Should have exactly consumed the buffer */
 	}
 
+#ifdef CONFIG_SYS_HEAP_SMALL_BINS
+	/* Binned chunks are used chunks of exactly the bin's size */
+	for (int b = 0; b < SMALL_BINS; b++) {
+		uint32_t n = 0;
+
+		for (c = h->small_bins[b].next; c != 0;
+		     n++, c = next_free_chunk(h, c)) {
+			VALIDATE(n < h->small_bins[b].count);
+			VALIDATE(valid_chunk(h, c));
+			VALIDATE(chunk_used(h, c));
+			VALIDATE(chunk_size(h, c) == b + 1);
+		}
+		VALIDATE(n == h->small_bins[b].count);
+	}
+#endif
+
 	/* Check the free lists: entry count should match, empty bit
 	 * should be correct, and all chunk entries should point into
 	 * valid unused chunks.  Mark those chunks USED, temporarily.
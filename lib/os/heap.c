@@ -5,6 +5,7 @@
  */
 #include <sys/sys_heap.h>
 #include <kernel.h>
+#include <string.h>
 #include "heap.h"
 
 static void *chunk_mem(struct z_heap *h, chunkid_t c)
@@ -126,6 +127,66 @@ static void free_chunk(struct z_heap *h, chunkid_t c)
 	free_list_add(h, c);
 }
 
+#ifdef CONFIG_SYS_HEAP_SMALL_BINS
+static bool small_bin_put(struct z_heap *h, chunkid_t c)
+{
+	size_t sz = chunk_size(h, c);
+	struct z_heap_small_bin *bin;
+
+	if (sz > SMALL_BINS) {
+		return false;
+	}
+
+	bin = &h->small_bins[sz - 1];
+	if (bin->count >= CONFIG_SYS_HEAP_SMALL_BIN_DEPTH) {
+		return false;
+	}
+
+	set_next_free_chunk(h, c, bin->next);
+	bin->next = c;
+	bin->count++;
+	return true;
+}
+
+static chunkid_t small_bin_get(struct z_heap *h, size_t sz)
+{
+	struct z_heap_small_bin *bin;
+	chunkid_t c;
+
+	if (sz > SMALL_BINS) {
+		return 0;
+	}
+
+	bin = &h->small_bins[sz - 1];
+	c = bin->next;
+	if (c != 0) {
+		CHECK(chunk_used(h, c) && chunk_size(h, c) == sz);
+		bin->next = next_free_chunk(h, c);
+		bin->count--;
+	}
+	return c;
+}
+
+/* Return all binned chunks to the heap proper.  Returns true if
+ * anything was released.
+ */
+static bool small_bins_flush(struct z_heap *h)
+{
+	bool ret = false;
+
+	for (int i = 0; i < SMALL_BINS; i++) {
+		chunkid_t c;
+
+		while ((c = small_bin_get(h, i + 1)) != 0) {
+			set_chunk_used(h, c, false);
+			free_chunk(h, c);
+			ret = true;
+		}
+	}
+	return ret;
+}
+#endif /* CONFIG_SYS_HEAP_SMALL_BINS */
+
 /*
  * Return the closest chunk ID corresponding to given memory pointer.
  * Here "closest" is only meaningful in the context of sys_heap_aligned_alloc()
@@ -162,6 +223,12 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 		 "corrupted heap bounds (buffer overflow?) for memory at %p",
 		 mem);
 
+#ifdef CONFIG_SYS_HEAP_SMALL_BINS
+	if (small_bin_put(h, c)) {
+		return;
+	}
+#endif
+
 	set_chunk_used(h, c, false);
 	free_chunk(h, c);
 }
@@ -217,6 +284,13 @@ static chunkid_t alloc_chunk(struct z_heap *h, size_t sz)
 		return c;
 	}
 
+#ifdef CONFIG_SYS_HEAP_SMALL_BINS
+	/* Binned chunks may be what stands between us and success */
+	if (small_bins_flush(h)) {
+		return alloc_chunk(h, sz);
+	}
+#endif
+
 	return 0;
 }
 
@@ -228,7 +302,16 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 
 	struct z_heap *h = heap->heap;
 	size_t chunk_sz = bytes_to_chunksz(h, bytes);
-	chunkid_t c = alloc_chunk(h, chunk_sz);
+	chunkid_t c;
+
+#ifdef CONFIG_SYS_HEAP_SMALL_BINS
+	c = small_bin_get(h, chunk_sz);
+	if (c != 0) {
+		return chunk_mem(h, c);
+	}
+#endif
+
+	c = alloc_chunk(h, chunk_sz);
 	if (c == 0) {
 		return NULL;
 	}
@@ -293,6 +376,64 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 	return mem;
 }
 
+void *sys_heap_realloc(struct sys_heap *heap, void *ptr, size_t bytes)
+{
+	if (ptr == NULL) {
+		return sys_heap_alloc(heap, bytes);
+	}
+	if (bytes == 0) {
+		sys_heap_free(heap, ptr);
+		return NULL;
+	}
+
+	struct z_heap *h = heap->heap;
+	chunkid_t c = mem_to_chunkid(h, ptr);
+	chunkid_t rc = right_chunk(h, c);
+	size_t align_gap = (uint8_t *)ptr - (uint8_t *)chunk_mem(h, c);
+	size_t chunks_need = bytes_to_chunksz(h, bytes + align_gap);
+
+	__ASSERT(chunk_used(h, c),
+		 "unexpected heap state (double-free?) for memory at %p", ptr);
+
+	if (chunk_size(h, c) == chunks_need) {
+		/* We're good already */
+		return ptr;
+	}
+
+	if (chunk_size(h, c) > chunks_need) {
+		/* Shrink in place, split and free unused suffix */
+		split_chunks(h, c, c + chunks_need);
+		set_chunk_used(h, c, true);
+		free_chunk(h, c + chunks_need);
+		return ptr;
+	}
+
+	if (!chunk_used(h, rc) &&
+	    (chunk_size(h, c) + chunk_size(h, rc) >= chunks_need)) {
+		/* Expand: split the right chunk and append */
+		free_list_remove(h, rc);
+		merge_chunks(h, c, rc);
+		if (chunk_size(h, c) > chunks_need) {
+			split_chunks(h, c, c + chunks_need);
+			free_list_add(h, c + chunks_need);
+		}
+		set_chunk_used(h, c, true);
+		return ptr;
+	}
+
+	/* Fallback: allocate and copy */
+	void *ptr2 = sys_heap_alloc(heap, bytes);
+
+	if (ptr2 != NULL) {
+		size_t prev_size = chunk_size(h, c) * CHUNK_UNIT
+				   - chunk_header_bytes(h) - align_gap;
+
+		memcpy(ptr2, ptr, MIN(prev_size, bytes));
+		sys_heap_free(heap, ptr);
+	}
+	return ptr2;
+}
+
 void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 {
 	/* Must fit in a 32 bit count of HUNK_UNIT */
@@ -326,6 +467,13 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 		h->buckets[i].next = 0;
 	}
 
+#ifdef CONFIG_SYS_HEAP_SMALL_BINS
+	for (int i = 0; i < SMALL_BINS; i++) {
+		h->small_bins[i].next = 0;
+		h->small_bins[i].count = 0;
+	}
+#endif
+
 	/* chunk containing our struct z_heap */
 	set_chunk_size(h, 0, chunk0_size);
 	set_chunk_used(h, 0, true);
@@ -57,10 +57,27 @@ struct z_heap_bucket {
 	chunkid_t next;
 };
 
+#ifdef CONFIG_SYS_HEAP_SMALL_BINS
+/* Small object bins hold freed chunks of one exact size, still marked
+ * used, singly linked through their FREE_NEXT field.  Bin N is for
+ * chunks of N + 1 units; sized for the largest (8 byte) header.
+ */
+#define SMALL_BINS ((CONFIG_SYS_HEAP_SMALL_BIN_MAX_BYTES + 8 + \
+		     CHUNK_UNIT - 1) / CHUNK_UNIT)
+
+struct z_heap_small_bin {
+	chunkid_t next;
+	uint32_t count;
+};
+#endif
+
 struct z_heap {
 	uint64_t chunk0_hdr_area;  /* matches the largest header */
 	uint32_t len;
 	uint32_t avail_buckets;
+#ifdef CONFIG_SYS_HEAP_SMALL_BINS
+	struct z_heap_small_bin small_bins[SMALL_BINS];
+#endif
 	struct z_heap_bucket buckets[0];
 };
 
@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <init.h>
+#include <errno.h>
+#include <drivers/counter.h>
+#include <sys/hrtimer.h>
+#include <sys_clock.h>
+
+#define LOG_LEVEL CONFIG_KERNEL_LOG_LEVEL
+#include <logging/log.h>
+LOG_MODULE_DECLARE(os);
+
+#define HRTIMER_CHANNEL CONFIG_HRTIMER_COUNTER_CHANNEL
+
+/*
+ * The active timers are sorted by expiry, the first one is programmed in
+ * the counter alarm. The counter value is extended to 64 bits by counting
+ * its wraps, an alarm is always set less than half a wrap ahead so that
+ * none is missed.
+ */
+static struct device *counter;
+static uint32_t counter_freq;
+static uint32_t counter_top;
+static uint32_t counter_last;
+static uint64_t counter_base;
+static sys_dlist_t hrtimers = SYS_DLIST_STATIC_INIT(&hrtimers);
+static struct k_spinlock lock;
+
+static void hrtimer_alarm(struct device *dev, uint8_t chan_id, uint32_t ticks,
+			  void *user_data);
+
+static uint64_t ns_to_ticks(uint64_t ns)
+{
+	/* rounded up, a timer never expires early */
+	return (ns / NSEC_PER_SEC) * counter_freq +
+	       ((ns % NSEC_PER_SEC) * counter_freq + NSEC_PER_SEC - 1) /
+	       NSEC_PER_SEC;
+}
+
+static uint64_t ticks_to_ns(uint64_t ticks)
+{
+	return (ticks / counter_freq) * NSEC_PER_SEC +
+	       (ticks % counter_freq) * NSEC_PER_SEC / counter_freq;
+}
+
+static uint64_t hrtimer_now(void)
+{
+	uint32_t value;
+
+	(void)counter_get_value(counter, &value);
+	if (value < counter_last) {
+		counter_base += (uint64_t)counter_top + 1U;
+	}
+	counter_last = value;
+
+	return counter_base + value;
+}
+
+static void hrtimer_insert(struct sys_hrtimer *timer)
+{
+	struct sys_hrtimer *t;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&hrtimers, t, node) {
+		if (timer->expiry < t->expiry) {
+			sys_dlist_insert(&t->node, &timer->node);
+			return;
+		}
+	}
+
+	sys_dlist_append(&hrtimers, &timer->node);
+}
+
+/* Program the alarm for the first timer, called with the lock held */
+static void hrtimer_program(uint64_t now)
+{
+	struct sys_hrtimer *first;
+	struct counter_alarm_cfg cfg = {
+		.callback = hrtimer_alarm,
+		.ticks = counter_top / 2U,
+	};
+
+	first = SYS_DLIST_PEEK_HEAD_CONTAINER(&hrtimers, first, node);
+	if ((first != NULL) && (first->expiry < now + cfg.ticks)) {
+		cfg.ticks = MAX(first->expiry, now + 1U) - now;
+	}
+
+	(void)counter_cancel_channel_alarm(counter, HRTIMER_CHANNEL);
+	(void)counter_set_channel_alarm(counter, HRTIMER_CHANNEL, &cfg);
+}
+
+static void hrtimer_alarm(struct device *dev, uint8_t chan_id, uint32_t ticks,
+			  void *user_data)
+{
+	struct sys_hrtimer *timer;
+	k_spinlock_key_t key;
+	uint64_t now;
+
+	key = k_spin_lock(&lock);
+
+	for (;;) {
+		now = hrtimer_now();
+		timer = SYS_DLIST_PEEK_HEAD_CONTAINER(&hrtimers, timer, node);
+		if ((timer == NULL) || (timer->expiry > now)) {
+			break;
+		}
+
+		sys_dlist_remove(&timer->node);
+		if (timer->period != 0U) {
+			timer->expiry += timer->period;
+			hrtimer_insert(timer);
+		}
+
+		if (timer->handler != NULL) {
+			k_spin_unlock(&lock, key);
+			timer->handler(timer);
+			key = k_spin_lock(&lock);
+		}
+	}
+
+	hrtimer_program(now);
+
+	k_spin_unlock(&lock, key);
+}
+
+void sys_hrtimer_init(struct sys_hrtimer *timer,
+		      sys_hrtimer_handler_t handler, void *user_data)
+{
+	sys_dnode_init(&timer->node);
+	timer->handler = handler;
+	timer->user_data = user_data;
+	timer->expiry = 0U;
+	timer->period = 0U;
+}
+
+int sys_hrtimer_start(struct sys_hrtimer *timer, uint64_t delay_ns,
+		      uint64_t period_ns)
+{
+	k_spinlock_key_t key;
+	uint64_t now;
+
+	if (counter == NULL) {
+		return -ENODEV;
+	}
+
+	key = k_spin_lock(&lock);
+
+	if (sys_dnode_is_linked(&timer->node)) {
+		sys_dlist_remove(&timer->node);
+	}
+
+	now = hrtimer_now();
+	timer->expiry = now + MAX(ns_to_ticks(delay_ns), 1U);
+	timer->period = (period_ns != 0U) ? MAX(ns_to_ticks(period_ns), 1U) :
+					    0U;
+	hrtimer_insert(timer);
+
+	if (sys_dlist_peek_head(&hrtimers) == &timer->node) {
+		hrtimer_program(now);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+void sys_hrtimer_stop(struct sys_hrtimer *timer)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&lock);
+
+	if (sys_dnode_is_linked(&timer->node)) {
+		sys_dlist_remove(&timer->node);
+	}
+
+	/* a now early alarm just finds nothing expired */
+
+	k_spin_unlock(&lock, key);
+}
+
+uint64_t sys_hrtimer_remaining_ns(struct sys_hrtimer *timer)
+{
+	k_spinlock_key_t key;
+	uint64_t ticks = 0U;
+	uint64_t now;
+
+	key = k_spin_lock(&lock);
+
+	if (sys_dnode_is_linked(&timer->node)) {
+		now = hrtimer_now();
+		if (timer->expiry > now) {
+			ticks = timer->expiry - now;
+		}
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return (ticks != 0U) ? ticks_to_ns(ticks) : 0U;
+}
+
+static void hrtimer_wakeup(struct sys_hrtimer *timer)
+{
+	k_sem_give(timer->user_data);
+}
+
+int sys_hrtimer_sleep_ns(uint64_t ns)
+{
+	struct sys_hrtimer timer;
+	struct k_sem sem;
+	int ret;
+
+	k_sem_init(&sem, 0, 1);
+	sys_hrtimer_init(&timer, hrtimer_wakeup, &sem);
+
+	ret = sys_hrtimer_start(&timer, ns, 0);
+	if (ret == 0) {
+		(void)k_sem_take(&sem, K_FOREVER);
+	}
+
+	return ret;
+}
+
+static int hrtimer_init(struct device *unused)
+{
+	struct device *dev;
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(unused);
+
+	dev = device_get_binding(CONFIG_HRTIMER_COUNTER_NAME);
+	if (dev == NULL) {
+		LOG_ERR("No counter %s for the hrtimers",
+			CONFIG_HRTIMER_COUNTER_NAME);
+		return -ENODEV;
+	}
+
+	if (!counter_is_counting_up(dev) ||
+	    counter_get_frequency(dev) == 0U) {
+		LOG_ERR("hrtimers need a clock driven counter counting up");
+		return -ENOTSUP;
+	}
+
+	counter_freq = counter_get_frequency(dev);
+	counter_top = counter_get_top_value(dev);
+	(void)counter_start(dev);
+
+	key = k_spin_lock(&lock);
+	counter = dev;
+	hrtimer_program(hrtimer_now());
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+SYS_INIT(hrtimer_init, APPLICATION, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -17,6 +17,10 @@
 
 #include <data/json.h>
 
+#if defined(CONFIG_NET_BUF)
+#include <net/buf.h>
+#endif
+
 struct token {
 	enum json_tokens type;
 	char *start;
@@ -936,3 +940,370 @@ ssize_t json_calc_encoded_len(const struct json_obj_descr *descr,
 
 	return total;
 }
+
+enum stream_state {
+	STREAM_VALUE,
+	STREAM_VALUE_OR_END,
+	STREAM_KEY,
+	STREAM_KEY_OR_END,
+	STREAM_COLON,
+	STREAM_COMMA_OR_END,
+	STREAM_DONE,
+};
+
+enum stream_lex {
+	STREAM_LEX_NONE,
+	STREAM_LEX_STRING,
+	STREAM_LEX_ESCAPE,
+	STREAM_LEX_UNICODE,
+	STREAM_LEX_NUMBER,
+	STREAM_LEX_LITERAL,
+};
+
+static const char *const stream_literals[] = { "true", "false", "null" };
+static const enum json_tokens stream_literal_tokens[] = {
+	JSON_TOK_TRUE, JSON_TOK_FALSE, JSON_TOK_NULL
+};
+
+void json_stream_init(struct json_stream_parser *parser, char *buf,
+		      size_t buf_size, json_stream_cb_t cb, void *user_data)
+{
+	*parser = (struct json_stream_parser) {
+		.cb = cb,
+		.user_data = user_data,
+		.buf = buf,
+		.buf_size = buf_size,
+		.state = STREAM_VALUE,
+		.lex = STREAM_LEX_NONE,
+	};
+}
+
+static bool stream_in_object(const struct json_stream_parser *parser)
+{
+	return parser->depth > 0 &&
+	       (parser->objects & BIT(parser->depth - 1)) != 0U;
+}
+
+static int stream_append(struct json_stream_parser *parser, char c)
+{
+	if (parser->key_len + parser->value_len >= parser->buf_size) {
+		return -ENOMEM;
+	}
+
+	if (parser->in_key) {
+		parser->buf[parser->key_len++] = c;
+	} else {
+		parser->buf[parser->key_len + parser->value_len++] = c;
+	}
+
+	return 0;
+}
+
+static int stream_emit(struct json_stream_parser *parser,
+		       enum json_tokens type, bool with_value)
+{
+	struct json_stream_event event = {
+		.type = type,
+		.depth = parser->depth,
+	};
+	int ret;
+
+	if (type != JSON_TOK_OBJECT_END && type != JSON_TOK_LIST_END &&
+	    stream_in_object(parser)) {
+		event.key = parser->buf;
+		event.key_len = parser->key_len;
+	}
+
+	if (with_value) {
+		event.value = parser->buf + parser->key_len;
+		event.value_len = parser->value_len;
+	}
+
+	ret = parser->cb(&event, parser->user_data);
+
+	parser->key_len = 0;
+	parser->value_len = 0;
+
+	return ret;
+}
+
+static void stream_value_done(struct json_stream_parser *parser)
+{
+	parser->lex = STREAM_LEX_NONE;
+	parser->state = parser->depth ? STREAM_COMMA_OR_END : STREAM_DONE;
+}
+
+static int stream_number_done(struct json_stream_parser *parser)
+{
+	const char *num = parser->buf + parser->key_len;
+	int ret;
+
+	if (!isdigit((unsigned char)num[parser->value_len - 1])) {
+		return -EINVAL;
+	}
+
+	ret = stream_emit(parser, JSON_TOK_NUMBER, true);
+	stream_value_done(parser);
+
+	return ret;
+}
+
+static int stream_open(struct json_stream_parser *parser, bool object)
+{
+	int ret;
+
+	if (parser->depth >= 32U) {
+		return -ENOMEM;
+	}
+
+	ret = stream_emit(parser, object ? JSON_TOK_OBJECT_START :
+				  JSON_TOK_LIST_START, false);
+
+	WRITE_BIT(parser->objects, parser->depth, object);
+	parser->depth++;
+	parser->state = object ? STREAM_KEY_OR_END : STREAM_VALUE_OR_END;
+
+	return ret;
+}
+
+static int stream_close(struct json_stream_parser *parser, bool object)
+{
+	bool allowed;
+
+	if (object) {
+		allowed = parser->state == STREAM_KEY_OR_END ||
+			  (parser->state == STREAM_COMMA_OR_END &&
+			   stream_in_object(parser));
+	} else {
+		allowed = parser->state == STREAM_VALUE_OR_END ||
+			  (parser->state == STREAM_COMMA_OR_END &&
+			   !stream_in_object(parser));
+	}
+
+	if (!allowed) {
+		return -EINVAL;
+	}
+
+	parser->depth--;
+	stream_value_done(parser);
+
+	return stream_emit(parser, object ? JSON_TOK_OBJECT_END :
+			   JSON_TOK_LIST_END, false);
+}
+
+static int stream_structural(struct json_stream_parser *parser, char c)
+{
+	bool want_value = parser->state == STREAM_VALUE ||
+			  parser->state == STREAM_VALUE_OR_END;
+	size_t i;
+
+	if (isspace((unsigned char)c)) {
+		return 0;
+	}
+
+	switch (c) {
+	case '{':
+	case '[':
+		return want_value ? stream_open(parser, c == '{') : -EINVAL;
+	case '}':
+	case ']':
+		return stream_close(parser, c == '}');
+	case ',':
+		if (parser->state != STREAM_COMMA_OR_END) {
+			return -EINVAL;
+		}
+
+		parser->state = stream_in_object(parser) ? STREAM_KEY :
+			STREAM_VALUE;
+		return 0;
+	case ':':
+		if (parser->state != STREAM_COLON) {
+			return -EINVAL;
+		}
+
+		parser->state = STREAM_VALUE;
+		return 0;
+	case '"':
+		if (parser->state == STREAM_KEY ||
+		    parser->state == STREAM_KEY_OR_END) {
+			parser->in_key = true;
+		} else if (want_value) {
+			parser->in_key = false;
+		} else {
+			return -EINVAL;
+		}
+
+		parser->lex = STREAM_LEX_STRING;
+		return 0;
+	}
+
+	if (!want_value) {
+		return -EINVAL;
+	}
+
+	if (c == '-' || isdigit((unsigned char)c)) {
+		parser->in_key = false;
+		parser->lex = STREAM_LEX_NUMBER;
+		return stream_append(parser, c);
+	}
+
+	for (i = 0; i < ARRAY_SIZE(stream_literals); i++) {
+		if (c == stream_literals[i][0]) {
+			parser->lex = STREAM_LEX_LITERAL;
+			parser->lex_aux = (i << 4) | 1;
+			return 0;
+		}
+	}
+
+	return -EINVAL;
+}
+
+static int stream_char(struct json_stream_parser *parser, char c)
+{
+	const char *literal;
+	int ret;
+
+	switch (parser->lex) {
+	case STREAM_LEX_NONE:
+		if (parser->state == STREAM_DONE) {
+			return isspace((unsigned char)c) ? 0 : -EINVAL;
+		}
+
+		return stream_structural(parser, c);
+	case STREAM_LEX_STRING:
+		if (c == '"') {
+			parser->lex = STREAM_LEX_NONE;
+			if (parser->in_key) {
+				parser->in_key = false;
+				parser->state = STREAM_COLON;
+				return 0;
+			}
+
+			ret = stream_emit(parser, JSON_TOK_STRING, true);
+			stream_value_done(parser);
+			return ret;
+		}
+
+		if (c == '\\') {
+			parser->lex = STREAM_LEX_ESCAPE;
+		}
+
+		return stream_append(parser, c);
+	case STREAM_LEX_ESCAPE:
+		if (c == 'u') {
+			parser->lex = STREAM_LEX_UNICODE;
+			parser->lex_aux = 4;
+		} else if (strchr("\"\\/bfnrt", c) && c != '\0') {
+			parser->lex = STREAM_LEX_STRING;
+		} else {
+			return -EINVAL;
+		}
+
+		return stream_append(parser, c);
+	case STREAM_LEX_UNICODE:
+		if (!isxdigit((unsigned char)c)) {
+			return -EINVAL;
+		}
+
+		if (--parser->lex_aux == 0U) {
+			parser->lex = STREAM_LEX_STRING;
+		}
+
+		return stream_append(parser, c);
+	case STREAM_LEX_NUMBER:
+		if (isdigit((unsigned char)c) || c == '.' || c == 'e' ||
+		    c == 'E' || c == '+' || c == '-') {
+			return stream_append(parser, c);
+		}
+
+		ret = stream_number_done(parser);
+		if (ret < 0) {
+			return ret;
+		}
+
+		return stream_char(parser, c);
+	case STREAM_LEX_LITERAL:
+		literal = stream_literals[parser->lex_aux >> 4];
+		if (c != literal[parser->lex_aux & 0xf]) {
+			return -EINVAL;
+		}
+
+		parser->lex_aux++;
+		if (literal[parser->lex_aux & 0xf] != '\0') {
+			return 0;
+		}
+
+		ret = stream_emit(parser,
+				  stream_literal_tokens[parser->lex_aux >> 4],
+				  false);
+		stream_value_done(parser);
+		return ret;
+	}
+
+	return -EINVAL;
+}
+
+int json_stream_feed(struct json_stream_parser *parser, const char *data,
+		     size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len && parser->error == 0; i++) {
+		parser->error = stream_char(parser, data[i]);
+	}
+
+	return parser->error;
+}
+
+int json_stream_finish(struct json_stream_parser *parser)
+{
+	if (parser->error == 0 && parser->lex == STREAM_LEX_NUMBER &&
+	    parser->depth == 0U) {
+		parser->error = stream_number_done(parser);
+	}
+
+	if (parser->error == 0 && parser->state != STREAM_DONE) {
+		parser->error = -EINVAL;
+	}
+
+	return parser->error;
+}
+
+#if defined(CONFIG_NET_BUF)
+int json_stream_feed_net_buf(struct json_stream_parser *parser,
+			     const struct net_buf *buf)
+{
+	int ret = parser->error;
+
+	for (; buf != NULL && ret == 0; buf = buf->frags) {
+		ret = json_stream_feed(parser, (const char *)buf->data,
+				       buf->len);
+	}
+
+	return ret;
+}
+
+static struct net_buf *net_buf_appender_alloc(k_timeout_t timeout,
+					      void *user_data)
+{
+	struct json_net_buf_appender *appender = user_data;
+
+	if (appender->pool == NULL) {
+		return NULL;
+	}
+
+	return net_buf_alloc(appender->pool, timeout);
+}
+
+int json_append_bytes_to_net_buf(const char *bytes, size_t len, void *data)
+{
+	struct json_net_buf_appender *appender = data;
+	size_t added;
+
+	added = net_buf_append_bytes(appender->buf, len, bytes,
+				     appender->timeout, net_buf_appender_alloc,
+				     appender);
+
+	return added == len ? 0 : -ENOMEM;
+}
+#endif /* CONFIG_NET_BUF */
@@ -0,0 +1,298 @@
+/* mpsc_pbuf.c: Multi producer, single consumer packet buffer */
+
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sys/mpsc_pbuf.h>
+#include <sys/__assert.h>
+#include <string.h>
+
+/*
+ * Packet header, the first word of each packet:
+ *
+ *   bit 0     VALID, set once the packet is committed
+ *   bit 1     BUSY, set while the packet is claimed or being dropped
+ *   bit 2     PAD, filler up to the end of the buffer, never handed out
+ *   bit 3     FREE, set once the packet is freed, dropped or skipped
+ *   bits 4-31 length of the packet in bytes, header excluded
+ *
+ * Packets from the read index up to the claim index were handed out to, or
+ * skipped by, the consumer. Those from the claim index up to the write
+ * index wait to be claimed. All free words, from the write index up to the
+ * read index, are kept zero. A header of zero thus means that the packet
+ * has been allocated but its producer did not write the header yet.
+ *
+ * Freed packets keep their space until they reach the read index. The
+ * context clearing the FREE header found there, whichever it is, then
+ * owns that space and advances the read index.
+ */
+#define HDR_VALID BIT(0)
+#define HDR_BUSY BIT(1)
+#define HDR_PAD BIT(2)
+#define HDR_FREE BIT(3)
+#define HDR_LEN_POS 4
+
+#define HDR_LEN(hdr) ((uint32_t)(hdr) >> HDR_LEN_POS)
+
+/* Packet length in words, header included */
+static inline uint32_t wlen_get(size_t len)
+{
+	return 1 + ceiling_fraction(len, sizeof(uint32_t));
+}
+
+static inline atomic_t *hdr_get(struct mpsc_pbuf_buffer *buffer, uint32_t idx)
+{
+	return (atomic_t *)&buffer->buf[idx & (buffer->size - 1)];
+}
+
+void mpsc_pbuf_init(struct mpsc_pbuf_buffer *buffer, uint32_t *data,
+		    uint32_t size, uint32_t mode, mpsc_pbuf_drop_t drop)
+{
+	__ASSERT(size && !(size & (size - 1)), "size is not a power of 2");
+
+	(void)memset(data, 0, size * sizeof(uint32_t));
+
+	buffer->buf = data;
+	buffer->size = size;
+	buffer->flags = mode;
+	buffer->drop = drop;
+	atomic_set(&buffer->wr_idx, 0);
+	atomic_set(&buffer->claim_idx, 0);
+	atomic_set(&buffer->rd_idx, 0);
+	atomic_set(&buffer->dropped, 0);
+}
+
+/* Give back the space of the freed packets at the read index. */
+static void freed_release(struct mpsc_pbuf_buffer *buffer)
+{
+	atomic_t *phdr;
+	atomic_val_t hdr;
+	uint32_t rd, wlen;
+
+	while (true) {
+		rd = (uint32_t)atomic_get(&buffer->rd_idx);
+		if (rd == (uint32_t)atomic_get(&buffer->wr_idx)) {
+			return;
+		}
+
+		phdr = hdr_get(buffer, rd);
+		hdr = atomic_get(phdr);
+		if (!(hdr & HDR_FREE) || !atomic_cas(phdr, hdr, 0)) {
+			/* Still in use, or taken by another context */
+			return;
+		}
+
+		/* The read index may have moved on, and the buffer wrapped,
+		 * between reading it and taking what was then another packet.
+		 */
+		if ((uint32_t)atomic_get(&buffer->rd_idx) != rd) {
+			atomic_set(phdr, hdr);
+			continue;
+		}
+
+		wlen = wlen_get(HDR_LEN(hdr));
+
+		/* Not claimed yet if freed before being committed */
+		(void)atomic_cas(&buffer->claim_idx, (atomic_val_t)rd,
+				 (atomic_val_t)(rd + wlen));
+
+		/* Keep free words zero before producers can allocate them */
+		(void)memset(phdr, 0, wlen * sizeof(uint32_t));
+
+		atomic_set(&buffer->rd_idx, (atomic_val_t)(rd + wlen));
+	}
+}
+
+/* Drop the oldest packet, returns false if that is not possible. */
+static bool oldest_drop(struct mpsc_pbuf_buffer *buffer)
+{
+	uint32_t rd = (uint32_t)atomic_get(&buffer->rd_idx);
+	atomic_t *phdr = hdr_get(buffer, rd);
+	atomic_val_t hdr = atomic_get(phdr);
+
+	if (hdr & HDR_FREE) {
+		/* Freed, its space is just not given back yet */
+		freed_release(buffer);
+		return true;
+	}
+
+	if ((rd != (uint32_t)atomic_get(&buffer->claim_idx)) ||
+	    !(hdr & HDR_VALID) || (hdr & HDR_BUSY) ||
+	    !atomic_cas(phdr, hdr, hdr | HDR_BUSY)) {
+		/* The oldest packet is claimed, owned or not committed yet,
+		 * unless another context gave back its space meanwhile and
+		 * the caller can retry.
+		 */
+		return (uint32_t)atomic_get(&buffer->rd_idx) != rd;
+	}
+
+	if ((uint32_t)atomic_get(&buffer->rd_idx) != rd) {
+		(void)atomic_cas(phdr, hdr | HDR_BUSY, hdr);
+		return true;
+	}
+
+	if (!(hdr & HDR_PAD)) {
+		atomic_inc(&buffer->dropped);
+
+		if (buffer->drop != NULL) {
+			buffer->drop(buffer, phdr + 1, HDR_LEN(hdr));
+		}
+	}
+
+	atomic_or(phdr, HDR_FREE);
+	freed_release(buffer);
+
+	return true;
+}
+
+void *mpsc_pbuf_alloc(struct mpsc_pbuf_buffer *buffer, size_t len)
+{
+	uint32_t wlen = wlen_get(len);
+	uint32_t rd, wr, pos, need;
+	atomic_t *phdr;
+
+	if (wlen > buffer->size || len > HDR_LEN(~0U)) {
+		atomic_inc(&buffer->dropped);
+		return NULL;
+	}
+
+	while (true) {
+		/* Read index first so that the used space is never
+		 * underestimated.
+		 */
+		rd = (uint32_t)atomic_get(&buffer->rd_idx);
+		wr = (uint32_t)atomic_get(&buffer->wr_idx);
+
+		/* A packet does not wrap, pad up to the end of the buffer */
+		pos = wr & (buffer->size - 1);
+		if (pos + wlen > buffer->size) {
+			need = buffer->size - pos;
+		} else {
+			need = wlen;
+		}
+
+		if (wr - rd + need > buffer->size) {
+			if (!(buffer->flags & MPSC_PBUF_MODE_OVERWRITE) ||
+			    !oldest_drop(buffer)) {
+				atomic_inc(&buffer->dropped);
+				return NULL;
+			}
+
+			continue;
+		}
+
+		if (!atomic_cas(&buffer->wr_idx, (atomic_val_t)wr,
+				(atomic_val_t)(wr + need))) {
+			continue;
+		}
+
+		phdr = hdr_get(buffer, wr);
+
+		if (need != wlen) {
+			atomic_set(phdr, (atomic_val_t)(HDR_PAD | HDR_VALID |
+				   (((need - 1) * sizeof(uint32_t)) <<
+				    HDR_LEN_POS)));
+			continue;
+		}
+
+		atomic_set(phdr, (atomic_val_t)(len << HDR_LEN_POS));
+
+		return phdr + 1;
+	}
+}
+
+void mpsc_pbuf_commit(struct mpsc_pbuf_buffer *buffer, void *packet)
+{
+	ARG_UNUSED(buffer);
+
+	atomic_or((atomic_t *)packet - 1, HDR_VALID);
+}
+
+void *mpsc_pbuf_claim(struct mpsc_pbuf_buffer *buffer, size_t *len)
+{
+	atomic_t *phdr;
+	atomic_val_t hdr;
+	uint32_t cl;
+
+	while (true) {
+		cl = (uint32_t)atomic_get(&buffer->claim_idx);
+		if (cl == (uint32_t)atomic_get(&buffer->wr_idx)) {
+			return NULL;
+		}
+
+		phdr = hdr_get(buffer, cl);
+		hdr = atomic_get(phdr);
+
+		if (hdr & HDR_FREE) {
+			/* Freed before being committed, or dropped */
+			(void)atomic_cas(&buffer->claim_idx, (atomic_val_t)cl,
+					 (atomic_val_t)(cl +
+						wlen_get(HDR_LEN(hdr))));
+			continue;
+		}
+
+		if (!(hdr & HDR_VALID) || (hdr & HDR_BUSY) ||
+		    !atomic_cas(phdr, hdr, hdr | HDR_BUSY)) {
+			/* Not committed yet, being dropped, or changed
+			 * meanwhile, which is retried if the claim index
+			 * moved on.
+			 */
+			if ((uint32_t)atomic_get(&buffer->claim_idx) != cl) {
+				continue;
+			}
+
+			return NULL;
+		}
+
+		/* The claim index may have moved on, and the buffer wrapped,
+		 * between reading it and setting BUSY on what was then
+		 * another packet.
+		 */
+		if ((uint32_t)atomic_get(&buffer->claim_idx) != cl) {
+			(void)atomic_cas(phdr, hdr | HDR_BUSY, hdr);
+			continue;
+		}
+
+		atomic_set(&buffer->claim_idx,
+			   (atomic_val_t)(cl + wlen_get(HDR_LEN(hdr))));
+
+		if (!(hdr & HDR_PAD)) {
+			*len = HDR_LEN(hdr);
+			return phdr + 1;
+		}
+
+		atomic_or(phdr, HDR_FREE);
+		freed_release(buffer);
+	}
+}
+
+void mpsc_pbuf_free(struct mpsc_pbuf_buffer *buffer, const void *packet)
+{
+	atomic_val_t hdr;
+
+	hdr = atomic_or((atomic_t *)packet - 1, HDR_FREE);
+
+	__ASSERT(!(hdr & HDR_VALID) || (hdr & HDR_BUSY),
+		 "packet is committed but not claimed");
+	__ASSERT(!(hdr & HDR_FREE), "packet is already freed");
+
+	freed_release(buffer);
+}
+
+bool mpsc_pbuf_is_pending(struct mpsc_pbuf_buffer *buffer)
+{
+	uint32_t cl = (uint32_t)atomic_get(&buffer->claim_idx);
+	atomic_val_t hdr;
+
+	if (cl == (uint32_t)atomic_get(&buffer->wr_idx)) {
+		return false;
+	}
+
+	hdr = atomic_get(hdr_get(buffer, cl));
+
+	return (hdr & HDR_FREE) ||
+	       ((hdr & HDR_VALID) && !(hdr & HDR_BUSY));
+}
@@ -8,6 +8,13 @@
 #include <sys/mutex.h>
 #include <syscall_handler.h>
 #include <kernel_structs.h>
+#include <kernel_internal.h>
+#include <app_memory/app_memdomain.h>
+
+#if defined(CONFIG_SYS_MUTEX_FAST_PATH) && !defined(CONFIG_SMP)
+/* Lets user threads know their ID without a k_current_get() syscall */
+K_APP_DMEM(z_libc_partition) atomic_val_t z_sys_mutex_self;
+#endif
 
 static struct k_mutex *get_k_mutex(struct sys_mutex *mutex)
 {
@@ -23,13 +30,170 @@ static struct k_mutex *get_k_mutex(struct sys_mutex *mutex)
 
 static bool check_sys_mutex_addr(struct sys_mutex *addr)
 {
-	/* sys_mutex memory is never touched, just used to lookup the
-	 * underlying k_mutex, but we don't want threads using mutexes
-	 * that are outside their memory domain
+	/* sys_mutex memory is used to lookup the underlying k_mutex, and
+	 * holds the owner with CONFIG_SYS_MUTEX_FAST_PATH, we don't want
+	 * threads using mutexes that are outside their memory domain
 	 */
 	return Z_SYSCALL_MEMORY_WRITE(addr, sizeof(struct sys_mutex));
 }
 
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+/*
+ * The mutex value is the owner thread, ORed with SYS_MUTEX_CONTENDED
+ * while the backing k_mutex holds the ownership. A thread which has to
+ * wait for a mutex locked without syscall first makes the owner own the
+ * k_mutex, then waits on it so that the owner inherits its priority. The
+ * value lives in user memory, the k_mutex state is never derived from it
+ * without checks.
+ */
+static struct k_spinlock lock;
+
+/* Thread which locked a mutex without syscall, NULL if not a thread */
+static struct k_thread *fast_owner(atomic_val_t val)
+{
+	struct z_object *obj;
+
+	obj = z_object_find((void *)(val & ~SYS_MUTEX_CONTENDED));
+	if (obj == NULL || obj->type != K_OBJ_THREAD ||
+	    (obj->flags & K_OBJ_FLAG_INITIALIZED) == 0U) {
+		return NULL;
+	}
+
+	return obj->name;
+}
+
+static k_timeout_t timeout_left(k_timeout_t timeout, uint64_t end)
+{
+	int64_t ticks;
+
+	if (K_TIMEOUT_EQ(timeout, K_FOREVER) ||
+	    K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return timeout;
+	}
+
+	ticks = (int64_t)end - z_tick_get();
+
+	return K_TICKS(MAX(ticks, 0));
+}
+
+static int fast_mutex_lock(struct sys_mutex *mutex,
+			   struct k_mutex *kernel_mutex, k_timeout_t timeout)
+{
+	atomic_val_t self = (atomic_val_t)_current;
+	uint64_t end = z_timeout_end_calc(timeout);
+	struct k_thread *owner;
+	k_spinlock_key_t key;
+	atomic_val_t val;
+	int ret;
+
+	for (;;) {
+		key = k_spin_lock(&lock);
+		val = atomic_get(&mutex->val);
+
+		if (val == 0) {
+			k_spin_unlock(&lock, key);
+			if (atomic_cas(&mutex->val, 0, self)) {
+				return 0;
+			}
+			continue;
+		}
+
+		if ((val & ~SYS_MUTEX_CONTENDED) == self) {
+			/* Recursive locking is handled without syscall */
+			k_spin_unlock(&lock, key);
+			return -EINVAL;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&lock, key);
+			return -EBUSY;
+		}
+
+		if ((val & SYS_MUTEX_CONTENDED) == 0U) {
+			owner = fast_owner(val);
+			if (owner == NULL) {
+				k_spin_unlock(&lock, key);
+				return -EINVAL;
+			}
+
+			/* From now on the owner unlocks through the kernel */
+			if (!atomic_cas(&mutex->val, val,
+					val | SYS_MUTEX_CONTENDED)) {
+				k_spin_unlock(&lock, key);
+				continue;
+			}
+
+			/* Fails if a previous waiter still holds the k_mutex,
+			 * it gives it back once it sees the new owner.
+			 */
+			if (z_mutex_adopt(kernel_mutex, owner) != 0) {
+				atomic_set(&mutex->val, val);
+			}
+		}
+
+		k_spin_unlock(&lock, key);
+
+		ret = k_mutex_lock(kernel_mutex, timeout_left(timeout, end));
+		if (ret != 0) {
+			return ret;
+		}
+
+		key = k_spin_lock(&lock);
+		val = atomic_get(&mutex->val);
+		if ((val == 0 || val == SYS_MUTEX_CONTENDED) &&
+		    atomic_cas(&mutex->val, val, self | SYS_MUTEX_CONTENDED)) {
+			k_spin_unlock(&lock, key);
+			return 0;
+		}
+		k_spin_unlock(&lock, key);
+
+		/* Locked again without syscall meanwhile, start over */
+		k_mutex_unlock(kernel_mutex);
+	}
+}
+
+static int fast_mutex_unlock(struct sys_mutex *mutex,
+			     struct k_mutex *kernel_mutex)
+{
+	atomic_val_t self = (atomic_val_t)_current;
+	k_spinlock_key_t key;
+	atomic_val_t val;
+	bool owned;
+
+	key = k_spin_lock(&lock);
+	val = atomic_get(&mutex->val);
+
+	if ((val & ~SYS_MUTEX_CONTENDED) != self) {
+		k_spin_unlock(&lock, key);
+		return (val == 0) ? -EINVAL : -EPERM;
+	}
+
+	if ((val & SYS_MUTEX_CONTENDED) == 0U) {
+		(void)atomic_cas(&mutex->val, val, 0);
+		k_spin_unlock(&lock, key);
+		return 0;
+	}
+
+	/* No owner until a waiter takes the k_mutex over */
+	atomic_set(&mutex->val, SYS_MUTEX_CONTENDED);
+	owned = (kernel_mutex->owner == _current);
+	k_spin_unlock(&lock, key);
+
+	if (owned) {
+		k_mutex_unlock(kernel_mutex);
+	}
+
+	/* Back to lock free operation if no waiter took the mutex */
+	key = k_spin_lock(&lock);
+	if (kernel_mutex->lock_count == 0U) {
+		(void)atomic_cas(&mutex->val, SYS_MUTEX_CONTENDED, 0);
+	}
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
+
 int z_impl_z_sys_mutex_kernel_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 {
 	struct k_mutex *kernel_mutex = get_k_mutex(mutex);
@@ -38,7 +202,11 @@ int z_impl_z_sys_mutex_kernel_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	return fast_mutex_lock(mutex, kernel_mutex, timeout);
+#else
 	return k_mutex_lock(kernel_mutex, timeout);
+#endif
 }
 
 static inline int z_vrfy_z_sys_mutex_kernel_lock(struct sys_mutex *mutex,
@@ -56,6 +224,13 @@ int z_impl_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
 {
 	struct k_mutex *kernel_mutex = get_k_mutex(mutex);
 
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	if (kernel_mutex == NULL) {
+		return -EINVAL;
+	}
+
+	return fast_mutex_unlock(mutex, kernel_mutex);
+#else
 	if (kernel_mutex == NULL || kernel_mutex->lock_count == 0) {
 		return -EINVAL;
 	}
@@ -66,6 +241,7 @@ int z_impl_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
 
 	k_mutex_unlock(kernel_mutex);
 	return 0;
+#endif
 }
 
 static inline int z_vrfy_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
@@ -20,6 +20,8 @@
 #include <syscall_handler.h>
 #include <logging/log.h>
 #include <sys/types.h>
+#include <string.h>
+#include <sys/ring_buffer.h>
 
 typedef int (*out_func_t)(int c, void *ctx);
 
@@ -159,16 +161,75 @@ static bool negative(printk_val_t val)
 	return (val & hibit) != 0;
 }
 
-/**
- * @brief Printk internals
- *
- * See printk() for description.
- * @param fmt Format string
- * @param ap Variable parameters
- *
- * @return N/A
+/* Source of the arguments consumed by the formatter: either the caller's
+ * va_list or, with CONFIG_PRINTK_PACKAGE, a package built by
+ * printk_vpackage()
  */
-void z_vprintk(out_func_t out, void *ctx, const char *fmt, va_list ap)
+struct fmt_args {
+	va_list ap;
+#ifdef CONFIG_PRINTK_PACKAGE
+	const uint8_t *pkg;
+	size_t pos;
+	uint32_t str_copied;
+	uint32_t str_idx;
+#endif
+};
+
+#ifdef CONFIG_PRINTK_PACKAGE
+/* Package header, followed by the raw bytes of each argument in format
+ * string order. A %s argument whose bit is set in str_copied holds the
+ * offset of the string within the package instead of a pointer, and the
+ * string itself follows right after it. Everything is accessed with
+ * memcpy() so a package may be copied anywhere without regard for
+ * alignment.
+ */
+struct pkg_hdr {
+	const char *fmt;
+	uint32_t len;
+	uint32_t str_copied;
+};
+
+#define PKG_MAX_COPIED_STRINGS 32
+
+static void pkg_arg_read(struct fmt_args *args, void *dst, size_t size)
+{
+	(void)memcpy(dst, args->pkg + args->pos, size);
+	args->pos += size;
+}
+
+#define FMT_ARG(args, type) ({					\
+	type _arg;						\
+								\
+	if ((args)->pkg == NULL) {				\
+		_arg = va_arg((args)->ap, type);		\
+	} else {						\
+		pkg_arg_read((args), &_arg, sizeof(_arg));	\
+	}							\
+	_arg;							\
+})
+
+static char *pkg_str_resolve(struct fmt_args *args, char *s)
+{
+	if (args->pkg == NULL) {
+		return s;
+	}
+
+	if ((args->str_idx < PKG_MAX_COPIED_STRINGS) &&
+	    ((args->str_copied & BIT(args->str_idx)) != 0U)) {
+		s = (char *)args->pkg + (uintptr_t)s;
+		args->pos += strlen(s) + 1;
+	}
+	args->str_idx++;
+
+	return s;
+}
+#else
+#define FMT_ARG(args, type) va_arg((args)->ap, type)
+#define pkg_str_resolve(args, s) (s)
+#endif /* CONFIG_PRINTK_PACKAGE */
+
+static void fmt_run(out_func_t out, void *ctx, const char *fmt,
+		    struct fmt_args *args)
 {
 	int might_format = 0; /* 1 if encountered a '%' */
 	enum pad_type padding = PAD_NONE;
@@ -239,17 +300,19 @@ void z_vprintk(out_func_t out, void *ctx, const char *fmt, va_list ap)
 				printk_val_t d;
 
 				if (length_mod == 'z') {
-					d = va_arg(ap, ssize_t);
+					d = FMT_ARG(args, ssize_t);
 				} else if (length_mod == 'l') {
-					d = va_arg(ap, long);
+					d = FMT_ARG(args, long);
 				} else if (length_mod == 'L') {
-					long long lld = va_arg(ap, long long);
+					long long lld;
+
+					lld = FMT_ARG(args, long long);
 					if (!ok64(out, ctx, lld)) {
 						break;
 					}
 					d = (printk_val_t) lld;
 				} else {
-					d = va_arg(ap, int);
+					d = FMT_ARG(args, int);
 				}
 
 				if (*fmt != 'u' && negative(d)) {
@@ -272,21 +335,24 @@ void z_vprintk(out_func_t out, void *ctx, const char *fmt, va_list ap)
 				printk_val_t x;
 
 				if (*fmt == 'p') {
-					x = (uintptr_t)va_arg(ap, void *);
+					x = (uintptr_t)FMT_ARG(args, void *);
 				} else if (length_mod == 'l') {
-					x = va_arg(ap, unsigned long);
+					x = FMT_ARG(args, unsigned long);
 				} else if (length_mod == 'L') {
-					x = va_arg(ap, unsigned long long);
+					x = FMT_ARG(args, unsigned long long);
 				} else {
-					x = va_arg(ap, unsigned int);
+					x = FMT_ARG(args, unsigned int);
 				}
 
 				print_hex(out, ctx, x, padding, min_width);
 				break;
 			}
 			case 's': {
-				char *s = va_arg(ap, char *);
-				char *start = s;
+				char *s = FMT_ARG(args, char *);
+				char *start;
+
+				s = pkg_str_resolve(args, s);
+				start = s;
 
 				while (*s) {
 					out((int)(*s++), ctx);
@@ -301,7 +367,7 @@ void z_vprintk(out_func_t out, void *ctx, const char *fmt, va_list ap)
 				break;
 			}
 			case 'c': {
-				int c = va_arg(ap, int);
+				int c = FMT_ARG(args, int);
 
 				out(c, ctx);
 				break;
@@ -322,6 +388,223 @@ still_might_format:
 	}
 }
 
+/**
+ * @brief Printk internals
+ *
+ * See printk() for description.
+ * @param fmt Format string
+ * @param ap Variable parameters
+ *
+ * @return N/A
+ */
+void z_vprintk(out_func_t out, void *ctx, const char *fmt, va_list ap)
+{
+	struct fmt_args args;
+
+	va_copy(args.ap, ap);
+#ifdef CONFIG_PRINTK_PACKAGE
+	args.pkg = NULL;
+#endif
+	fmt_run(out, ctx, fmt, &args);
+	va_end(args.ap);
+}
+
+#ifdef CONFIG_PRINTK_PACKAGE
+static bool ptr_in_rodata(const char *addr)
+{
+#if defined(CONFIG_ARM) || defined(CONFIG_ARC) || defined(CONFIG_X86)
+	extern const char _image_rodata_start[];
+	extern const char _image_rodata_end[];
+	#define RO_START _image_rodata_start
+	#define RO_END _image_rodata_end
+#elif defined(CONFIG_NIOS2) || defined(CONFIG_RISCV)
+	extern const char _image_rom_start[];
+	extern const char _image_rom_end[];
+	#define RO_START _image_rom_start
+	#define RO_END _image_rom_end
+#elif defined(CONFIG_XTENSA)
+	extern const char _rodata_start[];
+	extern const char _rodata_end[];
+	#define RO_START _rodata_start
+	#define RO_END _rodata_end
+#else
+	#define RO_START 0
+	#define RO_END 0
+#endif
+
+	return (addr >= (const char *)RO_START) &&
+	       (addr < (const char *)RO_END);
+}
+
+struct pkg_out {
+	uint8_t *buf;
+	size_t len;
+	size_t pos;
+};
+
+static void pkg_put(struct pkg_out *pkg, const void *data, size_t size)
+{
+	if ((pkg->buf != NULL) && (pkg->pos + size <= pkg->len)) {
+		(void)memcpy(pkg->buf + pkg->pos, data, size);
+	}
+	pkg->pos += size;
+}
+
+#define PKG_ARG(pkg, ap, type) do {			\
+		type _arg = va_arg(ap, type);		\
+							\
+		pkg_put((pkg), &_arg, sizeof(_arg));	\
+	} while (false)
+
+int printk_vpackage(void *packaged, size_t len, const char *fmt, va_list ap)
+{
+	struct pkg_out pkg = { .buf = packaged, .len = len };
+	struct pkg_hdr hdr = { .fmt = fmt };
+	const char *f = fmt;
+	bool might_format = false;
+	char length_mod = 0;
+	uint32_t str_idx = 0U;
+
+	/* Header goes in last, once the length is known */
+	pkg.pos = sizeof(hdr);
+
+	/* This walks the format string exactly like fmt_run() does, so that
+	 * it consumes the same arguments with the same types
+	 */
+	for (; *f != '\0'; f++) {
+		if (!might_format) {
+			if (*f == '%') {
+				might_format = true;
+				length_mod = 0;
+			}
+			continue;
+		}
+
+		switch (*f) {
+		case '-':
+		case '0':
+		case '1':
+		case '2':
+		case '3':
+		case '4':
+		case '5':
+		case '6':
+		case '7':
+		case '8':
+		case '9':
+			continue;
+		case 'h':
+		case 'l':
+		case 'z':
+			if (*f == 'h' && length_mod == 'h') {
+				length_mod = 'H';
+			} else if (*f == 'l' && length_mod == 'l') {
+				length_mod = 'L';
+			} else if (length_mod == 0) {
+				length_mod = *f;
+			} else {
+				break;
+			}
+			continue;
+		case 'd':
+		case 'i':
+		case 'u':
+			if (length_mod == 'z') {
+				PKG_ARG(&pkg, ap, ssize_t);
+			} else if (length_mod == 'l') {
+				PKG_ARG(&pkg, ap, long);
+			} else if (length_mod == 'L') {
+				PKG_ARG(&pkg, ap, long long);
+			} else {
+				PKG_ARG(&pkg, ap, int);
+			}
+			break;
+		case 'p':
+			PKG_ARG(&pkg, ap, void *);
+			break;
+		case 'x':
+		case 'X':
+			if (length_mod == 'l') {
+				PKG_ARG(&pkg, ap, unsigned long);
+			} else if (length_mod == 'L') {
+				PKG_ARG(&pkg, ap, unsigned long long);
+			} else {
+				PKG_ARG(&pkg, ap, unsigned int);
+			}
+			break;
+		case 's': {
+			const char *str = va_arg(ap, const char *);
+
+			if ((str == NULL) || ptr_in_rodata(str)) {
+				pkg_put(&pkg, &str, sizeof(str));
+			} else if (str_idx < PKG_MAX_COPIED_STRINGS) {
+				uintptr_t off = pkg.pos + sizeof(off);
+
+				pkg_put(&pkg, &off, sizeof(off));
+				pkg_put(&pkg, str, strlen(str) + 1);
+				hdr.str_copied |= BIT(str_idx);
+			} else {
+				return -EINVAL;
+			}
+			str_idx++;
+			break;
+		}
+		case 'c':
+			PKG_ARG(&pkg, ap, int);
+			break;
+		default:
+			break;
+		}
+		might_format = false;
+	}
+
+	hdr.len = pkg.pos;
+	if (packaged != NULL) {
+		if (pkg.pos > len) {
+			return -ENOSPC;
+		}
+		(void)memcpy(packaged, &hdr, sizeof(hdr));
+	}
+
+	return pkg.pos;
+}
+
+int printk_package(void *packaged, size_t len, const char *fmt, ...)
+{
+	va_list ap;
+	int ret;
+
+	va_start(ap, fmt);
+	ret = printk_vpackage(packaged, len, fmt, ap);
+	va_end(ap);
+
+	return ret;
+}
+
+size_t printk_package_len(const void *packaged)
+{
+	struct pkg_hdr hdr;
+
+	(void)memcpy(&hdr, packaged, sizeof(hdr));
+
+	return hdr.len;
+}
+
+void printk_package_render(int (*out)(int c, void *ctx), void *ctx,
+			   const void *packaged)
+{
+	struct fmt_args args = { .pkg = packaged };
+	struct pkg_hdr hdr;
+
+	(void)memcpy(&hdr, packaged, sizeof(hdr));
+	args.pos = sizeof(hdr);
+	args.str_copied = hdr.str_copied;
+
+	fmt_run(out, ctx, hdr.fmt, &args);
+}
+#endif /* CONFIG_PRINTK_PACKAGE */
+
+
 #ifdef CONFIG_PRINTK
 #ifdef CONFIG_USERSPACE
 struct buf_out_context {
@@ -362,6 +645,123 @@ static int char_out(int c, void *ctx_p)
 	return _char_out(c);
 }
 
+#ifdef CONFIG_PRINTK_DEFERRED
+#define DEFERRED_PKG_WORDS \
+	ceiling_fraction(CONFIG_PRINTK_DEFERRED_MAX_PACKAGE_SIZE, sizeof(uint32_t))
+
+RING_BUF_ITEM_DECLARE_SIZE(printk_deferred_rb,
+			   CONFIG_PRINTK_DEFERRED_BUFFER_SIZE /
+			   sizeof(uint32_t));
+static struct k_spinlock deferred_lock;
+static K_SEM_DEFINE(deferred_sem, 0, 1);
+static atomic_t deferred_dropped;
+static bool deferred_panic;
+
+static void printk_immediate(const char *fmt, ...)
+{
+	struct out_context ctx = { 0 };
+	va_list ap;
+
+	va_start(ap, fmt);
+	z_vprintk(char_out, &ctx, fmt, ap);
+	va_end(ap);
+}
+
+/* Package the message and queue it for the printk thread. Returns nonzero
+ * if the message has to be printed right away instead.
+ */
+static int deferred_put(const char *fmt, va_list ap)
+{
+	uint32_t pkg[DEFERRED_PKG_WORDS];
+	k_spinlock_key_t key;
+	va_list aq;
+	int len;
+	int ret;
+
+	if (deferred_panic || k_is_pre_kernel()) {
+		return -EAGAIN;
+	}
+
+	va_copy(aq, ap);
+	len = printk_vpackage(pkg, sizeof(pkg), fmt, aq);
+	va_end(aq);
+	if (len < 0) {
+		return len;
+	}
+
+	key = k_spin_lock(&deferred_lock);
+	ret = ring_buf_item_put(&printk_deferred_rb, 0, 0, pkg,
+				ceiling_fraction(len, sizeof(uint32_t)));
+	k_spin_unlock(&deferred_lock, key);
+
+	if (ret != 0) {
+		atomic_inc(&deferred_dropped);
+	} else {
+		k_sem_give(&deferred_sem);
+	}
+
+	return 0;
+}
+
+static void deferred_drain(void)
+{
+	uint32_t pkg[DEFERRED_PKG_WORDS];
+	k_spinlock_key_t key;
+	atomic_val_t dropped;
+	uint16_t type;
+	uint8_t value;
+	uint8_t size32;
+	int ret;
+
+	do {
+		size32 = DEFERRED_PKG_WORDS;
+		key = k_spin_lock(&deferred_lock);
+		ret = ring_buf_item_get(&printk_deferred_rb, &type, &value,
+					pkg, &size32);
+		k_spin_unlock(&deferred_lock, key);
+
+		if (ret == 0) {
+			struct out_context ctx = { 0 };
+#ifdef CONFIG_PRINTK_SYNC
+			key = k_spin_lock(&lock);
+#endif
+			printk_package_render(char_out, &ctx, pkg);
+#ifdef CONFIG_PRINTK_SYNC
+			k_spin_unlock(&lock, key);
+#endif
+		}
+	} while (ret == 0);
+
+	dropped = atomic_set(&deferred_dropped, 0);
+	if (dropped != 0) {
+		printk_immediate("--- %d printk messages dropped ---\n",
+				 (int)dropped);
+	}
+}
+
+void printk_deferred_panic(void)
+{
+	deferred_panic = true;
+	deferred_drain();
+}
+
+static void printk_deferred_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		(void)k_sem_take(&deferred_sem, K_FOREVER);
+		deferred_drain();
+	}
+}
+
+K_THREAD_DEFINE(printk_deferred, CONFIG_PRINTK_DEFERRED_STACK_SIZE,
+		printk_deferred_thread, NULL, NULL, NULL,
+		K_LOWEST_APPLICATION_THREAD_PRIO, 0, 0);
+#endif /* CONFIG_PRINTK_DEFERRED */
+
 #ifdef CONFIG_USERSPACE
 void vprintk(const char *fmt, va_list ap)
 {
@@ -375,6 +775,11 @@ void vprintk(const char *fmt, va_list ap)
 		}
 	} else {
 		struct out_context ctx = { 0 };
+#ifdef CONFIG_PRINTK_DEFERRED
+		if (deferred_put(fmt, ap) == 0) {
+			return;
+		}
+#endif
 #ifdef CONFIG_PRINTK_SYNC
 		k_spinlock_key_t key = k_spin_lock(&lock);
 #endif
@@ -390,6 +795,11 @@ void vprintk(const char *fmt, va_list ap)
 void vprintk(const char *fmt, va_list ap)
 {
 	struct out_context ctx = { 0 };
+#ifdef CONFIG_PRINTK_DEFERRED
+	if (deferred_put(fmt, ap) == 0) {
+		return;
+	}
+#endif
 #ifdef CONFIG_PRINTK_SYNC
 	k_spinlock_key_t key = k_spin_lock(&lock);
 #endif
@@ -510,3 +920,18 @@ int vsnprintk(char *str, size_t size, const char *fmt, va_list ap)
 
 	return ctx.count;
 }
+
+#ifdef CONFIG_PRINTK_PACKAGE
+int snprintk_package(char *str, size_t size, const void *packaged)
+{
+	struct str_context ctx = { str, size, 0 };
+
+	printk_package_render((out_func_t)str_out, &ctx, packaged);
+
+	if (ctx.count < ctx.max) {
+		str[ctx.count] = '\0';
+	}
+
+	return ctx.count;
+}
+#endif /* CONFIG_PRINTK_PACKAGE */
@@ -39,13 +39,15 @@ int ring_buf_item_put(struct ring_buf *buf, uint16_t type, uint8_t value,
 				index = (i + buf->tail + 1) & buf->mask;
 				buf->buf.buf32[index] = data[i];
 			}
-			buf->tail = (buf->tail + size32 + 1) & buf->mask;
+			z_ring_buf_idx_set(&buf->tail,
+					   (buf->tail + size32 + 1) & buf->mask);
 		} else {
 			for (i = 0U; i < size32; ++i) {
 				index = (i + buf->tail + 1) % buf->size;
 				buf->buf.buf32[index] = data[i];
 			}
-			buf->tail = (buf->tail + size32 + 1) % buf->size;
+			z_ring_buf_idx_set(&buf->tail,
+					   (buf->tail + size32 + 1) % buf->size);
 		}
 		rc = 0U;
 	} else {
@@ -82,13 +84,15 @@ int ring_buf_item_get(struct ring_buf *buf, uint16_t *type, uint8_t *value,
 			index = (i + buf->head + 1) & buf->mask;
 			data[i] = buf->buf.buf32[index];
 		}
-		buf->head = (buf->head + header->length + 1) & buf->mask;
+		z_ring_buf_idx_set(&buf->head,
+				(buf->head + header->length + 1) & buf->mask);
 	} else {
 		for (i = 0U; i < header->length; ++i) {
 			index = (i + buf->head + 1) % buf->size;
 			data[i] = buf->buf.buf32[index];
 		}
-		buf->head = (buf->head + header->length + 1) % buf->size;
+		z_ring_buf_idx_set(&buf->head,
+				(buf->head + header->length + 1) % buf->size);
 	}
 
 	return 0;
@@ -106,11 +110,28 @@ static inline uint32_t wrap(uint32_t val, uint32_t max)
 	return val >= max ? (val - max) : val;
 }
 
+/** @brief Wraps index of a byte mode ring buffer.
+ *
+ * @param buf  Address of ring buffer.
+ * @param val  Index, at most twice the buffer size.
+ *
+ * @return @a val wrapped into the buffer, masked if the size is a power of 2.
+ */
+static inline uint32_t idx_wrap(struct ring_buf *buf, uint32_t val)
+{
+	if (likely(buf->mask)) {
+		return val & buf->mask;
+	}
+
+	return wrap(val, buf->size);
+}
+
 uint32_t ring_buf_put_claim(struct ring_buf *buf, uint8_t **data, uint32_t size)
 {
 	uint32_t space, trail_size, allocated;
 
-	space = z_ring_buf_custom_space_get(buf->size, buf->head,
+	space = z_ring_buf_custom_space_get(buf->size,
+					    z_ring_buf_idx_get(&buf->head),
 					    buf->misc.byte_mode.tmp_tail);
 
 	/* Limit requested size to available size. */
@@ -122,7 +143,7 @@ uint32_t ring_buf_put_claim(struct ring_buf *buf, uint8_t **data, uint32_t size)
 
 	*data = &buf->buf.buf8[buf->misc.byte_mode.tmp_tail];
 	buf->misc.byte_mode.tmp_tail =
-		wrap(buf->misc.byte_mode.tmp_tail + allocated, buf->size);
+		idx_wrap(buf, buf->misc.byte_mode.tmp_tail + allocated);
 
 	return allocated;
 }
@@ -133,8 +154,8 @@ int ring_buf_put_finish(struct ring_buf *buf, uint32_t size)
 		return -EINVAL;
 	}
 
-	buf->tail = wrap(buf->tail + size, buf->size);
-	buf->misc.byte_mode.tmp_tail = buf->tail;
+	buf->misc.byte_mode.tmp_tail = idx_wrap(buf, buf->tail + size);
+	z_ring_buf_idx_set(&buf->tail, buf->misc.byte_mode.tmp_tail);
 
 	return 0;
 }
@@ -167,7 +188,7 @@ uint32_t ring_buf_get_claim(struct ring_buf *buf, uint8_t **data, uint32_t size)
 	space = (buf->size - 1) -
 		z_ring_buf_custom_space_get(buf->size,
 					    buf->misc.byte_mode.tmp_head,
-					    buf->tail);
+					    z_ring_buf_idx_get(&buf->tail));
 	trail_size = buf->size - buf->misc.byte_mode.tmp_head;
 
 	/* Limit requested size to available size. */
@@ -178,7 +199,7 @@ uint32_t ring_buf_get_claim(struct ring_buf *buf, uint8_t **data, uint32_t size)
 
 	*data = &buf->buf.buf8[buf->misc.byte_mode.tmp_head];
 	buf->misc.byte_mode.tmp_head =
-		wrap(buf->misc.byte_mode.tmp_head + granted_size, buf->size);
+		idx_wrap(buf, buf->misc.byte_mode.tmp_head + granted_size);
 
 	return granted_size;
 }
@@ -191,8 +212,8 @@ int ring_buf_get_finish(struct ring_buf *buf, uint32_t size)
 		return -EINVAL;
 	}
 
-	buf->head = wrap(buf->head + size, buf->size);
-	buf->misc.byte_mode.tmp_head = buf->head;
+	buf->misc.byte_mode.tmp_head = idx_wrap(buf, buf->head + size);
+	z_ring_buf_idx_set(&buf->head, buf->misc.byte_mode.tmp_head);
 
 	return 0;
 }
@@ -217,3 +238,160 @@ uint32_t ring_buf_get(struct ring_buf *buf, uint8_t *data, uint32_t size)
 
 	return total_size;
 }
+
+/*
+ * Multi-producer and multi-consumer claims.
+ *
+ * The writers share the tmp_tail word (the readers tmp_head) as an atomic
+ * state: the index up to which space is reserved, the number of claims not
+ * finished yet, and an owner flag. Whenever no claim is outstanding, all
+ * data up to the reserved index is complete and can be published to the
+ * tail (head) index. Only the owner publishes, so the published index
+ * never moves backwards; it keeps publishing until it sees the state
+ * unchanged, then gives ownership up.
+ */
+#define MP_IDX_MASK	BIT_MASK(24)
+#define MP_CNT_SHIFT	24
+#define MP_CNT_MASK	(BIT_MASK(7) << MP_CNT_SHIFT)
+#define MP_OWNER	BIT(31)
+
+static uint32_t mp_claim(struct ring_buf *buf, atomic_t *state,
+			 const uint32_t *limit, bool put, uint8_t **data,
+			 uint32_t size)
+{
+	atomic_val_t old, new;
+	uint32_t idx, avail, granted;
+
+	__ASSERT(buf->size <= MP_IDX_MASK, "ring buffer too large");
+
+	do {
+		old = atomic_get(state);
+		idx = old & MP_IDX_MASK;
+
+		__ASSERT((old & MP_CNT_MASK) != MP_CNT_MASK,
+			 "too many outstanding claims");
+
+		if (put) {
+			avail = z_ring_buf_custom_space_get(buf->size,
+						z_ring_buf_idx_get(limit), idx);
+		} else {
+			avail = (buf->size - 1) -
+				z_ring_buf_custom_space_get(buf->size, idx,
+						z_ring_buf_idx_get(limit));
+		}
+
+		granted = MIN(MIN(size, avail), buf->size - idx);
+		if (granted == 0U) {
+			return 0;
+		}
+
+		new = ((old & ~MP_IDX_MASK) + BIT(MP_CNT_SHIFT)) |
+		      idx_wrap(buf, idx + granted);
+	} while (!atomic_cas(state, old, new));
+
+	*data = &buf->buf.buf8[idx];
+
+	return granted;
+}
+
+static void mp_finish(atomic_t *state, uint32_t *pub)
+{
+	atomic_val_t old, new;
+
+	do {
+		old = atomic_get(state);
+		__ASSERT((old & MP_CNT_MASK) != 0, "no outstanding claim");
+
+		new = old - BIT(MP_CNT_SHIFT);
+		if ((new & MP_CNT_MASK) == 0) {
+			new |= MP_OWNER;
+		}
+	} while (!atomic_cas(state, old, new));
+
+	/* Claims outstanding, or the owner will see this one finished */
+	if ((new & MP_CNT_MASK) != 0 || (old & MP_OWNER) != 0) {
+		return;
+	}
+
+	old = new;
+	for (;;) {
+		if ((old & MP_CNT_MASK) == 0) {
+			z_ring_buf_idx_set(pub, old & MP_IDX_MASK);
+		}
+
+		if (atomic_cas(state, old, old & ~MP_OWNER)) {
+			break;
+		}
+
+		old = atomic_get(state);
+	}
+}
+
+uint32_t ring_buf_mp_put_claim(struct ring_buf *buf, uint8_t **data,
+			       uint32_t size)
+{
+	return mp_claim(buf, (atomic_t *)&buf->misc.byte_mode.tmp_tail,
+			&buf->head, true, data, size);
+}
+
+void ring_buf_mp_put_finish(struct ring_buf *buf)
+{
+	mp_finish((atomic_t *)&buf->misc.byte_mode.tmp_tail, &buf->tail);
+}
+
+uint32_t ring_buf_mp_put(struct ring_buf *buf, const uint8_t *data,
+			 uint32_t size)
+{
+	uint8_t *dst;
+	uint32_t partial_size;
+	uint32_t total_size = 0U;
+
+	while (size != 0U) {
+		partial_size = ring_buf_mp_put_claim(buf, &dst, size);
+		if (partial_size == 0U) {
+			break;
+		}
+
+		memcpy(dst, data, partial_size);
+		ring_buf_mp_put_finish(buf);
+		total_size += partial_size;
+		size -= partial_size;
+		data += partial_size;
+	}
+
+	return total_size;
+}
+
+uint32_t ring_buf_mc_get_claim(struct ring_buf *buf, uint8_t **data,
+			       uint32_t size)
+{
+	return mp_claim(buf, (atomic_t *)&buf->misc.byte_mode.tmp_head,
+			&buf->tail, false, data, size);
+}
+
+void ring_buf_mc_get_finish(struct ring_buf *buf)
+{
+	mp_finish((atomic_t *)&buf->misc.byte_mode.tmp_head, &buf->head);
+}
+
+uint32_t ring_buf_mc_get(struct ring_buf *buf, uint8_t *data, uint32_t size)
+{
+	uint8_t *src;
+	uint32_t partial_size;
+	uint32_t total_size = 0U;
+
+	while (size != 0U) {
+		partial_size = ring_buf_mc_get_claim(buf, &src, size);
+		if (partial_size == 0U) {
+			break;
+		}
+
+		memcpy(data, src, partial_size);
+		ring_buf_mc_get_finish(buf);
+		total_size += partial_size;
+		size -= partial_size;
+		data += partial_size;
+	}
+
+	return total_size;
+}
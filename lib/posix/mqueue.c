@@ -17,6 +17,7 @@ typedef struct mqueue_object {
 	struct k_msgq queue;
 	atomic_t ref_count;
 	char *name;
+	uint32_t name_hash;
 } mqueue_object;
 
 typedef struct mqueue_desc {
@@ -27,10 +28,11 @@ typedef struct mqueue_desc {
 
 K_SEM_DEFINE(mq_sem, 1, 1);
 
-/* Initialize the list */
-sys_slist_t mq_list = SYS_SLIST_STATIC_INIT(&mq_list);
+/* Queues hashed by name */
+static sys_slist_t mq_hash[CONFIG_MQUEUE_HASH_BUCKETS];
 
 int64_t timespec_to_timeoutms(const struct timespec *abstime);
+static uint32_t name_hash(const char *name);
 static mqueue_object *find_in_list(const char *name);
 static int32_t send_message(mqueue_desc *mqd, const char *msg_ptr, size_t msg_len,
 			  k_timeout_t timeout);
@@ -135,6 +137,7 @@ mqd_t mq_open(const char *name, int oflags, ...)
 		}
 
 		strcpy(msg_queue->name, name);
+		msg_queue->name_hash = name_hash(name);
 
 		mq_buf_ptr = k_malloc(msg_size * max_msgs * sizeof(uint8_t));
 		if (mq_buf_ptr != NULL) {
@@ -150,7 +153,9 @@ mqd_t mq_open(const char *name, int oflags, ...)
 		k_msgq_init(&msg_queue->queue, msg_queue->mem_buffer, msg_size,
 			    max_msgs);
 		k_sem_take(&mq_sem, K_FOREVER);
-		sys_slist_append(&mq_list, (sys_snode_t *)&(msg_queue->snode));
+		sys_slist_append(&mq_hash[msg_queue->name_hash %
+					  CONFIG_MQUEUE_HASH_BUCKETS],
+				 (sys_snode_t *)&(msg_queue->snode));
 		k_sem_give(&mq_sem);
 
 	} else {
@@ -340,17 +345,142 @@ int mq_setattr(mqd_t mqdes, const struct mq_attr *mqstat,
 	return 0;
 }
 
+/**
+ * @brief Claim the next free message slot of a message queue.
+ *
+ * Zephyr extension. The message is written in place, of up to the message
+ * size of the queue, and sent with mq_send_commit(). A queue has at most
+ * one claimed slot at a time, mq_send() fails with EBUSY meanwhile.
+ */
+int mq_send_claim(mqd_t mqdes, void **msg_ptr)
+{
+	mqueue_desc *mqd = (mqueue_desc *)mqdes;
+	k_timeout_t timeout = K_FOREVER;
+	int ret;
+
+	if (mqd == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if ((mqd->flags & O_NONBLOCK) != 0U) {
+		timeout = K_NO_WAIT;
+	}
+
+	ret = k_msgq_put_claim(&mqd->mqueue->queue, msg_ptr, timeout);
+	if (ret != 0) {
+		errno = (ret == -EBUSY) ? EBUSY : EAGAIN;
+		return -1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Send the message written in the slot claimed by mq_send_claim().
+ *
+ * Zephyr extension.
+ */
+int mq_send_commit(mqd_t mqdes)
+{
+	mqueue_desc *mqd = (mqueue_desc *)mqdes;
+
+	if (mqd == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (k_msgq_put_commit(&mqd->mqueue->queue) != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Claim the oldest message of a message queue.
+ *
+ * Zephyr extension. The message is read in place and stays queued until
+ * mq_receive_release(). A queue has at most one claimed message at a
+ * time, mq_receive() fails with EBUSY meanwhile.
+ *
+ * @return Size of the message, -1 on error.
+ */
+int mq_receive_claim(mqd_t mqdes, void **msg_ptr)
+{
+	mqueue_desc *mqd = (mqueue_desc *)mqdes;
+	k_timeout_t timeout = K_FOREVER;
+	int ret;
+
+	if (mqd == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if ((mqd->flags & O_NONBLOCK) != 0U) {
+		timeout = K_NO_WAIT;
+	}
+
+	ret = k_msgq_get_claim(&mqd->mqueue->queue, msg_ptr, timeout);
+	if (ret != 0) {
+		errno = (ret == -EBUSY) ? EBUSY : EAGAIN;
+		return -1;
+	}
+
+	return mqd->mqueue->queue.msg_size;
+}
+
+/**
+ * @brief Remove the message claimed by mq_receive_claim() from its queue.
+ *
+ * Zephyr extension.
+ */
+int mq_receive_release(mqd_t mqdes)
+{
+	mqueue_desc *mqd = (mqueue_desc *)mqdes;
+
+	if (mqd == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (k_msgq_get_release(&mqd->mqueue->queue) != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	return 0;
+}
+
 /* Internal functions */
+
+/* FNV-1a */
+static uint32_t name_hash(const char *name)
+{
+	uint32_t hash = 2166136261U;
+
+	while (*name != '\0') {
+		hash ^= (uint8_t)*name++;
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
 static mqueue_object *find_in_list(const char *name)
 {
+	uint32_t hash = name_hash(name);
 	sys_snode_t *mq;
 	mqueue_object *msg_queue;
 
-	mq = mq_list.head;
+	mq = mq_hash[hash % CONFIG_MQUEUE_HASH_BUCKETS].head;
 
 	while (mq != NULL) {
 		msg_queue = (mqueue_object *)mq;
-		if (strcmp(msg_queue->name, name) == 0) {
+		/* unlinked queues stay listed until closed, without name */
+		if (msg_queue->name_hash == hash && msg_queue->name != NULL &&
+		    strcmp(msg_queue->name, name) == 0) {
 			return msg_queue;
 		}
 
@@ -419,7 +549,9 @@ static void remove_mq(mqueue_object *msg_queue)
 {
 	if (atomic_cas(&msg_queue->ref_count, 0, 0)) {
 		k_sem_take(&mq_sem, K_FOREVER);
-		sys_slist_find_and_remove(&mq_list, (sys_snode_t *) msg_queue);
+		sys_slist_find_and_remove(&mq_hash[msg_queue->name_hash %
+						   CONFIG_MQUEUE_HASH_BUCKETS],
+					  (sys_snode_t *) msg_queue);
 		k_sem_give(&mq_sem);
 
 		/* Free mq buffer and pbject */
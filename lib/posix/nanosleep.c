@@ -11,6 +11,9 @@
 /* required for struct timespec */
 #include <posix/time.h>
 #include <sys_clock.h>
+#ifdef CONFIG_POSIX_HRTIMER
+#include <sys/hrtimer.h>
+#endif
 
 /**
  * @brief Suspend execution for nanosecond intervals.
@@ -47,7 +50,13 @@ int nanosleep(const struct timespec *rqtp, struct timespec *rmtp)
 		ns = rqtp->tv_sec * NSEC_PER_SEC + rqtp->tv_nsec;
 	}
 
-	/* currently we have no mechanism to achieve greater resolution */
+#ifdef CONFIG_POSIX_HRTIMER
+	if (sys_hrtimer_sleep_ns(ns) == 0) {
+		goto do_rmtp_update;
+	}
+#endif
+
+	/* no mechanism to achieve greater resolution, busy wait */
 	k_busy_wait(ns / NSEC_PER_USEC);
 
 do_rmtp_update:
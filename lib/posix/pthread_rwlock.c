@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <kernel.h>
+#include <ksched.h>
+#include <wait_q.h>
 #include <errno.h>
 #include <posix/time.h>
 #include <posix/posix_types.h>
@@ -11,7 +13,18 @@
 #define INITIALIZED 1
 #define NOT_INITIALIZED 0
 
-#define CONCURRENT_READER_LIMIT  (CONFIG_MAX_PTHREAD_COUNT + 1)
+/*
+ * The lock state word holds the writer flag, a flag telling that threads
+ * wait for the lock, and the number of readers. Uncontended locks and
+ * unlocks only update it atomically. Once a thread waits, all operations
+ * go through the slow path under irq_lock(), where the lock is handed
+ * over to the waiting threads.
+ */
+#define RW_WRITER BIT(0)
+#define RW_WAITERS BIT(1)
+#define RW_READER 4
+
+#define PREFER_WRITER IS_ENABLED(CONFIG_PTHREAD_RWLOCK_PREFER_WRITER)
 
 int64_t timespec_to_timeoutms(const struct timespec *abstime);
 static uint32_t read_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout);
@@ -25,10 +38,11 @@ static uint32_t write_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout);
 int pthread_rwlock_init(pthread_rwlock_t *rwlock,
 			const pthread_rwlockattr_t *attr)
 {
-	k_sem_init(&rwlock->rd_sem, CONCURRENT_READER_LIMIT,
-		   CONCURRENT_READER_LIMIT);
-	k_sem_init(&rwlock->wr_sem, 1, 1);
-	k_sem_init(&rwlock->reader_active, 1, 1);
+	atomic_set(&rwlock->state, 0);
+	z_waitq_init(&rwlock->rd_wait_q);
+	z_waitq_init(&rwlock->wr_wait_q);
+	rwlock->rd_waiting = 0U;
+	rwlock->wr_waiting = 0U;
 	rwlock->wr_owner = NULL;
 	rwlock->status = INITIALIZED;
 	return 0;
@@ -45,7 +59,7 @@ int pthread_rwlock_destroy(pthread_rwlock_t *rwlock)
 		return EINVAL;
 	}
 
-	if (rwlock->wr_owner != NULL) {
+	if (atomic_get(&rwlock->state) != 0) {
 		return EBUSY;
 	}
 
@@ -60,9 +74,6 @@ int pthread_rwlock_destroy(pthread_rwlock_t *rwlock)
 /**
  * @brief Lock a read-write lock object for reading.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_rdlock(pthread_rwlock_t *rwlock)
@@ -77,9 +88,6 @@ int pthread_rwlock_rdlock(pthread_rwlock_t *rwlock)
 /**
  * @brief Lock a read-write lock object for reading within specific time.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_timedrdlock(pthread_rwlock_t *rwlock,
@@ -105,9 +113,6 @@ int pthread_rwlock_timedrdlock(pthread_rwlock_t *rwlock,
 /**
  * @brief Lock a read-write lock object for reading immedately.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_tryrdlock(pthread_rwlock_t *rwlock)
@@ -122,8 +127,9 @@ int pthread_rwlock_tryrdlock(pthread_rwlock_t *rwlock)
 /**
  * @brief Lock a read-write lock object for writing.
  *
- * Write lock does not have priority over reader lock,
- * threads get lock based on priority.
+ * With CONFIG_PTHREAD_RWLOCK_PREFER_WRITER, waiting writers have
+ * priority over new readers. Otherwise readers may join a read locked
+ * lock while writers wait.
  *
  * See IEEE 1003.1
  */
@@ -139,9 +145,6 @@ int pthread_rwlock_wrlock(pthread_rwlock_t *rwlock)
 /**
  * @brief Lock a read-write lock object for writing within specific time.
  *
- * Write lock does not have priority over reader lock,
- * threads get lock based on priority.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_timedwrlock(pthread_rwlock_t *rwlock,
@@ -167,9 +170,6 @@ int pthread_rwlock_timedwrlock(pthread_rwlock_t *rwlock,
 /**
  * @brief Lock a read-write lock object for writing immedately.
  *
- * Write lock does not have priority over reader lock,
- * threads get lock based on priority.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_trywrlock(pthread_rwlock_t *rwlock)
@@ -181,6 +181,49 @@ int pthread_rwlock_trywrlock(pthread_rwlock_t *rwlock)
 	return write_lock_acquire(rwlock, 0);
 }
 
+/*
+ * Hand the lock over to the waiting threads it can be granted to.
+ * Called with irq_lock() held, returns true if a thread was readied.
+ */
+static bool wake_waiters(pthread_rwlock_t *rwlock)
+{
+	atomic_val_t state = atomic_get(&rwlock->state);
+	struct k_thread *thread;
+	bool woken = false;
+
+	if ((state & RW_WRITER) != 0) {
+		return false;
+	}
+
+	if ((state < RW_READER) && (rwlock->wr_waiting > 0U) &&
+	    (PREFER_WRITER || rwlock->rd_waiting == 0U)) {
+		thread = z_unpend_first_thread(&rwlock->wr_wait_q);
+		if (thread != NULL) {
+			rwlock->wr_waiting--;
+			rwlock->wr_owner = thread;
+			atomic_or(&rwlock->state, RW_WRITER);
+			z_ready_thread(thread);
+			arch_thread_return_value_set(thread, 0);
+			woken = true;
+		}
+	} else if (!PREFER_WRITER || rwlock->wr_waiting == 0U) {
+		while ((thread =
+			z_unpend_first_thread(&rwlock->rd_wait_q)) != NULL) {
+			rwlock->rd_waiting--;
+			atomic_add(&rwlock->state, RW_READER);
+			z_ready_thread(thread);
+			arch_thread_return_value_set(thread, 0);
+			woken = true;
+		}
+	}
+
+	if ((rwlock->rd_waiting == 0U) && (rwlock->wr_waiting == 0U)) {
+		atomic_and(&rwlock->state, ~RW_WAITERS);
+	}
+
+	return woken;
+}
+
 /**
  *
  * @brief Unlock a read-write lock object.
@@ -189,73 +232,146 @@ int pthread_rwlock_trywrlock(pthread_rwlock_t *rwlock)
  */
 int pthread_rwlock_unlock(pthread_rwlock_t *rwlock)
 {
+	bool writer;
+	unsigned int key;
+
 	if (rwlock->status == NOT_INITIALIZED) {
 		return EINVAL;
 	}
 
-	if (k_current_get() == rwlock->wr_owner) {
-		/* Write unlock */
+	writer = (k_current_get() == rwlock->wr_owner);
+
+	if (writer) {
 		rwlock->wr_owner = NULL;
-		k_sem_give(&rwlock->reader_active);
-		k_sem_give(&rwlock->wr_sem);
+		if (atomic_cas(&rwlock->state, RW_WRITER, 0)) {
+			return 0;
+		}
 	} else {
-		/* Read unlock */
-		if (k_sem_count_get(&rwlock->rd_sem) ==
-				    (CONCURRENT_READER_LIMIT - 1)) {
-			/* Last read lock, unlock writer */
-			k_sem_give(&rwlock->reader_active);
+		atomic_val_t state = atomic_get(&rwlock->state);
+
+		if (state < RW_READER) {
+			return EPERM;
 		}
 
-		k_sem_give(&rwlock->rd_sem);
+		if (((state & RW_WAITERS) == 0) &&
+		    atomic_cas(&rwlock->state, state, state - RW_READER)) {
+			return 0;
+		}
 	}
+
+	key = irq_lock();
+
+	if (writer) {
+		atomic_and(&rwlock->state, ~RW_WRITER);
+	} else {
+		atomic_sub(&rwlock->state, RW_READER);
+	}
+
+	if (wake_waiters(rwlock)) {
+		z_reschedule_irqlock(key);
+	} else {
+		irq_unlock(key);
+	}
+
 	return 0;
 }
 
+/*
+ * Wait for the lock to be handed over, with irq_lock() held and the
+ * thread counted in the waiters.
+ */
+static uint32_t wait_handover(pthread_rwlock_t *rwlock, _wait_q_t *wait_q,
+			      uint16_t *waiting, unsigned int key,
+			      int32_t timeout)
+{
+	if (z_pend_curr_irqlock(key, wait_q, SYS_TIMEOUT_MS(timeout)) == 0) {
+		return 0U;
+	}
+
+	/* timed out, the lock may now be granted to the other waiters */
+	key = irq_lock();
+	(*waiting)--;
+	if (wake_waiters(rwlock)) {
+		z_reschedule_irqlock(key);
+	} else {
+		irq_unlock(key);
+	}
+
+	return EBUSY;
+}
 
 static uint32_t read_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout)
 {
-	uint32_t ret = 0U;
+	atomic_val_t state = atomic_get(&rwlock->state);
+	unsigned int key;
 
-	if (k_sem_take(&rwlock->wr_sem, SYS_TIMEOUT_MS(timeout)) == 0) {
-		k_sem_take(&rwlock->reader_active, K_NO_WAIT);
-		k_sem_take(&rwlock->rd_sem, K_NO_WAIT);
-		k_sem_give(&rwlock->wr_sem);
-	} else {
-		ret = EBUSY;
+	/* fast path, no writer and nobody waiting */
+	if (((state & (RW_WRITER | RW_WAITERS)) == 0) &&
+	    atomic_cas(&rwlock->state, state, state + RW_READER)) {
+		return 0U;
 	}
 
-	return ret;
+	key = irq_lock();
+
+	for (;;) {
+		state = atomic_get(&rwlock->state);
+
+		if (((state & RW_WRITER) == 0) &&
+		    !(PREFER_WRITER && rwlock->wr_waiting > 0U)) {
+			if (atomic_cas(&rwlock->state, state,
+				       state + RW_READER)) {
+				irq_unlock(key);
+				return 0U;
+			}
+		} else if (timeout == 0) {
+			irq_unlock(key);
+			return EBUSY;
+		} else if (atomic_cas(&rwlock->state, state,
+				      state | RW_WAITERS)) {
+			break;
+		}
+	}
+
+	rwlock->rd_waiting++;
+
+	return wait_handover(rwlock, &rwlock->rd_wait_q, &rwlock->rd_waiting,
+			     key, timeout);
 }
 
 static uint32_t write_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout)
 {
-	uint32_t ret = 0U;
-	int64_t elapsed_time, st_time = k_uptime_get();
-	k_timeout_t k_timeout;
-
-	k_timeout = SYS_TIMEOUT_MS(timeout);
-
-	/* waiting for release of write lock */
-	if (k_sem_take(&rwlock->wr_sem, k_timeout) == 0) {
-		/* update remaining timeout time for 2nd sem */
-		if (timeout != SYS_FOREVER_MS) {
-			elapsed_time = k_uptime_get() - st_time;
-			timeout = timeout <= elapsed_time ? 0 :
-				  timeout - elapsed_time;
-		}
+	atomic_val_t state;
+	unsigned int key;
 
-		k_timeout = SYS_TIMEOUT_MS(timeout);
+	/* fast path, lock free and nobody waiting */
+	if (atomic_cas(&rwlock->state, 0, RW_WRITER)) {
+		rwlock->wr_owner = k_current_get();
+		return 0U;
+	}
 
-		/* waiting for reader to complete operation */
-		if (k_sem_take(&rwlock->reader_active, k_timeout) == 0) {
-			rwlock->wr_owner = k_current_get();
-		} else {
-			k_sem_give(&rwlock->wr_sem);
-			ret = EBUSY;
+	key = irq_lock();
+
+	for (;;) {
+		state = atomic_get(&rwlock->state);
+
+		if ((state & ~RW_WAITERS) == 0) {
+			if (atomic_cas(&rwlock->state, state,
+				       state | RW_WRITER)) {
+				rwlock->wr_owner = k_current_get();
+				irq_unlock(key);
+				return 0U;
+			}
+		} else if (timeout == 0) {
+			irq_unlock(key);
+			return EBUSY;
+		} else if (atomic_cas(&rwlock->state, state,
+				      state | RW_WAITERS)) {
+			break;
 		}
-
-	} else {
-		ret = EBUSY;
 	}
-	return ret;
+
+	rwlock->wr_waiting++;
+
+	return wait_handover(rwlock, &rwlock->wr_wait_q, &rwlock->wr_waiting,
+			     key, timeout);
 }
@@ -8,14 +8,19 @@
 #include <string.h>
 #include <sys/printk.h>
 #include <posix/time.h>
+#ifdef CONFIG_POSIX_HRTIMER
+#include <sys/hrtimer.h>
+#endif
 
 #define ACTIVE 1
 #define NOT_ACTIVE 0
 
-static void zephyr_timer_wrapper(struct k_timer *timer);
-
 struct timer_obj {
+#ifdef CONFIG_POSIX_HRTIMER
+	struct sys_hrtimer ztimer;
+#else
 	struct k_timer ztimer;
+#endif
 	void (*sigev_notify_function)(sigval val);
 	sigval val;
 	struct timespec interval;	/* Reload value */
@@ -26,12 +31,8 @@ struct timer_obj {
 K_MEM_SLAB_DEFINE(posix_timer_slab, sizeof(struct timer_obj),
 		  CONFIG_MAX_TIMER_COUNT, 4);
 
-static void zephyr_timer_wrapper(struct k_timer *ztimer)
+static void timer_expired(struct timer_obj *timer)
 {
-	struct timer_obj *timer;
-
-	timer = (struct timer_obj *)ztimer;
-
 	if (timer->reload == 0U) {
 		timer->status = NOT_ACTIVE;
 	}
@@ -39,6 +40,95 @@ static void zephyr_timer_wrapper(struct k_timer *ztimer)
 	(timer->sigev_notify_function)(timer->val);
 }
 
+#ifdef CONFIG_POSIX_HRTIMER
+static uint64_t ts_to_ns(const struct timespec *ts)
+{
+	return (uint64_t)ts->tv_sec * NSEC_PER_SEC + ts->tv_nsec;
+}
+
+static void zephyr_timer_wrapper(struct sys_hrtimer *ztimer)
+{
+	timer_expired((struct timer_obj *)ztimer);
+}
+
+static void ztimer_init(struct timer_obj *timer, bool notify)
+{
+	sys_hrtimer_init(&timer->ztimer, notify ? zephyr_timer_wrapper : NULL,
+			 NULL);
+}
+
+static void ztimer_start(struct timer_obj *timer, int flags,
+			 const struct itimerspec *value)
+{
+	uint64_t delay = ts_to_ns(&value->it_value);
+	struct timespec now;
+
+	if ((flags & TIMER_ABSTIME) != 0) {
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		delay = (delay > ts_to_ns(&now)) ? delay - ts_to_ns(&now) : 0U;
+	}
+
+	(void)sys_hrtimer_start(&timer->ztimer, delay,
+				ts_to_ns(&value->it_interval));
+}
+
+static void ztimer_stop(struct timer_obj *timer)
+{
+	sys_hrtimer_stop(&timer->ztimer);
+}
+
+static void ztimer_remaining(struct timer_obj *timer, struct timespec *ts)
+{
+	uint64_t ns = sys_hrtimer_remaining_ns(&timer->ztimer);
+
+	ts->tv_sec = ns / NSEC_PER_SEC;
+	ts->tv_nsec = ns % NSEC_PER_SEC;
+}
+#else
+static void zephyr_timer_wrapper(struct k_timer *ztimer)
+{
+	timer_expired((struct timer_obj *)ztimer);
+}
+
+static void ztimer_init(struct timer_obj *timer, bool notify)
+{
+	k_timer_init(&timer->ztimer, notify ? zephyr_timer_wrapper : NULL,
+		     NULL);
+}
+
+static void ztimer_start(struct timer_obj *timer, int flags,
+			 const struct itimerspec *value)
+{
+	uint32_t duration, current;
+
+	duration = _ts_to_ms(&value->it_value);
+	if ((flags & TIMER_ABSTIME) != 0) {
+		current = k_timer_remaining_get(&timer->ztimer);
+
+		if (current >= duration) {
+			duration = 0U;
+		} else {
+			duration -= current;
+		}
+	}
+
+	k_timer_start(&timer->ztimer, K_MSEC(duration), K_MSEC(timer->reload));
+}
+
+static void ztimer_stop(struct timer_obj *timer)
+{
+	k_timer_stop(&timer->ztimer);
+}
+
+static void ztimer_remaining(struct timer_obj *timer, struct timespec *ts)
+{
+	int32_t remaining = k_timer_remaining_get(&timer->ztimer);
+
+	ts->tv_sec = remaining / MSEC_PER_SEC;
+	ts->tv_nsec = (int64_t)(remaining % MSEC_PER_SEC) * NSEC_PER_MSEC;
+}
+#endif /* CONFIG_POSIX_HRTIMER */
+
 /**
  * @brief Create a per-process timer.
  *
@@ -72,11 +162,7 @@ int timer_create(clockid_t clockid, struct sigevent *evp, timer_t *timerid)
 	timer->reload = 0U;
 	timer->status = NOT_ACTIVE;
 
-	if (evp->sigev_notify == SIGEV_NONE) {
-		k_timer_init(&timer->ztimer, NULL, NULL);
-	} else {
-		k_timer_init(&timer->ztimer, zephyr_timer_wrapper, NULL);
-	}
+	ztimer_init(timer, evp->sigev_notify != SIGEV_NONE);
 
 	*timerid = (timer_t)timer;
 
@@ -91,8 +177,6 @@ int timer_create(clockid_t clockid, struct sigevent *evp, timer_t *timerid)
 int timer_gettime(timer_t timerid, struct itimerspec *its)
 {
 	struct timer_obj *timer = (struct timer_obj *)timerid;
-	int32_t remaining, leftover;
-	int64_t   nsecs, secs;
 
 	if (timer == NULL) {
 		errno = EINVAL;
@@ -100,12 +184,7 @@ int timer_gettime(timer_t timerid, struct itimerspec *its)
 	}
 
 	if (timer->status == ACTIVE) {
-		remaining = k_timer_remaining_get(&timer->ztimer);
-		secs =  remaining / MSEC_PER_SEC;
-		leftover = remaining - (secs * MSEC_PER_SEC);
-		nsecs = (int64_t)leftover * NSEC_PER_MSEC;
-		its->it_value.tv_sec = (int32_t) secs;
-		its->it_value.tv_nsec = (int32_t) nsecs;
+		ztimer_remaining(timer, &its->it_value);
 	} else {
 		/* Timer is disarmed */
 		its->it_value.tv_sec = 0;
@@ -126,7 +205,6 @@ int timer_settime(timer_t timerid, int flags, const struct itimerspec *value,
 		  struct itimerspec *ovalue)
 {
 	struct timer_obj *timer = (struct timer_obj *) timerid;
-	uint32_t duration, current;
 
 	if (timer == NULL ||
 	    value->it_interval.tv_nsec < 0 ||
@@ -145,7 +223,7 @@ int timer_settime(timer_t timerid, int flags, const struct itimerspec *value,
 	/* Stop the timer if the value is 0 */
 	if ((value->it_value.tv_sec == 0) && (value->it_value.tv_nsec == 0)) {
 		if (timer->status == ACTIVE) {
-			k_timer_stop(&timer->ztimer);
+			ztimer_stop(timer);
 		}
 
 		timer->status = NOT_ACTIVE;
@@ -157,24 +235,12 @@ int timer_settime(timer_t timerid, int flags, const struct itimerspec *value,
 	timer->interval.tv_sec = value->it_interval.tv_sec;
 	timer->interval.tv_nsec = value->it_interval.tv_nsec;
 
-	/* Calcaulte timer duration */
-	duration = _ts_to_ms(&(value->it_value));
-	if ((flags & TIMER_ABSTIME) != 0) {
-		current = k_timer_remaining_get(&timer->ztimer);
-
-		if (current >= duration) {
-			duration = 0U;
-		} else {
-			duration -= current;
-		}
-	}
-
 	if (timer->status == ACTIVE) {
-		k_timer_stop(&timer->ztimer);
+		ztimer_stop(timer);
 	}
 
 	timer->status = ACTIVE;
-	k_timer_start(&timer->ztimer, K_MSEC(duration), K_MSEC(timer->reload));
+	ztimer_start(timer, flags, value);
 	return 0;
 }
 
@@ -194,7 +260,7 @@ int timer_delete(timer_t timerid)
 
 	if (timer->status == ACTIVE) {
 		timer->status = NOT_ACTIVE;
-		k_timer_stop(&timer->ztimer);
+		ztimer_stop(timer);
 	}
 
 	k_mem_slab_free(&posix_timer_slab, (void *) &timer);
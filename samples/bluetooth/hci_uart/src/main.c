@@ -218,11 +218,15 @@ static void tx_thread(void *p1, void *p2, void *p3)
 
 static int h4_send(struct net_buf *buf)
 {
-	LOG_DBG("buf %p type %u len %u", buf, bt_buf_get_type(buf),
-		    buf->len);
+	struct net_buf *frag;
 
-	while (buf->len) {
-		uart_poll_out(hci_uart_dev, net_buf_pull_u8(buf));
+	LOG_DBG("buf %p type %u len %zu", buf, bt_buf_get_type(buf),
+		    net_buf_frags_len(buf));
+
+	for (frag = buf; frag; frag = frag->frags) {
+		while (frag->len) {
+			uart_poll_out(hci_uart_dev, net_buf_pull_u8(frag));
+		}
 	}
 
 	net_buf_unref(buf);
@@ -24,6 +24,7 @@ void main(void)
 	struct video_buffer *buffers[2], *vbuf;
 	struct video_format fmt;
 	struct video_caps caps;
+	struct video_stats stats;
 	struct device *video;
 	unsigned int frame = 0;
 	size_t bsize;
@@ -119,6 +120,11 @@ void main(void)
 		printk("\rGot frame %u! size: %u; timestamp %u ms",
 		       frame++, vbuf->bytesused, vbuf->timestamp);
 
+		if (!video_get_stats(video, VIDEO_EP_OUT, &stats)) {
+			printk("; %u fps, %u dropped", video_stats_fps(&stats),
+			       stats.dropped);
+		}
+
 		err = video_enqueue(video, VIDEO_EP_OUT, vbuf);
 		if (err) {
 			LOG_ERR("Unable to requeue video buf");
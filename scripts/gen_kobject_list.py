@@ -100,6 +100,7 @@ kobjects = OrderedDict([
     ("k_stack", (None, False, True)),
     ("k_thread", (None, False, True)), # But see #
     ("k_timer", (None, False, True)),
+    ("k_event", ("CONFIG_EVENTS", False, True)),
     ("z_thread_stack_element", (None, False, False)),
     ("device", (None, False, False)),
     ("NET_SOCKET", (None, False, False)),
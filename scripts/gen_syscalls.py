@@ -20,7 +20,8 @@ parse_syscalls.py to create several files:
 - A directory containing header files. Each header corresponds to a header
   that was identified as containing system call declarations. These
   generated headers contain the inline invocation functions for each system
-  call in that header.
+  call in that header, and the functions queueing it in a system call
+  batch.
 """
 
 import sys
@@ -219,6 +220,70 @@ def wrapper_defs(func_name, func_type, args):
 
     return wrap
 
+# System calls that can not be queued in a k_syscall_batch
+nobatch = ["k_syscall_batch_run"]
+
+def batch_defs(func_name, func_type, args):
+    """Emit z_batch_<name>(), which queues the call in a k_syscall_batch.
+
+    Only calls whose marshalled arguments fit the six handler registers
+    and that do not return a split 64-bit value can be batched: the
+    "more" array and the 64-bit return slot would have to outlive the
+    inline function.
+    """
+    if func_name in nobatch or need_split(func_type):
+        return ""
+
+    mrsh_args = []
+    split_args = []
+    for argtype, argname in args:
+        if need_split(argtype):
+            mrsh_args.append("parm%d.split.lo" % len(split_args))
+            mrsh_args.append("parm%d.split.hi" % len(split_args))
+            split_args.append((argtype, argname))
+        else:
+            mrsh_args.append("*(uintptr_t *)&" + argname)
+
+    if len(mrsh_args) > 6:
+        return ""
+
+    decl_arglist = ", ".join(["struct k_syscall_batch *batch"] +
+                             [" ".join(argrec) for argrec in args])
+
+    bat = "#ifdef CONFIG_SYSCALL_BATCH\n"
+    bat += "static inline int z_batch_%s(%s)\n" % (func_name, decl_arglist)
+    bat += "{\n"
+    bat += "\t" + "struct k_syscall_batch_entry *entry = z_syscall_batch_next(batch);\n"
+    bat += "\n"
+    bat += "\t" + "if (z_syscall_trap()) {\n"
+
+    for parmnum, (argtype, argname) in enumerate(split_args):
+        bat += "\t\t%s parm%d;\n" % (union_decl(argtype), parmnum)
+        bat += "\t\t" + "parm%d.val = %s;\n" % (parmnum, argname)
+
+    bat += "\t\t" + "entry->id = K_SYSCALL_%s;\n" % func_name.upper()
+    for i in range(6):
+        val = mrsh_args[i] if i < len(mrsh_args) else "0"
+        bat += "\t\t" + "entry->args[%d] = %s;\n" % (i, val)
+    bat += "\t\t" + "return (int)(entry - batch->entries);\n"
+    bat += "\t" + "}\n"
+
+    # Supervisor threads run the call right away, in queue order
+    impl_arglist = ", ".join([argrec[1] for argrec in args])
+    impl_call = "z_impl_%s(%s)" % (func_name, impl_arglist)
+    bat += "\t" + "compiler_barrier();\n"
+    bat += "\t" + "entry->id = K_SYSCALL_LIMIT;\n"
+    if func_type == "void":
+        bat += "\t" + "%s;\n" % impl_call
+        bat += "\t" + "entry->ret = 0;\n"
+    else:
+        bat += "\t" + "entry->ret = (uintptr_t) %s;\n" % impl_call
+    bat += "\t" + "return (int)(entry - batch->entries);\n"
+    bat += "}\n"
+    bat += "#endif\n"
+
+    return bat
+
 # Returns an expression for the specified (zero-indexed!) marshalled
 # parameter to a syscall, with handling for a final "more" parameter.
 def mrsh_rval(mrsh_num, total):
@@ -322,6 +387,7 @@ def analyze_fn(match_group):
     marshaller = None
     marshaller, handler = marshall_defs(func_name, func_type, args)
     invocation = wrapper_defs(func_name, func_type, args)
+    invocation += batch_defs(func_name, func_type, args)
 
     # Entry in _k_syscall_table
     table_entry = "[%s] = %s" % (sys_id, handler)
@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2020 Intel Corporation
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Generate the database used to decode dictionary based log output.
+
+The database, a JSON file, holds every null terminated string found in the
+read-only sections of the ELF file, indexed by address, and the names of the
+log sources in source ID order.
+"""
+
+import argparse
+import json
+import string
+import sys
+
+from elftools.elf.elffile import ELFFile
+from elftools.elf.constants import SH_FLAGS
+from elftools.elf.sections import SymbolTableSection
+
+DATABASE_VERSION = 1
+
+PRINTABLE = set(string.printable.encode())
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elffile", help="Zephyr ELF file")
+    parser.add_argument("dbfile", help="Output database file")
+    return parser.parse_args()
+
+
+def rodata_sections(elf):
+    """Allocated, read-only sections holding data"""
+    for section in elf.iter_sections():
+        flags = section['sh_flags']
+        if (section['sh_type'] == 'SHT_PROGBITS' and
+                flags & SH_FLAGS.SHF_ALLOC and
+                not flags & SH_FLAGS.SHF_WRITE):
+            yield section
+
+
+def extract_strings(elf):
+    """Map the address of each printable string to the string"""
+    strings = {}
+
+    for section in rodata_sections(elf):
+        data = section.data()
+        base = section['sh_addr']
+        start = 0
+
+        for end, byte in enumerate(data):
+            if byte != 0:
+                if byte not in PRINTABLE:
+                    start = None
+                elif start is None:
+                    start = end
+                continue
+
+            if start is not None and end > start:
+                strings[base + start] = data[start:end].decode()
+            start = end + 1
+
+    return strings
+
+
+def read_mem(elf, addr, size):
+    for section in elf.iter_sections():
+        base = section['sh_addr']
+        if (section['sh_type'] == 'SHT_PROGBITS' and
+                base <= addr < base + section['sh_size']):
+            offset = addr - base
+            return section.data()[offset:offset + size]
+
+    return None
+
+
+def read_str(elf, addr):
+    for section in elf.iter_sections():
+        base = section['sh_addr']
+        if (section['sh_type'] == 'SHT_PROGBITS' and
+                base <= addr < base + section['sh_size']):
+            data = section.data()[addr - base:]
+            return data[:data.index(b'\0')].decode()
+
+    return None
+
+
+def extract_log_sources(elf):
+    """Names of the log sources, indexed by source ID"""
+    symtab = elf.get_section_by_name('.symtab')
+    if not isinstance(symtab, SymbolTableSection):
+        sys.exit("ELF file has no symbol table")
+
+    syms = {sym.name: sym for sym in symtab.iter_symbols()}
+    if '__log_const_start' not in syms:
+        return []
+
+    start = syms['__log_const_start']['st_value']
+    end = syms['__log_const_end']['st_value']
+    ptr_size = elf.elfclass // 8
+    byteorder = 'little' if elf.little_endian else 'big'
+
+    entries = [sym for name, sym in syms.items()
+               if name.startswith('log_const_') and
+               start <= sym['st_value'] < end]
+    if not entries:
+        return []
+
+    entry_size = entries[0]['st_size']
+    sources = [None] * ((end - start) // entry_size)
+
+    for sym in entries:
+        addr = sym['st_value']
+        name_ptr = int.from_bytes(read_mem(elf, addr, ptr_size), byteorder)
+        sources[(addr - start) // entry_size] = read_str(elf, name_ptr)
+
+    return sources
+
+
+def main():
+    args = parse_args()
+
+    with open(args.elffile, 'rb') as f:
+        elf = ELFFile(f)
+
+        database = {
+            'version': DATABASE_VERSION,
+            'arch_bits': elf.elfclass,
+            'little_endian': elf.little_endian,
+            'log_sources': extract_log_sources(elf),
+            'strings': {hex(addr): s
+                        for addr, s in extract_strings(elf).items()},
+        }
+
+    with open(args.dbfile, 'w') as f:
+        json.dump(database, f, indent=1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,244 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2020 Intel Corporation
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Decode dictionary based log output.
+
+Reads the binary records written by the target when
+CONFIG_LOG_DICTIONARY_SUPPORT is enabled, from a file or from standard
+input, and prints the log messages using the database generated at build
+time (log_dictionary.json in the build directory).
+"""
+
+import argparse
+import bisect
+import json
+import re
+import struct
+import sys
+
+MSG_STD = 0
+MSG_HEXDUMP = 1
+MSG_DROPPED = 2
+
+LEVELS = ['', 'err', 'wrn', 'inf', 'dbg']
+
+HEXDUMP_BYTES_IN_LINE = 16
+
+# A printf conversion: flags, width, precision, length and specifier
+CONVERSION = re.compile(r'%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?'
+                        r'(hh|h|ll|l|L|j|z|t)?([diouxXeEfFgGaAcspn%])')
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("dbfile", help="Dictionary database file")
+    parser.add_argument("logfile", nargs='?', default='-',
+                        help="Binary log output, standard input if omitted")
+    parser.add_argument("--timestamp-freq", type=int, default=0,
+                        help="Timestamp frequency in Hz, to print "
+                             "timestamps in seconds instead of ticks")
+    return parser.parse_args()
+
+
+class Database:
+    def __init__(self, path):
+        with open(path) as f:
+            db = json.load(f)
+
+        self.ptr_size = db['arch_bits'] // 8
+        self.endian = '<' if db['little_endian'] else '>'
+        self.sources = db['log_sources']
+        self.strings = {int(addr, 16): s
+                        for addr, s in db['strings'].items()}
+        self.addrs = sorted(self.strings)
+
+    def string(self, addr):
+        """String at addr, which may point inside a longer string"""
+        i = bisect.bisect_right(self.addrs, addr) - 1
+        if i >= 0:
+            start = self.addrs[i]
+            s = self.strings[start]
+            if addr - start <= len(s):
+                return s[addr - start:]
+
+        return '<unknown string 0x{:x}>'.format(addr)
+
+    def source(self, source_id):
+        if source_id < len(self.sources) and self.sources[source_id]:
+            return self.sources[source_id]
+
+        return '<unknown source {}>'.format(source_id)
+
+
+class Reader:
+    def __init__(self, stream, endian):
+        self.stream = stream
+        self.endian = endian
+
+    def read(self, size):
+        data = self.stream.read(size)
+        if len(data) != size:
+            raise EOFError
+        return data
+
+    def unpack(self, fmt):
+        fmt = self.endian + fmt
+        return struct.unpack(fmt, self.read(struct.calcsize(fmt)))
+
+    def cstring(self):
+        data = bytearray()
+        while True:
+            byte = self.read(1)
+            if byte == b'\0':
+                return data.decode(errors='replace')
+            data += byte
+
+
+def c_format(db, fmt, args, strs):
+    """Render a printf format string with raw integer arguments"""
+    arg_bits = db.ptr_size * 8
+    idx = 0
+
+    def next_arg():
+        nonlocal idx
+        value = args[idx] if idx < len(args) else 0
+        idx += 1
+        return value
+
+    def convert(match):
+        flags, width, precision, length, spec = match.groups()
+
+        if spec == '%':
+            return '%'
+
+        if width == '*':
+            width = str(next_arg())
+        if precision == '*':
+            precision = str(next_arg())
+
+        arg_idx = idx
+        value = next_arg()
+
+        if spec == 's':
+            value = strs.get(arg_idx) or db.string(value)
+        elif spec == 'c':
+            value = chr(value & 0xff)
+        elif spec == 'p':
+            spec = 'x'
+            flags += '#'
+        elif spec in 'di':
+            bits = {'hh': 8, 'h': 16}.get(length, arg_bits)
+            value &= (1 << bits) - 1
+            if value & (1 << (bits - 1)):
+                value -= 1 << bits
+            spec = 'd'
+        elif spec in 'ouxX':
+            bits = {'hh': 8, 'h': 16}.get(length, arg_bits)
+            value &= (1 << bits) - 1
+            if spec == 'u':
+                spec = 'd'
+        else:
+            # Floating point values are not passed by the logger
+            return '<{}>'.format(match.group(0))
+
+        conv = '%' + flags + (width or '')
+        if precision is not None:
+            conv += '.' + precision
+
+        return (conv + spec) % value
+
+    return CONVERSION.sub(convert, fmt)
+
+
+def prefix(db, hdr, args):
+    timestamp, ids, source = hdr
+    level = ids & 0x7
+    domain = ids >> 3
+
+    if args.timestamp_freq:
+        ts = '[{:.6f}]'.format(timestamp / args.timestamp_freq)
+    else:
+        ts = '[{:010d}]'.format(timestamp)
+
+    lvl = LEVELS[level] if level < len(LEVELS) else str(level)
+
+    if domain:
+        return '{} <{}> {}/{}: '.format(ts, lvl, domain, db.source(source))
+
+    return '{} <{}> {}: '.format(ts, lvl, db.source(source))
+
+
+def decode(db, reader, args, out):
+    ptr = 'I' if db.ptr_size == 4 else 'Q'
+
+    while True:
+        try:
+            msg_type, = reader.unpack('B')
+
+            if msg_type == MSG_DROPPED:
+                count, = reader.unpack('I')
+                out.write('--- {} messages dropped ---\n'.format(count))
+                continue
+
+            if msg_type not in (MSG_STD, MSG_HEXDUMP):
+                sys.exit("Unknown record type {}, stream out of sync"
+                         .format(msg_type))
+
+            ids, source, timestamp, fmt, length, nstr = \
+                reader.unpack('BHI' + ptr + 'HB')
+            level = ids & 0x7
+
+            if msg_type == MSG_STD:
+                msg_args = list(reader.unpack(ptr * length))
+                strs = {}
+                for _ in range(nstr):
+                    arg_idx, = reader.unpack('B')
+                    strs[arg_idx] = reader.cstring()
+
+                text = c_format(db, db.string(fmt), msg_args, strs)
+                if level:
+                    out.write(prefix(db, (timestamp, ids, source), args) +
+                              text + '\n')
+                else:
+                    out.write(text)
+                continue
+
+            data = reader.read(length)
+            if not level:
+                # Raw string, as passed to printk()
+                out.write(data.decode(errors='replace'))
+                continue
+
+            desc = db.string(fmt) if fmt else ''
+            out.write(prefix(db, (timestamp, ids, source), args) + desc +
+                      '\n')
+            for i in range(0, len(data), HEXDUMP_BYTES_IN_LINE):
+                line = data[i:i + HEXDUMP_BYTES_IN_LINE]
+                out.write('{:<49}|{}\n'.format(
+                    ' '.join('{:02x}'.format(b) for b in line),
+                    ''.join(chr(b) if 32 <= b < 127 else '.'
+                            for b in line)))
+        except EOFError:
+            return
+
+
+def main():
+    args = parse_args()
+    db = Database(args.dbfile)
+
+    if args.logfile == '-':
+        stream = sys.stdin.buffer
+    else:
+        stream = open(args.logfile, 'rb')
+
+    with stream:
+        decode(db, Reader(stream, db.endian), args, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2020 Intel Corporation
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Symbolize sampling profiler output into folded stacks.
+
+Reads the output of the "profiler dump" shell command, possibly surrounded
+by other console output, and prints one line per distinct stack with its
+sample count:
+
+    thread;caller;function count
+
+This is the input format of flamegraph.pl
+(https://github.com/brendangregg/FlameGraph) and of speedscope.
+"""
+
+import argparse
+import bisect
+import collections
+import re
+import sys
+
+from elftools.elf.elffile import ELFFile
+from elftools.elf.sections import SymbolTableSection
+
+THREAD_RE = re.compile(r'thread (0x[0-9a-fA-F]+) ?(.*)$')
+SAMPLE_RE = re.compile(r'sample ([0-9a-fA-F]+) ([0-9a-fA-F]+) '
+                       r'(0x[0-9a-fA-F]+)')
+HEADER_RE = re.compile(r'profiler: (\d+) samples, (\d+) dropped')
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elffile", help="Zephyr ELF file")
+    parser.add_argument("dump", nargs='?', default='-',
+                        help="Console output, standard input if omitted")
+    parser.add_argument("--no-threads", action='store_true',
+                        help="Do not split stacks per thread")
+    return parser.parse_args()
+
+
+class Symbols:
+    def __init__(self, path):
+        self.addrs = []
+        self.syms = []
+
+        with open(path, 'rb') as f:
+            elf = ELFFile(f)
+            symtab = elf.get_section_by_name('.symtab')
+            if not isinstance(symtab, SymbolTableSection):
+                sys.exit("ELF file has no symbol table")
+
+            funcs = []
+            for sym in symtab.iter_symbols():
+                if sym['st_info']['type'] != 'STT_FUNC' or not sym.name:
+                    continue
+                # Clear the Thumb bit
+                addr = sym['st_value'] & ~1
+                funcs.append((addr, sym['st_size'], sym.name))
+
+        for addr, size, name in sorted(funcs):
+            self.addrs.append(addr)
+            self.syms.append((addr + max(size, 1), name))
+
+    def lookup(self, addr):
+        i = bisect.bisect_right(self.addrs, addr) - 1
+        if i >= 0:
+            end, name = self.syms[i]
+            if addr < end:
+                return name
+
+        return '0x{:x}'.format(addr)
+
+
+def main():
+    args = parse_args()
+    symbols = Symbols(args.elffile)
+
+    threads = {}
+    stacks = collections.Counter()
+    total = dropped = 0
+
+    stream = sys.stdin if args.dump == '-' else open(args.dump)
+    with stream:
+        for line in stream:
+            match = HEADER_RE.search(line)
+            if match:
+                dropped += int(match.group(2))
+                continue
+
+            match = THREAD_RE.search(line)
+            if match:
+                name = match.group(2).strip() or match.group(1)
+                threads[int(match.group(1), 16)] = name
+                continue
+
+            match = SAMPLE_RE.search(line)
+            if not match:
+                continue
+
+            pc, caller, thread = (int(g, 16) for g in match.groups())
+            frames = []
+
+            if not args.no_threads:
+                frames.append(threads.get(thread, '0x{:x}'.format(thread)))
+
+            if pc == 0:
+                frames.append('[interrupt]')
+            else:
+                if caller:
+                    frames.append(symbols.lookup(caller))
+                frames.append(symbols.lookup(pc))
+
+            stacks[';'.join(frames)] += 1
+            total += 1
+
+    for stack, count in stacks.most_common():
+        print('{} {}'.format(stack, count))
+
+    print('{} samples, {} dropped'.format(total, dropped), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
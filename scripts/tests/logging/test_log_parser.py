@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+# Copyright (c) 2020 Intel Corporation
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""End to end test of dictionary based logging
+
+Builds tests/subsys/logging/log_dictionary for native_posix, or uses the
+build directory given in LOG_DICTIONARY_BUILD_DIR, runs it and decodes its
+dictionary based output with log_parser.py against the database generated
+by the build.
+"""
+
+import os
+import re
+import subprocess
+import sys
+
+import pytest
+
+ZEPHYR_BASE = os.environ["ZEPHYR_BASE"]
+TEST_APP = os.path.join(ZEPHYR_BASE, "tests", "subsys", "logging",
+                        "log_dictionary")
+LOG_PARSER = os.path.join(ZEPHYR_BASE, "scripts", "logging", "dictionary",
+                          "log_parser.py")
+
+# Printed by the test application once all test cases ran
+OUTPUT_RE = re.compile(r"^DICT_OUTPUT: ([0-9a-f]*)$", re.MULTILINE)
+
+PREFIX = r"\[\d{10}\] <inf> test: "
+
+
+@pytest.fixture(name="build_dir", scope="module")
+def _build_dir(tmpdir_factory):
+    """Build directory of the test application"""
+    build_dir = os.environ.get("LOG_DICTIONARY_BUILD_DIR")
+    if build_dir:
+        return build_dir
+
+    build_dir = str(tmpdir_factory.mktemp("log_dictionary"))
+    ret = subprocess.run(["cmake", "-GNinja", "-DBOARD=native_posix",
+                          "-S", TEST_APP, "-B", build_dir],
+                         stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+    if ret.returncode:
+        pytest.skip("cannot configure the native_posix build")
+
+    subprocess.run(["ninja", "-C", build_dir], check=True)
+
+    return build_dir
+
+
+@pytest.fixture(name="decoded", scope="module")
+def _decoded(build_dir, tmpdir_factory):
+    """Output of the test application, as decoded by log_parser.py"""
+    exe = os.path.join(build_dir, "zephyr", "zephyr.exe")
+    database = os.path.join(build_dir, "zephyr", "log_dictionary.json")
+
+    run = subprocess.run([exe], stdout=subprocess.PIPE, timeout=60,
+                         universal_newlines=True)
+    assert "PROJECT EXECUTION SUCCESSFUL" in run.stdout
+
+    match = OUTPUT_RE.search(run.stdout)
+    assert match, "no dictionary output"
+
+    log_file = tmpdir_factory.mktemp("log").join("log.bin")
+    log_file.write_binary(bytes.fromhex(match.group(1)))
+
+    parser = subprocess.run([sys.executable, LOG_PARSER, database,
+                             str(log_file)], stdout=subprocess.PIPE,
+                            check=True, universal_newlines=True)
+
+    return parser.stdout.splitlines()
+
+
+def test_strings(decoded):
+    """Constant strings come from the database, duplicates from the output"""
+    assert re.fullmatch(PREFIX + "const constant string "
+                        "strdup duplicated string num 42", decoded[0])
+
+
+def test_hexdump(decoded):
+    """Hexdump description and data"""
+    assert re.fullmatch(PREFIX + "hexdump", decoded[1])
+    assert decoded[2].startswith("01 02 03 04 05 ")
+    assert decoded[2].endswith("|.....")
+
+
+def test_dropped(decoded):
+    """Dropped messages notification"""
+    assert decoded[3] == "--- 3 messages dropped ---"
+    assert len(decoded) == 4
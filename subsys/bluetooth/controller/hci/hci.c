@@ -91,6 +91,10 @@ atomic_t hci_state_mask;
 static struct k_poll_signal *hbuf_signal;
 #endif
 
+#if defined(CONFIG_BT_CTLR_RX_ZERO_COPY)
+uint8_t hci_reset_count;
+#endif /* CONFIG_BT_CTLR_RX_ZERO_COPY */
+
 #if defined(CONFIG_BT_CONN)
 static uint32_t conn_count;
 #endif
@@ -295,6 +299,13 @@ static void reset(struct net_buf *buf, struct net_buf **evt)
 	le_event_mask = DEFAULT_LE_EVENT_MASK;
 
 	if (buf) {
+#if defined(CONFIG_BT_CTLR_RX_ZERO_COPY)
+		/* Rx PDUs still held by the HCI raw user are reclaimed by the
+		 * reset, and must not be released once more.
+		 */
+		hci_reset_count++;
+#endif /* CONFIG_BT_CTLR_RX_ZERO_COPY */
+
 		ll_reset();
 		*evt = cmd_complete_status(0x00);
 	}
@@ -4354,12 +4365,22 @@ static void encode_data_ctrl(struct node_rx_pdu *node_rx,
 
 #if defined(CONFIG_BT_CONN)
 void hci_acl_encode(struct node_rx_pdu *node_rx, struct net_buf *buf)
+{
+	struct pdu_data *pdu_data = (void *)node_rx->pdu;
+	uint8_t *data;
+
+	hci_acl_hdr_encode(node_rx, buf);
+
+	data = (void *)net_buf_add(buf, pdu_data->len);
+	memcpy(data, pdu_data->lldata, pdu_data->len);
+}
+
+void hci_acl_hdr_encode(struct node_rx_pdu *node_rx, struct net_buf *buf)
 {
 	struct pdu_data *pdu_data = (void *)node_rx->pdu;
 	struct bt_hci_acl_hdr *acl;
 	uint16_t handle_flags;
 	uint16_t handle;
-	uint8_t *data;
 
 	handle = node_rx->hdr.handle;
 
@@ -4374,8 +4395,6 @@ void hci_acl_encode(struct node_rx_pdu *node_rx, struct net_buf *buf)
 		}
 		acl->handle = sys_cpu_to_le16(handle_flags);
 		acl->len = sys_cpu_to_le16(pdu_data->len);
-		data = (void *)net_buf_add(buf, pdu_data->len);
-		memcpy(data, pdu_data->lldata, pdu_data->len);
 #if defined(CONFIG_BT_HCI_ACL_FLOW_CONTROL)
 		if (hci_hbuf_total > 0) {
 			LL_ASSERT((hci_hbuf_sent - hci_hbuf_acked) <
@@ -175,6 +175,48 @@ static void prio_recv_thread(void *p1, void *p2, void *p3)
 	}
 }
 
+#if defined(CONFIG_BT_CTLR_RX_ZERO_COPY)
+static void acl_frag_destroy(struct net_buf *frag);
+
+/* Fragments referencing the payload of received ACL data in its Rx PDU */
+NET_BUF_POOL_DEFINE(acl_frag_pool, CONFIG_BT_CTLR_RX_BUFFERS, 0,
+		    sizeof(struct node_rx_pdu *), acl_frag_destroy);
+
+static void acl_frag_destroy(struct net_buf *frag)
+{
+	struct node_rx_pdu *node_rx;
+
+	node_rx = *(struct node_rx_pdu **)net_buf_user_data(frag);
+	net_buf_destroy(frag);
+
+	/* The fragment may be released in any context, the Rx PDU is
+	 * released by the receive thread.
+	 */
+	node_rx->hdr.user_meta = HCI_CLASS_NONE;
+	k_fifo_put(&recv_fifo, node_rx);
+}
+
+static struct net_buf *acl_encode_zero_copy(struct node_rx_pdu *node_rx)
+{
+	struct pdu_data *pdu_data = (void *)node_rx->pdu;
+	struct net_buf *frag;
+	struct net_buf *buf;
+
+	buf = bt_buf_get_rx(BT_BUF_ACL_IN, K_FOREVER);
+	hci_acl_hdr_encode(node_rx, buf);
+
+	/* Handle is no longer needed, remember the HCI reset generation */
+	node_rx->hdr.handle = hci_reset_count;
+
+	frag = net_buf_alloc_with_data(&acl_frag_pool, pdu_data->lldata,
+				       pdu_data->len, K_FOREVER);
+	*(struct node_rx_pdu **)net_buf_user_data(frag) = node_rx;
+	net_buf_frag_add(buf, frag);
+
+	return buf;
+}
+#endif /* CONFIG_BT_CTLR_RX_ZERO_COPY */
+
 static inline struct net_buf *encode_node(struct node_rx_pdu *node_rx,
 					  int8_t class)
 {
@@ -198,6 +240,11 @@ static inline struct net_buf *encode_node(struct node_rx_pdu *node_rx,
 		break;
 #if defined(CONFIG_BT_CONN)
 	case HCI_CLASS_ACL_DATA:
+#if defined(CONFIG_BT_CTLR_RX_ZERO_COPY)
+		/* Rx PDU is released along with the buffer */
+		return acl_encode_zero_copy(node_rx);
+#endif /* CONFIG_BT_CTLR_RX_ZERO_COPY */
+
 		/* generate ACL data */
 		buf = bt_buf_get_rx(BT_BUF_ACL_IN, K_FOREVER);
 		hci_acl_encode(node_rx, buf);
@@ -219,6 +266,21 @@ static inline struct net_buf *process_node(struct node_rx_pdu *node_rx)
 	uint8_t class = node_rx->hdr.user_meta;
 	struct net_buf *buf = NULL;
 
+#if defined(CONFIG_BT_CTLR_RX_ZERO_COPY)
+	if (class == HCI_CLASS_NONE) {
+		/* Rx PDU of ACL data handed over without copying, and now
+		 * released by the HCI raw user. Not if the HCI was reset
+		 * meanwhile, the Rx PDU pool is then initialized again.
+		 */
+		if (node_rx->hdr.handle == hci_reset_count) {
+			node_rx->hdr.next = NULL;
+			ll_rx_mem_release((void **)&node_rx);
+		}
+
+		return NULL;
+	}
+#endif /* CONFIG_BT_CTLR_RX_ZERO_COPY */
+
 #if defined(CONFIG_BT_HCI_ACL_FLOW_CONTROL)
 	if (hbuf_count != -1) {
 		bool pend = !sys_slist_is_empty(&hbuf_pend);
@@ -39,8 +39,12 @@ void hci_disconn_complete_process(uint16_t handle);
 #if defined(CONFIG_BT_CONN)
 int hci_acl_handle(struct net_buf *acl, struct net_buf **evt);
 void hci_acl_encode(struct node_rx_pdu *node_rx, struct net_buf *buf);
+void hci_acl_hdr_encode(struct node_rx_pdu *node_rx, struct net_buf *buf);
 void hci_num_cmplt_encode(struct net_buf *buf, uint16_t handle, uint8_t num);
 #endif
+#if defined(CONFIG_BT_CTLR_RX_ZERO_COPY)
+extern uint8_t hci_reset_count;
+#endif
 int hci_vendor_cmd_handle(uint16_t ocf, struct net_buf *cmd,
 			  struct net_buf **evt);
 uint8_t hci_vendor_read_static_addr(struct bt_hci_vs_static_addr addrs[],
@@ -174,6 +174,28 @@ uint8_t ll_rx_get(void **node_rx, uint16_t *handle);
 void ll_rx_dequeue(void);
 void ll_rx_mem_release(void **node_rx);
 
+#if defined(CONFIG_BT_CTLR_MEM_STATS)
+/* Memory pool statistics */
+struct ll_mem_stats_pool {
+	uint16_t count;    /* Number of elements in the pool */
+	uint16_t used_max; /* Maximum number of elements ever acquired */
+};
+
+struct ll_mem_stats {
+	struct ll_mem_stats_pool done;
+	struct ll_mem_stats_pool link_done;
+	struct ll_mem_stats_pool pdu_rx;
+	struct ll_mem_stats_pool link_rx;
+#if defined(CONFIG_BT_CONN)
+	struct ll_mem_stats_pool conn_tx;
+	struct ll_mem_stats_pool conn_tx_ctrl;
+	struct ll_mem_stats_pool link_tx;
+#endif /* CONFIG_BT_CONN */
+};
+
+void ll_mem_stats_get(struct ll_mem_stats *stats);
+#endif /* CONFIG_BT_CTLR_MEM_STATS */
+
 /* External co-operation */
 void ll_timeslice_ticker_id_get(uint8_t * const instance_index, uint8_t * const user_id);
 void ll_radio_state_abort(void);
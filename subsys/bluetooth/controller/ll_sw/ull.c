@@ -30,6 +30,7 @@
 #include "ll_feat.h"
 #include "ll_settings.h"
 #include "lll.h"
+#include "lll_vendor.h"
 #include "lll_adv.h"
 #include "lll_scan.h"
 #include "lll_conn.h"
@@ -948,6 +949,32 @@ void ll_rx_mem_release(void **node_rx)
 	rx_alloc(UINT8_MAX);
 }
 
+#if defined(CONFIG_BT_CTLR_MEM_STATS)
+void ll_mem_stats_get(struct ll_mem_stats *stats)
+{
+	stats->done.count = EVENT_DONE_MAX;
+	stats->done.used_max = EVENT_DONE_MAX -
+			       mem_free_min_get(mem_done.free);
+
+	stats->link_done.count = EVENT_DONE_MAX;
+	stats->link_done.used_max = EVENT_DONE_MAX -
+				    mem_free_min_get(mem_link_done.free);
+
+	stats->pdu_rx.count = sizeof(mem_pdu_rx.pool) /
+			      (PDU_RX_NODE_POOL_ELEMENT_SIZE);
+	stats->pdu_rx.used_max = stats->pdu_rx.count -
+				 mem_free_min_get(mem_pdu_rx.free);
+
+	stats->link_rx.count = sizeof(mem_link_rx.pool) / sizeof(memq_link_t);
+	stats->link_rx.used_max = stats->link_rx.count -
+				  mem_free_min_get(mem_link_rx.free);
+
+#if defined(CONFIG_BT_CONN)
+	ull_conn_mem_stats_get(stats);
+#endif /* CONFIG_BT_CONN */
+}
+#endif /* CONFIG_BT_CTLR_MEM_STATS */
+
 static inline void ll_rx_link_inc_quota(int8_t delta)
 {
 	LL_ASSERT(delta <= 0 || mem_link_rx.quota_pdu < RX_CNT);
@@ -1208,6 +1235,14 @@ int ull_prepare_enqueue(lll_is_abort_cb_t is_abort_cb,
 	return 0;
 }
 
+uint32_t ull_prepare_deadline_get(uint32_t ticks_at_expire)
+{
+	/* LLL prepare has to run before the radio event starts */
+	return (ticks_at_expire +
+		HAL_TICKER_US_TO_TICKS(EVENT_OVERHEAD_START_US)) &
+	       HAL_TICKER_CNTR_MASK;
+}
+
 void *ull_prepare_dequeue_get(void)
 {
 	return MFIFO_DEQUEUE_GET(prep);
@@ -1519,6 +1519,7 @@ static void ticker_cb(uint32_t ticks_at_expire, uint32_t remainder, uint16_t laz
 	static struct mayfly mfy = {0, 0, &link, NULL, lll_adv_prepare};
 	static struct lll_prepare_param p;
 	struct ll_adv_set *adv = param;
+	uint32_t ticks_deadline;
 	struct lll_adv *lll;
 	uint32_t ret;
 	uint8_t ref;
@@ -1541,8 +1542,10 @@ static void ticker_cb(uint32_t ticks_at_expire, uint32_t remainder, uint16_t laz
 		mfy.param = &p;
 
 		/* Kick LLL prepare */
-		ret = mayfly_enqueue(TICKER_USER_ID_ULL_HIGH,
-				     TICKER_USER_ID_LLL, 0, &mfy);
+		ticks_deadline = ull_prepare_deadline_get(ticks_at_expire);
+		ret = mayfly_enqueue_deadline(TICKER_USER_ID_ULL_HIGH,
+					      TICKER_USER_ID_LLL, 0, &mfy,
+					      ticks_deadline);
 		LL_ASSERT(!ret);
 	}
 
@@ -856,8 +856,9 @@ static void ticker_cb(uint32_t ticks_at_expire, uint32_t remainder,
 	mfy.param = &p;
 
 	/* Kick LLL prepare */
-	ret = mayfly_enqueue(TICKER_USER_ID_ULL_HIGH,
-			     TICKER_USER_ID_LLL, 0, &mfy);
+	ret = mayfly_enqueue_deadline(TICKER_USER_ID_ULL_HIGH,
+				      TICKER_USER_ID_LLL, 0, &mfy,
+				      ull_prepare_deadline_get(ticks_at_expire));
 	LL_ASSERT(!ret);
 
 	DEBUG_RADIO_PREPARE_A(1);
@@ -1366,6 +1366,23 @@ void ull_conn_link_tx_release(void *link)
 	mem_release(link, &mem_link_tx.free);
 }
 
+#if defined(CONFIG_BT_CTLR_MEM_STATS)
+void ull_conn_mem_stats_get(struct ll_mem_stats *stats)
+{
+	stats->conn_tx.count = CONFIG_BT_CTLR_TX_BUFFERS;
+	stats->conn_tx.used_max = CONFIG_BT_CTLR_TX_BUFFERS -
+				  mem_free_min_get(mem_conn_tx.free);
+
+	stats->conn_tx_ctrl.count = CONN_TX_CTRL_BUFFERS;
+	stats->conn_tx_ctrl.used_max = CONN_TX_CTRL_BUFFERS -
+				       mem_free_min_get(mem_conn_tx_ctrl.free);
+
+	stats->link_tx.count = CONFIG_BT_CTLR_TX_BUFFERS + CONN_TX_CTRL_BUFFERS;
+	stats->link_tx.used_max = stats->link_tx.count -
+				  mem_free_min_get(mem_link_tx.free);
+}
+#endif /* CONFIG_BT_CTLR_MEM_STATS */
+
 uint8_t ull_conn_ack_last_idx_get(void)
 {
 	return mfifo_conn_ack.l;
@@ -27,6 +27,10 @@ void ull_conn_done(struct node_rx_event_done *done);
 void ull_conn_tx_demux(uint8_t count);
 void ull_conn_tx_lll_enqueue(struct ll_conn *conn, uint8_t count);
 void ull_conn_link_tx_release(void *link);
+#if defined(CONFIG_BT_CTLR_MEM_STATS)
+struct ll_mem_stats;
+void ull_conn_mem_stats_get(struct ll_mem_stats *stats);
+#endif /* CONFIG_BT_CTLR_MEM_STATS */
 uint8_t ull_conn_ack_last_idx_get(void);
 memq_link_t *ull_conn_ack_peek(uint8_t *ack_last, uint16_t *handle,
 			       struct node_tx **tx);
@@ -36,3 +36,4 @@ void *ull_update_mark(void *param);
 void *ull_update_unmark(void *param);
 void *ull_update_mark_get(void);
 int ull_disable(void *param);
+uint32_t ull_prepare_deadline_get(uint32_t ticks_at_expire);
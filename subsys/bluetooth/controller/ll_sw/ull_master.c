@@ -765,8 +765,9 @@ void ull_master_ticker_cb(uint32_t ticks_at_expire, uint32_t remainder, uint16_t
 	mfy.param = &p;
 
 	/* Kick LLL prepare */
-	err = mayfly_enqueue(TICKER_USER_ID_ULL_HIGH, TICKER_USER_ID_LLL,
-			     0, &mfy);
+	err = mayfly_enqueue_deadline(TICKER_USER_ID_ULL_HIGH,
+				      TICKER_USER_ID_LLL, 0, &mfy,
+				      ull_prepare_deadline_get(ticks_at_expire));
 	LL_ASSERT(!err);
 
 	/* De-mux remaining tx nodes from FIFO */
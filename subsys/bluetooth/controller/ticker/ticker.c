@@ -6,6 +6,7 @@
  */
 
 #include <stdbool.h>
+#include <string.h>
 #include <zephyr/types.h>
 #include <soc.h>
 
@@ -24,6 +25,11 @@
  ****************************************************************************/
 #define DOUBLE_BUFFER_SIZE 2
 
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+/* Number of express lanes above the ordered ticker node list */
+#define TICKER_SKIP_LEVELS 4
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
+
 /*****************************************************************************
  * Types
  ****************************************************************************/
@@ -81,6 +87,14 @@ struct ticker_node {
 	int8_t  priority;			 /* Ticker node priority. 0 is default.
 					  * Lower value is higher priority
 					  */
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+	uint8_t  skip_next[TICKER_SKIP_LEVELS]; /* Next ticker node in each
+						 * express lane
+						 */
+	uint32_t ticks_abs;		 /* Expiration, in ticks elapsed
+					  * since ticker_init
+					  */
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
 #endif /* CONFIG_BT_TICKER_COMPATIBILITY_MODE */
 };
 
@@ -228,6 +242,14 @@ struct ticker_instance {
 	uint8_t  ticker_id_head;      /* Index of first ticker node (next to
 				    * expire)
 				    */
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+	uint8_t  skip_head[TICKER_SKIP_LEVELS]; /* Index of first ticker node
+						 * in each express lane
+						 */
+	uint32_t ticks_abs_current; /* Ticks elapsed since ticker_init, at
+				     * last ticker_job
+				     */
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
 	uint8_t  job_guard;	   /* Flag preventing ticker_worker from
 				    * running if ticker_job is active
 				    */
@@ -249,6 +271,12 @@ struct ticker_instance {
 						     * the trigger (compare
 						     * value)
 						     */
+#if defined(CONFIG_BT_TICKER_JOB_PROFILE)
+	struct ticker_job_profile profile;	    /* ticker_job latency and
+						     * node list walk
+						     * statistics
+						     */
+#endif /* CONFIG_BT_TICKER_JOB_PROFILE */
 };
 
 BUILD_ASSERT(sizeof(struct ticker_node)    == TICKER_NODE_T_SIZE);
@@ -261,6 +289,12 @@ BUILD_ASSERT(sizeof(struct ticker_user_op) == TICKER_USER_OP_T_SIZE);
 #define TICKER_INSTANCE_MAX 1
 static struct ticker_instance _instance[TICKER_INSTANCE_MAX];
 
+#if defined(CONFIG_BT_TICKER_JOB_PROFILE)
+#define TICKER_PROFILE_WALK(instance) ((instance)->profile.walk_curr++)
+#else /* !CONFIG_BT_TICKER_JOB_PROFILE */
+#define TICKER_PROFILE_WALK(instance)
+#endif /* !CONFIG_BT_TICKER_JOB_PROFILE */
+
 /*****************************************************************************
  * Static Functions
  ****************************************************************************/
@@ -383,6 +417,217 @@ static void ticker_by_next_slot_get(struct ticker_instance *instance,
 	*ticks_to_expire = _ticks_to_expire;
 }
 
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+/**
+ * @brief Get number of express lanes of ticker node
+ *
+ * @details Half of the ticker node ids are in the first express lane, a
+ * quarter in the second one, and so on, as in a skip list with
+ * probability 1/2 but without a random number source.
+ *
+ * @param id Ticker node id
+ *
+ * @return Number of express lanes the ticker node is linked in
+ * @internal
+ */
+static inline uint8_t ticker_skip_height(uint8_t id)
+{
+	return MIN(find_lsb_set(id + 1U) - 1U, TICKER_SKIP_LEVELS);
+}
+
+/**
+ * @brief Get total ticks until expiration of ticker node
+ *
+ * @param instance Pointer to ticker instance
+ * @param ticker   Pointer to ticker node in the node list
+ *
+ * @return Sum of ticks_to_expire from the head up to the ticker node
+ * @internal
+ */
+static inline uint32_t ticker_skip_key(struct ticker_instance *instance,
+				       struct ticker_node *ticker)
+{
+	return ticker->ticks_abs - instance->ticks_abs_current;
+}
+
+/**
+ * @brief Find last ticker node expiring before given ticks
+ *
+ * @details Descends the express lanes, and records in each one the last
+ * ticker node expiring before ticks_to_expire.
+ *
+ * @param instance        Pointer to ticker instance
+ * @param ticks_to_expire Total ticks until expiration
+ * @param update          Array of TICKER_SKIP_LEVELS ids, filled with the
+ *                        last ticker node of each express lane expiring
+ *                        before ticks_to_expire, or TICKER_NULL
+ *
+ * @return Id of the last express ticker node expiring before
+ * ticks_to_expire, or TICKER_NULL
+ * @internal
+ */
+static uint8_t ticker_skip_find(struct ticker_instance *instance,
+				uint32_t ticks_to_expire, uint8_t *update)
+{
+	struct ticker_node *node;
+	uint8_t previous;
+	uint8_t current;
+	uint8_t level;
+
+	node = &instance->nodes[0];
+	previous = TICKER_NULL;
+	level = TICKER_SKIP_LEVELS;
+	while (level--) {
+		if (previous == TICKER_NULL) {
+			current = instance->skip_head[level];
+		} else {
+			current = node[previous].skip_next[level];
+		}
+
+		while ((current != TICKER_NULL) &&
+		       (ticker_skip_key(instance, &node[current]) <
+			ticks_to_expire)) {
+			previous = current;
+			current = node[current].skip_next[level];
+
+			TICKER_PROFILE_WALK(instance);
+		}
+
+		update[level] = previous;
+	}
+
+	return previous;
+}
+
+/**
+ * @brief Record ticker node walked past in the node list
+ *
+ * @param update Array of TICKER_SKIP_LEVELS ids, of the last ticker node
+ *               of each express lane before the insertion or extraction
+ *               point
+ * @param id     Ticker node id walked past
+ * @internal
+ */
+static inline void ticker_skip_pass(uint8_t *update, uint8_t id)
+{
+	uint8_t level;
+
+	level = ticker_skip_height(id);
+	while (level--) {
+		update[level] = id;
+	}
+}
+
+/**
+ * @brief Link ticker node in express lanes
+ *
+ * @details The ticker node must already be linked in the node list.
+ *
+ * @param instance Pointer to ticker instance
+ * @param id       Ticker node id to link
+ * @param update   Array of TICKER_SKIP_LEVELS ids, of the last ticker node
+ *                 of each express lane before the ticker node, or
+ *                 TICKER_NULL
+ * @internal
+ */
+static void ticker_skip_link(struct ticker_instance *instance, uint8_t id,
+			     uint8_t *update)
+{
+	struct ticker_node *node;
+	uint8_t level;
+
+	node = &instance->nodes[0];
+	level = ticker_skip_height(id);
+	while (level--) {
+		uint8_t *next;
+
+		if (update[level] == TICKER_NULL) {
+			next = &instance->skip_head[level];
+		} else {
+			next = &node[update[level]].skip_next[level];
+		}
+
+		node[id].skip_next[level] = *next;
+		*next = id;
+	}
+}
+
+/**
+ * @brief Unlink ticker node from express lanes
+ *
+ * @param instance Pointer to ticker instance
+ * @param id       Ticker node id to unlink
+ * @param update   Array of TICKER_SKIP_LEVELS ids, of the last ticker node
+ *                 of each express lane before the ticker node, or NULL if
+ *                 the ticker node is the head of the node list
+ * @internal
+ */
+static void ticker_skip_unlink(struct ticker_instance *instance, uint8_t id,
+			       uint8_t *update)
+{
+	struct ticker_node *node;
+	uint8_t level;
+
+	node = &instance->nodes[0];
+	level = ticker_skip_height(id);
+	while (level--) {
+		if (!update || (update[level] == TICKER_NULL)) {
+			instance->skip_head[level] = node[id].skip_next[level];
+		} else {
+			node[update[level]].skip_next[level] =
+				node[id].skip_next[level];
+		}
+	}
+}
+
+#if defined(CONFIG_BT_TICKER_EXT)
+/**
+ * @brief Rebuild express lanes
+ *
+ * @details Called after the node list was re-ordered without maintaining
+ * the express lanes, recomputes the expiration of each ticker node and
+ * links them again in the express lanes.
+ *
+ * @param instance Pointer to ticker instance
+ * @internal
+ */
+static void ticker_skip_rebuild(struct ticker_instance *instance)
+{
+	uint8_t update[TICKER_SKIP_LEVELS];
+	struct ticker_node *node;
+	uint32_t ticks_abs;
+	uint8_t current;
+	uint8_t level;
+
+	for (level = 0U; level < TICKER_SKIP_LEVELS; level++) {
+		instance->skip_head[level] = TICKER_NULL;
+		update[level] = TICKER_NULL;
+	}
+
+	node = &instance->nodes[0];
+	ticks_abs = instance->ticks_abs_current;
+	current = instance->ticker_id_head;
+	while (current != TICKER_NULL) {
+		ticks_abs += node[current].ticks_to_expire;
+		node[current].ticks_abs = ticks_abs;
+
+		/* Nodes are walked in order, append to the express lanes */
+		ticker_skip_link(instance, current, update);
+		ticker_skip_pass(update, current);
+
+		current = node[current].next;
+	}
+
+	/* Terminate the express lanes */
+	for (level = 0U; level < TICKER_SKIP_LEVELS; level++) {
+		if (update[level] != TICKER_NULL) {
+			node[update[level]].skip_next[level] = TICKER_NULL;
+		}
+	}
+}
+#endif /* CONFIG_BT_TICKER_EXT */
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
+
 #if !defined(CONFIG_BT_TICKER_COMPATIBILITY_MODE)
 /**
  * @brief Enqueue ticker node
@@ -405,6 +650,9 @@ static uint8_t ticker_enqueue(struct ticker_instance *instance, uint8_t id)
 	uint32_t ticks_to_expire;
 	uint8_t previous;
 	uint8_t current;
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+	uint8_t update[TICKER_SKIP_LEVELS];
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
 
 	node = &instance->nodes[0];
 	ticker_new = &node[id];
@@ -416,6 +664,16 @@ static uint8_t ticker_enqueue(struct ticker_instance *instance, uint8_t id)
 	 */
 	previous = TICKER_NULL;
 
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+	/* Skip the nodes expiring before the new ticker node */
+	ticker_new->ticks_abs = instance->ticks_abs_current + ticks_to_expire;
+	previous = ticker_skip_find(instance, ticks_to_expire, update);
+	if (previous != TICKER_NULL) {
+		ticks_to_expire -= ticker_skip_key(instance, &node[previous]);
+		current = node[previous].next;
+	}
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
+
 	while ((current != TICKER_NULL) && (ticks_to_expire >=
 		(ticks_to_expire_current =
 		(ticker_current = &node[current])->ticks_to_expire))) {
@@ -433,6 +691,12 @@ static uint8_t ticker_enqueue(struct ticker_instance *instance, uint8_t id)
 
 		previous = current;
 		current = ticker_current->next;
+
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+		ticker_skip_pass(update, previous);
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
+
+		TICKER_PROFILE_WALK(instance);
 	}
 
 	/* Link in new ticker node and adjust ticks_to_expire to relative value
@@ -450,6 +714,10 @@ static uint8_t ticker_enqueue(struct ticker_instance *instance, uint8_t id)
 		node[current].ticks_to_expire -= ticks_to_expire;
 	}
 
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+	ticker_skip_link(instance, id, update);
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
+
 	return id;
 }
 #else /* !CONFIG_BT_TICKER_COMPATIBILITY_MODE */
@@ -512,6 +780,8 @@ static uint8_t ticker_enqueue(struct ticker_instance *instance, uint8_t id)
 		}
 		previous = current;
 		current = ticker_current->next;
+
+		TICKER_PROFILE_WALK(instance);
 	}
 
 	/* Check for collision for new ticker node at insertion point */
@@ -573,6 +843,9 @@ static uint32_t ticker_dequeue(struct ticker_instance *instance, uint8_t id)
 	uint32_t timeout;
 	uint8_t current;
 	uint32_t total;
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+	uint8_t update[TICKER_SKIP_LEVELS];
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
 
 	/* Find the ticker's position in ticker node list while accumulating
 	 * ticks_to_expire
@@ -582,6 +855,22 @@ static uint32_t ticker_dequeue(struct ticker_instance *instance, uint8_t id)
 	current = previous;
 	total = 0U;
 	ticker_current = 0;
+
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+	/* Skip the nodes expiring before the ticker. If the ticker is not in
+	 * the list, its expiration is stale and it is not found either.
+	 */
+	previous = ticker_skip_find(instance,
+				    ticker_skip_key(instance, &node[id]),
+				    update);
+	if (previous != TICKER_NULL) {
+		total = ticker_skip_key(instance, &node[previous]);
+		current = node[previous].next;
+	} else {
+		previous = current;
+	}
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
+
 	while (current != TICKER_NULL) {
 		ticker_current = &node[current];
 
@@ -592,6 +881,12 @@ static uint32_t ticker_dequeue(struct ticker_instance *instance, uint8_t id)
 		total += ticker_current->ticks_to_expire;
 		previous = current;
 		current = ticker_current->next;
+
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+		ticker_skip_pass(update, previous);
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
+
+		TICKER_PROFILE_WALK(instance);
 	}
 
 	if (current == TICKER_NULL) {
@@ -619,6 +914,10 @@ static uint32_t ticker_dequeue(struct ticker_instance *instance, uint8_t id)
 		node[ticker_current->next].ticks_to_expire += timeout;
 	}
 
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+	ticker_skip_unlink(instance, id, update);
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
+
 	return (total + timeout);
 }
 
@@ -1433,6 +1732,10 @@ static inline void ticker_job_worker_bh(struct ticker_instance *instance,
 		/* remove the expired ticker from head */
 		instance->ticker_id_head = ticker->next;
 
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+		ticker_skip_unlink(instance, id_expired, NULL);
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
+
 		/* Ticker will be restarted if periodic or to be re-scheduled */
 		if ((ticker->ticks_periodic != 0U) ||
 		    TICKER_RESCHEDULE_PENDING(ticker)) {
@@ -2216,6 +2519,41 @@ static inline void ticker_job_compare_update(struct ticker_instance *instance,
 		  ticker_ticks_diff_get(cc, ctr));
 }
 
+#if defined(CONFIG_BT_TICKER_JOB_PROFILE)
+/**
+ * @brief Update ticker_job profiling statistics
+ *
+ * @details Records the duration of the ticker_job that started at
+ * ticks_start, together with the number of ticker nodes visited while
+ * walking the node list, and updates the min/max values accordingly.
+ *
+ * @param instance    Pointer to ticker instance
+ * @param ticks_start Counter value sampled when ticker_job started
+ *
+ * @internal
+ */
+static inline void ticker_job_profile_update(struct ticker_instance *instance,
+					     uint32_t ticks_start)
+{
+	struct ticker_job_profile *profile = &instance->profile;
+	uint32_t ticks;
+
+	ticks = ticker_ticks_diff_get(cntr_cnt_get(), ticks_start);
+
+	profile->ticks_curr = ticks;
+	if (!profile->count || (ticks < profile->ticks_min)) {
+		profile->ticks_min = ticks;
+	}
+	if (ticks > profile->ticks_max) {
+		profile->ticks_max = ticks;
+	}
+	if (profile->walk_curr > profile->walk_max) {
+		profile->walk_max = profile->walk_curr;
+	}
+	profile->count++;
+}
+#endif /* CONFIG_BT_TICKER_JOB_PROFILE */
+
 /**
  * @brief Ticker job
  *
@@ -2240,6 +2578,9 @@ void ticker_job(void *param)
 	uint8_t flag_elapsed;
 	uint8_t pending;
 	uint8_t flag_compare_update;
+#if defined(CONFIG_BT_TICKER_JOB_PROFILE)
+	uint32_t ticks_job_start;
+#endif /* CONFIG_BT_TICKER_JOB_PROFILE */
 
 	DEBUG_TICKER_JOB(1);
 
@@ -2250,6 +2591,11 @@ void ticker_job(void *param)
 	}
 	instance->job_guard = 1U;
 
+#if defined(CONFIG_BT_TICKER_JOB_PROFILE)
+	ticks_job_start = cntr_cnt_get();
+	instance->profile.walk_curr = 0U;
+#endif /* CONFIG_BT_TICKER_JOB_PROFILE */
+
 	/* Back up the previous known tick */
 	ticks_previous = instance->ticks_current;
 
@@ -2294,6 +2640,11 @@ void ticker_job(void *param)
 		ticker_job_worker_bh(instance, ticks_previous, ticks_elapsed,
 				     &insert_head);
 
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+		/* Expirations are now relative to the new current tick */
+		instance->ticks_abs_current += ticks_elapsed;
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
+
 		/* Detect change in head of the list */
 		if (instance->ticker_id_head != ticker_id_old_head) {
 			flag_compare_update = 1U;
@@ -2306,6 +2657,10 @@ void ticker_job(void *param)
 		/* Re-schedule any pending nodes with slot_window */
 		if (ticker_job_reschedule_in_window(instance, ticks_elapsed)) {
 			flag_compare_update = 1U;
+
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+			ticker_skip_rebuild(instance);
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
 		}
 #endif /* CONFIG_BT_TICKER_EXT */
 	} else {
@@ -2324,6 +2679,10 @@ void ticker_job(void *param)
 		ticker_job_list_inquire(instance);
 	}
 
+#if defined(CONFIG_BT_TICKER_JOB_PROFILE)
+	ticker_job_profile_update(instance, ticks_job_start);
+#endif /* CONFIG_BT_TICKER_JOB_PROFILE */
+
 	/* Permit worker job to run */
 	instance->job_guard = 0U;
 
@@ -2417,6 +2776,12 @@ uint32_t ticker_init(uint8_t instance_index, uint8_t count_node, void *node,
 	instance->ticks_elapsed_first = 0U;
 	instance->ticks_elapsed_last = 0U;
 
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+	(void)memset(instance->skip_head, TICKER_NULL,
+		     sizeof(instance->skip_head));
+	instance->ticks_abs_current = 0U;
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
+
 	return TICKER_STATUS_SUCCESS;
 }
 
@@ -2948,3 +3313,33 @@ uint32_t ticker_ticks_diff_get(uint32_t ticks_now, uint32_t ticks_old)
 {
 	return ((ticks_now - ticks_old) & HAL_TICKER_CNTR_MASK);
 }
+
+#if defined(CONFIG_BT_TICKER_JOB_PROFILE)
+/**
+ * @brief Get ticker_job profiling statistics
+ *
+ * @details Copies the ticker_job latency (in ticker counter ticks) and node
+ * list walk statistics of the ticker instance. When reset is true, the
+ * min/max values are cleared after being copied.
+ * Shall be called from the ticker job context, or with the ticker job
+ * disabled, for the copy to be consistent.
+ *
+ * @param instance_index Index of ticker instance
+ * @param profile        Pointer to the profiling statistics to fill
+ * @param reset          Clear the min/max values after copying
+ */
+void ticker_job_profile_get(uint8_t instance_index,
+			    struct ticker_job_profile *profile, bool reset)
+{
+	struct ticker_instance *instance = &_instance[instance_index];
+
+	*profile = instance->profile;
+
+	if (reset) {
+		instance->profile.ticks_min = 0U;
+		instance->profile.ticks_max = 0U;
+		instance->profile.walk_max = 0U;
+		instance->profile.count = 0U;
+	}
+}
+#endif /* CONFIG_BT_TICKER_JOB_PROFILE */
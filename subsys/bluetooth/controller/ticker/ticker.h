@@ -34,15 +34,23 @@
  * @}
  */
 
+/** \brief Timer node skip list size.
+ */
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+#define TICKER_NODE_SKIP_T_SIZE 8
+#else
+#define TICKER_NODE_SKIP_T_SIZE 0
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
+
 /** \brief Timer node type size.
  */
 #if defined(CONFIG_BT_TICKER_COMPATIBILITY_MODE)
 #define TICKER_NODE_T_SIZE      40
 #else
 #if defined(CONFIG_BT_TICKER_EXT)
-#define TICKER_NODE_T_SIZE      48
+#define TICKER_NODE_T_SIZE      (48 + TICKER_NODE_SKIP_T_SIZE)
 #else
-#define TICKER_NODE_T_SIZE      44
+#define TICKER_NODE_T_SIZE      (44 + TICKER_NODE_SKIP_T_SIZE)
 #endif /* CONFIG_BT_TICKER_EXT */
 #endif /* CONFIG_BT_TICKER_COMPATIBILITY_MODE*/
 
@@ -103,6 +111,22 @@ struct ticker_ext {
 };
 #endif /* CONFIG_BT_TICKER_EXT */
 
+#if defined(CONFIG_BT_TICKER_JOB_PROFILE)
+/** \brief ticker_job profiling statistics.
+ *
+ * Durations are in ticker counter ticks, walks are the number of ticker
+ * nodes visited by list insertions and removals during one ticker_job.
+ */
+struct ticker_job_profile {
+	uint32_t ticks_curr; /* Duration of last ticker_job */
+	uint32_t ticks_min;  /* Shortest ticker_job duration */
+	uint32_t ticks_max;  /* Longest ticker_job duration */
+	uint32_t count;	     /* Number of profiled ticker_job runs */
+	uint16_t walk_curr;  /* Nodes walked during last ticker_job */
+	uint16_t walk_max;   /* Most nodes walked in one ticker_job */
+};
+#endif /* CONFIG_BT_TICKER_JOB_PROFILE */
+
 /** \brief Timer module initialization.
  *
  * \param[in]  instance_index  Timer mode instance 0 or 1 (uses RTC0 CMP0 or
@@ -146,6 +170,10 @@ uint32_t ticker_job_idle_get(uint8_t instance_index, uint8_t user_id,
 void ticker_job_sched(uint8_t instance_index, uint8_t user_id);
 uint32_t ticker_ticks_now_get(void);
 uint32_t ticker_ticks_diff_get(uint32_t ticks_now, uint32_t ticks_old);
+#if defined(CONFIG_BT_TICKER_JOB_PROFILE)
+void ticker_job_profile_get(uint8_t instance_index,
+			    struct ticker_job_profile *profile, bool reset);
+#endif /* CONFIG_BT_TICKER_JOB_PROFILE */
 #if !defined(CONFIG_BT_TICKER_COMPATIBILITY_MODE)
 uint32_t ticker_priority_set(uint8_t instance_index, uint8_t user_id, uint8_t ticker_id,
 			  int8_t priority, ticker_op_func fp_op_func,
@@ -11,6 +11,29 @@
 #include "memq.h"
 #include "mayfly.h"
 
+#if defined(CONFIG_BT_MAYFLY_LATENCY_PROFILE) || \
+	defined(CONFIG_BT_MAYFLY_DEADLINE)
+#include "hal/cntr.h"
+#include "hal/ticker.h"
+#endif /* CONFIG_BT_MAYFLY_LATENCY_PROFILE || CONFIG_BT_MAYFLY_DEADLINE */
+
+#if defined(CONFIG_BT_MAYFLY_LATENCY_PROFILE)
+static struct mayfly_latency mfl_latency[MAYFLY_CALLEE_COUNT];
+
+#define MAYFLY_READY_STAMP(m) ((m)->_ticks_ready = cntr_cnt_get())
+#else /* !CONFIG_BT_MAYFLY_LATENCY_PROFILE */
+#define MAYFLY_READY_STAMP(m)
+#endif /* !CONFIG_BT_MAYFLY_LATENCY_PROFILE */
+
+#if defined(CONFIG_BT_MAYFLY_DEADLINE)
+#define MAYFLY_DEADLINE_TICKS \
+	HAL_TICKER_US_TO_TICKS(CONFIG_BT_MAYFLY_DEADLINE_US)
+
+#define MAYFLY_DEADLINE_SET(m, ticks) ((m)->_ticks_deadline = (ticks))
+#else /* !CONFIG_BT_MAYFLY_DEADLINE */
+#define MAYFLY_DEADLINE_SET(m, ticks)
+#endif /* !CONFIG_BT_MAYFLY_DEADLINE */
+
 static struct {
 	memq_link_t *head;
 	memq_link_t *tail;
@@ -67,8 +90,8 @@ void mayfly_enable(uint8_t caller_id, uint8_t callee_id, uint8_t enable)
 	}
 }
 
-uint32_t mayfly_enqueue(uint8_t caller_id, uint8_t callee_id, uint8_t chain,
-			struct mayfly *m)
+static uint32_t enqueue(uint8_t caller_id, uint8_t callee_id, uint8_t chain,
+			struct mayfly *m, uint32_t ticks_deadline)
 {
 	uint8_t state;
 	uint8_t ack;
@@ -87,7 +110,9 @@ uint32_t mayfly_enqueue(uint8_t caller_id, uint8_t callee_id, uint8_t chain,
 		if (chain) {
 			if (state != 1U) {
 				/* mark as ready in queue */
+				MAYFLY_DEADLINE_SET(m, ticks_deadline);
 				m->_req = ack + 1;
+				MAYFLY_READY_STAMP(m);
 
 				goto mayfly_enqueue_pend;
 			}
@@ -109,7 +134,9 @@ uint32_t mayfly_enqueue(uint8_t caller_id, uint8_t callee_id, uint8_t chain,
 	}
 
 	/* new, add as ready in the queue */
+	MAYFLY_DEADLINE_SET(m, ticks_deadline);
 	m->_req = ack + 1;
+	MAYFLY_READY_STAMP(m);
 	memq_enqueue(m->_link, m, &mft[callee_id][caller_id].tail);
 
 mayfly_enqueue_pend:
@@ -122,6 +149,57 @@ mayfly_enqueue_pend:
 	return 0;
 }
 
+uint32_t mayfly_enqueue(uint8_t caller_id, uint8_t callee_id, uint8_t chain,
+			struct mayfly *m)
+{
+#if defined(CONFIG_BT_MAYFLY_DEADLINE)
+	uint32_t ticks_deadline;
+
+	ticks_deadline = (cntr_cnt_get() + MAYFLY_DEADLINE_TICKS) &
+			 HAL_TICKER_CNTR_MASK;
+
+	return enqueue(caller_id, callee_id, chain, m, ticks_deadline);
+#else /* !CONFIG_BT_MAYFLY_DEADLINE */
+	return enqueue(caller_id, callee_id, chain, m, 0U);
+#endif /* !CONFIG_BT_MAYFLY_DEADLINE */
+}
+
+#if defined(CONFIG_BT_MAYFLY_DEADLINE)
+uint32_t mayfly_enqueue_deadline(uint8_t caller_id, uint8_t callee_id,
+				 uint8_t chain, struct mayfly *m,
+				 uint32_t ticks_deadline)
+{
+	return enqueue(caller_id, callee_id, chain, m, ticks_deadline);
+}
+#endif /* CONFIG_BT_MAYFLY_DEADLINE */
+
+#if defined(CONFIG_BT_MAYFLY_LATENCY_PROFILE)
+static void latency_update(uint8_t callee_id, struct mayfly *m)
+{
+	struct mayfly_latency *latency = &mfl_latency[callee_id];
+	uint32_t ticks;
+
+	ticks = (cntr_cnt_get() - m->_ticks_ready) & HAL_TICKER_CNTR_MASK;
+
+	latency->ticks_curr = ticks;
+	if (ticks > latency->ticks_max) {
+		latency->ticks_max = ticks;
+	}
+	latency->count++;
+}
+
+void mayfly_latency_get(uint8_t callee_id, struct mayfly_latency *latency,
+			uint8_t reset)
+{
+	*latency = mfl_latency[callee_id];
+
+	if (reset) {
+		mfl_latency[callee_id].ticks_max = 0U;
+		mfl_latency[callee_id].count = 0U;
+	}
+}
+#endif /* CONFIG_BT_MAYFLY_LATENCY_PROFILE */
+
 static void dequeue(uint8_t callee_id, uint8_t caller_id, memq_link_t *link,
 		    struct mayfly *m)
 {
@@ -169,6 +247,92 @@ static void dequeue(uint8_t callee_id, uint8_t caller_id, memq_link_t *link,
 	}
 }
 
+#if defined(CONFIG_BT_MAYFLY_DEADLINE)
+static inline uint8_t deadline_is_before(struct mayfly *m, struct mayfly *ref)
+{
+	return ((m->_ticks_deadline - ref->_ticks_deadline) &
+		HAL_TICKER_CNTR_MASK) > (HAL_TICKER_CNTR_MASK >> 1);
+}
+
+static memq_link_t *ready_peek(uint8_t callee_id, uint8_t caller_id,
+			       struct mayfly **m)
+{
+	memq_link_t *link;
+
+	/* fetch mayfly in callee queue, if any */
+	link = memq_peek(mft[callee_id][caller_id].head,
+			 mft[callee_id][caller_id].tail, (void **)m);
+
+	/* dequeue mayflies marked done in queue */
+	while (link && ((((*m)->_req - (*m)->_ack) & 0x03) != 1U)) {
+		dequeue(callee_id, caller_id, link, *m);
+
+		link = memq_peek(mft[callee_id][caller_id].head,
+				 mft[callee_id][caller_id].tail, (void **)m);
+	}
+
+	return link;
+}
+
+/* Run the ready mayflies, earliest deadline first among the caller queues
+ * heads. Returns 1 if yielding with mayflies left to run.
+ */
+static uint8_t run_deadline(uint8_t callee_id)
+{
+	while (1) {
+		memq_link_t *link = NULL;
+		struct mayfly *m = NULL;
+		uint8_t caller_run = 0U;
+		uint8_t caller_id;
+
+		/* select the earliest deadline, the highest caller id on a
+		 * tie as in the caller queue order.
+		 */
+		caller_id = MAYFLY_CALLER_COUNT;
+		while (caller_id--) {
+			memq_link_t *link_caller;
+			struct mayfly *m_caller;
+
+			link_caller = ready_peek(callee_id, caller_id,
+						 &m_caller);
+			if (link_caller &&
+			    (!link || deadline_is_before(m_caller, m))) {
+				link = link_caller;
+				m = m_caller;
+				caller_run = caller_id;
+			}
+		}
+
+		if (!link) {
+			return 0U;
+		}
+
+		/* mark mayfly as ran */
+		m->_ack--;
+
+#if defined(CONFIG_BT_MAYFLY_LATENCY_PROFILE)
+		latency_update(callee_id, m);
+#endif /* CONFIG_BT_MAYFLY_LATENCY_PROFILE */
+
+		/* call the mayfly function */
+		m->fp(m->param);
+
+		/* dequeue if not re-pended */
+		dequeue(callee_id, caller_run, link, m);
+
+#if defined(CONFIG_BT_MAYFLY_YIELD_AFTER_CALL)
+		/* yield out of mayfly_run, the queues and the enable and
+		 * disable requests are processed in the tailchained run.
+		 */
+		mfp[callee_id] = 1U;
+		mayfly_pend(callee_id, callee_id);
+
+		return 1U;
+#endif /* CONFIG_BT_MAYFLY_YIELD_AFTER_CALL */
+	}
+}
+#endif /* CONFIG_BT_MAYFLY_DEADLINE */
+
 void mayfly_run(uint8_t callee_id)
 {
 	uint8_t disable = 0U;
@@ -180,6 +344,16 @@ void mayfly_run(uint8_t callee_id)
 	}
 	mfp[callee_id] = 0U;
 
+#if defined(CONFIG_BT_MAYFLY_DEADLINE)
+	if (run_deadline(callee_id)) {
+		return;
+	}
+
+	/* The caller queues below are now empty, unless mayflies were
+	 * queued since, and only the enable and disable requests remain.
+	 */
+#endif /* CONFIG_BT_MAYFLY_DEADLINE */
+
 	/* iterate through each caller queue to this callee_id */
 	caller_id = MAYFLY_CALLER_COUNT;
 	while (caller_id--) {
@@ -207,6 +381,10 @@ void mayfly_run(uint8_t callee_id)
 				/* mark mayfly as ran */
 				m->_ack--;
 
+#if defined(CONFIG_BT_MAYFLY_LATENCY_PROFILE)
+				latency_update(callee_id, m);
+#endif /* CONFIG_BT_MAYFLY_LATENCY_PROFILE */
+
 				/* call the mayfly function */
 				m->fp(m->param);
 			}
@@ -18,13 +18,46 @@ struct mayfly {
 	memq_link_t *_link;
 	void *param;
 	void (*fp)(void *);
+#if defined(CONFIG_BT_MAYFLY_LATENCY_PROFILE)
+	uint32_t _ticks_ready;
+#endif /* CONFIG_BT_MAYFLY_LATENCY_PROFILE */
+#if defined(CONFIG_BT_MAYFLY_DEADLINE)
+	uint32_t _ticks_deadline;
+#endif /* CONFIG_BT_MAYFLY_DEADLINE */
 };
 
+#if defined(CONFIG_BT_MAYFLY_LATENCY_PROFILE)
+struct mayfly_latency {
+	uint32_t ticks_curr; /* Last enqueue-to-run latency */
+	uint32_t ticks_max;  /* Largest enqueue-to-run latency */
+	uint32_t count;	     /* Number of deferred mayflies run */
+};
+#endif /* CONFIG_BT_MAYFLY_LATENCY_PROFILE */
+
 void mayfly_init(void);
 void mayfly_enable(uint8_t caller_id, uint8_t callee_id, uint8_t enable);
 uint32_t mayfly_enqueue(uint8_t caller_id, uint8_t callee_id, uint8_t chain,
 		     struct mayfly *m);
+#if defined(CONFIG_BT_MAYFLY_DEADLINE)
+uint32_t mayfly_enqueue_deadline(uint8_t caller_id, uint8_t callee_id,
+				 uint8_t chain, struct mayfly *m,
+				 uint32_t ticks_deadline);
+#else /* !CONFIG_BT_MAYFLY_DEADLINE */
+static inline uint32_t mayfly_enqueue_deadline(uint8_t caller_id,
+					       uint8_t callee_id,
+					       uint8_t chain, struct mayfly *m,
+					       uint32_t ticks_deadline)
+{
+	(void)ticks_deadline;
+
+	return mayfly_enqueue(caller_id, callee_id, chain, m);
+}
+#endif /* !CONFIG_BT_MAYFLY_DEADLINE */
 void mayfly_run(uint8_t callee_id);
+#if defined(CONFIG_BT_MAYFLY_LATENCY_PROFILE)
+void mayfly_latency_get(uint8_t callee_id, struct mayfly_latency *latency,
+			uint8_t reset);
+#endif /* CONFIG_BT_MAYFLY_LATENCY_PROFILE */
 
 extern void mayfly_enable_cb(uint8_t caller_id, uint8_t callee_id, uint8_t enable);
 extern uint32_t mayfly_is_enabled(uint8_t caller_id, uint8_t callee_id);
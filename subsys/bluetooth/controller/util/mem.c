@@ -7,11 +7,20 @@
 
 #include <zephyr/types.h>
 #include <string.h>
+#include <sys/util.h>
 
 #include "util.h"
 
 #include "mem.h"
 
+#if defined(CONFIG_BT_CTLR_MEM_STATS)
+/* Lowest free count seen on the pool, stored next to the free count of the
+ * list's head. It is handed over to the new head on every acquire and release.
+ */
+#define MEM_FREE_MIN(head) \
+	(*((uint16_t *)MROUND((uint8_t *)(head) + sizeof(void *)) + 1))
+#endif /* CONFIG_BT_CTLR_MEM_STATS */
+
 void mem_init(void *mem_pool, uint16_t mem_size, uint16_t mem_count,
 	      void **mem_head)
 {
@@ -22,6 +31,10 @@ void mem_init(void *mem_pool, uint16_t mem_size, uint16_t mem_count,
 	 */
 	*((uint16_t *)MROUND((uint8_t *)mem_pool + sizeof(mem_pool))) = mem_count;
 
+#if defined(CONFIG_BT_CTLR_MEM_STATS)
+	MEM_FREE_MIN(mem_pool) = mem_count;
+#endif /* CONFIG_BT_CTLR_MEM_STATS */
+
 	/* Initialize next pointers to form a free list,
 	 * next pointer is stored in the first 32-bit of each block
 	 */
@@ -56,6 +69,10 @@ void *mem_acquire(void **mem_head)
 		if (head) {
 			*((uint16_t *)MROUND((uint8_t *)head + sizeof(head))) =
 				free_count;
+
+#if defined(CONFIG_BT_CTLR_MEM_STATS)
+			MEM_FREE_MIN(head) = MIN(MEM_FREE_MIN(mem), free_count);
+#endif /* CONFIG_BT_CTLR_MEM_STATS */
 		}
 
 		*mem_head = head;
@@ -68,11 +85,18 @@ void *mem_acquire(void **mem_head)
 void mem_release(void *mem, void **mem_head)
 {
 	uint16_t free_count = 0U;
+#if defined(CONFIG_BT_CTLR_MEM_STATS)
+	uint16_t free_min = 0U;
+#endif /* CONFIG_BT_CTLR_MEM_STATS */
 
 	/* Get the free count from the list and increment it */
 	if (*mem_head) {
 		free_count = *((uint16_t *)MROUND((uint8_t *)*mem_head +
 					       sizeof(mem_head)));
+
+#if defined(CONFIG_BT_CTLR_MEM_STATS)
+		free_min = MEM_FREE_MIN(*mem_head);
+#endif /* CONFIG_BT_CTLR_MEM_STATS */
 	}
 	free_count++;
 
@@ -81,6 +105,10 @@ void mem_release(void *mem, void **mem_head)
 	/* Store free mem_count after the list's next pointer */
 	*((uint16_t *)MROUND((uint8_t *)mem + sizeof(mem))) = free_count;
 
+#if defined(CONFIG_BT_CTLR_MEM_STATS)
+	MEM_FREE_MIN(mem) = free_min;
+#endif /* CONFIG_BT_CTLR_MEM_STATS */
+
 	*mem_head = mem;
 }
 
@@ -97,6 +125,18 @@ uint16_t mem_free_count_get(void *mem_head)
 	return free_count;
 }
 
+#if defined(CONFIG_BT_CTLR_MEM_STATS)
+uint16_t mem_free_min_get(void *mem_head)
+{
+	/* An empty list has been exhausted */
+	if (!mem_head) {
+		return 0U;
+	}
+
+	return MEM_FREE_MIN(mem_head);
+}
+#endif /* CONFIG_BT_CTLR_MEM_STATS */
+
 void *mem_get(void *mem_pool, uint16_t mem_size, uint16_t index)
 {
 	return ((void *)((uint8_t *)mem_pool + (mem_size * index)));
@@ -194,5 +234,12 @@ uint32_t mem_ut(void)
 		return 6;
 	}
 
+#if defined(CONFIG_BT_CTLR_MEM_STATS)
+	/* Pool has been exhausted once */
+	if (mem_free_min_get(mem_free) != 0U) {
+		return 7;
+	}
+#endif /* CONFIG_BT_CTLR_MEM_STATS */
+
 	return 0;
 }
@@ -37,11 +37,31 @@
 #define MROUND(x) (((uint32_t)(x)+3) & (~((uint32_t)3)))
 #endif
 
+#ifndef MEM_BARRIER_RELEASE
+/**
+ * @brief Order queue element accesses against the queue's indices
+ * @details Producers use the release barrier between writing an element and
+ *   publishing it through the queue's write index or tail, consumers use the
+ *   acquire barrier between observing the write index or tail and reading the
+ *   element. The consumer's release of a slot is ordered the same way.
+ *   Only needed when the producer and consumer contexts execute on different
+ *   cores; on a single core both reduce to nothing.
+ */
+#if defined(CONFIG_BT_CTLR_MEMQ_SMP)
+#define MEM_BARRIER_RELEASE() __atomic_thread_fence(__ATOMIC_RELEASE)
+#define MEM_BARRIER_ACQUIRE() __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#else /* !CONFIG_BT_CTLR_MEMQ_SMP */
+#define MEM_BARRIER_RELEASE()
+#define MEM_BARRIER_ACQUIRE()
+#endif /* !CONFIG_BT_CTLR_MEMQ_SMP */
+#endif
+
 void mem_init(void *mem_pool, uint16_t mem_size, uint16_t mem_count, void **mem_head);
 void *mem_acquire(void **mem_head);
 void mem_release(void *mem, void **mem_head);
 
 uint16_t mem_free_count_get(void *mem_head);
+uint16_t mem_free_min_get(void *mem_head);
 void *mem_get(void *mem_pool, uint16_t mem_size, uint16_t index);
 uint16_t mem_index_get(void *mem, void *mem_pool, uint16_t mem_size);
 
@@ -35,6 +35,7 @@
 #include <zephyr/types.h>
 #include <stddef.h>
 
+#include "mem.h"
 #include "memq.h"
 
 /**
@@ -94,6 +95,9 @@ memq_link_t *memq_enqueue(memq_link_t *link, void *mem, memq_link_t **tail)
 	/* Let the old tail element point the the new memory */
 	(*tail)->mem = mem;
 
+	/* Link and payload shall be visible before the new tail */
+	MEM_BARRIER_RELEASE();
+
 	/* Update the tail-pointer to point to the new tail element.
 	 * The new tail-element is not expected to point to anything sensible
 	 */
@@ -117,6 +121,9 @@ memq_link_t *memq_peek(memq_link_t *head, memq_link_t *tail, void **mem)
 		return NULL;
 	}
 
+	/* Read the head element only after having observed the tail */
+	MEM_BARRIER_ACQUIRE();
+
 	/* Extract the head link-element's memory */
 	if (mem) {
 		*mem = head->mem;
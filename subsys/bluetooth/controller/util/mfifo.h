@@ -98,6 +98,9 @@ static inline bool mfifo_enqueue_idx_get(uint8_t count, uint8_t first, uint8_t l
 		return false; /* Queue is full */
 	}
 
+	/* Do not write the buffer before the consumer has released it */
+	MEM_BARRIER_ACQUIRE();
+
 	*idx = last; /* Emit the allocated buffer's index */
 	return true; /* Successfully allocated new buffer */
 }
@@ -123,6 +126,9 @@ static inline void mfifo_by_idx_enqueue(uint8_t *fifo, uint8_t size, uint8_t idx
 	void **p = (void **)(fifo + (*last) * size); /* buffer preceding idx */
 	*p = mem; /* store the payload which for API 2 is only a void-ptr */
 
+	/* Payload shall be visible before the write index */
+	MEM_BARRIER_RELEASE();
+
 	*last = idx; /* Commit: Update write index */
 }
 
@@ -189,6 +195,9 @@ static inline uint8_t mfifo_enqueue_get(uint8_t *fifo, uint8_t size, uint8_t cou
  */
 static inline void mfifo_enqueue(uint8_t idx, uint8_t *last)
 {
+	/* Buffer content shall be visible before the write index */
+	MEM_BARRIER_RELEASE();
+
 	*last = idx; /* Commit: Update write index */
 }
 
@@ -234,6 +243,9 @@ static inline void *mfifo_dequeue_get(uint8_t *fifo, uint8_t size, uint8_t first
 		return NULL;
 	}
 
+	/* Read the buffer only after having observed the write index */
+	MEM_BARRIER_ACQUIRE();
+
 	/* API 1: fifo is array of some value type */
 	return (void *)(fifo + first * size);
 }
@@ -256,6 +268,9 @@ static inline void *mfifo_dequeue_peek(uint8_t *fifo, uint8_t size, uint8_t firs
 		return NULL; /* Queue is empty */
 	}
 
+	/* Read the buffer only after having observed the write index */
+	MEM_BARRIER_ACQUIRE();
+
 	/* API 2: fifo is array of void-ptrs */
 	return *((void **)(fifo + first * size));
 }
@@ -282,6 +297,9 @@ static inline void *mfifo_dequeue_iter_get(uint8_t *fifo, uint8_t size, uint8_t
 		return NULL;
 	}
 
+	/* Read the buffer only after having observed the write index */
+	MEM_BARRIER_ACQUIRE();
+
 	i = *idx + 1;
 	if (i == count) {
 		i = 0U;
@@ -320,6 +338,9 @@ static inline void *mfifo_dequeue(uint8_t *fifo, uint8_t size, uint8_t count,
 		return NULL;
 	}
 
+	/* Read the buffer only after having observed the write index */
+	MEM_BARRIER_ACQUIRE();
+
 	/* Obtain address of head buffer.
 	 * API 2: fifo is array of void-ptrs
 	 */
@@ -331,6 +352,9 @@ static inline void *mfifo_dequeue(uint8_t *fifo, uint8_t size, uint8_t count,
 		_first = 0U;
 	}
 
+	/* Done with the buffer before handing it back to the producer */
+	MEM_BARRIER_RELEASE();
+
 	*first = _first; /* Write back read-index */
 
 	return mem;
@@ -83,6 +83,17 @@ struct bt_a2dp *get_new_connection(struct bt_conn *conn)
 int a2dp_accept(struct bt_conn *conn, struct bt_avdtp **session)
 {
 	struct bt_a2dp *a2dp_conn;
+	int i;
+
+	/* Further channels of a connected session are stream transport
+	 * channels, resolved by AVDTP.
+	 */
+	for (i = 0; i < CONFIG_BT_MAX_CONN; i++) {
+		if (connection[i].session.br_chan.chan.conn == conn) {
+			*session = &connection[i].session;
+			return 0;
+		}
+	}
 
 	a2dp_conn = get_new_connection(conn);
 	if (!a2dp_conn) {
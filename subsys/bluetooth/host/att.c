@@ -110,6 +110,13 @@ K_MEM_SLAB_DEFINE(att_slab, sizeof(struct bt_att),
 		  CONFIG_BT_MAX_CONN, 16);
 K_MEM_SLAB_DEFINE(chan_slab, sizeof(struct bt_att_chan),
 		  CONFIG_BT_MAX_CONN * ATT_CHAN_MAX, 16);
+
+#if defined(CONFIG_BT_EATT_AUTO_CONNECT)
+/* Indexed by connection: a bt_att is freed on disconnection, possibly
+ * while its work is still queued.
+ */
+static struct k_work eatt_work[CONFIG_BT_MAX_CONN];
+#endif /* CONFIG_BT_EATT_AUTO_CONNECT */
 static struct bt_att_req cancel;
 
 static void att_req_destroy(struct bt_att_req *req)
@@ -2705,6 +2712,16 @@ static void bt_att_encrypt_change(struct bt_l2cap_chan *chan,
 		return;
 	}
 
+#if defined(CONFIG_BT_EATT_AUTO_CONNECT)
+	/* Let the central set up the enhanced bearers once the link is
+	 * encrypted, so both sides do not race to connect them.
+	 */
+	if (!atomic_test_bit(att_chan->flags, ATT_ENHANCED) &&
+	    conn->role == BT_HCI_ROLE_MASTER) {
+		k_work_submit(&eatt_work[bt_conn_index(conn)]);
+	}
+#endif /* CONFIG_BT_EATT_AUTO_CONNECT */
+
 	if (!att_chan->req || !att_chan->req->retrying) {
 		return;
 	}
@@ -2800,6 +2817,50 @@ static struct bt_att_chan *att_chan_new(struct bt_att *att, atomic_val_t flags)
 	return chan;
 }
 
+#if defined(CONFIG_BT_EATT_AUTO_CONNECT)
+static void att_eatt_connect_work(struct k_work *work)
+{
+	struct bt_conn *conn = bt_conn_lookup_index(work - eatt_work);
+	struct bt_att_chan *chan;
+	struct bt_att *att;
+	int num_channels = CONFIG_BT_EATT_MAX;
+	int err;
+
+	if (!conn) {
+		return;
+	}
+
+	if (conn->state != BT_CONN_CONNECTED) {
+		goto done;
+	}
+
+	att = att_get(conn);
+	if (!att) {
+		goto done;
+	}
+
+	/* Only connect the bearers that are missing */
+	SYS_SLIST_FOR_EACH_CONTAINER(&att->chans, chan, node) {
+		if (atomic_test_bit(chan->flags, ATT_ENHANCED)) {
+			num_channels--;
+		}
+	}
+
+	if (num_channels <= 0) {
+		goto done;
+	}
+
+	err = bt_eatt_connect(conn, num_channels);
+	if (err < 0) {
+		BT_WARN("Unable to connect %d EATT bearers (err %d)",
+			num_channels, err);
+	}
+
+done:
+	bt_conn_unref(conn);
+}
+#endif /* CONFIG_BT_EATT_AUTO_CONNECT */
+
 static int bt_att_accept(struct bt_conn *conn, struct bt_l2cap_chan **ch)
 {
 	struct bt_att *att;
@@ -2916,6 +2977,14 @@ static void bt_eatt_init(void)
 
 void bt_att_init(void)
 {
+#if defined(CONFIG_BT_EATT_AUTO_CONNECT)
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(eatt_work); i++) {
+		k_work_init(&eatt_work[i], att_eatt_connect_work);
+	}
+#endif /* CONFIG_BT_EATT_AUTO_CONNECT */
+
 	bt_gatt_init();
 
 	if (IS_ENABLED(CONFIG_BT_EATT)) {
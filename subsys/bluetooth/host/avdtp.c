@@ -48,6 +48,20 @@ static struct bt_avdtp_seid_lsep *lseps;
 
 #define AVDTP_TIMEOUT K_SECONDS(6)
 
+#define AVDTP_STREAM_CHAN(_ch) CONTAINER_OF(_ch, struct bt_avdtp_stream, \
+					    chan.chan)
+
+/* RTP header (RFC 3550) preceding each media packet payload */
+#define AVDTP_RTP_VERSION     2
+#define AVDTP_RTP_HDR_LEN     12
+#define AVDTP_RTP_CSRC_LEN    4
+#define AVDTP_RTP_EXT_HDR_LEN 4
+
+#define AVDTP_RTP_GET_VERSION(b0) ((b0) >> 6)
+#define AVDTP_RTP_GET_PADDING(b0) (((b0) >> 5) & 0x01)
+#define AVDTP_RTP_GET_EXT(b0)     (((b0) >> 4) & 0x01)
+#define AVDTP_RTP_GET_CC(b0)      ((b0) & 0x0f)
+
 static const struct {
 	uint8_t sig_id;
 	void (*func)(struct bt_avdtp *session, struct net_buf *buf,
@@ -112,6 +126,113 @@ static void avdtp_timeout(struct k_work *work)
 
 }
 
+/* Media transport channel callbacks */
+static void avdtp_media_connected(struct bt_l2cap_chan *chan)
+{
+	struct bt_avdtp_stream *stream = AVDTP_STREAM_CHAN(chan);
+
+	BT_DBG("chan %p stream %p", chan, stream);
+
+	if (stream->ops && stream->ops->connected) {
+		stream->ops->connected(stream);
+	}
+}
+
+static void avdtp_media_disconnected(struct bt_l2cap_chan *chan)
+{
+	struct bt_avdtp_stream *stream = AVDTP_STREAM_CHAN(chan);
+
+	BT_DBG("chan %p stream %p", chan, stream);
+
+	stream->chan.chan.conn = NULL;
+
+	if (stream->ops && stream->ops->disconnected) {
+		stream->ops->disconnected(stream);
+	}
+}
+
+/* Parse the RTP header in place, so that the payload is handed to the
+ * stream without being copied.
+ */
+static int avdtp_media_recv(struct bt_l2cap_chan *chan, struct net_buf *buf)
+{
+	struct bt_avdtp_stream *stream = AVDTP_STREAM_CHAN(chan);
+	struct bt_avdtp_media_hdr hdr;
+	uint8_t b0, b1, padding;
+	size_t skip;
+
+	if (buf->len < AVDTP_RTP_HDR_LEN) {
+		BT_ERR("Too short media packet (len %u)", buf->len);
+		return 0;
+	}
+
+	b0 = net_buf_pull_u8(buf);
+	b1 = net_buf_pull_u8(buf);
+
+	if (AVDTP_RTP_GET_VERSION(b0) != AVDTP_RTP_VERSION) {
+		BT_WARN("Unsupported RTP version %u",
+			AVDTP_RTP_GET_VERSION(b0));
+		return 0;
+	}
+
+	hdr.marker = b1 >> 7;
+	hdr.payload_type = b1 & 0x7f;
+	hdr.seq = net_buf_pull_be16(buf);
+	hdr.timestamp = net_buf_pull_be32(buf);
+	hdr.ssrc = net_buf_pull_be32(buf);
+
+	skip = AVDTP_RTP_GET_CC(b0) * AVDTP_RTP_CSRC_LEN;
+	if (buf->len < skip) {
+		goto malformed;
+	}
+	net_buf_pull(buf, skip);
+
+	if (AVDTP_RTP_GET_EXT(b0)) {
+		if (buf->len < AVDTP_RTP_EXT_HDR_LEN) {
+			goto malformed;
+		}
+
+		/* Extension length is in 32-bit words, after its header */
+		skip = AVDTP_RTP_EXT_HDR_LEN +
+		       sys_get_be16(&buf->data[2]) * sizeof(uint32_t);
+		if (buf->len < skip) {
+			goto malformed;
+		}
+		net_buf_pull(buf, skip);
+	}
+
+	if (AVDTP_RTP_GET_PADDING(b0)) {
+		if (!buf->len) {
+			goto malformed;
+		}
+
+		padding = buf->data[buf->len - 1];
+		if (!padding || padding > buf->len) {
+			goto malformed;
+		}
+		buf->len -= padding;
+	}
+
+	BT_DBG("stream %p seq %u ts %u len %u", stream, hdr.seq,
+	       hdr.timestamp, buf->len);
+
+	if (stream->ops && stream->ops->recv) {
+		stream->ops->recv(stream, &hdr, buf);
+	}
+
+	return 0;
+
+malformed:
+	BT_ERR("Malformed media packet");
+	return 0;
+}
+
+static const struct bt_l2cap_chan_ops media_ops = {
+	.connected = avdtp_media_connected,
+	.disconnected = avdtp_media_disconnected,
+	.recv = avdtp_media_recv,
+};
+
 /* L2CAP Interface callbacks */
 void bt_avdtp_l2cap_connected(struct bt_l2cap_chan *chan)
 {
@@ -209,6 +330,27 @@ int bt_avdtp_connect(struct bt_conn *conn, struct bt_avdtp *session)
 				     BT_L2CAP_PSM_AVDTP);
 }
 
+int bt_avdtp_stream_connect(struct bt_avdtp *session,
+			    struct bt_avdtp_stream *stream)
+{
+	if (!session || !stream) {
+		return -EINVAL;
+	}
+
+	if (!session->br_chan.chan.conn) {
+		return -ENOTCONN;
+	}
+
+	BT_DBG("session %p stream %p", session, stream);
+
+	stream->chan.chan.ops = &media_ops;
+	stream->chan.rx.mtu = BT_AVDTP_MAX_MTU;
+	stream->chan.chan.required_sec_level = BT_SECURITY_L2;
+
+	return bt_l2cap_chan_connect(session->br_chan.chan.conn,
+				     &stream->chan.chan, BT_L2CAP_PSM_AVDTP);
+}
+
 int bt_avdtp_disconnect(struct bt_avdtp *session)
 {
 	if (!session) {
@@ -236,6 +378,30 @@ int bt_avdtp_l2cap_accept(struct bt_conn *conn, struct bt_l2cap_chan **chan)
 	if (result < 0) {
 		return result;
 	}
+
+	/* Once signaling is up, further channels are stream transport
+	 * channels, opened in the order the streams were opened.
+	 */
+	if (session->br_chan.chan.conn == conn) {
+		struct bt_avdtp_stream *stream;
+
+		for (stream = session->streams; stream; stream = stream->next) {
+			if (!stream->chan.chan.conn) {
+				break;
+			}
+		}
+
+		if (!stream) {
+			BT_WARN("No stream awaiting a transport channel");
+			return -ENOMEM;
+		}
+
+		stream->chan.chan.ops = &media_ops;
+		stream->chan.rx.mtu = BT_AVDTP_MAX_MTU;
+		*chan = &stream->chan.chan;
+		return 0;
+	}
+
 	session->br_chan.chan.ops = &ops;
 	session->br_chan.rx.mtu = BT_AVDTP_MAX_MTU;
 	*chan = &session->br_chan.chan;
@@ -168,3 +168,7 @@ int bt_avdtp_register_sep(uint8_t media_type, uint8_t role,
 /* AVDTP Discover Request */
 int bt_avdtp_discover(struct bt_avdtp *session,
 		      struct bt_avdtp_discover_params *param);
+
+/* AVDTP stream transport channel connect, once the stream is opened */
+int bt_avdtp_stream_connect(struct bt_avdtp *session,
+			    struct bt_avdtp_stream *stream);
@@ -897,6 +897,11 @@ void bt_conn_recv(struct bt_conn *conn, struct net_buf *buf, uint8_t flags)
 
 	BT_DBG("handle %u len %u flags %02x", conn->handle, buf->len, flags);
 
+#if defined(CONFIG_BT_CONN_STATS)
+	conn->stats.rx_bytes += buf->len;
+	conn->stats.rx_packets++;
+#endif /* CONFIG_BT_CONN_STATS */
+
 	/* Check packet boundary flags */
 	switch (flags) {
 	case BT_ACL_START:
@@ -1053,6 +1058,7 @@ static bool send_frag(struct bt_conn *conn, struct net_buf *buf, uint8_t flags,
 	struct bt_hci_acl_hdr *hdr;
 	uint32_t *pending_no_cb;
 	unsigned int key;
+	uint16_t len;
 	int err;
 
 	BT_DBG("conn %p buf %p len %u flags 0x%02x", conn, buf, buf->len,
@@ -1066,9 +1072,11 @@ static bool send_frag(struct bt_conn *conn, struct net_buf *buf, uint8_t flags,
 		goto fail;
 	}
 
+	len = buf->len;
+
 	hdr = net_buf_push(buf, sizeof(*hdr));
 	hdr->handle = sys_cpu_to_le16(bt_acl_handle_pack(conn->handle, flags));
-	hdr->len = sys_cpu_to_le16(buf->len - sizeof(*hdr));
+	hdr->len = sys_cpu_to_le16(len);
 
 	/* Add to pending, it must be done before bt_buf_set_type */
 	key = irq_lock();
@@ -1105,6 +1113,11 @@ static bool send_frag(struct bt_conn *conn, struct net_buf *buf, uint8_t flags,
 		goto fail;
 	}
 
+#if defined(CONFIG_BT_CONN_STATS)
+	conn->stats.tx_bytes += len;
+	conn->stats.tx_packets++;
+#endif /* CONFIG_BT_CONN_STATS */
+
 	return true;
 
 fail:
@@ -1714,6 +1727,17 @@ int bt_conn_get_info(const struct bt_conn *conn, struct bt_conn_info *info)
 	return -EINVAL;
 }
 
+int bt_conn_get_stats(const struct bt_conn *conn, struct bt_conn_stats *stats)
+{
+#if defined(CONFIG_BT_CONN_STATS)
+	*stats = conn->stats;
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif /* CONFIG_BT_CONN_STATS */
+}
+
 int bt_conn_get_remote_info(struct bt_conn *conn,
 			    struct bt_conn_remote_info *remote_info)
 {
@@ -147,6 +147,10 @@ struct bt_conn {
 	/* Queue for outgoing ACL data */
 	struct k_fifo		tx_queue;
 
+#if defined(CONFIG_BT_CONN_STATS)
+	struct bt_conn_stats	stats;
+#endif /* CONFIG_BT_CONN_STATS */
+
 	/* Active L2CAP channels */
 	sys_slist_t		channels;
 
@@ -58,6 +58,17 @@ struct ccc_store {
 	uint16_t value;
 };
 
+#if defined(CONFIG_BT_SETTINGS_GATT_AGGREGATE)
+/* Set when per-subsystem items were loaded, they are then deleted once the
+ * peer has been stored in the aggregated format.
+ */
+static bool gatt_legacy_found;
+
+static int gatt_store_peer(uint8_t id, const bt_addr_le_t *addr,
+			   bool ccc_loaded);
+static void gatt_load_ccc(uint8_t id, const bt_addr_le_t *addr);
+#endif /* CONFIG_BT_SETTINGS_GATT_AGGREGATE */
+
 struct gatt_sub {
 	uint8_t id;
 	bt_addr_le_t peer;
@@ -80,6 +91,239 @@ static sys_slist_t db;
 
 static atomic_t init;
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+/* Service of the local database, the index is sorted by handle */
+struct gatt_svc_entry {
+	const struct bt_gatt_attr *attrs;
+	uint16_t attr_count;
+	uint16_t start_handle;
+	uint16_t end_handle;
+	/* Static attributes have no handle, it follows from their position */
+	bool is_static;
+};
+
+/* Attribute with a 16-bit UUID, the index is sorted by UUID and handle */
+struct gatt_uuid_entry {
+	uint16_t uuid;
+	uint16_t handle;
+};
+
+static struct gatt_svc_entry svc_index[CONFIG_BT_GATT_ATTR_INDEX_SVC_MAX];
+static uint16_t svc_index_count;
+static struct gatt_uuid_entry uuid_index[CONFIG_BT_GATT_ATTR_INDEX_UUID_MAX];
+static uint16_t uuid_index_count;
+
+/* Set when an index ran out of entries, lookups then scan the database */
+static bool svc_index_overflow;
+static bool uuid_index_overflow;
+
+static bool gatt_uuid16(const struct bt_uuid *uuid, uint16_t *val)
+{
+	struct bt_uuid_16 u16;
+
+	switch (uuid->type) {
+	case BT_UUID_TYPE_16:
+		*val = BT_UUID_16(uuid)->val;
+		return true;
+	case BT_UUID_TYPE_32:
+		if (BT_UUID_32(uuid)->val > UINT16_MAX) {
+			return false;
+		}
+
+		*val = BT_UUID_32(uuid)->val;
+		return true;
+	case BT_UUID_TYPE_128:
+		/* Only UUIDs derived from the Base UUID have a short form */
+		u16.uuid.type = BT_UUID_TYPE_16;
+		u16.val = sys_get_le16(&BT_UUID_128(uuid)->val[12]);
+		if (bt_uuid_cmp(&u16.uuid, uuid)) {
+			return false;
+		}
+
+		*val = u16.val;
+		return true;
+	}
+
+	return false;
+}
+
+/* Position of the first service ending at or after handle */
+static size_t svc_index_lookup(uint16_t handle)
+{
+	size_t lo = 0, hi = svc_index_count;
+
+	while (lo < hi) {
+		size_t mid = (lo + hi) / 2U;
+
+		if (svc_index[mid].end_handle < handle) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+/* Position of the first attribute not sorting before uuid/handle */
+static size_t uuid_index_lookup(uint16_t uuid, uint16_t handle)
+{
+	size_t lo = 0, hi = uuid_index_count;
+
+	while (lo < hi) {
+		size_t mid = (lo + hi) / 2U;
+
+		if (uuid_index[mid].uuid < uuid ||
+		    (uuid_index[mid].uuid == uuid &&
+		     uuid_index[mid].handle < handle)) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+static void uuid_index_add(const struct bt_gatt_attr *attr, uint16_t handle)
+{
+	uint16_t uuid;
+	size_t pos;
+
+	if (!gatt_uuid16(attr->uuid, &uuid)) {
+		return;
+	}
+
+	if (uuid_index_count == ARRAY_SIZE(uuid_index)) {
+		if (!uuid_index_overflow) {
+			BT_WARN("UUID index full, increase "
+				"CONFIG_BT_GATT_ATTR_INDEX_UUID_MAX");
+			uuid_index_overflow = true;
+		}
+		return;
+	}
+
+	pos = uuid_index_lookup(uuid, handle);
+	memmove(&uuid_index[pos + 1], &uuid_index[pos],
+		(uuid_index_count - pos) * sizeof(uuid_index[0]));
+	uuid_index[pos].uuid = uuid;
+	uuid_index[pos].handle = handle;
+	uuid_index_count++;
+}
+
+static void gatt_index_add(const struct bt_gatt_attr *attrs, uint16_t count,
+			   uint16_t start_handle, bool is_static)
+{
+	struct gatt_svc_entry *entry;
+	size_t pos;
+
+	if (svc_index_count == ARRAY_SIZE(svc_index)) {
+		if (!svc_index_overflow) {
+			BT_WARN("Service index full, increase "
+				"CONFIG_BT_GATT_ATTR_INDEX_SVC_MAX");
+			svc_index_overflow = true;
+		}
+		return;
+	}
+
+	pos = svc_index_lookup(start_handle);
+	memmove(&svc_index[pos + 1], &svc_index[pos],
+		(svc_index_count - pos) * sizeof(svc_index[0]));
+	svc_index_count++;
+
+	entry = &svc_index[pos];
+	entry->attrs = attrs;
+	entry->attr_count = count;
+	entry->start_handle = start_handle;
+	entry->is_static = is_static;
+
+	if (is_static) {
+		entry->end_handle = start_handle + count - 1;
+	} else {
+		entry->end_handle = attrs[count - 1].handle;
+	}
+
+	for (uint16_t i = 0; i < count; i++) {
+		uuid_index_add(&attrs[i], is_static ? start_handle + i :
+			       attrs[i].handle);
+	}
+}
+
+static void gatt_index_remove(uint16_t start_handle, uint16_t end_handle)
+{
+	size_t pos, i;
+
+	pos = svc_index_lookup(start_handle);
+	if (pos < svc_index_count &&
+	    svc_index[pos].start_handle == start_handle) {
+		svc_index_count--;
+		memmove(&svc_index[pos], &svc_index[pos + 1],
+			(svc_index_count - pos) * sizeof(svc_index[0]));
+	}
+
+	for (i = 0, pos = 0; i < uuid_index_count; i++) {
+		if (uuid_index[i].handle >= start_handle &&
+		    uuid_index[i].handle <= end_handle) {
+			continue;
+		}
+
+		uuid_index[pos++] = uuid_index[i];
+	}
+
+	uuid_index_count = pos;
+}
+
+static void gatt_index_build(void)
+{
+#if defined(CONFIG_BT_GATT_DYNAMIC_DB)
+	struct bt_gatt_service *svc;
+#endif /* CONFIG_BT_GATT_DYNAMIC_DB */
+	uint16_t handle = 1;
+
+	svc_index_count = 0;
+	uuid_index_count = 0;
+	svc_index_overflow = false;
+	uuid_index_overflow = false;
+
+	Z_STRUCT_SECTION_FOREACH(bt_gatt_service_static, static_svc) {
+		if (!static_svc->attr_count) {
+			continue;
+		}
+
+		gatt_index_add(static_svc->attrs, static_svc->attr_count,
+			       handle, true);
+		handle += static_svc->attr_count;
+	}
+
+#if defined(CONFIG_BT_GATT_DYNAMIC_DB)
+	SYS_SLIST_FOR_EACH_CONTAINER(&db, svc, node) {
+		gatt_index_add(svc->attrs, svc->attr_count,
+			       svc->attrs[0].handle, false);
+	}
+#endif /* CONFIG_BT_GATT_DYNAMIC_DB */
+}
+
+static bool gatt_index_ready(void)
+{
+	return atomic_get(&init) && !svc_index_overflow;
+}
+
+/* Handle of a static attribute, searched service by service */
+static uint16_t gatt_index_static_handle(const struct bt_gatt_attr *attr)
+{
+	for (size_t i = 0; i < svc_index_count; i++) {
+		const struct gatt_svc_entry *entry = &svc_index[i];
+
+		if (entry->is_static && attr >= entry->attrs &&
+		    attr < &entry->attrs[entry->attr_count]) {
+			return entry->start_handle + (attr - entry->attrs);
+		}
+	}
+
+	return 0;
+}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 static ssize_t read_name(struct bt_conn *conn, const struct bt_gatt_attr *attr,
 			 void *buf, uint16_t len, uint16_t offset)
 {
@@ -230,6 +474,12 @@ static void sc_store(struct gatt_sc_cfg *cfg)
 	char key[BT_SETTINGS_KEY_MAX];
 	int err;
 
+#if defined(CONFIG_BT_SETTINGS_GATT_AGGREGATE)
+	/* The peer may not be connected, so its CCCs may not be loaded */
+	(void)gatt_store_peer(cfg->id, &cfg->peer, false);
+	return;
+#endif
+
 	if (cfg->id) {
 		char id_str[4];
 
@@ -267,7 +517,8 @@ static int bt_gatt_clear_sc(uint8_t id, const bt_addr_le_t *addr)
 		return 0;
 	}
 
-	if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
+	if (IS_ENABLED(CONFIG_BT_SETTINGS) &&
+	    !IS_ENABLED(CONFIG_BT_SETTINGS_GATT_AGGREGATE)) {
 		char key[BT_SETTINGS_KEY_MAX];
 		int err;
 
@@ -306,6 +557,10 @@ static void sc_clear(struct bt_conn *conn)
 		if (err) {
 			BT_ERR("Failed to clear SC %d", err);
 		}
+
+#if defined(CONFIG_BT_SETTINGS_GATT_AGGREGATE)
+		(void)gatt_store_peer(conn->id, &conn->le.dst, true);
+#endif
 	} else {
 		struct gatt_sc_cfg *cfg;
 
@@ -866,6 +1121,11 @@ populate:
 
 	gatt_insert(svc, last_handle);
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	gatt_index_add(svc->attrs, svc->attr_count, svc->attrs[0].handle,
+		       false);
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 	return 0;
 }
 #endif /* CONFIG_BT_GATT_DYNAMIC_DB */
@@ -1031,6 +1291,10 @@ void bt_gatt_init(void)
 		last_static_handle += svc->attr_count;
 	}
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	gatt_index_build();
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 #if defined(CONFIG_BT_GATT_CACHING)
 	k_delayed_work_init(&db_hash_work, db_hash_process);
 
@@ -1153,6 +1417,16 @@ static int gatt_unregister(struct bt_gatt_service *svc)
 		return -ENOENT;
 	}
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	if (svc_index_overflow || uuid_index_overflow) {
+		/* Services left out may fit now */
+		gatt_index_build();
+	} else {
+		gatt_index_remove(svc->attrs[0].handle,
+				  svc->attrs[svc->attr_count - 1].handle);
+	}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 	for (uint16_t i = 0; i < svc->attr_count; i++) {
 		struct bt_gatt_attr *attr = &svc->attrs[i];
 
@@ -1277,6 +1551,12 @@ static uint16_t find_static_attr(const struct bt_gatt_attr *attr)
 {
 	uint16_t handle = 1;
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	if (gatt_index_ready()) {
+		return gatt_index_static_handle(attr);
+	}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 	Z_STRUCT_SECTION_FOREACH(bt_gatt_service_static, static_svc) {
 		for (size_t i = 0; i < static_svc->attr_count; i++, handle++) {
 			if (attr == &static_svc->attrs[i]) {
@@ -1452,6 +1732,106 @@ static void foreach_attr_type_dyndb(uint16_t start_handle, uint16_t end_handle,
 #endif /* CONFIG_BT_GATT_DYNAMIC_DB */
 }
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+static uint8_t gatt_index_iter(const struct gatt_svc_entry *entry, size_t i,
+			       uint16_t start_handle, uint16_t end_handle,
+			       const struct bt_uuid *uuid,
+			       const void *attr_data, uint16_t *num_matches,
+			       bt_gatt_attr_func_t func, void *user_data)
+{
+	struct bt_gatt_attr attr;
+
+	if (!entry->is_static) {
+		return gatt_foreach_iter(&entry->attrs[i], start_handle,
+					 end_handle, uuid, attr_data,
+					 num_matches, func, user_data);
+	}
+
+	memcpy(&attr, &entry->attrs[i], sizeof(attr));
+
+	attr.handle = entry->start_handle + i;
+
+	return gatt_foreach_iter(&attr, start_handle, end_handle, uuid,
+				 attr_data, num_matches, func, user_data);
+}
+
+static void foreach_attr_type_uuid_index(uint16_t start_handle,
+					 uint16_t end_handle,
+					 const struct bt_uuid *uuid,
+					 uint16_t uuid16,
+					 const void *attr_data,
+					 uint16_t num_matches,
+					 bt_gatt_attr_func_t func,
+					 void *user_data)
+{
+	size_t pos, i;
+
+	for (pos = uuid_index_lookup(uuid16, start_handle);
+	     pos < uuid_index_count; pos++) {
+		const struct gatt_uuid_entry *match = &uuid_index[pos];
+		const struct gatt_svc_entry *entry;
+
+		if (match->uuid != uuid16 || match->handle > end_handle) {
+			return;
+		}
+
+		entry = &svc_index[svc_index_lookup(match->handle)];
+
+		if (entry->is_static) {
+			i = match->handle - entry->start_handle;
+		} else {
+			for (i = 0; i < entry->attr_count; i++) {
+				if (entry->attrs[i].handle == match->handle) {
+					break;
+				}
+			}
+		}
+
+		if (i == entry->attr_count) {
+			continue;
+		}
+
+		if (gatt_index_iter(entry, i, start_handle, end_handle, uuid,
+				    attr_data, &num_matches, func,
+				    user_data) == BT_GATT_ITER_STOP) {
+			return;
+		}
+	}
+}
+
+static void foreach_attr_type_svc_index(uint16_t start_handle,
+					uint16_t end_handle,
+					const struct bt_uuid *uuid,
+					const void *attr_data,
+					uint16_t num_matches,
+					bt_gatt_attr_func_t func,
+					void *user_data)
+{
+	size_t pos, i;
+
+	for (pos = svc_index_lookup(start_handle); pos < svc_index_count;
+	     pos++) {
+		const struct gatt_svc_entry *entry = &svc_index[pos];
+
+		i = 0;
+
+		/* Static handles are contiguous, start at the first one */
+		if (entry->is_static && start_handle > entry->start_handle) {
+			i = start_handle - entry->start_handle;
+		}
+
+		for (; i < entry->attr_count; i++) {
+			if (gatt_index_iter(entry, i, start_handle,
+					    end_handle, uuid, attr_data,
+					    &num_matches, func, user_data) ==
+			    BT_GATT_ITER_STOP) {
+				return;
+			}
+		}
+	}
+}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 void bt_gatt_foreach_attr_type(uint16_t start_handle, uint16_t end_handle,
 			       const struct bt_uuid *uuid,
 			       const void *attr_data, uint16_t num_matches,
@@ -1463,6 +1843,27 @@ void bt_gatt_foreach_attr_type(uint16_t start_handle, uint16_t end_handle,
 		num_matches = UINT16_MAX;
 	}
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	if (gatt_index_ready()) {
+		uint16_t uuid16;
+
+		if (uuid && !uuid_index_overflow &&
+		    gatt_uuid16(uuid, &uuid16)) {
+			foreach_attr_type_uuid_index(start_handle, end_handle,
+						     uuid, uuid16, attr_data,
+						     num_matches, func,
+						     user_data);
+		} else {
+			foreach_attr_type_svc_index(start_handle, end_handle,
+						    uuid, attr_data,
+						    num_matches, func,
+						    user_data);
+		}
+
+		return;
+	}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 	if (start_handle <= last_static_handle) {
 		uint16_t handle = 1;
 
@@ -1818,11 +2219,15 @@ static int gatt_notify(struct bt_conn *conn, uint16_t handle,
 #endif
 
 #if defined(CONFIG_BT_GATT_NOTIFY_MULTIPLE)
+	/* Peers which enabled Multiple Handle Value Notifications get the
+	 * value batched with others queued for them, a single notification
+	 * is only sent when no batch buffer could be allocated.
+	 */
 	if (gatt_cf_notify_multi(conn)) {
 		int err;
 
 		err = gatt_notify_mult(conn, handle, params);
-		if (err && err != -ENOMEM) {
+		if (err != -ENOMEM) {
 			return err;
 		}
 	}
@@ -4311,6 +4716,10 @@ static int ccc_set(const char *name, size_t len_rd, settings_read_cb read_cb,
 			load.entry = ccc_store;
 			load.count = len / sizeof(*ccc_store);
 
+#if defined(CONFIG_BT_SETTINGS_GATT_AGGREGATE)
+			gatt_legacy_found = true;
+#endif
+
 			for (size_t i = 0; i < load.count; i++) {
 				BT_DBG("Read CCC: handle 0x%04x value 0x%04x",
 				       ccc_store[i].handle, ccc_store[i].value);
@@ -4380,6 +4789,10 @@ void bt_gatt_connected(struct bt_conn *conn)
 		}
 
 		settings_load_subtree_direct(key, ccc_set_direct, (void *)key);
+
+#if defined(CONFIG_BT_SETTINGS_GATT_AGGREGATE)
+		gatt_load_ccc(conn->id, &conn->le.dst);
+#endif
 	}
 
 	bt_gatt_foreach_attr(0x0001, 0xffff, update_ccc, &data);
@@ -4475,6 +4888,11 @@ static int bt_gatt_store_cf(struct bt_conn *conn)
 	size_t len;
 	int err;
 
+#if defined(CONFIG_BT_SETTINGS_GATT_AGGREGATE)
+	/* Stored along with the CCCs by bt_gatt_store_ccc() */
+	return 0;
+#endif
+
 	cfg = find_cf_cfg(conn);
 	if (!cfg) {
 		/* No cfg found, just clear it */
@@ -4560,7 +4978,7 @@ static struct gatt_cf_cfg *find_cf_cfg_by_addr(uint8_t id,
 
 struct ccc_save {
 	struct addr_with_id addr_with_id;
-	struct ccc_store store[CCC_STORE_MAX];
+	struct ccc_store *store;
 	size_t count;
 };
 
@@ -4595,14 +5013,20 @@ static uint8_t ccc_save(const struct bt_gatt_attr *attr, void *user_data)
 
 int bt_gatt_store_ccc(uint8_t id, const bt_addr_le_t *addr)
 {
+	struct ccc_store store[CCC_STORE_MAX];
 	struct ccc_save save;
 	char key[BT_SETTINGS_KEY_MAX];
 	size_t len;
 	char *str;
 	int err;
 
+#if defined(CONFIG_BT_SETTINGS_GATT_AGGREGATE)
+	return gatt_store_peer(id, addr, true);
+#endif
+
 	save.addr_with_id.addr = addr;
 	save.addr_with_id.id = id;
+	save.store = store;
 	save.count = 0;
 
 	bt_gatt_foreach_attr(0x0001, 0xffff, ccc_save, &save);
@@ -4697,6 +5121,10 @@ static int sc_set(const char *name, size_t len_rd, settings_read_cb read_cb,
 
 		BT_DBG("Read SC: len %zd", len);
 
+#if defined(CONFIG_BT_SETTINGS_GATT_AGGREGATE)
+		gatt_legacy_found = true;
+#endif
+
 		BT_DBG("Restored SC for %s", bt_addr_le_str(&addr));
 	} else if (cfg) {
 		/* Clear configuration */
@@ -4773,6 +5201,10 @@ static int cf_set(const char *name, size_t len_rd, settings_read_cb read_cb,
 		}
 
 		BT_DBG("Read CF: len %zd", len);
+
+#if defined(CONFIG_BT_SETTINGS_GATT_AGGREGATE)
+		gatt_legacy_found = true;
+#endif
 	} else {
 		clear_cf_cfg(cfg);
 	}
@@ -4840,6 +5272,350 @@ static int db_hash_commit(void)
 SETTINGS_STATIC_HANDLER_DEFINE(bt_hash, "bt/hash", NULL, db_hash_set,
 			       db_hash_commit, NULL);
 #endif /*CONFIG_BT_GATT_CACHING */
+
+#if defined(CONFIG_BT_SETTINGS_GATT_AGGREGATE)
+#define GATT_STORE_VERSION	1
+
+#define GATT_STORE_SC		BIT(0)
+#define GATT_STORE_CF		BIT(1)
+
+/* Persistent storage format for all GATT server state of a peer: a fixed
+ * header followed by the CCC entries up to the end of the item.
+ */
+struct gatt_store_hdr {
+	uint8_t version;
+	uint8_t flags;
+	uint8_t cf;
+	uint8_t rfu;
+	struct sc_data sc;
+};
+
+struct gatt_store {
+	struct gatt_store_hdr hdr;
+	struct ccc_store ccc[CCC_STORE_MAX];
+};
+
+BUILD_ASSERT(offsetof(struct gatt_store, ccc) ==
+	     sizeof(struct gatt_store_hdr));
+BUILD_ASSERT(sizeof(((struct gatt_cf_cfg *)0)->data) ==
+	     sizeof(((struct gatt_store_hdr *)0)->cf));
+
+struct gatt_store_read {
+	struct gatt_store *store;
+	size_t count;
+};
+
+static void gatt_settings_key(char *key, size_t key_size, const char *subsys,
+			      uint8_t id, const bt_addr_le_t *addr)
+{
+	if (id) {
+		char id_str[4];
+
+		u8_to_dec(id_str, sizeof(id_str), id);
+		bt_settings_encode_key(key, key_size, subsys, addr, id_str);
+	} else {
+		bt_settings_encode_key(key, key_size, subsys, addr, NULL);
+	}
+}
+
+static ssize_t gatt_store_decode(struct gatt_store *store, size_t len_rd,
+				 settings_read_cb read_cb, void *cb_arg)
+{
+	ssize_t len;
+
+	if (!len_rd) {
+		(void)memset(&store->hdr, 0, sizeof(store->hdr));
+		return 0;
+	}
+
+	len = read_cb(cb_arg, store, sizeof(*store));
+	if (len < 0) {
+		BT_ERR("Failed to decode value (err %zd)", len);
+		return len;
+	}
+
+	if (len < sizeof(store->hdr) ||
+	    store->hdr.version != GATT_STORE_VERSION) {
+		BT_WARN("Unsupported GATT settings format");
+		return -EINVAL;
+	}
+
+	return (len - sizeof(store->hdr)) / sizeof(store->ccc[0]);
+}
+
+static void gatt_delete_legacy(uint8_t id, const bt_addr_le_t *addr)
+{
+	static const char * const subsys[] = { "ccc", "sc", "cf" };
+	char key[BT_SETTINGS_KEY_MAX];
+
+	for (size_t i = 0; i < ARRAY_SIZE(subsys); i++) {
+		gatt_settings_key(key, sizeof(key), subsys[i], id, addr);
+		(void)settings_delete(key);
+	}
+}
+
+static int gatt_delete_peer(uint8_t id, const bt_addr_le_t *addr)
+{
+	char key[BT_SETTINGS_KEY_MAX];
+
+	gatt_delete_legacy(id, addr);
+
+	gatt_settings_key(key, sizeof(key), "gatt", id, addr);
+
+	return settings_delete(key);
+}
+
+static int gatt_store_read_direct(const char *key, size_t len,
+				  settings_read_cb read_cb, void *cb_arg,
+				  void *param)
+{
+	struct gatt_store_read *read = param;
+	ssize_t count;
+
+	/* Items of the other identities of the peer live below the key */
+	if (key) {
+		return 0;
+	}
+
+	count = gatt_store_decode(read->store, len, read_cb, cb_arg);
+	read->count = MAX(count, 0);
+
+	return 0;
+}
+
+static int gatt_store_peer(uint8_t id, const bt_addr_le_t *addr,
+			   bool ccc_loaded)
+{
+	struct gatt_store store;
+	struct gatt_cf_cfg *cf;
+	char key[BT_SETTINGS_KEY_MAX];
+	size_t len;
+	int err;
+
+	gatt_settings_key(key, sizeof(key), "gatt", id, addr);
+
+	if (IS_ENABLED(CONFIG_BT_SETTINGS_CCC_LAZY_LOADING) && !ccc_loaded) {
+		struct gatt_store_read read = {
+			.store = &store,
+		};
+
+		/* CCCs are only loaded once the peer connects, keep the
+		 * stored ones.
+		 */
+		settings_load_subtree_direct(key, gatt_store_read_direct,
+					     &read);
+		len = read.count;
+	} else {
+		struct ccc_save save = {
+			.addr_with_id.addr = addr,
+			.addr_with_id.id = id,
+			.store = store.ccc,
+		};
+
+		bt_gatt_foreach_attr(0x0001, 0xffff, ccc_save, &save);
+		len = save.count;
+	}
+
+	(void)memset(&store.hdr, 0, sizeof(store.hdr));
+	store.hdr.version = GATT_STORE_VERSION;
+
+	if (IS_ENABLED(CONFIG_BT_GATT_SERVICE_CHANGED)) {
+		struct gatt_sc_cfg *sc;
+
+		sc = find_sc_cfg(id, (bt_addr_le_t *)addr);
+		if (sc) {
+			store.hdr.flags |= GATT_STORE_SC;
+			store.hdr.sc.start = sc->data.start;
+			store.hdr.sc.end = sc->data.end;
+		}
+	}
+
+	cf = find_cf_cfg_by_addr(id, addr);
+	if (cf) {
+		store.hdr.flags |= GATT_STORE_CF;
+		store.hdr.cf = cf->data[0];
+	}
+
+	if (!store.hdr.flags && !len) {
+		/* Nothing to store, just clear */
+		err = settings_delete(key);
+	} else {
+		len = sizeof(store.hdr) + len * sizeof(store.ccc[0]);
+		err = settings_save_one(key, &store, len);
+	}
+
+	if (err) {
+		BT_ERR("Failed to store GATT settings (err %d)", err);
+		return err;
+	}
+
+	BT_DBG("Stored GATT settings for %s (%s)", bt_addr_le_str(addr),
+	       log_strdup(key));
+
+	if (gatt_legacy_found) {
+		gatt_delete_legacy(id, addr);
+	}
+
+	return 0;
+}
+
+static void gatt_load_sc(uint8_t id, const bt_addr_le_t *addr,
+			 const struct gatt_store_hdr *hdr)
+{
+#if defined(CONFIG_BT_GATT_SERVICE_CHANGED)
+	struct gatt_sc_cfg *cfg;
+
+	cfg = find_sc_cfg(id, (bt_addr_le_t *)addr);
+	if (!(hdr->flags & GATT_STORE_SC)) {
+		if (cfg) {
+			clear_sc_cfg(cfg);
+		}
+
+		return;
+	}
+
+	if (!cfg) {
+		cfg = find_sc_cfg(BT_ID_DEFAULT, BT_ADDR_LE_ANY);
+		if (!cfg) {
+			BT_ERR("Unable to restore SC: no cfg left");
+			return;
+		}
+
+		cfg->id = id;
+		bt_addr_le_copy(&cfg->peer, addr);
+	}
+
+	cfg->data.start = hdr->sc.start;
+	cfg->data.end = hdr->sc.end;
+#endif /* CONFIG_BT_GATT_SERVICE_CHANGED */
+}
+
+static void gatt_load_cf(uint8_t id, const bt_addr_le_t *addr,
+			 const struct gatt_store_hdr *hdr)
+{
+#if defined(CONFIG_BT_GATT_CACHING)
+	struct gatt_cf_cfg *cfg;
+
+	cfg = find_cf_cfg_by_addr(id, addr);
+	if (!(hdr->flags & GATT_STORE_CF)) {
+		if (cfg) {
+			clear_cf_cfg(cfg);
+		}
+
+		return;
+	}
+
+	if (!cfg) {
+		cfg = find_cf_cfg(NULL);
+		if (!cfg) {
+			BT_ERR("Unable to restore CF: no cfg left");
+			return;
+		}
+
+		cfg->id = id;
+		bt_addr_le_copy(&cfg->peer, addr);
+	}
+
+	cfg->data[0] = hdr->cf;
+#endif /* CONFIG_BT_GATT_CACHING */
+}
+
+static int gatt_load_peer(uint8_t id, const bt_addr_le_t *addr,
+			  size_t len_rd, settings_read_cb read_cb,
+			  void *cb_arg, bool ccc_only)
+{
+	struct gatt_store store;
+	struct ccc_load load;
+	ssize_t count;
+
+	count = gatt_store_decode(&store, len_rd, read_cb, cb_arg);
+	if (count < 0) {
+		return count;
+	}
+
+	if (!ccc_only) {
+		gatt_load_sc(id, addr, &store.hdr);
+		gatt_load_cf(id, addr, &store.hdr);
+
+		/* CCCs are loaded once the peer connects */
+		if (IS_ENABLED(CONFIG_BT_SETTINGS_CCC_LAZY_LOADING)) {
+			return 0;
+		}
+	}
+
+	load.addr_with_id.addr = addr;
+	load.addr_with_id.id = id;
+	load.entry = len_rd ? store.ccc : NULL;
+	load.count = count;
+
+	bt_gatt_foreach_attr(0x0001, 0xffff, ccc_load, &load);
+
+	BT_DBG("Restored GATT settings for id:%" PRIu8 " addr:%s", id,
+	       bt_addr_le_str(addr));
+
+	return 0;
+}
+
+static int gatt_set(const char *name, size_t len_rd, settings_read_cb read_cb,
+		    void *cb_arg)
+{
+	bt_addr_le_t addr;
+	const char *next;
+	uint8_t id;
+	int err;
+
+	if (!name) {
+		BT_ERR("Insufficient number of arguments");
+		return -EINVAL;
+	}
+
+	err = bt_settings_decode_key(name, &addr);
+	if (err) {
+		BT_ERR("Unable to decode address %s", log_strdup(name));
+		return -EINVAL;
+	}
+
+	settings_name_next(name, &next);
+
+	if (!next) {
+		id = BT_ID_DEFAULT;
+	} else {
+		id = strtol(next, NULL, 10);
+	}
+
+	return gatt_load_peer(id, &addr, len_rd, read_cb, cb_arg, false);
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(bt_gatt, "bt/gatt", NULL, gatt_set, NULL,
+			       NULL);
+
+static int gatt_set_direct(const char *key, size_t len,
+			   settings_read_cb read_cb, void *cb_arg, void *param)
+{
+	const struct addr_with_id *addr_with_id = param;
+
+	/* Items of the other identities of the peer live below the key */
+	if (key) {
+		return 0;
+	}
+
+	return gatt_load_peer(addr_with_id->id, addr_with_id->addr, len,
+			      read_cb, cb_arg, true);
+}
+
+static void gatt_load_ccc(uint8_t id, const bt_addr_le_t *addr)
+{
+	struct addr_with_id addr_with_id = {
+		.addr = addr,
+		.id = id,
+	};
+	char key[BT_SETTINGS_KEY_MAX];
+
+	gatt_settings_key(key, sizeof(key), "gatt", id, addr);
+
+	settings_load_subtree_direct(key, gatt_set_direct, &addr_with_id);
+}
+#endif /* CONFIG_BT_SETTINGS_GATT_AGGREGATE */
 #endif /* CONFIG_BT_SETTINGS */
 
 static uint8_t remove_peer_from_attr(const struct bt_gatt_attr *attr,
@@ -4875,7 +5651,8 @@ static int bt_gatt_clear_ccc(uint8_t id, const bt_addr_le_t *addr)
 	bt_gatt_foreach_attr(0x0001, 0xffff, remove_peer_from_attr,
 			     &addr_with_id);
 
-	if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
+	if (IS_ENABLED(CONFIG_BT_SETTINGS) &&
+	    !IS_ENABLED(CONFIG_BT_SETTINGS_GATT_AGGREGATE)) {
 		char key[BT_SETTINGS_KEY_MAX];
 
 		if (id) {
@@ -4904,7 +5681,8 @@ static int bt_gatt_clear_cf(uint8_t id, const bt_addr_le_t *addr)
 		clear_cf_cfg(cfg);
 	}
 
-	if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
+	if (IS_ENABLED(CONFIG_BT_SETTINGS) &&
+	    !IS_ENABLED(CONFIG_BT_SETTINGS_GATT_AGGREGATE)) {
 		char key[BT_SETTINGS_KEY_MAX];
 
 		if (id) {
@@ -4985,5 +5763,12 @@ int bt_gatt_clear(uint8_t id, const bt_addr_le_t *addr)
 		bt_gatt_clear_subscriptions(id, addr);
 	}
 
+#if defined(CONFIG_BT_SETTINGS_GATT_AGGREGATE)
+	err = gatt_delete_peer(id, addr);
+	if (err < 0) {
+		return err;
+	}
+#endif
+
 	return 0;
 }
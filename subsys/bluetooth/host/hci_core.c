@@ -45,6 +45,7 @@
 #include "smp.h"
 #include "crypto.h"
 #include "settings.h"
+#include "scan_filter.h"
 
 #if !defined(CONFIG_BT_EXT_ADV_LEGACY_SUPPORT)
 #undef BT_FEAT_LE_EXT_ADV
@@ -70,15 +71,16 @@ static void init_work(struct k_work *work);
 
 struct bt_dev bt_dev = {
 	.init          = Z_WORK_INITIALIZER(init_work),
-	/* Give cmd_sem allowing to send first HCI_Reset cmd, the only
-	 * exception is if the controller requests to wait for an
-	 * initial Command Complete for NOP.
+	/* Allow sending the first HCI_Reset cmd, the only exception is if
+	 * the controller requests to wait for an initial Command Complete
+	 * for NOP.
 	 */
 #if !defined(CONFIG_BT_WAIT_NOP)
-	.ncmd_sem      = Z_SEM_INITIALIZER(bt_dev.ncmd_sem, 1, 1),
+	.ncmd          = 1,
 #else
-	.ncmd_sem      = Z_SEM_INITIALIZER(bt_dev.ncmd_sem, 0, 1),
+	.ncmd          = 0,
 #endif
+	.ncmd_sem      = Z_SEM_INITIALIZER(bt_dev.ncmd_sem, 0, 1),
 	.cmd_tx_queue  = Z_FIFO_INITIALIZER(bt_dev.cmd_tx_queue),
 #if !defined(CONFIG_BT_RECV_IS_RX_THREAD)
 	.rx_queue      = Z_FIFO_INITIALIZER(bt_dev.rx_queue),
@@ -397,6 +399,75 @@ int bt_hci_cmd_send_sync(uint16_t opcode, struct net_buf *buf,
 	return 0;
 }
 
+struct hci_cmd_batch {
+	uint16_t opcode;
+	void (*complete)(struct net_buf *rsp);
+};
+
+/* Send commands without parameters, keeping up to CONFIG_BT_HCI_CMD_PIPELINE
+ * of them in flight, and pass the responses to their handler in order.
+ */
+static int hci_cmd_send_batch(const struct hci_cmd_batch *cmds, size_t count)
+{
+	struct k_sem sync_sem[CONFIG_BT_HCI_CMD_PIPELINE];
+	struct net_buf *bufs[CONFIG_BT_HCI_CMD_PIPELINE];
+	size_t sent = 0, done = 0;
+	struct net_buf *buf;
+	uint8_t status;
+	size_t slot;
+	int err = 0;
+	int ret;
+
+	while (done < count) {
+		while (sent < count && sent - done < ARRAY_SIZE(bufs)) {
+			slot = sent % ARRAY_SIZE(bufs);
+
+			buf = bt_hci_cmd_create(cmds[sent].opcode, 0);
+			if (!buf) {
+				/* Only wait for what was already sent */
+				err = -ENOBUFS;
+				count = sent;
+				break;
+			}
+
+			k_sem_init(&sync_sem[slot], 0, 1);
+			cmd(buf)->sync = &sync_sem[slot];
+
+			/* Keep the buffer around until the command completes */
+			bufs[slot] = net_buf_ref(buf);
+
+			net_buf_put(&bt_dev.cmd_tx_queue, buf);
+			sent++;
+		}
+
+		if (done == sent) {
+			break;
+		}
+
+		slot = done % ARRAY_SIZE(bufs);
+
+		ret = k_sem_take(&sync_sem[slot], HCI_CMD_TIMEOUT);
+		BT_ASSERT_MSG(ret == 0, "k_sem_take failed with err %d", ret);
+
+		status = cmd(bufs[slot])->status;
+		if (status) {
+			BT_WARN("opcode 0x%04x status 0x%02x",
+				cmds[done].opcode, status);
+			if (!err) {
+				err = -EIO;
+				count = sent;
+			}
+		} else if (!err) {
+			cmds[done].complete(bufs[slot]);
+		}
+
+		net_buf_unref(bufs[slot]);
+		done++;
+	}
+
+	return err;
+}
+
 #if defined(CONFIG_BT_OBSERVER) || defined(CONFIG_BT_BROADCASTER)
 const bt_addr_le_t *bt_lookup_id_addr(uint8_t id, const bt_addr_le_t *addr)
 {
@@ -1353,6 +1424,10 @@ static void hci_num_completed_packets(struct net_buf *buf)
 
 		irq_unlock(key);
 
+#if defined(CONFIG_BT_CONN_STATS)
+		conn->stats.tx_completed += count;
+#endif /* CONFIG_BT_CONN_STATS */
+
 		while (count--) {
 			struct bt_conn_tx *tx;
 			sys_snode_t *node;
@@ -3998,15 +4073,101 @@ static void hci_reset_complete(struct net_buf *buf)
 	atomic_set(bt_dev.flags, flags);
 }
 
+/* Number of sent commands waiting for completion, IRQs must be locked */
+static uint8_t sent_cmd_count(void)
+{
+	uint8_t count = 0U;
+
+	while (count < ARRAY_SIZE(bt_dev.sent_cmd) &&
+	       bt_dev.sent_cmd[count]) {
+		count++;
+	}
+
+	return count;
+}
+
+/* Remove @a buf, or the oldest command with @a opcode if @a buf is NULL,
+ * from the sent commands. The reference of the list goes to the caller.
+ */
+static struct net_buf *sent_cmd_remove(uint16_t opcode, struct net_buf *buf)
+{
+	struct net_buf *sent = NULL;
+	unsigned int key;
+	uint8_t count, i;
+
+	key = irq_lock();
+
+	count = sent_cmd_count();
+
+	for (i = 0U; i < count; i++) {
+		if (buf ? bt_dev.sent_cmd[i] == buf :
+		    cmd(bt_dev.sent_cmd[i])->opcode == opcode) {
+			sent = bt_dev.sent_cmd[i];
+			break;
+		}
+	}
+
+	if (sent) {
+		for (; i + 1U < count; i++) {
+			bt_dev.sent_cmd[i] = bt_dev.sent_cmd[i + 1U];
+		}
+
+		bt_dev.sent_cmd[count - 1U] = NULL;
+	}
+
+	irq_unlock(key);
+
+	return sent;
+}
+
+/* Update the number of commands that may be sent from the
+ * Num_HCI_Command_Packets value of a Command Complete or Status event.
+ */
+static void hci_cmd_credits(uint8_t ncmd)
+{
+	unsigned int key;
+	uint8_t in_flight;
+
+	key = irq_lock();
+
+	/* Commands still in flight may not be accounted for by the
+	 * controller yet.
+	 */
+	in_flight = sent_cmd_count();
+	ncmd = MIN(ncmd, CONFIG_BT_HCI_CMD_PIPELINE);
+	bt_dev.ncmd = (ncmd > in_flight) ? (ncmd - in_flight) : 0U;
+
+	irq_unlock(key);
+
+	if (bt_dev.ncmd) {
+		k_sem_give(&bt_dev.ncmd_sem);
+	}
+}
+
 static void hci_cmd_done(uint16_t opcode, uint8_t status, struct net_buf *buf)
 {
+	struct net_buf *sent = NULL;
+
 	BT_DBG("opcode 0x%04x status 0x%02x buf %p", opcode, status, buf);
 
 	if (net_buf_pool_get(buf->pool_id) != &hci_cmd_pool) {
-		BT_WARN("opcode 0x%04x pool id %u pool %p != &hci_cmd_pool %p",
-			opcode, buf->pool_id, net_buf_pool_get(buf->pool_id),
-			&hci_cmd_pool);
-		return;
+		/* With several commands in flight the event could not reuse
+		 * the command buffer, copy the return parameters into it.
+		 */
+		sent = sent_cmd_remove(opcode, NULL);
+		if (!sent) {
+			BT_WARN("opcode 0x%04x pool id %u pool %p != "
+				"&hci_cmd_pool %p", opcode, buf->pool_id,
+				net_buf_pool_get(buf->pool_id), &hci_cmd_pool);
+			return;
+		}
+
+		bt_buf_set_type(sent, BT_BUF_EVT);
+		sent->len = 0U;
+		net_buf_reserve(sent, BT_BUF_RESERVE);
+		net_buf_add_mem(sent, buf->data,
+				MIN(buf->len, net_buf_tailroom(sent)));
+		buf = sent;
 	}
 
 	if (cmd(buf)->opcode != opcode) {
@@ -4025,6 +4186,10 @@ static void hci_cmd_done(uint16_t opcode, uint8_t status, struct net_buf *buf)
 		cmd(buf)->status = status;
 		k_sem_give(cmd(buf)->sync);
 	}
+
+	if (sent) {
+		net_buf_unref(sent);
+	}
 }
 
 static void hci_cmd_complete(struct net_buf *buf)
@@ -4047,9 +4212,7 @@ static void hci_cmd_complete(struct net_buf *buf)
 	hci_cmd_done(opcode, status, buf);
 
 	/* Allow next command to be sent */
-	if (ncmd) {
-		k_sem_give(&bt_dev.ncmd_sem);
-	}
+	hci_cmd_credits(ncmd);
 }
 
 static void hci_cmd_status(struct net_buf *buf)
@@ -4067,9 +4230,7 @@ static void hci_cmd_status(struct net_buf *buf)
 	hci_cmd_done(opcode, evt->status, buf);
 
 	/* Allow next command to be sent */
-	if (ncmd) {
-		k_sem_give(&bt_dev.ncmd_sem);
-	}
+	hci_cmd_credits(ncmd);
 }
 
 #if defined(CONFIG_BT_OBSERVER)
@@ -4391,6 +4552,7 @@ static void le_adv_recv(bt_addr_le_t *addr, struct bt_le_scan_recv_info *info,
 	struct bt_le_scan_cb *listener;
 	struct net_buf_simple_state state;
 	bt_addr_le_t id_addr;
+	bool deliver = true;
 
 	BT_DBG("%s event %u, len %u, rssi %d dBm", bt_addr_le_str(addr),
 	       info->adv_type, len, info->rssi);
@@ -4403,6 +4565,20 @@ static void le_adv_recv(bt_addr_le_t *addr, struct bt_le_scan_recv_info *info,
 		return;
 	}
 
+#if defined(CONFIG_BT_SCAN_FILTER)
+	if (!bt_scan_filter_report(addr, info, buf->data, len)) {
+		/* Filtered reports are still needed to establish pending
+		 * connections, which can only happen outside explicit scanning.
+		 */
+		if (!IS_ENABLED(CONFIG_BT_CENTRAL) ||
+		    atomic_test_bit(bt_dev.flags, BT_DEV_EXPLICIT_SCAN)) {
+			return;
+		}
+
+		deliver = false;
+	}
+#endif /* CONFIG_BT_SCAN_FILTER */
+
 	if (addr->type == BT_ADDR_LE_PUBLIC_ID ||
 	    addr->type == BT_ADDR_LE_RANDOM_ID) {
 		bt_addr_le_copy(&id_addr, addr);
@@ -4416,7 +4592,11 @@ static void le_adv_recv(bt_addr_le_t *addr, struct bt_le_scan_recv_info *info,
 
 	info->addr = &id_addr;
 
-	if (scan_dev_found_cb) {
+#if defined(CONFIG_BT_SCAN_FILTER)
+	deliver = deliver && bt_scan_filter_addr(&id_addr);
+#endif /* CONFIG_BT_SCAN_FILTER */
+
+	if (deliver && scan_dev_found_cb) {
 		net_buf_simple_save(&buf->b, &state);
 
 		buf->len = len;
@@ -4426,8 +4606,11 @@ static void le_adv_recv(bt_addr_le_t *addr, struct bt_le_scan_recv_info *info,
 		net_buf_simple_restore(&buf->b, &state);
 	}
 
-
 	SYS_SLIST_FOR_EACH_CONTAINER(&scan_cbs, listener, node) {
+		if (!deliver) {
+			break;
+		}
+
 		net_buf_simple_save(&buf->b, &state);
 
 		buf->len = len;
@@ -5072,6 +5255,8 @@ static void hci_event(struct net_buf *buf)
 static void send_cmd(void)
 {
 	struct net_buf *buf;
+	unsigned int key;
+	uint8_t count;
 	int err;
 
 	/* Get next command */
@@ -5079,29 +5264,49 @@ static void send_cmd(void)
 	buf = net_buf_get(&bt_dev.cmd_tx_queue, K_NO_WAIT);
 	BT_ASSERT(buf);
 
-	/* Wait until ncmd > 0 */
+	/* Wait until ncmd > 0, the command is added to the sent ones
+	 * together with taking the credit so that hci_cmd_credits() never
+	 * sees one without the other.
+	 */
 	BT_DBG("calling sem_take_wait");
-	k_sem_take(&bt_dev.ncmd_sem, K_FOREVER);
+	while (1) {
+		key = irq_lock();
 
-	/* Clear out any existing sent command */
-	if (bt_dev.sent_cmd) {
-		BT_ERR("Uncleared pending sent_cmd");
-		net_buf_unref(bt_dev.sent_cmd);
-		bt_dev.sent_cmd = NULL;
-	}
+		if (bt_dev.ncmd) {
+			count = sent_cmd_count();
+			__ASSERT_NO_MSG(count < ARRAY_SIZE(bt_dev.sent_cmd));
 
-	bt_dev.sent_cmd = net_buf_ref(buf);
+			bt_dev.ncmd--;
+			bt_dev.sent_cmd[count] = net_buf_ref(buf);
+			irq_unlock(key);
+			break;
+		}
+
+		irq_unlock(key);
+
+		k_sem_take(&bt_dev.ncmd_sem, K_FOREVER);
+	}
 
 	BT_DBG("Sending command 0x%04x (buf %p) to driver",
 	       cmd(buf)->opcode, buf);
 
 	err = bt_send(buf);
 	if (err) {
+		struct net_buf *sent;
+
 		BT_ERR("Unable to send to driver (err %d)", err);
+
+		sent = sent_cmd_remove(cmd(buf)->opcode, buf);
+		if (sent) {
+			net_buf_unref(sent);
+		}
+
+		key = irq_lock();
+		bt_dev.ncmd++;
+		irq_unlock(key);
 		k_sem_give(&bt_dev.ncmd_sem);
+
 		hci_cmd_done(cmd(buf)->opcode, BT_HCI_ERR_UNSPECIFIED, buf);
-		net_buf_unref(bt_dev.sent_cmd);
-		bt_dev.sent_cmd = NULL;
 		net_buf_unref(buf);
 	}
 }
@@ -5310,6 +5515,14 @@ static void le_read_resolving_list_size_complete(struct net_buf *buf)
 
 static int common_init(void)
 {
+	static const struct hci_cmd_batch read_cmds[] = {
+		{ BT_HCI_OP_READ_LOCAL_FEATURES,
+		  read_local_features_complete },
+		{ BT_HCI_OP_READ_LOCAL_VERSION_INFO,
+		  read_local_ver_complete },
+		{ BT_HCI_OP_READ_SUPPORTED_COMMANDS,
+		  read_supported_commands_complete },
+	};
 	struct net_buf *rsp;
 	int err;
 
@@ -5323,31 +5536,13 @@ static int common_init(void)
 		net_buf_unref(rsp);
 	}
 
-	/* Read Local Supported Features */
-	err = bt_hci_cmd_send_sync(BT_HCI_OP_READ_LOCAL_FEATURES, NULL, &rsp);
-	if (err) {
-		return err;
-	}
-	read_local_features_complete(rsp);
-	net_buf_unref(rsp);
-
-	/* Read Local Version Information */
-	err = bt_hci_cmd_send_sync(BT_HCI_OP_READ_LOCAL_VERSION_INFO, NULL,
-				   &rsp);
+	/* Read Local Supported Features, Version Information and
+	 * Supported Commands
+	 */
+	err = hci_cmd_send_batch(read_cmds, ARRAY_SIZE(read_cmds));
 	if (err) {
 		return err;
 	}
-	read_local_ver_complete(rsp);
-	net_buf_unref(rsp);
-
-	/* Read Local Supported Commands */
-	err = bt_hci_cmd_send_sync(BT_HCI_OP_READ_SUPPORTED_COMMANDS, NULL,
-				   &rsp);
-	if (err) {
-		return err;
-	}
-	read_supported_commands_complete(rsp);
-	net_buf_unref(rsp);
 
 	if (IS_ENABLED(CONFIG_BT_HOST_CRYPTO)) {
 		/* Initialize the PRNG so that it is safe to use it later
@@ -5454,6 +5649,14 @@ static int le_set_event_mask(void)
 
 static int le_init(void)
 {
+	static const struct hci_cmd_batch read_cmds[] = {
+		{ BT_HCI_OP_LE_READ_LOCAL_FEATURES,
+		  read_le_features_complete },
+#if defined(CONFIG_BT_CONN)
+		{ BT_HCI_OP_LE_READ_BUFFER_SIZE,
+		  le_read_buffer_size_complete },
+#endif
+	};
 	struct bt_hci_cp_write_le_host_supp *cp_le;
 	struct net_buf *buf, *rsp;
 	int err;
@@ -5464,26 +5667,11 @@ static int le_init(void)
 		return -ENODEV;
 	}
 
-	/* Read Low Energy Supported Features */
-	err = bt_hci_cmd_send_sync(BT_HCI_OP_LE_READ_LOCAL_FEATURES, NULL,
-				   &rsp);
-	if (err) {
-		return err;
-	}
-
-	read_le_features_complete(rsp);
-	net_buf_unref(rsp);
-
-#if defined(CONFIG_BT_CONN)
-	/* Read LE Buffer Size */
-	err = bt_hci_cmd_send_sync(BT_HCI_OP_LE_READ_BUFFER_SIZE,
-				   NULL, &rsp);
+	/* Read Low Energy Supported Features and LE Buffer Size */
+	err = hci_cmd_send_batch(read_cmds, ARRAY_SIZE(read_cmds));
 	if (err) {
 		return err;
 	}
-	le_read_buffer_size_complete(rsp);
-	net_buf_unref(rsp);
-#endif
 
 	if (BT_FEAT_BREDR(bt_dev.features)) {
 		buf = bt_hci_cmd_create(BT_HCI_OP_LE_WRITE_LE_HOST_SUPP,
@@ -8628,9 +8816,16 @@ struct net_buf *bt_buf_get_cmd_complete(k_timeout_t timeout)
 	struct net_buf *buf;
 	unsigned int key;
 
+	/* The event can only reuse the command buffer when it is known
+	 * which command it completes.
+	 */
 	key = irq_lock();
-	buf = bt_dev.sent_cmd;
-	bt_dev.sent_cmd = NULL;
+	if (sent_cmd_count() == 1U) {
+		buf = bt_dev.sent_cmd[0];
+		bt_dev.sent_cmd[0] = NULL;
+	} else {
+		buf = NULL;
+	}
 	irq_unlock(key);
 
 	BT_DBG("sent_cmd %p", buf);
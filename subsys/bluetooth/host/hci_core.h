@@ -261,11 +261,14 @@ struct bt_dev {
 	struct bt_dev_br	br;
 #endif
 
-	/* Number of commands controller can accept */
+	/* Signaled when the controller can accept more commands */
 	struct k_sem		ncmd_sem;
 
-	/* Last sent HCI command */
-	struct net_buf		*sent_cmd;
+	/* Number of commands that may still be sent to the controller */
+	uint8_t			ncmd;
+
+	/* Sent HCI commands waiting for completion, oldest first */
+	struct net_buf		*sent_cmd[CONFIG_BT_HCI_CMD_PIPELINE];
 
 #if !defined(CONFIG_BT_RECV_IS_RX_THREAD)
 	/* Queue for incoming HCI events & ACL data */
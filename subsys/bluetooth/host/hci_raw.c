@@ -39,8 +39,12 @@ NET_BUF_POOL_FIXED_DEFINE(hci_rx_pool, CONFIG_BT_RX_BUF_COUNT,
 			  BT_BUF_RX_SIZE, NULL);
 NET_BUF_POOL_FIXED_DEFINE(hci_cmd_pool, CONFIG_BT_HCI_CMD_COUNT,
 			  BT_BUF_RX_SIZE, NULL);
+/* In H:4 mode transports may receive the packet type into the ACL buffer
+ * along with the packet, to avoid copying it to another buffer.
+ */
 NET_BUF_POOL_FIXED_DEFINE(hci_acl_pool, BT_HCI_ACL_COUNT,
-			  BT_BUF_ACL_SIZE, NULL);
+			  BT_BUF_ACL_SIZE + IS_ENABLED(CONFIG_BT_HCI_RAW_H4),
+			  NULL);
 
 struct bt_dev_raw bt_dev;
 struct bt_hci_raw_cmd_ext *cmd_ext;
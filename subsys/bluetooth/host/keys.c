@@ -38,6 +38,74 @@ static uint32_t aging_counter_val;
 static struct bt_keys *last_keys_updated;
 #endif /* CONFIG_BT_KEYS_OVERWRITE_OLDEST */
 
+#if CONFIG_BT_KEYS_RPA_UNRESOLVED_CACHE > 0
+/* Peers are expected to change their RPA at least this often */
+#if defined(CONFIG_BT_RPA_TIMEOUT)
+#define RPA_UNRESOLVED_TIMEOUT_MS (CONFIG_BT_RPA_TIMEOUT * MSEC_PER_SEC)
+#else
+#define RPA_UNRESOLVED_TIMEOUT_MS (900 * MSEC_PER_SEC)
+#endif
+
+/* Recently seen RPAs which did not match any of the stored IRKs */
+static struct {
+	bool      valid;
+	uint8_t   id;
+	bt_addr_t rpa;
+	uint32_t  timestamp;
+} rpa_unresolved[CONFIG_BT_KEYS_RPA_UNRESOLVED_CACHE];
+static uint8_t rpa_unresolved_next;
+
+static bool rpa_unresolved_find(uint8_t id, const bt_addr_t *rpa)
+{
+	uint32_t now = k_uptime_get_32();
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(rpa_unresolved); i++) {
+		if (!rpa_unresolved[i].valid) {
+			continue;
+		}
+
+		if ((now - rpa_unresolved[i].timestamp) >=
+		    RPA_UNRESOLVED_TIMEOUT_MS) {
+			rpa_unresolved[i].valid = false;
+			continue;
+		}
+
+		if (rpa_unresolved[i].id == id &&
+		    !bt_addr_cmp(&rpa_unresolved[i].rpa, rpa)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void rpa_unresolved_add(uint8_t id, const bt_addr_t *rpa)
+{
+	uint8_t i = rpa_unresolved_next;
+
+	rpa_unresolved[i].valid = true;
+	rpa_unresolved[i].id = id;
+	bt_addr_copy(&rpa_unresolved[i].rpa, rpa);
+	rpa_unresolved[i].timestamp = k_uptime_get_32();
+
+	rpa_unresolved_next = (i + 1) % ARRAY_SIZE(rpa_unresolved);
+}
+
+static void rpa_unresolved_clear(void)
+{
+	(void)memset(rpa_unresolved, 0, sizeof(rpa_unresolved));
+}
+#else
+static inline bool rpa_unresolved_find(uint8_t id, const bt_addr_t *rpa)
+{
+	return false;
+}
+
+static inline void rpa_unresolved_add(uint8_t id, const bt_addr_t *rpa) {}
+static inline void rpa_unresolved_clear(void) {}
+#endif /* CONFIG_BT_KEYS_RPA_UNRESOLVED_CACHE > 0 */
+
 struct bt_keys *bt_keys_get_addr(uint8_t id, const bt_addr_le_t *addr)
 {
 	struct bt_keys *keys;
@@ -189,6 +257,11 @@ struct bt_keys *bt_keys_find_irk(uint8_t id, const bt_addr_le_t *addr)
 		}
 	}
 
+	if (rpa_unresolved_find(id, &addr->a)) {
+		BT_DBG("Unresolvable RPA %s (cached)", bt_addr_le_str(addr));
+		return NULL;
+	}
+
 	for (i = 0; i < ARRAY_SIZE(key_pool); i++) {
 		if (!(key_pool[i].keys & BT_KEYS_IRK)) {
 			continue;
@@ -211,6 +284,8 @@ struct bt_keys *bt_keys_find_irk(uint8_t id, const bt_addr_le_t *addr)
 
 	BT_DBG("No IRK for %s", bt_addr_le_str(addr));
 
+	rpa_unresolved_add(id, &addr->a);
+
 	return NULL;
 }
 
@@ -232,9 +307,21 @@ struct bt_keys *bt_keys_find_addr(uint8_t id, const bt_addr_le_t *addr)
 
 void bt_keys_add_type(struct bt_keys *keys, int type)
 {
+	if (type & BT_KEYS_IRK) {
+		/* RPAs seen so far may resolve with the new IRK */
+		rpa_unresolved_clear();
+	}
+
 	keys->keys |= type;
 }
 
+void bt_keys_irk_set(struct bt_keys *keys, const uint8_t irk[16])
+{
+	memcpy(keys->irk.val, irk, sizeof(keys->irk.val));
+
+	rpa_unresolved_clear();
+}
+
 void bt_keys_clear(struct bt_keys *keys)
 {
 	BT_DBG("%s (keys 0x%04x)", bt_addr_le_str(&keys->addr), keys->keys);
@@ -374,6 +461,10 @@ static int keys_set(const char *name, size_t len_rd, settings_read_cb read_cb,
 		memcpy(keys->storage_start, val, len);
 	}
 
+	if (keys->keys & BT_KEYS_IRK) {
+		rpa_unresolved_clear();
+	}
+
 	BT_DBG("Successfully restored keys for %s", bt_addr_le_str(&addr));
 #if IS_ENABLED(CONFIG_BT_KEYS_OVERWRITE_OLDEST)
 	if (aging_counter_val < keys->aging_counter) {
@@ -1593,10 +1593,10 @@ static struct net_buf *l2cap_chan_create_seg(struct bt_l2cap_le_chan *ch,
 
 	headroom = BT_L2CAP_CHAN_SEND_RESERVE + sdu_hdr_len;
 
-	/* Check if original buffer has enough headroom and don't have any
-	 * fragments.
+	/* Check if original buffer has enough headroom, it is then sent as
+	 * is. Any following fragments are detached by the caller.
 	 */
-	if (net_buf_headroom(buf) >= headroom && !buf->frags) {
+	if (net_buf_headroom(buf) >= headroom) {
 		if (sdu_hdr_len) {
 			/* Push SDU length if set */
 			net_buf_push_le16(buf, net_buf_frags_len(buf));
@@ -1685,10 +1685,13 @@ static bool test_and_dec(atomic_t *target)
  * be sent later.
  */
 static int l2cap_chan_le_send(struct bt_l2cap_le_chan *ch,
-			      struct net_buf *buf, uint16_t sdu_hdr_len)
+			      struct net_buf **buf, uint16_t sdu_hdr_len)
 {
+	struct net_buf *frag = *buf;
+	struct net_buf *next = NULL;
 	struct net_buf *seg;
 	struct net_buf_simple_state state;
+	bool last;
 	int len, err;
 
 	if (!test_and_dec(&ch->tx.credits)) {
@@ -1697,23 +1700,34 @@ static int l2cap_chan_le_send(struct bt_l2cap_le_chan *ch,
 	}
 
 	/* Save state so it can be restored if we failed to send */
-	net_buf_simple_save(&buf->b, &state);
+	net_buf_simple_save(&frag->b, &state);
 
-	seg = l2cap_chan_create_seg(ch, buf, sdu_hdr_len);
+	seg = l2cap_chan_create_seg(ch, frag, sdu_hdr_len);
 	if (!seg) {
 		atomic_inc(&ch->tx.credits);
 		return -EAGAIN;
 	}
 
+	if (seg == frag) {
+		/* The fragment itself is sent so it must not carry the rest
+		 * of the SDU along.
+		 */
+		next = frag->frags;
+		frag->frags = NULL;
+		last = !next;
+	} else {
+		last = !net_buf_frags_len(frag);
+	}
+
 	BT_DBG("ch %p cid 0x%04x len %u credits %u", ch, ch->tx.cid,
 	       seg->len, atomic_get(&ch->tx.credits));
 
 	len = seg->len - sdu_hdr_len;
 
-	/* Set a callback if there is no data left in the buffer and sent
+	/* Set a callback if there is no data left in the SDU and sent
 	 * callback has been set.
 	 */
-	if ((buf == seg || !buf->len) && ch->chan.ops->sent) {
+	if (last && ch->chan.ops->sent) {
 		err = bt_l2cap_send_cb(ch->chan.conn, ch->tx.cid, seg,
 				       l2cap_chan_sdu_sent, &ch->chan);
 	} else {
@@ -1725,15 +1739,25 @@ static int l2cap_chan_le_send(struct bt_l2cap_le_chan *ch,
 		BT_WARN("Unable to send seg %d", err);
 		atomic_inc(&ch->tx.credits);
 
+		if (seg == frag) {
+			frag->frags = next;
+		}
+
 		if (err == -ENOBUFS) {
 			/* Restore state since segment could not be sent */
-			net_buf_simple_restore(&buf->b, &state);
+			net_buf_simple_restore(&frag->b, &state);
 			return -EAGAIN;
 		}
 
 		return err;
 	}
 
+	/* Continue with the next fragment if this one went out as is */
+	if (next) {
+		*buf = next;
+		net_buf_unref(frag);
+	}
+
 	/* Check if there is no credits left clear output status and notify its
 	 * change.
 	 */
@@ -1766,7 +1790,7 @@ static int l2cap_chan_le_send_sdu(struct bt_l2cap_le_chan *ch,
 
 	if (!sent) {
 		/* Add SDU length for the first segment */
-		ret = l2cap_chan_le_send(ch, frag, BT_L2CAP_SDU_HDR_LEN);
+		ret = l2cap_chan_le_send(ch, &frag, BT_L2CAP_SDU_HDR_LEN);
 		if (ret < 0) {
 			if (ret == -EAGAIN) {
 				/* Store sent data into user_data */
@@ -1785,7 +1809,7 @@ static int l2cap_chan_le_send_sdu(struct bt_l2cap_le_chan *ch,
 			frag = net_buf_frag_del(NULL, frag);
 		}
 
-		ret = l2cap_chan_le_send(ch, frag, 0);
+		ret = l2cap_chan_le_send(ch, &frag, 0);
 		if (ret < 0) {
 			if (ret == -EAGAIN) {
 				/* Store sent data into user_data */
@@ -2074,6 +2098,27 @@ static struct net_buf *l2cap_alloc_frag(k_timeout_t timeout, void *user_data)
 	return frag;
 }
 
+static bool l2cap_chan_le_append_seg(struct bt_l2cap_le_chan *chan,
+				     struct net_buf *buf, uint16_t seg)
+{
+	uint16_t len;
+
+#if CONFIG_BT_L2CAP_RX_SEG_REF_MAX > 0
+	/* Chain the segment instead of copying it, its RX buffer is then held
+	 * until the SDU is released.
+	 */
+	if (seg <= CONFIG_BT_L2CAP_RX_SEG_REF_MAX) {
+		net_buf_frag_add(chan->_sdu, net_buf_ref(buf));
+		return true;
+	}
+#endif /* CONFIG_BT_L2CAP_RX_SEG_REF_MAX > 0 */
+
+	len = net_buf_append_bytes(chan->_sdu, buf->len, buf->data, K_NO_WAIT,
+				   l2cap_alloc_frag, chan);
+
+	return len == buf->len;
+}
+
 static void l2cap_chan_le_recv_sdu(struct bt_l2cap_le_chan *chan,
 				   struct net_buf *buf, uint16_t seg)
 {
@@ -2120,9 +2165,7 @@ static void l2cap_chan_le_recv_seg(struct bt_l2cap_le_chan *chan,
 	BT_DBG("chan %p seg %d len %zu", chan, seg, net_buf_frags_len(buf));
 
 	/* Append received segment to SDU */
-	len = net_buf_append_bytes(chan->_sdu, buf->len, buf->data, K_NO_WAIT,
-				   l2cap_alloc_frag, chan);
-	if (len != buf->len) {
+	if (!l2cap_chan_le_append_seg(chan, buf, seg)) {
 		BT_ERR("Unable to store SDU");
 		bt_l2cap_chan_disconnect(&chan->chan);
 		return;
@@ -310,11 +310,11 @@ static void rfcomm_session_disconnected(struct bt_rfcomm_session *session)
 struct net_buf *bt_rfcomm_create_pdu(struct net_buf_pool *pool)
 {
 	/* Length in RFCOMM header can be 2 bytes depending on length of user
-	 * data
+	 * data, and credits may be returned in the same frame.
 	 */
 	return bt_conn_create_pdu(pool,
 				  sizeof(struct bt_l2cap_hdr) +
-				  sizeof(struct bt_rfcomm_hdr) + 1);
+				  sizeof(struct bt_rfcomm_hdr) + 2);
 }
 
 static int rfcomm_send_sabm(struct bt_rfcomm_session *session, uint8_t dlci)
@@ -442,6 +442,7 @@ static void rfcomm_dlc_init(struct bt_rfcomm_dlc *dlc,
 	dlc->dlci = dlci;
 	dlc->session = session;
 	dlc->rx_credit = RFCOMM_DEFAULT_CREDIT;
+	atomic_clear(&dlc->rx_credit_pending);
 	dlc->state = BT_RFCOMM_STATE_INIT;
 	dlc->role = role;
 	k_delayed_work_init(&dlc->rtx_work, rfcomm_dlc_rtx_timeout);
@@ -505,6 +506,92 @@ static int rfcomm_send_dm(struct bt_rfcomm_session *session, uint8_t dlci)
 	return bt_l2cap_chan_send(&session->br_chan.chan, buf);
 }
 
+static int rfcomm_send_credit(struct bt_rfcomm_dlc *dlc, uint8_t credits);
+
+#if defined(CONFIG_BT_RFCOMM_TX_AGGREGATE)
+/* Append queued data to the frame being sent, as long as it fits */
+static void rfcomm_dlc_tx_aggregate(struct bt_rfcomm_dlc *dlc,
+				    struct net_buf *buf)
+{
+	struct net_buf *next;
+
+	while ((next = k_fifo_peek_head(&dlc->tx_queue))) {
+		/* Leave dummy buffers and fragmented data to the TX loop */
+		if (!next->len || next->frags || buf->frags) {
+			break;
+		}
+
+		if (buf->len + next->len > dlc->mtu ||
+		    net_buf_tailroom(buf) < next->len + BT_RFCOMM_FCS_SIZE) {
+			break;
+		}
+
+		/* Only this thread dequeues, so this is the peeked buffer */
+		next = net_buf_get(&dlc->tx_queue, K_NO_WAIT);
+		net_buf_add_mem(buf, next->data, next->len);
+		net_buf_unref(next);
+	}
+}
+#endif /* CONFIG_BT_RFCOMM_TX_AGGREGATE */
+
+/* Add the RFCOMM UIH header and FCS to user data, returning pending RX
+ * credits in the same frame if there is room for them.
+ */
+static void rfcomm_dlc_tx_frame(struct bt_rfcomm_dlc *dlc,
+				struct net_buf *buf)
+{
+	struct bt_rfcomm_hdr *hdr;
+	uint8_t fcs, cr, pf;
+	uint16_t len = buf->len;
+	atomic_val_t credits = 0;
+
+	/* Buffers not allocated with bt_rfcomm_create_pdu() may lack the
+	 * headroom for the credits byte.
+	 */
+	if (net_buf_headroom(buf) >= BT_BUF_RESERVE +
+	    sizeof(struct bt_hci_acl_hdr) + sizeof(struct bt_l2cap_hdr) +
+	    sizeof(*hdr) + (len > BT_RFCOMM_MAX_LEN_8) + 1) {
+		credits = atomic_set(&dlc->rx_credit_pending, 0);
+	}
+
+	if (credits) {
+		net_buf_push_u8(buf, credits);
+		pf = BT_RFCOMM_PF_UIH_CREDIT;
+	} else {
+		pf = BT_RFCOMM_PF_UIH_NO_CREDIT;
+	}
+
+	if (len > BT_RFCOMM_MAX_LEN_8) {
+		uint16_t *len16;
+
+		/* Length is 2 byte */
+		hdr = net_buf_push(buf, sizeof(*hdr) + 1);
+		len16 = (uint16_t *)&hdr->length;
+		*len16 = BT_RFCOMM_SET_LEN_16(sys_cpu_to_le16(len));
+	} else {
+		hdr = net_buf_push(buf, sizeof(*hdr));
+		hdr->length = BT_RFCOMM_SET_LEN_8(len);
+	}
+
+	cr = BT_RFCOMM_UIH_CR(dlc->session->role);
+	hdr->address = BT_RFCOMM_SET_ADDR(dlc->dlci, cr);
+	hdr->control = BT_RFCOMM_SET_CTRL(BT_RFCOMM_UIH, pf);
+
+	fcs = rfcomm_calc_fcs(BT_RFCOMM_FCS_LEN_UIH, buf->data);
+	net_buf_add_u8(buf, fcs);
+}
+
+/* Send RX credits which could not be returned along with data */
+static void rfcomm_dlc_flush_credits(struct bt_rfcomm_dlc *dlc)
+{
+	atomic_val_t credits;
+
+	credits = atomic_set(&dlc->rx_credit_pending, 0);
+	if (credits) {
+		rfcomm_send_credit(dlc, credits);
+	}
+}
+
 static void rfcomm_check_fc(struct bt_rfcomm_dlc *dlc)
 {
 	BT_DBG("%p", dlc);
@@ -558,6 +645,12 @@ static void rfcomm_dlc_tx_thread(void *p1, void *p2, void *p3)
 			break;
 		}
 
+#if defined(CONFIG_BT_RFCOMM_TX_AGGREGATE)
+		rfcomm_dlc_tx_aggregate(dlc, buf);
+#endif /* CONFIG_BT_RFCOMM_TX_AGGREGATE */
+
+		rfcomm_dlc_tx_frame(dlc, buf);
+
 		if (bt_l2cap_chan_send(&dlc->session->br_chan.chan, buf) < 0) {
 			/* This fails only if channel is disconnected */
 			dlc->state = BT_RFCOMM_STATE_DISCONNECTED;
@@ -565,6 +658,9 @@ static void rfcomm_dlc_tx_thread(void *p1, void *p2, void *p3)
 			break;
 		}
 
+		/* Credits deferred while this frame was being sent */
+		rfcomm_dlc_flush_credits(dlc);
+
 		if (dlc->state == BT_RFCOMM_STATE_USER_DISCONNECT) {
 			timeout = K_NO_WAIT;
 		}
@@ -1356,7 +1452,16 @@ static void rfcomm_dlc_update_credits(struct bt_rfcomm_dlc *dlc)
 	credits = RFCOMM_MAX_CREDITS - dlc->rx_credit;
 	dlc->rx_credit += credits;
 
-	rfcomm_send_credit(dlc, credits);
+	/* Let the TX thread return the credits with the next data frame if
+	 * it is about to send one. Otherwise take them back and send them
+	 * right away, so that the peer never waits on them.
+	 */
+	atomic_add(&dlc->rx_credit_pending, credits);
+
+	if (k_fifo_is_empty(&dlc->tx_queue) ||
+	    !k_sem_count_get(&dlc->tx_credits)) {
+		rfcomm_dlc_flush_credits(dlc);
+	}
 }
 
 static void rfcomm_handle_data(struct bt_rfcomm_session *session,
@@ -1405,8 +1510,7 @@ static void rfcomm_handle_data(struct bt_rfcomm_session *session,
 
 int bt_rfcomm_dlc_send(struct bt_rfcomm_dlc *dlc, struct net_buf *buf)
 {
-	struct bt_rfcomm_hdr *hdr;
-	uint8_t fcs, cr;
+	int len;
 
 	if (!buf) {
 		return -EINVAL;
@@ -1422,30 +1526,14 @@ int bt_rfcomm_dlc_send(struct bt_rfcomm_dlc *dlc, struct net_buf *buf)
 		return -EMSGSIZE;
 	}
 
-	if (buf->len > BT_RFCOMM_MAX_LEN_8) {
-		uint16_t *len;
-
-		/* Length is 2 byte */
-		hdr = net_buf_push(buf, sizeof(*hdr) + 1);
-		len = (uint16_t *)&hdr->length;
-		*len = BT_RFCOMM_SET_LEN_16(sys_cpu_to_le16(buf->len -
-							    sizeof(*hdr) - 1));
-	} else {
-		hdr = net_buf_push(buf, sizeof(*hdr));
-		hdr->length = BT_RFCOMM_SET_LEN_8(buf->len - sizeof(*hdr));
-	}
-
-	cr = BT_RFCOMM_UIH_CR(dlc->session->role);
-	hdr->address = BT_RFCOMM_SET_ADDR(dlc->dlci, cr);
-	hdr->control = BT_RFCOMM_SET_CTRL(BT_RFCOMM_UIH,
-					  BT_RFCOMM_PF_UIH_NO_CREDIT);
-
-	fcs = rfcomm_calc_fcs(BT_RFCOMM_FCS_LEN_UIH, buf->data);
-	net_buf_add_u8(buf, fcs);
-
+	/* The frame header and FCS are added by the TX thread, which may
+	 * also append further queued data and return credits in the same
+	 * frame.
+	 */
+	len = buf->len;
 	net_buf_put(&dlc->tx_queue, buf);
 
-	return buf->len;
+	return len;
 }
 
 static int rfcomm_recv(struct bt_l2cap_chan *chan, struct net_buf *buf)
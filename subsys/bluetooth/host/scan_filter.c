@@ -0,0 +1,234 @@
+/* scan_filter.c - Host side scan report filtering */
+
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/util.h>
+#include <sys/byteorder.h>
+#include <sys/crc.h>
+
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/conn.h>
+#include <bluetooth/hci.h>
+
+#define BT_DBG_ENABLED IS_ENABLED(CONFIG_BT_DEBUG_HCI_CORE)
+#define LOG_MODULE_NAME bt_scan_filter
+#include "common/log.h"
+
+#include "hci_core.h"
+#include "scan_filter.h"
+
+static struct bt_le_scan_filter filter;
+static bool filter_enabled;
+
+/* Recently delivered reports, used to drop repeated ones */
+static struct {
+	bool         valid;
+	bt_addr_le_t addr;
+	uint8_t      adv_type;
+	uint8_t      len;
+	uint32_t     crc;
+	uint32_t     timestamp;
+} dedup[CONFIG_BT_SCAN_FILTER_DEDUP_SIZE];
+static uint8_t dedup_next;
+
+static bool is_duplicate(const bt_addr_le_t *addr, uint8_t adv_type,
+			 const uint8_t *data, uint8_t len)
+{
+	uint32_t now = k_uptime_get_32();
+	uint32_t crc = crc32_ieee(data, len);
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(dedup); i++) {
+		if (!dedup[i].valid ||
+		    dedup[i].crc != crc || dedup[i].len != len ||
+		    dedup[i].adv_type != adv_type ||
+		    bt_addr_le_cmp(&dedup[i].addr, addr)) {
+			continue;
+		}
+
+		if ((now - dedup[i].timestamp) < filter.dedup_window) {
+			return true;
+		}
+
+		/* Same report, but the window has passed: deliver it and
+		 * restart the window.
+		 */
+		dedup[i].timestamp = now;
+		return false;
+	}
+
+	i = dedup_next;
+	dedup_next = (dedup_next + 1) % ARRAY_SIZE(dedup);
+
+	dedup[i].valid = true;
+	bt_addr_le_copy(&dedup[i].addr, addr);
+	dedup[i].adv_type = adv_type;
+	dedup[i].len = len;
+	dedup[i].crc = crc;
+	dedup[i].timestamp = now;
+
+	return false;
+}
+
+static bool uuid16_match(const uint8_t *data, uint8_t len)
+{
+	int i, j;
+
+	for (i = 0; i + 1 < len; i += 2) {
+		uint16_t uuid = sys_get_le16(&data[i]);
+
+		for (j = 0; j < filter.uuid16_count; j++) {
+			if (filter.uuid16s[j] == uuid) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+static bool company_id_match(const uint8_t *data, uint8_t len)
+{
+	uint16_t company_id;
+	int i;
+
+	if (len < sizeof(company_id)) {
+		return false;
+	}
+
+	company_id = sys_get_le16(data);
+
+	for (i = 0; i < filter.company_id_count; i++) {
+		if (filter.company_ids[i] == company_id) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Walk the AD structures directly, instead of through bt_data_parse(), so
+ * the report buffer is left untouched for the scan callbacks.
+ */
+static bool data_match(const uint8_t *data, uint8_t len)
+{
+	bool uuid_ok = !filter.uuid16_count;
+	bool company_ok = !filter.company_id_count;
+
+	while (len > 1 && !(uuid_ok && company_ok)) {
+		uint8_t field_len = data[0];
+		uint8_t type;
+
+		/* Early termination, or malformed data */
+		if (!field_len || field_len >= len) {
+			break;
+		}
+
+		type = data[1];
+
+		switch (type) {
+		case BT_DATA_UUID16_SOME:
+		case BT_DATA_UUID16_ALL:
+			uuid_ok = uuid_ok || uuid16_match(&data[2],
+							  field_len - 1);
+			break;
+		case BT_DATA_MANUFACTURER_DATA:
+			company_ok = company_ok ||
+				     company_id_match(&data[2], field_len - 1);
+			break;
+		default:
+			break;
+		}
+
+		data += field_len + 1;
+		len -= field_len + 1;
+	}
+
+	return uuid_ok && company_ok;
+}
+
+bool bt_scan_filter_report(const bt_addr_le_t *addr,
+			   const struct bt_le_scan_recv_info *info,
+			   const uint8_t *data, uint8_t len)
+{
+	if (!filter_enabled) {
+		return true;
+	}
+
+	if (filter.rssi_min && info->rssi != BT_GAP_RSSI_INVALID &&
+	    info->rssi < filter.rssi_min) {
+		BT_DBG("Dropped weak report (rssi %d)", info->rssi);
+		return false;
+	}
+
+	/* Fragments of extended advertising data can not be checked on their
+	 * own and are always delivered.
+	 */
+	if (BT_HCI_LE_ADV_EVT_TYPE_DATA_STATUS(info->adv_props) !=
+	    BT_HCI_LE_ADV_EVT_TYPE_DATA_STATUS_COMPLETE) {
+		return true;
+	}
+
+	if ((filter.uuid16_count || filter.company_id_count) &&
+	    !data_match(data, len)) {
+		return false;
+	}
+
+	if (filter.dedup_window &&
+	    is_duplicate(addr, info->adv_type, data, len)) {
+		BT_DBG("Dropped duplicate report");
+		return false;
+	}
+
+	return true;
+}
+
+bool bt_scan_filter_addr(const bt_addr_le_t *id_addr)
+{
+	int i;
+
+	if (!filter_enabled || !filter.addr_count) {
+		return true;
+	}
+
+	for (i = 0; i < filter.addr_count; i++) {
+		if (!bt_addr_le_cmp(&filter.addrs[i], id_addr)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int bt_le_scan_filter_set(const struct bt_le_scan_filter *param)
+{
+	if (atomic_test_bit(bt_dev.flags, BT_DEV_SCANNING)) {
+		return -EBUSY;
+	}
+
+	if (!param) {
+		filter_enabled = false;
+		return 0;
+	}
+
+	if ((param->addr_count && !param->addrs) ||
+	    (param->uuid16_count && !param->uuid16s) ||
+	    (param->company_id_count && !param->company_ids)) {
+		return -EINVAL;
+	}
+
+	filter = *param;
+	filter_enabled = true;
+
+	(void)memset(dedup, 0, sizeof(dedup));
+	dedup_next = 0U;
+
+	return 0;
+}
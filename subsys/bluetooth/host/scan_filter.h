@@ -0,0 +1,19 @@
+/* scan_filter.h - Host side scan report filtering */
+
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Check report contents: RSSI, duplicates and advertising data.
+ * Returns true if the report should be delivered.
+ */
+bool bt_scan_filter_report(const bt_addr_le_t *addr,
+			   const struct bt_le_scan_recv_info *info,
+			   const uint8_t *data, uint8_t len);
+
+/* Check the (identity) address of a report which passed
+ * bt_scan_filter_report(). Returns true if the report should be delivered.
+ */
+bool bt_scan_filter_addr(const bt_addr_le_t *id_addr);
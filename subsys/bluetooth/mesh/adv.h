@@ -29,7 +29,8 @@ struct bt_mesh_adv {
 	void *cb_data;
 
 	uint8_t      type:2,
-		  busy:1;
+		  busy:1,
+		  relay:1;
 	uint8_t      xmit;
 };
 
@@ -49,6 +50,35 @@ void bt_mesh_adv_send(struct net_buf *buf, const struct bt_mesh_send_cb *cb,
 
 void bt_mesh_adv_update(void);
 
+/* Interface between the common code in adv.c and the bearer backend
+ * (adv_legacy.c or adv_ext.c).
+ */
+struct net_buf *bt_mesh_adv_buf_get(k_timeout_t timeout);
+
+struct net_buf *bt_mesh_adv_relay_buf_get(k_timeout_t timeout);
+
+void bt_mesh_adv_buf_get_cancel(void);
+
+void bt_mesh_adv_buf_ready(void);
+
+static inline void bt_mesh_adv_send_start(uint16_t duration, int err,
+					  const struct bt_mesh_send_cb *cb,
+					  void *cb_data)
+{
+	if (cb && cb->start) {
+		cb->start(duration, err, cb_data);
+	}
+}
+
+static inline void bt_mesh_adv_send_end(int err,
+					const struct bt_mesh_send_cb *cb,
+					void *cb_data)
+{
+	if (cb && cb->end) {
+		cb->end(err, cb_data);
+	}
+}
+
 void bt_mesh_adv_init(void);
 
 int bt_mesh_scan_enable(void);
@@ -0,0 +1,272 @@
+/*  Bluetooth Mesh */
+
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/util.h>
+#include <sys/atomic.h>
+
+#include <net/buf.h>
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/hci.h>
+#include <bluetooth/conn.h>
+#include <bluetooth/mesh.h>
+
+#define BT_DBG_ENABLED IS_ENABLED(CONFIG_BT_MESH_DEBUG_ADV)
+#define LOG_MODULE_NAME bt_mesh_adv_ext
+#include "common/log.h"
+
+#include "adv.h"
+#include "net.h"
+#include "proxy.h"
+
+/* Convert from ms to 0.625ms units */
+#define ADV_SCAN_UNIT(_ms) ((_ms) * 8 / 5)
+
+/* Extended advertising requires a 5.0+ controller, which can go down to
+ * 20ms.
+ */
+#define ADV_INT_FAST_MS 20
+
+#if defined(CONFIG_BT_MESH_ADV_EXT_RELAY)
+#define ADV_SET_COUNT 2
+#else
+#define ADV_SET_COUNT 1
+#endif
+
+/* Connectable proxy advertising uses the legacy advertiser, which also
+ * takes up one of the advertising sets.
+ */
+BUILD_ASSERT(CONFIG_BT_EXT_ADV_MAX_ADV_SET >=
+	     ADV_SET_COUNT + IS_ENABLED(CONFIG_BT_MESH_PROXY),
+	     "Not enough advertising sets for Mesh");
+
+enum {
+	/* A message is being sent by the controller */
+	ADV_FLAG_ACTIVE,
+	/* The controller has finished sending the active message */
+	ADV_FLAG_SENT,
+
+	ADV_FLAGS_NUM,
+};
+
+/* Each set is driven by a work item: the controller performs all the
+ * retransmissions of a message on its own (the number of advertising
+ * events is given when starting), and the sent callback kicks the work
+ * item to start the next one. No advertising is ever stopped by the host.
+ */
+struct ext_adv {
+	struct bt_le_ext_adv *instance;
+	struct net_buf *(*buf_get)(k_timeout_t timeout);
+	const struct bt_mesh_send_cb *cb;
+	void *cb_data;
+	uint16_t adv_int;
+	struct k_work work;
+	ATOMIC_DEFINE(flags, ADV_FLAGS_NUM);
+};
+
+static struct ext_adv adv_sets[ADV_SET_COUNT];
+
+#if defined(CONFIG_BT_MESH_PROXY)
+static struct k_delayed_work proxy_work;
+#endif
+
+static void adv_sent(struct bt_le_ext_adv *instance,
+		     struct bt_le_ext_adv_sent_info *info)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(adv_sets); i++) {
+		struct ext_adv *adv = &adv_sets[i];
+
+		if (adv->instance != instance) {
+			continue;
+		}
+
+		if (atomic_test_bit(adv->flags, ADV_FLAG_ACTIVE)) {
+			atomic_set_bit(adv->flags, ADV_FLAG_SENT);
+			k_work_submit(&adv->work);
+		}
+
+		return;
+	}
+}
+
+static const struct bt_le_ext_adv_cb adv_cb = {
+	.sent = adv_sent,
+};
+
+static void adv_param_init(struct bt_le_adv_param *param, uint16_t adv_int)
+{
+	(void)memset(param, 0, sizeof(*param));
+
+	/* Mesh messages are legacy non-connectable advertising PDUs */
+	if (IS_ENABLED(CONFIG_BT_MESH_DEBUG_USE_ID_ADDR)) {
+		param->options = BT_LE_ADV_OPT_USE_IDENTITY;
+	}
+
+	param->id = BT_ID_DEFAULT;
+	param->interval_min = ADV_SCAN_UNIT(adv_int);
+	param->interval_max = param->interval_min;
+}
+
+static int adv_start(struct ext_adv *adv, struct net_buf *buf)
+{
+	static const uint8_t adv_type[] = {
+		[BT_MESH_ADV_PROV]   = BT_DATA_MESH_PROV,
+		[BT_MESH_ADV_DATA]   = BT_DATA_MESH_MESSAGE,
+		[BT_MESH_ADV_BEACON] = BT_DATA_MESH_BEACON,
+		[BT_MESH_ADV_URI]    = BT_DATA_URI,
+	};
+	struct bt_le_ext_adv_start_param start = {};
+	struct bt_le_adv_param param;
+	uint16_t duration, adv_int;
+	struct bt_data ad;
+	int err;
+
+	adv_int = MAX(ADV_INT_FAST_MS,
+		      BT_MESH_TRANSMIT_INT(BT_MESH_ADV(buf)->xmit));
+	start.num_events = BT_MESH_TRANSMIT_COUNT(BT_MESH_ADV(buf)->xmit) + 1;
+	duration = start.num_events * (adv_int + 10);
+
+	BT_DBG("type %u len %u: %s", BT_MESH_ADV(buf)->type,
+	       buf->len, bt_hex(buf->data, buf->len));
+	BT_DBG("count %u interval %ums duration %ums", start.num_events,
+	       adv_int, duration);
+
+	adv->cb = BT_MESH_ADV(buf)->cb;
+	adv->cb_data = BT_MESH_ADV(buf)->cb_data;
+
+	ad.type = adv_type[BT_MESH_ADV(buf)->type];
+	ad.data_len = buf->len;
+	ad.data = buf->data;
+
+	/* Only touch the parameters when the interval changes */
+	if (!adv->instance) {
+		adv_param_init(&param, adv_int);
+		err = bt_le_ext_adv_create(&param, &adv_cb, &adv->instance);
+		if (err) {
+			BT_ERR("Creating advertising set failed (err %d)", err);
+			goto done;
+		}
+
+		adv->adv_int = adv_int;
+	} else if (adv->adv_int != adv_int) {
+		adv_param_init(&param, adv_int);
+		err = bt_le_ext_adv_update_param(adv->instance, &param);
+		if (err) {
+			BT_ERR("Updating advertising parameters failed (err %d)",
+			       err);
+			goto done;
+		}
+
+		adv->adv_int = adv_int;
+	}
+
+	err = bt_le_ext_adv_set_data(adv->instance, &ad, 1, NULL, 0);
+	if (err) {
+		BT_ERR("Setting advertising data failed (err %d)", err);
+		goto done;
+	}
+
+	atomic_set_bit(adv->flags, ADV_FLAG_ACTIVE);
+
+	err = bt_le_ext_adv_start(adv->instance, &start);
+	if (err) {
+		BT_ERR("Advertising failed: err %d", err);
+		atomic_clear_bit(adv->flags, ADV_FLAG_ACTIVE);
+	}
+
+done:
+	net_buf_unref(buf);
+	bt_mesh_adv_send_start(duration, err, adv->cb, adv->cb_data);
+
+	return err;
+}
+
+static void adv_work_handler(struct k_work *work)
+{
+	struct ext_adv *adv = CONTAINER_OF(work, struct ext_adv, work);
+	struct net_buf *buf;
+
+	if (atomic_test_and_clear_bit(adv->flags, ADV_FLAG_SENT)) {
+		BT_DBG("Advertising done");
+		atomic_clear_bit(adv->flags, ADV_FLAG_ACTIVE);
+		bt_mesh_adv_send_end(0, adv->cb, adv->cb_data);
+	}
+
+	if (atomic_test_bit(adv->flags, ADV_FLAG_ACTIVE)) {
+		return;
+	}
+
+	while ((buf = adv->buf_get(K_NO_WAIT))) {
+		/* busy == 0 means this was canceled */
+		if (!BT_MESH_ADV(buf)->busy) {
+			net_buf_unref(buf);
+			continue;
+		}
+
+		BT_MESH_ADV(buf)->busy = 0U;
+
+		if (!adv_start(adv, buf)) {
+			return;
+		}
+	}
+}
+
+#if defined(CONFIG_BT_MESH_PROXY)
+static void proxy_work_handler(struct k_work *work)
+{
+	k_timeout_t timeout;
+
+	bt_mesh_proxy_adv_stop();
+
+	timeout = bt_mesh_proxy_adv_start();
+	BT_DBG("Proxy Advertising");
+
+	if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		k_delayed_work_submit(&proxy_work, timeout);
+	}
+}
+#endif
+
+void bt_mesh_adv_update(void)
+{
+	BT_DBG("");
+
+#if defined(CONFIG_BT_MESH_PROXY)
+	k_delayed_work_submit(&proxy_work, K_NO_WAIT);
+#endif
+}
+
+void bt_mesh_adv_buf_ready(void)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(adv_sets); i++) {
+		k_work_submit(&adv_sets[i].work);
+	}
+}
+
+void bt_mesh_adv_init(void)
+{
+	int i;
+
+	adv_sets[0].buf_get = bt_mesh_adv_buf_get;
+#if defined(CONFIG_BT_MESH_ADV_EXT_RELAY)
+	adv_sets[1].buf_get = bt_mesh_adv_relay_buf_get;
+#endif
+
+	for (i = 0; i < ARRAY_SIZE(adv_sets); i++) {
+		k_work_init(&adv_sets[i].work, adv_work_handler);
+	}
+
+#if defined(CONFIG_BT_MESH_PROXY)
+	k_delayed_work_init(&proxy_work, proxy_work_handler);
+	k_delayed_work_submit(&proxy_work, K_NO_WAIT);
+#endif
+}
@@ -70,9 +70,25 @@ static struct friend_cred friend_cred[FRIEND_CRED_COUNT];
 static struct {
 	uint32_t src : 15, /* MSb of source is always 0 */
 	      seq : 17;
+	uint16_t next;     /* Next entry in the hash chain + 1, 0 ends it */
 } msg_cache[CONFIG_BT_MESH_MSG_CACHE_SIZE];
 static uint16_t msg_cache_next;
 
+/* Hash chain heads for the message cache, entry index + 1 */
+static uint16_t msg_cache_hash[CONFIG_BT_MESH_MSG_CACHE_SIZE];
+
+#define MSG_CACHE_HASH(src, seq) (((src) ^ (seq)) % ARRAY_SIZE(msg_cache_hash))
+
+/* Hash chain heads and links for the Replay Protection List, entry
+ * index + 1. The used entries of bt_mesh.rpl[] are kept at the start of
+ * the array, so rpl_count is also the next free slot.
+ */
+static uint16_t rpl_hash[CONFIG_BT_MESH_CRPL];
+static uint16_t rpl_next[CONFIG_BT_MESH_CRPL];
+static uint16_t rpl_count;
+
+#define RPL_HASH(src) ((src) % ARRAY_SIZE(rpl_hash))
+
 /* Singleton network context (the implementation only supports one) */
 struct bt_mesh_net bt_mesh = {
 	.local_queue = SYS_SLIST_STATIC_INIT(&bt_mesh.local_queue),
@@ -114,11 +130,14 @@ static bool check_dup(struct net_buf_simple *data)
 static bool msg_cache_match(struct bt_mesh_net_rx *rx,
 			    struct net_buf_simple *pdu)
 {
+	uint16_t src = SRC(pdu->data);
+	uint32_t seq = SEQ(pdu->data) & BIT_MASK(17);
 	uint16_t i;
 
-	for (i = 0U; i < ARRAY_SIZE(msg_cache); i++) {
-		if (msg_cache[i].src == SRC(pdu->data) &&
-		    msg_cache[i].seq == (SEQ(pdu->data) & BIT_MASK(17))) {
+	for (i = msg_cache_hash[MSG_CACHE_HASH(src, seq)]; i;
+	     i = msg_cache[i - 1].next) {
+		if (msg_cache[i - 1].src == src &&
+		    msg_cache[i - 1].seq == seq) {
 			return true;
 		}
 	}
@@ -126,12 +145,45 @@ static bool msg_cache_match(struct bt_mesh_net_rx *rx,
 	return false;
 }
 
+static void msg_cache_remove(uint16_t idx)
+{
+	uint16_t *link;
+
+	if (msg_cache[idx].src == BT_MESH_ADDR_UNASSIGNED) {
+		return;
+	}
+
+	link = &msg_cache_hash[MSG_CACHE_HASH(msg_cache[idx].src,
+					      msg_cache[idx].seq)];
+	while (*link) {
+		if (*link - 1 == idx) {
+			*link = msg_cache[idx].next;
+			break;
+		}
+
+		link = &msg_cache[*link - 1].next;
+	}
+
+	msg_cache[idx].src = BT_MESH_ADDR_UNASSIGNED;
+}
+
 static void msg_cache_add(struct bt_mesh_net_rx *rx)
 {
+	uint16_t hash;
+
 	rx->msg_cache_idx = msg_cache_next++;
+	msg_cache_next %= ARRAY_SIZE(msg_cache);
+
+	/* Evict the oldest entry from its hash chain */
+	msg_cache_remove(rx->msg_cache_idx);
+
 	msg_cache[rx->msg_cache_idx].src = rx->ctx.addr;
 	msg_cache[rx->msg_cache_idx].seq = rx->seq;
-	msg_cache_next %= ARRAY_SIZE(msg_cache);
+
+	hash = MSG_CACHE_HASH(msg_cache[rx->msg_cache_idx].src,
+			      msg_cache[rx->msg_cache_idx].seq);
+	msg_cache[rx->msg_cache_idx].next = msg_cache_hash[hash];
+	msg_cache_hash[hash] = rx->msg_cache_idx + 1;
 }
 
 struct bt_mesh_subnet *bt_mesh_subnet_get(uint16_t net_idx)
@@ -431,6 +483,7 @@ int bt_mesh_net_create(uint16_t idx, uint8_t flags, const uint8_t key[16],
 	BT_DBG("NetKey %s", bt_hex(key, 16));
 
 	(void)memset(msg_cache, 0, sizeof(msg_cache));
+	(void)memset(msg_cache_hash, 0, sizeof(msg_cache_hash));
 	msg_cache_next = 0U;
 
 	sub = &bt_mesh.sub[0];
@@ -546,6 +599,72 @@ bool bt_mesh_kr_update(struct bt_mesh_subnet *sub, uint8_t new_kr, bool new_key)
 	return false;
 }
 
+struct bt_mesh_rpl *bt_mesh_rpl_find(uint16_t src)
+{
+	uint16_t i;
+
+	for (i = rpl_hash[RPL_HASH(src)]; i; i = rpl_next[i - 1]) {
+		if (bt_mesh.rpl[i - 1].src == src) {
+			return &bt_mesh.rpl[i - 1];
+		}
+	}
+
+	return NULL;
+}
+
+struct bt_mesh_rpl *bt_mesh_rpl_next_free(void)
+{
+	if (rpl_count == ARRAY_SIZE(bt_mesh.rpl)) {
+		return NULL;
+	}
+
+	return &bt_mesh.rpl[rpl_count];
+}
+
+struct bt_mesh_rpl *bt_mesh_rpl_alloc(uint16_t src)
+{
+	struct bt_mesh_rpl *rpl;
+	uint16_t hash = RPL_HASH(src);
+
+	rpl = bt_mesh_rpl_next_free();
+	if (!rpl) {
+		return NULL;
+	}
+
+	rpl->src = src;
+	rpl_next[rpl_count] = rpl_hash[hash];
+	rpl_hash[hash] = ++rpl_count;
+
+	return rpl;
+}
+
+void bt_mesh_rpl_index_rebuild(void)
+{
+	uint16_t i;
+
+	(void)memset(rpl_hash, 0, sizeof(rpl_hash));
+	rpl_count = 0U;
+
+	for (i = 0U; i < ARRAY_SIZE(bt_mesh.rpl); i++) {
+		struct bt_mesh_rpl *rpl = &bt_mesh.rpl[i];
+		uint16_t hash;
+
+		if (!rpl->src) {
+			continue;
+		}
+
+		/* Close the gaps left by removed entries */
+		if (i != rpl_count) {
+			bt_mesh.rpl[rpl_count] = *rpl;
+			(void)memset(rpl, 0, sizeof(*rpl));
+		}
+
+		hash = RPL_HASH(bt_mesh.rpl[rpl_count].src);
+		rpl_next[rpl_count] = rpl_hash[hash];
+		rpl_hash[hash] = ++rpl_count;
+	}
+}
+
 void bt_mesh_rpl_reset(void)
 {
 	int i;
@@ -564,6 +683,8 @@ void bt_mesh_rpl_reset(void)
 			}
 		}
 	}
+
+	bt_mesh_rpl_index_rebuild();
 }
 
 #if defined(CONFIG_BT_MESH_IV_UPDATE_TEST)
@@ -642,6 +763,7 @@ bool bt_mesh_net_iv_update(uint32_t iv_index, bool iv_update)
 		if (iv_index > bt_mesh.iv_index + 1) {
 			BT_WARN("Performing IV Index Recovery");
 			(void)memset(bt_mesh.rpl, 0, sizeof(bt_mesh.rpl));
+			bt_mesh_rpl_index_rebuild();
 			bt_mesh.iv_index = iv_index;
 			bt_mesh.seq = 0U;
 			goto do_update;
@@ -950,89 +1072,235 @@ static int net_decrypt(struct bt_mesh_subnet *sub, const uint8_t *enc,
 	return bt_mesh_net_decrypt(enc, buf, BT_MESH_NET_IVI_RX(rx), false);
 }
 
-static int friend_decrypt(struct bt_mesh_subnet *sub, const uint8_t *data,
-			  size_t data_len, struct bt_mesh_net_rx *rx,
-			  struct net_buf_simple *buf)
+/* Network credential candidates (subnet keys and friendship credentials),
+ * chained per NID so that a received PDU is only tried against the
+ * credentials that can match it. The index is maintained lazily: entries
+ * are validated before use, and a credential only found by the full scan
+ * triggers a rebuild.
+ */
+#define NET_CAND_COUNT (2 * (CONFIG_BT_MESH_SUBNET_COUNT + FRIEND_CRED_COUNT))
+
+static struct net_cand {
+	struct bt_mesh_subnet *sub;
+	struct friend_cred *cred; /* NULL for the subnet's own keys */
+	uint8_t idx;              /* 1 for the Key Refresh key */
+	uint16_t next;            /* Next candidate + 1, 0 ends the chain */
+} net_cand[NET_CAND_COUNT];
+
+/* Chain heads per NID, candidate index + 1 */
+static uint16_t net_cand_nid[BIT(7)];
+static uint16_t net_cand_tail[BIT(7)];
+static uint16_t net_cand_count;
+
+typedef bool (*net_cand_func_t)(struct bt_mesh_subnet *sub,
+				struct friend_cred *cred, uint8_t idx,
+				void *user_data);
+
+static uint8_t net_cand_get_nid(struct bt_mesh_subnet *sub,
+				struct friend_cred *cred, uint8_t idx)
 {
-	int i;
+	return cred ? cred->cred[idx].nid : sub->keys[idx].nid;
+}
 
-	BT_DBG("NID 0x%02x net_idx 0x%04x", NID(data), sub->net_idx);
+static bool net_cand_valid(struct bt_mesh_subnet *sub,
+			   struct friend_cred *cred, uint8_t idx)
+{
+	if (sub->net_idx == BT_MESH_KEY_UNUSED) {
+		return false;
+	}
 
-	for (i = 0; i < ARRAY_SIZE(friend_cred); i++) {
-		struct friend_cred *cred = &friend_cred[i];
+	if (cred && cred->net_idx != sub->net_idx) {
+		return false;
+	}
 
-		if (cred->net_idx != sub->net_idx) {
+	return (idx == 0U || sub->kr_phase != BT_MESH_KR_NORMAL);
+}
+
+/* Visit all usable credentials in the order they are tried in: friendship
+ * credentials of a subnet first, then its own keys.
+ */
+static bool net_cand_foreach(net_cand_func_t func, void *user_data)
+{
+	int i, j;
+
+	for (i = 0; i < ARRAY_SIZE(bt_mesh.sub); i++) {
+		struct bt_mesh_subnet *sub = &bt_mesh.sub[i];
+
+		if (sub->net_idx == BT_MESH_KEY_UNUSED) {
 			continue;
 		}
 
-		if (NID(data) == cred->cred[0].nid &&
-		    !net_decrypt(sub, cred->cred[0].enc, cred->cred[0].privacy,
-				 data, data_len, rx, buf)) {
-			return 0;
+		for (j = 0; j < ARRAY_SIZE(friend_cred); j++) {
+			struct friend_cred *cred = &friend_cred[j];
+
+			if (cred->net_idx != sub->net_idx) {
+				continue;
+			}
+
+			if (func(sub, cred, 0, user_data)) {
+				return true;
+			}
+
+			if (sub->kr_phase != BT_MESH_KR_NORMAL &&
+			    func(sub, cred, 1, user_data)) {
+				return true;
+			}
 		}
 
-		if (sub->kr_phase == BT_MESH_KR_NORMAL) {
-			continue;
+		if (func(sub, NULL, 0, user_data)) {
+			return true;
 		}
 
-		if (NID(data) == cred->cred[1].nid &&
-		    !net_decrypt(sub, cred->cred[1].enc, cred->cred[1].privacy,
-				 data, data_len, rx, buf)) {
-			rx->new_key = 1U;
-			return 0;
+		if (sub->kr_phase != BT_MESH_KR_NORMAL &&
+		    func(sub, NULL, 1, user_data)) {
+			return true;
 		}
 	}
 
-	return -ENOENT;
+	return false;
 }
 
-static bool net_find_and_decrypt(const uint8_t *data, size_t data_len,
-				 struct bt_mesh_net_rx *rx,
-				 struct net_buf_simple *buf)
+static bool net_cand_add(struct bt_mesh_subnet *sub, struct friend_cred *cred,
+			 uint8_t idx, void *user_data)
 {
-	struct bt_mesh_subnet *sub;
-	int i;
+	uint8_t nid = net_cand_get_nid(sub, cred, idx);
+	struct net_cand *cand;
 
+	if (net_cand_count == ARRAY_SIZE(net_cand)) {
+		return true;
+	}
+
+	cand = &net_cand[net_cand_count++];
+	cand->sub = sub;
+	cand->cred = cred;
+	cand->idx = idx;
+	cand->next = 0U;
+
+	if (net_cand_tail[nid]) {
+		net_cand[net_cand_tail[nid] - 1].next = net_cand_count;
+	} else {
+		net_cand_nid[nid] = net_cand_count;
+	}
+
+	net_cand_tail[nid] = net_cand_count;
+
+	return false;
+}
+
+static void net_cand_rebuild(void)
+{
 	BT_DBG("");
 
-	for (i = 0; i < ARRAY_SIZE(bt_mesh.sub); i++) {
-		sub = &bt_mesh.sub[i];
-		if (sub->net_idx == BT_MESH_KEY_UNUSED) {
-			continue;
-		}
+	(void)memset(net_cand_nid, 0, sizeof(net_cand_nid));
+	(void)memset(net_cand_tail, 0, sizeof(net_cand_tail));
+	net_cand_count = 0U;
 
-		if ((IS_ENABLED(CONFIG_BT_MESH_LOW_POWER) ||
-		     IS_ENABLED(CONFIG_BT_MESH_FRIEND)) &&
-		    !friend_decrypt(sub, data, data_len, rx, buf)) {
-			rx->friend_cred = 1U;
-			rx->ctx.net_idx = sub->net_idx;
-			rx->sub = sub;
-			return true;
-		}
+	net_cand_foreach(net_cand_add, NULL);
+}
+
+static bool net_cand_indexed(struct bt_mesh_subnet *sub,
+			     struct friend_cred *cred, uint8_t idx,
+			     uint8_t nid)
+{
+	uint16_t i;
 
-		if (NID(data) == sub->keys[0].nid &&
-		    !net_decrypt(sub, sub->keys[0].enc, sub->keys[0].privacy,
-				 data, data_len, rx, buf)) {
-			rx->ctx.net_idx = sub->net_idx;
-			rx->sub = sub;
+	for (i = net_cand_nid[nid]; i; i = net_cand[i - 1].next) {
+		if (net_cand[i - 1].sub == sub && net_cand[i - 1].cred == cred &&
+		    net_cand[i - 1].idx == idx) {
 			return true;
 		}
+	}
 
-		if (sub->kr_phase == BT_MESH_KR_NORMAL) {
+	return false;
+}
+
+struct net_cand_decrypt {
+	const uint8_t *data;
+	size_t data_len;
+	struct bt_mesh_net_rx *rx;
+	struct net_buf_simple *buf;
+	bool skip_indexed;
+};
+
+static bool net_cand_decrypt(struct bt_mesh_subnet *sub,
+			     struct friend_cred *cred, uint8_t idx,
+			     void *user_data)
+{
+	struct net_cand_decrypt *dec = user_data;
+	uint8_t nid = NID(dec->data);
+	const uint8_t *enc, *priv;
+
+	if (net_cand_get_nid(sub, cred, idx) != nid) {
+		return false;
+	}
+
+	/* Already tried from the index */
+	if (dec->skip_indexed && net_cand_indexed(sub, cred, idx, nid)) {
+		return false;
+	}
+
+	if (cred) {
+		enc = cred->cred[idx].enc;
+		priv = cred->cred[idx].privacy;
+	} else {
+		enc = sub->keys[idx].enc;
+		priv = sub->keys[idx].privacy;
+	}
+
+	if (net_decrypt(sub, enc, priv, dec->data, dec->data_len, dec->rx,
+			dec->buf)) {
+		return false;
+	}
+
+	if (idx) {
+		dec->rx->new_key = 1U;
+	}
+
+	if (cred) {
+		dec->rx->friend_cred = 1U;
+	}
+
+	dec->rx->ctx.net_idx = sub->net_idx;
+	dec->rx->sub = sub;
+
+	return true;
+}
+
+static bool net_find_and_decrypt(const uint8_t *data, size_t data_len,
+				 struct bt_mesh_net_rx *rx,
+				 struct net_buf_simple *buf)
+{
+	struct net_cand_decrypt dec = {
+		.data = data,
+		.data_len = data_len,
+		.rx = rx,
+		.buf = buf,
+	};
+	uint16_t i;
+
+	BT_DBG("");
+
+	for (i = net_cand_nid[NID(data)]; i; i = net_cand[i - 1].next) {
+		struct net_cand *cand = &net_cand[i - 1];
+
+		if (!net_cand_valid(cand->sub, cand->cred, cand->idx)) {
 			continue;
 		}
 
-		if (NID(data) == sub->keys[1].nid &&
-		    !net_decrypt(sub, sub->keys[1].enc, sub->keys[1].privacy,
-				 data, data_len, rx, buf)) {
-			rx->new_key = 1U;
-			rx->ctx.net_idx = sub->net_idx;
-			rx->sub = sub;
+		if (net_cand_decrypt(cand->sub, cand->cred, cand->idx, &dec)) {
 			return true;
 		}
 	}
 
-	return false;
+	/* Credentials may have been added since the index was built */
+	dec.skip_indexed = true;
+	if (!net_cand_foreach(net_cand_decrypt, &dec)) {
+		return false;
+	}
+
+	net_cand_rebuild();
+
+	return true;
 }
 
 /* Relaying from advertising to the advertising bearer should only happen
@@ -1102,6 +1370,8 @@ static void bt_mesh_net_relay(struct net_buf_simple *sbuf,
 		return;
 	}
 
+	BT_MESH_ADV(buf)->relay = (rx->net_if != BT_MESH_NET_IF_LOCAL);
+
 	/* Only decrement TTL for non-locally originated packets */
 	if (rx->net_if != BT_MESH_NET_IF_LOCAL) {
 		/* Leave CTL bit intact */
@@ -1271,7 +1541,7 @@ void bt_mesh_net_recv(struct net_buf_simple *data, int8_t rssi,
 	 */
 	if (bt_mesh_trans_recv(&buf, &rx) == -EAGAIN) {
 		BT_WARN("Removing rejected message from Network Message Cache");
-		msg_cache[rx.msg_cache_idx].src = BT_MESH_ADDR_UNASSIGNED;
+		msg_cache_remove(rx.msg_cache_idx);
 		/* Rewind the next index now that we're not using this entry */
 		msg_cache_next = rx.msg_cache_idx;
 	}
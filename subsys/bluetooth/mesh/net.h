@@ -318,6 +318,14 @@ void bt_mesh_net_revoke_keys(struct bt_mesh_subnet *sub);
 
 int bt_mesh_net_beacon_update(struct bt_mesh_subnet *sub);
 
+struct bt_mesh_rpl *bt_mesh_rpl_find(uint16_t src);
+
+struct bt_mesh_rpl *bt_mesh_rpl_next_free(void);
+
+struct bt_mesh_rpl *bt_mesh_rpl_alloc(uint16_t src);
+
+void bt_mesh_rpl_index_rebuild(void);
+
 void bt_mesh_rpl_reset(void);
 
 bool bt_mesh_net_iv_update(uint32_t iv_index, bool iv_update);
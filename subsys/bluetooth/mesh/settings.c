@@ -280,33 +280,6 @@ static int seq_set(const char *name, size_t len_rd, settings_read_cb read_cb,
 	return 0;
 }
 
-static struct bt_mesh_rpl *rpl_find(uint16_t src)
-{
-	int i;
-
-	for (i = 0; i < ARRAY_SIZE(bt_mesh.rpl); i++) {
-		if (bt_mesh.rpl[i].src == src) {
-			return &bt_mesh.rpl[i];
-		}
-	}
-
-	return NULL;
-}
-
-static struct bt_mesh_rpl *rpl_alloc(uint16_t src)
-{
-	int i;
-
-	for (i = 0; i < ARRAY_SIZE(bt_mesh.rpl); i++) {
-		if (!bt_mesh.rpl[i].src) {
-			bt_mesh.rpl[i].src = src;
-			return &bt_mesh.rpl[i];
-		}
-	}
-
-	return NULL;
-}
-
 static int rpl_set(const char *name, size_t len_rd,
 		   settings_read_cb read_cb, void *cb_arg)
 {
@@ -321,12 +294,13 @@ static int rpl_set(const char *name, size_t len_rd,
 	}
 
 	src = strtol(name, NULL, 16);
-	entry = rpl_find(src);
+	entry = bt_mesh_rpl_find(src);
 
 	if (len_rd == 0) {
 		BT_DBG("val (null)");
 		if (entry) {
 			(void)memset(entry, 0, sizeof(*entry));
+			bt_mesh_rpl_index_rebuild();
 		} else {
 			BT_WARN("Unable to find RPL entry for 0x%04x", src);
 		}
@@ -335,7 +309,7 @@ static int rpl_set(const char *name, size_t len_rd,
 	}
 
 	if (!entry) {
-		entry = rpl_alloc(src);
+		entry = bt_mesh_rpl_alloc(src);
 		if (!entry) {
 			BT_ERR("Unable to allocate RPL entry for 0x%04x", src);
 			return -ENOMEM;
@@ -1373,6 +1347,8 @@ static void clear_rpl(void)
 
 		(void)memset(rpl, 0, sizeof(*rpl));
 	}
+
+	bt_mesh_rpl_index_rebuild();
 }
 
 static void store_pending_rpl(void)
@@ -1381,7 +1357,8 @@ static void store_pending_rpl(void)
 
 	BT_DBG("");
 
-	for (i = 0; i < ARRAY_SIZE(bt_mesh.rpl); i++) {
+	/* Used entries are kept at the start of the RPL */
+	for (i = 0; i < ARRAY_SIZE(bt_mesh.rpl) && bt_mesh.rpl[i].src; i++) {
 		struct bt_mesh_rpl *rpl = &bt_mesh.rpl[i];
 
 		if (rpl->store) {
@@ -2072,6 +2049,14 @@ static void store_pending(struct k_work *work)
 void bt_mesh_store_rpl(struct bt_mesh_rpl *entry)
 {
 	entry->store = true;
+
+	/* Already part of a scheduled flush, which stores every entry
+	 * flagged by then.
+	 */
+	if (atomic_test_bit(bt_mesh.flags, BT_MESH_RPL_PENDING)) {
+		return;
+	}
+
 	schedule_store(BT_MESH_RPL_PENDING);
 }
 
@@ -113,9 +113,13 @@ static struct seg_rx {
 	uint8_t                     ttl;
 	uint32_t                    block;
 	uint32_t                    last;
-	struct k_delayed_work    ack;
+	uint32_t                    ack_at;
+	bool                     ack_pending;
 } seg_rx[CONFIG_BT_MESH_RX_SEG_MSG_COUNT];
 
+/* A single timer sends the pending acks of all RX contexts */
+static struct k_delayed_work seg_ack_work;
+
 K_MEM_SLAB_DEFINE(segs, BT_MESH_APP_SEG_SDU_MAX, CONFIG_BT_MESH_SEG_BUFS, 4);
 
 static uint16_t hb_sub_dst = BT_MESH_ADDR_UNASSIGNED;
@@ -678,6 +682,17 @@ int bt_mesh_trans_send(struct bt_mesh_net_tx *tx, struct net_buf_simple *msg,
 
 static void update_rpl(struct bt_mesh_rpl *rpl, struct bt_mesh_net_rx *rx)
 {
+	/* A free slot handed out by is_replay() is only added to the RPL
+	 * index once the message it was reserved for has been accepted.
+	 */
+	if (!rpl->src) {
+		rpl = bt_mesh_rpl_alloc(rx->ctx.addr);
+		if (!rpl) {
+			BT_ERR("RPL is full!");
+			return;
+		}
+	}
+
 	rpl->src = rx->ctx.addr;
 	rpl->seq = rx->seq;
 	rpl->old_iv = rx->old_iv;
@@ -694,7 +709,7 @@ static void update_rpl(struct bt_mesh_rpl *rpl, struct bt_mesh_net_rx *rx)
  */
 static bool is_replay(struct bt_mesh_net_rx *rx, struct bt_mesh_rpl **match)
 {
-	int i;
+	struct bt_mesh_rpl *rpl;
 
 	/* Don't bother checking messages from ourselves */
 	if (rx->net_if == BT_MESH_NET_IF_LOCAL) {
@@ -706,11 +721,16 @@ static bool is_replay(struct bt_mesh_net_rx *rx, struct bt_mesh_rpl **match)
 		return false;
 	}
 
-	for (i = 0; i < ARRAY_SIZE(bt_mesh.rpl); i++) {
-		struct bt_mesh_rpl *rpl = &bt_mesh.rpl[i];
+	rpl = bt_mesh_rpl_find(rx->ctx.addr);
 
-		/* Empty slot */
-		if (!rpl->src) {
+	/* Existing slot for given address */
+	if (rpl) {
+		if (rx->old_iv && !rpl->old_iv) {
+			return true;
+		}
+
+		if ((!rx->old_iv && rpl->old_iv) ||
+		    rpl->seq < rx->seq) {
 			if (match) {
 				*match = rpl;
 			} else {
@@ -718,31 +738,25 @@ static bool is_replay(struct bt_mesh_net_rx *rx, struct bt_mesh_rpl **match)
 			}
 
 			return false;
+		} else {
+			return true;
 		}
+	}
 
-		/* Existing slot for given address */
-		if (rpl->src == rx->ctx.addr) {
-			if (rx->old_iv && !rpl->old_iv) {
-				return true;
-			}
-
-			if ((!rx->old_iv && rpl->old_iv) ||
-			    rpl->seq < rx->seq) {
-				if (match) {
-					*match = rpl;
-				} else {
-					update_rpl(rpl, rx);
-				}
+	/* Empty slot */
+	rpl = bt_mesh_rpl_next_free();
+	if (!rpl) {
+		BT_ERR("RPL is full!");
+		return true;
+	}
 
-				return false;
-			} else {
-				return true;
-			}
-		}
+	if (match) {
+		*match = rpl;
+	} else {
+		update_rpl(rpl, rx);
 	}
 
-	BT_ERR("RPL is full!");
-	return true;
+	return false;
 }
 
 static void seg_rx_assemble(struct seg_rx *rx, struct net_buf_simple *buf,
@@ -802,17 +816,15 @@ static int remote_devkey_decrypt(struct bt_mesh_net_rx *rx, uint32_t seq, uint8_
 	return 0;
 }
 
-static int app_key_decrypt(struct bt_mesh_net_rx *rx,
-			   struct bt_mesh_app_key *key, uint32_t seq, uint8_t *ad,
-			   uint8_t hdr, uint8_t aszmic, struct net_buf_simple *buf,
-			   struct net_buf_simple *sdu)
+static struct bt_mesh_app_keys *app_keys_match(struct bt_mesh_net_rx *rx,
+					       struct bt_mesh_app_key *key,
+					       uint8_t hdr)
 {
 	struct bt_mesh_app_keys *keys;
-	int err;
 
 	/* Check that this AppKey matches received net_idx */
 	if (key->net_idx != rx->sub->net_idx) {
-		return -EINVAL;
+		return NULL;
 	}
 
 	if (rx->new_key && key->updated) {
@@ -823,6 +835,22 @@ static int app_key_decrypt(struct bt_mesh_net_rx *rx,
 
 	/* Check that the AppKey ID matches */
 	if (AID(&hdr) != keys->id) {
+		return NULL;
+	}
+
+	return keys;
+}
+
+static int app_key_decrypt(struct bt_mesh_net_rx *rx,
+			   struct bt_mesh_app_key *key, uint32_t seq, uint8_t *ad,
+			   uint8_t hdr, uint8_t aszmic, struct net_buf_simple *buf,
+			   struct net_buf_simple *sdu)
+{
+	struct bt_mesh_app_keys *keys;
+	int err;
+
+	keys = app_keys_match(rx, key, hdr);
+	if (!keys) {
 		return -EINVAL;
 	}
 
@@ -924,6 +952,7 @@ static int sdu_recv_seg(struct seg_rx *seg, uint8_t hdr, uint8_t aszmic,
 	NET_BUF_SIMPLE_DEFINE(buf, BT_MESH_RX_SDU_MAX);
 	struct net_buf_simple sdu;
 	uint32_t seq = (seg->seq_auth & 0xffffff);
+	bool assembled = false;
 	uint8_t *ad;
 	uint16_t i;
 	int err;
@@ -949,7 +978,8 @@ static int sdu_recv_seg(struct seg_rx *seg, uint8_t hdr, uint8_t aszmic,
 
 	/* Decrypting in place to avoid creating two assembly buffers.
 	 * We'll reassemble the buffer from the segments before each decryption
-	 * attempt.
+	 * attempt that follows one which actually ran, and not at all for
+	 * keys that are ruled out by their AID or NetKey.
 	 */
 	if (!AKF(&hdr)) {
 		/* Attempt remote dev key first, as that is only available for
@@ -968,7 +998,11 @@ static int sdu_recv_seg(struct seg_rx *seg, uint8_t hdr, uint8_t aszmic,
 			return 0;
 		}
 
-		seg_rx_assemble(seg, &buf, aszmic);
+		/* -ENOENT means the remote DevKey was never tried */
+		if (err != -ENOENT) {
+			seg_rx_assemble(seg, &buf, aszmic);
+		}
+
 		net_buf_simple_init_with_data(&sdu, buf.data,
 					      seg->len - APP_MIC_LEN(aszmic));
 		sdu.len = 0;
@@ -990,7 +1024,15 @@ static int sdu_recv_seg(struct seg_rx *seg, uint8_t hdr, uint8_t aszmic,
 	for (i = 0U; i < ARRAY_SIZE(bt_mesh.app_keys); i++) {
 		struct bt_mesh_app_key *key = &bt_mesh.app_keys[i];
 
-		seg_rx_assemble(seg, &buf, aszmic);
+		if (!app_keys_match(rx, key, hdr)) {
+			continue;
+		}
+
+		if (!assembled) {
+			seg_rx_assemble(seg, &buf, aszmic);
+			assembled = true;
+		}
+
 		net_buf_simple_init_with_data(&sdu, buf.data,
 					      seg->len - APP_MIC_LEN(aszmic));
 		sdu.len = 0;
@@ -998,6 +1040,8 @@ static int sdu_recv_seg(struct seg_rx *seg, uint8_t hdr, uint8_t aszmic,
 		err = app_key_decrypt(rx, &bt_mesh.app_keys[i], seq, ad, hdr,
 				      aszmic, &buf, &sdu);
 		if (err) {
+			/* The failed attempt decrypted the buffer in place */
+			assembled = false;
 			continue;
 		}
 
@@ -1341,7 +1385,7 @@ static void seg_rx_reset(struct seg_rx *rx, bool full_reset)
 
 	BT_DBG("rx %p", rx);
 
-	k_delayed_work_cancel(&rx->ack);
+	rx->ack_pending = false;
 
 	if (IS_ENABLED(CONFIG_BT_MESH_FRIEND) && rx->obo &&
 	    rx->block != BLOCK_COMPLETE(rx->seg_n)) {
@@ -1373,27 +1417,68 @@ static void seg_rx_reset(struct seg_rx *rx, bool full_reset)
 	}
 }
 
-static void seg_ack(struct k_work *work)
+static void seg_ack_reschedule(void)
 {
-	struct seg_rx *rx = CONTAINER_OF(work, struct seg_rx, ack);
-
-	BT_DBG("rx %p", rx);
+	uint32_t now = k_uptime_get_32();
+	int32_t next = INT32_MAX;
+	int i;
 
-	if (k_uptime_get_32() - rx->last > (60 * MSEC_PER_SEC)) {
-		BT_WARN("Incomplete timer expired");
-		seg_rx_reset(rx, false);
+	for (i = 0; i < ARRAY_SIZE(seg_rx); i++) {
+		struct seg_rx *rx = &seg_rx[i];
 
-		if (IS_ENABLED(CONFIG_BT_TESTING)) {
-			bt_test_mesh_trans_incomp_timer_exp();
+		if (rx->ack_pending) {
+			next = MIN(next, MAX((int32_t)(rx->ack_at - now), 0));
 		}
+	}
 
+	if (next == INT32_MAX) {
+		k_delayed_work_cancel(&seg_ack_work);
 		return;
 	}
 
-	send_ack(rx->sub, rx->dst, rx->src, rx->ttl, &rx->seq_auth,
-		 rx->block, rx->obo);
+	k_delayed_work_submit(&seg_ack_work, K_MSEC(next));
+}
+
+static void seg_ack_start(struct seg_rx *rx)
+{
+	rx->ack_at = k_uptime_get_32() + ack_timeout(rx);
+	rx->ack_pending = true;
+
+	seg_ack_reschedule();
+}
+
+static void seg_ack(struct k_work *work)
+{
+	uint32_t now = k_uptime_get_32();
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(seg_rx); i++) {
+		struct seg_rx *rx = &seg_rx[i];
+
+		if (!rx->ack_pending || (int32_t)(rx->ack_at - now) > 0) {
+			continue;
+		}
+
+		BT_DBG("rx %p", rx);
+
+		if (now - rx->last > (60 * MSEC_PER_SEC)) {
+			BT_WARN("Incomplete timer expired");
+			seg_rx_reset(rx, false);
 
-	k_delayed_work_submit(&rx->ack, K_MSEC(ack_timeout(rx)));
+			if (IS_ENABLED(CONFIG_BT_TESTING)) {
+				bt_test_mesh_trans_incomp_timer_exp();
+			}
+
+			continue;
+		}
+
+		send_ack(rx->sub, rx->dst, rx->src, rx->ttl, &rx->seq_auth,
+			 rx->block, rx->obo);
+
+		rx->ack_at = now + ack_timeout(rx);
+	}
+
+	seg_ack_reschedule();
 }
 
 static inline bool sdu_len_is_ok(bool ctl, uint8_t seg_n)
@@ -1673,9 +1758,8 @@ found_rx:
 	/* Reset the Incomplete Timer */
 	rx->last = k_uptime_get_32();
 
-	if (!k_delayed_work_remaining_get(&rx->ack) &&
-	    !bt_mesh_lpn_established()) {
-		k_delayed_work_submit(&rx->ack, K_MSEC(ack_timeout(rx)));
+	if (!rx->ack_pending && !bt_mesh_lpn_established()) {
+		seg_ack_start(rx);
 	}
 
 	/* Allocated segment here */
@@ -1705,7 +1789,7 @@ found_rx:
 
 	*pdu_type = BT_MESH_FRIEND_PDU_COMPLETE;
 
-	k_delayed_work_cancel(&rx->ack);
+	rx->ack_pending = false;
 	send_ack(net_rx->sub, net_rx->ctx.recv_dst, net_rx->ctx.addr,
 		 net_rx->ctx.send_ttl, seq_auth, rx->block, rx->obo);
 
@@ -1826,6 +1910,7 @@ void bt_mesh_rx_reset(void)
 		bt_mesh_clear_rpl();
 	} else {
 		(void)memset(bt_mesh.rpl, 0, sizeof(bt_mesh.rpl));
+		bt_mesh_rpl_index_rebuild();
 	}
 }
 
@@ -1848,15 +1933,14 @@ void bt_mesh_trans_init(void)
 		k_delayed_work_init(&seg_tx[i].retransmit, seg_retransmit);
 	}
 
-	for (i = 0; i < ARRAY_SIZE(seg_rx); i++) {
-		k_delayed_work_init(&seg_rx[i].ack, seg_ack);
-	}
+	k_delayed_work_init(&seg_ack_work, seg_ack);
 }
 
 void bt_mesh_rpl_clear(void)
 {
 	BT_DBG("");
 	(void)memset(bt_mesh.rpl, 0, sizeof(bt_mesh.rpl));
+	bt_mesh_rpl_index_rebuild();
 }
 
 int bt_mesh_heartbeat_send(const struct bt_mesh_send_cb *cb, void *cb_data)
@@ -63,6 +63,11 @@ inline void canopen_od_unlock(void)
 	k_mutex_unlock(&canopen_co_mutex);
 }
 
+/* COB-IDs of the SYNC object and of the PDOs */
+#define CANOPEN_COB_ID_SYNC    0x080U
+#define CANOPEN_COB_ID_PDO_MIN 0x180U
+#define CANOPEN_COB_ID_PDO_MAX 0x57FU
+
 static void canopen_detach_all_rx_filters(CO_CANmodule_t *CANmodule)
 {
 	uint16_t i;
@@ -78,23 +83,135 @@ static void canopen_detach_all_rx_filters(CO_CANmodule_t *CANmodule)
 			CANmodule->rx_array[i].filter_id = CAN_NO_FREE_FILTER;
 		}
 	}
+
+#ifdef CONFIG_CANOPEN_RX_HASH
+	if (CANmodule->rx_hash_filter_id != CAN_NO_FREE_FILTER) {
+		can_detach(CANmodule->dev, CANmodule->rx_hash_filter_id);
+		CANmodule->rx_hash_filter_id = CAN_NO_FREE_FILTER;
+	}
+#endif /* CONFIG_CANOPEN_RX_HASH */
+}
+
+static void canopen_rx_dispatch(CO_CANrx_t *buffer, struct zcan_frame *msg)
+{
+	CO_CANrxMsg_t rxMsg;
+
+	rxMsg.ident = msg->std_id;
+	rxMsg.DLC = msg->dlc;
+	memcpy(rxMsg.data, msg->data, msg->dlc);
+	buffer->pFunct(buffer->object, &rxMsg);
+
+#ifdef CONFIG_CANOPEN_SYNC_THREAD
+	/*
+	 * The RPDO data is copied by CANopenNode above, process it
+	 * right away instead of at the next SYNC thread period.
+	 */
+	if (msg->std_id == CANOPEN_COB_ID_SYNC ||
+	    (msg->std_id >= CANOPEN_COB_ID_PDO_MIN &&
+	     msg->std_id <= CANOPEN_COB_ID_PDO_MAX)) {
+		canopen_sync_notify();
+	}
+#endif /* CONFIG_CANOPEN_SYNC_THREAD */
 }
 
 static void canopen_rx_isr_callback(struct zcan_frame *msg, void *arg)
 {
 	CO_CANrx_t *buffer = (CO_CANrx_t *)arg;
-	CO_CANrxMsg_t rxMsg;
 
 	if (!buffer || !buffer->pFunct) {
 		LOG_ERR("failed to process CAN rx isr callback");
 		return;
 	}
 
-	rxMsg.ident = msg->std_id;
-	rxMsg.DLC = msg->dlc;
-	memcpy(rxMsg.data, msg->data, msg->dlc);
-	buffer->pFunct(buffer->object, &rxMsg);
+	canopen_rx_dispatch(buffer, msg);
+}
+
+#ifdef CONFIG_CANOPEN_RX_HASH
+static inline uint16_t canopen_rx_hash(uint16_t ident)
+{
+	/* Mix the function code into the node-ID bits */
+	return (ident ^ (ident >> 7)) % CONFIG_CANOPEN_RX_HASH_SIZE;
+}
+
+static void canopen_rx_hash_isr_callback(struct zcan_frame *msg, void *arg)
+{
+	CO_CANmodule_t *CANmodule = arg;
+	uint16_t slot = canopen_rx_hash(msg->std_id);
+	CO_CANrx_t *buffer;
+	uint16_t i;
+
+	/* Linear probing, an empty slot ends the search */
+	for (i = 0U; i < CONFIG_CANOPEN_RX_HASH_SIZE; i++) {
+		buffer = CANmodule->rx_hash[slot];
+		if (!buffer) {
+			return;
+		}
+
+		if (buffer->ident == msg->std_id && buffer->rtr == msg->rtr) {
+			canopen_rx_dispatch(buffer, msg);
+			return;
+		}
+
+		slot = (slot + 1U) % CONFIG_CANOPEN_RX_HASH_SIZE;
+	}
+}
+
+/*
+ * Rebuild the table from the RX buffers. This only happens when an RX
+ * buffer is (re)configured, which keeps the removal of entries simple.
+ */
+static void canopen_rx_hash_rebuild(CO_CANmodule_t *CANmodule)
+{
+	CO_CANrx_t *buffer;
+	unsigned int key;
+	uint16_t slot;
+	uint16_t i;
+
+	key = irq_lock();
+
+	memset(CANmodule->rx_hash, 0, sizeof(CANmodule->rx_hash));
+
+	for (i = 0U; i < CANmodule->rx_size; i++) {
+		buffer = &CANmodule->rx_array[i];
+		if (!buffer->hashed || !buffer->pFunct) {
+			continue;
+		}
+
+		slot = canopen_rx_hash(buffer->ident);
+		while (CANmodule->rx_hash[slot]) {
+			slot = (slot + 1U) % CONFIG_CANOPEN_RX_HASH_SIZE;
+		}
+
+		CANmodule->rx_hash[slot] = buffer;
+	}
+
+	irq_unlock(key);
+}
+
+static int canopen_rx_hash_attach(CO_CANmodule_t *CANmodule)
+{
+	const struct zcan_filter filter = {
+		.id_type = CAN_STANDARD_IDENTIFIER,
+		.std_id = 0U,
+		.std_id_mask = 0U,
+		.rtr = 0U,
+		.rtr_mask = 0U,
+	};
+
+	if (CANmodule->rx_hash_filter_id != CAN_NO_FREE_FILTER) {
+		return 0;
+	}
+
+	CANmodule->rx_hash_filter_id =
+		can_attach_isr(CANmodule->dev, canopen_rx_hash_isr_callback,
+			       CANmodule, &filter);
+	if (CANmodule->rx_hash_filter_id == CAN_NO_FREE_FILTER) {
+		return -ENOSPC;
+	}
+
+	return 0;
 }
+#endif /* CONFIG_CANOPEN_RX_HASH */
 
 static void canopen_tx_isr_callback(uint32_t error_flags, void *arg)
 {
@@ -179,6 +296,14 @@ CO_ReturnError_t CO_CANmodule_init(CO_CANmodule_t *CANmodule,
 		return CO_ERROR_ILLEGAL_ARGUMENT;
 	}
 
+#ifdef CONFIG_CANOPEN_RX_HASH
+	if (rxSize > CONFIG_CANOPEN_RX_HASH_SIZE) {
+		LOG_ERR("insufficient COB-ID hash table size"
+			" (needs %d, %d available)", rxSize,
+			CONFIG_CANOPEN_RX_HASH_SIZE);
+		return CO_ERROR_OUT_OF_MEMORY;
+	}
+#else
 	if (rxSize > CONFIG_CAN_MAX_FILTER) {
 		LOG_ERR("insufficient number of concurrent CAN RX filters"
 			" (needs %d, %d available)", rxSize,
@@ -189,6 +314,7 @@ CO_ReturnError_t CO_CANmodule_init(CO_CANmodule_t *CANmodule,
 			" (needs %d, %d available)", rxSize,
 			CONFIG_CAN_MAX_FILTER);
 	}
+#endif /* CONFIG_CANOPEN_RX_HASH */
 
 	canopen_detach_all_rx_filters(CANmodule);
 	canopen_tx_queue.CANmodule = CANmodule;
@@ -207,8 +333,14 @@ CO_ReturnError_t CO_CANmodule_init(CO_CANmodule_t *CANmodule,
 		rxArray[i].ident = 0U;
 		rxArray[i].pFunct = NULL;
 		rxArray[i].filter_id = CAN_NO_FREE_FILTER;
+		rxArray[i].hashed = false;
 	}
 
+#ifdef CONFIG_CANOPEN_RX_HASH
+	memset(CANmodule->rx_hash, 0, sizeof(CANmodule->rx_hash));
+	CANmodule->rx_hash_filter_id = CAN_NO_FREE_FILTER;
+#endif /* CONFIG_CANOPEN_RX_HASH */
+
 	for (i = 0U; i < txSize; i++) {
 		txArray[i].bufferFull = false;
 	}
@@ -265,8 +397,34 @@ CO_ReturnError_t CO_CANrxBufferInit(CO_CANmodule_t *CANmodule, uint16_t index,
 	}
 
 	buffer = &CANmodule->rx_array[index];
+
+	if (buffer->filter_id != CAN_NO_FREE_FILTER) {
+		can_detach(CANmodule->dev, buffer->filter_id);
+		buffer->filter_id = CAN_NO_FREE_FILTER;
+	}
+
 	buffer->object = object;
 	buffer->pFunct = pFunct;
+	buffer->ident = ident;
+	buffer->rtr = rtr;
+
+#ifdef CONFIG_CANOPEN_RX_HASH
+	/* Buffers matching a single COB-ID share one catch-all filter */
+	buffer->hashed = ((mask & CAN_STD_ID_MASK) == CAN_STD_ID_MASK);
+	canopen_rx_hash_rebuild(CANmodule);
+
+	if (buffer->hashed) {
+		if (canopen_rx_hash_attach(CANmodule)) {
+			LOG_ERR("failed to attach CAN rx isr, no free filter");
+			CO_errorReport(CANmodule->em,
+				       CO_EM_MEMORY_ALLOCATION_ERROR,
+				       CO_EMC_SOFTWARE_INTERNAL, 0);
+			return CO_ERROR_OUT_OF_MEMORY;
+		}
+
+		return CO_ERROR_NO;
+	}
+#endif /* CONFIG_CANOPEN_RX_HASH */
 
 	filter.id_type = CAN_STANDARD_IDENTIFIER;
 	filter.std_id = ident;
@@ -274,10 +432,6 @@ CO_ReturnError_t CO_CANrxBufferInit(CO_CANmodule_t *CANmodule, uint16_t index,
 	filter.rtr = (rtr ? 1 : 0);
 	filter.rtr_mask = 1;
 
-	if (buffer->filter_id != CAN_NO_FREE_FILTER) {
-		can_detach(CANmodule->dev, buffer->filter_id);
-	}
-
 	buffer->filter_id = can_attach_isr(CANmodule->dev,
 					   canopen_rx_isr_callback,
 					   buffer, &filter);
@@ -68,6 +68,9 @@ typedef struct canopen_rx {
 	void *object;
 	CO_CANrxBufferCallback_t pFunct;
 	uint16_t ident;
+	bool_t rtr : 1;
+	/* Dispatched through the COB-ID hash table, no own CAN filter */
+	bool_t hashed : 1;
 } CO_CANrx_t;
 
 typedef struct canopen_tx {
@@ -87,6 +90,10 @@ typedef struct canopen_module {
 	uint16_t tx_size;
 	uint32_t errors;
 	void *em;
+#ifdef CONFIG_CANOPEN_RX_HASH
+	CO_CANrx_t *rx_hash[CONFIG_CANOPEN_RX_HASH_SIZE];
+	int rx_hash_filter_id;
+#endif /* CONFIG_CANOPEN_RX_HASH */
 	bool_t configured : 1;
 	bool_t CANnormal : 1;
 	bool_t first_tx_msg : 1;
@@ -102,6 +109,11 @@ void canopen_emcy_unlock(void);
 #define CO_LOCK_EMCY()   canopen_emcy_lock()
 #define CO_UNLOCK_EMCY() canopen_emcy_unlock()
 
+#ifdef CONFIG_CANOPEN_SYNC_THREAD
+/* Wake the SYNC thread up to process a received SYNC or RPDO */
+void canopen_sync_notify(void);
+#endif /* CONFIG_CANOPEN_SYNC_THREAD */
+
 void canopen_od_lock(void);
 void canopen_od_unlock(void);
 #define CO_LOCK_OD()   canopen_od_lock()
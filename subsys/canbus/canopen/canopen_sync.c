@@ -6,11 +6,20 @@
 
 #include <CANopen.h>
 
+/* Given when a SYNC or an RPDO is received */
+static K_SEM_DEFINE(canopen_sync_sem, 0, 1);
+
+void canopen_sync_notify(void)
+{
+	k_sem_give(&canopen_sync_sem);
+}
+
 /**
  * @brief CANopen sync thread.
  *
  * The CANopen real-time sync thread processes SYNC RPDOs and TPDOs
- * through the CANopenNode stack with an interval of 1 millisecond.
+ * through the CANopenNode stack with an interval of 1 millisecond, or
+ * as soon as a SYNC or an RPDO is received.
  *
  * @param p1 Unused
  * @param p2 Unused
@@ -38,7 +47,7 @@ static void canopen_sync_thread(void *p1, void *p2, void *p3)
 			CO_UNLOCK_OD();
 		}
 
-		k_sleep(K_MSEC(1));
+		k_sem_take(&canopen_sync_sem, K_MSEC(1));
 		stop = k_cycle_get_32();
 		delta = stop - start;
 		elapsed = (uint32_t)k_cyc_to_ns_floor64(delta) / NSEC_PER_USEC;
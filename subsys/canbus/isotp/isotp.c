@@ -257,6 +257,36 @@ static int receive_alloc_buffer(struct isotp_recv_ctx *ctx)
 	return 0;
 }
 
+/* Take the SDU buffer for a message of len bytes, if it is free. */
+static bool receive_sdu_start(struct isotp_recv_ctx *ctx, size_t len)
+{
+	if (!ctx->sdu_buf || ctx->sdu_state != ISOTP_SDU_FREE ||
+	    len > ctx->sdu_size) {
+		return false;
+	}
+
+	ctx->sdu_state = ISOTP_SDU_RX;
+	ctx->sdu_len = 0;
+
+	return true;
+}
+
+static void receive_sdu_done(struct isotp_recv_ctx *ctx,
+			     enum isotp_sdu_state state)
+{
+	ctx->sdu_state = state;
+	k_sem_give(&ctx->sdu_sem);
+}
+
+/* Copy the SF or FF payload to the SDU buffer, the frame buffer is freed */
+static void receive_sdu_first(struct isotp_recv_ctx *ctx)
+{
+	memcpy(ctx->sdu_buf, ctx->buf->data, ctx->buf->len);
+	ctx->sdu_len = ctx->buf->len;
+	net_buf_unref(ctx->buf);
+	ctx->buf = NULL;
+}
+
 static void receive_state_machine(struct isotp_recv_ctx *ctx)
 {
 	int ret;
@@ -265,6 +295,14 @@ static void receive_state_machine(struct isotp_recv_ctx *ctx)
 	switch (ctx->state) {
 	case ISOTP_RX_STATE_PROCESS_SF:
 		ctx->buf->len = receive_get_sf_length(ctx->buf);
+		if (receive_sdu_start(ctx, ctx->buf->len)) {
+			receive_sdu_first(ctx);
+			receive_sdu_done(ctx, ISOTP_SDU_FULL);
+			ctx->state = ISOTP_RX_STATE_RECYCLE;
+			receive_state_machine(ctx);
+			break;
+		}
+
 		ud_rem_len = net_buf_user_data(ctx->buf);
 		*ud_rem_len = 0;
 		LOG_DBG("SM process SF of length %d", ctx->buf->len);
@@ -276,6 +314,17 @@ static void receive_state_machine(struct isotp_recv_ctx *ctx)
 	case ISOTP_RX_STATE_PROCESS_FF:
 		ctx->length = receive_get_ff_length(ctx->buf);
 		LOG_DBG("SM process FF. Length: %d", ctx->length);
+		if (receive_sdu_start(ctx, ctx->length)) {
+			/* No buffer to allocate, the whole message fits */
+			ctx->length -= ctx->buf->len;
+			receive_sdu_first(ctx);
+			ctx->bs = ctx->opts.bs;
+			ctx->wft = ISOTP_WFT_FIRST;
+			ctx->state = ISOTP_RX_STATE_SEND_FC;
+			receive_state_machine(ctx);
+			break;
+		}
+
 		ctx->length -= ctx->buf->len;
 		if (ctx->opts.bs == 0 &&
 		    ctx->length > CONFIG_ISOTP_RX_BUF_COUNT *
@@ -343,8 +392,15 @@ static void receive_state_machine(struct isotp_recv_ctx *ctx)
 		}
 
 		k_fifo_cancel_wait(&ctx->fifo);
-		net_buf_unref(ctx->buf);
-		ctx->buf = NULL;
+		if (ctx->sdu_state == ISOTP_SDU_RX) {
+			receive_sdu_done(ctx, ISOTP_SDU_ERR);
+		}
+
+		if (ctx->buf) {
+			net_buf_unref(ctx->buf);
+			ctx->buf = NULL;
+		}
+
 		ctx->state = ISOTP_RX_STATE_RECYCLE;
 		/* FALLTHROUGH */
 	case ISOTP_RX_STATE_RECYCLE:
@@ -442,7 +498,8 @@ static inline void receive_add_mem(struct isotp_recv_ctx *ctx, uint8_t *data,
 
 static void process_cf(struct isotp_recv_ctx *ctx, struct zcan_frame *frame)
 {
-	uint32_t *ud_rem_len = (uint32_t *)net_buf_user_data(ctx->buf);
+	bool sdu = (ctx->sdu_state == ISOTP_SDU_RX);
+	uint32_t *ud_rem_len;
 	int index = 0;
 
 	if (ctx->rx_addr.use_ext_addr) {
@@ -473,23 +530,44 @@ static void process_cf(struct isotp_recv_ctx *ctx, struct zcan_frame *frame)
 	if (frame->dlc - index > ctx->length) {
 		LOG_ERR("The frame contains more bytes than expected");
 		receive_report_error(ctx, ISOTP_N_ERROR);
+		return;
 	}
 
 	LOG_DBG("Got CF irq. Appending data");
-	receive_add_mem(ctx, &frame->data[index], frame->dlc - index);
+	if (sdu) {
+		memcpy(ctx->sdu_buf + ctx->sdu_len, &frame->data[index],
+		       frame->dlc - index);
+		ctx->sdu_len += frame->dlc - index;
+	} else {
+		receive_add_mem(ctx, &frame->data[index], frame->dlc - index);
+	}
+
 	ctx->length -= frame->dlc - index;
 	LOG_DBG("%d bytes remaining", ctx->length);
 
 	if (ctx->length == 0) {
 		ctx->state = ISOTP_RX_STATE_RECYCLE;
+		if (sdu) {
+			receive_sdu_done(ctx, ISOTP_SDU_FULL);
+			return;
+		}
+
+		ud_rem_len = net_buf_user_data(ctx->buf);
 		*ud_rem_len = 0;
 		net_buf_put(&ctx->fifo, ctx->buf);
 		return;
 	}
 
 	if (ctx->opts.bs && !--ctx->bs) {
-		LOG_DBG("Block is complete. Allocate new buffer");
 		ctx->bs = ctx->opts.bs;
+		if (sdu) {
+			LOG_DBG("Block is complete. Send FC");
+			ctx->state = ISOTP_RX_STATE_SEND_FC;
+			return;
+		}
+
+		LOG_DBG("Block is complete. Allocate new buffer");
+		ud_rem_len = net_buf_user_data(ctx->buf);
 		*ud_rem_len = ctx->length;
 		net_buf_put(&ctx->fifo, ctx->buf);
 		ctx->state = ISOTP_RX_STATE_TRY_ALLOC;
@@ -571,6 +649,9 @@ int isotp_bind(struct isotp_recv_ctx *ctx, struct device *can_dev,
 
 	ctx->opts = *opts;
 	ctx->state = ISOTP_RX_STATE_WAIT_FF_SF;
+	ctx->sdu_buf = NULL;
+	ctx->sdu_state = ISOTP_SDU_FREE;
+	k_sem_init(&ctx->sdu_sem, 0, 1);
 
 	LOG_DBG("Binding to addr: 0x%x. Responding on 0x%x",
 		ctx->rx_addr.ext_id, ctx->tx_addr.ext_id);
@@ -618,6 +699,11 @@ void isotp_unbind(struct isotp_recv_ctx *ctx)
 
 	k_fifo_cancel_wait(&ctx->fifo);
 
+	if (ctx->sdu_state == ISOTP_SDU_RX) {
+		ctx->error_nr = ISOTP_N_ERROR;
+		receive_sdu_done(ctx, ISOTP_SDU_ERR);
+	}
+
 	if (ctx->buf) {
 		net_buf_unref(ctx->buf);
 	}
@@ -625,6 +711,47 @@ void isotp_unbind(struct isotp_recv_ctx *ctx)
 	LOG_DBG("Unbound");
 }
 
+int isotp_recv_sdu_buf(struct isotp_recv_ctx *ctx, uint8_t *buf, size_t len)
+{
+	if (ctx->sdu_state == ISOTP_SDU_RX) {
+		return ISOTP_N_ERROR;
+	}
+
+	ctx->sdu_buf = buf;
+	ctx->sdu_size = len;
+	ctx->sdu_state = ISOTP_SDU_FREE;
+	k_sem_reset(&ctx->sdu_sem);
+
+	return ISOTP_N_OK;
+}
+
+int isotp_recv_sdu(struct isotp_recv_ctx *ctx, k_timeout_t timeout)
+{
+	int ret;
+
+	if (!ctx->sdu_buf) {
+		return ISOTP_N_ERROR;
+	}
+
+	/* The previous message is consumed */
+	if (ctx->sdu_state == ISOTP_SDU_FULL) {
+		ctx->sdu_state = ISOTP_SDU_FREE;
+	}
+
+	if (k_sem_take(&ctx->sdu_sem, timeout)) {
+		return ISOTP_RECV_TIMEOUT;
+	}
+
+	if (ctx->sdu_state == ISOTP_SDU_ERR) {
+		ctx->sdu_state = ISOTP_SDU_FREE;
+		ret = ctx->error_nr ? ctx->error_nr : ISOTP_N_ERROR;
+		ctx->error_nr = 0;
+		return ret;
+	}
+
+	return ctx->sdu_len;
+}
+
 int isotp_recv_net(struct isotp_recv_ctx *ctx, struct net_buf **buffer,
 		   k_timeout_t timeout)
 {
@@ -1027,6 +1154,14 @@ static void send_state_machine(struct isotp_send_ctx *ctx)
 					      send_timeout_handler,
 					      K_MSEC(ISOTP_BS));
 				break;
+			} else if (ctx->opts.stmin >= ISOTP_STMIN_US_BEGIN &&
+				   ctx->opts.stmin <= ISOTP_STMIN_US_END) {
+				/*
+				 * A timeout would round the separation time
+				 * up to a whole tick, spin for it instead.
+				 */
+				k_busy_wait((ctx->opts.stmin + 1 -
+					     ISOTP_STMIN_US_BEGIN) * 100U);
 			} else if (ctx->opts.stmin) {
 				ctx->state = ISOTP_TX_WAIT_ST;
 				break;
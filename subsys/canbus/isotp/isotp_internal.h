@@ -100,6 +100,14 @@ enum isotp_rx_state {
 	ISOTP_RX_STATE_UNBOUND
 };
 
+/* State of the SDU buffer of a receive context */
+enum isotp_sdu_state {
+	ISOTP_SDU_FREE,
+	ISOTP_SDU_RX,
+	ISOTP_SDU_FULL,
+	ISOTP_SDU_ERR
+};
+
 enum isotp_tx_state {
 	ISOTP_TX_STATE_RESET,
 	ISOTP_TX_SEND_SF,
@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ *  @brief Sampling profiler
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <debug/profiler.h>
+#include <drivers/counter.h>
+#include <shell/shell.h>
+#include <stdlib.h>
+#include <errno.h>
+
+#if defined(CONFIG_CPU_CORTEX_M)
+#include <arch/arm/aarch32/cortex_m/cmsis.h>
+#endif
+
+static struct profiler_sample samples[CONFIG_PROFILER_SAMPLES];
+static size_t sample_count;
+static uint32_t dropped;
+static bool started;
+
+static void interrupted_pc_get(uintptr_t *pc, uintptr_t *caller)
+{
+	*pc = 0;
+	*caller = 0;
+
+#if defined(CONFIG_CPU_CORTEX_M)
+	/* Threads run on the process stack, where the exception entry pushed
+	 * r0-r3, r12, lr, pc and xpsr. If another interrupt was preempted,
+	 * the frame is on the main stack at an unknown depth instead.
+	 */
+#if defined(SCB_ICSR_RETTOBASE_Msk)
+	if ((SCB->ICSR & SCB_ICSR_RETTOBASE_Msk) == 0) {
+		return;
+	}
+#endif
+	const uint32_t *frame = (const uint32_t *)__get_PSP();
+
+	*pc = frame[6];
+	if (IS_ENABLED(CONFIG_PROFILER_CALLER)) {
+		*caller = frame[5] & ~1U;
+	}
+#endif
+}
+
+/* Called in interrupt context. */
+static void sample(void)
+{
+	struct profiler_sample *s;
+
+	if (sample_count == ARRAY_SIZE(samples)) {
+		dropped++;
+		return;
+	}
+
+	s = &samples[sample_count];
+	interrupted_pc_get(&s->pc, &s->caller);
+	s->thread = _current;
+	sample_count++;
+}
+
+#if defined(CONFIG_PROFILER_SOURCE_COUNTER)
+static struct device *counter_dev;
+static struct counter_alarm_cfg alarm_cfg;
+
+static void alarm_handler(struct device *dev, uint8_t chan_id, uint32_t ticks,
+			  void *user_data)
+{
+	sample();
+
+	if (started) {
+		(void)counter_set_channel_alarm(dev, 0, &alarm_cfg);
+	}
+}
+
+static int source_start(uint32_t rate)
+{
+	counter_dev = device_get_binding(CONFIG_PROFILER_COUNTER_NAME);
+	if (counter_dev == NULL) {
+		return -ENODEV;
+	}
+
+	alarm_cfg.callback = alarm_handler;
+	alarm_cfg.ticks = counter_us_to_ticks(counter_dev,
+					      USEC_PER_SEC / rate);
+	alarm_cfg.flags = 0;
+	if (alarm_cfg.ticks == 0U) {
+		return -EINVAL;
+	}
+
+	(void)counter_start(counter_dev);
+
+	return counter_set_channel_alarm(counter_dev, 0, &alarm_cfg);
+}
+
+static void source_stop(void)
+{
+	(void)counter_cancel_channel_alarm(counter_dev, 0);
+}
+#else
+static void timer_handler(struct k_timer *timer)
+{
+	/* Expiry functions run in the system timer interrupt. */
+	sample();
+}
+
+static K_TIMER_DEFINE(sample_timer, timer_handler, NULL);
+
+static int source_start(uint32_t rate)
+{
+	k_timeout_t period = K_USEC(USEC_PER_SEC / rate);
+
+	k_timer_start(&sample_timer, period, period);
+
+	return 0;
+}
+
+static void source_stop(void)
+{
+	k_timer_stop(&sample_timer);
+}
+#endif /* CONFIG_PROFILER_SOURCE_COUNTER */
+
+int profiler_start(uint32_t rate)
+{
+	int err;
+
+	if ((rate == 0U) || (rate > USEC_PER_SEC)) {
+		return -EINVAL;
+	}
+
+	if (started) {
+		return -EALREADY;
+	}
+
+	started = true;
+	err = source_start(rate);
+	if (err) {
+		started = false;
+	}
+
+	return err;
+}
+
+void profiler_stop(void)
+{
+	if (started) {
+		started = false;
+		source_stop();
+	}
+}
+
+void profiler_reset(void)
+{
+	unsigned int key = irq_lock();
+
+	sample_count = 0;
+	dropped = 0;
+	irq_unlock(key);
+}
+
+size_t profiler_samples_get(const struct profiler_sample **out)
+{
+	*out = samples;
+
+	return sample_count;
+}
+
+uint32_t profiler_dropped_get(void)
+{
+	return dropped;
+}
+
+#if defined(CONFIG_PROFILER_SHELL)
+static int cmd_start(const struct shell *shell, size_t argc, char **argv)
+{
+	uint32_t rate = CONFIG_PROFILER_DEFAULT_RATE;
+	int err;
+
+	if (argc > 1) {
+		rate = strtoul(argv[1], NULL, 10);
+	}
+
+	err = profiler_start(rate);
+	if (err) {
+		shell_error(shell, "Failed to start (err %d)", err);
+	}
+
+	return err;
+}
+
+static int cmd_stop(const struct shell *shell, size_t argc, char **argv)
+{
+	profiler_stop();
+
+	return 0;
+}
+
+static int cmd_reset(const struct shell *shell, size_t argc, char **argv)
+{
+	profiler_stop();
+	profiler_reset();
+
+	return 0;
+}
+
+#if defined(CONFIG_THREAD_MONITOR)
+static void thread_print(const struct k_thread *thread, void *user_data)
+{
+	const struct shell *shell = user_data;
+	const char *name = k_thread_name_get((k_tid_t)thread);
+
+	shell_print(shell, "thread %p %s", thread, name ? name : "");
+}
+#endif
+
+/* The format is parsed by scripts/profiler/profiler_flamegraph.py. */
+static int cmd_dump(const struct shell *shell, size_t argc, char **argv)
+{
+	const struct profiler_sample *s;
+	size_t count;
+
+	profiler_stop();
+	count = profiler_samples_get(&s);
+
+	shell_print(shell, "profiler: %zu samples, %u dropped", count,
+		    profiler_dropped_get());
+
+#if defined(CONFIG_THREAD_MONITOR)
+	k_thread_foreach(thread_print, (void *)shell);
+#endif
+
+	for (size_t i = 0; i < count; i++) {
+		shell_print(shell, "sample %lx %lx %p", (unsigned long)s[i].pc,
+			    (unsigned long)s[i].caller, s[i].thread);
+	}
+
+	shell_print(shell, "profiler: end");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_profiler,
+	SHELL_CMD_ARG(start, NULL, "Start sampling [rate in Hz]", cmd_start,
+		      1, 1),
+	SHELL_CMD(stop, NULL, "Stop sampling", cmd_stop),
+	SHELL_CMD(reset, NULL, "Stop sampling and discard samples", cmd_reset),
+	SHELL_CMD(dump, NULL, "Stop sampling and print samples", cmd_dump),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(profiler, &sub_profiler, "Sampling profiler commands",
+		   NULL);
+#endif /* CONFIG_PROFILER_SHELL */
@@ -45,6 +45,12 @@ static void thread_print_cb(struct thread_analyzer_info *info)
 		THREAD_ANALYZER_VSTR(info->name),
 		info->stack_size - info->stack_used, info->stack_used,
 		info->stack_size, pcnt);
+
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	THREAD_ANALYZER_PRINT(
+		THREAD_ANALYZER_FMT(" %-20s: CPU: %u %%"),
+		THREAD_ANALYZER_VSTR(info->name), info->utilization);
+#endif
 }
 
 static void thread_analyze_cb(const struct k_thread *cthread, void *user_data)
@@ -77,6 +83,21 @@ static void thread_analyze_cb(const struct k_thread *cthread, void *user_data)
 	info.name = name;
 	info.stack_size = size;
 	info.stack_used = size - unused;
+
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	k_thread_runtime_stats_t rt_stats_thread;
+	k_thread_runtime_stats_t rt_stats_all;
+
+	info.utilization = 0;
+	if ((k_thread_runtime_stats_get(thread, &rt_stats_thread) == 0) &&
+	    (k_thread_runtime_stats_all_get(&rt_stats_all) == 0) &&
+	    (rt_stats_all.execution_cycles != 0U)) {
+		info.utilization = (unsigned int)
+			((rt_stats_thread.execution_cycles * 100U) /
+			 rt_stats_all.execution_cycles);
+	}
+#endif
+
 	cb(&info);
 }
 
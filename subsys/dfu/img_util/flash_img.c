@@ -8,6 +8,7 @@
 #include <stddef.h>
 #include <stdio.h>
 #include <string.h>
+#include <errno.h>
 #include <dfu/flash_img.h>
 #include <storage/flash_map.h>
 #include <storage/stream_flash.h>
@@ -18,6 +19,11 @@
 
 #include <devicetree.h>
 
+#ifdef CONFIG_IMG_CHECK_READBACK
+#include <tinycrypt/sha256.h>
+#include <tinycrypt/constants.h>
+#endif
+
 /* FLASH_AREA_ID() values used below are auto-generated by DT */
 #ifdef CONFIG_TRUSTED_EXECUTION_NONSECURE
 #define FLASH_AREA_IMAGE_SECONDARY FLASH_AREA_ID(image_1_nonsecure)
@@ -75,12 +81,103 @@ int flash_img_init_id(struct flash_img_context *ctx, uint8_t area_id)
 
 	flash_dev = flash_area_get_device(ctx->flash_area);
 
-	return stream_flash_init(&ctx->stream, flash_dev, ctx->buf,
+	rc = stream_flash_init(&ctx->stream, flash_dev, ctx->buf,
 			CONFIG_IMG_BLOCK_BUF_SIZE, ctx->flash_area->fa_off,
 			ctx->flash_area->fa_size, NULL);
+
+#ifdef CONFIG_IMG_WRITE_BACKGROUND
+	if (rc == 0) {
+		rc = stream_flash_double_buffer_set(&ctx->stream, ctx->buf2);
+	}
+#endif
+
+	return rc;
 }
 
 int flash_img_init(struct flash_img_context *ctx)
 {
 	return flash_img_init_id(ctx, FLASH_AREA_IMAGE_SECONDARY);
 }
+
+#ifdef CONFIG_IMG_ENABLE_IMAGE_CHECK
+#ifdef CONFIG_IMG_CHECK_READBACK
+static int flash_img_hash(struct flash_img_context *ctx, size_t len,
+			  uint8_t area_id, uint8_t *digest)
+{
+	struct tc_sha256_state_struct sha256;
+	const struct flash_area *fa;
+	size_t off;
+	size_t n;
+	int rc;
+
+	rc = flash_area_open(area_id, &fa);
+	if (rc) {
+		return rc;
+	}
+
+	if (len > fa->fa_size) {
+		rc = -EINVAL;
+		goto out;
+	}
+
+	tc_sha256_init(&sha256);
+
+	/* The image buffer is free once the image is flushed */
+	for (off = 0; off < len; off += n) {
+		n = MIN(len - off, sizeof(ctx->buf));
+		rc = flash_area_read(fa, off, ctx->buf, n);
+		if (rc) {
+			goto out;
+		}
+
+		tc_sha256_update(&sha256, ctx->buf, n);
+	}
+
+	if (tc_sha256_final(digest, &sha256) != TC_CRYPTO_SUCCESS) {
+		rc = -EINVAL;
+	}
+
+out:
+	flash_area_close(fa);
+	return rc;
+}
+#else
+static int flash_img_hash(struct flash_img_context *ctx, size_t len,
+			  uint8_t area_id, uint8_t *digest)
+{
+	ARG_UNUSED(area_id);
+
+	/* The stream hashes the data without the padding of the last
+	 * block, as does the byte count.
+	 */
+	if (len != stream_flash_bytes_written(&ctx->stream)) {
+		return -EINVAL;
+	}
+
+	return stream_flash_sha256_get(&ctx->stream, digest);
+}
+#endif /* CONFIG_IMG_CHECK_READBACK */
+
+int flash_img_check(struct flash_img_context *ctx,
+		    const struct flash_img_check *fic,
+		    uint8_t area_id)
+{
+	uint8_t digest[TC_SHA256_DIGEST_SIZE];
+	int rc;
+
+	if (!ctx || !fic || !fic->match) {
+		return -EINVAL;
+	}
+
+	rc = flash_img_hash(ctx, fic->clen, area_id, digest);
+	if (rc) {
+		return rc;
+	}
+
+	if (memcmp(digest, fic->match, sizeof(digest)) != 0) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_IMG_ENABLE_IMAGE_CHECK */
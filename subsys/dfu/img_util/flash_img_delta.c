@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/types.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/util.h>
+#include <sys/byteorder.h>
+#include <dfu/flash_img.h>
+#include <storage/flash_map.h>
+
+/* FLASH_AREA_ID() values used below are auto-generated by DT */
+#ifdef CONFIG_TRUSTED_EXECUTION_NONSECURE
+#define FLASH_AREA_IMAGE_PRIMARY FLASH_AREA_ID(image_0_nonsecure)
+#else
+#define FLASH_AREA_IMAGE_PRIMARY FLASH_AREA_ID(image_0)
+#endif /* CONFIG_TRUSTED_EXECUTION_NONSECURE */
+
+/* "ZDLT" */
+#define DELTA_MAGIC 0x544c445aU
+#define DELTA_HEADER_SIZE 8
+#define DELTA_RECORD_SIZE 12
+
+/* Source bytes patched per flash read */
+#define DELTA_CHUNK_SIZE 64
+
+enum {
+	DELTA_HEADER,
+	DELTA_RECORD,
+	DELTA_DIFF,
+	DELTA_EXTRA,
+	DELTA_DONE,
+};
+
+/* Collect the header or a record, return true once size bytes are in. */
+static bool delta_collect(struct flash_img_delta *d, const uint8_t **data,
+			  size_t *len, size_t size)
+{
+	size_t n = MIN(size - d->hdr_len, *len);
+
+	memcpy(d->hdr + d->hdr_len, *data, n);
+	d->hdr_len += n;
+	*data += n;
+	*len -= n;
+
+	if (d->hdr_len < size) {
+		return false;
+	}
+
+	d->hdr_len = 0U;
+	return true;
+}
+
+/* Pick the next state once part of a record is consumed. */
+static int delta_next(struct flash_img_delta *d)
+{
+	if (d->diff_len > 0U) {
+		d->state = DELTA_DIFF;
+		return 0;
+	}
+
+	if (d->extra_len > 0U) {
+		d->state = DELTA_EXTRA;
+		return 0;
+	}
+
+	if ((int64_t)d->src_off + d->seek < 0 ||
+	    (int64_t)d->src_off + d->seek > d->src->fa_size) {
+		return -EINVAL;
+	}
+
+	d->src_off += d->seek;
+	d->state = (d->left > 0U) ? DELTA_RECORD : DELTA_DONE;
+
+	return 0;
+}
+
+static int delta_diff(struct flash_img_context *ctx, const uint8_t *data,
+		      size_t len)
+{
+	struct flash_img_delta *d = &ctx->delta;
+	uint8_t buf[DELTA_CHUNK_SIZE];
+	int rc;
+
+	if (d->src_off + len > d->src->fa_size) {
+		return -EINVAL;
+	}
+
+	rc = flash_area_read(d->src, d->src_off, buf, len);
+	if (rc) {
+		return rc;
+	}
+
+	for (size_t i = 0; i < len; i++) {
+		buf[i] += data[i];
+	}
+
+	d->src_off += len;
+	return flash_img_buffered_write(ctx, buf, len, false);
+}
+
+int flash_img_delta_write(struct flash_img_context *ctx, const uint8_t *data,
+			  size_t len, bool flush)
+{
+	struct flash_img_delta *d = &ctx->delta;
+	size_t n;
+	int rc = 0;
+
+	if (d->src == NULL) {
+		return -EINVAL;
+	}
+
+	while ((len > 0U) && (rc == 0)) {
+		switch (d->state) {
+		case DELTA_HEADER:
+			if (!delta_collect(d, &data, &len,
+					   DELTA_HEADER_SIZE)) {
+				break;
+			}
+
+			if (sys_get_le32(d->hdr) != DELTA_MAGIC) {
+				return -EINVAL;
+			}
+
+			d->left = sys_get_le32(d->hdr + 4);
+			d->state = (d->left > 0U) ? DELTA_RECORD : DELTA_DONE;
+			break;
+		case DELTA_RECORD:
+			if (!delta_collect(d, &data, &len,
+					   DELTA_RECORD_SIZE)) {
+				break;
+			}
+
+			d->diff_len = sys_get_le32(d->hdr);
+			d->extra_len = sys_get_le32(d->hdr + 4);
+			d->seek = (int32_t)sys_get_le32(d->hdr + 8);
+			if ((uint64_t)d->diff_len + d->extra_len > d->left) {
+				return -EINVAL;
+			}
+
+			rc = delta_next(d);
+			break;
+		case DELTA_DIFF:
+			n = MIN(MIN(len, d->diff_len), DELTA_CHUNK_SIZE);
+			rc = delta_diff(ctx, data, n);
+			if (rc) {
+				break;
+			}
+
+			data += n;
+			len -= n;
+			d->diff_len -= n;
+			d->left -= n;
+			rc = delta_next(d);
+			break;
+		case DELTA_EXTRA:
+			n = MIN(len, d->extra_len);
+			rc = flash_img_buffered_write(ctx, data, n, false);
+			if (rc) {
+				break;
+			}
+
+			data += n;
+			len -= n;
+			d->extra_len -= n;
+			d->left -= n;
+			rc = delta_next(d);
+			break;
+		default:
+			/* Data past the end of the patch */
+			return -EINVAL;
+		}
+	}
+
+	if (rc || !flush) {
+		return rc;
+	}
+
+	if (d->state != DELTA_DONE) {
+		return -EINVAL;
+	}
+
+	flash_area_close(d->src);
+	d->src = NULL;
+
+	return flash_img_buffered_write(ctx, NULL, 0, true);
+}
+
+int flash_img_delta_init_id(struct flash_img_context *ctx,
+			    uint8_t src_area_id)
+{
+	struct flash_img_delta *d = &ctx->delta;
+	int rc;
+
+	(void)memset(d, 0, sizeof(*d));
+
+	rc = flash_area_open(src_area_id, &d->src);
+	if (rc) {
+		d->src = NULL;
+		return rc;
+	}
+
+	d->state = DELTA_HEADER;
+
+	return 0;
+}
+
+int flash_img_delta_init(struct flash_img_context *ctx)
+{
+	return flash_img_delta_init_id(ctx, FLASH_AREA_IMAGE_PRIMARY);
+}
@@ -17,8 +17,10 @@ LOG_MODULE_REGISTER(sdhc_spi, CONFIG_DISK_LOG_LEVEL);
 
 /* Clock speed used during initialisation */
 #define SDHC_SPI_INITIAL_SPEED 400000
-/* Clock speed used after initialisation */
+/* Clock speed used after initialisation when the slot does not give one */
 #define SDHC_SPI_SPEED 4000000
+/* Maximum clock speed in SPI mode */
+#define SDHC_SPI_MAX_SPEED 25000000
 
 #if !DT_NODE_HAS_STATUS(DT_INST(0, zephyr_mmc_spi_slot), okay)
 #warning NO SDHC slot specified on board
@@ -201,16 +203,21 @@ static int sdhc_spi_skip_until_start(struct sdhc_spi_data *data)
 static int sdhc_spi_skip_until_ready(struct sdhc_spi_data *data)
 {
 	struct sdhc_retry retry;
+	/* Busy periods last many bytes, poll a few at a time */
+	uint8_t buf[8];
 	int status;
+	int err;
 
 	sdhc_retry_init(&retry, SDHC_READY_TIMEOUT, 0);
 
 	do {
-		status = sdhc_spi_rx_u8(data);
-		if (status < 0) {
-			return status;
+		err = sdhc_spi_rx_bytes(data, buf, sizeof(buf));
+		if (err != 0) {
+			return err;
 		}
 
+		status = buf[sizeof(buf) - 1];
+
 		if (status == 0) {
 			/* Card is still busy */
 			continue;
@@ -355,6 +362,7 @@ static int sdhc_spi_rx_block(struct sdhc_spi_data *data,
 	int err;
 	int token;
 	int i;
+	struct spi_buf tx_bufs[SDMMC_DEFAULT_BLOCK_SIZE / sizeof(sdhc_ones)];
 	/* Note the one extra byte to ensure there's an idle byte
 	 * between commands.
 	 */
@@ -370,41 +378,37 @@ static int sdhc_spi_rx_block(struct sdhc_spi_data *data,
 		return -EIO;
 	}
 
-	/* Read the data in batches */
-	for (i = 0; i < len; i += sizeof(sdhc_ones)) {
-		int remain = MIN(sizeof(sdhc_ones), len - i);
+	/* Read the data in a single transfer, clocking out ones */
+	__ASSERT_NO_MSG(len <= ARRAY_SIZE(tx_bufs) * sizeof(sdhc_ones));
 
-		struct spi_buf tx_bufs[] = {
-			{
-				.buf = (uint8_t *)sdhc_ones,
-				.len = remain
-			}
-		};
+	for (i = 0; i * sizeof(sdhc_ones) < len; i++) {
+		tx_bufs[i].buf = (uint8_t *)sdhc_ones;
+		tx_bufs[i].len = MIN(sizeof(sdhc_ones),
+				     len - i * sizeof(sdhc_ones));
+	}
 
-		const struct spi_buf_set tx = {
-			.buffers = tx_bufs,
-			.count = 1,
-		};
+	const struct spi_buf_set tx = {
+		.buffers = tx_bufs,
+		.count = i,
+	};
 
-		struct spi_buf rx_bufs[] = {
-			{
-				.buf = &buf[i],
-				.len = remain
-			}
-		};
+	struct spi_buf rx_bufs[] = {
+		{
+			.buf = buf,
+			.len = len
+		}
+	};
 
-		const struct spi_buf_set rx = {
-			.buffers = rx_bufs,
-			.count = 1,
-		};
+	const struct spi_buf_set rx = {
+		.buffers = rx_bufs,
+		.count = 1,
+	};
 
-		err = sdhc_spi_trace(data, -1,
-				spi_transceive(data->spi, &data->cfg,
-				&tx, &rx),
-				&buf[i], remain);
-		if (err != 0) {
-			return err;
-		}
+	err = sdhc_spi_trace(data, -1,
+			spi_transceive(data->spi, &data->cfg, &tx, &rx),
+			buf, len);
+	if (err != 0) {
+		return err;
 	}
 
 	err = sdhc_spi_rx_bytes(data, crc, sizeof(crc));
@@ -420,28 +424,69 @@ static int sdhc_spi_rx_block(struct sdhc_spi_data *data,
 	return 0;
 }
 
+/* Transmits the payload of a data block and computes its CRC */
+static int sdhc_spi_tx_payload(struct sdhc_spi_data *data,
+	const uint8_t *send, int len, uint16_t *crc)
+{
+#ifdef CONFIG_SPI_ASYNC
+	struct spi_buf spi_bufs[] = {
+		{
+			.buf = (uint8_t *)send,
+			.len = len
+		}
+	};
+
+	const struct spi_buf_set tx = {
+		.buffers = spi_bufs,
+		.count = 1
+	};
+
+	struct k_poll_signal done = K_POLL_SIGNAL_INITIALIZER(done);
+	struct k_poll_event evt = K_POLL_EVENT_INITIALIZER(
+		K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &done);
+	int err;
+
+	/* Compute the CRC while the payload is being sent */
+	err = spi_write_async(data->spi, &data->cfg, &tx, &done);
+	if (err != 0) {
+		return sdhc_spi_trace(data, 1, err, send, len);
+	}
+
+	*crc = crc16_itu_t(0, send, len);
+
+	k_poll(&evt, 1, K_FOREVER);
+
+	return sdhc_spi_trace(data, 1, done.result, send, len);
+#else
+	*crc = crc16_itu_t(0, send, len);
+
+	return sdhc_spi_tx(data, send, len);
+#endif
+}
+
 /* Transmits a SDHC data block */
 static int sdhc_spi_tx_block(struct sdhc_spi_data *data,
-	uint8_t *send, int len)
+	uint8_t token, const uint8_t *send, int len)
 {
 	uint8_t buf[SDHC_CRC16_SIZE];
+	uint16_t crc;
 	int err;
 
 	/* Start the block */
-	buf[0] = SDHC_TOKEN_SINGLE;
+	buf[0] = token;
 	err = sdhc_spi_tx(data, buf, 1);
 	if (err != 0) {
 		return err;
 	}
 
 	/* Write the payload */
-	err = sdhc_spi_tx(data, send, len);
+	err = sdhc_spi_tx_payload(data, send, len, &crc);
 	if (err != 0) {
 		return err;
 	}
 
-	/* Build and write the trailing CRC */
-	sys_put_be16(crc16_itu_t(0, send, len), buf);
+	/* Write the trailing CRC */
+	sys_put_be16(crc, buf);
 
 	err = sdhc_spi_tx(data, buf, sizeof(buf));
 	if (err != 0) {
@@ -646,8 +691,15 @@ static int sdhc_spi_detect(struct sdhc_spi_data *data)
 		buf[0], buf[1], buf[2], buf[3], buf[4], buf[5], buf[6],
 		buf[7], buf[8], sys_get_be32(&buf[9]));
 
-	/* Initilisation complete */
-	data->cfg.frequency = SDHC_SPI_SPEED;
+	/* Initilisation complete, switch to the highest clock speed the
+	 * slot supports.
+	 */
+	data->cfg.frequency = DT_PROP(DT_INST(0, zephyr_mmc_spi_slot),
+				      spi_max_frequency);
+	if (data->cfg.frequency == 0U) {
+		data->cfg.frequency = SDHC_SPI_SPEED;
+	}
+	data->cfg.frequency = MIN(data->cfg.frequency, SDHC_SPI_MAX_SPEED);
 	data->status = DISK_STATUS_OK;
 
 	return 0;
@@ -708,52 +760,76 @@ static int sdhc_spi_write(struct sdhc_spi_data *data,
 {
 	int err;
 	uint32_t addr;
+	uint8_t stop[] = { SDHC_TOKEN_STOP_TRAN, 0xFF };
 
 	err = sdhc_map_disk_status(data->status);
 	if (err != 0) {
 		return err;
 	}
 
-	sdhc_spi_set_cs(data, 0);
+	/* Translate sector number to data address.
+	 * SDSC cards use byte addressing, SDHC cards use block addressing.
+	 */
+	if (data->high_capacity) {
+		addr = sector;
+	} else {
+		addr = sector * SDMMC_DEFAULT_BLOCK_SIZE;
+	}
 
-	/* Write the blocks one-by-one */
-	for (; count != 0U; count--) {
-		/* Translate sector number to data address.
-		 * SDSC cards use byte addressing, SDHC cards use block addressing.
-		 */
-		if (data->high_capacity) {
-			addr = sector;
-		} else {
-			addr = sector * SDMMC_DEFAULT_BLOCK_SIZE;
-		}
+	sdhc_spi_set_cs(data, 0);
 
+	if (count == 1U) {
 		err = sdhc_spi_cmd_r1(data, SDHC_WRITE_BLOCK, addr);
 		if (err < 0) {
 			goto error;
 		}
 
-		err = sdhc_spi_tx_block(data, (uint8_t *)buf,
+		err = sdhc_spi_tx_block(data, SDHC_TOKEN_SINGLE, buf,
 			SDMMC_DEFAULT_BLOCK_SIZE);
 		if (err != 0) {
 			goto error;
 		}
-
-		/* Wait for the card to finish programming */
-		err = sdhc_spi_skip_until_ready(data);
-		if (err != 0) {
+	} else {
+		err = sdhc_spi_cmd_r1(data, SDHC_WRITE_MULTIPLE_BLOCK, addr);
+		if (err < 0) {
 			goto error;
 		}
 
-		err = sdhc_spi_cmd_r2(data, SDHC_SEND_STATUS, 0);
+		for (; count != 0U; count--) {
+			err = sdhc_spi_tx_block(data, SDHC_TOKEN_MULTI_WRITE,
+				buf, SDMMC_DEFAULT_BLOCK_SIZE);
+			if (err == 0) {
+				/* Wait for the card to program the block */
+				err = sdhc_spi_skip_until_ready(data);
+			}
+
+			if (err != 0) {
+				/* Terminate the transfer, keeping the
+				 * first error.
+				 */
+				sdhc_spi_tx(data, stop, sizeof(stop));
+				sdhc_spi_skip_until_ready(data);
+				goto error;
+			}
+
+			buf += SDMMC_DEFAULT_BLOCK_SIZE;
+		}
+
+		/* Stop the transfer, followed by an idle byte */
+		err = sdhc_spi_tx(data, stop, sizeof(stop));
 		if (err != 0) {
 			goto error;
 		}
+	}
 
-		buf += SDMMC_DEFAULT_BLOCK_SIZE;
-		sector++;
+	/* Wait for the card to finish programming */
+	err = sdhc_spi_skip_until_ready(data);
+	if (err != 0) {
+		goto error;
 	}
 
-	err = 0;
+	err = sdhc_spi_cmd_r2(data, SDHC_SEND_STATUS, 0);
+
 error:
 	sdhc_spi_set_cs(data, 1);
 
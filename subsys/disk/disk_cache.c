@@ -0,0 +1,399 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Write-back sector cache between disk_access and the disk drivers.
+ *
+ * Sectors are kept in a LRU list, the most recently used first. Small reads
+ * and writes go through the cache, larger transfers go straight to the
+ * driver. Dirty sectors are written back when evicted or on
+ * DISK_IOCTL_CTRL_SYNC, together with the adjacent dirty sectors in a
+ * single multi-sector write of up to CONFIG_DISK_CACHE_BURST sectors.
+ */
+
+#include <string.h>
+#include <zephyr/types.h>
+#include <sys/util.h>
+#include <sys/dlist.h>
+#include <init.h>
+#include <disk/disk_access.h>
+#include <errno.h>
+
+#include "disk_cache.h"
+
+#define SECTOR_SIZE CONFIG_DISK_CACHE_SECTOR_SIZE
+
+BUILD_ASSERT(CONFIG_DISK_CACHE_BURST <= CONFIG_DISK_CACHE_SECTORS,
+	     "Bursts must fit in the cache");
+
+struct cache_block {
+	sys_dnode_t node;
+	/* NULL if the block is unused */
+	struct disk_info *disk;
+	uint32_t sector;
+	bool dirty;
+	uint8_t data[SECTOR_SIZE] __aligned(4);
+};
+
+static struct cache_block blocks[CONFIG_DISK_CACHE_SECTORS];
+static uint8_t burst_buf[CONFIG_DISK_CACHE_BURST][SECTOR_SIZE] __aligned(4);
+static sys_dlist_t lru;
+static struct k_mutex cache_lock;
+
+/* End of the last read, to detect sequential reads */
+static struct disk_info *last_disk;
+static uint32_t last_end;
+
+static bool cache_usable(struct disk_info *disk)
+{
+	uint32_t size;
+
+	if ((disk->ops->ioctl == NULL) ||
+	    disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_SIZE, &size)) {
+		return false;
+	}
+
+	return size == SECTOR_SIZE;
+}
+
+static struct cache_block *cache_find(struct disk_info *disk, uint32_t sector)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(blocks); i++) {
+		if ((blocks[i].disk == disk) && (blocks[i].sector == sector)) {
+			return &blocks[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void cache_touch(struct cache_block *blk)
+{
+	sys_dlist_remove(&blk->node);
+	sys_dlist_prepend(&lru, &blk->node);
+}
+
+static void cache_invalidate(struct cache_block *blk)
+{
+	blk->disk = NULL;
+	blk->dirty = false;
+	sys_dlist_remove(&blk->node);
+	sys_dlist_append(&lru, &blk->node);
+}
+
+/* Write blk back along with the adjacent dirty sectors. */
+static int cache_flush_run(struct cache_block *blk)
+{
+	struct disk_info *disk = blk->disk;
+	struct cache_block *run[CONFIG_DISK_CACHE_BURST];
+	struct cache_block *b;
+	uint32_t first = blk->sector;
+	uint32_t cnt;
+	int rc;
+
+	while ((first > 0U) &&
+	       (blk->sector - first + 1U < CONFIG_DISK_CACHE_BURST)) {
+		b = cache_find(disk, first - 1U);
+		if ((b == NULL) || !b->dirty) {
+			break;
+		}
+		first--;
+	}
+
+	for (cnt = 0U; cnt < CONFIG_DISK_CACHE_BURST; cnt++) {
+		b = cache_find(disk, first + cnt);
+		if ((b == NULL) || !b->dirty) {
+			break;
+		}
+		run[cnt] = b;
+	}
+
+	if (cnt == 1U) {
+		rc = disk->ops->write(disk, blk->data, blk->sector, 1);
+	} else {
+		for (uint32_t i = 0U; i < cnt; i++) {
+			memcpy(burst_buf[i], run[i]->data, SECTOR_SIZE);
+		}
+		rc = disk->ops->write(disk, burst_buf[0], first, cnt);
+	}
+
+	if (rc == 0) {
+		for (uint32_t i = 0U; i < cnt; i++) {
+			run[i]->dirty = false;
+		}
+	}
+
+	return rc;
+}
+
+/* Write back the dirty blocks among the cnt least recently used ones, so
+ * that they can be reused without writing.
+ */
+static int cache_clean_tail(size_t cnt)
+{
+	sys_dnode_t *node = sys_dlist_peek_tail(&lru);
+	struct cache_block *blk;
+	int rc;
+
+	while ((node != NULL) && (cnt-- > 0U)) {
+		blk = CONTAINER_OF(node, struct cache_block, node);
+		if ((blk->disk != NULL) && blk->dirty) {
+			rc = cache_flush_run(blk);
+			if (rc) {
+				return rc;
+			}
+		}
+		node = sys_dlist_peek_prev_no_check(&lru, node);
+	}
+
+	return 0;
+}
+
+/* Take the least recently used block for sector. */
+static int cache_alloc(struct disk_info *disk, uint32_t sector,
+		       struct cache_block **out)
+{
+	struct cache_block *blk;
+	int rc;
+
+	blk = CONTAINER_OF(sys_dlist_peek_tail(&lru), struct cache_block,
+			   node);
+	if ((blk->disk != NULL) && blk->dirty) {
+		rc = cache_flush_run(blk);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	blk->disk = disk;
+	blk->sector = sector;
+	blk->dirty = false;
+	cache_touch(blk);
+	*out = blk;
+
+	return 0;
+}
+
+/* Cache a clean copy of a sector read from disk, if not cached already. */
+static int cache_insert(struct disk_info *disk, uint32_t sector,
+			const uint8_t *data)
+{
+	struct cache_block *blk;
+	int rc;
+
+	if (cache_find(disk, sector) != NULL) {
+		return 0;
+	}
+
+	rc = cache_alloc(disk, sector, &blk);
+	if (rc == 0) {
+		memcpy(blk->data, data, SECTOR_SIZE);
+	}
+
+	return rc;
+}
+
+/* Read a burst of sectors starting at sector into the cache. */
+static int cache_read_ahead(struct disk_info *disk, uint32_t sector)
+{
+	int rc;
+
+	/* cache_insert() must not flush, which would clobber burst_buf */
+	rc = cache_clean_tail(CONFIG_DISK_CACHE_BURST);
+	if (rc) {
+		return rc;
+	}
+
+	rc = disk->ops->read(disk, burst_buf[0], sector,
+			     CONFIG_DISK_CACHE_BURST);
+	if (rc) {
+		return rc;
+	}
+
+	for (uint32_t i = 0U; i < CONFIG_DISK_CACHE_BURST; i++) {
+		rc = cache_insert(disk, sector + i, burst_buf[i]);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	return 0;
+}
+
+int disk_cache_read(struct disk_info *disk, uint8_t *data_buf,
+		    uint32_t start_sector, uint32_t num_sector)
+{
+	struct cache_block *blk;
+	bool sequential;
+	uint32_t run;
+	int rc = 0;
+
+	if (!cache_usable(disk)) {
+		return disk->ops->read(disk, data_buf, start_sector,
+				       num_sector);
+	}
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	sequential = (disk == last_disk) && (start_sector == last_end);
+	last_disk = disk;
+	last_end = start_sector + num_sector;
+
+	while (num_sector > 0U) {
+		blk = cache_find(disk, start_sector);
+		if (blk != NULL) {
+			memcpy(data_buf, blk->data, SECTOR_SIZE);
+			cache_touch(blk);
+			data_buf += SECTOR_SIZE;
+			start_sector++;
+			num_sector--;
+			continue;
+		}
+
+		for (run = 1U; run < num_sector; run++) {
+			if (cache_find(disk, start_sector + run) != NULL) {
+				break;
+			}
+		}
+
+		/* A read-ahead past the end of the disk fails, then the
+		 * sectors are read as requested.
+		 */
+		if (IS_ENABLED(CONFIG_DISK_CACHE_READ_AHEAD) && sequential &&
+		    (run < CONFIG_DISK_CACHE_BURST) &&
+		    (cache_read_ahead(disk, start_sector) == 0)) {
+			continue;
+		}
+
+		rc = disk->ops->read(disk, data_buf, start_sector, run);
+		if (rc) {
+			break;
+		}
+
+		/* Larger transfers are file data rather than metadata */
+		for (uint32_t i = 0U;
+		     (run <= CONFIG_DISK_CACHE_BURST) && (i < run); i++) {
+			rc = cache_insert(disk, start_sector + i,
+					  data_buf + i * SECTOR_SIZE);
+			if (rc) {
+				goto out;
+			}
+		}
+
+		data_buf += run * SECTOR_SIZE;
+		start_sector += run;
+		num_sector -= run;
+	}
+
+out:
+	k_mutex_unlock(&cache_lock);
+	return rc;
+}
+
+int disk_cache_write(struct disk_info *disk, const uint8_t *data_buf,
+		     uint32_t start_sector, uint32_t num_sector)
+{
+	struct cache_block *blk;
+	int rc = 0;
+
+	if (!cache_usable(disk)) {
+		return disk->ops->write(disk, data_buf, start_sector,
+					num_sector);
+	}
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	if (num_sector > CONFIG_DISK_CACHE_BURST) {
+		/* Write large transfers through, dropping the cached copies
+		 * they overwrite.
+		 */
+		for (uint32_t i = 0U; i < num_sector; i++) {
+			blk = cache_find(disk, start_sector + i);
+			if (blk != NULL) {
+				cache_invalidate(blk);
+			}
+		}
+
+		rc = disk->ops->write(disk, data_buf, start_sector,
+				      num_sector);
+		goto out;
+	}
+
+	for (uint32_t i = 0U; i < num_sector; i++) {
+		blk = cache_find(disk, start_sector + i);
+		if (blk == NULL) {
+			rc = cache_alloc(disk, start_sector + i, &blk);
+			if (rc) {
+				break;
+			}
+		} else {
+			cache_touch(blk);
+		}
+
+		memcpy(blk->data, data_buf + i * SECTOR_SIZE, SECTOR_SIZE);
+		blk->dirty = true;
+	}
+
+out:
+	k_mutex_unlock(&cache_lock);
+	return rc;
+}
+
+int disk_cache_sync(struct disk_info *disk)
+{
+	int rc = 0;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(blocks); i++) {
+		if ((blocks[i].disk == disk) && blocks[i].dirty) {
+			rc = cache_flush_run(&blocks[i]);
+			if (rc) {
+				break;
+			}
+		}
+	}
+
+	k_mutex_unlock(&cache_lock);
+	return rc;
+}
+
+int disk_cache_drop(struct disk_info *disk)
+{
+	int rc;
+
+	rc = disk_cache_sync(disk);
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(blocks); i++) {
+		if (blocks[i].disk == disk) {
+			cache_invalidate(&blocks[i]);
+		}
+	}
+
+	if (last_disk == disk) {
+		last_disk = NULL;
+	}
+
+	k_mutex_unlock(&cache_lock);
+	return rc;
+}
+
+static int disk_cache_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_mutex_init(&cache_lock);
+	sys_dlist_init(&lru);
+	for (size_t i = 0; i < ARRAY_SIZE(blocks); i++) {
+		sys_dlist_append(&lru, &blocks[i].node);
+	}
+
+	return 0;
+}
+
+SYS_INIT(disk_cache_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
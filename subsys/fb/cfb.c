@@ -59,10 +59,40 @@ struct char_framebuffer {
 
 	/** Invertedj*/
 	bool inverted;
+
+	/** First tile row changed since the last finalize */
+	uint16_t dirty_first;
+
+	/** Last tile row changed since the last finalize */
+	uint16_t dirty_last;
 };
 
 static struct char_framebuffer char_fb;
 
+/*
+ * Extend the band of tile rows to write on the next finalize. The band
+ * spans the full width so that it stays contiguous in the buffer.
+ */
+static void cfb_mark_dirty(struct char_framebuffer *fb, uint16_t first,
+			   uint16_t last)
+{
+	last = MIN(last, fb->y_res / fb->ppt - 1U);
+
+	if (fb->dirty_first > fb->dirty_last) {
+		fb->dirty_first = first;
+		fb->dirty_last = last;
+		return;
+	}
+
+	fb->dirty_first = MIN(fb->dirty_first, first);
+	fb->dirty_last = MAX(fb->dirty_last, last);
+}
+
+static void cfb_mark_all_dirty(struct char_framebuffer *fb)
+{
+	cfb_mark_dirty(fb, 0, fb->y_res / fb->ppt - 1U);
+}
+
 static inline uint8_t *get_glyph_ptr(const struct cfb_font *fptr, char c)
 {
 	if (fptr->caps & CFB_FONT_MONO_VPACKED) {
@@ -78,7 +108,7 @@ static inline uint8_t *get_glyph_ptr(const struct cfb_font *fptr, char c)
  * Draw the monochrome character in the monochrome tiled framebuffer,
  * a byte is interpreted as 8 pixels ordered vertically among each other.
  */
-static uint8_t draw_char_vtmono(const struct char_framebuffer *fb,
+static uint8_t draw_char_vtmono(struct char_framebuffer *fb,
 			     char c, uint16_t x, uint16_t y)
 {
 	const struct cfb_font *fptr = &(fb->fonts[fb->font_idx]);
@@ -95,6 +125,8 @@ static uint8_t draw_char_vtmono(const struct char_framebuffer *fb,
 		return 0;
 	}
 
+	cfb_mark_dirty(fb, y / 8U, y / 8U + fptr->height / 8U - 1U);
+
 	for (size_t g_x = 0; g_x < fptr->width; g_x++) {
 		uint32_t y_segment = y / 8U;
 
@@ -121,7 +153,7 @@ static uint8_t draw_char_vtmono(const struct char_framebuffer *fb,
 
 int cfb_print(struct device *dev, char *str, uint16_t x, uint16_t y)
 {
-	const struct char_framebuffer *fb = &char_fb;
+	struct char_framebuffer *fb = &char_fb;
 	const struct cfb_font *fptr;
 
 	if (!fb->fonts || !fb->buf) {
@@ -150,29 +182,23 @@ int cfb_print(struct device *dev, char *str, uint16_t x, uint16_t y)
 	return -1;
 }
 
-static int cfb_invert(const struct char_framebuffer *fb)
+static void cfb_invert(uint8_t *buf, size_t len)
 {
-	for (size_t i = 0; i < fb->x_res * fb->y_res / 8U; i++) {
-		fb->buf[i] = ~fb->buf[i];
+	for (size_t i = 0; i < len; i++) {
+		buf[i] = ~buf[i];
 	}
-
-	return 0;
 }
 
 int cfb_framebuffer_clear(struct device *dev, bool clear_display)
 {
-	const struct char_framebuffer *fb = &char_fb;
-	struct display_buffer_descriptor desc;
+	struct char_framebuffer *fb = &char_fb;
 
 	if (!fb || !fb->buf) {
 		return -1;
 	}
 
-	desc.buf_size = fb->size;
-	desc.width = fb->x_res;
-	desc.height = fb->y_res;
-	desc.pitch = fb->x_res;
 	memset(fb->buf, 0, fb->size);
+	cfb_mark_all_dirty(fb);
 
 	return 0;
 }
@@ -187,6 +213,7 @@ int cfb_framebuffer_invert(struct device *dev)
 	}
 
 	fb->inverted = !fb->inverted;
+	cfb_mark_all_dirty(fb);
 
 	return 0;
 }
@@ -194,23 +221,53 @@ int cfb_framebuffer_invert(struct device *dev)
 int cfb_framebuffer_finalize(struct device *dev)
 {
 	const struct display_driver_api *api = dev->api;
-	const struct char_framebuffer *fb = &char_fb;
+	struct char_framebuffer *fb = &char_fb;
 	struct display_buffer_descriptor desc;
+	bool invert;
+	uint8_t *buf;
+	int err;
 
 	if (!fb || !fb->buf) {
 		return -1;
 	}
 
-	desc.buf_size = fb->size;
+	/*
+	 * Alternating RAM buffers hold an older frame, they only take
+	 * partial writes if the controller supports partial updates.
+	 */
+	if ((fb->screen_info & SCREEN_INFO_DOUBLE_BUFFER) &&
+	    !(fb->screen_info & SCREEN_INFO_PARTIAL_UPDATE)) {
+		cfb_mark_all_dirty(fb);
+	}
+
+	if (fb->dirty_first > fb->dirty_last) {
+		return 0;
+	}
+
+	buf = fb->buf + fb->dirty_first * fb->x_res;
 	desc.width = fb->x_res;
-	desc.height = fb->y_res;
+	desc.height = (fb->dirty_last - fb->dirty_first + 1U) * fb->ppt;
 	desc.pitch = fb->x_res;
+	desc.buf_size = desc.width * desc.height / fb->ppt;
+
+	/* Invert around the write only, the buffer keeps the drawn content */
+	invert = !(fb->pixel_format & PIXEL_FORMAT_MONO10) != !(fb->inverted);
+	if (invert) {
+		cfb_invert(buf, desc.buf_size);
+	}
+
+	err = api->write(dev, 0, fb->dirty_first * fb->ppt, &desc, buf);
+
+	if (invert) {
+		cfb_invert(buf, desc.buf_size);
+	}
 
-	if (!(fb->pixel_format & PIXEL_FORMAT_MONO10) != !(fb->inverted)) {
-		cfb_invert(fb);
+	if (err == 0) {
+		fb->dirty_first = UINT16_MAX;
+		fb->dirty_last = 0U;
 	}
 
-	return api->write(dev, 0, 0, &desc, fb->buf);
+	return err;
 }
 
 int cfb_get_display_parameter(struct device *dev,
@@ -312,6 +369,9 @@ int cfb_framebuffer_init(struct device *dev)
 	}
 
 	memset(fb->buf, 0, fb->size);
+	fb->dirty_first = UINT16_MAX;
+	fb->dirty_last = 0U;
+	cfb_mark_all_dirty(fb);
 
 	return 0;
 }
@@ -9,6 +9,7 @@
 #include <string.h>
 
 #include <fs/fcb.h>
+#include <sys/crc.h>
 #include "fcb_priv.h"
 
 static struct flash_sector *
@@ -56,10 +57,40 @@ fcb_append_to_scratch(struct fcb *fcb)
 	return 0;
 }
 
+/*
+ * Make room for len bytes in the active sector, taking a new sector into use
+ * if needed. Called with the FCB mutex held.
+ */
+static int
+fcb_append_room(struct fcb *fcb, uint32_t len)
+{
+	struct flash_sector *sector;
+	struct fcb_entry *active;
+	int rc;
+
+	active = &fcb->f_active;
+	if (active->fe_elem_off + len <= active->fe_sector->fs_size) {
+		return 0;
+	}
+
+	sector = fcb_new_sector(fcb, fcb->f_scratch_cnt);
+	if (!sector || (sector->fs_size <
+		sizeof(struct fcb_disk_area) + len)) {
+		return -ENOSPC;
+	}
+	rc = fcb_sector_hdr_init(fcb, sector, fcb->f_active_id + 1);
+	if (rc) {
+		return rc;
+	}
+	fcb->f_active.fe_sector = sector;
+	fcb->f_active.fe_elem_off = sizeof(struct fcb_disk_area);
+	fcb->f_active_id++;
+	return 0;
+}
+
 int
 fcb_append(struct fcb *fcb, uint16_t len, struct fcb_entry *append_loc)
 {
-	struct flash_sector *sector;
 	struct fcb_entry *active;
 	int cnt;
 	int rc;
@@ -79,20 +110,9 @@ fcb_append(struct fcb *fcb, uint16_t len, struct fcb_entry *append_loc)
 		return -EINVAL;
 	}
 	active = &fcb->f_active;
-	if (active->fe_elem_off + len + cnt > active->fe_sector->fs_size) {
-		sector = fcb_new_sector(fcb, fcb->f_scratch_cnt);
-		if (!sector || (sector->fs_size <
-			sizeof(struct fcb_disk_area) + len + cnt)) {
-			rc = -ENOSPC;
-			goto err;
-		}
-		rc = fcb_sector_hdr_init(fcb, sector, fcb->f_active_id + 1);
-		if (rc) {
-			goto err;
-		}
-		fcb->f_active.fe_sector = sector;
-		fcb->f_active.fe_elem_off = sizeof(struct fcb_disk_area);
-		fcb->f_active_id++;
+	rc = fcb_append_room(fcb, len + cnt);
+	if (rc) {
+		goto err;
 	}
 
 	rc = fcb_flash_write(fcb, active->fe_sector, active->fe_elem_off, tmp_str, cnt);
@@ -135,3 +155,77 @@ fcb_append_finish(struct fcb *fcb, struct fcb_entry *loc)
 	}
 	return 0;
 }
+
+int
+fcb_append_batch(struct fcb *fcb, const struct fcb_batch_elem *elems,
+		 size_t cnt, uint8_t *buf, size_t buf_size)
+{
+	struct fcb_entry *active;
+	size_t off;
+	size_t i;
+	int hdr_len;
+	int data_len;
+	int crc_len;
+	uint8_t crc8;
+	int rc;
+
+	/*
+	 * Encode the entries the way fcb_append() and fcb_append_finish()
+	 * lay them out in flash.
+	 */
+	crc_len = fcb_len_in_flash(fcb, FCB_CRC_SZ);
+	off = 0;
+	for (i = 0; i < cnt; i++) {
+		uint8_t tmp_str[8];
+
+		hdr_len = fcb_put_len(tmp_str, elems[i].len);
+		if (hdr_len < 0) {
+			return hdr_len;
+		}
+		crc8 = crc8_ccitt(CRC8_CCITT_INITIAL_VALUE, tmp_str, hdr_len);
+		crc8 = crc8_ccitt(crc8, elems[i].data, elems[i].len);
+
+		data_len = fcb_len_in_flash(fcb, elems[i].len);
+		if (off + fcb_len_in_flash(fcb, hdr_len) + data_len +
+		    crc_len > buf_size) {
+			return -ENOMEM;
+		}
+
+		(void)memset(&buf[off], 0xFF, fcb_len_in_flash(fcb, hdr_len));
+		memcpy(&buf[off], tmp_str, hdr_len);
+		off += fcb_len_in_flash(fcb, hdr_len);
+
+		(void)memset(&buf[off], 0xFF, data_len);
+		memcpy(&buf[off], elems[i].data, elems[i].len);
+		off += data_len;
+
+		(void)memset(&buf[off], 0xFF, crc_len);
+		buf[off] = crc8;
+		off += crc_len;
+	}
+
+	if (off == 0) {
+		return 0;
+	}
+
+	rc = k_mutex_lock(&fcb->f_mtx, K_FOREVER);
+	if (rc) {
+		return -EINVAL;
+	}
+	active = &fcb->f_active;
+	rc = fcb_append_room(fcb, off);
+	if (rc) {
+		goto out;
+	}
+
+	rc = fcb_flash_write(fcb, active->fe_sector, active->fe_elem_off, buf,
+			     off);
+	if (rc) {
+		rc = -EIO;
+		goto out;
+	}
+	active->fe_elem_off += off;
+out:
+	k_mutex_unlock(&fcb->f_mtx);
+	return rc;
+}
@@ -8,6 +8,7 @@
 #include <string.h>
 #include <zephyr/types.h>
 #include <errno.h>
+#include <kernel.h>
 #include <init.h>
 #include <fs/fs.h>
 #include <sys/stat.h>
@@ -166,6 +167,143 @@ ssize_t fs_write(struct fs_file_t *zfp, const void *ptr, size_t size)
 	return rc;
 }
 
+ssize_t fs_readv(struct fs_file_t *zfp, const struct fs_iovec *iov,
+		 int iovcnt)
+{
+	ssize_t total = 0;
+	ssize_t rc;
+
+	if (zfp->mp == NULL) {
+		return -EBADF;
+	}
+
+	if ((iov == NULL) || (iovcnt < 0)) {
+		return -EINVAL;
+	}
+
+	if (zfp->mp->fs->readv != NULL) {
+		rc = zfp->mp->fs->readv(zfp, iov, iovcnt);
+		if (rc < 0) {
+			LOG_ERR("file read error (%zd)", rc);
+		}
+		return rc;
+	}
+
+	for (int i = 0; i < iovcnt; i++) {
+		rc = fs_read(zfp, iov[i].base, iov[i].len);
+		if (rc < 0) {
+			return (total > 0) ? total : rc;
+		}
+
+		total += rc;
+		if ((size_t)rc < iov[i].len) {
+			break;
+		}
+	}
+
+	return total;
+}
+
+ssize_t fs_writev(struct fs_file_t *zfp, const struct fs_iovec *iov,
+		  int iovcnt)
+{
+	ssize_t total = 0;
+	ssize_t rc;
+
+	if (zfp->mp == NULL) {
+		return -EBADF;
+	}
+
+	if ((iov == NULL) || (iovcnt < 0)) {
+		return -EINVAL;
+	}
+
+	if (zfp->mp->fs->writev != NULL) {
+		rc = zfp->mp->fs->writev(zfp, iov, iovcnt);
+		if (rc < 0) {
+			LOG_ERR("file write error (%zd)", rc);
+		}
+		return rc;
+	}
+
+	for (int i = 0; i < iovcnt; i++) {
+		rc = fs_write(zfp, iov[i].base, iov[i].len);
+		if (rc < 0) {
+			return (total > 0) ? total : rc;
+		}
+
+		total += rc;
+		if ((size_t)rc < iov[i].len) {
+			break;
+		}
+	}
+
+	return total;
+}
+
+#ifdef CONFIG_FS_ASYNC
+static K_FIFO_DEFINE(fs_async_fifo);
+
+static int fs_async_submit(struct fs_async_op *op, struct fs_file_t *zfp,
+			   const struct fs_iovec *iov, int iovcnt,
+			   struct k_poll_signal *signal, bool write)
+{
+	if ((op == NULL) || (iov == NULL) || (iovcnt < 0) ||
+	    (signal == NULL)) {
+		return -EINVAL;
+	}
+
+	if (zfp->mp == NULL) {
+		return -EBADF;
+	}
+
+	op->zfp = zfp;
+	op->iov = iov;
+	op->iovcnt = iovcnt;
+	op->write = write;
+	op->signal = signal;
+
+	k_fifo_put(&fs_async_fifo, op);
+
+	return 0;
+}
+
+int fs_readv_async(struct fs_async_op *op, struct fs_file_t *zfp,
+		   const struct fs_iovec *iov, int iovcnt,
+		   struct k_poll_signal *signal)
+{
+	return fs_async_submit(op, zfp, iov, iovcnt, signal, false);
+}
+
+int fs_writev_async(struct fs_async_op *op, struct fs_file_t *zfp,
+		    const struct fs_iovec *iov, int iovcnt,
+		    struct k_poll_signal *signal)
+{
+	return fs_async_submit(op, zfp, iov, iovcnt, signal, true);
+}
+
+static void fs_async_thread(void *p1, void *p2, void *p3)
+{
+	struct fs_async_op *op;
+	ssize_t rc;
+
+	for (;;) {
+		op = k_fifo_get(&fs_async_fifo, K_FOREVER);
+
+		if (op->write) {
+			rc = fs_writev(op->zfp, op->iov, op->iovcnt);
+		} else {
+			rc = fs_readv(op->zfp, op->iov, op->iovcnt);
+		}
+
+		k_poll_signal_raise(op->signal, rc);
+	}
+}
+
+K_THREAD_DEFINE(fs_async, CONFIG_FS_ASYNC_STACK_SIZE, fs_async_thread,
+		NULL, NULL, NULL, CONFIG_FS_ASYNC_THREAD_PRIO, 0, 0);
+#endif /* CONFIG_FS_ASYNC */
+
 int fs_seek(struct fs_file_t *zfp, off_t offset, int whence)
 {
 	int rc = -EINVAL;
@@ -138,6 +138,16 @@ static int lfs_api_read(const struct lfs_config *c, lfs_block_t block,
 	const struct flash_area *fa = c->context;
 	size_t offset = block * c->block_size + off;
 
+#ifdef CONFIG_FS_LITTLEFS_MMAP_READ
+	const struct fs_littlefs *fs =
+		CONTAINER_OF(c, struct fs_littlefs, cfg);
+
+	if (fs->mmap != NULL) {
+		memcpy(buffer, fs->mmap + offset, size);
+		return LFS_ERR_OK;
+	}
+#endif
+
 	int rc = flash_area_read(fa, offset, buffer, size);
 
 	return errno_to_lfs(rc);
@@ -305,6 +315,61 @@ static ssize_t littlefs_write(struct fs_file_t *fp, const void *ptr, size_t len)
 	return lfs_to_errno(ret);
 }
 
+/* The buffers are transferred under a single lock, so that the data of
+ * concurrent writers is not interleaved.
+ */
+static ssize_t littlefs_readv(struct fs_file_t *fp, const struct fs_iovec *iov,
+			      int iovcnt)
+{
+	struct fs_littlefs *fs = fp->mp->fs_data;
+	ssize_t total = 0;
+	lfs_ssize_t ret = 0;
+
+	fs_lock(fs);
+
+	for (int i = 0; i < iovcnt; i++) {
+		ret = lfs_file_read(&fs->lfs, LFS_FILEP(fp), iov[i].base,
+				    iov[i].len);
+		if (ret < 0) {
+			break;
+		}
+
+		total += ret;
+		if ((size_t)ret < iov[i].len) {
+			break;
+		}
+	}
+
+	fs_unlock(fs);
+	return ((ret < 0) && (total == 0)) ? lfs_to_errno(ret) : total;
+}
+
+static ssize_t littlefs_writev(struct fs_file_t *fp,
+			       const struct fs_iovec *iov, int iovcnt)
+{
+	struct fs_littlefs *fs = fp->mp->fs_data;
+	ssize_t total = 0;
+	lfs_ssize_t ret = 0;
+
+	fs_lock(fs);
+
+	for (int i = 0; i < iovcnt; i++) {
+		ret = lfs_file_write(&fs->lfs, LFS_FILEP(fp), iov[i].base,
+				     iov[i].len);
+		if (ret < 0) {
+			break;
+		}
+
+		total += ret;
+		if ((size_t)ret < iov[i].len) {
+			break;
+		}
+	}
+
+	fs_unlock(fs);
+	return ((ret < 0) && (total == 0)) ? lfs_to_errno(ret) : total;
+}
+
 BUILD_ASSERT((FS_SEEK_SET == LFS_SEEK_SET)
 	     && (FS_SEEK_CUR == LFS_SEEK_CUR)
 	     && (FS_SEEK_END == LFS_SEEK_END));
@@ -538,11 +603,60 @@ static lfs_size_t get_block_size(const struct flash_area *fa)
 	};
 	struct device *dev = flash_area_get_device(fa);
 
-	flash_page_foreach(dev, get_page_cb, &ctx);
+	flash_page_foreach_in_range(dev, fa->fa_off, fa->fa_size,
+				    get_page_cb, &ctx);
 
 	return ctx.max_size;
 }
 
+#ifdef CONFIG_FS_LITTLEFS_CACHE_POOL
+/* Allocate the missing read and program caches from the pool */
+static int alloc_caches(struct fs_littlefs *fs, lfs_size_t cache_size)
+{
+	struct lfs_config *lcp = &fs->cfg;
+	int ret;
+
+	memset(fs->cache_blocks, 0, sizeof(fs->cache_blocks));
+
+	if (lcp->read_buffer == NULL) {
+		ret = k_mem_pool_alloc(&file_cache_pool, &fs->cache_blocks[0],
+				       cache_size, K_NO_WAIT);
+		if (ret != 0) {
+			return -ENOMEM;
+		}
+		lcp->read_buffer = fs->cache_blocks[0].data;
+	}
+
+	if (lcp->prog_buffer == NULL) {
+		ret = k_mem_pool_alloc(&file_cache_pool, &fs->cache_blocks[1],
+				       cache_size, K_NO_WAIT);
+		if (ret != 0) {
+			return -ENOMEM;
+		}
+		lcp->prog_buffer = fs->cache_blocks[1].data;
+	}
+
+	return 0;
+}
+
+static void free_caches(struct fs_littlefs *fs)
+{
+	struct lfs_config *lcp = &fs->cfg;
+
+	if (fs->cache_blocks[0].data != NULL) {
+		k_mem_pool_free(&fs->cache_blocks[0]);
+		fs->cache_blocks[0].data = NULL;
+		lcp->read_buffer = NULL;
+	}
+
+	if (fs->cache_blocks[1].data != NULL) {
+		k_mem_pool_free(&fs->cache_blocks[1]);
+		fs->cache_blocks[1].data = NULL;
+		lcp->prog_buffer = NULL;
+	}
+}
+#endif /* CONFIG_FS_LITTLEFS_CACHE_POOL */
+
 static int littlefs_mount(struct fs_mount_t *mountp)
 {
 	int ret;
@@ -660,6 +774,28 @@ static int littlefs_mount(struct fs_mount_t *mountp)
 	__ASSERT((block_size % cache_size) == 0,
 		 "cache size incompatible with block size");
 
+#ifdef CONFIG_FS_LITTLEFS_CACHE_POOL
+	ret = alloc_caches(fs, cache_size);
+	if (ret != 0) {
+		LOG_ERR("can't allocate %u byte caches", cache_size);
+		goto out;
+	}
+#endif
+
+#if defined(CONFIG_FS_LITTLEFS_MMAP_READ) && \
+	defined(DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL)
+	/* The internal flash is mapped at CONFIG_FLASH_BASE_ADDRESS */
+	if (strcmp(fs->area->fa_dev_name,
+		   DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL) == 0) {
+		fs->mmap = (const uint8_t *)CONFIG_FLASH_BASE_ADDRESS +
+			   fs->area->fa_off;
+	} else {
+		fs->mmap = NULL;
+	}
+#elif defined(CONFIG_FS_LITTLEFS_MMAP_READ)
+	fs->mmap = NULL;
+#endif
+
 	/* Set the validated/defaulted values. */
 	lcp->context = (void *)fs->area;
 	lcp->read = lfs_api_read;
@@ -696,6 +832,11 @@ static int littlefs_mount(struct fs_mount_t *mountp)
 
 out:
 	if (ret < 0) {
+#ifdef CONFIG_FS_LITTLEFS_CACHE_POOL
+		if (fs->area != NULL) {
+			free_caches(fs);
+		}
+#endif
 		fs->area = NULL;
 	}
 
@@ -711,6 +852,9 @@ static int littlefs_unmount(struct fs_mount_t *mountp)
 	fs_lock(fs);
 
 	lfs_unmount(&fs->lfs);
+#ifdef CONFIG_FS_LITTLEFS_CACHE_POOL
+	free_caches(fs);
+#endif
 	flash_area_close(fs->area);
 	fs->area = NULL;
 
@@ -741,6 +885,8 @@ static struct fs_file_system_t littlefs_fs = {
 	.mkdir = littlefs_mkdir,
 	.stat = littlefs_stat,
 	.statvfs = littlefs_statvfs,
+	.readv = littlefs_readv,
+	.writev = littlefs_writev,
 };
 
 static int littlefs_init(struct device *dev)
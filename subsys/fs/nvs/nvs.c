@@ -27,6 +27,13 @@ static inline size_t nvs_al_size(struct nvs_fs *fs, size_t len)
 	}
 	return (len + (write_block_size - 1U)) & ~(write_block_size - 1U);
 }
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+static inline size_t nvs_lookup_cache_pos(uint16_t id)
+{
+	return id % CONFIG_NVS_LOOKUP_CACHE_SIZE;
+}
+#endif
 /* end basic routines */
 
 /* flash routines */
@@ -106,6 +113,12 @@ static int nvs_flash_ate_wrt(struct nvs_fs *fs, const struct nvs_ate *entry)
 
 	rc = nvs_flash_al_wrt(fs, fs->ate_wra, entry,
 			       sizeof(struct nvs_ate));
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	/* close ate's use the 0xFFFF id and are never looked up */
+	if (entry->id != 0xFFFF) {
+		fs->lookup_cache[nvs_lookup_cache_pos(entry->id)] = fs->ate_wra;
+	}
+#endif
 	fs->ate_wra -= nvs_al_size(fs, sizeof(struct nvs_ate));
 
 	return rc;
@@ -252,6 +265,17 @@ static int nvs_flash_erase_sector(struct nvs_fs *fs, uint32_t addr)
 		return rc;
 	}
 	(void) flash_write_protection_set(fs->flash_device, 1);
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	/* Only the oldest sector is erased during operation, so a cache
+	 * entry still pointing into it has no more recent ate anywhere else.
+	 */
+	for (size_t i = 0; i < CONFIG_NVS_LOOKUP_CACHE_SIZE; i++) {
+		if ((fs->lookup_cache[i] & ADDR_SECT_MASK) == addr) {
+			fs->lookup_cache[i] = NVS_LOOKUP_CACHE_NO_ADDR;
+		}
+	}
+#endif
 	return 0;
 }
 
@@ -466,6 +490,18 @@ static int nvs_sector_close(struct nvs_fs *fs)
 }
 
 
+/* address of the ate to start searching the latest entry with id from,
+ * NVS_LOOKUP_CACHE_NO_ADDR if there is none.
+ */
+static uint32_t nvs_lookup_start(struct nvs_fs *fs, uint16_t id)
+{
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	return fs->lookup_cache[nvs_lookup_cache_pos(id)];
+#else
+	return fs->ate_wra;
+#endif
+}
+
 /* garbage collection: the address ate_wra has been updated to the new sector
  * that has just been started. The data to gc is in the sector after this new
  * sector.
@@ -523,7 +559,8 @@ static int nvs_gc(struct nvs_fs *fs)
 			continue;
 		}
 
-		wlk_addr = fs->ate_wra;
+		/* gc_ate is valid so the lookup cache has an entry for it */
+		wlk_addr = nvs_lookup_start(fs, gc_ate.id);
 		do {
 			wlk_prev_addr = wlk_addr;
 			rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
@@ -573,6 +610,38 @@ static int nvs_gc(struct nvs_fs *fs)
 	return 0;
 }
 
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+/* fill the lookup cache by walking the allocation table from the newest to
+ * the oldest entry, keeping the first valid ate found for each cache entry.
+ */
+static int nvs_lookup_cache_rebuild(struct nvs_fs *fs)
+{
+	int rc;
+	uint32_t addr, ate_addr;
+	uint32_t *cache_entry;
+	struct nvs_ate ate;
+
+	memset(fs->lookup_cache, 0xff, sizeof(fs->lookup_cache));
+	addr = fs->ate_wra;
+
+	do {
+		ate_addr = addr;
+		rc = nvs_prev_ate(fs, &addr, &ate);
+		if (rc) {
+			return rc;
+		}
+
+		cache_entry = &fs->lookup_cache[nvs_lookup_cache_pos(ate.id)];
+		if ((*cache_entry == NVS_LOOKUP_CACHE_NO_ADDR) &&
+		    (ate.id != 0xFFFF) && (!nvs_ate_crc8_check(&ate))) {
+			*cache_entry = ate_addr;
+		}
+	} while (addr != fs->ate_wra);
+
+	return 0;
+}
+#endif
+
 static int nvs_startup(struct nvs_fs *fs)
 {
 	int rc;
@@ -585,6 +654,7 @@ static int nvs_startup(struct nvs_fs *fs)
 	uint32_t addr = 0U;
 	uint16_t i, closed_sectors = 0;
 	uint8_t erase_value = fs->flash_parameters->erase_value;
+	bool gc_needed;
 
 	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
 
@@ -693,7 +763,8 @@ static int nvs_startup(struct nvs_fs *fs)
 	if (rc < 0) {
 		goto end;
 	}
-	if (rc) {
+	gc_needed = (rc != 0);
+	if (gc_needed) {
 		/* the sector after fs->ate_wrt is not empty */
 		rc = nvs_flash_erase_sector(fs, fs->ate_wra);
 		if (rc) {
@@ -702,10 +773,18 @@ static int nvs_startup(struct nvs_fs *fs)
 		fs->ate_wra &= ADDR_SECT_MASK;
 		fs->ate_wra += (fs->sector_size - 2 * ate_size);
 		fs->data_wra = (fs->ate_wra & ADDR_SECT_MASK);
+	}
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	/* gc relies on the lookup cache */
+	rc = nvs_lookup_cache_rebuild(fs);
+	if (rc) {
+		goto end;
+	}
+#endif
+
+	if (gc_needed) {
 		rc = nvs_gc(fs);
-		if (rc) {
-			goto end;
-		}
 	}
 
 end:
@@ -825,10 +904,10 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 	}
 
 	/* find latest entry with same id */
-	wlk_addr = fs->ate_wra;
+	wlk_addr = nvs_lookup_start(fs, id);
 	rd_addr = wlk_addr;
 
-	while (1) {
+	while (wlk_addr != NVS_LOOKUP_CACHE_NO_ADDR) {
 		rd_addr = wlk_addr;
 		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
 		if (rc) {
@@ -921,6 +1000,40 @@ int nvs_delete(struct nvs_fs *fs, uint16_t id)
 	return nvs_write(fs, id, NULL, 0);
 }
 
+int nvs_gc_ahead(struct nvs_fs *fs, size_t len)
+{
+	int rc = 0;
+	size_t ate_size;
+
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	if (len > (fs->sector_size - 3 * ate_size)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	/* same condition as in nvs_write, including the delete ate space */
+	if (fs->ate_wra >= fs->data_wra + nvs_al_size(fs, len) + ate_size) {
+		goto end;
+	}
+
+	rc = nvs_sector_close(fs);
+	if (rc) {
+		goto end;
+	}
+
+	rc = nvs_gc(fs);
+end:
+	k_mutex_unlock(&fs->nvs_lock);
+	return rc;
+}
+
 ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 		      uint16_t cnt)
 {
@@ -943,7 +1056,10 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 
 	cnt_his = 0U;
 
-	wlk_addr = fs->ate_wra;
+	wlk_addr = nvs_lookup_start(fs, id);
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		return -ENOENT;
+	}
 	rd_addr = wlk_addr;
 
 	while (cnt_his <= cnt) {
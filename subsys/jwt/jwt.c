@@ -119,7 +119,32 @@ static int base64_append_bytes(const char *bytes, size_t len,
 			 void *data)
 {
 	struct jwt_builder *st = data;
+	const uint8_t *b;
 
+	/* Complete the pending group first. */
+	while (len > 0 && st->pending != 0) {
+		base64_addbyte(st, *bytes++);
+		len--;
+	}
+
+	/*
+	 * Whole groups are then encoded straight into the token, as
+	 * long as they fit with the terminating null.
+	 */
+	b = (const uint8_t *)bytes;
+	while (len >= 3 && !st->overflowed && st->len > 4) {
+		st->buf[0] = base64_char(b[0] >> 2);
+		st->buf[1] = base64_char(((b[0] & 0x03) << 4) | (b[1] >> 4));
+		st->buf[2] = base64_char(((b[1] & 0x0f) << 2) | (b[2] >> 6));
+		st->buf[3] = base64_char(b[2] & 0x3f);
+		st->buf += 4;
+		st->len -= 4;
+		*st->buf = 0;
+		b += 3;
+		len -= 3;
+	}
+
+	bytes = (const char *)b;
 	while (len-- > 0) {
 		base64_addbyte(st, *bytes++);
 	}
@@ -127,15 +152,17 @@ static int base64_append_bytes(const char *bytes, size_t len,
 	return 0;
 }
 
-struct jwt_header {
-	char *typ;
-	char *alg;
-};
-
-static struct json_obj_descr jwt_header_desc[] = {
-	JSON_OBJ_DESCR_PRIM(struct jwt_header, alg, JSON_TOK_STRING),
-	JSON_OBJ_DESCR_PRIM(struct jwt_header, typ, JSON_TOK_STRING),
-};
+/*
+ * The header never changes, so it is stored already encoded. This is
+ * the base64url encoding of {"alg":"RS256","typ":"JWT"} or of
+ * {"alg":"ES256","typ":"JWT"}, which has no padding.
+ */
+#ifdef CONFIG_JWT_SIGN_RSA
+static const char jwt_header_b64[] = "eyJhbGciOiJSUzI1NiIsInR5cCI6IkpXVCJ9";
+#endif
+#ifdef CONFIG_JWT_SIGN_ECDSA
+static const char jwt_header_b64[] = "eyJhbGciOiJFUzI1NiIsInR5cCI6IkpXVCJ9";
+#endif
 
 struct jwt_payload {
 	int32_t exp;
@@ -154,23 +181,16 @@ static struct json_obj_descr jwt_payload_desc[] = {
  */
 static void jwt_add_header(struct jwt_builder *builder)
 {
-	static const struct jwt_header head = {
-		.typ = "JWT",
-#ifdef CONFIG_JWT_SIGN_RSA
-		.alg = "RS256",
-#endif
-#ifdef CONFIG_JWT_SIGN_ECDSA
-		.alg = "ES256",
-#endif
-	};
+	size_t len = sizeof(jwt_header_b64) - 1;
 
-	int res = json_obj_encode(jwt_header_desc, ARRAY_SIZE(jwt_header_desc),
-				  &head, base64_append_bytes, builder);
-	if (res != 0) {
-		/* Log an error here. */
+	if (builder->len <= len) {
+		builder->overflowed = true;
 		return;
 	}
-	base64_flush(builder);
+
+	memcpy(builder->buf, jwt_header_b64, sizeof(jwt_header_b64));
+	builder->buf += len;
+	builder->len -= len;
 }
 
 int jwt_add_payload(struct jwt_builder *builder,
@@ -194,21 +214,32 @@ int jwt_add_payload(struct jwt_builder *builder,
 }
 
 #ifdef CONFIG_JWT_SIGN_RSA
-int jwt_sign(struct jwt_builder *builder,
-	     const char *der_key,
-	     size_t der_key_len)
+int jwt_signer_init(struct jwt_signer *signer,
+		    const char *der_key,
+		    size_t der_key_len)
 {
 	int res;
-	mbedtls_pk_context ctx;
 
-	mbedtls_pk_init(&ctx);
+	mbedtls_pk_init(&signer->pk);
 
-	res = mbedtls_pk_parse_key(&ctx, der_key, der_key_len,
-				       NULL, 0);
+	res = mbedtls_pk_parse_key(&signer->pk, der_key, der_key_len,
+				   NULL, 0);
 	if (res != 0) {
-		return res;
+		mbedtls_pk_free(&signer->pk);
 	}
 
+	return res;
+}
+
+void jwt_signer_free(struct jwt_signer *signer)
+{
+	mbedtls_pk_free(&signer->pk);
+}
+
+int jwt_signer_sign(struct jwt_signer *signer,
+		    struct jwt_builder *builder)
+{
+	int res;
 	uint8_t hash[32], sig[256];
 	size_t sig_len = sizeof(sig);
 
@@ -219,7 +250,7 @@ int jwt_sign(struct jwt_builder *builder,
 	mbedtls_sha256(builder->base, builder->buf - builder->base,
 		       hash, 0);
 
-	res = mbedtls_pk_sign(&ctx, MBEDTLS_MD_SHA256,
+	res = mbedtls_pk_sign(&signer->pk, MBEDTLS_MD_SHA256,
 			      hash, sizeof(hash),
 			      sig, &sig_len,
 			      NULL, NULL);
@@ -270,27 +301,43 @@ int default_CSPRNG(uint8_t *dest, unsigned int size)
 	return res;
 }
 
-int jwt_sign(struct jwt_builder *builder,
-	     const char *der_key,
-	     size_t der_key_len)
+int jwt_signer_init(struct jwt_signer *signer,
+		    const char *der_key,
+		    size_t der_key_len)
 {
-	struct tc_sha256_state_struct ctx;
-	uint8_t hash[32], sig[64];
 	int res;
 
-	tc_sha256_init(&ctx);
-	tc_sha256_update(&ctx, builder->base, builder->buf - builder->base);
-	tc_sha256_final(hash, &ctx);
+	ARG_UNUSED(der_key_len);
 
 	res = setup_prng();
-
 	if (res != 0) {
 		return res;
 	}
 	uECC_set_rng(&default_CSPRNG);
 
+	signer->key = (const uint8_t *)der_key;
+
+	return 0;
+}
+
+void jwt_signer_free(struct jwt_signer *signer)
+{
+	signer->key = NULL;
+}
+
+int jwt_signer_sign(struct jwt_signer *signer,
+		    struct jwt_builder *builder)
+{
+	struct tc_sha256_state_struct ctx;
+	uint8_t hash[32], sig[64];
+	int res;
+
+	tc_sha256_init(&ctx);
+	tc_sha256_update(&ctx, builder->base, builder->buf - builder->base);
+	tc_sha256_final(hash, &ctx);
+
 	/* Note that tinycrypt only supports P-256. */
-	res = uECC_sign(der_key, hash, sizeof(hash),
+	res = uECC_sign(signer->key, hash, sizeof(hash),
 			sig, &curve_secp256r1);
 	if (res != TC_CRYPTO_SUCCESS) {
 		return -EINVAL;
@@ -300,10 +347,28 @@ int jwt_sign(struct jwt_builder *builder,
 	base64_append_bytes(sig, sizeof(sig), builder);
 	base64_flush(builder);
 
-	return 0;
+	return builder->overflowed ? -ENOMEM : 0;
 }
 #endif
 
+int jwt_sign(struct jwt_builder *builder,
+	     const char *der_key,
+	     size_t der_key_len)
+{
+	struct jwt_signer signer;
+	int res;
+
+	res = jwt_signer_init(&signer, der_key, der_key_len);
+	if (res != 0) {
+		return res;
+	}
+
+	res = jwt_signer_sign(&signer, builder);
+	jwt_signer_free(&signer);
+
+	return res;
+}
+
 int jwt_init_builder(struct jwt_builder *builder,
 		     char *buffer,
 		     size_t buffer_size)
@@ -252,7 +252,14 @@ const struct log_backend_api log_backend_net_api = {
 /* Note that the backend can be activated only after we have networking
  * subsystem ready so we must not start it immediately.
  */
+#ifdef CONFIG_LOG_BACKEND_THREAD
+LOG_BACKEND_THREAD_DEFINE(log_backend_net, log_backend_net_api, true,
+			  CONFIG_LOG_BACKEND_NET_QUEUE_LEN,
+			  CONFIG_LOG_BACKEND_NET_THREAD_STACK_SIZE,
+			  K_LOWEST_APPLICATION_THREAD_PRIO, 0);
+#else
 LOG_BACKEND_DEFINE(log_backend_net, log_backend_net_api, true);
+#endif
 
 const struct log_backend *log_backend_net_get(void)
 {
@@ -8,6 +8,7 @@
 
 #include <logging/log_msg.h>
 #include <logging/log_output.h>
+#include <logging/log_output_dict.h>
 #include <kernel.h>
 
 #ifdef __cplusplus
@@ -36,6 +37,10 @@ log_backend_std_put(const struct log_output *const log_output, uint32_t flags,
 		flags |= LOG_OUTPUT_FLAG_FORMAT_TIMESTAMP;
 	}
 
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_SUPPORT)) {
+		flags |= LOG_OUTPUT_FLAG_FORMAT_DICT;
+	}
+
 	log_output_msg_process(log_output, msg, flags);
 
 	log_msg_put(msg);
@@ -59,6 +64,11 @@ log_backend_std_panic(const struct log_output *const log_output)
 static inline void
 log_backend_std_dropped(const struct log_output *const log_output, uint32_t cnt)
 {
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_SUPPORT)) {
+		log_output_dropped_dict_process(log_output, cnt);
+		return;
+	}
+
 	log_output_dropped_process(log_output, cnt);
 }
 
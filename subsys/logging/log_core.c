@@ -4,7 +4,6 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <logging/log_msg.h>
-#include "log_list.h"
 #include <logging/log.h>
 #include <logging/log_backend.h>
 #include <logging/log_ctrl.h>
@@ -58,7 +57,6 @@ struct k_mem_slab log_strdup_pool;
 static uint8_t __noinit __aligned(sizeof(void *))
 		log_strdup_pool_buf[LOG_STRDUP_POOL_BUFFER_SIZE];
 
-static struct log_list_t list;
 static atomic_t initialized;
 static bool panic_mode;
 static bool backend_attached;
@@ -191,11 +189,7 @@ static inline void msg_finalize(struct log_msg *msg,
 
 	atomic_inc(&buffered_cnt);
 
-	key = irq_lock();
-
-	log_list_add_tail(&list, msg);
-
-	irq_unlock(key);
+	log_msg_commit(msg);
 
 	if (panic_mode) {
 		key = irq_lock();
@@ -316,6 +310,34 @@ void log_hexdump(const char *str, const void *data, uint32_t length,
 	}
 }
 
+#ifdef CONFIG_LOG_PRINTK_PACKAGE
+/* Package a printk message, falling back to formatting it right away
+ * (truncated like an unpackaged message) when the package would be too
+ * large.
+ */
+static int printk_package_from_va(uint8_t *pkg, size_t len,
+				  const char *fmt, va_list ap)
+{
+	va_list aq;
+	int ret;
+
+	va_copy(aq, ap);
+	ret = printk_vpackage(pkg, len, fmt, aq);
+	va_end(aq);
+
+	if (ret < 0) {
+		char str[CONFIG_LOG_PRINTK_MAX_STRING_LENGTH + 1];
+
+		(void)vsnprintk(str, sizeof(str), fmt, ap);
+		ret = printk_package(pkg, len, "%s", str);
+	}
+
+	return ret;
+}
+#else
+#define printk_package_from_va(pkg, len, fmt, ap) (-ENOTSUP)
+#endif /* CONFIG_LOG_PRINTK_PACKAGE */
+
 void log_printk(const char *fmt, va_list ap)
 {
 	if (IS_ENABLED(CONFIG_LOG_PRINTK)) {
@@ -338,12 +360,25 @@ void log_printk(const char *fmt, va_list ap)
 			log_generic(src_level_union.structure, fmt, ap,
 							LOG_STRDUP_SKIP);
 		} else {
+#ifdef CONFIG_LOG_PRINTK_PACKAGE
+			uint8_t str[Z_LOG_PRINTK_PACKAGE_MAX_SIZE];
+#else
 			uint8_t str[CONFIG_LOG_PRINTK_MAX_STRING_LENGTH + 1];
+#endif
 			struct log_msg *msg;
 			int length;
 
-			length = vsnprintk(str, sizeof(str), fmt, ap);
-			length = MIN(length, sizeof(str));
+			if (IS_ENABLED(CONFIG_LOG_PRINTK_PACKAGE)) {
+				length = printk_package_from_va(str,
+								sizeof(str),
+								fmt, ap);
+				if (length < 0) {
+					return;
+				}
+			} else {
+				length = vsnprintk(str, sizeof(str), fmt, ap);
+				length = MIN(length, sizeof(str));
+			}
 
 			msg = log_msg_hexdump_create(NULL, str, length);
 			if (msg == NULL) {
@@ -479,7 +514,6 @@ void log_core_init(void)
 
 	if (!IS_ENABLED(CONFIG_LOG_IMMEDIATE)) {
 		log_msg_pool_init();
-		log_list_init(&list);
 
 		k_mem_slab_init(&log_strdup_pool, log_strdup_pool_buf,
 					sizeof(struct log_strdup_buf),
@@ -511,9 +545,7 @@ void log_core_init(void)
 			uint32_t *filters = log_dynamic_filters_get(i);
 			uint8_t level = log_compiled_level_get(i);
 
-			LOG_FILTER_SLOT_SET(filters,
-					    LOG_FILTER_AGGR_SLOT_IDX,
-					    level);
+			LOG_FILTER_AGGR_SLOT_SET(filters, level);
 		}
 	}
 }
@@ -599,6 +631,7 @@ void z_impl_log_panic(void)
 
 		if (log_backend_is_active(backend)) {
 			log_backend_panic(backend);
+			backend_thread_flush(backend);
 		}
 	}
 
@@ -623,21 +656,121 @@ static bool msg_filter_check(struct log_backend const *backend,
 			     struct log_msg *msg)
 {
 	if (IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING)) {
-		uint32_t backend_level;
-		uint32_t msg_level;
-
-		backend_level = log_filter_get(backend,
-					       log_msg_domain_id_get(msg),
-					       log_msg_source_id_get(msg),
-					       true /*enum RUNTIME, COMPILETIME*/);
-		msg_level = log_msg_level_get(msg);
-
-		return (msg_level <= backend_level);
+		uint32_t *filters =
+			log_dynamic_filters_get(log_msg_source_id_get(msg));
+
+		/* Read the backend slot directly, source ID was validated when
+		 * the message was created.
+		 */
+		return log_msg_level_get(msg) <=
+		       LOG_FILTER_SLOT_GET(filters, log_backend_id_get(backend));
 	} else {
 		return true;
 	}
 }
 
+#ifdef CONFIG_LOG_BACKEND_THREAD
+static void backend_thread_func(void *p1, void *p2, void *p3)
+{
+	struct log_backend const *backend = p1;
+	const struct log_backend_thread *thread = backend->thread;
+	struct log_msg *msg;
+	uint32_t dropped;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		(void)k_msgq_get(thread->queue, &msg, K_FOREVER);
+
+		/* Backends process messages synchronously in panic mode. */
+		if ((thread->pending != NULL) && !panic_mode) {
+			(void)k_sem_take(thread->pending, K_FOREVER);
+		}
+
+		dropped = atomic_set(&backend->cb->dropped, 0);
+		if (dropped) {
+			log_backend_dropped(backend, dropped);
+		}
+
+		log_backend_put(backend, msg);
+		log_msg_put(msg);
+	}
+}
+
+static void backend_thread_start(struct log_backend const *const backend)
+{
+	const struct log_backend_thread *thread = backend->thread;
+
+	if ((thread == NULL) || backend->cb->thread_started) {
+		return;
+	}
+
+	backend->cb->thread_started = true;
+	k_thread_create(thread->thread, thread->stack, thread->stack_size,
+			backend_thread_func, (void *)backend, NULL, NULL,
+			thread->prio, 0, K_NO_WAIT);
+	k_thread_name_set(thread->thread, backend->name);
+}
+
+/* Pass the message to the backend thread, or return false if the backend
+ * has no thread and the message must be passed directly.
+ */
+static bool backend_thread_put(struct log_backend const *const backend,
+			       struct log_msg *msg)
+{
+	if ((backend->thread == NULL) || panic_mode) {
+		return false;
+	}
+
+	log_msg_get(msg);
+	if (k_msgq_put(backend->thread->queue, &msg, K_NO_WAIT) != 0) {
+		log_msg_put(msg);
+		atomic_inc(&backend->cb->dropped);
+	}
+
+	return true;
+}
+
+/* Process messages still queued for the backend, used when entering panic
+ * mode.
+ */
+static void backend_thread_flush(struct log_backend const *const backend)
+{
+	struct log_msg *msg;
+
+	uint32_t dropped;
+
+	if (backend->thread == NULL) {
+		return;
+	}
+
+	dropped = atomic_set(&backend->cb->dropped, 0);
+	if (dropped) {
+		log_backend_dropped(backend, dropped);
+	}
+
+	while (k_msgq_get(backend->thread->queue, &msg, K_NO_WAIT) == 0) {
+		log_backend_put(backend, msg);
+		log_msg_put(msg);
+	}
+}
+#else
+static inline void backend_thread_start(struct log_backend const *const backend)
+{
+}
+
+static inline bool backend_thread_put(struct log_backend const *const backend,
+				      struct log_msg *msg)
+{
+	return false;
+}
+
+static inline void backend_thread_flush(struct log_backend const *const backend)
+{
+}
+#endif /* CONFIG_LOG_BACKEND_THREAD */
+
 static void msg_process(struct log_msg *msg, bool bypass)
 {
 	struct log_backend const *backend;
@@ -652,7 +785,8 @@ static void msg_process(struct log_msg *msg, bool bypass)
 			backend = log_backend_get(i);
 
 			if (log_backend_is_active(backend) &&
-			    msg_filter_check(backend, msg)) {
+			    msg_filter_check(backend, msg) &&
+			    !backend_thread_put(backend, msg)) {
 				log_backend_put(backend, msg);
 			}
 		}
@@ -668,9 +802,18 @@ void dropped_notify(void)
 	for (int i = 0; i < log_backend_count_get(); i++) {
 		struct log_backend const *backend = log_backend_get(i);
 
-		if (log_backend_is_active(backend)) {
-			log_backend_dropped(backend, dropped);
+		if (!log_backend_is_active(backend)) {
+			continue;
+		}
+
+#ifdef CONFIG_LOG_BACKEND_THREAD
+		/* Reported by the backend thread, in order with messages. */
+		if (backend->thread != NULL) {
+			atomic_add(&backend->cb->dropped, dropped);
+			continue;
 		}
+#endif
+		log_backend_dropped(backend, dropped);
 	}
 }
 
@@ -681,10 +824,8 @@ bool z_impl_log_process(bool bypass)
 	if (!backend_attached && !bypass) {
 		return false;
 	}
-	unsigned int key = irq_lock();
 
-	msg = log_list_head_get(&list);
-	irq_unlock(key);
+	msg = log_msg_claim();
 
 	if (msg != NULL) {
 		atomic_dec(&buffered_cnt);
@@ -695,7 +836,7 @@ bool z_impl_log_process(bool bypass)
 		dropped_notify();
 	}
 
-	return (log_list_head_peek(&list) != NULL);
+	return log_msg_pending();
 }
 
 #ifdef CONFIG_USERSPACE
@@ -724,6 +865,12 @@ void log_dropped(void)
 	atomic_inc(&dropped_cnt);
 }
 
+void z_log_dropped_buffered(void)
+{
+	atomic_dec(&buffered_cnt);
+	log_dropped();
+}
+
 uint32_t log_src_cnt_get(uint32_t domain_id)
 {
 	return log_sources_count();
@@ -792,9 +939,7 @@ uint32_t z_impl_log_filter_set(struct log_backend const *const backend,
 			 */
 			new_aggr_filter = max_filter_get(*filters);
 
-			LOG_FILTER_SLOT_SET(filters,
-					    LOG_FILTER_AGGR_SLOT_IDX,
-					    new_aggr_filter);
+			LOG_FILTER_AGGR_SLOT_SET(filters, new_aggr_filter);
 		}
 	}
 
@@ -843,6 +988,7 @@ void log_backend_enable(struct log_backend const *const backend,
 
 	log_backend_id_set(backend, id);
 	backend_filter_set(backend, level);
+	backend_thread_start(backend);
 	log_backend_activate(backend, ctx);
 
 	/* Wakeup logger thread after attaching first backend. It might be
@@ -982,8 +1128,8 @@ void z_vrfy_z_log_string_from_user(uint32_t src_level_val, const char *str)
 
 	if (IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) &&
 	    (level != LOG_LEVEL_INTERNAL_RAW_STRING) &&
-	    (level > LOG_FILTER_SLOT_GET(log_dynamic_filters_get(source_id),
-					LOG_FILTER_AGGR_SLOT_IDX))) {
+	    !LOG_FILTER_AGGR_LEVEL_CHECK(log_dynamic_filters_get(source_id),
+					 level)) {
 		/* Skip filtered out messages. */
 		return;
 	}
@@ -1006,7 +1152,20 @@ void z_vrfy_z_log_string_from_user(uint32_t src_level_val, const char *str)
 		   (level == LOG_LEVEL_INTERNAL_RAW_STRING)) {
 		struct log_msg *msg;
 
+#ifdef CONFIG_LOG_PRINTK_PACKAGE
+		/* Raw strings are always stored as packages in this
+		 * configuration, the string is copied into the package.
+		 */
+		uint8_t pkg[Z_LOG_PRINTK_PACKAGE_MAX_SIZE];
+		int pkg_len = printk_package(pkg, sizeof(pkg), "%s", str);
+
+		if (pkg_len < 0) {
+			return;
+		}
+		msg = log_msg_hexdump_create(NULL, pkg, pkg_len);
+#else
 		msg = log_msg_hexdump_create(NULL, str, len);
+#endif
 		if (msg != NULL) {
 			msg_finalize(msg, src_level_union.structure);
 		}
@@ -1077,9 +1236,9 @@ void z_vrfy_z_log_hexdump_from_user(uint32_t src_level_val, const char *metadata
 		"Invalid log source id"));
 
 	if (IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) &&
-	    (src_level_union.structure.level > LOG_FILTER_SLOT_GET(
+	    !LOG_FILTER_AGGR_LEVEL_CHECK(
 	     log_dynamic_filters_get(src_level_union.structure.source_id),
-	     LOG_FILTER_AGGR_SLOT_IDX))) {
+	     src_level_union.structure.level)) {
 		/* Skip filtered out messages. */
 		return;
 	}
@@ -8,6 +8,7 @@
 #include <logging/log_msg.h>
 #include <logging/log_ctrl.h>
 #include <logging/log_core.h>
+#include <sys/mpsc_pbuf.h>
 #include <string.h>
 #include <assert.h>
 
@@ -38,15 +39,58 @@ BUILD_ASSERT((sizeof(union log_msg_head_data) ==
 #endif
 
 #define MSG_SIZE sizeof(union log_msg_chunk)
-#define NUM_OF_MSGS (CONFIG_LOG_BUFFER_SIZE / MSG_SIZE)
 
-struct k_mem_slab log_msg_pool;
-static uint8_t __noinit __aligned(sizeof(void *))
-		log_msg_pool_buf[CONFIG_LOG_BUFFER_SIZE];
+/* Packets of the buffer are aligned to 32 bits only, on 64 bit targets a
+ * message then starts after one word of padding, which is kept zero.
+ */
+#define MSG_ALIGN_PAD (sizeof(void *) - sizeof(uint32_t))
+
+struct mpsc_pbuf_buffer log_msg_buffer;
+static uint32_t __noinit __aligned(sizeof(void *))
+		log_msg_buffer_data[CONFIG_LOG_BUFFER_SIZE / sizeof(uint32_t)];
+
+static struct log_msg *packet_to_msg(void *packet)
+{
+	return (struct log_msg *)ROUND_UP(packet, sizeof(void *));
+}
+
+static void *msg_to_packet(struct log_msg *msg)
+{
+	uint32_t *word = (uint32_t *)msg;
+
+	/* The header of a packet is never zero */
+	if ((MSG_ALIGN_PAD != 0) && (word[-1] == 0U)) {
+		return &word[-1];
+	}
+
+	return msg;
+}
+
+static void msg_strings_free(struct log_msg *msg);
+
+/* Called for the oldest messages dropped to make room in overflow mode. */
+static void msg_drop(struct mpsc_pbuf_buffer *buffer, void *packet,
+		     size_t len)
+{
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(len);
+
+	msg_strings_free(packet_to_msg(packet));
+	z_log_dropped_buffered();
+}
 
 void log_msg_pool_init(void)
 {
-	k_mem_slab_init(&log_msg_pool, log_msg_pool_buf, MSG_SIZE, NUM_OF_MSGS);
+	uint32_t size = ARRAY_SIZE(log_msg_buffer_data);
+
+	/* Round down to a power of 2 */
+	while ((size & (size - 1)) != 0U) {
+		size &= size - 1;
+	}
+
+	mpsc_pbuf_init(&log_msg_buffer, log_msg_buffer_data, size,
+		       IS_ENABLED(CONFIG_LOG_MODE_OVERFLOW) ?
+		       MPSC_PBUF_MODE_OVERWRITE : 0, msg_drop);
 }
 
 /* Return true if interrupts were unlocked in the context of this call. */
@@ -59,7 +103,7 @@ static bool is_irq_unlocked(void)
 	return ret;
 }
 
-/* Check if context can be blocked and pend on available memory slab. Context
+/* Check if context can be blocked and wait for room in the buffer. Context
  * can be blocked if in a thread and interrupts are not locked.
  */
 static bool block_on_alloc(void)
@@ -71,38 +115,60 @@ static bool block_on_alloc(void)
 	return (!k_is_in_isr() && is_irq_unlocked());
 }
 
-union log_msg_chunk *log_msg_chunk_alloc(void)
+/* The buffer has no wait queue, poll it until messages are processed. */
+static void *alloc_wait(size_t len)
 {
-	union log_msg_chunk *msg = NULL;
-	int err = k_mem_slab_alloc(&log_msg_pool, (void **)&msg,
-		   block_on_alloc()
-		   ? K_MSEC(CONFIG_LOG_BLOCK_IN_THREAD_TIMEOUT_MS)
-		   : K_NO_WAIT);
-
-	if (err != 0) {
-		msg = log_msg_no_space_handle();
-	}
+	int64_t end = k_uptime_get() + CONFIG_LOG_BLOCK_IN_THREAD_TIMEOUT_MS;
+	void *packet;
 
-	return msg;
+	do {
+		k_sleep(K_MSEC(1));
+		packet = mpsc_pbuf_alloc(&log_msg_buffer, len);
+	} while ((packet == NULL) &&
+		 ((CONFIG_LOG_BLOCK_IN_THREAD_TIMEOUT_MS < 0) ||
+		  (k_uptime_get() < end)));
+
+	return packet;
 }
 
-void log_msg_get(struct log_msg *msg)
+union log_msg_chunk *log_msg_chunks_alloc(uint32_t n)
 {
-	atomic_inc(&msg->hdr.ref_cnt);
+	size_t len = n * MSG_SIZE + MSG_ALIGN_PAD;
+	void *packet = mpsc_pbuf_alloc(&log_msg_buffer, len);
+
+	if ((packet == NULL) && block_on_alloc()) {
+		packet = alloc_wait(len);
+	}
+
+	if (packet == NULL) {
+		log_dropped();
+		return NULL;
+	}
+
+	return (union log_msg_chunk *)packet_to_msg(packet);
 }
 
-static void cont_free(struct log_msg_cont *cont)
+/* Link the continuation chunks, which follow the head chunk. */
+static void chunks_link(struct log_msg *msg, uint32_t n)
 {
-	struct log_msg_cont *next;
+	union log_msg_chunk *chunk = (union log_msg_chunk *)msg;
+	struct log_msg_cont **next = &msg->payload.ext.next;
+	uint32_t i;
 
-	while (cont != NULL) {
-		next = cont->next;
-		k_mem_slab_free(&log_msg_pool, (void **)&cont);
-		cont = next;
+	for (i = 1U; i < n; i++) {
+		*next = &chunk[i].cont;
+		next = &chunk[i].cont.next;
 	}
+
+	*next = NULL;
 }
 
-static void msg_free(struct log_msg *msg)
+void log_msg_get(struct log_msg *msg)
+{
+	atomic_inc(&msg->hdr.ref_cnt);
+}
+
+static void msg_strings_free(struct log_msg *msg)
 {
 	uint32_t nargs = log_msg_nargs_get(msg);
 
@@ -150,34 +216,15 @@ static void msg_free(struct log_msg *msg)
 			log_free((void *)(str));
 		}
 	}
-
-	if (msg->hdr.params.generic.ext == 1) {
-		cont_free(msg->payload.ext.next);
-	}
-
-	k_mem_slab_free(&log_msg_pool, (void **)&msg);
 }
 
-union log_msg_chunk *log_msg_no_space_handle(void)
+static void msg_free(struct log_msg *msg)
 {
-	union log_msg_chunk *msg = NULL;
-	bool more;
-	int err;
-
-	if (IS_ENABLED(CONFIG_LOG_MODE_OVERFLOW)) {
-		do {
-			more = log_process(true);
-			log_dropped();
-			err = k_mem_slab_alloc(&log_msg_pool,
-					       (void **)&msg,
-					       K_NO_WAIT);
-		} while ((err != 0) && more);
-	} else {
-		log_dropped();
-	}
-	return msg;
+	msg_strings_free(msg);
 
+	mpsc_pbuf_free(&log_msg_buffer, msg_to_packet(msg));
 }
+
 void log_msg_put(struct log_msg *msg)
 {
 	atomic_dec(&msg->hdr.ref_cnt);
@@ -187,6 +234,26 @@ void log_msg_put(struct log_msg *msg)
 	}
 }
 
+void log_msg_commit(struct log_msg *msg)
+{
+	mpsc_pbuf_commit(&log_msg_buffer, msg_to_packet(msg));
+}
+
+struct log_msg *log_msg_claim(void)
+{
+	void *packet;
+	size_t len;
+
+	packet = mpsc_pbuf_claim(&log_msg_buffer, &len);
+
+	return (packet != NULL) ? packet_to_msg(packet) : NULL;
+}
+
+bool log_msg_pending(void)
+{
+	return mpsc_pbuf_is_pending(&log_msg_buffer);
+}
+
 uint32_t log_msg_nargs_get(struct log_msg *msg)
 {
 	return msg->hdr.params.std.nargs;
@@ -247,34 +314,23 @@ const char *log_msg_str_get(struct log_msg *msg)
  */
 static struct log_msg *msg_alloc(uint32_t nargs)
 {
-	struct log_msg_cont *cont;
-	struct log_msg_cont **next;
-	struct  log_msg *msg = z_log_msg_std_alloc();
-	int n = (int)nargs;
+	struct  log_msg *msg;
+	uint32_t n = 1U;
+
+	if (nargs > LOG_MSG_NARGS_SINGLE_CHUNK) {
+		n += ceiling_fraction(nargs - LOG_MSG_NARGS_HEAD_CHUNK,
+				      ARGS_CONT_MSG);
+	}
+
+	msg = z_log_msg_std_chunks_alloc(n);
 
-	if ((msg == NULL) || nargs <= LOG_MSG_NARGS_SINGLE_CHUNK) {
+	if ((msg == NULL) || (n == 1U)) {
 		return msg;
 	}
 
 	msg->hdr.params.std.nargs = 0U;
 	msg->hdr.params.generic.ext = 1;
-	n -= LOG_MSG_NARGS_HEAD_CHUNK;
-	next = &msg->payload.ext.next;
-	*next = NULL;
-
-	while (n > 0) {
-		cont = (struct log_msg_cont *)log_msg_chunk_alloc();
-
-		if (cont == NULL) {
-			msg_free(msg);
-			return NULL;
-		}
-
-		*next = cont;
-		cont->next = NULL;
-		next = &cont->next;
-		n -= ARGS_CONT_MSG;
-	}
+	chunks_link(msg, n);
 
 	return msg;
 }
@@ -326,16 +382,22 @@ struct log_msg *log_msg_hexdump_create(const char *str,
 				       const uint8_t *data,
 				       uint32_t length)
 {
-	struct log_msg_cont **prev_cont;
-	struct log_msg_cont *cont;
+	struct log_msg_cont *cont = NULL;
 	struct log_msg *msg;
 	uint32_t chunk_length;
+	uint32_t n = 1U;
 
 	/* Saturate length. */
 	length = (length > LOG_MSG_HEXDUMP_MAX_LENGTH) ?
 		 LOG_MSG_HEXDUMP_MAX_LENGTH : length;
 
-	msg = (struct log_msg *)log_msg_chunk_alloc();
+	if (length > LOG_MSG_HEXDUMP_BYTES_SINGLE_CHUNK) {
+		n += ceiling_fraction(length -
+				      LOG_MSG_HEXDUMP_BYTES_HEAD_CHUNK,
+				      HEXDUMP_BYTES_CONT_MSG);
+	}
+
+	msg = (struct log_msg *)log_msg_chunks_alloc(n);
 	if (msg == NULL) {
 		return NULL;
 	}
@@ -351,7 +413,8 @@ struct log_msg *log_msg_hexdump_create(const char *str,
 		(void)memcpy(msg->payload.ext.data.bytes,
 		       data,
 		       LOG_MSG_HEXDUMP_BYTES_HEAD_CHUNK);
-		msg->payload.ext.next = NULL;
+		chunks_link(msg, n);
+		cont = msg->payload.ext.next;
 		msg->hdr.params.generic.ext = 1;
 
 		data += LOG_MSG_HEXDUMP_BYTES_HEAD_CHUNK;
@@ -362,23 +425,12 @@ struct log_msg *log_msg_hexdump_create(const char *str,
 		length = 0U;
 	}
 
-	prev_cont = &msg->payload.ext.next;
-
 	while (length > 0) {
-		cont = (struct log_msg_cont *)log_msg_chunk_alloc();
-		if (cont == NULL) {
-			msg_free(msg);
-			return NULL;
-		}
-
-		*prev_cont = cont;
-		cont->next = NULL;
-		prev_cont = &cont->next;
-
 		chunk_length = (length > HEXDUMP_BYTES_CONT_MSG) ?
 			       HEXDUMP_BYTES_CONT_MSG : length;
 
 		(void)memcpy(cont->payload.bytes, data, chunk_length);
+		cont = cont->next;
 		data += chunk_length;
 		length -= chunk_length;
 	}
@@ -5,6 +5,7 @@
  */
 
 #include <logging/log_output.h>
+#include <logging/log_output_dict.h>
 #include <logging/log_ctrl.h>
 #include <logging/log.h>
 #include <assert.h>
@@ -12,6 +13,7 @@
 #include <time.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <sys/printk.h>
 
 #define LOG_COLOR_CODE_DEFAULT "\x1B[0m"
 #define LOG_COLOR_CODE_RED     "\x1B[1;31m"
@@ -437,6 +439,39 @@ static void hexdump_print(struct log_msg *msg,
 	} while (true);
 }
 
+#ifdef CONFIG_LOG_PRINTK_PACKAGE
+struct package_out_ctx {
+	const struct log_output *log_output;
+	int last;
+};
+
+static int package_out_func(int c, void *ctx)
+{
+	struct package_out_ctx *pkg_ctx = ctx;
+
+	pkg_ctx->last = c;
+
+	return out_func(c, (void *)pkg_ctx->log_output);
+}
+
+static void raw_string_print(struct log_msg *msg,
+			     const struct log_output *log_output)
+{
+	uint8_t pkg[Z_LOG_PRINTK_PACKAGE_MAX_SIZE];
+	struct package_out_ctx ctx = { .log_output = log_output };
+	size_t length = sizeof(pkg);
+
+	/* Raw string is stored as a printk package in a hexdump message. */
+	log_msg_hexdump_data_get(msg, pkg, &length, 0);
+	printk_package_render(package_out_func, &ctx, pkg);
+
+	log_output_flush(log_output);
+
+	if (ctx.last == '\n') {
+		print_formatted(log_output, "\r");
+	}
+}
+#else
 static void raw_string_print(struct log_msg *msg,
 			     const struct log_output *log_output)
 {
@@ -464,6 +499,7 @@ static void raw_string_print(struct log_msg *msg,
 		print_formatted(log_output, "\r");
 	}
 }
+#endif /* CONFIG_LOG_PRINTK_PACKAGE */
 
 static uint32_t prefix_print(const struct log_output *log_output,
 			 uint32_t flags, bool func_on, uint32_t timestamp, uint8_t level,
@@ -538,6 +574,12 @@ void log_output_msg_process(const struct log_output *log_output,
 		return;
 	}
 
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_SUPPORT) &&
+	    flags & LOG_OUTPUT_FLAG_FORMAT_DICT) {
+		log_output_msg_dict_process(log_output, msg, flags);
+		return;
+	}
+
 	prefix_offset = raw_string ?
 			0 : prefix_print(log_output, flags, std_msg, timestamp,
 					 level, domain_id, source_id);
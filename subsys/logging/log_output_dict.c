@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <logging/log.h>
+#include <logging/log_ctrl.h>
+#include <logging/log_output.h>
+#include <logging/log_output_dict.h>
+
+#define HEXDUMP_CHUNK_LEN 32
+
+static void dict_write(const struct log_output *log_output,
+		       const void *data, size_t len)
+{
+	struct log_output_control_block *cb = log_output->control_block;
+	const uint8_t *src = data;
+
+	while (len) {
+		size_t offset = (size_t)atomic_get(&cb->offset);
+		size_t part = MIN(len, log_output->size - offset);
+
+		memcpy(&log_output->buf[offset], src, part);
+		atomic_add(&cb->offset, part);
+		src += part;
+		len -= part;
+
+		if ((size_t)atomic_get(&cb->offset) == log_output->size) {
+			log_output_flush(log_output);
+		}
+	}
+}
+
+/* Get the arguments printed with %s. Like log_count_args(), every
+ * conversion takes one argument.
+ */
+static uint32_t str_args_get(const char *fmt)
+{
+	uint32_t mask = 0U;
+	uint32_t idx = 0U;
+
+	while ((fmt = strchr(fmt, '%')) != NULL) {
+		fmt++;
+
+		if (*fmt == '%') {
+			fmt++;
+			continue;
+		}
+
+		/* Skip flags, field width, precision and length modifiers */
+		while ((*fmt != '\0') && strchr("-+ #0123456789.*hlLjzt", *fmt)) {
+			if (*fmt == '*') {
+				idx++;
+			}
+			fmt++;
+		}
+
+		if (*fmt == '\0') {
+			break;
+		}
+
+		if ((*fmt == 's') && (idx < LOG_MAX_NARGS)) {
+			mask |= BIT(idx);
+		}
+
+		idx++;
+		fmt++;
+	}
+
+	return mask;
+}
+
+static void hdr_fill(struct log_dict_output_normal_msg_hdr *hdr,
+		     struct log_msg *msg, uint8_t type)
+{
+	hdr->type = type;
+	hdr->ids = (uint8_t)(log_msg_level_get(msg) |
+			     (log_msg_domain_id_get(msg) << 3));
+	hdr->source = (uint16_t)log_msg_source_id_get(msg);
+	hdr->timestamp = log_msg_timestamp_get(msg);
+	hdr->fmt = (uintptr_t)log_msg_str_get(msg);
+	hdr->nstr = 0U;
+}
+
+static void std_msg_process(const struct log_output *log_output,
+			    struct log_msg *msg)
+{
+	struct log_dict_output_normal_msg_hdr hdr;
+	uint32_t nargs = log_msg_nargs_get(msg);
+	uint32_t str_args = 0U;
+	uint32_t i;
+
+	hdr_fill(&hdr, msg, LOG_DICT_OUTPUT_MSG_STD);
+	hdr.len = (uint16_t)nargs;
+
+	/* Strings duplicated with log_strdup() do not exist in the ELF file
+	 * and are copied, other strings are referred to by their address.
+	 */
+	if (nargs) {
+		uint32_t mask = str_args_get(log_msg_str_get(msg));
+
+		for (i = 0; i < nargs; i++) {
+			if ((mask & BIT(i)) &&
+			    log_is_strdup((void *)log_msg_arg_get(msg, i))) {
+				str_args |= BIT(i);
+				hdr.nstr++;
+			}
+		}
+	}
+
+	dict_write(log_output, &hdr, sizeof(hdr));
+
+	for (i = 0; i < nargs; i++) {
+		log_arg_t arg = log_msg_arg_get(msg, i);
+
+		dict_write(log_output, &arg, sizeof(arg));
+	}
+
+	for (i = 0; str_args; i++) {
+		if (str_args & BIT(i)) {
+			const char *str = (const char *)log_msg_arg_get(msg, i);
+			uint8_t idx = (uint8_t)i;
+
+			dict_write(log_output, &idx, sizeof(idx));
+			dict_write(log_output, str, strlen(str) + 1);
+			str_args &= ~BIT(i);
+		}
+	}
+}
+
+static void hexdump_msg_process(const struct log_output *log_output,
+				struct log_msg *msg)
+{
+	struct log_dict_output_normal_msg_hdr hdr;
+	uint8_t data[HEXDUMP_CHUNK_LEN];
+	size_t offset = 0;
+	size_t length;
+
+	hdr_fill(&hdr, msg, LOG_DICT_OUTPUT_MSG_HEXDUMP);
+	hdr.len = msg->hdr.params.hexdump.length;
+
+	dict_write(log_output, &hdr, sizeof(hdr));
+
+	do {
+		length = sizeof(data);
+		log_msg_hexdump_data_get(msg, data, &length, offset);
+		dict_write(log_output, data, length);
+		offset += length;
+	} while (length);
+}
+
+void log_output_msg_dict_process(const struct log_output *log_output,
+				 struct log_msg *msg, uint32_t flags)
+{
+	ARG_UNUSED(flags);
+
+	if (log_msg_is_std(msg)) {
+		std_msg_process(log_output, msg);
+	} else {
+		hexdump_msg_process(log_output, msg);
+	}
+
+	log_output_flush(log_output);
+}
+
+void log_output_dropped_dict_process(const struct log_output *log_output,
+				     uint32_t cnt)
+{
+	struct log_dict_output_dropped_msg msg = {
+		.type = LOG_DICT_OUTPUT_MSG_DROPPED,
+		.count = cnt,
+	};
+
+	dict_write(log_output, &msg, sizeof(msg));
+	log_output_flush(log_output);
+}
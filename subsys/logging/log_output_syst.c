@@ -307,9 +307,17 @@ static void raw_string_print(struct log_msg *msg,
 	size_t length = CONFIG_LOG_STRDUP_MAX_STRING;
 	uint32_t severity = level_to_syst_severity(log_msg_level_get(msg));
 
+#ifdef CONFIG_LOG_PRINTK_PACKAGE
+	uint8_t pkg[Z_LOG_PRINTK_PACKAGE_MAX_SIZE];
+
+	length = sizeof(pkg);
+	log_msg_hexdump_data_get(msg, pkg, &length, 0);
+	(void)snprintk_package(buf, sizeof(buf), pkg);
+#else
 	log_msg_hexdump_data_get(msg, buf, &length, 0);
 
 	buf[length] = '\0';
+#endif
 
 	MIPI_SYST_PRINTF(&log_syst_handle, severity, buf);
 }
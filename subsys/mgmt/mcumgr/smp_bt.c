@@ -54,7 +54,13 @@ static ssize_t smp_bt_chr_write(struct bt_conn *conn,
 	struct smp_bt_user_data *ud;
 	struct net_buf *nb;
 
+	/* Requests that arrive while all buffers are queued are dropped,
+	 * the client retransmits them.
+	 */
 	nb = mcumgr_buf_alloc();
+	if (nb == NULL) {
+		return BT_GATT_ERR(BT_ATT_ERR_INSUFFICIENT_RESOURCES);
+	}
 	net_buf_add_mem(nb, buf, len);
 
 	ud = net_buf_user_data(nb);
@@ -20,13 +20,25 @@
 
 struct device;
 
+static struct zephyr_smp_transport smp_uart_transport;
+
+#ifdef CONFIG_UART_MCUMGR_BINARY
+/**
+ * Passes a packet received by the mcumgr UART driver to SMP.  The driver
+ * receives it straight into the net_buf.  This function executes in the
+ * interrupt context.
+ */
+static void smp_uart_rx_pkt(struct net_buf *nb)
+{
+	zephyr_smp_rx_req(&smp_uart_transport, nb);
+}
+#else
 static void smp_uart_process_rx_queue(struct k_work *work);
 
 K_FIFO_DEFINE(smp_uart_rx_fifo);
 K_WORK_DEFINE(smp_uart_work, smp_uart_process_rx_queue);
 
 static struct mcumgr_serial_rx_ctxt smp_uart_rx_ctxt;
-static struct zephyr_smp_transport smp_uart_transport;
 
 /**
  * Processes a single line (fragment) coming from the mcumgr UART driver.
@@ -70,6 +82,7 @@ static void smp_uart_rx_frag(struct uart_mcumgr_rx_buf *rx_buf)
 	k_fifo_put(&smp_uart_rx_fifo, rx_buf);
 	k_work_submit(&smp_uart_work);
 }
+#endif /* CONFIG_UART_MCUMGR_BINARY */
 
 static uint16_t smp_uart_get_mtu(const struct net_buf *nb)
 {
@@ -93,7 +106,11 @@ static int smp_uart_init(struct device *dev)
 
 	zephyr_smp_transport_init(&smp_uart_transport, smp_uart_tx_pkt,
 				  smp_uart_get_mtu, NULL, NULL);
+#ifdef CONFIG_UART_MCUMGR_BINARY
+	uart_mcumgr_register_pkt(smp_uart_rx_pkt);
+#else
 	uart_mcumgr_register(smp_uart_rx_frag);
+#endif
 
 	return 0;
 }
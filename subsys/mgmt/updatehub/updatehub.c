@@ -28,6 +28,10 @@ LOG_MODULE_REGISTER(updatehub, CONFIG_UPDATEHUB_LOG_LEVEL);
 #include "updatehub_device.h"
 #include "updatehub_timer.h"
 
+#if defined(CONFIG_UPDATEHUB_DOWNLOAD_RESUME)
+#include <settings/settings.h>
+#endif
+
 #if defined(CONFIG_UPDATEHUB_DTLS)
 #define CA_CERTIFICATE_TAG 1
 #include <net/tls_credentials.h>
@@ -75,6 +79,20 @@ static struct update_info {
 
 static struct k_delayed_work updatehub_work_handle;
 
+#if defined(CONFIG_UPDATEHUB_DOWNLOAD_RESUME)
+#define DOWNLOAD_STATE_KEY "updatehub/dl/state"
+#define DOWNLOAD_FLASH_KEY "updatehub/dl/flash"
+
+/* Saved after the flash progress, the download only resumes when both
+ * agree on the size.
+ */
+struct download_state {
+	char sha256sum_image[SHA256_HEX_DIGEST_SIZE];
+	struct tc_sha256_state_struct sha256sum;
+	int downloaded_size;
+};
+#endif
+
 static int bin2hex_str(uint8_t *bin, size_t bin_len, char *str, size_t str_buf_len)
 {
 	if (bin == NULL || str == NULL) {
@@ -381,6 +399,113 @@ static bool install_update_cb_sha256(void)
 	return true;
 }
 
+#if defined(CONFIG_UPDATEHUB_DOWNLOAD_RESUME)
+static int download_state_loader(const char *key, size_t len,
+				 settings_read_cb read_cb, void *cb_arg,
+				 void *param)
+{
+	struct download_state *state = param;
+
+	if (settings_name_next(key, NULL) != 0 || len != sizeof(*state)) {
+		return 0;
+	}
+
+	if (read_cb(cb_arg, state, sizeof(*state)) != sizeof(*state)) {
+		memset(state, 0, sizeof(*state));
+	}
+
+	return 0;
+}
+
+static void download_state_save(void)
+{
+	struct download_state state;
+	int interval = coap_block_size_to_bytes(ctx.block.block_size) *
+		       CONFIG_UPDATEHUB_DOWNLOAD_SAVE_INTERVAL;
+
+	/* Only at block boundaries with all the data on flash */
+	if ((ctx.downloaded_size % interval) != 0 ||
+	    flash_img_bytes_written(&ctx.flash_ctx) != ctx.downloaded_size) {
+		return;
+	}
+
+	if (stream_flash_progress_save(&ctx.flash_ctx.stream,
+				       DOWNLOAD_FLASH_KEY) < 0) {
+		LOG_WRN("Could not save download progress");
+		return;
+	}
+
+	memcpy(state.sha256sum_image, update_info.sha256sum_image,
+	       SHA256_HEX_DIGEST_SIZE);
+	state.sha256sum = ctx.sha256sum;
+	state.downloaded_size = ctx.downloaded_size;
+
+	if (settings_save_one(DOWNLOAD_STATE_KEY, &state, sizeof(state)) < 0) {
+		LOG_WRN("Could not save download state");
+	}
+}
+
+static void download_state_clear(void)
+{
+	stream_flash_progress_clear(&ctx.flash_ctx.stream, DOWNLOAD_FLASH_KEY);
+	settings_delete(DOWNLOAD_STATE_KEY);
+}
+
+/* Continue the download of the same image from the last saved block. */
+static bool download_resume(void)
+{
+	struct download_state state;
+	int block_size = coap_block_size_to_bytes(ctx.block.block_size);
+
+	memset(&state, 0, sizeof(state));
+
+	if (settings_subsys_init() < 0 ||
+	    settings_load_subtree_direct(DOWNLOAD_STATE_KEY,
+					 download_state_loader, &state) < 0) {
+		return false;
+	}
+
+	if (strncmp(state.sha256sum_image, update_info.sha256sum_image,
+		    SHA256_HEX_DIGEST_SIZE) != 0 ||
+	    state.downloaded_size <= 0 ||
+	    state.downloaded_size >= ctx.block.total_size ||
+	    (state.downloaded_size % block_size) != 0) {
+		return false;
+	}
+
+	if (stream_flash_progress_load(&ctx.flash_ctx.stream,
+				       DOWNLOAD_FLASH_KEY) < 0 ||
+	    flash_img_bytes_written(&ctx.flash_ctx) != state.downloaded_size) {
+		/* Start over with a fresh stream */
+		(void)flash_img_init(&ctx.flash_ctx);
+		return false;
+	}
+
+	ctx.sha256sum = state.sha256sum;
+	ctx.downloaded_size = state.downloaded_size;
+	ctx.block.current = state.downloaded_size;
+	updatehub_blk_set(UPDATEHUB_BLK_INDEX,
+			  state.downloaded_size / block_size);
+
+	LOG_INF("Resuming download at %d bytes", ctx.downloaded_size);
+
+	return true;
+}
+#else
+static inline void download_state_save(void)
+{
+}
+
+static inline void download_state_clear(void)
+{
+}
+
+static inline bool download_resume(void)
+{
+	return false;
+}
+#endif /* CONFIG_UPDATEHUB_DOWNLOAD_RESUME */
+
 static int install_update_cb_check_blk_num(struct coap_packet *resp)
 {
 	int blk_num;
@@ -473,11 +598,14 @@ static void install_update_cb(void)
 		}
 
 		LOG_INF("Firmware downloaded successfully");
+		download_state_clear();
 		if (!install_update_cb_sha256()) {
 			LOG_ERR("Firmware validation has failed");
 			ctx.code_status = UPDATEHUB_DOWNLOAD_ERROR;
 			goto cleanup;
 		}
+	} else {
+		download_state_save();
 	}
 
 	ctx.code_status = UPDATEHUB_OK;
@@ -488,18 +616,6 @@ cleanup:
 
 static enum updatehub_response install_update(void)
 {
-	if (boot_erase_img_bank(FLASH_AREA_ID(image_1)) != 0) {
-		LOG_ERR("Failed to init flash and erase second slot");
-		ctx.code_status = UPDATEHUB_FLASH_INIT_ERROR;
-		goto error;
-	}
-
-	if (tc_sha256_init(&ctx.sha256sum) < 1) {
-		LOG_ERR("Could not start sha256sum");
-		ctx.code_status = UPDATEHUB_DOWNLOAD_ERROR;
-		goto error;
-	}
-
 	if (!start_coap_client()) {
 		ctx.code_status = UPDATEHUB_NETWORKING_ERROR;
 		goto error;
@@ -524,6 +640,20 @@ static enum updatehub_response install_update(void)
 	updatehub_blk_set(UPDATEHUB_BLK_INDEX, 0);
 	updatehub_blk_set(UPDATEHUB_BLK_TX_AVAILABLE, 1);
 
+	if (!download_resume()) {
+		if (boot_erase_img_bank(FLASH_AREA_ID(image_1)) != 0) {
+			LOG_ERR("Failed to init flash and erase second slot");
+			ctx.code_status = UPDATEHUB_FLASH_INIT_ERROR;
+			goto cleanup;
+		}
+
+		if (tc_sha256_init(&ctx.sha256sum) < 1) {
+			LOG_ERR("Could not start sha256sum");
+			ctx.code_status = UPDATEHUB_DOWNLOAD_ERROR;
+			goto cleanup;
+		}
+	}
+
 	while (ctx.downloaded_size != ctx.block.total_size) {
 		if (updatehub_blk_get(UPDATEHUB_BLK_TX_AVAILABLE)) {
 			if (send_request(COAP_TYPE_CON, COAP_METHOD_GET,
@@ -149,13 +149,46 @@ static uint8_t *fixed_data_alloc(struct net_buf *buf, size_t *size,
 	return fixed->data_pool + fixed->data_size * net_buf_id(buf);
 }
 
+/* Fixed-size data has no reference count of its own: the data area of
+ * buffer N of the pool lives as long as buffer N itself, so referencing the
+ * data means referencing the buffer owning it.
+ */
+static struct net_buf *fixed_data_owner(struct net_buf *buf, uint8_t *data)
+{
+	struct net_buf_pool *pool = net_buf_pool_get(buf->pool_id);
+	const struct net_buf_pool_fixed *fixed = pool->alloc->alloc_data;
+
+	if (!fixed->data_size) {
+		return NULL;
+	}
+
+	return &pool->__bufs[(data - fixed->data_pool) / fixed->data_size];
+}
+
+static uint8_t *fixed_data_ref(struct net_buf *buf, uint8_t *data)
+{
+	struct net_buf *owner = fixed_data_owner(buf, data);
+
+	if (owner) {
+		net_buf_ref(owner);
+	}
+
+	return data;
+}
+
 static void fixed_data_unref(struct net_buf *buf, uint8_t *data)
 {
-	/* Nothing needed for fixed-size data pools */
+	struct net_buf *owner = fixed_data_owner(buf, data);
+
+	/* Nothing needed when the buffer releases its own data */
+	if (owner && owner != buf) {
+		net_buf_unref(owner);
+	}
 }
 
 const struct net_buf_data_cb net_buf_fixed_cb = {
 	.alloc = fixed_data_alloc,
+	.ref   = fixed_data_ref,
 	.unref = fixed_data_unref,
 };
 
@@ -230,8 +263,8 @@ struct net_buf *net_buf_alloc_len_debug(struct net_buf_pool *pool, size_t size,
 					k_timeout_t timeout, const char *func,
 					int line)
 #else
-struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
-				  k_timeout_t timeout)
+__hot_text struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool,
+					     size_t size, k_timeout_t timeout)
 #endif
 {
 	uint64_t end = z_timeout_end_calc(timeout);
@@ -518,7 +551,7 @@ void net_buf_put(struct k_fifo *fifo, struct net_buf *buf)
 #if defined(CONFIG_NET_BUF_LOG)
 void net_buf_unref_debug(struct net_buf *buf, const char *func, int line)
 #else
-void net_buf_unref(struct net_buf *buf)
+__hot_text void net_buf_unref(struct net_buf *buf)
 #endif
 {
 	__ASSERT_NO_MSG(buf);
@@ -627,6 +660,46 @@ struct net_buf *net_buf_clone(struct net_buf *buf, k_timeout_t timeout)
 	return clone;
 }
 
+struct net_buf *net_buf_slice(struct net_buf *buf, size_t offset, size_t len,
+			      k_timeout_t timeout)
+{
+	struct net_buf_pool *pool;
+	struct net_buf *slice;
+
+	__ASSERT_NO_MSG(buf);
+	__ASSERT_NO_MSG(offset + len <= buf->len);
+
+	pool = net_buf_pool_get(buf->pool_id);
+
+	/* Only pools able to reference data can host slices, externally
+	 * allocated data stays owned by whoever provided it.
+	 */
+	if (!pool->alloc->cb->ref && !(buf->flags & NET_BUF_EXTERNAL_DATA)) {
+		return NULL;
+	}
+
+	slice = net_buf_alloc_len(pool, 0, timeout);
+	if (!slice) {
+		return NULL;
+	}
+
+	if (buf->flags & NET_BUF_EXTERNAL_DATA) {
+		slice->__buf = buf->__buf;
+		slice->flags = NET_BUF_EXTERNAL_DATA;
+	} else {
+		slice->__buf = data_ref(buf, buf->__buf);
+	}
+
+	/* Leave no tailroom so that the slice cannot grow over the data
+	 * following the referenced range.
+	 */
+	slice->data = buf->data + offset;
+	slice->len = len;
+	slice->size = slice->data + len - slice->__buf;
+
+	return slice;
+}
+
 struct net_buf *net_buf_frag_last(struct net_buf *buf)
 {
 	__ASSERT_NO_MSG(buf);
@@ -155,6 +155,131 @@ static inline bool net_6lo_maddr_48_bit_compressible(struct in6_addr *addr)
 		 (addr->s6_addr[10] == 0x00));
 }
 
+/* Compressed headers of recent flows. The compression of a header only
+ * depends on the fields of the IPv6 header but the payload length, on the
+ * UDP ports and on the link layer addresses, so packets of a flow get the
+ * same compressed header, but for the UDP checksum which is always
+ * carried inline, as the last bytes of it.
+ */
+struct compress_cache_entry {
+	struct net_if *iface;
+	struct net_ipv6_hdr ipv6;
+	uint16_t src_port;
+	uint16_t dst_port;
+	uint8_t ll_src[NET_LINK_ADDR_MAX_LENGTH];
+	uint8_t ll_dst[NET_LINK_ADDR_MAX_LENGTH];
+	uint8_t ll_src_len;
+	uint8_t ll_dst_len;
+	uint8_t hdr_len;	/* Length of hdr, 0 if the entry is unused */
+	uint8_t hdr[NET_IPV6UDPH_LEN];
+};
+
+#if CONFIG_NET_6LO_COMPRESS_CACHE_SIZE > 0
+static struct compress_cache_entry
+compress_cache[CONFIG_NET_6LO_COMPRESS_CACHE_SIZE];
+static uint8_t compress_cache_next;
+static struct k_spinlock compress_cache_lock;
+
+static void compress_cache_key(struct compress_cache_entry *key,
+			       struct net_pkt *pkt,
+			       struct net_ipv6_hdr *ipv6,
+			       struct net_udp_hdr *udp)
+{
+	struct net_linkaddr *ll_src = net_pkt_lladdr_src(pkt);
+	struct net_linkaddr *ll_dst = net_pkt_lladdr_dst(pkt);
+
+	(void)memset(key, 0, offsetof(struct compress_cache_entry, hdr));
+
+	key->iface = net_pkt_iface(pkt);
+	memcpy(&key->ipv6, ipv6, sizeof(key->ipv6));
+	key->ipv6.len = 0U;
+
+	if (udp) {
+		key->src_port = udp->src_port;
+		key->dst_port = udp->dst_port;
+	}
+
+	key->ll_src_len = MIN(ll_src->len, sizeof(key->ll_src));
+	if (ll_src->addr) {
+		memcpy(key->ll_src, ll_src->addr, key->ll_src_len);
+	}
+
+	key->ll_dst_len = MIN(ll_dst->len, sizeof(key->ll_dst));
+	if (ll_dst->addr) {
+		memcpy(key->ll_dst, ll_dst->addr, key->ll_dst_len);
+	}
+}
+
+/* On a hit, write the cached compressed header in front of the payload
+ * and return the number of bytes it saved, return 0 otherwise.
+ */
+static int compress_cache_get(struct net_pkt *pkt,
+			      struct compress_cache_entry *key,
+			      uint8_t hdr_len, bool udp)
+{
+	k_spinlock_key_t lock = k_spin_lock(&compress_cache_lock);
+	uint8_t *end = pkt->buffer->data + hdr_len;
+	int compressed = 0;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(compress_cache); i++) {
+		struct compress_cache_entry *entry = &compress_cache[i];
+		uint8_t len = entry->hdr_len;
+
+		if (!len ||
+		    memcmp(entry, key, offsetof(struct compress_cache_entry,
+						hdr_len))) {
+			continue;
+		}
+
+		/* The UDP checksum is already where it belongs */
+		if (udp) {
+			len -= sizeof(uint16_t);
+			end -= sizeof(uint16_t);
+		}
+
+		memcpy(end - len, entry->hdr, len);
+		compressed = hdr_len - entry->hdr_len;
+		break;
+	}
+
+	k_spin_unlock(&compress_cache_lock, lock);
+
+	return compressed;
+}
+
+static void compress_cache_put(struct compress_cache_entry *key,
+			       uint8_t *hdr, uint8_t hdr_len)
+{
+	k_spinlock_key_t lock = k_spin_lock(&compress_cache_lock);
+	struct compress_cache_entry *entry =
+		&compress_cache[compress_cache_next];
+
+	memcpy(entry, key, offsetof(struct compress_cache_entry, hdr_len));
+	memcpy(entry->hdr, hdr, hdr_len);
+	entry->hdr_len = hdr_len;
+
+	compress_cache_next = (compress_cache_next + 1) %
+			      ARRAY_SIZE(compress_cache);
+
+	k_spin_unlock(&compress_cache_lock, lock);
+}
+
+static inline void compress_cache_flush(void)
+{
+	k_spinlock_key_t lock = k_spin_lock(&compress_cache_lock);
+
+	(void)memset(compress_cache, 0, sizeof(compress_cache));
+
+	k_spin_unlock(&compress_cache_lock, lock);
+}
+#else
+#define compress_cache_key(key, pkt, ipv6, udp)
+#define compress_cache_get(pkt, key, hdr_len, udp) 0
+#define compress_cache_put(key, hdr, hdr_len)
+#define compress_cache_flush()
+#endif /* CONFIG_NET_6LO_COMPRESS_CACHE_SIZE > 0 */
+
 #if defined(CONFIG_NET_6LO_CONTEXT)
 /* RFC 6775, 4.2, 5.4.2, 5.4.3 and 7.2*/
 static inline void set_6lo_context(struct net_if *iface, uint8_t index,
@@ -189,6 +314,9 @@ void net_6lo_set_context(struct net_if *iface,
 
 		if (ctx_6co[i].iface == iface &&
 		    ctx_6co[i].cid == get_6co_cid(context)) {
+			/* Compressed headers might refer to the context */
+			compress_cache_flush();
+
 			/* Remove if lifetime is zero */
 			if (!context->lifetime) {
 				ctx_6co[i].is_used = false;
@@ -203,6 +331,7 @@ void net_6lo_set_context(struct net_if *iface,
 
 	/* Cache the context information. */
 	if (unused != -1) {
+		compress_cache_flush();
 		set_6lo_context(iface, unused, context);
 		return;
 	}
@@ -727,8 +856,11 @@ static inline int compress_IPHC_header(struct net_pkt *pkt)
 	uint8_t compressed = 0;
 	uint16_t iphc = (NET_6LO_DISPATCH_IPHC << 8);
 	struct net_ipv6_hdr *ipv6 = NET_IPV6_HDR(pkt);
-	struct net_udp_hdr *udp;
+	struct compress_cache_entry key __unused;
+	struct net_udp_hdr *udp = NULL;
 	uint8_t *inline_pos;
+	uint8_t hdr_len;
+	int ret;
 
 	if (pkt->frags->len < NET_IPV6H_LEN) {
 		NET_ERR("Invalid length %d, min %d",
@@ -744,9 +876,25 @@ static inline int compress_IPHC_header(struct net_pkt *pkt)
 	}
 
 	inline_pos = pkt->buffer->data + NET_IPV6H_LEN;
+	hdr_len = NET_IPV6H_LEN;
 
 	if (ipv6->nexthdr == IPPROTO_UDP) {
 		udp = (struct net_udp_hdr *)inline_pos;
+		hdr_len += NET_UDPH_LEN;
+	}
+
+	/* The header gets compressed in place, so the cache key has to be
+	 * taken first.
+	 */
+	compress_cache_key(&key, pkt, ipv6, udp);
+
+	ret = compress_cache_get(pkt, &key, hdr_len, udp != NULL);
+	if (ret) {
+		net_buf_pull(pkt->buffer, ret);
+		return ret;
+	}
+
+	if (udp) {
 		inline_pos += NET_UDPH_LEN;
 
 		inline_pos = compress_nh_udp(udp, inline_pos, false);
@@ -827,6 +975,8 @@ sa_end:
 
 	net_buf_pull(pkt->buffer, compressed);
 
+	compress_cache_put(&key, pkt->buffer->data, hdr_len - compressed);
+
 	return compressed;
 }
 
@@ -1348,7 +1498,15 @@ static bool uncompress_IPHC_header(struct net_pkt *pkt)
 			nhc_inline_size;
 	}
 
-	if (net_buf_tailroom(pkt->buffer) >= diff) {
+	if (net_buf_headroom(pkt->buffer) >= diff) {
+		/* The compressed header ends where the uncompressed one
+		 * would, so the payload does not have to move.
+		 */
+		NET_DBG("Enough headroom. Uncompress inplace");
+		frag = pkt->buffer;
+		cursor = frag->data;
+		net_buf_push(frag, diff);
+	} else if (net_buf_tailroom(pkt->buffer) >= diff) {
 		NET_DBG("Enough tailroom. Uncompress inplace");
 		frag = pkt->buffer;
 		net_buf_add(frag, diff);
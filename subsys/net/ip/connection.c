@@ -54,11 +54,32 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 
 #define NET_CONN_RANK(_flags)		(_flags & 0x78)
 
+/** End points shared with other reuseport connections */
+#define NET_CONN_REUSEPORT		BIT(7)
+
 static struct net_conn conns[CONFIG_NET_MAX_CONN];
 
 static sys_slist_t conn_unused;
 static sys_slist_t conn_used;
 
+/* Connections are also indexed by protocol and ports so that incoming
+ * packets only need to be matched against the few that can accept them.
+ * Connections with a local port are hashed on it, and on the remote port
+ * when one is specified. The others are kept in the wildcard list that is
+ * searched for every packet.
+ */
+static sys_slist_t conn_hash[CONFIG_NET_CONN_HASH_BUCKETS];
+static sys_slist_t conn_wildcard;
+
+/* Registration order, newest first, is what decides between connections
+ * of equal rank. It is kept across the lookup lists with a sequence number.
+ */
+static uint32_t conn_seq;
+
+struct conn_lookup {
+	sys_snode_t *next[3];
+};
+
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
 void conn_register_debug(struct net_conn *conn,
@@ -127,11 +148,78 @@ static struct net_conn *conn_get_unused(void)
 	return CONTAINER_OF(node, struct net_conn, node);
 }
 
+static sys_slist_t *conn_hash_bucket(uint16_t proto, uint16_t local_port,
+				     uint16_t remote_port)
+{
+	uint32_t hash = (((uint32_t)local_port << 16) | remote_port) ^ proto;
+
+	/* Fibonacci hashing, the upper bits are the best mixed ones */
+	hash *= 0x9e3779b1U;
+
+	return &conn_hash[(hash >> 16) % CONFIG_NET_CONN_HASH_BUCKETS];
+}
+
+static sys_slist_t *conn_lookup_list(struct net_conn *conn)
+{
+	if (!(conn->flags & NET_CONN_LOCAL_PORT_SPEC)) {
+		return &conn_wildcard;
+	}
+
+	return conn_hash_bucket(conn->proto,
+				net_sin(&conn->local_addr)->sin_port,
+				conn->flags & NET_CONN_REMOTE_PORT_SPEC ?
+				net_sin(&conn->remote_addr)->sin_port : 0);
+}
+
+/* Ports are in network byte order */
+static void conn_lookup_init(struct conn_lookup *lookup, uint16_t proto,
+			     uint16_t src_port, uint16_t dst_port)
+{
+	sys_slist_t *exact = conn_hash_bucket(proto, dst_port, src_port);
+	sys_slist_t *local = conn_hash_bucket(proto, dst_port, 0);
+
+	lookup->next[0] = sys_slist_peek_head(exact);
+	lookup->next[1] = local != exact ? sys_slist_peek_head(local) : NULL;
+	lookup->next[2] = sys_slist_peek_head(&conn_wildcard);
+}
+
+/* Return the candidates in the order they were registered, newest first,
+ * by merging the lookup lists which are each kept in that order.
+ */
+static struct net_conn *conn_lookup_next(struct conn_lookup *lookup)
+{
+	struct net_conn *newest = NULL;
+	int i, pick = 0;
+
+	for (i = 0; i < ARRAY_SIZE(lookup->next); i++) {
+		struct net_conn *conn;
+
+		if (!lookup->next[i]) {
+			continue;
+		}
+
+		conn = CONTAINER_OF(lookup->next[i], struct net_conn,
+				    hash_node);
+		if (!newest || (int32_t)(conn->seq - newest->seq) > 0) {
+			newest = conn;
+			pick = i;
+		}
+	}
+
+	if (newest) {
+		lookup->next[pick] = sys_slist_peek_next(lookup->next[pick]);
+	}
+
+	return newest;
+}
+
 static void conn_set_used(struct net_conn *conn)
 {
 	conn->flags |= NET_CONN_IN_USE;
+	conn->seq = conn_seq++;
 
 	sys_slist_prepend(&conn_used, &conn->node);
+	sys_slist_prepend(conn_lookup_list(conn), &conn->hash_node);
 }
 
 static void conn_set_unused(struct net_conn *conn)
@@ -239,21 +327,25 @@ static struct net_conn *conn_find_handler(uint16_t proto, uint8_t family,
 	return NULL;
 }
 
-int net_conn_register(uint16_t proto, uint8_t family,
-		      const struct sockaddr *remote_addr,
-		      const struct sockaddr *local_addr,
-		      uint16_t remote_port,
-		      uint16_t local_port,
-		      net_conn_cb_t cb,
-		      void *user_data,
-		      struct net_conn_handle **handle)
+static int conn_register(uint16_t proto, uint8_t family,
+			 const struct sockaddr *remote_addr,
+			 const struct sockaddr *local_addr,
+			 uint16_t remote_port,
+			 uint16_t local_port,
+			 net_conn_cb_t cb,
+			 void *user_data,
+			 struct net_conn_handle **handle,
+			 bool reuseport)
 {
 	struct net_conn *conn;
 	uint8_t flags = 0U;
 
+	/* Identical reuseport handlers are either all reuseport or this one
+	 * would have been refused, checking the first one found is enough.
+	 */
 	conn = conn_find_handler(proto, family, remote_addr, local_addr,
 				 remote_port, local_port);
-	if (conn) {
+	if (conn && !(reuseport && (conn->flags & NET_CONN_REUSEPORT))) {
 		NET_ERR("Identical connection handler %p already found.", conn);
 		return -EALREADY;
 	}
@@ -342,6 +434,10 @@ int net_conn_register(uint16_t proto, uint8_t family,
 		net_sin(&conn->local_addr)->sin_port = htons(local_port);
 	}
 
+	if (reuseport) {
+		flags |= NET_CONN_REUSEPORT;
+	}
+
 	conn->cb = cb;
 	conn->user_data = user_data;
 	conn->flags = flags;
@@ -362,6 +458,109 @@ error:
 	return -EINVAL;
 }
 
+int net_conn_register(uint16_t proto, uint8_t family,
+		      const struct sockaddr *remote_addr,
+		      const struct sockaddr *local_addr,
+		      uint16_t remote_port,
+		      uint16_t local_port,
+		      net_conn_cb_t cb,
+		      void *user_data,
+		      struct net_conn_handle **handle)
+{
+	return conn_register(proto, family, remote_addr, local_addr,
+			     remote_port, local_port, cb, user_data, handle,
+			     false);
+}
+
+#if defined(CONFIG_NET_CONTEXT_REUSEPORT)
+int net_conn_register_reuseport(uint16_t proto, uint8_t family,
+				const struct sockaddr *remote_addr,
+				const struct sockaddr *local_addr,
+				uint16_t remote_port,
+				uint16_t local_port,
+				net_conn_cb_t cb,
+				void *user_data,
+				struct net_conn_handle **handle,
+				bool reuseport)
+{
+	return conn_register(proto, family, remote_addr, local_addr,
+			     remote_port, local_port, cb, user_data, handle,
+			     reuseport);
+}
+
+/* Hash of the source address and port of the packet, in network order */
+static uint32_t conn_flow_hash(struct net_pkt *pkt,
+			       union net_ip_header *ip_hdr,
+			       uint16_t src_port)
+{
+	const uint8_t *addr = NULL;
+	uint32_t hash = src_port;
+	size_t len = 0;
+	size_t i;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
+		addr = ip_hdr->ipv6->src.s6_addr;
+		len = sizeof(struct in6_addr);
+	} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
+		   net_pkt_family(pkt) == AF_INET) {
+		addr = ip_hdr->ipv4->src.s4_addr;
+		len = sizeof(struct in_addr);
+	}
+
+	for (i = 0; i < len; i++) {
+		hash = (hash * 31U) + addr[i];
+	}
+
+	return hash;
+}
+
+static uint32_t conn_reuseport_weight(struct net_conn *conn, uint32_t flow)
+{
+	uint32_t weight = flow ^ (conn->seq * 0x9e3779b1U);
+
+	/* Murmur3 finalizer, so that the weights of the handlers of a
+	 * group look independent from each other.
+	 */
+	weight ^= weight >> 16;
+	weight *= 0x85ebca6bU;
+	weight ^= weight >> 13;
+	weight *= 0xc2b2ae35U;
+	weight ^= weight >> 16;
+
+	return weight;
+}
+
+/* A packet for a group of reuseport handlers goes to the one with the
+ * highest weight for its flow (rendezvous hashing). A flow thus always
+ * reaches the same handler, and a handler leaving the group only moves
+ * the flows it had.
+ */
+static bool conn_reuseport_prefer(struct net_conn *conn,
+				  struct net_conn *best,
+				  struct net_pkt *pkt,
+				  union net_ip_header *ip_hdr,
+				  uint16_t src_port)
+{
+	uint32_t flow;
+
+	if (!best || !(best->flags & NET_CONN_REUSEPORT) ||
+	    !(conn->flags & NET_CONN_REUSEPORT)) {
+		return false;
+	}
+
+	if (NET_CONN_RANK(conn->flags) != NET_CONN_RANK(best->flags)) {
+		return false;
+	}
+
+	flow = conn_flow_hash(pkt, ip_hdr, src_port);
+
+	return conn_reuseport_weight(conn, flow) >
+		conn_reuseport_weight(best, flow);
+}
+#else
+#define conn_reuseport_prefer(...) false
+#endif /* CONFIG_NET_CONTEXT_REUSEPORT */
+
 int net_conn_unregister(struct net_conn_handle *handle)
 {
 	struct net_conn *conn = (struct net_conn *)handle;
@@ -377,6 +576,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 	NET_DBG("Connection handler %p removed", conn);
 
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	sys_slist_find_and_remove(conn_lookup_list(conn), &conn->hash_node);
 
 	conn_set_unused(conn);
 
@@ -504,6 +704,20 @@ static bool conn_are_end_points_valid(struct net_pkt *pkt,
 	return !(my_src_addr && (src_port == dst_port));
 }
 
+#if defined(CONFIG_NET_PKT_RXTIME_STATS_DETAIL)
+static inline void conn_rx_stats_tick(struct net_pkt *pkt, uint8_t proto)
+{
+	/* Packet sockets see the packet before L2, only UDP and TCP
+	 * packets are timed here so the RX detail stages stay in order.
+	 */
+	if (proto == IPPROTO_UDP || proto == IPPROTO_TCP) {
+		net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
+	}
+}
+#else
+#define conn_rx_stats_tick(pkt, proto)
+#endif
+
 enum net_verdict net_conn_input(struct net_pkt *pkt,
 				union net_ip_header *ip_hdr,
 				uint8_t proto,
@@ -513,6 +727,7 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 	struct net_conn *best_match = NULL;
 	bool is_mcast_pkt = false, mcast_pkt_delivered = false;
 	int16_t best_rank = -1;
+	struct conn_lookup lookup;
 	struct net_conn *conn;
 	uint16_t src_port;
 	uint16_t dst_port;
@@ -546,6 +761,8 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		return NET_DROP;
 	}
 
+	conn_rx_stats_tick(pkt, proto);
+
 	/* TODO: Make core part of networing subsystem less dependent on
 	 * UDP, TCP, IPv4 or IPv6. So that we can add new features with
 	 * less cross-module changes.
@@ -568,7 +785,9 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+	conn_lookup_init(&lookup, proto, src_port, dst_port);
+
+	while ((conn = conn_lookup_next(&lookup)) != NULL) {
 		if (conn->proto != proto) {
 			continue;
 		}
@@ -619,6 +838,14 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 				continue;
 			}
 
+			if (!is_mcast_pkt &&
+			    conn_reuseport_prefer(conn, best_match, pkt,
+						  ip_hdr, src_port)) {
+				best_match = conn;
+
+				continue;
+			}
+
 			if (best_rank < NET_CONN_RANK(conn->flags)) {
 				struct net_pkt *mcast_pkt;
 
@@ -699,6 +926,8 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		NET_DBG("[%p] match found cb %p ud %p rank 0x%02x",
 			conn, conn->cb, conn->user_data, conn->flags);
 
+		conn_rx_stats_tick(pkt, proto);
+
 		if (conn->cb(conn, pkt, ip_hdr, proto_hdr,
 			     conn->user_data) == NET_DROP) {
 			goto drop;
@@ -752,6 +981,11 @@ void net_conn_init(void)
 
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
+	sys_slist_init(&conn_wildcard);
+
+	for (i = 0; i < ARRAY_SIZE(conn_hash); i++) {
+		sys_slist_init(&conn_hash[i]);
+	}
 
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
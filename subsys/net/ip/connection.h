@@ -50,6 +50,9 @@ struct net_conn {
 	/** Internal slist node */
 	sys_snode_t node;
 
+	/** Internal node in the lookup list of the connection */
+	sys_snode_t hash_node;
+
 	/** Remote IP address */
 	struct sockaddr remote_addr;
 
@@ -70,6 +73,9 @@ struct net_conn {
 
 	/** Flags for the connection */
 	uint8_t flags;
+
+	/** Registration sequence number */
+	uint32_t seq;
 };
 
 /**
@@ -121,6 +127,58 @@ static inline int net_conn_register(uint16_t proto, uint8_t family,
 }
 #endif
 
+/**
+ * @brief Register a connection handler which can share its end points.
+ *
+ * Same as net_conn_register(), but if @p reuseport is set, handlers
+ * identical to this one can be registered as long as they all set it.
+ * Packets matching such a group of handlers are spread among them by
+ * hashing their source address and port, so that a given flow is always
+ * delivered to the same handler. Multicast packets still reach all of
+ * them.
+ *
+ * @param proto Protocol for the connection (UDP or TCP or SOCK_RAW)
+ * @param family Protocol family (AF_INET or AF_INET6 or AF_PACKET)
+ * @param remote_addr Remote address of the connection end point.
+ * @param local_addr Local address of the connection end point.
+ * @param remote_port Remote port of the connection end point.
+ * @param local_port Local port of the connection end point.
+ * @param cb Callback to be called
+ * @param user_data User data supplied by caller.
+ * @param handle Connection handle that can be used when unregistering
+ * @param reuseport Share the end points with other reuseport handlers
+ *
+ * @return Return 0 if the registration succeed, <0 otherwise.
+ */
+#if defined(CONFIG_NET_NATIVE) && defined(CONFIG_NET_CONTEXT_REUSEPORT)
+int net_conn_register_reuseport(uint16_t proto, uint8_t family,
+				const struct sockaddr *remote_addr,
+				const struct sockaddr *local_addr,
+				uint16_t remote_port,
+				uint16_t local_port,
+				net_conn_cb_t cb,
+				void *user_data,
+				struct net_conn_handle **handle,
+				bool reuseport);
+#else
+static inline int net_conn_register_reuseport(uint16_t proto, uint8_t family,
+					const struct sockaddr *remote_addr,
+					const struct sockaddr *local_addr,
+					uint16_t remote_port,
+					uint16_t local_port,
+					net_conn_cb_t cb,
+					void *user_data,
+					struct net_conn_handle **handle,
+					bool reuseport)
+{
+	ARG_UNUSED(reuseport);
+
+	return net_conn_register(proto, family, remote_addr, local_addr,
+				 remote_port, local_port, cb, user_data,
+				 handle);
+}
+#endif
+
 /**
  * @brief Unregister connection handler.
  *
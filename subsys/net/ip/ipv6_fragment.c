@@ -46,6 +46,56 @@ static bool reassembly_init_done;
 static struct net_ipv6_reassembly
 reassembly[CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT];
 
+/* Pending reassemblies indexed by source, destination and id */
+static sys_slist_t reassembly_hash[CONFIG_NET_IPV6_FRAGMENT_HASH_BUCKETS];
+static sys_slist_t reassembly_free;
+
+static inline sys_slist_t *reassembly_hash_bucket(uint32_t id,
+						  const struct in6_addr *src,
+						  const struct in6_addr *dst)
+{
+	uint32_t hash = id ^
+			UNALIGNED_GET(&src->s6_addr32[3]) ^
+			UNALIGNED_GET(&dst->s6_addr32[3]);
+
+	hash = (hash ^ (hash >> 16)) * 0x45d9f3bU;
+	hash ^= hash >> 16;
+
+	return &reassembly_hash[hash % ARRAY_SIZE(reassembly_hash)];
+}
+
+static struct net_ipv6_reassembly *reassembly_find(uint32_t id,
+						   struct in6_addr *src,
+						   struct in6_addr *dst)
+{
+	struct net_ipv6_reassembly *reass;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(reassembly_hash_bucket(id, src, dst),
+				     reass, node) {
+		if (reass->id == id &&
+		    net_ipv6_addr_cmp(src, &reass->src) &&
+		    net_ipv6_addr_cmp(dst, &reass->dst)) {
+			return reass;
+		}
+	}
+
+	return NULL;
+}
+
+static void reassembly_release(struct net_ipv6_reassembly *reass)
+{
+	k_delayed_work_cancel(&reass->timer);
+
+	sys_slist_find_and_remove(reassembly_hash_bucket(reass->id,
+							 &reass->src,
+							 &reass->dst),
+				  &reass->node);
+
+	reass->id = 0U;
+
+	sys_slist_append(&reassembly_free, &reass->node);
+}
+
 int net_ipv6_find_last_ext_hdr(struct net_pkt *pkt, uint16_t *next_hdr_off,
 			       uint16_t *last_hdr_off)
 {
@@ -124,85 +174,68 @@ static struct net_ipv6_reassembly *reassembly_get(uint32_t id,
 						  struct in6_addr *src,
 						  struct in6_addr *dst)
 {
-	int i, avail = -1;
-
-	for (i = 0; i < CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT; i++) {
-
-		if (k_delayed_work_remaining_get(&reassembly[i].timer) &&
-		    reassembly[i].id == id &&
-		    net_ipv6_addr_cmp(src, &reassembly[i].src) &&
-		    net_ipv6_addr_cmp(dst, &reassembly[i].dst)) {
-			return &reassembly[i];
-		}
+	struct net_ipv6_reassembly *reass;
+	sys_snode_t *node;
 
-		if (k_delayed_work_remaining_get(&reassembly[i].timer)) {
-			continue;
-		}
-
-		if (avail < 0) {
-			avail = i;
-		}
+	reass = reassembly_find(id, src, dst);
+	if (reass) {
+		return reass;
 	}
 
-	if (avail < 0) {
+	node = sys_slist_get(&reassembly_free);
+	if (!node) {
 		return NULL;
 	}
 
-	k_delayed_work_submit(&reassembly[avail].timer,
-			      IPV6_REASSEMBLY_TIMEOUT);
+	reass = CONTAINER_OF(node, struct net_ipv6_reassembly, node);
+
+	k_delayed_work_submit(&reass->timer, IPV6_REASSEMBLY_TIMEOUT);
 
-	net_ipaddr_copy(&reassembly[avail].src, src);
-	net_ipaddr_copy(&reassembly[avail].dst, dst);
+	net_ipaddr_copy(&reass->src, src);
+	net_ipaddr_copy(&reass->dst, dst);
 
-	reassembly[avail].id = id;
+	reass->id = id;
 
-	return &reassembly[avail];
+	sys_slist_prepend(reassembly_hash_bucket(id, src, dst), &reass->node);
+
+	return reass;
 }
 
 static bool reassembly_cancel(uint32_t id,
 			      struct in6_addr *src,
 			      struct in6_addr *dst)
 {
-	int i, j;
+	struct net_ipv6_reassembly *reass;
+	int32_t remaining;
+	int j;
 
 	NET_DBG("Cancel 0x%x", id);
 
-	for (i = 0; i < CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT; i++) {
-		int32_t remaining;
-
-		if (reassembly[i].id != id ||
-		    !net_ipv6_addr_cmp(src, &reassembly[i].src) ||
-		    !net_ipv6_addr_cmp(dst, &reassembly[i].dst)) {
-			continue;
-		}
-
-		remaining = k_delayed_work_remaining_get(&reassembly[i].timer);
-		if (remaining) {
-			k_delayed_work_cancel(&reassembly[i].timer);
-		}
+	reass = reassembly_find(id, src, dst);
+	if (!reass) {
+		return false;
+	}
 
-		NET_DBG("IPv6 reassembly id 0x%x remaining %d ms",
-			reassembly[i].id, remaining);
+	remaining = k_delayed_work_remaining_get(&reass->timer);
 
-		reassembly[i].id = 0U;
+	NET_DBG("IPv6 reassembly id 0x%x remaining %d ms",
+		reass->id, remaining);
 
-		for (j = 0; j < NET_IPV6_FRAGMENTS_MAX_PKT; j++) {
-			if (!reassembly[i].pkt[j]) {
-				continue;
-			}
-
-			NET_DBG("[%d] IPv6 reassembly pkt %p %zd bytes data",
-				j, reassembly[i].pkt[j],
-				net_pkt_get_len(reassembly[i].pkt[j]));
-
-			net_pkt_unref(reassembly[i].pkt[j]);
-			reassembly[i].pkt[j] = NULL;
+	for (j = 0; j < NET_IPV6_FRAGMENTS_MAX_PKT; j++) {
+		if (!reass->pkt[j]) {
+			continue;
 		}
 
-		return true;
+		NET_DBG("[%d] IPv6 reassembly pkt %p %zd bytes data",
+			j, reass->pkt[j], net_pkt_get_len(reass->pkt[j]));
+
+		net_pkt_unref(reass->pkt[j]);
+		reass->pkt[j] = NULL;
 	}
 
-	return false;
+	reassembly_release(reass);
+
+	return true;
 }
 
 static void reassembly_info(char *str, struct net_ipv6_reassembly *reass)
@@ -281,6 +314,8 @@ static void reassemble_packet(struct net_ipv6_reassembly *reass)
 	pkt = reass->pkt[0];
 	reass->pkt[0] = NULL;
 
+	reassembly_release(reass);
+
 	/* Next we need to strip away the fragment header from the first packet
 	 * and set the various pointers and values in packet.
 	 */
@@ -350,15 +385,14 @@ error:
 
 void net_ipv6_frag_foreach(net_ipv6_frag_cb_t cb, void *user_data)
 {
+	struct net_ipv6_reassembly *reass;
 	int i;
 
 	for (i = 0; reassembly_init_done &&
-		     i < CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT; i++) {
-		if (!k_delayed_work_remaining_get(&reassembly[i].timer)) {
-			continue;
+		     i < ARRAY_SIZE(reassembly_hash); i++) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&reassembly_hash[i], reass, node) {
+			cb(reass, user_data);
 		}
-
-		cb(&reassembly[i], user_data);
 	}
 }
 
@@ -442,6 +476,8 @@ enum net_verdict net_ipv6_handle_fragment_hdr(struct net_pkt *pkt,
 		for (i = 0; i < CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT; i++) {
 			k_delayed_work_init(&reassembly[i].timer,
 					    reassembly_timeout);
+			sys_slist_append(&reassembly_free,
+					 &reassembly[i].node);
 		}
 
 		reassembly_init_done = true;
@@ -654,6 +690,38 @@ fail:
 	return ret;
 }
 
+/* The hardware cannot compute an upper layer checksum spanning several
+ * fragments, so one left pending has to be filled in before fragmenting.
+ */
+static int ipv6_fragment_chksum(struct net_pkt *pkt, uint8_t proto)
+{
+	uint16_t chksum;
+	size_t offset;
+
+	net_pkt_set_chksum_state(pkt, NET_PKT_CHKSUM_NONE);
+
+	if (IS_ENABLED(CONFIG_NET_UDP) && proto == IPPROTO_UDP) {
+		chksum = net_calc_chksum_udp(pkt);
+		offset = offsetof(struct net_udp_hdr, chksum);
+	} else if (IS_ENABLED(CONFIG_NET_TCP) && proto == IPPROTO_TCP) {
+		chksum = net_calc_chksum_tcp(pkt);
+		offset = offsetof(struct net_tcp_hdr, chksum);
+	} else {
+		return 0;
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
+			 net_pkt_ipv6_ext_len(pkt) + offset) ||
+	    net_pkt_write(pkt, &chksum, sizeof(chksum))) {
+		return -ENOBUFS;
+	}
+
+	return 0;
+}
+
 int net_ipv6_send_fragmented_pkt(struct net_if *iface, struct net_pkt *pkt,
 				 uint16_t pkt_len)
 {
@@ -682,6 +750,13 @@ int net_ipv6_send_fragmented_pkt(struct net_if *iface, struct net_pkt *pkt,
 		return -ENOBUFS;
 	}
 
+	if (net_pkt_chksum_state(pkt) == NET_PKT_CHKSUM_PENDING) {
+		ret = ipv6_fragment_chksum(pkt, last_hdr);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
 	/* The Maximum payload can fit into each packet after IPv6 header,
 	 * Extenstion headers and Fragmentation header.
 	 */
@@ -97,6 +97,21 @@ NET_NBR_TABLE_INIT(NET_NBR_GLOBAL,
 		   net_neighbor_pool,
 		   net_neighbor_table_clear);
 
+/* Neighbors indexed by IPv6 address */
+static sys_slist_t nbr_hash[CONFIG_NET_IPV6_NBR_HASH_BUCKETS];
+
+static inline sys_slist_t *nbr_hash_bucket(const struct in6_addr *addr)
+{
+	/* The interface identifier is what differs on a link */
+	uint32_t hash = UNALIGNED_GET(&addr->s6_addr32[2]) ^
+			UNALIGNED_GET(&addr->s6_addr32[3]);
+
+	hash = (hash ^ (hash >> 16)) * 0x45d9f3bU;
+	hash ^= hash >> 16;
+
+	return &nbr_hash[hash % ARRAY_SIZE(nbr_hash)];
+}
+
 const char *net_ipv6_nbr_state2str(enum net_ipv6_nbr_state state)
 {
 	switch (state) {
@@ -259,20 +274,19 @@ static struct net_nbr *nbr_lookup(struct net_nbr_table *table,
 				  struct net_if *iface,
 				  const struct in6_addr *addr)
 {
-	int i;
+	struct net_ipv6_nbr_data *data;
 
-	for (i = 0; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
-		struct net_nbr *nbr = get_nbr(i);
+	ARG_UNUSED(table);
 
-		if (!nbr->ref) {
-			continue;
-		}
+	SYS_SLIST_FOR_EACH_CONTAINER(nbr_hash_bucket(addr), data, hash_node) {
+		struct net_nbr *nbr = CONTAINER_OF((uint8_t *)data,
+						   struct net_nbr, __nbr);
 
 		if (iface && nbr->iface != iface) {
 			continue;
 		}
 
-		if (net_ipv6_addr_cmp(&net_ipv6_nbr_data(nbr)->addr, addr)) {
+		if (net_ipv6_addr_cmp(&data->addr, addr)) {
 			return nbr;
 		}
 	}
@@ -408,6 +422,8 @@ static void nbr_init(struct net_nbr *nbr, struct net_if *iface,
 	nbr->iface = iface;
 
 	net_ipaddr_copy(&net_ipv6_nbr_data(nbr)->addr, addr);
+	sys_slist_prepend(nbr_hash_bucket(addr),
+			  &net_ipv6_nbr_data(nbr)->hash_node);
 	ipv6_nbr_set_state(nbr, state);
 	net_ipv6_nbr_data(nbr)->is_router = is_router;
 	net_ipv6_nbr_data(nbr)->pending = NULL;
@@ -651,8 +667,13 @@ struct net_nbr *net_ipv6_nbr_add(struct net_if *iface,
 
 void net_neighbor_data_remove(struct net_nbr *nbr)
 {
+	struct net_ipv6_nbr_data *data = net_ipv6_nbr_data(nbr);
+
 	NET_DBG("Neighbor %p removed", nbr);
 
+	sys_slist_find_and_remove(nbr_hash_bucket(&data->addr),
+				  &data->hash_node);
+
 	return;
 }
 
@@ -787,9 +808,10 @@ enum net_verdict net_ipv6_prepare_for_send(struct net_pkt *pkt)
 
 #if defined(CONFIG_NET_IPV6_FRAGMENT)
 	/* If we have already fragmented the packet, the fragment id will
-	 * contain a proper value and we can skip other checks.
+	 * contain a proper value and we can skip other checks. Packets
+	 * segmented by the hardware are never fragmented.
 	 */
-	if (net_pkt_ipv6_fragment_id(pkt) == 0U) {
+	if (net_pkt_ipv6_fragment_id(pkt) == 0U && !net_pkt_tso_mss(pkt)) {
 		uint16_t mtu = net_if_get_mtu(net_pkt_iface(pkt));
 		size_t pkt_len = net_pkt_get_len(pkt);
 
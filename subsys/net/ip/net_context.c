@@ -1128,6 +1128,22 @@ static int get_context_timepstamp(struct net_context *context,
 #endif
 }
 
+static int get_context_reuseport(struct net_context *context,
+				 void *value, size_t *len)
+{
+#if defined(CONFIG_NET_CONTEXT_REUSEPORT)
+	*((bool *)value) = context->options.reuseport;
+
+	if (len) {
+		*len = sizeof(bool);
+	}
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
 static int get_context_proxy(struct net_context *context,
 			     void *value, size_t *len)
 {
@@ -1185,15 +1201,25 @@ static int get_context_txtime(struct net_context *context,
 #endif
 }
 
+/* Data produced straight into the packet, see net_context_send_from() */
+struct context_fill {
+	net_context_fill_cb_t cb;
+	void *user_data;
+};
+
 /* If buf is not NULL, then use it. Otherwise read the data to be written
- * to net_pkt from msghdr.
+ * to net_pkt from msghdr, or have the fill callback produce it.
  */
 static int context_write_data(struct net_pkt *pkt, const void *buf,
-			      int buf_len, const struct msghdr *msghdr)
+			      int buf_len, const struct msghdr *msghdr,
+			      const struct context_fill *fill)
 {
 	int ret = 0;
 
-	if (msghdr) {
+	if (fill) {
+		ret = net_pkt_write_from(pkt, fill->cb, fill->user_data,
+					 buf_len);
+	} else if (msghdr) {
 		int i;
 
 		for (i = 0; i < msghdr->msg_iovlen; i++) {
@@ -1215,6 +1241,7 @@ static int context_setup_udp_packet(struct net_context *context,
 				    const void *buf,
 				    size_t len,
 				    const struct msghdr *msg,
+				    const struct context_fill *fill,
 				    const struct sockaddr *dst_addr,
 				    socklen_t addrlen)
 {
@@ -1256,7 +1283,7 @@ static int context_setup_udp_packet(struct net_context *context,
 		return ret;
 	}
 
-	ret = context_write_data(pkt, buf, len, msg);
+	ret = context_write_data(pkt, buf, len, msg, fill);
 	if (ret) {
 		return ret;
 	}
@@ -1344,6 +1371,7 @@ static int context_sendto(struct net_context *context,
 			  net_context_send_cb_t cb,
 			  k_timeout_t timeout,
 			  void *user_data,
+			  const struct context_fill *fill,
 			  bool sendto)
 {
 	const struct msghdr *msghdr = NULL;
@@ -1560,7 +1588,7 @@ static int context_sendto(struct net_context *context,
 
 	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
 	    net_if_is_ip_offloaded(net_context_get_iface(context))) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, fill);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1578,7 +1606,7 @@ static int context_sendto(struct net_context *context,
 	} else if (IS_ENABLED(CONFIG_NET_UDP) &&
 	    net_context_get_ip_proto(context) == IPPROTO_UDP) {
 		ret = context_setup_udp_packet(context, pkt, buf, len, msghdr,
-					       dst_addr, addrlen);
+					       fill, dst_addr, addrlen);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1589,7 +1617,7 @@ static int context_sendto(struct net_context *context,
 	} else if (IS_ENABLED(CONFIG_NET_TCP) &&
 		   net_context_get_ip_proto(context) == IPPROTO_TCP) {
 
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, fill);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1603,7 +1631,7 @@ static int context_sendto(struct net_context *context,
 		ret = net_tcp_send_data(context, cb, user_data);
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) &&
 		   net_context_get_family(context) == AF_PACKET) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, fill);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1614,7 +1642,7 @@ static int context_sendto(struct net_context *context,
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_CAN) &&
 		   net_context_get_family(context) == AF_CAN &&
 		   net_context_get_ip_proto(context) == CAN_RAW) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, fill);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1639,12 +1667,13 @@ fail:
 	return ret;
 }
 
-int net_context_send(struct net_context *context,
-		     const void *buf,
-		     size_t len,
-		     net_context_send_cb_t cb,
-		     k_timeout_t timeout,
-		     void *user_data)
+static int context_send(struct net_context *context,
+			const void *buf,
+			size_t len,
+			const struct context_fill *fill,
+			net_context_send_cb_t cb,
+			k_timeout_t timeout,
+			void *user_data)
 {
 	socklen_t addrlen;
 	int ret = 0;
@@ -1675,13 +1704,40 @@ int net_context_send(struct net_context *context,
 	}
 
 	ret = context_sendto(context, buf, len, &context->remote,
-			     addrlen, cb, timeout, user_data, false);
+			     addrlen, cb, timeout, user_data, fill, false);
 unlock:
 	k_mutex_unlock(&context->lock);
 
 	return ret;
 }
 
+int net_context_send(struct net_context *context,
+		     const void *buf,
+		     size_t len,
+		     net_context_send_cb_t cb,
+		     k_timeout_t timeout,
+		     void *user_data)
+{
+	return context_send(context, buf, len, NULL, cb, timeout, user_data);
+}
+
+int net_context_send_from(struct net_context *context,
+			  net_context_fill_cb_t fill,
+			  void *fill_data,
+			  size_t len,
+			  net_context_send_cb_t cb,
+			  k_timeout_t timeout,
+			  void *user_data)
+{
+	const struct context_fill data = {
+		.cb = fill,
+		.user_data = fill_data,
+	};
+
+	return context_send(context, NULL, len, &data, cb, timeout,
+			    user_data);
+}
+
 int net_context_sendmsg(struct net_context *context,
 			const struct msghdr *msghdr,
 			int flags,
@@ -1694,7 +1750,7 @@ int net_context_sendmsg(struct net_context *context,
 	k_mutex_lock(&context->lock, K_FOREVER);
 
 	ret = context_sendto(context, msghdr, 0, NULL, 0,
-			     cb, timeout, user_data, true);
+			     cb, timeout, user_data, NULL, true);
 
 	k_mutex_unlock(&context->lock);
 
@@ -1715,7 +1771,7 @@ int net_context_sendto(struct net_context *context,
 	k_mutex_lock(&context->lock, K_FOREVER);
 
 	ret = context_sendto(context, buf, len, dst_addr, addrlen,
-			     cb, timeout, user_data, true);
+			     cb, timeout, user_data, NULL, true);
 
 	k_mutex_unlock(&context->lock);
 
@@ -1816,7 +1872,8 @@ static int recv_udp(struct net_context *context,
 
 	context->recv_cb = cb;
 
-	ret = net_conn_register(net_context_get_ip_proto(context),
+	ret = net_conn_register_reuseport(
+				net_context_get_ip_proto(context),
 				net_context_get_family(context),
 				context->flags & NET_CONTEXT_REMOTE_ADDR_SET ?
 							&context->remote : NULL,
@@ -1825,7 +1882,8 @@ static int recv_udp(struct net_context *context,
 				ntohs(lport),
 				net_context_packet_received,
 				user_data,
-				&context->conn_handler);
+				&context->conn_handler,
+				net_context_is_reuseport(context));
 
 	return ret;
 }
@@ -2062,6 +2120,25 @@ static int set_context_txtime(struct net_context *context,
 #endif
 }
 
+static int set_context_reuseport(struct net_context *context,
+				 const void *value, size_t len)
+{
+#if defined(CONFIG_NET_CONTEXT_REUSEPORT)
+	if (len > sizeof(bool)) {
+		return -EINVAL;
+	}
+
+	/* Only used when the context registers its connection handler,
+	 * i.e. it must be set before the context starts to receive.
+	 */
+	context->options.reuseport = *((bool *)value);
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
 static int set_context_proxy(struct net_context *context,
 			     const void *value, size_t len)
 {
@@ -2112,6 +2189,9 @@ int net_context_set_option(struct net_context *context,
 	case NET_OPT_SOCKS5:
 		ret = set_context_proxy(context, value, len);
 		break;
+	case NET_OPT_REUSEPORT:
+		ret = set_context_reuseport(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
@@ -2146,6 +2226,9 @@ int net_context_get_option(struct net_context *context,
 	case NET_OPT_SOCKS5:
 		ret = get_context_proxy(context, value, len);
 		break;
+	case NET_OPT_REUSEPORT:
+		ret = get_context_reuseport(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
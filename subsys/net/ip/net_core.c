@@ -97,6 +97,11 @@ static inline enum net_verdict process_data(struct net_pkt *pkt,
 		}
 	}
 
+	/* Recorded for loopback too so that the following RX detail
+	 * stages stay at the same index.
+	 */
+	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
+
 	ret = net_canbus_socket_input(pkt);
 	if (ret != NET_CONTINUE) {
 		return ret;
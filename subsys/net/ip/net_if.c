@@ -344,6 +344,115 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 	return true;
 }
 
+#if defined(CONFIG_NET_TX_BATCH)
+/* Packets collected by each TX thread, only accessed from that thread */
+struct net_if_tx_batch {
+	struct net_if *iface;
+	size_t count;
+	struct net_pkt *pkts[CONFIG_NET_TX_BATCH_SIZE];
+};
+
+static struct net_if_tx_batch tx_batches[NET_TC_TX_COUNT];
+
+static void net_if_tx_batch(struct net_if *iface, struct net_pkt *pkts[],
+			    size_t count)
+{
+	struct net_linkaddr_storage ll_dst[CONFIG_NET_TX_BATCH_SIZE];
+	struct net_context *context[CONFIG_NET_TX_BATCH_SIZE];
+	int status[CONFIG_NET_TX_BATCH_SIZE];
+	size_t i;
+
+	if (count == 1U || !net_if_l2(iface)->send_batch ||
+	    !net_if_flag_is_set(iface, NET_IF_UP)) {
+		for (i = 0; i < count; i++) {
+			net_if_tx(iface, pkts[i]);
+		}
+
+		return;
+	}
+
+	for (i = 0; i < count; i++) {
+		debug_check_packet(pkts[i]);
+
+		/* Same as in net_if_tx(), the packet might be freed before
+		 * the link callbacks are called.
+		 */
+		ll_dst[i].len = 0U;
+
+		if (!sys_slist_is_empty(&link_callbacks) &&
+		    net_linkaddr_set(&ll_dst[i],
+				     net_pkt_lladdr_dst(pkts[i])->addr,
+				     net_pkt_lladdr_dst(pkts[i])->len) == 0) {
+			ll_dst[i].type = net_pkt_lladdr_dst(pkts[i])->type;
+		}
+
+		context[i] = net_pkt_context(pkts[i]);
+
+		if (IS_ENABLED(CONFIG_NET_TCP) &&
+		    net_pkt_family(pkts[i]) != AF_UNSPEC) {
+			net_pkt_set_queued(pkts[i], false);
+		}
+	}
+
+	net_if_l2(iface)->send_batch(iface, pkts, status, count);
+
+	for (i = 0; i < count; i++) {
+		if (status[i] < 0) {
+			net_pkt_unref(pkts[i]);
+		} else {
+			net_stats_update_bytes_sent(iface, status[i]);
+		}
+
+		if (context[i]) {
+			NET_DBG("Calling context send cb %p status %d",
+				context[i], status[i]);
+
+			net_context_send_cb(context[i], status[i]);
+		}
+
+		if (ll_dst[i].len) {
+			struct net_linkaddr lladdr = {
+				.addr = ll_dst[i].addr,
+				.len = ll_dst[i].len,
+				.type = ll_dst[i].type,
+			};
+
+			net_if_call_link_cb(iface, &lladdr, status[i]);
+		}
+	}
+}
+
+static void tx_batch_flush(struct net_if_tx_batch *batch)
+{
+	net_if_tx_batch(batch->iface, batch->pkts, batch->count);
+
+#if defined(CONFIG_NET_POWER_MANAGEMENT)
+	batch->iface->tx_pending -= batch->count;
+#endif
+
+	batch->count = 0;
+}
+
+static void tx_batch_add(struct net_if *iface, struct net_pkt *pkt)
+{
+	uint8_t tc = net_tx_priority2tc(net_pkt_priority(pkt));
+	struct net_if_tx_batch *batch = &tx_batches[tc];
+
+	if (batch->count > 0 && batch->iface != iface) {
+		tx_batch_flush(batch);
+	}
+
+	batch->iface = iface;
+	batch->pkts[batch->count++] = pkt;
+
+	/* Wait for more packets only if some are already queued */
+	if (batch->count == CONFIG_NET_TX_BATCH_SIZE ||
+	    net_tc_tx_queue_is_empty(tc)) {
+		tx_batch_flush(batch);
+	}
+}
+#endif /* CONFIG_NET_TX_BATCH */
+
 static void process_tx_packet(struct k_work *work)
 {
 	struct net_if *iface;
@@ -355,11 +464,15 @@ static void process_tx_packet(struct k_work *work)
 
 	iface = net_pkt_iface(pkt);
 
+#if defined(CONFIG_NET_TX_BATCH)
+	tx_batch_add(iface, pkt);
+#else
 	net_if_tx(iface, pkt);
 
 #if defined(CONFIG_NET_POWER_MANAGEMENT)
 	iface->tx_pending--;
 #endif
+#endif /* CONFIG_NET_TX_BATCH */
 }
 
 void net_if_queue_tx(struct net_if *iface, struct net_pkt *pkt)
@@ -395,6 +508,9 @@ void net_if_stats_reset(struct net_if *iface)
 	Z_STRUCT_SECTION_FOREACH(net_if, tmp) {
 		if (iface == tmp) {
 			memset(&iface->stats, 0, sizeof(iface->stats));
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+			memset(iface->stats_cpu, 0, sizeof(iface->stats_cpu));
+#endif
 			return;
 		}
 	}
@@ -407,6 +523,9 @@ void net_if_stats_reset_all(void)
 
 	Z_STRUCT_SECTION_FOREACH(net_if, iface) {
 		memset(&iface->stats, 0, sizeof(iface->stats));
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+		memset(iface->stats_cpu, 0, sizeof(iface->stats_cpu));
+#endif
 	}
 #endif
 }
@@ -3529,6 +3648,22 @@ bool net_if_need_calc_rx_checksum(struct net_if *iface)
 	return need_calc_checksum(iface, ETHERNET_HW_RX_CHKSUM_OFFLOAD);
 }
 
+bool net_if_can_offload_tso(struct net_if *iface)
+{
+#if defined(CONFIG_NET_L2_ETHERNET)
+	enum ethernet_hw_caps caps = ETHERNET_HW_TX_TSO |
+				     ETHERNET_HW_TX_CHKSUM_OFFLOAD;
+
+	if (net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET)) {
+		return false;
+	}
+
+	return (net_eth_get_hw_capabilities(iface) & caps) == caps;
+#else
+	return false;
+#endif
+}
+
 int net_if_get_by_iface(struct net_if *iface)
 {
 	if (!(iface >= _net_if_list_start && iface < _net_if_list_end)) {
@@ -3753,22 +3888,64 @@ static void net_tx_ts_thread(void)
 	}
 }
 
+static inline bool timestamp_cb_matches(struct net_if_timestamp_cb *handle,
+					struct net_pkt *pkt)
+{
+	return ((handle->iface == NULL) ||
+		(handle->iface == net_pkt_iface(pkt))) &&
+		(handle->pkt == NULL || handle->pkt == pkt);
+}
+
 void net_if_register_timestamp_cb(struct net_if_timestamp_cb *handle,
 				  struct net_pkt *pkt,
 				  struct net_if *iface,
 				  net_if_timestamp_callback_t cb)
 {
+	unsigned int key;
+
+	/* The list is walked by the drivers when direct callbacks are
+	 * enabled, the handle must be complete once it is in it.
+	 */
+	key = irq_lock();
+
 	sys_slist_find_and_remove(&timestamp_callbacks, &handle->node);
-	sys_slist_prepend(&timestamp_callbacks, &handle->node);
 
 	handle->iface = iface;
 	handle->cb = cb;
 	handle->pkt = pkt;
+#if defined(CONFIG_NET_PKT_TIMESTAMP_DIRECT)
+	handle->direct = false;
+#endif
+
+	sys_slist_prepend(&timestamp_callbacks, &handle->node);
+
+	irq_unlock(key);
+}
+
+#if defined(CONFIG_NET_PKT_TIMESTAMP_DIRECT)
+void net_if_register_timestamp_cb_direct(struct net_if_timestamp_cb *handle,
+					 struct net_pkt *pkt,
+					 struct net_if *iface,
+					 net_if_timestamp_callback_t cb)
+{
+	unsigned int key;
+
+	key = irq_lock();
+
+	net_if_register_timestamp_cb(handle, pkt, iface, cb);
+	handle->direct = true;
+
+	irq_unlock(key);
 }
+#endif /* CONFIG_NET_PKT_TIMESTAMP_DIRECT */
 
 void net_if_unregister_timestamp_cb(struct net_if_timestamp_cb *handle)
 {
+	unsigned int key;
+
+	key = irq_lock();
 	sys_slist_find_and_remove(&timestamp_callbacks, &handle->node);
+	irq_unlock(key);
 }
 
 void net_if_call_timestamp_cb(struct net_pkt *pkt)
@@ -3779,9 +3956,7 @@ void net_if_call_timestamp_cb(struct net_pkt *pkt)
 		struct net_if_timestamp_cb *handle =
 			CONTAINER_OF(sn, struct net_if_timestamp_cb, node);
 
-		if (((handle->iface == NULL) ||
-		     (handle->iface == net_pkt_iface(pkt))) &&
-		    (handle->pkt == NULL || handle->pkt == pkt)) {
+		if (timestamp_cb_matches(handle, pkt)) {
 			handle->cb(pkt);
 		}
 	}
@@ -3789,6 +3964,28 @@ void net_if_call_timestamp_cb(struct net_pkt *pkt)
 
 void net_if_add_tx_timestamp(struct net_pkt *pkt)
 {
+#if defined(CONFIG_NET_PKT_TIMESTAMP_DIRECT)
+	net_if_timestamp_callback_t cb = NULL;
+	struct net_if_timestamp_cb *handle;
+	unsigned int key;
+
+	key = irq_lock();
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&timestamp_callbacks, handle, node) {
+		if (handle->direct && timestamp_cb_matches(handle, pkt)) {
+			cb = handle->cb;
+			break;
+		}
+	}
+
+	irq_unlock(key);
+
+	if (cb) {
+		cb(pkt);
+		return;
+	}
+#endif /* CONFIG_NET_PKT_TIMESTAMP_DIRECT */
+
 	k_fifo_put(&tx_ts_queue, pkt);
 }
 #endif /* CONFIG_NET_PKT_TIMESTAMP_THREAD */
@@ -33,131 +33,192 @@ struct mgmt_event_wait {
 	struct net_if *iface;
 };
 
+/* Callbacks are hashed on the layer and layer code of their mask: both
+ * need an exact match, so only one bucket has to be walked per event.
+ */
+#define MGMT_CB_BUCKETS 8
+
+#define MGMT_CB_HASH(_event)						\
+	((NET_MGMT_GET_LAYER(_event) ^ NET_MGMT_GET_LAYER_CODE(_event)) & \
+	 (MGMT_CB_BUCKETS - 1))
+
 static K_SEM_DEFINE(network_event, 0, UINT_MAX);
 static K_SEM_DEFINE(net_mgmt_lock, 1, 1);
 
 K_KERNEL_STACK_DEFINE(mgmt_stack, CONFIG_NET_MGMT_EVENT_STACK_SIZE);
 static struct k_thread mgmt_thread_data;
 static struct mgmt_event_entry events[CONFIG_NET_MGMT_EVENT_QUEUE_SIZE];
+static struct k_spinlock events_lock;
 static uint32_t global_event_mask;
-static sys_slist_t event_callbacks;
-static int16_t in_event;
-static int16_t out_event;
+static sys_slist_t event_callbacks[MGMT_CB_BUCKETS];
+static uint16_t out_event;
+static uint16_t pending_events;
+
+#ifdef CONFIG_NET_MGMT_EVENT_DIRECT
+static K_MUTEX_DEFINE(direct_lock);
+static uint32_t direct_event_mask;
+static sys_slist_t direct_callbacks[MGMT_CB_BUCKETS];
+#endif
+
+#define EVENT_SLOT(_pos)						\
+	(&events[(out_event + (_pos)) % CONFIG_NET_MGMT_EVENT_QUEUE_SIZE])
+
+#ifdef CONFIG_NET_MGMT_EVENT_COALESCE
+static bool mgmt_event_pending(uint32_t mgmt_event, struct net_if *iface,
+			       void *info, size_t length)
+{
+	uint16_t pos;
+
+	for (pos = 0U; pos < pending_events; pos++) {
+		struct mgmt_event_entry *entry = EVENT_SLOT(pos);
+
+		if (entry->event != mgmt_event || entry->iface != iface) {
+			continue;
+		}
+
+#ifdef CONFIG_NET_MGMT_EVENT_INFO
+		if (entry->info_length != (info ? length : 0) ||
+		    (entry->info_length &&
+		     memcmp(entry->info, info, length))) {
+			continue;
+		}
+#endif /* CONFIG_NET_MGMT_EVENT_INFO */
+
+		return true;
+	}
+
+	return false;
+}
+#endif /* CONFIG_NET_MGMT_EVENT_COALESCE */
 
-static inline void mgmt_push_event(uint32_t mgmt_event, struct net_if *iface,
+/* Producers only hold events_lock while copying the event in, they never
+ * wait for callbacks being run from the net_mgmt thread.
+ */
+static inline bool mgmt_push_event(uint32_t mgmt_event, struct net_if *iface,
 				   void *info, size_t length)
 {
-	int16_t i_idx;
+	struct mgmt_event_entry *entry;
+	k_spinlock_key_t key;
 
-#ifndef CONFIG_NET_MGMT_EVENT_INFO
+#ifdef CONFIG_NET_MGMT_EVENT_INFO
+	if (info && length > NET_EVENT_INFO_MAX_SIZE) {
+		NET_ERR("Event info length %zu > max size %zu",
+			length, NET_EVENT_INFO_MAX_SIZE);
+		return false;
+	}
+#else
 	ARG_UNUSED(info);
 	ARG_UNUSED(length);
 #endif /* CONFIG_NET_MGMT_EVENT_INFO */
 
-	k_sem_take(&net_mgmt_lock, K_FOREVER);
+	key = k_spin_lock(&events_lock);
+
+#ifdef CONFIG_NET_MGMT_EVENT_COALESCE
+	if (mgmt_event_pending(mgmt_event, iface, info, length)) {
+		k_spin_unlock(&events_lock, key);
 
-	i_idx = in_event + 1;
-	if (i_idx == CONFIG_NET_MGMT_EVENT_QUEUE_SIZE) {
-		i_idx = 0;
+		NET_DBG("Event 0x%08x already pending", mgmt_event);
+		return false;
 	}
+#endif
+
+	if (pending_events == CONFIG_NET_MGMT_EVENT_QUEUE_SIZE) {
+		/* Queue is full, the oldest event is lost */
+		out_event = (out_event + 1) % CONFIG_NET_MGMT_EVENT_QUEUE_SIZE;
+		pending_events--;
+	}
+
+	entry = EVENT_SLOT(pending_events);
 
 #ifdef CONFIG_NET_MGMT_EVENT_INFO
 	if (info && length) {
-		if (length <= NET_EVENT_INFO_MAX_SIZE) {
-			memcpy(events[i_idx].info, info, length);
-			events[i_idx].info_length = length;
-		} else {
-			NET_ERR("Event info length %zu > max size %zu",
-				length, NET_EVENT_INFO_MAX_SIZE);
-			k_sem_give(&net_mgmt_lock);
-
-			return;
-		}
+		memcpy(entry->info, info, length);
+		entry->info_length = length;
 	} else {
-		events[i_idx].info_length = 0;
+		entry->info_length = 0;
 	}
 #endif /* CONFIG_NET_MGMT_EVENT_INFO */
 
-	events[i_idx].event = mgmt_event;
-	events[i_idx].iface = iface;
+	entry->event = mgmt_event;
+	entry->iface = iface;
 
-	if (i_idx == out_event) {
-		uint16_t o_idx = out_event + 1;
+	pending_events++;
 
-		if (o_idx == CONFIG_NET_MGMT_EVENT_QUEUE_SIZE) {
-			o_idx = 0U;
-		}
-
-		if (events[o_idx].event) {
-			out_event = o_idx;
-		}
-	} else if (out_event < 0) {
-		out_event = i_idx;
-	}
-
-	in_event = i_idx;
+	k_spin_unlock(&events_lock, key);
 
-	k_sem_give(&net_mgmt_lock);
+	return true;
 }
 
-static inline struct mgmt_event_entry *mgmt_pop_event(void)
+static inline bool mgmt_pop_event(struct mgmt_event_entry *mgmt_event)
 {
-	int16_t o_idx;
+	k_spinlock_key_t key;
+	bool ret = false;
 
-	if (out_event < 0 || !events[out_event].event) {
-		return NULL;
-	}
-
-	o_idx = out_event;
-	out_event++;
+	key = k_spin_lock(&events_lock);
 
-	if (o_idx == in_event) {
-		in_event = -1;
-		out_event = -1;
-	} else if (out_event == CONFIG_NET_MGMT_EVENT_QUEUE_SIZE) {
-		out_event = 0;
+	if (pending_events) {
+		memcpy(mgmt_event, EVENT_SLOT(0), sizeof(*mgmt_event));
+		out_event = (out_event + 1) % CONFIG_NET_MGMT_EVENT_QUEUE_SIZE;
+		pending_events--;
+		ret = true;
 	}
 
-	return &events[o_idx];
-}
+	k_spin_unlock(&events_lock, key);
 
-static inline void mgmt_clean_event(struct mgmt_event_entry *mgmt_event)
-{
-	mgmt_event->event = 0U;
-	mgmt_event->iface = NULL;
+	return ret;
 }
 
-static inline void mgmt_add_event_mask(uint32_t event_mask)
+static inline void mgmt_add_event_mask(uint32_t *mask, uint32_t event_mask)
 {
-	global_event_mask |= event_mask;
+	*mask |= event_mask;
 }
 
-static inline void mgmt_rebuild_global_event_mask(void)
+static inline void mgmt_rebuild_event_mask(uint32_t *mask,
+					   sys_slist_t *callbacks)
 {
 	struct net_mgmt_event_callback *cb, *tmp;
+	int i;
 
-	global_event_mask = 0U;
+	*mask = 0U;
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&event_callbacks, cb, tmp, node) {
-		mgmt_add_event_mask(cb->event_mask);
+	for (i = 0; i < MGMT_CB_BUCKETS; i++) {
+		SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&callbacks[i], cb, tmp,
+						  node) {
+			mgmt_add_event_mask(mask, cb->event_mask);
+		}
 	}
 }
 
-static inline bool mgmt_is_event_handled(uint32_t mgmt_event)
+static inline bool mgmt_is_event_handled(uint32_t event_mask,
+					 uint32_t mgmt_event)
 {
 	return (((NET_MGMT_GET_LAYER(mgmt_event) &
-		  NET_MGMT_GET_LAYER(global_event_mask)) ==
+		  NET_MGMT_GET_LAYER(event_mask)) ==
 		 NET_MGMT_GET_LAYER(mgmt_event)) &&
 		((NET_MGMT_GET_LAYER_CODE(mgmt_event) &
-		  NET_MGMT_GET_LAYER_CODE(global_event_mask)) ==
+		  NET_MGMT_GET_LAYER_CODE(event_mask)) ==
 		 NET_MGMT_GET_LAYER_CODE(mgmt_event)) &&
 		((NET_MGMT_GET_COMMAND(mgmt_event) &
-		  NET_MGMT_GET_COMMAND(global_event_mask)) ==
+		  NET_MGMT_GET_COMMAND(event_mask)) ==
 		 NET_MGMT_GET_COMMAND(mgmt_event)));
 }
 
+static inline bool mgmt_cb_matches(struct net_mgmt_event_callback *cb,
+				   uint32_t mgmt_event)
+{
+	return (NET_MGMT_GET_LAYER(mgmt_event) ==
+		NET_MGMT_GET_LAYER(cb->event_mask)) &&
+		(NET_MGMT_GET_LAYER_CODE(mgmt_event) ==
+		 NET_MGMT_GET_LAYER_CODE(cb->event_mask)) &&
+		(!NET_MGMT_GET_COMMAND(mgmt_event) ||
+		 !NET_MGMT_GET_COMMAND(cb->event_mask) ||
+		 (NET_MGMT_GET_COMMAND(mgmt_event) &
+		  NET_MGMT_GET_COMMAND(cb->event_mask)));
+}
+
 static inline void mgmt_run_callbacks(struct mgmt_event_entry *mgmt_event)
 {
+	sys_slist_t *bucket = &event_callbacks[MGMT_CB_HASH(mgmt_event->event)];
 	sys_snode_t *prev = NULL;
 	struct net_mgmt_event_callback *cb, *tmp;
 
@@ -166,15 +227,9 @@ static inline void mgmt_run_callbacks(struct mgmt_event_entry *mgmt_event)
 		NET_MGMT_GET_LAYER_CODE(mgmt_event->event),
 		NET_MGMT_GET_COMMAND(mgmt_event->event));
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&event_callbacks, cb, tmp, node) {
-		if (!(NET_MGMT_GET_LAYER(mgmt_event->event) ==
-		      NET_MGMT_GET_LAYER(cb->event_mask)) ||
-		    !(NET_MGMT_GET_LAYER_CODE(mgmt_event->event) ==
-		      NET_MGMT_GET_LAYER_CODE(cb->event_mask)) ||
-		    (NET_MGMT_GET_COMMAND(mgmt_event->event) &&
-		     NET_MGMT_GET_COMMAND(cb->event_mask) &&
-		     !(NET_MGMT_GET_COMMAND(mgmt_event->event) &
-		       NET_MGMT_GET_COMMAND(cb->event_mask)))) {
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(bucket, cb, tmp, node) {
+		if (!mgmt_cb_matches(cb, mgmt_event->event)) {
+			prev = &cb->node;
 			continue;
 		}
 
@@ -195,6 +250,7 @@ static inline void mgmt_run_callbacks(struct mgmt_event_entry *mgmt_event)
 
 			if (sync_data->iface &&
 			    sync_data->iface != mgmt_event->iface) {
+				prev = &cb->node;
 				continue;
 			}
 
@@ -203,7 +259,7 @@ static inline void mgmt_run_callbacks(struct mgmt_event_entry *mgmt_event)
 			cb->raised_event = mgmt_event->event;
 			sync_data->iface = mgmt_event->iface;
 
-			sys_slist_remove(&event_callbacks, prev, &cb->node);
+			sys_slist_remove(bucket, prev, &cb->node);
 
 			k_sem_give(cb->sync_call);
 		} else {
@@ -220,18 +276,55 @@ static inline void mgmt_run_callbacks(struct mgmt_event_entry *mgmt_event)
 #endif
 }
 
+#ifdef CONFIG_NET_MGMT_EVENT_DIRECT
+static void mgmt_run_direct_callbacks(uint32_t mgmt_event,
+				      struct net_if *iface,
+				      void *info, size_t length)
+{
+	struct net_mgmt_event_callback *cb, *tmp;
+
+#ifndef CONFIG_NET_MGMT_EVENT_INFO
+	ARG_UNUSED(info);
+	ARG_UNUSED(length);
+#endif /* CONFIG_NET_MGMT_EVENT_INFO */
+
+	k_mutex_lock(&direct_lock, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(
+		&direct_callbacks[MGMT_CB_HASH(mgmt_event)], cb, tmp, node) {
+		if (!mgmt_cb_matches(cb, mgmt_event)) {
+			continue;
+		}
+
+#ifdef CONFIG_NET_MGMT_EVENT_INFO
+		if (info && length) {
+			cb->info = info;
+			cb->info_length = length;
+		} else {
+			cb->info = NULL;
+			cb->info_length = 0;
+		}
+#endif /* CONFIG_NET_MGMT_EVENT_INFO */
+
+		NET_DBG("Running direct callback %p : %p", cb, cb->handler);
+
+		cb->handler(cb, mgmt_event, iface);
+	}
+
+	k_mutex_unlock(&direct_lock);
+}
+#endif /* CONFIG_NET_MGMT_EVENT_DIRECT */
+
 static void mgmt_thread(void)
 {
-	struct mgmt_event_entry *mgmt_event;
+	static struct mgmt_event_entry mgmt_event;
 
 	while (1) {
 		k_sem_take(&network_event, K_FOREVER);
-		k_sem_take(&net_mgmt_lock, K_FOREVER);
 
 		NET_DBG("Handling events, forwarding it relevantly");
 
-		mgmt_event = mgmt_pop_event();
-		if (!mgmt_event) {
+		if (!mgmt_pop_event(&mgmt_event)) {
 			/* System is over-loaded?
 			 * At this point we have most probably notified
 			 * more events than we could handle
@@ -239,15 +332,12 @@ static void mgmt_thread(void)
 			NET_DBG("Some event got probably lost (%u)",
 				k_sem_count_get(&network_event));
 
-			k_sem_init(&network_event, 0, UINT_MAX);
-			k_sem_give(&net_mgmt_lock);
-
 			continue;
 		}
 
-		mgmt_run_callbacks(mgmt_event);
+		k_sem_take(&net_mgmt_lock, K_FOREVER);
 
-		mgmt_clean_event(mgmt_event);
+		mgmt_run_callbacks(&mgmt_event);
 
 		k_sem_give(&net_mgmt_lock);
 
@@ -314,37 +404,94 @@ void net_mgmt_add_event_callback(struct net_mgmt_event_callback *cb)
 
 	k_sem_take(&net_mgmt_lock, K_FOREVER);
 
-	sys_slist_prepend(&event_callbacks, &cb->node);
+	sys_slist_prepend(&event_callbacks[MGMT_CB_HASH(cb->event_mask)],
+			  &cb->node);
 
-	mgmt_add_event_mask(cb->event_mask);
+	mgmt_add_event_mask(&global_event_mask, cb->event_mask);
 
 	k_sem_give(&net_mgmt_lock);
 }
 
+static bool mgmt_remove_callback(sys_slist_t *callbacks,
+				 struct net_mgmt_event_callback *cb)
+{
+	int i;
+
+	/* The command part of the mask may have been changed since the
+	 * callback was added, but the layer and layer code may not.
+	 * Still, look in every bucket: this is not a hot path.
+	 */
+	for (i = 0; i < MGMT_CB_BUCKETS; i++) {
+		if (sys_slist_find_and_remove(&callbacks[i], &cb->node)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 void net_mgmt_del_event_callback(struct net_mgmt_event_callback *cb)
 {
 	NET_DBG("Deleting event callback %p", cb);
 
+#ifdef CONFIG_NET_MGMT_EVENT_DIRECT
+	k_mutex_lock(&direct_lock, K_FOREVER);
+
+	if (mgmt_remove_callback(direct_callbacks, cb)) {
+		mgmt_rebuild_event_mask(&direct_event_mask, direct_callbacks);
+		k_mutex_unlock(&direct_lock);
+
+		return;
+	}
+
+	k_mutex_unlock(&direct_lock);
+#endif /* CONFIG_NET_MGMT_EVENT_DIRECT */
+
 	k_sem_take(&net_mgmt_lock, K_FOREVER);
 
-	sys_slist_find_and_remove(&event_callbacks, &cb->node);
+	mgmt_remove_callback(event_callbacks, cb);
 
-	mgmt_rebuild_global_event_mask();
+	mgmt_rebuild_event_mask(&global_event_mask, event_callbacks);
 
 	k_sem_give(&net_mgmt_lock);
 }
 
+#ifdef CONFIG_NET_MGMT_EVENT_DIRECT
+void net_mgmt_add_event_callback_direct(struct net_mgmt_event_callback *cb)
+{
+	NET_ASSERT(!NET_MGMT_EVENT_SYNCHRONOUS(cb->event_mask));
+
+	NET_DBG("Adding direct event callback %p", cb);
+
+	k_mutex_lock(&direct_lock, K_FOREVER);
+
+	sys_slist_prepend(&direct_callbacks[MGMT_CB_HASH(cb->event_mask)],
+			  &cb->node);
+
+	mgmt_add_event_mask(&direct_event_mask, cb->event_mask);
+
+	k_mutex_unlock(&direct_lock);
+}
+#endif /* CONFIG_NET_MGMT_EVENT_DIRECT */
+
 void net_mgmt_event_notify_with_info(uint32_t mgmt_event, struct net_if *iface,
 				     void *info, size_t length)
 {
-	if (mgmt_is_event_handled(mgmt_event)) {
+#ifdef CONFIG_NET_MGMT_EVENT_DIRECT
+	if (mgmt_is_event_handled(direct_event_mask, mgmt_event)) {
+		mgmt_run_direct_callbacks(mgmt_event, iface, info, length);
+	}
+#endif /* CONFIG_NET_MGMT_EVENT_DIRECT */
+
+	if (mgmt_is_event_handled(global_event_mask, mgmt_event)) {
 		NET_DBG("Notifying Event layer %u code %u type %u",
 			NET_MGMT_GET_LAYER(mgmt_event),
 			NET_MGMT_GET_LAYER_CODE(mgmt_event),
 			NET_MGMT_GET_COMMAND(mgmt_event));
 
-		mgmt_push_event(mgmt_event, iface, info, length);
-		k_sem_give(&network_event);
+		if (mgmt_push_event(mgmt_event, iface, info, length)) {
+			k_sem_give(&network_event);
+		}
 	}
 }
 
@@ -377,11 +524,19 @@ int net_mgmt_event_wait_on_iface(struct net_if *iface,
 
 void net_mgmt_event_init(void)
 {
-	sys_slist_init(&event_callbacks);
+	int i;
+
+	for (i = 0; i < MGMT_CB_BUCKETS; i++) {
+		sys_slist_init(&event_callbacks[i]);
+#ifdef CONFIG_NET_MGMT_EVENT_DIRECT
+		sys_slist_init(&direct_callbacks[i]);
+#endif
+	}
+
 	global_event_mask = 0U;
 
-	in_event = -1;
-	out_event = -1;
+	out_event = 0U;
+	pending_events = 0U;
 
 	(void)memset(events, 0, CONFIG_NET_MGMT_EVENT_QUEUE_SIZE *
 			sizeof(struct mgmt_event_entry));
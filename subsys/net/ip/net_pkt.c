@@ -30,6 +30,7 @@ LOG_MODULE_REGISTER(net_pkt, CONFIG_NET_PKT_LOG_LEVEL);
 #include <sys/types.h>
 
 #include <sys/util.h>
+#include <sys/byteorder.h>
 
 #include <net/net_core.h>
 #include <net/net_ip.h>
@@ -1545,6 +1546,26 @@ static void pkt_cursor_update(struct net_pkt *pkt,
 	}
 }
 
+/* Amount of data that can be read, or written, from the cursor position
+ * without crossing into the next fragment.
+ */
+static inline size_t pkt_cursor_contiguous_len(struct net_pkt *pkt,
+					       bool write)
+{
+	struct net_pkt_cursor *cursor = &pkt->cursor;
+	size_t len;
+
+	pkt_cursor_advance(pkt, write);
+
+	if (!cursor->buf || !cursor->pos) {
+		return 0;
+	}
+
+	len = write ? cursor->buf->size : cursor->buf->len;
+
+	return len - (cursor->pos - cursor->buf->data);
+}
+
 /* Internal function that does all operation (skip/read/write/memset) */
 static int net_pkt_cursor_operate(struct net_pkt *pkt,
 				  void *data, size_t length,
@@ -1625,6 +1646,14 @@ int net_pkt_read(struct net_pkt *pkt, void *data, size_t length)
 {
 	NET_DBG("pkt %p data %p length %zu", pkt, data, length);
 
+	/* Fast path: the whole range lies in the current fragment */
+	if (length && pkt_cursor_contiguous_len(pkt, false) >= length) {
+		memcpy(data, pkt->cursor.pos, length);
+		pkt_cursor_update(pkt, length, false);
+
+		return 0;
+	}
+
 	return net_pkt_cursor_operate(pkt, data, length, true, false);
 }
 
@@ -1633,6 +1662,13 @@ int net_pkt_read_be16(struct net_pkt *pkt, uint16_t *data)
 	uint8_t d16[2];
 	int ret;
 
+	if (pkt_cursor_contiguous_len(pkt, false) >= sizeof(uint16_t)) {
+		*data = sys_get_be16(pkt->cursor.pos);
+		pkt_cursor_update(pkt, sizeof(uint16_t), false);
+
+		return 0;
+	}
+
 	ret = net_pkt_read(pkt, d16, sizeof(uint16_t));
 
 	*data = d16[0] << 8 | d16[1];
@@ -1645,6 +1681,13 @@ int net_pkt_read_le16(struct net_pkt *pkt, uint16_t *data)
 	uint8_t d16[2];
 	int ret;
 
+	if (pkt_cursor_contiguous_len(pkt, false) >= sizeof(uint16_t)) {
+		*data = sys_get_le16(pkt->cursor.pos);
+		pkt_cursor_update(pkt, sizeof(uint16_t), false);
+
+		return 0;
+	}
+
 	ret = net_pkt_read(pkt, d16, sizeof(uint16_t));
 
 	*data = d16[1] << 8 | d16[0];
@@ -1657,6 +1700,13 @@ int net_pkt_read_be32(struct net_pkt *pkt, uint32_t *data)
 	uint8_t d32[4];
 	int ret;
 
+	if (pkt_cursor_contiguous_len(pkt, false) >= sizeof(uint32_t)) {
+		*data = sys_get_be32(pkt->cursor.pos);
+		pkt_cursor_update(pkt, sizeof(uint32_t), false);
+
+		return 0;
+	}
+
 	ret = net_pkt_read(pkt, d32, sizeof(uint32_t));
 
 	*data = d32[0] << 24 | d32[1] << 16 | d32[2] << 8 | d32[3];
@@ -1666,21 +1716,109 @@ int net_pkt_read_be32(struct net_pkt *pkt, uint32_t *data)
 
 int net_pkt_write(struct net_pkt *pkt, const void *data, size_t length)
 {
+	bool ow = net_pkt_is_being_overwritten(pkt);
+
 	NET_DBG("pkt %p data %p length %zu", pkt, data, length);
 
-	if (data == pkt->cursor.pos && net_pkt_is_contiguous(pkt, length)) {
-		return net_pkt_skip(pkt, length);
+	if (!length || pkt_cursor_contiguous_len(pkt, !ow) < length) {
+		return net_pkt_cursor_operate(pkt, (void *)data, length,
+					      true, true);
+	}
+
+	/* Fast path: the whole range lies in the current fragment. Data
+	 * that is already in place, as handed out by net_pkt_get_data(),
+	 * is only skipped.
+	 */
+	if (data != pkt->cursor.pos) {
+		memcpy(pkt->cursor.pos, data, length);
 	}
 
-	return net_pkt_cursor_operate(pkt, (void *)data, length, true, true);
+	if (!ow) {
+		net_buf_add(pkt->cursor.buf, length);
+	}
+
+	pkt_cursor_update(pkt, length, true);
+
+	return 0;
 }
 
-int net_pkt_copy(struct net_pkt *pkt_dst,
-		 struct net_pkt *pkt_src,
-		 size_t length)
+int net_pkt_write_from(struct net_pkt *pkt, net_context_fill_cb_t fill,
+		       void *user_data, size_t length)
+{
+	struct net_pkt_cursor *c_op = &pkt->cursor;
+	bool ow = net_pkt_is_being_overwritten(pkt);
+	size_t d_len;
+	int ret;
+
+	NET_DBG("pkt %p fill %p length %zu", pkt, fill, length);
+
+	/* As net_pkt_cursor_operate() writes, the callback doing the copy */
+	while (c_op->buf && length) {
+		pkt_cursor_advance(pkt, !ow);
+		if (c_op->buf == NULL) {
+			break;
+		}
+
+		if (ow) {
+			d_len = c_op->buf->len - (c_op->pos - c_op->buf->data);
+		} else {
+			d_len = c_op->buf->size - (c_op->pos - c_op->buf->data);
+		}
+
+		if (!d_len) {
+			break;
+		}
+
+		d_len = MIN(d_len, length);
+
+		ret = fill(c_op->pos, d_len, user_data);
+		if (ret < 0) {
+			return ret;
+		}
+
+		if (!ow) {
+			net_buf_add(c_op->buf, d_len);
+		}
+
+		pkt_cursor_update(pkt, d_len, true);
+
+		length -= d_len;
+	}
+
+	if (length) {
+		NET_DBG("Still some length to go %zu", length);
+		return -ENOBUFS;
+	}
+
+	return 0;
+}
+
+/* Checksum of data copied in chunks, the chunks starting at an odd offset
+ * from the beginning of the data having their bytes swapped.
+ */
+static inline uint16_t pkt_chksum_add(uint16_t sum, const uint8_t *data,
+				      size_t len, bool odd)
+{
+	uint16_t tmp = net_calc_chksum_data(0U, data, len);
+
+	if (odd) {
+		tmp = (tmp << 8) | (tmp >> 8);
+	}
+
+	sum += tmp;
+	if (sum < tmp) {
+		sum++;
+	}
+
+	return sum;
+}
+
+static int pkt_copy(struct net_pkt *pkt_dst, struct net_pkt *pkt_src,
+		    size_t length, uint16_t *sum)
 {
 	struct net_pkt_cursor *c_dst = &pkt_dst->cursor;
 	struct net_pkt_cursor *c_src = &pkt_src->cursor;
+	bool odd = false;
 
 	while (c_dst->buf && c_src->buf && length) {
 		size_t s_len, d_len, len;
@@ -1710,6 +1848,11 @@ int net_pkt_copy(struct net_pkt *pkt_dst,
 
 		memcpy(c_dst->pos, c_src->pos, len);
 
+		if (sum) {
+			*sum = pkt_chksum_add(*sum, c_dst->pos, len, odd);
+			odd ^= len & 1U;
+		}
+
 		if (!net_pkt_is_being_overwritten(pkt_dst)) {
 			net_buf_add(c_dst->buf, len);
 		}
@@ -1728,6 +1871,20 @@ int net_pkt_copy(struct net_pkt *pkt_dst,
 	return 0;
 }
 
+int net_pkt_copy(struct net_pkt *pkt_dst,
+		 struct net_pkt *pkt_src,
+		 size_t length)
+{
+	return pkt_copy(pkt_dst, pkt_src, length, NULL);
+}
+
+int net_pkt_copy_chksum(struct net_pkt *pkt_dst,
+			struct net_pkt *pkt_src,
+			size_t length, uint16_t *sum)
+{
+	return pkt_copy(pkt_dst, pkt_src, length, sum);
+}
+
 static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 {
 	net_pkt_set_family(clone_pkt, net_pkt_family(pkt));
@@ -1737,6 +1894,8 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_timestamp(clone_pkt, net_pkt_timestamp(pkt));
 	net_pkt_set_priority(clone_pkt, net_pkt_priority(pkt));
 	net_pkt_set_orig_iface(clone_pkt, net_pkt_orig_iface(pkt));
+	net_pkt_set_chksum_state(clone_pkt, net_pkt_chksum_state(pkt));
+	net_pkt_set_tso_mss(clone_pkt, net_pkt_tso_mss(pkt));
 
 	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
 		net_pkt_set_ipv4_ttl(clone_pkt, net_pkt_ipv4_ttl(pkt));
@@ -1956,20 +2115,10 @@ uint16_t net_pkt_get_current_offset(struct net_pkt *pkt)
 
 bool net_pkt_is_contiguous(struct net_pkt *pkt, size_t size)
 {
-	pkt_cursor_advance(pkt, !net_pkt_is_being_overwritten(pkt));
+	size_t len = pkt_cursor_contiguous_len(pkt,
+					!net_pkt_is_being_overwritten(pkt));
 
-	if (pkt->cursor.buf && pkt->cursor.pos) {
-		size_t len;
-
-		len = net_pkt_is_being_overwritten(pkt) ?
-			pkt->cursor.buf->len : pkt->cursor.buf->size;
-		len -= pkt->cursor.pos - pkt->cursor.buf->data;
-		if (len >= size) {
-			return true;
-		}
-	}
-
-	return false;
+	return len && len >= size;
 }
 
 void *net_pkt_get_data(struct net_pkt *pkt,
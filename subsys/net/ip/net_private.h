@@ -77,6 +77,7 @@ static inline enum net_verdict net_ipv6_input(struct net_pkt *pkt,
 }
 #endif
 extern bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt);
+extern bool net_tc_tx_queue_is_empty(uint8_t tc);
 extern void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt);
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
 
@@ -149,6 +150,12 @@ extern char *net_sprint_ll_addr_buf(const uint8_t *ll, uint8_t ll_len,
 				    char *buf, int buflen);
 extern uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto);
 
+/* Add the 16-bit ones' complement sum of len bytes of data, taken as
+ * starting at an even offset, to sum.
+ */
+extern uint16_t net_calc_chksum_data(uint16_t sum, const uint8_t *data,
+				     size_t len);
+
 /**
  * @brief Deliver the incoming packet through the recv_cb of the net_context
  *        to the upper layers
@@ -199,6 +206,44 @@ static inline uint16_t net_calc_chksum_tcp(struct net_pkt *pkt)
 	return net_calc_chksum(pkt, IPPROTO_TCP);
 }
 
+/* Whether the IPv4, UDP and TCP checksums of an outgoing packet have to be
+ * computed in software. If the interface offloads them instead, the packet
+ * is marked as having its checksums pending.
+ */
+static inline bool net_pkt_need_calc_tx_checksum(struct net_pkt *pkt)
+{
+	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
+		return true;
+	}
+
+	net_pkt_set_chksum_state(pkt, NET_PKT_CHKSUM_PENDING);
+
+	return false;
+}
+
+/* Whether a checksum of an incoming packet has to be verified in software,
+ * l4 tells if this is the UDP or TCP checksum rather than the IPv4 header
+ * one. Drivers either verify all packets, as told by the interface
+ * capabilities, or mark the ones the hardware could check.
+ */
+static inline bool net_pkt_need_calc_rx_checksum(struct net_pkt *pkt, bool l4)
+{
+	switch (net_pkt_chksum_state(pkt)) {
+	case NET_PKT_CHKSUM_VERIFIED:
+		return false;
+	case NET_PKT_CHKSUM_IP_VERIFIED:
+		if (!l4) {
+			return false;
+		}
+
+		break;
+	default:
+		break;
+	}
+
+	return net_if_need_calc_rx_checksum(net_pkt_iface(pkt));
+}
+
 static inline char *net_sprint_ll_addr(const uint8_t *ll, uint8_t ll_len)
 {
 	static char buf[sizeof("xx:xx:xx:xx:xx:xx:xx:xx")];
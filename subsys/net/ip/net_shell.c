@@ -36,6 +36,10 @@ LOG_MODULE_REGISTER(net_shell, LOG_LEVEL_DBG);
 #include "tcp_internal.h"
 #endif
 
+#if defined(CONFIG_NET_TCP2)
+#include "tcp2.h"
+#endif
+
 #include "ipv6.h"
 
 #if defined(CONFIG_NET_ARP)
@@ -248,6 +252,7 @@ static struct ethernet_capabilities eth_hw_caps[] = {
 	EC(ETHERNET_PROMISC_MODE,         "Promiscuous mode"),
 	EC(ETHERNET_PRIORITY_QUEUES,      "Priority queues"),
 	EC(ETHERNET_HW_FILTERING,         "MAC address filtering"),
+	EC(ETHERNET_HW_TX_TSO,            "TCP segmentation offload"),
 };
 
 static void print_supported_ethernet_capabilities(
@@ -1018,6 +1023,63 @@ static void print_tc_rx_stats(const struct shell *shell, struct net_if *iface)
 #endif /* NET_TC_RX_COUNT > 1 */
 }
 
+#if defined(CONFIG_NET_PKT_TXTIME_STATS_HISTOGRAM) || \
+	defined(CONFIG_NET_PKT_RXTIME_STATS_HISTOGRAM)
+static void print_time_hist(const struct shell *shell, const char *dir,
+			    const struct net_stats_time_hist *hist)
+{
+	int i;
+
+	PR("%s time histogram:\n", dir);
+
+	for (i = 0; i < NET_STATS_TIME_HIST_BUCKETS; i++) {
+		if (hist->bucket[i] == 0) {
+			continue;
+		}
+
+		if (i == NET_STATS_TIME_HIST_BUCKETS - 1) {
+			PR("\t>= %u us\t%u\n", (uint32_t)BIT(i - 1),
+			   hist->bucket[i]);
+		} else {
+			PR("\t< %u us\t%u\n", (uint32_t)BIT(i),
+			   hist->bucket[i]);
+		}
+	}
+}
+#endif
+
+static void print_time_hist_stats(const struct shell *shell,
+				  struct net_if *iface)
+{
+#if defined(CONFIG_NET_PKT_RXTIME_STATS_HISTOGRAM) && \
+	defined(CONFIG_NET_PKT_RXTIME_STATS_DETAIL)
+	/* Time spent before reaching each point recording an RX tick */
+	static const char * const rx_stages[] = {
+		"RX driver", "RX TC queue", "RX L2", "RX IP", "RX conn",
+		"RX context", "RX socket queue",
+	};
+	int i;
+
+	BUILD_ASSERT(ARRAY_SIZE(rx_stages) == NET_PKT_DETAIL_STATS_COUNT);
+#endif
+
+#if defined(CONFIG_NET_PKT_TXTIME_STATS_HISTOGRAM)
+	print_time_hist(shell, "TX", GET_STAT_ADDR(iface, tx_time_hist));
+#endif
+#if defined(CONFIG_NET_PKT_RXTIME_STATS_HISTOGRAM)
+	print_time_hist(shell, "RX", GET_STAT_ADDR(iface, rx_time_hist));
+
+#if defined(CONFIG_NET_PKT_RXTIME_STATS_DETAIL)
+	for (i = 0; i < NET_PKT_DETAIL_STATS_COUNT; i++) {
+		print_time_hist(shell, rx_stages[i],
+				GET_STAT_ADDR(iface, rx_time_detail_hist[i]));
+	}
+#endif
+#endif
+	ARG_UNUSED(shell);
+	ARG_UNUSED(iface);
+}
+
 static void print_net_pm_stats(const struct shell *shell, struct net_if *iface)
 {
 #if defined(CONFIG_NET_STATISTICS_POWER_MANAGEMENT)
@@ -1053,6 +1115,8 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 		PR("=================\n");
 	}
 
+	net_stats_collect(iface);
+
 #if defined(CONFIG_NET_STATISTICS_IPV6) && defined(CONFIG_NET_NATIVE_IPV6)
 	PR("IPv6 recv      %d\tsent\t%d\tdrop\t%d\tforwarded\t%d\n",
 	   GET_STAT(iface, ipv6.recv),
@@ -1144,6 +1208,7 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 
 	print_tc_tx_stats(shell, iface);
 	print_tc_rx_stats(shell, iface);
+	print_time_hist_stats(shell, iface);
 
 #if defined(CONFIG_NET_STATISTICS_ETHERNET) && \
 					defined(CONFIG_NET_STATISTICS_USER_API)
@@ -1315,6 +1380,32 @@ static void conn_handler_cb(struct net_conn *conn, void *user_data)
 }
 #endif /* CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG */
 
+#if defined(CONFIG_NET_TCP2) && \
+	(defined(CONFIG_NET_OFFLOAD) || defined(CONFIG_NET_NATIVE))
+static void tcp2_cb(struct net_tcp_info *info, void *user_data)
+{
+	struct net_shell_user_data *data = user_data;
+	const struct shell *shell = data->shell;
+	int *count = data->user_data;
+
+	PR("%p   %5u    %5u %10u %10u %5u   %s\n",
+	   info->context,
+	   ntohs(net_sin6_ptr(&info->context->local)->sin6_port),
+	   ntohs(net_sin6(&info->context->remote)->sin6_port),
+	   info->seq, info->ack, info->mss, info->state);
+	PR("           cc %s cwnd %u ssthresh %u send-win %u\n",
+	   info->cc ? info->cc : "none", info->cwnd, info->ssthresh,
+	   info->send_win);
+	PR("           srtt %d rttvar %d rto %d ms\n",
+	   info->srtt, info->rttvar, info->rto);
+	PR("           rexmit %u fast-rexmit %u timeouts %u dup-acks %u\n",
+	   info->rexmits, info->fast_rexmits, info->timeouts,
+	   info->dup_acks);
+
+	(*count)++;
+}
+#endif
+
 #if defined(CONFIG_NET_TCP1) && \
 	(defined(CONFIG_NET_OFFLOAD) || defined(CONFIG_NET_NATIVE))
 static void tcp_cb(struct net_tcp *tcp, void *user_data)
@@ -1651,6 +1742,19 @@ static int cmd_net_conn(const struct shell *shell, size_t argc, char *argv[])
 
 #endif
 
+#if defined(CONFIG_NET_TCP2)
+	PR("\nContext    Src port Dst port   Send-Seq   Send-Ack  MSS    State"
+	   "\n");
+
+	count = 0;
+
+	net_tcp_info_foreach(tcp2_cb, &user_data);
+
+	if (count == 0) {
+		PR("No TCP connections\n");
+	}
+#endif
+
 #if defined(CONFIG_NET_IPV6_FRAGMENT)
 	count = 0;
 
@@ -1767,8 +1871,86 @@ static void print_dns_info(const struct shell *shell,
 		}
 	}
 }
+
+static void dns_cache_cb(const char *name, enum dns_query_type type,
+			 enum dns_resolve_status status,
+			 const struct sockaddr *addrs, int count,
+			 uint32_t ttl, void *user_data)
+{
+	struct net_shell_user_data *data = user_data;
+	const struct shell *shell = data->shell;
+	int *entries = data->user_data;
+	char addr[NET_IPV6_ADDR_LEN];
+	int i;
+
+	PR("%s %s ttl %u%s
+", name,
+	   type == DNS_QUERY_TYPE_AAAA ? "AAAA" : "A", ttl,
+	   status == DNS_EAI_ALLDONE ? "" : " (negative)");
+
+	for (i = 0; i < count; i++) {
+		if (addrs[i].sa_family == AF_INET) {
+			net_addr_ntop(AF_INET, &net_sin(&addrs[i])->sin_addr,
+				      addr, sizeof(addr));
+		} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+			   addrs[i].sa_family == AF_INET6) {
+			net_addr_ntop(AF_INET6,
+				      &net_sin6(&addrs[i])->sin6_addr,
+				      addr, sizeof(addr));
+		} else {
+			continue;
+		}
+
+		PR("\t%s\n", addr);
+	}
+
+	(*entries)++;
+}
 #endif
 
+static int cmd_net_dns_cache(const struct shell *shell, size_t argc,
+			     char *argv[])
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	struct net_shell_user_data user_data;
+	int count = 0;
+
+	user_data.shell = shell;
+	user_data.user_data = &count;
+
+	dns_cache_foreach(dns_cache_cb, &user_data);
+
+	if (count == 0) {
+		PR("DNS cache is empty.\n");
+	}
+#else
+	PR_INFO("Set %s to enable %s support.\n", "CONFIG_DNS_RESOLVER_CACHE",
+		"DNS cache");
+#endif
+
+	return 0;
+}
+
+static int cmd_net_dns_flush(const struct shell *shell, size_t argc,
+			     char *argv[])
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	PR("Flushing DNS cache.\n");
+	dns_cache_flush();
+#else
+	PR_INFO("Set %s to enable %s support.\n", "CONFIG_DNS_RESOLVER_CACHE",
+		"DNS cache");
+#endif
+
+	return 0;
+}
+
 static int cmd_net_dns_cancel(const struct shell *shell, size_t argc,
 			      char *argv[])
 {
@@ -2132,6 +2314,22 @@ static const char *selected_role_str(int port)
 	return "<unknown>";
 }
 
+#if defined(CONFIG_NET_GPTP_STATISTICS)
+static void gptp_print_stat_var(const struct shell *shell, const char *name,
+				const struct gptp_stat_var *stat)
+{
+	PR("%s (%u samples)\n", name, stat->count);
+
+	if (stat->count == 0U) {
+		return;
+	}
+
+	PR("\tmean %lld ns, variance %llu ns^2, min %lld ns, max %lld ns\n",
+	   (long long)stat->mean, (unsigned long long)gptp_stat_var_get(stat),
+	   (long long)stat->min, (long long)stat->max);
+}
+#endif /* CONFIG_NET_GPTP_STATISTICS */
+
 static void gptp_print_port_info(const struct shell *shell, int port)
 {
 	struct gptp_port_bmca_data *port_bmca_data;
@@ -2393,6 +2591,9 @@ static void gptp_print_port_info(const struct shell *shell, int port)
 	   "messages", "sent", port_param_ds->tx_pdelay_resp_fup_count);
 	PR("Announce %s %s                 : %u\n",
 	   "messages", "sent", port_param_ds->tx_announce_count);
+	gptp_print_stat_var(shell, "Offset from master",
+			    &port_param_ds->offset);
+	gptp_print_stat_var(shell, "Path delay", &port_param_ds->path_delay);
 #endif /* CONFIG_NET_GPTP_STATISTICS */
 }
 #endif /* CONFIG_NET_GPTP */
@@ -4456,8 +4657,12 @@ SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_arp,
 );
 
 SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_dns,
+	SHELL_CMD(cache, NULL, "Print cached DNS answers.",
+		  cmd_net_dns_cache),
 	SHELL_CMD(cancel, NULL, "Cancel all pending requests.",
 		  cmd_net_dns_cancel),
+	SHELL_CMD(flush, NULL, "Remove all entries from DNS cache.",
+		  cmd_net_dns_flush),
 	SHELL_CMD(query, NULL,
 		  "'net dns <hostname> [A or AAAA]' queries IPv4 address "
 		  "(default) or IPv6 address for a host name.",
@@ -29,6 +29,152 @@ LOG_MODULE_REGISTER(net_stats, NET_LOG_LEVEL);
  */
 struct net_stats net_stats = { 0 };
 
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+struct net_stats_cpu net_stats_cpu[CONFIG_MP_NUM_CPUS];
+
+static struct k_spinlock collect_lock;
+
+/* Add the counters of src to dst, or set them to the ones of src when
+ * reset is true. Values which are set rather than counted (traffic class
+ * priorities, power management) are only kept in the shared statistics
+ * and are left alone.
+ */
+#define FOLD(dst, src) ((dst) = (reset ? 0 : (dst)) + (src))
+
+static void fold_counters(net_stats_t *dst, const net_stats_t *src,
+			  size_t len, bool reset)
+{
+	size_t i;
+
+	for (i = 0; i < len / sizeof(net_stats_t); i++) {
+		FOLD(dst[i], src[i]);
+	}
+}
+
+#define FOLD_COUNTERS(dst, src, field)					\
+	fold_counters((net_stats_t *)&(dst)->field,			\
+		      (const net_stats_t *)&(src)->field,		\
+		      sizeof((dst)->field), reset)
+
+#define FOLD_TIME(dst, src)						\
+	do {								\
+		FOLD((dst).sum, (src).sum);				\
+		FOLD((dst).count, (src).count);				\
+	} while (0)
+
+static void stats_fold(struct net_stats *dst, const struct net_stats *src,
+		       bool reset)
+{
+	int i;
+
+	FOLD(dst->processing_error, src->processing_error);
+	FOLD_COUNTERS(dst, src, bytes);
+	FOLD_COUNTERS(dst, src, ip_errors);
+#if defined(CONFIG_NET_STATISTICS_IPV6)
+	FOLD_COUNTERS(dst, src, ipv6);
+#endif
+#if defined(CONFIG_NET_STATISTICS_IPV4)
+	FOLD_COUNTERS(dst, src, ipv4);
+#endif
+#if defined(CONFIG_NET_STATISTICS_ICMP)
+	FOLD_COUNTERS(dst, src, icmp);
+#endif
+#if defined(CONFIG_NET_STATISTICS_TCP)
+	FOLD_COUNTERS(dst, src, tcp);
+#endif
+#if defined(CONFIG_NET_STATISTICS_UDP)
+	FOLD_COUNTERS(dst, src, udp);
+#endif
+#if defined(CONFIG_NET_STATISTICS_IPV6_ND)
+	FOLD_COUNTERS(dst, src, ipv6_nd);
+#endif
+#if defined(CONFIG_NET_STATISTICS_MLD)
+	FOLD_COUNTERS(dst, src, ipv6_mld);
+#endif
+
+#if NET_TC_COUNT > 1
+	for (i = 0; i < NET_TC_TX_COUNT; i++) {
+		FOLD(dst->tc.sent[i].pkts, src->tc.sent[i].pkts);
+		FOLD(dst->tc.sent[i].bytes, src->tc.sent[i].bytes);
+		FOLD_TIME(dst->tc.sent[i].tx_time, src->tc.sent[i].tx_time);
+#if defined(CONFIG_NET_PKT_TXTIME_STATS_DETAIL)
+		for (int j = 0; j < NET_PKT_DETAIL_STATS_COUNT; j++) {
+			FOLD_TIME(dst->tc.sent[i].tx_time_detail[j],
+				  src->tc.sent[i].tx_time_detail[j]);
+		}
+#endif
+	}
+
+	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+		FOLD(dst->tc.recv[i].pkts, src->tc.recv[i].pkts);
+		FOLD(dst->tc.recv[i].bytes, src->tc.recv[i].bytes);
+		FOLD_TIME(dst->tc.recv[i].rx_time, src->tc.recv[i].rx_time);
+#if defined(CONFIG_NET_PKT_RXTIME_STATS_DETAIL)
+		for (int j = 0; j < NET_PKT_DETAIL_STATS_COUNT; j++) {
+			FOLD_TIME(dst->tc.recv[i].rx_time_detail[j],
+				  src->tc.recv[i].rx_time_detail[j]);
+		}
+#endif
+	}
+#endif /* NET_TC_COUNT > 1 */
+
+#if defined(CONFIG_NET_CONTEXT_TIMESTAMP) || \
+	defined(CONFIG_NET_PKT_TXTIME_STATS)
+	FOLD_TIME(dst->tx_time, src->tx_time);
+#if defined(CONFIG_NET_PKT_TXTIME_STATS_DETAIL)
+	for (i = 0; i < NET_PKT_DETAIL_STATS_COUNT; i++) {
+		FOLD_TIME(dst->tx_time_detail[i], src->tx_time_detail[i]);
+	}
+#endif
+#endif
+#if defined(CONFIG_NET_PKT_TXTIME_STATS_HISTOGRAM)
+	FOLD_COUNTERS(dst, src, tx_time_hist);
+#endif
+
+#if defined(CONFIG_NET_PKT_RXTIME_STATS)
+	FOLD_TIME(dst->rx_time, src->rx_time);
+#if defined(CONFIG_NET_PKT_RXTIME_STATS_DETAIL)
+	for (i = 0; i < NET_PKT_DETAIL_STATS_COUNT; i++) {
+		FOLD_TIME(dst->rx_time_detail[i], src->rx_time_detail[i]);
+	}
+#endif
+#endif
+#if defined(CONFIG_NET_PKT_RXTIME_STATS_HISTOGRAM)
+	FOLD_COUNTERS(dst, src, rx_time_hist);
+#if defined(CONFIG_NET_PKT_RXTIME_STATS_DETAIL)
+	FOLD_COUNTERS(dst, src, rx_time_detail_hist);
+#endif
+#endif
+
+	ARG_UNUSED(i);
+}
+
+static void stats_collect(struct net_stats *total,
+			  const struct net_stats_cpu *cpu)
+{
+	k_spinlock_key_t key = k_spin_lock(&collect_lock);
+	int i;
+
+	for (i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		stats_fold(total, &cpu[i].stats, i == 0);
+	}
+
+	k_spin_unlock(&collect_lock, key);
+}
+
+void net_stats_collect(struct net_if *iface)
+{
+#if defined(CONFIG_NET_STATISTICS_PER_INTERFACE)
+	if (iface) {
+		stats_collect(&iface->stats, iface->stats_cpu);
+		return;
+	}
+#endif
+
+	stats_collect(&net_stats, net_stats_cpu);
+}
+#endif /* CONFIG_NET_STATISTICS_PER_CPU */
+
 #if defined(CONFIG_NET_STATISTICS_PERIODIC_OUTPUT)
 
 #define PRINT_STATISTICS_INTERVAL (30 * MSEC_PER_SEC)
@@ -72,6 +218,8 @@ static inline void stats(struct net_if *iface)
 	int i;
 
 	if (!next_print || (abs(cmp) > PRINT_STATISTICS_INTERVAL)) {
+		net_stats_collect(iface);
+
 		if (iface) {
 			NET_INFO("Interface %p [%d]", iface,
 				 net_if_get_by_iface(iface));
@@ -240,6 +388,8 @@ static int net_stats_get(uint32_t mgmt_request, struct net_if *iface,
 	size_t len_chk = 0;
 	void *src = NULL;
 
+	net_stats_collect(iface);
+
 	switch (NET_MGMT_GET_COMMAND(mgmt_request)) {
 	case NET_REQUEST_STATS_CMD_GET_ALL:
 		len_chk = sizeof(struct net_stats);
@@ -372,4 +522,7 @@ void net_stats_reset(struct net_if *iface)
 
 	net_if_stats_reset_all();
 	memset(&net_stats, 0, sizeof(net_stats));
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+	memset(net_stats_cpu, 0, sizeof(net_stats_cpu));
+#endif
 }
@@ -27,10 +27,36 @@ extern struct net_stats net_stats;
 #define GET_STAT_ADDR(iface, s) (&GET_STAT(iface, s))
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+extern struct net_stats_cpu net_stats_cpu[CONFIG_MP_NUM_CPUS];
+
+/* The counters are updated in the copy of the current CPU and only end up
+ * in net_stats and iface->stats when net_stats_collect() is called. A
+ * thread migrating to another CPU in the middle of an update can lose
+ * that update, just like two unlocked updates of a shared counter can.
+ */
+#define STAT_CPU (arch_curr_cpu()->id)
+#define UPDATE_STAT_GLOBAL(cmd) (net_stats_cpu[STAT_CPU].cmd)
+#define UPDATE_STAT_IFACE(_iface, _cmd) \
+	SET_STAT(_iface->stats_cpu[STAT_CPU]._cmd)
+
+void net_stats_collect(struct net_if *iface);
+#else
 #define UPDATE_STAT_GLOBAL(cmd) (net_##cmd)
+#define UPDATE_STAT_IFACE(_iface, _cmd) SET_STAT(_iface->_cmd)
+
+#define net_stats_collect(iface)
+#endif /* CONFIG_NET_STATISTICS_PER_CPU */
+
 #define UPDATE_STAT(_iface, _cmd) \
 	{ NET_ASSERT(_iface); (UPDATE_STAT_GLOBAL(_cmd)); \
-	  SET_STAT(_iface->_cmd); }
+	  UPDATE_STAT_IFACE(_iface, _cmd); }
+
+/* Values which are set rather than counted always live in the shared
+ * statistics.
+ */
+#define UPDATE_STAT_SHARED(_iface, _cmd) \
+	{ NET_ASSERT(_iface); (net_##_cmd); SET_STAT(_iface->_cmd); }
 /* Core stats */
 
 static inline void net_stats_update_processing_error(struct net_if *iface)
@@ -65,6 +91,7 @@ static inline void net_stats_update_bytes_sent(struct net_if *iface,
 #define net_stats_update_ip_errors_vhlerr(iface)
 #define net_stats_update_bytes_recv(iface, bytes)
 #define net_stats_update_bytes_sent(iface, bytes)
+#define net_stats_collect(iface)
 #endif /* CONFIG_NET_STATISTICS */
 
 #if defined(CONFIG_NET_STATISTICS_IPV6) && defined(CONFIG_NET_NATIVE_IPV6)
@@ -318,6 +345,15 @@ static inline void net_stats_update_ipv6_mld_drop(struct net_if *iface)
 #define net_stats_update_ipv6_mld_drop(iface)
 #endif /* CONFIG_NET_STATISTICS_MLD */
 
+#if defined(CONFIG_NET_PKT_TXTIME_STATS_HISTOGRAM) || \
+	defined(CONFIG_NET_PKT_RXTIME_STATS_HISTOGRAM)
+static inline int net_stats_time_hist_bucket(uint64_t us)
+{
+	return MIN(find_msb_set((uint32_t)MIN(us, UINT32_MAX)),
+		   NET_STATS_TIME_HIST_BUCKETS - 1);
+}
+#endif
+
 #if (defined(CONFIG_NET_CONTEXT_TIMESTAMP) || \
 	defined(CONFIG_NET_PKT_TXTIME_STATS)) && defined(CONFIG_NET_STATISTICS)
 static inline void net_stats_update_tx_time(struct net_if *iface,
@@ -325,10 +361,14 @@ static inline void net_stats_update_tx_time(struct net_if *iface,
 					    uint32_t end_time)
 {
 	uint32_t diff = end_time - start_time;
+	uint64_t us = k_cyc_to_ns_floor64(diff) / 1000;
 
-	UPDATE_STAT(iface, stats.tx_time.sum +=
-		    k_cyc_to_ns_floor64(diff) / 1000);
+	UPDATE_STAT(iface, stats.tx_time.sum += us);
 	UPDATE_STAT(iface, stats.tx_time.count += 1);
+#if defined(CONFIG_NET_PKT_TXTIME_STATS_HISTOGRAM)
+	UPDATE_STAT(iface,
+		    stats.tx_time_hist.bucket[net_stats_time_hist_bucket(us)]++);
+#endif
 }
 #else
 #define net_stats_update_tx_time(iface, start_time, end_time)
@@ -358,10 +398,14 @@ static inline void net_stats_update_rx_time(struct net_if *iface,
 					    uint32_t end_time)
 {
 	uint32_t diff = end_time - start_time;
+	uint64_t us = k_cyc_to_ns_floor64(diff) / 1000;
 
-	UPDATE_STAT(iface, stats.rx_time.sum +=
-		    k_cyc_to_ns_floor64(diff) / 1000);
+	UPDATE_STAT(iface, stats.rx_time.sum += us);
 	UPDATE_STAT(iface, stats.rx_time.count += 1);
+#if defined(CONFIG_NET_PKT_RXTIME_STATS_HISTOGRAM)
+	UPDATE_STAT(iface,
+		    stats.rx_time_hist.bucket[net_stats_time_hist_bucket(us)]++);
+#endif
 }
 #else
 #define net_stats_update_rx_time(iface, start_time, end_time)
@@ -374,11 +418,15 @@ static inline void net_stats_update_rx_time_detail(struct net_if *iface,
 	int i;
 
 	for (i = 0; i < NET_PKT_DETAIL_STATS_COUNT; i++) {
-		UPDATE_STAT(iface,
-			    stats.rx_time_detail[i].sum +=
-			    k_cyc_to_ns_floor64(detail_stat[i]) / 1000);
+		uint64_t us = k_cyc_to_ns_floor64(detail_stat[i]) / 1000;
+
+		UPDATE_STAT(iface, stats.rx_time_detail[i].sum += us);
 		UPDATE_STAT(iface,
 			    stats.rx_time_detail[i].count += 1);
+#if defined(CONFIG_NET_PKT_RXTIME_STATS_HISTOGRAM)
+		UPDATE_STAT(iface, stats.rx_time_detail_hist[i].bucket[
+				    net_stats_time_hist_bucket(us)]++);
+#endif
 	}
 }
 #else
@@ -401,7 +449,7 @@ static inline void net_stats_update_tc_sent_bytes(struct net_if *iface,
 static inline void net_stats_update_tc_sent_priority(struct net_if *iface,
 						     uint8_t tc, uint8_t priority)
 {
-	UPDATE_STAT(iface, stats.tc.sent[tc].priority = priority);
+	UPDATE_STAT_SHARED(iface, stats.tc.sent[tc].priority = priority);
 }
 
 #if (defined(CONFIG_NET_CONTEXT_TIMESTAMP) || \
@@ -503,7 +551,7 @@ static inline void net_stats_update_tc_recv_bytes(struct net_if *iface,
 static inline void net_stats_update_tc_recv_priority(struct net_if *iface,
 						     uint8_t tc, uint8_t priority)
 {
-	UPDATE_STAT(iface, stats.tc.recv[tc].priority = priority);
+	UPDATE_STAT_SHARED(iface, stats.tc.recv[tc].priority = priority);
 }
 #else
 #define net_stats_update_tc_sent_pkt(iface, tc)
@@ -576,7 +624,7 @@ static inline void net_stats_update_tc_rx_time_detail(struct net_if *iface,
 static inline void net_stats_add_suspend_start_time(struct net_if *iface,
 						    uint32_t time)
 {
-	UPDATE_STAT(iface, stats.pm.start_time = time);
+	UPDATE_STAT_SHARED(iface, stats.pm.start_time = time);
 }
 
 static inline void net_stats_add_suspend_end_time(struct net_if *iface,
@@ -585,10 +633,10 @@ static inline void net_stats_add_suspend_end_time(struct net_if *iface,
 	uint32_t diff_time =
 		k_cyc_to_ms_floor32(time - GET_STAT(iface, pm.start_time));
 
-	UPDATE_STAT(iface, stats.pm.start_time = 0);
-	UPDATE_STAT(iface, stats.pm.last_suspend_time = diff_time);
-	UPDATE_STAT(iface, stats.pm.suspend_count++);
-	UPDATE_STAT(iface, stats.pm.overall_suspend_time += diff_time);
+	UPDATE_STAT_SHARED(iface, stats.pm.start_time = 0);
+	UPDATE_STAT_SHARED(iface, stats.pm.last_suspend_time = diff_time);
+	UPDATE_STAT_SHARED(iface, stats.pm.suspend_count++);
+	UPDATE_STAT_SHARED(iface, stats.pm.overall_suspend_time += diff_time);
 }
 #else
 #define net_stats_add_suspend_start_time(iface, time)
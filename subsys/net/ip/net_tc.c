@@ -13,6 +13,8 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include <net/net_core.h>
 #include <net/net_pkt.h>
 #include <net/net_stats.h>
+#include <net/ethernet.h>
+#include <sys/byteorder.h>
 
 #include "net_private.h"
 #include "net_stats.h"
@@ -29,6 +31,137 @@ K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT,
 static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
 
+#if defined(CONFIG_NET_RX_FLOW_STEERING)
+#define RX_FLOW_EXTRA_QUEUES (CONFIG_NET_RX_FLOW_QUEUES - 1)
+
+/* The first flow queue is the work queue of the best effort traffic class,
+ * these are the additional ones.
+ */
+K_KERNEL_STACK_ARRAY_DEFINE(rx_flow_stack, RX_FLOW_EXTRA_QUEUES,
+			    CONFIG_NET_RX_STACK_SIZE);
+
+static struct k_work_q rx_flow_queues[RX_FLOW_EXTRA_QUEUES];
+static uint8_t rx_flow_tc;
+
+static uint32_t rx_flow_mix(uint32_t hash, uint32_t value)
+{
+	return (hash ^ value) * 0x01000193U;
+}
+
+/* Compute a hash of the addresses, protocol and ports of a received IP
+ * packet, or of its addresses and protocol for fragments and protocols
+ * without ports. Returns 0 if the packet cannot be parsed from its first
+ * fragment, in which case it goes to the regular queue.
+ */
+static uint32_t rx_flow_hash(struct net_pkt *pkt)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+	const uint8_t *hdr = pkt->frags->data;
+	size_t len = pkt->frags->len;
+	uint32_t hash = 0x811c9dc5U;
+	bool has_ports = true;
+	size_t ip_len;
+	uint8_t proto;
+	int i;
+
+	if (false) {
+#if defined(CONFIG_NET_L2_ETHERNET)
+	} else if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		uint16_t type;
+
+		if (len < sizeof(struct net_eth_hdr)) {
+			return 0;
+		}
+
+		type = ntohs(((struct net_eth_hdr *)hdr)->type);
+		hdr += sizeof(struct net_eth_hdr);
+		len -= sizeof(struct net_eth_hdr);
+
+		if (type == NET_ETH_PTYPE_VLAN) {
+			if (len < 4) {
+				return 0;
+			}
+
+			type = sys_get_be16(hdr + 2);
+			hdr += 4;
+			len -= 4;
+		}
+
+		if (type != NET_ETH_PTYPE_IP && type != NET_ETH_PTYPE_IPV6) {
+			return 0;
+		}
+#endif
+#if defined(CONFIG_NET_L2_DUMMY)
+	} else if (net_if_l2(iface) == &NET_L2_GET_NAME(DUMMY)) {
+		/* Dummy L2 packets start with the IP header */
+#endif
+	} else {
+		return 0;
+	}
+
+	if (len == 0) {
+		return 0;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && (hdr[0] >> 4) == 4) {
+		if (len < sizeof(struct net_ipv4_hdr)) {
+			return 0;
+		}
+
+		ip_len = (hdr[0] & 0x0f) * 4U;
+		proto = hdr[9];
+		hash = rx_flow_mix(hash, sys_get_be32(hdr + 12));
+		hash = rx_flow_mix(hash, sys_get_be32(hdr + 16));
+
+		/* Later fragments have no ports, keep all of them together */
+		if (sys_get_be16(hdr + 6) & 0x3fff) {
+			has_ports = false;
+		}
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && (hdr[0] >> 4) == 6) {
+		if (len < sizeof(struct net_ipv6_hdr)) {
+			return 0;
+		}
+
+		ip_len = sizeof(struct net_ipv6_hdr);
+		proto = hdr[6];
+		for (i = 8; i < 40; i += 4) {
+			hash = rx_flow_mix(hash, sys_get_be32(hdr + i));
+		}
+	} else {
+		return 0;
+	}
+
+	hash = rx_flow_mix(hash, proto);
+
+	if (has_ports && (proto == IPPROTO_TCP || proto == IPPROTO_UDP) &&
+	    len >= ip_len + 4) {
+		hash = rx_flow_mix(hash, sys_get_be32(hdr + ip_len));
+	}
+
+	/* Final avalanche so that the low bits depend on all the input */
+	hash ^= hash >> 16;
+	hash *= 0x85ebca6bU;
+	hash ^= hash >> 13;
+
+	return hash;
+}
+
+static struct k_work_q *rx_flow_queue(struct net_pkt *pkt,
+				      struct k_work_q *queue)
+{
+	uint32_t hash = net_pkt_rx_hash(pkt);
+	uint32_t idx;
+
+	if (hash == 0U) {
+		hash = rx_flow_hash(pkt);
+	}
+
+	idx = hash % CONFIG_NET_RX_FLOW_QUEUES;
+
+	return idx == 0U ? queue : &rx_flow_queues[idx - 1];
+}
+#endif /* CONFIG_NET_RX_FLOW_STEERING */
+
 bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt)
 {
 	if (k_work_pending(net_pkt_work(pkt))) {
@@ -42,11 +175,26 @@ bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt)
 	return true;
 }
 
+#if defined(CONFIG_NET_TX_BATCH)
+bool net_tc_tx_queue_is_empty(uint8_t tc)
+{
+	return k_queue_is_empty(&tx_classes[tc].work_q.queue);
+}
+#endif
+
 void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 {
+	struct k_work_q *queue = &rx_classes[tc].work_q;
+
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
-	k_work_submit_to_queue(&rx_classes[tc].work_q, net_pkt_work(pkt));
+#if defined(CONFIG_NET_RX_FLOW_STEERING)
+	if (tc == rx_flow_tc) {
+		queue = rx_flow_queue(pkt, queue);
+	}
+#endif
+
+	k_work_submit_to_queue(queue, net_pkt_work(pkt));
 }
 
 int net_tx_priority2tc(enum net_priority prio)
@@ -260,6 +408,10 @@ void net_tc_rx_init(void)
 	net_if_foreach(net_tc_rx_stats_priority_setup, NULL);
 #endif
 
+#if defined(CONFIG_NET_RX_FLOW_STEERING)
+	rx_flow_tc = net_rx_priority2tc(NET_PRIORITY_BE);
+#endif
+
 	for (i = 0; i < NET_TC_RX_COUNT; i++) {
 		uint8_t thread_priority;
 
@@ -272,10 +424,38 @@ void net_tc_rx_init(void)
 			K_KERNEL_STACK_SIZEOF(rx_stack[i]),
 			thread_priority, K_PRIO_COOP(thread_priority));
 
+#if defined(CONFIG_NET_RX_FLOW_STEERING)
+		if (i == rx_flow_tc) {
+			k_work_q_start_pinned(&rx_classes[i].work_q,
+					      rx_stack[i],
+					      K_KERNEL_STACK_SIZEOF(rx_stack[i]),
+					      K_PRIO_COOP(thread_priority), 0);
+			k_thread_name_set(&rx_classes[i].work_q.thread,
+					  "rx_workq");
+			continue;
+		}
+#endif
+
 		k_work_q_start(&rx_classes[i].work_q,
 			       rx_stack[i],
 			       K_KERNEL_STACK_SIZEOF(rx_stack[i]),
 			       K_PRIO_COOP(thread_priority));
 		k_thread_name_set(&rx_classes[i].work_q.thread, "rx_workq");
 	}
+
+#if defined(CONFIG_NET_RX_FLOW_STEERING)
+	/* Flow queues run at the priority of the best effort class, each
+	 * one on its own CPU when possible.
+	 */
+	for (i = 0; i < RX_FLOW_EXTRA_QUEUES; i++) {
+		NET_DBG("[%d] Starting RX flow queue %p", i + 1,
+			&rx_flow_queues[i].queue);
+
+		k_work_q_start_pinned(&rx_flow_queues[i], rx_flow_stack[i],
+				      K_KERNEL_STACK_SIZEOF(rx_flow_stack[i]),
+				      K_PRIO_COOP(rx_classes[rx_flow_tc].tc),
+				      i + 1);
+		k_thread_name_set(&rx_flow_queues[i].thread, "rx_flow_workq");
+	}
+#endif
 }
@@ -36,7 +36,7 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 /* We keep track of the routes in a separate list so that we can remove
  * the oldest routes (at tail) if needed.
  */
-static sys_slist_t routes;
+static sys_dlist_t routes = SYS_DLIST_STATIC_INIT(&routes);
 
 static void net_route_nexthop_remove(struct net_nbr *nbr)
 {
@@ -253,45 +253,319 @@ static int nbr_nexthop_put(struct net_nbr *nbr)
 /* Route was accessed, so place it in front of the routes list */
 static inline void update_route_access(struct net_route_entry *route)
 {
-	sys_slist_find_and_remove(&routes, &route->node);
-	sys_slist_prepend(&routes, &route->node);
+	sys_dlist_remove(&route->node);
+	sys_dlist_prepend(&routes, &route->node);
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct in6_addr *dst)
+/*
+ * The routes are indexed by a path-compressed binary trie keyed on their
+ * prefix, so that a lookup only visits the nodes along the bits of the
+ * destination address. A node either holds the routes having exactly its
+ * prefix, or is a branching node with two children. As each route adds at
+ * most one node holding routes and one branching node, the node pool does
+ * not need to be larger than twice the number of routes.
+ */
+struct route_trie_node {
+	/** Node in the list of free nodes, unused otherwise. */
+	sys_snode_t node;
+
+	struct route_trie_node *parent;
+	struct route_trie_node *child[2];
+
+	/** Routes of this prefix, one per network interface. */
+	sys_slist_t routes;
+
+	struct in6_addr prefix;
+	uint8_t len;
+};
+
+static struct route_trie_node route_trie_nodes[2 * CONFIG_NET_MAX_ROUTES];
+static struct route_trie_node *route_trie_root;
+static sys_slist_t route_trie_free;
+
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+/* Results of recent lookups, flushed on any change of the routing table. */
+struct route_cache_entry {
+	struct net_if *iface;
+	struct net_route_entry *route;
+	struct in6_addr dst;
+};
+
+static struct route_cache_entry route_cache[CONFIG_NET_ROUTE_CACHE_SIZE];
+static uint8_t route_cache_next;
+
+static struct net_route_entry *route_cache_get(struct net_if *iface,
+					       struct in6_addr *dst)
 {
-	struct net_route_entry *route, *found = NULL;
-	uint8_t longest_match = 0U;
 	int i;
 
-	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
-		struct net_nbr *nbr = get_nbr(i);
+	for (i = 0; i < ARRAY_SIZE(route_cache); i++) {
+		if (route_cache[i].route && route_cache[i].iface == iface &&
+		    net_ipv6_addr_cmp(&route_cache[i].dst, dst)) {
+			return route_cache[i].route;
+		}
+	}
 
-		if (!nbr->ref) {
-			continue;
+	return NULL;
+}
+
+static void route_cache_put(struct net_if *iface, struct in6_addr *dst,
+			    struct net_route_entry *route)
+{
+	struct route_cache_entry *entry = &route_cache[route_cache_next];
+
+	entry->iface = iface;
+	entry->route = route;
+	net_ipaddr_copy(&entry->dst, dst);
+
+	route_cache_next = (route_cache_next + 1) % ARRAY_SIZE(route_cache);
+}
+
+static void route_cache_flush(void)
+{
+	(void)memset(route_cache, 0, sizeof(route_cache));
+}
+#else
+#define route_cache_get(iface, dst) NULL
+#define route_cache_put(iface, dst, route)
+#define route_cache_flush()
+#endif /* CONFIG_NET_ROUTE_CACHE_SIZE > 0 */
+
+static inline int prefix_bit(const struct in6_addr *addr, uint8_t pos)
+{
+	return (addr->s6_addr[pos / 8] >> (7 - pos % 8)) & 1;
+}
+
+/* Number of leading bits, at most max, that both addresses share */
+static uint8_t prefix_common_len(const struct in6_addr *a,
+				 const struct in6_addr *b, uint8_t max)
+{
+	uint8_t len = 0U;
+	int i;
+
+	for (i = 0; i < sizeof(struct in6_addr) && len < max; i++) {
+		uint8_t diff = a->s6_addr[i] ^ b->s6_addr[i];
+
+		if (diff) {
+			len += __builtin_clz(diff) - (32 - 8);
+			break;
 		}
 
-		if (iface && nbr->iface != iface) {
-			continue;
+		len += 8U;
+	}
+
+	return MIN(len, max);
+}
+
+static struct route_trie_node *route_trie_node_alloc(struct in6_addr *prefix,
+						     uint8_t len)
+{
+	struct route_trie_node *node;
+	sys_snode_t *free_node;
+
+	free_node = sys_slist_get(&route_trie_free);
+
+	/* Cannot run out, see the pool size above */
+	NET_ASSERT(free_node, "No free route trie node");
+
+	node = CONTAINER_OF(free_node, struct route_trie_node, node);
+
+	(void)memset(node, 0, sizeof(*node));
+	net_ipaddr_copy(&node->prefix, prefix);
+	node->len = len;
+
+	return node;
+}
+
+static void route_trie_node_free(struct route_trie_node *node)
+{
+	sys_slist_prepend(&route_trie_free, &node->node);
+}
+
+/* Where the parent of a node (or the root) points to it */
+static struct route_trie_node **route_trie_link(struct route_trie_node *node)
+{
+	struct route_trie_node *parent = node->parent;
+
+	if (!parent) {
+		return &route_trie_root;
+	}
+
+	return &parent->child[parent->child[1] == node];
+}
+
+static void route_trie_set_child(struct route_trie_node *parent,
+				 struct route_trie_node *child)
+{
+	parent->child[prefix_bit(&child->prefix, parent->len)] = child;
+	child->parent = parent;
+}
+
+static void route_trie_insert(struct net_route_entry *route)
+{
+	struct route_trie_node *parent = NULL;
+	struct route_trie_node **link = &route_trie_root;
+	struct route_trie_node *node, *new_node;
+	uint8_t len = route->prefix_len;
+	uint8_t common = 0U;
+
+	while ((node = *link) != NULL) {
+		common = prefix_common_len(&route->addr, &node->prefix,
+					   MIN(len, node->len));
+		if (common < node->len) {
+			break;
 		}
 
-		route = net_route_data(nbr);
+		if (node->len == len) {
+			sys_slist_prepend(&node->routes, &route->trie_node);
+			return;
+		}
 
-		if (route->prefix_len >= longest_match &&
-		    net_ipv6_is_prefix(dst->s6_addr,
-				       route->addr.s6_addr,
-				       route->prefix_len)) {
-			found = route;
-			longest_match = route->prefix_len;
+		parent = node;
+		link = &node->child[prefix_bit(&route->addr, node->len)];
+	}
+
+	new_node = route_trie_node_alloc(&route->addr, len);
+	sys_slist_prepend(&new_node->routes, &route->trie_node);
+
+	if (node && common == len) {
+		/* The new prefix covers the one of the node */
+		route_trie_set_child(new_node, node);
+	} else if (node) {
+		/* The prefixes diverge, branch where they do */
+		struct route_trie_node *branch;
+
+		branch = route_trie_node_alloc(&route->addr, common);
+		route_trie_set_child(branch, node);
+		route_trie_set_child(branch, new_node);
+		new_node = branch;
+	}
+
+	*link = new_node;
+	new_node->parent = parent;
+}
+
+/* Remove a node without routes if it has less than two children */
+static void route_trie_prune(struct route_trie_node *node)
+{
+	while (node && sys_slist_is_empty(&node->routes) &&
+	       !(node->child[0] && node->child[1])) {
+		struct route_trie_node *child = node->child[0] ?
+						node->child[0] : node->child[1];
+		struct route_trie_node *parent = node->parent;
+
+		*route_trie_link(node) = child;
+		if (child) {
+			child->parent = parent;
+		}
+
+		route_trie_node_free(node);
+
+		/* Only a parent which lost a child may need pruning */
+		node = child ? NULL : parent;
+	}
+}
+
+/* Node of exactly the given prefix, if any */
+static struct route_trie_node *route_trie_find(struct in6_addr *prefix,
+					       uint8_t len)
+{
+	struct route_trie_node *node = route_trie_root;
+
+	while (node && node->len <= len &&
+	       prefix_common_len(prefix, &node->prefix,
+				 node->len) == node->len) {
+		if (node->len == len) {
+			return node;
 		}
+
+		node = node->child[prefix_bit(prefix, node->len)];
+	}
+
+	return NULL;
+}
+
+static void route_trie_remove(struct net_route_entry *route)
+{
+	struct route_trie_node *node;
+
+	node = route_trie_find(&route->addr, route->prefix_len);
+
+	if (!node || !sys_slist_find_and_remove(&node->routes,
+						&route->trie_node)) {
+		return;
+	}
+
+	route_trie_prune(node);
+}
+
+static struct net_route_entry *route_trie_node_get(struct route_trie_node *node,
+						   struct net_if *iface)
+{
+	struct net_route_entry *route;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&node->routes, route, trie_node) {
+		if (!iface || route->iface == iface) {
+			return route;
+		}
+	}
+
+	return NULL;
+}
+
+/* Route towards exactly the given prefix, if any */
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *addr,
+					  uint8_t prefix_len)
+{
+	struct route_trie_node *node = route_trie_find(addr, prefix_len);
+
+	if (!node) {
+		return NULL;
 	}
 
+	return route_trie_node_get(node, iface);
+}
+
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct net_route_entry *route, *found;
+	struct route_trie_node *node = route_trie_root;
+
+	found = route_cache_get(iface, dst);
 	if (found) {
-		net_route_info("Found", found, dst);
+		goto out;
+	}
 
-		update_route_access(found);
+	/* Longest prefix match: the deepest matching node with a route
+	 * on the interface.
+	 */
+	while (node && prefix_common_len(dst, &node->prefix,
+					 node->len) == node->len) {
+		route = route_trie_node_get(node, iface);
+		if (route) {
+			found = route;
+		}
+
+		if (node->len == 128U) {
+			break;
+		}
+
+		node = node->child[prefix_bit(dst, node->len)];
 	}
 
+	if (!found) {
+		return NULL;
+	}
+
+	route_cache_put(iface, dst, found);
+
+out:
+	net_route_info("Found", found, dst);
+
+	update_route_access(found);
+
 	return found;
 }
 
@@ -333,7 +607,7 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 		log_strdup(net_sprint_ll_addr(nexthop_lladdr->addr,
 					      nexthop_lladdr->len)));
 
-	route = net_route_lookup(iface, addr);
+	route = route_find(iface, addr, prefix_len);
 	if (route) {
 		/* Update nexthop if not the same */
 		struct in6_addr *nexthop_addr;
@@ -353,9 +627,7 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	nbr = nbr_new(iface, addr, prefix_len);
 	if (!nbr) {
 		/* Remove the oldest route and try again */
-		sys_snode_t *last = sys_slist_peek_tail(&routes);
-
-		sys_slist_find_and_remove(&routes, last);
+		sys_dnode_t *last = sys_dlist_peek_tail(&routes);
 
 		route = CONTAINER_OF(last,
 				     struct net_route_entry,
@@ -401,7 +673,10 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	route = net_route_data(nbr);
 	route->iface = iface;
 
-	sys_slist_prepend(&routes, &route->node);
+	sys_dlist_prepend(&routes, &route->node);
+
+	route_trie_insert(route);
+	route_cache_flush();
 
 	tmp = nbr_nexthop_get(iface, nexthop);
 
@@ -454,13 +729,18 @@ int net_route_del(struct net_route_entry *route)
 	net_mgmt_event_notify(NET_EVENT_IPV6_ROUTE_DEL, route->iface);
 #endif
 
-	sys_slist_find_and_remove(&routes, &route->node);
-
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
 		return -ENOENT;
 	}
 
+	if (sys_dnode_is_linked(&route->node)) {
+		sys_dlist_remove(&route->node);
+	}
+
+	route_trie_remove(route);
+	route_cache_flush();
+
 	net_route_info("Deleted", route, &route->addr);
 
 	SYS_SLIST_FOR_EACH_CONTAINER(&route->nexthop, nexthop_route, node) {
@@ -910,6 +1190,12 @@ int net_route_packet_if(struct net_pkt *pkt, struct net_if *iface)
 
 void net_route_init(void)
 {
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(route_trie_nodes); i++) {
+		route_trie_node_free(&route_trie_nodes[i]);
+	}
+
 	NET_DBG("Allocated %d routing entries (%zu bytes)",
 		CONFIG_NET_MAX_ROUTES, sizeof(net_route_entries_pool));
 
@@ -20,6 +20,7 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #include "connection.h"
 #include "net_stats.h"
 #include "net_private.h"
+#include "tcp2.h"
 #include "tcp2_priv.h"
 
 static int tcp_rto = CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
@@ -32,6 +33,7 @@ static K_MEM_SLAB_DEFINE(tcp_conns_slab, sizeof(struct tcp),
 				CONFIG_NET_MAX_CONTEXTS, 4);
 
 static void tcp_in(struct tcp *conn, struct net_pkt *pkt);
+static void tcp_ooo_flush(struct tcp *conn);
 
 int (*tcp_send_cb)(struct net_pkt *pkt) = NULL;
 size_t (*tcp_recv_cb)(struct tcp *conn, struct net_pkt *pkt) = NULL;
@@ -319,6 +321,8 @@ static int tcp_conn_unref(struct tcp *conn)
 
 	tcp_send_queue_flush(conn);
 
+	tcp_ooo_flush(conn);
+
 	if (k_delayed_work_remaining_get(&conn->send_data_timer)) {
 		k_delayed_work_cancel(&conn->send_data_timer);
 	}
@@ -326,6 +330,8 @@ static int tcp_conn_unref(struct tcp *conn)
 
 	k_delayed_work_cancel(&conn->timewait_timer);
 
+	k_delayed_work_cancel(&conn->ack_timer);
+
 	sys_slist_find_and_remove(&tcp_conns, (sys_snode_t *)conn);
 
 	memset(conn, 0, sizeof(*conn));
@@ -471,18 +477,25 @@ static uint8_t *tcp_options_get(struct net_pkt *pkt, int tcp_options_len,
 }
 
 static bool tcp_options_check(struct tcp_options *recv_options,
-			      struct net_pkt *pkt, ssize_t len)
+			      struct net_pkt *pkt, ssize_t len, uint8_t flags)
 {
-	uint8_t options_buf[40]; /* TCP header max options size is 40 */
+	uint8_t options_buf[TCP_OPTIONS_MAX_LEN];
 	bool result = len > 0 && ((len % 4) == 0) ? true : false;
 	uint8_t *options = tcp_options_get(pkt, len, options_buf,
 					   sizeof(options_buf));
 	uint8_t opt, opt_len;
+	int i;
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
+	/* MSS, window scale and SACK permitted are only valid on a SYN and
+	 * stay in effect for the lifetime of the connection.
+	 */
+	if (flags & SYN) {
+		recv_options->mss_found = false;
+		recv_options->wnd_found = false;
+		recv_options->sack_perm_found = false;
+	}
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -526,9 +539,49 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
-			recv_options->window = opt;
+			recv_options->window = options[2];
 			recv_options->wnd_found = true;
 			break;
+		case TCPOPT_SACK_PERM:
+			if (opt_len != TCPOPT_SACK_PERM_LEN) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm_found = true;
+			break;
+		case TCPOPT_SACK:
+			if (opt_len < 2 + TCPOPT_SACK_BLOCK_LEN ||
+			    (opt_len - 2) % TCPOPT_SACK_BLOCK_LEN) {
+				result = false;
+				goto end;
+			}
+
+			for (i = 0; i < (opt_len - 2) / TCPOPT_SACK_BLOCK_LEN &&
+				     i < TCP_SACK_BLOCKS_MAX; i++) {
+				uint8_t *block = options + 2 +
+					i * TCPOPT_SACK_BLOCK_LEN;
+
+				recv_options->sack[i].left = ntohl(
+					UNALIGNED_GET((uint32_t *)block));
+				recv_options->sack[i].right = ntohl(
+					UNALIGNED_GET((uint32_t *)(block + 4)));
+			}
+
+			recv_options->sack_count = i;
+			break;
+		case TCPOPT_TIMESTAMP:
+			if (opt_len != TCPOPT_TIMESTAMP_LEN) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->tsval =
+				ntohl(UNALIGNED_GET((uint32_t *)(options + 2)));
+			recv_options->tsecr =
+				ntohl(UNALIGNED_GET((uint32_t *)(options + 6)));
+			recv_options->ts_found = true;
+			break;
 		default:
 			continue;
 		}
@@ -589,11 +642,126 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+/* Write the SACK option describing the out-of-order queue, the block
+ * holding the most recently received segment goes first (RFC 2018, 4).
+ */
+static size_t tcp_sack_blocks_put(struct tcp *conn, uint8_t *buf,
+				  size_t max_blocks)
+{
+	struct tcp_sack_block blocks[TCP_SACK_QUEUE_LEN + 1];
+	struct tcp_sack_block first;
+	struct net_pkt *pkt;
+	size_t count = 0, i, len = 0;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&conn->ooo_queue, pkt, next) {
+		uint32_t left = th_seq(th_get(pkt));
+		uint32_t right = left + tcp_data_len(pkt);
+
+		if (count && blocks[count - 1].right == left) {
+			blocks[count - 1].right = right;
+			continue;
+		}
+
+		blocks[count].left = left;
+		blocks[count].right = right;
+		count++;
+	}
+
+	for (i = 0; i < count; i++) {
+		if (net_tcp_seq_cmp(conn->ooo_last, blocks[i].left) >= 0 &&
+		    net_tcp_seq_cmp(conn->ooo_last, blocks[i].right) < 0) {
+			first = blocks[i];
+			blocks[i] = blocks[0];
+			blocks[0] = first;
+			break;
+		}
+	}
+
+	count = MIN(count, max_blocks);
+	if (!count) {
+		return 0;
+	}
+
+	buf[len++] = TCPOPT_NOP;
+	buf[len++] = TCPOPT_NOP;
+	buf[len++] = TCPOPT_SACK;
+	buf[len++] = 2 + count * TCPOPT_SACK_BLOCK_LEN;
+
+	for (i = 0; i < count; i++) {
+		UNALIGNED_PUT(htonl(blocks[i].left), (uint32_t *)(buf + len));
+		UNALIGNED_PUT(htonl(blocks[i].right),
+			      (uint32_t *)(buf + len + 4));
+		len += TCPOPT_SACK_BLOCK_LEN;
+	}
+
+	return len;
+}
+
+/* Build the TCP options of an outgoing segment into buf, return their
+ * length. A SYN offers every enabled option, a SYN-ACK only the ones the
+ * peer has offered, and later segments carry what has been negotiated.
+ */
+static size_t tcp_options_build(struct tcp *conn, uint8_t flags, uint8_t *buf)
+{
+	bool syn = flags & SYN, active = syn && !(flags & ACK);
+	bool ts = active ? IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS) :
+		conn_ts_ok(conn);
+	bool sack_perm = syn && (active ? IS_ENABLED(CONFIG_NET_TCP_SACK) :
+				 conn_sack_ok(conn));
+	bool wscale = syn && (active ?
+			      IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) :
+			      conn_wscale_ok(conn));
+	size_t len = 0;
+
+	if (ts) {
+		if (sack_perm) {
+			buf[len++] = TCPOPT_SACK_PERM;
+			buf[len++] = TCPOPT_SACK_PERM_LEN;
+			sack_perm = false;
+		} else {
+			buf[len++] = TCPOPT_NOP;
+			buf[len++] = TCPOPT_NOP;
+		}
+
+		buf[len++] = TCPOPT_TIMESTAMP;
+		buf[len++] = TCPOPT_TIMESTAMP_LEN;
+		UNALIGNED_PUT(htonl(k_uptime_get_32()),
+			      (uint32_t *)(buf + len));
+		UNALIGNED_PUT(htonl(conn->ts_recent),
+			      (uint32_t *)(buf + len + 4));
+		len += 8;
+	}
+
+	if (sack_perm) {
+		buf[len++] = TCPOPT_NOP;
+		buf[len++] = TCPOPT_NOP;
+		buf[len++] = TCPOPT_SACK_PERM;
+		buf[len++] = TCPOPT_SACK_PERM_LEN;
+	}
+
+	if (wscale) {
+		buf[len++] = TCPOPT_NOP;
+		buf[len++] = TCPOPT_WINDOW;
+		buf[len++] = TCPOPT_WINDOW_LEN;
+		buf[len++] = TCP_WSCALE_SHIFT;
+	}
+
+	if (!syn && (flags & ACK) && conn_sack_ok(conn) &&
+	    !sys_slist_is_empty(&conn->ooo_queue)) {
+		len += tcp_sack_blocks_put(conn, buf + len,
+					   (TCP_OPTIONS_MAX_LEN - len - 4) /
+					   TCPOPT_SACK_BLOCK_LEN);
+	}
+
+	return len;
+}
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, uint8_t *options, size_t options_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
+	int ret;
 
 	th = (struct tcphdr *)net_pkt_get_data(pkt, &tcp_access);
 	if (!th) {
@@ -605,16 +773,23 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 	th->th_sport = conn->src.sin.sin_port;
 	th->th_dport = conn->dst.sin.sin_port;
 
-	th->th_off = 5;
+	th->th_off = 5 + options_len / 4;
 	th->th_flags = flags;
-	th->th_win = htons(conn->recv_win);
+	/* The window of a SYN is never scaled (RFC 7323, 2.2) */
+	th->th_win = htons(flags & SYN ? conn->recv_win :
+			   conn->recv_win >> conn->rcv_wscale);
 	th->th_seq = htonl(seq);
 
 	if (ACK & flags) {
 		th->th_ack = htonl(conn->ack);
 	}
 
-	return net_pkt_set_data(pkt, &tcp_access);
+	ret = net_pkt_set_data(pkt, &tcp_access);
+	if (ret < 0 || !options_len) {
+		return ret;
+	}
+
+	return net_pkt_write(pkt, options, options_len);
 }
 
 static int ip_header_add(struct tcp *conn, struct net_pkt *pkt)
@@ -637,15 +812,22 @@ static int ip_header_add(struct tcp *conn, struct net_pkt *pkt)
 static void tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 			uint32_t seq)
 {
+	uint8_t options[TCP_OPTIONS_MAX_LEN];
+	size_t options_len = tcp_options_build(conn, flags, options);
 	struct net_pkt *pkt;
 	int ret;
 
-	pkt = tcp_pkt_alloc(conn, sizeof(struct tcphdr));
+	pkt = tcp_pkt_alloc(conn, sizeof(struct tcphdr) + options_len);
 	if (!pkt) {
 		goto out;
 	}
 
 	if (data) {
+		/* More than a segment of data is split by the hardware */
+		if (net_pkt_get_len(data) > conn_smss(conn)) {
+			net_pkt_set_tso_mss(pkt, conn_smss(conn));
+		}
+
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
 		data->buffer = NULL;
@@ -658,7 +840,7 @@ static void tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, options, options_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
@@ -672,6 +854,13 @@ static void tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 
 	NET_DBG("%s", log_strdup(tcp_th(pkt)));
 
+	if (flags & ACK) {
+		/* Any outgoing segment carries the pending ACK */
+		conn->ack_pending = 0;
+		conn->ack_pending_len = 0;
+		k_delayed_work_cancel(&conn->ack_timer);
+	}
+
 	if (tcp_send_cb) {
 		tcp_send_cb(pkt);
 		goto out;
@@ -721,9 +910,19 @@ static void tcp_pkt_peek(struct net_pkt *to, struct net_pkt *from, size_t pos,
 	net_pkt_copy(to, from, len);
 }
 
+/* The window we may fill: the peer's receive window limited by cwnd */
+static uint32_t tcp_send_win(struct tcp *conn)
+{
+	if (conn->cc) {
+		return MIN(conn->send_win, conn->cwnd);
+	}
+
+	return conn->send_win;
+}
+
 static bool tcp_window_full(struct tcp *conn)
 {
-	bool window_full = !(conn->unacked_len < conn->send_win);
+	bool window_full = !((uint32_t)conn->unacked_len < tcp_send_win(conn));
 
 	NET_DBG("conn: %p window_full=%hu", conn, window_full);
 
@@ -748,27 +947,141 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
-static int tcp_send_data(struct tcp *conn)
+/* Called once the connection is established, when the peer's MSS and
+ * the negotiated options are known.
+ */
+static void tcp_cc_init(struct tcp *conn)
+{
+	conn->snd_max = conn->seq;
+	conn->recover = conn->seq;
+
+	conn->cc = TCP_CC_DEFAULT;
+	if (conn->cc) {
+		conn->ssthresh = UINT32_MAX;
+		conn->cc->init(conn);
+	}
+}
+
+/* Loss detected by duplicate ACKs or by the retransmission timer */
+static void tcp_cc_loss(struct tcp *conn, bool timeout)
+{
+	uint32_t smss = conn_smss(conn);
+
+	if (!conn->cc) {
+		return;
+	}
+
+	conn->ssthresh = conn->cc->ssthresh(conn);
+	conn->cwnd_acked = 0;
+
+	/* RFC 5681, 3.1 and 3.2 */
+	conn->cwnd = timeout ? smss :
+		conn->ssthresh + TCP_DUPACK_THRESHOLD * smss;
+
+	NET_DBG("conn: %p %s cwnd=%u ssthresh=%u", conn,
+		timeout ? "timeout" : "fast retransmit", conn->cwnd,
+		conn->ssthresh);
+}
+
+/* Send len bytes at offset pos of the send_data queue */
+static int tcp_send_segment(struct tcp *conn, int pos, int len)
 {
-	int ret = 0;
-	int pos, len;
 	struct net_pkt *pkt;
 
-	pos = conn->unacked_len;
-	len = MIN3(conn->send_data_total - conn->unacked_len,
-		   conn->send_win - conn->unacked_len,
-		   conn_mss(conn));
+	if (len > conn_smss(conn)) {
+		/* Segmented by the hardware, so not limited by the MTU */
+		pkt = net_pkt_alloc_with_buffer(NULL, len, AF_UNSPEC, 0,
+						TCP_PKT_ALLOC_TIMEOUT);
+		tp_pkt_alloc(pkt, tp_basename(__FILE__), __LINE__);
+	} else {
+		pkt = tcp_pkt_alloc(conn, len);
+	}
 
-	pkt = tcp_pkt_alloc(conn, len);
 	if (!pkt) {
 		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
-		ret = -ENOBUFS;
-		goto out;
+		return -ENOBUFS;
 	}
 
 	tcp_pkt_peek(pkt, conn->send_data, pos, len);
 
-	tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
+	tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + pos);
+
+	return 0;
+}
+
+/* Move unacked_len past send_data the peer has selectively acknowledged
+ * and limit len so that the next segment stops at the next such block.
+ */
+static int tcp_sack_skip(struct tcp *conn, int len)
+{
+	int i;
+
+	for (i = 0; i < conn->sacked_count; i++) {
+		struct tcp_sack_block *block = &conn->sacked[i];
+		uint32_t next = conn->seq + conn->unacked_len;
+
+		if (net_tcp_seq_cmp(next, block->left) < 0) {
+			return MIN(len, (int)(block->left - next));
+		}
+
+		if (net_tcp_seq_cmp(next, block->right) < 0) {
+			conn->unacked_len = block->right - conn->seq;
+		}
+	}
+
+	return len;
+}
+
+/* Largest amount of data handed to the interface at once, several
+ * segments if the hardware does the segmentation.
+ */
+static int tcp_send_mss(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_TSO)
+	if (net_if_can_offload_tso(conn->iface)) {
+		return MAX(CONFIG_NET_TCP_TSO_MAX_SIZE, conn_smss(conn));
+	}
+#endif
+
+	return conn_smss(conn);
+}
+
+static int tcp_send_data(struct tcp *conn)
+{
+	int ret = 0;
+	int mss = tcp_send_mss(conn);
+	uint32_t seq;
+	int len;
+
+	if (conn_sack_ok(conn)) {
+		mss = tcp_sack_skip(conn, mss);
+	}
+
+	len = MIN3((int)conn->send_data_total - conn->unacked_len,
+		   (int)tcp_send_win(conn) - conn->unacked_len, mss);
+	if (len <= 0) {
+		goto out;
+	}
+
+	ret = tcp_send_segment(conn, conn->unacked_len, len);
+	if (ret < 0) {
+		goto out;
+	}
+
+	seq = conn->seq + conn->unacked_len;
+
+	if (net_tcp_seq_cmp(seq, conn->snd_max) < 0) {
+		conn->stats.rexmits++;
+	} else if (!conn->rtt_timing && !conn_ts_ok(conn)) {
+		/* Karn: only time segments sent for the first time */
+		conn->rtt_timing = true;
+		conn->rtt_seq = seq + len;
+		conn->rtt_start = k_uptime_get_32();
+	}
+
+	if (net_tcp_seq_cmp(seq + len, conn->snd_max) > 0) {
+		conn->snd_max = seq + len;
+	}
 
 	conn->unacked_len += len;
  out:
@@ -777,6 +1090,15 @@ static int tcp_send_data(struct tcp *conn)
 	return ret;
 }
 
+/* Nagle's algorithm (RFC 896, RFC 1122 4.2.3.4): hold back a partial
+ * segment while earlier data is unacknowledged, its ACK will push it.
+ */
+static bool tcp_nagle_hold(struct tcp *conn)
+{
+	return !conn->nodelay && conn->unacked_len > 0 &&
+		tcp_unsent_len(conn) < conn_smss(conn);
+}
+
 /* Send all queued but unsent data from the send_data packet by packet
  * until the receiver's window is full. */
 static int tcp_send_queued_data(struct tcp *conn)
@@ -795,6 +1117,10 @@ static int tcp_send_queued_data(struct tcp *conn)
 			break;
 		}
 
+		if (tcp_nagle_hold(conn)) {
+			break;
+		}
+
 		ret = tcp_send_data(conn);
 		if (ret < 0) {
 			break;
@@ -811,7 +1137,7 @@ static int tcp_send_queued_data(struct tcp *conn)
 
 	if (subscribe) {
 		conn->send_data_retries = 0;
-		k_delayed_work_submit(&conn->send_data_timer, K_MSEC(tcp_rto));
+		k_delayed_work_submit(&conn->send_data_timer, K_MSEC(conn->rto));
 	}
  out:
 	return ret;
@@ -830,18 +1156,431 @@ static void tcp_resend_data(struct k_work *work)
 		goto out;
 	}
 
+	/* The peer may have reneged on the data it has selectively
+	 * acknowledged, so forget about it (RFC 2018, 8).
+	 */
+	conn->sacked_count = 0;
+	conn->dup_acks = 0;
+
+	/* Only the first expiration for the same data lowers ssthresh */
+	if (conn->send_data_retries == 0) {
+		tcp_cc_loss(conn, true);
+	}
+
+	conn->in_recovery = false;
+	conn->rtt_timing = false;
+	conn->stats.timeouts++;
+
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
 	tcp_send_data(conn);
 
+	/* Back off the timer until a new RTT sample (RFC 6298, 5.5) */
+	conn->rto = MIN(conn->rto * 2, TCP_RTO_MAX);
+
 	conn->send_data_retries++;
-	k_delayed_work_submit(&conn->send_data_timer, K_MSEC(tcp_rto));
+	k_delayed_work_submit(&conn->send_data_timer, K_MSEC(conn->rto));
  out:
 	if (conn_unref) {
 		tcp_conn_unref(conn);
 	}
 }
 
+/* Called on the SYN exchange, enable the options both ends have offered */
+static void tcp_options_negotiate(struct tcp *conn)
+{
+	struct tcp_options *options = &conn->recv_options;
+
+	conn->wscale_ok = IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) &&
+		options->wnd_found;
+	conn->snd_wscale = conn->wscale_ok ?
+		MIN(options->window, TCP_WSCALE_MAX) : 0;
+	conn->rcv_wscale = conn->wscale_ok ? TCP_WSCALE_SHIFT : 0;
+
+	conn->ts_ok = IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS) &&
+		options->ts_found;
+	if (conn->ts_ok) {
+		conn->ts_recent = options->tsval;
+	}
+
+	conn->sack_ok = IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+		options->sack_perm_found;
+
+	NET_DBG("conn: %p wscale=%hu/%hu ts=%d sack=%d", conn,
+		(uint16_t)conn->snd_wscale, (uint16_t)conn->rcv_wscale,
+		conn->ts_ok, conn->sack_ok);
+}
+
+/* RFC 6298 round-trip time estimation, fed from echoed timestamps or
+ * from timing one segment per window.
+ */
+static void tcp_rtt_update(struct tcp *conn, uint32_t sent)
+{
+	int rtt = k_uptime_get_32() - sent;
+
+	if (rtt < 0) {
+		return;
+	}
+
+	if (!conn->srtt) {
+		conn->srtt = MAX(rtt, 1);
+		conn->rttvar = rtt / 2;
+	} else {
+		conn->rttvar = (3 * conn->rttvar + abs(conn->srtt - rtt)) / 4;
+		conn->srtt = (7 * conn->srtt + rtt) / 8;
+	}
+
+	conn->rto = MIN(MAX(conn->srtt + 4 * conn->rttvar, tcp_rto),
+			TCP_RTO_MAX);
+
+	NET_DBG("conn: %p rtt=%d srtt=%d rttvar=%d rto=%d", conn, rtt,
+		conn->srtt, conn->rttvar, conn->rto);
+}
+
+static void tcp_sack_block_remove(struct tcp *conn, int i)
+{
+	memmove(&conn->sacked[i], &conn->sacked[i + 1],
+		(conn->sacked_count - i - 1) * sizeof(conn->sacked[0]));
+	conn->sacked_count--;
+}
+
+/* Merge a block into the sorted scoreboard, when it is full the block
+ * with the highest sequence numbers is dropped.
+ */
+static void tcp_sack_block_add(struct tcp *conn, uint32_t left, uint32_t right)
+{
+	int i;
+
+	for (i = 0; i < conn->sacked_count; i++) {
+		struct tcp_sack_block *block = &conn->sacked[i];
+
+		if (net_tcp_seq_cmp(right, block->left) < 0) {
+			break;
+		}
+
+		if (net_tcp_seq_cmp(left, block->right) <= 0) {
+			/* Overlapping or adjacent, absorb and retry */
+			if (net_tcp_seq_cmp(block->left, left) < 0) {
+				left = block->left;
+			}
+
+			if (net_tcp_seq_cmp(block->right, right) > 0) {
+				right = block->right;
+			}
+
+			tcp_sack_block_remove(conn, i);
+			i--;
+		}
+	}
+
+	if (conn->sacked_count == TCP_SACK_BLOCKS_MAX) {
+		if (i == TCP_SACK_BLOCKS_MAX) {
+			return;
+		}
+
+		conn->sacked_count--;
+	}
+
+	memmove(&conn->sacked[i + 1], &conn->sacked[i],
+		(conn->sacked_count - i) * sizeof(conn->sacked[0]));
+	conn->sacked[i].left = left;
+	conn->sacked[i].right = right;
+	conn->sacked_count++;
+}
+
+/* Drop what the cumulative ACK covers from the scoreboard and add the
+ * SACK blocks of the received segment.
+ */
+static void tcp_sack_update(struct tcp *conn)
+{
+	struct tcp_options *options = &conn->recv_options;
+	uint32_t end = conn->seq + conn->send_data_total;
+	int i;
+
+	while (conn->sacked_count &&
+	       net_tcp_seq_cmp(conn->sacked[0].right, conn->seq) <= 0) {
+		tcp_sack_block_remove(conn, 0);
+	}
+
+	if (conn->sacked_count &&
+	    net_tcp_seq_cmp(conn->sacked[0].left, conn->seq) < 0) {
+		conn->sacked[0].left = conn->seq;
+	}
+
+	for (i = 0; i < options->sack_count; i++) {
+		struct tcp_sack_block *block = &options->sack[i];
+
+		/* Skip D-SACKs and blocks for data never sent */
+		if (net_tcp_seq_cmp(block->left, conn->seq) <= 0 ||
+		    net_tcp_seq_cmp(block->right, end) > 0 ||
+		    net_tcp_seq_cmp(block->left, block->right) >= 0) {
+			continue;
+		}
+
+		tcp_sack_block_add(conn, block->left, block->right);
+	}
+}
+
+/* Retransmit the holes below the highest selectively acknowledged data,
+ * each hole is resent once per recovery.
+ */
+static int tcp_sack_retransmit(struct tcp *conn)
+{
+	uint32_t next = conn->sack_rexmit;
+	int ret = 0;
+	int i, len;
+
+	if (net_tcp_seq_cmp(next, conn->seq) < 0) {
+		next = conn->seq;
+	}
+
+	for (i = 0; i < conn->sacked_count; i++) {
+		struct tcp_sack_block *block = &conn->sacked[i];
+
+		while (net_tcp_seq_cmp(next, block->left) < 0) {
+			len = MIN(block->left - next, (uint32_t)conn_smss(conn));
+
+			ret = tcp_send_segment(conn, next - conn->seq, len);
+			if (ret < 0) {
+				goto out;
+			}
+
+			conn->stats.rexmits++;
+			conn->stats.fast_rexmits++;
+			next += len;
+		}
+
+		if (net_tcp_seq_cmp(next, block->right) < 0) {
+			next = block->right;
+		}
+	}
+ out:
+	conn->sack_rexmit = next;
+
+	return ret;
+}
+
+static void tcp_ooo_flush(struct tcp *conn)
+{
+	struct net_pkt *pkt;
+
+	while ((pkt = tcp_slist(&conn->ooo_queue, get, struct net_pkt,
+				next))) {
+		tcp_pkt_unref(pkt);
+	}
+
+	conn->ooo_count = 0;
+}
+
+/* Keep a copy of an out-of-order segment, it will be reported in SACK
+ * blocks until the missing data before it arrives.
+ */
+static void tcp_ooo_queue(struct tcp *conn, struct net_pkt *pkt,
+			  uint32_t seq, size_t len)
+{
+	sys_snode_t *prev = NULL;
+	struct net_pkt *queued;
+
+	if (conn->ooo_count >= TCP_SACK_QUEUE_LEN) {
+		NET_DBG("conn: %p out-of-order queue full", conn);
+		return;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&conn->ooo_queue, queued, next) {
+		uint32_t queued_seq = th_seq(th_get(queued));
+
+		if (net_tcp_seq_cmp(seq + len, queued_seq) <= 0) {
+			break;
+		}
+
+		if (net_tcp_seq_cmp(seq, queued_seq + tcp_data_len(queued)) <
+		    0) {
+			return; /* overlaps data already queued */
+		}
+
+		prev = &queued->next;
+	}
+
+	queued = tcp_pkt_clone(pkt);
+	if (!queued) {
+		return;
+	}
+
+	sys_slist_insert(&conn->ooo_queue, prev, &queued->next);
+	conn->ooo_count++;
+	conn->ooo_last = seq;
+}
+
+/* Pass up the queued segments that have become in-order */
+static void tcp_ooo_drain(struct tcp *conn)
+{
+	struct net_pkt *pkt;
+
+	while ((pkt = tcp_slist(&conn->ooo_queue, peek_head, struct net_pkt,
+				next))) {
+		uint32_t seq = th_seq(th_get(pkt));
+		size_t len = tcp_data_len(pkt);
+
+		if (net_tcp_seq_cmp(seq, conn->ack) > 0) {
+			break;
+		}
+
+		if (seq == conn->ack) {
+			if (tcp_data_get(conn, pkt) < 0) {
+				break;
+			}
+
+			conn_ack(conn, + len);
+		}
+
+		/* A segment partly covered by the in-order data is dropped
+		 * and left for the peer to retransmit.
+		 */
+		sys_slist_get(&conn->ooo_queue);
+		conn->ooo_count--;
+		tcp_pkt_unref(pkt);
+	}
+}
+
+/* Resend what the duplicate ACKs show as lost: the holes in the SACK
+ * scoreboard, or else the first unacknowledged segment.
+ */
+static void tcp_fast_retransmit(struct tcp *conn)
+{
+	int len;
+
+	conn->rtt_timing = false;
+
+	if (conn_sack_ok(conn) && conn->sacked_count) {
+		tcp_sack_retransmit(conn);
+		return;
+	}
+
+	len = MIN(conn->unacked_len, conn_smss(conn));
+
+	if (tcp_send_segment(conn, 0, len) == 0) {
+		conn->stats.rexmits++;
+		conn->stats.fast_rexmits++;
+	}
+}
+
+static void tcp_dup_ack(struct tcp *conn)
+{
+	conn->stats.dup_acks++;
+
+	if (conn->dup_acks < UINT8_MAX) {
+		conn->dup_acks++;
+	}
+
+	if (conn->in_recovery) {
+		/* Every duplicate ACK means a segment has left the network */
+		if (conn->cc) {
+			conn->cwnd += conn_smss(conn);
+		}
+
+		if (conn_sack_ok(conn) && conn->sacked_count) {
+			tcp_sack_retransmit(conn);
+		}
+
+		return;
+	}
+
+	/* Don't start a new recovery for losses of the previous one */
+	if (conn->dup_acks != TCP_DUPACK_THRESHOLD ||
+	    net_tcp_seq_cmp(conn->seq, conn->recover) < 0) {
+		return;
+	}
+
+	conn->in_recovery = true;
+	conn->recover = conn->seq + conn->unacked_len;
+	conn->sack_rexmit = conn->seq;
+
+	tcp_cc_loss(conn, false);
+	tcp_fast_retransmit(conn);
+}
+
+/* RFC 6582 NewReno recovery, the congestion control algorithm only sees
+ * the data acknowledged outside of it.
+ */
+static void tcp_new_ack(struct tcp *conn, uint32_t acked)
+{
+	uint32_t smss = conn_smss(conn);
+
+	if (!conn->in_recovery) {
+		conn->dup_acks = 0;
+
+		if (conn->cc) {
+			conn->cc->cong_avoid(conn, acked);
+		}
+
+		return;
+	}
+
+	if (net_tcp_seq_cmp(conn->seq, conn->recover) >= 0) {
+		conn->in_recovery = false;
+		conn->dup_acks = 0;
+
+		if (conn->cc) {
+			conn->cwnd = MIN(conn->ssthresh,
+					 MAX((uint32_t)conn->unacked_len, smss) +
+					 smss);
+		}
+
+		return;
+	}
+
+	/* Partial acknowledgement, the next segment was lost too */
+	tcp_fast_retransmit(conn);
+
+	if (conn->cc) {
+		conn->cwnd = conn->cwnd > acked ? conn->cwnd - acked : 0;
+		if (acked >= smss) {
+			conn->cwnd += smss;
+		}
+
+		conn->cwnd = MAX(conn->cwnd, smss);
+	}
+}
+
+static void tcp_ack_timeout(struct k_work *work)
+{
+	struct tcp *conn = CONTAINER_OF(work, struct tcp, ack_timer);
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (conn->ack_pending) {
+		tcp_out(conn, ACK);
+	}
+
+	k_mutex_unlock(&conn->lock);
+}
+
+/* Acknowledge in-order data, delayed as allowed by RFC 1122 4.2.3.2:
+ * at most NET_TCP_DELAYED_ACK_TIMEOUT and at least every second
+ * segment. Half of the receive window being used forces an ACK too, so
+ * that the peer is not left waiting for a window update.
+ */
+static void tcp_data_ack(struct tcp *conn, size_t len)
+{
+#if defined(CONFIG_NET_TCP_DELAYED_ACK)
+	conn->ack_pending++;
+	conn->ack_pending_len = MIN(conn->ack_pending_len + len, UINT16_MAX);
+
+	if (conn->ack_pending < 2 &&
+	    conn->ack_pending_len < conn->recv_win / 2 &&
+	    sys_slist_is_empty(&conn->ooo_queue)) {
+		if (!k_delayed_work_remaining_get(&conn->ack_timer)) {
+			k_delayed_work_submit(&conn->ack_timer,
+				K_MSEC(CONFIG_NET_TCP_DELAYED_ACK_TIMEOUT));
+		}
+
+		return;
+	}
+#endif
+
+	tcp_out(conn, ACK);
+}
+
 static void tcp_timewait_timeout(struct k_work *work)
 {
 	struct tcp *conn = CONTAINER_OF(work, struct tcp, timewait_timer);
@@ -880,11 +1619,16 @@ static struct tcp *tcp_conn_alloc(void)
 		     IS_ENABLED(CONFIG_NET_TEST)) ? 0 : sys_rand32_get();
 
 	sys_slist_init(&conn->send_queue);
+	sys_slist_init(&conn->ooo_queue);
+
+	conn->rto = tcp_rto;
 
 	k_delayed_work_init(&conn->send_timer, tcp_send_process);
 
 	k_delayed_work_init(&conn->timewait_timer, tcp_timewait_timeout);
 
+	k_delayed_work_init(&conn->ack_timer, tcp_ack_timeout);
+
 	conn->send_data = tcp_pkt_alloc(conn, 0);
 	k_delayed_work_init(&conn->send_data_timer, tcp_resend_data);
 
@@ -1098,16 +1842,41 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto next_state;
 	}
 
+	conn->recv_options.ts_found = false;
+	conn->recv_options.sack_count = 0;
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
-						  tcp_options_len)) {
+						  tcp_options_len,
+						  th->th_flags)) {
 		NET_DBG("DROP: Invalid TCP option list");
 		tcp_out(conn, RST);
 		conn_state(conn, TCP_CLOSED);
 		goto next_state;
 	}
 
+	if (th && (th->th_flags & SYN)) {
+		tcp_options_negotiate(conn);
+	}
+
+	if (th && conn_ts_ok(conn) && conn->recv_options.ts_found &&
+	    !(th->th_flags & (SYN | RST))) {
+		if ((int32_t)(conn->recv_options.tsval - conn->ts_recent) < 0) {
+			NET_DBG("DROP: PAWS, tsval=%u ts_recent=%u",
+				conn->recv_options.tsval, conn->ts_recent);
+			tcp_out(conn, ACK);
+			goto out;
+		}
+
+		if (net_tcp_seq_cmp(th_seq(th), conn->ack) <= 0) {
+			conn->ts_recent = conn->recv_options.tsval;
+		}
+	}
+
 	if (th) {
 		conn->send_win = ntohs(th->th_win);
+		if (!(th->th_flags & SYN)) {
+			conn->send_win <<= conn->snd_wscale;
+		}
 	}
 
 	if (FL(&fl, &, RST)) {
@@ -1134,6 +1903,7 @@ next_state:
 				th_seq(th) == conn->ack)) {
 			tcp_send_timer_cancel(conn);
 			next = TCP_ESTABLISHED;
+			tcp_cc_init(conn);
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
 
@@ -1162,6 +1932,7 @@ next_state:
 			}
 			k_sem_give(&conn->connect_sem);
 			next = TCP_ESTABLISHED;
+			tcp_cc_init(conn);
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
 			tcp_out(conn, ACK);
@@ -1203,6 +1974,16 @@ next_state:
 
 			conn_send_data_dump(conn);
 
+			if (conn_ts_ok(conn) && conn->recv_options.ts_found &&
+			    conn->recv_options.tsecr) {
+				tcp_rtt_update(conn, conn->recv_options.tsecr);
+			} else if (conn->rtt_timing &&
+				   net_tcp_seq_cmp(conn->seq,
+						   conn->rtt_seq) >= 0) {
+				conn->rtt_timing = false;
+				tcp_rtt_update(conn, conn->rtt_start);
+			}
+
 			if (!k_delayed_work_remaining_get(&conn->send_data_timer)) {
 				NET_ERR("conn: %p, Missing a subscription "
 					"of the send_data queue timer", conn);
@@ -1217,6 +1998,26 @@ next_state:
 			}
 			conn->data_mode = TCP_DATA_MODE_SEND;
 
+			if (conn_sack_ok(conn)) {
+				tcp_sack_update(conn);
+			}
+
+			tcp_new_ack(conn, len_acked);
+
+			if (tcp_send_queued_data(conn) < 0) {
+				tcp_out(conn, RST);
+				conn_state(conn, TCP_CLOSED);
+				break;
+			}
+		} else if (th && (th->th_flags & ACK) && conn->unacked_len &&
+			   !len && th_ack(th) == conn->seq &&
+			   conn->data_mode == TCP_DATA_MODE_SEND) {
+			if (conn_sack_ok(conn)) {
+				tcp_sack_update(conn);
+			}
+
+			tcp_dup_ack(conn);
+
 			if (tcp_send_queued_data(conn) < 0) {
 				tcp_out(conn, RST);
 				conn_state(conn, TCP_CLOSED);
@@ -1230,9 +2031,18 @@ next_state:
 					break;
 				}
 				conn_ack(conn, + len);
-				tcp_out(conn, ACK);
+				if (conn_sack_ok(conn)) {
+					tcp_ooo_drain(conn);
+				}
+				tcp_data_ack(conn, len);
 			} else if (net_tcp_seq_greater(conn->ack, th_seq(th))) {
 				tcp_out(conn, ACK); /* peer has resent */
+			} else if (conn_sack_ok(conn)) {
+				if (!(th->th_flags & FIN)) {
+					tcp_ooo_queue(conn, pkt, th_seq(th),
+						      len);
+				}
+				tcp_out(conn, ACK); /* duplicate ACK with SACK */
 			}
 		}
 		break;
@@ -1294,7 +2104,7 @@ next_state:
 		next = 0;
 		goto next_state;
 	}
-
+out:
 	k_mutex_unlock(&conn->lock);
 }
 
@@ -1321,6 +2131,120 @@ int net_tcp_put(struct net_context *context)
 	return 0;
 }
 
+static bool tcp_info_get(int index, struct net_tcp_info *info)
+{
+	struct tcp *conn;
+	int key = irq_lock();
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp_conns, conn, next) {
+		if (index--) {
+			continue;
+		}
+
+		info->context = conn->context;
+		info->state = tcp_state_to_str(conn->state, false);
+		info->cc = conn->cc ? conn->cc->name : NULL;
+		info->seq = conn->seq;
+		info->ack = conn->ack;
+		info->mss = conn_mss(conn);
+		info->send_win = conn->send_win;
+		info->cwnd = conn->cwnd;
+		info->ssthresh = conn->ssthresh;
+		info->srtt = conn->srtt;
+		info->rttvar = conn->rttvar;
+		info->rto = conn->rto;
+		info->rexmits = conn->stats.rexmits;
+		info->fast_rexmits = conn->stats.fast_rexmits;
+		info->timeouts = conn->stats.timeouts;
+		info->dup_acks = conn->stats.dup_acks;
+		break;
+	}
+
+	irq_unlock(key);
+
+	return conn != NULL;
+}
+
+void net_tcp_info_foreach(net_tcp_info_cb_t cb, void *user_data)
+{
+	struct net_tcp_info info;
+	int i;
+
+	/* The callback runs unlocked, so look each connection up again */
+	for (i = 0; tcp_info_get(i, &info); i++) {
+		cb(&info, user_data);
+	}
+}
+
+int net_tcp_set_option(struct net_context *context,
+		       enum tcp_conn_option option,
+		       const void *value, size_t len)
+{
+	struct tcp *conn = context->tcp;
+	int ret = 0;
+
+	if (!conn) {
+		return -ENOTCONN;
+	}
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	switch (option) {
+	case TCP_OPT_NODELAY:
+		if (len != sizeof(int)) {
+			ret = -EINVAL;
+			break;
+		}
+
+		conn->nodelay = *(const int *)value != 0;
+
+		/* Data held back by Nagle's algorithm can go now */
+		if (conn->nodelay && conn->state == TCP_ESTABLISHED) {
+			ret = tcp_send_queued_data(conn);
+		}
+
+		break;
+	default:
+		ret = -ENOPROTOOPT;
+	}
+
+	k_mutex_unlock(&conn->lock);
+
+	return ret;
+}
+
+int net_tcp_get_option(struct net_context *context,
+		       enum tcp_conn_option option,
+		       void *value, size_t *len)
+{
+	struct tcp *conn = context->tcp;
+	int ret = 0;
+
+	if (!conn) {
+		return -ENOTCONN;
+	}
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	switch (option) {
+	case TCP_OPT_NODELAY:
+		if (*len < sizeof(int)) {
+			ret = -EINVAL;
+			break;
+		}
+
+		*(int *)value = conn->nodelay;
+		*len = sizeof(int);
+		break;
+	default:
+		ret = -ENOPROTOOPT;
+	}
+
+	k_mutex_unlock(&conn->lock);
+
+	return ret;
+}
+
 int net_tcp_listen(struct net_context *context)
 {
 	/* when created, tcp connections are in state TCP_LISTEN */
@@ -1562,14 +2486,16 @@ int net_tcp_accept(struct net_context *context, net_tcp_accept_cb_t cb,
 	 */
 	net_conn_unregister(context->conn_handler);
 
-	return net_conn_register(net_context_get_ip_proto(context),
+	return net_conn_register_reuseport(
+				 net_context_get_ip_proto(context),
 				 local_addr.sa_family,
 				 context->flags & NET_CONTEXT_REMOTE_ADDR_SET ?
 				 &context->remote : NULL,
 				 &local_addr,
 				 remote_port, local_port,
 				 tcp_recv, context,
-				 &context->conn_handler);
+				 &context->conn_handler,
+				 net_context_is_reuseport(context));
 }
 
 int net_tcp_recv(struct net_context *context, net_context_recv_cb_t cb,
@@ -1600,7 +2526,7 @@ int net_tcp_finalize(struct net_pkt *pkt)
 
 	tcp_hdr->chksum = 0U;
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
+	if (net_pkt_need_calc_tx_checksum(pkt)) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 	}
 
@@ -1613,7 +2539,7 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 	struct net_tcp_hdr *tcp_hdr;
 
 	if (IS_ENABLED(CONFIG_NET_TCP_CHECKSUM) &&
-			net_if_need_calc_rx_checksum(net_pkt_iface(pkt)) &&
+			net_pkt_need_calc_rx_checksum(pkt, true) &&
 			net_calc_chksum_tcp(pkt) != 0U) {
 		NET_DBG("DROP: checksum mismatch");
 		goto drop;
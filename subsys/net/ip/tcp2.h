@@ -126,6 +126,71 @@ int net_tcp_update_recv_wnd(struct net_context *context, int32_t delta);
 int net_tcp_queue_data(struct net_context *context, struct net_pkt *pkt);
 int net_tcp_finalize(struct net_pkt *pkt);
 
+/** TCP connection options */
+enum tcp_conn_option {
+	TCP_OPT_NODELAY = 1, /* int, non-zero disables Nagle's algorithm */
+};
+
+/**
+ * @brief Set a TCP connection option
+ *
+ * @param context Network context
+ * @param option Option to set
+ * @param value Option value
+ * @param len Option length
+ *
+ * @return 0 on success, < 0 on error
+ */
+int net_tcp_set_option(struct net_context *context,
+		       enum tcp_conn_option option,
+		       const void *value, size_t len);
+
+/**
+ * @brief Get a TCP connection option
+ *
+ * @param context Network context
+ * @param option Option to get
+ * @param value Option value
+ * @param len Option length, updated with the length written
+ *
+ * @return 0 on success, < 0 on error
+ */
+int net_tcp_get_option(struct net_context *context,
+		       enum tcp_conn_option option,
+		       void *value, size_t *len);
+
+/** Snapshot of a TCP connection, as given by net_tcp_info_foreach() */
+struct net_tcp_info {
+	struct net_context *context;
+	const char *state;
+	const char *cc; /* congestion control algorithm, NULL if none */
+	uint32_t seq;
+	uint32_t ack;
+	uint16_t mss;
+	uint32_t send_win;
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	int srtt; /* ms, 0 if not measured yet */
+	int rttvar; /* ms */
+	int rto; /* ms */
+	uint32_t rexmits;
+	uint32_t fast_rexmits;
+	uint32_t timeouts;
+	uint32_t dup_acks;
+};
+
+typedef void (*net_tcp_info_cb_t)(struct net_tcp_info *info,
+				  void *user_data);
+
+/**
+ * @brief Go through all the TCP connections and call callback
+ *        with a snapshot of each of them.
+ *
+ * @param cb User supplied callback function to call.
+ * @param user_data User specified data.
+ */
+void net_tcp_info_foreach(net_tcp_info_cb_t cb, void *user_data);
+
 #if defined(CONFIG_NET_TEST_PROTOCOL)
 /**
  * @brief Handle an incoming TCP packet
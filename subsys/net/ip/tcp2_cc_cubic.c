@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* CUBIC congestion control (RFC 8312), C = 0.4 and beta = 0.7, computed
+ * with windows in bytes and time in milliseconds.
+ */
+
+#include <zephyr.h>
+#include <net/net_pkt.h>
+#include <net/net_context.h>
+#include "tcp2_priv.h"
+
+/* Time past K after which the window growth is no longer computed,
+ * keeps the cube below 2^63 once scaled.
+ */
+#define CUBIC_DELTA_MAX 120000
+
+static uint32_t cubic_cbrt(uint64_t x)
+{
+	uint64_t y = 0, b;
+	int s;
+
+	for (s = 63; s >= 0; s -= 3) {
+		y <<= 1;
+		b = 3 * y * (y + 1) + 1;
+		if ((x >> s) >= b) {
+			x -= b << s;
+			y++;
+		}
+	}
+
+	return y;
+}
+
+static void cubic_init(struct tcp *conn)
+{
+	tcp_cc_newreno.init(conn);
+
+	memset(&conn->cc_data.cubic, 0, sizeof(conn->cc_data.cubic));
+}
+
+/* W_cubic(t) = C * (t - K)^3 + origin, in bytes */
+static uint32_t cubic_window(struct tcp *conn, uint32_t t)
+{
+	struct tcp_cubic *cubic = &conn->cc_data.cubic;
+	int64_t delta = (int64_t)t - cubic->k;
+	int64_t offs, w;
+
+	delta = MIN(MAX(delta, -CUBIC_DELTA_MAX), CUBIC_DELTA_MAX);
+
+	/* 0.4 segments/s^3 in units of 1/1024 segment per ms^3 */
+	offs = (4 * 1024 * delta * delta * delta) / 10000000000LL;
+	w = cubic->origin + offs * conn_smss(conn) / 1024;
+
+	return (uint32_t)MIN(MAX(w, (int64_t)conn_smss(conn)),
+			     (int64_t)UINT32_MAX);
+}
+
+static void cubic_cong_avoid(struct tcp *conn, uint32_t acked)
+{
+	struct tcp_cubic *cubic = &conn->cc_data.cubic;
+	uint32_t smss = conn_smss(conn);
+	uint32_t now, target;
+
+	acked = tcp_cc_slow_start(conn, acked);
+	if (!acked) {
+		return;
+	}
+
+	now = k_uptime_get_32();
+
+	if (!cubic->epoch_start) {
+		cubic->epoch_start = MAX(now, 1U);
+		cubic->w_est = conn->cwnd;
+
+		if (conn->cwnd < cubic->w_max) {
+			/* K = cbrt((W_max - cwnd) / C) */
+			cubic->k = cubic_cbrt((uint64_t)(cubic->w_max -
+							 conn->cwnd) *
+					      2500000000ULL / smss);
+			cubic->origin = cubic->w_max;
+		} else {
+			cubic->k = 0;
+			cubic->origin = conn->cwnd;
+		}
+	}
+
+	/* Aim at the window one RTT from now */
+	target = cubic_window(conn, now - cubic->epoch_start + conn->srtt);
+	target = MIN(target, conn->cwnd + conn->cwnd / 2);
+
+	/* Don't grow slower than Reno would, alpha = 3 * (1 - beta) /
+	 * (1 + beta) segments per RTT.
+	 */
+	cubic->w_est += (uint64_t)9 * smss * acked / (17 * conn->cwnd);
+	target = MAX(target, cubic->w_est);
+
+	if (target > conn->cwnd) {
+		conn->cwnd += (uint64_t)(target - conn->cwnd) * acked /
+			conn->cwnd;
+	}
+}
+
+static uint32_t cubic_ssthresh(struct tcp *conn)
+{
+	struct tcp_cubic *cubic = &conn->cc_data.cubic;
+
+	/* Fast convergence, release bandwidth to newer flows */
+	if (conn->cwnd < cubic->w_max) {
+		cubic->w_max = (uint64_t)conn->cwnd * 17 / 20;
+	} else {
+		cubic->w_max = conn->cwnd;
+	}
+
+	cubic->epoch_start = 0;
+
+	return MAX((uint64_t)conn->cwnd * 7 / 10, 2 * conn_smss(conn));
+}
+
+const struct tcp_cc tcp_cc_cubic = {
+	.name = "cubic",
+	.init = cubic_init,
+	.cong_avoid = cubic_cong_avoid,
+	.ssthresh = cubic_ssthresh,
+};
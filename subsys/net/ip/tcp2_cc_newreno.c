@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* NewReno congestion control (RFC 5681 and RFC 6582), the fast recovery
+ * part is common to all algorithms and lives in tcp2.c.
+ */
+
+#include <zephyr.h>
+#include <net/net_pkt.h>
+#include <net/net_context.h>
+#include "tcp2_priv.h"
+
+/* Grow cwnd by at most one segment per ACK while below ssthresh (RFC 5681,
+ * 3.1), return the part of acked left for congestion avoidance.
+ */
+uint32_t tcp_cc_slow_start(struct tcp *conn, uint32_t acked)
+{
+	uint32_t smss = conn_smss(conn);
+	uint32_t inc;
+
+	if (conn->cwnd >= conn->ssthresh) {
+		return acked;
+	}
+
+	inc = MIN(MIN(acked, smss), conn->ssthresh - conn->cwnd);
+	conn->cwnd += inc;
+
+	return acked - inc;
+}
+
+static void newreno_init(struct tcp *conn)
+{
+	uint32_t smss = conn_smss(conn);
+
+	/* RFC 5681, 3.1 */
+	if (smss > 2190) {
+		conn->cwnd = 2 * smss;
+	} else if (smss > 1095) {
+		conn->cwnd = 3 * smss;
+	} else {
+		conn->cwnd = 4 * smss;
+	}
+
+	conn->cwnd_acked = 0;
+}
+
+static void newreno_cong_avoid(struct tcp *conn, uint32_t acked)
+{
+	acked = tcp_cc_slow_start(conn, acked);
+	if (!acked) {
+		return;
+	}
+
+	/* One segment per window of acknowledged data (RFC 5681, 3.1) */
+	conn->cwnd_acked += acked;
+	if (conn->cwnd_acked >= conn->cwnd) {
+		conn->cwnd_acked -= conn->cwnd;
+		conn->cwnd += conn_smss(conn);
+	}
+}
+
+static uint32_t newreno_ssthresh(struct tcp *conn)
+{
+	return MAX((uint32_t)conn->unacked_len / 2, 2 * conn_smss(conn));
+}
+
+const struct tcp_cc tcp_cc_newreno = {
+	.name = "newreno",
+	.init = newreno_init,
+	.cong_avoid = newreno_cong_avoid,
+	.ssthresh = newreno_ssthresh,
+};
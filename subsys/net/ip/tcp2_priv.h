@@ -85,6 +85,11 @@
 	((_conn)->recv_options.mss_found ?		\
 	 (_conn)->recv_options.mss : NET_IPV6_MTU)
 
+/* Payload of a full-sized segment, the peer's MSS minus our options */
+#define conn_smss(_conn)						\
+	(conn_mss(_conn) -						\
+	 (conn_ts_ok(_conn) ? 2 + TCPOPT_TIMESTAMP_LEN : 0))
+
 #define conn_state(_conn, _s)						\
 ({									\
 	NET_DBG("%s->%s",						\
@@ -96,7 +101,7 @@
 #define conn_send_data_dump(_conn)					\
 ({									\
 	NET_DBG("conn: %p total=%zd, unacked_len=%d, "			\
-		"send_win=%hu, mss=%hu",				\
+		"send_win=%u, mss=%hu",					\
 		(_conn), net_pkt_get_len((_conn)->send_data),		\
 		conn->unacked_len, conn->send_win,			\
 		conn_mss((_conn)));					\
@@ -110,6 +115,40 @@
 #define TCPOPT_NOP	1
 #define TCPOPT_MAXSEG	2
 #define TCPOPT_WINDOW	3
+#define TCPOPT_SACK_PERM 4
+#define TCPOPT_SACK	5
+#define TCPOPT_TIMESTAMP 8
+
+#define TCPOPT_WINDOW_LEN	3
+#define TCPOPT_SACK_PERM_LEN	2
+#define TCPOPT_SACK_BLOCK_LEN	8
+#define TCPOPT_TIMESTAMP_LEN	10
+
+#define TCP_OPTIONS_MAX_LEN	40 /* TCP header max options size */
+#define TCP_SACK_BLOCKS_MAX	4  /* SACK blocks fitting in one header */
+#define TCP_WSCALE_MAX		14 /* RFC 7323, 2.3 */
+#define TCP_DUPACK_THRESHOLD	3
+#define TCP_RTO_MAX		60000 /* ms */
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+#define TCP_WSCALE_SHIFT CONFIG_NET_TCP_WINDOW_SCALE_SHIFT
+#else
+#define TCP_WSCALE_SHIFT 0
+#endif
+
+#if defined(CONFIG_NET_TCP_SACK)
+#define TCP_SACK_QUEUE_LEN CONFIG_NET_TCP_SACK_QUEUE_LEN
+#else
+#define TCP_SACK_QUEUE_LEN 0
+#endif
+
+/* Options negotiated on the connection's SYN exchange */
+#define conn_wscale_ok(_conn)						\
+	(IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) && (_conn)->wscale_ok)
+#define conn_ts_ok(_conn)						\
+	(IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS) && (_conn)->ts_ok)
+#define conn_sack_ok(_conn)						\
+	(IS_ENABLED(CONFIG_NET_TCP_SACK) && (_conn)->sack_ok)
 
 enum pkt_addr {
 	TCP_EP_SRC = 1,
@@ -169,11 +208,65 @@ union tcp_endpoint {
 	struct sockaddr_in6 sin6;
 };
 
+struct tcp_sack_block {
+	uint32_t left;	/* first sequence number of the block */
+	uint32_t right;	/* sequence number following the block */
+};
+
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
+	uint32_t tsval;
+	uint32_t tsecr;
+	struct tcp_sack_block sack[TCP_SACK_BLOCKS_MAX];
+	uint8_t sack_count;
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
+	bool ts_found : 1;
+};
+
+struct tcp;
+
+/* Congestion control algorithm, the hooks are called with the connection
+ * locked and may adjust cwnd, ssthresh and their private data.
+ */
+struct tcp_cc {
+	const char *name;
+	/* Connection established, set the initial window */
+	void (*init)(struct tcp *conn);
+	/* New data has been acknowledged outside of loss recovery */
+	void (*cong_avoid)(struct tcp *conn, uint32_t acked);
+	/* Loss detected, return the new slow start threshold */
+	uint32_t (*ssthresh)(struct tcp *conn);
+};
+
+extern const struct tcp_cc tcp_cc_newreno;
+extern const struct tcp_cc tcp_cc_cubic;
+
+uint32_t tcp_cc_slow_start(struct tcp *conn, uint32_t acked);
+
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+#define TCP_CC_DEFAULT (&tcp_cc_cubic)
+#elif defined(CONFIG_NET_TCP_CC_NEWRENO)
+#define TCP_CC_DEFAULT (&tcp_cc_newreno)
+#else
+#define TCP_CC_DEFAULT NULL
+#endif
+
+struct tcp_cubic {
+	uint32_t w_max; /* window before the last reduction */
+	uint32_t origin; /* window the cubic function grows back to */
+	uint32_t w_est; /* Reno-friendly window estimate */
+	uint32_t epoch_start; /* start of the current growth epoch, in ms */
+	uint32_t k; /* time to grow back to origin, in ms */
+};
+
+struct tcp_conn_stats {
+	uint32_t rexmits; /* segments sent again, for any reason */
+	uint32_t fast_rexmits; /* segments resent on duplicate ACKs */
+	uint32_t timeouts; /* retransmission timer expirations */
+	uint32_t dup_acks; /* duplicate ACKs received */
 };
 
 struct tcp { /* TCP connection */
@@ -187,8 +280,38 @@ struct tcp { /* TCP connection */
 	union tcp_endpoint src;
 	union tcp_endpoint dst;
 	uint16_t recv_win;
-	uint16_t send_win;
+	uint32_t send_win;
+	uint8_t snd_wscale; /* peer's shift, applied to received windows */
+	uint8_t rcv_wscale; /* our shift, applied to advertised windows */
+	bool wscale_ok;
+	bool ts_ok;
+	bool sack_ok;
+	uint32_t ts_recent; /* last timestamp value received in sequence */
+	int srtt; /* smoothed round-trip time in ms, 0 until measured */
+	int rttvar;
+	int rto; /* retransmission timeout of the send_data queue in ms */
+	uint32_t rtt_seq; /* sequence number timed for an RTT sample */
+	uint32_t rtt_start;
+	bool rtt_timing;
+	uint32_t snd_max; /* highest sequence number sent so far */
+	const struct tcp_cc *cc;
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	uint32_t cwnd_acked; /* bytes acknowledged toward a cwnd increase */
+	uint32_t recover; /* end of the data in flight at loss, RFC 6582 */
+	bool in_recovery;
+	union {
+		struct tcp_cubic cubic;
+	} cc_data;
+	struct tcp_conn_stats stats;
 	struct tcp_options recv_options;
+	struct tcp_sack_block sacked[TCP_SACK_BLOCKS_MAX]; /* scoreboard */
+	uint8_t sacked_count;
+	uint8_t dup_acks;
+	uint32_t sack_rexmit; /* SACK recovery has resent holes up to here */
+	sys_slist_t ooo_queue; /* out-of-order segments, sorted by seq */
+	uint8_t ooo_count;
+	uint32_t ooo_last; /* seq of the last queued out-of-order segment */
 	struct k_delayed_work send_timer;
 	sys_slist_t send_queue;
 	struct k_delayed_work send_data_timer;
@@ -200,6 +323,10 @@ struct tcp { /* TCP connection */
 	bool in_retransmission;
 	size_t send_retries;
 	struct k_delayed_work timewait_timer;
+	struct k_delayed_work ack_timer; /* delayed ACK */
+	uint8_t ack_pending; /* segments received since the last ACK */
+	uint16_t ack_pending_len;
+	bool nodelay; /* TCP_NODELAY, Nagle's algorithm disabled */
 	struct net_if *iface;
 	struct k_sem connect_sem; /* semaphore for blocking connect */
 	bool in_connect;
@@ -489,32 +489,43 @@ int z_vrfy_net_addr_pton(sa_family_t family, const char *src,
 #include <syscalls/net_addr_pton_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
-static uint16_t calc_chksum(uint16_t sum, const uint8_t *data, size_t len)
+uint16_t net_calc_chksum_data(uint16_t sum, const uint8_t *data, size_t len)
 {
-	const uint8_t *end;
-	uint16_t tmp;
-
-	end = data + len - 1;
-
-	while (data < end) {
-		tmp = (data[0] << 8) + data[1];
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
+	uint32_t acc = sum;
+
+	/* Accumulate the 16-bit words in a 32-bit sum and fold the carries
+	 * back once at the end, rather than after every word. Folding when
+	 * the top bit gets set keeps arbitrary lengths from overflowing.
+	 */
+	while (len >= 8) {
+		acc += ((uint32_t)data[0] << 8) + data[1];
+		acc += ((uint32_t)data[2] << 8) + data[3];
+		acc += ((uint32_t)data[4] << 8) + data[5];
+		acc += ((uint32_t)data[6] << 8) + data[7];
+
+		if (acc & 0x80000000) {
+			acc = (acc & 0xffff) + (acc >> 16);
 		}
 
+		data += 8;
+		len -= 8;
+	}
+
+	while (len > 1) {
+		acc += ((uint32_t)data[0] << 8) + data[1];
 		data += 2;
+		len -= 2;
 	}
 
-	if (data == end) {
-		tmp = data[0] << 8;
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+	if (len) {
+		acc += (uint32_t)data[0] << 8;
 	}
 
-	return sum;
+	while (acc >> 16) {
+		acc = (acc & 0xffff) + (acc >> 16);
+	}
+
+	return acc;
 }
 
 static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
@@ -529,7 +540,7 @@ static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 	len = cur->buf->len - (cur->pos - cur->buf->data);
 
 	while (cur->buf) {
-		sum = calc_chksum(sum, cur->pos, len);
+		sum = net_calc_chksum_data(sum, cur->pos, len);
 
 		cur->buf = cur->buf->frags;
 		if (!cur->buf || !cur->buf->len) {
@@ -588,7 +599,7 @@ uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto)
 
 	net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) - len);
 
-	sum = calc_chksum(sum, pkt->cursor.pos, len);
+	sum = net_calc_chksum_data(sum, pkt->cursor.pos, len);
 	net_pkt_skip(pkt, len + net_pkt_ip_opts_len(pkt));
 
 	sum = pkt_calc_chksum(pkt, sum);
@@ -607,7 +618,7 @@ uint16_t net_calc_chksum_ipv4(struct net_pkt *pkt)
 {
 	uint16_t sum;
 
-	sum = calc_chksum(0, pkt->buffer->data,
+	sum = net_calc_chksum_data(0, pkt->buffer->data,
 			  net_pkt_ip_hdr_len(pkt) +
 			  net_pkt_ipv4_opts_len(pkt));
 
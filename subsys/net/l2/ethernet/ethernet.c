@@ -555,17 +555,14 @@ static void ethernet_remove_l2_header(struct net_pkt *pkt)
 	net_pkt_frag_unref(buf);
 }
 
-static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
+/* Prepare the packet for the driver. If the packet has to wait for
+ * ARP resolution, *pkt_ptr is replaced by the ARP request to send instead.
+ */
+static int ethernet_prepare(struct net_if *iface, struct net_pkt **pkt_ptr)
 {
-	const struct ethernet_api *api = net_if_get_device(iface)->api;
 	struct ethernet_context *ctx = net_if_l2_data(iface);
+	struct net_pkt *pkt = *pkt_ptr;
 	uint16_t ptype;
-	int ret;
-
-	if (!api) {
-		ret = -ENOENT;
-		goto error;
-	}
 
 	if (IS_ENABLED(CONFIG_NET_IPV4) &&
 	    net_pkt_family(pkt) == AF_INET) {
@@ -576,13 +573,13 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 		} else {
 			tmp = ethernet_ll_prepare_on_ipv4(iface, pkt);
 			if (!tmp) {
-				ret = -ENOMEM;
-				goto error;
+				return -ENOMEM;
 			} else if (IS_ENABLED(CONFIG_NET_ARP) && tmp != pkt) {
 				/* Original pkt got queued and is replaced
 				 * by an ARP request packet.
 				 */
 				pkt = tmp;
+				*pkt_ptr = pkt;
 				ptype = htons(NET_ETH_PTYPE_ARP);
 				net_pkt_set_family(pkt, AF_INET);
 			} else {
@@ -594,7 +591,7 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 		ptype = htons(NET_ETH_PTYPE_IPV6);
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) &&
 		   net_pkt_family(pkt) == AF_PACKET) {
-		goto send;
+		return 0;
 	} else if (IS_ENABLED(CONFIG_NET_GPTP) && net_pkt_is_gptp(pkt)) {
 		ptype = htons(NET_ETH_PTYPE_PTP);
 	} else if (IS_ENABLED(CONFIG_NET_LLDP) && net_pkt_is_lldp(pkt)) {
@@ -605,8 +602,7 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 		ptype = htons(NET_ETH_PTYPE_ARP);
 		net_pkt_set_family(pkt, AF_INET);
 	} else {
-		ret = -ENOTSUP;
-		goto error;
+		return -ENOTSUP;
 	}
 
 	/* If the ll dst addr has not been set before, let's assume
@@ -621,8 +617,7 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 	if (IS_ENABLED(CONFIG_NET_VLAN) &&
 	    net_eth_is_vlan_enabled(ctx, iface)) {
 		if (set_vlan_tag(ctx, iface, pkt) == NET_DROP) {
-			ret = -EINVAL;
-			goto error;
+			return -EINVAL;
 		}
 
 		set_vlan_priority(ctx, pkt);
@@ -631,18 +626,21 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 	/* Then set the ethernet header.
 	 */
 	if (!ethernet_fill_header(ctx, pkt, ptype)) {
-		ret = -ENOMEM;
-		goto error;
+		return -ENOMEM;
 	}
 
 	net_pkt_cursor_init(pkt);
 
-send:
-	ret = api->send(net_if_get_device(iface), pkt);
+	return 0;
+}
+
+/* Handle the result of the driver send for a prepared packet */
+static int ethernet_sent(struct net_if *iface, struct net_pkt *pkt, int ret)
+{
 	if (ret != 0) {
 		eth_stats_update_errors_tx(iface);
 		ethernet_remove_l2_header(pkt);
-		goto error;
+		return ret;
 	}
 
 	ethernet_update_tx_stats(iface, pkt);
@@ -651,10 +649,80 @@ send:
 	ethernet_remove_l2_header(pkt);
 
 	net_pkt_unref(pkt);
-error:
+
 	return ret;
 }
 
+static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	const struct ethernet_api *api = net_if_get_device(iface)->api;
+	int ret;
+
+	if (!api) {
+		return -ENOENT;
+	}
+
+	ret = ethernet_prepare(iface, &pkt);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = api->send(net_if_get_device(iface), pkt);
+
+	return ethernet_sent(iface, pkt, ret);
+}
+
+#if defined(CONFIG_NET_TX_BATCH)
+static void ethernet_send_batch(struct net_if *iface, struct net_pkt *pkts[],
+				int *status, size_t count)
+{
+	const struct ethernet_api *api = net_if_get_device(iface)->api;
+	struct net_pkt *frames[CONFIG_NET_TX_BATCH_SIZE];
+	uint8_t slot[CONFIG_NET_TX_BATCH_SIZE];
+	size_t frame_count = 0;
+	int queued = 0;
+	size_t i;
+
+	NET_ASSERT(count <= CONFIG_NET_TX_BATCH_SIZE);
+
+	for (i = 0; i < count; i++) {
+		if (!api) {
+			status[i] = -ENOENT;
+			continue;
+		}
+
+		frames[frame_count] = pkts[i];
+
+		status[i] = ethernet_prepare(iface, &frames[frame_count]);
+		if (status[i] < 0) {
+			continue;
+		}
+
+		slot[frame_count++] = i;
+	}
+
+	if (frame_count > 1 && api->send_batch) {
+		queued = api->send_batch(net_if_get_device(iface), frames,
+					 frame_count);
+		if (queued < 0) {
+			queued = 0;
+		}
+	}
+
+	for (i = 0; i < frame_count; i++) {
+		int ret = 0;
+
+		if ((int)i >= queued) {
+			ret = api->send(net_if_get_device(iface), frames[i]);
+		}
+
+		status[slot[i]] = ethernet_sent(iface, frames[i], ret);
+	}
+}
+#else
+#define ethernet_send_batch NULL
+#endif /* CONFIG_NET_TX_BATCH */
+
 static inline int ethernet_enable(struct net_if *iface, bool state)
 {
 	const struct ethernet_api *eth =
@@ -967,8 +1035,8 @@ int net_eth_vlan_disable(struct net_if *iface, uint16_t tag)
 }
 #endif /* CONFIG_NET_VLAN */
 
-NET_L2_INIT(ETHERNET_L2, ethernet_recv, ethernet_send, ethernet_enable,
-	    ethernet_flags);
+NET_L2_INIT_BATCH(ETHERNET_L2, ethernet_recv, ethernet_send,
+		  ethernet_send_batch, ethernet_enable, ethernet_flags);
 
 static void carrier_on(struct k_work *work)
 {
@@ -146,6 +146,14 @@ static int ethernet_set_config(uint32_t mgmt_request,
 
 		config.promisc_mode = params->promisc_mode;
 		type = ETHERNET_CONFIG_TYPE_PROMISC_MODE;
+	} else if (mgmt_request == NET_REQUEST_ETHERNET_SET_RX_STEERING) {
+		if (!is_hw_caps_supported(dev, ETHERNET_PRIORITY_QUEUES)) {
+			return -ENOTSUP;
+		}
+
+		memcpy(&config.rx_steering, &params->rx_steering,
+		       sizeof(struct ethernet_rx_steering));
+		type = ETHERNET_CONFIG_TYPE_RX_STEERING;
 	} else {
 		return -EINVAL;
 	}
@@ -171,6 +179,9 @@ NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_ETHERNET_SET_QAV_PARAM,
 NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_ETHERNET_SET_PROMISC_MODE,
 				  ethernet_set_config);
 
+NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_ETHERNET_SET_RX_STEERING,
+				  ethernet_set_config);
+
 static int ethernet_get_config(uint32_t mgmt_request,
 			       struct net_if *iface,
 			       void *data, size_t len)
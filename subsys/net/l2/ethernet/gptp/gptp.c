@@ -853,6 +853,36 @@ void gptp_foreach_port(gptp_port_cb_t cb, void *user_data)
 	net_if_foreach(gptp_get_port, &ud);
 }
 
+#if defined(CONFIG_NET_GPTP_STATISTICS)
+void gptp_stat_var_add(struct gptp_stat_var *stat, double value)
+{
+	double delta;
+
+	if (stat->count == 0U || value < stat->min) {
+		stat->min = value;
+	}
+
+	if (stat->count == 0U || value > stat->max) {
+		stat->max = value;
+	}
+
+	stat->count++;
+
+	delta = value - stat->mean;
+	stat->mean += delta / stat->count;
+	stat->m2 += delta * (value - stat->mean);
+}
+
+double gptp_stat_var_get(const struct gptp_stat_var *stat)
+{
+	if (stat->count < 2U) {
+		return 0;
+	}
+
+	return stat->m2 / (stat->count - 1U);
+}
+#endif /* CONFIG_NET_GPTP_STATISTICS */
+
 struct gptp_domain *gptp_get_domain(void)
 {
 	return &gptp_domain;
@@ -470,6 +470,29 @@ struct gptp_port_ds {
 	bool neighbor_rate_ratio_valid : 1;
 };
 
+/**
+ * @brief Running statistics of a measured time.
+ *
+ * Mean and variance are updated with Welford's algorithm, all the values
+ * are in nanoseconds.
+ */
+struct gptp_stat_var {
+	/** Number of samples. */
+	uint32_t count;
+
+	/** Mean of the samples. */
+	double mean;
+
+	/** Sum of the squared differences from the mean. */
+	double m2;
+
+	/** Smallest sample. */
+	double min;
+
+	/** Largest sample. */
+	double max;
+};
+
 /**
  * @brief Port Parameter Statistics.
  *
@@ -526,6 +549,12 @@ struct gptp_port_param_ds {
 
 	/** Neighbor propagation delay threshold exceeded. */
 	uint32_t neighbor_prop_delay_exceeded;
+
+	/** Offset of the local clock from the master clock. */
+	struct gptp_stat_var offset;
+
+	/** Neighbor propagation delay. */
+	struct gptp_stat_var path_delay;
 };
 
 /**
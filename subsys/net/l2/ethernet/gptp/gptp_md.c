@@ -376,6 +376,9 @@ static void gptp_md_pdelay_compute(int port)
 
 		NET_DBG("Neighbor prop delay %d",
 			(int32_t)port_ds->neighbor_prop_delay);
+
+		GPTP_STATS_SAMPLE(port, path_delay,
+				  port_ds->neighbor_prop_delay);
 	}
 
 	state->lost_responses = 0U;
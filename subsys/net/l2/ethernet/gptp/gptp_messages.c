@@ -103,6 +103,13 @@ static void gptp_sync_timestamp_callback(struct net_pkt *pkt)
 
 		/* The pkt was ref'ed in gptp_send_sync() */
 		net_pkt_unref(pkt);
+
+#if defined(CONFIG_NET_PKT_TIMESTAMP_DIRECT)
+		/* Called by the driver, let the state machine send the
+		 * Follow Up now instead of at the next thread timeout.
+		 */
+		k_fifo_cancel_wait(&gptp_rx_queue);
+#endif
 	}
 }
 
@@ -827,10 +834,19 @@ void gptp_handle_signaling(int port, struct net_pkt *pkt)
 void gptp_send_sync(int port, struct net_pkt *pkt)
 {
 	if (!sync_cb_registered) {
+#if defined(CONFIG_NET_PKT_TIMESTAMP_DIRECT)
+		/* The callback only flags the timestamp to the state
+		 * machine, it is safe to call from the driver.
+		 */
+		net_if_register_timestamp_cb_direct(
+			&sync_timestamp_cb, pkt, net_pkt_iface(pkt),
+			gptp_sync_timestamp_callback);
+#else
 		net_if_register_timestamp_cb(&sync_timestamp_cb,
 					     pkt,
 					     net_pkt_iface(pkt),
 					     gptp_sync_timestamp_callback);
+#endif
 		sync_cb_registered = true;
 	}
 
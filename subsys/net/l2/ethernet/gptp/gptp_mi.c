@@ -733,6 +733,72 @@ static void gptp_mi_clk_slave_sync_compute(void)
 	offset_state->rcvd_sync_receipt_time = true;
 }
 
+#if defined(CONFIG_NET_GPTP_PI_SERVO)
+#define GPTP_PI_SERVO_KP (CONFIG_NET_GPTP_PI_SERVO_KP / 1000.0)
+#define GPTP_PI_SERVO_KI (CONFIG_NET_GPTP_PI_SERVO_KI / 1000.0)
+#define GPTP_PI_SERVO_MAX_PPB ((double)CONFIG_NET_GPTP_PI_SERVO_MAX_PPB)
+
+static struct {
+	/* Integral term, in ppb */
+	double drift_ppb;
+	/* Correction currently applied on top of the rate ratio, in ppb */
+	double applied_ppb;
+	/* Local time of the previous update, 0 if none */
+	uint64_t last_local_time;
+} pi_servo;
+
+/* The neighbor rate ratio corrects the frequency of the local clock, the
+ * servo adds a correction proportional to the offset and to its integral
+ * to bring the phase in. The clock driver applies rate changes relative
+ * to its current rate, so only the change of the correction is applied.
+ */
+static void gptp_pi_servo_update(struct device *clk, double rate_ratio,
+				 int64_t offset, uint64_t local_time)
+{
+	double interval = 1.0;
+	double ki_term;
+	double ppb;
+
+	if (pi_servo.last_local_time != 0U &&
+	    local_time > pi_servo.last_local_time) {
+		interval = (double)(local_time - pi_servo.last_local_time) /
+			NSEC_PER_SEC;
+	}
+
+	pi_servo.last_local_time = local_time;
+
+	ki_term = GPTP_PI_SERVO_KI * offset * interval;
+	ppb = GPTP_PI_SERVO_KP * offset + pi_servo.drift_ppb + ki_term;
+
+	/* Do not integrate while the output is saturated */
+	if (ppb > GPTP_PI_SERVO_MAX_PPB) {
+		ppb = GPTP_PI_SERVO_MAX_PPB;
+	} else if (ppb < -GPTP_PI_SERVO_MAX_PPB) {
+		ppb = -GPTP_PI_SERVO_MAX_PPB;
+	} else {
+		pi_servo.drift_ppb += ki_term;
+	}
+
+	rate_ratio *= (NSEC_PER_SEC + ppb) /
+		(NSEC_PER_SEC + pi_servo.applied_ppb);
+	pi_servo.applied_ppb = ppb;
+
+	ptp_clock_rate_adjust(clk, rate_ratio);
+}
+
+/* Remove the servo correction, the clock is about to be set. */
+static double gptp_pi_servo_reset(double rate_ratio)
+{
+	rate_ratio *= NSEC_PER_SEC / (NSEC_PER_SEC + pi_servo.applied_ppb);
+
+	pi_servo.drift_ppb = 0;
+	pi_servo.applied_ppb = 0;
+	pi_servo.last_local_time = 0U;
+
+	return rate_ratio;
+}
+#endif /* CONFIG_NET_GPTP_PI_SERVO */
+
 #if defined(CONFIG_NET_GPTP_USE_DEFAULT_CLOCK_UPDATE)
 static void gptp_update_local_port_clock(void)
 {
@@ -744,6 +810,7 @@ static void gptp_update_local_port_clock(void)
 	int64_t second_diff;
 	struct device *clk;
 	struct net_ptp_time tm;
+	double rate_ratio;
 	int key;
 
 	state = &GPTP_STATE()->clk_slave_sync;
@@ -781,14 +848,31 @@ static void gptp_update_local_port_clock(void)
 		nanosecond_diff = -NSEC_PER_SEC + nanosecond_diff;
 	}
 
-	ptp_clock_rate_adjust(clk, port_ds->neighbor_rate_ratio);
+	GPTP_STATS_SAMPLE(port, offset,
+			  (double)second_diff * NSEC_PER_SEC + nanosecond_diff);
+
+	rate_ratio = port_ds->neighbor_rate_ratio;
+
+#if defined(CONFIG_NET_GPTP_PI_SERVO)
+	if (second_diff == 0 &&
+	    nanosecond_diff >= -GPTP_CLOCK_STEP_THRESHOLD_NS &&
+	    nanosecond_diff <= GPTP_CLOCK_STEP_THRESHOLD_NS) {
+		gptp_pi_servo_update(clk, rate_ratio, nanosecond_diff,
+				     global_ds->sync_receipt_local_time);
+		return;
+	}
+
+	rate_ratio = gptp_pi_servo_reset(rate_ratio);
+#endif
+
+	ptp_clock_rate_adjust(clk, rate_ratio);
 
 	/* If time difference is too high, set the clock value.
 	 * Otherwise, adjust it.
 	 */
 	if (second_diff || (second_diff == 0 &&
-			    (nanosecond_diff < -5000 ||
-			     nanosecond_diff > 5000))) {
+			    (nanosecond_diff < -GPTP_CLOCK_STEP_THRESHOLD_NS ||
+			     nanosecond_diff > GPTP_CLOCK_STEP_THRESHOLD_NS))) {
 		bool underflow = false;
 
 		key = irq_lock();
@@ -24,12 +24,44 @@ extern "C" {
 #define GPTP_THREAD_WAIT_TIMEOUT_MS 1
 #define GPTP_MULTIPLE_PDELAY_RESP_WAIT (5 * 60 * MSEC_PER_SEC)
 
+/* Offset above which the local clock is set instead of adjusted. */
+#define GPTP_CLOCK_STEP_THRESHOLD_NS 5000
+
 #if defined(CONFIG_NET_GPTP_STATISTICS)
 #define GPTP_STATS_INC(port, var) (GPTP_PORT_PARAM_DS(port)->var++)
+#define GPTP_STATS_SAMPLE(port, var, value) \
+	gptp_stat_var_add(&GPTP_PORT_PARAM_DS(port)->var, value)
 #else
 #define GPTP_STATS_INC(port, var)
+#define GPTP_STATS_SAMPLE(port, var, value)
 #endif
 
+/* Wakes the gPTP thread up when the TX timestamps are delivered directly
+ * from the driver.
+ */
+extern struct k_fifo gptp_rx_queue;
+
+#if defined(CONFIG_NET_GPTP_STATISTICS)
+struct gptp_stat_var;
+
+/**
+ * @brief Add a sample to running statistics.
+ *
+ * @param stat Statistics to update.
+ * @param value Sample, in nanoseconds.
+ */
+void gptp_stat_var_add(struct gptp_stat_var *stat, double value);
+
+/**
+ * @brief Get the variance of running statistics.
+ *
+ * @param stat Statistics.
+ *
+ * @return Sample variance, in square nanoseconds.
+ */
+double gptp_stat_var_get(const struct gptp_stat_var *stat);
+#endif /* CONFIG_NET_GPTP_STATISTICS */
+
 /**
  * @brief Is a slave acting as a slave.
  *
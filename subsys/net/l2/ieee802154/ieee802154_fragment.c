@@ -42,6 +42,7 @@ static uint16_t datagram_tag;
  *  IPv6 packets simultaneously.
  */
 struct frag_cache {
+	sys_snode_t node;		/* Node in the hash bucket */
 	struct k_delayed_work timer;	/* Reassemble timer */
 	struct net_pkt *pkt;		/* Reassemble packet */
 	uint16_t size;			/* Datagram size */
@@ -51,6 +52,14 @@ struct frag_cache {
 
 static struct frag_cache cache[REASS_CACHE_SIZE];
 
+/* Used caches indexed by datagram tag */
+static sys_slist_t reass_hash[REASS_CACHE_SIZE];
+
+static inline sys_slist_t *reass_hash_bucket(uint16_t tag)
+{
+	return &reass_hash[tag % REASS_CACHE_SIZE];
+}
+
 /**
  *  RFC 4944, section 5.3
  *  If an entire payload (e.g., IPv6) datagram fits within a single 802.15.4
@@ -255,25 +264,18 @@ static void update_protocol_header_lengths(struct net_pkt *pkt, uint16_t size)
 	}
 }
 
-static inline void clear_reass_cache(uint16_t size, uint16_t tag)
+static inline void release_reass_cache(struct frag_cache *cache)
 {
-	uint8_t i;
+	sys_slist_find_and_remove(reass_hash_bucket(cache->tag), &cache->node);
 
-	for (i = 0U; i < REASS_CACHE_SIZE; i++) {
-		if (!(cache[i].size == size && cache[i].tag == tag)) {
-			continue;
-		}
-
-		if (cache[i].pkt) {
-			net_pkt_unref(cache[i].pkt);
-		}
-
-		cache[i].pkt = NULL;
-		cache[i].size = 0U;
-		cache[i].tag = 0U;
-		cache[i].used = false;
-		k_delayed_work_cancel(&cache[i].timer);
+	if (cache->pkt) {
+		net_pkt_unref(cache->pkt);
 	}
+
+	cache->pkt = NULL;
+	cache->size = 0U;
+	cache->tag = 0U;
+	cache->used = false;
 }
 
 /**
@@ -284,14 +286,7 @@ static void reass_timeout(struct k_work *work)
 {
 	struct frag_cache *cache = CONTAINER_OF(work, struct frag_cache, timer);
 
-	if (cache->pkt) {
-		net_pkt_unref(cache->pkt);
-	}
-
-	cache->pkt = NULL;
-	cache->size = 0U;
-	cache->tag = 0U;
-	cache->used = false;
+	release_reass_cache(cache);
 }
 
 /**
@@ -314,6 +309,8 @@ static inline struct frag_cache *set_reass_cache(struct net_pkt *pkt,
 		cache[i].tag = tag;
 		cache[i].used = true;
 
+		sys_slist_prepend(reass_hash_bucket(tag), &cache[i].node);
+
 		k_delayed_work_init(&cache[i].timer, reass_timeout);
 		k_delayed_work_submit(&cache[i].timer, FRAG_REASSEMBLY_TIMEOUT);
 		return &cache[i];
@@ -328,14 +325,11 @@ static inline struct frag_cache *set_reass_cache(struct net_pkt *pkt,
  */
 static inline struct frag_cache *get_reass_cache(uint16_t size, uint16_t tag)
 {
-	uint8_t i;
+	struct frag_cache *cache;
 
-	for (i = 0U; i < REASS_CACHE_SIZE; i++) {
-		if (cache[i].used) {
-			if (cache[i].size == size &&
-			    cache[i].tag == tag) {
-				return &cache[i];
-			}
+	SYS_SLIST_FOR_EACH_CONTAINER(reass_hash_bucket(tag), cache, node) {
+		if (cache->size == size && cache->tag == tag) {
+			return cache;
 		}
 	}
 
@@ -440,8 +434,10 @@ static inline void fragment_remove_headers(struct net_pkt *pkt)
 			hdr_len = NET_6LO_FRAG1_HDR_LEN;
 		}
 
-		memmove(frag->data, frag->data + hdr_len, frag->len - hdr_len);
-		frag->len -= hdr_len;
+		/* The payload stays in place, the header becomes headroom
+		 * that uncompressing the IPv6 header can reuse.
+		 */
+		net_buf_pull(frag, hdr_len);
 
 		frag = frag->frags;
 	}
@@ -522,7 +518,8 @@ static inline enum net_verdict fragment_add_to_cache(struct net_pkt *pkt)
 		fragment_reconstruct_packet(pkt);
 
 		/* Once reassemble is done, cache is no longer needed. */
-		clear_reass_cache(size, tag);
+		k_delayed_work_cancel(&cache->timer);
+		release_reass_cache(cache);
 
 		if (!net_6lo_uncompress(pkt)) {
 			NET_ERR("Could not uncompress. Bogus packet?");
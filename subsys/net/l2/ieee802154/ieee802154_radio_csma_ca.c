@@ -20,6 +20,35 @@ LOG_MODULE_REGISTER(net_ieee802154_csma, CONFIG_NET_L2_IEEE802154_LOG_LEVEL);
 #include "ieee802154_utils.h"
 #include "ieee802154_radio_utils.h"
 
+/* The radio does the backoffs and the CCA, and possibly waits for the ACK,
+ * the transmission only blocks on the radio driver.
+ */
+static inline int csma_ca_hw_radio_send(struct net_if *iface,
+					struct net_pkt *pkt,
+					struct net_buf *frag,
+					bool ack_required)
+{
+	uint8_t retries = CONFIG_NET_L2_IEEE802154_RADIO_TX_RETRIES;
+	int ret = -EIO;
+
+	while (retries) {
+		retries--;
+
+		ret = ieee802154_tx(iface, IEEE802154_TX_MODE_CSMA_CA,
+				    pkt, frag);
+		if (ret) {
+			continue;
+		}
+
+		ret = wait_for_ack(iface, ack_required);
+		if (!ret) {
+			break;
+		}
+	}
+
+	return ret;
+}
+
 static inline int csma_ca_radio_send(struct net_if *iface,
 				     struct net_pkt *pkt,
 				     struct net_buf *frag)
@@ -28,24 +57,41 @@ static inline int csma_ca_radio_send(struct net_if *iface,
 	const uint8_t max_be = CONFIG_NET_L2_IEEE802154_RADIO_CSMA_CA_MAX_BE;
 	uint8_t retries = CONFIG_NET_L2_IEEE802154_RADIO_TX_RETRIES;
 	struct ieee802154_context *ctx = net_if_l2_data(iface);
-	bool ack_required = prepare_for_ack(ctx, pkt, frag);
-	uint8_t be = CONFIG_NET_L2_IEEE802154_RADIO_CSMA_CA_MIN_BE;
-	uint8_t nb = 0U;
+	enum ieee802154_hw_caps caps = ieee802154_get_hw_capabilities(iface);
+	bool ack_required;
+	uint8_t be;
+	uint8_t nb;
 	int ret = -EIO;
 
 	NET_DBG("frag %p", frag);
 
+	/* No need to track the ACK when the radio handles it */
+	if (caps & IEEE802154_HW_TX_RX_ACK) {
+		ack_required = false;
+	} else {
+		ack_required = prepare_for_ack(ctx, pkt, frag);
+	}
+
+	if (caps & IEEE802154_HW_CSMA) {
+		return csma_ca_hw_radio_send(iface, pkt, frag, ack_required);
+	}
+
 loop:
 	while (retries) {
 		retries--;
 
-		if (be) {
-			uint8_t bo_n = sys_rand32_get() & ((1 << be) - 1);
-
-			k_busy_wait(bo_n * 20U);
-		}
+		/* Each transmission attempt starts a new CSMA-CA run */
+		be = CONFIG_NET_L2_IEEE802154_RADIO_CSMA_CA_MIN_BE;
+		nb = 0U;
 
 		while (1) {
+			if (be) {
+				uint8_t bo_n = sys_rand32_get() &
+					((1 << be) - 1);
+
+				k_busy_wait(bo_n * 20U);
+			}
+
 			if (!ieee802154_cca(iface)) {
 				break;
 			}
@@ -54,6 +100,8 @@ loop:
 			nb++;
 
 			if (nb > max_bo) {
+				/* Channel access failure */
+				ret = -EBUSY;
 				goto loop;
 			}
 		}
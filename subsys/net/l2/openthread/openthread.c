@@ -180,9 +180,17 @@ static void ot_receive_handler(otMessage *aMessage, void *context)
 
 	uint16_t offset = 0U;
 	uint16_t read_len;
-	struct net_pkt *pkt;
+	struct net_pkt *pkt = NULL;
 	struct net_buf *pkt_buf;
 
+	/* Do not copy a message which would be dropped anyway, this
+	 * happens with bursts of multicast traffic.
+	 */
+	if (pkt_list_is_full(ot_context)) {
+		NET_INFO("Packet list is full");
+		goto out;
+	}
+
 	pkt = net_pkt_rx_alloc_with_buffer(ot_context->iface,
 					   otMessageGetLength(aMessage),
 					   AF_UNSPEC, 0, K_NO_WAIT);
@@ -220,22 +228,18 @@ static void ot_receive_handler(otMessage *aMessage, void *context)
 		net_pkt_hexdump(pkt, "Received IPv6 packet");
 	}
 
-	if (!pkt_list_is_full(ot_context)) {
-		if (pkt_list_add(ot_context, pkt) != 0) {
-			NET_ERR("pkt_list_add failed");
-			goto out;
-		}
-
-		if (net_recv_data(ot_context->iface, pkt) < 0) {
-			NET_ERR("net_recv_data failed");
-			pkt_list_remove_first(ot_context);
-			goto out;
-		}
+	if (pkt_list_add(ot_context, pkt) != 0) {
+		NET_ERR("pkt_list_add failed");
+		goto out;
+	}
 
-		pkt = NULL;
-	} else {
-		NET_INFO("Packet list is full");
+	if (net_recv_data(ot_context->iface, pkt) < 0) {
+		NET_ERR("net_recv_data failed");
+		pkt_list_remove_first(ot_context);
+		goto out;
 	}
+
+	pkt = NULL;
 out:
 	if (pkt) {
 		net_pkt_unref(pkt);
@@ -266,11 +270,17 @@ static void openthread_process(void *context, void *arg2, void *arg3)
 	while (1) {
 		openthread_api_mutex_lock(ot_context);
 
-		while (otTaskletsArePending(ot_context->instance)) {
-			otTaskletsProcess(ot_context->instance);
-		}
+		/* Processing the driver events, e.g. the received frames,
+		 * schedules new tasklets. Run them in the same batch rather
+		 * than after another round trip through ot_sem.
+		 */
+		do {
+			while (otTaskletsArePending(ot_context->instance)) {
+				otTaskletsProcess(ot_context->instance);
+			}
 
-		otSysProcessDrivers(ot_context->instance);
+			otSysProcessDrivers(ot_context->instance);
+		} while (otTaskletsArePending(ot_context->instance));
 
 		openthread_api_mutex_unlock(ot_context);
 
@@ -580,3 +580,49 @@ int dns_unpack_query(struct dns_msg_t *dns_msg, struct net_buf *buf,
 
 	return ret;
 }
+
+int mdns_unpack_answer(struct dns_msg_t *dns_msg, struct net_buf *buf,
+		       enum dns_rr_type *type, uint32_t *ttl,
+		       const uint8_t **rdata, uint16_t *rdlength)
+{
+	const uint8_t *end_of_label;
+	const uint8_t *fields;
+	int remaining_size;
+	uint16_t len;
+	int ret;
+
+	ret = dns_unpack_name(dns_msg->msg, dns_msg->msg_size,
+			      dns_msg->msg + dns_msg->answer_offset,
+			      buf, &end_of_label);
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* TYPE, CLASS, TTL and RDLENGTH, see RFC 1035 ch 4.1.3 */
+	fields = end_of_label;
+	remaining_size = dns_msg->msg + dns_msg->msg_size - fields;
+	if (remaining_size < DNS_QTYPE_LEN + DNS_QCLASS_LEN + DNS_TTL_LEN +
+			     DNS_RDLENGTH_LEN) {
+		return -EMSGSIZE;
+	}
+
+	*type = dns_unpack_query_qtype(fields);
+	fields += DNS_QTYPE_LEN + DNS_QCLASS_LEN;
+
+	*ttl = ntohl(UNALIGNED_GET((uint32_t *)fields));
+	fields += DNS_TTL_LEN;
+
+	len = ntohs(UNALIGNED_GET((uint16_t *)fields));
+	fields += DNS_RDLENGTH_LEN;
+
+	if (dns_msg->msg + dns_msg->msg_size - fields < len) {
+		return -EMSGSIZE;
+	}
+
+	*rdata = fields;
+	*rdlength = len;
+
+	dns_msg->answer_offset = fields + len - dns_msg->msg;
+
+	return ret;
+}
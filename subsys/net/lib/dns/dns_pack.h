@@ -396,4 +396,23 @@ int dns_unpack_query(struct dns_msg_t *dns_msg, struct net_buf *buf,
 		     enum dns_rr_type *qtype,
 		     enum dns_class *qclass);
 
+/**
+ * @brief Unpacks a resource record of a mDNS query answer section.
+ *
+ * The record is read at dns_msg->answer_offset, which is then moved to
+ * the next record.
+ *
+ * @param dns_msg Structure containing the message.
+ * @param buf Result buf, receives the name of the record
+ * @param type Record type is returned to caller
+ * @param ttl Record TTL is returned to caller
+ * @param rdata Record data is returned to caller, pointing into the message
+ * @param rdlength Record data length is returned to caller
+ * @retval Length of the name on success
+ * @retval -EMSGSIZE if the record does not fit in the message.
+ */
+int mdns_unpack_answer(struct dns_msg_t *dns_msg, struct net_buf *buf,
+		       enum dns_rr_type *type, uint32_t *ttl,
+		       const uint8_t **rdata, uint16_t *rdlength);
+
 #endif
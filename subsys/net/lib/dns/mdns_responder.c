@@ -51,6 +51,40 @@ static struct net_context *ipv6;
 NET_BUF_POOL_DEFINE(mdns_msg_pool, DNS_RESOLVER_BUF_CTR,
 		    DNS_RESOLVER_MAX_BUF_SIZE, 0, NULL);
 
+#define MDNS_ANSWER_INTERVAL CONFIG_MDNS_RESPONDER_ANSWER_INTERVAL
+
+/* The hostname gets the link address in hex appended when unique */
+#if defined(CONFIG_NET_HOSTNAME_UNIQUE)
+#define MDNS_HOSTNAME_MAX_LEN (sizeof(CONFIG_NET_HOSTNAME) - 1 + 8 * 2)
+#else
+#define MDNS_HOSTNAME_MAX_LEN (sizeof(CONFIG_NET_HOSTNAME) - 1)
+#endif
+
+/* Header, packed "<hostname>.local", TYPE, CLASS, TTL, RDLENGTH and an
+ * address
+ */
+#define MDNS_RESPONSE_MAX_LEN (DNS_MSG_HEADER_SIZE +			\
+			       MDNS_HOSTNAME_MAX_LEN + sizeof(".local") + 1 + \
+			       DNS_QTYPE_LEN + DNS_QCLASS_LEN +		\
+			       DNS_TTL_LEN + DNS_RDLENGTH_LEN +		\
+			       sizeof(struct in6_addr))
+
+/* Prebuilt answer for a record of our hostname on an interface */
+struct mdns_record {
+	struct net_if *iface;
+	int64_t last_sent;
+	enum dns_rr_type type;
+	uint16_t len;
+	uint16_t addr_len;
+	bool sent;
+	uint8_t addr[sizeof(struct in6_addr)];
+	uint8_t pkt[MDNS_RESPONSE_MAX_LEN];
+};
+
+static struct mdns_record records[CONFIG_MDNS_RESPONDER_RECORDS];
+static char records_hostname[MDNS_HOSTNAME_MAX_LEN + 1];
+static K_MUTEX_DEFINE(records_lock);
+
 #if defined(CONFIG_NET_IPV6)
 static void create_ipv6_addr(struct sockaddr_in6 *addr)
 {
@@ -137,103 +171,157 @@ static void setup_dns_hdr(uint8_t *buf, uint16_t answers)
 	UNALIGNED_PUT(0, (uint16_t *)(buf + offset));
 }
 
-static void add_answer(struct net_buf *query, enum dns_rr_type qtype,
-		       uint32_t ttl, uint16_t addr_len, uint8_t *addr)
+/* Our own name, as unpacked from a message: ".<hostname>.local" */
+static bool is_own_name(struct net_buf *name, const char *hostname,
+			size_t hostname_len)
 {
-	char *dot = query->data + DNS_MSG_HEADER_SIZE;
-	char *prev = NULL;
+	return name->len == hostname_len + sizeof(".local") &&
+		!strncasecmp(hostname, name->data + 1, hostname_len) &&
+		!strcasecmp(name->data + 1 + hostname_len, ".local");
+}
+
+static struct mdns_record *get_record(struct net_if *iface,
+				      enum dns_rr_type type,
+				      const uint8_t *addr, uint16_t addr_len)
+{
+	const char *hostname = net_hostname_get();
+	struct mdns_record *rec = NULL;
+	char name[MDNS_HOSTNAME_MAX_LEN + sizeof(".local")];
 	uint16_t offset;
+	uint16_t len;
+	int i;
 
-	while ((dot = strchr(dot, '.'))) {
-		if (!prev) {
-			prev = dot++;
-			continue;
+	/* Prebuilt answers carry the hostname, drop them all if it changed */
+	if (strcmp(records_hostname, hostname)) {
+		for (i = 0; i < ARRAY_SIZE(records); i++) {
+			records[i].iface = NULL;
+		}
+
+		strncpy(records_hostname, hostname,
+			sizeof(records_hostname) - 1);
+	}
+
+	for (i = 0; i < ARRAY_SIZE(records); i++) {
+		if (records[i].iface == iface && records[i].type == type) {
+			rec = &records[i];
+			break;
 		}
 
-		*prev = dot - prev - 1;
-		prev = dot++;
+		/* Otherwise reuse a free or the least recently sent record */
+		if (rec == NULL || (rec->iface != NULL &&
+				    (records[i].iface == NULL ||
+				     records[i].last_sent < rec->last_sent))) {
+			rec = &records[i];
+		}
 	}
 
-	if (prev) {
-		*prev = strlen(prev) - 1;
+	if (rec->iface == iface && rec->type == type &&
+	    rec->addr_len == addr_len && !memcmp(rec->addr, addr, addr_len)) {
+		return rec;
 	}
 
-	/* terminator byte (0x00) */
-	query->len += 1;
+	rec->iface = NULL;
+
+	snprintk(name, sizeof(name), "%s.local", hostname);
+
+	setup_dns_hdr(rec->pkt, 1);
+	offset = DNS_MSG_HEADER_SIZE;
+
+	if (dns_msg_pack_qname(&len, rec->pkt + offset,
+			       sizeof(rec->pkt) - offset, name) < 0 ||
+	    sizeof(rec->pkt) - offset - len < DNS_QTYPE_LEN + DNS_QCLASS_LEN +
+					      DNS_TTL_LEN + DNS_RDLENGTH_LEN +
+					      addr_len) {
+		return NULL;
+	}
 
-	offset = DNS_MSG_HEADER_SIZE + query->len;
-	UNALIGNED_PUT(htons(qtype), (uint16_t *)(query->data+offset));
+	offset += len;
+	UNALIGNED_PUT(htons(type), (uint16_t *)(rec->pkt + offset));
 
 	/* Bit 15 tells to flush the cache */
 	offset += DNS_QTYPE_LEN;
 	UNALIGNED_PUT(htons(DNS_CLASS_IN | BIT(15)),
-		      (uint16_t *)(query->data+offset));
-
+		      (uint16_t *)(rec->pkt + offset));
 
 	offset += DNS_QCLASS_LEN;
-	UNALIGNED_PUT(htonl(ttl), query->data + offset);
+	UNALIGNED_PUT(htonl(MDNS_TTL), (uint32_t *)(rec->pkt + offset));
 
 	offset += DNS_TTL_LEN;
-	UNALIGNED_PUT(htons(addr_len), query->data + offset);
+	UNALIGNED_PUT(htons(addr_len), (uint16_t *)(rec->pkt + offset));
 
 	offset += DNS_RDLENGTH_LEN;
-	memcpy(query->data + offset, addr, addr_len);
+	memcpy(rec->pkt + offset, addr, addr_len);
+
+	rec->len = offset + addr_len;
+	memcpy(rec->addr, addr, addr_len);
+	rec->addr_len = addr_len;
+	rec->type = type;
+	rec->sent = false;
+	rec->last_sent = 0;
+	rec->iface = iface;
+
+	return rec;
 }
 
-static int create_answer(struct net_context *ctx,
-			 struct net_buf *query,
-			 enum dns_rr_type qtype,
-			 uint16_t addr_len, uint8_t *addr)
+/* RFC 6762 ch 7.1: no answer if the querier already knows it, with at
+ * least half of its TTL left.
+ */
+static bool is_known_answer(struct dns_msg_t *dns_msg, struct net_buf *name,
+			    struct mdns_record *rec)
 {
-	/* Prepare the response into the query buffer: move the name
-	 * query buffer has to get enough free space: dns_hdr + answer
-	 */
-	if ((query->size - query->len) < (DNS_MSG_HEADER_SIZE +
-					  DNS_QTYPE_LEN + DNS_QCLASS_LEN +
-					  DNS_TTL_LEN + DNS_RDLENGTH_LEN +
-					  addr_len)) {
-		return -ENOBUFS;
-	}
+	const char *hostname = net_hostname_get();
+	size_t hostname_len = strlen(hostname);
+	int answers = dns_unpack_header_ancount(dns_msg->msg);
+	enum dns_rr_type type;
+	const uint8_t *rdata;
+	uint16_t rdlength;
+	uint32_t ttl;
 
-	memmove(query->data + DNS_MSG_HEADER_SIZE, query->data, query->len);
+	dns_msg->answer_offset = dns_msg->query_offset;
 
-	setup_dns_hdr(query->data, 1);
+	while (answers-- > 0) {
+		name->len = 0U;
 
-	add_answer(query, qtype, MDNS_TTL, addr_len, addr);
+		if (mdns_unpack_answer(dns_msg, name, &type, &ttl, &rdata,
+				       &rdlength) < 0) {
+			break;
+		}
 
-	query->len += DNS_MSG_HEADER_SIZE +
-		DNS_QTYPE_LEN + DNS_QCLASS_LEN +
-		DNS_TTL_LEN + DNS_RDLENGTH_LEN + addr_len;
+		if (type == rec->type && ttl >= MDNS_TTL / 2 &&
+		    rdlength == rec->addr_len &&
+		    !memcmp(rdata, rec->addr, rdlength) &&
+		    is_own_name(name, hostname, hostname_len)) {
+			return true;
+		}
+	}
 
-	return 0;
+	return false;
 }
 
 static int send_response(struct net_context *ctx,
 			 struct net_pkt *pkt,
 			 union net_ip_header *ip_hdr,
-			 struct net_buf *query,
+			 struct dns_msg_t *dns_msg,
+			 struct net_buf *name,
 			 enum dns_rr_type qtype)
 {
+	struct mdns_record *rec;
+	const uint8_t *addr;
+	uint16_t addr_len;
 	struct sockaddr dst;
 	socklen_t dst_len;
+	int64_t now;
 	int ret;
 
 	if (qtype == DNS_RR_TYPE_A) {
 #if defined(CONFIG_NET_IPV4)
-		const struct in_addr *addr;
-
-		addr = net_if_ipv4_select_src_addr(net_pkt_iface(pkt),
-						   &ip_hdr->ipv4->src);
+		addr = (const uint8_t *)net_if_ipv4_select_src_addr(
+			net_pkt_iface(pkt), &ip_hdr->ipv4->src);
+		addr_len = sizeof(struct in_addr);
 
 		create_ipv4_addr(net_sin(&dst));
 		dst_len = sizeof(struct sockaddr_in);
 
-		ret = create_answer(ctx, query, qtype,
-				      sizeof(struct in_addr), (uint8_t *)addr);
-		if (ret != 0) {
-			return ret;
-		}
-
 		net_context_set_ipv4_ttl(ctx, 255);
 #else /* CONFIG_NET_IPV4 */
 		return -EPFNOSUPPORT;
@@ -241,20 +329,13 @@ static int send_response(struct net_context *ctx,
 
 	} else if (qtype == DNS_RR_TYPE_AAAA) {
 #if defined(CONFIG_NET_IPV6)
-		const struct in6_addr *addr;
-
-		addr = net_if_ipv6_select_src_addr(net_pkt_iface(pkt),
-						   &ip_hdr->ipv6->src);
+		addr = (const uint8_t *)net_if_ipv6_select_src_addr(
+			net_pkt_iface(pkt), &ip_hdr->ipv6->src);
+		addr_len = sizeof(struct in6_addr);
 
 		create_ipv6_addr(net_sin6(&dst));
 		dst_len = sizeof(struct sockaddr_in6);
 
-		ret = create_answer(ctx, query, qtype,
-				      sizeof(struct in6_addr), (uint8_t *)addr);
-		if (ret != 0) {
-			return -ENOMEM;
-		}
-
 		net_context_set_ipv6_hop_limit(ctx, 255);
 #else /* CONFIG_NET_IPV6 */
 		return -EPFNOSUPPORT;
@@ -265,12 +346,48 @@ static int send_response(struct net_context *ctx,
 		return -EINVAL;
 	}
 
-	ret = net_context_sendto(ctx, query->data, query->len, &dst,
+	if (!addr) {
+		return -EADDRNOTAVAIL;
+	}
+
+	k_mutex_lock(&records_lock, K_FOREVER);
+
+	rec = get_record(net_pkt_iface(pkt), qtype, addr, addr_len);
+	if (!rec) {
+		ret = -ENOBUFS;
+		goto unlock;
+	}
+
+	/* RFC 6762 ch 6: the same record is multicast at most once per
+	 * interval on an interface.
+	 */
+	now = k_uptime_get();
+	if (rec->sent && now - rec->last_sent < MDNS_ANSWER_INTERVAL) {
+		NET_DBG("mDNS answer sent %d ms ago, skipped",
+			(int)(now - rec->last_sent));
+		ret = 0;
+		goto unlock;
+	}
+
+	if (is_known_answer(dns_msg, name, rec)) {
+		NET_DBG("mDNS answer already known, skipped");
+		ret = 0;
+		goto unlock;
+	}
+
+	ret = net_context_sendto(ctx, rec->pkt, rec->len, &dst,
 				 dst_len, NULL, K_NO_WAIT, NULL);
 	if (ret < 0) {
 		NET_DBG("Cannot send mDNS reply (%d)", ret);
+		goto unlock;
 	}
 
+	rec->sent = true;
+	rec->last_sent = now;
+
+unlock:
+	k_mutex_unlock(&records_lock);
+
 	return ret;
 }
 
@@ -285,6 +402,8 @@ static int dns_read(struct net_context *ctx,
 	int hostname_len = strlen(hostname);
 	struct net_buf *result;
 	struct dns_msg_t dns_msg;
+	bool want_aaaa = false;
+	bool want_a = false;
 	int data_len;
 	int queries;
 	int ret;
@@ -347,19 +466,30 @@ static int dns_read(struct net_context *ctx,
 			qtype == DNS_RR_TYPE_A ? "A" : "AAAA", "IN",
 			log_strdup(result->data), ret);
 
-		/* If the query matches to our hostname, then send reply.
-		 * We skip the first dot, and make sure there is dot after
-		 * matching hostname.
+		/* If the query matches to our hostname, then send reply once
+		 * the known answers, after all the questions, can be checked.
 		 */
-		if (!strncasecmp(hostname, result->data + 1, hostname_len) &&
-		    (result->len - 1) >= hostname_len &&
-		    &(result->data + 1)[hostname_len] == lquery) {
+		if (is_own_name(result, hostname, hostname_len)) {
 			NET_DBG("mDNS query to our hostname %s.local",
 				hostname);
-			send_response(ctx, pkt, ip_hdr, result, qtype);
+			if (qtype == DNS_RR_TYPE_A) {
+				want_a = true;
+			} else {
+				want_aaaa = true;
+			}
 		}
 	} while (--queries);
 
+	if (want_a) {
+		send_response(ctx, pkt, ip_hdr, &dns_msg, result,
+			      DNS_RR_TYPE_A);
+	}
+
+	if (want_aaaa) {
+		send_response(ctx, pkt, ip_hdr, &dns_msg, result,
+			      DNS_RR_TYPE_AAAA);
+	}
+
 	ret = 0;
 
 quit:
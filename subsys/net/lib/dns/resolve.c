@@ -330,6 +330,264 @@ int dns_resolve_init(struct dns_resolve_context *ctx, const char *servers[],
 	return 0;
 }
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+struct dns_cache_entry {
+	/* Uptime (in ms) when the entry expires, 0 if it is free */
+	int64_t expires;
+	struct sockaddr addrs[CONFIG_DNS_RESOLVER_CACHE_MAX_ADDRESSES];
+	enum dns_query_type type;
+	/* DNS_EAI_ALLDONE for a positive answer */
+	enum dns_resolve_status status;
+	uint8_t count;
+	char name[DNS_MAX_NAME_LEN + 1];
+};
+
+static struct dns_cache_entry dns_cache[CONFIG_DNS_RESOLVER_CACHE_SIZE];
+static struct k_spinlock dns_cache_lock;
+
+static struct dns_cache_entry *dns_cache_find(const char *name,
+					      enum dns_query_type type,
+					      int64_t now)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_DNS_RESOLVER_CACHE_SIZE; i++) {
+		if (dns_cache[i].expires <= now ||
+		    dns_cache[i].type != type) {
+			continue;
+		}
+
+		if (!strcmp(dns_cache[i].name, name)) {
+			return &dns_cache[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void dns_cache_put(const char *name, enum dns_query_type type,
+			  enum dns_resolve_status status,
+			  const struct sockaddr *addrs, int count,
+			  uint32_t ttl)
+{
+	struct dns_cache_entry *entry;
+	k_spinlock_key_t key;
+	size_t len;
+	int64_t now;
+	int i;
+
+	len = strlen(name);
+	if (ttl == 0U || len > DNS_MAX_NAME_LEN) {
+		return;
+	}
+
+	ttl = MIN(ttl, CONFIG_DNS_RESOLVER_CACHE_MAX_TTL);
+	now = k_uptime_get();
+
+	key = k_spin_lock(&dns_cache_lock);
+
+	entry = dns_cache_find(name, type, now);
+	if (!entry) {
+		/* Free and expired entries have the smallest expiry time so
+		 * they are taken first, then the entry that expires next.
+		 */
+		entry = &dns_cache[0];
+
+		for (i = 1; i < CONFIG_DNS_RESOLVER_CACHE_SIZE; i++) {
+			if (dns_cache[i].expires < entry->expires) {
+				entry = &dns_cache[i];
+			}
+		}
+	}
+
+	memcpy(entry->name, name, len + 1);
+	entry->type = type;
+	entry->status = status;
+	entry->count = MIN(count, CONFIG_DNS_RESOLVER_CACHE_MAX_ADDRESSES);
+	memcpy(entry->addrs, addrs, entry->count * sizeof(entry->addrs[0]));
+	entry->expires = now + (int64_t)ttl * MSEC_PER_SEC;
+
+	k_spin_unlock(&dns_cache_lock, key);
+}
+
+/* Give the cached answer to the callback, returns -ENOENT if there is none */
+static int dns_cache_answer(const char *name, enum dns_query_type type,
+			    dns_resolve_cb_t cb, void *user_data)
+{
+	struct sockaddr addrs[CONFIG_DNS_RESOLVER_CACHE_MAX_ADDRESSES];
+	enum dns_resolve_status status;
+	struct dns_cache_entry *entry;
+	struct dns_addrinfo info;
+	k_spinlock_key_t key;
+	int count, i;
+
+	key = k_spin_lock(&dns_cache_lock);
+
+	entry = dns_cache_find(name, type, k_uptime_get());
+	if (!entry) {
+		k_spin_unlock(&dns_cache_lock, key);
+		return -ENOENT;
+	}
+
+	status = entry->status;
+	count = entry->count;
+	memcpy(addrs, entry->addrs, count * sizeof(addrs[0]));
+
+	k_spin_unlock(&dns_cache_lock, key);
+
+	NET_DBG("Cached answer for %s type %d (%d addresses)",
+		log_strdup(name), type, count);
+
+	for (i = 0; i < count; i++) {
+		(void)memset(&info, 0, sizeof(info));
+		memcpy(&info.ai_addr, &addrs[i], sizeof(info.ai_addr));
+		info.ai_family = addrs[i].sa_family;
+
+		if (info.ai_family == AF_INET) {
+			info.ai_addrlen = sizeof(struct sockaddr_in);
+		} else {
+			info.ai_addrlen = sizeof(struct sockaddr_in6);
+		}
+
+		cb(DNS_EAI_INPROGRESS, &info, user_data);
+	}
+
+	cb(status, NULL, user_data);
+
+	return 0;
+}
+
+void dns_cache_foreach(dns_cache_cb_t cb, void *user_data)
+{
+	struct dns_cache_entry entry;
+	k_spinlock_key_t key;
+	int64_t now;
+	int i;
+
+	for (i = 0; i < CONFIG_DNS_RESOLVER_CACHE_SIZE; i++) {
+		now = k_uptime_get();
+
+		/* Copy the entry so that the callback runs unlocked */
+		key = k_spin_lock(&dns_cache_lock);
+		entry = dns_cache[i];
+		k_spin_unlock(&dns_cache_lock, key);
+
+		if (entry.expires <= now) {
+			continue;
+		}
+
+		cb(entry.name, entry.type, entry.status,
+		   entry.count ? entry.addrs : NULL, entry.count,
+		   (uint32_t)((entry.expires - now) / MSEC_PER_SEC), user_data);
+	}
+}
+
+void dns_cache_flush(void)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&dns_cache_lock);
+	(void)memset(dns_cache, 0, sizeof(dns_cache));
+	k_spin_unlock(&dns_cache_lock, key);
+}
+
+static inline int query_leader(struct dns_resolve_context *ctx, int idx)
+{
+	return ctx->queries[idx].leader;
+}
+
+static inline void query_set_leader(struct dns_resolve_context *ctx, int idx,
+				    int leader)
+{
+	ctx->queries[idx].leader = leader;
+}
+
+/* Find the query that was sent to the servers for this name and type */
+static int get_pending_slot(struct dns_resolve_context *ctx,
+			    const char *query, enum dns_query_type type)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		if (ctx->queries[i].cb && ctx->queries[i].leader < 0 &&
+		    ctx->queries[i].query_type == type &&
+		    !strcmp(ctx->queries[i].query, query)) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
+#else
+#define dns_cache_put(...)
+#define dns_cache_answer(...) (-ENOENT)
+#define get_pending_slot(...) (-ENOENT)
+
+static inline int query_leader(struct dns_resolve_context *ctx, int idx)
+{
+	return -1;
+}
+
+static inline void query_set_leader(struct dns_resolve_context *ctx, int idx,
+				    int leader)
+{
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
+/* Give a result to the query and to the queries sharing its answer */
+static void query_result(struct dns_resolve_context *ctx, int idx,
+			 enum dns_resolve_status status,
+			 struct dns_addrinfo *info)
+{
+	int i;
+
+	ctx->queries[idx].cb(status, info, ctx->queries[idx].user_data);
+
+	for (i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		if (i != idx && ctx->queries[i].cb &&
+		    query_leader(ctx, i) == idx) {
+			ctx->queries[i].cb(status, info,
+					   ctx->queries[i].user_data);
+		}
+	}
+}
+
+/* Release the query and the queries sharing its answer, then give them the
+ * final status. The slots are released first so that the callbacks can
+ * start new queries.
+ */
+static void query_done(struct dns_resolve_context *ctx, int idx,
+		       enum dns_resolve_status status)
+{
+	struct {
+		dns_resolve_cb_t cb;
+		void *user_data;
+	} done[CONFIG_DNS_NUM_CONCUR_QUERIES];
+	int count = 0;
+	int i;
+
+	if (k_delayed_work_remaining_get(&ctx->queries[idx].timer) > 0) {
+		k_delayed_work_cancel(&ctx->queries[idx].timer);
+	}
+
+	for (i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
+		if (!ctx->queries[i].cb ||
+		    (i != idx && query_leader(ctx, i) != idx)) {
+			continue;
+		}
+
+		done[count].cb = ctx->queries[i].cb;
+		done[count].user_data = ctx->queries[i].user_data;
+		count++;
+
+		ctx->queries[i].cb = NULL;
+	}
+
+	for (i = 0; i < count; i++) {
+		done[i].cb(status, NULL, done[i].user_data);
+	}
+}
+
 static inline int get_cb_slot(struct dns_resolve_context *ctx)
 {
 	int i;
@@ -351,6 +609,7 @@ static inline int get_slot_by_id(struct dns_resolve_context *ctx,
 
 	for (i = 0; i < CONFIG_DNS_NUM_CONCUR_QUERIES; i++) {
 		if (ctx->queries[i].cb && ctx->queries[i].id == dns_id &&
+		    query_leader(ctx, i) < 0 &&
 		    (query_hash == 0 ||
 		     ctx->queries[i].query_hash == query_hash)) {
 			return i;
@@ -370,7 +629,7 @@ static int dns_read(struct dns_resolve_context *ctx,
 	struct dns_addrinfo info = { 0 };
 	/* Helper struct to track the dns msg received from the server */
 	struct dns_msg_t dns_msg;
-	uint32_t ttl; /* RR ttl, so far it is not passed to caller */
+	uint32_t ttl; /* RR ttl, only used by the answer cache */
 	uint8_t *src, *addr;
 	const char *query_name;
 	int address_size;
@@ -380,6 +639,10 @@ static int dns_read(struct dns_resolve_context *ctx,
 	int items;
 	int ret;
 	int server_idx, query_idx = -1;
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	struct sockaddr cache_addrs[CONFIG_DNS_RESOLVER_CACHE_MAX_ADDRESSES];
+	uint32_t cache_ttl = UINT32_MAX;
+#endif
 
 	data_len = MIN(net_pkt_remaining_data(pkt), DNS_RESOLVER_MAX_BUF_SIZE);
 
@@ -415,6 +678,23 @@ static int dns_read(struct dns_resolve_context *ctx,
 		goto quit;
 	}
 
+	/* Remember that the name does not exist. The DNS id is 0 for mDNS
+	 * which does not send negative answers.
+	 */
+	if (IS_ENABLED(CONFIG_DNS_RESOLVER_CACHE) && *dns_id > 0 &&
+	    dns_header_rcode(dns_msg.msg) == DNS_HEADER_NAMEERROR) {
+		query_idx = get_slot_by_id(ctx, *dns_id, 0);
+		if (query_idx >= 0) {
+			dns_cache_put(ctx->queries[query_idx].query,
+				      ctx->queries[query_idx].query_type,
+				      DNS_EAI_FAIL, NULL, 0,
+				      CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL);
+		}
+
+		ret = DNS_EAI_FAIL;
+		goto quit;
+	}
+
 	ret = dns_unpack_response_header(&dns_msg, *dns_id);
 	if (ret < 0) {
 		ret = DNS_EAI_FAIL;
@@ -461,20 +741,21 @@ static int dns_read(struct dns_resolve_context *ctx,
 
 		switch (dns_msg.response_type) {
 		case DNS_RESPONSE_IP:
-			if (query_idx >= 0) {
-				goto query_known;
-			}
-
-			query_name = dns_msg.msg + dns_msg.query_offset;
+			if (query_idx < 0) {
+				query_name = dns_msg.msg + dns_msg.query_offset;
 
-			/* Add \0 and query type (A or AAAA) to the hash */
-			*query_hash = crc16_ansi(query_name,
-						 strlen(query_name) + 1 + 2);
+				/* Add \0 and query type (A or AAAA) to the
+				 * hash
+				 */
+				*query_hash = crc16_ansi(query_name,
+						strlen(query_name) + 1 + 2);
 
-			query_idx = get_slot_by_id(ctx, *dns_id, *query_hash);
-			if (query_idx < 0) {
-				ret = DNS_EAI_SYSTEM;
-				goto quit;
+				query_idx = get_slot_by_id(ctx, *dns_id,
+							   *query_hash);
+				if (query_idx < 0) {
+					ret = DNS_EAI_SYSTEM;
+					goto quit;
+				}
 			}
 
 			if (ctx->queries[query_idx].query_type ==
@@ -530,9 +811,16 @@ static int dns_read(struct dns_resolve_context *ctx,
 			src = dns_msg.msg + dns_msg.response_position;
 			memcpy(addr, src, address_size);
 
-		query_known:
-			ctx->queries[query_idx].cb(DNS_EAI_INPROGRESS, &info,
-					ctx->queries[query_idx].user_data);
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+			if (items < ARRAY_SIZE(cache_addrs)) {
+				memcpy(&cache_addrs[items], &info.ai_addr,
+				       sizeof(cache_addrs[0]));
+			}
+
+			cache_ttl = MIN(cache_ttl, ttl);
+#endif
+
+			query_result(ctx, query_idx, DNS_EAI_INPROGRESS, &info);
 			items++;
 			break;
 
@@ -591,18 +879,20 @@ static int dns_read(struct dns_resolve_context *ctx,
 
 	if (items == 0) {
 		ret = DNS_EAI_NODATA;
+
+		dns_cache_put(ctx->queries[query_idx].query,
+			      ctx->queries[query_idx].query_type, ret, NULL, 0,
+			      CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL);
 	} else {
 		ret = DNS_EAI_ALLDONE;
-	}
 
-	if (k_delayed_work_remaining_get(&ctx->queries[query_idx].timer) > 0) {
-		k_delayed_work_cancel(&ctx->queries[query_idx].timer);
+		dns_cache_put(ctx->queries[query_idx].query,
+			      ctx->queries[query_idx].query_type, ret,
+			      cache_addrs, items, cache_ttl);
 	}
 
 	/* Marks the end of the results */
-	ctx->queries[query_idx].cb(ret, NULL,
-				   ctx->queries[query_idx].user_data);
-	ctx->queries[query_idx].cb = NULL;
+	query_done(ctx, query_idx, ret);
 
 	net_pkt_unref(pkt);
 
@@ -698,13 +988,8 @@ quit:
 		goto free_buf;
 	}
 
-	if (k_delayed_work_remaining_get(&ctx->queries[i].timer) > 0) {
-		k_delayed_work_cancel(&ctx->queries[i].timer);
-	}
-
 	/* Marks the end of the results */
-	ctx->queries[i].cb(ret, NULL, ctx->queries[i].user_data);
-	ctx->queries[i].cb = NULL;
+	query_done(ctx, i, ret);
 
 free_buf:
 	if (dns_data) {
@@ -808,12 +1093,7 @@ static int dns_resolve_cancel_with_hash(struct dns_resolve_context *ctx,
 		log_strdup(query_name), ctx->queries[i].query_type,
 		query_hash);
 
-	if (k_delayed_work_remaining_get(&ctx->queries[i].timer) > 0) {
-		k_delayed_work_cancel(&ctx->queries[i].timer);
-	}
-
-	ctx->queries[i].cb(DNS_EAI_CANCELED, NULL, ctx->queries[i].user_data);
-	ctx->queries[i].cb = NULL;
+	query_done(ctx, i, DNS_EAI_CANCELED);
 
 	return 0;
 }
@@ -899,6 +1179,7 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 	struct sockaddr addr;
 	int ret, i = -1, j = 0;
 	int failure = 0;
+	int leader;
 	bool mdns_query = false;
 	uint8_t hop_limit;
 
@@ -965,11 +1246,21 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 	}
 
 try_resolve:
+	if (dns_cache_answer(query, type, cb, user_data) == 0) {
+		if (dns_id) {
+			*dns_id = 0U;
+		}
+
+		return 0;
+	}
+
 	i = get_cb_slot(ctx);
 	if (i < 0) {
 		return -EAGAIN;
 	}
 
+	leader = get_pending_slot(ctx, query, type);
+
 	ctx->queries[i].cb = cb;
 	ctx->queries[i].timeout = tout;
 	ctx->queries[i].query = query;
@@ -980,6 +1271,21 @@ try_resolve:
 
 	k_delayed_work_init(&ctx->queries[i].timer, query_timeout);
 
+	if (leader >= 0) {
+		/* The name is being resolved already, share that answer */
+		ctx->queries[i].id = ctx->queries[leader].id;
+		ctx->queries[i].query_hash = ctx->queries[leader].query_hash;
+		query_set_leader(ctx, i, leader);
+
+		if (dns_id) {
+			*dns_id = ctx->queries[i].id;
+		}
+
+		return 0;
+	}
+
+	query_set_leader(ctx, i, -1);
+
 	dns_data = net_buf_alloc(&dns_msg_pool, ctx->buf_timeout);
 	if (!dns_data) {
 		ret = -ENOMEM;
@@ -1132,6 +1438,11 @@ int dns_resolve_close(struct dns_resolve_context *ctx)
 
 	ctx->is_used = false;
 
+	/* The answers of the servers used so far may not apply to the
+	 * servers configured next.
+	 */
+	dns_cache_flush();
+
 	return 0;
 }
 
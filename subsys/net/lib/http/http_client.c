@@ -262,6 +262,10 @@ static int on_body(struct http_parser *parser, const char *at, size_t length)
 		req->internal.response.http_cb->on_body(parser, at, length);
 	}
 
+	/* The fragment is handed to the application where it was received */
+	req->internal.response.body_frag_start = (const uint8_t *)at;
+	req->internal.response.body_frag_len = length;
+
 	if (!req->internal.response.body_start &&
 	    (uint8_t *)at != (uint8_t *)req->internal.response.recv_buf) {
 		req->internal.response.body_start = (uint8_t *)at;
@@ -289,6 +293,9 @@ static int on_body(struct http_parser *parser, const char *at, size_t length)
 		req->internal.response.body_start = NULL;
 	}
 
+	req->internal.response.body_frag_start = NULL;
+	req->internal.response.body_frag_len = 0;
+
 	return 0;
 }
 
@@ -357,6 +364,7 @@ static int on_message_complete(struct http_parser *parser)
 		http_method_str(req->method));
 
 	req->internal.response.message_complete = 1;
+	req->internal.response.keep_alive = http_should_keep_alive(parser);
 
 	if (req->internal.response.cb) {
 		req->internal.response.cb(&req->internal.response,
@@ -417,6 +425,7 @@ static int http_wait_data(int sock, struct http_request *req)
 	int total_received = 0;
 	size_t offset = 0;
 	int received, ret;
+	size_t parsed;
 
 	do {
 		received = recv(sock, req->internal.response.recv_buf + offset,
@@ -435,11 +444,18 @@ static int http_wait_data(int sock, struct http_request *req)
 		} else {
 			req->internal.response.data_len += received;
 
-			(void)http_parser_execute(
+			parsed = http_parser_execute(
 				&req->internal.parser,
 				&req->internal.parser_settings,
 				req->internal.response.recv_buf + offset,
 				received);
+
+			/* Data after the response cannot be given to the
+			 * next request, so do not reuse the connection.
+			 */
+			if (parsed < received) {
+				req->internal.response.keep_alive = 0;
+			}
 		}
 
 		total_received += received;
@@ -465,7 +481,174 @@ static void http_timeout(struct k_work *work)
 		CONTAINER_OF(work, struct http_client_internal_data, work);
 
 	(void)close(data->sock);
+
+	/* Tell http_client_conn_put() the socket is gone already */
+	data->sock = -1;
+}
+
+int http_client_send_chunk(int sock, const void *data, size_t len)
+{
+	char chunk_hdr[sizeof("ffffffff" HTTP_CRLF)];
+	int hdr_len, ret;
+
+	hdr_len = snprintk(chunk_hdr, sizeof(chunk_hdr), "%x" HTTP_CRLF,
+			   (unsigned int)len);
+	if (hdr_len <= 0 || hdr_len >= sizeof(chunk_hdr)) {
+		return -EMSGSIZE;
+	}
+
+	ret = sendall(sock, chunk_hdr, hdr_len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (len > 0) {
+		ret = sendall(sock, data, len);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	ret = sendall(sock, HTTP_CRLF, sizeof(HTTP_CRLF) - 1);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return hdr_len + len + sizeof(HTTP_CRLF) - 1;
+}
+
+#if CONFIG_HTTP_CLIENT_CONN_POOL_SIZE > 0
+struct http_conn {
+	struct sockaddr addr;
+	socklen_t addrlen;
+	int sock;
+	bool is_used;
+	bool is_busy;
+};
+
+static struct http_conn http_conns[CONFIG_HTTP_CLIENT_CONN_POOL_SIZE];
+static K_MUTEX_DEFINE(http_conn_lock);
+
+/* An idle kept-alive connection must have nothing to read, otherwise the
+ * server closed it or sent something we cannot match to a request.
+ */
+static bool http_conn_is_idle(int sock)
+{
+	struct pollfd fds = {
+		.fd = sock,
+		.events = POLLIN,
+	};
+
+	return poll(&fds, 1, 0) == 0;
+}
+
+int http_client_conn_get(const struct sockaddr *addr, socklen_t addrlen)
+{
+	struct http_conn *conn;
+	int sock, i;
+
+	if (addr == NULL || addrlen > sizeof(conn->addr)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&http_conn_lock, K_FOREVER);
+
+	for (i = 0; i < CONFIG_HTTP_CLIENT_CONN_POOL_SIZE; i++) {
+		conn = &http_conns[i];
+
+		if (!conn->is_used || conn->is_busy ||
+		    conn->addrlen != addrlen ||
+		    memcmp(&conn->addr, addr, addrlen) != 0) {
+			continue;
+		}
+
+		if (!http_conn_is_idle(conn->sock)) {
+			NET_DBG("Dropping stale connection %d", conn->sock);
+			(void)close(conn->sock);
+			conn->is_used = false;
+			continue;
+		}
+
+		conn->is_busy = true;
+		k_mutex_unlock(&http_conn_lock);
+
+		NET_DBG("Reusing connection %d", conn->sock);
+
+		return conn->sock;
+	}
+
+	k_mutex_unlock(&http_conn_lock);
+
+	sock = socket(addr->sa_family, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0) {
+		return -errno;
+	}
+
+	if (connect(sock, addr, addrlen) < 0) {
+		int ret = -errno;
+
+		(void)close(sock);
+		return ret;
+	}
+
+	k_mutex_lock(&http_conn_lock, K_FOREVER);
+
+	for (i = 0; i < CONFIG_HTTP_CLIENT_CONN_POOL_SIZE; i++) {
+		conn = &http_conns[i];
+
+		if (conn->is_used) {
+			continue;
+		}
+
+		memcpy(&conn->addr, addr, addrlen);
+		conn->addrlen = addrlen;
+		conn->sock = sock;
+		conn->is_used = true;
+		conn->is_busy = true;
+		break;
+	}
+
+	/* If the pool is full, the connection is closed when put back */
+	k_mutex_unlock(&http_conn_lock);
+
+	return sock;
+}
+
+void http_client_conn_put(int sock, const struct http_request *req)
+{
+	bool keep = false;
+	bool closed = false;
+	int i;
+
+	if (req != NULL) {
+		keep = req->internal.response.keep_alive;
+		closed = req->internal.sock < 0;
+	}
+
+	k_mutex_lock(&http_conn_lock, K_FOREVER);
+
+	for (i = 0; i < CONFIG_HTTP_CLIENT_CONN_POOL_SIZE; i++) {
+		if (!http_conns[i].is_used || http_conns[i].sock != sock) {
+			continue;
+		}
+
+		if (keep && !closed) {
+			http_conns[i].is_busy = false;
+			k_mutex_unlock(&http_conn_lock);
+			return;
+		}
+
+		http_conns[i].is_used = false;
+		break;
+	}
+
+	k_mutex_unlock(&http_conn_lock);
+
+	if (!closed) {
+		(void)close(sock);
+	}
 }
+#endif /* CONFIG_HTTP_CLIENT_CONN_POOL_SIZE > 0 */
 
 int http_client_req(int sock, struct http_request *req,
 		    int32_t timeout, void *user_data)
@@ -45,6 +45,9 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #ifdef CONFIG_LWM2M_RW_JSON_SUPPORT
 #include "lwm2m_rw_json.h"
 #endif
+#ifdef CONFIG_LWM2M_RW_SENML_CBOR_SUPPORT
+#include "lwm2m_rw_senml_cbor.h"
+#endif
 #ifdef CONFIG_LWM2M_RD_CLIENT_SUPPORT
 #include "lwm2m_rd_client.h"
 #endif
@@ -1140,6 +1143,12 @@ static int select_writer(struct lwm2m_output_context *out, uint16_t accept)
 		break;
 #endif
 
+#ifdef CONFIG_LWM2M_RW_SENML_CBOR_SUPPORT
+	case LWM2M_FORMAT_APP_SENML_CBOR:
+		out->writer = &senml_cbor_writer;
+		break;
+#endif
+
 	default:
 		LOG_WRN("Unknown content type %u", accept);
 		return -ENOMSG;
@@ -2885,6 +2894,11 @@ static int do_read_op(struct lwm2m_message *msg, uint16_t content_format)
 		return do_read_op_json(msg, content_format);
 #endif
 
+#if defined(CONFIG_LWM2M_RW_SENML_CBOR_SUPPORT)
+	case LWM2M_FORMAT_APP_SENML_CBOR:
+		return do_read_op_senml_cbor(msg, content_format);
+#endif
+
 	default:
 		LOG_ERR("Unsupported content-format: %u", content_format);
 		return -ENOMSG;
@@ -4017,12 +4031,89 @@ cleanup:
 	return ret;
 }
 
+/* timestamp at which the observer is due for its next notification */
+static int64_t observer_next_timestamp(struct observe_node *obs)
+{
+	if (obs->event_timestamp > obs->last_timestamp) {
+		return obs->last_timestamp +
+		       MSEC_PER_SEC * obs->min_period_sec + 1;
+	}
+
+	return obs->last_timestamp + MSEC_PER_SEC * obs->max_period_sec + 1;
+}
+
+#if CONFIG_LWM2M_ENGINE_NOTIFY_COALESCE_WINDOW > 0
+static bool observer_same_instance(struct observe_node *a,
+				   struct observe_node *b)
+{
+	if (a->ctx != b->ctx || a->path.obj_id != b->path.obj_id) {
+		return false;
+	}
+
+	/* whole object observations contain every instance */
+	if (a->path.level < 2U || b->path.level < 2U) {
+		return true;
+	}
+
+	return a->path.obj_inst_id == b->path.obj_inst_id;
+}
+
+/*
+ * Bring forward the periodic notifications of the other observations on
+ * the same object instance, so a server watching several resources of an
+ * instance sees them in one burst instead of waking the device up for
+ * each pmax separately.  pmin is always honoured.
+ */
+static void notify_coalesce(struct observe_node *sent, int64_t timestamp)
+{
+	struct observe_node *obs;
+	bool manual;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&engine_observer_list, obs, node) {
+		if (obs == sent || !observer_same_instance(obs, sent)) {
+			continue;
+		}
+
+		if (timestamp <= obs->last_timestamp +
+				 MSEC_PER_SEC * obs->min_period_sec) {
+			continue;
+		}
+
+		if (observer_next_timestamp(obs) - timestamp >
+		    CONFIG_LWM2M_ENGINE_NOTIFY_COALESCE_WINDOW) {
+			continue;
+		}
+
+		manual = obs->event_timestamp > obs->last_timestamp;
+		obs->last_timestamp = k_uptime_get();
+		generate_notify_message(obs, manual);
+	}
+}
+#else
+#define notify_coalesce(...)
+#endif
+
 int32_t engine_next_service_timeout_ms(uint32_t max_timeout)
 {
 	struct service_node *srv;
+	struct observe_node *obs;
 	uint64_t time_left_ms, timestamp = k_uptime_get();
 	uint32_t timeout = max_timeout;
 
+	SYS_SLIST_FOR_EACH_CONTAINER(&engine_observer_list, obs, node) {
+		time_left_ms = observer_next_timestamp(obs);
+
+		/* notification is due */
+		if (time_left_ms <= timestamp) {
+			return 0;
+		}
+
+		time_left_ms -= timestamp;
+		if (time_left_ms < timeout) {
+			timeout = time_left_ms;
+		}
+	}
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&engine_service_list, srv, node) {
 		time_left_ms = srv->last_timestamp + srv->min_call_period;
 
@@ -4090,6 +4181,7 @@ static int lwm2m_engine_service(void)
 				MSEC_PER_SEC * obs->min_period_sec) {
 			obs->last_timestamp = k_uptime_get();
 			generate_notify_message(obs, true);
+			notify_coalesce(obs, timestamp);
 
 		/*
 		 * automatic time-based notify requirements:
@@ -4099,6 +4191,7 @@ static int lwm2m_engine_service(void)
 				MSEC_PER_SEC * obs->max_period_sec) {
 			obs->last_timestamp = k_uptime_get();
 			generate_notify_message(obs, false);
+			notify_coalesce(obs, timestamp);
 		}
 
 	}
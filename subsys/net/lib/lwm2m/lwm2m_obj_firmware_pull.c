@@ -35,6 +35,29 @@ static struct lwm2m_ctx firmware_ctx = {
 static int firmware_retry;
 static struct coap_block_context firmware_block_ctx;
 
+#define FIRMWARE_WINDOW CONFIG_LWM2M_FIRMWARE_UPDATE_PULL_WINDOW
+
+/* A Block2 request of the transfer window. A block received before the
+ * blocks preceding it is kept here until it can be written in order.
+ */
+struct firmware_block {
+	struct coap_block_context ctx;
+	size_t offset;
+	uint8_t token[8];
+	bool in_flight;
+	bool received;
+	bool last;
+#if FIRMWARE_WINDOW > 1
+	uint16_t len;
+	uint8_t data[CONFIG_LWM2M_COAP_BLOCK_SIZE];
+#endif
+};
+
+static struct firmware_block firmware_blocks[FIRMWARE_WINDOW];
+
+/* Offset of the next block to request */
+static size_t firmware_next_offset;
+
 #if defined(CONFIG_LWM2M_FIRMWARE_UPDATE_PULL_COAP_PROXY_SUPPORT)
 #define COAP2COAP_PROXY_URI_PATH	"coap2coap"
 #define COAP2HTTP_PROXY_URI_PATH	"coap2http"
@@ -43,6 +66,9 @@ static char proxy_uri[URI_LEN];
 #endif
 
 static void do_transmit_timeout_cb(struct lwm2m_message *msg);
+static int do_firmware_transfer_reply_cb(const struct coap_packet *response,
+					 struct coap_reply *reply,
+					 const struct sockaddr *from);
 
 static void set_update_result_from_error(int error_code)
 {
@@ -229,22 +255,191 @@ cleanup:
 	return ret;
 }
 
+/* Write a block to the firmware write callback. The data is handed over
+ * straight from the received packet, split to the size of the package
+ * resource buffer.
+ */
+static int firmware_write(const uint8_t *data, uint16_t data_len,
+			  bool last_block)
+{
+	struct lwm2m_engine_res *res = NULL;
+	lwm2m_engine_set_data_cb_t write_cb;
+	size_t write_buflen;
+	uint16_t len;
+	int ret;
+
+	write_cb = lwm2m_firmware_get_write_cb();
+	if (!write_cb || data_len == 0U) {
+		return 0;
+	}
+
+	LOG_DBG("total: %zd, current: %zd", firmware_block_ctx.total_size,
+		firmware_block_ctx.current);
+
+	/* look up firmware package resource */
+	ret = lwm2m_engine_get_resource("5/0/0", &res);
+	if (ret < 0) {
+		return ret;
+	}
+
+	write_buflen = res->res_instances->data_len;
+
+	/* check for user override to buffer */
+	if (res->pre_write_cb) {
+		(void)res->pre_write_cb(0, 0, 0, &write_buflen);
+	}
+
+	if (write_buflen == 0) {
+		return -ENOMEM;
+	}
+
+	while (data_len > 0) {
+		len = MIN(data_len, write_buflen);
+		data_len -= len;
+
+		ret = write_cb(0, 0, 0, (uint8_t *)data, len,
+			       last_block && (data_len == 0U),
+			       firmware_block_ctx.total_size);
+		if (ret < 0) {
+			return ret;
+		}
+
+		data += len;
+	}
+
+	return 0;
+}
+
+static struct firmware_block *firmware_block_find(const uint8_t *token,
+						  uint8_t tkl)
+{
+	int i;
+
+	for (i = 0; i < FIRMWARE_WINDOW; i++) {
+		if (firmware_blocks[i].in_flight &&
+		    tkl == sizeof(firmware_blocks[i].token) &&
+		    !memcmp(firmware_blocks[i].token, token, tkl)) {
+			return &firmware_blocks[i];
+		}
+	}
+
+	return NULL;
+}
+
+static int firmware_block_request(struct firmware_block *blk, size_t offset)
+{
+	int ret;
+
+	blk->ctx = firmware_block_ctx;
+	blk->ctx.current = offset;
+	blk->offset = offset;
+	memcpy(blk->token, coap_next_token(), sizeof(blk->token));
+
+	ret = transfer_request(&blk->ctx, blk->token, sizeof(blk->token),
+			       do_firmware_transfer_reply_cb);
+	if (ret < 0) {
+		return ret;
+	}
+
+	blk->in_flight = true;
+
+	return 0;
+}
+
+/* Keep the window of Block2 requests full. Until a response gives the size
+ * of the package, the blocks are requested one at a time as the block size
+ * chosen by the server and the end of the transfer are unknown.
+ */
+static int firmware_window_fill(void)
+{
+	size_t block_len;
+	int i, ret;
+
+	block_len = coap_block_size_to_bytes(firmware_block_ctx.block_size);
+
+	for (i = 0; i < FIRMWARE_WINDOW; i++) {
+		struct firmware_block *blk = &firmware_blocks[i];
+
+		if (blk->in_flight || blk->received) {
+			if (firmware_block_ctx.total_size == 0) {
+				return 0;
+			}
+
+			continue;
+		}
+
+		if (firmware_block_ctx.total_size > 0 &&
+		    firmware_next_offset >= firmware_block_ctx.total_size) {
+			return 0;
+		}
+
+		ret = firmware_block_request(blk, firmware_next_offset);
+		if (ret < 0) {
+			return ret;
+		}
+
+		firmware_next_offset += block_len;
+
+		if (firmware_block_ctx.total_size == 0) {
+			return 0;
+		}
+	}
+
+	return 0;
+}
+
+/* Write the blocks that were received ahead of their turn */
+static int firmware_window_flush(bool *done)
+{
+#if FIRMWARE_WINDOW > 1
+	struct firmware_block *blk;
+	int i, ret;
+
+	do {
+		blk = NULL;
+
+		for (i = 0; i < FIRMWARE_WINDOW; i++) {
+			if (firmware_blocks[i].received &&
+			    firmware_blocks[i].offset ==
+						firmware_block_ctx.current) {
+				blk = &firmware_blocks[i];
+				break;
+			}
+		}
+
+		if (!blk) {
+			return 0;
+		}
+
+		blk->received = false;
+
+		ret = firmware_write(blk->data, blk->len, blk->last);
+		if (ret < 0) {
+			return ret;
+		}
+
+		firmware_block_ctx.current += blk->len;
+		*done = blk->last;
+	} while (!*done);
+#endif
+
+	return 0;
+}
+
 static int
 do_firmware_transfer_reply_cb(const struct coap_packet *response,
 			      struct coap_reply *reply,
 			      const struct sockaddr *from)
 {
 	int ret;
-	bool last_block;
+	bool done = false;
 	uint8_t token[8];
 	uint8_t tkl;
-	uint16_t payload_len, payload_offset, len;
+	uint16_t payload_len;
+	const uint8_t *payload;
 	struct coap_packet *check_response = (struct coap_packet *)response;
-	struct lwm2m_engine_res *res = NULL;
-	lwm2m_engine_set_data_cb_t write_cb;
-	size_t write_buflen;
-	uint8_t resp_code, *write_buf;
-	struct coap_block_context received_block_ctx;
+	struct firmware_block *blk;
+	uint8_t resp_code;
 
 	/* token is used to determine a valid ACK vs a separated response */
 	tkl = coap_header_get_token(check_response, token);
@@ -261,6 +456,18 @@ do_firmware_transfer_reply_cb(const struct coap_packet *response,
 		}
 	}
 
+	/* test for duplicate transfer */
+	blk = firmware_block_find(token, tkl);
+	if (!blk) {
+		LOG_WRN("Duplicate packet ignored");
+
+		/* set reply->user_data to error to avoid releasing */
+		reply->user_data = (void *)COAP_REPLY_STATUS_ERROR;
+		return 0;
+	}
+
+	blk->in_flight = false;
+
 	/* Check response code from server. Expecting (2.05) */
 	resp_code = coap_header_get_code(check_response);
 	if (resp_code != COAP_RESPONSE_CODE_CONTENT) {
@@ -271,88 +478,64 @@ do_firmware_transfer_reply_cb(const struct coap_packet *response,
 		goto error;
 	}
 
-	/* save main firmware block context */
-	memcpy(&received_block_ctx, &firmware_block_ctx,
-	       sizeof(firmware_block_ctx));
-
-	ret = coap_update_from_block(check_response, &firmware_block_ctx);
-	if (ret < 0) {
+	ret = coap_update_from_block(check_response, &blk->ctx);
+	if (ret < 0 || blk->ctx.current != blk->offset) {
 		LOG_ERR("Error from block update: %d", ret);
 		ret = -EFAULT;
 		goto error;
 	}
 
-	/* test for duplicate transfer */
-	if (firmware_block_ctx.current < received_block_ctx.current) {
-		LOG_WRN("Duplicate packet ignored");
-
-		/* restore main firmware block context */
-		memcpy(&firmware_block_ctx, &received_block_ctx,
-		       sizeof(firmware_block_ctx));
-
-		/* set reply->user_data to error to avoid releasing */
-		reply->user_data = (void *)COAP_REPLY_STATUS_ERROR;
-		return 0;
+	if (firmware_block_ctx.total_size == 0) {
+		/* Adopt the block size of the server and the package size */
+		firmware_block_ctx.block_size = blk->ctx.block_size;
+		firmware_block_ctx.total_size = blk->ctx.total_size;
+		firmware_next_offset = blk->offset +
+			coap_block_size_to_bytes(blk->ctx.block_size);
+	} else if (blk->ctx.block_size != firmware_block_ctx.block_size) {
+		LOG_ERR("Block size changed during transfer");
+		ret = -EFAULT;
+		goto error;
 	}
 
 	/* Reach last block if ret equals to 0 */
-	last_block = !coap_next_block(check_response, &firmware_block_ctx);
-
-	/* Process incoming data */
-	payload_offset = response->hdr_len + response->opt_len;
-	coap_packet_get_payload(response, &payload_len);
-	if (payload_len > 0) {
-		LOG_DBG("total: %zd, current: %zd",
-			firmware_block_ctx.total_size,
-			firmware_block_ctx.current);
-
-		/* look up firmware package resource */
-		ret = lwm2m_engine_get_resource("5/0/0", &res);
+	blk->last = !coap_next_block(check_response, &blk->ctx);
+
+	payload = coap_packet_get_payload(response, &payload_len);
+
+	if (blk->offset == firmware_block_ctx.current) {
+		ret = firmware_write(payload, payload_len, blk->last);
 		if (ret < 0) {
 			goto error;
 		}
 
-		/* get buffer data */
-		write_buf = res->res_instances->data_ptr;
-		write_buflen = res->res_instances->data_len;
+		firmware_block_ctx.current += payload_len;
+		done = blk->last;
 
-		/* check for user override to buffer */
-		if (res->pre_write_cb) {
-			write_buf = res->pre_write_cb(0, 0, 0, &write_buflen);
-		}
-
-		write_cb = lwm2m_firmware_get_write_cb();
-		if (write_cb) {
-			/* flush incoming data to write_cb */
-			while (payload_len > 0) {
-				len = (payload_len > write_buflen) ?
-				       write_buflen : payload_len;
-				payload_len -= len;
-				/* check for end of packet */
-				if (buf_read(write_buf, len,
-					     CPKT_BUF_READ(response),
-					     &payload_offset) < 0) {
-					/* malformed packet */
-					ret = -EFAULT;
-					goto error;
-				}
-
-				ret = write_cb(0, 0, 0,
-					       write_buf, len,
-					       last_block &&
-							(payload_len == 0U),
-					       firmware_block_ctx.total_size);
-				if (ret < 0) {
-					goto error;
-				}
+		if (!done) {
+			ret = firmware_window_flush(&done);
+			if (ret < 0) {
+				goto error;
 			}
 		}
+	} else {
+#if FIRMWARE_WINDOW > 1
+		if (payload_len > sizeof(blk->data)) {
+			ret = -EFAULT;
+			goto error;
+		}
+
+		memcpy(blk->data, payload, payload_len);
+		blk->len = payload_len;
+		blk->received = true;
+#else
+		ret = -EFAULT;
+		goto error;
+#endif
 	}
 
-	if (!last_block) {
+	if (!done) {
 		/* More block(s) to come, setup next transfer */
-		ret = transfer_request(&firmware_block_ctx, token, tkl,
-				       do_firmware_transfer_reply_cb);
+		ret = firmware_window_fill();
 		if (ret < 0) {
 			goto error;
 		}
@@ -372,15 +555,21 @@ error:
 
 static void do_transmit_timeout_cb(struct lwm2m_message *msg)
 {
+	struct firmware_block *blk;
 	int ret;
 
+	blk = firmware_block_find(msg->token, msg->tkl);
+	if (!blk) {
+		return;
+	}
+
+	blk->in_flight = false;
+
 	if (firmware_retry < PACKET_TRANSFER_RETRY_MAX) {
 		/* retry block */
 		LOG_WRN("TIMEOUT - Sending a retry packet!");
 
-		ret = transfer_request(&firmware_block_ctx,
-				       msg->token, msg->tkl,
-				       do_firmware_transfer_reply_cb);
+		ret = firmware_block_request(blk, blk->offset);
 		if (ret < 0) {
 			/* abort retries / transfer */
 			set_update_result_from_error(ret);
@@ -437,8 +626,10 @@ static void firmware_transfer(struct k_work *work)
 	/* reset block transfer context */
 	coap_block_transfer_init(&firmware_block_ctx,
 				 lwm2m_default_block_size(), 0);
-	ret = transfer_request(&firmware_block_ctx, coap_next_token(), 8,
-			       do_firmware_transfer_reply_cb);
+	(void)memset(firmware_blocks, 0, sizeof(firmware_blocks));
+	firmware_next_offset = 0;
+
+	ret = firmware_window_fill();
 	if (ret < 0) {
 		goto error;
 	}
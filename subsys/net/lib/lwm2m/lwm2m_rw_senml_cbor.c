@@ -0,0 +1,419 @@
+/*
+ * Copyright (c) 2020 Linaro Limited
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * SenML CBOR writer (RFC 8428, section 6), used for READ and NOTIFY
+ * payloads.  Records are written as a CBOR indefinite length array of
+ * maps using the integer labels from RFC 8428, which keeps a multi
+ * resource notification considerably smaller than its TLV or JSON
+ * counterpart.
+ */
+
+#define LOG_MODULE_NAME net_lwm2m_senml_cbor
+#define LOG_LEVEL CONFIG_LWM2M_LOG_LEVEL
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/byteorder.h>
+
+#include "lwm2m_object.h"
+#include "lwm2m_rw_senml_cbor.h"
+#include "lwm2m_engine.h"
+
+/* CBOR major types */
+#define CBOR_UINT		0x00
+#define CBOR_NINT		0x20
+#define CBOR_BSTR		0x40
+#define CBOR_TSTR		0x60
+#define CBOR_ARRAY		0x80
+#define CBOR_MAP		0xa0
+
+#define CBOR_FALSE		0xf4
+#define CBOR_TRUE		0xf5
+#define CBOR_FLOAT64		0xfb
+#define CBOR_ARRAY_INDEF	0x9f
+#define CBOR_BREAK		0xff
+
+/* SenML labels */
+#define SENML_BASE_NAME		(-2)
+#define SENML_NAME		0
+#define SENML_VALUE		2
+#define SENML_STRING_VALUE	3
+#define SENML_BOOL_VALUE	4
+#define SENML_DATA_VALUE	8
+
+#define SENML_OBJLNK_VALUE	"vlo"
+
+#define NAME_BUF_LEN		32
+
+struct senml_cbor_out_formatter_data {
+	/* flags */
+	uint8_t writer_flags;
+
+	/* path storage */
+	uint8_t path_level;
+};
+
+static size_t put_head(struct lwm2m_output_context *out, uint8_t major,
+		       uint64_t value)
+{
+	uint8_t buf[9];
+	size_t len;
+
+	if (value < 24) {
+		buf[0] = major | value;
+		len = 1;
+	} else if (value <= UINT8_MAX) {
+		buf[0] = major | 24;
+		buf[1] = value;
+		len = 2;
+	} else if (value <= UINT16_MAX) {
+		buf[0] = major | 25;
+		sys_put_be16(value, &buf[1]);
+		len = 3;
+	} else if (value <= UINT32_MAX) {
+		buf[0] = major | 26;
+		sys_put_be32(value, &buf[1]);
+		len = 5;
+	} else {
+		buf[0] = major | 27;
+		sys_put_be64(value, &buf[1]);
+		len = 9;
+	}
+
+	if (buf_append(CPKT_BUF_WRITE(out->out_cpkt), buf, len) < 0) {
+		return 0;
+	}
+
+	return len;
+}
+
+static size_t put_int(struct lwm2m_output_context *out, int64_t value)
+{
+	if (value < 0) {
+		return put_head(out, CBOR_NINT, -1 - value);
+	}
+
+	return put_head(out, CBOR_UINT, value);
+}
+
+static size_t put_bytes(struct lwm2m_output_context *out, uint8_t major,
+			const void *buf, size_t buflen)
+{
+	size_t len;
+
+	len = put_head(out, major, buflen);
+	if (len == 0) {
+		return 0;
+	}
+
+	if (buf_append(CPKT_BUF_WRITE(out->out_cpkt), buf, buflen) < 0) {
+		return 0;
+	}
+
+	return len + buflen;
+}
+
+static size_t put_byte(struct lwm2m_output_context *out, uint8_t value)
+{
+	if (buf_append(CPKT_BUF_WRITE(out->out_cpkt), &value, 1) < 0) {
+		return 0;
+	}
+
+	return 1;
+}
+
+static size_t put_begin(struct lwm2m_output_context *out,
+			struct lwm2m_obj_path *path)
+{
+	return put_byte(out, CBOR_ARRAY_INDEF);
+}
+
+static size_t put_end(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path)
+{
+	return put_byte(out, CBOR_BREAK);
+}
+
+static size_t put_begin_ri(struct lwm2m_output_context *out,
+			   struct lwm2m_obj_path *path)
+{
+	struct senml_cbor_out_formatter_data *fd;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	fd->writer_flags |= WRITER_RESOURCE_INSTANCE;
+	return 0;
+}
+
+static size_t put_end_ri(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path)
+{
+	struct senml_cbor_out_formatter_data *fd;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	fd->writer_flags &= ~WRITER_RESOURCE_INSTANCE;
+	return 0;
+}
+
+/*
+ * Start a record: the base name is only written in the first record, all
+ * following names are relative to it.  The caller appends the value label
+ * and the value itself.
+ */
+static size_t put_record_prefix(struct lwm2m_output_context *out,
+				struct lwm2m_obj_path *path)
+{
+	struct senml_cbor_out_formatter_data *fd;
+	char name[NAME_BUF_LEN];
+	bool first;
+	size_t len;
+	int ret;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	first = !(fd->writer_flags & WRITER_OUTPUT_VALUE);
+	len = put_head(out, CBOR_MAP, first ? 3 : 2);
+
+	if (first) {
+		if (fd->path_level >= 2U) {
+			ret = snprintk(name, sizeof(name), "/%u/%u/",
+				       path->obj_id, path->obj_inst_id);
+		} else {
+			ret = snprintk(name, sizeof(name), "/%u/",
+				       path->obj_id);
+		}
+
+		if (ret < 0 || ret >= sizeof(name)) {
+			return 0;
+		}
+
+		len += put_int(out, SENML_BASE_NAME);
+		len += put_bytes(out, CBOR_TSTR, name, ret);
+		fd->writer_flags |= WRITER_OUTPUT_VALUE;
+	}
+
+	if (fd->path_level >= 2U) {
+		if (fd->writer_flags & WRITER_RESOURCE_INSTANCE) {
+			ret = snprintk(name, sizeof(name), "%u/%u",
+				       path->res_id, path->res_inst_id);
+		} else {
+			ret = snprintk(name, sizeof(name), "%u",
+				       path->res_id);
+		}
+	} else {
+		if (fd->writer_flags & WRITER_RESOURCE_INSTANCE) {
+			ret = snprintk(name, sizeof(name), "%u/%u/%u",
+				       path->obj_inst_id, path->res_id,
+				       path->res_inst_id);
+		} else {
+			ret = snprintk(name, sizeof(name), "%u/%u",
+				       path->obj_inst_id, path->res_id);
+		}
+	}
+
+	if (ret < 0 || ret >= sizeof(name)) {
+		return 0;
+	}
+
+	len += put_int(out, SENML_NAME);
+	len += put_bytes(out, CBOR_TSTR, name, ret);
+
+	return len;
+}
+
+static size_t put_s64(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path, int64_t value)
+{
+	size_t len;
+
+	len = put_record_prefix(out, path);
+	len += put_int(out, SENML_VALUE);
+	len += put_int(out, value);
+
+	return len;
+}
+
+static size_t put_s32(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path, int32_t value)
+{
+	return put_s64(out, path, (int64_t)value);
+}
+
+static size_t put_s16(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path, int16_t value)
+{
+	return put_s64(out, path, (int64_t)value);
+}
+
+static size_t put_s8(struct lwm2m_output_context *out,
+		     struct lwm2m_obj_path *path, int8_t value)
+{
+	return put_s64(out, path, (int64_t)value);
+}
+
+static size_t put_string(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path,
+			 char *buf, size_t buflen)
+{
+	size_t len;
+
+	len = put_record_prefix(out, path);
+	len += put_int(out, SENML_STRING_VALUE);
+	len += put_bytes(out, CBOR_TSTR, buf, buflen);
+
+	return len;
+}
+
+static size_t put_opaque(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path,
+			 char *buf, size_t buflen)
+{
+	size_t len;
+
+	len = put_record_prefix(out, path);
+	len += put_int(out, SENML_DATA_VALUE);
+	len += put_bytes(out, CBOR_BSTR, buf, buflen);
+
+	return len;
+}
+
+static size_t put_double(struct lwm2m_output_context *out, double value)
+{
+	uint8_t buf[9];
+	union {
+		double d;
+		uint64_t u;
+	} conv = { .d = value };
+
+	buf[0] = CBOR_FLOAT64;
+	sys_put_be64(conv.u, &buf[1]);
+
+	if (buf_append(CPKT_BUF_WRITE(out->out_cpkt), buf, sizeof(buf)) < 0) {
+		return 0;
+	}
+
+	return sizeof(buf);
+}
+
+static size_t put_float32fix(struct lwm2m_output_context *out,
+			     struct lwm2m_obj_path *path,
+			     float32_value_t *value)
+{
+	size_t len;
+
+	/* whole numbers are encoded as integers, they are shorter */
+	if (value->val2 == 0) {
+		return put_s64(out, path, value->val1);
+	}
+
+	len = put_record_prefix(out, path);
+	len += put_int(out, SENML_VALUE);
+	len += put_double(out, (double)value->val1 +
+			       (double)value->val2 / LWM2M_FLOAT32_DEC_MAX);
+
+	return len;
+}
+
+static size_t put_float64fix(struct lwm2m_output_context *out,
+			     struct lwm2m_obj_path *path,
+			     float64_value_t *value)
+{
+	size_t len;
+
+	if (value->val2 == 0) {
+		return put_s64(out, path, value->val1);
+	}
+
+	len = put_record_prefix(out, path);
+	len += put_int(out, SENML_VALUE);
+	len += put_double(out, (double)value->val1 +
+			       (double)value->val2 / LWM2M_FLOAT64_DEC_MAX);
+
+	return len;
+}
+
+static size_t put_bool(struct lwm2m_output_context *out,
+		       struct lwm2m_obj_path *path,
+		       bool value)
+{
+	size_t len;
+
+	len = put_record_prefix(out, path);
+	len += put_int(out, SENML_BOOL_VALUE);
+	len += put_byte(out, value ? CBOR_TRUE : CBOR_FALSE);
+
+	return len;
+}
+
+static size_t put_objlnk(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path,
+			 struct lwm2m_objlnk *value)
+{
+	char buf[sizeof("65535:65535")];
+	size_t len;
+	int ret;
+
+	ret = snprintk(buf, sizeof(buf), "%u:%u", value->obj_id,
+		       value->obj_inst);
+	if (ret < 0 || ret >= sizeof(buf)) {
+		return 0;
+	}
+
+	len = put_record_prefix(out, path);
+	len += put_bytes(out, CBOR_TSTR, SENML_OBJLNK_VALUE,
+			 sizeof(SENML_OBJLNK_VALUE) - 1);
+	len += put_bytes(out, CBOR_TSTR, buf, ret);
+
+	return len;
+}
+
+const struct lwm2m_writer senml_cbor_writer = {
+	.put_begin = put_begin,
+	.put_end = put_end,
+	.put_begin_ri = put_begin_ri,
+	.put_end_ri = put_end_ri,
+	.put_s8 = put_s8,
+	.put_s16 = put_s16,
+	.put_s32 = put_s32,
+	.put_s64 = put_s64,
+	.put_string = put_string,
+	.put_float32fix = put_float32fix,
+	.put_float64fix = put_float64fix,
+	.put_bool = put_bool,
+	.put_opaque = put_opaque,
+	.put_objlnk = put_objlnk,
+};
+
+int do_read_op_senml_cbor(struct lwm2m_message *msg, int content_format)
+{
+	struct senml_cbor_out_formatter_data fd;
+	int ret;
+
+	(void)memset(&fd, 0, sizeof(fd));
+	engine_set_out_user_data(&msg->out, &fd);
+	/* save the level for output processing */
+	fd.path_level = msg->path.level;
+	ret = lwm2m_perform_read_op(msg, content_format);
+	engine_clear_out_user_data(&msg->out);
+
+	return ret;
+}
@@ -25,6 +25,11 @@ static void client_reset(struct mqtt_client *client)
 	client->internal.last_activity = 0U;
 	client->internal.rx_buf_datalen = 0U;
 	client->internal.remaining_payload = 0U;
+
+#if CONFIG_MQTT_INFLIGHT_WINDOW > 0
+	memset(client->internal.inflight, 0,
+	       sizeof(client->internal.inflight));
+#endif
 }
 
 /** @brief Initialize tx buffer. */
@@ -236,6 +241,48 @@ static int verify_tx_state(const struct mqtt_client *client)
 	return 0;
 }
 
+#if CONFIG_MQTT_INFLIGHT_WINDOW > 0
+/** @brief Take an in-flight window slot for a QoS 1 or QoS 2 message. */
+static int inflight_take(struct mqtt_client *client, uint16_t message_id)
+{
+	uint16_t *slot = NULL;
+	int i;
+
+	for (i = 0; i < CONFIG_MQTT_INFLIGHT_WINDOW; i++) {
+		/* A retransmission keeps the slot it already has. */
+		if (client->internal.inflight[i] == message_id) {
+			return 0;
+		}
+
+		if (client->internal.inflight[i] == 0U && slot == NULL) {
+			slot = &client->internal.inflight[i];
+		}
+	}
+
+	if (slot == NULL) {
+		return -EAGAIN;
+	}
+
+	*slot = message_id;
+
+	return 0;
+}
+
+void mqtt_inflight_release(struct mqtt_client *client, uint16_t message_id)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_MQTT_INFLIGHT_WINDOW; i++) {
+		if (client->internal.inflight[i] == message_id) {
+			client->internal.inflight[i] = 0U;
+			break;
+		}
+	}
+}
+#else
+#define inflight_take(...) 0
+#endif
+
 int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param)
 {
@@ -266,6 +313,14 @@ int mqtt_publish(struct mqtt_client *client,
 		goto error;
 	}
 
+	if (param->message.topic.qos > MQTT_QOS_0_AT_MOST_ONCE) {
+		err_code = inflight_take(client, param->message_id);
+		if (err_code < 0) {
+			MQTT_TRC("[CID %p]: In-flight window full.", client);
+			goto error;
+		}
+	}
+
 	io_vector[0].iov_base = packet.cur;
 	io_vector[0].iov_len = packet.end - packet.cur;
 	io_vector[1].iov_base = param->message.payload.data;
@@ -276,6 +331,7 @@ int mqtt_publish(struct mqtt_client *client,
 	msg.msg_iov = io_vector;
 	msg.msg_iovlen = ARRAY_SIZE(io_vector);
 
+	/* A failed write disconnects the client, which empties the window. */
 	err_code = client_write_msg(client, &msg);
 
 error:
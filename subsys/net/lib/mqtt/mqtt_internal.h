@@ -162,6 +162,17 @@ void event_notify(struct mqtt_client *client, const struct mqtt_evt *evt);
  */
 int mqtt_handle_rx(struct mqtt_client *client);
 
+#if CONFIG_MQTT_INFLIGHT_WINDOW > 0
+/**@brief Releases the in-flight window slot of an acknowledged message.
+ *
+ * @param[in] client Identifies the client for which the message was sent.
+ * @param[in] message_id Message id of the acknowledged publication.
+ */
+void mqtt_inflight_release(struct mqtt_client *client, uint16_t message_id);
+#else
+#define mqtt_inflight_release(...)
+#endif
+
 /**@brief Constructs/encodes Connect packet.
  *
  * @param[in] client Identifies the client for which the procedure is requested.
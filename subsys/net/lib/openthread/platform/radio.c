@@ -277,11 +277,26 @@ static inline void handle_tx_done(otInstance *aInstance)
 static void openthread_handle_received_frame(otInstance *instance,
 					     struct net_pkt *pkt)
 {
+	static uint8_t rx_psdu[OT_RADIO_FRAME_MAX_SIZE];
 	otRadioFrame recv_frame;
 
-	recv_frame.mPsdu = net_buf_frag_last(pkt->buffer)->data;
 	/* Length inc. CRC. */
 	recv_frame.mLength = net_buf_frags_len(pkt->buffer);
+
+	/* The frame is handed to OpenThread in place, unless the driver
+	 * spread it over several buffers.
+	 */
+	if (pkt->buffer->frags == NULL) {
+		recv_frame.mPsdu = pkt->buffer->data;
+	} else if (recv_frame.mLength <= sizeof(rx_psdu)) {
+		net_buf_linearize(rx_psdu, sizeof(rx_psdu), pkt->buffer, 0,
+				  recv_frame.mLength);
+		recv_frame.mPsdu = rx_psdu;
+	} else {
+		LOG_DBG("Dropping oversized frame (%u)", recv_frame.mLength);
+		goto out;
+	}
+
 	recv_frame.mChannel = platformRadioChannelGet(instance);
 	recv_frame.mInfo.mRxInfo.mLqi = net_pkt_ieee802154_lqi(pkt);
 	recv_frame.mInfo.mRxInfo.mRssi = net_pkt_ieee802154_rssi(pkt);
@@ -303,6 +318,7 @@ static void openthread_handle_received_frame(otInstance *instance,
 				       &recv_frame, OT_ERROR_NONE);
 	}
 
+out:
 	net_pkt_unref(pkt);
 }
 
@@ -5,6 +5,7 @@
  */
 
 #include <fcntl.h>
+#include <limits.h>
 
 /* Zephyr headers */
 #include <logging/log.h>
@@ -120,6 +121,17 @@ static inline size_t spair_read_avail(struct spair *spair)
 	return k_pipe_read_avail(&spair->recv_q);
 }
 
+/**
+ * Determine free space in the local receive queue
+ *
+ * Specifically, this function calculates the number of bytes that the
+ * remote end of a given @ref spair may write without blocking.
+ */
+static inline size_t spair_local_write_avail(struct spair *spair)
+{
+	return k_pipe_write_avail(&spair->recv_q);
+}
+
 /** Swap two 32-bit integers */
 static inline void swap32(uint32_t *a, uint32_t *b)
 {
@@ -386,9 +398,9 @@ static ssize_t spair_write(void *obj, const void *buffer, size_t count)
 	size_t avail;
 	bool is_nonblock;
 	size_t bytes_written;
+	bool was_empty;
 	bool have_local_sem = false;
 	bool have_remote_sem = false;
-	bool will_block = false;
 	struct spair *const spair = (struct spair *)obj;
 	struct spair *remote = NULL;
 
@@ -448,16 +460,17 @@ static ssize_t spair_write(void *obj, const void *buffer, size_t count)
 
 	avail = spair_write_avail(spair);
 
-	if (avail == 0) {
+	while (avail == 0) {
 		if (is_nonblock) {
 			errno = EAGAIN;
 			res = -1;
 			goto out;
 		}
-		will_block = true;
-	}
 
-	if (will_block) {
+		/* Only a transition from full is signaled, so clear any
+		 * stale signal while the remote sem is still held.
+		 */
+		k_poll_signal_reset(&remote->read_signal);
 
 		for (int signaled = false, result = -1; !signaled;
 			result = -1) {
@@ -501,7 +514,8 @@ static ssize_t spair_write(void *obj, const void *buffer, size_t count)
 			k_poll_signal_check(&remote->read_signal, &signaled,
 					    &result);
 			if (!signaled) {
-				continue;
+				/* reset by poll(), check for room again */
+				break;
 			}
 
 			switch (result) {
@@ -526,14 +540,29 @@ static ssize_t spair_write(void *obj, const void *buffer, size_t count)
 			/* SPAIR_SIG_DATA was received */
 			break;
 		}
+
+		avail = spair_write_avail(spair);
 	}
 
+	was_empty = spair_read_avail(remote) == 0;
+
 	res = k_pipe_put(&remote->recv_q, (void *)buffer, count,
 			 &bytes_written, 1, K_NO_WAIT);
+	if (res == -EBUSY) {
+		/* zsock_socketpair_claim() is in progress on this end */
+		errno = EBUSY;
+		res = -1;
+		goto out;
+	}
+
 	__ASSERT(res == 0, "k_pipe_put() failed: %d", res);
 
-	res = k_poll_signal_raise(&remote->write_signal, SPAIR_SIG_DATA);
-	__ASSERT(res == 0, "k_poll_signal_raise() failed: %d", res);
+	/* Readers only need to be woken up when data becomes available */
+	if (was_empty) {
+		res = k_poll_signal_raise(&remote->write_signal,
+					  SPAIR_SIG_DATA);
+		__ASSERT(res == 0, "k_poll_signal_raise() failed: %d", res);
+	}
 
 	res = bytes_written;
 
@@ -549,6 +578,90 @@ out:
 	return res;
 }
 
+/**
+ * Wait until data can be read from the local end of a @ref spair
+ *
+ * Only a transition of the local @ref spair.recv_q from empty is signaled
+ * by writers, so any stale signal is cleared before blocking. Must be
+ * called with the local sem held, which is released while waiting.
+ *
+ * @param spair the local endpoint
+ * @param is_nonblock do not wait if nothing can be read
+ *
+ * @return the number of bytes that can be read
+ * @return 0 on end-of-file
+ * @return -1 on error, with @ref errno set appropriately.
+ */
+static int spair_wait_readable(struct spair *spair, bool is_nonblock)
+{
+	size_t avail;
+	int res;
+
+	while ((avail = spair_read_avail(spair)) == 0) {
+		if (!sock_is_connected(spair)) {
+			/* signal EOF */
+			return 0;
+		}
+
+		if (is_nonblock) {
+			errno = EAGAIN;
+			return -1;
+		}
+
+		k_poll_signal_reset(&spair->write_signal);
+
+		for (int signaled = false, result = -1; !signaled;
+			result = -1) {
+
+			struct k_poll_event events[] = {
+				K_POLL_EVENT_INITIALIZER(
+					K_POLL_TYPE_SIGNAL,
+					K_POLL_MODE_NOTIFY_ONLY,
+					&spair->write_signal
+				),
+			};
+
+			k_sem_give(&spair->sem);
+
+			res = k_poll(events, ARRAY_SIZE(events), K_FOREVER);
+			__ASSERT(res == 0, "k_poll() failed: %d", res);
+
+			res = k_sem_take(&spair->sem, K_FOREVER);
+			__ASSERT(res == 0, "failed to take local sem: %d", res);
+
+			k_poll_signal_check(&spair->write_signal, &signaled,
+					    &result);
+			if (!signaled) {
+				/* reset by poll(), check for data again */
+				break;
+			}
+
+			switch (result) {
+				case SPAIR_SIG_DATA: {
+					break;
+				}
+
+				case SPAIR_SIG_CANCEL: {
+					errno = EPIPE;
+					return -1;
+				}
+
+				default: {
+					__ASSERT(false,
+						"unrecognized result: %d",
+						result);
+					continue;
+				}
+			}
+
+			/* SPAIR_SIG_DATA was received */
+			break;
+		}
+	}
+
+	return MIN(avail, INT_MAX);
+}
+
 /**
  * Read data from one end of a @ref spair
  *
@@ -588,11 +701,10 @@ static ssize_t spair_read(void *obj, void *buffer, size_t count)
 	int res;
 	int key;
 	bool is_connected;
-	size_t avail;
+	bool was_full;
 	bool is_nonblock;
 	size_t bytes_read;
 	bool have_local_sem = false;
-	bool will_block = false;
 	struct spair *const spair = (struct spair *)obj;
 
 	if (obj == NULL || buffer == NULL || count == 0) {
@@ -623,84 +735,28 @@ static ssize_t spair_read(void *obj, void *buffer, size_t count)
 
 	have_local_sem = true;
 
-	is_connected = sock_is_connected(spair);
-	avail = spair_read_avail(spair);
-
-	if (avail == 0) {
-		if (!is_connected) {
-			/* signal EOF */
-			res = 0;
-			goto out;
-		}
-
-		if (is_nonblock) {
-			errno = EAGAIN;
-			res = -1;
-			goto out;
-		}
-
-		will_block = true;
+	res = spair_wait_readable(spair, is_nonblock);
+	if (res <= 0) {
+		/* error or EOF */
+		goto out;
 	}
 
-	if (will_block) {
-
-		for (int signaled = false, result = -1; !signaled;
-			result = -1) {
-
-			struct k_poll_event events[] = {
-				K_POLL_EVENT_INITIALIZER(
-					K_POLL_TYPE_SIGNAL,
-					K_POLL_MODE_NOTIFY_ONLY,
-					&spair->write_signal
-				),
-			};
-
-			k_sem_give(&spair->sem);
-			have_local_sem = false;
-
-			res = k_poll(events, ARRAY_SIZE(events), K_FOREVER);
-			__ASSERT(res == 0, "k_poll() failed: %d", res);
-
-			res = k_sem_take(&spair->sem, K_FOREVER);
-			__ASSERT(res == 0, "failed to take local sem: %d", res);
-
-			have_local_sem = true;
-
-			k_poll_signal_check(&spair->write_signal, &signaled,
-					    &result);
-			if (!signaled) {
-				continue;
-			}
-
-			switch (result) {
-				case SPAIR_SIG_DATA: {
-					break;
-				}
-
-				case SPAIR_SIG_CANCEL: {
-					errno = EPIPE;
-					res = -1;
-					goto out;
-				}
-
-				default: {
-					__ASSERT(false,
-						"unrecognized result: %d",
-						result);
-					continue;
-				}
-			}
-
-			/* SPAIR_SIG_DATA was received */
-			break;
-		}
-	}
+	is_connected = sock_is_connected(spair);
+	was_full = spair_local_write_avail(spair) == 0;
 
 	res = k_pipe_get(&spair->recv_q, (void *)buffer, count, &bytes_read,
 			 1, K_NO_WAIT);
+	if (res == -EBUSY) {
+		/* zsock_socketpair_splice() is in progress on this end */
+		errno = EBUSY;
+		res = -1;
+		goto out;
+	}
+
 	__ASSERT(res == 0, "k_pipe_get() failed: %d", res);
 
-	if (is_connected) {
+	/* Writers only need to be woken up when space becomes available */
+	if (is_connected && was_full) {
 		res = k_poll_signal_raise(&spair->read_signal, SPAIR_SIG_DATA);
 		__ASSERT(res == 0, "k_poll_signal_raise() failed: %d", res);
 	}
@@ -716,41 +772,48 @@ out:
 	return res;
 }
 
+static void spair_poll_event_init(struct k_poll_event *pev,
+				  struct k_poll_signal *signal)
+{
+	pev->obj = signal;
+	pev->type = K_POLL_TYPE_SIGNAL;
+	pev->mode = K_POLL_MODE_NOTIFY_ONLY;
+	pev->state = K_POLL_STATE_NOT_READY;
+}
+
+/*
+ * Writers and readers only raise the signals on empty to non-empty and
+ * full to non-full transitions, so poll() is told to short-circuit its
+ * wait whenever the requested condition already holds. One event is used
+ * per requested direction, matching zsock_poll_update_ctx().
+ */
 static int zsock_poll_prepare_ctx(struct spair *const spair,
 				  struct zsock_pollfd *const pfd,
 				  struct k_poll_event **pev,
 				  struct k_poll_event *pev_end)
 {
 	int res;
-
+	bool ready = false;
 	struct spair *remote = NULL;
 	bool have_remote_sem = false;
 
 	if (pfd->events & ZSOCK_POLLIN) {
-
-		/* Tell poll() to short-circuit wait */
-		if (sock_is_eof(spair)) {
-			res = -EALREADY;
-			goto out;
-		}
-
 		if (*pev == pev_end) {
 			res = -ENOMEM;
 			goto out;
 		}
 
 		/* Wait until data has been written to the local end */
-		(*pev)->obj = &spair->write_signal;
-	}
+		spair_poll_event_init(*pev, &spair->write_signal);
+		k_poll_signal_reset(&spair->write_signal);
+		(*pev)++;
 
-	if (pfd->events & ZSOCK_POLLOUT) {
-
-		/* Tell poll() to short-circuit wait */
-		if (!sock_is_connected(spair)) {
-			res = -EALREADY;
-			goto out;
+		if (sock_is_eof(spair) || spair_read_avail(spair) > 0) {
+			ready = true;
 		}
+	}
 
+	if (pfd->events & ZSOCK_POLLOUT) {
 		if (*pev == pev_end) {
 			res = -ENOMEM;
 			goto out;
@@ -760,27 +823,31 @@ static int zsock_poll_prepare_ctx(struct spair *const spair,
 			(const struct fd_op_vtable *)
 			&spair_fd_op_vtable, 0);
 
-		__ASSERT(remote != NULL, "remote is NULL");
+		if (remote == NULL) {
+			/* Nothing to wait for, POLLHUP is reported */
+			spair_poll_event_init(*pev, &spair->read_signal);
+			(*pev)++;
+			ready = true;
+		} else {
+			res = k_sem_take(&remote->sem, K_FOREVER);
+			if (res < 0) {
+				goto out;
+			}
 
-		res = k_sem_take(&remote->sem, K_FOREVER);
-		if (res < 0) {
-			goto out;
-		}
+			have_remote_sem = true;
 
-		have_remote_sem = true;
+			/* Wait until data has been read from the remote end */
+			spair_poll_event_init(*pev, &remote->read_signal);
+			k_poll_signal_reset(&remote->read_signal);
+			(*pev)++;
 
-		/* Wait until data has been read from the remote end */
-		(*pev)->obj = &remote->read_signal;
+			if (spair_write_avail(spair) > 0) {
+				ready = true;
+			}
+		}
 	}
 
-	(*pev)->type = K_POLL_TYPE_SIGNAL;
-	(*pev)->mode = K_POLL_MODE_NOTIFY_ONLY;
-	(*pev)->state = K_POLL_STATE_NOT_READY;
-	k_poll_signal_reset((*pev)->obj);
-
-	(*pev)++;
-
-	res = 0;
+	res = ready ? -EALREADY : 0;
 
 out:
 
@@ -802,6 +869,8 @@ static int zsock_poll_update_ctx(struct spair *const spair,
 	bool have_remote_sem = false;
 
 	if (pfd->events & ZSOCK_POLLOUT) {
+		(*pev)++;
+
 		if (!sock_is_connected(spair)) {
 			pfd->revents |= ZSOCK_POLLHUP;
 			goto pollout_done;
@@ -842,6 +911,8 @@ static int zsock_poll_update_ctx(struct spair *const spair,
 pollout_done:
 
 	if (pfd->events & ZSOCK_POLLIN) {
+		(*pev)++;
+
 		if (sock_is_eof(spair)) {
 			pfd->revents |= ZSOCK_POLLIN;
 			goto pollin_done;
@@ -869,8 +940,6 @@ pollout_done:
 pollin_done:
 	res = 0;
 
-	(*pev)++;
-
 	if (remote != NULL && have_remote_sem) {
 		k_sem_give(&remote->sem);
 	}
@@ -1153,3 +1222,165 @@ static const struct socket_op_vtable spair_fd_op_vtable = {
 	.getsockopt = spair_getsockopt,
 	.setsockopt = spair_setsockopt,
 };
+
+int zsock_socketpair_claim(int sock, uint8_t **data, size_t size)
+{
+	int res;
+	struct spair *spair;
+	struct spair *remote;
+
+	spair = z_get_fd_obj(sock,
+		(const struct fd_op_vtable *)&spair_fd_op_vtable, ENOTSOCK);
+	if (spair == NULL) {
+		return -1;
+	}
+
+	remote = z_get_fd_obj(spair->remote,
+		(const struct fd_op_vtable *)&spair_fd_op_vtable, 0);
+	if (remote == NULL) {
+		errno = EPIPE;
+		return -1;
+	}
+
+	res = k_sem_take(&remote->sem, K_FOREVER);
+	if (res < 0) {
+		errno = EPIPE;
+		return -1;
+	}
+
+	res = k_pipe_put_claim(&remote->recv_q, data, size, K_NO_WAIT);
+
+	k_sem_give(&remote->sem);
+
+	if (res == -EIO) {
+		errno = EAGAIN;
+		return -1;
+	} else if (res < 0) {
+		errno = -res;
+		return -1;
+	}
+
+	return res;
+}
+
+int zsock_socketpair_commit(int sock, size_t size)
+{
+	int res;
+	bool was_empty;
+	struct spair *spair;
+	struct spair *remote;
+
+	spair = z_get_fd_obj(sock,
+		(const struct fd_op_vtable *)&spair_fd_op_vtable, ENOTSOCK);
+	if (spair == NULL) {
+		return -1;
+	}
+
+	remote = z_get_fd_obj(spair->remote,
+		(const struct fd_op_vtable *)&spair_fd_op_vtable, 0);
+	if (remote == NULL) {
+		errno = EPIPE;
+		return -1;
+	}
+
+	res = k_sem_take(&remote->sem, K_FOREVER);
+	if (res < 0) {
+		errno = EPIPE;
+		return -1;
+	}
+
+	was_empty = spair_read_avail(remote) == 0;
+
+	res = k_pipe_put_commit(&remote->recv_q, size);
+	if (res < 0) {
+		errno = -res;
+		res = -1;
+	} else if (size > 0 && was_empty) {
+		res = k_poll_signal_raise(&remote->write_signal,
+					  SPAIR_SIG_DATA);
+		__ASSERT(res == 0, "k_poll_signal_raise() failed: %d", res);
+	}
+
+	k_sem_give(&remote->sem);
+
+	return res;
+}
+
+ssize_t zsock_socketpair_splice(int in, int out, size_t len, int flags)
+{
+	int res;
+	int claimed;
+	ssize_t sent;
+	size_t done = 0;
+	uint8_t *data;
+	bool was_full;
+	bool is_nonblock;
+	struct spair *spair;
+
+	spair = z_get_fd_obj(in,
+		(const struct fd_op_vtable *)&spair_fd_op_vtable, ENOTSOCK);
+	if (spair == NULL) {
+		return -1;
+	}
+
+	while (done < len) {
+		res = k_sem_take(&spair->sem, K_FOREVER);
+		__ASSERT(res == 0, "failed to take local sem: %d", res);
+
+		/* only the first chunk may wait, like a short read() */
+		is_nonblock = sock_is_nonblock(spair) || done > 0 ||
+			      (flags & ZSOCK_MSG_DONTWAIT);
+
+		res = spair_wait_readable(spair, is_nonblock);
+		if (res > 0) {
+			res = k_pipe_get_claim(&spair->recv_q, &data,
+					       len - done, K_NO_WAIT);
+			if (res < 0) {
+				errno = (res == -EBUSY) ? EBUSY : EAGAIN;
+				res = -1;
+			}
+		}
+
+		k_sem_give(&spair->sem);
+
+		if (res <= 0) {
+			break;
+		}
+
+		claimed = res;
+
+		/* the peer may keep writing to the rest of the buffer */
+		sent = zsock_sendto(out, data, claimed, flags, NULL, 0);
+
+		(void)k_sem_take(&spair->sem, K_FOREVER);
+
+		was_full = spair_local_write_avail(spair) == 0;
+		k_pipe_get_release(&spair->recv_q, MAX(sent, 0));
+
+		if (sent > 0 && was_full && sock_is_connected(spair)) {
+			res = k_poll_signal_raise(&spair->read_signal,
+						  SPAIR_SIG_DATA);
+			__ASSERT(res == 0, "k_poll_signal_raise() failed: %d",
+				 res);
+		}
+
+		k_sem_give(&spair->sem);
+
+		if (sent < 0) {
+			res = -1;
+			break;
+		}
+
+		done += sent;
+
+		if (sent < claimed) {
+			break;
+		}
+	}
+
+	if (done > 0) {
+		return done;
+	}
+
+	return res;
+}
@@ -18,12 +18,18 @@ LOG_MODULE_REGISTER(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <syscall_handler.h>
 #include <sys/fdtable.h>
 #include <sys/math_extras.h>
+#if defined(CONFIG_NET_SOCKETS_SENDFILE)
+#include <fs/fs.h>
+#endif
 
 #if defined(CONFIG_SOCKS)
 #include "socks.h"
 #endif
 
 #include "../../ip/net_stats.h"
+#if defined(CONFIG_NET_TCP2)
+#include "../../ip/tcp2.h"
+#endif
 
 #include "sockets_internal.h"
 
@@ -256,6 +262,10 @@ int z_impl_zsock_close(int sock)
 
 	NET_DBG("close: ctx=%p, fd=%d", ctx, sock);
 
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+	zsock_epoll_fd_closed(sock);
+#endif
+
 	ret = vtable->fd_vtable.close(ctx);
 
 	z_free_fd(sock);
@@ -664,93 +674,301 @@ ssize_t z_impl_zsock_sendmsg(int sock, const struct msghdr *msg, int flags)
 }
 
 #ifdef CONFIG_USERSPACE
+static void user_msghdr_free(struct msghdr *msg_copy)
+{
+	size_t i;
+
+	k_free(msg_copy->msg_name);
+	k_free(msg_copy->msg_control);
+
+	if (msg_copy->msg_iov) {
+		for (i = 0; i < msg_copy->msg_iovlen; i++) {
+			k_free(msg_copy->msg_iov[i].iov_base);
+		}
+
+		k_free(msg_copy->msg_iov);
+	}
+}
+
+/* Copy a message to send and all its buffers from user mode. On failure,
+ * what was already copied must be released with user_msghdr_free().
+ */
+static int user_msghdr_copy(struct msghdr *msg_copy, const struct msghdr *msg)
+{
+	struct iovec *iov;
+	size_t iovlen;
+	size_t size;
+	size_t i;
+
+	Z_OOPS(z_user_from_copy(msg_copy, (void *)msg, sizeof(*msg_copy)));
+
+	iov = msg_copy->msg_iov;
+	iovlen = msg_copy->msg_iovlen;
+
+	msg_copy->msg_iov = NULL;
+	msg_copy->msg_iovlen = 0;
+
+	if (msg_copy->msg_namelen > 0) {
+		msg_copy->msg_name = z_user_alloc_from_copy(msg_copy->msg_name,
+							   msg_copy->msg_namelen);
+		if (!msg_copy->msg_name) {
+			msg_copy->msg_control = NULL;
+			return -ENOMEM;
+		}
+	} else {
+		msg_copy->msg_name = NULL;
+	}
+
+	if (msg_copy->msg_controllen > 0) {
+		msg_copy->msg_control =
+			z_user_alloc_from_copy(msg_copy->msg_control,
+					       msg_copy->msg_controllen);
+		if (!msg_copy->msg_control) {
+			return -ENOMEM;
+		}
+	} else {
+		msg_copy->msg_control = NULL;
+	}
+
+	if (size_mul_overflow(iovlen, sizeof(struct iovec), &size)) {
+		return -EINVAL;
+	}
+
+	msg_copy->msg_iov = z_user_alloc_from_copy(iov, size);
+	if (!msg_copy->msg_iov) {
+		return -ENOMEM;
+	}
+
+	for (i = 0; i < iovlen; i++) {
+		iov = &msg_copy->msg_iov[i];
+
+		iov->iov_base = z_user_alloc_from_copy(iov->iov_base,
+						       iov->iov_len);
+		if (!iov->iov_base) {
+			return -ENOMEM;
+		}
+
+		/* Only the buffers copied so far are released on failure */
+		msg_copy->msg_iovlen = i + 1;
+	}
+
+	return 0;
+}
+
 static inline ssize_t z_vrfy_zsock_sendmsg(int sock,
 					   const struct msghdr *msg,
 					   int flags)
 {
 	struct msghdr msg_copy;
-	size_t i;
-	int ret;
+	ssize_t ret;
 
-	Z_OOPS(z_user_from_copy(&msg_copy, (void *)msg, sizeof(msg_copy)));
+	ret = user_msghdr_copy(&msg_copy, msg);
+	if (ret < 0) {
+		errno = -ret;
+		ret = -1;
+	} else {
+		ret = z_impl_zsock_sendmsg(sock,
+					   (const struct msghdr *)&msg_copy,
+					   flags);
+	}
 
-	msg_copy.msg_name = NULL;
-	msg_copy.msg_control = NULL;
+	user_msghdr_free(&msg_copy);
 
-	msg_copy.msg_iov = z_user_alloc_from_copy(msg->msg_iov,
-				       msg->msg_iovlen * sizeof(struct iovec));
-	if (!msg_copy.msg_iov) {
-		errno = ENOMEM;
-		goto fail;
+	return ret;
+}
+#include <syscalls/zsock_sendmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	unsigned int i;
+	ssize_t len;
+	void *ctx;
+
+	ctx = get_sock_vtable(sock, &vtable);
+	if (ctx == NULL || vtable->sendmsg == NULL) {
+		errno = EBADF;
+		return -1;
 	}
 
-	for (i = 0; i < msg->msg_iovlen; i++) {
-		msg_copy.msg_iov[i].iov_base =
-			z_user_alloc_from_copy(msg->msg_iov[i].iov_base,
-					       msg->msg_iov[i].iov_len);
-		if (!msg_copy.msg_iov[i].iov_base) {
-			errno = ENOMEM;
-			goto fail;
+	for (i = 0; i < vlen; i++) {
+		len = vtable->sendmsg(ctx, &msgvec[i].msg_hdr, flags);
+		if (len < 0) {
+			/* If some messages were sent, the error is reported
+			 * by the next call.
+			 */
+			return i > 0 ? (int)i : -1;
 		}
 
-		msg_copy.msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
+		msgvec[i].msg_len = len;
 	}
 
-	if (msg->msg_namelen > 0) {
-		msg_copy.msg_name = z_user_alloc_from_copy(msg->msg_name,
-							   msg->msg_namelen);
-		if (!msg_copy.msg_name) {
-			errno = ENOMEM;
-			goto fail;
+	return i;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_sendmmsg(int sock,
+					struct zsock_mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct zsock_mmsghdr msg_copy;
+	unsigned int i;
+	int ret;
+
+	/* Copy one message at a time, to bound the memory needed for the
+	 * copies of the user buffers.
+	 */
+	for (i = 0; i < vlen; i++) {
+		ret = user_msghdr_copy(&msg_copy.msg_hdr, &msgvec[i].msg_hdr);
+		if (ret < 0) {
+			errno = -ret;
+		} else {
+			ret = z_impl_zsock_sendmmsg(sock, &msg_copy, 1, flags);
 		}
-	}
 
-	if (msg->msg_controllen > 0) {
-		msg_copy.msg_control = z_user_alloc_from_copy(msg->msg_control,
-							  msg->msg_controllen);
-		if (!msg_copy.msg_control) {
-			errno = ENOMEM;
-			goto fail;
+		user_msghdr_free(&msg_copy.msg_hdr);
+
+		if (ret < 0) {
+			return i > 0 ? (int)i : -1;
 		}
+
+		Z_OOPS(z_user_to_copy(&msgvec[i].msg_len, &msg_copy.msg_len,
+				      sizeof(msg_copy.msg_len)));
 	}
 
-	ret = z_impl_zsock_sendmsg(sock, (const struct msghdr *)&msg_copy,
-				   flags);
+	return i;
+}
+#include <syscalls/zsock_sendmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+#if defined(CONFIG_NET_SOCKETS_SENDFILE)
+/* Buffer for the sockets the data can't be read directly into */
+#define SENDFILE_COPY_LEN 128
 
-	k_free(msg_copy.msg_name);
-	k_free(msg_copy.msg_control);
+static int sendfile_fill(void *buf, size_t len, void *user_data)
+{
+	ssize_t ret = fs_read(user_data, buf, len);
 
-	for (i = 0; i < msg_copy.msg_iovlen; i++) {
-		k_free(msg_copy.msg_iov[i].iov_base);
+	if (ret < 0) {
+		return ret;
 	}
 
-	k_free(msg_copy.msg_iov);
+	/* The length was clamped to the file size, no EOF expected */
+	return (ret == len) ? 0 : -EIO;
+}
 
-	return ret;
+static int sendfile_direct(struct net_context *ctx, struct fs_file_t *file,
+			   size_t count, size_t *sent)
+{
+	k_timeout_t timeout = K_FOREVER;
+	int ret;
 
-fail:
-	if (msg_copy.msg_name) {
-		k_free(msg_copy.msg_name);
+	if (sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
 	}
 
-	if (msg_copy.msg_control) {
-		k_free(msg_copy.msg_control);
+	ret = net_context_recv(ctx, zsock_received_cb, K_NO_WAIT,
+			       ctx->user_data);
+	if (ret < 0) {
+		return ret;
 	}
 
-	if (msg_copy.msg_iov) {
-		for (i = 0; i < msg_copy.msg_iovlen; i++) {
-			if (msg_copy.msg_iov[i].iov_base) {
-				k_free(msg_copy.msg_iov[i].iov_base);
-			}
+	while (*sent < count) {
+		ret = net_context_send_from(ctx, sendfile_fill, file,
+					    count - *sent, NULL, timeout,
+					    ctx->user_data);
+		if (ret < 0) {
+			return ret;
 		}
 
-		k_free(msg_copy.msg_iov);
+		*sent += ret;
 	}
 
-	return -1;
+	return 0;
 }
-#include <syscalls/zsock_sendmsg_mrsh.c>
-#endif /* CONFIG_USERSPACE */
+
+static int sendfile_copy(int sock, struct fs_file_t *file, size_t count,
+			 size_t *sent)
+{
+	uint8_t buf[SENDFILE_COPY_LEN];
+	ssize_t len;
+
+	while (*sent < count) {
+		len = fs_read(file, buf, MIN(sizeof(buf), count - *sent));
+		if (len <= 0) {
+			return len < 0 ? len : -EIO;
+		}
+
+		len = zsock_send(sock, buf, len, 0);
+		if (len < 0) {
+			return -errno;
+		}
+
+		*sent += len;
+	}
+
+	return 0;
+}
+
+ssize_t zsock_sendfile(int sock, struct fs_file_t *file, off_t *offset,
+		       size_t count)
+{
+	const struct socket_op_vtable *vtable;
+	size_t sent = 0;
+	off_t start;
+	off_t end;
+	off_t pos;
+	void *ctx;
+	int ret;
+
+	ctx = get_sock_vtable(sock, &vtable);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	start = fs_tell(file);
+	pos = offset ? *offset : start;
+
+	ret = fs_seek(file, 0, FS_SEEK_END);
+	if (ret == 0) {
+		end = fs_tell(file);
+		ret = fs_seek(file, pos, FS_SEEK_SET);
+	}
+
+	if (ret < 0 || start < 0 || end < 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	count = MIN(count, end > pos ? end - pos : 0);
+
+	if (vtable == &sock_fd_op_vtable) {
+		ret = sendfile_direct(ctx, file, count, &sent);
+	} else {
+		ret = sendfile_copy(sock, file, count, &sent);
+	}
+
+	/* Data read for a packet which was not sent is read again next
+	 * time, so set the position from what was actually sent.
+	 */
+	if (offset) {
+		*offset = pos + sent;
+		(void)fs_seek(file, start, FS_SEEK_SET);
+	} else {
+		(void)fs_seek(file, pos + sent, FS_SEEK_SET);
+	}
+
+	if (sent == 0 && ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return sent;
+}
+#endif /* CONFIG_NET_SOCKETS_SENDFILE */
 
 static int sock_get_pkt_src_addr(struct net_pkt *pkt,
 				 enum net_ip_protocol proto,
@@ -864,7 +1082,7 @@ void net_socket_update_tc_rx_time(struct net_pkt *pkt, uint32_t end_tick)
 				    net_pkt_timestamp(pkt)->nanosecond,
 				    end_tick);
 
-	if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS_DETAIL)) {
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS_DETAIL)) {
 		uint32_t val, prev = net_pkt_timestamp(pkt)->nanosecond;
 		int i;
 
@@ -886,16 +1104,18 @@ void net_socket_update_tc_rx_time(struct net_pkt *pkt, uint32_t end_tick)
 }
 
 static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
-				       void *buf,
-				       size_t max_len,
+				       struct iovec *iov,
+				       size_t iovlen,
 				       int flags,
 				       struct sockaddr *src_addr,
-				       socklen_t *addrlen)
+				       socklen_t *addrlen,
+				       int *msg_flags)
 {
 	k_timeout_t timeout = K_FOREVER;
 	size_t recv_len = 0;
 	struct net_pkt_cursor backup;
 	struct net_pkt *pkt;
+	size_t i;
 
 	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
 		timeout = K_NO_WAIT;
@@ -946,14 +1166,19 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 		}
 	}
 
-	recv_len = net_pkt_remaining_data(pkt);
-	if (recv_len > max_len) {
-		recv_len = max_len;
+	for (i = 0; i < iovlen && net_pkt_remaining_data(pkt) > 0; i++) {
+		size_t len = MIN(iov[i].iov_len, net_pkt_remaining_data(pkt));
+
+		if (net_pkt_read(pkt, iov[i].iov_base, len)) {
+			errno = ENOBUFS;
+			goto fail;
+		}
+
+		recv_len += len;
 	}
 
-	if (net_pkt_read(pkt, buf, recv_len)) {
-		errno = ENOBUFS;
-		goto fail;
+	if (msg_flags && net_pkt_remaining_data(pkt) > 0) {
+		*msg_flags |= ZSOCK_MSG_TRUNC;
 	}
 
 	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) &&
@@ -1079,7 +1304,13 @@ ssize_t zsock_recvfrom_ctx(struct net_context *ctx, void *buf, size_t max_len,
 	}
 
 	if (sock_type == SOCK_DGRAM) {
-		return zsock_recv_dgram(ctx, buf, max_len, flags, src_addr, addrlen);
+		struct iovec iov = {
+			.iov_base = buf,
+			.iov_len = max_len,
+		};
+
+		return zsock_recv_dgram(ctx, &iov, 1, flags, src_addr, addrlen,
+					NULL);
 	} else if (sock_type == SOCK_STREAM) {
 		return zsock_recv_stream(ctx, buf, max_len, flags);
 	} else {
@@ -1127,6 +1358,204 @@ ssize_t z_vrfy_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 #include <syscalls/zsock_recvfrom_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct msghdr *msg,
+			  int flags)
+{
+	if (net_context_get_type(ctx) != SOCK_DGRAM) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	/* No ancillary data is supported */
+	msg->msg_controllen = 0;
+	msg->msg_flags = 0;
+
+	return zsock_recv_dgram(ctx, msg->msg_iov, msg->msg_iovlen, flags,
+				msg->msg_name,
+				msg->msg_name ? &msg->msg_namelen : NULL,
+				&msg->msg_flags);
+}
+
+int z_impl_zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	unsigned int i;
+	ssize_t len;
+	void *ctx;
+
+	ctx = get_sock_vtable(sock, &vtable);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->recvmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	for (i = 0; i < vlen; i++) {
+		len = vtable->recvmsg(ctx, &msgvec[i].msg_hdr, flags);
+		if (len < 0) {
+			return i > 0 ? (int)i : -1;
+		}
+
+		msgvec[i].msg_len = len;
+
+		/* Only wait for the first datagram */
+		flags |= ZSOCK_MSG_DONTWAIT;
+	}
+
+	return i;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_recvmmsg(int sock,
+					struct zsock_mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct zsock_mmsghdr *msgvec_copy;
+	unsigned int iov_copies = 0;
+	unsigned int i;
+	size_t size;
+	size_t j;
+	int ret = -1;
+
+	if (size_mul_overflow(vlen, sizeof(*msgvec), &size)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	msgvec_copy = z_user_alloc_from_copy(msgvec, size);
+	if (!msgvec_copy) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	/* The data is received directly into the user buffers, only the
+	 * message headers and the iovec arrays are copied.
+	 */
+	for (i = 0; i < vlen; i++) {
+		struct msghdr *msg = &msgvec_copy[i].msg_hdr;
+
+		if (size_mul_overflow(msg->msg_iovlen, sizeof(struct iovec),
+				      &size)) {
+			errno = EINVAL;
+			goto out;
+		}
+
+		msg->msg_iov = z_user_alloc_from_copy(msg->msg_iov, size);
+		if (!msg->msg_iov) {
+			errno = ENOMEM;
+			goto out;
+		}
+
+		iov_copies++;
+
+		for (j = 0; j < msg->msg_iovlen; j++) {
+			if (Z_SYSCALL_MEMORY_WRITE(msg->msg_iov[j].iov_base,
+						   msg->msg_iov[j].iov_len)) {
+				errno = EFAULT;
+				goto out;
+			}
+		}
+
+		if (msg->msg_name &&
+		    Z_SYSCALL_MEMORY_WRITE(msg->msg_name, msg->msg_namelen)) {
+			errno = EFAULT;
+			goto out;
+		}
+
+		msg->msg_control = NULL;
+	}
+
+	ret = z_impl_zsock_recvmmsg(sock, msgvec_copy, vlen, flags);
+
+	for (i = 0; ret > 0 && i < (unsigned int)ret; i++) {
+		struct zsock_mmsghdr *msg_copy = &msgvec_copy[i];
+
+		z_user_to_copy(&msgvec[i].msg_len, &msg_copy->msg_len,
+			       sizeof(msg_copy->msg_len));
+		z_user_to_copy(&msgvec[i].msg_hdr.msg_namelen,
+			       &msg_copy->msg_hdr.msg_namelen,
+			       sizeof(msg_copy->msg_hdr.msg_namelen));
+		z_user_to_copy(&msgvec[i].msg_hdr.msg_controllen,
+			       &msg_copy->msg_hdr.msg_controllen,
+			       sizeof(msg_copy->msg_hdr.msg_controllen));
+		z_user_to_copy(&msgvec[i].msg_hdr.msg_flags,
+			       &msg_copy->msg_hdr.msg_flags,
+			       sizeof(msg_copy->msg_hdr.msg_flags));
+	}
+
+out:
+	for (i = 0; i < iov_copies; i++) {
+		k_free(msgvec_copy[i].msg_hdr.msg_iov);
+	}
+
+	k_free(msgvec_copy);
+
+	return ret;
+}
+#include <syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int zsock_recv_pkts(int sock, struct net_pkt *pkts[], unsigned int count,
+		    int flags, struct sockaddr_storage *src_addrs)
+{
+	const struct socket_op_vtable *vtable;
+	k_timeout_t timeout = K_FOREVER;
+	struct net_context *ctx;
+	unsigned int i;
+
+	ctx = get_sock_vtable(sock, &vtable);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	/* The packets are only accessible from supervisor mode */
+	if (_is_user_context() || vtable != &sock_fd_op_vtable ||
+	    net_context_get_type(ctx) != SOCK_DGRAM) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	}
+
+	for (i = 0; i < count; i++) {
+		struct net_pkt *pkt;
+
+		/* Only wait for the first datagram */
+		pkt = k_fifo_get(&ctx->recv_q, i == 0 ? timeout : K_NO_WAIT);
+		if (!pkt) {
+			break;
+		}
+
+		if (src_addrs &&
+		    sock_get_pkt_src_addr(pkt, net_context_get_ip_proto(ctx),
+					  (struct sockaddr *)&src_addrs[i],
+					  sizeof(src_addrs[i])) < 0) {
+			src_addrs[i].ss_family = AF_UNSPEC;
+		}
+
+		if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+			net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+		}
+
+		pkts[i] = pkt;
+	}
+
+	if (i == 0) {
+		errno = EAGAIN;
+		return -1;
+	}
+
+	return i;
+}
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -1449,6 +1878,55 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 
 				return 0;
 			}
+
+			break;
+
+		case SO_REUSEPORT:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_REUSEPORT)) {
+				bool reuseport;
+
+				if (*optlen < sizeof(int)) {
+					errno = EINVAL;
+					return -1;
+				}
+
+				ret = net_context_get_option(ctx,
+							     NET_OPT_REUSEPORT,
+							     &reuseport, NULL);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				*(int *)optval = reuseport;
+				*optlen = sizeof(int);
+
+				return 0;
+			}
+
+			break;
+		}
+
+		break;
+
+	case IPPROTO_TCP:
+		switch (optname) {
+#if defined(CONFIG_NET_TCP2)
+		case TCP_NODELAY: {
+			size_t len = *optlen;
+
+			ret = net_tcp_get_option(ctx, TCP_OPT_NODELAY,
+						 optval, &len);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+
+			*optlen = len;
+
+			return 0;
+		}
+#endif
 		}
 
 		break;
@@ -1509,6 +1987,31 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			 */
 			return 0;
 
+		case SO_REUSEPORT:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_REUSEPORT)) {
+				bool reuseport;
+
+				if (optlen != sizeof(int)) {
+					errno = EINVAL;
+					return -1;
+				}
+
+				reuseport = *(const int *)optval != 0;
+
+				ret = net_context_set_option(ctx,
+							     NET_OPT_REUSEPORT,
+							     &reuseport,
+							     sizeof(reuseport));
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+
 		case SO_PRIORITY:
 			if (IS_ENABLED(CONFIG_NET_CONTEXT_PRIORITY)) {
 				ret = net_context_set_option(ctx,
@@ -1578,8 +2081,16 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 	case IPPROTO_TCP:
 		switch (optname) {
 		case TCP_NODELAY:
-			/* Ignore for now. Provided to let port
-			 * existing apps.
+#if defined(CONFIG_NET_TCP2)
+			ret = net_tcp_set_option(ctx, TCP_OPT_NODELAY,
+						 optval, optlen);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+#endif
+			/* The legacy TCP stack ignores this, provided to
+			 * let port existing apps.
 			 */
 			return 0;
 		}
@@ -1820,6 +2331,11 @@ static ssize_t sock_recvfrom_vmeth(void *obj, void *buf, size_t max_len,
 				  src_addr, addrlen);
 }
 
+static ssize_t sock_recvmsg_vmeth(void *obj, struct msghdr *msg, int flags)
+{
+	return zsock_recvmsg_ctx(obj, msg, flags);
+}
+
 static int sock_getsockopt_vmeth(void *obj, int level, int optname,
 				 void *optval, socklen_t *optlen)
 {
@@ -1857,6 +2373,7 @@ const struct socket_op_vtable sock_fd_op_vtable = {
 	.sendto = sock_sendto_vmeth,
 	.sendmsg = sock_sendmsg_vmeth,
 	.recvfrom = sock_recvfrom_vmeth,
+	.recvmsg = sock_recvmsg_vmeth,
 	.getsockopt = sock_getsockopt_vmeth,
 	.setsockopt = sock_setsockopt_vmeth,
 	.getsockname = sock_getsockname_vmeth,
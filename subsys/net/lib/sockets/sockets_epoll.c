@@ -0,0 +1,640 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_sock_epoll, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <kernel.h>
+#include <sys/dlist.h>
+#include <sys/fdtable.h>
+#include <net/net_context.h>
+#include <net/socket.h>
+
+#include "sockets_internal.h"
+
+/* Most objects need one poll event per direction */
+#define EPOLL_POLL_EVENTS 2
+
+#define EPOLL_EVENTS_MASK (ZSOCK_EPOLLIN | ZSOCK_EPOLLOUT)
+#define EPOLL_REVENTS_MASK (ZSOCK_EPOLLIN | ZSOCK_EPOLLOUT | \
+			    ZSOCK_EPOLLERR | ZSOCK_EPOLLHUP)
+
+struct epoll_entry {
+	/* Node in the list of entries which are ready without waiting */
+	sys_dnode_t node;
+
+	/* Registered file descriptor, -1 if the entry is free */
+	int fd;
+	void *obj;
+	const struct fd_op_vtable *vtable;
+
+	struct zsock_epoll_event event;
+
+	/* Events of the object, registered with the instance poll set */
+	struct k_poll_event poll_events[EPOLL_POLL_EVENTS];
+	uint8_t poll_count;
+
+	bool pending;
+};
+
+struct epoll_instance {
+	struct k_poll_set set;
+	struct k_mutex lock;
+
+	/* Entries whose POLL_PREPARE reported them ready already, e.g. for
+	 * writing or at EOF. Those are checked on each wait.
+	 */
+	sys_dlist_t immediate;
+
+	struct epoll_entry entries[CONFIG_NET_SOCKETS_EPOLL_MAX_FDS];
+	int count;
+
+	/* Whether the entries are offloaded sockets, valid if count > 0 */
+	bool offloaded;
+	bool in_use;
+};
+
+static struct epoll_instance epoll_instances[CONFIG_NET_SOCKETS_EPOLL_INSTANCES];
+static K_MUTEX_DEFINE(epoll_lock);
+
+static const struct fd_op_vtable epoll_fd_op_vtable;
+
+static void entry_disarm(struct epoll_instance *inst,
+			 struct epoll_entry *entry)
+{
+	int i;
+
+	for (i = 0; i < entry->poll_count; i++) {
+		k_poll_set_remove(&inst->set, &entry->poll_events[i]);
+	}
+
+	entry->poll_count = 0;
+
+	if (sys_dnode_is_linked(&entry->node)) {
+		sys_dlist_remove(&entry->node);
+	}
+}
+
+/* Ask the object for the poll events matching the registered event mask
+ * and add them to the poll set, where they stay until disarmed.
+ */
+static int entry_arm(struct epoll_instance *inst, struct epoll_entry *entry)
+{
+	struct zsock_pollfd pfd = {
+		.fd = entry->fd,
+		.events = entry->event.events & EPOLL_EVENTS_MASK,
+	};
+	struct k_poll_event *pev = entry->poll_events;
+	int ret;
+	int i;
+
+	(void)memset(entry->poll_events, 0, sizeof(entry->poll_events));
+
+	ret = z_fdtable_call_ioctl(entry->vtable, entry->obj,
+				   ZFD_IOCTL_POLL_PREPARE, &pfd, &pev,
+				   entry->poll_events +
+				   ARRAY_SIZE(entry->poll_events));
+	if (ret != 0 && ret != -EALREADY) {
+		return ret;
+	}
+
+	entry->poll_count = pev - entry->poll_events;
+
+	for (i = 0; i < entry->poll_count; i++) {
+		k_poll_set_add(&inst->set, &entry->poll_events[i]);
+	}
+
+	/* Nothing to report for an entry without events, even at EOF */
+	if (ret == -EALREADY && pfd.events != 0) {
+		sys_dlist_append(&inst->immediate, &entry->node);
+	}
+
+	return 0;
+}
+
+static void entry_free(struct epoll_instance *inst, struct epoll_entry *entry)
+{
+	entry_disarm(inst, entry);
+	entry->fd = -1;
+	inst->count--;
+}
+
+static struct epoll_entry *entry_find(struct epoll_instance *inst, int fd)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(inst->entries); i++) {
+		if (inst->entries[i].fd == fd) {
+			return &inst->entries[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct epoll_entry *event_to_entry(struct epoll_instance *inst,
+					  struct k_poll_event *event)
+{
+	size_t offset = (uint8_t *)event - (uint8_t *)inst->entries;
+
+	return &inst->entries[offset / sizeof(struct epoll_entry)];
+}
+
+static ssize_t epoll_read_vmeth(void *obj, void *buffer, size_t count)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(count);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static ssize_t epoll_write_vmeth(void *obj, const void *buffer, size_t count)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(count);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static int epoll_close_vmeth(void *obj)
+{
+	struct epoll_instance *inst = obj;
+	int i;
+
+	k_mutex_lock(&epoll_lock, K_FOREVER);
+	k_mutex_lock(&inst->lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(inst->entries); i++) {
+		if (inst->entries[i].fd >= 0) {
+			entry_free(inst, &inst->entries[i]);
+		}
+	}
+
+	inst->in_use = false;
+
+	k_mutex_unlock(&inst->lock);
+	k_mutex_unlock(&epoll_lock);
+
+	return 0;
+}
+
+static int epoll_ioctl_vmeth(void *obj, unsigned int request, va_list args)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(request);
+	ARG_UNUSED(args);
+
+	/* Epoll instances cannot be polled nor nested */
+	errno = EOPNOTSUPP;
+	return -1;
+}
+
+static const struct fd_op_vtable epoll_fd_op_vtable = {
+	.read = epoll_read_vmeth,
+	.write = epoll_write_vmeth,
+	.close = epoll_close_vmeth,
+	.ioctl = epoll_ioctl_vmeth,
+};
+
+int zsock_epoll_create(int size)
+{
+	struct epoll_instance *inst = NULL;
+	int fd;
+	int i;
+
+	if (size <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(epoll_instances); i++) {
+		if (!epoll_instances[i].in_use) {
+			inst = &epoll_instances[i];
+			break;
+		}
+	}
+
+	if (inst == NULL) {
+		k_mutex_unlock(&epoll_lock);
+		errno = ENFILE;
+		return -1;
+	}
+
+	fd = z_reserve_fd();
+	if (fd < 0) {
+		k_mutex_unlock(&epoll_lock);
+		return -1;
+	}
+
+	k_poll_set_init(&inst->set);
+	k_mutex_init(&inst->lock);
+	sys_dlist_init(&inst->immediate);
+
+	for (i = 0; i < ARRAY_SIZE(inst->entries); i++) {
+		sys_dnode_init(&inst->entries[i].node);
+		inst->entries[i].fd = -1;
+		inst->entries[i].poll_count = 0;
+		inst->entries[i].pending = false;
+	}
+
+	inst->count = 0;
+	inst->offloaded = false;
+	inst->in_use = true;
+
+	z_finalize_fd(fd, inst, &epoll_fd_op_vtable);
+
+	k_mutex_unlock(&epoll_lock);
+
+	NET_DBG("epoll: inst=%p, fd=%d", inst, fd);
+
+	return fd;
+}
+
+static int epoll_add(struct epoll_instance *inst, int fd, void *obj,
+		     const struct fd_op_vtable *vtable,
+		     struct zsock_epoll_event *event)
+{
+	struct epoll_entry *entry;
+	bool offloaded;
+	int ret;
+
+	if (entry_find(inst, fd) != NULL) {
+		return -EEXIST;
+	}
+
+	entry = entry_find(inst, -1);
+	if (entry == NULL) {
+		return -ENOSPC;
+	}
+
+	entry->fd = fd;
+	entry->obj = obj;
+	entry->vtable = vtable;
+	entry->event = *event;
+
+	ret = entry_arm(inst, entry);
+	offloaded = (ret == -EXDEV);
+	if (ret != 0 && !offloaded) {
+		entry->fd = -1;
+		return ret;
+	}
+
+	/* Offloaded sockets are waited for by their own poll handler, which
+	 * cannot be fed native ones.
+	 */
+	if (inst->count > 0 && offloaded != inst->offloaded) {
+		entry_disarm(inst, entry);
+		entry->fd = -1;
+		return -EPERM;
+	}
+
+	inst->offloaded = offloaded;
+	inst->count++;
+
+	return 0;
+}
+
+static int epoll_mod(struct epoll_instance *inst, struct epoll_entry *entry,
+		     struct zsock_epoll_event *event)
+{
+	int ret;
+
+	entry_disarm(inst, entry);
+	entry->event = *event;
+
+	ret = entry_arm(inst, entry);
+	if (ret == -EXDEV) {
+		ret = 0;
+	}
+
+	if (ret != 0) {
+		entry_free(inst, entry);
+	}
+
+	return ret;
+}
+
+int zsock_epoll_ctl(int epfd, int op, int fd, struct zsock_epoll_event *event)
+{
+	struct epoll_instance *inst;
+	struct epoll_entry *entry;
+	const struct fd_op_vtable *vtable;
+	void *obj;
+	int ret;
+
+	inst = z_get_fd_obj(epfd, &epoll_fd_op_vtable, EINVAL);
+	if (inst == NULL) {
+		return -1;
+	}
+
+	if (fd == epfd) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (op != ZSOCK_EPOLL_CTL_DEL && event == NULL) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	obj = z_get_fd_obj_and_vtable(fd, &vtable);
+	if (obj == NULL) {
+		return -1;
+	}
+
+	if (vtable == &epoll_fd_op_vtable) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	k_mutex_lock(&inst->lock, K_FOREVER);
+
+	switch (op) {
+	case ZSOCK_EPOLL_CTL_ADD:
+		ret = epoll_add(inst, fd, obj, vtable, event);
+		break;
+
+	case ZSOCK_EPOLL_CTL_MOD:
+		entry = entry_find(inst, fd);
+		ret = entry ? epoll_mod(inst, entry, event) : -ENOENT;
+		break;
+
+	case ZSOCK_EPOLL_CTL_DEL:
+		entry = entry_find(inst, fd);
+		if (entry != NULL) {
+			entry_free(inst, entry);
+			ret = 0;
+		} else {
+			ret = -ENOENT;
+		}
+		break;
+
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	k_mutex_unlock(&inst->lock);
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+void zsock_epoll_fd_closed(int fd)
+{
+	struct epoll_instance *inst;
+	struct epoll_entry *entry;
+	int i;
+
+	k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(epoll_instances); i++) {
+		inst = &epoll_instances[i];
+		if (!inst->in_use) {
+			continue;
+		}
+
+		k_mutex_lock(&inst->lock, K_FOREVER);
+
+		entry = entry_find(inst, fd);
+		if (entry != NULL) {
+			entry_free(inst, entry);
+		}
+
+		k_mutex_unlock(&inst->lock);
+	}
+
+	k_mutex_unlock(&epoll_lock);
+}
+
+/* Refresh an entry after it was found ready, returns its revents. The
+ * events are registered again, since the object to wait for may change
+ * with the state of the socket (e.g. TLS handshake completion).
+ */
+static int entry_update(struct epoll_instance *inst, struct epoll_entry *entry)
+{
+	struct zsock_pollfd pfd = {
+		.fd = entry->fd,
+		.events = entry->event.events & EPOLL_EVENTS_MASK,
+	};
+	struct k_poll_event *pev = entry->poll_events;
+	int result;
+
+	result = z_fdtable_call_ioctl(entry->vtable, entry->obj,
+				      ZFD_IOCTL_POLL_UPDATE, &pfd, &pev);
+	/* EAGAIN: ready for a reason not visible to the application */
+	if (result != 0 && result != -EAGAIN) {
+		pfd.revents |= ZSOCK_EPOLLERR;
+	}
+
+	entry_disarm(inst, entry);
+
+	if (entry_arm(inst, entry) != 0) {
+		pfd.revents |= ZSOCK_EPOLLERR;
+	}
+
+	return pfd.revents & EPOLL_REVENTS_MASK;
+}
+
+static int epoll_wait_offload(struct epoll_instance *inst,
+			      struct zsock_epoll_event *events,
+			      int maxevents, int timeout)
+{
+	struct zsock_pollfd pfds[CONFIG_NET_SOCKETS_EPOLL_MAX_FDS];
+	const struct fd_op_vtable *vtable = NULL;
+	void *obj = NULL;
+	int nfds = 0;
+	int nready = 0;
+	int ret;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(inst->entries); i++) {
+		struct epoll_entry *entry = &inst->entries[i];
+
+		if (entry->fd < 0) {
+			continue;
+		}
+
+		pfds[nfds].fd = entry->fd;
+		pfds[nfds].events = entry->event.events & EPOLL_EVENTS_MASK;
+		pfds[nfds].revents = 0;
+		nfds++;
+
+		obj = entry->obj;
+		vtable = entry->vtable;
+	}
+
+	k_mutex_unlock(&inst->lock);
+
+	ret = z_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_POLL_OFFLOAD,
+				   pfds, nfds, timeout);
+
+	k_mutex_lock(&inst->lock, K_FOREVER);
+
+	if (ret <= 0) {
+		return ret;
+	}
+
+	for (i = 0; i < nfds && nready < maxevents; i++) {
+		struct epoll_entry *entry;
+
+		if (pfds[i].revents == 0) {
+			continue;
+		}
+
+		entry = entry_find(inst, pfds[i].fd);
+		if (entry == NULL) {
+			continue;
+		}
+
+		events[nready].events = pfds[i].revents & EPOLL_REVENTS_MASK;
+		events[nready].data = entry->event.data;
+		nready++;
+	}
+
+	return nready;
+}
+
+int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+		     int maxevents, int timeout)
+{
+	struct epoll_instance *inst;
+	struct k_poll_event *ready[CONFIG_NET_SOCKETS_EPOLL_MAX_FDS];
+	struct epoll_entry *pending[CONFIG_NET_SOCKETS_EPOLL_MAX_FDS];
+	struct epoll_entry *entry;
+	k_timeout_t wait_timeout;
+	int nready = 0;
+	uint64_t end;
+
+	inst = z_get_fd_obj(epfd, &epoll_fd_op_vtable, EINVAL);
+	if (inst == NULL) {
+		return -1;
+	}
+
+	if (events == NULL || maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (timeout < 0) {
+		wait_timeout = K_FOREVER;
+		timeout = SYS_FOREVER_MS;
+	} else {
+		wait_timeout = K_MSEC(timeout);
+	}
+
+	end = z_timeout_end_calc(wait_timeout);
+
+	k_mutex_lock(&inst->lock, K_FOREVER);
+
+	if (inst->count > 0 && inst->offloaded) {
+		nready = epoll_wait_offload(inst, events, maxevents, timeout);
+		k_mutex_unlock(&inst->lock);
+
+		return nready;
+	}
+
+	do {
+		k_timeout_t poll_timeout = wait_timeout;
+		int npending = 0;
+		int count;
+		int i;
+
+		if (!sys_dlist_is_empty(&inst->immediate)) {
+			poll_timeout = K_NO_WAIT;
+		}
+
+		/* Do not block ctl() and close() of other threads while
+		 * waiting, entries changed meanwhile are checked below.
+		 */
+		k_mutex_unlock(&inst->lock);
+
+		count = k_poll_set_wait(&inst->set, ready,
+					MIN(maxevents, ARRAY_SIZE(ready)),
+					poll_timeout);
+
+		k_mutex_lock(&inst->lock, K_FOREVER);
+
+		for (i = 0; i < count; i++) {
+			entry = event_to_entry(inst, ready[i]);
+			if (!entry->pending) {
+				entry->pending = true;
+				pending[npending++] = entry;
+			}
+		}
+
+		SYS_DLIST_FOR_EACH_CONTAINER(&inst->immediate, entry, node) {
+			if (!entry->pending) {
+				entry->pending = true;
+				pending[npending++] = entry;
+			}
+		}
+
+		for (i = 0; i < npending; i++) {
+			const struct fd_op_vtable *vtable;
+			uint32_t revents;
+			void *obj;
+
+			entry = pending[i];
+			entry->pending = false;
+
+			/* Events not handled now are reported by the next
+			 * wait, as the poll set re-arms them.
+			 */
+			if (entry->fd < 0 || nready == maxevents) {
+				continue;
+			}
+
+			/* The descriptor may have been closed without going
+			 * through zsock_close(), e.g. with POSIX close().
+			 */
+			obj = z_get_fd_obj_and_vtable(entry->fd, &vtable);
+			if (obj != entry->obj || vtable != entry->vtable) {
+				entry_free(inst, entry);
+				continue;
+			}
+
+			revents = entry_update(inst, entry);
+			if (revents != 0) {
+				events[nready].events = revents;
+				events[nready].data = entry->event.data;
+				nready++;
+			}
+		}
+
+		if (nready > 0 || K_TIMEOUT_EQ(wait_timeout, K_NO_WAIT)) {
+			break;
+		}
+
+		/* Woken up without anything to report, e.g. a TLS socket
+		 * which only made handshake progress: wait for the rest
+		 * of the period.
+		 */
+		if (!K_TIMEOUT_EQ(wait_timeout, K_FOREVER)) {
+			int64_t remaining = end - z_tick_get();
+
+			if (remaining <= 0) {
+				break;
+			}
+
+			wait_timeout = Z_TIMEOUT_TICKS(remaining);
+		}
+	} while (true);
+
+	k_mutex_unlock(&inst->lock);
+
+	return nready;
+}
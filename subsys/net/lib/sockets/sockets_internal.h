@@ -32,6 +32,9 @@ void net_socket_update_tc_rx_time(struct net_pkt *pkt, uint32_t end_tick);
 #define sock_set_eof(ctx) sock_set_flag(ctx, SOCK_EOF, SOCK_EOF)
 #define sock_is_nonblock(ctx) sock_get_flag(ctx, SOCK_NONBLOCK)
 
+/* Drop a file descriptor being closed from the epoll instances */
+void zsock_epoll_fd_closed(int fd);
+
 struct socket_op_vtable {
 	struct fd_op_vtable fd_vtable;
 	int (*bind)(void *obj, const struct sockaddr *addr, socklen_t addrlen);
@@ -48,6 +51,7 @@ struct socket_op_vtable {
 	int (*setsockopt)(void *obj, int level, int optname,
 			  const void *optval, socklen_t optlen);
 	ssize_t (*sendmsg)(void *obj, const struct msghdr *msg, int flags);
+	ssize_t (*recvmsg)(void *obj, struct msghdr *msg, int flags);
 	int (*getsockname)(void *obj, struct sockaddr *addr,
 			   socklen_t *addrlen);
 };
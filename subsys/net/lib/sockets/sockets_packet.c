@@ -6,6 +6,7 @@
 
 #include <stdbool.h>
 #include <fcntl.h>
+#include <string.h>
 
 #include <logging/log.h>
 LOG_MODULE_REGISTER(net_sock_packet, CONFIG_NET_SOCKETS_LOG_LEVEL);
@@ -39,6 +40,233 @@ static inline int k_fifo_wait_non_empty(struct k_fifo *fifo,
 	return k_poll(events, ARRAY_SIZE(events), timeout);
 }
 
+#if defined(CONFIG_NET_SOCKETS_PACKET_RX_RING)
+/* Receive ring set with PACKET_RX_RING, owned by ctx while non-NULL */
+struct packet_rx_ring {
+	struct net_context *ctx;
+	uint8_t *frames;
+	uint32_t frame_size;
+	uint32_t frame_nr;
+	/* Next frame filled by the stack */
+	uint32_t head;
+	bool losing;
+	struct zsock_tpacket_stats stats;
+	struct k_poll_signal signal;
+};
+
+static struct packet_rx_ring rx_rings[CONFIG_NET_SOCKETS_PACKET_RX_RING_COUNT];
+
+/* Held while a frame is stored, so that close() can release the ring */
+static K_MUTEX_DEFINE(rx_rings_lock);
+
+static struct packet_rx_ring *rx_ring_find(struct net_context *ctx)
+{
+	for (int i = 0; i < ARRAY_SIZE(rx_rings); i++) {
+		if (rx_rings[i].ctx == ctx) {
+			return &rx_rings[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct zsock_tpacket_hdr *rx_ring_frame(struct packet_rx_ring *ring,
+					       uint32_t idx)
+{
+	return (struct zsock_tpacket_hdr *)(ring->frames +
+					    idx * ring->frame_size);
+}
+
+static int rx_ring_set(struct net_context *ctx,
+		       const struct zsock_tpacket_req *req)
+{
+	size_t size = (size_t)req->tp_frame_size * req->tp_frame_nr;
+	struct packet_rx_ring *ring;
+	int ret = 0;
+
+	if (req->tp_ring == NULL || req->tp_frame_nr == 0U ||
+	    req->tp_frame_size <= TPACKET_HDRLEN ||
+	    (req->tp_frame_size % TPACKET_ALIGNMENT) != 0U ||
+	    ((uintptr_t)req->tp_ring % TPACKET_ALIGNMENT) != 0U ||
+	    size / req->tp_frame_nr != req->tp_frame_size) {
+		return -EINVAL;
+	}
+
+#if defined(CONFIG_USERSPACE)
+	/* The stack writes the frames on behalf of the caller */
+	if (z_is_in_user_syscall() &&
+	    arch_buffer_validate(req->tp_ring, size, 1) != 0) {
+		return -EFAULT;
+	}
+#endif
+
+	k_mutex_lock(&rx_rings_lock, K_FOREVER);
+
+	if (rx_ring_find(ctx) != NULL) {
+		ret = -EBUSY;
+		goto out;
+	}
+
+	ring = rx_ring_find(NULL);
+	if (ring == NULL) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	ring->frames = req->tp_ring;
+	ring->frame_size = req->tp_frame_size;
+	ring->frame_nr = req->tp_frame_nr;
+	ring->head = 0U;
+	ring->losing = false;
+	(void)memset(&ring->stats, 0, sizeof(ring->stats));
+	k_poll_signal_init(&ring->signal);
+
+	for (uint32_t i = 0U; i < ring->frame_nr; i++) {
+		atomic_set(&rx_ring_frame(ring, i)->tp_status,
+			   TP_STATUS_KERNEL);
+	}
+
+	ring->ctx = ctx;
+
+out:
+	k_mutex_unlock(&rx_rings_lock);
+
+	return ret;
+}
+
+static void rx_ring_release(struct net_context *ctx)
+{
+	struct packet_rx_ring *ring;
+
+	k_mutex_lock(&rx_rings_lock, K_FOREVER);
+
+	ring = rx_ring_find(ctx);
+	if (ring != NULL) {
+		ring->ctx = NULL;
+	}
+
+	k_mutex_unlock(&rx_rings_lock);
+}
+
+/* Store a received frame in the ring of ctx, false if ctx has no ring */
+static bool rx_ring_store(struct net_context *ctx, struct net_pkt *pkt)
+{
+	struct zsock_tpacket_hdr *hdr;
+	struct packet_rx_ring *ring;
+	struct net_ptp_time *ts;
+	uint32_t status;
+	size_t len;
+
+	k_mutex_lock(&rx_rings_lock, K_FOREVER);
+
+	ring = rx_ring_find(ctx);
+	if (ring == NULL) {
+		k_mutex_unlock(&rx_rings_lock);
+		return false;
+	}
+
+	hdr = rx_ring_frame(ring, ring->head);
+	if (atomic_get(&hdr->tp_status) != TP_STATUS_KERNEL) {
+		ring->stats.tp_drops++;
+		ring->losing = true;
+		goto out;
+	}
+
+	len = net_pkt_get_len(pkt);
+	hdr->tp_len = len;
+	hdr->tp_snaplen = MIN(len, ring->frame_size - TPACKET_HDRLEN);
+	hdr->tp_mac = TPACKET_HDRLEN;
+	hdr->tp_ifindex = net_if_get_by_iface(net_pkt_iface(pkt));
+
+	ts = net_pkt_timestamp(pkt);
+	hdr->tp_sec = ts ? ts->second : 0U;
+	hdr->tp_nsec = ts ? ts->nanosecond : 0U;
+
+	if (net_pkt_read(pkt, (uint8_t *)hdr + TPACKET_HDRLEN,
+			 hdr->tp_snaplen)) {
+		ring->stats.tp_drops++;
+		ring->losing = true;
+		goto out;
+	}
+
+	status = TP_STATUS_USER;
+	if (ring->losing) {
+		status |= TP_STATUS_LOSING;
+		ring->losing = false;
+	}
+
+	/* atomic_set() orders the frame data before the status */
+	atomic_set(&hdr->tp_status, status);
+
+	ring->stats.tp_packets++;
+	ring->head = (ring->head + 1U) % ring->frame_nr;
+	k_poll_signal_raise(&ring->signal, 0);
+
+out:
+	k_mutex_unlock(&rx_rings_lock);
+	net_pkt_unref(pkt);
+
+	return true;
+}
+
+/* A frame is ready if the one before the head belongs to the application */
+static bool rx_ring_readable(struct packet_rx_ring *ring)
+{
+	uint32_t prev = (ring->head + ring->frame_nr - 1U) % ring->frame_nr;
+
+	return atomic_get(&rx_ring_frame(ring, prev)->tp_status) !=
+		TP_STATUS_KERNEL;
+}
+
+static int rx_ring_poll_prepare(struct packet_rx_ring *ring,
+				struct zsock_pollfd *pfd,
+				struct k_poll_event **pev,
+				struct k_poll_event *pev_end)
+{
+	if (pfd->events & ZSOCK_POLLIN) {
+		if (*pev == pev_end) {
+			return -ENOMEM;
+		}
+
+		k_poll_signal_reset(&ring->signal);
+
+		(*pev)->obj = &ring->signal;
+		(*pev)->type = K_POLL_TYPE_SIGNAL;
+		(*pev)->mode = K_POLL_MODE_NOTIFY_ONLY;
+		(*pev)->state = K_POLL_STATE_NOT_READY;
+		(*pev)++;
+
+		if (rx_ring_readable(ring)) {
+			return -EALREADY;
+		}
+	}
+
+	if (pfd->events & ZSOCK_POLLOUT) {
+		return -EALREADY;
+	}
+
+	return 0;
+}
+
+static int rx_ring_poll_update(struct packet_rx_ring *ring,
+			       struct zsock_pollfd *pfd,
+			       struct k_poll_event **pev)
+{
+	if (pfd->events & ZSOCK_POLLOUT) {
+		pfd->revents |= ZSOCK_POLLOUT;
+	}
+
+	if (pfd->events & ZSOCK_POLLIN) {
+		if (rx_ring_readable(ring)) {
+			pfd->revents |= ZSOCK_POLLIN;
+		}
+		(*pev)++;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_NET_SOCKETS_PACKET_RX_RING */
+
 static int zpacket_socket(int family, int type, int proto)
 {
 	struct net_context *ctx;
@@ -104,6 +332,12 @@ static void zpacket_received_cb(struct net_context *ctx,
 		return;
 	}
 
+#if defined(CONFIG_NET_SOCKETS_PACKET_RX_RING)
+	if (rx_ring_store(ctx, pkt)) {
+		return;
+	}
+#endif
+
 	/* Normal packet */
 	net_pkt_set_eof(pkt, false);
 
@@ -259,6 +493,36 @@ int zpacket_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 		return -1;
 	}
 
+#if defined(CONFIG_NET_SOCKETS_PACKET_RX_RING)
+	if (level == SOL_PACKET && optname == PACKET_STATISTICS) {
+		struct packet_rx_ring *ring;
+
+		if (*optlen < sizeof(struct zsock_tpacket_stats)) {
+			errno = EINVAL;
+			return -1;
+		}
+
+		k_mutex_lock(&rx_rings_lock, K_FOREVER);
+
+		ring = rx_ring_find(ctx);
+		if (ring != NULL) {
+			/* Counters are reset on read, as on Linux */
+			memcpy(optval, &ring->stats, sizeof(ring->stats));
+			(void)memset(&ring->stats, 0, sizeof(ring->stats));
+		}
+
+		k_mutex_unlock(&rx_rings_lock);
+
+		if (ring == NULL) {
+			errno = EINVAL;
+			return -1;
+		}
+
+		*optlen = sizeof(struct zsock_tpacket_stats);
+		return 0;
+	}
+#endif
+
 	return sock_fd_op_vtable.getsockopt(ctx, level, optname,
 					    optval, optlen);
 }
@@ -266,6 +530,26 @@ int zpacket_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 int zpacket_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			const void *optval, socklen_t optlen)
 {
+#if defined(CONFIG_NET_SOCKETS_PACKET_RX_RING)
+	if (level == SOL_PACKET && optname == PACKET_RX_RING) {
+		int ret;
+
+		if (optval == NULL ||
+		    optlen != sizeof(struct zsock_tpacket_req)) {
+			errno = EINVAL;
+			return -1;
+		}
+
+		ret = rx_ring_set(ctx, optval);
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+
+		return 0;
+	}
+#endif
+
 	return sock_fd_op_vtable.setsockopt(ctx, level, optname,
 					    optval, optlen);
 }
@@ -284,9 +568,44 @@ static ssize_t packet_sock_write_vmeth(void *obj, const void *buffer,
 static int packet_sock_ioctl_vmeth(void *obj, unsigned int request,
 				   va_list args)
 {
+#if defined(CONFIG_NET_SOCKETS_PACKET_RX_RING)
+	struct packet_rx_ring *ring = rx_ring_find(obj);
+
+	if (ring != NULL && request == ZFD_IOCTL_POLL_PREPARE) {
+		struct zsock_pollfd *pfd;
+		struct k_poll_event **pev;
+		struct k_poll_event *pev_end;
+
+		pfd = va_arg(args, struct zsock_pollfd *);
+		pev = va_arg(args, struct k_poll_event **);
+		pev_end = va_arg(args, struct k_poll_event *);
+
+		return rx_ring_poll_prepare(ring, pfd, pev, pev_end);
+	}
+
+	if (ring != NULL && request == ZFD_IOCTL_POLL_UPDATE) {
+		struct zsock_pollfd *pfd;
+		struct k_poll_event **pev;
+
+		pfd = va_arg(args, struct zsock_pollfd *);
+		pev = va_arg(args, struct k_poll_event **);
+
+		return rx_ring_poll_update(ring, pfd, pev);
+	}
+#endif
+
 	return sock_fd_op_vtable.fd_vtable.ioctl(obj, request, args);
 }
 
+static int packet_sock_close_vmeth(void *obj)
+{
+#if defined(CONFIG_NET_SOCKETS_PACKET_RX_RING)
+	rx_ring_release(obj);
+#endif
+
+	return sock_fd_op_vtable.fd_vtable.close(obj);
+}
+
 /*
  * TODO: A packet socket can be bound to a network device using SO_BINDTODEVICE.
  */
@@ -358,6 +677,7 @@ static const struct socket_op_vtable packet_sock_fd_op_vtable = {
 		.read = packet_sock_read_vmeth,
 		.write = packet_sock_write_vmeth,
 		.ioctl = packet_sock_ioctl_vmeth,
+		.close = packet_sock_close_vmeth,
 	},
 	.bind = packet_sock_bind_vmeth,
 	.connect = packet_sock_connect_vmeth,
@@ -14,6 +14,7 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <init.h>
 #include <drivers/entropy.h>
 #include <sys/util.h>
+#include <sys/crc.h>
 #include <net/net_context.h>
 #include <net/socket.h>
 #include <random/rand32.h>
@@ -33,6 +34,7 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <mbedtls/x509_crt.h>
 #include <mbedtls/ssl.h>
 #include <mbedtls/ssl_cookie.h>
+#include <mbedtls/ssl_ticket.h>
 #include <mbedtls/error.h>
 #include <mbedtls/debug.h>
 #endif /* CONFIG_MBEDTLS */
@@ -80,6 +82,9 @@ struct tls_context {
 	/** Socket flags passed to a socket call. */
 	int flags;
 
+	/** mbedTLS read error to report on the next TLS read. */
+	int read_err;
+
 	/** Information whether TLS context was initialized. */
 	bool is_initialized;
 
@@ -103,6 +108,11 @@ struct tls_context {
 
 		/** DTLS role, client by default. */
 		int8_t role;
+
+		/** Information whether the session can be resumed later:
+		 *  cached by clients, issued as a ticket by servers.
+		 */
+		bool cache_enabled;
 	} options;
 
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
@@ -142,6 +152,46 @@ struct tls_context {
 
 static mbedtls_ctr_drbg_context tls_ctr_drbg;
 
+#if CONFIG_NET_SOCKETS_TLS_SESSION_CACHE_SIZE > 0
+/** Client session kept for resumption, by session ID or ticket. */
+struct tls_session_cache {
+	/** Information whether the entry is used. */
+	bool is_used;
+
+	/** Time the session was stored, to replace the oldest one. */
+	uint32_t timestamp;
+
+	/** Hash of the hostname the session was established for. */
+	uint32_t hostname_hash;
+
+	/** Address of the peer the session was established with. */
+	struct sockaddr peer_addr;
+
+	/** mbedTLS session. */
+	mbedtls_ssl_session session;
+};
+
+static struct tls_session_cache
+session_cache[CONFIG_NET_SOCKETS_TLS_SESSION_CACHE_SIZE];
+
+static struct zsock_tls_session_cache_stats session_cache_stats;
+
+/* A mutex for protecting the session cache. */
+static struct k_mutex session_cache_lock;
+#endif /* CONFIG_NET_SOCKETS_TLS_SESSION_CACHE_SIZE > 0 */
+
+#if CONFIG_NET_SOCKETS_TLS_SERVER_TICKET_LIFETIME > 0 && \
+	defined(MBEDTLS_SSL_TICKET_C) && \
+	defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_SRV_C)
+#define TLS_SERVER_TICKETS 1
+
+/* Keys protecting the session tickets issued by servers, shared by all
+ * sockets and rotated by mbedTLS once per ticket lifetime.
+ */
+static mbedtls_ssl_ticket_context tls_ticket_ctx;
+static bool tls_ticket_ready;
+#endif
+
 /* A global pool of TLS contexts. */
 static struct tls_context tls_contexts[CONFIG_NET_SOCKETS_TLS_MAX_CONTEXTS];
 
@@ -290,6 +340,26 @@ static int tls_init(struct device *unused)
 	mbedtls_debug_set_threshold(CONFIG_MBEDTLS_DEBUG_LEVEL);
 #endif
 
+#if CONFIG_NET_SOCKETS_TLS_SESSION_CACHE_SIZE > 0
+	k_mutex_init(&session_cache_lock);
+#endif
+
+#if defined(TLS_SERVER_TICKETS)
+	mbedtls_ssl_ticket_init(&tls_ticket_ctx);
+
+	ret = mbedtls_ssl_ticket_setup(&tls_ticket_ctx,
+				       mbedtls_ctr_drbg_random, &tls_ctr_drbg,
+				       MBEDTLS_CIPHER_AES_128_GCM,
+				       CONFIG_NET_SOCKETS_TLS_SERVER_TICKET_LIFETIME);
+	if (ret != 0) {
+		/* Servers will not issue tickets, but still work. */
+		mbedtls_ssl_ticket_free(&tls_ticket_ctx);
+		NET_WARN("TLS session ticket keys setup failed");
+	} else {
+		tls_ticket_ready = true;
+	}
+#endif
+
 	return 0;
 }
 
@@ -759,6 +829,155 @@ exit:
 	return err;
 }
 
+#if CONFIG_NET_SOCKETS_TLS_SESSION_CACHE_SIZE > 0
+static const struct sockaddr *tls_peer_addr(struct net_context *context)
+{
+#if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
+	if (net_context_get_type(context) == SOCK_DGRAM) {
+		return &context->tls->dtls_peer_addr;
+	}
+#endif
+
+	return &context->remote;
+}
+
+static bool tls_peer_addr_cmp(const struct sockaddr *addr1,
+			      const struct sockaddr *addr2)
+{
+	if (addr1->sa_family != addr2->sa_family) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && addr1->sa_family == AF_INET6) {
+		return (net_sin6(addr1)->sin6_port ==
+			net_sin6(addr2)->sin6_port) &&
+			net_ipv6_addr_cmp(&net_sin6(addr1)->sin6_addr,
+					  &net_sin6(addr2)->sin6_addr);
+	} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
+		   addr1->sa_family == AF_INET) {
+		return (net_sin(addr1)->sin_port ==
+			net_sin(addr2)->sin_port) &&
+			net_ipv4_addr_cmp(&net_sin(addr1)->sin_addr,
+					  &net_sin(addr2)->sin_addr);
+	}
+
+	return false;
+}
+
+static uint32_t tls_hostname_hash(struct net_context *context)
+{
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+	const char *hostname = context->tls->ssl.hostname;
+
+	if (context->tls->options.is_hostname_set && hostname) {
+		return crc32_ieee((const uint8_t *)hostname, strlen(hostname));
+	}
+#endif
+
+	return 0;
+}
+
+static struct tls_session_cache *tls_session_find(const struct sockaddr *addr,
+						  uint32_t hostname_hash)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(session_cache); i++) {
+		if (session_cache[i].is_used &&
+		    session_cache[i].hostname_hash == hostname_hash &&
+		    tls_peer_addr_cmp(&session_cache[i].peer_addr, addr)) {
+			return &session_cache[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Offer the session cached for the peer, if any, for resumption. */
+static void tls_session_restore(struct net_context *context)
+{
+	struct tls_session_cache *entry;
+
+	if (!context->tls->options.cache_enabled) {
+		return;
+	}
+
+	k_mutex_lock(&session_cache_lock, K_FOREVER);
+
+	session_cache_stats.lookups++;
+
+	entry = tls_session_find(tls_peer_addr(context),
+				 tls_hostname_hash(context));
+	if (entry && mbedtls_ssl_set_session(&context->tls->ssl,
+					     &entry->session) == 0) {
+		session_cache_stats.hits++;
+		NET_DBG("Resuming TLS session %p", entry);
+	}
+
+	k_mutex_unlock(&session_cache_lock);
+}
+
+/* Cache the session established with the peer, replacing the one of the
+ * same peer or the oldest one.
+ */
+static void tls_session_store(struct net_context *context)
+{
+	const struct sockaddr *addr = tls_peer_addr(context);
+	uint32_t hostname_hash = tls_hostname_hash(context);
+	struct tls_session_cache *entry;
+	int i;
+
+	if (!context->tls->options.cache_enabled) {
+		return;
+	}
+
+	k_mutex_lock(&session_cache_lock, K_FOREVER);
+
+	entry = tls_session_find(addr, hostname_hash);
+	for (i = 0; !entry && i < ARRAY_SIZE(session_cache); i++) {
+		if (!session_cache[i].is_used) {
+			entry = &session_cache[i];
+		}
+	}
+
+	if (!entry) {
+		entry = &session_cache[0];
+
+		for (i = 1; i < ARRAY_SIZE(session_cache); i++) {
+			if ((int32_t)(session_cache[i].timestamp -
+				      entry->timestamp) < 0) {
+				entry = &session_cache[i];
+			}
+		}
+	}
+
+	if (entry->is_used) {
+		mbedtls_ssl_session_free(&entry->session);
+	}
+
+	mbedtls_ssl_session_init(&entry->session);
+
+	if (mbedtls_ssl_get_session(&context->tls->ssl,
+				    &entry->session) != 0) {
+		mbedtls_ssl_session_free(&entry->session);
+		entry->is_used = false;
+		goto out;
+	}
+
+	entry->is_used = true;
+	entry->timestamp = k_uptime_get_32();
+	entry->hostname_hash = hostname_hash;
+	memcpy(&entry->peer_addr, addr, sizeof(entry->peer_addr));
+	session_cache_stats.stores++;
+
+out:
+	k_mutex_unlock(&session_cache_lock);
+}
+#else
+#define tls_session_restore(context)
+#define tls_session_store(context)
+#endif /* CONFIG_NET_SOCKETS_TLS_SESSION_CACHE_SIZE > 0 */
+
 static int tls_mbedtls_reset(struct net_context *context)
 {
 	int ret;
@@ -769,6 +988,7 @@ static int tls_mbedtls_reset(struct net_context *context)
 	}
 
 	k_sem_init(&context->tls->tls_established, 0, 1);
+	context->tls->read_err = 0;
 
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
 	(void)memset(&context->tls->dtls_peer_addr, 0,
@@ -810,6 +1030,10 @@ static int tls_mbedtls_handshake(struct net_context *context, bool block)
 	}
 
 	if (ret == 0) {
+		if (context->tls->ssl.conf->endpoint == MBEDTLS_SSL_IS_CLIENT) {
+			tls_session_store(context);
+		}
+
 		k_sem_give(&context->tls->tls_established);
 	}
 
@@ -906,6 +1130,16 @@ static int tls_mbedtls_init(struct net_context *context, bool is_server)
 			     mbedtls_ctr_drbg_random,
 			     &tls_ctr_drbg);
 
+#if defined(TLS_SERVER_TICKETS)
+	if (is_server && context->tls->options.cache_enabled &&
+	    tls_ticket_ready) {
+		mbedtls_ssl_conf_session_tickets_cb(&context->tls->config,
+						    mbedtls_ssl_ticket_write,
+						    mbedtls_ssl_ticket_parse,
+						    &tls_ticket_ctx);
+	}
+#endif
+
 	ret = tls_mbedtls_set_credentials(context->tls);
 	if (ret != 0) {
 		return ret;
@@ -920,6 +1154,10 @@ static int tls_mbedtls_init(struct net_context *context, bool is_server)
 		return -ENOMEM;
 	}
 
+	if (!is_server) {
+		tls_session_restore(context);
+	}
+
 	context->tls->is_initialized = true;
 
 	return 0;
@@ -1113,6 +1351,65 @@ static int tls_opt_dtls_role_set(struct net_context *context,
 	return 0;
 }
 
+static int tls_opt_session_cache_set(struct net_context *context,
+				     const void *optval, socklen_t optlen)
+{
+	int *cache;
+
+	if (!optval) {
+		return -EINVAL;
+	}
+
+	if (optlen != sizeof(int)) {
+		return -EINVAL;
+	}
+
+	cache = (int *)optval;
+	if (*cache != TLS_SESSION_CACHE_DISABLED &&
+	    *cache != TLS_SESSION_CACHE_ENABLED) {
+		return -EINVAL;
+	}
+
+	context->tls->options.cache_enabled =
+		(*cache == TLS_SESSION_CACHE_ENABLED);
+
+	return 0;
+}
+
+static int tls_opt_session_cache_get(struct net_context *context,
+				     void *optval, socklen_t *optlen)
+{
+	if (*optlen != sizeof(int)) {
+		return -EINVAL;
+	}
+
+	*(int *)optval = context->tls->options.cache_enabled ?
+			 TLS_SESSION_CACHE_ENABLED :
+			 TLS_SESSION_CACHE_DISABLED;
+
+	return 0;
+}
+
+static int tls_opt_session_cache_stats_get(struct net_context *context,
+					   void *optval, socklen_t *optlen)
+{
+	ARG_UNUSED(context);
+
+#if CONFIG_NET_SOCKETS_TLS_SESSION_CACHE_SIZE > 0
+	if (*optlen != sizeof(struct zsock_tls_session_cache_stats)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&session_cache_lock, K_FOREVER);
+	memcpy(optval, &session_cache_stats, sizeof(session_cache_stats));
+	k_mutex_unlock(&session_cache_lock);
+
+	return 0;
+#else
+	return -ENOPROTOOPT;
+#endif
+}
+
 static int ztls_socket(int family, int type, int proto)
 {
 	enum net_ip_protocol_secure tls_proto = 0;
@@ -1495,14 +1792,59 @@ ssize_t ztls_sendmsg_ctx(struct net_context *ctx, const struct msghdr *msg,
 	return len;
 }
 
+/* mbedtls_ssl_read() returns one record at most. Keep decrypting the
+ * records already received into the user buffer, so that a large buffer
+ * is filled by a single call. An error met on the way is kept for the
+ * next call, the data read so far is returned first.
+ */
+static size_t recv_tls_fill(struct net_context *ctx, uint8_t *buf,
+			    size_t max_len, size_t received)
+{
+	int flags = ctx->tls->flags;
+	int ret;
+
+	ctx->tls->flags |= ZSOCK_MSG_DONTWAIT;
+
+	while (received < max_len &&
+	       (mbedtls_ssl_check_pending(&ctx->tls->ssl) ||
+		!k_fifo_is_empty(&ctx->recv_q))) {
+		ret = mbedtls_ssl_read(&ctx->tls->ssl, buf + received,
+				       max_len - received);
+		if (ret <= 0) {
+			if (ret != MBEDTLS_ERR_SSL_WANT_READ &&
+			    ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
+				ctx->tls->read_err = ret;
+			}
+
+			break;
+		}
+
+		received += ret;
+	}
+
+	ctx->tls->flags = flags;
+
+	return received;
+}
+
 static ssize_t recv_tls(struct net_context *ctx, void *buf,
 			size_t max_len, int flags)
 {
 	int ret;
 
-	ret = mbedtls_ssl_read(&ctx->tls->ssl, buf, max_len);
-	if (ret >= 0) {
-		return ret;
+	if (ctx->tls->read_err != 0) {
+		ret = ctx->tls->read_err;
+		ctx->tls->read_err = 0;
+	} else {
+		ret = mbedtls_ssl_read(&ctx->tls->ssl, buf, max_len);
+	}
+
+	if (ret > 0) {
+		return recv_tls_fill(ctx, buf, max_len, ret);
+	}
+
+	if (ret == 0) {
+		return 0;
 	}
 
 	if (ret == MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY) {
@@ -1870,6 +2212,14 @@ int ztls_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 		err = tls_opt_ciphersuite_used_get(ctx, optval, optlen);
 		break;
 
+	case TLS_SESSION_CACHE:
+		err = tls_opt_session_cache_get(ctx, optval, optlen);
+		break;
+
+	case TLS_SESSION_CACHE_STATS:
+		err = tls_opt_session_cache_stats_get(ctx, optval, optlen);
+		break;
+
 	default:
 		/* Unknown or write-only option. */
 		err = -ENOPROTOOPT;
@@ -1920,6 +2270,10 @@ int ztls_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 		err = tls_opt_dtls_role_set(ctx, optval, optlen);
 		break;
 
+	case TLS_SESSION_CACHE:
+		err = tls_opt_session_cache_set(ctx, optval, optlen);
+		break;
+
 	default:
 		/* Unknown or read-only option. */
 		err = -ENOPROTOOPT;
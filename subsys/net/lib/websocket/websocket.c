@@ -386,6 +386,10 @@ int websocket_connect(int sock, struct websocket_request *wreq,
 	 */
 	ctx->tmp_buf_pos = 0;
 
+#if defined(CONFIG_WEBSOCKET_TX_COALESCE)
+	ctx->tx_buf_pos = 0;
+#endif
+
 	return fd;
 
 out:
@@ -409,6 +413,13 @@ int websocket_disconnect(int ws_sock)
 
 	NET_DBG("[%p] Disconnecting", ctx);
 
+#if defined(CONFIG_WEBSOCKET_TX_COALESCE)
+	/* Best effort, the queued frames are dropped if they cannot be
+	 * sent right away.
+	 */
+	(void)websocket_flush(ws_sock, 0);
+#endif
+
 	(void)close(ctx->sock);
 
 	ret = close(ctx->real_sock);
@@ -439,23 +450,75 @@ static int websocket_ioctl_vmeth(void *obj, unsigned int request, va_list args)
 	return sock_fd_op_vtable.fd_vtable.ioctl(obj, request, args);
 }
 
+/* XOR the data with the masking key, a word at a time once the data
+ * is aligned. The offset is the position of the data in the frame
+ * payload, which selects the key byte to start with.
+ */
+static void websocket_mask_payload(uint8_t *data, size_t len,
+				   uint32_t masking_value, uint64_t offset)
+{
+	uint8_t key[sizeof(uint32_t)];
+	uint8_t rotated[sizeof(uint32_t)];
+	uint32_t word_mask;
+	size_t i = 0;
+	int j;
+
+	sys_put_be32(masking_value, key);
+
+	while (i < len && ((uintptr_t)&data[i] & (sizeof(uint32_t) - 1))) {
+		data[i] ^= key[(offset + i) % sizeof(uint32_t)];
+		i++;
+	}
+
+	if (len - i >= sizeof(uint32_t)) {
+		for (j = 0; j < sizeof(uint32_t); j++) {
+			rotated[j] = key[(offset + i + j) % sizeof(uint32_t)];
+		}
+
+		memcpy(&word_mask, rotated, sizeof(word_mask));
+
+		for (; len - i >= sizeof(uint32_t); i += sizeof(uint32_t)) {
+			*(uint32_t *)&data[i] ^= word_mask;
+		}
+	}
+
+	for (; i < len; i++) {
+		data[i] ^= key[(offset + i) % sizeof(uint32_t)];
+	}
+}
+
 static int websocket_prepare_and_send(struct websocket_context *ctx,
 				      uint8_t *header, size_t header_len,
 				      uint8_t *payload, size_t payload_len,
 				      int32_t timeout)
 {
-	struct iovec io_vector[2];
+	struct iovec io_vector[3];
 	struct msghdr msg;
 
-	io_vector[0].iov_base = header;
-	io_vector[0].iov_len = header_len;
-	io_vector[1].iov_base = payload;
-	io_vector[1].iov_len = payload_len;
-
 	memset(&msg, 0, sizeof(msg));
 
 	msg.msg_iov = io_vector;
-	msg.msg_iovlen = ARRAY_SIZE(io_vector);
+
+#if defined(CONFIG_WEBSOCKET_TX_COALESCE) && !defined(CONFIG_NET_TEST)
+	/* Frames queued by websocket_queue_msg() go out first, in the same
+	 * TCP write as this frame.
+	 */
+	if (ctx->tx_buf_pos > 0) {
+		io_vector[msg.msg_iovlen].iov_base = ctx->tx_buf;
+		io_vector[msg.msg_iovlen].iov_len = ctx->tx_buf_pos;
+		msg.msg_iovlen++;
+	}
+#endif
+
+	io_vector[msg.msg_iovlen].iov_base = header;
+	io_vector[msg.msg_iovlen].iov_len = header_len;
+	msg.msg_iovlen++;
+
+	if (payload_len > 0) {
+		io_vector[msg.msg_iovlen].iov_base = payload;
+		io_vector[msg.msg_iovlen].iov_len = payload_len;
+		msg.msg_iovlen++;
+	}
 
 	if (HEXDUMP_SENT_PACKETS) {
 		LOG_HEXDUMP_DBG(header, header_len, "Header");
@@ -469,54 +532,46 @@ static int websocket_prepare_and_send(struct websocket_context *ctx,
 	return verify_sent_and_received_msg(&msg, !(header[1] & BIT(7)));
 #else
 	k_timeout_t tout = K_FOREVER;
+	int ret;
 
 	if (timeout != SYS_FOREVER_MS) {
 		tout = K_MSEC(timeout);
 	}
 
-	return sendmsg(ctx->real_sock, &msg,
-		       K_TIMEOUT_EQ(tout, K_NO_WAIT) ? MSG_DONTWAIT : 0);
-#endif /* CONFIG_NET_TEST */
-}
+	ret = sendmsg(ctx->real_sock, &msg,
+		      K_TIMEOUT_EQ(tout, K_NO_WAIT) ? MSG_DONTWAIT : 0);
 
-int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
-		       enum websocket_opcode opcode, bool mask, bool final,
-		       int32_t timeout)
-{
-	struct websocket_context *ctx;
-	uint8_t header[MAX_HEADER_LEN], hdr_len = 2;
-	uint8_t *data_to_send = (uint8_t *)payload;
-	int ret;
+#if defined(CONFIG_WEBSOCKET_TX_COALESCE)
+	if (ret >= 0 && ctx->tx_buf_pos > 0) {
+		if ((size_t)ret < ctx->tx_buf_pos) {
+			/* Keep the unsent part of the queued frames, this
+			 * frame was not sent at all.
+			 */
+			memmove(ctx->tx_buf, &ctx->tx_buf[ret],
+				ctx->tx_buf_pos - ret);
+			ctx->tx_buf_pos -= ret;
+			errno = EAGAIN;
+			return -1;
+		}
 
-	if (opcode != WEBSOCKET_OPCODE_DATA_TEXT &&
-	    opcode != WEBSOCKET_OPCODE_DATA_BINARY &&
-	    opcode != WEBSOCKET_OPCODE_CONTINUE &&
-	    opcode != WEBSOCKET_OPCODE_CLOSE &&
-	    opcode != WEBSOCKET_OPCODE_PING &&
-	    opcode != WEBSOCKET_OPCODE_PONG) {
-		return -EINVAL;
-	}
-
-#if defined(CONFIG_NET_TEST)
-	/* Websocket unit test does not use socket layer but feeds
-	 * the data directly here when testing this function.
-	 */
-	ctx = INT_TO_POINTER(ws_sock);
-#else
-	ctx = z_get_fd_obj(ws_sock, NULL, 0);
-	if (ctx == NULL) {
-		return -EBADF;
+		ret -= ctx->tx_buf_pos;
+		ctx->tx_buf_pos = 0;
 	}
+#endif
 
-	if (!PART_OF_ARRAY(contexts, ctx)) {
-		return -ENOENT;
-	}
+	return ret;
 #endif /* CONFIG_NET_TEST */
+}
 
-	NET_DBG("[%p] Len %zd %s/%d/%s", ctx, payload_len, opcode2str(opcode),
-		mask, final ? "final" : "more");
+/* Fill in the frame header and return its length */
+static size_t websocket_build_header(uint8_t *header, size_t payload_len,
+				     enum websocket_opcode opcode,
+				     bool mask, bool final,
+				     uint32_t masking_value)
+{
+	size_t hdr_len = 2;
 
-	memset(header, 0, sizeof(header));
+	memset(header, 0, MAX_HEADER_LEN);
 
 	/* Is this the last packet? */
 	header[0] = final ? BIT(7) : 0;
@@ -549,42 +604,224 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 
 	/* Add masking value if needed */
 	if (mask) {
-		int i;
+		sys_put_be32(masking_value, &header[hdr_len]);
+		hdr_len += sizeof(uint32_t);
+	}
+
+	return hdr_len;
+}
+
+static bool websocket_opcode_is_valid(enum websocket_opcode opcode)
+{
+	return opcode == WEBSOCKET_OPCODE_DATA_TEXT ||
+	       opcode == WEBSOCKET_OPCODE_DATA_BINARY ||
+	       opcode == WEBSOCKET_OPCODE_CONTINUE ||
+	       opcode == WEBSOCKET_OPCODE_CLOSE ||
+	       opcode == WEBSOCKET_OPCODE_PING ||
+	       opcode == WEBSOCKET_OPCODE_PONG;
+}
+
+static int websocket_send_ctx_get(int ws_sock,
+				  struct websocket_context **ctx)
+{
+#if defined(CONFIG_NET_TEST)
+	/* Websocket unit test does not use socket layer but feeds
+	 * the data directly here when testing this function.
+	 */
+	*ctx = INT_TO_POINTER(ws_sock);
+#else
+	*ctx = z_get_fd_obj(ws_sock, NULL, 0);
+	if (*ctx == NULL) {
+		return -EBADF;
+	}
 
-		ctx->masking_value = sys_rand32_get();
+	if (!PART_OF_ARRAY(contexts, *ctx)) {
+		return -ENOENT;
+	}
+#endif /* CONFIG_NET_TEST */
 
-		header[hdr_len++] |= ctx->masking_value >> 24;
-		header[hdr_len++] |= ctx->masking_value >> 16;
-		header[hdr_len++] |= ctx->masking_value >> 8;
-		header[hdr_len++] |= ctx->masking_value;
+	return 0;
+}
 
+int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
+		       enum websocket_opcode opcode, bool mask, bool final,
+		       int32_t timeout)
+{
+	struct websocket_context *ctx;
+	uint8_t header[MAX_HEADER_LEN];
+	uint8_t *data_to_send = (uint8_t *)payload;
+	uint32_t masking_value = 0;
+	size_t hdr_len;
+	int ret;
+
+	if (!websocket_opcode_is_valid(opcode)) {
+		return -EINVAL;
+	}
+
+	ret = websocket_send_ctx_get(ws_sock, &ctx);
+	if (ret < 0) {
+		return ret;
+	}
+
+	NET_DBG("[%p] Len %zd %s/%d/%s", ctx, payload_len, opcode2str(opcode),
+		mask, final ? "final" : "more");
+
+	/* The masking value of the received frame is kept in the context,
+	 * the one of the sent frame must not overwrite it.
+	 */
+	if (mask) {
+		masking_value = sys_rand32_get();
+	}
+
+	hdr_len = websocket_build_header(header, payload_len, opcode, mask,
+					 final, masking_value);
+
+	if (mask && payload_len > 0) {
 		data_to_send = k_malloc(payload_len);
 		if (!data_to_send) {
 			return -ENOMEM;
 		}
 
 		memcpy(data_to_send, payload, payload_len);
-
-		for (i = 0; i < payload_len; i++) {
-			data_to_send[i] ^=
-				ctx->masking_value >> (8 * (3 - i % 4));
-		}
+		websocket_mask_payload(data_to_send, payload_len,
+				       masking_value, 0);
 	}
 
+#if defined(CONFIG_WEBSOCKET_TX_COALESCE) && !defined(CONFIG_NET_TEST)
+	k_mutex_lock(&ctx->lock, K_FOREVER);
+#endif
+
 	ret = websocket_prepare_and_send(ctx, header, hdr_len,
 					 data_to_send, payload_len, timeout);
+
+#if defined(CONFIG_WEBSOCKET_TX_COALESCE) && !defined(CONFIG_NET_TEST)
+	k_mutex_unlock(&ctx->lock);
+#endif
+
 	if (ret < 0) {
-		NET_DBG("Cannot send ws msg (%d)", -errno);
+		ret = -errno;
+		NET_DBG("Cannot send ws msg (%d)", ret);
 		goto quit;
 	}
 
+	ret -= hdr_len;
+
 quit:
 	if (data_to_send != payload) {
 		k_free(data_to_send);
 	}
 
-	return ret - hdr_len;
+	return ret;
+}
+
+#if defined(CONFIG_WEBSOCKET_TX_COALESCE)
+static int websocket_flush_locked(struct websocket_context *ctx,
+				  int32_t timeout)
+{
+	k_timeout_t tout = K_FOREVER;
+	int ret;
+
+	if (timeout != SYS_FOREVER_MS) {
+		tout = K_MSEC(timeout);
+	}
+
+	while (ctx->tx_buf_pos > 0) {
+		ret = send(ctx->real_sock, ctx->tx_buf, ctx->tx_buf_pos,
+			   K_TIMEOUT_EQ(tout, K_NO_WAIT) ? MSG_DONTWAIT : 0);
+		if (ret < 0) {
+			return -errno;
+		}
+
+		memmove(ctx->tx_buf, &ctx->tx_buf[ret],
+			ctx->tx_buf_pos - ret);
+		ctx->tx_buf_pos -= ret;
+	}
+
+	return 0;
+}
+
+int websocket_queue_msg(int ws_sock, const uint8_t *payload,
+			size_t payload_len, enum websocket_opcode opcode,
+			bool mask, bool final, int32_t timeout)
+{
+	struct websocket_context *ctx;
+	uint8_t header[MAX_HEADER_LEN];
+	uint32_t masking_value = 0;
+	size_t hdr_len;
+	int ret;
+
+	if (!websocket_opcode_is_valid(opcode)) {
+		return -EINVAL;
+	}
+
+	ret = websocket_send_ctx_get(ws_sock, &ctx);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (mask) {
+		masking_value = sys_rand32_get();
+	}
+
+	hdr_len = websocket_build_header(header, payload_len, opcode, mask,
+					 final, masking_value);
+
+	/* Frames that can never fit are sent right away, after the queued
+	 * ones.
+	 */
+	if (hdr_len + payload_len > sizeof(ctx->tx_buf)) {
+		return websocket_send_msg(ws_sock, payload, payload_len,
+					  opcode, mask, final, timeout);
+	}
+
+	k_mutex_lock(&ctx->lock, K_FOREVER);
+
+	if (ctx->tx_buf_pos + hdr_len + payload_len > sizeof(ctx->tx_buf)) {
+		ret = websocket_flush_locked(ctx, timeout);
+		if (ret < 0) {
+			goto out;
+		}
+	}
+
+	memcpy(&ctx->tx_buf[ctx->tx_buf_pos], header, hdr_len);
+	ctx->tx_buf_pos += hdr_len;
+
+	/* The copy is masked in place, no need for a separate buffer */
+	memcpy(&ctx->tx_buf[ctx->tx_buf_pos], payload, payload_len);
+	if (mask) {
+		websocket_mask_payload(&ctx->tx_buf[ctx->tx_buf_pos],
+				       payload_len, masking_value, 0);
+	}
+
+	ctx->tx_buf_pos += payload_len;
+	ret = payload_len;
+
+	NET_DBG("[%p] Queued %zd bytes %s, %zd pending", ctx, payload_len,
+		opcode2str(opcode), ctx->tx_buf_pos);
+
+out:
+	k_mutex_unlock(&ctx->lock);
+
+	return ret;
+}
+
+int websocket_flush(int ws_sock, int32_t timeout)
+{
+	struct websocket_context *ctx;
+	int ret;
+
+	ret = websocket_send_ctx_get(ws_sock, &ctx);
+	if (ret < 0) {
+		return ret;
+	}
+
+	k_mutex_lock(&ctx->lock, K_FOREVER);
+	ret = websocket_flush_locked(ctx, timeout);
+	k_mutex_unlock(&ctx->lock);
+
+	return ret;
 }
+#endif /* CONFIG_WEBSOCKET_TX_COALESCE */
 
 static bool websocket_parse_header(uint8_t *buf, size_t buf_len, bool *masked,
 				   uint32_t *mask_value, uint64_t *message_length,
@@ -760,9 +997,9 @@ int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 
 		ctx->total_read = 0;
 
-		memmove(ctx->tmp_buf, &ctx->tmp_buf[header_len],
-			ctx->tmp_buf_len - header_len);
 		ctx->tmp_buf_pos -= header_len;
+		memmove(ctx->tmp_buf, &ctx->tmp_buf[header_len],
+			ctx->tmp_buf_pos);
 
 		if (ctx->tmp_buf_pos == 0) {
 			/* No data after the header, let the caller call
@@ -828,19 +1065,12 @@ int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 	ctx->tmp_buf_pos = left;
 	ctx->total_read += recv_len;
 
-	/* Unmask the data */
+	/* Unmask the data, the part of the payload already read selects
+	 * the masking value byte to start with.
+	 */
 	if (ctx->masked) {
-		/* As we might have less than 4 received bytes, we must select
-		 * which byte from masking value to take. The mask_shift will
-		 * tell that.
-		 */
-		int mask_shift = (ctx->total_read - recv_len) % sizeof(uint32_t);
-		int i;
-
-		for (i = 0; i < recv_len; i++) {
-			buf[i] ^= ctx->masking_value >>
-				(8 * (3 - (i + mask_shift) % 4));
-		}
+		websocket_mask_payload(buf, recv_len, ctx->masking_value,
+				       ctx->total_read - recv_len);
 	}
 
 #if HEXDUMP_RECV_PACKETS
@@ -985,5 +1215,11 @@ void websocket_context_foreach(websocket_context_cb_t cb, void *user_data)
 
 void websocket_init(void)
 {
+	int i;
+
 	k_sem_init(&contexts_lock, 1, UINT_MAX);
+
+	for (i = 0; i < ARRAY_SIZE(contexts); i++) {
+		k_mutex_init(&contexts[i].lock);
+	}
 }
@@ -77,6 +77,17 @@ __net_socket struct websocket_context {
 	 */
 	int real_sock;
 
+#if defined(CONFIG_WEBSOCKET_TX_COALESCE)
+	/** Frames queued by websocket_queue_msg(), already masked. They
+	 * are sent in a single TCP write by the next websocket_send_msg()
+	 * or websocket_flush() call.
+	 */
+	uint8_t tx_buf[CONFIG_WEBSOCKET_TX_COALESCE_BUF_SIZE];
+
+	/** Amount of data in tx_buf */
+	size_t tx_buf_pos;
+#endif
+
 	/** Websocket connection masking value */
 	uint32_t masking_value;
 
@@ -43,6 +43,16 @@ void sys_pm_resume_devices(void);
  */
 enum power_states sys_pm_policy_next_state(int32_t ticks);
 
+/**
+ * @brief Function to report the time spent in a PM state
+ *
+ * @param state State left.
+ * @param ticks Ticks to the next timeout when the state was entered.
+ * @param slept Ticks spent in the state.
+ */
+void sys_pm_policy_state_exit(enum power_states state, int32_t ticks,
+			      int32_t slept);
+
 /**
  * @brief Function to determine whether to put devices in low
  *        power state, given the system PM state.
@@ -6,6 +6,7 @@
 
 #include <zephyr.h>
 #include <kernel.h>
+#include <errno.h>
 #include "pm_policy.h"
 
 #define LOG_LEVEL CONFIG_SYS_PM_LOG_LEVEL /* From power module Kconfig */
@@ -45,6 +46,220 @@ static const unsigned int pm_min_residency[] = {
 #endif /* CONFIG_SYS_POWER_DEEP_SLEEP_STATES */
 };
 
+#ifdef CONFIG_SYS_PM_POLICY_RESIDENCY_PREDICTIVE
+/* Exit latency of the states, in microseconds */
+static const uint32_t pm_exit_latency[] = {
+#ifdef CONFIG_SYS_POWER_SLEEP_STATES
+#ifdef CONFIG_HAS_SYS_POWER_STATE_SLEEP_1
+	CONFIG_SYS_PM_EXIT_LATENCY_SLEEP_1,
+#endif
+
+#ifdef CONFIG_HAS_SYS_POWER_STATE_SLEEP_2
+	CONFIG_SYS_PM_EXIT_LATENCY_SLEEP_2,
+#endif
+
+#ifdef CONFIG_HAS_SYS_POWER_STATE_SLEEP_3
+	CONFIG_SYS_PM_EXIT_LATENCY_SLEEP_3,
+#endif
+#endif /* CONFIG_SYS_POWER_SLEEP_STATES */
+
+#ifdef CONFIG_SYS_POWER_DEEP_SLEEP_STATES
+#ifdef CONFIG_HAS_SYS_POWER_STATE_DEEP_SLEEP_1
+	CONFIG_SYS_PM_EXIT_LATENCY_DEEP_SLEEP_1,
+#endif
+
+#ifdef CONFIG_HAS_SYS_POWER_STATE_DEEP_SLEEP_2
+	CONFIG_SYS_PM_EXIT_LATENCY_DEEP_SLEEP_2,
+#endif
+
+#ifdef CONFIG_HAS_SYS_POWER_STATE_DEEP_SLEEP_3
+	CONFIG_SYS_PM_EXIT_LATENCY_DEEP_SLEEP_3,
+#endif
+#endif /* CONFIG_SYS_POWER_DEEP_SLEEP_STATES */
+};
+
+/* Time spent in the last low power states, in ticks */
+static int32_t idle_history[CONFIG_SYS_PM_POLICY_HISTORY_SIZE];
+static uint8_t idle_history_next;
+static uint8_t idle_history_len;
+static int64_t idle_history_sum;
+
+static sys_slist_t latency_reqs;
+
+struct pm_state_counters {
+	uint32_t count;
+	uint32_t early_wakeups;
+	uint32_t too_deep;
+	uint32_t too_shallow;
+	uint64_t residency;
+};
+
+static struct pm_state_counters pm_counters[ARRAY_SIZE(pm_min_residency)];
+
+/*
+ * The idle time is expected to be the average of the last ones, bounded
+ * by the next timeout. Bursts of interrupts thus keep the system in the
+ * shallow states, while long idle periods bring it back to the deep ones.
+ */
+static int32_t predicted_idle(int32_t ticks)
+{
+	int32_t avg;
+
+	if (idle_history_len == 0U) {
+		return ticks;
+	}
+
+	avg = (int32_t)(idle_history_sum / idle_history_len);
+	if ((ticks == K_TICKS_FOREVER) || (avg < ticks)) {
+		return avg;
+	}
+
+	return ticks;
+}
+
+static uint32_t latency_limit(void)
+{
+	struct sys_pm_latency_req *req;
+	uint32_t limit = UINT32_MAX;
+	unsigned int key;
+
+	key = irq_lock();
+	SYS_SLIST_FOR_EACH_CONTAINER(&latency_reqs, req, node) {
+		limit = MIN(limit, req->latency_us);
+	}
+	irq_unlock(key);
+
+	return limit;
+}
+
+static bool state_allowed(int i, uint32_t limit)
+{
+#ifdef CONFIG_SYS_PM_STATE_LOCK
+	if (!sys_pm_ctrl_is_state_enabled((enum power_states)(i))) {
+		return false;
+	}
+#endif
+	return pm_exit_latency[i] <= limit;
+}
+
+enum power_states sys_pm_policy_next_state(int32_t ticks)
+{
+	uint32_t limit = latency_limit();
+	int32_t idle = predicted_idle(ticks);
+	int i;
+
+	if ((idle != K_TICKS_FOREVER) && (idle < pm_min_residency[0])) {
+		LOG_DBG("Not enough time for PM operations: %d", idle);
+		return SYS_POWER_STATE_ACTIVE;
+	}
+
+	for (i = ARRAY_SIZE(pm_min_residency) - 1; i >= 0; i--) {
+		if (!state_allowed(i, limit)) {
+			continue;
+		}
+
+		if ((idle == K_TICKS_FOREVER) ||
+		    (idle >= pm_min_residency[i])) {
+			LOG_DBG("Selected power state %d "
+				"(ticks: %d, predicted: %d)", i, ticks, idle);
+			return (enum power_states)(i);
+		}
+	}
+
+	LOG_DBG("No suitable power state found!");
+	return SYS_POWER_STATE_ACTIVE;
+}
+
+void sys_pm_policy_state_exit(enum power_states state, int32_t ticks,
+			      int32_t slept)
+{
+	struct pm_state_counters *cnt;
+	int i = (int)state;
+
+	if ((i < 0) || (i >= ARRAY_SIZE(pm_min_residency))) {
+		return;
+	}
+
+	if (idle_history_len == ARRAY_SIZE(idle_history)) {
+		idle_history_sum -= idle_history[idle_history_next];
+	} else {
+		idle_history_len++;
+	}
+
+	idle_history[idle_history_next] = slept;
+	idle_history_sum += slept;
+	idle_history_next = (idle_history_next + 1U) %
+			    ARRAY_SIZE(idle_history);
+
+	cnt = &pm_counters[i];
+	cnt->count++;
+	cnt->residency += slept;
+
+	if ((ticks != K_TICKS_FOREVER) && (slept < ticks)) {
+		cnt->early_wakeups++;
+	}
+
+	if (slept < pm_min_residency[i]) {
+		cnt->too_deep++;
+		return;
+	}
+
+	for (i++; i < ARRAY_SIZE(pm_min_residency); i++) {
+		if (state_allowed(i, latency_limit())) {
+			if (slept >= pm_min_residency[i]) {
+				cnt->too_shallow++;
+			}
+			break;
+		}
+	}
+}
+
+void sys_pm_latency_request(struct sys_pm_latency_req *req,
+			    uint32_t latency_us)
+{
+	unsigned int key;
+
+	key = irq_lock();
+	(void)sys_slist_find_and_remove(&latency_reqs, &req->node);
+	req->latency_us = latency_us;
+	sys_slist_append(&latency_reqs, &req->node);
+	irq_unlock(key);
+}
+
+void sys_pm_latency_release(struct sys_pm_latency_req *req)
+{
+	unsigned int key;
+
+	key = irq_lock();
+	(void)sys_slist_find_and_remove(&latency_reqs, &req->node);
+	irq_unlock(key);
+}
+
+int sys_pm_state_stats_get(enum power_states state,
+			   struct sys_pm_state_stats *stats)
+{
+	struct pm_state_counters *cnt;
+	unsigned int key;
+
+	if (((int)state < 0) || (state >= ARRAY_SIZE(pm_min_residency))) {
+		return -EINVAL;
+	}
+
+	cnt = &pm_counters[state];
+
+	key = irq_lock();
+	stats->count = cnt->count;
+	stats->early_wakeups = cnt->early_wakeups;
+	stats->too_deep = cnt->too_deep;
+	stats->too_shallow = cnt->too_shallow;
+	stats->residency_us = k_ticks_to_us_floor64(cnt->residency);
+	irq_unlock(key);
+
+	return 0;
+}
+
+#else
+
 enum power_states sys_pm_policy_next_state(int32_t ticks)
 {
 	int i;
@@ -73,6 +288,8 @@ enum power_states sys_pm_policy_next_state(int32_t ticks)
 	return SYS_POWER_STATE_ACTIVE;
 }
 
+#endif /* CONFIG_SYS_PM_POLICY_RESIDENCY_PREDICTIVE */
+
 __weak bool sys_pm_policy_low_power_devices(enum power_states pm_state)
 {
 	return sys_pm_is_sleep_state(pm_state);
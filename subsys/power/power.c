@@ -95,6 +95,9 @@ enum power_states _sys_suspend(int32_t ticks)
 #if CONFIG_DEVICE_POWER_MANAGEMENT
 	bool low_power = false;
 #endif
+#ifdef CONFIG_SYS_PM_POLICY_RESIDENCY_PREDICTIVE
+	int64_t entry;
+#endif
 
 	pm_state = (forced_pm_state == SYS_POWER_STATE_AUTO) ?
 		   sys_pm_policy_next_state(ticks) : forced_pm_state;
@@ -144,9 +147,17 @@ enum power_states _sys_suspend(int32_t ticks)
 	}
 
 	/* Enter power state */
+#ifdef CONFIG_SYS_PM_POLICY_RESIDENCY_PREDICTIVE
+	entry = k_uptime_ticks();
+#endif
 	sys_pm_debug_start_timer();
 	sys_set_power_state(pm_state);
 	sys_pm_debug_stop_timer();
+#ifdef CONFIG_SYS_PM_POLICY_RESIDENCY_PREDICTIVE
+	sys_pm_policy_state_exit(pm_state, ticks,
+				 (int32_t)MIN(k_uptime_ticks() - entry,
+					      INT32_MAX));
+#endif
 
 #if CONFIG_DEVICE_POWER_MANAGEMENT
 	if (deep_sleep || low_power) {
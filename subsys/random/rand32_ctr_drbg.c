@@ -26,28 +26,50 @@
 
 #endif /* CONFIG_MBEDTLS */
 
-static K_SEM_DEFINE(state_sem, 1, 1);
+/*
+ * Callers take the first free instance instead of all serializing on a
+ * single generator, each instance being seeded separately.
+ */
+struct ctr_drbg {
+	struct k_sem lock;
+#if defined(CONFIG_MBEDTLS)
+	mbedtls_ctr_drbg_context ctx;
+#elif defined(CONFIG_TINYCRYPT)
+	TCCtrPrng_t ctx;
+#endif
+	bool seeded;
+};
+
+static struct ctr_drbg drbgs[CONFIG_CS_CTR_DRBG_INSTANCES];
 
 static struct device *entropy_driver;
 static const unsigned char drbg_seed[] = CONFIG_CS_CTR_DRBG_PERSONALIZATION;
 
-#if defined(CONFIG_MBEDTLS)
+static int ctr_drbg_entropy_get(uint8_t *buf, size_t len)
+{
+	int ret;
+
+	if (k_is_in_isr()) {
+		ret = entropy_get_entropy_isr(entropy_driver, buf, len,
+					      ENTROPY_BUSYWAIT);
+		return (ret == len) ? 0 : -EIO;
+	}
 
-static mbedtls_ctr_drbg_context ctr_ctx;
+	return entropy_get_entropy(entropy_driver, buf, len);
+}
+
+#if defined(CONFIG_MBEDTLS)
 
 static int ctr_drbg_entropy_func(void *ctx, unsigned char *buf, size_t len)
 {
-	return entropy_get_entropy(ctx, (void *)buf, len);
-}
+	ARG_UNUSED(ctx);
 
-#elif defined(CONFIG_TINYCRYPT)
-
-static TCCtrPrng_t ctr_ctx;
+	return ctr_drbg_entropy_get(buf, len);
+}
 
 #endif /* CONFIG_MBEDTLS */
 
-
-static int ctr_drbg_initialize(void)
+static int ctr_drbg_initialize(struct ctr_drbg *drbg)
 {
 	int ret;
 
@@ -65,16 +87,16 @@ static int ctr_drbg_initialize(void)
 
 #if defined(CONFIG_MBEDTLS)
 
-	mbedtls_ctr_drbg_init(&ctr_ctx);
+	mbedtls_ctr_drbg_init(&drbg->ctx);
 
-	ret = mbedtls_ctr_drbg_seed(&ctr_ctx,
+	ret = mbedtls_ctr_drbg_seed(&drbg->ctx,
 				    ctr_drbg_entropy_func,
-				    entropy_driver,
+				    NULL,
 				    drbg_seed,
 				    sizeof(drbg_seed));
 
 	if (ret != 0) {
-		mbedtls_ctr_drbg_free(&ctr_ctx);
+		mbedtls_ctr_drbg_free(&drbg->ctx);
 		return -EIO;
 	}
 
@@ -82,13 +104,12 @@ static int ctr_drbg_initialize(void)
 
 	uint8_t entropy[TC_AES_KEY_SIZE + TC_AES_BLOCK_SIZE];
 
-	ret = entropy_get_entropy(entropy_driver, (void *)&entropy,
-				  sizeof(entropy));
+	ret = ctr_drbg_entropy_get(entropy, sizeof(entropy));
 	if (ret != 0) {
 		return -EIO;
 	}
 
-	ret = tc_ctr_prng_init(&ctr_ctx,
+	ret = tc_ctr_prng_init(&drbg->ctx,
 			       (uint8_t *)&entropy,
 			       sizeof(entropy),
 			       (uint8_t *)drbg_seed,
@@ -100,46 +121,74 @@ static int ctr_drbg_initialize(void)
 
 #endif
 
+	drbg->seeded = true;
+
 	return 0;
 }
 
+static struct ctr_drbg *ctr_drbg_acquire(void)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(drbgs); i++) {
+		if (k_sem_take(&drbgs[i].lock, K_NO_WAIT) == 0) {
+			return &drbgs[i];
+		}
+	}
+
+	if (k_is_in_isr()) {
+		return NULL;
+	}
+
+	/* All busy, spread the waiting threads over the instances */
+	i = POINTER_TO_UINT(k_current_get()) % ARRAY_SIZE(drbgs);
+	k_sem_take(&drbgs[i].lock, K_FOREVER);
+
+	return &drbgs[i];
+}
 
 int z_impl_sys_csrand_get(void *dst, uint32_t outlen)
 {
+	struct ctr_drbg *drbg;
 	int ret;
-	unsigned int key = irq_lock();
 
-	if (unlikely(!entropy_driver)) {
-		ret = ctr_drbg_initialize();
+	drbg = ctr_drbg_acquire();
+	if (!drbg) {
+		return -EBUSY;
+	}
+
+	if (unlikely(!drbg->seeded)) {
+		ret = ctr_drbg_initialize(drbg);
 		if (ret != 0) {
+			k_sem_give(&drbg->lock);
 			return ret;
 		}
 	}
 
 #if defined(CONFIG_MBEDTLS)
 
-	ret = mbedtls_ctr_drbg_random(&ctr_ctx, (unsigned char *)dst, outlen);
+	ret = mbedtls_ctr_drbg_random(&drbg->ctx, (unsigned char *)dst,
+				      outlen);
 
 #elif defined(CONFIG_TINYCRYPT)
 
 	uint8_t entropy[TC_AES_KEY_SIZE + TC_AES_BLOCK_SIZE];
 
-	ret = tc_ctr_prng_generate(&ctr_ctx, 0, 0, (uint8_t *)dst, outlen);
+	ret = tc_ctr_prng_generate(&drbg->ctx, 0, 0, (uint8_t *)dst, outlen);
 
 	if (ret == TC_CRYPTO_SUCCESS) {
 		ret = 0;
 	} else if (ret == TC_CTR_PRNG_RESEED_REQ) {
 
-		entropy_get_entropy(entropy_driver,
-				    (void *)&entropy, sizeof(entropy));
+		ctr_drbg_entropy_get(entropy, sizeof(entropy));
 
-		ret = tc_ctr_prng_reseed(&ctr_ctx,
+		ret = tc_ctr_prng_reseed(&drbg->ctx,
 					entropy,
 					sizeof(entropy),
 					drbg_seed,
 					sizeof(drbg_seed));
 
-		ret = tc_ctr_prng_generate(&ctr_ctx, 0, 0,
+		ret = tc_ctr_prng_generate(&drbg->ctx, 0, 0,
 					   (uint8_t *)dst, outlen);
 
 		ret = (ret == TC_CRYPTO_SUCCESS) ? 0 : -EIO;
@@ -147,7 +196,22 @@ int z_impl_sys_csrand_get(void *dst, uint32_t outlen)
 		ret = -EIO;
 	}
 #endif
-	irq_unlock(key);
+	k_sem_give(&drbg->lock);
 
 	return ret;
 }
+
+static int ctr_drbg_init(struct device *dev)
+{
+	int i;
+
+	ARG_UNUSED(dev);
+
+	for (i = 0; i < ARRAY_SIZE(drbgs); i++) {
+		k_sem_init(&drbgs[i].lock, 1, 1);
+	}
+
+	return 0;
+}
+
+SYS_INIT(ctr_drbg_init, PRE_KERNEL_1, 0);
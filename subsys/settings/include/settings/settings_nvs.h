@@ -38,6 +38,18 @@ struct settings_nvs {
 	struct nvs_fs cf_nvs;
 	uint16_t last_name_id;
 	const char *flash_dev_name;
+#if defined(CONFIG_SETTINGS_NVS_NAME_CACHE)
+	/* Hashes of the stored names, filled when loading all names. When
+	 * cache_complete is set, every stored name is in the cache.
+	 */
+	struct {
+		uint16_t name_hash;
+		uint16_t subtree_hash;
+		uint16_t name_id;
+	} cache[CONFIG_SETTINGS_NVS_NAME_CACHE_SIZE];
+	uint16_t cache_next;
+	bool cache_complete;
+#endif
 };
 
 /* register nvs to be a source of settings */
@@ -222,7 +222,8 @@ static int settings_line_raw_read_until(off_t seek, char *out, size_t len_req,
 				 void *cb_arg)
 {
 	size_t rem_size, len;
-	char temp_buf[16]; /* buffer for fit read-block-size requirements */
+	/* buffer for fit read-block-size requirements */
+	char temp_buf[CONFIG_SETTINGS_LINE_READ_BUF_SIZE];
 	size_t exp_size, read_size;
 	uint8_t rbs = settings_io_cb.rwbs;
 	off_t off;
@@ -235,6 +236,31 @@ static int settings_line_raw_read_until(off_t seek, char *out, size_t len_req,
 	rem_size = len_req;
 
 	while (rem_size) {
+		if ((until_char == NULL) && (seek % rbs == 0) &&
+		    (rem_size >= rbs)) {
+			/* Aligned blocks are read straight into out, in a
+			 * single storage access.
+			 */
+			read_size = rem_size - rem_size % rbs;
+			exp_size = read_size;
+
+			rc = settings_io_cb.read_cb(cb_arg, seek, out,
+						    &read_size);
+			if (rc) {
+				return -EIO;
+			}
+
+			rem_size -= read_size;
+
+			if (exp_size > read_size) {
+				break;
+			}
+
+			out += read_size;
+			seek += read_size;
+			continue;
+		}
+
 		off = seek / rbs * rbs;
 
 		read_size = sizeof(temp_buf);
@@ -12,6 +12,7 @@
 #include "settings/settings_nvs.h"
 #include "settings_priv.h"
 #include <storage/flash_map.h>
+#include <sys/crc.h>
 
 #include <logging/log.h>
 LOG_MODULE_DECLARE(settings, CONFIG_SETTINGS_LOG_LEVEL);
@@ -48,6 +49,112 @@ static ssize_t settings_nvs_read_fn(void *back_end, void *data, size_t len)
 	return rc;
 }
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_CACHE)
+static uint16_t settings_nvs_hash(const char *str, size_t len)
+{
+	return crc16_ccitt(0xffff, (const uint8_t *)str, len);
+}
+
+/* hash of the first name component, which a subtree has to match */
+static uint16_t settings_nvs_subtree_hash(const char *name)
+{
+	return settings_nvs_hash(name, settings_name_next(name, NULL));
+}
+
+static void settings_nvs_cache_add(struct settings_nvs *cf, const char *name,
+				   uint16_t name_id)
+{
+	if (cf->cache_next == ARRAY_SIZE(cf->cache)) {
+		/* Not all names can be cached anymore */
+		cf->cache_complete = false;
+		return;
+	}
+
+	cf->cache[cf->cache_next].name_hash =
+		settings_nvs_hash(name, strlen(name));
+	cf->cache[cf->cache_next].subtree_hash =
+		settings_nvs_subtree_hash(name);
+	cf->cache[cf->cache_next].name_id = name_id;
+	cf->cache_next++;
+}
+
+static void settings_nvs_cache_del(struct settings_nvs *cf, uint16_t name_id)
+{
+	for (uint16_t i = 0; i < cf->cache_next; i++) {
+		if (cf->cache[i].name_id == name_id) {
+			cf->cache[i] = cf->cache[--cf->cache_next];
+			return;
+		}
+	}
+}
+
+static void settings_nvs_cache_reset(struct settings_nvs *cf)
+{
+	cf->cache_next = 0;
+	cf->cache_complete = false;
+}
+
+/* Find the name ID of name among the cached names with the same hash,
+ * NVS_NAMECNT_ID if not found.
+ */
+static uint16_t settings_nvs_cache_match(struct settings_nvs *cf,
+					 const char *name, char *rdname,
+					 size_t len)
+{
+	uint16_t name_hash = settings_nvs_hash(name, strlen(name));
+	ssize_t rc;
+
+	for (uint16_t i = 0; i < cf->cache_next; i++) {
+		if (cf->cache[i].name_hash != name_hash) {
+			continue;
+		}
+
+		rc = nvs_read(&cf->cf_nvs, cf->cache[i].name_id, rdname, len);
+		if (rc <= 0) {
+			continue;
+		}
+
+		rdname[rc] = '\0';
+		if (!strcmp(name, rdname)) {
+			return cf->cache[i].name_id;
+		}
+	}
+
+	return NVS_NAMECNT_ID;
+}
+
+static bool settings_nvs_cache_complete(struct settings_nvs *cf)
+{
+	return cf->cache_complete;
+}
+#else
+static inline void settings_nvs_cache_add(struct settings_nvs *cf,
+					  const char *name, uint16_t name_id)
+{
+}
+
+static inline void settings_nvs_cache_del(struct settings_nvs *cf,
+					  uint16_t name_id)
+{
+}
+
+static inline void settings_nvs_cache_reset(struct settings_nvs *cf)
+{
+}
+
+static inline uint16_t settings_nvs_cache_match(struct settings_nvs *cf,
+						const char *name, char *rdname,
+						size_t len)
+{
+	return NVS_NAMECNT_ID;
+}
+
+static inline bool settings_nvs_cache_complete(struct settings_nvs *cf)
+{
+	return false;
+}
+#endif /* CONFIG_SETTINGS_NVS_NAME_CACHE */
+
 int settings_nvs_src(struct settings_nvs *cf)
 {
 	cf->cf_store.cs_itf = &settings_nvs_itf;
@@ -64,6 +171,55 @@ int settings_nvs_dst(struct settings_nvs *cf)
 	return 0;
 }
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_CACHE)
+/* Load the settings of the cached names, skipping the names that can't be
+ * part of the requested subtree without reading them.
+ */
+static int settings_nvs_load_cached(struct settings_nvs *cf,
+				    const struct settings_load_arg *arg)
+{
+	int ret = 0;
+	struct settings_nvs_read_fn_arg read_fn_arg;
+	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	char buf;
+	ssize_t rc1, rc2;
+	uint16_t subtree_hash = 0U;
+	bool subtree = (arg != NULL) && (arg->subtree != NULL);
+	uint16_t name_id;
+
+	if (subtree) {
+		subtree_hash = settings_nvs_subtree_hash(arg->subtree);
+	}
+
+	for (int i = cf->cache_next - 1; i >= 0; i--) {
+		if (subtree && (cf->cache[i].subtree_hash != subtree_hash)) {
+			continue;
+		}
+
+		name_id = cf->cache[i].name_id;
+		rc1 = nvs_read(&cf->cf_nvs, name_id, &name, sizeof(name));
+		rc2 = nvs_read(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET,
+			       &buf, sizeof(buf));
+		if ((rc1 <= 0) || (rc2 <= 0)) {
+			continue;
+		}
+
+		name[rc1] = '\0';
+		read_fn_arg.fs = &cf->cf_nvs;
+		read_fn_arg.id = name_id + NVS_NAME_ID_OFFSET;
+
+		ret = settings_call_set_handler(
+			name, rc2,
+			settings_nvs_read_fn, &read_fn_arg,
+			(void *)arg);
+		if (ret) {
+			break;
+		}
+	}
+	return ret;
+}
+#endif /* CONFIG_SETTINGS_NVS_NAME_CACHE */
+
 static int settings_nvs_load(struct settings_store *cs,
 			     const struct settings_load_arg *arg)
 {
@@ -75,6 +231,16 @@ static int settings_nvs_load(struct settings_store *cs,
 	ssize_t rc1, rc2;
 	uint16_t name_id = NVS_NAMECNT_ID;
 
+#if defined(CONFIG_SETTINGS_NVS_NAME_CACHE)
+	if (settings_nvs_cache_complete(cf)) {
+		return settings_nvs_load_cached(cf, arg);
+	}
+
+	/* Walking all names below refills the cache */
+	settings_nvs_cache_reset(cf);
+	cf->cache_complete = true;
+#endif
+
 	name_id = cf->last_name_id + 1;
 
 	while (1) {
@@ -114,6 +280,8 @@ static int settings_nvs_load(struct settings_store *cs,
 
 		/* Found a name, this might not include a trailing \0 */
 		name[rc1] = '\0';
+		settings_nvs_cache_add(cf, name, name_id);
+
 		read_fn_arg.fs = &cf->cf_nvs;
 		read_fn_arg.id = name_id + NVS_NAME_ID_OFFSET;
 
@@ -122,12 +290,49 @@ static int settings_nvs_load(struct settings_store *cs,
 			settings_nvs_read_fn, &read_fn_arg,
 			(void *)arg);
 		if (ret) {
+			/* Not all names were walked */
+			settings_nvs_cache_reset(cf);
 			break;
 		}
 	}
 	return ret;
 }
 
+/* Find the name ID of name by reading all names, NVS_NAMECNT_ID if not
+ * found. free_id is set to the lowest free name ID read before, if any.
+ */
+static uint16_t settings_nvs_find(struct settings_nvs *cf, const char *name,
+				  char *rdname, size_t len, uint16_t *free_id)
+{
+	uint16_t name_id = cf->last_name_id + 1;
+	ssize_t rc;
+
+	while (1) {
+		name_id--;
+		if (name_id == NVS_NAMECNT_ID) {
+			break;
+		}
+
+		rc = nvs_read(&cf->cf_nvs, name_id, rdname, len);
+
+		if (rc < 0) {
+			/* Error or entry not found */
+			if (rc == -ENOENT) {
+				*free_id = name_id;
+			}
+			continue;
+		}
+
+		rdname[rc] = '\0';
+
+		if (!strcmp(name, rdname)) {
+			return name_id;
+		}
+	}
+
+	return NVS_NAMECNT_ID;
+}
+
 static int settings_nvs_save(struct settings_store *cs, const char *name,
 			     const char *value, size_t val_len)
 {
@@ -144,32 +349,22 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 	/* Find out if we are doing a delete */
 	delete = ((value == NULL) || (val_len == 0));
 
-	name_id = cf->last_name_id + 1;
 	write_name_id = cf->last_name_id + 1;
 	write_name = true;
 
-	while (1) {
-		name_id--;
-		if (name_id == NVS_NAMECNT_ID) {
-			break;
-		}
-
-		rc = nvs_read(&cf->cf_nvs, name_id, &rdname, sizeof(rdname));
+	name_id = settings_nvs_cache_match(cf, name, rdname, sizeof(rdname));
 
-		if (rc < 0) {
-			/* Error or entry not found */
-			if (rc == -ENOENT) {
-				write_name_id = name_id;
-			}
-			continue;
-		}
-
-		rdname[rc] = '\0';
-
-		if (strcmp(name, rdname)) {
-			continue;
-		}
+	/* When all names are cached, a name that is not is new, and a new
+	 * name ID is allocated unless there is none left.
+	 */
+	if ((name_id == NVS_NAMECNT_ID) &&
+	    (!settings_nvs_cache_complete(cf) ||
+	     (write_name_id == NVS_NAMECNT_ID + NVS_NAME_ID_OFFSET))) {
+		name_id = settings_nvs_find(cf, name, rdname, sizeof(rdname),
+					    &write_name_id);
+	}
 
+	if (name_id != NVS_NAMECNT_ID) {
 		if ((delete) && (name_id == cf->last_name_id)) {
 			cf->last_name_id--;
 			rc = nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
@@ -183,6 +378,8 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 		}
 
 		if (delete) {
+			settings_nvs_cache_del(cf, name_id);
+
 			rc = nvs_delete(&cf->cf_nvs, name_id);
 
 			if (rc >= 0) {
@@ -198,7 +395,6 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 		}
 		write_name_id = name_id;
 		write_name = false;
-		break;
 	}
 
 	if (delete) {
@@ -220,6 +416,7 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 		if (rc < 0) {
 			return rc;
 		}
+		settings_nvs_cache_add(cf, name, write_name_id);
 	}
 
 	/* update the last_name_id and write to flash if required*/
@@ -242,6 +439,8 @@ int settings_nvs_backend_init(struct settings_nvs *cf)
 	int rc;
 	uint16_t last_name_id;
 
+	settings_nvs_cache_reset(cf);
+
 	rc = nvs_init(&cf->cf_nvs, cf->flash_dev_name);
 	if (rc) {
 		return rc;
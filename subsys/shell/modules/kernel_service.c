@@ -14,6 +14,7 @@
 #include <string.h>
 #include <device.h>
 #include <drivers/timer/system_timer.h>
+#include <sw_isr_table.h>
 
 static int cmd_kernel_version(const struct shell *shell,
 			      size_t argc, char **argv)
@@ -74,6 +75,21 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 		      thread->base.timeout.dticks);
 	shell_print(shell, "\tstate: %s", k_thread_state_str(thread));
 
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	k_thread_runtime_stats_t rt_stats_thread;
+	k_thread_runtime_stats_t rt_stats_all;
+
+	if ((k_thread_runtime_stats_get(thread, &rt_stats_thread) == 0) &&
+	    (k_thread_runtime_stats_all_get(&rt_stats_all) == 0)) {
+		pcnt = (unsigned int)((rt_stats_thread.execution_cycles * 100U) /
+				      MAX(rt_stats_all.execution_cycles, 1U));
+
+		shell_print(shell, "\tTotal execution cycles: %llu (%u %%)",
+			    (unsigned long long)rt_stats_thread.execution_cycles,
+			    pcnt);
+	}
+#endif
+
 	ret = k_thread_stack_space_get(thread, &unused);
 	if (ret) {
 		shell_print(shell,
@@ -99,6 +115,20 @@ static int cmd_kernel_threads(const struct shell *shell,
 	shell_print(shell, "Scheduler: %u since last call", z_clock_elapsed());
 	shell_print(shell, "Threads:");
 	k_thread_foreach(shell_tdata_dump, (void *)shell);
+
+#ifdef CONFIG_THREAD_RUNTIME_STATS_ISR
+	k_thread_runtime_stats_t rt_stats;
+
+	shell_print(shell, "Interrupts:");
+	for (unsigned int irq = 0; irq < IRQ_TABLE_SIZE; irq++) {
+		if ((k_isr_runtime_stats_get(irq, &rt_stats) == 0) &&
+		    (rt_stats.execution_cycles != 0U)) {
+			shell_print(shell, " IRQ %02u: execution cycles %llu",
+				    irq,
+				    (unsigned long long)rt_stats.execution_cycles);
+		}
+	}
+#endif
 	return 0;
 }
 
@@ -503,6 +503,13 @@ static int exec_cmd(const struct shell *shell, size_t argc, const char **argv,
 		/* Unlock thread mutex in case command would like to borrow
 		 * shell context to other thread to avoid mutex deadlock.
 		 */
+		struct shell_vt100_colors col;
+
+		if (IS_ENABLED(CONFIG_SHELL_CMD_BUFFERED_OUTPUT)) {
+			shell_vt100_colors_store(shell, &col);
+			shell->fprintf_ctx->ctrl_blk->autoflush = false;
+		}
+
 		k_mutex_unlock(&shell->ctx->wr_mtx);
 		flag_cmd_ctx_set(shell, 1);
 		ret_val = shell->ctx->active_cmd.handler(shell, argc,
@@ -510,6 +517,12 @@ static int exec_cmd(const struct shell *shell, size_t argc, const char **argv,
 		flag_cmd_ctx_set(shell, 0);
 		/* Bring back mutex to shell thread. */
 		k_mutex_lock(&shell->ctx->wr_mtx, K_FOREVER);
+
+		if (IS_ENABLED(CONFIG_SHELL_CMD_BUFFERED_OUTPUT)) {
+			shell->fprintf_ctx->ctrl_blk->autoflush = true;
+			shell_vt100_colors_restore(shell, &col);
+			transport_buffer_flush(shell);
+		}
 	}
 
 	return ret_val;
@@ -1384,7 +1397,9 @@ void shell_vfprintf(const struct shell *shell, enum shell_vt100_color color,
 	if (!flag_cmd_ctx_get(shell)) {
 		shell_print_prompt_and_cmd(shell);
 	}
-	transport_buffer_flush(shell);
+	if (!shell_output_buffered(shell)) {
+		transport_buffer_flush(shell);
+	}
 	k_mutex_unlock(&shell->ctx->wr_mtx);
 }
 
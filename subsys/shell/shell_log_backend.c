@@ -274,6 +274,11 @@ static void panic(const struct log_backend *const backend)
 		shell->log_backend->control_block->state =
 							SHELL_LOG_BACKEND_PANIC;
 
+		/* Output of the interrupted command may still be buffered. */
+		if (IS_ENABLED(CONFIG_SHELL_CMD_BUFFERED_OUTPUT)) {
+			shell_fprintf_buffer_flush(shell->fprintf_ctx);
+		}
+
 		/* Move to the start of next line. */
 		shell_multiline_data_calc(&shell->ctx->vt100_ctx.cons,
 						  shell->ctx->cmd_buff_pos,
@@ -449,6 +449,15 @@ void shell_internal_vfprintf(const struct shell *shell,
 			     va_list args)
 {
 	if (IS_ENABLED(CONFIG_SHELL_VT100_COLORS) &&
+	    shell->ctx->internal.flags.use_colors &&
+	    (color != shell->ctx->vt100_ctx.col.col) &&
+	    shell_output_buffered(shell)) {
+		/* Consecutive prints in the same color do not switch back and
+		 * forth, colors are restored once the command returns.
+		 */
+		shell_vt100_color_set(shell, color);
+		shell_fprintf_fmt(shell->fprintf_ctx, fmt, args);
+	} else if (IS_ENABLED(CONFIG_SHELL_VT100_COLORS) &&
 	    shell->ctx->internal.flags.use_colors &&
 	    (color != shell->ctx->vt100_ctx.col.col)) {
 		struct shell_vt100_colors col;
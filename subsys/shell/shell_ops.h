@@ -141,6 +141,16 @@ static inline void flag_cmd_ctx_set(const struct shell *shell, bool val)
 	shell->ctx->internal.flags.cmd_ctx = val ? 1 : 0;
 }
 
+/* Output of a command running in the shell thread is flushed when the
+ * command returns.
+ */
+static inline bool shell_output_buffered(const struct shell *shell)
+{
+	return IS_ENABLED(CONFIG_SHELL_CMD_BUFFERED_OUTPUT) &&
+	       flag_cmd_ctx_get(shell) &&
+	       (k_current_get() == shell->ctx->tid);
+}
+
 static inline uint8_t flag_last_nl_get(const struct shell *shell)
 {
 	return shell->ctx->internal.flags.last_nl;
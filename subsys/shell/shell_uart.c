@@ -129,6 +129,139 @@ static void uart_callback(struct device *dev, void *user_data)
 }
 #endif /* CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN */
 
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+/* Inactivity period after which received bytes are reported, in ms. */
+#define ASYNC_RX_TIMEOUT 1
+
+/* Starts a transfer of the data at the head of the TX ring buffer, unless
+ * one is already ongoing.
+ */
+static void async_tx_start(const struct shell_uart *sh_uart)
+{
+	uint8_t *data;
+	uint32_t len;
+
+	while (atomic_set(&sh_uart->ctrl_blk->tx_busy, 1) == 0) {
+		len = ring_buf_get_claim(sh_uart->tx_ringbuf, &data,
+					 sh_uart->tx_ringbuf->size);
+		if (len == 0U) {
+			atomic_clear(&sh_uart->ctrl_blk->tx_busy);
+
+			/* Data may have been added before tx_busy was
+			 * cleared, without starting a transfer.
+			 */
+			if (ring_buf_is_empty(sh_uart->tx_ringbuf)) {
+				return;
+			}
+		} else {
+			int err = uart_tx(sh_uart->ctrl_blk->dev, data, len,
+					  SYS_FOREVER_MS);
+
+			(void)err;
+			__ASSERT_NO_MSG(err == 0);
+			return;
+		}
+	}
+}
+
+static void async_rx_handle(const struct shell_uart *sh_uart,
+			    const uint8_t *data, size_t len)
+{
+	bool new_data = false;
+
+	for (size_t i = 0; i < len; i++) {
+#ifdef CONFIG_MCUMGR_SMP_SHELL
+		/* Divert bytes from shell handling if they are part of an
+		 * mcumgr frame.
+		 */
+		if (smp_shell_rx_byte(&sh_uart->ctrl_blk->smp, data[i])) {
+			continue;
+		}
+#endif /* CONFIG_MCUMGR_SMP_SHELL */
+		if (ring_buf_put(sh_uart->rx_ringbuf, &data[i], 1) == 0U) {
+			LOG_WRN("RX ring buffer full.");
+			break;
+		}
+		new_data = true;
+	}
+
+	if (new_data) {
+		sh_uart->ctrl_blk->handler(SHELL_TRANSPORT_EVT_RX_RDY,
+					   sh_uart->ctrl_blk->context);
+	}
+}
+
+static void async_rx_enable(const struct shell_uart *sh_uart)
+{
+	struct shell_uart_ctrl_blk *ctrl_blk = sh_uart->ctrl_blk;
+	int err;
+
+	ctrl_blk->rx_buf_idx = 0;
+	err = uart_rx_enable(ctrl_blk->dev, ctrl_blk->rx_bufs[0],
+			     sizeof(ctrl_blk->rx_bufs[0]), ASYNC_RX_TIMEOUT);
+	if (err) {
+		LOG_ERR("Failed to enable RX (err %d)", err);
+	}
+}
+
+static void async_callback(struct device *dev, struct uart_event *evt,
+			   void *user_data)
+{
+	const struct shell_uart *sh_uart = (struct shell_uart *)user_data;
+	struct shell_uart_ctrl_blk *ctrl_blk = sh_uart->ctrl_blk;
+	int err;
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+	case UART_TX_ABORTED:
+		err = ring_buf_get_finish(sh_uart->tx_ringbuf,
+					  evt->data.tx.len);
+		(void)err;
+		__ASSERT_NO_MSG(err == 0);
+
+		atomic_clear(&ctrl_blk->tx_busy);
+		if (!ctrl_blk->blocking_tx) {
+			async_tx_start(sh_uart);
+		}
+
+		ctrl_blk->handler(SHELL_TRANSPORT_EVT_TX_RDY,
+				  ctrl_blk->context);
+		break;
+
+	case UART_RX_RDY:
+		async_rx_handle(sh_uart,
+				&evt->data.rx.buf[evt->data.rx.offset],
+				evt->data.rx.len);
+		break;
+
+	case UART_RX_BUF_REQUEST:
+		ctrl_blk->rx_buf_idx ^= 1U;
+		(void)uart_rx_buf_rsp(dev,
+				      ctrl_blk->rx_bufs[ctrl_blk->rx_buf_idx],
+				      sizeof(ctrl_blk->rx_bufs[0]));
+		break;
+
+	case UART_RX_DISABLED:
+		/* Reception stops on errors, restart it. */
+		if (ctrl_blk->rx_enabled) {
+			async_rx_enable(sh_uart);
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+static void uart_async_init(const struct shell_uart *sh_uart)
+{
+	uart_callback_set(sh_uart->ctrl_blk->dev, async_callback,
+			  (void *)sh_uart);
+	sh_uart->ctrl_blk->rx_enabled = true;
+	async_rx_enable(sh_uart);
+}
+#endif /* CONFIG_SHELL_BACKEND_SERIAL_ASYNC */
+
 static void uart_irq_init(const struct shell_uart *sh_uart)
 {
 #ifdef CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN
@@ -165,7 +298,11 @@ static int init(const struct shell_transport *transport,
 	sh_uart->ctrl_blk->handler = evt_handler;
 	sh_uart->ctrl_blk->context = context;
 
-	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN)) {
+	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_ASYNC)) {
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+		uart_async_init(sh_uart);
+#endif
+	} else if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN)) {
 		uart_irq_init(sh_uart);
 	} else {
 		k_timer_init(sh_uart->timer, timer_handler, NULL);
@@ -180,7 +317,12 @@ static int uninit(const struct shell_transport *transport)
 {
 	const struct shell_uart *sh_uart = (struct shell_uart *)transport->ctx;
 
-	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN)) {
+	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_ASYNC)) {
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+		sh_uart->ctrl_blk->rx_enabled = false;
+#endif
+		(void)uart_rx_disable(sh_uart->ctrl_blk->dev);
+	} else if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN)) {
 		struct device *dev = sh_uart->ctrl_blk->dev;
 
 		uart_irq_rx_disable(dev);
@@ -201,6 +343,10 @@ static int enable(const struct shell_transport *transport, bool blocking_tx)
 #ifdef CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN
 		uart_irq_tx_disable(sh_uart->ctrl_blk->dev);
 #endif
+		if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_ASYNC)) {
+			/* Polled output must not race with a transfer. */
+			(void)uart_tx_abort(sh_uart->ctrl_blk->dev);
+		}
 	}
 
 	return 0;
@@ -224,7 +370,13 @@ static int write(const struct shell_transport *transport,
 	const struct shell_uart *sh_uart = (struct shell_uart *)transport->ctx;
 	const uint8_t *data8 = (const uint8_t *)data;
 
-	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN) &&
+	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_ASYNC) &&
+	    !sh_uart->ctrl_blk->blocking_tx) {
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+		*cnt = ring_buf_put(sh_uart->tx_ringbuf, data, length);
+		async_tx_start(sh_uart);
+#endif
+	} else if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN) &&
 		!sh_uart->ctrl_blk->blocking_tx) {
 		irq_write(sh_uart, data, length, cnt);
 	} else {
@@ -78,6 +78,55 @@ stats_gen_name(int idx, char *dst)
 	dst[len] = '\0';
 }
 
+#ifdef CONFIG_STATS_PER_CPU
+static uint64_t
+stats_entry_get(const uint8_t *entry, uint8_t size)
+{
+	switch (size) {
+	case sizeof(uint16_t):
+		return *(const uint16_t *)entry;
+	case sizeof(uint32_t):
+		return *(const uint32_t *)entry;
+	default:
+		return *(const uint64_t *)entry;
+	}
+}
+
+static void
+stats_entry_set(uint8_t *entry, uint8_t size, uint64_t val)
+{
+	switch (size) {
+	case sizeof(uint16_t):
+		*(uint16_t *)entry = (uint16_t)val;
+		break;
+	case sizeof(uint32_t):
+		*(uint32_t *)entry = (uint32_t)val;
+		break;
+	default:
+		*(uint64_t *)entry = val;
+		break;
+	}
+}
+
+/**
+ * Stores the sum of the per-CPU copies of an entry in the group.
+ */
+static void
+stats_cpu_sum(struct stats_hdr *hdr, uint16_t off)
+{
+	const uint8_t *cpu = hdr->s_cpu;
+	uint64_t sum = 0;
+	int i;
+
+	for (i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		sum += stats_entry_get(cpu + i * hdr->s_cpu_stride + off,
+				       hdr->s_size);
+	}
+
+	stats_entry_set((uint8_t *)hdr + off, hdr->s_size, sum);
+}
+#endif /* CONFIG_STATS_PER_CPU */
+
 /**
  * Walk a specific statistic entry, and call walk_func with arg for
  * each field within that entry.
@@ -90,6 +139,9 @@ stats_gen_name(int idx, char *dst)
  *   ("s%d", n), where n is the number of the statistic in the structure.
  * - A pointer to the current entry.
  *
+ * Entries of per-CPU groups are updated with the sum of their per-CPU copies
+ * before walk_func is called.
+ *
  * @return 0 on success, the return code of the walk_func on abort.
  *
  */
@@ -109,6 +161,12 @@ stats_walk(struct stats_hdr *hdr, stats_walk_fn *walk_func, void *arg)
 			name = name_buf;
 		}
 
+#ifdef CONFIG_STATS_PER_CPU
+		if (hdr->s_cpu != NULL) {
+			stats_cpu_sum(hdr, stats_get_off(hdr, i));
+		}
+#endif
+
 		rc = walk_func(hdr, arg, name, stats_get_off(hdr, i));
 		if (rc != 0) {
 			return rc;
@@ -136,6 +194,9 @@ stats_init(struct stats_hdr *hdr, uint8_t size, uint16_t cnt,
 {
 	hdr->s_size = size;
 	hdr->s_cnt = cnt;
+#ifdef CONFIG_STATS_PER_CPU
+	hdr->s_cpu = NULL;
+#endif
 #ifdef CONFIG_STATS_NAMES
 	hdr->s_map = map;
 	hdr->s_map_cnt = map_cnt;
@@ -273,6 +334,35 @@ stats_init_and_reg(struct stats_hdr *shdr, uint8_t size, uint16_t cnt,
 	return 0;
 }
 
+#ifdef CONFIG_STATS_PER_CPU
+/**
+ * Initializes and registers the specified per-CPU statistics section.
+ *
+ * @param shdr The statistics header to register
+ * @param cpu_hdr The header of the first of the CONFIG_MP_NUM_CPUS copies of
+ *                the statistics structure.
+ * @param stride The size of the statistics structure.
+ *
+ * See stats_init_and_reg() for the other parameters.
+ *
+ * @return 0 on success, non-zero error code on failure.
+ */
+int
+stats_per_cpu_init_and_reg(struct stats_hdr *shdr, struct stats_hdr *cpu_hdr,
+			   size_t stride, uint8_t size, uint16_t cnt,
+			   const struct stats_name_map *map, uint16_t map_cnt,
+			   const char *name)
+{
+	stats_init(shdr, size, cnt, map, map_cnt);
+
+	shdr->s_cpu = cpu_hdr;
+	shdr->s_cpu_stride = stride;
+	stats_reset(shdr);
+
+	return stats_register(name, shdr);
+}
+#endif /* CONFIG_STATS_PER_CPU */
+
 /**
  * Resets and zeroes the specified statistics section.
  *
@@ -282,4 +372,11 @@ void
 stats_reset(struct stats_hdr *hdr)
 {
 	(void)memset((uint8_t *)hdr + sizeof(*hdr), 0, hdr->s_size * hdr->s_cnt);
+
+#ifdef CONFIG_STATS_PER_CPU
+	for (int i = 0; (hdr->s_cpu != NULL) && (i < CONFIG_MP_NUM_CPUS); i++) {
+		(void)memset((uint8_t *)hdr->s_cpu + i * hdr->s_cpu_stride +
+			     sizeof(*hdr), 0, hdr->s_size * hdr->s_cnt);
+	}
+#endif
 }
@@ -143,7 +143,8 @@ flash_page_cb cb, struct layout_data *cb_data)
 		return -ENODEV;
 	}
 
-	flash_page_foreach(flash_dev, cb, cb_data);
+	flash_page_foreach_in_range(flash_dev, fa->fa_off, fa->fa_size, cb,
+				    cb_data);
 
 	if (cb_data->status == 0) {
 		*cnt = cb_data->ret_idx;
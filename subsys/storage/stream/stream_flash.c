@@ -12,10 +12,21 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME, CONFIG_STREAM_FLASH_LOG_LEVEL);
 
 #include <zephyr/types.h>
 #include <string.h>
+#include <init.h>
 #include <drivers/flash.h>
 
 #include <storage/stream_flash.h>
 
+#ifdef CONFIG_STREAM_FLASH_PROGRESS
+#include <settings/settings.h>
+#endif
+
+#ifdef CONFIG_STREAM_FLASH_DOUBLE_BUFFER
+static struct k_work_q stream_flash_workq;
+static K_THREAD_STACK_DEFINE(stream_flash_workq_stack,
+			     CONFIG_STREAM_FLASH_WORKQ_STACK_SIZE);
+#endif
+
 #ifdef CONFIG_STREAM_FLASH_ERASE
 
 int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
@@ -49,19 +60,14 @@ int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 
 #endif /* CONFIG_STREAM_FLASH_ERASE */
 
-static int flash_sync(struct stream_flash_ctx *ctx)
+/* Erase if needed and program len bytes of buf at write_addr */
+static int flash_program(struct stream_flash_ctx *ctx, const uint8_t *buf,
+			 size_t len, size_t write_addr)
 {
 	int rc = 0;
-	size_t write_addr = ctx->offset + ctx->bytes_written;
-
 
 	if (IS_ENABLED(CONFIG_STREAM_FLASH_ERASE)) {
-		if (ctx->buf_bytes == 0) {
-			return 0;
-		}
-
-		rc = stream_flash_erase_page(ctx,
-					     write_addr + ctx->buf_bytes - 1);
+		rc = stream_flash_erase_page(ctx, write_addr + len - 1);
 		if (rc < 0) {
 			LOG_ERR("stream_flash_erase_page err %d offset=0x%08zx",
 				rc, write_addr);
@@ -70,36 +76,187 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 	}
 
 	flash_write_protection_set(ctx->fdev, false);
-	rc = flash_write(ctx->fdev, write_addr, ctx->buf, ctx->buf_bytes);
+	rc = flash_write(ctx->fdev, write_addr, buf, len);
 	flash_write_protection_set(ctx->fdev, true);
 
 	if (rc != 0) {
 		LOG_ERR("flash_write error %d offset=0x%08zx", rc,
 			write_addr);
+	}
+
+	return rc;
+}
+
+/* Read back the data programmed at write_addr into buf for the callback */
+static int flash_verify(struct stream_flash_ctx *ctx, uint8_t *buf,
+			size_t len, size_t write_addr)
+{
+	int rc;
+
+	if (!ctx->callback) {
+		return 0;
+	}
+
+	/* Invert to ensure that caller is able to discover a faulty
+	 * flash_read() even if no error code is returned.
+	 */
+	for (int i = 0; i < len; i++) {
+		buf[i] = ~buf[i];
+	}
+
+	rc = flash_read(ctx->fdev, write_addr, buf, len);
+	if (rc != 0) {
+		LOG_ERR("flash read failed: %d", rc);
 		return rc;
 	}
 
-	if (ctx->callback) {
-		/* Invert to ensure that caller is able to discover a faulty
-		 * flash_read() even if no error code is returned.
-		 */
-		for (int i = 0; i < ctx->buf_bytes; i++) {
-			ctx->buf[i] = ~ctx->buf[i];
-		}
+	rc = ctx->callback(buf, len, write_addr);
+	if (rc != 0) {
+		LOG_ERR("callback failed: %d", rc);
+	}
 
-		rc = flash_read(ctx->fdev, write_addr, ctx->buf,
-				ctx->buf_bytes);
-		if (rc != 0) {
-			LOG_ERR("flash read failed: %d", rc);
-			return rc;
-		}
+	return rc;
+}
 
-		rc = ctx->callback(ctx->buf, ctx->buf_bytes, write_addr);
-		if (rc != 0) {
-			LOG_ERR("callback failed: %d", rc);
-		}
+#ifdef CONFIG_STREAM_FLASH_DOUBLE_BUFFER
+
+static void flash_sync_work(struct k_work *work)
+{
+	struct stream_flash_ctx *ctx =
+		CONTAINER_OF(work, struct stream_flash_ctx, work);
+	size_t end = ctx->sync_addr + ctx->sync_len;
+	size_t area_end = ctx->offset + ctx->available;
+	int rc;
+
+	rc = flash_program(ctx, ctx->sync_buf, ctx->sync_len, ctx->sync_addr);
+	if (rc == 0) {
+		rc = flash_verify(ctx, ctx->sync_buf, ctx->sync_len,
+				  ctx->sync_addr);
+	}
+
+	/* Erase the page of the next buffer while it is being filled */
+	if (IS_ENABLED(CONFIG_STREAM_FLASH_ERASE) && (rc == 0) &&
+	    (end < area_end)) {
+		rc = stream_flash_erase_page(ctx,
+			MIN(end + ctx->buf_len, area_end) - 1);
+	}
+
+	ctx->sync_rc = rc;
+	k_sem_give(&ctx->idle);
+}
+
+/* Wait for the buffer being programmed, returns its result */
+static int flash_wait_idle(struct stream_flash_ctx *ctx)
+{
+	if (!ctx->buf2) {
+		return 0;
+	}
+
+	k_sem_take(&ctx->idle, K_FOREVER);
+	k_sem_give(&ctx->idle);
+
+	return ctx->sync_rc;
+}
+
+/* Hand the filled buffer over to the work queue and swap buffers. The data
+ * is accounted as written, an error is reported by the next call.
+ */
+static int flash_sync_background(struct stream_flash_ctx *ctx)
+{
+	uint8_t *buf = ctx->buf;
+	int rc;
+
+	if (ctx->buf_bytes == 0) {
+		return 0;
 	}
 
+	k_sem_take(&ctx->idle, K_FOREVER);
+
+	rc = ctx->sync_rc;
+	if (rc != 0) {
+		k_sem_give(&ctx->idle);
+		return rc;
+	}
+
+	ctx->sync_buf = buf;
+	ctx->sync_len = ctx->buf_bytes;
+	ctx->sync_addr = ctx->offset + ctx->bytes_written;
+	ctx->buf = ctx->buf2;
+	ctx->buf2 = buf;
+
+	ctx->bytes_written += ctx->buf_bytes;
+	ctx->buf_bytes = 0U;
+
+	k_work_submit_to_queue(&stream_flash_workq, &ctx->work);
+
+	return 0;
+}
+
+static int stream_flash_workq_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_work_q_start(&stream_flash_workq, stream_flash_workq_stack,
+		       K_THREAD_STACK_SIZEOF(stream_flash_workq_stack),
+		       CONFIG_STREAM_FLASH_WORKQ_PRIORITY);
+	k_thread_name_set(&stream_flash_workq.thread, "stream_flash");
+
+	return 0;
+}
+
+SYS_INIT(stream_flash_workq_init, POST_KERNEL,
+	 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+int stream_flash_double_buffer_set(struct stream_flash_ctx *ctx,
+				   uint8_t *buf2)
+{
+	if (!ctx || !buf2) {
+		return -EFAULT;
+	}
+
+	if (ctx->bytes_written != 0 || ctx->buf_bytes != 0) {
+		return -EBUSY;
+	}
+
+	ctx->buf2 = buf2;
+	ctx->sync_rc = 0;
+	k_work_init(&ctx->work, flash_sync_work);
+	k_sem_init(&ctx->idle, 1, 1);
+
+	return 0;
+}
+
+#else
+
+static inline int flash_wait_idle(struct stream_flash_ctx *ctx)
+{
+	return 0;
+}
+
+#endif /* CONFIG_STREAM_FLASH_DOUBLE_BUFFER */
+
+static int flash_sync(struct stream_flash_ctx *ctx)
+{
+	size_t write_addr = ctx->offset + ctx->bytes_written;
+	int rc;
+
+#ifdef CONFIG_STREAM_FLASH_DOUBLE_BUFFER
+	if (ctx->buf2) {
+		return flash_sync_background(ctx);
+	}
+#endif
+
+	if (IS_ENABLED(CONFIG_STREAM_FLASH_ERASE) && (ctx->buf_bytes == 0)) {
+		return 0;
+	}
+
+	rc = flash_program(ctx, ctx->buf, ctx->buf_bytes, write_addr);
+	if (rc != 0) {
+		return rc;
+	}
+
+	rc = flash_verify(ctx, ctx->buf, ctx->buf_bytes, write_addr);
+
 	ctx->bytes_written += ctx->buf_bytes;
 	ctx->buf_bytes = 0U;
 
@@ -123,6 +280,10 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		return -ENOMEM;
 	}
 
+#ifdef CONFIG_STREAM_FLASH_SHA256
+	tc_sha256_update(&ctx->sha256, data, len);
+#endif
+
 	while ((len - processed) >=
 	       (buf_empty_bytes = ctx->buf_len - ctx->buf_bytes)) {
 		memcpy(ctx->buf + ctx->buf_bytes, data + processed,
@@ -146,6 +307,12 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 	}
 
 	if (flush && ctx->buf_bytes > 0) {
+		/* The page of the filler may be being erased ahead */
+		rc = flash_wait_idle(ctx);
+		if (rc != 0) {
+			return rc;
+		}
+
 		fill_length = flash_get_write_block_size(ctx->fdev);
 		if (ctx->buf_bytes % fill_length) {
 			fill_length -= ctx->buf_bytes % fill_length;
@@ -170,7 +337,12 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		}
 
 		rc = flash_sync(ctx);
+		if (rc == 0) {
+			rc = flash_wait_idle(ctx);
+		}
 		ctx->bytes_written -= fill_length;
+	} else if (flush) {
+		rc = flash_wait_idle(ctx);
 	}
 
 	return rc;
@@ -181,6 +353,110 @@ size_t stream_flash_bytes_written(struct stream_flash_ctx *ctx)
 	return ctx->bytes_written;
 }
 
+#ifdef CONFIG_STREAM_FLASH_SHA256
+int stream_flash_sha256_get(struct stream_flash_ctx *ctx,
+			    uint8_t digest[TC_SHA256_DIGEST_SIZE])
+{
+	/* Finalize a copy so that the stream can be continued */
+	struct tc_sha256_state_struct sha256 = ctx->sha256;
+
+	if (tc_sha256_final(digest, &sha256) != TC_CRYPTO_SUCCESS) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+#endif
+
+#ifdef CONFIG_STREAM_FLASH_PROGRESS
+static int progress_loader(const char *key, size_t len,
+			   settings_read_cb read_cb, void *cb_arg,
+			   void *param)
+{
+	size_t *bytes_written = param;
+	size_t val;
+
+	/* Only the key itself, the backend may also pass stale values
+	 * before the current one.
+	 */
+	if ((settings_name_next(key, NULL) != 0) || (len != sizeof(val))) {
+		return 0;
+	}
+
+	if (read_cb(cb_arg, &val, sizeof(val)) == sizeof(val)) {
+		*bytes_written = val;
+	}
+
+	return 0;
+}
+
+int stream_flash_progress_load(struct stream_flash_ctx *ctx,
+			       const char *settings_key)
+{
+	size_t bytes_written = 0;
+	int rc;
+
+	if (ctx->bytes_written != 0 || ctx->buf_bytes != 0) {
+		return -EBUSY;
+	}
+
+	rc = settings_load_subtree_direct(settings_key, progress_loader,
+					  &bytes_written);
+	if (rc != 0) {
+		return rc;
+	}
+
+	if (bytes_written > ctx->available ||
+	    bytes_written % flash_get_write_block_size(ctx->fdev)) {
+		LOG_ERR("Invalid saved progress %zu", bytes_written);
+		return -EINVAL;
+	}
+
+	ctx->bytes_written = bytes_written;
+
+#ifdef CONFIG_STREAM_FLASH_ERASE
+	/* The page holding the last byte written must not be erased again */
+	if (bytes_written > 0) {
+		struct flash_pages_info page;
+
+		rc = flash_get_page_info_by_offs(ctx->fdev,
+						 ctx->offset + bytes_written - 1,
+						 &page);
+		if (rc != 0) {
+			return rc;
+		}
+
+		ctx->last_erased_page_start_offset = page.start_offset;
+	}
+#endif
+
+	return 0;
+}
+
+int stream_flash_progress_save(struct stream_flash_ctx *ctx,
+			       const char *settings_key)
+{
+	int rc;
+
+	/* Only save what is known to be programmed */
+	rc = flash_wait_idle(ctx);
+	if (rc != 0) {
+		return rc;
+	}
+
+	return settings_save_one(settings_key, &ctx->bytes_written,
+				 sizeof(ctx->bytes_written));
+}
+
+int stream_flash_progress_clear(struct stream_flash_ctx *ctx,
+				const char *settings_key)
+{
+	ARG_UNUSED(ctx);
+
+	return settings_delete(settings_key);
+}
+#endif /* CONFIG_STREAM_FLASH_PROGRESS */
+
 int stream_flash_init(struct stream_flash_ctx *ctx, struct device *fdev,
 		      uint8_t *buf, size_t buf_len, size_t offset, size_t size,
 		      stream_flash_callback_t cb)
@@ -233,5 +509,13 @@ int stream_flash_init(struct stream_flash_ctx *ctx, struct device *fdev,
 	ctx->last_erased_page_start_offset = -1;
 #endif
 
+#ifdef CONFIG_STREAM_FLASH_DOUBLE_BUFFER
+	ctx->buf2 = NULL;
+#endif
+
+#ifdef CONFIG_STREAM_FLASH_SHA256
+	tc_sha256_init(&ctx->sha256);
+#endif
+
 	return 0;
 }
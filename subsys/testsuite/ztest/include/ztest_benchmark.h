@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Ztest benchmark support
+ */
+
+#ifndef __ZTEST_BENCHMARK_H__
+#define __ZTEST_BENCHMARK_H__
+
+#include <zephyr/types.h>
+#include <kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup ztest_benchmark Ztest benchmark support
+ * @ingroup ztest
+ *
+ * This module provides timing, iteration control and statistics for
+ * benchmarks, and reports the results in a common format. These need
+ * CONFIG_ZTEST_BENCHMARK=y, but not CONFIG_ZTEST.
+ *
+ * Each benchmark reports one line:
+ *
+ * @code
+ * BENCH name=<name> iterations=<n> min_ns=<n> avg_ns=<n> p50_ns=<n>
+ *       p99_ns=<n> max_ns=<n> overhead_ns=<n>
+ * @endcode
+ *
+ * on a single line. The percentiles are "n/a" when no sample buffer was
+ * given. Sanitycheck records these lines into recording.csv with this
+ * harness configuration:
+ *
+ * @code
+ * harness_config:
+ *   record:
+ *     regex: "BENCH name=(?P<name>\\S+) iterations=(?P<iterations>\\d+)
+ *             min_ns=(?P<min_ns>\\d+) avg_ns=(?P<avg_ns>\\d+)
+ *             p50_ns=(?P<p50_ns>\\S+) p99_ns=(?P<p99_ns>\\S+)
+ *             max_ns=(?P<max_ns>\\d+) overhead_ns=(?P<overhead_ns>\\d+)"
+ * @endcode
+ *
+ * @{
+ */
+
+/**
+ * @brief Benchmark state and statistics
+ *
+ * Initialize with ztest_bench_init(), the fields are private.
+ */
+struct ztest_bench {
+	const char *name;
+	uint32_t *samples;
+	uint32_t warmup;
+	uint32_t iterations;
+	uint32_t count;
+	uint32_t min;
+	uint32_t max;
+	uint64_t sum;
+	uint32_t overhead;
+	uint32_t start;
+};
+
+/**
+ * @brief Read the cycle counter used by the benchmarks
+ *
+ * @return Current cycle count
+ */
+static inline uint32_t ztest_bench_cycles(void)
+{
+	return k_cycle_get_32();
+}
+
+/**
+ * @brief Initialize a benchmark
+ *
+ * Also calibrates the overhead of a ztest_bench_start() and
+ * ztest_bench_stop() pair, which ztest_bench_stop() then subtracts from
+ * each measurement.
+ *
+ * @param bench Benchmark to initialize
+ * @param name Name of the benchmark, spaces are reported as underscores
+ * @param warmup Number of measurements to discard first
+ * @param iterations Number of measurements to keep
+ * @param samples Buffer for @a iterations measurements, needed to report
+ *        percentiles, or NULL
+ */
+void ztest_bench_init(struct ztest_bench *bench, const char *name,
+		      uint32_t warmup, uint32_t iterations,
+		      uint32_t *samples);
+
+/**
+ * @brief Record a measurement
+ *
+ * For measurements taken by the benchmark itself, for instance from
+ * timestamps taken in an ISR. No overhead is subtracted.
+ *
+ * @param bench Benchmark
+ * @param cycles Measurement, in cycles
+ */
+void ztest_bench_record(struct ztest_bench *bench, uint32_t cycles);
+
+/**
+ * @brief Record operations timed together
+ *
+ * For operations too short to be timed one by one: @a n operations ran
+ * back to back in @a cycles, and each is recorded with the average. As
+ * with ztest_bench_record(), no overhead is subtracted.
+ *
+ * @param bench Benchmark
+ * @param cycles Total time of the operations, in cycles
+ * @param n Number of operations
+ */
+void ztest_bench_record_batch(struct ztest_bench *bench, uint32_t cycles,
+			      uint32_t n);
+
+/**
+ * @brief Start a measurement
+ *
+ * @param bench Benchmark
+ */
+static inline void ztest_bench_start(struct ztest_bench *bench)
+{
+	bench->start = ztest_bench_cycles();
+}
+
+/**
+ * @brief Stop and record the measurement started by ztest_bench_start()
+ *
+ * @param bench Benchmark
+ */
+static inline void ztest_bench_stop(struct ztest_bench *bench)
+{
+	uint32_t cycles = ztest_bench_cycles() - bench->start;
+
+	ztest_bench_record(bench, cycles > bench->overhead ?
+			   cycles - bench->overhead : 0U);
+}
+
+/**
+ * @brief Check if all the measurements were recorded
+ *
+ * A benchmark typically loops on its measurement until this returns
+ * true, warmup included.
+ *
+ * @param bench Benchmark
+ *
+ * @return true if @a iterations measurements were kept
+ */
+static inline bool ztest_bench_done(struct ztest_bench *bench)
+{
+	return bench->count >= bench->iterations;
+}
+
+/**
+ * @brief Report the results of a benchmark
+ *
+ * The samples, if any, are sorted in place and can be used for further
+ * reporting afterwards.
+ *
+ * @param bench Benchmark
+ */
+void ztest_bench_report(struct ztest_bench *bench);
+
+/**
+ * @brief Report a result measured with another time source
+ *
+ * For benchmarks that rely on timestamps taken by the kernel or the
+ * architecture, in units other than the benchmark cycles. The result is
+ * reported as a single iteration without percentiles.
+ *
+ * @param name Name of the benchmark, spaces are reported as underscores
+ * @param ns Result, in nanoseconds
+ */
+void ztest_bench_report_ns(const char *name, uint32_t ns);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ZTEST_BENCHMARK_H__ */
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest_benchmark.h>
+#include <sys/printk.h>
+#include <sys/util.h>
+
+/* Back to back timestamp pairs measured to calibrate the overhead, the
+ * smallest one is taken as the others include interrupts.
+ */
+#define OVERHEAD_RUNS 32
+
+/* Longest name reported, longer ones are truncated */
+#define NAME_MAX_LEN 64
+
+static uint32_t bench_overhead(void)
+{
+	uint32_t overhead = UINT32_MAX;
+	uint32_t start;
+	int i;
+
+	for (i = 0; i < OVERHEAD_RUNS; i++) {
+		start = ztest_bench_cycles();
+		overhead = MIN(overhead, ztest_bench_cycles() - start);
+	}
+
+	return overhead;
+}
+
+void ztest_bench_init(struct ztest_bench *bench, const char *name,
+		      uint32_t warmup, uint32_t iterations,
+		      uint32_t *samples)
+{
+	bench->name = name;
+	bench->samples = samples;
+	bench->warmup = warmup;
+	bench->iterations = iterations;
+	bench->count = 0U;
+	bench->min = UINT32_MAX;
+	bench->max = 0U;
+	bench->sum = 0U;
+	bench->overhead = bench_overhead();
+}
+
+void ztest_bench_record(struct ztest_bench *bench, uint32_t cycles)
+{
+	if (bench->warmup > 0U) {
+		bench->warmup--;
+		return;
+	}
+
+	if (bench->count >= bench->iterations) {
+		return;
+	}
+
+	if (bench->samples) {
+		bench->samples[bench->count] = cycles;
+	}
+
+	bench->min = MIN(bench->min, cycles);
+	bench->max = MAX(bench->max, cycles);
+	bench->sum += cycles;
+	bench->count++;
+}
+
+void ztest_bench_record_batch(struct ztest_bench *bench, uint32_t cycles,
+			      uint32_t n)
+{
+	uint32_t avg;
+
+	if (n == 0U) {
+		return;
+	}
+
+	avg = cycles / n;
+
+	while (n-- > 0U) {
+		ztest_bench_record(bench, avg);
+	}
+}
+
+static void bench_sort(uint32_t *a, uint32_t n)
+{
+	uint32_t gap, i, j;
+	uint32_t v;
+
+	for (gap = n / 2U; gap > 0U; gap /= 2U) {
+		for (i = gap; i < n; i++) {
+			v = a[i];
+
+			for (j = i; j >= gap && a[j - gap] > v; j -= gap) {
+				a[j] = a[j - gap];
+			}
+
+			a[j] = v;
+		}
+	}
+}
+
+static uint32_t cyc_to_ns(uint64_t cycles)
+{
+	return (uint32_t)k_cyc_to_ns_floor64(cycles);
+}
+
+/* Names are one word in the report */
+static const char *bench_name(const char *name, char *buf)
+{
+	int i;
+
+	for (i = 0; i < NAME_MAX_LEN && name[i] != '\0'; i++) {
+		buf[i] = (name[i] == ' ') ? '_' : name[i];
+	}
+	buf[i] = '\0';
+
+	return buf;
+}
+
+void ztest_bench_report(struct ztest_bench *bench)
+{
+	uint32_t count = bench->count;
+	char name[NAME_MAX_LEN + 1];
+
+	bench_name(bench->name, name);
+
+	if (count == 0U) {
+		printk("BENCH name=%s iterations=0\n", name);
+		return;
+	}
+
+	printk("BENCH name=%s iterations=%u min_ns=%u avg_ns=%u ",
+	       name, count, cyc_to_ns(bench->min),
+	       cyc_to_ns(bench->sum / count));
+
+	if (bench->samples) {
+		bench_sort(bench->samples, count);
+		printk("p50_ns=%u p99_ns=%u ",
+		       cyc_to_ns(bench->samples[count / 2U]),
+		       cyc_to_ns(bench->samples[(count * 99U) / 100U]));
+	} else {
+		printk("p50_ns=n/a p99_ns=n/a ");
+	}
+
+	printk("max_ns=%u overhead_ns=%u\n", cyc_to_ns(bench->max),
+	       cyc_to_ns(bench->overhead));
+}
+
+void ztest_bench_report_ns(const char *name, uint32_t ns)
+{
+	char buf[NAME_MAX_LEN + 1];
+
+	printk("BENCH name=%s iterations=1 min_ns=%u avg_ns=%u "
+	       "p50_ns=n/a p99_ns=n/a max_ns=%u overhead_ns=0\n",
+	       bench_name(name, buf), ns, ns, ns);
+}
@@ -8,6 +8,7 @@
 #include <kernel_structs.h>
 #include <kernel_internal.h>
 #include <ctf_top.h>
+#include <tracing_core.h>
 
 void sys_trace_thread_switched_out(void)
 {
@@ -141,3 +142,39 @@ void sys_trace_end_call(unsigned int id)
 {
 	ctf_top_end_call(id);
 }
+
+/* Precedes the events drained from the buffer of a CPU, so that the host
+ * knows which CPU they come from and how many were dropped.
+ */
+struct ctf_cpu_packet {
+#ifdef CONFIG_TRACING_CTF_TIMESTAMP
+	uint32_t tstamp;
+#endif
+	uint8_t id;
+	uint8_t cpu_id;
+	uint32_t dropped;
+	uint32_t length;
+} __packed;
+
+uint32_t tracing_drain_header_get(uint8_t *buf, uint32_t size,
+				  unsigned int cpu, uint32_t length,
+				  uint32_t dropped)
+{
+	struct ctf_cpu_packet packet = {
+#ifdef CONFIG_TRACING_CTF_TIMESTAMP
+		.tstamp = k_cycle_get_32(),
+#endif
+		.id = CTF_EVENT_CPU_PACKET,
+		.cpu_id = cpu,
+		.dropped = dropped,
+		.length = length,
+	};
+
+	if (size < sizeof(packet)) {
+		return 0;
+	}
+
+	memcpy(buf, &packet, sizeof(packet));
+
+	return sizeof(packet);
+}
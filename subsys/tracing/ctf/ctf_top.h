@@ -82,6 +82,7 @@ typedef enum {
 	CTF_EVENT_ISR_EXIT              =  0x21,
 	CTF_EVENT_ISR_EXIT_TO_SCHEDULER =  0x22,
 	CTF_EVENT_IDLE                  =  0x30,
+	CTF_EVENT_CPU_PACKET            =  0x38,
 	CTF_EVENT_ID_START_CALL         =  0x41,
 	CTF_EVENT_ID_END_CALL           =  0x42
 } ctf_event_t;
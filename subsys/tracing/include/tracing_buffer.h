@@ -14,6 +14,16 @@
 extern "C" {
 #endif
 
+/* Number of tracing buffers, one per CPU with CONFIG_TRACING_BUFFER_PER_CPU.
+ * Functions without a CPU argument use the buffer of the current CPU and
+ * must be called with interrupts locked.
+ */
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+#define TRACING_BUFFER_NUM CONFIG_MP_NUM_CPUS
+#else
+#define TRACING_BUFFER_NUM 1
+#endif
+
 /**
  * @brief Initialize tracing buffer.
  */
@@ -104,6 +114,49 @@ int tracing_buffer_get_finish(uint32_t size);
  */
 uint32_t tracing_buffer_get(uint8_t *data, uint32_t size);
 
+/**
+ * @brief Get address of the first valid data in the buffer of a CPU.
+ *
+ * @param cpu CPU index, smaller than TRACING_BUFFER_NUM.
+ * @param data Pointer to the address. It's set to a location pointing to
+ *             the first valid data within the tracing buffer.
+ * @param size Requested buffer size (in bytes).
+ *
+ * @return Size of valid buffer which can be smaller than requested
+ *         if there isn't enough valid data or buffer wraps.
+ */
+uint32_t tracing_buffer_cpu_get_claim(unsigned int cpu, uint8_t **data,
+				      uint32_t size);
+
+/**
+ * @brief Indicate number of bytes read from the buffer of a CPU.
+ *
+ * @param cpu CPU index, smaller than TRACING_BUFFER_NUM.
+ * @param size Number of bytes read from claimed buffer.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL Given @a size exceeds available data of tracing buffer.
+ */
+int tracing_buffer_cpu_get_finish(unsigned int cpu, uint32_t size);
+
+/**
+ * @brief Check if the buffer of a CPU is empty.
+ *
+ * @param cpu CPU index, smaller than TRACING_BUFFER_NUM.
+ *
+ * @return true if the buffer is empty, or false if not.
+ */
+bool tracing_buffer_cpu_is_empty(unsigned int cpu);
+
+/**
+ * @brief Get the amount of data in the buffer of a CPU.
+ *
+ * @param cpu CPU index, smaller than TRACING_BUFFER_NUM.
+ *
+ * @return Number of bytes available for reading.
+ */
+uint32_t tracing_buffer_cpu_size_get(unsigned int cpu);
+
 /**
  * @brief Get buffer from tracing command buffer.
  *
@@ -14,9 +14,18 @@
 extern "C" {
 #endif
 
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+/* Each CPU writes its own buffer, masking local interrupts is enough and
+ * avoids serializing CPUs on the global interrupt lock.
+ */
+#define TRACING_LOCK()		{ unsigned int key; key = arch_irq_lock()
+
+#define TRACING_UNLOCK()	{ arch_irq_unlock(key); } }
+#else
 #define TRACING_LOCK()		{ int key; key = irq_lock()
 
 #define TRACING_UNLOCK()	{ irq_unlock(key); } }
+#endif
 
 /**
  * @brief Check tracing enabled or not.
@@ -38,6 +47,35 @@ void tracing_buffer_handle(uint8_t *data, uint32_t length);
  */
 void tracing_packet_drop_handle(void);
 
+/**
+ * @brief Get and reset the number of dropped packets of a CPU.
+ *
+ * @param cpu CPU index, smaller than TRACING_BUFFER_NUM.
+ *
+ * @return Number of packets dropped since the last call.
+ */
+uint32_t tracing_packet_drop_get(unsigned int cpu);
+
+/**
+ * @brief Build the header sent before the data drained from a CPU buffer.
+ *
+ * Called by the tracing thread before passing data drained from the buffer
+ * of a CPU to the backend. The tracing format may override this weak
+ * function to identify the CPU the data comes from, and report dropped
+ * packets. The default implementation adds no header.
+ *
+ * @param buf Buffer for the header.
+ * @param size Size of @p buf (in bytes).
+ * @param cpu CPU index the data comes from.
+ * @param length Length of the data following the header (in bytes).
+ * @param dropped Number of packets dropped by that CPU since last header.
+ *
+ * @return Length of the header (in bytes).
+ */
+uint32_t tracing_drain_header_get(uint8_t *buf, uint32_t size,
+				  unsigned int cpu, uint32_t length,
+				  uint32_t dropped);
+
 /**
  * @brief Handle tracing command.
  *
@@ -4,12 +4,41 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <kernel.h>
+#include <string.h>
+#include <kernel_structs.h>
 #include <sys/ring_buffer.h>
+#include <tracing_buffer.h>
 
-static struct ring_buf tracing_ring_buf;
-static uint8_t tracing_buffer[CONFIG_TRACING_BUFFER_SIZE + 1];
+/* With per-CPU buffers each CPU only writes its own buffer, with local
+ * interrupts locked, and the tracing thread is its only reader. No lock is
+ * shared between CPUs.
+ */
+static struct ring_buf tracing_ring_buf[TRACING_BUFFER_NUM];
+static uint8_t tracing_buffer[TRACING_BUFFER_NUM]
+			     [CONFIG_TRACING_BUFFER_SIZE + 1];
 static uint8_t tracing_cmd_buffer[CONFIG_TRACING_CMD_BUFFER_SIZE];
 
+/* On SMP the tracing thread may read the buffer from another CPU, data
+ * must be visible before the buffer indexes are updated.
+ */
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+#define BUFFER_BARRIER_RELEASE() __atomic_thread_fence(__ATOMIC_RELEASE)
+#define BUFFER_BARRIER_ACQUIRE() __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#else
+#define BUFFER_BARRIER_RELEASE()
+#define BUFFER_BARRIER_ACQUIRE()
+#endif
+
+static inline struct ring_buf *curr_ring_buf(void)
+{
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+	return &tracing_ring_buf[_current_cpu->id];
+#else
+	return &tracing_ring_buf[0];
+#endif
+}
+
 uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
 {
 	*data = &tracing_cmd_buffer[0];
@@ -19,51 +48,97 @@ uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
 
 uint32_t tracing_buffer_put_claim(uint8_t **data, uint32_t size)
 {
-	return ring_buf_put_claim(&tracing_ring_buf, data, size);
+	return ring_buf_put_claim(curr_ring_buf(), data, size);
 }
 
 int tracing_buffer_put_finish(uint32_t size)
 {
-	return ring_buf_put_finish(&tracing_ring_buf, size);
+	BUFFER_BARRIER_RELEASE();
+
+	return ring_buf_put_finish(curr_ring_buf(), size);
 }
 
 uint32_t tracing_buffer_put(uint8_t *data, uint32_t size)
 {
-	return ring_buf_put(&tracing_ring_buf, data, size);
+	struct ring_buf *buf = curr_ring_buf();
+	uint32_t total = 0U;
+	uint32_t partial;
+	uint8_t *dst;
+
+	do {
+		partial = ring_buf_put_claim(buf, &dst, size - total);
+		memcpy(dst, data + total, partial);
+		total += partial;
+	} while ((total < size) && (partial != 0U));
+
+	BUFFER_BARRIER_RELEASE();
+	(void)ring_buf_put_finish(buf, total);
+
+	return total;
 }
 
 uint32_t tracing_buffer_get_claim(uint8_t **data, uint32_t size)
 {
-	return ring_buf_get_claim(&tracing_ring_buf, data, size);
+	return ring_buf_get_claim(curr_ring_buf(), data, size);
 }
 
 int tracing_buffer_get_finish(uint32_t size)
 {
-	return ring_buf_get_finish(&tracing_ring_buf, size);
+	return ring_buf_get_finish(curr_ring_buf(), size);
 }
 
 uint32_t tracing_buffer_get(uint8_t *data, uint32_t size)
 {
-	return ring_buf_get(&tracing_ring_buf, data, size);
+	return ring_buf_get(curr_ring_buf(), data, size);
+}
+
+uint32_t tracing_buffer_cpu_get_claim(unsigned int cpu, uint8_t **data,
+				      uint32_t size)
+{
+	uint32_t claimed = ring_buf_get_claim(&tracing_ring_buf[cpu], data,
+					      size);
+
+	BUFFER_BARRIER_ACQUIRE();
+
+	return claimed;
+}
+
+int tracing_buffer_cpu_get_finish(unsigned int cpu, uint32_t size)
+{
+	return ring_buf_get_finish(&tracing_ring_buf[cpu], size);
+}
+
+bool tracing_buffer_cpu_is_empty(unsigned int cpu)
+{
+	return ring_buf_is_empty(&tracing_ring_buf[cpu]);
+}
+
+uint32_t tracing_buffer_cpu_size_get(unsigned int cpu)
+{
+	struct ring_buf *buf = &tracing_ring_buf[cpu];
+
+	return ring_buf_capacity_get(buf) - ring_buf_space_get(buf);
 }
 
 void tracing_buffer_init(void)
 {
-	ring_buf_init(&tracing_ring_buf,
-		      sizeof(tracing_buffer), tracing_buffer);
+	for (int i = 0; i < TRACING_BUFFER_NUM; i++) {
+		ring_buf_init(&tracing_ring_buf[i],
+			      sizeof(tracing_buffer[i]), tracing_buffer[i]);
+	}
 }
 
 bool tracing_buffer_is_empty(void)
 {
-	return ring_buf_is_empty(&tracing_ring_buf);
+	return ring_buf_is_empty(curr_ring_buf());
 }
 
 uint32_t tracing_buffer_capacity_get(void)
 {
-	return ring_buf_capacity_get(&tracing_ring_buf);
+	return ring_buf_capacity_get(curr_ring_buf());
 }
 
 uint32_t tracing_buffer_space_get(void)
 {
-	return ring_buf_space_get(&tracing_ring_buf);
+	return ring_buf_space_get(curr_ring_buf());
 }
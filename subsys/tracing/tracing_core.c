@@ -7,6 +7,7 @@
 #include <init.h>
 #include <string.h>
 #include <kernel.h>
+#include <kernel_structs.h>
 #include <sys/util.h>
 #include <sys/atomic.h>
 #include <tracing_core.h>
@@ -32,7 +33,7 @@ enum tracing_state {
 };
 
 static atomic_t tracing_state;
-static atomic_t tracing_packet_drop_num;
+static atomic_t tracing_packet_drop_num[TRACING_BUFFER_NUM];
 static struct tracing_backend *working_backend;
 
 #ifdef CONFIG_TRACING_ASYNC
@@ -45,26 +46,55 @@ static K_SEM_DEFINE(tracing_thread_sem, 0, 1);
 static K_THREAD_STACK_DEFINE(tracing_thread_stack,
 			CONFIG_TRACING_THREAD_STACK_SIZE);
 
-static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
+/* Pass the data buffered by a CPU to the backend, in as few transfers as
+ * the buffer wrapping allows. Only the data present when starting is
+ * drained, so that the header announces its length.
+ */
+static bool tracing_cpu_drain(unsigned int cpu)
 {
+	uint8_t header[16];
 	uint8_t *transferring_buf;
-	uint32_t transferring_length, tracing_buffer_max_length;
+	uint32_t transferring_length, length, header_length;
 
-	tracing_thread_tid = k_current_get();
+	length = tracing_buffer_cpu_size_get(cpu);
+	if (length == 0U) {
+		return false;
+	}
 
-	tracing_buffer_max_length = tracing_buffer_capacity_get();
+	header_length = tracing_drain_header_get(header, sizeof(header), cpu,
+						 length,
+						 tracing_packet_drop_get(cpu));
+	if (header_length) {
+		tracing_buffer_handle(header, header_length);
+	}
+
+	while (length) {
+		transferring_length =
+			tracing_buffer_cpu_get_claim(cpu, &transferring_buf,
+						     length);
+		tracing_buffer_handle(transferring_buf, transferring_length);
+		tracing_buffer_cpu_get_finish(cpu, transferring_length);
+		length -= transferring_length;
+	}
+
+	return true;
+}
+
+static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
+{
+	bool drained;
+
+	tracing_thread_tid = k_current_get();
 
 	while (true) {
-		if (tracing_buffer_is_empty()) {
+		drained = false;
+
+		for (unsigned int cpu = 0; cpu < TRACING_BUFFER_NUM; cpu++) {
+			drained |= tracing_cpu_drain(cpu);
+		}
+
+		if (!drained) {
 			k_sem_take(&tracing_thread_sem, K_FOREVER);
-		} else {
-			transferring_length =
-				tracing_buffer_get_claim(
-						&transferring_buf,
-						tracing_buffer_max_length);
-			tracing_buffer_handle(transferring_buf,
-					      transferring_length);
-			tracing_buffer_get_finish(transferring_length);
 		}
 	}
 }
@@ -89,7 +119,9 @@ static int tracing_init(struct device *arg)
 	working_backend = tracing_backend_get(TRACING_BACKEND_NAME);
 	tracing_backend_init(working_backend);
 
-	atomic_set(&tracing_packet_drop_num, 0);
+	for (int i = 0; i < TRACING_BUFFER_NUM; i++) {
+		atomic_set(&tracing_packet_drop_num[i], 0);
+	}
 
 	if (IS_ENABLED(CONFIG_TRACING_HANDLE_HOST_CMD)) {
 		tracing_set_state(TRACING_DISABLE);
@@ -150,5 +182,30 @@ void tracing_buffer_handle(uint8_t *data, uint32_t length)
 
 void tracing_packet_drop_handle(void)
 {
-	atomic_inc(&tracing_packet_drop_num);
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+	unsigned int key = arch_irq_lock();
+
+	atomic_inc(&tracing_packet_drop_num[_current_cpu->id]);
+	arch_irq_unlock(key);
+#else
+	atomic_inc(&tracing_packet_drop_num[0]);
+#endif
+}
+
+uint32_t tracing_packet_drop_get(unsigned int cpu)
+{
+	return atomic_set(&tracing_packet_drop_num[cpu], 0);
+}
+
+__weak uint32_t tracing_drain_header_get(uint8_t *buf, uint32_t size,
+					 unsigned int cpu, uint32_t length,
+					 uint32_t dropped)
+{
+	ARG_UNUSED(buf);
+	ARG_UNUSED(size);
+	ARG_UNUSED(cpu);
+	ARG_UNUSED(length);
+	ARG_UNUSED(dropped);
+
+	return 0;
 }
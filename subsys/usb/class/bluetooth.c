@@ -37,6 +37,9 @@ static K_FIFO_DEFINE(tx_queue);
 					    USB_MAX_FS_BULK_MPS)
 #define BLUETOOTH_INT_EP_MPS            MIN(BT_BUF_RX_SIZE, USB_MAX_FS_INT_MPS)
 
+#define H4_CMD 0x01
+#define H4_ACL 0x02
+
 /* HCI RX/TX threads */
 static K_KERNEL_STACK_DEFINE(rx_thread_stack, CONFIG_BT_HCI_TX_STACK_SIZE);
 static struct k_thread rx_thread_data;
@@ -115,11 +118,125 @@ static struct usb_ep_cfg_data bluetooth_ep_data[] = {
 	},
 };
 
+/* Controller to host traffic: events and ACL data are sent on different
+ * endpoints, each with its own queue so that a long ACL transfer does not
+ * hold back events. Buffers are sent from and released in the transfer
+ * completion, without being copied. Fragmented buffers are sent one
+ * fragment per transfer.
+ */
+struct hci_in_ep {
+	uint8_t idx;
+	unsigned int flags;
+	struct k_fifo queue;
+	atomic_t busy;
+	struct net_buf *buf;
+	struct net_buf *frag;
+};
+
+static struct hci_in_ep hci_evt_ep = {
+	.idx = HCI_INT_EP_IDX,
+	.flags = USB_TRANS_WRITE | USB_TRANS_NO_ZLP,
+};
+
+static struct hci_in_ep hci_acl_ep = {
+	.idx = HCI_IN_EP_IDX,
+	.flags = USB_TRANS_WRITE,
+};
+
+static void hci_in_ep_sent(uint8_t ep, int size, void *priv);
+
+static int hci_in_ep_send(struct hci_in_ep *in_ep)
+{
+	struct net_buf *frag = in_ep->frag;
+	unsigned int flags = in_ep->flags;
+
+	/* Only the last fragment may end the packet */
+	if (frag->frags) {
+		flags |= USB_TRANS_NO_ZLP;
+	}
+
+	return usb_transfer(bluetooth_ep_data[in_ep->idx].ep_addr,
+			    frag->data, frag->len, flags,
+			    hci_in_ep_sent, in_ep);
+}
+
+static void hci_in_ep_kick(struct hci_in_ep *in_ep)
+{
+	while (!k_fifo_is_empty(&in_ep->queue) &&
+	       atomic_cas(&in_ep->busy, 0, 1)) {
+		struct net_buf *buf;
+		int err;
+
+		buf = net_buf_get(&in_ep->queue, K_NO_WAIT);
+		if (!buf) {
+			atomic_clear(&in_ep->busy);
+			continue;
+		}
+
+		in_ep->buf = buf;
+		in_ep->frag = buf;
+
+		err = hci_in_ep_send(in_ep);
+		if (err) {
+			LOG_ERR("Transfer failed (err %d)", err);
+			in_ep->buf = NULL;
+			net_buf_unref(buf);
+			atomic_clear(&in_ep->busy);
+		}
+
+		/* Otherwise the completion kicks the next transfer */
+		return;
+	}
+}
+
+static void hci_in_ep_sent(uint8_t ep, int size, void *priv)
+{
+	struct hci_in_ep *in_ep = priv;
+	struct net_buf *frag = in_ep->frag->frags;
+
+	while (frag && !frag->len) {
+		frag = frag->frags;
+	}
+
+	if (frag) {
+		int err;
+
+		in_ep->frag = frag;
+
+		err = hci_in_ep_send(in_ep);
+		if (!err) {
+			return;
+		}
+
+		LOG_ERR("Transfer failed (err %d)", err);
+	}
+
+	net_buf_unref(in_ep->buf);
+	in_ep->buf = NULL;
+	atomic_clear(&in_ep->busy);
+
+	hci_in_ep_kick(in_ep);
+}
+
+/* Cancelled transfers have no completion, release their buffers here */
+static void hci_in_ep_reset(struct hci_in_ep *in_ep)
+{
+	usb_cancel_transfer(bluetooth_ep_data[in_ep->idx].ep_addr);
+
+	if (in_ep->buf) {
+		net_buf_unref(in_ep->buf);
+		in_ep->buf = NULL;
+	}
+
+	atomic_clear(&in_ep->busy);
+}
+
 static void hci_tx_thread(void)
 {
 	LOG_DBG("Start USB Bluetooth thread");
 
 	while (true) {
+		struct hci_in_ep *in_ep;
 		struct net_buf *buf;
 
 		buf = net_buf_get(&tx_queue, K_FOREVER);
@@ -132,23 +249,19 @@ static void hci_tx_thread(void)
 
 		switch (bt_buf_get_type(buf)) {
 		case BT_BUF_EVT:
-			usb_transfer_sync(
-				bluetooth_ep_data[HCI_INT_EP_IDX].ep_addr,
-				buf->data, buf->len,
-				USB_TRANS_WRITE | USB_TRANS_NO_ZLP);
+			in_ep = &hci_evt_ep;
 			break;
 		case BT_BUF_ACL_IN:
-			usb_transfer_sync(
-				bluetooth_ep_data[HCI_IN_EP_IDX].ep_addr,
-				buf->data, buf->len,
-				USB_TRANS_WRITE);
+			in_ep = &hci_acl_ep;
 			break;
 		default:
 			LOG_ERR("Unknown type %u", bt_buf_get_type(buf));
-			break;
+			net_buf_unref(buf);
+			continue;
 		}
 
-		net_buf_unref(buf);
+		net_buf_put(&in_ep->queue, buf);
+		hci_in_ep_kick(in_ep);
 	}
 }
 
@@ -168,32 +281,63 @@ static void hci_rx_thread(void)
 	}
 }
 
-static void acl_read_cb(uint8_t ep, int size, void *priv)
+/* Host to controller ACL data is read straight into the buffer which is
+ * then passed to the controller.
+ */
+static struct net_buf *acl_out_buf;
+
+static struct net_buf *acl_out_h4(struct net_buf *buf)
 {
-	static uint8_t data[BLUETOOTH_BULK_EP_MPS];
+	struct net_buf *cmd;
+
+	switch (net_buf_pull_u8(buf)) {
+	case H4_ACL:
+		return buf;
+	case H4_CMD:
+		/* Commands have their own pool, they are short enough to be
+		 * copied.
+		 */
+		cmd = bt_buf_get_tx(BT_BUF_CMD, K_FOREVER, buf->data,
+				    buf->len);
+		net_buf_unref(buf);
+		return cmd;
+	default:
+		LOG_ERR("Unknown H4 type");
+		net_buf_unref(buf);
+		return NULL;
+	}
+}
 
+static void acl_read_cb(uint8_t ep, int size, void *priv)
+{
 	if (size > 0) {
-		struct net_buf *buf;
+		struct net_buf *buf = acl_out_buf;
+
+		acl_out_buf = NULL;
+		net_buf_add(buf, size);
 
 		if (IS_ENABLED(CONFIG_USB_DEVICE_BLUETOOTH_VS_H4) &&
 		    bt_hci_raw_get_mode() == BT_HCI_RAW_MODE_H4) {
-			buf = bt_buf_get_tx(BT_BUF_H4, K_FOREVER, data, size);
-		} else {
-			buf = bt_buf_get_tx(BT_BUF_ACL_OUT, K_FOREVER, data,
-					    size);
+			buf = acl_out_h4(buf);
 		}
 
-		if (!buf) {
+		if (buf) {
+			net_buf_put(&rx_queue, buf);
+		}
+	}
+
+	if (!acl_out_buf) {
+		acl_out_buf = bt_buf_get_tx(BT_BUF_ACL_OUT, K_FOREVER, NULL, 0);
+		if (!acl_out_buf) {
 			LOG_ERR("Cannot get free TX buffer\n");
 			return;
 		}
-
-		net_buf_put(&rx_queue, buf);
 	}
 
 	/* Start a new read transfer */
-	usb_transfer(bluetooth_ep_data[HCI_OUT_EP_IDX].ep_addr, data,
-		     BT_BUF_ACL_SIZE, USB_TRANS_READ, acl_read_cb, NULL);
+	usb_transfer(bluetooth_ep_data[HCI_OUT_EP_IDX].ep_addr,
+		     net_buf_tail(acl_out_buf), net_buf_tailroom(acl_out_buf),
+		     USB_TRANS_READ, acl_read_cb, NULL);
 }
 
 static void bluetooth_status_cb(struct usb_cfg_data *cfg,
@@ -220,9 +364,11 @@ static void bluetooth_status_cb(struct usb_cfg_data *cfg,
 		break;
 	case USB_DC_DISCONNECTED:
 		LOG_DBG("USB device disconnected");
-		/* Cancel any transfer */
-		usb_cancel_transfer(bluetooth_ep_data[HCI_INT_EP_IDX].ep_addr);
-		usb_cancel_transfer(bluetooth_ep_data[HCI_IN_EP_IDX].ep_addr);
+		/* Cancel any transfer, the read buffer is kept for the next
+		 * read.
+		 */
+		hci_in_ep_reset(&hci_evt_ep);
+		hci_in_ep_reset(&hci_acl_ep);
 		usb_cancel_transfer(bluetooth_ep_data[HCI_OUT_EP_IDX].ep_addr);
 		break;
 	case USB_DC_SUSPEND:
@@ -349,6 +495,9 @@ static int bluetooth_init(struct device *dev)
 		bt_hci_raw_cmd_ext_register(cmd_ext, ARRAY_SIZE(cmd_ext));
 	}
 
+	k_fifo_init(&hci_evt_ep.queue);
+	k_fifo_init(&hci_acl_ep.queue);
+
 	k_thread_create(&rx_thread_data, rx_thread_stack,
 			K_KERNEL_STACK_SIZEOF(rx_thread_stack),
 			(k_thread_entry_t)hci_rx_thread, NULL, NULL, NULL,
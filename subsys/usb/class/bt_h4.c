@@ -115,15 +115,24 @@ static void bt_h4_read(uint8_t ep, int size, void *priv)
 
 static void hci_tx_thread(void)
 {
+	uint8_t ep = bt_h4_ep_data[BT_H4_IN_EP_IDX].ep_addr;
+
 	LOG_DBG("Start USB Bluetooth thread");
 
 	while (true) {
 		struct net_buf *buf;
+		struct net_buf *frag;
 
 		buf = net_buf_get(&tx_queue, K_FOREVER);
 
-		usb_transfer_sync(bt_h4_ep_data[BT_H4_IN_EP_IDX].ep_addr,
-				  buf->data, buf->len, USB_TRANS_WRITE);
+		for (frag = buf; frag; frag = frag->frags) {
+			if (!frag->len) {
+				continue;
+			}
+
+			usb_transfer_sync(ep, frag->data, frag->len,
+					  USB_TRANS_WRITE);
+		}
 
 		net_buf_unref(buf);
 	}
@@ -186,6 +186,19 @@ struct cdc_acm_dev_data_t {
 	uint8_t rx_buf[CDC_ACM_BUFFER_SIZE];	/* Internal RX buffer */
 	struct ring_buf *rx_ringbuf;
 	struct ring_buf *tx_ringbuf;
+#ifdef CONFIG_UART_ASYNC_API
+	uart_callback_t async_cb;
+	void *async_cb_data;
+	/* Buffer of the uart_tx() in progress */
+	const uint8_t *async_tx_buf;
+	size_t async_tx_len;
+	/* Buffers of uart_rx_enable() and uart_rx_buf_rsp() */
+	uint8_t *async_rx_buf;
+	size_t async_rx_len;
+	size_t async_rx_offset;
+	uint8_t *async_rx_next;
+	size_t async_rx_next_len;
+#endif
 	/* Interface data buffer */
 	/* CDC ACM line coding properties. LE order */
 	struct cdc_acm_line_coding line_coding;
@@ -340,6 +353,129 @@ static void tx_work_handler(struct k_work *work)
 	ring_buf_get_finish(dev_data->tx_ringbuf, len);
 }
 
+static void cdc_acm_read_start(struct cdc_acm_dev_data_t *dev_data,
+			       uint8_t ep);
+
+#ifdef CONFIG_UART_ASYNC_API
+static void cdc_acm_async_evt(struct cdc_acm_dev_data_t *dev_data,
+			      struct uart_event *evt)
+{
+	if (dev_data->async_cb) {
+		dev_data->async_cb(dev_data->common.dev, evt,
+				   dev_data->async_cb_data);
+	}
+}
+
+static void cdc_acm_async_write_cb(uint8_t ep, int size, void *priv)
+{
+	struct cdc_acm_dev_data_t *dev_data = priv;
+	struct uart_event evt = {
+		.type = UART_TX_DONE,
+		.data.tx.buf = dev_data->async_tx_buf,
+		.data.tx.len = MAX(size, 0),
+	};
+
+	LOG_DBG("ep %x: written %d bytes dev_data %p", ep, size, dev_data);
+
+	if (evt.data.tx.len < dev_data->async_tx_len) {
+		evt.type = UART_TX_ABORTED;
+	}
+
+	dev_data->async_tx_buf = NULL;
+	cdc_acm_async_evt(dev_data, &evt);
+}
+
+/* Report the end of the buffers once the endpoint stopped using them. */
+static void cdc_acm_async_rx_release(struct cdc_acm_dev_data_t *dev_data)
+{
+	struct uart_event evt = {
+		.type = UART_RX_BUF_RELEASED,
+	};
+
+	if (dev_data->async_rx_next) {
+		evt.data.rx_buf.buf = dev_data->async_rx_next;
+		dev_data->async_rx_next = NULL;
+		cdc_acm_async_evt(dev_data, &evt);
+	}
+
+	evt.data.rx_buf.buf = dev_data->async_rx_buf;
+	dev_data->async_rx_buf = NULL;
+	cdc_acm_async_evt(dev_data, &evt);
+
+	evt.type = UART_RX_DISABLED;
+	cdc_acm_async_evt(dev_data, &evt);
+}
+
+static void cdc_acm_async_read_cb(uint8_t ep, int size, void *priv)
+{
+	struct cdc_acm_dev_data_t *dev_data = priv;
+	struct uart_event evt = {
+		.type = UART_RX_RDY,
+	};
+
+	LOG_DBG("ep %x size %d dev_data %p", ep, size, dev_data);
+
+	if (dev_data->async_rx_buf == NULL) {
+		/* Disabled meanwhile */
+		return;
+	}
+
+	if (size > 0) {
+		evt.data.rx.buf = dev_data->async_rx_buf;
+		evt.data.rx.offset = dev_data->async_rx_offset;
+		evt.data.rx.len = size;
+		dev_data->async_rx_offset += size;
+		cdc_acm_async_evt(dev_data, &evt);
+	}
+
+	cdc_acm_read_start(dev_data, ep);
+}
+
+/*
+ * Read into the free space of the current receive buffer, switching to the
+ * next buffer once less than a packet is left. Returns false if receiving
+ * in the user buffers is not enabled, or just ended.
+ */
+static bool cdc_acm_async_read(struct cdc_acm_dev_data_t *dev_data,
+			       uint8_t ep)
+{
+	struct uart_event evt;
+	size_t len;
+
+	while (dev_data->async_rx_buf != NULL) {
+		/* Whole packets only, nothing must be left in the endpoint */
+		len = ROUND_DOWN(dev_data->async_rx_len -
+				 dev_data->async_rx_offset,
+				 CDC_ACM_BUFFER_SIZE);
+		if (len) {
+			usb_transfer(ep, dev_data->async_rx_buf +
+				     dev_data->async_rx_offset, len,
+				     USB_TRANS_READ, cdc_acm_async_read_cb,
+				     dev_data);
+			return true;
+		}
+
+		if (dev_data->async_rx_next == NULL) {
+			cdc_acm_async_rx_release(dev_data);
+			break;
+		}
+
+		evt.type = UART_RX_BUF_RELEASED;
+		evt.data.rx_buf.buf = dev_data->async_rx_buf;
+		dev_data->async_rx_buf = dev_data->async_rx_next;
+		dev_data->async_rx_len = dev_data->async_rx_next_len;
+		dev_data->async_rx_offset = 0;
+		dev_data->async_rx_next = NULL;
+		cdc_acm_async_evt(dev_data, &evt);
+
+		evt.type = UART_RX_BUF_REQUEST;
+		cdc_acm_async_evt(dev_data, &evt);
+	}
+
+	return false;
+}
+#endif /* CONFIG_UART_ASYNC_API */
+
 static void cdc_acm_read_cb(uint8_t ep, int size, void *priv)
 {
 	struct cdc_acm_dev_data_t *dev_data = priv;
@@ -365,9 +501,20 @@ done:
 		k_work_submit(&dev_data->cb_work);
 	}
 
+	cdc_acm_read_start(dev_data, ep);
+}
+
+static void cdc_acm_read_start(struct cdc_acm_dev_data_t *dev_data,
+			       uint8_t ep)
+{
+#ifdef CONFIG_UART_ASYNC_API
+	if (cdc_acm_async_read(dev_data, ep)) {
+		return;
+	}
+#endif
+
 	usb_transfer(ep, dev_data->rx_buf, sizeof(dev_data->rx_buf),
 		     USB_TRANS_READ, cdc_acm_read_cb, dev_data);
-
 }
 
 /**
@@ -399,6 +546,12 @@ static void cdc_acm_int_in(uint8_t ep, enum usb_dc_ep_cb_status_code ep_status)
 
 static void cdc_acm_reset_port(struct cdc_acm_dev_data_t *dev_data)
 {
+#ifdef CONFIG_UART_ASYNC_API
+	/* The transfer got cancelled without completion callback */
+	if (dev_data->async_tx_buf) {
+		cdc_acm_async_write_cb(0, 0, dev_data);
+	}
+#endif
 	k_sem_give(&poll_wait_sem);
 	dev_data->configured = false;
 	dev_data->suspended = false;
@@ -993,6 +1146,163 @@ static void cdc_acm_poll_out(struct device *dev,
 	k_sem_take(&poll_wait_sem, K_MSEC(100));
 }
 
+#ifdef CONFIG_UART_ASYNC_API
+static int cdc_acm_callback_set(struct device *dev, uart_callback_t callback,
+				void *user_data)
+{
+	struct cdc_acm_dev_data_t * const dev_data = DEV_DATA(dev);
+
+	dev_data->async_cb = callback;
+	dev_data->async_cb_data = user_data;
+
+	return 0;
+}
+
+/*
+ * The buffer is handed to the bulk IN endpoint as is, the timeout is not
+ * used as the transfer ends when the host has read the whole buffer.
+ */
+static int cdc_acm_tx(struct device *dev, const uint8_t *buf, size_t len,
+		      int32_t timeout)
+{
+	struct cdc_acm_dev_data_t * const dev_data = DEV_DATA(dev);
+	struct usb_cfg_data *cfg = (void *)dev->config;
+	uint8_t ep = cfg->endpoint[ACM_IN_EP_IDX].ep_addr;
+	unsigned int key;
+	int ret;
+
+	ARG_UNUSED(timeout);
+
+	if (!dev_data->configured) {
+		return -EIO;
+	}
+
+	key = irq_lock();
+	if (dev_data->async_tx_buf) {
+		irq_unlock(key);
+		return -EBUSY;
+	}
+
+	dev_data->async_tx_buf = buf;
+	dev_data->async_tx_len = len;
+	irq_unlock(key);
+
+	ret = usb_transfer(ep, (uint8_t *)buf, len, USB_TRANS_WRITE,
+			   cdc_acm_async_write_cb, dev_data);
+	if (ret) {
+		dev_data->async_tx_buf = NULL;
+	}
+
+	return ret;
+}
+
+static int cdc_acm_tx_abort(struct device *dev)
+{
+	struct cdc_acm_dev_data_t * const dev_data = DEV_DATA(dev);
+	struct usb_cfg_data *cfg = (void *)dev->config;
+	struct uart_event evt = {
+		.type = UART_TX_ABORTED,
+	};
+
+	if (dev_data->async_tx_buf == NULL) {
+		return -EFAULT;
+	}
+
+	/* Cancelled transfers do not call their completion callback */
+	usb_cancel_transfer(cfg->endpoint[ACM_IN_EP_IDX].ep_addr);
+
+	evt.data.tx.buf = dev_data->async_tx_buf;
+	dev_data->async_tx_buf = NULL;
+	cdc_acm_async_evt(dev_data, &evt);
+
+	return 0;
+}
+
+/*
+ * Data is reported as each bulk OUT transfer ends, on a short packet or
+ * when the buffer is full, the timeout is not used. The buffers take
+ * whole packets only, a buffer is released once less than
+ * CONFIG_CDC_ACM_BULK_EP_MPS bytes are left in it.
+ */
+static int cdc_acm_rx_enable(struct device *dev, uint8_t *buf, size_t len,
+			     int32_t timeout)
+{
+	struct cdc_acm_dev_data_t * const dev_data = DEV_DATA(dev);
+	struct usb_cfg_data *cfg = (void *)dev->config;
+	uint8_t ep = cfg->endpoint[ACM_OUT_EP_IDX].ep_addr;
+	struct uart_event evt = {
+		.type = UART_RX_BUF_REQUEST,
+	};
+
+	ARG_UNUSED(timeout);
+
+	if (dev_data->async_rx_buf) {
+		return -EBUSY;
+	}
+
+	if (len < CDC_ACM_BUFFER_SIZE) {
+		return -EINVAL;
+	}
+
+	dev_data->async_rx_buf = buf;
+	dev_data->async_rx_len = len;
+	dev_data->async_rx_offset = 0;
+	dev_data->async_rx_next = NULL;
+	cdc_acm_async_evt(dev_data, &evt);
+
+	if (dev_data->configured) {
+		/* Move the pending read from the ring buffer path */
+		usb_cancel_transfer(ep);
+		cdc_acm_read_start(dev_data, ep);
+	}
+
+	return 0;
+}
+
+static int cdc_acm_rx_buf_rsp(struct device *dev, uint8_t *buf, size_t len)
+{
+	struct cdc_acm_dev_data_t * const dev_data = DEV_DATA(dev);
+
+	if (dev_data->async_rx_buf == NULL) {
+		return -EACCES;
+	}
+
+	if (dev_data->async_rx_next) {
+		return -EBUSY;
+	}
+
+	if (len < CDC_ACM_BUFFER_SIZE) {
+		return -EINVAL;
+	}
+
+	dev_data->async_rx_next_len = len;
+	dev_data->async_rx_next = buf;
+
+	return 0;
+}
+
+static int cdc_acm_rx_disable(struct device *dev)
+{
+	struct cdc_acm_dev_data_t * const dev_data = DEV_DATA(dev);
+	struct usb_cfg_data *cfg = (void *)dev->config;
+	uint8_t ep = cfg->endpoint[ACM_OUT_EP_IDX].ep_addr;
+
+	if (dev_data->async_rx_buf == NULL) {
+		return -EFAULT;
+	}
+
+	usb_cancel_transfer(ep);
+	cdc_acm_async_rx_release(dev_data);
+
+	if (dev_data->configured) {
+		/* Back to the ring buffer */
+		cdc_acm_read_start(dev_data, ep);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_UART_ASYNC_API */
+
 static const struct uart_driver_api cdc_acm_driver_api = {
 	.poll_in = cdc_acm_poll_in,
 	.poll_out = cdc_acm_poll_out,
@@ -1007,6 +1317,14 @@ static const struct uart_driver_api cdc_acm_driver_api = {
 	.irq_is_pending = cdc_acm_irq_is_pending,
 	.irq_update = cdc_acm_irq_update,
 	.irq_callback_set = cdc_acm_irq_callback_set,
+#ifdef CONFIG_UART_ASYNC_API
+	.callback_set = cdc_acm_callback_set,
+	.tx = cdc_acm_tx,
+	.tx_abort = cdc_acm_tx_abort,
+	.rx_enable = cdc_acm_rx_enable,
+	.rx_buf_rsp = cdc_acm_rx_buf_rsp,
+	.rx_disable = cdc_acm_rx_disable,
+#endif /* CONFIG_UART_ASYNC_API */
 #ifdef CONFIG_UART_LINE_CTRL
 	.line_ctrl_set = cdc_acm_line_ctrl_set,
 	.line_ctrl_get = cdc_acm_line_ctrl_get,
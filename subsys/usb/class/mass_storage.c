@@ -52,6 +52,7 @@ LOG_MODULE_REGISTER(usb_msc);
 #define MAX_PACKET	CONFIG_MASS_STORAGE_BULK_EP_MPS
 
 #define BLOCK_SIZE	512
+#define BUF_SIZE	(BLOCK_SIZE * CONFIG_MASS_STORAGE_BUF_BLOCKS)
 #define DISK_KERNEL_STACK_SZ	512
 #define DISK_THREAD_PRIO	-5
 
@@ -110,14 +111,33 @@ static struct k_sem disk_wait_sem;
 static volatile uint32_t defered_wr_sz;
 
 /*
- * Keep block buffer larger than BLOCK_SIZE for the case
+ * Keep block buffer larger than BUF_SIZE for the case
  * the dCBWDataTransferLength is multiple of the BLOCK_SIZE and
  * the length of the transferred data is not aligned to the BLOCK_SIZE.
  *
  * Align for cases where the underlying disk access requires word-aligned
  * addresses.
+ *
+ * Reads use both buffers in turn, one is sent while the other one is read
+ * from the disk. Writes and verifies use the first one.
  */
-static uint8_t __aligned(4) page[BLOCK_SIZE + CONFIG_MASS_STORAGE_BULK_EP_MPS];
+static uint8_t __aligned(4) page[2][BUF_SIZE + MAX_PACKET];
+
+/* Read pipeline: next block to read and number of blocks left to read */
+static uint32_t rd_lba;
+static uint32_t rd_left;
+/* Bytes loaded in each buffer, 0 while the buffer is free */
+static uint32_t rd_len[2];
+/* Buffer being sent and offset in it, buffer to load next */
+static uint8_t rd_cur;
+static uint32_t rd_pos;
+static uint8_t rd_fill;
+/* The IN endpoint waits for the current buffer to be loaded */
+static bool rd_wait;
+
+/* Write: block the buffer is written to and bytes received in it */
+static uint32_t wr_lba;
+static uint32_t wr_off;
 
 /* Initialized during mass_storage_init() */
 static uint32_t memory_size;
@@ -366,36 +386,53 @@ static bool readCapacity(void)
 	return write(capacity, sizeof(capacity));
 }
 
-static void thread_memory_read_done(void)
+static void memoryRead(void);
+
+/* Load the free buffers, the thread runs until both are loaded. */
+static void thread_memory_read(void)
 {
-	uint32_t n;
+	unsigned int key;
+	uint32_t blocks;
+	uint32_t lba;
+	uint8_t fill;
+	bool wait;
+
+	while (true) {
+		key = irq_lock();
+		fill = rd_fill;
+		if (!rd_left || rd_len[fill]) {
+			irq_unlock(key);
+			break;
+		}
 
-	n = (length > MAX_PACKET) ? MAX_PACKET : length;
-	if ((addr + n) > memory_size) {
-		n = memory_size - addr;
-		stage = MSC_ERROR;
-	}
+		blocks = MIN(rd_left, CONFIG_MASS_STORAGE_BUF_BLOCKS);
+		lba = rd_lba;
+		rd_lba += blocks;
+		rd_left -= blocks;
+		irq_unlock(key);
 
-	if (usb_write(mass_ep_data[MSD_IN_EP_IDX].ep_addr,
-		&page[addr % BLOCK_SIZE], n, NULL) != 0) {
-		LOG_ERR("Failed to write EP 0x%x",
-			mass_ep_data[MSD_IN_EP_IDX].ep_addr);
-	}
-	addr += n;
-	length -= n;
+		if (disk_access_read(disk_pdrv, page[fill], lba, blocks)) {
+			LOG_ERR("!! Disk Read Error %d !", lba);
+		}
 
-	csw.DataResidue -= n;
+		key = irq_lock();
+		rd_len[fill] = blocks * BLOCK_SIZE;
+		rd_fill ^= 1U;
+		wait = rd_wait;
+		rd_wait = false;
+		irq_unlock(key);
 
-	if (!length || (stage != MSC_PROCESS_CBW)) {
-		csw.Status = (stage == MSC_PROCESS_CBW) ?
-			CSW_PASSED : CSW_FAILED;
-		stage = (stage == MSC_PROCESS_CBW) ? MSC_SEND_CSW : stage;
+		if (wait) {
+			memoryRead();
+		}
 	}
 }
 
-
 static void memoryRead(void)
 {
+	unsigned int key;
+	bool refill = false;
+	bool wait = false;
 	uint32_t n;
 
 	n = (length > MAX_PACKET) ? MAX_PACKET : length;
@@ -404,15 +441,40 @@ static void memoryRead(void)
 		stage = MSC_ERROR;
 	}
 
-	/* we read an entire block */
-	if (!(addr % BLOCK_SIZE)) {
-		thread_op = THREAD_OP_READ_QUEUED;
-		LOG_DBG("Signal thread for %d", (addr/BLOCK_SIZE));
-		k_sem_give(&disk_wait_sem);
-		return;
+	if (n) {
+		key = irq_lock();
+		if (rd_pos && rd_pos == rd_len[rd_cur]) {
+			/* Buffer sent, load it again while the other is sent */
+			rd_len[rd_cur] = 0U;
+			rd_cur ^= 1U;
+			rd_pos = 0U;
+			refill = true;
+		}
+
+		if (!rd_len[rd_cur]) {
+			/* The thread sends once the buffer is loaded */
+			rd_wait = true;
+			wait = true;
+		}
+		irq_unlock(key);
+
+		if (refill || wait) {
+			thread_op = THREAD_OP_READ_QUEUED;
+			LOG_DBG("Signal thread for %d", rd_lba);
+			k_sem_give(&disk_wait_sem);
+		}
+
+		if (wait) {
+			return;
+		}
+	}
+
+	if (usb_write(mass_ep_data[MSD_IN_EP_IDX].ep_addr,
+		      &page[rd_cur][rd_pos], n, NULL) != 0) {
+		LOG_ERR("Failed to write EP 0x%x",
+			mass_ep_data[MSD_IN_EP_IDX].ep_addr);
 	}
-	usb_write(mass_ep_data[MSD_IN_EP_IDX].ep_addr,
-		  &page[addr % BLOCK_SIZE], n, NULL);
+	rd_pos += n;
 	addr += n;
 	length -= n;
 
@@ -457,6 +519,8 @@ static bool infoTransfer(void)
 	}
 
 	addr = n * BLOCK_SIZE;
+	wr_lba = n;
+	wr_off = 0U;
 
 	/* Number of Blocks to transfer */
 	switch (cbw.CB[0]) {
@@ -475,6 +539,16 @@ static bool infoTransfer(void)
 	LOG_DBG("Size (block) : 0x%x ", n);
 	length = n * BLOCK_SIZE;
 
+	/* Blocks past the end of the disk are not read */
+	rd_lba = wr_lba;
+	rd_left = MIN(n, block_count - rd_lba);
+	rd_len[0] = 0U;
+	rd_len[1] = 0U;
+	rd_cur = 0U;
+	rd_pos = 0U;
+	rd_fill = 0U;
+	rd_wait = false;
+
 	if (cbw.DataLength != length) {
 		if ((cbw.Flags & 0x80) != 0U) {
 			LOG_WRN("Stall IN endpoint");
@@ -637,14 +711,14 @@ static void memoryVerify(uint8_t *buf, uint16_t size)
 	/* beginning of a new block -> load a whole block in RAM */
 	if (!(addr % BLOCK_SIZE)) {
 		LOG_DBG("Disk READ sector %d", addr/BLOCK_SIZE);
-		if (disk_access_read(disk_pdrv, page, addr/BLOCK_SIZE, 1)) {
+		if (disk_access_read(disk_pdrv, page[0], addr/BLOCK_SIZE, 1)) {
 			LOG_ERR("---- Disk Read Error %d", addr/BLOCK_SIZE);
 		}
 	}
 
 	/* info are in RAM -> no need to re-read memory */
 	for (n = 0U; n < size; n++) {
-		if (page[addr%BLOCK_SIZE + n] != buf[n]) {
+		if (page[0][addr%BLOCK_SIZE + n] != buf[n]) {
 			LOG_DBG("Mismatch sector %d offset %d",
 				addr/BLOCK_SIZE, n);
 			memOK = false;
@@ -672,21 +746,22 @@ static void memoryWrite(uint8_t *buf, uint16_t size)
 		LOG_WRN("Stall OUT endpoint");
 	}
 
-	/* we fill an array in RAM of 1 block before writing it in memory */
-	for (int i = 0; i < size; i++) {
-		page[addr % BLOCK_SIZE + i] = buf[i];
-	}
+	if (!(disk_access_status(disk_pdrv) & DISK_STATUS_WR_PROTECT)) {
+		/* we fill an array in RAM of BUF_SIZE before writing it */
+		for (int i = 0; i < size; i++) {
+			page[0][wr_off + i] = buf[i];
+		}
 
-	/* if the array is filled, write it in memory */
-	if ((addr % BLOCK_SIZE) + size >= BLOCK_SIZE) {
-		if (!(disk_access_status(disk_pdrv) &
-					DISK_STATUS_WR_PROTECT)) {
-			LOG_DBG("Disk WRITE Qd %d", (addr/BLOCK_SIZE));
+		/* if the array is filled or the data ends, write it */
+		if ((wr_off + size >= BUF_SIZE) || (size >= length)) {
+			LOG_DBG("Disk WRITE Qd %d", wr_lba);
 			thread_op = THREAD_OP_WRITE_QUEUED;  /* write_queued */
 			defered_wr_sz = size;
 			k_sem_give(&disk_wait_sem);
 			return;
 		}
+
+		wr_off += size;
 	}
 
 	addr += size;
@@ -753,15 +828,19 @@ static void mass_storage_bulk_out(uint8_t ep,
 
 }
 
-static void thread_memory_write_done(void)
+static void thread_memory_write_done(uint32_t blocks)
 {
 	uint32_t size = defered_wr_sz;
-	size_t overflowed_len = (addr + size) % CONFIG_MASS_STORAGE_BULK_EP_MPS;
+	size_t overflowed_len = wr_off + size - blocks * BLOCK_SIZE;
 
 	if (overflowed_len) {
-		memmove(page, &page[BLOCK_SIZE], overflowed_len);
+		memmove(page[0], &page[0][blocks * BLOCK_SIZE],
+			overflowed_len);
 	}
 
+	wr_lba += blocks;
+	wr_off = overflowed_len;
+
 	addr += size;
 	length -= size;
 	csw.DataResidue -= size;
@@ -904,6 +983,8 @@ USBD_CFG_DATA_DEFINE(primary, msd) struct usb_cfg_data mass_storage_config = {
 
 static void mass_thread_main(int arg1, int unused)
 {
+	uint32_t blocks;
+
 	ARG_UNUSED(unused);
 	ARG_UNUSED(arg1);
 
@@ -913,21 +994,16 @@ static void mass_thread_main(int arg1, int unused)
 
 		switch (thread_op) {
 		case THREAD_OP_READ_QUEUED:
-			if (disk_access_read(disk_pdrv,
-						page, (addr/BLOCK_SIZE), 1)) {
-				LOG_ERR("!! Disk Read Error %d !",
-					addr/BLOCK_SIZE);
-			}
-
-			thread_memory_read_done();
+			thread_memory_read();
 			break;
 		case THREAD_OP_WRITE_QUEUED:
+			blocks = (wr_off + defered_wr_sz) / BLOCK_SIZE;
 			if (disk_access_write(disk_pdrv,
-						page, (addr/BLOCK_SIZE), 1)) {
+						page[0], wr_lba, blocks)) {
 				LOG_ERR("!!!!! Disk Write Error %d !!!!!",
-					addr/BLOCK_SIZE);
+					wr_lba);
 			}
-			thread_memory_write_done();
+			thread_memory_write_done(blocks);
 			break;
 		default:
 			LOG_ERR("XXXXXX thread_op  %d ! XXXXX", thread_op);
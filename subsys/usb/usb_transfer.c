@@ -13,7 +13,7 @@
 
 LOG_MODULE_REGISTER(usb_transfer, CONFIG_USB_DEVICE_LOG_LEVEL);
 
-#define MAX_NUM_TRANSFERS           4 /** Max number of parallel transfers */
+#define MAX_NUM_TRANSFERS CONFIG_USB_MAX_NUM_TRANSFERS
 
 struct usb_transfer_sync_priv {
 	int tsize;
@@ -41,13 +41,35 @@ struct usb_transfer_data {
 	struct k_work work;
 	/** Transfer flags */
 	unsigned int flags;
+	/** Waiting for the transfer ahead on the endpoint to complete */
+	bool queued;
+	/** Next transfer queued on the endpoint */
+	struct usb_transfer_data *next;
 };
 
 static struct usb_transfer_data ut_data[MAX_NUM_TRANSFERS];
 
 /* Transfer management */
+static struct usb_transfer_data *usb_ep_get_active_transfer(uint8_t ep)
+{
+	for (int i = 0; i < ARRAY_SIZE(ut_data); i++) {
+		if (ut_data[i].ep == ep && ut_data[i].status == -EBUSY &&
+		    !ut_data[i].queued) {
+			return &ut_data[i];
+		}
+	}
+
+	return NULL;
+}
+
 static struct usb_transfer_data *usb_ep_get_transfer(uint8_t ep)
 {
+	struct usb_transfer_data *trans = usb_ep_get_active_transfer(ep);
+
+	if (trans) {
+		return trans;
+	}
+
 	for (int i = 0; i < ARRAY_SIZE(ut_data); i++) {
 		if (ut_data[i].ep == ep) {
 			return &ut_data[i];
@@ -68,11 +90,59 @@ bool usb_transfer_is_busy(uint8_t ep)
 	return false;
 }
 
+static int usb_transfer_start(struct usb_transfer_data *trans)
+{
+	if (trans->flags & USB_TRANS_WRITE) {
+		/* start writing first chunk */
+		k_work_submit(&trans->work);
+		return 0;
+	}
+
+	/* ready to read, clear NAK */
+	return usb_dc_ep_read_continue(trans->ep);
+}
+
+/*
+ * Start the transfer queued after trans, once trans is over. A write
+ * following a ZLP is started by the endpoint callback of the ZLP instead.
+ */
+static void usb_transfer_next(struct usb_transfer_data *trans, bool start)
+{
+	struct usb_transfer_data *next;
+	unsigned int key;
+
+	key = irq_lock();
+	next = trans->next;
+	trans->next = NULL;
+	if (next) {
+		next->queued = false;
+	}
+	irq_unlock(key);
+
+	if (next && start) {
+		LOG_DBG("Start queued transfer, ep 0x%02x", next->ep);
+		usb_transfer_start(next);
+	}
+}
+
+static int usb_transfer_write(struct usb_transfer_data *trans,
+			      const uint8_t *data, uint32_t len,
+			      uint32_t *bytes)
+{
+	/* usb_write() yields on a busy endpoint, not an option in IRQ */
+	if (k_is_in_isr()) {
+		return usb_dc_ep_write(trans->ep, data, len, bytes);
+	}
+
+	return usb_write(trans->ep, data, len, bytes);
+}
+
 static void usb_transfer_work(struct k_work *item)
 {
 	struct usb_transfer_data *trans;
 	int ret = 0;
 	uint32_t bytes;
+	bool zlp = false;
 	uint8_t ep;
 
 	trans = CONTAINER_OF(item, struct usb_transfer_data, work);
@@ -88,13 +158,27 @@ static void usb_transfer_work(struct k_work *item)
 		if (!trans->bsize) {
 			if (!(trans->flags & USB_TRANS_NO_ZLP)) {
 				LOG_DBG("Transfer ZLP");
-				usb_write(ep, NULL, 0, NULL);
+				ret = usb_transfer_write(trans, NULL, 0, NULL);
+				if (ret == -EAGAIN && k_is_in_isr()) {
+					/* endpoint busy, retry in thread */
+					k_work_submit(&trans->work);
+					return;
+				}
+
+				zlp = (ret == 0);
 			}
 			trans->status = 0;
 			goto done;
 		}
 
-		ret = usb_write(ep, trans->buffer, trans->bsize, &bytes);
+		ret = usb_transfer_write(trans, trans->buffer, trans->bsize,
+					 &bytes);
+		if (ret == -EAGAIN && k_is_in_isr()) {
+			/* endpoint busy, retry in thread */
+			k_work_submit(&trans->work);
+			return;
+		}
+
 		if (ret) {
 			LOG_ERR("Transfer error %d, ep 0x%02x", ret, ep);
 			/* transfer error */
@@ -131,6 +215,11 @@ static void usb_transfer_work(struct k_work *item)
 	}
 
 done:
+	if (trans->status != -EBUSY) {
+		/* The next transfer does not wait for the completion */
+		usb_transfer_next(trans, !zlp);
+	}
+
 	if (trans->status != -EBUSY && trans->cb) { /* Transfer complete */
 		usb_transfer_callback cb = trans->cb;
 		int tsize = trans->tsize;
@@ -183,9 +272,11 @@ void usb_transfer_ep_callback(uint8_t ep, enum usb_dc_ep_cb_status_code status)
 		return;
 	}
 
-	if (!k_is_in_isr() || (status == USB_DC_EP_DATA_OUT)) {
+	if (!k_is_in_isr() || (status == USB_DC_EP_DATA_OUT) ||
+	    IS_ENABLED(CONFIG_USB_DEVICE_EP_WRITE_ISR_SAFE)) {
 		/* If we are not in IRQ context, no need to defer work */
 		/* Read (out) needs to be done from ep_callback */
+		/* Writes are done from IRQ if the controller allows it */
 		usb_transfer_work(&trans->work);
 	} else {
 		k_work_submit(&trans->work);
@@ -196,6 +287,7 @@ int usb_transfer(uint8_t ep, uint8_t *data, size_t dlen, unsigned int flags,
 		 usb_transfer_callback cb, void *cb_data)
 {
 	struct usb_transfer_data *trans = NULL;
+	struct usb_transfer_data *last;
 	int i, key, ret = 0;
 
 	LOG_DBG("Transfer start, ep 0x%02x, data %p, dlen %zd",
@@ -216,7 +308,8 @@ int usb_transfer(uint8_t ep, uint8_t *data, size_t dlen, unsigned int flags,
 		goto done;
 	}
 
-	if (trans->status == -EBUSY) {
+	last = usb_ep_get_active_transfer(ep);
+	if (last && !IS_ENABLED(CONFIG_USB_TRANSFER_QUEUE)) {
 		/* A transfer is already ongoing and not completed */
 		LOG_ERR("A transfer is already ongoing, ep 0x%02x", ep);
 		k_sem_give(&trans->sem);
@@ -233,20 +326,28 @@ int usb_transfer(uint8_t ep, uint8_t *data, size_t dlen, unsigned int flags,
 	trans->flags = flags;
 	trans->priv = cb_data;
 	trans->status = -EBUSY;
+	trans->queued = false;
+	trans->next = NULL;
 
 	if (usb_dc_ep_mps(ep) && (dlen % usb_dc_ep_mps(ep))) {
 		/* no need to send ZLP since last packet will be a short one */
 		trans->flags |= USB_TRANS_NO_ZLP;
 	}
 
-	if (flags & USB_TRANS_WRITE) {
-		/* start writing first chunk */
-		k_work_submit(&trans->work);
-	} else {
-		/* ready to read, clear NAK */
-		ret = usb_dc_ep_read_continue(ep);
+	if (last) {
+		/* Queue behind the transfers of the endpoint */
+		while (last->next) {
+			last = last->next;
+		}
+
+		LOG_DBG("Transfer queued, ep 0x%02x", ep);
+		trans->queued = true;
+		last->next = trans;
+		goto done;
 	}
 
+	ret = usb_transfer_start(trans);
+
 done:
 	irq_unlock(key);
 	return ret;
@@ -254,24 +355,24 @@ done:
 
 void usb_cancel_transfer(uint8_t ep)
 {
-	struct usb_transfer_data *trans;
 	unsigned int key;
 
 	key = irq_lock();
 
-	trans = usb_ep_get_transfer(ep);
-	if (!trans) {
-		goto done;
-	}
+	/* Cancel the queued transfers as well */
+	for (int i = 0; i < ARRAY_SIZE(ut_data); i++) {
+		struct usb_transfer_data *trans = &ut_data[i];
 
-	if (trans->status != -EBUSY) {
-		goto done;
-	}
+		if (trans->ep != ep || trans->status != -EBUSY) {
+			continue;
+		}
 
-	trans->status = -ECANCELED;
-	k_work_submit(&trans->work);
+		trans->status = -ECANCELED;
+		trans->queued = false;
+		trans->next = NULL;
+		k_work_submit(&trans->work);
+	}
 
-done:
 	irq_unlock(key);
 }
 
@@ -285,6 +386,8 @@ void usb_cancel_transfers(void)
 
 		if (trans->status == -EBUSY) {
 			trans->status = -ECANCELED;
+			trans->queued = false;
+			trans->next = NULL;
 			k_work_submit(&trans->work);
 			LOG_DBG("Cancel transfer for ep: 0x%02x", trans->ep);
 		}
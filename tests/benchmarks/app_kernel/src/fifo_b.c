@@ -28,8 +28,7 @@ void queue_test(void)
 	}
 	et = TIME_STAMP_DELTA_GET(et);
 
-	PRINT_F(output_file, FORMAT, "enqueue 1 byte msg in FIFO",
-			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+	PRINT_RESULT("enqueue 1 byte msg in FIFO", et, NR_OF_FIFO_RUNS);
 
 	et = BENCH_START();
 	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
@@ -38,8 +37,7 @@ void queue_test(void)
 	et = TIME_STAMP_DELTA_GET(et);
 	check_result();
 
-	PRINT_F(output_file, FORMAT, "dequeue 1 byte msg in FIFO",
-			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+	PRINT_RESULT("dequeue 1 byte msg in FIFO", et, NR_OF_FIFO_RUNS);
 
 	et = BENCH_START();
 	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
@@ -48,8 +46,7 @@ void queue_test(void)
 	et = TIME_STAMP_DELTA_GET(et);
 	check_result();
 
-	PRINT_F(output_file, FORMAT, "enqueue 4 bytes msg in FIFO",
-			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+	PRINT_RESULT("enqueue 4 bytes msg in FIFO", et, NR_OF_FIFO_RUNS);
 
 	et = BENCH_START();
 	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
@@ -58,8 +55,7 @@ void queue_test(void)
 	et = TIME_STAMP_DELTA_GET(et);
 	check_result();
 
-	PRINT_F(output_file, FORMAT, "dequeue 4 bytes msg in FIFO",
-			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+	PRINT_RESULT("dequeue 4 bytes msg in FIFO", et, NR_OF_FIFO_RUNS);
 
 	k_sem_give(&STARTRCV);
 
@@ -70,9 +66,9 @@ void queue_test(void)
 	et = TIME_STAMP_DELTA_GET(et);
 	check_result();
 
-	PRINT_F(output_file, FORMAT,
-			"enqueue 1 byte msg in FIFO to a waiting higher priority task",
-			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+	PRINT_RESULT(
+		"enqueue 1 byte msg in FIFO to a waiting higher priority task",
+		et, NR_OF_FIFO_RUNS);
 
 	et = BENCH_START();
 	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
@@ -81,9 +77,9 @@ void queue_test(void)
 	et = TIME_STAMP_DELTA_GET(et);
 	check_result();
 
-	PRINT_F(output_file, FORMAT,
-			"enqueue 4 bytes in FIFO to a waiting higher priority task",
-			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+	PRINT_RESULT(
+		"enqueue 4 bytes in FIFO to a waiting higher priority task",
+		et, NR_OF_FIFO_RUNS);
 }
 
 #endif /* FIFO_BENCH */
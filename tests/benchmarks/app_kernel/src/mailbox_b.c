@@ -104,12 +104,14 @@ void mailbox_test(void)
 	/* waiting for ack */
 	k_msgq_get(&MB_COMM, &getinfo, K_FOREVER);
 	PRINT_ONE_RESULT();
+	bench_report_ns(puttime, "mailbox put %u bytes", putsize);
 	empty_msg_put_time = puttime;
 	for (putsize = 8U; putsize <= MESSAGE_SIZE; putsize <<= 1) {
 		mailbox_put(putsize, putcount, &puttime);
 		/* waiting for ack */
 		k_msgq_get(&MB_COMM, &getinfo, K_FOREVER);
 		PRINT_ONE_RESULT();
+		bench_report_ns(puttime, "mailbox put %u bytes", putsize);
 	}
 	PRINT_STRING(dashline, output_file);
 	PRINT_OVERHEAD();
@@ -16,8 +16,10 @@
 #include "receiver.h"
 
 #include <timestamp.h>
+#include <ztest_benchmark.h>
 
 #include <string.h>
+#include <stdarg.h>
 
 #include <sys/util.h>
 
@@ -172,6 +174,42 @@ extern struct k_mem_pool DEMOPOOL;
 #define PRINT_OVERFLOW_ERROR()						\
 	PRINT_F(output_file, __FILE__":%d Error: tick occurred\n", __LINE__)
 
+/* The tables are for reading, each result is also reported on a line that
+ * sanitycheck can record, see ztest_benchmark.h.
+ */
+static inline void bench_report_batch(const char *name, uint32_t et,
+				      uint32_t runs)
+{
+	struct ztest_bench bench;
+
+	ztest_bench_init(&bench, name, 0, runs, NULL);
+	ztest_bench_record_batch(&bench, et, runs);
+	ztest_bench_report(&bench);
+}
+
+static inline void bench_report_ns(uint32_t ns, const char *fmt, ...)
+{
+	char name[SLINE_LEN];
+	va_list ap;
+
+	va_start(ap, fmt);
+	vsnprintf(name, sizeof(name), fmt, ap);
+	va_end(ap);
+
+	ztest_bench_report_ns(name, ns);
+}
+
+/* PRINT_RESULT
+ * Macro to print the average time of runs operations timed together as et
+ * cycles.
+ */
+#define PRINT_RESULT(name, et, runs)					\
+{									\
+	PRINT_F(output_file, FORMAT, name,				\
+		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, (runs)));		\
+	bench_report_batch(name, et, (runs));				\
+}
+
 static inline uint32_t BENCH_START(void)
 {
 	uint32_t et;
@@ -39,8 +39,8 @@ void memorymap_test(void)
 	et = TIME_STAMP_DELTA_GET(et);
 	check_result();
 
-	PRINT_F(output_file, FORMAT, "average alloc and dealloc memory page",
-		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, (2 * NR_OF_MAP_RUNS)));
+	PRINT_RESULT("average alloc and dealloc memory page",
+		     et, 2 * NR_OF_MAP_RUNS);
 }
 
 #endif /* MEMMAP_BENCH */
@@ -38,9 +38,8 @@ void mempool_test(void)
 	if (return_value != 0) {
 		k_panic();
 	}
-	PRINT_F(output_file, FORMAT,
-		"average alloc and dealloc memory pool block",
-		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, (2 * NR_OF_POOL_RUNS)));
+	PRINT_RESULT("average alloc and dealloc memory pool block",
+		     et, 2 * NR_OF_POOL_RUNS);
 }
 
 #endif /* MEMPOOL_BENCH */
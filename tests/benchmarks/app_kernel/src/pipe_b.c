@@ -77,6 +77,10 @@
 	     (uint32_t)(((uint64_t)putsize * 1000000U) / SAFE_DIVISOR(puttime[2])))
 #endif /* FLOAT */
 
+static const char *const pipe_names[] = {
+	"no buf", "small buf", "big buf"
+};
+
 /*
  * Function prototypes.
  */
@@ -137,6 +141,8 @@ void pipe_test(void)
 
 			/* waiting for ack */
 			k_msgq_get(&CH_COMM, &getinfo, K_FOREVER);
+			bench_report_ns(puttime[pipe], "pipe ALL_N %s %u bytes",
+					pipe_names[pipe], putsize);
 		}
 		PRINT_ALL_TO_N();
 	}
@@ -172,6 +178,10 @@ void pipe_test(void)
 			/* waiting for ack */
 			k_msgq_get(&CH_COMM, &getinfo, K_FOREVER);
 			getsize = getinfo.size;
+			bench_report_ns(puttime[pipe],
+					"pipe 1_TO_N %s priority %s %u bytes",
+					prio == 0 ? "higher" : "lower",
+					pipe_names[pipe], putsize);
 		}
 		PRINT_1_TO_N();
 	}
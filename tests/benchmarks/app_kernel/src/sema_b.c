@@ -30,8 +30,7 @@ void sema_test(void)
 	et = TIME_STAMP_DELTA_GET(et);
 	check_result();
 
-	PRINT_F(output_file, FORMAT, "signal semaphore",
-			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_SEMA_RUNS));
+	PRINT_RESULT("signal semaphore", et, NR_OF_SEMA_RUNS);
 
 	k_sem_reset(&SEM1);
 	k_sem_give(&STARTRCV);
@@ -43,8 +42,7 @@ void sema_test(void)
 	et = TIME_STAMP_DELTA_GET(et);
 	check_result();
 
-	PRINT_F(output_file, FORMAT, "signal to waiting high pri task",
-			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_SEMA_RUNS));
+	PRINT_RESULT("signal to waiting high pri task", et, NR_OF_SEMA_RUNS);
 
 	et = BENCH_START();
 	for (i = 0; i < NR_OF_SEMA_RUNS; i++) {
@@ -53,9 +51,8 @@ void sema_test(void)
 	et = TIME_STAMP_DELTA_GET(et);
 	check_result();
 
-	PRINT_F(output_file, FORMAT,
-			"signal to waiting high pri task, with timeout",
-			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_SEMA_RUNS));
+	PRINT_RESULT("signal to waiting high pri task, with timeout",
+		     et, NR_OF_SEMA_RUNS);
 
 }
 
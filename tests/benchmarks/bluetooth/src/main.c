@@ -0,0 +1,889 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Bluetooth host throughput and latency benchmark.
+ *
+ * The central measures the HCI command round trip time to its controller,
+ * then connects to CONFIG_BT_BENCHMARK_CONN_COUNT peripherals running the
+ * peripheral role of this benchmark and streams data to and from all of
+ * them at once: ATT Write Commands, ATT Notifications and L2CAP
+ * connection oriented channel SDUs. Payloads fill the negotiated ATT MTU
+ * and L2CAP MTU respectively.
+ *
+ * The peripheral counts every byte it receives and returns the counter
+ * when its characteristic is read. The central reads it at the end of a
+ * run, so throughput is measured up to the point where the peer has
+ * received all of the data rather than up to the point where the local
+ * host has queued it.
+ *
+ * Every result is printed as one line made of "BT_BENCH " followed by a
+ * JSON object so that it can be collected by scripts and compared across
+ * releases.
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <sys/byteorder.h>
+#include <net/buf.h>
+
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/hci.h>
+#include <bluetooth/conn.h>
+#include <bluetooth/uuid.h>
+#include <bluetooth/gatt.h>
+#include <bluetooth/l2cap.h>
+
+#if defined(CONFIG_BT_BENCHMARK_CONN_COUNT)
+#define CONN_COUNT CONFIG_BT_BENCHMARK_CONN_COUNT
+#else
+#define CONN_COUNT 1
+#endif
+
+#define ATT_PAYLOAD_MAX (CONFIG_BT_L2CAP_TX_MTU - 3)
+#define L2CAP_SDU_LEN (CONFIG_BT_L2CAP_TX_MTU - 2)
+#define L2CAP_TX_BUF_COUNT 4
+
+#define CONN_TIMEOUT K_SECONDS(30)
+#define DONE_TIMEOUT K_SECONDS(60)
+
+#define LOAD_SLICE_US 100
+#define LOAD_STACK_SIZE 512
+
+#define BENCH_SVC_UUID BT_UUID_128_ENCODE(0x2e2b8dc3, 0x06e0, 0x4f93, \
+					  0x9bb2, 0x734091c356f0)
+#define BENCH_CHRC_UUID BT_UUID_128_ENCODE(0x2e2b8dc3, 0x06e0, 0x4f93, \
+					   0x9bb2, 0x734091c356f1)
+
+static struct bt_uuid_128 bench_svc_uuid = BT_UUID_INIT_128(BENCH_SVC_UUID);
+static struct bt_uuid_128 bench_chrc_uuid = BT_UUID_INIT_128(BENCH_CHRC_UUID);
+
+static uint8_t payload[MAX(ATT_PAYLOAD_MAX, L2CAP_SDU_LEN)];
+
+/* Bytes received by the peripheral over any transport, returned when the
+ * benchmark characteristic is read.
+ */
+static atomic_t rx_bytes;
+
+static struct bt_l2cap_le_chan l2cap_chans[CONN_COUNT];
+
+NET_BUF_POOL_FIXED_DEFINE(l2cap_rx_pool, 1, CONFIG_BT_L2CAP_RX_MTU, NULL);
+
+#if defined(CONFIG_BT_BENCHMARK_CPU_LOAD)
+static K_THREAD_STACK_DEFINE(load_stack, LOAD_STACK_SIZE);
+static struct k_thread load_thread;
+static volatile uint32_t idle_slices;
+
+/* Runs whenever nothing else can: every slice it completes is time the
+ * benchmark left unused.
+ */
+static void load_fn(void *arg1, void *arg2, void *arg3)
+{
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (true) {
+		k_busy_wait(LOAD_SLICE_US);
+		idle_slices++;
+	}
+}
+
+static void load_init(void)
+{
+	k_thread_create(&load_thread, load_stack,
+			K_THREAD_STACK_SIZEOF(load_stack),
+			load_fn, NULL, NULL, NULL,
+			K_LOWEST_APPLICATION_THREAD_PRIO, 0, K_NO_WAIT);
+	k_thread_name_set(&load_thread, "bench_load");
+}
+#endif /* CONFIG_BT_BENCHMARK_CPU_LOAD */
+
+struct run_result {
+	uint32_t start;
+	uint32_t end;
+	uint32_t idle_start;
+	uint32_t bytes;
+	uint32_t packets;
+	uint32_t retries;
+	uint32_t buf_peak;
+};
+
+static void run_start(struct run_result *result)
+{
+	(void)memset(result, 0, sizeof(*result));
+
+#if defined(CONFIG_BT_BENCHMARK_CPU_LOAD)
+	result->idle_start = idle_slices;
+#endif
+	result->start = k_cycle_get_32();
+}
+
+static uint32_t elapsed_us(const struct run_result *result)
+{
+	return MAX(k_cyc_to_us_floor64(result->end - result->start), 1);
+}
+
+static uint32_t cpu_load(const struct run_result *result)
+{
+#if defined(CONFIG_BT_BENCHMARK_CPU_LOAD)
+	uint64_t idle_us;
+
+	idle_us = (uint64_t)(idle_slices - result->idle_start) * LOAD_SLICE_US;
+
+	return 100U - MIN(idle_us * 100U / elapsed_us(result), 100U);
+#else
+	return 0U;
+#endif
+}
+
+static void run_print(const char *test, const struct run_result *result,
+		      uint16_t size)
+{
+	uint32_t us = elapsed_us(result);
+
+	printk("BT_BENCH {\"test\":\"%s\",\"conns\":%u,\"size\":%u,"
+	       "\"packets\":%u,\"bytes\":%u,\"retries\":%u,\"usec\":%u,"
+	       "\"kbps\":%u,\"cpu_load\":%u,\"buf_peak\":%u}\n",
+	       test, CONN_COUNT, size, result->packets, result->bytes,
+	       result->retries, us,
+	       (uint32_t)((uint64_t)result->bytes * 8000U / us),
+	       cpu_load(result), result->buf_peak);
+}
+
+static struct net_buf *l2cap_alloc_buf(struct bt_l2cap_chan *chan)
+{
+	return net_buf_alloc(&l2cap_rx_pool, K_FOREVER);
+}
+
+static int l2cap_recv(struct bt_l2cap_chan *chan, struct net_buf *buf)
+{
+	atomic_add(&rx_bytes, buf->len);
+
+	return 0;
+}
+
+#if defined(CONFIG_BT_BENCHMARK_PERIPHERAL)
+static struct bt_conn *central_conn;
+static K_SEM_DEFINE(notify_start, 0, 1);
+
+static ssize_t bench_read(struct bt_conn *conn,
+			  const struct bt_gatt_attr *attr, void *buf,
+			  uint16_t len, uint16_t offset)
+{
+	uint8_t value[4];
+
+	sys_put_le32(atomic_get(&rx_bytes), value);
+
+	return bt_gatt_attr_read(conn, attr, buf, len, offset, value,
+				 sizeof(value));
+}
+
+static ssize_t bench_write(struct bt_conn *conn,
+			   const struct bt_gatt_attr *attr, const void *buf,
+			   uint16_t len, uint16_t offset, uint8_t flags)
+{
+	atomic_add(&rx_bytes, len);
+
+	return len;
+}
+
+static void bench_ccc_changed(const struct bt_gatt_attr *attr,
+			      uint16_t value)
+{
+	if (value == BT_GATT_CCC_NOTIFY) {
+		k_sem_give(&notify_start);
+	}
+}
+
+BT_GATT_SERVICE_DEFINE(bench_svc,
+	BT_GATT_PRIMARY_SERVICE(&bench_svc_uuid),
+	BT_GATT_CHARACTERISTIC(&bench_chrc_uuid.uuid,
+			       BT_GATT_CHRC_READ | BT_GATT_CHRC_WRITE_WITHOUT_RESP |
+			       BT_GATT_CHRC_NOTIFY,
+			       BT_GATT_PERM_READ | BT_GATT_PERM_WRITE,
+			       bench_read, bench_write, NULL),
+	BT_GATT_CCC(bench_ccc_changed,
+		    BT_GATT_PERM_READ | BT_GATT_PERM_WRITE),
+);
+
+static const struct bt_data ad[] = {
+	BT_DATA_BYTES(BT_DATA_FLAGS, (BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR)),
+	BT_DATA_BYTES(BT_DATA_UUID128_ALL, BENCH_SVC_UUID),
+};
+
+static const struct bt_l2cap_chan_ops l2cap_server_ops = {
+	.alloc_buf = l2cap_alloc_buf,
+	.recv = l2cap_recv,
+};
+
+static int l2cap_accept(struct bt_conn *conn, struct bt_l2cap_chan **chan)
+{
+	struct bt_l2cap_le_chan *le_chan = &l2cap_chans[0];
+
+	if (le_chan->chan.conn) {
+		return -ENOMEM;
+	}
+
+	le_chan->chan.ops = &l2cap_server_ops;
+	le_chan->rx.mtu = CONFIG_BT_L2CAP_RX_MTU;
+	*chan = &le_chan->chan;
+
+	return 0;
+}
+
+static struct bt_l2cap_server l2cap_server = {
+	.psm = CONFIG_BT_BENCHMARK_L2CAP_PSM,
+	.accept = l2cap_accept,
+};
+
+/* Send CONFIG_BT_BENCHMARK_ATT_BYTES of notifications to the central once
+ * it has subscribed.
+ */
+static void peripheral_notify(void)
+{
+	const struct bt_gatt_attr *attr = &bench_svc.attrs[1];
+	struct run_result result;
+	uint16_t size;
+	int err;
+
+	size = MIN(bt_gatt_get_mtu(central_conn) - 3, ATT_PAYLOAD_MAX);
+
+	run_start(&result);
+
+	while (result.bytes < CONFIG_BT_BENCHMARK_ATT_BYTES) {
+		err = bt_gatt_notify(central_conn, attr, payload, size);
+		if (err == -ENOMEM) {
+			result.retries++;
+			k_sleep(K_MSEC(1));
+			continue;
+		}
+
+		if (err) {
+			printk("Notification failed (err %d)\n", err);
+			break;
+		}
+
+		result.packets++;
+		result.bytes += size;
+	}
+
+	result.end = k_cycle_get_32();
+
+	run_print("att_notify_tx", &result, size);
+}
+
+static void peripheral_main(void)
+{
+	int err;
+
+	err = bt_l2cap_server_register(&l2cap_server);
+	if (err) {
+		printk("L2CAP server registration failed (err %d)\n", err);
+		return;
+	}
+
+	err = bt_le_adv_start(BT_LE_ADV_CONN, ad, ARRAY_SIZE(ad), NULL, 0);
+	if (err) {
+		printk("Advertising failed to start (err %d)\n", err);
+		return;
+	}
+
+	printk("BT_BENCH peripheral ready\n");
+
+	while (true) {
+		k_sem_take(&notify_start, K_FOREVER);
+
+		if (central_conn) {
+			peripheral_notify();
+		}
+	}
+}
+
+static void connected(struct bt_conn *conn, uint8_t err)
+{
+	if (err) {
+		printk("Connection failed (err 0x%02x)\n", err);
+		return;
+	}
+
+	central_conn = bt_conn_ref(conn);
+}
+
+static void disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	printk("Disconnected (reason 0x%02x)\n", reason);
+
+	if (conn == central_conn) {
+		bt_conn_unref(central_conn);
+		central_conn = NULL;
+	}
+}
+#endif /* CONFIG_BT_BENCHMARK_PERIPHERAL */
+
+#if defined(CONFIG_BT_BENCHMARK_CENTRAL)
+struct peer {
+	struct bt_conn *conn;
+	uint16_t value_handle;
+	uint16_t mtu;
+	uint32_t rx_base;
+	uint32_t notified;
+	struct bt_gatt_subscribe_params subscribe;
+};
+
+static struct peer peers[CONN_COUNT];
+static uint8_t peer_count;
+
+static K_SEM_DEFINE(conn_sem, 0, 1);
+static K_SEM_DEFINE(op_sem, 0, 1);
+static K_SEM_DEFINE(notify_done, 0, 1);
+static int op_err;
+static uint32_t peer_rx_bytes;
+static atomic_t notify_pending;
+
+static atomic_t l2cap_tx_in_use;
+static uint32_t l2cap_tx_peak;
+
+static void l2cap_tx_destroy(struct net_buf *buf)
+{
+	atomic_dec(&l2cap_tx_in_use);
+	net_buf_destroy(buf);
+}
+
+NET_BUF_POOL_FIXED_DEFINE(l2cap_tx_pool, L2CAP_TX_BUF_COUNT,
+			  BT_L2CAP_CHAN_SEND_RESERVE + L2CAP_SDU_LEN,
+			  l2cap_tx_destroy);
+
+static struct peer *peer_lookup(struct bt_conn *conn)
+{
+	int i;
+
+	for (i = 0; i < peer_count; i++) {
+		if (peers[i].conn == conn) {
+			return &peers[i];
+		}
+	}
+
+	return NULL;
+}
+
+static bool ad_has_bench_uuid(struct bt_data *data, void *user_data)
+{
+	bool *found = user_data;
+
+	if (data->type == BT_DATA_UUID128_ALL &&
+	    data->data_len == sizeof(bench_svc_uuid.val) &&
+	    !memcmp(data->data, bench_svc_uuid.val, data->data_len)) {
+		*found = true;
+		return false;
+	}
+
+	return true;
+}
+
+static void device_found(const bt_addr_le_t *addr, int8_t rssi, uint8_t type,
+			 struct net_buf_simple *buf)
+{
+	struct bt_conn *conn;
+	bool found = false;
+	int err;
+
+	if (type != BT_GAP_ADV_TYPE_ADV_IND) {
+		return;
+	}
+
+	bt_data_parse(buf, ad_has_bench_uuid, &found);
+	if (!found) {
+		return;
+	}
+
+	if (bt_le_scan_stop()) {
+		return;
+	}
+
+	err = bt_conn_le_create(addr, BT_CONN_LE_CREATE_CONN,
+				BT_LE_CONN_PARAM_DEFAULT, &conn);
+	if (err) {
+		printk("Create connection failed (err %d)\n", err);
+		k_sem_give(&conn_sem);
+		return;
+	}
+
+	/* The reference is kept in peers[] once connected */
+	bt_conn_unref(conn);
+}
+
+static void connected(struct bt_conn *conn, uint8_t err)
+{
+	if (err) {
+		printk("Connection failed (err 0x%02x)\n", err);
+	} else {
+		peers[peer_count++].conn = bt_conn_ref(conn);
+	}
+
+	k_sem_give(&conn_sem);
+}
+
+static void disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	printk("Disconnected (reason 0x%02x)\n", reason);
+}
+
+static void mtu_exchanged(struct bt_conn *conn, uint8_t err,
+			  struct bt_gatt_exchange_params *params)
+{
+	op_err = err;
+	k_sem_give(&op_sem);
+}
+
+static uint8_t chrc_discovered(struct bt_conn *conn,
+			       const struct bt_gatt_attr *attr,
+			       struct bt_gatt_discover_params *params)
+{
+	struct bt_gatt_chrc *chrc;
+
+	if (!attr) {
+		k_sem_give(&op_sem);
+		return BT_GATT_ITER_STOP;
+	}
+
+	chrc = attr->user_data;
+	peer_lookup(conn)->value_handle = chrc->value_handle;
+	op_err = 0;
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static uint8_t counter_read(struct bt_conn *conn, uint8_t err,
+			    struct bt_gatt_read_params *params,
+			    const void *data, uint16_t length)
+{
+	if (data) {
+		if (length == sizeof(uint32_t)) {
+			peer_rx_bytes = sys_get_le32(data);
+		}
+
+		return BT_GATT_ITER_CONTINUE;
+	}
+
+	op_err = err;
+	k_sem_give(&op_sem);
+
+	return BT_GATT_ITER_STOP;
+}
+
+/* Connect to all peers, then negotiate the ATT MTU and find the benchmark
+ * characteristic on each of them.
+ */
+static int central_connect(void)
+{
+	static struct bt_gatt_exchange_params exchange_params = {
+		.func = mtu_exchanged,
+	};
+	static struct bt_gatt_discover_params discover_params = {
+		.uuid = &bench_chrc_uuid.uuid,
+		.func = chrc_discovered,
+		.type = BT_GATT_DISCOVER_CHARACTERISTIC,
+		.start_handle = 0x0001,
+		.end_handle = 0xffff,
+	};
+	struct peer *peer;
+	int err;
+
+	while (peer_count < CONN_COUNT) {
+		err = bt_le_scan_start(BT_LE_SCAN_PASSIVE, device_found);
+		if (err) {
+			return err;
+		}
+
+		if (k_sem_take(&conn_sem, CONN_TIMEOUT)) {
+			return -ETIMEDOUT;
+		}
+	}
+
+	for (peer = peers; peer < &peers[peer_count]; peer++) {
+		err = bt_gatt_exchange_mtu(peer->conn, &exchange_params);
+		if (err || k_sem_take(&op_sem, CONN_TIMEOUT) || op_err) {
+			return -EIO;
+		}
+
+		peer->mtu = bt_gatt_get_mtu(peer->conn);
+
+		op_err = -ENOENT;
+		err = bt_gatt_discover(peer->conn, &discover_params);
+		if (err || k_sem_take(&op_sem, CONN_TIMEOUT) || op_err) {
+			return -ENOENT;
+		}
+	}
+
+	return 0;
+}
+
+static int peer_counter_read(struct peer *peer, uint32_t *bytes)
+{
+	struct bt_gatt_read_params params = {
+		.func = counter_read,
+		.handle_count = 1,
+		.single.handle = peer->value_handle,
+	};
+	int err;
+
+	err = bt_gatt_read(peer->conn, &params);
+	if (err) {
+		return err;
+	}
+
+	if (k_sem_take(&op_sem, DONE_TIMEOUT)) {
+		return -ETIMEDOUT;
+	}
+
+	*bytes = peer_rx_bytes;
+
+	return op_err;
+}
+
+static void peers_counter_base(void)
+{
+	int i;
+
+	for (i = 0; i < peer_count; i++) {
+		(void)peer_counter_read(&peers[i], &peers[i].rx_base);
+	}
+}
+
+/* Wait for every peer to report that it has received all bytes of the run
+ * and account them in the result.
+ */
+static void peers_wait_rx(struct run_result *result, uint32_t expected)
+{
+	uint32_t bytes;
+	int i;
+
+	for (i = 0; i < peer_count; i++) {
+		do {
+			if (peer_counter_read(&peers[i], &bytes)) {
+				bytes = peers[i].rx_base;
+				break;
+			}
+		} while (bytes - peers[i].rx_base < expected);
+
+		result->bytes += bytes - peers[i].rx_base;
+	}
+
+	result->end = k_cycle_get_32();
+}
+
+static void bench_hci_rtt(void)
+{
+	uint32_t min = UINT32_MAX, max = 0U;
+	uint32_t count = 0U;
+	uint64_t sum = 0U;
+	struct net_buf *rsp;
+	uint32_t t0, us;
+	int err;
+
+	while (count < CONFIG_BT_BENCHMARK_HCI_RTT_COUNT) {
+		t0 = k_cycle_get_32();
+
+		err = bt_hci_cmd_send_sync(BT_HCI_OP_READ_LOCAL_VERSION_INFO,
+					   NULL, &rsp);
+		if (err) {
+			printk("HCI command failed (err %d)\n", err);
+			break;
+		}
+
+		us = k_cyc_to_us_floor32(k_cycle_get_32() - t0);
+		net_buf_unref(rsp);
+
+		min = MIN(min, us);
+		max = MAX(max, us);
+		sum += us;
+		count++;
+	}
+
+	printk("BT_BENCH {\"test\":\"hci_rtt\",\"count\":%u,"
+	       "\"min_us\":%u,\"avg_us\":%u,\"max_us\":%u}\n",
+	       count, count ? min : 0U,
+	       count ? (uint32_t)(sum / count) : 0U, max);
+}
+
+static void bench_att_write(void)
+{
+	uint32_t sent[CONN_COUNT] = { 0 };
+	struct run_result result;
+	uint16_t size = ATT_PAYLOAD_MAX;
+	bool pending = true;
+	struct peer *peer;
+	uint16_t len;
+	int err;
+
+	for (peer = peers; peer < &peers[peer_count]; peer++) {
+		size = MIN(size, peer->mtu - 3);
+	}
+
+	peers_counter_base();
+	run_start(&result);
+
+	/* Round robin over the connections so that they all stay busy */
+	while (pending) {
+		pending = false;
+
+		for (peer = peers; peer < &peers[peer_count]; peer++) {
+			uint32_t *peer_sent = &sent[peer - peers];
+
+			if (*peer_sent >= CONFIG_BT_BENCHMARK_ATT_BYTES) {
+				continue;
+			}
+
+			pending = true;
+			len = MIN(size,
+				  CONFIG_BT_BENCHMARK_ATT_BYTES - *peer_sent);
+
+			err = bt_gatt_write_without_response(peer->conn,
+							     peer->value_handle,
+							     payload, len,
+							     false);
+			if (err == -ENOMEM) {
+				result.retries++;
+				k_sleep(K_MSEC(1));
+				continue;
+			}
+
+			if (err) {
+				printk("Write failed (err %d)\n", err);
+				*peer_sent = CONFIG_BT_BENCHMARK_ATT_BYTES;
+				continue;
+			}
+
+			*peer_sent += len;
+			result.packets++;
+		}
+	}
+
+	peers_wait_rx(&result, CONFIG_BT_BENCHMARK_ATT_BYTES);
+
+	run_print("att_write", &result, size);
+}
+
+static uint8_t notified(struct bt_conn *conn,
+			struct bt_gatt_subscribe_params *params,
+			const void *data, uint16_t length)
+{
+	struct peer *peer = CONTAINER_OF(params, struct peer, subscribe);
+
+	if (!data) {
+		return BT_GATT_ITER_STOP;
+	}
+
+	if (peer->notified < CONFIG_BT_BENCHMARK_ATT_BYTES) {
+		peer->notified += length;
+
+		if (peer->notified >= CONFIG_BT_BENCHMARK_ATT_BYTES &&
+		    atomic_dec(&notify_pending) == 1) {
+			k_sem_give(&notify_done);
+		}
+	}
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static void bench_att_notify(void)
+{
+	struct run_result result;
+	uint16_t size = ATT_PAYLOAD_MAX;
+	struct peer *peer;
+	int err;
+
+	atomic_set(&notify_pending, peer_count);
+	run_start(&result);
+
+	for (peer = peers; peer < &peers[peer_count]; peer++) {
+		size = MIN(size, peer->mtu - 3);
+
+		peer->notified = 0U;
+		peer->subscribe.notify = notified;
+		peer->subscribe.value_handle = peer->value_handle;
+		peer->subscribe.ccc_handle = peer->value_handle + 1;
+		peer->subscribe.value = BT_GATT_CCC_NOTIFY;
+
+		err = bt_gatt_subscribe(peer->conn, &peer->subscribe);
+		if (err) {
+			printk("Subscribe failed (err %d)\n", err);
+			atomic_dec(&notify_pending);
+		}
+	}
+
+	(void)k_sem_take(&notify_done, DONE_TIMEOUT);
+	result.end = k_cycle_get_32();
+
+	for (peer = peers; peer < &peers[peer_count]; peer++) {
+		result.bytes += peer->notified;
+		result.packets += DIV_ROUND_UP(peer->notified, size);
+	}
+
+	run_print("att_notify", &result, size);
+}
+
+static struct net_buf *l2cap_tx_alloc(struct run_result *result)
+{
+	struct net_buf *buf;
+	uint32_t in_use;
+
+	buf = net_buf_alloc(&l2cap_tx_pool, K_NO_WAIT);
+	if (!buf) {
+		result->retries++;
+		buf = net_buf_alloc(&l2cap_tx_pool, DONE_TIMEOUT);
+		if (!buf) {
+			return NULL;
+		}
+	}
+
+	in_use = atomic_inc(&l2cap_tx_in_use) + 1;
+	result->buf_peak = MAX(result->buf_peak, in_use);
+
+	net_buf_reserve(buf, BT_L2CAP_CHAN_SEND_RESERVE);
+
+	return buf;
+}
+
+static void l2cap_connected(struct bt_l2cap_chan *chan)
+{
+	k_sem_give(&op_sem);
+}
+
+static void l2cap_disconnected(struct bt_l2cap_chan *chan)
+{
+	k_sem_give(&op_sem);
+}
+
+static const struct bt_l2cap_chan_ops l2cap_client_ops = {
+	.alloc_buf = l2cap_alloc_buf,
+	.recv = l2cap_recv,
+	.connected = l2cap_connected,
+	.disconnected = l2cap_disconnected,
+};
+
+static void bench_l2cap(void)
+{
+	uint32_t sent[CONN_COUNT] = { 0 };
+	struct run_result result;
+	uint16_t size = L2CAP_SDU_LEN;
+	struct bt_l2cap_le_chan *le_chan;
+	struct net_buf *buf;
+	bool pending = true;
+	uint16_t len;
+	int err, i;
+
+	for (i = 0; i < peer_count; i++) {
+		le_chan = &l2cap_chans[i];
+		le_chan->chan.ops = &l2cap_client_ops;
+		le_chan->rx.mtu = CONFIG_BT_L2CAP_RX_MTU;
+
+		err = bt_l2cap_chan_connect(peers[i].conn, &le_chan->chan,
+					    CONFIG_BT_BENCHMARK_L2CAP_PSM);
+		if (err || k_sem_take(&op_sem, CONN_TIMEOUT) ||
+		    !le_chan->chan.conn) {
+			printk("L2CAP connect failed (err %d)\n", err);
+			return;
+		}
+
+		size = MIN(size, le_chan->tx.mtu);
+	}
+
+	peers_counter_base();
+	run_start(&result);
+
+	while (pending) {
+		pending = false;
+
+		for (i = 0; i < peer_count; i++) {
+			if (sent[i] >= CONFIG_BT_BENCHMARK_L2CAP_BYTES) {
+				continue;
+			}
+
+			pending = true;
+			len = MIN(size,
+				  CONFIG_BT_BENCHMARK_L2CAP_BYTES - sent[i]);
+
+			buf = l2cap_tx_alloc(&result);
+			if (!buf) {
+				printk("L2CAP buffers exhausted\n");
+				goto done;
+			}
+
+			net_buf_add_mem(buf, payload, len);
+
+			err = bt_l2cap_chan_send(&l2cap_chans[i].chan, buf);
+			if (err < 0) {
+				printk("L2CAP send failed (err %d)\n", err);
+				net_buf_unref(buf);
+				sent[i] = CONFIG_BT_BENCHMARK_L2CAP_BYTES;
+				continue;
+			}
+
+			sent[i] += len;
+			result.packets++;
+		}
+	}
+
+done:
+	peers_wait_rx(&result, CONFIG_BT_BENCHMARK_L2CAP_BYTES);
+
+	run_print("l2cap_coc", &result, size);
+}
+
+static void central_main(void)
+{
+	int err;
+
+	bench_hci_rtt();
+
+	err = central_connect();
+	if (err) {
+		printk("Connecting to peers failed (err %d)\n", err);
+		return;
+	}
+
+	bench_att_write();
+	bench_att_notify();
+	bench_l2cap();
+
+	printk("BT_BENCH done\n");
+}
+#endif /* CONFIG_BT_BENCHMARK_CENTRAL */
+
+static struct bt_conn_cb conn_callbacks = {
+	.connected = connected,
+	.disconnected = disconnected,
+};
+
+
+void main(void)
+{
+	int err;
+	int i;
+
+	for (i = 0; i < sizeof(payload); i++) {
+		payload[i] = i;
+	}
+
+	bt_conn_cb_register(&conn_callbacks);
+
+	err = bt_enable(NULL);
+	if (err) {
+		printk("Bluetooth init failed (err %d)\n", err);
+		return;
+	}
+
+#if defined(CONFIG_BT_BENCHMARK_CPU_LOAD)
+	load_init();
+#endif
+
+#if defined(CONFIG_BT_BENCHMARK_CENTRAL)
+	central_main();
+#else
+	peripheral_main();
+#endif
+}
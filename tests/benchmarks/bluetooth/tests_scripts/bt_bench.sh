@@ -0,0 +1,43 @@
+#!/usr/bin/env bash
+# Copyright (c) 2020 Intel Corporation
+# SPDX-License-Identifier: Apache-2.0
+
+# Bluetooth host benchmark: one central and BT_BENCH_PERIPHERALS
+# peripherals, which must match CONFIG_BT_BENCHMARK_CONN_COUNT of the
+# central image.
+simulation_id="bt_bench"
+verbosity_level=2
+process_ids=""; exit_code=0
+peripherals="${BT_BENCH_PERIPHERALS:-1}"
+
+function Execute(){
+  if [ ! -f $1 ]; then
+    echo -e "  \e[91m`pwd`/`basename $1` cannot be found (did you forget to\
+ compile it?)\e[39m"
+    exit 1
+  fi
+  timeout 300 $@ & process_ids="$process_ids $!"
+}
+
+: "${BSIM_OUT_PATH:?BSIM_OUT_PATH must be defined}"
+
+#Give a default value to BOARD if it does not have one yet:
+BOARD="${BOARD:-nrf52_bsim}"
+
+cd ${BSIM_OUT_PATH}/bin
+
+Execute ./bs_${BOARD}_tests_benchmarks_bluetooth_prj_conf \
+  -v=${verbosity_level} -s=${simulation_id} -d=0
+
+for i in $(seq 1 ${peripherals}); do
+  Execute ./bs_${BOARD}_tests_benchmarks_bluetooth_prj_peripheral_conf \
+    -v=${verbosity_level} -s=${simulation_id} -d=${i}
+done
+
+Execute ./bs_2G4_phy_v1 -v=${verbosity_level} -s=${simulation_id} \
+  -D=$((peripherals + 1)) -sim_length=120e6 $@
+
+for process_id in $process_ids; do
+  wait $process_id || let "exit_code=$?"
+done
+exit $exit_code #the last exit code != 0
@@ -13,11 +13,13 @@
  *  1. From __start to main()
  *  2. From __start to task
  *  3. From __start to idle
+ *  4. Duration of each init entry, if CONFIG_BOOT_TIME_INIT_ENTRIES is set
  */
 
 #include <zephyr.h>
 #include <tc_util.h>
 #include <kernel_internal.h>
+#include <device.h>
 
 void main(void)
 {
@@ -52,6 +54,26 @@ void main(void)
 						       task_us);
 	TC_PRINT("_start->idle  : %u cycles, %u us\n", z_timestamp_idle,
 						       idle_us);
+#if CONFIG_BOOT_TIME_INIT_ENTRIES > 0
+	uint32_t count = MIN(atomic_get(&z_init_timing_count),
+			     CONFIG_BOOT_TIME_INIT_ENTRIES);
+
+	TC_PRINT("Init entries (completion order):\n");
+	for (uint32_t i = 0; i < count; i++) {
+		const struct init_entry *entry = z_init_timings[i].entry;
+		uint32_t cycles = z_init_timings[i].cycles;
+
+		if (entry->dev != NULL) {
+			TC_PRINT("  %-24s: %u cycles, %u us\n",
+				 entry->dev->name, cycles,
+				 k_cyc_to_us_ceil32(cycles));
+		} else {
+			TC_PRINT("  init fn %-16p: %u cycles, %u us\n",
+				 entry->init, cycles,
+				 k_cyc_to_us_ceil32(cycles));
+		}
+	}
+#endif
 	TC_PRINT("Boot Time Measurement finished\n");
 
 	TC_END_RESULT(TC_PASS);
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <cmsis_os2.h>
+
+/*
+ * Compare the cost of the CMSIS-RTOS v2 wrappers with the native kernel
+ * calls they stand for. Each pair of calls never blocks, so this
+ * measures the overhead of the wrappers themselves, averaged in cycles.
+ */
+
+#define N_RUNS 1000
+
+#define MSG_COUNT 4
+
+/* Large enough for any of the control blocks of the wrappers */
+#define CB_WORDS 32
+
+/* Control blocks placed by the application, no slab allocation */
+static uint64_t evt_cb[CB_WORDS];
+static uint64_t sem_cb[CB_WORDS];
+static uint64_t msgq_cb[CB_WORDS];
+static uint32_t msgq_mem[MSG_COUNT];
+
+static struct k_poll_signal signal;
+static K_SEM_DEFINE(sem, 0, 1);
+K_MSGQ_DEFINE(msgq, sizeof(uint32_t), MSG_COUNT, 4);
+
+static uint32_t cycles_avg(uint32_t start)
+{
+	return (k_cycle_get_32() - start) / N_RUNS;
+}
+
+static void bench_event_flags(void)
+{
+	const osEventFlagsAttr_t attr = {
+		.cb_mem = evt_cb,
+		.cb_size = sizeof(evt_cb),
+	};
+	struct k_poll_event event;
+	osEventFlagsId_t id;
+	uint32_t cmsis, native;
+	uint32_t start;
+	int i;
+
+	id = osEventFlagsNew(&attr);
+	__ASSERT_NO_MSG(id != NULL);
+
+	start = k_cycle_get_32();
+	for (i = 0; i < N_RUNS; i++) {
+		osEventFlagsSet(id, 1U);
+		osEventFlagsWait(id, 1U, osFlagsWaitAny, 0U);
+	}
+	cmsis = cycles_avg(start);
+
+	k_poll_signal_init(&signal);
+	k_poll_event_init(&event, K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &signal);
+
+	start = k_cycle_get_32();
+	for (i = 0; i < N_RUNS; i++) {
+		k_poll_signal_raise(&signal, 1);
+		k_poll(&event, 1, K_NO_WAIT);
+		k_poll_signal_reset(&signal);
+		event.state = K_POLL_STATE_NOT_READY;
+	}
+	native = cycles_avg(start);
+
+	osEventFlagsDelete(id);
+
+	printk("event flags   cmsis %u native %u\n", cmsis, native);
+}
+
+static void bench_semaphore(void)
+{
+	const osSemaphoreAttr_t attr = {
+		.cb_mem = sem_cb,
+		.cb_size = sizeof(sem_cb),
+	};
+	osSemaphoreId_t id;
+	uint32_t cmsis, native;
+	uint32_t start;
+	int i;
+
+	id = osSemaphoreNew(1U, 0U, &attr);
+	__ASSERT_NO_MSG(id != NULL);
+
+	start = k_cycle_get_32();
+	for (i = 0; i < N_RUNS; i++) {
+		osSemaphoreRelease(id);
+		osSemaphoreAcquire(id, 0U);
+	}
+	cmsis = cycles_avg(start);
+
+	start = k_cycle_get_32();
+	for (i = 0; i < N_RUNS; i++) {
+		k_sem_give(&sem);
+		k_sem_take(&sem, K_NO_WAIT);
+	}
+	native = cycles_avg(start);
+
+	osSemaphoreDelete(id);
+
+	printk("semaphore     cmsis %u native %u\n", cmsis, native);
+}
+
+static void bench_message_queue(void)
+{
+	const osMessageQueueAttr_t attr = {
+		.cb_mem = msgq_cb,
+		.cb_size = sizeof(msgq_cb),
+		.mq_mem = msgq_mem,
+		.mq_size = sizeof(msgq_mem),
+	};
+	osMessageQueueId_t id;
+	uint32_t cmsis, native;
+	uint32_t start;
+	uint32_t msg = 0U;
+	int i;
+
+	id = osMessageQueueNew(MSG_COUNT, sizeof(uint32_t), &attr);
+	__ASSERT_NO_MSG(id != NULL);
+
+	start = k_cycle_get_32();
+	for (i = 0; i < N_RUNS; i++) {
+		osMessageQueuePut(id, &msg, 0U, 0U);
+		osMessageQueueGet(id, &msg, NULL, 0U);
+	}
+	cmsis = cycles_avg(start);
+
+	start = k_cycle_get_32();
+	for (i = 0; i < N_RUNS; i++) {
+		k_msgq_put(&msgq, &msg, K_NO_WAIT);
+		k_msgq_get(&msgq, &msg, K_NO_WAIT);
+	}
+	native = cycles_avg(start);
+
+	osMessageQueueDelete(id);
+
+	printk("message queue cmsis %u native %u\n", cmsis, native);
+}
+
+void main(void)
+{
+	bench_event_flags();
+	bench_semaphore();
+	bench_message_queue();
+
+	printk("fin\n");
+}
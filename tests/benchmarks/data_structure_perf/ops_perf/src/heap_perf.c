@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sys/sys_heap.h>
+#include "ops_perf.h"
+
+#define HEAP_SIZE	8192
+#define HEAP_SLOTS	32
+#define HEAP_ROUNDS	1024
+#define HEAP_MIN_BLOCK	8
+#define HEAP_MAX_BLOCK	256
+
+static char heap_mem[HEAP_SIZE] __aligned(8);
+static struct sys_heap heap;
+static void *slots[HEAP_SLOTS];
+
+static size_t random_size(void)
+{
+	return HEAP_MIN_BLOCK +
+	       ops_perf_rand() % (HEAP_MAX_BLOCK - HEAP_MIN_BLOCK + 1);
+}
+
+static void heap_free_all(void)
+{
+	for (int i = 0; i < HEAP_SLOTS; i++) {
+		sys_heap_free(&heap, slots[i]);
+		slots[i] = NULL;
+	}
+}
+
+/**
+ * @brief sys_heap allocation patterns
+ *
+ * @details Time allocation/free pairs of a fixed size on an empty heap,
+ * then random sizes, freeing and reallocating random slots so the heap
+ * reaches its fragmentation steady state. Failed allocations of the
+ * steady state are reported.
+ *
+ * @see sys_heap_alloc(), sys_heap_free()
+ */
+void test_heap_perf(void)
+{
+	uint32_t start, cycles;
+	uint32_t failed = 0U;
+	void *p;
+	int i;
+
+	sys_heap_init(&heap, heap_mem, sizeof(heap_mem));
+	ops_perf_srand(2U);
+
+	start = k_cycle_get_32();
+	for (i = 0; i < HEAP_ROUNDS; i++) {
+		p = sys_heap_alloc(&heap, 64);
+		sys_heap_free(&heap, p);
+	}
+	cycles = k_cycle_get_32() - start;
+	zassert_not_null(p, "fixed size allocation failed");
+	ops_perf_report("heap alloc+free 64 bytes", cycles, HEAP_ROUNDS);
+
+	start = k_cycle_get_32();
+	for (i = 0; i < HEAP_SLOTS; i++) {
+		slots[i] = sys_heap_alloc(&heap, random_size());
+	}
+	cycles = k_cycle_get_32() - start;
+	ops_perf_report("heap alloc random size, filling", cycles,
+			HEAP_SLOTS);
+
+	start = k_cycle_get_32();
+	for (i = 0; i < HEAP_ROUNDS; i++) {
+		int slot = ops_perf_rand() % HEAP_SLOTS;
+
+		sys_heap_free(&heap, slots[slot]);
+		slots[slot] = sys_heap_alloc(&heap, random_size());
+		if (slots[slot] == NULL) {
+			failed++;
+		}
+	}
+	cycles = k_cycle_get_32() - start;
+	ops_perf_report("heap free+alloc random, steady", cycles,
+			HEAP_ROUNDS);
+	TC_PRINT("%-32s %8u of %u\n", "heap steady state failures", failed,
+		 HEAP_ROUNDS);
+
+	start = k_cycle_get_32();
+	heap_free_all();
+	cycles = k_cycle_get_32() - start;
+	ops_perf_report("heap free, emptying", cycles, HEAP_SLOTS);
+
+	zassert_true(sys_heap_validate(&heap), "corrupted heap");
+}
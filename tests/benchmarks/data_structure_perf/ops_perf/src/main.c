@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * Cycles per operation of the data structures on the kernel hot paths:
+ * red-black tree, sys_heap, ring buffer and scheduler priority queues.
+ */
+
+#include "ops_perf.h"
+
+static uint32_t rand_state = 1U;
+
+uint32_t ops_perf_rand(void)
+{
+	/* Numerical Recipes LCG, the high bits are the random ones */
+	rand_state = rand_state * 1664525U + 1013904223U;
+
+	return rand_state >> 8;
+}
+
+void ops_perf_srand(uint32_t seed)
+{
+	rand_state = seed;
+}
+
+void ops_perf_report(const char *name, uint32_t cycles, uint32_t ops)
+{
+	TC_PRINT("%-32s %8u cycles/op (%u ops, %u ns/op)\n", name,
+		 cycles / ops, ops,
+		 (uint32_t)(k_cyc_to_ns_floor64(cycles) / ops));
+}
+
+extern void test_rbtree_perf(void);
+extern void test_heap_perf(void);
+extern void test_ring_buf_perf(void);
+extern void test_priq_perf(void);
+
+void test_main(void)
+{
+	ztest_test_suite(ops_perf,
+			 ztest_unit_test(test_rbtree_perf),
+			 ztest_unit_test(test_heap_perf),
+			 ztest_unit_test(test_ring_buf_perf),
+			 ztest_unit_test(test_priq_perf));
+	ztest_run_test_suite(ops_perf);
+}
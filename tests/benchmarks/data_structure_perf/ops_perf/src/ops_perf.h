@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef OPS_PERF_H_
+#define OPS_PERF_H_
+
+#include <ztest.h>
+
+/* Deterministic pseudo random numbers, same sequence on all boards */
+uint32_t ops_perf_rand(void);
+void ops_perf_srand(uint32_t seed);
+
+/* Print the average cost of an operation */
+void ops_perf_report(const char *name, uint32_t cycles, uint32_t ops);
+
+#endif /* OPS_PERF_H_ */
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <sched_priq.h>
+#include "ops_perf.h"
+
+#define PRIQ_THREADS	32
+
+/* The multi-queue handles at most 32 priorities */
+#define PRIQ_PRIOS	MIN(32, K_LOWEST_THREAD_PRIO - K_HIGHEST_THREAD_PRIO + 1)
+
+/* Only the scheduling fields are used, the threads never run */
+static struct k_thread threads[PRIQ_THREADS];
+
+static void threads_init(void)
+{
+	ops_perf_srand(3U);
+	for (int i = 0; i < PRIQ_THREADS; i++) {
+		threads[i].base.prio = K_HIGHEST_THREAD_PRIO +
+				       ops_perf_rand() % PRIQ_PRIOS;
+	}
+}
+
+static void priq_dumb_perf(void)
+{
+	sys_dlist_t pq;
+	struct k_thread *t;
+	uint32_t start, add, best = 0U, remove = 0U;
+	int n = 0;
+
+	sys_dlist_init(&pq);
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < PRIQ_THREADS; i++) {
+		z_priq_dumb_add(&pq, &threads[i]);
+	}
+	add = k_cycle_get_32() - start;
+
+	for (;;) {
+		start = k_cycle_get_32();
+		t = z_priq_dumb_best(&pq);
+		best += k_cycle_get_32() - start;
+		if (t == NULL) {
+			break;
+		}
+
+		start = k_cycle_get_32();
+		z_priq_dumb_remove(&pq, t);
+		remove += k_cycle_get_32() - start;
+		n++;
+	}
+
+	zassert_equal(n, PRIQ_THREADS, "lost threads");
+	ops_perf_report("priq dumb add", add, PRIQ_THREADS);
+	ops_perf_report("priq dumb best", best, PRIQ_THREADS + 1);
+	ops_perf_report("priq dumb remove", remove, PRIQ_THREADS);
+}
+
+static void priq_rb_perf(void)
+{
+	struct _priq_rb pq = {
+		.tree = { .lessthan_fn = z_priq_rb_lessthan },
+	};
+	struct k_thread *t;
+	uint32_t start, add, best = 0U, remove = 0U;
+	int n = 0;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < PRIQ_THREADS; i++) {
+		z_priq_rb_add(&pq, &threads[i]);
+	}
+	add = k_cycle_get_32() - start;
+
+	for (;;) {
+		start = k_cycle_get_32();
+		t = z_priq_rb_best(&pq);
+		best += k_cycle_get_32() - start;
+		if (t == NULL) {
+			break;
+		}
+
+		start = k_cycle_get_32();
+		z_priq_rb_remove(&pq, t);
+		remove += k_cycle_get_32() - start;
+		n++;
+	}
+
+	zassert_equal(n, PRIQ_THREADS, "lost threads");
+	ops_perf_report("priq rb add", add, PRIQ_THREADS);
+	ops_perf_report("priq rb best", best, PRIQ_THREADS + 1);
+	ops_perf_report("priq rb remove", remove, PRIQ_THREADS);
+}
+
+static void priq_mq_perf(void)
+{
+	struct _priq_mq pq;
+	struct k_thread *t;
+	uint32_t start, add, best = 0U, remove = 0U;
+	int n = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(pq.queues); i++) {
+		sys_dlist_init(&pq.queues[i]);
+	}
+	pq.bitmask = 0U;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < PRIQ_THREADS; i++) {
+		z_priq_mq_add(&pq, &threads[i]);
+	}
+	add = k_cycle_get_32() - start;
+
+	for (;;) {
+		start = k_cycle_get_32();
+		t = z_priq_mq_best(&pq);
+		best += k_cycle_get_32() - start;
+		if (t == NULL) {
+			break;
+		}
+
+		start = k_cycle_get_32();
+		z_priq_mq_remove(&pq, t);
+		remove += k_cycle_get_32() - start;
+		n++;
+	}
+
+	zassert_equal(n, PRIQ_THREADS, "lost threads");
+	ops_perf_report("priq mq add", add, PRIQ_THREADS);
+	ops_perf_report("priq mq best", best, PRIQ_THREADS + 1);
+	ops_perf_report("priq mq remove", remove, PRIQ_THREADS);
+}
+
+/**
+ * @brief Scheduler priority queue operations
+ *
+ * @details Add threads of random priorities to each priority queue
+ * implementation of the scheduler, then take the best thread and remove
+ * it until the queue is empty. Best and remove are timed one by one as
+ * they interleave, so they include the cost of reading the timer.
+ *
+ * @see z_priq_dumb_add(), z_priq_rb_add(), z_priq_mq_add()
+ */
+void test_priq_perf(void)
+{
+	threads_init();
+
+	priq_dumb_perf();
+	priq_rb_perf();
+	priq_mq_perf();
+}
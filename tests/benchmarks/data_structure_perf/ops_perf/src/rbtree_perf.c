@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sys/rb.h>
+#include "ops_perf.h"
+
+#define RB_NODES	256
+
+struct rb_item {
+	struct rbnode node;
+	uint32_t key;
+};
+
+static struct rb_item items[RB_NODES];
+static struct rb_item *order[RB_NODES];
+
+static bool item_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	struct rb_item *ia = CONTAINER_OF(a, struct rb_item, node);
+	struct rb_item *ib = CONTAINER_OF(b, struct rb_item, node);
+
+	if (ia->key != ib->key) {
+		return ia->key < ib->key;
+	}
+
+	return ia < ib;
+}
+
+static void shuffle(void)
+{
+	for (int i = RB_NODES - 1; i > 0; i--) {
+		int j = ops_perf_rand() % (i + 1);
+		struct rb_item *tmp = order[i];
+
+		order[i] = order[j];
+		order[j] = tmp;
+	}
+}
+
+/**
+ * @brief Red-black tree insert, lookup, minimum and remove
+ *
+ * @details Insert nodes with random keys, look each of them up, take
+ * the minimum and remove the nodes in another random order.
+ *
+ * @see rb_insert(), rb_contains(), rb_get_min(), rb_remove()
+ */
+void test_rbtree_perf(void)
+{
+	struct rbtree tree = { .lessthan_fn = item_lessthan };
+	struct rbnode *min = NULL;
+	uint32_t start, cycles;
+	int i;
+
+	ops_perf_srand(1U);
+	for (i = 0; i < RB_NODES; i++) {
+		items[i].key = ops_perf_rand();
+		order[i] = &items[i];
+	}
+
+	start = k_cycle_get_32();
+	for (i = 0; i < RB_NODES; i++) {
+		rb_insert(&tree, &items[i].node);
+	}
+	cycles = k_cycle_get_32() - start;
+	ops_perf_report("rbtree insert", cycles, RB_NODES);
+
+	shuffle();
+	start = k_cycle_get_32();
+	for (i = 0; i < RB_NODES; i++) {
+		if (!rb_contains(&tree, &order[i]->node)) {
+			break;
+		}
+	}
+	cycles = k_cycle_get_32() - start;
+	zassert_equal(i, RB_NODES, "node %d not found", i);
+	ops_perf_report("rbtree lookup", cycles, RB_NODES);
+
+	start = k_cycle_get_32();
+	for (i = 0; i < RB_NODES; i++) {
+		min = rb_get_min(&tree);
+	}
+	cycles = k_cycle_get_32() - start;
+	zassert_not_null(min, "empty tree");
+	ops_perf_report("rbtree get min", cycles, RB_NODES);
+
+	shuffle();
+	start = k_cycle_get_32();
+	for (i = 0; i < RB_NODES; i++) {
+		rb_remove(&tree, &order[i]->node);
+	}
+	cycles = k_cycle_get_32() - start;
+	zassert_is_null(tree.root, "tree not empty");
+	ops_perf_report("rbtree remove", cycles, RB_NODES);
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sys/ring_buffer.h>
+#include "ops_perf.h"
+
+#define RB_BUF_SIZE	256
+#define RB_CHUNK	16
+#define RB_ROUNDS	1024
+
+RING_BUF_DECLARE(ring, RB_BUF_SIZE);
+
+static uint8_t chunk[RB_CHUNK];
+
+/**
+ * @brief Ring buffer claim/finish and copy throughput
+ *
+ * @details Move chunks through the ring buffer, in place with the claim
+ * and finish calls, then copying with ring_buf_put() and ring_buf_get().
+ * Chunks wrap around the end of the buffer, a claim then returns the
+ * part up to the end.
+ *
+ * @see ring_buf_put_claim(), ring_buf_get_claim(), ring_buf_put()
+ */
+void test_ring_buf_perf(void)
+{
+	uint32_t start, cycles;
+	uint32_t moved = 0U;
+	uint8_t *data;
+	uint32_t len;
+	int i;
+
+	ring_buf_reset(&ring);
+
+	start = k_cycle_get_32();
+	for (i = 0; i < RB_ROUNDS; i++) {
+		len = ring_buf_put_claim(&ring, &data, RB_CHUNK);
+		data[0] = (uint8_t)i;
+		ring_buf_put_finish(&ring, len);
+
+		len = ring_buf_get_claim(&ring, &data, RB_CHUNK);
+		moved += len;
+		ring_buf_get_finish(&ring, len);
+	}
+	cycles = k_cycle_get_32() - start;
+	zassert_true(ring_buf_is_empty(&ring), "ring buffer not empty");
+	ops_perf_report("ring_buf claim+finish put+get", cycles, RB_ROUNDS);
+	ops_perf_report("ring_buf claim+finish per byte", cycles, moved);
+
+	moved = 0U;
+	start = k_cycle_get_32();
+	for (i = 0; i < RB_ROUNDS; i++) {
+		moved += ring_buf_put(&ring, chunk, sizeof(chunk));
+		(void)ring_buf_get(&ring, chunk, sizeof(chunk));
+	}
+	cycles = k_cycle_get_32() - start;
+	zassert_true(ring_buf_is_empty(&ring), "ring buffer not empty");
+	ops_perf_report("ring_buf put+get copy", cycles, RB_ROUNDS);
+	ops_perf_report("ring_buf put+get copy per byte", cycles, moved);
+}
@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Latency histogram benchmark. Each measurement collects APP_SAMPLES
+ * latencies in cycles, then reports their distribution: averages hide
+ * exactly the tail a real-time application has to bound.
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <irq_offload.h>
+#include <ztest_benchmark.h>
+
+#define SAMPLES CONFIG_APP_SAMPLES
+#define STACK_SIZE 1024
+
+/* Waiters run above the main thread so that a wakeup preempts it */
+#define WAITER_PRIO K_PRIO_COOP(0)
+#define LOAD_PRIO K_LOWEST_APPLICATION_THREAD_PRIO
+
+/* Cross-CPU wakeups need two CPUs and threads pinned to them */
+#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_CPU_MASK) && \
+	(CONFIG_MP_NUM_CPUS > 1)
+#define XCPU_TEST 1
+#else
+#define XCPU_TEST 0
+#endif
+
+static uint32_t samples[SAMPLES];
+static volatile int count;
+static volatile uint32_t stamp;
+
+static K_SEM_DEFINE(wake_sem, 0, 1);
+static K_SEM_DEFINE(done_sem, 0, 1);
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, 2, STACK_SIZE);
+static struct k_thread threads[2];
+
+static uint32_t cyc_to_ns(uint32_t cyc)
+{
+	return (uint32_t)k_cyc_to_ns_floor64(cyc);
+}
+
+static void report(const char *name)
+{
+	uint32_t buckets[33] = { 0 };
+	struct ztest_bench bench;
+	uint32_t ns;
+	int i;
+
+	/* Samples are taken in ISRs and threads, record them afterwards.
+	 * Each one is stored back in place, then sorted by the report.
+	 */
+	ztest_bench_init(&bench, name, 0U, SAMPLES, samples);
+	for (i = 0; i < SAMPLES; i++) {
+		ztest_bench_record(&bench, samples[i]);
+	}
+
+	ztest_bench_report(&bench);
+
+	/* Bucket i holds the latencies below 2^i ns */
+	for (i = 0; i < SAMPLES; i++) {
+		ns = cyc_to_ns(samples[i]);
+		buckets[ns == 0U ? 0 : 32 - __builtin_clz(ns)]++;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(buckets); i++) {
+		if (buckets[i] != 0U) {
+			printk("  < %llu ns: %u\n", BIT64(i), buckets[i]);
+		}
+	}
+}
+
+static void start_thread(int idx, k_thread_entry_t entry, int prio, int cpu)
+{
+	k_thread_create(&threads[idx], stacks[idx], STACK_SIZE, entry,
+			NULL, NULL, NULL, prio, 0, K_FOREVER);
+#ifdef CONFIG_SCHED_CPU_MASK
+	if (cpu >= 0) {
+		k_thread_cpu_mask_clear(&threads[idx]);
+		k_thread_cpu_mask_enable(&threads[idx], cpu);
+	}
+#else
+	ARG_UNUSED(cpu);
+#endif
+	k_thread_start(&threads[idx]);
+}
+
+/* Takes wake_sem, records the latency since stamp and gives done_sem */
+static void waiter(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < SAMPLES; i++) {
+		k_sem_take(&wake_sem, K_FOREVER);
+		samples[i] = k_cycle_get_32() - stamp;
+		k_sem_give(&done_sem);
+	}
+}
+
+static void entry_isr(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	stamp = k_cycle_get_32();
+}
+
+static void irq_to_isr(void)
+{
+	uint32_t start;
+
+	for (int i = 0; i < SAMPLES; i++) {
+		start = k_cycle_get_32();
+		irq_offload(entry_isr, NULL);
+		samples[i] = stamp - start;
+	}
+
+	report("irq_to_isr");
+}
+
+static void wake_isr(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	stamp = k_cycle_get_32();
+	k_sem_give(&wake_sem);
+}
+
+static void isr_to_thread(void)
+{
+	start_thread(0, waiter, WAITER_PRIO, -1);
+
+	for (int i = 0; i < SAMPLES; i++) {
+		irq_offload(wake_isr, NULL);
+		k_sem_take(&done_sem, K_FOREVER);
+	}
+
+	k_thread_join(&threads[0], K_FOREVER);
+	report("isr_to_thread");
+}
+
+#if XCPU_TEST
+static void giver(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < SAMPLES; i++) {
+		stamp = k_cycle_get_32();
+		k_sem_give(&wake_sem);
+		k_sem_take(&done_sem, K_FOREVER);
+	}
+}
+
+static void xcpu_sem(void)
+{
+	/* The main thread may run anywhere, pin both ends instead */
+	start_thread(0, waiter, WAITER_PRIO, 1);
+	start_thread(1, giver, WAITER_PRIO, 0);
+
+	k_thread_join(&threads[1], K_FOREVER);
+	k_thread_join(&threads[0], K_FOREVER);
+	report("xcpu_sem");
+}
+#endif
+
+static void timer_expiry(struct k_timer *timer)
+{
+	uint32_t period = k_ticks_to_cyc_floor32(CONFIG_APP_TIMER_PERIOD_TICKS);
+
+	/* Expiry time, less the periods elapsed since the first one */
+	samples[count] = k_cycle_get_32() - count * period;
+	if (++count == SAMPLES) {
+		k_timer_stop(timer);
+		k_sem_give(&done_sem);
+	}
+}
+
+static K_TIMER_DEFINE(timer, timer_expiry, NULL);
+
+static void timer_late(void)
+{
+	int32_t min = 0;
+	int i;
+
+	count = 0;
+	k_timer_start(&timer, K_TICKS(CONFIG_APP_TIMER_PERIOD_TICKS),
+		      K_TICKS(CONFIG_APP_TIMER_PERIOD_TICKS));
+	k_sem_take(&done_sem, K_FOREVER);
+
+	/* The expiry phase is unknown, take the earliest one as reference */
+	for (i = SAMPLES - 1; i >= 0; i--) {
+		samples[i] -= samples[0];
+		min = MIN(min, (int32_t)samples[i]);
+	}
+
+	for (i = 0; i < SAMPLES; i++) {
+		samples[i] -= min;
+	}
+
+	report("timer_late");
+}
+
+#if CONFIG_APP_LOAD_THREADS > 0
+static K_THREAD_STACK_ARRAY_DEFINE(load_stacks, CONFIG_APP_LOAD_THREADS,
+				   STACK_SIZE);
+static struct k_thread load_threads[CONFIG_APP_LOAD_THREADS];
+
+static void load(void *p1, void *p2, void *p3)
+{
+	unsigned int key;
+
+	for (;;) {
+		key = irq_lock();
+		k_busy_wait(CONFIG_APP_LOAD_IRQ_LOCK_US);
+		irq_unlock(key);
+		k_busy_wait(CONFIG_APP_LOAD_IRQ_LOCK_US);
+	}
+}
+
+static void load_start(void)
+{
+	for (int i = 0; i < CONFIG_APP_LOAD_THREADS; i++) {
+		k_thread_create(&load_threads[i], load_stacks[i], STACK_SIZE,
+				load, NULL, NULL, NULL, LOAD_PRIO, 0,
+				K_NO_WAIT);
+	}
+}
+#else
+static void load_start(void)
+{
+}
+#endif
+
+void main(void)
+{
+	printk("Latency histograms, %d samples, %d load threads locking "
+	       "interrupts for %d us\n", SAMPLES, CONFIG_APP_LOAD_THREADS,
+	       CONFIG_APP_LOAD_IRQ_LOCK_US);
+
+	load_start();
+
+	irq_to_isr();
+	isr_to_thread();
+#if XCPU_TEST
+	xcpu_sem();
+#endif
+	timer_late();
+
+	printk("PROJECT EXECUTION SUCCESSFUL\n");
+}
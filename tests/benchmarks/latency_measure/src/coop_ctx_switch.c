@@ -122,10 +122,11 @@ int coop_ctx_switch(void)
 
 		diff = TIMING_INFO_GET_DELTA(timestamp_start, timestamp_end);
 
-		PRINT_FORMAT(" Average context switch time is %u tcs = %u"
+		PRINT_RESULT("coop context switch",
+			     CYCLES_TO_NS_AVG(diff, ctx_switch_counter),
+			     " Average context switch time is %u tcs = %u"
 			     " nsec",
-			     diff / ctx_switch_counter,
-			     CYCLES_TO_NS_AVG(diff, ctx_switch_counter));
+			     diff / ctx_switch_counter);
 	}
 
 	benchmark_timer_stop();
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * This file contains the benchmark that measure the average time it takes to
+ * do context switches, using k_yield(), between a thread using the floating
+ * point registers and a thread not using them.
+ */
+
+#include <zephyr.h>
+#include <stdlib.h>
+#include "timestamp.h"
+#include "utils.h"      /* PRINT () and other macros */
+#include "timing_info.h"
+
+#ifdef CONFIG_FPU_SHARING
+
+/* context switch enough time so our measurement is precise */
+#define NB_OF_YIELD     1000
+
+static uint32_t fp_thread_iterations;
+static volatile float fp_value;
+
+#define FP_STACK_SIZE   (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define FP_PRIORITY     10
+
+K_THREAD_STACK_DEFINE(fp_stack_area, FP_STACK_SIZE);
+static struct k_thread fp_thread;
+
+/**
+ *
+ * @brief Helper thread using the FP registers between its yields
+ *
+ * @return N/A
+ */
+static void fp_yielding_thread(void *arg1, void *arg2, void *arg3)
+{
+	while (fp_thread_iterations < NB_OF_YIELD) {
+		fp_value = fp_value * 0.5f + 1.0f;
+		k_yield();
+		fp_thread_iterations++;
+	}
+}
+
+/**
+ *
+ * @brief Entry point for FP thread context switch using yield test
+ *
+ * @return N/A
+ */
+void fp_ctx_switch(void)
+{
+	uint32_t iterations = 0U;
+	int32_t delta;
+	uint32_t timestamp_start;
+	uint32_t timestamp_end;
+	uint32_t ts_diff;
+
+	PRINT_FORMAT(" 7 - Measure average context switch time between FP"
+		     " and non FP threads (k_yield)");
+
+	benchmark_timer_start();
+	bench_test_start();
+
+	/* launch helper thread of the same priority than this routine */
+	k_thread_create(&fp_thread, fp_stack_area, FP_STACK_SIZE,
+			fp_yielding_thread, NULL, NULL, NULL,
+			FP_PRIORITY, K_FP_REGS, K_NO_WAIT);
+
+	/* let the helper thread take the FP registers a first time */
+	k_yield();
+
+	TIMING_INFO_PRE_READ();
+	timestamp_start = TIMING_INFO_OS_GET_TIME();
+
+	while (iterations < NB_OF_YIELD &&
+	       fp_thread_iterations < NB_OF_YIELD) {
+		k_yield();
+		iterations++;
+	}
+
+	TIMING_INFO_PRE_READ();
+	timestamp_end = TIMING_INFO_OS_GET_TIME();
+
+	delta = iterations - fp_thread_iterations;
+	if (bench_test_end() < 0) {
+		error_count++;
+		PRINT_OVERFLOW_ERROR();
+	} else if (abs(delta) > 1) {
+		error_count++;
+		PRINT_FORMAT(" Error, iteration:%u, helper iteration:%u",
+			     iterations, fp_thread_iterations);
+	} else {
+		ts_diff = TIMING_INFO_GET_DELTA(timestamp_start, timestamp_end);
+		PRINT_RESULT("FP thread context switch yield",
+			     CYCLES_TO_NS_AVG(ts_diff,
+					      (iterations +
+					       fp_thread_iterations)),
+			     " Average FP thread context switch using "
+			     "yield %u tcs = %u nsec",
+			     ts_diff / (iterations + fp_thread_iterations));
+	}
+
+	k_thread_join(&fp_thread, K_FOREVER);
+
+	benchmark_timer_stop();
+}
+
+#endif /* CONFIG_FPU_SHARING */
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * This file contains the benchmark that measure the average time from an
+ * interrupt being pended to its handler running, for a regular ISR going
+ * through the software ISR table and for a direct ISR.
+ */
+
+#include <zephyr.h>
+#include <irq.h>
+#include "timestamp.h"
+#include "utils.h"      /* PRINT () and other macros */
+#include "timing_info.h"
+
+#ifdef CONFIG_CPU_CORTEX_M
+#include <arch/arm/aarch32/cortex_m/cmsis.h>
+
+/* interrupt enough time so our measurement is precise */
+#define NB_OF_INTS      1000
+
+/* Last lines of the NVIC, left unused by the test platforms */
+#define REGULAR_IRQ     (CONFIG_NUM_IRQS - 1)
+#define DIRECT_IRQ      (CONFIG_NUM_IRQS - 2)
+
+static volatile uint32_t timestamp_isr;
+static volatile uint32_t isr_count;
+
+static void regular_isr(void *unused)
+{
+	ARG_UNUSED(unused);
+
+	TIMING_INFO_PRE_READ();
+	timestamp_isr = TIMING_INFO_OS_GET_TIME();
+	isr_count++;
+}
+
+ISR_DIRECT_DECLARE(direct_isr)
+{
+	TIMING_INFO_PRE_READ();
+	timestamp_isr = TIMING_INFO_OS_GET_TIME();
+	isr_count++;
+
+	return 0;
+}
+
+/**
+ *
+ * @brief Pend an interrupt line repeatedly, sum the entry latencies
+ *
+ * @return sum of the latencies, 0 if an interrupt was lost
+ */
+static uint32_t int_entry_measure(unsigned int irq)
+{
+	uint32_t timestamp_start;
+	uint32_t sum = 0U;
+	uint32_t i;
+
+	isr_count = 0U;
+	irq_enable(irq);
+
+	for (i = 0U; i < NB_OF_INTS; i++) {
+		TIMING_INFO_PRE_READ();
+		timestamp_start = TIMING_INFO_OS_GET_TIME();
+		NVIC_SetPendingIRQ(irq);
+		__DSB();
+		__ISB();
+		sum += TIMING_INFO_GET_DELTA(timestamp_start, timestamp_isr);
+	}
+
+	irq_disable(irq);
+
+	return (isr_count == NB_OF_INTS) ? sum : 0U;
+}
+
+static void int_entry_print(const char *kind, const char *name,
+			    uint32_t sum)
+{
+	if (sum == 0U) {
+		error_count++;
+		PRINT_FORMAT(" Error, %s ISR not called on each interrupt",
+			     kind);
+	} else {
+		PRINT_RESULT(name, CYCLES_TO_NS_AVG(sum, NB_OF_INTS),
+			     " Average %s ISR entry latency %u tcs = %u nsec",
+			     kind, sum / NB_OF_INTS);
+	}
+}
+
+/**
+ *
+ * @brief Entry point for the interrupt entry latency test
+ *
+ * @return N/A
+ */
+void int_entry(void)
+{
+	uint32_t regular;
+	uint32_t direct;
+
+	IRQ_CONNECT(REGULAR_IRQ, IRQ_PRIORITY, regular_isr, NULL, 0);
+	IRQ_DIRECT_CONNECT(DIRECT_IRQ, IRQ_PRIORITY, direct_isr, 0);
+
+	PRINT_FORMAT(" 8 - Measure average interrupt entry latency, regular"
+		     " and direct ISR");
+
+	benchmark_timer_start();
+	bench_test_start();
+
+	regular = int_entry_measure(REGULAR_IRQ);
+	direct = int_entry_measure(DIRECT_IRQ);
+
+	if (bench_test_end() < 0) {
+		error_count++;
+		PRINT_OVERFLOW_ERROR();
+	} else {
+		int_entry_print("regular", "regular ISR entry", regular);
+		int_entry_print("direct", "direct ISR entry", direct);
+	}
+
+	benchmark_timer_stop();
+}
+
+#endif /* CONFIG_CPU_CORTEX_M */
@@ -81,8 +81,8 @@ int int_to_thread(void)
 	make_int();
 	if (flag_var == 1) {
 		diff = TIMING_INFO_GET_DELTA(timestamp_start, timestamp_end);
-		PRINT_FORMAT(" switching time is %u tcs = %u nsec",
-			     diff, CYCLES_TO_NS(diff));
+		PRINT_RESULT("interrupt to thread switch", CYCLES_TO_NS(diff),
+			     " switching time is %u tcs = %u nsec", diff);
 	}
 	benchmark_timer_stop();
 	return 0;
@@ -103,7 +103,7 @@ int int_to_thread_evt(void)
 
 	diff = TIMING_INFO_GET_DELTA(timestamp_start, timestamp_end);
 
-	PRINT_FORMAT(" switch time is %u tcs = %u nsec",
-		     diff, CYCLES_TO_NS(diff));
+	PRINT_RESULT("interrupt to thread event switch", CYCLES_TO_NS(diff),
+		     " switch time is %u tcs = %u nsec", diff);
 	return 0;
 }
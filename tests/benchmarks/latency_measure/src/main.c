@@ -26,6 +26,8 @@ extern void int_to_thread_evt(void);
 extern void sema_lock_unlock(void);
 extern void mutex_lock_unlock(void);
 extern int coop_ctx_switch(void);
+extern void fp_ctx_switch(void);
+extern void int_entry(void);
 void test_thread(void *arg1, void *arg2, void *arg3)
 {
 	PRINT_BANNER();
@@ -52,6 +54,16 @@ void test_thread(void *arg1, void *arg2, void *arg3)
 	coop_ctx_switch();
 	print_dash_line();
 
+#ifdef CONFIG_FPU_SHARING
+	fp_ctx_switch();
+	print_dash_line();
+#endif
+
+#ifdef CONFIG_CPU_CORTEX_M
+	int_entry();
+	print_dash_line();
+#endif
+
 	TC_END_REPORT(error_count);
 }
 
@@ -63,10 +63,11 @@ int sema_lock_unlock(void)
 
 	if (bench_test_end() == 0) {
 		diff = TIMING_INFO_GET_DELTA(timestamp_start, timestamp_end);
-		PRINT_FORMAT(" Average semaphore signal time %u tcs = %u"
+		PRINT_RESULT("semaphore signal",
+			     CYCLES_TO_NS_AVG(diff, N_TEST_SEMA),
+			     " Average semaphore signal time %u tcs = %u"
 			     " nsec",
-			     diff / N_TEST_SEMA,
-			     CYCLES_TO_NS_AVG(diff, N_TEST_SEMA));
+			     diff / N_TEST_SEMA);
 	} else {
 		error_count++;
 		PRINT_OVERFLOW_ERROR();
@@ -88,10 +89,11 @@ int sema_lock_unlock(void)
 
 	if (bench_test_end() == 0) {
 		diff = TIMING_INFO_GET_DELTA(timestamp_start, timestamp_end);
-		PRINT_FORMAT(" Average semaphore test time %u tcs = %u "
+		PRINT_RESULT("semaphore test",
+			     CYCLES_TO_NS_AVG(diff, N_TEST_SEMA),
+			     " Average semaphore test time %u tcs = %u "
 			     "nsec",
-			     diff / N_TEST_SEMA,
-			     CYCLES_TO_NS_AVG(diff, N_TEST_SEMA));
+			     diff / N_TEST_SEMA);
 	} else {
 		error_count++;
 		PRINT_OVERFLOW_ERROR();
@@ -128,9 +130,9 @@ int mutex_lock_unlock(void)
 	timestamp_end = TIMING_INFO_OS_GET_TIME();
 
 	diff = TIMING_INFO_GET_DELTA(timestamp_start, timestamp_end);
-	PRINT_FORMAT(" Average time to lock the mutex %u tcs = %u nsec",
-		     diff / N_TEST_MUTEX,
-		     CYCLES_TO_NS_AVG(diff, N_TEST_MUTEX));
+	PRINT_RESULT("mutex lock", CYCLES_TO_NS_AVG(diff, N_TEST_MUTEX),
+		     " Average time to lock the mutex %u tcs = %u nsec",
+		     diff / N_TEST_MUTEX);
 
 	TIMING_INFO_PRE_READ();
 	timestamp_start = TIMING_INFO_OS_GET_TIME();
@@ -143,9 +145,9 @@ int mutex_lock_unlock(void)
 	timestamp_end = TIMING_INFO_OS_GET_TIME();
 
 	diff = TIMING_INFO_GET_DELTA(timestamp_start, timestamp_end);
-	PRINT_FORMAT(" Average time to unlock the mutex %u tcs = %u nsec",
-		     diff / N_TEST_MUTEX,
-		     CYCLES_TO_NS_AVG(diff, N_TEST_MUTEX));
+	PRINT_RESULT("mutex unlock", CYCLES_TO_NS_AVG(diff, N_TEST_MUTEX),
+		     " Average time to unlock the mutex %u tcs = %u nsec",
+		     diff / N_TEST_MUTEX);
 	benchmark_timer_stop();
 	return 0;
 }
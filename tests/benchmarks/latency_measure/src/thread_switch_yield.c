@@ -105,11 +105,13 @@ void thread_switch_yield(void)
 		 * times in total.
 		 */
 		ts_diff = TIMING_INFO_GET_DELTA(timestamp_start, timestamp_end);
-		PRINT_FORMAT(" Average thread context switch using "
-			     "yield %u tcs = %u nsec",
-			     ts_diff / (iterations + helper_thread_iterations),
+		PRINT_RESULT("thread context switch yield",
 			     CYCLES_TO_NS_AVG(ts_diff,
-							   (iterations + helper_thread_iterations)));
+					      (iterations +
+					       helper_thread_iterations)),
+			     " Average thread context switch using "
+			     "yield %u tcs = %u nsec",
+			     ts_diff / (iterations + helper_thread_iterations));
 	}
 
 	benchmark_timer_stop();
@@ -20,6 +20,7 @@
 #ifdef CONFIG_PRINTK
 #include <sys/printk.h>
 #include <stdio.h>
+#include <ztest_benchmark.h>
 #include "timestamp.h"
 extern char tmp_string[];
 extern int error_count;
@@ -35,6 +36,17 @@ extern int error_count;
 		PRINTF("|%-77s|\n", tmp_string);				\
 	} while (0)
 
+/* Print a result row, whose last argument is @a ns, and report it as a
+ * benchmark record
+ */
+#define PRINT_RESULT(name, ns, fmt, ...)				\
+	do {								\
+		uint32_t result_ns = (ns);				\
+									\
+		PRINT_FORMAT(fmt, ##__VA_ARGS__, result_ns);		\
+		ztest_bench_report_ns(name, result_ns);			\
+	} while (0)
+
 /**
  *
  * @brief Print dash line
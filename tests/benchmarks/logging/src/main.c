@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <logging/log.h>
+#include <logging/log_ctrl.h>
+#include <logging/log_msg.h>
+#include <sys/mpsc_pbuf.h>
+
+LOG_MODULE_REGISTER(bench, LOG_LEVEL_INF);
+
+/* This is a logging subsystem benchmark. It reports:
+ *
+ * 1. The cycles spent in a logging call, with interrupts locked as in an
+ *    ISR, for each number of arguments and for hexdumps. In deferred mode
+ *    this is the cost of creating the message, in immediate mode it
+ *    includes the backend output.
+ * 2. The memory taken from the log buffer by each kind of message.
+ * 3. The number of messages per second processed by the enabled backend
+ *    (UART, RTT or ring buffer, depending on the configuration).
+ * 4. The number of messages dropped when logging faster than processing.
+ *
+ * Items 2 to 4 only apply to deferred mode.
+ */
+
+#define N_RUNS 100
+#define N_BURST 32
+
+static const uint8_t data[32] = { 0x55 };
+
+#ifndef CONFIG_LOG_IMMEDIATE
+extern struct mpsc_pbuf_buffer log_msg_buffer;
+#endif
+
+static void process_all(void)
+{
+	if (!IS_ENABLED(CONFIG_LOG_IMMEDIATE)) {
+		while (log_process(false)) {
+		}
+	}
+}
+
+#define BENCH_CALL(_name, _call)					\
+	do {								\
+		uint32_t total = 0;					\
+									\
+		for (int i = 0; i < N_RUNS; i++) {			\
+			unsigned int key = irq_lock();			\
+			uint32_t start = k_cycle_get_32();		\
+									\
+			_call;						\
+			total += k_cycle_get_32() - start;		\
+			irq_unlock(key);				\
+			process_all();					\
+		}							\
+		results[n_results].name = _name;			\
+		results[n_results++].cycles = total / N_RUNS;		\
+	} while (false)
+
+#define BENCH_MEM(_name, _call)						\
+	do {								\
+		uint32_t used = mpsc_pbuf_used_get(&log_msg_buffer);	\
+									\
+		_call;							\
+		used = mpsc_pbuf_used_get(&log_msg_buffer) - used;	\
+		process_all();						\
+		printk("%-10s %u bytes\n", _name, used);		\
+	} while (false)
+
+/* Results are printed once all calls are measured, so that in immediate
+ * mode the measurements are not interleaved with the log output.
+ */
+static struct {
+	const char *name;
+	uint32_t cycles;
+} results[8];
+static int n_results;
+
+static void bench_calls(void)
+{
+	BENCH_CALL("log_0", LOG_INF("test"));
+	BENCH_CALL("log_1", LOG_INF("test %d", 1));
+	BENCH_CALL("log_2", LOG_INF("test %d %d", 1, 2));
+	BENCH_CALL("log_3", LOG_INF("test %d %d %d", 1, 2, 3));
+	BENCH_CALL("log_n(6)", LOG_INF("test %d %d %d %d %d %d",
+				       1, 2, 3, 4, 5, 6));
+	BENCH_CALL("log_strdup", LOG_INF("test %s", log_strdup("str")));
+	BENCH_CALL("hexdump", LOG_HEXDUMP_INF(data, sizeof(data), "test"));
+
+	process_all();
+	printk("\nCycles per call (%s mode):\n",
+	       IS_ENABLED(CONFIG_LOG_IMMEDIATE) ? "immediate" : "deferred");
+	for (int i = 0; i < n_results; i++) {
+		printk("%-10s %u cycles\n", results[i].name,
+		       results[i].cycles);
+	}
+}
+
+#ifndef CONFIG_LOG_IMMEDIATE
+static void bench_memory(void)
+{
+	printk("\nLog buffer usage per message:\n");
+	BENCH_MEM("log_0", LOG_INF("test"));
+	BENCH_MEM("log_3", LOG_INF("test %d %d %d", 1, 2, 3));
+	BENCH_MEM("log_n(6)", LOG_INF("test %d %d %d %d %d %d",
+				      1, 2, 3, 4, 5, 6));
+	BENCH_MEM("hexdump", LOG_HEXDUMP_INF(data, sizeof(data), "test"));
+}
+
+static void bench_throughput(void)
+{
+	uint32_t count;
+	uint32_t cycles;
+
+	for (int i = 0; i < N_BURST; i++) {
+		LOG_INF("test %d %d", i, 2);
+	}
+
+	count = log_buffered_cnt();
+	cycles = k_cycle_get_32();
+	process_all();
+	cycles = k_cycle_get_32() - cycles;
+
+	printk("\nBackend throughput: %u messages in %u cycles, %u msg/s\n",
+	       count, cycles,
+	       (uint32_t)(((uint64_t)count * sys_clock_hw_cycles_per_sec()) /
+			  MAX(cycles, 1U)));
+}
+
+static void bench_drops(void)
+{
+	uint32_t burst = 4 * (CONFIG_LOG_BUFFER_SIZE /
+			      sizeof(union log_msg_chunk));
+	uint32_t buffered;
+
+	for (uint32_t i = 0; i < burst; i++) {
+		LOG_INF("test %d", i);
+	}
+
+	buffered = log_buffered_cnt();
+	process_all();
+
+	printk("\nBurst of %u messages: %u buffered, %u dropped\n",
+	       burst, buffered, burst - buffered);
+}
+#endif /* CONFIG_LOG_IMMEDIATE */
+
+void main(void)
+{
+	process_all();
+
+	bench_calls();
+
+#ifndef CONFIG_LOG_IMMEDIATE
+	bench_memory();
+	bench_throughput();
+	bench_drops();
+#endif
+
+	printk("fin\n");
+}
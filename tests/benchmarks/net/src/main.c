@@ -0,0 +1,489 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Network stack throughput and latency benchmark.
+ *
+ * UDP and TCP traffic is sent through the socket API either to our own
+ * address, in which case it goes through the loopback interface and both
+ * ends are measured, or to a peer given by CONFIG_NET_BENCHMARK_PEER_ADDR,
+ * in which case only the sending side is measured. Each run is repeated
+ * for payload sizes doubling from CONFIG_NET_BENCHMARK_MIN_PAYLOAD up to
+ * CONFIG_NET_BENCHMARK_MAX_PAYLOAD.
+ *
+ * Every result is printed as one line made of "NET_BENCH " followed by a
+ * JSON object so that it can be collected by scripts and compared across
+ * releases.
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/socket.h>
+#include <net/net_pkt.h>
+#include <net/buf.h>
+
+#define PEER_ADDR CONFIG_NET_BENCHMARK_PEER_ADDR
+#define LOOPBACK (sizeof(PEER_ADDR) == 1)
+#define LINK_NAME (LOOPBACK ? "loopback" : "peer")
+
+#define RX_TIMEOUT_MS 1000
+#define DONE_TIMEOUT K_SECONDS(30)
+
+#define WORKER_STACK_SIZE 2048
+#define WORKER_PRIORITY K_PRIO_PREEMPT(8)
+
+enum worker_mode {
+	WORKER_UDP_SINK,
+	WORKER_UDP_ECHO,
+	WORKER_TCP_SINK,
+};
+
+struct run_result {
+	uint32_t start;
+	uint32_t end;
+	uint32_t sent;
+	uint32_t received;
+	uint32_t bytes;
+	uint32_t retries;
+};
+
+struct usage {
+	uint32_t tx_pkt_peak;
+	uint32_t rx_pkt_peak;
+	uint32_t buf_peak;
+};
+
+static K_THREAD_STACK_DEFINE(worker_stack, WORKER_STACK_SIZE);
+static struct k_thread worker_thread;
+static K_SEM_DEFINE(worker_start, 0, 1);
+static K_SEM_DEFINE(worker_done, 0, 1);
+
+static struct {
+	enum worker_mode mode;
+	uint32_t expected;
+	struct run_result *result;
+} worker;
+
+static struct sockaddr_in peer;
+static int udp_sink = -1;
+static int tcp_listener = -1;
+
+static uint8_t payload[CONFIG_NET_BENCHMARK_MAX_PAYLOAD];
+static uint8_t rx_buf[CONFIG_NET_BENCHMARK_MAX_PAYLOAD];
+static uint8_t reply_buf[CONFIG_NET_BENCHMARK_MAX_PAYLOAD];
+
+static void usage_sample(struct usage *usage)
+{
+	struct k_mem_slab *rx, *tx;
+	struct net_buf_pool *rx_data, *tx_data;
+
+	net_pkt_get_info(&rx, &tx, &rx_data, &tx_data);
+
+	usage->rx_pkt_peak = MAX(usage->rx_pkt_peak,
+				 k_mem_slab_num_used_get(rx));
+	usage->tx_pkt_peak = MAX(usage->tx_pkt_peak,
+				 k_mem_slab_num_used_get(tx));
+
+#if defined(CONFIG_NET_BUF_POOL_USAGE)
+	usage->buf_peak = MAX(usage->buf_peak,
+			      (uint32_t)(rx_data->buf_count -
+					 rx_data->avail_count +
+					 tx_data->buf_count -
+					 tx_data->avail_count));
+#endif
+}
+
+static uint32_t elapsed_us(const struct run_result *result)
+{
+	return MAX(k_cyc_to_us_floor64(result->end - result->start), 1);
+}
+
+static bool wait_readable(int sock)
+{
+	struct pollfd fds = {
+		.fd = sock,
+		.events = POLLIN,
+	};
+
+	return poll(&fds, 1, RX_TIMEOUT_MS) > 0;
+}
+
+static void udp_sink_run(struct run_result *result, bool echo)
+{
+	struct sockaddr_in src;
+	socklen_t src_len;
+	int ret;
+
+	while (result->received < worker.expected) {
+		if (!wait_readable(udp_sink)) {
+			break;
+		}
+
+		src_len = sizeof(src);
+		ret = recvfrom(udp_sink, rx_buf, sizeof(rx_buf), 0,
+			       (struct sockaddr *)&src, &src_len);
+		if (ret < 0) {
+			break;
+		}
+
+		if (echo) {
+			(void)sendto(udp_sink, rx_buf, ret, 0,
+				     (struct sockaddr *)&src, src_len);
+		}
+
+		result->received++;
+		result->bytes += ret;
+		result->end = k_cycle_get_32();
+	}
+}
+
+static void tcp_sink_run(struct run_result *result)
+{
+	int sock;
+	int ret;
+
+	if (!wait_readable(tcp_listener)) {
+		return;
+	}
+
+	sock = accept(tcp_listener, NULL, NULL);
+	if (sock < 0) {
+		return;
+	}
+
+	while (result->bytes < worker.expected) {
+		if (!wait_readable(sock)) {
+			break;
+		}
+
+		ret = recv(sock, rx_buf, sizeof(rx_buf), 0);
+		if (ret <= 0) {
+			break;
+		}
+
+		result->received++;
+		result->bytes += ret;
+		result->end = k_cycle_get_32();
+	}
+
+	close(sock);
+}
+
+static void worker_fn(void *arg1, void *arg2, void *arg3)
+{
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (true) {
+		k_sem_take(&worker_start, K_FOREVER);
+
+		switch (worker.mode) {
+		case WORKER_UDP_SINK:
+			udp_sink_run(worker.result, false);
+			break;
+		case WORKER_UDP_ECHO:
+			udp_sink_run(worker.result, true);
+			break;
+		case WORKER_TCP_SINK:
+			tcp_sink_run(worker.result);
+			break;
+		}
+
+		k_sem_give(&worker_done);
+	}
+}
+
+static void worker_run(enum worker_mode mode, uint32_t expected,
+		       struct run_result *result)
+{
+	worker.mode = mode;
+	worker.expected = expected;
+	worker.result = result;
+
+	k_sem_give(&worker_start);
+}
+
+static bool worker_wait(void)
+{
+	return k_sem_take(&worker_done, DONE_TIMEOUT) == 0;
+}
+
+/* Out of network buffers: let the receiving side catch up and retry */
+static bool send_retry(int ret, struct run_result *result)
+{
+	if (ret < 0 && (errno == ENOMEM || errno == ENOBUFS ||
+			errno == EAGAIN)) {
+		result->retries++;
+		k_sleep(K_MSEC(1));
+
+		return true;
+	}
+
+	return false;
+}
+
+static void bench_udp_stream(size_t size)
+{
+	struct run_result result = { 0 };
+	struct usage usage = { 0 };
+	uint32_t us;
+	int sock;
+	int ret;
+
+	sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (sock < 0) {
+		printk("Cannot create UDP socket (%d)\n", errno);
+		return;
+	}
+
+	if (LOOPBACK) {
+		worker_run(WORKER_UDP_SINK, CONFIG_NET_BENCHMARK_PACKETS,
+			   &result);
+	}
+
+	result.start = k_cycle_get_32();
+
+	while (result.sent < CONFIG_NET_BENCHMARK_PACKETS) {
+		ret = sendto(sock, payload, size, 0,
+			     (struct sockaddr *)&peer, sizeof(peer));
+		if (send_retry(ret, &result)) {
+			continue;
+		}
+
+		if (ret < 0) {
+			printk("UDP send failed (%d)\n", errno);
+			break;
+		}
+
+		result.sent++;
+		usage_sample(&usage);
+	}
+
+	if (LOOPBACK) {
+		(void)worker_wait();
+	} else {
+		result.received = result.sent;
+		result.bytes = result.sent * size;
+		result.end = k_cycle_get_32();
+	}
+
+	close(sock);
+
+	us = elapsed_us(&result);
+
+	printk("NET_BENCH {\"test\":\"udp_stream\",\"link\":\"%s\","
+	       "\"size\":%zu,\"sent\":%u,\"received\":%u,\"retries\":%u,"
+	       "\"usec\":%u,\"kbps\":%u,\"pps\":%u,"
+	       "\"tx_pkt_peak\":%u,\"rx_pkt_peak\":%u,\"buf_peak\":%u}\n",
+	       LINK_NAME, size, result.sent, result.received, result.retries,
+	       us, (uint32_t)((uint64_t)result.bytes * 8000U / us),
+	       (uint32_t)((uint64_t)result.received * USEC_PER_SEC / us),
+	       usage.tx_pkt_peak, usage.rx_pkt_peak, usage.buf_peak);
+}
+
+static void bench_udp_rtt(size_t size)
+{
+	struct run_result result = { 0 };
+	struct usage usage = { 0 };
+	uint32_t min = UINT32_MAX, max = 0U;
+	uint32_t replies = 0U;
+	uint64_t sum = 0U;
+	uint32_t t0, us;
+	int sock;
+	int ret;
+
+	sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (sock < 0) {
+		printk("Cannot create UDP socket (%d)\n", errno);
+		return;
+	}
+
+	worker_run(WORKER_UDP_ECHO, CONFIG_NET_BENCHMARK_RTT_COUNT, &result);
+
+	while (result.sent < CONFIG_NET_BENCHMARK_RTT_COUNT) {
+		t0 = k_cycle_get_32();
+
+		ret = sendto(sock, payload, size, 0,
+			     (struct sockaddr *)&peer, sizeof(peer));
+		if (send_retry(ret, &result)) {
+			continue;
+		}
+
+		if (ret < 0) {
+			printk("UDP send failed (%d)\n", errno);
+			break;
+		}
+
+		result.sent++;
+		usage_sample(&usage);
+
+		if (!wait_readable(sock)) {
+			continue;
+		}
+
+		ret = recv(sock, reply_buf, sizeof(reply_buf), 0);
+		if (ret < 0) {
+			continue;
+		}
+
+		us = k_cyc_to_us_floor32(k_cycle_get_32() - t0);
+		min = MIN(min, us);
+		max = MAX(max, us);
+		sum += us;
+		replies++;
+	}
+
+	(void)worker_wait();
+	close(sock);
+
+	printk("NET_BENCH {\"test\":\"udp_rtt\",\"link\":\"%s\","
+	       "\"size\":%zu,\"sent\":%u,\"received\":%u,"
+	       "\"min_us\":%u,\"avg_us\":%u,\"max_us\":%u,"
+	       "\"tx_pkt_peak\":%u,\"rx_pkt_peak\":%u,\"buf_peak\":%u}\n",
+	       LINK_NAME, size, result.sent, replies,
+	       replies ? min : 0U,
+	       replies ? (uint32_t)(sum / replies) : 0U,
+	       max, usage.tx_pkt_peak, usage.rx_pkt_peak, usage.buf_peak);
+}
+
+static void bench_tcp_stream(size_t size)
+{
+	struct run_result result = { 0 };
+	struct usage usage = { 0 };
+	uint32_t sent_bytes = 0U;
+	uint32_t us;
+	int sock;
+	int ret;
+
+	sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0) {
+		printk("Cannot create TCP socket (%d)\n", errno);
+		return;
+	}
+
+	if (LOOPBACK) {
+		worker_run(WORKER_TCP_SINK, CONFIG_NET_BENCHMARK_TCP_BYTES,
+			   &result);
+	}
+
+	ret = connect(sock, (struct sockaddr *)&peer, sizeof(peer));
+	if (ret < 0) {
+		printk("TCP connect failed (%d)\n", errno);
+		goto out;
+	}
+
+	result.start = k_cycle_get_32();
+
+	while (sent_bytes < CONFIG_NET_BENCHMARK_TCP_BYTES) {
+		ret = send(sock, payload,
+			   MIN(size, CONFIG_NET_BENCHMARK_TCP_BYTES -
+				     sent_bytes), 0);
+		if (send_retry(ret, &result)) {
+			continue;
+		}
+
+		if (ret < 0) {
+			printk("TCP send failed (%d)\n", errno);
+			break;
+		}
+
+		result.sent++;
+		sent_bytes += ret;
+		usage_sample(&usage);
+	}
+
+	if (!LOOPBACK) {
+		result.bytes = sent_bytes;
+		result.end = k_cycle_get_32();
+	}
+
+out:
+	close(sock);
+
+	if (LOOPBACK) {
+		(void)worker_wait();
+	}
+
+	us = elapsed_us(&result);
+
+	printk("NET_BENCH {\"test\":\"tcp_stream\",\"link\":\"%s\","
+	       "\"size\":%zu,\"sent\":%u,\"bytes\":%u,\"retries\":%u,"
+	       "\"usec\":%u,\"kbps\":%u,"
+	       "\"tx_pkt_peak\":%u,\"rx_pkt_peak\":%u,\"buf_peak\":%u}\n",
+	       LINK_NAME, size, sent_bytes, result.bytes, result.retries,
+	       us, (uint32_t)((uint64_t)result.bytes * 8000U / us),
+	       usage.tx_pkt_peak, usage.rx_pkt_peak, usage.buf_peak);
+}
+
+static int setup(void)
+{
+	struct sockaddr_in local = {
+		.sin_family = AF_INET,
+		.sin_port = htons(CONFIG_NET_BENCHMARK_PORT),
+	};
+
+	peer.sin_family = AF_INET;
+	peer.sin_port = htons(CONFIG_NET_BENCHMARK_PORT);
+
+	if (!LOOPBACK) {
+		return inet_pton(AF_INET, PEER_ADDR, &peer.sin_addr) == 1 ?
+			0 : -EINVAL;
+	}
+
+	if (inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR,
+		      &peer.sin_addr) != 1) {
+		return -EINVAL;
+	}
+
+	udp_sink = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	tcp_listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (udp_sink < 0 || tcp_listener < 0) {
+		return -errno;
+	}
+
+	if (bind(udp_sink, (struct sockaddr *)&local, sizeof(local)) < 0 ||
+	    bind(tcp_listener, (struct sockaddr *)&local,
+		 sizeof(local)) < 0 ||
+	    listen(tcp_listener, 1) < 0) {
+		return -errno;
+	}
+
+	k_thread_create(&worker_thread, worker_stack,
+			K_THREAD_STACK_SIZEOF(worker_stack),
+			worker_fn, NULL, NULL, NULL,
+			WORKER_PRIORITY, 0, K_NO_WAIT);
+	k_thread_name_set(&worker_thread, "bench_worker");
+
+	return 0;
+}
+
+void main(void)
+{
+	size_t size;
+	int i;
+
+	for (i = 0; i < sizeof(payload); i++) {
+		payload[i] = i;
+	}
+
+	if (setup() < 0) {
+		printk("Benchmark setup failed\n");
+		return;
+	}
+
+	for (size = CONFIG_NET_BENCHMARK_MIN_PAYLOAD;
+	     size <= CONFIG_NET_BENCHMARK_MAX_PAYLOAD; size *= 2) {
+		bench_udp_stream(size);
+
+		if (LOOPBACK) {
+			bench_udp_rtt(size);
+		}
+
+		bench_tcp_stream(size);
+	}
+
+	printk("NET_BENCH done\n");
+}
@@ -8,6 +8,7 @@
 #include <sys/printk.h>
 #include <wait_q.h>
 #include <ksched.h>
+#include <ztest_benchmark.h>
 
 /* This is a scheduler microbenchmark, designed to measure latencies
  * of specific low level scheduling primitives independent of overhead
@@ -24,9 +25,9 @@
  *    (the kernel switches to the main thread)
  * 5. The main thread returns from k_yield()
  *
- * It then iterates this many times, reporting timestamp latencies
- * between each numbered step and for the whole cycle, and a running
- * average for all cycles run.
+ * It then iterates this many times, and reports the statistics of the
+ * timestamp latencies between each numbered step and for the whole
+ * cycle.
  */
 
 #define N_RUNS 1000
@@ -49,19 +50,18 @@ enum {
 
 uint32_t stamps[NUM_STAMP_STATES];
 
+/* One benchmark per step, and one for the whole cycle */
+static const char *const step_names[NUM_STAMP_STATES] = {
+	"sched_unpend", "sched_ready", "sched_switch", "sched_pend",
+	"sched_total",
+};
+
+static struct ztest_bench benches[NUM_STAMP_STATES];
+static uint32_t total_samples[N_RUNS];
+
 static inline int _stamp(int state)
 {
-	uint32_t t;
-
-	/* In theory the TSC has much lower overhead and higher
-	 * precision.  In practice it's VERY jittery in recent qemu
-	 * versions and frankly too noisy to trust.
-	 */
-#ifdef CONFIG_X86
-	__asm__ volatile("rdtsc" : "=a"(t) : : "edx");
-#else
-	t = k_cycle_get_32();
-#endif
+	uint32_t t = ztest_bench_cycles();
 
 	stamps[state] = t;
 	return t;
@@ -101,10 +101,15 @@ void main(void)
 	/* Let it start running and pend */
 	k_sleep(K_MSEC(100));
 
-	uint64_t tot = 0U;
-	uint32_t runs = 0U;
+	/* The first runs are discarded to let performance settle, cache
+	 * effects in the host pollute the early data.
+	 */
+	for (int i = 0; i < NUM_STAMP_STATES; i++) {
+		ztest_bench_init(&benches[i], step_names[i], N_SETTLE, N_RUNS,
+				 i == YIELDED ? total_samples : NULL);
+	}
 
-	for (int i = 0; i < N_RUNS + N_SETTLE; i++) {
+	while (!ztest_bench_done(&benches[YIELDED])) {
 		stamp(UNPENDING);
 		z_unpend_first_thread(&waitq);
 		stamp(UNPENDED_READYING);
@@ -120,33 +125,18 @@ void main(void)
 		k_yield();
 		stamp(YIELDED);
 
-		uint32_t avg, whole = stamps[4] - stamps[0];
-
-		if (++runs > N_SETTLE) {
-			/* Only compute averages after the first ~10
-			 * runs to let performance settle, cache
-			 * effects in the host pollute the early
-			 * data
-			 */
-			tot += whole;
-			avg = tot / (runs - 10);
-		} else {
-			tot = 0U;
-			avg = 0U;
+		for (int s = UNPENDED_READYING; s <= YIELDED; s++) {
+			ztest_bench_record(&benches[s - 1],
+					   stamps[s] - stamps[s - 1]);
 		}
 
-		/* For reference, an unmodified HEAD on qemu_x86 with
-		 * !USERSPACE and SCHED_DUMB and using -icount
-		 * shift=0,sleep=off,align=off, I get results of:
-		 *
-		 * unpend 132 ready 257 switch 278 pend 321 tot 988 (avg 900)
-		 */
-		printk("unpend %4d ready %4d switch %4d pend %4d tot %4d (avg %4d)\n",
-		       stamps[1] - stamps[0],
-		       stamps[2] - stamps[1],
-		       stamps[3] - stamps[2],
-		       stamps[4] - stamps[3],
-		       whole, avg);
+		ztest_bench_record(&benches[YIELDED],
+				   stamps[YIELDED] - stamps[UNPENDING]);
 	}
+
+	for (int i = 0; i < NUM_STAMP_STATES; i++) {
+		ztest_bench_report(&benches[i]);
+	}
+
 	printk("fin\n");
 }
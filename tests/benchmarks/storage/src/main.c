@@ -0,0 +1,439 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <string.h>
+#include <errno.h>
+#include <storage/flash_map.h>
+
+#ifdef CONFIG_FILE_SYSTEM
+#include <fs/fs.h>
+#endif
+#ifdef CONFIG_FILE_SYSTEM_LITTLEFS
+#include <fs/littlefs.h>
+#endif
+#ifdef CONFIG_FAT_FILESYSTEM_ELM
+#include <ff.h>
+#endif
+#ifdef CONFIG_SETTINGS
+#include <settings/settings.h>
+#elif defined(CONFIG_NVS)
+#include <fs/nvs.h>
+#endif
+#ifdef CONFIG_FLASH_SIMULATOR_UNIT_STATS
+#include <drivers/flash/flash_simulator.h>
+#endif
+
+/* This is a storage benchmark. Depending on the configuration it reports,
+ * for each run, the throughput and the 50th, 90th and 99th percentile and
+ * maximum latency of the individual operations:
+ *
+ * 1. File system (FAT or littlefs): sequential write, sync, sequential
+ *    read, random block reads and random block writes in a file.
+ * 2. NVS: writes and reads of a few ids, or with CONFIG_SETTINGS, saves and
+ *    a load of settings through the configured backend.
+ *
+ * On the flash simulator, the bytes programmed and the erases of each run
+ * are reported as well, taken from its per erase unit counters.
+ */
+
+#define BLOCK_SIZE CONFIG_BENCH_BLOCK_SIZE
+#define N_BLOCKS (CONFIG_BENCH_FILE_SIZE / BLOCK_SIZE)
+#define N_LAT MAX(MAX(N_BLOCKS, CONFIG_BENCH_RANDOM_OPS), CONFIG_BENCH_NVS_OPS)
+#define N_KEYS 16
+
+BUILD_ASSERT(CONFIG_BENCH_FILE_SIZE % BLOCK_SIZE == 0,
+	     "The file size must be a multiple of the block size");
+
+#if FLASH_AREA_LABEL_EXISTS(bench)
+#define BENCH_AREA_ID FLASH_AREA_ID(bench)
+#else
+#define BENCH_AREA_ID FLASH_AREA_ID(storage)
+#endif
+
+static uint32_t lat[N_LAT];
+static uint8_t block[MAX(BLOCK_SIZE, CONFIG_BENCH_NVS_VALUE_SIZE)] __aligned(4);
+static uint32_t rand_state = 0x2545f491;
+
+#define TIMED(_i, _call)						\
+	do {								\
+		uint32_t start = k_cycle_get_32();			\
+									\
+		rc = _call;						\
+		lat[_i] = k_cycle_get_32() - start;			\
+	} while (false)
+
+/* Deterministic, so that runs compare. */
+static uint32_t bench_rand(void)
+{
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+
+	return rand_state;
+}
+
+static void sort(uint32_t *v, int n)
+{
+	for (int i = 1; i < n; i++) {
+		uint32_t x = v[i];
+		int j;
+
+		for (j = i; (j > 0) && (v[j - 1] > x); j--) {
+			v[j] = v[j - 1];
+		}
+		v[j] = x;
+	}
+}
+
+/* Print the results of the n operations timed in lat[], which moved
+ * bytes of data.
+ */
+static void report(const char *name, int n, size_t bytes)
+{
+	uint64_t total = 0;
+
+	for (int i = 0; i < n; i++) {
+		total += lat[i];
+	}
+
+	sort(lat, n);
+
+	printk("%-12s %6u KiB/s p50 %6u us p90 %6u us p99 %6u us max %6u us\n",
+	       name,
+	       (uint32_t)((bytes * (uint64_t)sys_clock_hw_cycles_per_sec()) /
+			  (1024U * MAX(total, 1U))),
+	       k_cyc_to_us_floor32(lat[n / 2]),
+	       k_cyc_to_us_floor32(lat[(n * 9) / 10]),
+	       k_cyc_to_us_floor32(lat[(n * 99) / 100]),
+	       k_cyc_to_us_floor32(lat[n - 1]));
+}
+
+#ifdef CONFIG_FLASH_SIMULATOR_UNIT_STATS
+struct wear {
+	uint32_t bytes_written;
+	uint32_t erases;
+	uint32_t max_unit_erases;
+};
+
+static void wear_get(struct wear *w)
+{
+	struct device *dev =
+		device_get_binding(DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	struct flash_simulator_unit_stats st;
+	size_t count = flash_simulator_unit_count(dev);
+
+	memset(w, 0, sizeof(*w));
+	for (size_t i = 0; i < count; i++) {
+		(void)flash_simulator_unit_stats_get(dev, i, &st);
+		w->bytes_written += st.bytes_written;
+		w->erases += st.erases;
+		w->max_unit_erases = MAX(w->max_unit_erases, st.erases);
+	}
+}
+
+/* Print the flash wear since the snapshot in w, and update it. */
+static void wear_report(struct wear *w)
+{
+	struct wear now;
+
+	wear_get(&now);
+	printk("%-12s %u bytes programmed, %u unit erases, %u max per unit\n",
+	       "  wear", now.bytes_written - w->bytes_written,
+	       now.erases - w->erases, now.max_unit_erases);
+	*w = now;
+}
+#else
+struct wear {
+};
+
+static inline void wear_get(struct wear *w)
+{
+}
+
+static inline void wear_report(struct wear *w)
+{
+}
+#endif
+
+#ifdef CONFIG_FILE_SYSTEM
+#if defined(CONFIG_FILE_SYSTEM_LITTLEFS)
+FS_LITTLEFS_DECLARE_DEFAULT_CONFIG(lfs_data);
+
+static struct fs_mount_t mnt = {
+	.type = FS_LITTLEFS,
+	.fs_data = &lfs_data,
+	.storage_dev = (void *)BENCH_AREA_ID,
+	.mnt_point = "/lfs",
+};
+#define FS_NAME "littlefs"
+#elif defined(CONFIG_FAT_FILESYSTEM_ELM)
+static FATFS fat_fs;
+
+static struct fs_mount_t mnt = {
+	.type = FS_FATFS,
+	.fs_data = &fat_fs,
+#ifdef CONFIG_DISK_ACCESS_SDHC
+	.mnt_point = "/" CONFIG_DISK_SDHC_VOLUME_NAME ":",
+#else
+	.mnt_point = "/" CONFIG_DISK_RAM_VOLUME_NAME ":",
+#endif
+};
+#define FS_NAME "FAT"
+#endif
+
+static int bench_fs_seq(struct fs_file_t *file, bool write)
+{
+	int rc;
+
+	rc = fs_seek(file, 0, FS_SEEK_SET);
+	if (rc < 0) {
+		return rc;
+	}
+
+	for (int i = 0; i < N_BLOCKS; i++) {
+		if (write) {
+			TIMED(i, fs_write(file, block, BLOCK_SIZE));
+		} else {
+			TIMED(i, fs_read(file, block, BLOCK_SIZE));
+		}
+
+		if (rc != BLOCK_SIZE) {
+			return (rc < 0) ? rc : -EIO;
+		}
+	}
+
+	report(write ? "seq write" : "seq read", N_BLOCKS,
+	       N_BLOCKS * BLOCK_SIZE);
+
+	return 0;
+}
+
+static int bench_fs_random(struct fs_file_t *file, bool write)
+{
+	int rc;
+
+	for (int i = 0; i < CONFIG_BENCH_RANDOM_OPS; i++) {
+		off_t off = (bench_rand() % N_BLOCKS) * BLOCK_SIZE;
+		uint32_t start = k_cycle_get_32();
+
+		rc = fs_seek(file, off, FS_SEEK_SET);
+		if (rc == 0) {
+			rc = write ? fs_write(file, block, BLOCK_SIZE) :
+				     fs_read(file, block, BLOCK_SIZE);
+		}
+		lat[i] = k_cycle_get_32() - start;
+
+		if (rc != BLOCK_SIZE) {
+			return (rc < 0) ? rc : -EIO;
+		}
+	}
+
+	if (write) {
+		rc = fs_sync(file);
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	report(write ? "rand write" : "rand read", CONFIG_BENCH_RANDOM_OPS,
+	       CONFIG_BENCH_RANDOM_OPS * BLOCK_SIZE);
+
+	return 0;
+}
+
+static void bench_fs(void)
+{
+	struct fs_file_t file;
+	struct wear wear;
+	char path[32];
+	int rc;
+
+	printk("\n%s file system, %u byte blocks, %u byte file:\n", FS_NAME,
+	       BLOCK_SIZE, CONFIG_BENCH_FILE_SIZE);
+
+	rc = fs_mount(&mnt);
+	if (rc < 0) {
+		printk("Mounting %s failed: %d\n", mnt.mnt_point, rc);
+		return;
+	}
+
+	snprintk(path, sizeof(path), "%s/bench.bin", mnt.mnt_point);
+	(void)fs_unlink(path);
+
+	rc = fs_open(&file, path, FS_O_CREATE | FS_O_RDWR);
+	if (rc < 0) {
+		printk("Opening %s failed: %d\n", path, rc);
+		goto unmount;
+	}
+
+	memset(block, 0xa5, sizeof(block));
+	wear_get(&wear);
+
+	rc = bench_fs_seq(&file, true);
+	if (rc < 0) {
+		goto close;
+	}
+
+	TIMED(0, fs_sync(&file));
+	if (rc < 0) {
+		goto close;
+	}
+	report("sync", 1, 0);
+	wear_report(&wear);
+
+	rc = bench_fs_seq(&file, false);
+	if (rc < 0) {
+		goto close;
+	}
+
+	rc = bench_fs_random(&file, false);
+	if (rc < 0) {
+		goto close;
+	}
+
+	rc = bench_fs_random(&file, true);
+	if (rc < 0) {
+		goto close;
+	}
+	wear_report(&wear);
+
+close:
+	if (rc < 0) {
+		printk("%s run failed: %d\n", FS_NAME, rc);
+	}
+
+	fs_close(&file);
+	fs_unlink(path);
+
+unmount:
+	fs_unmount(&mnt);
+}
+#endif /* CONFIG_FILE_SYSTEM */
+
+#if defined(CONFIG_SETTINGS)
+static void bench_settings(void)
+{
+	struct wear wear;
+	char key[16];
+	int rc;
+
+	printk("\nSettings, %u byte values over %u keys:\n",
+	       CONFIG_BENCH_NVS_VALUE_SIZE, N_KEYS);
+
+	rc = settings_subsys_init();
+	if (rc < 0) {
+		printk("Settings init failed: %d\n", rc);
+		return;
+	}
+
+	wear_get(&wear);
+
+	for (int i = 0; i < CONFIG_BENCH_NVS_OPS; i++) {
+		snprintk(key, sizeof(key), "bench/%d", i % N_KEYS);
+		block[0] = i;
+		TIMED(i, settings_save_one(key, block,
+					   CONFIG_BENCH_NVS_VALUE_SIZE));
+		if (rc < 0) {
+			printk("Saving %s failed: %d\n", key, rc);
+			return;
+		}
+	}
+
+	report("save", CONFIG_BENCH_NVS_OPS,
+	       CONFIG_BENCH_NVS_OPS * CONFIG_BENCH_NVS_VALUE_SIZE);
+	wear_report(&wear);
+
+	TIMED(0, settings_load());
+	report("load", 1, 0);
+}
+#elif defined(CONFIG_NVS)
+static void bench_nvs(void)
+{
+	struct flash_pages_info info;
+	const struct flash_area *fa;
+	static struct nvs_fs fs;
+	struct wear wear;
+	int rc;
+
+	printk("\nNVS, %u byte values over %u ids:\n",
+	       CONFIG_BENCH_NVS_VALUE_SIZE, N_KEYS);
+
+	rc = flash_area_open(BENCH_AREA_ID, &fa);
+	if (rc < 0) {
+		printk("Opening the flash area failed: %d\n", rc);
+		return;
+	}
+
+	rc = flash_get_page_info_by_offs(
+		device_get_binding(fa->fa_dev_name), fa->fa_off, &info);
+	if (rc < 0) {
+		printk("Getting the page size failed: %d\n", rc);
+		return;
+	}
+
+	fs.offset = fa->fa_off;
+	fs.sector_size = info.size;
+	fs.sector_count = MIN(fa->fa_size / info.size, UINT16_MAX);
+
+	rc = nvs_init(&fs, fa->fa_dev_name);
+	if (rc == 0) {
+		rc = nvs_clear(&fs);
+	}
+	if (rc == 0) {
+		rc = nvs_init(&fs, fa->fa_dev_name);
+	}
+	if (rc < 0) {
+		printk("NVS init failed: %d\n", rc);
+		return;
+	}
+
+	wear_get(&wear);
+
+	for (int i = 0; i < CONFIG_BENCH_NVS_OPS; i++) {
+		block[0] = i;
+		TIMED(i, nvs_write(&fs, i % N_KEYS, block,
+				   CONFIG_BENCH_NVS_VALUE_SIZE));
+		if (rc < 0) {
+			printk("Writing id %d failed: %d\n", i % N_KEYS, rc);
+			return;
+		}
+	}
+
+	report("write", CONFIG_BENCH_NVS_OPS,
+	       CONFIG_BENCH_NVS_OPS * CONFIG_BENCH_NVS_VALUE_SIZE);
+	wear_report(&wear);
+
+	for (int i = 0; i < CONFIG_BENCH_NVS_OPS; i++) {
+		TIMED(i, nvs_read(&fs, i % N_KEYS, block,
+				  CONFIG_BENCH_NVS_VALUE_SIZE));
+		if (rc < 0) {
+			printk("Reading id %d failed: %d\n", i % N_KEYS, rc);
+			return;
+		}
+	}
+
+	report("read", CONFIG_BENCH_NVS_OPS,
+	       CONFIG_BENCH_NVS_OPS * CONFIG_BENCH_NVS_VALUE_SIZE);
+}
+#endif
+
+void main(void)
+{
+	printk("Storage benchmark\n");
+
+#ifdef CONFIG_FILE_SYSTEM
+	bench_fs();
+#endif
+#if defined(CONFIG_SETTINGS)
+	bench_settings();
+#elif defined(CONFIG_NVS)
+	bench_nvs();
+#endif
+
+	printk("\nfin\n");
+}
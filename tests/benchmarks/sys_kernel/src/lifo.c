@@ -168,7 +168,7 @@ int lifo_test(void)
 
 	t = TIME_STAMP_DELTA_GET(t);
 
-	return_value += check_result(i, t);
+	return_value += check_result("LIFO #1", i, t);
 
 	/* threads have done their job, they can stop now safely: */
 	for (j = 0; j < 2; j++) {
@@ -202,7 +202,7 @@ int lifo_test(void)
 
 	t = TIME_STAMP_DELTA_GET(t);
 
-	return_value += check_result(i, t);
+	return_value += check_result("LIFO #2", i, t);
 
 	/* threads have done their job, they can stop now safely: */
 	for (j = 0; j < 2; j++) {
@@ -248,7 +248,7 @@ int lifo_test(void)
 
 	t = TIME_STAMP_DELTA_GET(t);
 
-	return_value += check_result(i * 2, t);
+	return_value += check_result("LIFO #3", i * 2, t);
 
 	/* threads have done their job, they can stop now safely: */
 	for (j = 0; j < 2; j++) {
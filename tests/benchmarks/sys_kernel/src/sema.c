@@ -135,7 +135,7 @@ int sema_test(void)
 
 	t = TIME_STAMP_DELTA_GET(t);
 
-	return_value += check_result(i, t);
+	return_value += check_result("Semaphore #1", i, t);
 
 	fprintf(output_file, sz_test_case_fmt,
 			"Semaphore #2");
@@ -160,7 +160,7 @@ int sema_test(void)
 
 	t = TIME_STAMP_DELTA_GET(t);
 
-	return_value += check_result(i, t);
+	return_value += check_result("Semaphore #2", i, t);
 
 	fprintf(output_file, sz_test_case_fmt,
 			"Semaphore #3");
@@ -186,7 +186,7 @@ int sema_test(void)
 
 	t = TIME_STAMP_DELTA_GET(t);
 
-	return_value += check_result(i, t);
+	return_value += check_result("Semaphore #3", i, t);
 
 	return return_value;
 }
@@ -169,7 +169,7 @@ int stack_test(void)
 
 	t = TIME_STAMP_DELTA_GET(t);
 
-	return_value += check_result(i, t);
+	return_value += check_result("Stack #1", i, t);
 
 	/* test get/yield & put stack functions between co-op threads */
 	fprintf(output_file, sz_test_case_fmt,
@@ -196,7 +196,7 @@ int stack_test(void)
 
 	t = TIME_STAMP_DELTA_GET(t);
 
-	return_value += check_result(i, t);
+	return_value += check_result("Stack #2", i, t);
 
 	/* test get wait & put stack functions across co-op and premptive
 	 * threads
@@ -239,7 +239,7 @@ int stack_test(void)
 
 	t = TIME_STAMP_DELTA_GET(t);
 
-	return_value += check_result(i * 2, t);
+	return_value += check_result("Stack #3", i * 2, t);
 
 	return return_value;
 }
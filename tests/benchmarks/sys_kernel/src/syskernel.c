@@ -51,15 +51,18 @@ void begin_test(void)
 
 /**
  *
- * @brief Checks number of tests and calculate average time
+ * @brief Checks number of tests and reports the average time
  *
  * @return 1 if success and 0 on failure
  *
+ * @param name Name of the test case.
  * @param i   Number of tests.
- * @param t   Time in ticks for the whole test.
+ * @param t   Time in cycles for the whole test.
  */
-int check_result(int i, uint32_t t)
+int check_result(const char *name, int i, uint32_t t)
 {
+	struct ztest_bench bench;
+
 	/*
 	 * bench_test_end checks tCheck static variable.
 	 * bench_test_start modifies it
@@ -79,10 +82,11 @@ int check_result(int i, uint32_t t)
 		return 0;
 	}
 	fprintf(output_file, sz_case_result_fmt, sz_success);
-	fprintf(output_file, sz_case_details_fmt,
-			"Average time for 1 iteration: ");
-	fprintf(output_file, sz_case_timing_fmt,
-			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(t, number_of_loops));
+	fprintf(output_file, "\n");
+
+	ztest_bench_init(&bench, name, 0, number_of_loops, NULL);
+	ztest_bench_record_batch(&bench, t, number_of_loops);
+	ztest_bench_report(&bench);
 
 	fprintf(output_file, sz_case_end_fmt);
 	return 1;
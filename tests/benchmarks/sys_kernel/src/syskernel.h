@@ -10,6 +10,7 @@
 #define SYSKERNEK_H
 
 #include <timestamp.h>
+#include <ztest_benchmark.h>
 
 #include <stdio.h>
 #include <toolchain.h>
@@ -43,9 +44,8 @@ extern uint32_t number_of_loops;
 #define sz_case_result_fmt	"\nTEST RESULT: %s"
 #define sz_case_details_fmt	"\nDETAILS: %s"
 #define sz_case_end_fmt		"\nEND TEST CASE"
-#define sz_case_timing_fmt	"%u nSec"
 
-int check_result(int i, uint32_t ticks);
+int check_result(const char *name, int i, uint32_t ticks);
 
 int sema_test(void);
 int lifo_test(void);
@@ -11,8 +11,6 @@
 #include <ksched.h>
 #include "timing_info.h"
 
-extern char sline[];
-
 /* mailbox*/
 /* K_MBOX_DEFINE(test_msg_queue) */
 K_MSGQ_DEFINE(benchmark_q, sizeof(int), 10, 4);
@@ -10,9 +10,6 @@
 #include <ksched.h>
 #include "timing_info.h"
 
-
-extern char sline[];
-
 K_SEM_DEFINE(sem_bench, 0, 1);
 K_SEM_DEFINE(sem_bench_1, 0, 1);
 
@@ -15,7 +15,6 @@
 #include <tc_util.h>
 #include <ksched.h>
 #include "timing_info.h"
-char sline[256];
 /* FILE *output_file = stdout; */
 
 /* location of the time stamps*/
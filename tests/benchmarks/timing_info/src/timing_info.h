@@ -206,20 +206,14 @@ static inline uint32_t get_core_freq_MHz(void)
 
 /******************************************************************************/
 /* PRINT_F
- * Macro to print a formatted output string. fprintf is used when
- * Assumed that sline character array of SLINE_LEN + 1 characters
- * is defined in the main file
+ * Macro to report a result, given as description, cycles and nanoseconds,
+ * through the ztest benchmark API. The timestamps are taken by the
+ * architecture code with the timers above, so only the result in
+ * nanoseconds is reported.
  */
+#include <ztest_benchmark.h>
 
-/* #define CSV_FORMAT_OUTPUT */
-/* printf format defines. */
-#ifdef CSV_FORMAT_OUTPUT
-#define FORMAT "%-45s,%4u,%5u\n"
-#else
-#define FORMAT "%-45s:%4u cycles , %5u ns\n"
-#endif
-#include <stdio.h>
-
+#define GET_1ST_ARG(first, ...) (first)
 #define GET_2ND_ARG(first, second, ...) (second)
 #define GET_3ND_ARG(first, second, third, ...) (third)
 
@@ -237,16 +231,16 @@ static inline uint32_t get_core_freq_MHz(void)
 	{							     \
 		if ((GET_2ND_ARG(__VA_ARGS__) <= 20000) &&	     \
 		    (GET_2ND_ARG(__VA_ARGS__) != 0)) {		     \
-			snprintf(sline, 254, FORMAT, ##__VA_ARGS__); \
-			TC_PRINT("%s", sline);			     \
+			ztest_bench_report_ns(GET_1ST_ARG(__VA_ARGS__), \
+					      GET_3ND_ARG(__VA_ARGS__)); \
 		}						     \
 	}
 #else
 /* Prints all outputs*/
 #define PRINT_F(...)						     \
 	{							     \
-		snprintf(sline, 254, FORMAT, ##__VA_ARGS__); \
-		TC_PRINT("%s", sline);			     \
+		ztest_bench_report_ns(GET_1ST_ARG(__VA_ARGS__),	     \
+				      GET_3ND_ARG(__VA_ARGS__));     \
 	}
 
 #endif
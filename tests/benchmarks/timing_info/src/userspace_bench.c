@@ -19,7 +19,6 @@
 K_APPMEM_PARTITION_DEFINE(bench_ptn);
 struct k_mem_domain bench_domain;
 
-extern char sline[256];
 extern uint64_t arch_timing_enter_user_mode_end;
 
 uint64_t drop_to_user_mode_start_time;
@@ -18,8 +18,6 @@ extern K_THREAD_STACK_DEFINE(my_stack_area_0, STACK_SIZE);
 extern struct k_thread my_thread;
 extern struct k_thread my_thread_0;
 
-extern char sline[];
-
 extern uint64_t thread_sleep_start_time;
 extern uint64_t thread_sleep_end_time;
 uint64_t thread_yield_start_time;
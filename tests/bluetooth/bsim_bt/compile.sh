@@ -58,3 +58,5 @@ app=tests/bluetooth/bsim_bt/bsim_test_app conf_file=prj_split_privacy.conf \
 app=tests/bluetooth/bsim_bt/bsim_test_advx compile
 app=tests/bluetooth/bsim_bt/edtt_ble_test_app/hci_test_app compile
 app=tests/bluetooth/bsim_bt/edtt_ble_test_app/gatt_test_app compile
+app=tests/benchmarks/bluetooth compile
+app=tests/benchmarks/bluetooth conf_file=prj_peripheral.conf compile
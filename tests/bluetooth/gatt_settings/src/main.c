@@ -0,0 +1,216 @@
+/* main.c - Application main entry point */
+
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <stddef.h>
+#include <ztest.h>
+
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/gatt.h>
+#include <settings/settings.h>
+
+#include "gatt_internal.h"
+#include "settings_ram.h"
+
+/* Settings keys of the peer below, as encoded by the host */
+#define PEER_KEY	"c0ffee0000010"
+#define CCC_KEY		"bt/ccc/" PEER_KEY
+#define SC_KEY		"bt/sc/" PEER_KEY
+#define CF_KEY		"bt/cf/" PEER_KEY
+#define GATT_KEY	"bt/gatt/" PEER_KEY
+
+#define GATT_STORE_VERSION	1
+#define GATT_STORE_SC		BIT(0)
+#define GATT_STORE_CF		BIT(1)
+
+/* "bt/gatt" item of a peer with one CCC */
+struct gatt_item {
+	uint8_t version;
+	uint8_t flags;
+	uint8_t cf;
+	uint8_t rfu;
+	uint16_t sc_start;
+	uint16_t sc_end;
+	uint16_t ccc_handle;
+	uint16_t ccc_value;
+} __packed;
+
+static const bt_addr_le_t peer = {
+	.type = BT_ADDR_LE_PUBLIC,
+	.a.val = { 0x01, 0x00, 0x00, 0xee, 0xff, 0xc0 },
+};
+
+static struct bt_uuid_128 test_uuid = BT_UUID_INIT_128(
+	0xf0, 0xde, 0xbc, 0x9a, 0x78, 0x56, 0x34, 0x12,
+	0x78, 0x56, 0x34, 0x12, 0x78, 0x56, 0x34, 0x12);
+static struct bt_uuid_128 test_nfy_uuid = BT_UUID_INIT_128(
+	0xf1, 0xde, 0xbc, 0x9a, 0x78, 0x56, 0x34, 0x12,
+	0x78, 0x56, 0x34, 0x12, 0x78, 0x56, 0x34, 0x12);
+
+BT_GATT_SERVICE_DEFINE(test_svc,
+	BT_GATT_PRIMARY_SERVICE(&test_uuid),
+	BT_GATT_CHARACTERISTIC(&test_nfy_uuid.uuid, BT_GATT_CHRC_NOTIFY,
+			       BT_GATT_PERM_NONE, NULL, NULL, NULL),
+	BT_GATT_CCC(NULL, BT_GATT_PERM_READ | BT_GATT_PERM_WRITE),
+);
+
+static uint8_t find_ccc(const struct bt_gatt_attr *attr, void *user_data)
+{
+	uint16_t *handle = user_data;
+
+	if (attr->user_data != test_svc.attrs[3].user_data) {
+		return BT_GATT_ITER_CONTINUE;
+	}
+
+	*handle = attr->handle;
+
+	return BT_GATT_ITER_STOP;
+}
+
+static uint16_t ccc_handle(void)
+{
+	uint16_t handle = 0U;
+
+	bt_gatt_foreach_attr(0x0001, 0xffff, find_ccc, &handle);
+	zassert_not_equal(handle, 0U, "CCC not found");
+
+	return handle;
+}
+
+static uint16_t peer_ccc_value(void)
+{
+	struct _bt_gatt_ccc *ccc = test_svc.attrs[3].user_data;
+
+	for (size_t i = 0; i < ARRAY_SIZE(ccc->cfg); i++) {
+		if (ccc->cfg[i].id == BT_ID_DEFAULT &&
+		    !bt_addr_le_cmp(&ccc->cfg[i].peer, &peer)) {
+			return ccc->cfg[i].value;
+		}
+	}
+
+	return 0;
+}
+
+static void store_legacy(void)
+{
+	struct {
+		uint16_t handle;
+		uint16_t value;
+	} ccc = { ccc_handle(), BT_GATT_CCC_NOTIFY };
+	uint16_t sc[2] = { 0x0010, 0x0020 };
+	uint8_t cf = BIT(0);
+
+	zassert_false(settings_save_one(CCC_KEY, &ccc, sizeof(ccc)),
+		      "Failed to store CCC");
+	zassert_false(settings_save_one(SC_KEY, sc, sizeof(sc)),
+		      "Failed to store SC");
+	zassert_false(settings_save_one(CF_KEY, &cf, sizeof(cf)),
+		      "Failed to store CF");
+}
+
+static void assert_no_legacy(void)
+{
+	uint8_t buf[8];
+
+	zassert_equal(settings_ram_get(CCC_KEY, buf, sizeof(buf)), -ENOENT,
+		      "CCC item not deleted");
+	zassert_equal(settings_ram_get(SC_KEY, buf, sizeof(buf)), -ENOENT,
+		      "SC item not deleted");
+	zassert_equal(settings_ram_get(CF_KEY, buf, sizeof(buf)), -ENOENT,
+		      "CF item not deleted");
+}
+
+/* Items in the per-subsystem format are loaded, and replaced by a single
+ * item once the peer is stored.
+ */
+void test_gatt_settings_migrate(void)
+{
+	struct gatt_item item;
+
+	store_legacy();
+
+	zassert_false(settings_load_subtree("bt/ccc"), "Failed to load CCC");
+	zassert_false(settings_load_subtree("bt/sc"), "Failed to load SC");
+	zassert_false(settings_load_subtree("bt/cf"), "Failed to load CF");
+	zassert_equal(peer_ccc_value(), BT_GATT_CCC_NOTIFY,
+		      "CCC not restored");
+
+	zassert_false(bt_gatt_store_ccc(BT_ID_DEFAULT, &peer),
+		      "Failed to store peer");
+
+	zassert_equal(settings_ram_get(GATT_KEY, &item, sizeof(item)),
+		      sizeof(item), "Wrong GATT item length");
+	zassert_equal(item.version, GATT_STORE_VERSION, "Wrong version");
+	zassert_equal(item.flags, GATT_STORE_SC | GATT_STORE_CF,
+		      "Wrong flags");
+	zassert_equal(item.cf, BIT(0), "Wrong CF");
+	zassert_equal(item.sc_start, 0x0010, "Wrong SC start");
+	zassert_equal(item.sc_end, 0x0020, "Wrong SC end");
+	zassert_equal(item.ccc_handle, ccc_handle(), "Wrong CCC handle");
+	zassert_equal(item.ccc_value, BT_GATT_CCC_NOTIFY, "Wrong CCC value");
+
+	assert_no_legacy();
+}
+
+/* The single item is loaded back, and stored again as it was loaded */
+void test_gatt_settings_reload(void)
+{
+	struct gatt_item item, stored;
+
+	zassert_equal(settings_ram_get(GATT_KEY, &item, sizeof(item)),
+		      sizeof(item), "Wrong GATT item length");
+
+	/* Different values than the ones in memory */
+	item.cf = 0U;
+	item.sc_start = 0x0030;
+	item.sc_end = 0x0040;
+	item.ccc_value = BT_GATT_CCC_INDICATE;
+	zassert_false(settings_save_one(GATT_KEY, &item, sizeof(item)),
+		      "Failed to store GATT item");
+
+	zassert_false(settings_load_subtree("bt/gatt"),
+		      "Failed to load GATT item");
+	zassert_equal(peer_ccc_value(), BT_GATT_CCC_INDICATE,
+		      "CCC not restored");
+
+	zassert_false(bt_gatt_store_ccc(BT_ID_DEFAULT, &peer),
+		      "Failed to store peer");
+	zassert_equal(settings_ram_get(GATT_KEY, &stored, sizeof(stored)),
+		      sizeof(stored), "Wrong GATT item length");
+	zassert_mem_equal(&stored, &item, sizeof(item),
+			  "GATT item not restored");
+
+	assert_no_legacy();
+}
+
+/* Unpairing deletes the peer in both formats */
+void test_gatt_settings_unpair(void)
+{
+	struct gatt_item item;
+
+	store_legacy();
+
+	zassert_false(bt_unpair(BT_ID_DEFAULT, &peer), "Failed to unpair");
+
+	zassert_equal(settings_ram_get(GATT_KEY, &item, sizeof(item)),
+		      -ENOENT, "GATT item not deleted");
+	assert_no_legacy();
+	zassert_equal(peer_ccc_value(), 0, "CCC not cleared");
+}
+
+void test_main(void)
+{
+	zassert_false(settings_subsys_init(), "Failed to init settings");
+	bt_gatt_init();
+
+	ztest_test_suite(test_gatt_settings,
+			 ztest_unit_test(test_gatt_settings_migrate),
+			 ztest_unit_test(test_gatt_settings_reload),
+			 ztest_unit_test(test_gatt_settings_unpair));
+	ztest_run_test_suite(test_gatt_settings);
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <string.h>
+#include <settings/settings.h>
+#include "settings_ram.h"
+
+/* Settings backend keeping the items in RAM, so that the test can look at
+ * what was stored.
+ */
+#define RAM_ITEMS	16
+#define RAM_VAL_MAX	64
+
+struct ram_item {
+	char name[SETTINGS_MAX_NAME_LEN + 1];
+	uint8_t val[RAM_VAL_MAX];
+	size_t len;
+};
+
+static struct ram_item items[RAM_ITEMS];
+
+static struct ram_item *ram_find(const char *name)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(items); i++) {
+		if (items[i].len && !strcmp(items[i].name, name)) {
+			return &items[i];
+		}
+	}
+
+	return NULL;
+}
+
+static ssize_t ram_read(void *back_end, void *data, size_t len)
+{
+	struct ram_item *item = back_end;
+
+	len = MIN(len, item->len);
+	memcpy(data, item->val, len);
+
+	return len;
+}
+
+static int ram_load(struct settings_store *cs,
+		    const struct settings_load_arg *arg)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(items); i++) {
+		if (!items[i].len) {
+			continue;
+		}
+
+		(void)settings_call_set_handler(items[i].name, items[i].len,
+						ram_read, &items[i], arg);
+	}
+
+	return 0;
+}
+
+static int ram_save(struct settings_store *cs, const char *name,
+		    const char *value, size_t val_len)
+{
+	struct ram_item *item;
+
+	if (val_len > RAM_VAL_MAX || strlen(name) > SETTINGS_MAX_NAME_LEN) {
+		return -ENOMEM;
+	}
+
+	item = ram_find(name);
+
+	/* Zero length deletes the item */
+	if (!value || !val_len) {
+		if (item) {
+			item->len = 0;
+		}
+
+		return 0;
+	}
+
+	for (size_t i = 0; !item && i < ARRAY_SIZE(items); i++) {
+		if (!items[i].len) {
+			item = &items[i];
+		}
+	}
+
+	if (!item) {
+		return -ENOMEM;
+	}
+
+	strcpy(item->name, name);
+	memcpy(item->val, value, val_len);
+	item->len = val_len;
+
+	return 0;
+}
+
+static const struct settings_store_itf ram_itf = {
+	.csi_load = ram_load,
+	.csi_save = ram_save,
+};
+
+static struct settings_store ram_store = {
+	.cs_itf = &ram_itf,
+};
+
+ssize_t settings_ram_get(const char *name, void *buf, size_t size)
+{
+	struct ram_item *item = ram_find(name);
+
+	if (!item) {
+		return -ENOENT;
+	}
+
+	return ram_read(item, buf, size);
+}
+
+int settings_backend_init(void)
+{
+	settings_src_register(&ram_store);
+	settings_dst_register(&ram_store);
+
+	return 0;
+}
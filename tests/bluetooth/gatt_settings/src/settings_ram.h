@@ -0,0 +1,15 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_TESTS_BLUETOOTH_GATT_SETTINGS_SRC_SETTINGS_RAM_H_
+#define ZEPHYR_TESTS_BLUETOOTH_GATT_SETTINGS_SRC_SETTINGS_RAM_H_
+
+#include <sys/types.h>
+
+/* Read an item of the RAM settings backend, -ENOENT if there is none */
+ssize_t settings_ram_get(const char *name, void *buf, size_t size);
+
+#endif /* ZEPHYR_TESTS_BLUETOOTH_GATT_SETTINGS_SRC_SETTINGS_RAM_H_ */
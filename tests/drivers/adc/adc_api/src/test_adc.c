@@ -538,6 +538,82 @@ void test_adc_repeated_samplings(void)
 	zassert_true(test_task_repeated_samplings() == TC_PASS, NULL);
 }
 
+/*
+ * test_adc_continuous_sampling
+ */
+#if defined(CONFIG_ADC_CONTINUOUS)
+#define CONTINUOUS_BLOCK_LEN	64
+#define CONTINUOUS_BLOCKS	10
+/* The STM32 ADC converts back to back, the SAADC uses its sample timer */
+#if defined(CONFIG_ADC_STM32)
+#define CONTINUOUS_INTERVAL_US	0
+#else
+#define CONTINUOUS_INTERVAL_US	20
+#endif
+
+static int16_t m_continuous_buffer[2 * CONTINUOUS_BLOCK_LEN];
+static uint8_t m_blocks_done;
+
+static enum adc_action continuous_block_callback(
+				struct device *dev,
+				const struct adc_sequence *sequence,
+				const void *block, size_t size)
+{
+	int16_t *expected = &m_continuous_buffer[(m_blocks_done % 2) *
+						 CONTINUOUS_BLOCK_LEN];
+
+	zassert_equal_ptr(block, expected, "unexpected block");
+	zassert_equal(size, sizeof(m_continuous_buffer) / 2,
+		      "unexpected block size %u", size);
+
+	if (++m_blocks_done < CONTINUOUS_BLOCKS) {
+		return ADC_ACTION_CONTINUE;
+	}
+
+	return ADC_ACTION_FINISH;
+}
+
+static int test_task_continuous_sampling(void)
+{
+	int ret;
+	const struct adc_sequence_options options = {
+		.interval_us    = CONTINUOUS_INTERVAL_US,
+		.block_callback = continuous_block_callback,
+	};
+	const struct adc_sequence sequence = {
+		.options     = &options,
+		.channels    = BIT(ADC_1ST_CHANNEL_ID),
+		.buffer      = m_continuous_buffer,
+		.buffer_size = sizeof(m_continuous_buffer),
+		.resolution  = ADC_RESOLUTION,
+	};
+
+	struct device *adc_dev = init_adc();
+
+	if (!adc_dev) {
+		return TC_FAIL;
+	}
+
+	m_blocks_done = 0U;
+
+	ret = adc_read(adc_dev, &sequence);
+	zassert_equal(ret, 0, "adc_read() failed with code %d", ret);
+	zassert_equal(m_blocks_done, CONTINUOUS_BLOCKS,
+		      "%u blocks done", m_blocks_done);
+
+	return TC_PASS;
+}
+#endif /* defined(CONFIG_ADC_CONTINUOUS) */
+
+void test_adc_continuous_sampling(void)
+{
+#if defined(CONFIG_ADC_CONTINUOUS)
+	zassert_true(test_task_continuous_sampling() == TC_PASS, NULL);
+#else
+	ztest_test_skip();
+#endif /* defined(CONFIG_ADC_CONTINUOUS) */
+}
+
 /*
  * test_adc_invalid_request
  */
@@ -12,12 +12,14 @@ extern void test_dma_m2m_chan0_burst8(void);
 extern void test_dma_m2m_chan1_burst8(void);
 extern void test_dma_m2m_chan0_burst16(void);
 extern void test_dma_m2m_chan1_burst16(void);
+extern void test_dma_m2m_chan0_chained(void);
 
 #ifdef CONFIG_SHELL
 TC_CMD_DEFINE(test_dma_m2m_chan0_burst8)
 TC_CMD_DEFINE(test_dma_m2m_chan1_burst8)
 TC_CMD_DEFINE(test_dma_m2m_chan0_burst16)
 TC_CMD_DEFINE(test_dma_m2m_chan1_burst16)
+TC_CMD_DEFINE(test_dma_m2m_chan0_chained)
 
 SHELL_CMD_REGISTER(test_dma_m2m_chan0_burst8, NULL, NULL,
 			TC_CMD_ITEM(test_dma_m2m_chan0_burst8));
@@ -27,6 +29,8 @@ SHELL_CMD_REGISTER(test_dma_m2m_chan0_burst16, NULL, NULL,
 			TC_CMD_ITEM(test_dma_m2m_chan0_burst16));
 SHELL_CMD_REGISTER(test_dma_m2m_chan1_burst16, NULL, NULL,
 			TC_CMD_ITEM(test_dma_m2m_chan1_burst16));
+SHELL_CMD_REGISTER(test_dma_m2m_chan0_chained, NULL, NULL,
+			TC_CMD_ITEM(test_dma_m2m_chan0_chained));
 #endif
 
 void test_main(void)
@@ -36,7 +40,8 @@ void test_main(void)
 			 ztest_unit_test(test_dma_m2m_chan0_burst8),
 			 ztest_unit_test(test_dma_m2m_chan1_burst8),
 			 ztest_unit_test(test_dma_m2m_chan0_burst16),
-			 ztest_unit_test(test_dma_m2m_chan1_burst16));
+			 ztest_unit_test(test_dma_m2m_chan1_burst16),
+			 ztest_unit_test(test_dma_m2m_chan0_chained));
 	ztest_run_test_suite(dma_m2m_test);
 #endif
 }
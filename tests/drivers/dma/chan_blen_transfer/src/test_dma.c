@@ -98,6 +98,90 @@ static int test_task(uint32_t chan_id, uint32_t blen)
 	return TC_PASS;
 }
 
+#if defined(CONFIG_DMA_STM32) || defined(CONFIG_DMA_SAM_XDMAC) || \
+	defined(CONFIG_DMA_MCUX_EDMA)
+#define DMA_CHAINED_SUPPORTED 1
+#endif
+
+static volatile int blocks_done;
+static volatile int transfers_done;
+
+static void test_chained_done(struct device *dma_dev, void *arg,
+			      uint32_t id, int status)
+{
+	if (status == DMA_STATUS_BLOCK) {
+		blocks_done++;
+	} else if (status == DMA_STATUS_COMPLETE) {
+		transfers_done++;
+	} else {
+		TC_PRINT("DMA transfer met an error\n");
+	}
+}
+
+/* Transfer the two halves of tx_data as two chained blocks */
+static int test_chained_task(uint32_t chan_id)
+{
+	struct dma_config dma_cfg = { 0 };
+	struct dma_block_config dma_block_cfg[2] = { 0 };
+	struct device *dma = device_get_binding(DMA_DEVICE_NAME);
+	size_t half = sizeof(tx_data) / 2;
+
+	if (!dma) {
+		TC_PRINT("Cannot get dma controller\n");
+		return TC_FAIL;
+	}
+
+#ifdef CONFIG_NOCACHE_MEMORY
+	memcpy(tx_data, TX_DATA, sizeof(TX_DATA));
+#endif
+
+	dma_cfg.channel_direction = MEMORY_TO_MEMORY;
+	dma_cfg.source_data_size = 1U;
+	dma_cfg.dest_data_size = 1U;
+	dma_cfg.source_burst_length = 1U;
+	dma_cfg.dest_burst_length = 1U;
+	dma_cfg.dma_callback = test_chained_done;
+	dma_cfg.complete_callback_en = 1U;
+	dma_cfg.error_callback_en = 1U;
+	dma_cfg.block_count = 2U;
+	dma_cfg.head_block = &dma_block_cfg[0];
+#ifdef CONFIG_DMA_MCUX_TEST_SLOT_START
+	dma_cfg.dma_slot = CONFIG_DMA_MCUX_TEST_SLOT_START;
+#endif
+
+	(void)memset(rx_data, 0, sizeof(rx_data));
+	dma_block_cfg[0].block_size = half;
+	dma_block_cfg[0].source_address = (uint32_t)tx_data;
+	dma_block_cfg[0].dest_address = (uint32_t)rx_data;
+	dma_block_cfg[0].next_block = &dma_block_cfg[1];
+	dma_block_cfg[1].block_size = sizeof(tx_data) - half;
+	dma_block_cfg[1].source_address = (uint32_t)tx_data + half;
+	dma_block_cfg[1].dest_address = (uint32_t)rx_data + half;
+
+	blocks_done = 0;
+	transfers_done = 0;
+
+	if (dma_config(dma, chan_id, &dma_cfg)) {
+		TC_PRINT("ERROR: transfer\n");
+		return TC_FAIL;
+	}
+
+	if (dma_start(dma, chan_id)) {
+		TC_PRINT("ERROR: transfer\n");
+		return TC_FAIL;
+	}
+	k_sleep(K_MSEC(2000));
+	TC_PRINT("%s\n", rx_data);
+	if ((blocks_done != 1) || (transfers_done != 1)) {
+		TC_PRINT("%d blocks, %d transfers done\n", blocks_done,
+			 transfers_done);
+		return TC_FAIL;
+	}
+	if (strcmp(tx_data, rx_data) != 0)
+		return TC_FAIL;
+	return TC_PASS;
+}
+
 /* export test cases */
 void test_dma_m2m_chan0_burst8(void)
 {
@@ -118,3 +202,12 @@ void test_dma_m2m_chan1_burst16(void)
 {
 	zassert_true((test_task(1, 16) == TC_PASS), NULL);
 }
+
+void test_dma_m2m_chan0_chained(void)
+{
+#ifdef DMA_CHAINED_SUPPORTED
+	zassert_true((test_chained_task(0) == TC_PASS), NULL);
+#else
+	ztest_test_skip();
+#endif
+}
@@ -125,11 +125,71 @@ static void test_read_unaligned_address(void)
 	}
 }
 
+#ifdef CONFIG_FLASH_PAGE_LAYOUT
+struct range_data {
+	off_t start;
+	off_t end;
+	size_t count;
+	struct flash_pages_info first;
+};
+
+static bool count_in_range_cb(const struct flash_pages_info *info,
+			      void *datav)
+{
+	struct range_data *data = datav;
+
+	if ((info->start_offset + info->size > data->start) &&
+	    (info->start_offset < data->end)) {
+		if (data->count++ == 0U) {
+			data->first = *info;
+		}
+	}
+
+	return true;
+}
+
+static void test_page_foreach_in_range(void)
+{
+	struct range_data all = {
+		.start = FLASH_TEST_REGION_OFFSET + 1,
+		.end = FLASH_TEST_REGION_OFFSET + 2 * page_info.size,
+	};
+	struct range_data range = all;
+	struct flash_pages_info info;
+
+	flash_page_foreach(flash_dev, count_in_range_cb, &all);
+	flash_page_foreach_in_range(flash_dev, range.start,
+				    range.end - range.start,
+				    count_in_range_cb, &range);
+
+	zassert_equal(range.count, all.count, "Wrong number of pages");
+	zassert_equal(range.first.start_offset, all.first.start_offset,
+		      "Wrong first page offset");
+	zassert_equal(range.first.index, all.first.index,
+		      "Wrong first page index");
+
+	zassert_equal(flash_get_page_info_by_idx(flash_dev, all.first.index,
+						 &info), 0,
+		      "Cannot get page info");
+	zassert_equal(info.start_offset, all.first.start_offset,
+		      "Wrong page offset by index");
+	zassert_equal(flash_get_page_info_by_idx(flash_dev,
+				flash_get_page_count(flash_dev), &info),
+		      -EINVAL, "Page index out of range not rejected");
+}
+#else
+static void test_page_foreach_in_range(void)
+{
+	ztest_test_skip();
+}
+#endif
+
 void test_main(void)
 {
 	ztest_test_suite(flash_driver_test,
 		ztest_unit_test(test_setup),
-		ztest_unit_test(test_read_unaligned_address)
+		ztest_unit_test(test_read_unaligned_address),
+		ztest_unit_test(test_page_foreach_in_range)
 	);
 
 	ztest_run_test_suite(flash_driver_test);
@@ -6,6 +6,7 @@
 
 #include <ztest.h>
 #include <drivers/flash.h>
+#include <drivers/flash/flash_simulator.h>
 #include <device.h>
 
 /* configuration derived from DT */
@@ -306,6 +307,77 @@ static void test_get_erase_value(void)
 		      FLASH_SIMULATOR_ERASE_VALUE);
 }
 
+static void test_unit_stats(void)
+{
+	struct flash_simulator_unit_stats st;
+	uint32_t data[2] = {0};
+	size_t count;
+	int rc;
+
+	if (!IS_ENABLED(CONFIG_FLASH_SIMULATOR_UNIT_STATS)) {
+		ztest_test_skip();
+	}
+
+	count = flash_simulator_unit_count(flash_dev);
+	zassert_equal(count,
+		      FLASH_SIMULATOR_FLASH_SIZE / FLASH_SIMULATOR_ERASE_UNIT,
+		      "Unexpected number of units");
+
+	flash_simulator_unit_stats_reset(flash_dev);
+
+	rc = flash_erase(flash_dev, FLASH_SIMULATOR_BASE_OFFSET,
+			 FLASH_SIMULATOR_ERASE_UNIT * 2);
+	zassert_equal(0, rc, "flash_erase should succeed");
+
+	/* a write straddling the first two units */
+	rc = flash_write(flash_dev, FLASH_SIMULATOR_BASE_OFFSET +
+			 FLASH_SIMULATOR_ERASE_UNIT - 4, data, sizeof(data));
+	zassert_equal(0, rc, "flash_write should succeed");
+
+	for (int unit = 0; unit < 2; unit++) {
+		rc = flash_simulator_unit_stats_get(flash_dev, unit, &st);
+		zassert_equal(0, rc, "Getting the unit stats should succeed");
+		zassert_equal(st.erases, 1, "Unit %d erases %u", unit,
+			      st.erases);
+		zassert_equal(st.writes, 1, "Unit %d writes %u", unit,
+			      st.writes);
+		zassert_equal(st.bytes_written, 4, "Unit %d bytes %u", unit,
+			      st.bytes_written);
+	}
+
+	rc = flash_simulator_unit_stats_get(flash_dev, 2, &st);
+	zassert_equal(0, rc, "Getting the unit stats should succeed");
+	zassert_equal(st.erases + st.writes, 0, "Unit 2 should be unused");
+
+	rc = flash_simulator_unit_stats_get(flash_dev, count, &st);
+	zassert_equal(-EINVAL, rc, "Out of range unit should fail");
+}
+
+static void test_timing(void)
+{
+	struct flash_simulator_timing saved;
+	struct flash_simulator_timing t = {
+		.erase_us = 1000,
+		.erase_unit_us = 1000,
+	};
+	uint32_t start;
+	uint32_t us;
+	int rc;
+
+	flash_simulator_timing_get(flash_dev, &saved);
+	flash_simulator_timing_set(flash_dev, &t);
+
+	start = k_cycle_get_32();
+	rc = flash_erase(flash_dev, FLASH_SIMULATOR_BASE_OFFSET,
+			 FLASH_SIMULATOR_ERASE_UNIT * 2);
+	us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+	flash_simulator_timing_set(flash_dev, &saved);
+
+	zassert_equal(0, rc, "flash_erase should succeed");
+	zassert_true(us >= 3000, "Erase took %u us, expected 3000 us", us);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(flash_sim_api,
@@ -317,7 +389,9 @@ void test_main(void)
 			 ztest_unit_test(test_out_of_bounds),
 			 ztest_unit_test(test_align),
 			 ztest_unit_test(test_get_erase_value),
-			 ztest_unit_test(test_double_write));
+			 ztest_unit_test(test_double_write),
+			 ztest_unit_test(test_unit_stats),
+			 ztest_unit_test(test_timing));
 
 	ztest_run_test_suite(flash_sim_api);
 }
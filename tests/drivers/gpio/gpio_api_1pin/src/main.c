@@ -25,6 +25,7 @@ void test_main(void)
 		ztest_unit_test(test_gpio_port_set_clr_bits_raw),
 		ztest_unit_test(test_gpio_port_set_clr_bits),
 		ztest_unit_test(test_gpio_port_toggle),
+		ztest_unit_test(test_gpio_port_bitbang),
 		ztest_unit_test(test_gpio_int_edge_rising),
 		ztest_unit_test(test_gpio_int_edge_falling),
 		ztest_unit_test(test_gpio_int_edge_both),
@@ -44,6 +44,7 @@ void test_gpio_port_set_bits_clear_bits(void);
 void test_gpio_port_set_clr_bits_raw(void);
 void test_gpio_port_set_clr_bits(void);
 void test_gpio_port_toggle(void);
+void test_gpio_port_bitbang(void);
 
 void test_gpio_int_edge_rising(void);
 void test_gpio_int_edge_falling(void);
@@ -7,6 +7,7 @@
 
 #include <limits.h>
 #include <sys/util.h>
+#include <drivers/gpio/gpio_bitbang.h>
 #include "test_gpio_api.h"
 
 #define TEST_GPIO_PORT_VALUE_MAX         ((1LLU << GPIO_MAX_PINS_PER_PORT) - 1)
@@ -470,3 +471,46 @@ void test_gpio_port_set_clr_bits(void)
 		port_get_and_verify(port, BIT(TEST_PIN), val_expected, i);
 	}
 }
+
+void test_gpio_port_bitbang(void)
+{
+	struct gpio_bitbang bb;
+	struct device *port;
+	int ret;
+
+	port = device_get_binding(TEST_DEV);
+	zassert_not_null(port, "device " TEST_DEV " not found");
+
+	TC_PRINT("Running test on port=%s, pin=%d\n", TEST_DEV, TEST_PIN);
+
+	ret = gpio_pin_configure(port, TEST_PIN, GPIO_OUTPUT | GPIO_INPUT |
+				 GPIO_ACTIVE_LOW);
+	if (ret == -ENOTSUP) {
+		TC_PRINT("Simultaneous pin in/out mode is not supported.\n");
+		ztest_test_skip();
+		return;
+	}
+	zassert_equal(ret, 0, "Failed to configure the pin");
+
+	gpio_bitbang_init(&bb, port);
+
+	gpio_bitbang_set_bits(&bb, BIT(TEST_PIN));
+	k_busy_wait(TEST_GPIO_MAX_RISE_FALL_TIME_US);
+	port_get_raw_and_verify(port, BIT(TEST_PIN), 0, 0);
+	zassert_equal(gpio_bitbang_pin_get(&bb, TEST_PIN), 1,
+		      "Test point 0: invalid bit-bang get value");
+
+	gpio_bitbang_clear_bits(&bb, BIT(TEST_PIN));
+	k_busy_wait(TEST_GPIO_MAX_RISE_FALL_TIME_US);
+	port_get_raw_and_verify(port, BIT(TEST_PIN), BIT(TEST_PIN), 1);
+	zassert_equal(gpio_bitbang_pin_get(&bb, TEST_PIN), 0,
+		      "Test point 1: invalid bit-bang get value");
+
+	gpio_bitbang_set_masked(&bb, BIT(TEST_PIN), BIT(TEST_PIN));
+	k_busy_wait(TEST_GPIO_MAX_RISE_FALL_TIME_US);
+	port_get_raw_and_verify(port, BIT(TEST_PIN), 0, 2);
+
+	gpio_bitbang_pin_set(&bb, TEST_PIN, 0);
+	k_busy_wait(TEST_GPIO_MAX_RISE_FALL_TIME_US);
+	port_get_raw_and_verify(port, BIT(TEST_PIN), BIT(TEST_PIN), 3);
+}
@@ -127,6 +127,74 @@ static int test_burst_gy271(void)
 	return TC_PASS;
 }
 
+#ifdef CONFIG_I2C_ASYNC
+static int test_async_gy271(void)
+{
+	uint8_t cfg[] = { 0x01, 0x20, 0x02, 0x00 };
+	uint8_t reg = 0x03;
+	uint8_t datas[6];
+	struct i2c_msg cfg_msg = {
+		.buf = cfg,
+		.len = sizeof(cfg),
+		.flags = I2C_MSG_WRITE | I2C_MSG_STOP,
+	};
+	struct i2c_msg read_msgs[] = {
+		{
+			.buf = &reg,
+			.len = 1,
+			.flags = I2C_MSG_WRITE,
+		},
+		{
+			.buf = datas,
+			.len = sizeof(datas),
+			.flags = I2C_MSG_RESTART | I2C_MSG_READ | I2C_MSG_STOP,
+		},
+	};
+	struct k_poll_signal sig[2];
+	struct k_poll_event evt;
+	struct device *i2c_dev = device_get_binding(I2C_DEV_NAME);
+
+	if (!i2c_dev) {
+		TC_PRINT("Cannot get I2C device\n");
+		return TC_FAIL;
+	}
+
+	if (i2c_configure(i2c_dev, i2c_cfg)) {
+		TC_PRINT("I2C config failed\n");
+		return TC_FAIL;
+	}
+
+	(void)memset(datas, 0, sizeof(datas));
+
+	for (int i = 0; i < ARRAY_SIZE(sig); i++) {
+		k_poll_signal_init(&sig[i]);
+	}
+
+	/* The read is queued behind the configuration */
+	if (i2c_transfer_async(i2c_dev, &cfg_msg, 1, 0x1E, &sig[0]) ||
+	    i2c_transfer_async(i2c_dev, read_msgs, ARRAY_SIZE(read_msgs),
+			       0x1E, &sig[1])) {
+		TC_PRINT("Fail to start transfers to sensor GY271\n");
+		return TC_FAIL;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(sig); i++) {
+		k_poll_event_init(&evt, K_POLL_TYPE_SIGNAL,
+				  K_POLL_MODE_NOTIFY_ONLY, &sig[i]);
+		if (k_poll(&evt, 1, K_MSEC(100)) || sig[i].result) {
+			TC_PRINT("Transfer %d to sensor GY271 failed\n", i);
+			return TC_FAIL;
+		}
+	}
+
+	TC_PRINT("axis raw data: %d %d %d %d %d %d\n",
+				datas[0], datas[1], datas[2],
+				datas[3], datas[4], datas[5]);
+
+	return TC_PASS;
+}
+#endif
+
 void test_i2c_gy271(void)
 {
 	zassert_true(test_gy271() == TC_PASS, NULL);
@@ -136,3 +204,12 @@ void test_i2c_burst_gy271(void)
 {
 	zassert_true(test_burst_gy271() == TC_PASS, NULL);
 }
+
+void test_i2c_async_gy271(void)
+{
+#ifdef CONFIG_I2C_ASYNC
+	zassert_true(test_async_gy271() == TC_PASS, NULL);
+#else
+	ztest_test_skip();
+#endif
+}
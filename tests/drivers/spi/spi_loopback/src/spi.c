@@ -544,6 +544,80 @@ static int spi_async_call(struct device *dev, struct spi_config *spi_conf)
 }
 #endif
 
+#if defined(CONFIG_SPI_ASYNC_QUEUE)
+/* Queue two transactions at once, the second waits for the first */
+static int spi_async_queue(struct device *dev, struct spi_config *spi_conf)
+{
+	const struct spi_buf tx_bufs[] = {
+		{
+			.buf = buffer_tx,
+			.len = BUF_SIZE,
+		},
+		{
+			.buf = buffer2_tx,
+			.len = BUF2_SIZE,
+		},
+	};
+	const struct spi_buf rx_bufs[] = {
+		{
+			.buf = buffer_rx,
+			.len = BUF_SIZE,
+		},
+		{
+			.buf = buffer2_rx,
+			.len = BUF2_SIZE,
+		},
+	};
+	const struct spi_buf_set tx[] = {
+		{ .buffers = &tx_bufs[0], .count = 1 },
+		{ .buffers = &tx_bufs[1], .count = 1 },
+	};
+	const struct spi_buf_set rx[] = {
+		{ .buffers = &rx_bufs[0], .count = 1 },
+		{ .buffers = &rx_bufs[1], .count = 1 },
+	};
+	struct k_poll_signal sig[2];
+	struct k_poll_event evt[2];
+	int ret;
+
+	LOG_INF("Start queued async calls");
+
+	(void)memset(buffer_rx, 0, BUF_SIZE);
+	(void)memset(buffer2_rx, 0, BUF2_SIZE);
+
+	for (int i = 0; i < 2; i++) {
+		k_poll_signal_init(&sig[i]);
+		k_poll_event_init(&evt[i], K_POLL_TYPE_SIGNAL,
+				  K_POLL_MODE_NOTIFY_ONLY, &sig[i]);
+
+		ret = spi_transceive_async(dev, spi_conf, &tx[i], &rx[i],
+					   &sig[i]);
+		if (ret) {
+			LOG_ERR("Code %d", ret);
+			zassert_false(ret, "SPI transceive failed");
+			return -1;
+		}
+	}
+
+	for (int i = 0; i < 2; i++) {
+		ret = k_poll(&evt[i], 1, K_MSEC(200));
+		zassert_false(ret, "transaction %d not done", i);
+		zassert_false(sig[i].result, "transaction %d failed", i);
+	}
+
+	if (memcmp(buffer_tx, buffer_rx, BUF_SIZE) ||
+	    memcmp(buffer2_tx, buffer2_rx, BUF2_SIZE)) {
+		LOG_ERR("Buffer contents are different");
+		zassert_false(1, "Buffer contents are different");
+		return -1;
+	}
+
+	LOG_INF("Passed");
+
+	return 0;
+}
+#endif
+
 static int spi_resource_lock_test(struct device *lock_dev,
 				  struct spi_config *spi_conf_lock,
 				  struct device *try_dev,
@@ -612,6 +686,9 @@ void test_spi_loopback(void)
 	    spi_rx_every_4(spi_slow, &spi_cfg_slow)
 #if (CONFIG_SPI_ASYNC)
 	    || spi_async_call(spi_slow, &spi_cfg_slow)
+#endif
+#if defined(CONFIG_SPI_ASYNC_QUEUE)
+	    || spi_async_queue(spi_slow, &spi_cfg_slow)
 #endif
 	    ) {
 		goto end;
@@ -627,6 +704,9 @@ void test_spi_loopback(void)
 	    spi_rx_every_4(spi_fast, &spi_cfg_fast)
 #if (CONFIG_SPI_ASYNC)
 	    || spi_async_call(spi_fast, &spi_cfg_fast)
+#endif
+#if defined(CONFIG_SPI_ASYNC_QUEUE)
+	    || spi_async_queue(spi_fast, &spi_cfg_fast)
 #endif
 	    ) {
 		goto end;
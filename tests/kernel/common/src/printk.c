@@ -152,6 +152,111 @@ void test_printk(void)
 	pk_console[count] = '\0';
 	zassert_true((strcmp(pk_console, expected) == 0), "snprintk failed");
 }
+
+#ifdef CONFIG_PRINTK_PACKAGE
+static int package_snprintk(char *str, size_t size, const char *fmt, ...)
+{
+	uint8_t pkg[128];
+	va_list ap;
+	int ret;
+
+	va_start(ap, fmt);
+	ret = printk_vpackage(pkg, sizeof(pkg), fmt, ap);
+	va_end(ap);
+	zassert_true(ret > 0, "packaging \"%s\" failed", fmt);
+
+	return snprintk_package(str, size, pkg);
+}
+
+/**
+ * @brief Test packaged printk formatting
+ *
+ * @details Package the same messages as test_printk() and check they
+ * render identically, that strings outside read-only memory are copied
+ * into the package and that a package may be moved.
+ *
+ * @see printk_package(), printk_vpackage(), snprintk_package()
+ */
+void test_printk_package(void)
+{
+	uint8_t pkg[64];
+	uint8_t moved[sizeof(pkg) + 1];
+	char ram_str[8];
+	char out[32];
+	int count;
+	int len;
+
+	(void)memset(pk_console, 0, sizeof(pk_console));
+	count = 0;
+
+	count += package_snprintk(pk_console + count,
+				  sizeof(pk_console) - count,
+				  "%zu %hhu %hu %u %lu %llu\n",
+				  stv, uc, usi, ui, ul, ull);
+	count += package_snprintk(pk_console + count,
+				  sizeof(pk_console) - count,
+				  "%c %hhd %hd %d %ld %lld\n",
+				  c, c, ssi, si, sl, sll);
+	count += package_snprintk(pk_console + count,
+				  sizeof(pk_console) - count,
+				  "0x%x 0x%02x 0x%04x 0x%08x 0x%016x\n",
+				  1, 1, 1, 1, 1);
+	count += package_snprintk(pk_console + count,
+				  sizeof(pk_console) - count,
+				  "0x%x 0x%2x 0x%4x 0x%8x\n", 1, 1, 1, 1);
+	count += package_snprintk(pk_console + count,
+				  sizeof(pk_console) - count,
+				  "%d %02d %04d %08d\n", 42, 42, 42, 42);
+	count += package_snprintk(pk_console + count,
+				  sizeof(pk_console) - count,
+				  "%d %02d %04d %08d\n", -42, -42, -42, -42);
+	count += package_snprintk(pk_console + count,
+				  sizeof(pk_console) - count,
+				  "%u %2u %4u %8u\n", 42, 42, 42, 42);
+	count += package_snprintk(pk_console + count,
+				  sizeof(pk_console) - count,
+				  "%u %02u %04u %08u\n", 42, 42, 42, 42);
+	count += package_snprintk(pk_console + count,
+				  sizeof(pk_console) - count,
+				  "%-8u%-6d%-4x  %8d\n", 0xFF, 42, 0xABCDEF, 42);
+	count += package_snprintk(pk_console + count,
+				  sizeof(pk_console) - count,
+				  "%lld %lld %llu %llx\n",
+				  0xFFFFFFFFFULL, -1LL, -1ULL, -1ULL);
+	pk_console[count] = '\0';
+	zassert_true((strcmp(pk_console, expected) == 0),
+		     "packaged printk failed");
+
+	(void)package_snprintk(pk_console, sizeof(pk_console),
+			       "0x%x %p %-2p\n", hex, ptr, (char *)42);
+	zassert_true((strcmp(pk_console, expected2) == 0),
+		     "packaged printk failed");
+
+	/* Strings in RAM are captured when packaging */
+	strcpy(ram_str, "ram");
+	len = printk_package(pkg, sizeof(pkg), "%s %s %c", "rodata", ram_str,
+			     '!');
+	zassert_true(len > 0, "packaging failed");
+	zassert_equal(printk_package_len(pkg), len, "wrong package length");
+	zassert_equal(printk_package(NULL, 0, "%s %s %c", "rodata", ram_str,
+				     '!'), len, "wrong package size");
+	strcpy(ram_str, "xyz");
+
+	/* Packages have no alignment requirement and may be moved */
+	(void)memcpy(&moved[1], pkg, len);
+	(void)memset(pkg, 0, sizeof(pkg));
+	(void)snprintk_package(out, sizeof(out), &moved[1]);
+	zassert_true(strcmp(out, "rodata ram !") == 0, "got \"%s\"", out);
+
+	zassert_equal(printk_package(pkg, 4, "%d", 1), -ENOSPC,
+		      "package should not fit");
+}
+#else
+void test_printk_package(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_PRINTK_PACKAGE */
 /**
  * @}
  */
@@ -23,6 +23,7 @@ extern void test_mmio_multiple(void);
 extern void test_mmio_toplevel(void);
 extern void test_mmio_single(void);
 extern void test_mmio_device_map(void);
+extern void test_device_init_async(void);
 
 /**
  * @brief Test cases to verify device objects
@@ -386,6 +387,7 @@ void test_main(void)
 			 ztest_user_unit_test(test_dynamic_name),
 			 ztest_unit_test(test_device_init_level),
 			 ztest_unit_test(test_device_init_priority),
+			 ztest_unit_test(test_device_init_async),
 			 ztest_unit_test(test_abstraction_driver_common),
 			 ztest_unit_test(test_mmio_single),
 			 ztest_unit_test(test_mmio_multiple),
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <device.h>
+#include <init.h>
+#include <ztest.h>
+
+#define ASYNC_DRIVER_A		"async_driver_a"
+#define ASYNC_DRIVER_B		"async_driver_b"
+#define ASYNC_DRIVER_BAD	"async_driver_bad"
+
+#define ASYNC_INIT_MS		20
+
+static const struct {
+	int dummy;
+} async_api;
+
+static volatile bool a_done, b_done;
+static volatile bool b_saw_a, sync_saw_a, sync_saw_b;
+static volatile int sync_wait_b, sync_wait_bad;
+
+DEVICE_DECLARE(async_a);
+DEVICE_DECLARE(async_b);
+DEVICE_DECLARE(async_bad);
+
+static int async_a_init(struct device *dev)
+{
+	k_sleep(K_MSEC(ASYNC_INIT_MS));
+	a_done = true;
+
+	return 0;
+}
+
+static int async_b_init(struct device *dev)
+{
+	b_saw_a = (device_init_wait(DEVICE_GET(async_a)) == 0) && a_done;
+	k_sleep(K_MSEC(ASYNC_INIT_MS));
+	b_done = true;
+
+	return 0;
+}
+
+static int async_bad_init(struct device *dev)
+{
+	return -EIO;
+}
+
+/* Runs in order after all of the above have been started */
+static int sync_init(struct device *dev)
+{
+	sync_saw_a = a_done;
+	sync_wait_b = device_init_wait(DEVICE_GET(async_b));
+	sync_saw_b = b_done;
+	sync_wait_bad = device_init_wait(DEVICE_GET(async_bad));
+
+	return 0;
+}
+
+DEVICE_AND_API_INIT_ASYNC(async_a, ASYNC_DRIVER_A, async_a_init,
+			  NULL, NULL, POST_KERNEL, 60, &async_api);
+DEVICE_AND_API_INIT_ASYNC(async_b, ASYNC_DRIVER_B, async_b_init,
+			  NULL, NULL, POST_KERNEL, 61, &async_api);
+DEVICE_AND_API_INIT_ASYNC(async_bad, ASYNC_DRIVER_BAD, async_bad_init,
+			  NULL, NULL, POST_KERNEL, 62, &async_api);
+SYS_INIT(sync_init, POST_KERNEL, 63);
+
+/**
+ * @brief Test parallel initialization of devices
+ *
+ * @details Two asynchronous devices sleep during initialization, the
+ * second one waiting for the first with device_init_wait().  A regular
+ * init entry of the same level waits for the second device.  With
+ * CONFIG_INIT_PARALLEL the regular entry runs while the first device is
+ * still initializing; in every configuration the declared dependencies
+ * are honored and failed initialization is reported.
+ *
+ * @ingroup kernel_device_tests
+ *
+ * @see DEVICE_AND_API_INIT_ASYNC(), device_init_wait()
+ */
+void test_device_init_async(void)
+{
+	zassert_true(b_saw_a, "dependency not initialized first");
+	zassert_equal(sync_wait_b, 0, "waiting for device failed");
+	zassert_true(sync_saw_b, "device not initialized after wait");
+	zassert_equal(sync_wait_bad, -ENODEV, "failed init not reported");
+
+	if (IS_ENABLED(CONFIG_INIT_PARALLEL)) {
+		zassert_false(sync_saw_a, "init entries did not overlap");
+	} else {
+		zassert_true(sync_saw_a, "init entries out of order");
+	}
+
+	zassert_not_null(device_get_binding(ASYNC_DRIVER_A), NULL);
+	zassert_not_null(device_get_binding(ASYNC_DRIVER_B), NULL);
+	zassert_is_null(device_get_binding(ASYNC_DRIVER_BAD), NULL);
+	zassert_equal(device_init_wait(DEVICE_GET(async_a)), 0, NULL);
+}
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <irq_offload.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define WAIT_TIMEOUT K_MSEC(100)
+
+#define EV_A BIT(0)
+#define EV_B BIT(1)
+#define EV_C BIT(2)
+
+K_EVENT_DEFINE(test_event);
+static struct k_event init_event;
+
+static K_THREAD_STACK_ARRAY_DEFINE(tstack, 2, STACK_SIZE);
+static struct k_thread tdata[2];
+static volatile uint32_t woken_events[2];
+
+static void post_task(void *p1, void *p2, void *p3)
+{
+	k_sleep(K_MSEC(10));
+	k_event_post(&test_event, POINTER_TO_UINT(p1));
+}
+
+static void wait_task(void *p1, void *p2, void *p3)
+{
+	int idx = POINTER_TO_INT(p1);
+
+	woken_events[idx] = k_event_wait(&test_event, POINTER_TO_UINT(p2),
+					 K_EVENT_WAIT_CLEAR, K_FOREVER);
+}
+
+static void isr_post(void *events)
+{
+	k_event_post(&test_event, POINTER_TO_UINT(events));
+}
+
+static void isr_wait(void *events)
+{
+	woken_events[0] = k_event_wait(&test_event, POINTER_TO_UINT(events),
+				       K_EVENT_WAIT_ANY, K_NO_WAIT);
+}
+
+/**
+ * @brief Test initialization and direct update of the events
+ *
+ * @see k_event_init(), k_event_set(), k_event_clear(), k_event_get()
+ */
+void test_event_init_set_clear(void)
+{
+	k_event_init(&init_event);
+	zassert_equal(k_event_get(&init_event), 0U, NULL);
+
+	k_event_set(&init_event, EV_A | EV_B);
+	zassert_equal(k_event_get(&init_event), EV_A | EV_B, NULL);
+
+	k_event_set(&init_event, EV_C);
+	zassert_equal(k_event_get(&init_event), EV_C, NULL);
+
+	k_event_post(&init_event, EV_A);
+	zassert_equal(k_event_get(&init_event), EV_A | EV_C, NULL);
+
+	k_event_clear(&init_event, EV_C);
+	zassert_equal(k_event_get(&init_event), EV_A, NULL);
+}
+
+/**
+ * @brief Test waiting for any of several events
+ *
+ * @see k_event_post(), k_event_wait()
+ */
+void test_event_wait_any(void)
+{
+	k_event_set(&test_event, 0U);
+
+	zassert_equal(k_event_wait(&test_event, EV_A | EV_B,
+				   K_EVENT_WAIT_ANY, K_NO_WAIT), 0U, NULL);
+
+	k_event_post(&test_event, EV_B | EV_C);
+	zassert_equal(k_event_wait(&test_event, EV_A | EV_B,
+				   K_EVENT_WAIT_ANY, K_NO_WAIT), EV_B, NULL);
+
+	/* Not consumed without K_EVENT_WAIT_CLEAR */
+	zassert_equal(k_event_get(&test_event), EV_B | EV_C, NULL);
+}
+
+/**
+ * @brief Test waiting for all of several events
+ *
+ * @see k_event_post(), k_event_wait()
+ */
+void test_event_wait_all(void)
+{
+	k_event_set(&test_event, EV_A);
+
+	zassert_equal(k_event_wait(&test_event, EV_A | EV_B,
+				   K_EVENT_WAIT_ALL, K_NO_WAIT), 0U, NULL);
+
+	k_event_post(&test_event, EV_B);
+	zassert_equal(k_event_wait(&test_event, EV_A | EV_B,
+				   K_EVENT_WAIT_ALL, K_NO_WAIT),
+		      EV_A | EV_B, NULL);
+}
+
+/**
+ * @brief Test clearing the events which satisfied a wait
+ *
+ * @see k_event_wait()
+ */
+void test_event_wait_clear(void)
+{
+	k_event_set(&test_event, EV_A | EV_C);
+
+	zassert_equal(k_event_wait(&test_event, EV_A | EV_B,
+				   K_EVENT_WAIT_CLEAR, K_NO_WAIT), EV_A, NULL);
+	zassert_equal(k_event_get(&test_event), EV_C, NULL);
+}
+
+/**
+ * @brief Test a wait timing out
+ *
+ * @see k_event_wait()
+ */
+void test_event_wait_timeout(void)
+{
+	int64_t start;
+
+	k_event_set(&test_event, 0U);
+
+	start = k_uptime_get();
+	zassert_equal(k_event_wait(&test_event, EV_A, K_EVENT_WAIT_ANY,
+				   WAIT_TIMEOUT), 0U, NULL);
+	zassert_true(k_uptime_get() - start >= 100, NULL);
+}
+
+/**
+ * @brief Test a thread waking up a thread waiting for all events
+ *
+ * @see k_event_post(), k_event_wait()
+ */
+void test_event_thread_post(void)
+{
+	k_event_set(&test_event, EV_A);
+
+	k_thread_create(&tdata[0], tstack[0], STACK_SIZE, post_task,
+			UINT_TO_POINTER(EV_B), NULL, NULL,
+			K_PRIO_PREEMPT(0), K_USER | K_INHERIT_PERMS,
+			K_NO_WAIT);
+
+	zassert_equal(k_event_wait(&test_event, EV_A | EV_B,
+				   K_EVENT_WAIT_ALL | K_EVENT_WAIT_CLEAR,
+				   K_FOREVER), EV_A | EV_B, NULL);
+	zassert_equal(k_event_get(&test_event), 0U, NULL);
+
+	k_thread_join(&tdata[0], K_FOREVER);
+}
+
+/**
+ * @brief Test posting and testing events from an ISR
+ *
+ * @see k_event_post(), k_event_wait()
+ */
+void test_event_isr(void)
+{
+	k_event_set(&test_event, 0U);
+
+	irq_offload(isr_post, UINT_TO_POINTER(EV_C));
+	zassert_equal(k_event_get(&test_event), EV_C, NULL);
+
+	irq_offload(isr_wait, UINT_TO_POINTER(EV_B | EV_C));
+	zassert_equal(woken_events[0], EV_C, NULL);
+}
+
+/**
+ * @brief Test that a post wakes up all the satisfied waiters
+ *
+ * Both threads consume the posted event, but both see it since they are
+ * woken up by the same post.
+ *
+ * @see k_event_post(), k_event_wait()
+ */
+void test_event_broadcast(void)
+{
+	k_event_set(&test_event, 0U);
+
+	for (int i = 0; i < 2; i++) {
+		woken_events[i] = 0U;
+		k_thread_create(&tdata[i], tstack[i], STACK_SIZE, wait_task,
+				INT_TO_POINTER(i), UINT_TO_POINTER(EV_A | EV_B),
+				NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	}
+
+	/* Let both threads wait */
+	k_sleep(K_MSEC(10));
+
+	k_event_post(&test_event, EV_B | EV_C);
+
+	for (int i = 0; i < 2; i++) {
+		k_thread_join(&tdata[i], K_FOREVER);
+		zassert_equal(woken_events[i], EV_B, NULL);
+	}
+
+	zassert_equal(k_event_get(&test_event), EV_C, NULL);
+}
+
+/**
+ * @brief Test polling an event object
+ *
+ * @see k_poll(), k_event_post()
+ */
+void test_event_poll(void)
+{
+	struct k_poll_event poll_event;
+
+	k_event_set(&test_event, 0U);
+
+	k_poll_event_init(&poll_event, K_POLL_TYPE_EVENTS_POSTED,
+			  K_POLL_MODE_NOTIFY_ONLY, &test_event);
+	zassert_equal(k_poll(&poll_event, 1, K_NO_WAIT), -EAGAIN, NULL);
+
+	k_thread_create(&tdata[0], tstack[0], STACK_SIZE, post_task,
+			UINT_TO_POINTER(EV_A), NULL, NULL,
+			K_PRIO_PREEMPT(0), K_USER | K_INHERIT_PERMS,
+			K_NO_WAIT);
+
+	poll_event.state = K_POLL_STATE_NOT_READY;
+	zassert_equal(k_poll(&poll_event, 1, K_FOREVER), 0, NULL);
+	zassert_equal(poll_event.state, K_POLL_STATE_EVENTS_POSTED, NULL);
+	zassert_equal(k_event_wait(&test_event, EV_A, K_EVENT_WAIT_CLEAR,
+				   K_NO_WAIT), EV_A, NULL);
+
+	k_thread_join(&tdata[0], K_FOREVER);
+}
+
+void test_main(void)
+{
+	k_thread_access_grant(k_current_get(), &test_event, &init_event,
+			      &tstack[0], &tdata[0]);
+
+	ztest_test_suite(event_api,
+			 ztest_user_unit_test(test_event_init_set_clear),
+			 ztest_user_unit_test(test_event_wait_any),
+			 ztest_user_unit_test(test_event_wait_all),
+			 ztest_user_unit_test(test_event_wait_clear),
+			 ztest_user_unit_test(test_event_wait_timeout),
+			 ztest_user_unit_test(test_event_thread_post),
+			 ztest_unit_test(test_event_isr),
+			 ztest_unit_test(test_event_broadcast),
+			 ztest_unit_test(test_event_poll));
+	ztest_run_test_suite(event_api);
+}
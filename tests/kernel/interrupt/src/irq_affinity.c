@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <irq.h>
+
+#ifdef CONFIG_ARCH_HAS_IRQ_AFFINITY
+
+#if defined(CONFIG_IOAPIC)
+#define TEST_IRQ	(CONFIG_IOAPIC_NUM_RTES - 1)
+#else
+#define TEST_IRQ	(CONFIG_NUM_IRQS - 1)
+#endif
+
+#define ALL_CPUS	BIT_MASK(CONFIG_MP_NUM_CPUS)
+
+/**
+ * @brief Test routing an IRQ line to a set of CPUs
+ *
+ * @ingroup kernel_interrupt_tests
+ *
+ * Validates irq_set_affinity() rejects an empty mask and CPUs which don't
+ * exist, and accepts each single CPU and all the CPUs.
+ */
+void test_irq_affinity(void)
+{
+	int ret;
+
+	zassert_equal(irq_set_affinity(TEST_IRQ, 0), -EINVAL,
+		      "empty CPU mask accepted");
+	zassert_equal(irq_set_affinity(TEST_IRQ, BIT(CONFIG_MP_NUM_CPUS)),
+		      -EINVAL, "mask of a missing CPU accepted");
+
+	ret = irq_set_affinity(TEST_IRQ, ALL_CPUS);
+	if (ret == -ENOTSUP) {
+		ztest_test_skip();
+	}
+	zassert_equal(ret, 0, "routing to all CPUs failed (%d)", ret);
+
+	for (int cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+		zassert_equal(irq_set_affinity(TEST_IRQ, BIT(cpu)), 0,
+			      "routing to CPU %d failed", cpu);
+	}
+
+	zassert_equal(irq_set_affinity(TEST_IRQ, ALL_CPUS), 0,
+		      "routing back to all CPUs failed");
+}
+
+#else
+
+void test_irq_affinity(void)
+{
+	ztest_test_skip();
+}
+
+#endif /* CONFIG_ARCH_HAS_IRQ_AFFINITY */
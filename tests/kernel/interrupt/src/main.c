@@ -9,13 +9,15 @@
 extern void test_isr_dynamic(void);
 extern void test_nested_isr(void);
 extern void test_prevent_interruption(void);
+extern void test_irq_affinity(void);
 
 void test_main(void)
 {
 	ztest_test_suite(interrupt_feature,
 			ztest_unit_test(test_isr_dynamic),
 			ztest_unit_test(test_nested_isr),
-			ztest_unit_test(test_prevent_interruption)
+			ztest_unit_test(test_prevent_interruption),
+			ztest_unit_test(test_irq_affinity)
 			);
 	ztest_run_test_suite(interrupt_feature);
 }
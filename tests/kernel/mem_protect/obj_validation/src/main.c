@@ -112,10 +112,58 @@ void test_generic_object(void)
 	}
 }
 
+/**
+ * @brief Test object validation from a system call context
+ *
+ * @details
+ * - Validate a dynamic object repeatedly as a user mode system call
+ *   would, which fills the thread's lookup cache when
+ *   CONFIG_USERSPACE_OBJ_CACHE is enabled.
+ * - Revoking the calling thread's access must be honored right away.
+ * - Freeing the object must make later lookups fail.
+ *
+ * @ingroup kernel_memprotect_tests
+ *
+ * @see k_object_access_revoke(), k_object_free()
+ */
+void test_syscall_object_lookup(void)
+{
+	struct k_sem *sem;
+	void *frame = _current->syscall_frame;
+	static char fake_frame;
+
+	sem = k_object_alloc(K_OBJ_SEM);
+	zassert_not_null(sem, "couldn't allocate semaphore");
+	k_sem_init(sem, 0, 1);
+	/* Keep the object alive once our own access is revoked */
+	k_object_access_grant(sem, &z_main_thread);
+
+	/* Pretend we are servicing a system call from user mode */
+	_current->syscall_frame = &fake_frame;
+
+	for (int i = 0; i < 4; i++) {
+		zassert_false(test_object(sem, 0), NULL);
+		zassert_false(test_object((struct k_sem *)&bad_sem, -EBADF),
+			      NULL);
+	}
+
+	k_object_access_revoke(sem, k_current_get());
+	zassert_false(test_object(sem, -EPERM), "revoked access still valid");
+
+	k_object_access_grant(sem, k_current_get());
+	zassert_false(test_object(sem, 0), NULL);
+
+	k_object_free(sem);
+	zassert_false(test_object(sem, -EBADF), "freed object still valid");
+
+	_current->syscall_frame = frame;
+}
+
 void test_main(void)
 {
 	k_thread_system_pool_assign(k_current_get());
 	ztest_test_suite(object_validation,
-			 ztest_unit_test(test_generic_object));
+			 ztest_unit_test(test_generic_object),
+			 ztest_unit_test(test_syscall_object_lookup));
 	ztest_run_test_suite(object_validation);
 }
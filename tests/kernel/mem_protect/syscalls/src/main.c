@@ -377,6 +377,47 @@ void test_syscall_context(void)
 	k_thread_user_mode_enter(test_syscall_context_user, NULL, NULL, NULL);
 }
 
+/**
+ * @brief Test running system calls as a batch
+ *
+ * @details Queue calls taking no argument, a pointer and a split 64-bit
+ * argument, submit them and check the return values match the direct
+ * calls. From a supervisor thread the calls run as they are queued.
+ *
+ * @ingroup kernel_memprotect_tests
+ *
+ * @see k_syscall_batch_submit()
+ */
+void test_syscall_batch(void)
+{
+#ifdef CONFIG_SYSCALL_BATCH
+	struct k_syscall_batch_entry entries[3];
+	struct k_syscall_batch batch;
+	int copy, arg64, context;
+
+	k_syscall_batch_init(&batch, entries, ARRAY_SIZE(entries));
+
+	copy = K_SYSCALL_BATCH(&batch, string_copy,
+			       "this is a kernel string");
+	arg64 = K_SYSCALL_BATCH(&batch, syscall_arg64, 54321);
+	context = K_SYSCALL_BATCH(&batch, syscall_context);
+	zassert_equal(K_SYSCALL_BATCH(&batch, syscall_context), -ENOMEM,
+		      "queued more calls than the batch holds");
+
+	zassert_equal(k_syscall_batch_submit(&batch), 0, NULL);
+
+	zassert_equal((int)k_syscall_batch_ret(&batch, copy), 0,
+		      "string should have matched");
+	zassert_equal((int)k_syscall_batch_ret(&batch, arg64),
+		      z_impl_syscall_arg64(54321),
+		      "syscall didn't match impl");
+	zassert_equal((bool)k_syscall_batch_ret(&batch, context),
+		      _is_user_context(), "wrong syscall context");
+#else
+	ztest_test_skip();
+#endif
+}
+
 K_MEM_POOL_DEFINE(test_pool, BUF_SIZE, BUF_SIZE, 4 * NR_THREADS, 4);
 
 void test_main(void)
@@ -393,7 +434,9 @@ void test_main(void)
 			 ztest_user_unit_test(test_user_string_alloc_copy),
 			 ztest_user_unit_test(test_arg64),
 			 ztest_unit_test(test_syscall_torture),
-			 ztest_unit_test(test_syscall_context)
+			 ztest_unit_test(test_syscall_context),
+			 ztest_unit_test(test_syscall_batch),
+			 ztest_user_unit_test(test_syscall_batch)
 			 );
 	ztest_run_test_suite(syscalls);
 }
@@ -224,3 +224,36 @@ void test_mslab_used_get(void)
 	tmslab_used_get(&mslab);
 	tmslab_used_get(&kmslab);
 }
+
+/**
+ * @brief Verify batch allocation and release of memory blocks
+ *
+ * @details Request more blocks than the slab holds with
+ * k_mem_slab_alloc_batch() and check that exactly all of them are
+ * returned, that the slab is then exhausted, and that
+ * k_mem_slab_free_batch() makes every block available again.
+ *
+ * @ingroup kernel_memory_slab_tests
+ */
+void test_mslab_batch(void)
+{
+	void *block[BLK_NUM + 1], *block_fail;
+
+	zassert_equal(k_mem_slab_alloc_batch(&kmslab, block, BLK_NUM + 1),
+		      BLK_NUM, NULL);
+	for (int i = 0; i < BLK_NUM; i++) {
+		zassert_not_null(block[i], NULL);
+		for (int j = 0; j < i; j++) {
+			zassert_not_equal(block[i], block[j], NULL);
+		}
+	}
+	zassert_equal(k_mem_slab_num_used_get(&kmslab), BLK_NUM, NULL);
+	zassert_equal(k_mem_slab_alloc(&kmslab, &block_fail, K_NO_WAIT),
+		      -ENOMEM, NULL);
+
+	k_mem_slab_free_batch(&kmslab, block, BLK_NUM);
+	zassert_equal(k_mem_slab_num_free_get(&kmslab), BLK_NUM, NULL);
+
+	/* everything freed can be allocated again */
+	tmslab_alloc_free(&kmslab);
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#define CLAIM_LEN 4
+
+K_THREAD_STACK_EXTERN(tstack);
+extern struct k_thread tdata;
+static char __aligned(4) cbuffer[MSG_SIZE * CLAIM_LEN];
+static struct k_msgq cmsgq;
+static uint32_t cdata[CLAIM_LEN] = { MSG0, MSG1, MSG0 + 1, MSG1 + 1 };
+
+static K_THREAD_STACK_ARRAY_DEFINE(rstack, 2, STACK_SIZE);
+static struct k_thread rdata[2];
+static uint32_t rx_msg[2];
+static int rx_ret[2];
+
+static void put_claim_entry(void *p1, void *p2, void *p3)
+{
+	void *slot;
+
+	k_msleep(TIMEOUT_MS >> 1);
+	zassert_equal(k_msgq_put_claim(&cmsgq, &slot, K_NO_WAIT), 0, NULL);
+	*(uint32_t *)slot = MSG1;
+	zassert_equal(k_msgq_put_commit(&cmsgq), 0, NULL);
+}
+
+static void reader_entry(void *p1, void *p2, void *p3)
+{
+	int i = POINTER_TO_INT(p1);
+
+	rx_ret[i] = k_msgq_get(&cmsgq, &rx_msg[i], K_FOREVER);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test writing and reading messages in place
+ * @see k_msgq_put_claim(), k_msgq_put_commit(), k_msgq_get_claim(),
+ * k_msgq_get_release()
+ */
+void test_msgq_claim(void)
+{
+	uint32_t rx_data;
+	void *slot, *slot2;
+
+	k_msgq_init(&cmsgq, cbuffer, MSG_SIZE, CLAIM_LEN);
+
+	zassert_equal(k_msgq_get_claim(&cmsgq, &slot, K_NO_WAIT), -ENOMSG,
+		      NULL);
+	zassert_equal(k_msgq_put_commit(&cmsgq), -EINVAL, NULL);
+	zassert_equal(k_msgq_get_release(&cmsgq), -EINVAL, NULL);
+
+	/**TESTPOINT: a claimed slot is invisible until committed */
+	zassert_equal(k_msgq_put_claim(&cmsgq, &slot, K_NO_WAIT), 0, NULL);
+	zassert_true((char *)slot >= cbuffer &&
+		     (char *)slot < cbuffer + sizeof(cbuffer), NULL);
+	zassert_equal(k_msgq_put_claim(&cmsgq, &slot2, K_NO_WAIT), -EBUSY,
+		      NULL);
+	zassert_equal(k_msgq_put(&cmsgq, &cdata[1], K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(k_msgq_num_used_get(&cmsgq), 0, NULL);
+	*(uint32_t *)slot = MSG0;
+	zassert_equal(k_msgq_put_commit(&cmsgq), 0, NULL);
+	zassert_equal(k_msgq_num_used_get(&cmsgq), 1, NULL);
+
+	/**TESTPOINT: claims and copies keep FIFO order */
+	zassert_equal(k_msgq_put(&cmsgq, &cdata[1], K_NO_WAIT), 0, NULL);
+	zassert_equal(k_msgq_get_claim(&cmsgq, &slot, K_NO_WAIT), 0, NULL);
+	zassert_equal(*(uint32_t *)slot, MSG0, NULL);
+	zassert_equal(k_msgq_get(&cmsgq, &rx_data, K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(k_msgq_get_release(&cmsgq), 0, NULL);
+	zassert_equal(k_msgq_get(&cmsgq, &rx_data, K_NO_WAIT), 0, NULL);
+	zassert_equal(rx_data, MSG1, NULL);
+
+	/**TESTPOINT: a get claim waits for a message */
+	k_thread_create(&tdata, tstack, STACK_SIZE,
+			put_claim_entry, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	zassert_equal(k_msgq_get_claim(&cmsgq, &slot, K_FOREVER), 0, NULL);
+	zassert_equal(*(uint32_t *)slot, MSG1, NULL);
+	zassert_equal(k_msgq_get_release(&cmsgq), 0, NULL);
+	k_thread_abort(&tdata);
+
+	/**TESTPOINT: full queue times out a put claim */
+	for (int i = 0; i < CLAIM_LEN; i++) {
+		zassert_equal(k_msgq_put(&cmsgq, &cdata[i], K_NO_WAIT), 0,
+			      NULL);
+	}
+	zassert_equal(k_msgq_put_claim(&cmsgq, &slot, K_NO_WAIT), -ENOMSG,
+		      NULL);
+	zassert_equal(k_msgq_put_claim(&cmsgq, &slot, TIMEOUT), -EAGAIN,
+		      NULL);
+
+	/**TESTPOINT: purge cancels a get claim */
+	zassert_equal(k_msgq_get_claim(&cmsgq, &slot, K_NO_WAIT), 0, NULL);
+	k_msgq_purge(&cmsgq);
+	zassert_equal(k_msgq_get_release(&cmsgq), -EINVAL, NULL);
+	zassert_equal(k_msgq_num_used_get(&cmsgq), 0, NULL);
+}
+
+/**
+ * @brief Test committing a claimed slot with several readers waiting
+ * @see k_msgq_put_claim(), k_msgq_put_commit()
+ */
+void test_msgq_claim_readers(void)
+{
+	void *slot;
+
+	k_msgq_init(&cmsgq, cbuffer, MSG_SIZE, CLAIM_LEN);
+
+	for (int i = 0; i < 2; i++) {
+		rx_ret[i] = -EINPROGRESS;
+		k_thread_create(&rdata[i], rstack[i], STACK_SIZE,
+				reader_entry, INT_TO_POINTER(i), NULL, NULL,
+				K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	}
+	k_msleep(TIMEOUT_MS >> 1);
+
+	/**TESTPOINT: the message goes to the first reader only */
+	zassert_equal(k_msgq_put_claim(&cmsgq, &slot, K_NO_WAIT), 0, NULL);
+	*(uint32_t *)slot = MSG0;
+	zassert_equal(k_msgq_put_commit(&cmsgq), 0, NULL);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	zassert_equal(rx_ret[0], 0, NULL);
+	zassert_equal(rx_msg[0], MSG0, NULL);
+	zassert_equal(rx_ret[1], -EINPROGRESS, NULL);
+	zassert_equal(k_msgq_num_used_get(&cmsgq), 0, NULL);
+
+	/**TESTPOINT: the second reader still waits for its own message */
+	zassert_equal(k_msgq_put(&cmsgq, &cdata[1], K_NO_WAIT), 0, NULL);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	zassert_equal(rx_ret[1], 0, NULL);
+	zassert_equal(rx_msg[1], MSG1, NULL);
+	zassert_equal(k_msgq_num_used_get(&cmsgq), 0, NULL);
+
+	for (int i = 0; i < 2; i++) {
+		k_thread_abort(&rdata[i]);
+	}
+}
+
+/**
+ * @brief Test receiving several messages at once
+ * @see k_msgq_get_batch()
+ */
+void test_msgq_get_batch(void)
+{
+	uint32_t rx_data[CLAIM_LEN + 1];
+
+	k_msgq_init(&cmsgq, cbuffer, MSG_SIZE, CLAIM_LEN);
+
+	zassert_equal(k_msgq_get_batch(&cmsgq, rx_data, CLAIM_LEN, K_NO_WAIT),
+		      -ENOMSG, NULL);
+	zassert_equal(k_msgq_get_batch(&cmsgq, rx_data, CLAIM_LEN, TIMEOUT),
+		      -EAGAIN, NULL);
+
+	for (int i = 0; i < CLAIM_LEN; i++) {
+		zassert_equal(k_msgq_put(&cmsgq, &cdata[i], K_NO_WAIT), 0,
+			      NULL);
+	}
+
+	/**TESTPOINT: a batch stops at max_msgs */
+	zassert_equal(k_msgq_get_batch(&cmsgq, rx_data, 1, K_NO_WAIT), 1,
+		      NULL);
+	zassert_equal(rx_data[0], cdata[0], NULL);
+
+	/**TESTPOINT: a batch stops when the queue is empty */
+	zassert_equal(k_msgq_get_batch(&cmsgq, rx_data, CLAIM_LEN + 1,
+				       K_NO_WAIT), CLAIM_LEN - 1, NULL);
+	for (int i = 0; i < CLAIM_LEN - 1; i++) {
+		zassert_equal(rx_data[i], cdata[i + 1], NULL);
+	}
+	zassert_equal(k_msgq_num_used_get(&cmsgq), 0, NULL);
+}
+
+/**
+ * @}
+ */
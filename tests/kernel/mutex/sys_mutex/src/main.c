@@ -361,6 +361,17 @@ void test_mutex(void)
 	TC_PRINT("Recursive locking tests successful\n");
 }
 
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+/* The fast path accesses the mutex memory before the kernel validates it,
+ * so the validation is exercised through the system calls directly.
+ */
+#define checked_lock(mutex, timeout) z_sys_mutex_kernel_lock(mutex, timeout)
+#define checked_unlock(mutex) z_sys_mutex_kernel_unlock(mutex)
+#else
+#define checked_lock(mutex, timeout) sys_mutex_lock(mutex, timeout)
+#define checked_unlock(mutex) sys_mutex_unlock(mutex)
+#endif
+
 void test_supervisor_access(void)
 {
 	int rv;
@@ -369,11 +380,11 @@ void test_supervisor_access(void)
 	/* coverage for get_k_mutex checks */
 	rv = sys_mutex_lock((struct sys_mutex *)NULL, K_NO_WAIT);
 	zassert_true(rv == -EINVAL, "accepted bad mutex pointer");
-	rv = sys_mutex_lock((struct sys_mutex *)k_current_get(), K_NO_WAIT);
-	zassert_true(rv == -EINVAL, "accepted object that was not a mutex");
 	rv = sys_mutex_unlock((struct sys_mutex *)NULL);
 	zassert_true(rv == -EINVAL, "accepted bad mutex pointer");
-	rv = sys_mutex_unlock((struct sys_mutex *)k_current_get());
+	rv = checked_lock((struct sys_mutex *)k_current_get(), K_NO_WAIT);
+	zassert_true(rv == -EINVAL, "accepted object that was not a mutex");
+	rv = checked_unlock((struct sys_mutex *)k_current_get());
 	zassert_true(rv == -EINVAL, "accepted object that was not a mutex");
 #endif /* CONFIG_USERSPACE */
 
@@ -388,9 +399,9 @@ void test_user_access(void)
 #ifdef CONFIG_USERSPACE
 	int rv;
 
-	rv = sys_mutex_lock(&no_access_mutex, K_NO_WAIT);
+	rv = checked_lock(&no_access_mutex, K_NO_WAIT);
 	zassert_true(rv == -EACCES, "accessed mutex not in memory domain");
-	rv = sys_mutex_unlock(&no_access_mutex);
+	rv = checked_unlock(&no_access_mutex);
 	zassert_true(rv == -EACCES, "accessed mutex not in memory domain");
 #else
 	ztest_test_skip();
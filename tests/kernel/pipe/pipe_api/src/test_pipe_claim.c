@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Tests for the pipe zero-copy claim API
+ * @ingroup kernel_pipe_tests
+ * @{
+ */
+
+#include <ztest.h>
+#include <string.h>
+
+#define CLAIM_PIPE_SIZE 8
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+K_PIPE_DEFINE(claim_pipe, CLAIM_PIPE_SIZE, 4);
+static K_THREAD_STACK_DEFINE(claim_stack, STACK_SIZE);
+static struct k_thread claim_thread;
+
+static void claim_reader(void *p1, void *p2, void *p3)
+{
+	uint8_t *buf = p1;
+	size_t bytes_read;
+
+	zassert_equal(k_pipe_get(&claim_pipe, buf, 4, &bytes_read, 4,
+				 K_FOREVER), 0, NULL);
+	zassert_equal(bytes_read, 4, NULL);
+}
+
+static void claim_writer(void *p1, void *p2, void *p3)
+{
+	size_t bytes_written;
+
+	zassert_equal(k_pipe_put(&claim_pipe, p1, 4, &bytes_written, 4,
+				 K_FOREVER), 0, NULL);
+	zassert_equal(bytes_written, 4, NULL);
+}
+
+/**
+ * @brief Test claiming pipe buffer space and data in place
+ *
+ * @details Write and read data through claims, check that a claim stops
+ * at the end of the ring buffer and that copying calls in the claimed
+ * direction return -EBUSY.
+ *
+ * @see k_pipe_put_claim(), k_pipe_put_commit(), k_pipe_get_claim(),
+ * k_pipe_get_release()
+ */
+void test_pipe_claim_put_get(void)
+{
+	uint8_t tx[] = "abcdefgh";
+	uint8_t rx[CLAIM_PIPE_SIZE];
+	uint8_t *data;
+	size_t bytes;
+	int ret;
+
+	k_pipe_init(&claim_pipe, claim_pipe.buffer, CLAIM_PIPE_SIZE);
+
+	/* nothing to claim for reading yet */
+	ret = k_pipe_get_claim(&claim_pipe, &data, 4, K_NO_WAIT);
+	zassert_equal(ret, -EIO, NULL);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, 0), -EINVAL, NULL);
+
+	ret = k_pipe_put_claim(&claim_pipe, &data, 6, K_NO_WAIT);
+	zassert_equal(ret, 6, NULL);
+	memcpy(data, tx, 6);
+
+	/* one put claim at a time, and no copying writes */
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &data, 1, K_NO_WAIT),
+		      -EBUSY, NULL);
+	zassert_equal(k_pipe_put(&claim_pipe, tx, 1, &bytes, 1, K_NO_WAIT),
+		      -EBUSY, NULL);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, 7), -EINVAL, NULL);
+
+	zassert_equal(k_pipe_put_commit(&claim_pipe, 6), 0, NULL);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 6, NULL);
+
+	ret = k_pipe_get_claim(&claim_pipe, &data, 4, K_NO_WAIT);
+	zassert_equal(ret, 4, NULL);
+	zassert_mem_equal(data, tx, 4, NULL);
+	zassert_equal(k_pipe_get(&claim_pipe, rx, 1, &bytes, 1, K_NO_WAIT),
+		      -EBUSY, NULL);
+	zassert_equal(k_pipe_get_release(&claim_pipe, 4), 0, NULL);
+
+	/* the free space wraps: only the run up to the end is claimed */
+	ret = k_pipe_put_claim(&claim_pipe, &data, 4, K_NO_WAIT);
+	zassert_equal(ret, 2, NULL);
+	memcpy(data, &tx[6], 2);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, 2), 0, NULL);
+
+	ret = k_pipe_put_claim(&claim_pipe, &data, 4, K_NO_WAIT);
+	zassert_equal(ret, 4, NULL);
+	zassert_equal(data, claim_pipe.buffer, NULL);
+	memcpy(data, tx, 4);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, 4), 0, NULL);
+
+	/* copying reads see the claimed data in order */
+	zassert_equal(k_pipe_get(&claim_pipe, rx, sizeof(rx), &bytes, 8,
+				 K_NO_WAIT), 0, NULL);
+	zassert_mem_equal(rx, "efghabcd", 8, NULL);
+}
+
+/**
+ * @brief Test that claims hand data to and from waiting threads
+ *
+ * @details A reader pended on an empty pipe is served by a commit, and a
+ * writer pended on a full pipe moves its data in on release.  A claim on
+ * a full pipe times out.
+ *
+ * @see k_pipe_put_commit(), k_pipe_get_release()
+ */
+void test_pipe_claim_waiters(void)
+{
+	uint8_t rx[4] = { 0 };
+	uint8_t tx[] = "wxyz";
+	uint8_t *data;
+	int ret;
+
+	k_pipe_init(&claim_pipe, claim_pipe.buffer, CLAIM_PIPE_SIZE);
+
+	k_thread_create(&claim_thread, claim_stack, STACK_SIZE, claim_reader,
+			rx, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_sleep(K_MSEC(10));
+
+	ret = k_pipe_put_claim(&claim_pipe, &data, CLAIM_PIPE_SIZE,
+			       K_NO_WAIT);
+	zassert_equal(ret, CLAIM_PIPE_SIZE, NULL);
+	memcpy(data, "abcdefgh", CLAIM_PIPE_SIZE);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, CLAIM_PIPE_SIZE), 0,
+		      NULL);
+	k_thread_join(&claim_thread, K_FOREVER);
+	zassert_mem_equal(rx, "abcd", 4, NULL);
+
+	/* fill the pipe and pend a writer on it */
+	ret = k_pipe_put_claim(&claim_pipe, &data, 4, K_NO_WAIT);
+	zassert_equal(ret, 4, NULL);
+	memcpy(data, "ijkl", 4);
+	zassert_equal(k_pipe_put_commit(&claim_pipe, 4), 0, NULL);
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &data, 1, K_MSEC(10)),
+		      -EAGAIN, NULL);
+
+	k_thread_create(&claim_thread, claim_stack, STACK_SIZE, claim_writer,
+			tx, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_sleep(K_MSEC(10));
+
+	ret = k_pipe_get_claim(&claim_pipe, &data, CLAIM_PIPE_SIZE,
+			       K_NO_WAIT);
+	zassert_equal(ret, 4, NULL);
+	zassert_mem_equal(data, "efgh", 4, NULL);
+	zassert_equal(k_pipe_get_release(&claim_pipe, 4), 0, NULL);
+	k_thread_join(&claim_thread, K_FOREVER);
+
+	ret = k_pipe_get_claim(&claim_pipe, &data, CLAIM_PIPE_SIZE,
+			       K_NO_WAIT);
+	zassert_equal(ret, 8, NULL);
+	zassert_mem_equal(data, "ijklwxyz", 8, NULL);
+	zassert_equal(k_pipe_get_release(&claim_pipe, 8), 0, NULL);
+}
+
+/**
+ * @}
+ */
@@ -641,3 +641,97 @@ void test_poll_zero_events(void)
 
 	zassert_equal(k_poll(&event, 0, K_MSEC(50)), -EAGAIN, NULL);
 }
+
+/* verify k_poll_set_wait() */
+static K_SEM_DEFINE(set_sem, 0, 1);
+static K_FIFO_DEFINE(set_fifo);
+static struct k_poll_signal set_signal;
+static struct k_poll_set poll_set;
+
+static void poll_set_helper(void *p1, void *p2, void *p3)
+{
+	k_sleep(K_MSEC(50));
+	k_poll_signal_raise(&set_signal, SIGNAL_RESULT);
+}
+
+/**
+ * @brief Test poll sets
+ *
+ * @details
+ * - register a semaphore, a fifo and a signal with a poll set once
+ * - verify that only ready events are returned, that returned events
+ *   are reported again while their condition holds and that the set
+ *   wakes up its owner when a registered object becomes ready
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_init(), k_poll_set_add(), k_poll_set_wait(),
+ * k_poll_set_remove()
+ */
+void test_poll_set(void)
+{
+	struct fifo_msg msg = { NULL, FIFO_MSG_VALUE };
+	struct k_poll_event *ready[3];
+	struct k_poll_event events[3];
+	int rc;
+
+	k_poll_signal_init(&set_signal);
+	k_poll_event_init(&events[0], K_POLL_TYPE_SEM_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_sem);
+	k_poll_event_init(&events[1], K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_fifo);
+	k_poll_event_init(&events[2], K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_signal);
+
+	k_poll_set_init(&poll_set);
+	for (int i = 0; i < ARRAY_SIZE(events); i++) {
+		k_poll_set_add(&poll_set, &events[i]);
+	}
+
+	/* nothing ready yet */
+	zassert_equal(k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN, "");
+	zassert_equal(k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready),
+				      K_MSEC(10)), -EAGAIN, "");
+
+	/* one object becomes ready: only its event is reported */
+	k_sem_give(&set_sem);
+	rc = k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(rc, 1, "");
+	zassert_equal_ptr(ready[0], &events[0], "");
+	zassert_equal(events[0].state, K_POLL_STATE_SEM_AVAILABLE, "");
+
+	/* level-triggered: still available, so reported again */
+	k_fifo_put(&set_fifo, &msg);
+	rc = k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(rc, 2, "");
+	zassert_equal_ptr(ready[0], &events[1], "");
+	zassert_equal_ptr(ready[1], &events[0], "");
+
+	/* consumed objects are re-registered instead of reported */
+	zassert_equal(k_sem_take(&set_sem, K_NO_WAIT), 0, "");
+	zassert_not_null(k_fifo_get(&set_fifo, K_NO_WAIT), "");
+	zassert_equal(k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN, "");
+
+	/* block until another thread raises the signal */
+	k_thread_create(&test_thread, test_stack,
+			K_THREAD_STACK_SIZEOF(test_stack), poll_set_helper,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	rc = k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready),
+			     K_SECONDS(1));
+	zassert_equal(rc, 1, "");
+	zassert_equal_ptr(ready[0], &events[2], "");
+	zassert_equal(events[2].state, K_POLL_STATE_SIGNALED, "");
+	k_thread_join(&test_thread, K_FOREVER);
+
+	/* removed events are no longer reported */
+	k_poll_signal_reset(&set_signal);
+	for (int i = 0; i < ARRAY_SIZE(events); i++) {
+		k_poll_set_remove(&poll_set, &events[i]);
+	}
+	k_sem_give(&set_sem);
+	zassert_equal(k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN, "");
+	zassert_equal(k_sem_take(&set_sem, K_NO_WAIT), 0, "");
+}
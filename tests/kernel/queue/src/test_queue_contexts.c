@@ -398,3 +398,59 @@ void test_multiple_queues(void)
 		tqueue_get(&queues[i]);
 	}
 }
+
+static void queue_batch_producer(void *p1, void *p2, void *p3)
+{
+	k_sleep(K_MSEC(10));
+	k_queue_append(&queue, &data_p[0]);
+	k_queue_append(&queue, &data_p[1]);
+}
+
+/**
+ * @brief Test getting all queue items at once
+ *
+ * @details Items appended one by one are returned in order as a single
+ * list, an empty queue returns nothing without waiting, and a waiting
+ * batch get returns once items arrive.
+ *
+ * @ingroup kernel_queue_tests
+ *
+ * @see k_queue_get_batch()
+ */
+void test_queue_get_batch(void)
+{
+	sys_slist_t list;
+	int count;
+
+	k_queue_init(&queue);
+	sys_slist_init(&list);
+
+	for (int i = 0; i < LIST_LEN; i++) {
+		k_queue_append(&queue, &data[i]);
+	}
+
+	count = k_queue_get_batch(&queue, &list, K_NO_WAIT);
+	zassert_equal(count, LIST_LEN, NULL);
+	zassert_true(k_queue_is_empty(&queue), NULL);
+	for (int i = 0; i < LIST_LEN; i++) {
+		zassert_equal(sys_slist_get(&list), &data[i].snode, NULL);
+	}
+	zassert_true(sys_slist_is_empty(&list), NULL);
+
+	zassert_equal(k_queue_get_batch(&queue, &list, K_NO_WAIT), 0, NULL);
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, queue_batch_producer,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	count = k_queue_get_batch(&queue, &list, K_FOREVER);
+	zassert_true(count >= 1, NULL);
+	zassert_equal(sys_slist_get(&list), &data_p[0].snode, NULL);
+
+	k_thread_join(&tdata, K_FOREVER);
+	if (count == 1) {
+		zassert_equal(k_queue_get(&queue, K_NO_WAIT), &data_p[1], NULL);
+	} else {
+		zassert_equal(sys_slist_get(&list), &data_p[1].snode, NULL);
+	}
+	zassert_true(k_queue_is_empty(&queue), NULL);
+}
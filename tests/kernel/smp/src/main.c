@@ -548,6 +548,60 @@ void test_smp_ipi(void)
 }
 #endif
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+static struct k_mutex spin_mutex;
+static volatile bool spin_mutex_held;
+
+static void mutex_holder_fn(void *p1, void *p2, void *p3)
+{
+	k_mutex_lock(&spin_mutex, K_FOREVER);
+	spin_mutex_held = true;
+	k_busy_wait(CONFIG_MUTEX_ADAPTIVE_SPIN_USEC / 4);
+	k_mutex_unlock(&spin_mutex);
+}
+
+/**
+ * @brief Test adaptive spinning on a mutex held on another CPU
+ *
+ * @details The mutex is held by a running thread on the other CPU for
+ * a fraction of the spin limit, so the lock must be obtained without
+ * pending.
+ *
+ * @ingroup kernel_smp_tests
+ *
+ * @see k_mutex_lock(), k_mutex_spin_stats_get()
+ */
+void test_mutex_adaptive_spin(void)
+{
+	struct k_mutex_spin_stats before, after;
+
+	k_mutex_init(&spin_mutex);
+	spin_mutex_held = false;
+	k_mutex_spin_stats_get(&before);
+
+	k_thread_create(&t2, t2_stack, T2_STACK_SIZE, mutex_holder_fn,
+			NULL, NULL, NULL, K_PRIO_COOP(2), 0, K_NO_WAIT);
+
+	while (!spin_mutex_held) {
+	}
+
+	zassert_equal(k_mutex_lock(&spin_mutex, K_FOREVER), 0, NULL);
+	k_mutex_unlock(&spin_mutex);
+	k_thread_join(&t2, K_FOREVER);
+
+	k_mutex_spin_stats_get(&after);
+	zassert_equal(after.blocked, before.blocked,
+		      "pended on a mutex held by a running thread");
+	zassert_equal(after.spin_blocked, before.spin_blocked,
+		      "spin timed out on a short critical section");
+}
+#else
+void test_mutex_adaptive_spin(void)
+{
+	ztest_test_skip();
+}
+#endif
+
 void test_main(void)
 {
 	/* Sleep a bit to guarantee that both CPUs enter an idle
@@ -565,7 +619,8 @@ void test_main(void)
 			 ztest_unit_test(test_sleep_threads),
 			 ztest_unit_test(test_wakeup_threads),
 			 ztest_unit_test(test_smp_ipi),
-			 ztest_unit_test(test_get_cpu)
+			 ztest_unit_test(test_get_cpu),
+			 ztest_unit_test(test_mutex_adaptive_spin)
 			 );
 	ztest_run_test_suite(smp);
 }
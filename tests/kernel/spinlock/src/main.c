@@ -20,6 +20,15 @@ static struct k_spinlock bounce_lock;
 
 volatile int bounce_owner, bounce_done;
 
+static bool spin_is_locked(struct k_spinlock *l)
+{
+#ifdef CONFIG_SPINLOCK_TICKET
+	return atomic_get(&l->tail) != atomic_get(&l->owner);
+#else
+	return atomic_get(&l->locked) != 0;
+#endif
+}
+
 /**
  * @brief Tests for spinlock
  *
@@ -43,16 +52,47 @@ void test_spinlock_basic(void)
 	k_spinlock_key_t key;
 	static struct k_spinlock l;
 
-	zassert_true(!l.locked, "Spinlock initialized to locked");
+	zassert_true(!spin_is_locked(&l), "Spinlock initialized to locked");
 
 	key = k_spin_lock(&l);
 
-	zassert_true(l.locked, "Spinlock failed to lock");
+	zassert_true(spin_is_locked(&l), "Spinlock failed to lock");
 
 	k_spin_unlock(&l, key);
 
-	zassert_true(!l.locked, "Spinlock failed to unlock");
+	zassert_true(!spin_is_locked(&l), "Spinlock failed to unlock");
+}
+
+#ifdef CONFIG_SPINLOCK_STATS
+/**
+ * @brief Test spinlock contention counters
+ *
+ * @ingroup kernel_spinlock_tests
+ *
+ * @see k_spin_stats_get()
+ */
+void test_spinlock_stats(void)
+{
+	k_spinlock_key_t key;
+	static struct k_spinlock l;
+	struct k_spinlock_stats stats;
+
+	for (int i = 0; i < 3; i++) {
+		key = k_spin_lock(&l);
+		k_spin_unlock(&l, key);
+	}
+
+	k_spin_stats_get(&l, &stats);
+	zassert_equal(stats.acquired, 3, "wrong acquisition count");
+	zassert_equal(stats.contended, 0, "uncontended lock contended");
+	zassert_equal(stats.spins, 0, "uncontended lock spun");
+}
+#else
+void test_spinlock_stats(void)
+{
+	ztest_test_skip();
 }
+#endif
 
 void bounce_once(int id)
 {
@@ -147,11 +187,11 @@ void test_spinlock_mutual_exclusion(void)
 	struct k_spinlock lock_runtime;
 	unsigned int irq_key;
 
-	lock_runtime.locked = 0;
+	(void)memset(&lock_runtime, 0, sizeof(lock_runtime));
 
 	key = k_spin_lock(&lock_runtime);
 
-	zassert_true(lock_runtime.locked, "Spinlock failed to lock");
+	zassert_true(spin_is_locked(&lock_runtime), "Spinlock failed to lock");
 
 	/* check irq has not locked */
 	zassert_true(arch_irq_unlocked(key.key),
@@ -171,13 +211,14 @@ void test_spinlock_mutual_exclusion(void)
 
 	k_spin_unlock(&lock_runtime, key);
 
-	zassert_true(!lock_runtime.locked, "Spinlock failed to unlock");
+	zassert_true(!spin_is_locked(&lock_runtime), "Spinlock failed to unlock");
 }
 
 void test_main(void)
 {
 	ztest_test_suite(spinlock,
 			 ztest_unit_test(test_spinlock_basic),
+			 ztest_unit_test(test_spinlock_stats),
 			 ztest_unit_test(test_spinlock_bounce),
 			 ztest_unit_test(test_spinlock_mutual_exclusion));
 	ztest_run_test_suite(spinlock);
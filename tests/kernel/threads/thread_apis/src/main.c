@@ -457,6 +457,47 @@ void test_thread_join_deadlock(void)
 		      "couldn't join deadlock2_thread");
 }
 
+/**
+ * @brief Test the thread runtime statistics
+ *
+ * @ingroup kernel_thread_tests
+ */
+void test_thread_runtime_stats_get(void)
+{
+	k_thread_runtime_stats_t stats;
+	k_thread_runtime_stats_t stats_all;
+	uint64_t cycles;
+
+	zassert_equal(k_thread_runtime_stats_get(NULL, &stats), -EINVAL,
+		      "NULL thread accepted");
+	zassert_equal(k_thread_runtime_stats_all_get(NULL), -EINVAL,
+		      "NULL stats accepted");
+
+	zassert_equal(k_thread_runtime_stats_get(k_current_get(), &stats), 0,
+		      NULL);
+	cycles = stats.execution_cycles;
+
+	/* Busy waiting is charged to the current thread */
+	k_busy_wait(1000);
+	zassert_equal(k_thread_runtime_stats_get(k_current_get(), &stats), 0,
+		      NULL);
+	zassert_true(stats.execution_cycles > cycles,
+		     "busy wait not accounted");
+
+	/* Sleeping is not */
+	cycles = stats.execution_cycles;
+	k_msleep(10);
+	zassert_equal(k_thread_runtime_stats_get(k_current_get(), &stats), 0,
+		      NULL);
+	zassert_true(stats.execution_cycles - cycles <
+		     k_ms_to_cyc_ceil32(10),
+		     "sleep accounted to the sleeping thread");
+
+	zassert_equal(k_thread_runtime_stats_all_get(&stats_all), 0, NULL);
+	zassert_true(stats_all.execution_cycles >= stats.execution_cycles,
+		     "thread cycles exceed the total");
+}
+
 void test_main(void)
 {
 	k_thread_access_grant(k_current_get(), &tdata, tstack,
@@ -501,7 +542,8 @@ void test_main(void)
 			 ztest_user_unit_test(test_thread_join),
 			 ztest_unit_test(test_thread_join_isr),
 			 ztest_user_unit_test(test_thread_join_deadlock),
-			 ztest_unit_test(test_abort_from_isr)
+			 ztest_unit_test(test_abort_from_isr),
+			 ztest_1cpu_unit_test(test_thread_runtime_stats_get)
 			 );
 
 	ztest_run_test_suite(threads_lifecycle);
@@ -64,6 +64,7 @@ static struct k_timer status_timer;
 static struct k_timer status_anytime_timer;
 static struct k_timer status_sync_timer;
 static struct k_timer remain_timer;
+static struct k_timer slack_timer;
 
 static ZTEST_BMEM struct timer_data tdata;
 
@@ -668,6 +669,46 @@ void test_timeout_abs(void)
 #endif
 }
 
+#define SLACK_TICKS 64
+
+static volatile int64_t slack_expiry;
+
+static void slack_expire(struct k_timer *timer)
+{
+	slack_expiry = k_uptime_ticks();
+}
+
+/**
+ * @brief Test the expiration of a timer allowed to expire late
+ *
+ * Validates that a timer given a slack with k_timer_slack_set() is
+ * delayed to a multiple of its slack, and never expires early.
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_slack_set(), k_timer_start(), k_timer_status_sync()
+ */
+void test_timer_slack(void)
+{
+#ifdef CONFIG_TIMEOUT_SLACK
+	int64_t start;
+
+	k_timer_slack_set(&slack_timer, K_TICKS(SLACK_TICKS));
+
+	start = k_uptime_ticks();
+	k_timer_start(&slack_timer, K_TICKS(1), K_NO_WAIT);
+	k_timer_status_sync(&slack_timer);
+
+	k_timer_slack_set(&slack_timer, K_NO_WAIT);
+
+	zassert_true(slack_expiry >= ROUND_UP(start + 1, SLACK_TICKS),
+		     "timer expired at %lld, before the slack boundary",
+		     slack_expiry);
+#else
+	ztest_test_skip();
+#endif
+}
+
 static void timer_init(struct k_timer *timer, k_timer_expiry_t expiry_fn,
 		       k_timer_stop_t stop_fn)
 {
@@ -686,6 +727,7 @@ void test_main(void)
 	timer_init(&status_anytime_timer, NULL, NULL);
 	timer_init(&status_sync_timer, duration_expire, duration_stop);
 	timer_init(&remain_timer, NULL, NULL);
+	timer_init(&slack_timer, slack_expire, NULL);
 
 	k_thread_access_grant(k_current_get(), &ktimer, &timer0, &timer1,
 			      &timer2, &timer3, &timer4);
@@ -702,6 +744,7 @@ void test_main(void)
 			 ztest_user_unit_test(test_timer_k_define),
 			 ztest_user_unit_test(test_timer_user_data),
 			 ztest_user_unit_test(test_timer_remaining),
-			 ztest_user_unit_test(test_timeout_abs));
+			 ztest_user_unit_test(test_timeout_abs),
+			 ztest_user_unit_test(test_timer_slack));
 	ztest_run_test_suite(timer_api);
 }
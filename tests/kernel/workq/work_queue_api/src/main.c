@@ -32,6 +32,14 @@ struct k_work_q work_q_max_number[MAX_WORK_Q_NUMBER];
 K_THREAD_STACK_DEFINE(my_stack_area, STACK_SIZE);
 K_THREAD_STACK_DEFINE(new_stack_area[MAX_WORK_Q_NUMBER], STACK_SIZE);
 
+#define NUM_POOL_THREADS 2
+K_THREAD_STACK_ARRAY_DEFINE(pool_stacks, NUM_POOL_THREADS, STACK_SIZE);
+static struct k_thread pool_threads[NUM_POOL_THREADS - 1];
+static struct k_work_pool work_pool;
+static struct k_work pool_work[NUM_POOL_THREADS];
+static struct k_delayed_work pool_delayed_work;
+static struct k_sem pool_release_sema;
+
 static K_THREAD_STACK_DEFINE(tstack, STACK_SIZE);
 static K_THREAD_STACK_DEFINE(user_tstack, STACK_SIZE);
 static struct k_work_q workq;
@@ -198,6 +206,89 @@ void test_workqueue_max_number(void)
 		     "%d, expected %d", work_q_num, MAX_WORK_Q_NUMBER);
 }
 
+static void pool_blocking_handler(struct k_work *unused)
+{
+	k_sem_give(&sync_sema);
+	k_sem_take(&pool_release_sema, K_FOREVER);
+}
+
+/**
+ * @brief Test work items are processed concurrently by a work pool
+ * @details
+ * - Start a work pool with two worker threads.
+ * - Submit two work items whose handlers block until released.
+ * - Both handlers must have started before either is released,
+ *   showing that a blocked handler does not stall the pool.
+ * - Submit a delayed work item to the pool and check it runs.
+ * @ingroup kernel_workqueue_tests
+ * @see k_work_pool_start(), k_work_pool_queue()
+ */
+void test_work_pool_concurrent(void)
+{
+	struct k_work_q *pool_q = k_work_pool_queue(&work_pool);
+
+	k_sem_reset(&sync_sema);
+	k_sem_init(&pool_release_sema, 0, NUM_POOL_THREADS);
+
+	k_work_pool_start(&work_pool, pool_stacks[0], STACK_SIZE,
+			  pool_threads, NUM_POOL_THREADS, MY_PRIORITY, false);
+
+	for (int i = 0; i < NUM_POOL_THREADS; i++) {
+		k_work_init(&pool_work[i], pool_blocking_handler);
+		k_work_submit_to_queue(pool_q, &pool_work[i]);
+	}
+
+	/**TESTPOINT: every worker picked up an item */
+	for (int i = 0; i < NUM_POOL_THREADS; i++) {
+		zassert_equal(k_sem_take(&sync_sema, TIMEOUT), 0,
+			      "work item %d not started", i);
+	}
+
+	for (int i = 0; i < NUM_POOL_THREADS; i++) {
+		k_sem_give(&pool_release_sema);
+	}
+
+	/**TESTPOINT: delayed work runs on the pool */
+	k_delayed_work_init(&pool_delayed_work, common_work_handler);
+	zassert_equal(k_delayed_work_submit_to_queue(pool_q,
+						     &pool_delayed_work,
+						     TIMEOUT), 0, NULL);
+	zassert_equal(k_sem_take(&sync_sema, K_MSEC(2 * TIMEOUT_MS)), 0,
+		      "delayed work not processed by pool");
+}
+
+K_WORK_POOL_DEFINE(static_work_pool, 2, STACK_SIZE, MY_PRIORITY);
+static struct k_work static_pool_work[2];
+
+/**
+ * @brief Test a statically defined work pool
+ *
+ * - Submit blocking work items to a pool defined with
+ *   K_WORK_POOL_DEFINE(), both must start before either is released.
+ * @ingroup kernel_workqueue_tests
+ * @see K_WORK_POOL_DEFINE(), k_work_pool_submit()
+ */
+void test_work_pool_static(void)
+{
+	k_sem_reset(&sync_sema);
+	k_sem_init(&pool_release_sema, 0, 2);
+
+	for (int i = 0; i < 2; i++) {
+		k_work_init(&static_pool_work[i], pool_blocking_handler);
+		k_work_pool_submit(&static_work_pool, &static_pool_work[i]);
+	}
+
+	/**TESTPOINT: both static workers picked up an item */
+	for (int i = 0; i < 2; i++) {
+		zassert_equal(k_sem_take(&sync_sema, TIMEOUT), 0,
+			      "work item %d not started", i);
+	}
+
+	for (int i = 0; i < 2; i++) {
+		k_sem_give(&pool_release_sema);
+	}
+}
+
 static void work_sleepy(struct k_work *w)
 {
 	k_sleep(TIMEOUT);
@@ -1128,6 +1219,8 @@ void test_main(void)
 			 ztest_unit_test(test_process_work_items_fifo),
 			 ztest_unit_test(test_sched_delayed_work_item),
 			 ztest_unit_test(test_workqueue_max_number),
+			 ztest_unit_test(test_work_pool_concurrent),
+			 ztest_unit_test(test_work_pool_static),
 			 ztest_unit_test(test_cancel_processed_work_item));
 	ztest_run_test_suite(workqueue_api);
 }
@@ -509,6 +509,187 @@ void test_str_operate(void)
 	zassert_not_null(strstr(str1, str2), "strstr aabbccd with b failed");
 }
 
+/*
+ * The word at a time routines have an unaligned head, an unrolled loop of
+ * four words, a word loop and a tail: sweep the alignments and the lengths
+ * over all of them.
+ */
+#define SWEEP_WORD sizeof(uintptr_t)
+#define SWEEP_LEN (5 * SWEEP_WORD)
+#define SWEEP_BUF (SWEEP_LEN + 2 * SWEEP_WORD)
+#define SWEEP_GUARD 0xa5
+
+static uintptr_t sweep_words1[SWEEP_BUF / sizeof(uintptr_t)];
+static uintptr_t sweep_words2[SWEEP_BUF / sizeof(uintptr_t)];
+
+/* Non zero bytes, including some with the high bit set */
+static unsigned char sweep_byte(size_t i)
+{
+	return 2 + (i * 37) % 254;
+}
+
+static void sweep_fill(unsigned char *buf)
+{
+	size_t i;
+
+	for (i = 0; i < SWEEP_BUF; i++) {
+		buf[i] = sweep_byte(i);
+	}
+}
+
+/**
+ *
+ * @brief Test memcpy() and memset() on all alignments and lengths
+ *
+ */
+void test_memcpy_memset_sweep(void)
+{
+	unsigned char *src = (unsigned char *)sweep_words1;
+	unsigned char *dst = (unsigned char *)sweep_words2;
+	size_t s_off, d_off, len, i;
+
+	sweep_fill(src);
+
+	for (s_off = 0; s_off < SWEEP_WORD; s_off++) {
+		for (d_off = 0; d_off < SWEEP_WORD; d_off++) {
+			for (len = 0; len <= SWEEP_LEN; len++) {
+				(void)memset(dst, SWEEP_GUARD, SWEEP_BUF);
+				zassert_equal(memcpy(dst + d_off, src + s_off,
+						     len), dst + d_off,
+					      "memcpy return value");
+
+				for (i = 0; i < SWEEP_BUF; i++) {
+					zassert_equal(dst[i],
+						      (i >= d_off &&
+						       i < d_off + len) ?
+						      src[s_off + i - d_off] :
+						      SWEEP_GUARD,
+						      "memcpy %zu %zu %zu @%zu",
+						      s_off, d_off, len, i);
+				}
+			}
+		}
+	}
+
+	for (d_off = 0; d_off < SWEEP_WORD; d_off++) {
+		for (len = 0; len <= SWEEP_LEN; len++) {
+			(void)memset(dst, SWEEP_GUARD, SWEEP_BUF);
+			/* only the low byte of the value is stored */
+			zassert_equal(memset(dst + d_off, 0x15a, len),
+				      dst + d_off, "memset return value");
+
+			for (i = 0; i < SWEEP_BUF; i++) {
+				zassert_equal(dst[i],
+					      (i >= d_off && i < d_off + len) ?
+					      0x5a : SWEEP_GUARD,
+					      "memset %zu %zu @%zu",
+					      d_off, len, i);
+			}
+		}
+	}
+}
+
+/**
+ *
+ * @brief Test strlen() and strcmp() with a terminator at every position
+ *
+ */
+void test_strlen_strcmp_sweep(void)
+{
+	char *s1 = (char *)sweep_words1;
+	char *s2 = (char *)sweep_words2;
+	unsigned char *u1 = (unsigned char *)s1;
+	unsigned char *u2 = (unsigned char *)s2;
+	size_t off1, off2, len, pos;
+	int expected;
+
+	for (off1 = 0; off1 < SWEEP_WORD; off1++) {
+		for (len = 0; len <= SWEEP_LEN; len++) {
+			sweep_fill(u1);
+			s1[off1 + len] = '\0';
+			zassert_equal(strlen(s1 + off1), len, "strlen %zu %zu",
+				      off1, len);
+		}
+	}
+
+	for (off1 = 0; off1 < SWEEP_WORD; off1++) {
+		for (off2 = 0; off2 < SWEEP_WORD; off2++) {
+			for (len = 0; len <= SWEEP_LEN; len++) {
+				sweep_fill(u1);
+				memcpy(s2 + off2, s1 + off1, len);
+				s1[off1 + len] = '\0';
+				s2[off2 + len] = '\0';
+				zassert_equal(strcmp(s1 + off1, s2 + off2), 0,
+					      "strcmp %zu %zu %zu",
+					      off1, off2, len);
+
+				if (len == 0) {
+					continue;
+				}
+
+				/* s1 is a prefix of s2 */
+				s2[off2 + len] = 'a';
+				s2[off2 + len + 1] = '\0';
+				zassert_true(strcmp(s1 + off1, s2 + off2) < 0,
+					     "strcmp prefix %zu %zu %zu",
+					     off1, off2, len);
+				zassert_true(strcmp(s2 + off2, s1 + off1) > 0,
+					     "strcmp prefix %zu %zu %zu",
+					     off1, off2, len);
+				s2[off2 + len] = '\0';
+
+				/*
+				 * Flipping the lowest bit keeps the bytes on
+				 * the same side of 0x80, so the order is the
+				 * same whether char is signed or not.
+				 */
+				for (pos = 0; pos < len; pos++) {
+					u2[off2 + pos] ^= 1;
+					expected = (u1[off1 + pos] <
+						    u2[off2 + pos]) ? -1 : 1;
+					zassert_true(strcmp(s1 + off1,
+							    s2 + off2) *
+						     expected > 0,
+						     "strcmp %zu %zu %zu @%zu",
+						     off1, off2, len, pos);
+					u2[off2 + pos] ^= 1;
+				}
+			}
+		}
+	}
+}
+
+/**
+ *
+ * @brief Test memchr() with a match at every position
+ *
+ */
+void test_memchr_sweep(void)
+{
+	unsigned char *buf = (unsigned char *)sweep_words1;
+	const unsigned char c = 0x85;
+	size_t off, len, pos;
+
+	for (off = 0; off < SWEEP_WORD; off++) {
+		for (len = 0; len <= SWEEP_LEN; len++) {
+			/* near misses: only the high bit differs */
+			(void)memset(buf, c ^ 0x80, SWEEP_BUF);
+			buf[off + len] = c;
+			zassert_is_null(memchr(buf + off, c, len),
+					"memchr %zu %zu", off, len);
+
+			for (pos = 0; pos < len; pos++) {
+				buf[off + pos] = c;
+				zassert_equal(memchr(buf + off, c, len),
+					      buf + off + pos,
+					      "memchr %zu %zu @%zu",
+					      off, len, pos);
+				buf[off + pos] = c ^ 0x80;
+			}
+		}
+	}
+}
+
 /**
  *
  * @brief test strtol function
@@ -620,6 +801,9 @@ void test_main(void)
 			 ztest_unit_test(test_checktype),
 			 ztest_unit_test(test_memstr),
 			 ztest_unit_test(test_str_operate),
+			 ztest_unit_test(test_memcpy_memset_sweep),
+			 ztest_unit_test(test_strlen_strcmp_sweep),
+			 ztest_unit_test(test_memchr_sweep),
 			 ztest_unit_test(test_tolower_toupper),
 			 ztest_unit_test(test_strtok_r)
 			 );
@@ -29,6 +29,38 @@ void test_z_reserve_fd(void)
 	z_free_fd(fd);
 }
 
+void test_z_reserve_fd_all(void)
+{
+	int fds[CONFIG_POSIX_MAX_FDS];
+	int n, fd, i;
+
+	for (n = 0; n < ARRAY_SIZE(fds); n++) {
+		fds[n] = z_reserve_fd();
+		if (fds[n] < 0) {
+			break;
+		}
+
+		for (i = 0; i < n; i++) {
+			zassert_not_equal(fds[i], fds[n], "fd reserved twice");
+		}
+	}
+
+	zassert_true(n > 0, "no fd reserved");
+
+	fd = z_reserve_fd();
+	zassert_true(fd < 0, "fd reserved from a full table");
+	zassert_equal(errno, ENFILE, "errno not set");
+
+	/* A reserved but never finalized fd is returned to the table */
+	z_free_fd(fds[0]);
+	fd = z_reserve_fd();
+	zassert_equal(fd, fds[0], "fd not returned to the table");
+
+	for (i = 0; i < n; i++) {
+		z_free_fd(fds[i]);
+	}
+}
+
 void test_z_get_fd_obj_and_vtable(void)
 {
 	const struct fd_op_vtable *vtable;
@@ -185,6 +217,7 @@ void test_main(void)
 {
 	ztest_test_suite(test_fdtable,
 			 ztest_unit_test(test_z_reserve_fd),
+			 ztest_unit_test(test_z_reserve_fd_all),
 			 ztest_unit_test(test_z_get_fd_obj_and_vtable),
 			 ztest_unit_test(test_z_get_fd_obj),
 			 ztest_unit_test(test_z_finalize_fd),
@@ -204,12 +204,62 @@ static void test_big_heap(void)
 	log_result(BIG_HEAP_SZ, &result);
 }
 
+/* Check that realloc shrinks and grows in place when the
+ * neighboring memory allows it, moves the data otherwise, and
+ * preserves the contents in every case.
+ */
+static void test_realloc(void)
+{
+	struct sys_heap heap;
+	uint8_t *p1, *p2, *p3;
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+
+	/* Grow into the free space to the right */
+	p1 = sys_heap_alloc(&heap, 64);
+	zassert_not_null(p1, "");
+	for (int i = 0; i < 64; i++) {
+		p1[i] = i;
+	}
+	p2 = sys_heap_realloc(&heap, p1, 256);
+	zassert_equal(p1, p2, "growing into free space should not move");
+	zassert_true(sys_heap_validate(&heap), "");
+
+	/* Shrink in place, the tail goes back to the heap */
+	p2 = sys_heap_realloc(&heap, p1, 32);
+	zassert_equal(p1, p2, "shrinking should not move");
+	zassert_true(sys_heap_validate(&heap), "");
+
+	/* Block the right neighbor so the next grow must move */
+	p3 = sys_heap_alloc(&heap, 32);
+	zassert_not_null(p3, "");
+	zassert_true(p3 > p1, "");
+	p2 = sys_heap_realloc(&heap, p1, 128);
+	zassert_not_null(p2, "");
+	zassert_not_equal(p1, p2, "");
+	for (int i = 0; i < 32; i++) {
+		zassert_equal(p2[i], i, "data not preserved");
+	}
+	zassert_true(sys_heap_validate(&heap), "");
+
+	/* Failed realloc leaves the original block intact */
+	zassert_is_null(sys_heap_realloc(&heap, p2, SMALL_HEAP_SZ), "");
+	for (int i = 0; i < 32; i++) {
+		zassert_equal(p2[i], i, "data not preserved");
+	}
+
+	zassert_is_null(sys_heap_realloc(&heap, p2, 0), "");
+	sys_heap_free(&heap, p3);
+	zassert_true(sys_heap_validate(&heap), "");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(lib_heap_test,
 			 ztest_unit_test(test_small_heap),
 			 ztest_unit_test(test_fragmentation),
-			 ztest_unit_test(test_big_heap)
+			 ztest_unit_test(test_big_heap),
+			 ztest_unit_test(test_realloc)
 			 );
 
 	ztest_run_test_suite(lib_heap_test);
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <device.h>
+#include <drivers/counter.h>
+#include "counter_mock.h"
+
+/*
+ * Counter for the high resolution timers on any platform, counting the
+ * system ticks. It wraps every second so that the timers go through many
+ * wraps in a short test, its alarm is a kernel timer.
+ */
+#define MOCK_TOP (COUNTER_MOCK_FREQ - 1U)
+
+static struct k_timer alarm_timer;
+static struct counter_alarm_cfg alarm;
+static uint32_t shortest_alarm = UINT32_MAX;
+
+void counter_mock_reset(void)
+{
+	shortest_alarm = UINT32_MAX;
+}
+
+uint32_t counter_mock_shortest_alarm(void)
+{
+	return shortest_alarm;
+}
+
+static uint32_t mock_value(void)
+{
+	return k_uptime_ticks() % COUNTER_MOCK_FREQ;
+}
+
+static void mock_alarm_expired(struct k_timer *timer)
+{
+	struct device *dev = k_timer_user_data_get(timer);
+
+	alarm.callback(dev, 0, mock_value(), alarm.user_data);
+}
+
+static int mock_start(struct device *dev)
+{
+	return 0;
+}
+
+static int mock_stop(struct device *dev)
+{
+	return -ENOTSUP;
+}
+
+static int mock_get_value(struct device *dev, uint32_t *ticks)
+{
+	*ticks = mock_value();
+	return 0;
+}
+
+static int mock_set_alarm(struct device *dev, uint8_t chan_id,
+			  const struct counter_alarm_cfg *alarm_cfg)
+{
+	/* the high resolution timers only set relative alarms */
+	if ((alarm_cfg->flags & COUNTER_ALARM_CFG_ABSOLUTE) != 0U) {
+		return -ENOTSUP;
+	}
+
+	alarm = *alarm_cfg;
+	shortest_alarm = MIN(shortest_alarm, alarm.ticks);
+	k_timer_start(&alarm_timer, K_TICKS(alarm.ticks), K_NO_WAIT);
+
+	return 0;
+}
+
+static int mock_cancel_alarm(struct device *dev, uint8_t chan_id)
+{
+	k_timer_stop(&alarm_timer);
+	return 0;
+}
+
+static int mock_set_top_value(struct device *dev,
+			      const struct counter_top_cfg *cfg)
+{
+	return -ENOTSUP;
+}
+
+static uint32_t mock_get_pending_int(struct device *dev)
+{
+	return 0;
+}
+
+static uint32_t mock_get_top_value(struct device *dev)
+{
+	return MOCK_TOP;
+}
+
+static uint32_t mock_get_max_relative_alarm(struct device *dev)
+{
+	return MOCK_TOP;
+}
+
+static const struct counter_driver_api mock_api = {
+	.start = mock_start,
+	.stop = mock_stop,
+	.get_value = mock_get_value,
+	.set_alarm = mock_set_alarm,
+	.cancel_alarm = mock_cancel_alarm,
+	.set_top_value = mock_set_top_value,
+	.get_pending_int = mock_get_pending_int,
+	.get_top_value = mock_get_top_value,
+	.get_max_relative_alarm = mock_get_max_relative_alarm,
+};
+
+static const struct counter_config_info mock_config = {
+	.max_top_value = MOCK_TOP,
+	.freq = COUNTER_MOCK_FREQ,
+	.flags = COUNTER_CONFIG_INFO_COUNT_UP,
+	.channels = 1,
+};
+
+static int mock_init(struct device *dev)
+{
+	k_timer_init(&alarm_timer, mock_alarm_expired, NULL);
+	k_timer_user_data_set(&alarm_timer, dev);
+
+	return 0;
+}
+
+DEVICE_AND_API_INIT(counter_mock, "HRTIMER_MOCK", mock_init, NULL,
+		    &mock_config, POST_KERNEL,
+		    CONFIG_KERNEL_INIT_PRIORITY_DEVICE, &mock_api);
@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_TESTS_LIB_HRTIMER_SRC_COUNTER_MOCK_H_
+#define ZEPHYR_TESTS_LIB_HRTIMER_SRC_COUNTER_MOCK_H_
+
+#include <zephyr/types.h>
+
+/* The mock counter runs at the system tick rate and wraps every second */
+#define COUNTER_MOCK_FREQ CONFIG_SYS_CLOCK_TICKS_PER_SEC
+
+/* Forget the alarms set so far */
+void counter_mock_reset(void);
+
+/* Shortest relative alarm set since the last reset, in counter ticks */
+uint32_t counter_mock_shortest_alarm(void);
+
+#endif /* ZEPHYR_TESTS_LIB_HRTIMER_SRC_COUNTER_MOCK_H_ */
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <sys/hrtimer.h>
+#include "counter_mock.h"
+
+#ifdef CONFIG_POSIX_HRTIMER
+#include <posix/time.h>
+#endif
+
+#define PERIOD_MS 40
+
+static struct sys_hrtimer timer;
+static K_SEM_DEFINE(expired, 0, 1);
+static int64_t expired_at;
+static atomic_t count;
+
+static void oneshot_handler(struct sys_hrtimer *t)
+{
+	expired_at = k_uptime_ticks();
+	k_sem_give(&expired);
+}
+
+static void periodic_handler(struct sys_hrtimer *t)
+{
+	atomic_inc(&count);
+}
+
+static void stopping_handler(struct sys_hrtimer *t)
+{
+	if (atomic_inc(&count) == 2) {
+		sys_hrtimer_stop(t);
+	}
+}
+
+/* A timer longer than two counter wraps expires on time */
+void test_hrtimer_wrap(void)
+{
+	int64_t start;
+
+	k_sem_reset(&expired);
+	sys_hrtimer_init(&timer, oneshot_handler, NULL);
+
+	start = k_uptime_ticks();
+	zassert_equal(sys_hrtimer_start(&timer, 2500ULL * NSEC_PER_MSEC, 0), 0,
+		      "failed to start timer");
+
+	k_sleep(K_MSEC(1200));
+	zassert_within(sys_hrtimer_remaining_ns(&timer),
+		       1300ULL * NSEC_PER_MSEC,
+		       2ULL * NSEC_PER_SEC / COUNTER_MOCK_FREQ,
+		       "wrong remaining time across a wrap");
+
+	zassert_equal(k_sem_take(&expired, K_MSEC(2000)), 0,
+		      "timer did not expire");
+	zassert_true(expired_at - start >= k_ms_to_ticks_ceil64(2500),
+		     "timer expired early");
+	zassert_true(expired_at - start <= k_ms_to_ticks_ceil64(2500) + 3,
+		     "timer expired late");
+	zassert_equal(sys_hrtimer_remaining_ns(&timer), 0,
+		      "expired timer still running");
+}
+
+/* Expiries missed while the counter interrupt is held all run at once,
+ * and the following ones stay on the original period.
+ */
+void test_hrtimer_periodic_catch_up(void)
+{
+	uint64_t remaining;
+	unsigned int key;
+
+	atomic_set(&count, 0);
+	sys_hrtimer_init(&timer, periodic_handler, NULL);
+	zassert_equal(sys_hrtimer_start(&timer, PERIOD_MS * NSEC_PER_MSEC,
+					PERIOD_MS * NSEC_PER_MSEC), 0,
+		      "failed to start timer");
+
+	/* 1.5 periods, then hold the interrupts over three more */
+	k_sleep(K_MSEC(PERIOD_MS * 3 / 2));
+	zassert_equal(atomic_get(&count), 1, "timer did not expire");
+
+	key = irq_lock();
+	k_busy_wait(PERIOD_MS * 3 * USEC_PER_MSEC);
+	irq_unlock(key);
+
+	zassert_equal(atomic_get(&count), 4, "missed expiries not run");
+
+	remaining = sys_hrtimer_remaining_ns(&timer);
+	zassert_true(remaining > 0 && remaining <= PERIOD_MS * NSEC_PER_MSEC,
+		     "next expiry off the period");
+
+	sys_hrtimer_stop(&timer);
+	zassert_equal(sys_hrtimer_remaining_ns(&timer), 0,
+		      "stopped timer still running");
+}
+
+/* A periodic timer stopped from its own handler does not expire again */
+void test_hrtimer_stop_in_handler(void)
+{
+	atomic_set(&count, 0);
+	sys_hrtimer_init(&timer, stopping_handler, NULL);
+	zassert_equal(sys_hrtimer_start(&timer, PERIOD_MS * NSEC_PER_MSEC,
+					PERIOD_MS * NSEC_PER_MSEC), 0,
+		      "failed to start timer");
+
+	k_sleep(K_MSEC(PERIOD_MS * 6));
+	zassert_equal(atomic_get(&count), 3, "timer not stopped by handler");
+	zassert_equal(sys_hrtimer_remaining_ns(&timer), 0,
+		      "stopped timer still running");
+}
+
+void test_hrtimer_sleep(void)
+{
+	int64_t start = k_uptime_ticks();
+
+	zassert_equal(sys_hrtimer_sleep_ns(15 * NSEC_PER_MSEC), 0,
+		      "failed to sleep");
+	zassert_true(k_uptime_ticks() - start >= k_ms_to_ticks_ceil64(15),
+		     "woke up early");
+}
+
+#ifdef CONFIG_POSIX_HRTIMER
+static void posix_handler(union sigval val)
+{
+	k_sem_give(&expired);
+}
+
+/* nanosleep() and the POSIX timers program the counter alarm themselves
+ * rather than waiting for the next half wrap alarm.
+ */
+void test_hrtimer_posix(void)
+{
+	struct timespec req = { .tv_nsec = 5 * NSEC_PER_MSEC };
+	struct sigevent sig = {
+		.sigev_notify = SIGEV_SIGNAL,
+		.sigev_notify_function = posix_handler,
+	};
+	struct itimerspec value = {
+		.it_value = { .tv_nsec = 5 * NSEC_PER_MSEC },
+	};
+	timer_t timerid;
+
+	counter_mock_reset();
+	zassert_equal(nanosleep(&req, NULL), 0, "nanosleep failed");
+	zassert_true(counter_mock_shortest_alarm() <=
+		     k_ms_to_ticks_ceil32(5), "nanosleep not on hrtimer");
+
+	k_sem_reset(&expired);
+	zassert_equal(timer_create(CLOCK_MONOTONIC, &sig, &timerid), 0,
+		      "timer_create failed");
+	counter_mock_reset();
+	zassert_equal(timer_settime(timerid, 0, &value, NULL), 0,
+		      "timer_settime failed");
+	zassert_equal(k_sem_take(&expired, K_MSEC(100)), 0,
+		      "POSIX timer did not expire");
+	zassert_true(counter_mock_shortest_alarm() <=
+		     k_ms_to_ticks_ceil32(5), "POSIX timer not on hrtimer");
+	zassert_equal(timer_delete(timerid), 0, "timer_delete failed");
+}
+#else
+void test_hrtimer_posix(void)
+{
+	ztest_test_skip();
+}
+#endif
+
+void test_main(void)
+{
+	ztest_test_suite(hrtimer,
+			 ztest_unit_test(test_hrtimer_wrap),
+			 ztest_unit_test(test_hrtimer_periodic_catch_up),
+			 ztest_unit_test(test_hrtimer_stop_in_handler),
+			 ztest_unit_test(test_hrtimer_sleep),
+			 ztest_unit_test(test_hrtimer_posix));
+	ztest_run_test_suite(hrtimer);
+}
@@ -8,6 +8,9 @@
 #include <stdbool.h>
 #include <ztest.h>
 #include <data/json.h>
+#if defined(CONFIG_NET_BUF)
+#include <net/buf.h>
+#endif
 
 struct test_nested {
 	int nested_int;
@@ -539,6 +542,176 @@ static void test_json_encode_bounds_check(void)
 	zassert_equal(ret, -ENOMEM, "Bounds check rejected");
 }
 
+struct stream_trace {
+	char buf[128];
+	size_t len;
+	int abort_at;
+};
+
+static int stream_record(const struct json_stream_event *event,
+			 void *user_data)
+{
+	struct stream_trace *trace = user_data;
+	int ret;
+
+	if (trace->abort_at-- == 0) {
+		return -ECANCELED;
+	}
+
+	ret = snprintk(trace->buf + trace->len, sizeof(trace->buf) - trace->len,
+		       "%c%s%.*s%s%s%.*s ", (char)event->type,
+		       event->key ? "(" : "", (int)event->key_len,
+		       event->key ? event->key : "", event->key ? ")" : "",
+		       event->value ? "=" : "", (int)event->value_len,
+		       event->value ? event->value : "");
+	trace->len += ret;
+
+	return 0;
+}
+
+static const char stream_doc[] =
+	"{\"a\":[1, -2.5e3,true],\"b\" : {\"c\":\"x\\\"\\u00e9\"},"
+	"\"d\":null,\"e\":[],\"f\":false}";
+static const char stream_expected[] =
+	"{ [(a) 0=1 0=-2.5e3 t ] {(b) \"(c)=x\\\"\\u00e9 } n(d) [(e) ] f(f) } ";
+
+static int stream_parse(const char *doc, size_t chunk, char *scratch,
+			size_t scratch_size, struct stream_trace *trace)
+{
+	struct json_stream_parser parser;
+	size_t len = strlen(doc);
+	size_t off;
+	int ret;
+
+	json_stream_init(&parser, scratch, scratch_size, stream_record, trace);
+
+	for (off = 0; off < len; off += chunk) {
+		ret = json_stream_feed(&parser, doc + off, MIN(chunk, len - off));
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return json_stream_finish(&parser);
+}
+
+static void test_json_stream(void)
+{
+	struct stream_trace trace;
+	char scratch[16];
+	size_t chunk;
+	int ret;
+
+	for (chunk = 1; chunk <= sizeof(stream_doc); chunk++) {
+		trace = (struct stream_trace) { .abort_at = -1 };
+		ret = stream_parse(stream_doc, chunk, scratch, sizeof(scratch),
+				   &trace);
+		zassert_equal(ret, 0, "Stream parse failed with chunk %zu",
+			      chunk);
+		zassert_true(!strcmp(trace.buf, stream_expected),
+			     "Unexpected events: %s", trace.buf);
+	}
+}
+
+static void test_json_stream_scalar(void)
+{
+	struct stream_trace trace = { .abort_at = -1 };
+	char scratch[8];
+
+	zassert_equal(stream_parse(" 42 ", 1, scratch, sizeof(scratch),
+				   &trace), 0, "Top-level number rejected");
+	zassert_true(!strcmp(trace.buf, "0=42 "), "Unexpected events");
+
+	trace = (struct stream_trace) { .abort_at = -1 };
+	zassert_equal(stream_parse("42", 2, scratch, sizeof(scratch),
+				   &trace), 0, "Unterminated number rejected");
+	zassert_true(!strcmp(trace.buf, "0=42 "), "Unexpected events");
+}
+
+static void test_json_stream_errors(void)
+{
+	static const char *const invalid[] = {
+		"{\"a\":1", "{\"a\" 1}", "[1,]", "{,}", "[1 2]", "[tru]",
+		"\"\\x\"", "\"\\u12g4\"", "[-]", "{} {}", "{\"a\":1]", "",
+	};
+	struct stream_trace trace;
+	char scratch[16];
+	size_t i;
+
+	for (i = 0; i < ARRAY_SIZE(invalid); i++) {
+		trace = (struct stream_trace) { .abort_at = -1 };
+		zassert_equal(stream_parse(invalid[i], 1, scratch,
+					   sizeof(scratch), &trace), -EINVAL,
+			      "Accepted invalid document %s", invalid[i]);
+	}
+
+	trace = (struct stream_trace) { .abort_at = -1 };
+	zassert_equal(stream_parse("{\"key\":\"value\"}", 1, scratch, 7,
+				   &trace), -ENOMEM,
+		      "Token larger than scratch buffer accepted");
+
+	trace = (struct stream_trace) { .abort_at = 2 };
+	zassert_equal(stream_parse("[1,2,3]", 1, scratch, sizeof(scratch),
+				   &trace), -ECANCELED,
+		      "Callback error not propagated");
+	zassert_true(!strcmp(trace.buf, "[ 0=1 "), "Parser not stopped");
+}
+
+#if defined(CONFIG_NET_BUF)
+NET_BUF_POOL_DEFINE(json_frag_pool, 16, 8, 0, NULL);
+
+static void test_json_stream_net_buf(void)
+{
+	struct obj_array obj = {
+		.elements = { { "Sim", 175 }, { "Ruth", 169 } },
+		.num_elements = 2,
+	};
+	struct json_net_buf_appender appender = {
+		.pool = &json_frag_pool,
+		.timeout = K_NO_WAIT,
+	};
+	struct json_stream_parser parser;
+	struct stream_trace trace = { .abort_at = -1 };
+	char scratch[16];
+	int ret;
+
+	appender.buf = net_buf_alloc(&json_frag_pool, K_NO_WAIT);
+	zassert_not_null(appender.buf, "No fragment available");
+
+	ret = json_obj_encode(obj_array_descr, ARRAY_SIZE(obj_array_descr),
+			      &obj, json_append_bytes_to_net_buf, &appender);
+	zassert_equal(ret, 0, "Encoding into net_buf chain failed");
+	zassert_not_null(appender.buf->frags, "Output not fragmented");
+	zassert_equal(net_buf_frags_len(appender.buf),
+		      json_calc_encoded_len(obj_array_descr,
+					    ARRAY_SIZE(obj_array_descr), &obj),
+		      "Unexpected encoded length");
+
+	json_stream_init(&parser, scratch, sizeof(scratch), stream_record,
+			 &trace);
+	zassert_equal(json_stream_feed_net_buf(&parser, appender.buf), 0,
+		      "Parsing net_buf chain failed");
+	zassert_equal(json_stream_finish(&parser), 0, "Document incomplete");
+	zassert_true(!strcmp(trace.buf, "{ [(elements) { \"(name)=Sim "
+			     "0(height)=175 } { \"(name)=Ruth 0(height)=169 } "
+			     "] } "), "Unexpected events: %s", trace.buf);
+
+	net_buf_unref(appender.buf);
+
+	appender.buf = net_buf_alloc(&json_frag_pool, K_NO_WAIT);
+	appender.pool = NULL;
+	ret = json_obj_encode(obj_array_descr, ARRAY_SIZE(obj_array_descr),
+			      &obj, json_append_bytes_to_net_buf, &appender);
+	zassert_equal(ret, -ENOMEM, "Chain grew without a pool");
+	net_buf_unref(appender.buf);
+}
+#else
+static void test_json_stream_net_buf(void)
+{
+	ztest_test_skip();
+}
+#endif
+
 void test_main(void)
 {
 	ztest_test_suite(lib_json_test,
@@ -560,7 +733,11 @@ void test_main(void)
 			 ztest_unit_test(test_json_escape_empty),
 			 ztest_unit_test(test_json_escape_no_op),
 			 ztest_unit_test(test_json_escape_bounds_check),
-			 ztest_unit_test(test_json_encode_bounds_check)
+			 ztest_unit_test(test_json_encode_bounds_check),
+			 ztest_unit_test(test_json_stream),
+			 ztest_unit_test(test_json_stream_scalar),
+			 ztest_unit_test(test_json_stream_errors),
+			 ztest_unit_test(test_json_stream_net_buf)
 			 );
 
 	ztest_run_test_suite(lib_json_test);
@@ -0,0 +1,411 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <irq_offload.h>
+#include <sys/mpsc_pbuf.h>
+
+/**
+ * @defgroup lib_mpsc_pbuf_tests MPSC packet buffer
+ * @ingroup all_tests
+ * @{
+ * @}
+ */
+
+#define BUF_WORDS 32
+/* Packet of two words and its header */
+#define PKT_LEN 8
+#define PKT_WORDS 3
+
+static uint32_t buf_data[BUF_WORDS];
+static struct mpsc_pbuf_buffer buffer;
+
+MPSC_PBUF_DEFINE(static_buffer, 4, 0, NULL);
+
+static uint32_t *put(uint32_t id)
+{
+	uint32_t *pkt;
+
+	pkt = mpsc_pbuf_alloc(&buffer, PKT_LEN);
+	if (pkt) {
+		pkt[0] = id;
+		pkt[1] = ~id;
+		mpsc_pbuf_commit(&buffer, pkt);
+	}
+
+	return pkt;
+}
+
+static uint32_t *get(void)
+{
+	uint32_t *pkt;
+	size_t len;
+
+	pkt = mpsc_pbuf_claim(&buffer, &len);
+	if (pkt) {
+		zassert_equal(len, PKT_LEN, "unexpected length");
+		zassert_equal(pkt[1], ~pkt[0], "corrupted packet");
+	}
+
+	return pkt;
+}
+
+/**
+ * @brief Test allocating, committing, claiming and freeing a packet
+ *
+ * @ingroup lib_mpsc_pbuf_tests
+ */
+void test_mpsc_pbuf_alloc_claim(void)
+{
+	uint8_t *pkt, *claimed;
+	size_t len;
+
+	mpsc_pbuf_init(&buffer, buf_data, BUF_WORDS, 0, NULL);
+
+	zassert_false(mpsc_pbuf_is_pending(&buffer), "not empty");
+
+	pkt = mpsc_pbuf_alloc(&buffer, 5);
+	zassert_not_null(pkt, "allocation failed");
+	memcpy(pkt, "hello", 5);
+
+	zassert_false(mpsc_pbuf_is_pending(&buffer), "uncommitted pending");
+	zassert_is_null(mpsc_pbuf_claim(&buffer, &len),
+			"claimed uncommitted packet");
+
+	mpsc_pbuf_commit(&buffer, pkt);
+	zassert_true(mpsc_pbuf_is_pending(&buffer), "committed not pending");
+
+	claimed = mpsc_pbuf_claim(&buffer, &len);
+	zassert_equal_ptr(claimed, pkt, "unexpected packet");
+	zassert_equal(len, 5, "unexpected length");
+	zassert_mem_equal(claimed, "hello", 5, "unexpected data");
+
+	mpsc_pbuf_free(&buffer, claimed);
+
+	zassert_false(mpsc_pbuf_is_pending(&buffer), "not empty");
+	zassert_equal(mpsc_pbuf_dropped_get(&buffer, false), 0, "dropped");
+}
+
+/**
+ * @brief Test that packets are claimed in allocation order
+ *
+ * @ingroup lib_mpsc_pbuf_tests
+ */
+void test_mpsc_pbuf_order(void)
+{
+	uint32_t *first, *second;
+
+	mpsc_pbuf_init(&buffer, buf_data, BUF_WORDS, 0, NULL);
+
+	first = mpsc_pbuf_alloc(&buffer, PKT_LEN);
+	zassert_not_null(first, "allocation failed");
+	zassert_not_null(put(2), "allocation failed");
+
+	/* The older packet, not committed yet, holds back the newer one */
+	zassert_is_null(get(), "claimed out of order");
+
+	first[0] = 1;
+	first[1] = ~1;
+	mpsc_pbuf_commit(&buffer, first);
+
+	first = get();
+	zassert_equal(first[0], 1, "unexpected packet");
+	mpsc_pbuf_free(&buffer, first);
+
+	second = get();
+	zassert_equal(second[0], 2, "unexpected packet");
+	mpsc_pbuf_free(&buffer, second);
+
+	zassert_is_null(get(), "not empty");
+}
+
+/**
+ * @brief Test that allocations fail when full, and wrap once freed
+ *
+ * @ingroup lib_mpsc_pbuf_tests
+ */
+void test_mpsc_pbuf_full(void)
+{
+	uint32_t *pkt;
+	uint32_t i;
+
+	mpsc_pbuf_init(&buffer, buf_data, BUF_WORDS, 0, NULL);
+
+	for (i = 0; i < BUF_WORDS / PKT_WORDS; i++) {
+		zassert_not_null(put(i), "allocation failed");
+	}
+
+	zassert_is_null(put(i), "allocated in full buffer");
+	zassert_equal(mpsc_pbuf_dropped_get(&buffer, true), 1,
+		      "drop not counted");
+
+	/* Free two packets, the next one is placed at the start of the
+	 * buffer after padding its end.
+	 */
+	for (i = 0; i < 2; i++) {
+		pkt = get();
+		zassert_equal(pkt[0], i, "unexpected packet");
+		mpsc_pbuf_free(&buffer, pkt);
+	}
+
+	pkt = put(BUF_WORDS);
+	zassert_equal_ptr(pkt, &buf_data[1], "packet not wrapped");
+
+	for (i = 2; i < BUF_WORDS / PKT_WORDS; i++) {
+		pkt = get();
+		zassert_equal(pkt[0], i, "unexpected packet");
+		mpsc_pbuf_free(&buffer, pkt);
+	}
+
+	pkt = get();
+	zassert_equal(pkt[0], BUF_WORDS, "padding not skipped");
+	mpsc_pbuf_free(&buffer, pkt);
+
+	zassert_false(mpsc_pbuf_is_pending(&buffer), "not empty");
+	zassert_equal(mpsc_pbuf_dropped_get(&buffer, false), 0, "dropped");
+}
+
+/**
+ * @brief Test that the oldest packets are dropped in overwrite mode
+ *
+ * @ingroup lib_mpsc_pbuf_tests
+ */
+void test_mpsc_pbuf_overwrite(void)
+{
+	uint32_t *pkt;
+	uint32_t count = 0;
+	uint32_t last = 0;
+	uint32_t i;
+
+	mpsc_pbuf_init(&buffer, buf_data, BUF_WORDS, MPSC_PBUF_MODE_OVERWRITE,
+		       NULL);
+
+	for (i = 0; i < 3 * BUF_WORDS; i++) {
+		zassert_not_null(put(i), "allocation failed");
+	}
+
+	while ((pkt = get())) {
+		zassert_true(!count || pkt[0] > last, "unexpected order");
+		last = pkt[0];
+		count++;
+		mpsc_pbuf_free(&buffer, pkt);
+	}
+
+	zassert_equal(last, 3 * BUF_WORDS - 1, "newest packet lost");
+	zassert_equal(count + mpsc_pbuf_dropped_get(&buffer, false),
+		      3 * BUF_WORDS, "drops not counted");
+}
+
+/**
+ * @brief Test that a claimed packet is not overwritten
+ *
+ * @ingroup lib_mpsc_pbuf_tests
+ */
+void test_mpsc_pbuf_overwrite_claimed(void)
+{
+	uint32_t *pkt;
+	uint32_t i;
+
+	mpsc_pbuf_init(&buffer, buf_data, BUF_WORDS, MPSC_PBUF_MODE_OVERWRITE,
+		       NULL);
+
+	for (i = 0; i < BUF_WORDS / PKT_WORDS; i++) {
+		zassert_not_null(put(i), "allocation failed");
+	}
+
+	pkt = get();
+	zassert_equal(pkt[0], 0, "unexpected packet");
+
+	zassert_is_null(put(i), "claimed packet overwritten");
+	zassert_equal(pkt[0], 0, "claimed packet modified");
+
+	mpsc_pbuf_free(&buffer, pkt);
+
+	zassert_not_null(put(i), "allocation failed");
+	pkt = get();
+	zassert_equal(pkt[0], 1, "unexpected packet");
+	mpsc_pbuf_free(&buffer, pkt);
+}
+
+/**
+ * @brief Test freeing claimed packets out of order
+ *
+ * @ingroup lib_mpsc_pbuf_tests
+ */
+void test_mpsc_pbuf_free_any_order(void)
+{
+	uint32_t n = BUF_WORDS / PKT_WORDS;
+	uint32_t *pkt[3];
+	uint32_t i;
+
+	mpsc_pbuf_init(&buffer, buf_data, BUF_WORDS, 0, NULL);
+
+	for (i = 0; i < n; i++) {
+		zassert_not_null(put(i), "allocation failed");
+	}
+
+	for (i = 0; i < ARRAY_SIZE(pkt); i++) {
+		pkt[i] = get();
+		zassert_equal(pkt[i][0], i, "unexpected packet");
+	}
+
+	/* Space is given back once the oldest packet is freed too */
+	mpsc_pbuf_free(&buffer, pkt[2]);
+	mpsc_pbuf_free(&buffer, pkt[1]);
+	zassert_is_null(put(n), "allocated over a claimed packet");
+
+	mpsc_pbuf_free(&buffer, pkt[0]);
+	zassert_not_null(put(n), "allocation failed");
+	zassert_not_null(put(n + 1), "allocation failed");
+
+	for (i = ARRAY_SIZE(pkt); i < n + 2; i++) {
+		pkt[0] = get();
+		zassert_equal(pkt[0][0], i, "unexpected packet");
+		mpsc_pbuf_free(&buffer, pkt[0]);
+	}
+
+	zassert_false(mpsc_pbuf_is_pending(&buffer), "not empty");
+}
+
+/**
+ * @brief Test freeing a packet which was never committed
+ *
+ * @ingroup lib_mpsc_pbuf_tests
+ */
+void test_mpsc_pbuf_free_uncommitted(void)
+{
+	uint32_t *pkt;
+
+	mpsc_pbuf_init(&buffer, buf_data, BUF_WORDS, 0, NULL);
+
+	pkt = mpsc_pbuf_alloc(&buffer, PKT_LEN);
+	zassert_not_null(pkt, "allocation failed");
+	zassert_not_null(put(1), "allocation failed");
+
+	mpsc_pbuf_free(&buffer, pkt);
+
+	pkt = get();
+	zassert_equal(pkt[0], 1, "freed packet not skipped");
+	mpsc_pbuf_free(&buffer, pkt);
+
+	zassert_false(mpsc_pbuf_is_pending(&buffer), "not empty");
+	zassert_equal(atomic_get(&buffer.rd_idx), atomic_get(&buffer.wr_idx),
+		      "space not given back");
+}
+
+static uint32_t drop_count;
+static uint32_t drop_last;
+
+static void drop(struct mpsc_pbuf_buffer *buf, void *packet, size_t len)
+{
+	uint32_t *pkt = packet;
+
+	zassert_equal_ptr(buf, &buffer, "unexpected buffer");
+	zassert_equal(len, PKT_LEN, "unexpected length");
+	zassert_true(!drop_count || pkt[0] > drop_last, "unexpected order");
+
+	drop_last = pkt[0];
+	drop_count++;
+}
+
+/**
+ * @brief Test that dropped packets are notified
+ *
+ * @ingroup lib_mpsc_pbuf_tests
+ */
+void test_mpsc_pbuf_overwrite_drop(void)
+{
+	uint32_t *pkt;
+	uint32_t i;
+
+	mpsc_pbuf_init(&buffer, buf_data, BUF_WORDS, MPSC_PBUF_MODE_OVERWRITE,
+		       drop);
+	drop_count = 0U;
+
+	for (i = 0; i < 2 * BUF_WORDS; i++) {
+		zassert_not_null(put(i), "allocation failed");
+	}
+
+	zassert_equal(drop_count, mpsc_pbuf_dropped_get(&buffer, false),
+		      "drops not notified");
+
+	pkt = get();
+	zassert_equal(pkt[0], drop_last + 1, "oldest packet not dropped");
+	mpsc_pbuf_free(&buffer, pkt);
+}
+
+static void isr_put(const void *arg)
+{
+	zassert_not_null(put((uint32_t)(uintptr_t)arg), "allocation failed");
+}
+
+/**
+ * @brief Test producing packets from ISR context
+ *
+ * @ingroup lib_mpsc_pbuf_tests
+ */
+void test_mpsc_pbuf_isr(void)
+{
+	uint32_t *pkt;
+	uint32_t i;
+
+	mpsc_pbuf_init(&buffer, buf_data, BUF_WORDS, 0, NULL);
+
+	for (i = 0; i < 4; i++) {
+		if (i & 1) {
+			irq_offload(isr_put, (const void *)(uintptr_t)i);
+		} else {
+			zassert_not_null(put(i), "allocation failed");
+		}
+	}
+
+	for (i = 0; i < 4; i++) {
+		pkt = get();
+		zassert_equal(pkt[0], i, "unexpected packet");
+		mpsc_pbuf_free(&buffer, pkt);
+	}
+}
+
+/**
+ * @brief Test a statically defined packet buffer
+ *
+ * @ingroup lib_mpsc_pbuf_tests
+ */
+void test_mpsc_pbuf_define(void)
+{
+	uint32_t *pkt, *claimed;
+	size_t len;
+
+	pkt = mpsc_pbuf_alloc(&static_buffer, 15 * sizeof(uint32_t));
+	zassert_not_null(pkt, "allocation failed");
+	zassert_is_null(mpsc_pbuf_alloc(&static_buffer, 0),
+			"allocated in full buffer");
+
+	mpsc_pbuf_commit(&static_buffer, pkt);
+
+	claimed = mpsc_pbuf_claim(&static_buffer, &len);
+	zassert_equal_ptr(claimed, pkt, "unexpected packet");
+	zassert_equal(len, 15 * sizeof(uint32_t), "unexpected length");
+	mpsc_pbuf_free(&static_buffer, claimed);
+}
+
+/*test case main entry*/
+void test_main(void)
+{
+	ztest_test_suite(test_mpsc_pbuf_api,
+			 ztest_unit_test(test_mpsc_pbuf_alloc_claim),
+			 ztest_unit_test(test_mpsc_pbuf_order),
+			 ztest_unit_test(test_mpsc_pbuf_full),
+			 ztest_unit_test(test_mpsc_pbuf_overwrite),
+			 ztest_unit_test(test_mpsc_pbuf_overwrite_claimed),
+			 ztest_unit_test(test_mpsc_pbuf_free_any_order),
+			 ztest_unit_test(test_mpsc_pbuf_free_uncommitted),
+			 ztest_unit_test(test_mpsc_pbuf_overwrite_drop),
+			 ztest_unit_test(test_mpsc_pbuf_isr),
+			 ztest_unit_test(test_mpsc_pbuf_define)
+			 );
+	ztest_run_test_suite(test_mpsc_pbuf_api);
+}
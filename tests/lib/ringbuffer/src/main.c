@@ -518,6 +518,169 @@ void test_ringbuffer_array_perf(void)
 	zassert_equal(sizeof(tp), sizeof(ringbuf_stored[0]), NULL);
 }
 
+#define RINGBUFFER_POW2_SIZE 8
+
+RING_BUF_DECLARE(ringbuf_pow2_raw, RINGBUFFER_POW2_SIZE);
+
+/**
+ * @brief Test byte mode ring buffer with a power of 2 size
+ *
+ * @details RING_BUF_DECLARE() sets up the masking fast path for a power
+ * of 2 size; data must still wrap around the end of the buffer.
+ *
+ * @ingroup lib_ringbuffer_tests
+ *
+ * @see RING_BUF_DECLARE(), ring_buf_put(), ring_buf_get()
+ */
+void test_ringbuffer_pow2_raw(void)
+{
+	uint8_t indata[RINGBUFFER_POW2_SIZE] = {1, 2, 3, 4, 5, 6, 7};
+	uint8_t outdata[RINGBUFFER_POW2_SIZE];
+
+	zassert_equal(ringbuf_pow2_raw.mask, RINGBUFFER_POW2_SIZE - 1, NULL);
+
+	for (int i = 0; i < 3; i++) {
+		zassert_equal(ring_buf_put(&ringbuf_pow2_raw, indata, 5), 5,
+			      NULL);
+		zassert_equal(ring_buf_get(&ringbuf_pow2_raw, outdata,
+					   sizeof(outdata)), 5, NULL);
+		zassert_mem_equal(outdata, indata, 5, NULL);
+	}
+
+	zassert_equal(ring_buf_put(&ringbuf_pow2_raw, indata,
+				   sizeof(indata)), RINGBUFFER_POW2_SIZE - 1,
+		      NULL);
+	zassert_equal(ring_buf_space_get(&ringbuf_pow2_raw), 0, NULL);
+	zassert_equal(ring_buf_get(&ringbuf_pow2_raw, outdata,
+				   sizeof(outdata)), RINGBUFFER_POW2_SIZE - 1,
+		      NULL);
+	zassert_mem_equal(outdata, indata, RINGBUFFER_POW2_SIZE - 1, NULL);
+}
+
+/**
+ * @brief Test multi-producer and multi-consumer claims
+ *
+ * @details Data of overlapping claims is published only once every
+ * claim is finished, and space is given back the same way.
+ *
+ * @ingroup lib_ringbuffer_tests
+ *
+ * @see ring_buf_mp_put_claim(), ring_buf_mp_put_finish(),
+ * ring_buf_mc_get_claim(), ring_buf_mc_get_finish()
+ */
+void test_ringbuffer_mp_mc_claim(void)
+{
+	uint8_t outdata[RINGBUFFER_POW2_SIZE];
+	uint8_t *first, *second;
+
+	ring_buf_init(&ringbuf_pow2_raw, RINGBUFFER_POW2_SIZE,
+		      ringbuf_pow2_raw.buf.buf8);
+
+	zassert_equal(ring_buf_mp_put_claim(&ringbuf_pow2_raw, &first, 2), 2,
+		      NULL);
+	zassert_equal(ring_buf_mp_put_claim(&ringbuf_pow2_raw, &second, 8),
+		      5, NULL);
+	zassert_equal(second, first + 2, NULL);
+	zassert_equal(ring_buf_mp_put_claim(&ringbuf_pow2_raw, &first, 1), 0,
+		      NULL);
+
+	memcpy(second, "cdefg", 5);
+	ring_buf_mp_put_finish(&ringbuf_pow2_raw);
+	zassert_true(ring_buf_is_empty(&ringbuf_pow2_raw),
+		     "data published before all claims were finished");
+
+	memcpy(first, "ab", 2);
+	ring_buf_mp_put_finish(&ringbuf_pow2_raw);
+	zassert_equal(ring_buf_space_get(&ringbuf_pow2_raw), 0, NULL);
+
+	zassert_equal(ring_buf_mc_get_claim(&ringbuf_pow2_raw, &first, 3), 3,
+		      NULL);
+	zassert_equal(ring_buf_mc_get_claim(&ringbuf_pow2_raw, &second, 3), 3,
+		      NULL);
+	zassert_mem_equal(first, "abc", 3, NULL);
+	zassert_mem_equal(second, "def", 3, NULL);
+
+	ring_buf_mc_get_finish(&ringbuf_pow2_raw);
+	zassert_equal(ring_buf_space_get(&ringbuf_pow2_raw), 0,
+		      "space freed before all claims were finished");
+	ring_buf_mc_get_finish(&ringbuf_pow2_raw);
+	zassert_equal(ring_buf_space_get(&ringbuf_pow2_raw), 6, NULL);
+
+	zassert_equal(ring_buf_mp_put(&ringbuf_pow2_raw, "hijklm", 6), 6,
+		      NULL);
+	zassert_equal(ring_buf_mc_get(&ringbuf_pow2_raw, outdata,
+				      sizeof(outdata)), 7, NULL);
+	zassert_mem_equal(outdata, "ghijklm", 7, NULL);
+}
+
+#define SPSC_STACK_SIZE (640 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define SPSC_BYTES 4096
+
+static K_THREAD_STACK_DEFINE(spsc_stack, SPSC_STACK_SIZE);
+static struct k_thread spsc_thread;
+
+static void spsc_producer(void *p1, void *p2, void *p3)
+{
+	uint32_t sent = 0U;
+	uint32_t granted;
+	uint8_t *data;
+
+	while (sent < SPSC_BYTES) {
+		granted = ring_buf_put_claim(&ringbuf_pow2_raw, &data,
+					     SPSC_BYTES - sent);
+		for (uint32_t i = 0U; i < granted; i++) {
+			data[i] = (uint8_t)(sent + i);
+		}
+		zassert_equal(ring_buf_put_finish(&ringbuf_pow2_raw, granted),
+			      0, NULL);
+		sent += granted;
+		if (granted == 0U) {
+			k_yield();
+		}
+	}
+}
+
+/**
+ * @brief Test one producer and one consumer without locking
+ *
+ * @details A producer thread and the test thread stream bytes through a
+ * ring buffer using the claim API concurrently; on SMP they run on
+ * different CPUs. The consumer checks the byte sequence.
+ *
+ * @ingroup lib_ringbuffer_tests
+ *
+ * @see ring_buf_put_claim(), ring_buf_get_claim()
+ */
+void test_ringbuffer_spsc(void)
+{
+	uint32_t received = 0U;
+	uint32_t granted;
+	uint8_t *data;
+
+	ring_buf_init(&ringbuf_pow2_raw, RINGBUFFER_POW2_SIZE,
+		      ringbuf_pow2_raw.buf.buf8);
+
+	k_thread_create(&spsc_thread, spsc_stack, SPSC_STACK_SIZE,
+			spsc_producer, NULL, NULL, NULL,
+			k_thread_priority_get(k_current_get()), 0, K_NO_WAIT);
+
+	while (received < SPSC_BYTES) {
+		granted = ring_buf_get_claim(&ringbuf_pow2_raw, &data,
+					     SPSC_BYTES - received);
+		for (uint32_t i = 0U; i < granted; i++) {
+			zassert_equal(data[i], (uint8_t)(received + i),
+				      "byte %u corrupted", received + i);
+		}
+		zassert_equal(ring_buf_get_finish(&ringbuf_pow2_raw, granted),
+			      0, NULL);
+		received += granted;
+		if (granted == 0U) {
+			k_yield();
+		}
+	}
+
+	k_thread_join(&spsc_thread, K_FOREVER);
+}
 
 /*test case main entry*/
 void test_main(void)
@@ -538,7 +701,10 @@ void test_main(void)
 			 ztest_unit_test(test_byte_put_free),
 			 ztest_unit_test(test_byte_put_free),
 			 ztest_unit_test(test_capacity),
-			 ztest_unit_test(test_reset)
+			 ztest_unit_test(test_reset),
+			 ztest_unit_test(test_ringbuffer_pow2_raw),
+			 ztest_unit_test(test_ringbuffer_mp_mc_claim),
+			 ztest_unit_test(test_ringbuffer_spsc)
 			 );
 	ztest_run_test_suite(test_ringbuffer_api);
 }
@@ -14,6 +14,7 @@
 #include <ztest.h>
 #include <stdio.h>
 #include <stdarg.h>
+#include <limits.h>
 
 #define DEADBEEF  0xdeadbeef
 
@@ -283,6 +284,7 @@ void test_sprintf_double(void)
 
 	/*******************/
 	var.d = 1234000000.0;
+#ifndef CONFIG_MINIMAL_LIBC_SHORTEST_FLOAT_PRINTF
 	sprintf(buffer, "%g", var.d);
 	zassert_true((strcmp(buffer, "1.234e+09") == 0),
 		     "sprintf(1.234e+09) - incorrect "
@@ -292,6 +294,12 @@ void test_sprintf_double(void)
 	zassert_true((strcmp(buffer, "1.234E+09") == 0),
 		     "sprintf(1.234E+09) - incorrect "
 		     "output '%s'\n", buffer);
+#endif
+
+	sprintf(buffer, "%.4g", var.d);
+	zassert_true((strcmp(buffer, "1.234e+09") == 0),
+		     "sprintf(1.234e+09) - incorrect "
+		     "output '%s'\n", buffer);
 
 	var.d = 150.0;
 	sprintf(buffer, "%#.3g", var.d);
@@ -325,12 +333,76 @@ void test_sprintf_double(void)
 
 	var.u1 = 0x00000001;
 	var.u2 = 0x00000000;    /* smallest denormal value */
-	sprintf(buffer, "%g", var.d);
+	sprintf(buffer, "%.6g", var.d);
 	zassert_true((strcmp(buffer, "4.94066e-324") == 0),
 		     "sprintf(4.94066e-324) - incorrect "
 		     "output '%s'\n", buffer);
 }
 
+/**
+ *
+ * @brief Test sprintf with the shortest round trip %g
+ *
+ * The expected strings read back to the same doubles with strtod().
+ */
+
+void test_sprintf_shortest_double(void)
+{
+	static const struct {
+		const char *format;
+		double d;
+		const char *expected;
+	} tests[] = {
+		{ "%g", 0.1, "0.1" },
+		{ "%g", 1.0 / 3.0, "0.3333333333333333" },
+		{ "%g", 123.456, "123.456" },
+		{ "%g", 9007199254740993.0, "9007199254740992" },
+		{ "%g", -1.25e-7, "-1.25e-07" },
+		{ "%g", 0.0, "0" },
+		{ "%g", -0.0, "-0" },
+		/* fixed notation for decimal exponents -4 to 16, as %.17g */
+		{ "%g", 1e-5, "1e-05" },
+		{ "%g", 1e-4, "0.0001" },
+		{ "%g", 1.0, "1" },
+		{ "%g", 1234000000.0, "1234000000" },
+		{ "%g", 1e16, "10000000000000000" },
+		{ "%g", 1e17, "1e+17" },
+		{ "%g", 1e22, "1e+22" },
+		/* read back exactly, but one of the few non shortest outputs */
+		{ "%g", 1e23, "9.999999999999999e+22" },
+		{ "%g", 1e-300, "1e-300" },
+		{ "%g", 1e300, "1e+300" },
+		{ "%g", 1.7976931348623157e308, "1.7976931348623157e+308" },
+		/* smallest normal, then denormals */
+		{ "%g", 2.2250738585072014e-308, "2.2250738585072014e-308" },
+		{ "%g", 2.2250738585072009e-308, "2.225073858507201e-308" },
+		{ "%g", 1e-320, "1e-320" },
+		{ "%g", 1.5e-323, "1.5e-323" },
+		{ "%g", 4.9406564584124654e-324, "5e-324" },
+		{ "%G", 1e-10, "1E-10" },
+		{ "%+g", 1.5, "+1.5" },
+		{ "%10g", 0.5, "       0.5" },
+		{ "%-8g", 0.25, "0.25    " },
+		/* an explicit precision keeps the C output */
+		{ "%.6g", 0.1, "0.1" },
+		{ "%.3g", 1e16, "1e+16" },
+	};
+	char buffer[64];
+	int i;
+
+#if !defined(CONFIG_FPU) || !defined(CONFIG_MINIMAL_LIBC_SHORTEST_FLOAT_PRINTF)
+	ztest_test_skip();
+	return;
+#endif
+
+	for (i = 0; i < ARRAY_SIZE(tests); i++) {
+		sprintf(buffer, tests[i].format, tests[i].d);
+		zassert_true((strcmp(buffer, tests[i].expected) == 0),
+			     "sprintf(%s) - incorrect output '%s'\n",
+			     tests[i].expected, buffer);
+	}
+}
+
 /**
  * @brief A test wrapper for vsnprintf()
  */
@@ -646,6 +718,35 @@ void test_sprintf_integer(void)
 	zassert_true((strcmp(buffer, "+1") == 0),
 		     "sprintf(%%+d). Expected '+1', got '%s'\n", buffer);
 
+	/*******************/
+	len = sprintf(buffer, "%d", INT_MIN);
+	zassert_true((len == 11),
+		     "sprintf(%%d).  Expected %d bytes written, not %d\n",
+		     11, len);
+
+	zassert_true((strcmp(buffer, "-2147483648") == 0),
+		     "sprintf(%%d). Expected '-2147483648', got '%s'\n",
+		     buffer);
+
+	/*******************/
+	len = sprintf(buffer, "%u", UINT32_MAX);
+	zassert_true((len == 10),
+		     "sprintf(%%u).  Expected %d bytes written, not %d\n",
+		     10, len);
+
+	zassert_true((strcmp(buffer, "4294967295") == 0),
+		     "sprintf(%%u). Expected '4294967295', got '%s'\n",
+		     buffer);
+
+	/*******************/
+	sprintf(buffer, "%u %u %u %u %u", 0, 9, 10, 99, 100);
+	zassert_true((strcmp(buffer, "0 9 10 99 100") == 0),
+		     "sprintf(%%u). Expected '0 9 10 99 100', got '%s'\n",
+		     buffer);
+
+	sprintf(buffer, "%05u", 42);
+	zassert_true((strcmp(buffer, "00042") == 0),
+		     "sprintf(%%05u). Expected '00042', got '%s'\n", buffer);
 }
 
 /**
@@ -687,6 +788,7 @@ void test_main(void)
 {
 	ztest_test_suite(test_sprintf,
 			 ztest_unit_test(test_sprintf_double),
+			 ztest_unit_test(test_sprintf_shortest_double),
 			 ztest_unit_test(test_sprintf_integer),
 			 ztest_unit_test(test_vsprintf),
 			 ztest_unit_test(test_vsnprintf),
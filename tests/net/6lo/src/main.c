@@ -1156,6 +1156,9 @@ void test_loop(void)
 		TC_START(tests[count].name);
 
 		test_6lo(tests[count].data);
+
+		/* Same flow again, now compressed from the header cache */
+		test_6lo(tests[count].data);
 	}
 	net_pkt_print();
 }
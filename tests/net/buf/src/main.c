@@ -457,6 +457,52 @@ static void test_net_buf_var_pool(void)
 	zassert_equal(destroy_called, 3, "Incorrect destroy callback count");
 }
 
+static void test_net_buf_slice(void)
+{
+	static const uint8_t data[] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+	struct net_buf *buf, *slice, *frag;
+
+	destroy_called = 0;
+
+	buf = net_buf_alloc_len(&fixed_pool, 64, K_NO_WAIT);
+	zassert_not_null(buf, "Failed to get buffer");
+	net_buf_add_mem(buf, data, sizeof(data));
+
+	slice = net_buf_slice(buf, 2, 4, K_NO_WAIT);
+	zassert_not_null(slice, "Failed to get slice");
+	zassert_equal(slice->data, buf->data + 2, "Slice data is a copy");
+	zassert_equal(slice->len, 4, "Invalid slice length");
+	zassert_equal(net_buf_tailroom(slice), 0, "Slice has tailroom");
+
+	/* The data of the buffer must outlive it while sliced */
+	net_buf_unref(buf);
+	zassert_equal(destroy_called, 0, "Sliced buffer destroyed");
+	zassert_mem_equal(slice->data, &data[2], 4, "Invalid slice data");
+
+	/* A slice of a slice references the same data */
+	frag = net_buf_slice(slice, 1, 2, K_NO_WAIT);
+	zassert_not_null(frag, "Failed to get slice");
+	zassert_equal(frag->data, slice->data + 1, "Slice data is a copy");
+
+	net_buf_unref(slice);
+	zassert_equal(destroy_called, 1, "Incorrect destroy callback count");
+
+	/* Slices can be chained like any other buffer */
+	buf = net_buf_alloc_len(&var_pool, 64, K_NO_WAIT);
+	zassert_not_null(buf, "Failed to get buffer");
+	net_buf_add_mem(buf, data, sizeof(data));
+
+	slice = net_buf_slice(buf, 0, 1, K_NO_WAIT);
+	zassert_not_null(slice, "Failed to get slice");
+	net_buf_frag_add(slice, frag);
+	zassert_equal(net_buf_frags_len(slice), 3, "Invalid chain length");
+
+	net_buf_unref(buf);
+	net_buf_unref(slice);
+
+	zassert_equal(destroy_called, 5, "Incorrect destroy callback count");
+}
+
 static void test_net_buf_byte_order(void)
 {
 	struct net_buf *buf;
@@ -585,6 +631,7 @@ void test_main(void)
 			 ztest_unit_test(test_net_buf_clone),
 			 ztest_unit_test(test_net_buf_fixed_pool),
 			 ztest_unit_test(test_net_buf_var_pool),
+			 ztest_unit_test(test_net_buf_slice),
 			 ztest_unit_test(test_net_buf_byte_order)
 			 );
 
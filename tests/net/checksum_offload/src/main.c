@@ -75,10 +75,12 @@ static struct net_context *udp_v6_ctx_1;
 static struct net_context *udp_v6_ctx_2;
 static struct net_context *udp_v4_ctx_1;
 static struct net_context *udp_v4_ctx_2;
+static struct net_context *udp_v4_ctx_3;
 
 static bool test_failed;
 static bool test_started;
 static bool start_receiving;
+static bool rx_chksum_verified;
 
 static K_SEM_DEFINE(wait_data, 0, UINT_MAX);
 
@@ -182,6 +184,14 @@ static int eth_tx_offloading_disabled(struct device *dev, struct net_pkt *pkt)
 		udp_hdr->src_port = udp_hdr->dst_port;
 		udp_hdr->dst_port = port;
 
+		if (rx_chksum_verified) {
+			/* The stack must trust the checksum check done by
+			 * the "hardware" and not verify it again.
+			 */
+			udp_hdr->chksum ^= htons(0x0100);
+			net_pkt_set_chksum_state(pkt, NET_PKT_CHKSUM_VERIFIED);
+		}
+
 		memcpy(lladdr,
 		       ((struct net_eth_hdr *)net_pkt_data(pkt))->src.addr,
 		       sizeof(lladdr));
@@ -208,6 +218,8 @@ static int eth_tx_offloading_disabled(struct device *dev, struct net_pkt *pkt)
 		DBG("Chksum 0x%x offloading disabled\n", chksum);
 
 		zassert_not_equal(chksum, 0, "Checksum calculated");
+		zassert_equal(net_pkt_chksum_state(pkt), NET_PKT_CHKSUM_NONE,
+			      "Checksum marked pending");
 
 		k_sem_give(&wait_data);
 	}
@@ -236,6 +248,9 @@ static int eth_tx_offloading_enabled(struct device *dev, struct net_pkt *pkt)
 		DBG("Chksum 0x%x offloading enabled\n", chksum);
 
 		zassert_equal(chksum, 0, "Checksum calculated");
+		zassert_equal(net_pkt_chksum_state(pkt),
+			      NET_PKT_CHKSUM_PENDING,
+			      "Checksum not marked pending");
 
 		k_sem_give(&wait_data);
 	}
@@ -926,6 +941,69 @@ static void test_rx_chksum_offload_enabled_test_v4(void)
 	k_sleep(K_MSEC(10));
 }
 
+/* The interface does not offload checksums, but the packet is marked as
+ * verified by the driver so a bad UDP checksum must go unnoticed.
+ */
+static void test_rx_chksum_verified_test_v4(void)
+{
+	struct net_if *iface;
+	int ret, len;
+	struct sockaddr_in dst_addr4 = {
+		.sin_family = AF_INET,
+		.sin_port = htons(TEST_PORT),
+	};
+	struct sockaddr_in src_addr4 = {
+		.sin_family = AF_INET,
+		.sin_port = 0,
+	};
+
+	ret = net_context_get(AF_INET, SOCK_DGRAM, IPPROTO_UDP,
+			      &udp_v4_ctx_3);
+	zassert_equal(ret, 0, "Create IPv4 UDP context failed");
+
+	memcpy(&src_addr4.sin_addr, &in4addr_my, sizeof(struct in_addr));
+	memcpy(&dst_addr4.sin_addr, &in4addr_dst, sizeof(struct in_addr));
+
+	ret = net_context_bind(udp_v4_ctx_3, (struct sockaddr *)&src_addr4,
+			       sizeof(struct sockaddr_in));
+	zassert_equal(ret, 0, "Context bind failure test failed");
+
+	iface = eth_interfaces[0];
+	zassert_equal_ptr(&eth_context_offloading_disabled,
+			  net_if_get_device(iface)->data,
+			  "eth context mismatch");
+
+	len = strlen(test_data);
+
+	test_started = true;
+	start_receiving = true;
+	rx_chksum_verified = true;
+
+	ret = net_context_recv(udp_v4_ctx_3, recv_cb_offload_disabled,
+			       K_NO_WAIT, NULL);
+	zassert_equal(ret, 0, "Recv UDP failed (%d)\n", ret);
+
+	/* Keep start_receiving set so that the packet is looped back */
+	ret = net_context_sendto(udp_v4_ctx_3, test_data, len,
+				 (struct sockaddr *)&dst_addr4,
+				 sizeof(struct sockaddr_in),
+				 NULL, K_FOREVER, NULL);
+	zassert_equal(ret, len, "Send UDP pkt failed (%d)\n", ret);
+
+	if (k_sem_take(&wait_data, WAIT_TIME)) {
+		DBG("Timeout while waiting interface data\n");
+		zassert_false(true, "Timeout");
+	}
+
+	/* Let the receiver to receive the packets */
+	k_sleep(K_MSEC(10));
+
+	start_receiving = false;
+	rx_chksum_verified = false;
+
+	net_context_unref(udp_v4_ctx_3);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(net_chksum_offload_test,
@@ -938,7 +1016,8 @@ void test_main(void)
 			 ztest_unit_test(test_rx_chksum_offload_disabled_test_v6),
 			 ztest_unit_test(test_rx_chksum_offload_disabled_test_v4),
 			 ztest_unit_test(test_rx_chksum_offload_enabled_test_v6),
-			 ztest_unit_test(test_rx_chksum_offload_enabled_test_v4)
+			 ztest_unit_test(test_rx_chksum_offload_enabled_test_v4),
+			 ztest_unit_test(test_rx_chksum_verified_test_v4)
 			 );
 
 	ztest_run_test_suite(net_chksum_offload_test);
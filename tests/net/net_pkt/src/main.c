@@ -630,6 +630,131 @@ void test_net_pkt_copy(void)
 		     "Pkt not properly unreferenced");
 }
 
+#define COPY_CHKSUM_TEST_DATA_SIZE 600
+#define COPY_CHKSUM_TEST_OFFSET 3
+
+static uint16_t test_chksum(const uint8_t *data, size_t len)
+{
+	uint32_t sum = 0U;
+	size_t i;
+
+	for (i = 0; i < len; i++) {
+		sum += (i % 2) ? data[i] : data[i] << 8;
+	}
+
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return sum;
+}
+
+void test_net_pkt_copy_chksum(void)
+{
+	static uint8_t pkt_data[COPY_CHKSUM_TEST_DATA_SIZE];
+	static uint8_t pkt_data_readback[COPY_CHKSUM_TEST_DATA_SIZE];
+	const size_t len = COPY_CHKSUM_TEST_DATA_SIZE -
+			   COPY_CHKSUM_TEST_OFFSET;
+	struct net_pkt *pkt_src;
+	struct net_pkt *pkt_dst;
+	uint16_t sum = 0U;
+	int i;
+
+	for (i = 0; i < COPY_CHKSUM_TEST_DATA_SIZE; i++) {
+		pkt_data[i] = sys_rand32_get();
+	}
+
+	pkt_src = net_pkt_alloc_with_buffer(eth_if,
+					    COPY_CHKSUM_TEST_DATA_SIZE,
+					    AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_true(pkt_src != NULL, "Pkt not allocated");
+
+	pkt_dst = net_pkt_alloc_with_buffer(eth_if, len,
+					    AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_true(pkt_dst != NULL, "Pkt not allocated");
+
+	zassert_true(net_pkt_write(pkt_src, pkt_data,
+				   COPY_CHKSUM_TEST_DATA_SIZE) == 0,
+		     "Write packet failed");
+
+	/* Starting at an odd offset makes the copied chunks end at odd
+	 * offsets too, as the fragments have the same size.
+	 */
+	net_pkt_cursor_init(pkt_src);
+	net_pkt_set_overwrite(pkt_src, true);
+	net_pkt_skip(pkt_src, COPY_CHKSUM_TEST_OFFSET);
+
+	zassert_true(net_pkt_copy_chksum(pkt_dst, pkt_src, len, &sum) == 0,
+		     "Copy failed");
+	zassert_equal(sum, test_chksum(&pkt_data[COPY_CHKSUM_TEST_OFFSET], len),
+		      "Wrong checksum");
+
+	net_pkt_cursor_init(pkt_dst);
+	net_pkt_set_overwrite(pkt_dst, true);
+	zassert_true(net_pkt_read(pkt_dst, pkt_data_readback, len) == 0,
+		     "Read packet failed");
+	zassert_mem_equal(pkt_data_readback,
+			  &pkt_data[COPY_CHKSUM_TEST_OFFSET], len,
+			  "Packet data changed");
+
+	net_pkt_unref(pkt_src);
+	net_pkt_unref(pkt_dst);
+}
+
+#define WRITE_FROM_TEST_DATA_SIZE 600
+
+struct write_from_source {
+	const uint8_t *data;
+	int calls;
+};
+
+static int write_from_fill(void *buf, size_t len, void *user_data)
+{
+	struct write_from_source *src = user_data;
+
+	memcpy(buf, src->data, len);
+	src->data += len;
+	src->calls++;
+
+	return 0;
+}
+
+void test_net_pkt_write_from(void)
+{
+	static uint8_t pkt_data[WRITE_FROM_TEST_DATA_SIZE];
+	static uint8_t pkt_data_readback[WRITE_FROM_TEST_DATA_SIZE];
+	struct write_from_source src = { .data = pkt_data };
+	struct net_pkt *pkt;
+	int i;
+
+	for (i = 0; i < WRITE_FROM_TEST_DATA_SIZE; i++) {
+		pkt_data[i] = sys_rand32_get();
+	}
+
+	pkt = net_pkt_alloc_with_buffer(eth_if, WRITE_FROM_TEST_DATA_SIZE,
+					AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_true(pkt != NULL, "Pkt not allocated");
+
+	zassert_true(net_pkt_write_from(pkt, write_from_fill, &src,
+					WRITE_FROM_TEST_DATA_SIZE) == 0,
+		     "Write packet failed");
+	zassert_equal(net_pkt_get_len(pkt), WRITE_FROM_TEST_DATA_SIZE,
+		      "Wrong length");
+
+	/* One call per fragment, the data does not fit in one */
+	zassert_true(src.calls > 1, "Fragments not filled in place");
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+	zassert_true(net_pkt_read(pkt, pkt_data_readback,
+				  WRITE_FROM_TEST_DATA_SIZE) == 0,
+		     "Read packet failed");
+	zassert_mem_equal(pkt_data_readback, pkt_data,
+			  WRITE_FROM_TEST_DATA_SIZE, "Packet data changed");
+
+	net_pkt_unref(pkt);
+}
+
 #define PULL_TEST_PKT_DATA_SIZE 600
 
 void test_net_pkt_pull(void)
@@ -796,6 +921,8 @@ void test_main(void)
 			 ztest_unit_test(test_net_pkt_advanced_basics),
 			 ztest_unit_test(test_net_pkt_easier_rw_usage),
 			 ztest_unit_test(test_net_pkt_copy),
+			 ztest_unit_test(test_net_pkt_copy_chksum),
+			 ztest_unit_test(test_net_pkt_write_from),
 			 ztest_unit_test(test_net_pkt_pull),
 			 ztest_unit_test(test_net_pkt_clone)
 		);
@@ -473,6 +473,48 @@ static void test_route_del_many(void)
 	}
 }
 
+static void test_route_longest_prefix(void)
+{
+	/* Outside of the /64 network but within the /32 one */
+	struct in6_addr other_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0x1, 0,
+					   0, 0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+	struct net_route_entry *host, *net64, *net32;
+
+	host = net_route_add(my_iface, &dest_addr, 128, &peer_addr);
+	zassert_not_null(host, "Host route add failed");
+
+	net64 = net_route_add(my_iface, &generic_addr, 64, &peer_addr);
+	zassert_not_null(net64, "/64 route add failed");
+	zassert_not_equal(net64, host, "/64 route merged with host route");
+
+	net32 = net_route_add(my_iface, &in6addr_mcast, 32, &peer_addr);
+	zassert_not_null(net32, "/32 route add failed");
+
+	zassert_equal_ptr(net_route_lookup(my_iface, &dest_addr), host,
+			  "Host route not found");
+	zassert_equal_ptr(net_route_lookup(my_iface, &generic_addr), net64,
+			  "/64 route not found");
+	zassert_equal_ptr(net_route_lookup(NULL, &other_addr), net32,
+			  "/32 route not found");
+	zassert_is_null(net_route_lookup(my_iface, &ll_addr),
+			"Route found for link local address");
+	zassert_is_null(net_route_lookup(peer_iface, &dest_addr),
+			"Route found on wrong interface");
+
+	/* Once the host route is gone, the /64 one applies */
+	zassert_false(net_route_del(host), "Host route del failed");
+	zassert_equal_ptr(net_route_lookup(my_iface, &dest_addr), net64,
+			  "/64 route not found after host route del");
+
+	zassert_false(net_route_del(net64), "/64 route del failed");
+	zassert_equal_ptr(net_route_lookup(my_iface, &dest_addr), net32,
+			  "/32 route not found after /64 route del");
+
+	zassert_false(net_route_del(net32), "/32 route del failed");
+	zassert_is_null(net_route_lookup(my_iface, &dest_addr),
+			"Route found after all routes deleted");
+}
+
 /*test case main entry*/
 void test_main(void)
 {
@@ -492,6 +534,7 @@ void test_main(void)
 			ztest_unit_test(test_route_del_nexthop_again),
 			ztest_unit_test(test_populate_nbr_cache),
 			ztest_unit_test(test_route_add_many),
-			ztest_unit_test(test_route_del_many));
+			ztest_unit_test(test_route_del_many),
+			ztest_unit_test(test_route_longest_prefix));
 	ztest_run_test_suite(test_route);
 }
@@ -220,11 +220,122 @@ static void test_packet_sockets(void)
 		       (struct sockaddr *)&src, &addrlen);
 	zassert_equal(ret, sizeof(data_to_send), "Cannot receive all data (%d)",
 		      -errno);
+
+	ret = close(sock1);
+	zassert_equal(ret, 0, "Cannot close 1st socket (%d)", -errno);
+
+	ret = close(sock2);
+	zassert_equal(ret, 0, "Cannot close 2nd socket (%d)", -errno);
+}
+
+#if defined(CONFIG_NET_SOCKETS_PACKET_RX_RING)
+#define RING_FRAME_SIZE 128
+#define RING_FRAME_NR 4
+
+static uint8_t ring_mem[RING_FRAME_SIZE * RING_FRAME_NR]
+	__aligned(TPACKET_ALIGNMENT);
+
+static void test_packet_rx_ring(void)
+{
+	struct user_data ud = { 0 };
+	uint8_t data_to_send[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+	struct zsock_tpacket_req req = {
+		.tp_ring = ring_mem,
+		.tp_frame_size = RING_FRAME_SIZE,
+		.tp_frame_nr = RING_FRAME_NR,
+	};
+	struct zsock_tpacket_stats stats;
+	socklen_t optlen = sizeof(stats);
+	struct zsock_tpacket_hdr *hdr;
+	struct pollfd pfd;
+	struct sockaddr_ll dst;
+	int ret, sock, i;
+
+	net_if_foreach(iface_cb, &ud);
+	zassert_not_null(ud.first, "1st Ethernet interface not found");
+
+	sock = setup_socket(ud.first);
+
+	ret = setsockopt(sock, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req));
+	zassert_equal(ret, 0, "Cannot set the ring (%d)", -errno);
+
+	ret = setsockopt(sock, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req));
+	zassert_equal(ret, -1, "Ring set twice");
+	zassert_equal(errno, EBUSY, "Wrong errno (%d)", errno);
+
+	ret = bind_socket(sock, ud.first);
+	zassert_equal(ret, 0, "Cannot bind socket (%d)", -errno);
+
+	memset(&dst, 0, sizeof(dst));
+	dst.sll_ifindex = net_if_get_by_iface(ud.first);
+	dst.sll_family = AF_PACKET;
+
+	/* One frame more than the ring holds */
+	for (i = 0; i <= RING_FRAME_NR; i++) {
+		data_to_send[0] = i;
+		ret = sendto(sock, data_to_send, sizeof(data_to_send), 0,
+			     (const struct sockaddr *)&dst, sizeof(dst));
+		zassert_equal(ret, sizeof(data_to_send),
+			      "Cannot send all data (%d)", -errno);
+	}
+
+	pfd.fd = sock;
+	pfd.events = POLLIN;
+	ret = poll(&pfd, 1, 100);
+	zassert_equal(ret, 1, "Ring not readable (%d)", ret);
+
+	k_msleep(10);
+
+	for (i = 0; i < RING_FRAME_NR; i++) {
+		hdr = zsock_tpacket_frame(&req, i);
+		zassert_equal(atomic_get(&hdr->tp_status), TP_STATUS_USER,
+			      "Frame %d not filled", i);
+		zassert_equal(hdr->tp_len, sizeof(data_to_send),
+			      "Wrong length of frame %d", i);
+		zassert_equal(hdr->tp_snaplen, sizeof(data_to_send),
+			      "Wrong snap length of frame %d", i);
+		zassert_equal(((uint8_t *)hdr + hdr->tp_mac)[0], i,
+			      "Wrong data in frame %d", i);
+	}
+
+	ret = getsockopt(sock, SOL_PACKET, PACKET_STATISTICS, &stats,
+			 &optlen);
+	zassert_equal(ret, 0, "Cannot get statistics (%d)", -errno);
+	zassert_equal(stats.tp_packets, RING_FRAME_NR, "Wrong packet count");
+	zassert_equal(stats.tp_drops, 1, "Wrong drop count");
+
+	/* Hand the frames back, the next one tells frames were lost */
+	for (i = 0; i < RING_FRAME_NR; i++) {
+		atomic_set(&zsock_tpacket_frame(&req, i)->tp_status,
+			   TP_STATUS_KERNEL);
+	}
+
+	ret = sendto(sock, data_to_send, sizeof(data_to_send), 0,
+		     (const struct sockaddr *)&dst, sizeof(dst));
+	zassert_equal(ret, sizeof(data_to_send), "Cannot send all data (%d)",
+		      -errno);
+
+	ret = poll(&pfd, 1, 100);
+	zassert_equal(ret, 1, "Ring not readable (%d)", ret);
+
+	hdr = zsock_tpacket_frame(&req, 0);
+	zassert_equal(atomic_get(&hdr->tp_status),
+		      TP_STATUS_USER | TP_STATUS_LOSING, "Loss not reported");
+
+	ret = close(sock);
+	zassert_equal(ret, 0, "Cannot close socket (%d)", -errno);
+}
+#else
+static void test_packet_rx_ring(void)
+{
+	ztest_test_skip();
 }
+#endif /* CONFIG_NET_SOCKETS_PACKET_RX_RING */
 
 void test_main(void)
 {
 	ztest_test_suite(socket_packet,
-			 ztest_unit_test(test_packet_sockets));
+			 ztest_unit_test(test_packet_sockets),
+			 ztest_unit_test(test_packet_rx_ring));
 	ztest_run_test_suite(socket_packet);
 }
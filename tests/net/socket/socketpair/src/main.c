@@ -44,6 +44,10 @@ extern void test_socketpair_poll_delayed_data(void);
 extern void test_socketpair_poll_close_remote_end_POLLIN(void);
 extern void test_socketpair_poll_close_remote_end_POLLOUT(void);
 
+/* in zero_copy.c */
+extern void test_socketpair_claim_commit(void);
+extern void test_socketpair_splice(void);
+
 /* work queue for tests that need an async event */
 static K_THREAD_STACK_DEFINE(test_socketpair_work_q_stack, 512);
 struct k_work_q test_socketpair_work_q;
@@ -90,7 +94,11 @@ void test_main(void)
 		ztest_user_unit_test(
 			test_socketpair_poll_close_remote_end_POLLIN),
 		ztest_user_unit_test(
-			test_socketpair_poll_close_remote_end_POLLOUT)
+			test_socketpair_poll_close_remote_end_POLLOUT),
+
+		/* claims hand out kernel memory, so supervisor mode only */
+		ztest_unit_test(test_socketpair_claim_commit),
+		ztest_unit_test(test_socketpair_splice)
 	);
 
 	ztest_run_test_suite(socketpair);
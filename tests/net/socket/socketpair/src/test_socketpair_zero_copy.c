@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <fcntl.h>
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <stdio.h>
+#include <string.h>
+#include <net/socket.h>
+#include <sys/util.h>
+#include <posix/unistd.h>
+
+#include <ztest_assert.h>
+
+#undef read
+#define read(fd, buf, len) zsock_recv(fd, buf, len, 0)
+
+#undef write
+#define write(fd, buf, len) zsock_send(fd, buf, len, 0)
+
+void test_socketpair_claim_commit(void)
+{
+	int res;
+	int sv[2] = {-1, -1};
+	uint8_t *data;
+	char buf[8];
+
+	res = socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+	zassert_equal(res, 0, "socketpair(2) failed: %d", errno);
+
+	res = zsock_socketpair_claim(sv[0], &data, 5);
+	zassert_equal(res, 5, "claim failed: %d", errno);
+
+	memcpy(data, "hello", 5);
+
+	/* regular writes are refused while the claim is outstanding */
+	res = write(sv[0], "x", 1);
+	zassert_equal(res, -1, "expected write to fail");
+	zassert_equal(errno, EBUSY, "errno: expected: EBUSY actual: %d",
+		      errno);
+
+	res = zsock_socketpair_commit(sv[0], 5);
+	zassert_equal(res, 0, "commit failed: %d", errno);
+
+	res = read(sv[1], buf, sizeof(buf));
+	zassert_equal(res, 5, "read(2) failed: %d", errno);
+	zassert_mem_equal(buf, "hello", 5, "unexpected data");
+
+	/* claims fail instead of blocking once the peer's buffer is full */
+	for (size_t k = 0; k < CONFIG_NET_SOCKETPAIR_BUFFER_SIZE; ++k) {
+		res = write(sv[0], "x", 1);
+		zassert_equal(res, 1, "write(2) failed: %d", errno);
+	}
+
+	res = zsock_socketpair_claim(sv[0], &data, 1);
+	zassert_equal(res, -1, "expected claim to fail");
+	zassert_equal(errno, EAGAIN, "errno: expected: EAGAIN actual: %d",
+		      errno);
+
+	close(sv[0]);
+	close(sv[1]);
+}
+
+void test_socketpair_splice(void)
+{
+	int res;
+	int sv[2] = {-1, -1};
+	int out[2] = {-1, -1};
+	char buf[16];
+
+	res = socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+	zassert_equal(res, 0, "socketpair(2) failed: %d", errno);
+
+	res = socketpair(AF_UNIX, SOCK_STREAM, 0, out);
+	zassert_equal(res, 0, "socketpair(2) failed: %d", errno);
+
+	res = write(sv[0], "0123456789", 10);
+	zassert_equal(res, 10, "write(2) failed: %d", errno);
+
+	res = zsock_socketpair_splice(sv[1], out[0], 4, 0);
+	zassert_equal(res, 4, "splice failed: %d", errno);
+
+	res = zsock_socketpair_splice(sv[1], out[0], sizeof(buf), 0);
+	zassert_equal(res, 6, "splice failed: %d", errno);
+
+	res = read(out[1], buf, sizeof(buf));
+	zassert_equal(res, 10, "read(2) failed: %d", errno);
+	zassert_mem_equal(buf, "0123456789", 10, "unexpected data");
+
+	/* nothing left to transfer */
+	res = zsock_socketpair_splice(sv[1], out[0], sizeof(buf),
+				      ZSOCK_MSG_DONTWAIT);
+	zassert_equal(res, -1, "expected splice to fail");
+	zassert_equal(errno, EAGAIN, "errno: expected: EAGAIN actual: %d",
+		      errno);
+
+	/* end of file once the writer is gone */
+	close(sv[0]);
+
+	res = zsock_socketpair_splice(sv[1], out[0], sizeof(buf), 0);
+	zassert_equal(res, 0, "expected end of file: %d", errno);
+
+	close(sv[1]);
+	close(out[0]);
+	close(out[1]);
+}
@@ -13,6 +13,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
 #include <net/socket.h>
 #include <net/ethernet.h>
+#include <net/net_pkt.h>
 
 #include "ipv6.h"
 #include "../../socket_helpers.h"
@@ -703,6 +704,198 @@ void test_v6_sendmsg_recvfrom_connected(void)
 	zassert_equal(rv, 0, "close failed");
 }
 
+void test_v4_sendmmsg_recvmmsg(void)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_in addr[3];
+	struct iovec tx_iov[3];
+	struct iovec rx_iov[4];
+	struct mmsghdr tx_msgs[2];
+	struct mmsghdr rx_msgs[3];
+	char buf[3][sizeof(TEST_STR_SMALL)];
+	int i;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, CLIENT_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock,
+		  (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = bind(client_sock,
+		  (struct sockaddr *)&client_addr,
+		  sizeof(client_addr));
+	zassert_equal(rv, 0, "client bind failed");
+
+	/* The second datagram is gathered from two buffers */
+	tx_iov[0].iov_base = TEST_STR_SMALL;
+	tx_iov[0].iov_len = STRLEN(TEST_STR_SMALL);
+	tx_iov[1].iov_base = TEST_STR_SMALL;
+	tx_iov[1].iov_len = 2;
+	tx_iov[2].iov_base = TEST_STR_SMALL + 2;
+	tx_iov[2].iov_len = STRLEN(TEST_STR_SMALL) - 2;
+
+	memset(tx_msgs, 0, sizeof(tx_msgs));
+	for (i = 0; i < ARRAY_SIZE(tx_msgs); i++) {
+		tx_msgs[i].msg_hdr.msg_name = &server_addr;
+		tx_msgs[i].msg_hdr.msg_namelen = sizeof(server_addr);
+	}
+
+	tx_msgs[0].msg_hdr.msg_iov = &tx_iov[0];
+	tx_msgs[0].msg_hdr.msg_iovlen = 1;
+	tx_msgs[1].msg_hdr.msg_iov = &tx_iov[1];
+	tx_msgs[1].msg_hdr.msg_iovlen = 2;
+
+	rv = sendmmsg(client_sock, tx_msgs, ARRAY_SIZE(tx_msgs), 0);
+	zassert_equal(rv, ARRAY_SIZE(tx_msgs), "sendmmsg failed (%d)", -errno);
+
+	for (i = 0; i < ARRAY_SIZE(tx_msgs); i++) {
+		zassert_equal(tx_msgs[i].msg_len, STRLEN(TEST_STR_SMALL),
+			      "invalid sent length");
+	}
+
+	/* Third datagram, received in a buffer too small for it */
+	rv = sendto(client_sock, TEST_STR_SMALL, STRLEN(TEST_STR_SMALL), 0,
+		    (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "sendto failed");
+
+	/* Let all the datagrams reach the server socket */
+	k_msleep(100);
+
+	memset(rx_msgs, 0, sizeof(rx_msgs));
+	memset(buf, 0, sizeof(buf));
+
+	/* The first datagram is scattered over two buffers */
+	rx_iov[0].iov_base = buf[0];
+	rx_iov[0].iov_len = 1;
+	rx_iov[1].iov_base = buf[0] + 1;
+	rx_iov[1].iov_len = sizeof(buf[0]) - 1;
+	rx_iov[2].iov_base = buf[1];
+	rx_iov[2].iov_len = sizeof(buf[1]);
+	rx_iov[3].iov_base = buf[2];
+	rx_iov[3].iov_len = 2;
+
+	rx_msgs[0].msg_hdr.msg_iov = &rx_iov[0];
+	rx_msgs[0].msg_hdr.msg_iovlen = 2;
+	rx_msgs[1].msg_hdr.msg_iov = &rx_iov[2];
+	rx_msgs[1].msg_hdr.msg_iovlen = 1;
+	rx_msgs[2].msg_hdr.msg_iov = &rx_iov[3];
+	rx_msgs[2].msg_hdr.msg_iovlen = 1;
+
+	for (i = 0; i < ARRAY_SIZE(rx_msgs); i++) {
+		rx_msgs[i].msg_hdr.msg_name = &addr[i];
+		rx_msgs[i].msg_hdr.msg_namelen = sizeof(addr[i]);
+	}
+
+	rv = recvmmsg(server_sock, rx_msgs, ARRAY_SIZE(rx_msgs), 0);
+	zassert_equal(rv, ARRAY_SIZE(rx_msgs), "recvmmsg failed (%d)", -errno);
+
+	for (i = 0; i < 2; i++) {
+		zassert_equal(rx_msgs[i].msg_len, STRLEN(TEST_STR_SMALL),
+			      "unexpected received bytes");
+		zassert_mem_equal(buf[i], BUF_AND_SIZE(TEST_STR_SMALL),
+				  "wrong data");
+		zassert_equal(rx_msgs[i].msg_hdr.msg_flags, 0,
+			      "unexpected flags");
+	}
+
+	zassert_equal(rx_msgs[2].msg_len, 2, "unexpected received bytes");
+	zassert_mem_equal(buf[2], TEST_STR_SMALL, 2, "wrong data");
+	zassert_true(rx_msgs[2].msg_hdr.msg_flags & MSG_TRUNC,
+		     "truncation not reported");
+
+	for (i = 0; i < ARRAY_SIZE(rx_msgs); i++) {
+		zassert_equal(rx_msgs[i].msg_hdr.msg_namelen,
+			      sizeof(struct sockaddr_in), "unexpected addrlen");
+		zassert_equal(addr[i].sin_port, htons(CLIENT_PORT),
+			      "unexpected client port");
+	}
+
+	/* Nothing left to receive */
+	rv = recvmmsg(server_sock, rx_msgs, ARRAY_SIZE(rx_msgs), MSG_DONTWAIT);
+	zassert_equal(rv, -1, "recvmmsg should fail");
+	zassert_equal(errno, EAGAIN, "unexpected errno (%d)", errno);
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+void test_v4_recv_pkts(void)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_storage addr[3];
+	struct net_pkt *pkts[3];
+	char buf[sizeof(TEST_STR2)];
+	int ret;
+	int i;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, CLIENT_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock,
+		  (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = bind(client_sock,
+		  (struct sockaddr *)&client_addr,
+		  sizeof(client_addr));
+	zassert_equal(rv, 0, "client bind failed");
+
+	for (i = 0; i < 2; i++) {
+		rv = sendto(client_sock, TEST_STR2, STRLEN(TEST_STR2), 0,
+			    (struct sockaddr *)&server_addr,
+			    sizeof(server_addr));
+		zassert_equal(rv, STRLEN(TEST_STR2), "sendto failed");
+	}
+
+	k_msleep(100);
+
+	rv = zsock_recv_pkts(server_sock, pkts, ARRAY_SIZE(pkts), 0, addr);
+	zassert_equal(rv, 2, "zsock_recv_pkts failed (%d)", -errno);
+
+	for (i = 0; i < rv; i++) {
+		zassert_equal(net_pkt_remaining_data(pkts[i]),
+			      STRLEN(TEST_STR2), "unexpected payload length");
+
+		/* The payload is spread over several buffers, read it */
+		ret = net_pkt_read(pkts[i], buf, STRLEN(TEST_STR2));
+		zassert_equal(ret, 0, "cannot read payload");
+		zassert_mem_equal(buf, BUF_AND_SIZE(TEST_STR2), "wrong data");
+
+		zassert_equal(addr[i].ss_family, AF_INET, "unexpected family");
+		zassert_equal(net_sin((struct sockaddr *)&addr[i])->sin_port,
+			      htons(CLIENT_PORT), "unexpected client port");
+
+		net_pkt_unref(pkts[i]);
+	}
+
+	rv = zsock_recv_pkts(server_sock, pkts, ARRAY_SIZE(pkts),
+			     MSG_DONTWAIT, NULL);
+	zassert_equal(rv, -1, "zsock_recv_pkts should fail");
+	zassert_equal(errno, EAGAIN, "unexpected errno (%d)", errno);
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 void test_so_txtime(void)
 {
 	struct sockaddr_in bind_addr4;
@@ -752,6 +945,88 @@ void test_so_txtime(void)
 	zassert_equal(rv, 0, "close failed");
 }
 
+#define REUSEPORT_CLIENTS 8
+
+void test_so_reuseport(void)
+{
+	struct sockaddr_in server_addr;
+	struct sockaddr_in client_addr;
+	int server_sock[2], client_sock;
+	int received[2] = { 0 };
+	socklen_t optlen;
+	int i, j, rv, optval;
+
+	for (i = 0; i < ARRAY_SIZE(server_sock); i++) {
+		prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR,
+				    SERVER_PORT, &server_sock[i],
+				    &server_addr);
+
+		optval = 1;
+		rv = setsockopt(server_sock[i], SOL_SOCKET, SO_REUSEPORT,
+				&optval, sizeof(optval));
+		zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+		optval = 0;
+		optlen = sizeof(optval);
+		rv = getsockopt(server_sock[i], SOL_SOCKET, SO_REUSEPORT,
+				&optval, &optlen);
+		zassert_equal(rv, 0, "getsockopt failed (%d)", errno);
+		zassert_equal(optlen, sizeof(optval), "invalid optlen");
+		zassert_equal(optval, 1, "getsockopt reuseport");
+
+		rv = bind(server_sock[i], (struct sockaddr *)&server_addr,
+			  sizeof(server_addr));
+		zassert_equal(rv, 0, "bind failed");
+	}
+
+	/* Each client sends twice, both datagrams must reach the same
+	 * server socket.
+	 */
+	for (i = 0; i < REUSEPORT_CLIENTS; i++) {
+		prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR,
+				    CLIENT_PORT + i, &client_sock,
+				    &client_addr);
+
+		rv = bind(client_sock, (struct sockaddr *)&client_addr,
+			  sizeof(client_addr));
+		zassert_equal(rv, 0, "bind failed");
+
+		for (j = 0; j < 2; j++) {
+			rv = sendto(client_sock, BUF_AND_SIZE(TEST_STR_SMALL),
+				    0, (struct sockaddr *)&server_addr,
+				    sizeof(server_addr));
+			zassert_equal(rv, STRLEN(TEST_STR_SMALL),
+				      "sendto failed");
+		}
+
+		k_msleep(10);
+
+		for (j = 0; j < ARRAY_SIZE(server_sock); j++) {
+			int count = 0;
+
+			while (recv(server_sock[j], rx_buf, sizeof(rx_buf),
+				    MSG_DONTWAIT) > 0) {
+				count++;
+			}
+
+			zassert_true(count == 0 || count == 2,
+				     "flow split among sockets");
+			received[j] += count;
+		}
+
+		rv = close(client_sock);
+		zassert_equal(rv, 0, "close failed");
+	}
+
+	zassert_equal(received[0] + received[1], 2 * REUSEPORT_CLIENTS,
+		      "datagrams lost");
+
+	for (i = 0; i < ARRAY_SIZE(server_sock); i++) {
+		rv = close(server_sock[i]);
+		zassert_equal(rv, 0, "close failed");
+	}
+}
+
 static void comm_sendmsg_with_txtime(int client_sock,
 				     struct sockaddr *client_addr,
 				     socklen_t client_addrlen,
@@ -966,6 +1241,7 @@ void test_main(void)
 			 ztest_unit_test(test_v6_bind_sendto),
 			 ztest_unit_test(test_so_priority),
 			 ztest_unit_test(test_so_txtime),
+			 ztest_unit_test(test_so_reuseport),
 			 ztest_unit_test(test_v4_sendmsg_recvfrom),
 			 ztest_user_unit_test(test_v4_sendmsg_recvfrom),
 			 ztest_unit_test(test_v4_sendmsg_recvfrom_no_aux_data),
@@ -976,6 +1252,9 @@ void test_main(void)
 			 ztest_user_unit_test(test_v4_sendmsg_recvfrom_connected),
 			 ztest_unit_test(test_v6_sendmsg_recvfrom_connected),
 			 ztest_user_unit_test(test_v6_sendmsg_recvfrom_connected),
+			 ztest_unit_test(test_v4_sendmmsg_recvmmsg),
+			 ztest_user_unit_test(test_v4_sendmmsg_recvmmsg),
+			 ztest_unit_test(test_v4_recv_pkts),
 			 ztest_unit_test(test_setup_eth),
 			 ztest_unit_test(test_v6_sendmsg_with_txtime),
 			 ztest_user_unit_test(test_v6_sendmsg_with_txtime)
@@ -94,6 +94,7 @@ static void handle_server_test(sa_family_t af, struct tcphdr *th);
 static void handle_syn_resend(void);
 static void handle_client_fin_wait_2_test(sa_family_t af, struct tcphdr *th);
 static void handle_client_closing_test(sa_family_t af, struct tcphdr *th);
+static void handle_nagle_test(sa_family_t af, struct tcphdr *th);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -375,6 +376,9 @@ static int tester_send(struct device *dev, struct net_pkt *pkt)
 	case 8:
 		handle_client_closing_test(net_pkt_family(pkt), &th);
 		break;
+	case 9:
+		handle_nagle_test(net_pkt_family(pkt), &th);
+		break;
 	default:
 		zassert_true(false, "Undefined test case");
 	}
@@ -589,6 +593,27 @@ static void test_client_ipv6(void)
 	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
 }
 
+/* Header length, in 32-bit words, of a SYN|ACK answering a SYN which
+ * offers every option: timestamps (with SACK permitted squeezed into the
+ * padding), SACK permitted alone and window scale, each as enabled.
+ */
+static uint8_t syn_ack_th_off(void)
+{
+	uint8_t th_off = 5U;
+
+	if (IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS)) {
+		th_off += 3U;
+	} else if (IS_ENABLED(CONFIG_NET_TCP_SACK)) {
+		th_off += 1U;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE)) {
+		th_off += 1U;
+	}
+
+	return th_off;
+}
+
 static void handle_server_test(sa_family_t af, struct tcphdr *th)
 {
 	struct net_pkt *reply;
@@ -604,6 +629,10 @@ static void handle_server_test(sa_family_t af, struct tcphdr *th)
 		break;
 	case T_SYN_ACK:
 		test_verify_flags(th, SYN | ACK);
+		if (test_case_no == 4U) {
+			zassert_equal(th->th_off, syn_ack_th_off(),
+				      "SYN|ACK does not echo the TCP options");
+		}
 		seq++;
 		ack = ntohs(th->th_seq) + 1U;
 		reply = prepare_ack_packet(af, htons(MY_PORT),
@@ -1165,6 +1194,232 @@ static void test_client_closing_ipv6(void)
 	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
 }
 
+static int nagle_segments;
+static uint16_t nagle_port;
+
+/* Data segments are counted but not acknowledged, the test does that */
+static void handle_nagle_test(sa_family_t af, struct tcphdr *th)
+{
+	struct net_pkt *reply;
+	int ret;
+
+	switch (t_state) {
+	case T_SYN:
+		test_verify_flags(th, SYN);
+		seq = 0U;
+		ack = ntohl(th->th_seq) + 1U;
+		nagle_port = th->th_sport;
+		reply = prepare_syn_ack_packet(af, htons(MY_PORT),
+					       th->th_sport);
+		seq++;
+		t_state = T_SYN_ACK;
+		break;
+	case T_SYN_ACK:
+		test_verify_flags(th, ACK);
+		t_state = T_DATA;
+		test_sem_give();
+		return;
+	case T_DATA:
+		if (th->th_flags & FIN) {
+			test_verify_flags(th, FIN | ACK);
+			ack = ntohl(th->th_seq) + 1U;
+			reply = prepare_fin_ack_packet(af, htons(MY_PORT),
+						       th->th_sport);
+			t_state = T_FIN_ACK;
+			break;
+		}
+
+		test_verify_flags(th, PSH | ACK);
+		nagle_segments++;
+		ack = ntohl(th->th_seq) + 1U;
+		test_sem_give();
+		return;
+	case T_FIN_ACK:
+		test_verify_flags(th, ACK);
+		test_sem_give();
+		return;
+	default:
+		zassert_true(false, "%s unexpected state", __func__);
+		return;
+	}
+
+	ret = net_recv_data(iface, reply);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	return;
+fail:
+	zassert_true(false, "%s failed", __func__);
+}
+
+/* Test case scenario IPv4
+ *   connect,
+ *   send Data "A", expect it right away,
+ *   send Data "B", expect it to be held while "A" is unacknowledged,
+ *   ACK "A", expect "B",
+ *   set TCP_OPT_NODELAY,
+ *   send Data "C", expect it right away although "B" is unacknowledged,
+ *   close the connection.
+ *   any failures cause test case to fail.
+ */
+static void test_client_nagle_ipv4(void)
+{
+	struct net_context *ctx;
+	uint8_t data[] = { 0x41, 0x42, 0x43 }; /* "ABC" */
+	size_t len = sizeof(int);
+	int nodelay = 1;
+	int ret;
+
+	t_state = T_SYN;
+	test_case_no = 9;
+	seq = ack = 0;
+	nagle_segments = 0;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	if (ret < 0) {
+		zassert_true(false, "Failed to get net_context");
+	}
+
+	net_context_ref(ctx);
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				  sizeof(struct sockaddr_in),
+				  NULL,
+				  K_MSEC(100), NULL);
+	if (ret < 0) {
+		zassert_true(false, "Failed to connect to peer");
+	}
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	ret = net_context_send(ctx, &data[0], 1, NULL, K_NO_WAIT, NULL);
+	zassert_true(ret >= 0, "Failed to send data to peer");
+	test_sem_take(K_MSEC(100), __LINE__);
+	zassert_equal(nagle_segments, 1, "First segment not sent");
+
+	ret = net_context_send(ctx, &data[1], 1, NULL, K_NO_WAIT, NULL);
+	zassert_true(ret >= 0, "Failed to send data to peer");
+	k_sleep(K_MSEC(50));
+	zassert_equal(nagle_segments, 1, "Small segment not held back");
+
+	/* The ACK for "A" releases "B" */
+	ret = net_recv_data(iface, prepare_ack_packet(AF_INET, htons(MY_PORT),
+						      nagle_port));
+	zassert_true(ret >= 0, "Failed to ACK data");
+	test_sem_take(K_MSEC(100), __LINE__);
+	zassert_equal(nagle_segments, 2, "Held segment not sent");
+
+	ret = net_tcp_set_option(ctx, TCP_OPT_NODELAY, &nodelay,
+				 sizeof(nodelay));
+	zassert_equal(ret, 0, "Failed to set TCP_OPT_NODELAY");
+
+	nodelay = 0;
+	ret = net_tcp_get_option(ctx, TCP_OPT_NODELAY, &nodelay, &len);
+	zassert_equal(ret, 0, "Failed to get TCP_OPT_NODELAY");
+	zassert_equal(nodelay, 1, "TCP_OPT_NODELAY not set");
+
+	ret = net_context_send(ctx, &data[2], 1, NULL, K_NO_WAIT, NULL);
+	zassert_true(ret >= 0, "Failed to send data to peer");
+	test_sem_take(K_MSEC(100), __LINE__);
+	zassert_equal(nagle_segments, 3, "Segment held with TCP_OPT_NODELAY");
+
+	ret = net_recv_data(iface, prepare_ack_packet(AF_INET, htons(MY_PORT),
+						      nagle_port));
+	zassert_true(ret >= 0, "Failed to ACK data");
+
+	net_tcp_put(ctx);
+
+	/* Peer will release the semaphone after it receives
+	 * proper ACK to FIN | ACK
+	 */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
+}
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+static void cc_conn_init(struct tcp *conn, const struct tcp_cc *cc)
+{
+	memset(conn, 0, sizeof(*conn));
+	conn->recv_options.mss = 1000U;
+	conn->recv_options.mss_found = true;
+	conn->ssthresh = UINT32_MAX;
+	conn->cc = cc;
+	cc->init(conn);
+}
+
+static void test_cc_newreno(void)
+{
+	struct tcp conn;
+	int i;
+
+	cc_conn_init(&conn, &tcp_cc_newreno);
+	zassert_equal(conn.cwnd, 4000U, "Wrong initial window");
+
+	/* Slow start, one segment per ACK */
+	conn.cc->cong_avoid(&conn, 1000U);
+	zassert_equal(conn.cwnd, 5000U, "No slow start growth");
+
+	/* Congestion avoidance, one segment per window */
+	conn.ssthresh = 5000U;
+	for (i = 0; i < 4; i++) {
+		conn.cc->cong_avoid(&conn, 1000U);
+	}
+	zassert_equal(conn.cwnd, 5000U, "Grew before a full window");
+	conn.cc->cong_avoid(&conn, 1000U);
+	zassert_equal(conn.cwnd, 6000U, "No congestion avoidance growth");
+
+	conn.unacked_len = 6000;
+	zassert_equal(conn.cc->ssthresh(&conn), 3000U, "Wrong ssthresh");
+	conn.unacked_len = 1000;
+	zassert_equal(conn.cc->ssthresh(&conn), 2000U, "ssthresh below 2 MSS");
+}
+
+static void test_cc_cubic(void)
+{
+	struct tcp conn;
+	uint32_t ssthresh;
+	int i;
+
+	cc_conn_init(&conn, &tcp_cc_cubic);
+	zassert_equal(conn.cwnd, 4000U, "Wrong initial window");
+
+	conn.cwnd = 10000U;
+	ssthresh = conn.cc->ssthresh(&conn);
+	zassert_equal(ssthresh, 7000U, "Wrong multiplicative decrease");
+	zassert_equal(conn.cc_data.cubic.w_max, 10000U, "Wrong W_max");
+
+	/* Right after the loss the window stays on the concave part,
+	 * well below the window it was cut from.
+	 */
+	conn.cwnd = conn.ssthresh = ssthresh;
+	for (i = 0; i < 7; i++) {
+		conn.cc->cong_avoid(&conn, 1000U);
+	}
+	zassert_true(conn.cwnd >= ssthresh && conn.cwnd < 10000U,
+		     "Unexpected window %u", conn.cwnd);
+	zassert_true(conn.cc_data.cubic.k > 1900U &&
+		     conn.cc_data.cubic.k < 2000U,
+		     "Wrong K %u", conn.cc_data.cubic.k);
+
+	/* A loss below the previous W_max releases bandwidth */
+	conn.cwnd = 8000U;
+	conn.cc->ssthresh(&conn);
+	zassert_equal(conn.cc_data.cubic.w_max, 6800U, "No fast convergence");
+}
+#else
+static void test_cc_newreno(void)
+{
+	ztest_test_skip();
+}
+
+static void test_cc_cubic(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_CONTROL */
+
 /** Test case main entry */
 void test_main(void)
 {
@@ -1177,7 +1432,10 @@ void test_main(void)
 			 ztest_unit_test(test_server_ipv6),
 			 ztest_unit_test(test_client_syn_resend),
 			 ztest_unit_test(test_client_fin_wait_2_ipv4),
-			 ztest_unit_test(test_client_closing_ipv6)
+			 ztest_unit_test(test_client_closing_ipv6),
+			 ztest_unit_test(test_client_nagle_ipv4),
+			 ztest_unit_test(test_cc_newreno),
+			 ztest_unit_test(test_cc_cubic)
 			 );
 
 	ztest_run_test_suite(test_tcp_fn);
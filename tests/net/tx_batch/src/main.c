@@ -0,0 +1,253 @@
+/* main.c - Application main entry point */
+
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define NET_LOG_LEVEL CONFIG_NET_L2_ETHERNET_LOG_LEVEL
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, NET_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/printk.h>
+#include <random/rand32.h>
+
+#include <ztest.h>
+
+#include <net/ethernet.h>
+#include <net/buf.h>
+#include <net/net_ip.h>
+#include <net/net_l2.h>
+
+#define NET_LOG_ENABLED 1
+#include "net_private.h"
+
+#if NET_LOG_LEVEL >= LOG_LEVEL_DBG
+#define DBG(fmt, ...) printk(fmt, ##__VA_ARGS__)
+#else
+#define DBG(fmt, ...)
+#endif
+
+#define TEST_PORT 9999
+
+/* Packets sent in one burst, more than CONFIG_NET_TX_BATCH_SIZE */
+#define BURST_LEN (CONFIG_NET_TX_BATCH_SIZE + 2)
+
+static char *test_data = "Test data to be sent";
+
+static struct in_addr in4addr_my = { { { 192, 0, 2, 1 } } };
+static struct in_addr in4addr_dst = { { { 192, 0, 2, 2 } } };
+
+static struct net_if *eth_iface;
+
+static K_SEM_DEFINE(wait_data, 0, UINT_MAX);
+
+#define WAIT_TIME K_SECONDS(1)
+
+struct eth_context {
+	uint8_t mac_addr[6];
+
+	/* How many frames the "hardware" accepts in one batch */
+	int batch_limit;
+
+	/* Size of each batch passed to eth_tx_batch() */
+	int batches[BURST_LEN];
+	int batch_count;
+	int single_count;
+};
+
+static struct eth_context eth_context;
+
+static void eth_iface_init(struct net_if *iface)
+{
+	struct device *dev = net_if_get_device(iface);
+	struct eth_context *context = dev->data;
+
+	net_if_set_link_addr(iface, context->mac_addr,
+			     sizeof(context->mac_addr),
+			     NET_LINK_ETHERNET);
+
+	ethernet_init(iface);
+}
+
+static int eth_tx(struct device *dev, struct net_pkt *pkt)
+{
+	struct eth_context *context = dev->data;
+
+	if (!pkt->buffer) {
+		DBG("No data to send!\n");
+		return -ENODATA;
+	}
+
+	context->single_count++;
+
+	k_sem_give(&wait_data);
+
+	return 0;
+}
+
+static int eth_tx_batch(struct device *dev, struct net_pkt *pkts[],
+			size_t count)
+{
+	struct eth_context *context = dev->data;
+	int queued = MIN(count, context->batch_limit);
+	int i;
+
+	zassert_true(count > 1, "Batch of %zu packet", count);
+	zassert_true(context->batch_count < BURST_LEN, "Too many batches");
+
+	context->batches[context->batch_count++] = count;
+
+	for (i = 0; i < queued; i++) {
+		zassert_not_null(pkts[i]->buffer, "No data to send");
+
+		k_sem_give(&wait_data);
+	}
+
+	return queued;
+}
+
+static struct ethernet_api api_funcs = {
+	.iface_api.init = eth_iface_init,
+
+	.send = eth_tx,
+	.send_batch = eth_tx_batch,
+};
+
+static int eth_init(struct device *dev)
+{
+	struct eth_context *context = dev->data;
+
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	context->mac_addr[0] = 0x00;
+	context->mac_addr[1] = 0x00;
+	context->mac_addr[2] = 0x5E;
+	context->mac_addr[3] = 0x00;
+	context->mac_addr[4] = 0x53;
+	context->mac_addr[5] = sys_rand32_get();
+
+	return 0;
+}
+
+ETH_NET_DEVICE_INIT(eth_tx_batch_test, "eth_tx_batch_test",
+		    eth_init, device_pm_control_nop,
+		    &eth_context, NULL, CONFIG_ETH_INIT_PRIORITY,
+		    &api_funcs, NET_ETH_MTU);
+
+static void iface_cb(struct net_if *iface, void *user_data)
+{
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET) &&
+	    net_if_get_device(iface)->data == &eth_context) {
+		eth_iface = iface;
+	}
+}
+
+static void test_setup(void)
+{
+	struct net_if_addr *ifaddr;
+
+	net_if_foreach(iface_cb, NULL);
+	zassert_not_null(eth_iface, "No test interface");
+
+	ifaddr = net_if_ipv4_addr_add(eth_iface, &in4addr_my,
+				      NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr, "Cannot add IPv4 address");
+
+	net_if_up(eth_iface);
+}
+
+/* Send a burst of packets while the TX thread cannot run, so that all of
+ * them are waiting in the TX queue when it wakes up.
+ */
+static void send_burst(void)
+{
+	struct net_context *ctx;
+	struct sockaddr_in dst_addr4 = {
+		.sin_family = AF_INET,
+		.sin_port = htons(TEST_PORT),
+	};
+	int ret, len, i;
+
+	ret = net_context_get(AF_INET, SOCK_DGRAM, IPPROTO_UDP, &ctx);
+	zassert_equal(ret, 0, "Create IPv4 UDP context failed");
+
+	memcpy(&dst_addr4.sin_addr, &in4addr_dst, sizeof(struct in_addr));
+
+	len = strlen(test_data);
+
+	eth_context.batch_count = 0;
+	eth_context.single_count = 0;
+	k_sem_reset(&wait_data);
+
+	k_sched_lock();
+
+	for (i = 0; i < BURST_LEN; i++) {
+		ret = net_context_sendto(ctx, test_data, len,
+					 (struct sockaddr *)&dst_addr4,
+					 sizeof(struct sockaddr_in),
+					 NULL, K_NO_WAIT, NULL);
+		if (ret != len) {
+			break;
+		}
+	}
+
+	k_sched_unlock();
+
+	zassert_equal(ret, len, "Send UDP pkt %d failed (%d)\n", i, ret);
+
+	for (i = 0; i < BURST_LEN; i++) {
+		zassert_equal(k_sem_take(&wait_data, WAIT_TIME), 0,
+			      "Timeout while waiting packet %d", i);
+	}
+
+	net_context_unref(ctx);
+}
+
+static void test_tx_batch(void)
+{
+	eth_context.batch_limit = CONFIG_NET_TX_BATCH_SIZE;
+
+	send_burst();
+
+	/* A full batch, then the rest once the queue became empty */
+	zassert_equal(eth_context.batch_count, 2, "Invalid batch count %d",
+		      eth_context.batch_count);
+	zassert_equal(eth_context.batches[0], CONFIG_NET_TX_BATCH_SIZE,
+		      "Invalid first batch size %d", eth_context.batches[0]);
+	zassert_equal(eth_context.batches[1],
+		      BURST_LEN - CONFIG_NET_TX_BATCH_SIZE,
+		      "Invalid second batch size %d", eth_context.batches[1]);
+	zassert_equal(eth_context.single_count, 0, "Packets sent one by one");
+}
+
+static void test_tx_batch_partial(void)
+{
+	/* The frames not accepted in the batch must go through send() */
+	eth_context.batch_limit = 1;
+
+	send_burst();
+
+	zassert_equal(eth_context.batch_count, 2, "Invalid batch count %d",
+		      eth_context.batch_count);
+	zassert_equal(eth_context.single_count, BURST_LEN - 2,
+		      "Invalid count of packets sent one by one %d",
+		      eth_context.single_count);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(net_tx_batch_test,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_tx_batch),
+			 ztest_unit_test(test_tx_batch_partial)
+			 );
+
+	ztest_run_test_suite(net_tx_batch_test);
+}
@@ -153,6 +153,7 @@ struct ud {
 };
 
 static struct ud *returned_ud;
+static k_tid_t returned_thread;
 
 static enum net_verdict test_ok(struct net_conn *conn,
 				struct net_pkt *pkt,
@@ -175,6 +176,7 @@ static enum net_verdict test_ok(struct net_conn *conn,
 	fail = false;
 
 	returned_ud = user_data;
+	returned_thread = k_current_get();
 
 	net_pkt_unref(pkt);
 
@@ -663,9 +665,105 @@ void test_udp(void)
 	zassert_false(test_failed, "udp tests failed");
 }
 
+#define MANY_PORTS 32
+
+static void test_udp_many_ports(void)
+{
+	static struct ud uds[MANY_PORTS + 1];
+	struct net_conn_handle *handles[MANY_PORTS + 1];
+	struct in_addr in4addr_my = { { { 192, 0, 2, 1 } } };
+	struct in_addr in4addr_peer = { { { 192, 0, 2, 9 } } };
+	struct net_if *iface = net_if_get_default();
+	int ret, i;
+
+	k_thread_priority_set(k_current_get(), K_PRIO_COOP(7));
+
+	/* Listeners on distinct local ports, plus a connected one sharing
+	 * a local port with a listener, which must win for its peer port.
+	 */
+	for (i = 0; i <= MANY_PORTS; i++) {
+		uds[i].local_port = 5000 + (i % MANY_PORTS);
+		uds[i].remote_port = i == MANY_PORTS ? 1234 : 0;
+		uds[i].test = "many ports";
+
+		ret = net_udp_register(AF_INET, NULL, NULL,
+				       uds[i].remote_port, uds[i].local_port,
+				       test_ok, &uds[i], &handles[i]);
+		zassert_equal(ret, 0, "UDP register %d failed (%d)", i, ret);
+	}
+
+	for (i = 0; i < MANY_PORTS; i++) {
+		zassert_true(send_ipv4_udp_msg(iface, &in4addr_peer,
+					       &in4addr_my, 4321, 5000 + i,
+					       &uds[i], false),
+			     "Port %d not delivered", 5000 + i);
+	}
+
+	zassert_true(send_ipv4_udp_msg(iface, &in4addr_peer, &in4addr_my,
+				       1234, 5000, &uds[MANY_PORTS], false),
+		     "Connected handler not preferred");
+	zassert_true(send_ipv4_udp_msg(iface, &in4addr_peer, &in4addr_my,
+				       4321, 5000 + MANY_PORTS, NULL, true),
+		     "Unknown port delivered");
+
+	for (i = 0; i <= MANY_PORTS; i++) {
+		zassert_equal(net_udp_unregister(handles[i]), 0,
+			      "UDP unregister %d failed", i);
+	}
+
+	zassert_true(send_ipv4_udp_msg(iface, &in4addr_peer, &in4addr_my,
+				       4321, 5001, NULL, true),
+		     "Unregistered port delivered");
+}
+
+static void test_udp_flow_steering(void)
+{
+#if defined(CONFIG_NET_RX_FLOW_STEERING)
+	static struct ud ud = { .test = "flow steering" };
+	struct in_addr in4addr_my = { { { 192, 0, 2, 1 } } };
+	struct in_addr in4addr_peer = { { { 192, 0, 2, 9 } } };
+	struct net_if *iface = net_if_get_default();
+	k_tid_t flow_threads[16];
+	struct net_conn_handle *handle;
+	bool spread = false;
+	int ret, i, j;
+
+	ret = net_udp_register(AF_INET, NULL, NULL, 0, 4242, test_ok, &ud,
+			       &handle);
+	zassert_equal(ret, 0, "UDP register failed (%d)", ret);
+
+	/* Packets of one flow are always handled by the same queue, and
+	 * different flows are spread over several queues.
+	 */
+	for (j = 0; j < 2; j++) {
+		for (i = 0; i < ARRAY_SIZE(flow_threads); i++) {
+			zassert_true(send_ipv4_udp_msg(iface, &in4addr_peer,
+						       &in4addr_my, 6000 + i,
+						       4242, &ud, false),
+				     "Flow %d not delivered", i);
+
+			if (j == 0) {
+				flow_threads[i] = returned_thread;
+				spread |= returned_thread != flow_threads[0];
+			} else {
+				zassert_equal(returned_thread, flow_threads[i],
+					      "Flow %d changed queue", i);
+			}
+		}
+	}
+
+	zassert_true(spread, "All flows handled by one queue");
+	zassert_equal(net_udp_unregister(handle), 0, "UDP unregister failed");
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_udp_fn,
-		ztest_unit_test(test_udp));
+		ztest_unit_test(test_udp),
+		ztest_unit_test(test_udp_many_ports),
+		ztest_unit_test(test_udp_flow_steering));
 	ztest_run_test_suite(test_udp_fn);
 }
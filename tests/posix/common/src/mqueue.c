@@ -8,6 +8,7 @@
 #include <zephyr.h>
 #include <sys/printk.h>
 #include <fcntl.h>
+#include <errno.h>
 #include <sys/util.h>
 #include <mqueue.h>
 #include <pthread.h>
@@ -107,3 +108,36 @@ void test_posix_mqueue(void)
 		      "unable to close message queue descriptor.");
 	zassert_false(mq_unlink(queue), "Not able to unlink Queue");
 }
+
+void test_posix_mqueue_claim(void)
+{
+	mqd_t mqd;
+	struct mq_attr attrs;
+	int32_t mode = 0777, flags = O_RDWR | O_CREAT | O_NONBLOCK;
+	void *msg;
+
+	attrs.mq_msgsize = MESSAGE_SIZE;
+	attrs.mq_maxmsg = MESG_COUNT_PERMQ;
+
+	mqd = mq_open(queue, flags, mode, &attrs);
+	zassert_not_equal(mqd, (mqd_t)-1, "Not able to open queue");
+
+	zassert_equal(mq_receive_claim(mqd, &msg), -1, NULL);
+	zassert_equal(errno, EAGAIN, NULL);
+
+	zassert_false(mq_send_claim(mqd, &msg), "Not able to claim slot");
+	memcpy(msg, send_data, MESSAGE_SIZE);
+	zassert_false(mq_send_commit(mqd), "Not able to commit message");
+
+	zassert_equal(mq_receive_claim(mqd, &msg), MESSAGE_SIZE,
+		      "Not able to claim message");
+	zassert_false(memcmp(msg, send_data, MESSAGE_SIZE),
+		      "Error in data reception");
+	zassert_false(mq_receive_release(mqd), "Not able to release message");
+
+	zassert_equal(mq_receive_claim(mqd, &msg), -1, NULL);
+
+	zassert_false(mq_close(mqd),
+		      "unable to close message queue descriptor.");
+	zassert_false(mq_unlink(queue), "Not able to unlink Queue");
+}
@@ -143,3 +143,193 @@ void test_posix_rw_lock(void)
 	zassert_false(pthread_rwlock_destroy(&rwlock),
 		      "Failed to destroy rwlock");
 }
+
+/* Threads of the tests below log the order in which they get the lock */
+#define READER(id) (id)
+#define WRITER(id) (0x10 | (id))
+
+static int events[N_THR];
+static atomic_t n_events;
+static int timed_ret;
+
+static void event_log(int event)
+{
+	events[atomic_inc(&n_events)] = event;
+}
+
+static void *reader(void *p1)
+{
+	zassert_false(pthread_rwlock_rdlock(&rwlock), "Failed to lock");
+	event_log(READER(POINTER_TO_INT(p1)));
+	usleep(USEC_PER_MSEC * 5U);
+	zassert_false(pthread_rwlock_unlock(&rwlock), "Failed to unlock");
+
+	return NULL;
+}
+
+static void *writer(void *p1)
+{
+	zassert_false(pthread_rwlock_wrlock(&rwlock), "Failed to lock");
+	event_log(WRITER(POINTER_TO_INT(p1)));
+	usleep(USEC_PER_MSEC * 5U);
+	zassert_false(pthread_rwlock_unlock(&rwlock), "Failed to unlock");
+
+	return NULL;
+}
+
+static void *timed_writer(void *p1)
+{
+	struct timespec abstime;
+
+	clock_gettime(CLOCK_MONOTONIC, &abstime);
+	abstime.tv_nsec += NSEC_PER_MSEC * 20U;
+	if (abstime.tv_nsec >= NSEC_PER_SEC) {
+		abstime.tv_sec++;
+		abstime.tv_nsec -= NSEC_PER_SEC;
+	}
+
+	timed_ret = pthread_rwlock_timedwrlock(&rwlock, &abstime);
+	if (timed_ret == 0) {
+		event_log(WRITER(POINTER_TO_INT(p1)));
+		zassert_false(pthread_rwlock_unlock(&rwlock),
+			      "Failed to unlock");
+	}
+
+	return NULL;
+}
+
+static pthread_t spawn(int i, void *(*entry)(void *))
+{
+	pthread_attr_t attr;
+	pthread_t thread;
+
+	zassert_equal(pthread_attr_init(&attr), 0,
+		      "Unable to create pthread object attrib");
+	pthread_attr_setstack(&attr, &stack[i][0], STACKSZ);
+	zassert_false(pthread_create(&thread, &attr, entry, INT_TO_POINTER(i)),
+		      "Low memory to thread new thread");
+
+	return thread;
+}
+
+static void join_all(pthread_t *threads, int n)
+{
+	void *status;
+
+	for (int i = 0; i < n; i++) {
+		zassert_false(pthread_join(threads[i], &status),
+			      "Failed to join");
+	}
+}
+
+static void events_reset(void)
+{
+	atomic_set(&n_events, 0);
+	(void)memset(events, 0, sizeof(events));
+}
+
+/* Readers and a writer wait for a write locked lock. Unlocking hands the
+ * lock over right away: to all readers, or to the writer when writers are
+ * preferred.
+ */
+void test_posix_rw_lock_handover(void)
+{
+	pthread_t threads[N_THR];
+
+	events_reset();
+	zassert_false(pthread_rwlock_init(&rwlock, NULL),
+		      "Failed to create rwlock");
+	zassert_false(pthread_rwlock_wrlock(&rwlock), "Failed to lock");
+
+	threads[0] = spawn(0, reader);
+	threads[1] = spawn(1, reader);
+	threads[2] = spawn(2, writer);
+	usleep(USEC_PER_MSEC * 5U);
+	zassert_equal(atomic_get(&n_events), 0, "lock should be held");
+
+	zassert_false(pthread_rwlock_unlock(&rwlock), "Failed to unlock");
+
+	/* Granted before the waiters even run */
+	if (IS_ENABLED(CONFIG_PTHREAD_RWLOCK_PREFER_WRITER)) {
+		zassert_equal(pthread_rwlock_tryrdlock(&rwlock), EBUSY,
+			      "writer should own the lock");
+	} else {
+		zassert_equal(pthread_rwlock_trywrlock(&rwlock), EBUSY,
+			      "readers should own the lock");
+	}
+
+	join_all(threads, N_THR);
+	zassert_equal(atomic_get(&n_events), N_THR, "all should lock");
+
+	if (IS_ENABLED(CONFIG_PTHREAD_RWLOCK_PREFER_WRITER)) {
+		zassert_equal(events[0], WRITER(2), "writer should be first");
+		zassert_true(events[1] < WRITER(0) && events[2] < WRITER(0),
+			     "readers should follow");
+	} else {
+		zassert_true(events[0] < WRITER(0) && events[1] < WRITER(0),
+			     "readers should be first");
+		zassert_equal(events[2], WRITER(2), "writer should follow");
+	}
+
+	zassert_false(pthread_rwlock_destroy(&rwlock),
+		      "Failed to destroy rwlock");
+}
+
+/* A writer times out waiting for a read locked lock. A reader that came
+ * in after it then gets the lock, and the lock has no waiters left.
+ */
+void test_posix_rw_lock_timeout(void)
+{
+	pthread_t threads[2];
+
+	events_reset();
+	zassert_false(pthread_rwlock_init(&rwlock, NULL),
+		      "Failed to create rwlock");
+	zassert_false(pthread_rwlock_rdlock(&rwlock), "Failed to lock");
+
+	threads[0] = spawn(0, timed_writer);
+	usleep(USEC_PER_MSEC * 5U);
+	threads[1] = spawn(1, reader);
+	usleep(USEC_PER_MSEC * 5U);
+
+	/* A waiting writer only holds new readers back if preferred */
+	zassert_equal(atomic_get(&n_events),
+		      IS_ENABLED(CONFIG_PTHREAD_RWLOCK_PREFER_WRITER) ? 0 : 1,
+		      "unexpected reader state");
+
+	join_all(threads, 2);
+	zassert_equal(timed_ret, ETIMEDOUT, "writer should time out");
+	zassert_equal(atomic_get(&n_events), 1, "reader should lock");
+	zassert_equal(events[0], READER(1), "reader should lock");
+
+	zassert_false(pthread_rwlock_unlock(&rwlock), "Failed to unlock");
+	zassert_false(pthread_rwlock_trywrlock(&rwlock),
+		      "lock should be free");
+	zassert_false(pthread_rwlock_unlock(&rwlock), "Failed to unlock");
+	zassert_false(pthread_rwlock_destroy(&rwlock),
+		      "Failed to destroy rwlock");
+}
+
+/* Unlocking a lock that is not held, or write locked by another thread */
+void test_posix_rw_lock_eperm(void)
+{
+	pthread_t thread;
+
+	events_reset();
+	zassert_false(pthread_rwlock_init(&rwlock, NULL),
+		      "Failed to create rwlock");
+	zassert_equal(pthread_rwlock_unlock(&rwlock), EPERM,
+		      "unlocking a free lock should fail");
+
+	thread = spawn(0, writer);
+	usleep(USEC_PER_MSEC);
+	zassert_equal(atomic_get(&n_events), 1, "writer should lock");
+	zassert_equal(pthread_rwlock_unlock(&rwlock), EPERM,
+		      "only the writer can unlock");
+
+	join_all(&thread, 1);
+	zassert_equal(pthread_rwlock_unlock(&rwlock), EPERM,
+		      "unlocking a free lock should fail");
+	zassert_false(pthread_rwlock_destroy(&rwlock),
+		      "Failed to destroy rwlock");
+}
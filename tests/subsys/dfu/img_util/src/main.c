@@ -7,6 +7,11 @@
 #include <ztest.h>
 #include <storage/flash_map.h>
 #include <dfu/flash_img.h>
+#include <sys/byteorder.h>
+
+#ifdef CONFIG_IMG_ENABLE_IMAGE_CHECK
+#include <tinycrypt/sha256.h>
+#endif
 
 void test_init_id(void)
 {
@@ -107,11 +112,157 @@ void test_collecting(void)
 #endif
 }
 
+#ifdef CONFIG_IMG_DELTA
+static void put_le32(uint8_t **p, uint32_t val)
+{
+	sys_put_le32(val, *p);
+	*p += 4;
+}
+
+void test_delta(void)
+{
+	struct flash_img_context ctx;
+	const struct flash_area *src;
+	uint8_t patch[8 + 12 + 100 + 20 + 12 + 30];
+	uint8_t src_data[200];
+	uint8_t expected[150];
+	uint8_t img[150];
+	uint8_t *p = patch;
+	size_t i, n;
+	int ret;
+
+	/* The storage partition stands in for the running image */
+	ret = flash_area_open(FLASH_AREA_ID(storage), &src);
+	zassert_true(ret == 0, "Flash area open failure (%d)", ret);
+
+	ret = flash_area_erase(src, 0, src->fa_size);
+	zassert_true(ret == 0, "Flash erase failure (%d)", ret);
+
+	for (i = 0; i < sizeof(src_data); i++) {
+		src_data[i] = i * 3;
+	}
+
+	ret = flash_area_write(src, 0, src_data, sizeof(src_data));
+	zassert_true(ret == 0, "Flash write failure (%d)", ret);
+
+	/* Source 0..100 plus one, 20 new bytes, then source 150..180 */
+	put_le32(&p, 0x544c445a);
+	put_le32(&p, sizeof(expected));
+	put_le32(&p, 100);
+	put_le32(&p, 20);
+	put_le32(&p, 50);
+	for (i = 0; i < 100; i++) {
+		*p++ = 1;
+		expected[i] = i * 3 + 1;
+	}
+	for (i = 100; i < 120; i++) {
+		*p++ = i;
+		expected[i] = i;
+	}
+	put_le32(&p, 30);
+	put_le32(&p, 0);
+	put_le32(&p, 0);
+	for (i = 120; i < 150; i++) {
+		*p++ = 0;
+		expected[i] = (i + 30) * 3;
+	}
+
+	ret = flash_img_init(&ctx);
+	zassert_true(ret == 0, "Flash img init");
+
+	ret = flash_area_erase(ctx.flash_area, 0, ctx.flash_area->fa_size);
+	zassert_true(ret == 0, "Flash erase failure (%d)", ret);
+
+	ret = flash_img_delta_init_id(&ctx, FLASH_AREA_ID(storage));
+	zassert_true(ret == 0, "Flash img delta init");
+
+	/* Feed the patch in pieces that straddle the records */
+	for (i = 0; i < sizeof(patch); i += n) {
+		n = MIN(7, sizeof(patch) - i);
+		ret = flash_img_delta_write(&ctx, patch + i, n, false);
+		zassert_true(ret == 0, "Delta write failure (%d)", ret);
+	}
+
+	ret = flash_img_delta_write(&ctx, NULL, 0, true);
+	zassert_true(ret == 0, "Delta flush failure (%d)", ret);
+
+	ret = flash_area_open(FLASH_AREA_ID(image_1), &src);
+	zassert_true(ret == 0, "Flash area open failure (%d)", ret);
+
+	ret = flash_area_read(src, 0, img, sizeof(img));
+	zassert_true(ret == 0, "Flash read failure (%d)", ret);
+	zassert_mem_equal(img, expected, sizeof(expected),
+			  "Patched image mismatch");
+}
+#else
+void test_delta(void)
+{
+	ztest_test_skip();
+}
+#endif
+
+#ifdef CONFIG_IMG_ENABLE_IMAGE_CHECK
+void test_check(void)
+{
+	struct tc_sha256_state_struct sha256;
+	uint8_t digest[TC_SHA256_DIGEST_SIZE];
+	struct flash_img_check fic = {
+		.match = digest,
+	};
+	struct flash_img_context ctx;
+	uint8_t data[100];
+	size_t i;
+	int ret;
+
+	for (i = 0; i < sizeof(data); i++) {
+		data[i] = i ^ 0x5a;
+	}
+
+	ret = flash_img_init(&ctx);
+	zassert_true(ret == 0, "Flash img init");
+
+	ret = flash_area_erase(ctx.flash_area, 0, ctx.flash_area->fa_size);
+	zassert_true(ret == 0, "Flash erase failure (%d)", ret);
+
+	/* 1000 bytes, not a multiple of the image buffer */
+	tc_sha256_init(&sha256);
+	for (i = 0; i < 10; i++) {
+		ret = flash_img_buffered_write(&ctx, data, sizeof(data), false);
+		zassert_true(ret == 0, "Image write failure (%d)", ret);
+		tc_sha256_update(&sha256, data, sizeof(data));
+	}
+	tc_sha256_final(digest, &sha256);
+
+	ret = flash_img_buffered_write(&ctx, NULL, 0, true);
+	zassert_true(ret == 0, "Image flush failure (%d)", ret);
+
+	fic.clen = 10 * sizeof(data);
+	ret = flash_img_check(&ctx, &fic, FLASH_AREA_ID(image_1));
+	zassert_true(ret == 0, "Image check failure (%d)", ret);
+
+	fic.clen--;
+	ret = flash_img_check(&ctx, &fic, FLASH_AREA_ID(image_1));
+	zassert_equal(ret, -EINVAL, "Shorter image passed the check");
+
+	fic.clen++;
+	digest[0] ^= 1;
+	ret = flash_img_check(&ctx, &fic, FLASH_AREA_ID(image_1));
+	zassert_equal(ret, -EINVAL, "Wrong hash passed the check");
+}
+#else
+void test_check(void)
+{
+	ztest_test_skip();
+}
+#endif
+
 void test_main(void)
 {
 	ztest_test_suite(test_util,
 			ztest_unit_test(test_collecting),
-			ztest_unit_test(test_init_id)
+			ztest_unit_test(test_init_id),
+			ztest_unit_test(test_delta),
+			ztest_unit_test(test_check)
 			);
 	ztest_run_test_suite(test_util);
 }
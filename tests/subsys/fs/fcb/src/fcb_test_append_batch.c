@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "fcb_test.h"
+
+void test_fcb_append_batch(void)
+{
+	int rc;
+	struct fcb *fcb;
+	struct fcb_batch_elem elems[16];
+	uint8_t test_data[16][16];
+	uint8_t buf[512];
+	int i;
+	int j;
+	int var_cnt;
+
+	fcb = &test_fcb;
+
+	for (i = 0; i < ARRAY_SIZE(elems); i++) {
+		for (j = 0; j < i; j++) {
+			test_data[i][j] = fcb_test_append_data(i, j);
+		}
+		elems[i].data = test_data[i];
+		elems[i].len = i;
+	}
+
+	rc = fcb_append_batch(fcb, elems, ARRAY_SIZE(elems), buf, 16);
+	zassert_true(rc == -ENOMEM, "fcb_append_batch overflowed buffer");
+
+	rc = fcb_append_batch(fcb, elems, ARRAY_SIZE(elems), buf, sizeof(buf));
+	zassert_true(rc == 0, "fcb_append_batch call failure");
+
+	var_cnt = 0;
+	rc = fcb_walk(fcb, 0, fcb_test_data_walk_cb, &var_cnt);
+	zassert_true(rc == 0, "fcb_walk call failure");
+	zassert_true(var_cnt == ARRAY_SIZE(elems),
+		     "fetched data size not match to wrote data size");
+}
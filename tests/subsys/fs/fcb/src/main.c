@@ -138,6 +138,7 @@ void test_fcb_empty_walk(void);
 void test_fcb_append(void);
 void test_fcb_append_too_big(void);
 void test_fcb_append_fill(void);
+void test_fcb_append_batch(void);
 void test_fcb_reset(void);
 void test_fcb_rotate(void);
 void test_fcb_multi_scratch(void);
@@ -162,6 +163,9 @@ void test_main(void)
 			 ztest_unit_test_setup_teardown(test_fcb_append_fill,
 							fcb_pretest_2_sectors,
 							teardown_nothing),
+			 ztest_unit_test_setup_teardown(test_fcb_append_batch,
+							fcb_pretest_2_sectors,
+							teardown_nothing),
 			 ztest_unit_test_setup_teardown(test_fcb_rotate,
 							fcb_pretest_2_sectors,
 							teardown_nothing),
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Vectored and asynchronous littlefs file operations */
+
+#include <string.h>
+#include <ztest.h>
+#include "testfs_tests.h"
+#include "testfs_lfs.h"
+
+#define HELLO "hello"
+#define GOODBYE "goodbye"
+
+static int verify_file(struct fs_file_t *file, const char *expected)
+{
+	char buf[32] = { 0 };
+	char *head = buf;
+	char *tail = buf + strlen(HELLO);
+	struct fs_iovec iov[] = {
+		{ .base = head, .len = strlen(HELLO) },
+		{ .base = tail, .len = sizeof(buf) - strlen(HELLO) - 1 },
+	};
+
+	zassert_equal(fs_seek(file, 0, FS_SEEK_SET), 0,
+		      "seek failed");
+	zassert_equal(fs_readv(file, iov, ARRAY_SIZE(iov)), strlen(expected),
+		      "readv failed");
+	zassert_equal(strcmp(buf, expected), 0,
+		      "readv data mismatch");
+
+	return TC_PASS;
+}
+
+void test_lfs_vectored(void)
+{
+	struct fs_mount_t *mp = &testfs_small_mnt;
+	struct testfs_path path;
+	struct fs_file_t file;
+	struct fs_iovec iov[] = {
+		{ .base = (void *)HELLO, .len = strlen(HELLO) },
+		{ .base = (void *)GOODBYE, .len = strlen(GOODBYE) },
+	};
+
+	zassert_equal(testfs_lfs_wipe_partition(mp), TC_PASS,
+		      "failed to wipe partition");
+	zassert_equal(fs_mount(mp), 0,
+		      "mount failed");
+
+	testfs_path_init(&path, mp, "vectored", TESTFS_PATH_END);
+	zassert_equal(fs_open(&file, path.path, FS_O_CREATE | FS_O_RDWR), 0,
+		      "open failed");
+
+	zassert_equal(fs_writev(&file, iov, ARRAY_SIZE(iov)),
+		      strlen(HELLO) + strlen(GOODBYE),
+		      "writev failed");
+	zassert_equal(verify_file(&file, HELLO GOODBYE), TC_PASS,
+		      "verify failed");
+
+#ifdef CONFIG_FS_ASYNC
+	struct fs_async_op op;
+	struct k_poll_signal signal;
+	struct k_poll_event evt = K_POLL_EVENT_INITIALIZER(
+		K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &signal);
+	unsigned int signaled;
+	int result;
+
+	k_poll_signal_init(&signal);
+	zassert_equal(fs_writev_async(&op, &file, iov, ARRAY_SIZE(iov),
+				      &signal), 0,
+		      "writev_async failed");
+	zassert_equal(k_poll(&evt, 1, K_SECONDS(5)), 0,
+		      "writev_async did not complete");
+	k_poll_signal_check(&signal, &signaled, &result);
+	zassert_equal(result, strlen(HELLO) + strlen(GOODBYE),
+		      "writev_async result mismatch");
+	zassert_equal(verify_file(&file, HELLO GOODBYE HELLO GOODBYE),
+		      TC_PASS, "verify after async write failed");
+#endif
+
+	zassert_equal(fs_close(&file), 0,
+		      "close failed");
+	zassert_equal(fs_unmount(mp), 0,
+		      "unmount failed");
+}
@@ -24,6 +24,9 @@ void test_lfs_dirops(void);
 /* Tests in test_lfs_perf */
 void test_lfs_perf(void);
 
+/* Tests in test_lfs_vectored */
+void test_lfs_vectored(void);
+
 /* Test fs_open flags */
 void test_fs_open_flags_lfs(void);
 
@@ -714,6 +714,136 @@ void test_nvs_gc_corrupt_ate(void)
 	zassert_true(err == 0,  "nvs_init call failure: %d", err);
 }
 
+/*
+ * Test that nvs_gc_ahead() only closes the current sector when it cannot hold
+ * the requested length, after which writing that length does not close it.
+ */
+void test_nvs_gc_ahead(void)
+{
+	int err;
+	ssize_t len;
+	uint16_t cnt = 0U;
+	uint32_t ate_wra;
+	uint8_t buf[64];
+
+	fs.sector_count = 3;
+
+	err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	zassert_true(err == 0,  "nvs_init call failure: %d", err);
+
+	memset(buf, 0xaa, sizeof(buf));
+	ate_wra = fs.ate_wra;
+
+	err = nvs_gc_ahead(&fs, sizeof(buf));
+	zassert_true(err == 0,  "nvs_gc_ahead call failure: %d", err);
+	zassert_equal(fs.ate_wra, ate_wra, "sector closed while not full");
+
+	/* Fill the first sector, then the second one up to less than three
+	 * entries. Only the last entry remains valid.
+	 */
+	while (((fs.ate_wra >> ADDR_SECT_SHIFT) == 0U) ||
+	       (fs.ate_wra - fs.data_wra >= 3 * (sizeof(buf) + 8))) {
+		cnt++;
+		memcpy(buf, &cnt, sizeof(cnt));
+		len = nvs_write(&fs, TEST_DATA_ID, buf, sizeof(buf));
+		zassert_true(len == sizeof(buf), "nvs_write failed: %d", len);
+	}
+
+	err = nvs_gc_ahead(&fs, fs.sector_size / 2);
+	zassert_true(err == 0,  "nvs_gc_ahead call failure: %d", err);
+	zassert_equal(fs.ate_wra >> ADDR_SECT_SHIFT, 2, "sector not closed");
+
+	ate_wra = fs.ate_wra;
+	cnt++;
+	memcpy(buf, &cnt, sizeof(cnt));
+	len = nvs_write(&fs, TEST_DATA_ID, buf, sizeof(buf));
+	zassert_true(len == sizeof(buf), "nvs_write failed: %d", len);
+	zassert_equal(fs.ate_wra >> ADDR_SECT_SHIFT, ate_wra >> ADDR_SECT_SHIFT,
+		      "write closed the sector");
+
+	err = nvs_gc_ahead(&fs, fs.sector_size);
+	zassert_true(err == -EINVAL, "oversized entry accepted: %d", err);
+}
+
+static int flash_sim_read_calls_find(struct stats_hdr *hdr, void *arg,
+				     const char *name, uint16_t off)
+{
+	if (!strcmp(name, "flash_read_calls")) {
+		uint32_t **flash_read_stat = (uint32_t **) arg;
+		*flash_read_stat = (uint32_t *)((uint8_t *)hdr + off);
+	}
+
+	return 0;
+}
+
+/*
+ * Test that the lookup cache follows the entries moved by garbage-collection
+ * and that reads use it instead of walking the whole allocation table.
+ */
+void test_nvs_cache(void)
+{
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	int err;
+	ssize_t len;
+	uint16_t id, data, data_read;
+	uint32_t *flash_read_stat = NULL;
+	uint32_t reads;
+
+	fs.sector_count = 3;
+
+	err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	zassert_true(err == 0,  "nvs_init call failure: %d", err);
+
+	/* Keep rewriting id 0 so that the other ids get moved by gc */
+	for (id = 1; id < 8; id++) {
+		len = nvs_write(&fs, id, &id, sizeof(id));
+		zassert_true(len == sizeof(id), "nvs_write failed: %d", len);
+	}
+	for (data = 0; data < fs.sector_size; data++) {
+		len = nvs_write(&fs, 0, &data, sizeof(data));
+		zassert_true(len == sizeof(data), "nvs_write failed: %d", len);
+	}
+
+	for (id = 1; id < 8; id++) {
+		len = nvs_read(&fs, id, &data_read, sizeof(data_read));
+		zassert_true(len == sizeof(data_read),
+			     "nvs_read failed: %d", len);
+		zassert_equal(data_read, id, "wrong data read");
+	}
+
+	err = nvs_delete(&fs, 1);
+	zassert_true(err == 0,  "nvs_delete call failure: %d", err);
+	len = nvs_read(&fs, 1, &data_read, sizeof(data_read));
+	zassert_true(len == -ENOENT, "nvs_read shouldn't found the entry: %d",
+		     len);
+
+	/* The cache is rebuilt from flash on init */
+	err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	zassert_true(err == 0,  "nvs_init call failure: %d", err);
+
+	stats_walk(sim_stats, flash_sim_read_calls_find, &flash_read_stat);
+	zassert_not_null(flash_read_stat, "flash_read_calls stat not found");
+
+	/* An id that was never written is found missing without flash read */
+	reads = *flash_read_stat;
+	len = nvs_read(&fs, 8, &data_read, sizeof(data_read));
+	zassert_true(len == -ENOENT, "nvs_read shouldn't found the entry: %d",
+		     len);
+	zassert_equal(*flash_read_stat, reads, "unexpected flash read");
+
+	/* Reading an entry takes its ate, possibly the close ate of its
+	 * sector, and its data.
+	 */
+	reads = *flash_read_stat;
+	len = nvs_read(&fs, 7, &data_read, sizeof(data_read));
+	zassert_true(len == sizeof(data_read), "nvs_read failed: %d", len);
+	zassert_equal(data_read, 7, "wrong data read");
+	zassert_true(*flash_read_stat - reads <= 3, "unexpected flash reads");
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_nvs,
@@ -737,7 +867,11 @@ void test_main(void)
 			 ztest_unit_test_setup_teardown(
 				 test_nvs_gc_corrupt_close_ate, setup, teardown),
 			 ztest_unit_test_setup_teardown(
-				 test_nvs_gc_corrupt_ate, setup, teardown)
+				 test_nvs_gc_corrupt_ate, setup, teardown),
+			 ztest_unit_test_setup_teardown(
+				 test_nvs_gc_ahead, setup, teardown),
+			 ztest_unit_test_setup_teardown(
+				 test_nvs_cache, setup, teardown)
 			);
 
 	ztest_run_test_suite(test_nvs);
@@ -57,10 +57,46 @@ void test_jwt(void)
 	printk("len: %zd\n", jwt_payload_len(&build));
 }
 
+void test_jwt_signer(void)
+{
+	char ref[460], buf[460];
+	struct jwt_builder build;
+	struct jwt_signer signer;
+	int res;
+	int i;
+
+	res = jwt_init_builder(&build, ref, sizeof(ref));
+	zassert_equal(res, 0, "Setting up jwt");
+	res = jwt_add_payload(&build, 1530312026, 1530308426,
+			      "iot-work-199419");
+	zassert_equal(res, 0, "Adding payload");
+	res = jwt_sign(&build, jwt_test_private_der, jwt_test_private_der_len);
+	zassert_equal(res, 0, "Signing payload");
+
+	res = jwt_signer_init(&signer, jwt_test_private_der,
+			      jwt_test_private_der_len);
+	zassert_equal(res, 0, "Parsing key");
+
+	/* The signer is reused, RS256 signatures are deterministic. */
+	for (i = 0; i < 2; i++) {
+		res = jwt_init_builder(&build, buf, sizeof(buf));
+		zassert_equal(res, 0, "Setting up jwt");
+		res = jwt_add_payload(&build, 1530312026, 1530308426,
+				      "iot-work-199419");
+		zassert_equal(res, 0, "Adding payload");
+		res = jwt_signer_sign(&signer, &build);
+		zassert_equal(res, 0, "Signing payload");
+		zassert_equal(strcmp(buf, ref), 0, "Token mismatch");
+	}
+
+	jwt_signer_free(&signer);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(lib_jwt_test,
-		ztest_unit_test(test_jwt));
+		ztest_unit_test(test_jwt),
+		ztest_unit_test(test_jwt_signer));
 
 	ztest_run_test_suite(lib_jwt_test);
 }
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Measure the cost of logging calls with runtime filtering
+ */
+
+#include <tc_util.h>
+#include <zephyr.h>
+#include <ztest.h>
+#include <logging/log_backend.h>
+#include <logging/log_ctrl.h>
+#include <logging/log.h>
+
+#define LOG_MODULE_NAME test
+LOG_MODULE_REGISTER(LOG_MODULE_NAME, LOG_LEVEL_DBG);
+
+#define ITERATIONS 1000
+
+static uint32_t msg_count;
+
+static void put(struct log_backend const *const backend,
+		struct log_msg *msg)
+{
+	msg_count++;
+}
+
+static void panic(struct log_backend const *const backend)
+{
+}
+
+const struct log_backend_api log_backend_test_api = {
+	.put = put,
+	.panic = panic,
+};
+
+LOG_BACKEND_DEFINE(backend, log_backend_test_api, false);
+
+static void process_all(void)
+{
+	while (log_process(false)) {
+	}
+}
+
+static void log_setup(uint32_t level)
+{
+	log_init();
+	log_backend_enable(&backend, NULL, level);
+	process_all();
+	msg_count = 0;
+}
+
+/**
+ * @brief Test that the aggregated filter follows the backend filters
+ *
+ * The macros only check the aggregated filter, so a level must pass it if
+ * and only if a backend accepts it.
+ */
+void test_log_aggregated_filter(void)
+{
+	uint32_t id = LOG_CURRENT_MODULE_ID();
+
+	log_setup(LOG_LEVEL_INF);
+
+	LOG_INF("accepted");
+	LOG_DBG("filtered");
+	process_all();
+	zassert_equal(msg_count, 1, "Unexpected number of messages");
+
+	log_filter_set(&backend, CONFIG_LOG_DOMAIN_ID, id, LOG_LEVEL_DBG);
+	LOG_DBG("accepted");
+	process_all();
+	zassert_equal(msg_count, 2, "Unexpected number of messages");
+
+	log_filter_set(&backend, CONFIG_LOG_DOMAIN_ID, id, LOG_LEVEL_ERR);
+	LOG_WRN("filtered");
+	LOG_ERR("accepted");
+	process_all();
+	zassert_equal(msg_count, 3, "Unexpected number of messages");
+
+	log_backend_disable(&backend);
+	LOG_ERR("filtered");
+	process_all();
+	zassert_equal(msg_count, 3, "Unexpected number of messages");
+	zassert_equal(log_buffered_cnt(), 0, "Message created");
+}
+
+/**
+ * @brief Measure logging calls rejected and accepted by runtime filtering
+ */
+void test_log_benchmark(void)
+{
+	uint32_t start;
+	uint32_t filtered;
+	uint32_t accepted;
+	int i;
+
+	log_setup(LOG_LEVEL_INF);
+
+	start = k_cycle_get_32();
+	for (i = 0; i < ITERATIONS; i++) {
+		LOG_DBG("filtered %d", i);
+	}
+	filtered = k_cycle_get_32() - start;
+
+	zassert_equal(log_buffered_cnt(), 0, "Message created");
+
+	start = k_cycle_get_32();
+	for (i = 0; i < ITERATIONS; i++) {
+		LOG_INF("accepted %d", i);
+		process_all();
+	}
+	accepted = k_cycle_get_32() - start;
+
+	zassert_equal(msg_count, ITERATIONS, "Messages lost");
+
+	TC_PRINT("Filtered message: %u cycles\n", filtered / ITERATIONS);
+	TC_PRINT("Accepted and processed message: %u cycles\n",
+		 accepted / ITERATIONS);
+
+	zassert_true(filtered < accepted, "Filtering slower than logging");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(test_log_benchmark,
+			 ztest_unit_test(test_log_aggregated_filter),
+			 ztest_unit_test(test_log_benchmark));
+	ztest_run_test_suite(test_log_benchmark);
+}
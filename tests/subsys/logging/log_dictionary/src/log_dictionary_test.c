@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2020 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Test dictionary based log output
+ */
+
+#include <logging/log.h>
+#include <logging/log_backend.h>
+#include <logging/log_ctrl.h>
+#include <logging/log_output.h>
+#include <logging/log_output_dict.h>
+
+#include <stdbool.h>
+#include <zephyr.h>
+#include <ztest.h>
+
+#define LOG_MODULE_NAME test
+LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+
+/* Output of the current test case */
+static uint8_t mock_buffer[256];
+static uint32_t mock_len;
+
+/* Output of the whole run, decoded on the host by log_parser.py */
+static uint8_t stream[1024];
+static uint32_t stream_len;
+
+static uint8_t log_output_buf[16];
+
+static const char const_str[] = "constant string";
+
+static int mock_output_func(uint8_t *buf, size_t size, void *ctx)
+{
+	zassert_true(mock_len + size <= sizeof(mock_buffer), "Output too long");
+	zassert_true(stream_len + size <= sizeof(stream), "Output too long");
+
+	memcpy(&mock_buffer[mock_len], buf, size);
+	mock_len += size;
+	memcpy(&stream[stream_len], buf, size);
+	stream_len += size;
+
+	return size;
+}
+
+LOG_OUTPUT_DEFINE(log_output, mock_output_func,
+		  log_output_buf, sizeof(log_output_buf));
+
+static void put(struct log_backend const *const backend, struct log_msg *msg)
+{
+	log_msg_get(msg);
+	log_output_msg_process(&log_output, msg, LOG_OUTPUT_FLAG_FORMAT_DICT);
+	log_msg_put(msg);
+}
+
+static void panic(struct log_backend const *const backend)
+{
+}
+
+static const struct log_backend_api log_backend_test_api = {
+	.put = put,
+	.panic = panic,
+};
+
+LOG_BACKEND_DEFINE(backend, log_backend_test_api, true);
+
+static void setup(void)
+{
+	mock_len = 0U;
+}
+
+static void teardown(void)
+{
+}
+
+static void process_all(void)
+{
+	while (log_process(false)) {
+	}
+}
+
+static const uint8_t *validate_hdr(uint8_t type, uint16_t len, uint8_t nstr)
+{
+	uint16_t source = log_const_source_id(
+				&LOG_ITEM_CONST_DATA(LOG_MODULE_NAME));
+	struct log_dict_output_normal_msg_hdr hdr;
+
+	zassert_true(mock_len >= sizeof(hdr), "No record");
+	memcpy(&hdr, mock_buffer, sizeof(hdr));
+
+	zassert_equal(hdr.type, type, "Unexpected type");
+	zassert_equal(hdr.ids & 0x7, LOG_LEVEL_INF, "Unexpected level");
+	zassert_equal(hdr.source, source, "Unexpected source");
+	zassert_not_equal(hdr.fmt, 0, "No format string");
+	zassert_equal(hdr.len, len, "Unexpected length");
+	zassert_equal(hdr.nstr, nstr, "Unexpected number of strings");
+
+	return &mock_buffer[sizeof(hdr)];
+}
+
+/* Only the string duplicated with log_strdup() is copied, the constant
+ * one is referred to by its address.
+ */
+void test_log_dict_std(void)
+{
+	char dup[] = "duplicated string";
+	const uint8_t *data;
+	log_arg_t arg;
+
+	LOG_INF("const %s strdup %s num %d", const_str, log_strdup(dup), 42);
+	/* The duplicate is not affected */
+	dup[0] = 'D';
+	process_all();
+
+	data = validate_hdr(LOG_DICT_OUTPUT_MSG_STD, 3, 1);
+
+	memcpy(&arg, data, sizeof(arg));
+	zassert_equal(arg, (log_arg_t)const_str, "Unexpected string address");
+	data += 2 * sizeof(arg);
+	memcpy(&arg, data, sizeof(arg));
+	zassert_equal(arg, 42, "Unexpected argument");
+	data += sizeof(arg);
+
+	zassert_equal(*data++, 1, "Unexpected string argument index");
+	zassert_equal(strcmp((const char *)data, "duplicated string"), 0,
+		      "Unexpected string");
+	data += strlen("duplicated string") + 1;
+
+	zassert_equal(data - mock_buffer, mock_len, "Unexpected record size");
+}
+
+void test_log_dict_hexdump(void)
+{
+	static const uint8_t hexdump[] = { 0x01, 0x02, 0x03, 0x04, 0x05 };
+	const uint8_t *data;
+
+	LOG_HEXDUMP_INF(hexdump, sizeof(hexdump), "hexdump");
+	process_all();
+
+	data = validate_hdr(LOG_DICT_OUTPUT_MSG_HEXDUMP, sizeof(hexdump), 0);
+	zassert_equal(memcmp(data, hexdump, sizeof(hexdump)), 0,
+		      "Unexpected data");
+	data += sizeof(hexdump);
+
+	zassert_equal(data - mock_buffer, mock_len, "Unexpected record size");
+}
+
+void test_log_dict_dropped(void)
+{
+	struct log_dict_output_dropped_msg msg;
+
+	log_output_dropped_dict_process(&log_output, 3);
+
+	zassert_equal(mock_len, sizeof(msg), "Unexpected record size");
+	memcpy(&msg, mock_buffer, sizeof(msg));
+	zassert_equal(msg.type, LOG_DICT_OUTPUT_MSG_DROPPED, "Unexpected type");
+	zassert_equal(msg.count, 3, "Unexpected count");
+}
+
+/* Print the output for scripts/tests/logging/test_log_parser.py */
+static void stream_print(void)
+{
+	printk("DICT_OUTPUT: ");
+	for (uint32_t i = 0; i < stream_len; i++) {
+		printk("%02x", stream[i]);
+	}
+	printk("\n");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(test_log_dictionary,
+			 ztest_unit_test_setup_teardown(test_log_dict_std,
+							setup, teardown),
+			 ztest_unit_test_setup_teardown(test_log_dict_hexdump,
+							setup, teardown),
+			 ztest_unit_test_setup_teardown(test_log_dict_dropped,
+							setup, teardown));
+	ztest_run_test_suite(test_log_dictionary);
+
+	stream_print();
+}
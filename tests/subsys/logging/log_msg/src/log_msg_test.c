@@ -10,13 +10,20 @@
  */
 
 #include <logging/log_msg.h>
+#include <sys/mpsc_pbuf.h>
 
 #include <tc_util.h>
 #include <stdbool.h>
 #include <zephyr.h>
 #include <ztest.h>
 
-extern struct k_mem_slab log_msg_pool;
+extern struct mpsc_pbuf_buffer log_msg_buffer;
+
+/* Space taken in the log buffer by a message of n chunks */
+#define MSG_BUF_SIZE(n) \
+	MPSC_PBUF_PACKET_SIZE((n) * sizeof(union log_msg_chunk) + \
+			      sizeof(void *) - sizeof(uint32_t))
+
 static const char my_string[] = "test_string";
 void test_log_std_msg(void)
 {
@@ -24,7 +31,7 @@ void test_log_std_msg(void)
 		      IS_ENABLED(CONFIG_64BIT) ? 4 : 3,
 		      "test assumes following setting");
 
-	uint32_t used_slabs = k_mem_slab_num_used_get(&log_msg_pool);
+	uint32_t used = mpsc_pbuf_used_get(&log_msg_buffer);
 	log_arg_t args[] = {1, 2, 3, 4, 5, 6};
 	struct log_msg *msg;
 
@@ -48,24 +55,24 @@ void test_log_std_msg(void)
 			break;
 		}
 
-		used_slabs += (i > LOG_MSG_NARGS_SINGLE_CHUNK) ? 2 : 1;
-		zassert_equal(used_slabs,
-			      k_mem_slab_num_used_get(&log_msg_pool),
-			      "Expected mem slab allocation.");
+		used += MSG_BUF_SIZE((i > LOG_MSG_NARGS_SINGLE_CHUNK) ? 2 : 1);
+		zassert_equal(used,
+			      mpsc_pbuf_used_get(&log_msg_buffer),
+			      "Expected log buffer allocation.");
 
 		log_msg_put(msg);
 
-		used_slabs -= (i > LOG_MSG_NARGS_SINGLE_CHUNK) ? 2 : 1;
-		zassert_equal(used_slabs,
-			      k_mem_slab_num_used_get(&log_msg_pool),
-			      "Expected mem slab allocation.");
+		used -= MSG_BUF_SIZE((i > LOG_MSG_NARGS_SINGLE_CHUNK) ? 2 : 1);
+		zassert_equal(used,
+			      mpsc_pbuf_used_get(&log_msg_buffer),
+			      "Expected log buffer allocation.");
 	}
 }
 
 void test_log_hexdump_msg(void)
 {
 
-	uint32_t used_slabs = k_mem_slab_num_used_get(&log_msg_pool);
+	uint32_t used = mpsc_pbuf_used_get(&log_msg_buffer);
 	struct log_msg *msg;
 	uint8_t data[128];
 
@@ -77,66 +84,66 @@ void test_log_hexdump_msg(void)
 	msg = log_msg_hexdump_create("test", data,
 				     LOG_MSG_HEXDUMP_BYTES_SINGLE_CHUNK - 4);
 
-	zassert_equal((used_slabs + 1),
-		      k_mem_slab_num_used_get(&log_msg_pool),
-		      "Expected mem slab allocation.");
-	used_slabs++;
+	zassert_equal((used + MSG_BUF_SIZE(1)),
+		      mpsc_pbuf_used_get(&log_msg_buffer),
+		      "Expected log buffer allocation.");
+	used += MSG_BUF_SIZE(1);
 
 	log_msg_put(msg);
 
-	zassert_equal((used_slabs - 1),
-		      k_mem_slab_num_used_get(&log_msg_pool),
-		      "Expected mem slab allocation.");
-	used_slabs--;
+	zassert_equal((used - MSG_BUF_SIZE(1)),
+		      mpsc_pbuf_used_get(&log_msg_buffer),
+		      "Expected log buffer allocation.");
+	used -= MSG_BUF_SIZE(1);
 
 	/* allocation of buffer that fits in single buffer */
 	msg = log_msg_hexdump_create("test", data,
 				     LOG_MSG_HEXDUMP_BYTES_SINGLE_CHUNK);
 
-	zassert_equal((used_slabs + 1),
-		      k_mem_slab_num_used_get(&log_msg_pool),
-		      "Expected mem slab allocation.");
-	used_slabs++;
+	zassert_equal((used + MSG_BUF_SIZE(1)),
+		      mpsc_pbuf_used_get(&log_msg_buffer),
+		      "Expected log buffer allocation.");
+	used += MSG_BUF_SIZE(1);
 
 	log_msg_put(msg);
 
-	zassert_equal((used_slabs - 1),
-		      k_mem_slab_num_used_get(&log_msg_pool),
-		      "Expected mem slab allocation.");
-	used_slabs--;
+	zassert_equal((used - MSG_BUF_SIZE(1)),
+		      mpsc_pbuf_used_get(&log_msg_buffer),
+		      "Expected log buffer allocation.");
+	used -= MSG_BUF_SIZE(1);
 
 	/* allocation of buffer that fits in 2 buffers */
 	msg = log_msg_hexdump_create("test", data,
 				     LOG_MSG_HEXDUMP_BYTES_SINGLE_CHUNK + 1);
 
-	zassert_equal((used_slabs + 2U),
-		      k_mem_slab_num_used_get(&log_msg_pool),
-		      "Expected mem slab allocation.");
-	used_slabs += 2U;
+	zassert_equal((used + MSG_BUF_SIZE(2)),
+		      mpsc_pbuf_used_get(&log_msg_buffer),
+		      "Expected log buffer allocation.");
+	used += MSG_BUF_SIZE(2);
 
 	log_msg_put(msg);
 
-	zassert_equal((used_slabs - 2U),
-		      k_mem_slab_num_used_get(&log_msg_pool),
-		      "Expected mem slab allocation.");
-	used_slabs -= 2U;
+	zassert_equal((used - MSG_BUF_SIZE(2)),
+		      mpsc_pbuf_used_get(&log_msg_buffer),
+		      "Expected log buffer allocation.");
+	used -= MSG_BUF_SIZE(2);
 
 	/* allocation of buffer that fits in 3 buffers */
 	msg = log_msg_hexdump_create("test", data,
 				     LOG_MSG_HEXDUMP_BYTES_SINGLE_CHUNK +
 				     HEXDUMP_BYTES_CONT_MSG + 1);
 
-	zassert_equal((used_slabs + 3U),
-		      k_mem_slab_num_used_get(&log_msg_pool),
-		      "Expected mem slab allocation.");
-	used_slabs += 3U;
+	zassert_equal((used + MSG_BUF_SIZE(3)),
+		      mpsc_pbuf_used_get(&log_msg_buffer),
+		      "Expected log buffer allocation.");
+	used += MSG_BUF_SIZE(3);
 
 	log_msg_put(msg);
 
-	zassert_equal((used_slabs - 3U),
-		      k_mem_slab_num_used_get(&log_msg_pool),
-		      "Expected mem slab allocation.");
-	used_slabs -= 3U;
+	zassert_equal((used - MSG_BUF_SIZE(3)),
+		      mpsc_pbuf_used_get(&log_msg_buffer),
+		      "Expected log buffer allocation.");
+	used -= MSG_BUF_SIZE(3);
 }
 
 void test_log_hexdump_data_get_single_chunk(void)
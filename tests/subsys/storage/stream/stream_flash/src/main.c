@@ -36,6 +36,9 @@ static size_t cb_offset;
 static int cb_ret;
 
 static uint8_t buf[BUF_LEN];
+#ifdef CONFIG_STREAM_FLASH_DOUBLE_BUFFER
+static uint8_t buf2[BUF_LEN];
+#endif
 static uint8_t read_buf[TESTBUF_SIZE];
 const static uint8_t write_buf[TESTBUF_SIZE] = {[0 ... TESTBUF_SIZE - 1] = 0xaa};
 static uint8_t written_pattern[TESTBUF_SIZE] = {[0 ... TESTBUF_SIZE - 1] = 0xaa};
@@ -375,6 +378,167 @@ static void test_stream_flash_buffered_write_whole_page(void)
 }
 #endif
 
+#ifdef CONFIG_STREAM_FLASH_SHA256
+static void test_stream_flash_sha256(void)
+{
+	struct tc_sha256_state_struct sha256;
+	uint8_t expected[TC_SHA256_DIGEST_SIZE];
+	uint8_t digest[TC_SHA256_DIGEST_SIZE];
+	int rc;
+
+	init_target();
+
+	tc_sha256_init(&sha256);
+	tc_sha256_update(&sha256, write_buf, BUF_LEN + 1);
+	tc_sha256_final(expected, &sha256);
+
+	/* Unaligned writes, the flush padding must not be hashed */
+	rc = stream_flash_buffered_write(&ctx, write_buf, 3, false);
+	zassert_equal(rc, 0, "expected success");
+	rc = stream_flash_buffered_write(&ctx, write_buf + 3, BUF_LEN - 2,
+					 true);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_sha256_get(&ctx, digest);
+	zassert_equal(rc, 0, "expected success");
+	zassert_mem_equal(digest, expected, sizeof(digest),
+			  "hash mismatch");
+}
+#else
+static void test_stream_flash_sha256(void)
+{
+	ztest_test_skip();
+}
+#endif
+
+#ifdef CONFIG_STREAM_FLASH_DOUBLE_BUFFER
+static void init_target_double_buffer(void)
+{
+	int rc;
+
+	init_target();
+
+	memset(buf2, 0, BUF_LEN);
+	rc = stream_flash_double_buffer_set(&ctx, buf2);
+	zassert_equal(rc, 0, "expected success");
+}
+
+static void test_stream_flash_double_buffer_write(void)
+{
+	int rc;
+
+	init_target();
+
+	/* Only a fresh context can be double buffered */
+	rc = stream_flash_double_buffer_set(&ctx, NULL);
+	zassert_equal(rc, -EFAULT, "should fail as buffer is NULL");
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, 1, false);
+	zassert_equal(rc, 0, "expected success");
+	rc = stream_flash_double_buffer_set(&ctx, buf2);
+	zassert_equal(rc, -EBUSY, "should fail as data was written");
+
+	init_target_double_buffer();
+
+	/* Filled buffers are accounted once handed over */
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN * 2 + 128,
+					 false);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&ctx), BUF_LEN * 2,
+		      "handed over buffers should be accounted");
+
+	/* The flush waits for everything to be programmed */
+	rc = stream_flash_buffered_write(&ctx, write_buf, 0, true);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&ctx), BUF_LEN * 2 + 128,
+		      "all data should be written");
+
+	VERIFY_WRITTEN(0, BUF_LEN * 2 + 128);
+}
+
+static void test_stream_flash_double_buffer_multi_page(void)
+{
+	int rc;
+	int num_pages = MAX_NUM_PAGES - 1;
+
+	init_target_double_buffer();
+
+	rc = stream_flash_buffered_write(&ctx, write_buf,
+					 (page_size * num_pages) + 128, true);
+	zassert_equal(rc, 0, "expected success");
+
+	VERIFY_WRITTEN(0, (page_size * num_pages) + 128);
+}
+
+static void test_stream_flash_double_buffer_error(void)
+{
+	int rc;
+
+	init_target_double_buffer();
+
+	/* A failed program or verify is reported by the next call */
+	cb_ret = -EFAULT;
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN, false);
+	zassert_equal(rc, 0, "expected success, the buffer is handed over");
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, 0, true);
+	zassert_equal(rc, -EFAULT, "expected failure from callback");
+}
+
+#ifdef CONFIG_STREAM_FLASH_ERASE
+static void test_stream_flash_double_buffer_erase_ahead(void)
+{
+	int rc;
+
+	init_target_double_buffer();
+
+	/* Put data in the second page */
+	rc = flash_write_protection_set(fdev, false);
+	zassert_equal(rc, 0, "should succeed");
+	rc = flash_write(fdev, FLASH_BASE + page_size, write_buf, BUF_LEN);
+	zassert_equal(rc, 0, "should succeed");
+	rc = flash_write_protection_set(fdev, true);
+	zassert_equal(rc, 0, "should succeed");
+
+	/* Fill the first page exactly, nothing is left to flush */
+	rc = stream_flash_buffered_write(&ctx, write_buf, page_size, false);
+	zassert_equal(rc, 0, "expected success");
+	rc = stream_flash_buffered_write(&ctx, write_buf, 0, true);
+	zassert_equal(rc, 0, "expected success");
+
+	VERIFY_WRITTEN(0, page_size);
+
+	/* The page of the next buffer is erased ahead */
+	VERIFY_ERASED(page_size, page_size);
+}
+#else
+static void test_stream_flash_double_buffer_erase_ahead(void)
+{
+	ztest_test_skip();
+}
+#endif
+#else
+static void test_stream_flash_double_buffer_write(void)
+{
+	ztest_test_skip();
+}
+
+static void test_stream_flash_double_buffer_multi_page(void)
+{
+	ztest_test_skip();
+}
+
+static void test_stream_flash_double_buffer_error(void)
+{
+	ztest_test_skip();
+}
+
+static void test_stream_flash_double_buffer_erase_ahead(void)
+{
+	ztest_test_skip();
+}
+#endif
+
 void test_main(void)
 {
 	fdev = device_get_binding(FLASH_NAME);
@@ -395,7 +559,12 @@ void test_main(void)
 	     ztest_unit_test(test_stream_flash_flush),
 	     ztest_unit_test(test_stream_flash_buffered_write_whole_page),
 	     ztest_unit_test(test_stream_flash_erase_page),
-	     ztest_unit_test(test_stream_flash_bytes_written)
+	     ztest_unit_test(test_stream_flash_bytes_written),
+	     ztest_unit_test(test_stream_flash_sha256),
+	     ztest_unit_test(test_stream_flash_double_buffer_write),
+	     ztest_unit_test(test_stream_flash_double_buffer_multi_page),
+	     ztest_unit_test(test_stream_flash_double_buffer_error),
+	     ztest_unit_test(test_stream_flash_double_buffer_erase_ahead)
 	 );
 
 	ztest_run_test_suite(lib_stream_flash_test);
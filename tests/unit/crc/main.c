@@ -202,6 +202,37 @@ void test_crc8(void)
 	zassert_equal(fcs, expected, "0x%02x vs 0x%02x", fcs, expected);
 }
 
+void test_crc_long_buffer(void)
+{
+	uint8_t buf[259];
+	uint32_t crc;
+	size_t i;
+
+	for (i = 0; i < sizeof(buf); i++) {
+		buf[i] = (uint8_t)(i * 7 + 3);
+	}
+
+	zassert_equal(crc32_ieee(buf, sizeof(buf)), 0xcdd9ac8e, NULL);
+	/* Unaligned start and odd length */
+	zassert_equal(crc32_ieee(buf + 1, sizeof(buf) - 1), 0x9dd41e2e, NULL);
+
+	/* Updating in chunks of every size gives the same result */
+	for (i = 1; i < 17; i++) {
+		size_t off;
+
+		crc = 0;
+		for (off = 0; off < sizeof(buf); off += i) {
+			crc = crc32_ieee_update(crc, buf + off,
+						MIN(i, sizeof(buf) - off));
+		}
+
+		zassert_equal(crc, 0xcdd9ac8e, "chunk size %zu", i);
+	}
+
+	zassert_equal(crc16_ccitt(0xffff, buf, sizeof(buf)), 0x1bbd, NULL);
+	zassert_equal(crc16_itu_t(0, buf, sizeof(buf)), 0xcd2c, NULL);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_crc,
@@ -213,6 +244,7 @@ void test_main(void)
 			 ztest_unit_test(test_crc16_itu_t),
 			 ztest_unit_test(test_crc8_ccitt),
 			 ztest_unit_test(test_crc7_be),
-			 ztest_unit_test(test_crc8));
+			 ztest_unit_test(test_crc8),
+			 ztest_unit_test(test_crc_long_buffer));
 	ztest_run_test_suite(test_crc);
 }